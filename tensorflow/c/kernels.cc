@@ -295,6 +295,31 @@ class KernelBuilderFactory
  private:
   TF_KernelBuilder* builder_;
 };
+
+// Returns true if `view` has a valid struct_size, and sets `status` to
+// TF_INVALID_ARGUMENT otherwise.
+bool ValidateTensorViewSize(const TF_TensorView* view, TF_Status* status) {
+  if (view->struct_size < TF_TensorView_STRUCT_SIZE) {
+    TF_SetStatus(status, TF_INVALID_ARGUMENT,
+                 "TF_TensorView struct size member must be set to "
+                 "TF_TensorView_STRUCT_SIZE");
+    return false;
+  }
+  return true;
+}
+
+// Fills `view` with `tensor` without allocating.
+void FillTensorView(const Tensor& tensor, TF_TensorView* view) {
+  view->dtype = static_cast<TF_DataType>(tensor.dtype());
+  view->num_dims = tensor.dims();
+  const int num_copied_dims =
+      view->dims == nullptr ? 0 : std::min(view->num_dims, view->dims_capacity);
+  for (int d = 0; d < num_copied_dims; ++d) {
+    view->dims[d] = tensor.dim_size(d);
+  }
+  view->data = const_cast<void*>(tensor.data());
+  view->len = tensor.TotalBytes();
+}
 }  // namespace
 }  // namespace tensorflow
 
@@ -427,6 +452,39 @@ void TF_SetOutput(TF_OpKernelContext* ctx, int i, const TF_Tensor* tensor,
   }
 }
 
+void TF_GetInputView(TF_OpKernelContext* ctx, int i, TF_TensorView* view,
+                     TF_Status* status) {
+  if (!::tensorflow::ValidateTensorViewSize(view, status)) return;
+  auto* cc_ctx = reinterpret_cast<::tensorflow::OpKernelContext*>(ctx);
+  if (i < 0 || i >= cc_ctx->num_inputs()) {
+    TF_SetStatus(status, TF_OUT_OF_RANGE, "input index out of range");
+    return;
+  }
+  ::tensorflow::FillTensorView(cc_ctx->input(i), view);
+  TF_SetStatus(status, TF_OK, "");
+}
+
+void TF_AllocateOutputView(TF_OpKernelContext* ctx, int i, const int64_t* dims,
+                           int num_dims, TF_TensorView* view,
+                           TF_Status* status) {
+  if (!::tensorflow::ValidateTensorViewSize(view, status)) return;
+  auto* cc_ctx = reinterpret_cast<::tensorflow::OpKernelContext*>(ctx);
+  if (i < 0 || i >= cc_ctx->num_outputs()) {
+    TF_SetStatus(status, TF_OUT_OF_RANGE, "output index out of range");
+    return;
+  }
+  tensorflow::gtl::ArraySlice<const int64_t> dimarray(dims, num_dims);
+  tensorflow::Tensor* tensor;
+  absl::Status s =
+      cc_ctx->allocate_output(i, tensorflow::TensorShape(dimarray), &tensor);
+  if (!s.ok()) {
+    ::tensorflow::Set_TF_Status_from_Status(status, s);
+    return;
+  }
+  ::tensorflow::FillTensorView(*tensor, view);
+  TF_SetStatus(status, TF_OK, "");
+}
+
 TF_Tensor* TF_GetMutableOutput(TF_OpKernelContext* ctx, int i,
                                TF_Status* status) {
   auto* cc_ctx = reinterpret_cast<::tensorflow::OpKernelContext*>(ctx);
@@ -219,6 +219,44 @@ TF_CAPI_EXPORT extern void TF_SetOutput(TF_OpKernelContext* ctx, int i,
 TF_CAPI_EXPORT extern TF_Tensor* TF_GetMutableOutput(TF_OpKernelContext* ctx,
                                                      int i, TF_Status* status);
 
+// A borrowed view of a tensor of an OpKernelContext. Unlike the TF_Tensor
+// returned by TF_GetInput or TF_AllocateOutput, filling a view doesn't
+// allocate, which matters for kernels that are launched at a high rate. The
+// view is valid until the kernel's compute function returns.
+typedef struct {
+  size_t struct_size;
+  void* priv;         // Not used, for possible extension.
+  int64_t* dims;      // input: optional buffer for the dimensions
+  int dims_capacity;  // input: number of elements of `dims`
+  TF_DataType dtype;  // output
+  int num_dims;       // output
+  void* data;         // output
+  size_t len;         // output: size of `data` in bytes
+} TF_TensorView;
+const size_t TF_TensorView_STRUCT_SIZE = TF_OFFSET_OF_END(TF_TensorView, len);
+
+// Fills `view` with the ith input of ctx. The first min(num_dims,
+// dims_capacity) dimensions are copied to `view->dims`. If TF_GetCode(status)
+// is anything but TF_OK, `view` is left unmodified.
+//
+// If view->struct_size is less than TF_TensorView_STRUCT_SIZE, *status is set
+// to TF_INVALID_ARGUMENT. If i < 0 or i >= TF_NumInputs(ctx), *status is set
+// to TF_OUT_OF_RANGE. `status` can be allocated once per kernel and reused
+// across calls.
+TF_CAPI_EXPORT extern void TF_GetInputView(TF_OpKernelContext* ctx, int i,
+                                           TF_TensorView* view,
+                                           TF_Status* status);
+
+// Allocates the ith output of ctx with the given shape and its expected data
+// type, and fills `view` with it. This is TF_AllocateOutput without the
+// TF_Tensor allocation, and checks view->struct_size like TF_GetInputView. If
+// TF_GetCode(status) is anything but TF_OK, `view` is left unmodified.
+TF_CAPI_EXPORT extern void TF_AllocateOutputView(TF_OpKernelContext* ctx,
+                                                 int i, const int64_t* dims,
+                                                 int num_dims,
+                                                 TF_TensorView* view,
+                                                 TF_Status* status);
+
 // Retrieves a serialized FunctionDefLibrary. Status will be set.
 TF_CAPI_EXPORT extern void TF_GetSerializedFunctionDefLibrary(
     TF_OpKernelContext* ctx, TF_Buffer* serialized_function_def_library,
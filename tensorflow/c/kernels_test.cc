@@ -1444,6 +1444,90 @@ TEST_F(DeviceKernelOpTest, TestForwardInputOrAllocateOutput) {
   }
 }
 
+TEST(TestKernel, TestTensorViews) {
+  const char* node_name = "TensorViewKernel";
+  const char* op_name = "TensorViewOp";
+  const char* device_name = "FakeDeviceName";
+
+  REGISTER_OP(op_name)
+      .Input("input1: float")
+      .Input("input2: float")
+      .Output("output1: float")
+      .Attr("SomeDataTypeAttr: type");
+
+  // A kernel that copies its first input to its output through views.
+  auto my_compute_func = [](void* kernel, TF_OpKernelContext* ctx) {
+    TF_Status* s = TF_NewStatus();
+    int64_t dims[2];
+    TF_TensorView input = {TF_TensorView_STRUCT_SIZE, nullptr, dims, 2};
+    TF_GetInputView(ctx, 0, &input, s);
+    EXPECT_EQ(TF_OK, TF_GetCode(s)) << TF_Message(s);
+    EXPECT_EQ(TF_FLOAT, input.dtype);
+    ASSERT_EQ(2, input.num_dims);
+    EXPECT_EQ(2, dims[0]);
+    EXPECT_EQ(3, dims[1]);
+    EXPECT_EQ(6 * sizeof(float), input.len);
+    TF_GetInputView(ctx, 2, &input, s);
+    EXPECT_EQ(TF_OUT_OF_RANGE, TF_GetCode(s));
+    TF_TensorView uninitialized = {0};
+    TF_GetInputView(ctx, 0, &uninitialized, s);
+    EXPECT_EQ(TF_INVALID_ARGUMENT, TF_GetCode(s));
+    TF_AllocateOutputView(ctx, 0, dims, 2, &uninitialized, s);
+    EXPECT_EQ(TF_INVALID_ARGUMENT, TF_GetCode(s));
+
+    TF_TensorView output = {TF_TensorView_STRUCT_SIZE};
+    TF_AllocateOutputView(ctx, 0, dims, 2, &output, s);
+    EXPECT_EQ(TF_OK, TF_GetCode(s)) << TF_Message(s);
+    EXPECT_EQ(TF_FLOAT, output.dtype);
+    EXPECT_EQ(2, output.num_dims);
+    ASSERT_EQ(input.len, output.len);
+    memcpy(output.data, input.data, input.len);
+    TF_AllocateOutputView(ctx, 1, dims, 2, &output, s);
+    EXPECT_EQ(TF_OUT_OF_RANGE, TF_GetCode(s));
+    TF_DeleteStatus(s);
+  };
+
+  TF_KernelBuilder* builder = TF_NewKernelBuilder(op_name, device_name, nullptr,
+                                                  my_compute_func, nullptr);
+
+  {
+    TF_Status* status = TF_NewStatus();
+    TF_RegisterKernelBuilder(node_name, builder, status);
+    EXPECT_EQ(TF_OK, TF_GetCode(status));
+    TF_DeleteStatus(status);
+  }
+
+  {
+    OpKernelContext::Params p;
+    DummyDevice dummy_device(nullptr);
+    p.device = &dummy_device;
+    AllocatorAttributes alloc_attrs;
+    p.output_attr_array = &alloc_attrs;
+
+    Tensor t(DT_FLOAT, TensorShape({2, 3}));
+    for (int i = 0; i < 6; ++i) t.flat<float>()(i) = i;
+
+    absl::InlinedVector<TensorValue, 4UL> inputs;
+    // GetFakeKernel requires a NodeDef with two inputs
+    inputs.emplace_back(&t);
+    inputs.emplace_back();
+    p.inputs = inputs;
+
+    absl::Status status;
+    std::unique_ptr<OpKernel> kernel =
+        GetFakeKernel(device_name, op_name, node_name, &status);
+    TF_EXPECT_OK(status);
+    ASSERT_NE(nullptr, kernel.get());
+
+    p.op_kernel = kernel.get();
+    OpKernelContext ctx(&p);
+    kernel->Compute(&ctx);
+    TF_EXPECT_OK(ctx.status());
+    ASSERT_EQ(TensorShape({2, 3}), ctx.mutable_output(0)->shape());
+    EXPECT_EQ(5, ctx.mutable_output(0)->matrix<float>()(1, 2));
+  }
+}
+
 void validate_tensor(TF_Tensor* tensor, int64_t* dims, int64_t num_dims,
                      TF_DataType dtype) {
   EXPECT_EQ(TF_FLOAT, TF_TensorType(tensor));
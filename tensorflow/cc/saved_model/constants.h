@@ -24,6 +24,10 @@ inline constexpr char kSavedModelAssetsDirectory[] = "assets";
 // SavedModel assets.extra directory.
 inline constexpr char kSavedModelAssetsExtraDirectory[] = "assets.extra";
 
+// File of the TensorFlow Serving warmup requests, in assets.extra.
+inline constexpr char kSavedModelWarmupRequestsFilename[] =
+    "tf_serving_warmup_requests";
+
 // SavedModel assets key for graph collection-def.
 inline constexpr char kSavedModelAssetsKey[] = "saved_model_assets";
 
@@ -15,14 +15,21 @@ limitations under the License.
 
 #include "tensorflow/cc/saved_model/loader.h"
 
+#include <atomic>
+#include <map>
 #include <memory>
 #include <string>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_join.h"
+#include "absl/types/span.h"
 #include "tensorflow/cc/saved_model/constants.h"
 #include "tensorflow/cc/saved_model/fingerprinting.h"
 #include "tensorflow/cc/saved_model/loader_util.h"
@@ -33,8 +40,10 @@ limitations under the License.
 #include "tensorflow/core/framework/function.pb.h"
 #include "tensorflow/core/framework/graph_debug_info.pb.h"
 #include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/node_def_util.h"
 #include "tensorflow/core/framework/op_def.pb.h"
 #include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/graph/tensor_id.h"
 #include "tensorflow/core/lib/io/path.h"
 #include "tensorflow/core/lib/monitoring/counter.h"
 #include "tensorflow/core/lib/monitoring/sampler.h"
@@ -43,6 +52,7 @@ limitations under the License.
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/file_system_helper.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/statusor.h"
 #include "tensorflow/core/protobuf/meta_graph.pb.h"
 #include "tensorflow/core/protobuf/saver.pb.h"
@@ -228,12 +238,11 @@ absl::Status RunInitOp(const RunOptions& run_options, const string& export_dir,
   return absl::OkStatus();
 }
 
-absl::Status RunRestore(const RunOptions& run_options, const string& export_dir,
-                        const StringPiece restore_op_name,
-                        const StringPiece variable_filename_const_op_name,
-                        const std::vector<AssetFileDef>& asset_file_defs,
-                        Session* session) {
-  LOG(INFO) << "Restoring SavedModel bundle.";
+// Sets `variables_path` to the checkpoint prefix of the variables of the
+// SavedModel in `export_dir` of `env`, or to an empty string if it has no
+// variables.
+absl::Status GetVariablesPath(Env* env, const string& export_dir,
+                              string* variables_path) {
   // Find path to variables to be restored in export directory.
   const string variables_directory =
       io::JoinPath(export_dir, kSavedModelVariablesDirectory);
@@ -244,15 +253,29 @@ absl::Status RunRestore(const RunOptions& run_options, const string& export_dir,
       variables_directory, MetaFilename(kSavedModelVariablesFilename));
   TF_ASSIGN_OR_RETURN(
       bool variables_index_exists,
-      internal::FileExists(Env::Default(), variables_index_path));
+      internal::FileExists(env, variables_index_path));
   if (!variables_index_exists) {
     LOG(INFO) << "The specified SavedModel has no variables; no checkpoints "
                  "were restored. File does not exist: "
               << variables_index_path;
+    variables_path->clear();
     return absl::OkStatus();
   }
-  const string variables_path =
+  *variables_path =
       io::JoinPath(variables_directory, kSavedModelVariablesFilename);
+  return absl::OkStatus();
+}
+
+absl::Status RunRestore(const RunOptions& run_options, Env* env,
+                        const string& export_dir,
+                        const StringPiece restore_op_name,
+                        const StringPiece variable_filename_const_op_name,
+                        const std::vector<AssetFileDef>& asset_file_defs,
+                        Session* session) {
+  LOG(INFO) << "Restoring SavedModel bundle.";
+  string variables_path;
+  TF_RETURN_IF_ERROR(GetVariablesPath(env, export_dir, &variables_path));
+  if (variables_path.empty()) return absl::OkStatus();
 
   // Add variables to the graph.
   Tensor variables_path_tensor(DT_STRING, TensorShape({}));
@@ -268,6 +291,258 @@ absl::Status RunRestore(const RunOptions& run_options, const string& export_dir,
                  nullptr /* outputs */, &run_metadata, session);
 }
 
+// Prefix of the nodes added to the graph to restore each variable separately,
+// when loading lazily.
+constexpr char kLazyRestorePrefix[] = "saved_model_lazy_restore";
+
+// The variables of a graph rewritten by AddLazyRestoreNodes().
+struct LazyRestoreGraph {
+  // The node restoring each variable, by variable key (see VariableKey()).
+  absl::flat_hash_map<string, string> restore_targets;
+
+  // The variables read by the signatures computing each output, and by the
+  // init op, by output node name.
+  absl::flat_hash_map<string, std::vector<string>> variables_by_output;
+
+  // The variables read by each signature, in signature key order.
+  std::vector<std::vector<string>> signature_variables;
+};
+
+// Adds to `nodes` the names of the nodes producing the tensors of `info`.
+void AddTensorInfoNodes(const TensorInfo& info,
+                        std::vector<absl::string_view>* nodes) {
+  switch (info.encoding_case()) {
+    case TensorInfo::kName:
+      nodes->push_back(ParseTensorName(info.name()).node());
+      break;
+    case TensorInfo::kCooSparse:
+      nodes->push_back(
+          ParseTensorName(info.coo_sparse().values_tensor_name()).node());
+      nodes->push_back(
+          ParseTensorName(info.coo_sparse().indices_tensor_name()).node());
+      nodes->push_back(
+          ParseTensorName(info.coo_sparse().dense_shape_tensor_name()).node());
+      break;
+    case TensorInfo::kCompositeTensor:
+      for (const TensorInfo& component :
+           info.composite_tensor().components()) {
+        AddTensorInfoNodes(component, nodes);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+// Returns in `value` the element `index` of the string constant `node`.
+absl::Status GetStringConstElement(const NodeDef* node, int index,
+                                   tstring* value) {
+  if (node == nullptr || node->op() != "Const") {
+    return errors::Unimplemented("Restore op input is not a constant");
+  }
+  Tensor tensor;
+  const auto it = node->attr().find("value");
+  if (it == node->attr().end() || !tensor.FromProto(it->second.tensor()) ||
+      tensor.dtype() != DT_STRING || index >= tensor.NumElements()) {
+    return errors::InvalidArgument("Invalid restore op input ", node->name());
+  }
+  *value = tensor.flat<tstring>()(index);
+  return absl::OkStatus();
+}
+
+NodeDef MakeStringConst(const string& name, const tstring& value,
+                        const string& device) {
+  NodeDef node;
+  node.set_name(name);
+  node.set_op("Const");
+  node.set_device(device);
+  Tensor tensor(DT_STRING, TensorShape({1}));
+  tensor.vec<tstring>()(0) = value;
+  AddNodeAttr("dtype", DT_STRING, &node);
+  AddNodeAttr("value", tensor, &node);
+  return node;
+}
+
+// Returns the key of the variable created by `node`, or an empty string if
+// `node` doesn't create a variable. The nodes creating the same variable share
+// its container and shared name, which defaults to the node name.
+string VariableKey(const NodeDef& node) {
+  if (node.op() != "VarHandleOp" && node.op() != "VariableV2" &&
+      node.op() != "Variable") {
+    return "";
+  }
+  string container;
+  string shared_name;
+  TryGetNodeAttr(node, "container", &container);
+  TryGetNodeAttr(node, "shared_name", &shared_name);
+  if (shared_name.empty()) shared_name = node.name();
+  return absl::StrCat(container, "/", shared_name);
+}
+
+// Adds to `graph_def` a node restoring each variable restored by the saver
+// op `restore_op_name` separately, so that the variables read by a signature
+// of `signatures`, or by the init op `init_op_name`, can be restored without
+// reading the whole checkpoint. Records the added nodes in `lazy_graph`.
+//
+// Supports the restore ops of V1 savers: a tree of NoOps over Assign or
+// AssignVariableOp nodes of RestoreV2 outputs. Returns an error, leaving
+// `graph_def` unchanged, for any other restore op.
+absl::Status AddLazyRestoreNodes(
+    const protobuf::Map<string, SignatureDef>& signatures,
+    const string& restore_op_name, const string& init_op_name,
+    GraphDef* graph_def, LazyRestoreGraph* lazy_graph) {
+  absl::flat_hash_map<absl::string_view, const NodeDef*> nodes;
+  for (const NodeDef& node : graph_def->node()) {
+    if (absl::StartsWith(node.name(), kLazyRestorePrefix)) {
+      return errors::AlreadyExists("Graph has a node named ", node.name());
+    }
+    nodes[node.name()] = &node;
+  }
+  auto find_node = [&nodes](absl::string_view input) -> const NodeDef* {
+    const auto it = nodes.find(ParseTensorName(input).node());
+    return it == nodes.end() ? nullptr : it->second;
+  };
+
+  // Find the nodes restoring each variable.
+  std::vector<const NodeDef*> assigns;
+  std::vector<absl::string_view> stack = {restore_op_name};
+  absl::flat_hash_set<absl::string_view> visited;
+  while (!stack.empty()) {
+    const NodeDef* node = find_node(stack.back());
+    stack.pop_back();
+    if (node == nullptr) {
+      return errors::NotFound("Restore op input of ", restore_op_name,
+                              " not found");
+    }
+    if (!visited.insert(node->name()).second) continue;
+    if (node->op() == "NoOp") {
+      for (const string& input : node->input()) stack.push_back(input);
+    } else if (node->op() == "Assign" || node->op() == "AssignVariableOp") {
+      assigns.push_back(node);
+    } else {
+      return errors::Unimplemented("Restore op ", restore_op_name,
+                                   " runs node ", node->name(), " of op ",
+                                   node->op());
+    }
+  }
+
+  std::vector<NodeDef> new_nodes;
+  for (const NodeDef* assign : assigns) {
+    if (assign->input_size() < 2) {
+      return errors::InvalidArgument("Invalid restore node ", assign->name());
+    }
+    // Find the RestoreV2 output assigned, through any Identity.
+    TensorId value_id = ParseTensorName(assign->input(1));
+    const NodeDef* restore = find_node(assign->input(1));
+    while (restore != nullptr && restore->op() == "Identity" &&
+           restore->input_size() > 0) {
+      value_id = ParseTensorName(restore->input(0));
+      restore = find_node(restore->input(0));
+    }
+    if (restore == nullptr || restore->op() != "RestoreV2" ||
+        restore->input_size() != 3 || value_id.index() < 0) {
+      return errors::Unimplemented("Restore node ", assign->name(),
+                                   " doesn't assign a RestoreV2 output");
+    }
+    const int index = value_id.index();
+    tstring tensor_name;
+    tstring shape_and_slice;
+    TF_RETURN_IF_ERROR(GetStringConstElement(find_node(restore->input(1)),
+                                             index, &tensor_name));
+    TF_RETURN_IF_ERROR(GetStringConstElement(find_node(restore->input(2)),
+                                             index, &shape_and_slice));
+    DataTypeVector dtypes;
+    TF_RETURN_IF_ERROR(GetNodeAttr(*restore, "dtypes", &dtypes));
+    if (index >= static_cast<int>(dtypes.size())) {
+      return errors::InvalidArgument("Invalid restore op ", restore->name());
+    }
+
+    const NodeDef* variable_node = find_node(assign->input(0));
+    const string variable_key =
+        variable_node == nullptr ? "" : VariableKey(*variable_node);
+    if (variable_key.empty()) {
+      return errors::Unimplemented("Restore node ", assign->name(),
+                                   " doesn't assign a variable");
+    }
+    const string prefix =
+        absl::StrCat(kLazyRestorePrefix, "/", variable_node->name());
+    if (lazy_graph->restore_targets.contains(variable_key)) {
+      return errors::Unimplemented("Variable ", variable_key,
+                                   " is restored more than once");
+    }
+    new_nodes.push_back(MakeStringConst(absl::StrCat(prefix, "/tensor_names"),
+                                        tensor_name, restore->device()));
+    new_nodes.push_back(
+        MakeStringConst(absl::StrCat(prefix, "/shape_and_slices"),
+                        shape_and_slice, restore->device()));
+    NodeDef& restore_variable = new_nodes.emplace_back();
+    restore_variable.set_name(absl::StrCat(prefix, "/RestoreV2"));
+    restore_variable.set_op("RestoreV2");
+    restore_variable.set_device(restore->device());
+    restore_variable.add_input(restore->input(0));
+    restore_variable.add_input(new_nodes[new_nodes.size() - 3].name());
+    restore_variable.add_input(new_nodes[new_nodes.size() - 2].name());
+    AddNodeAttr("dtypes", DataTypeVector{dtypes[index]}, &restore_variable);
+    NodeDef& assign_variable = new_nodes.emplace_back(*assign);
+    assign_variable.set_name(prefix);
+    assign_variable.clear_input();
+    assign_variable.add_input(assign->input(0));
+    assign_variable.add_input(new_nodes[new_nodes.size() - 2].name());
+    lazy_graph->restore_targets[variable_key] = prefix;
+  }
+
+  // Returns the variables to restore that the nodes of `stack` depend on.
+  auto find_variables = [&](std::vector<absl::string_view> stack) {
+    std::vector<string> variables;
+    visited.clear();
+    while (!stack.empty()) {
+      const NodeDef* node = find_node(stack.back());
+      stack.pop_back();
+      if (node == nullptr || !visited.insert(node->name()).second) continue;
+      string variable_key = VariableKey(*node);
+      if (lazy_graph->restore_targets.contains(variable_key)) {
+        variables.push_back(std::move(variable_key));
+      }
+      for (const string& input : node->input()) stack.push_back(input);
+    }
+    return variables;
+  };
+
+  // The variables that the init op reads or assigns are restored before it
+  // runs, as when loading the SavedModel eagerly.
+  if (!init_op_name.empty()) {
+    lazy_graph->variables_by_output[ParseTensorName(init_op_name).node()] =
+        find_variables({init_op_name});
+  }
+
+  // Find the variables read by each signature.
+  std::map<string, const SignatureDef*> sorted_signatures;
+  for (const auto& signature : signatures) {
+    sorted_signatures[signature.first] = &signature.second;
+  }
+  for (const auto& [key, signature] : sorted_signatures) {
+    std::vector<absl::string_view> outputs;
+    for (const auto& output : signature->outputs()) {
+      AddTensorInfoNodes(output.second, &outputs);
+    }
+    stack = outputs;
+    for (const auto& input : signature->inputs()) {
+      AddTensorInfoNodes(input.second, &stack);
+    }
+    const std::vector<string>& variables =
+        lazy_graph->signature_variables.emplace_back(find_variables(stack));
+    for (absl::string_view output : outputs) {
+      std::vector<string>& output_variables =
+          lazy_graph->variables_by_output[string(output)];
+      output_variables.insert(output_variables.end(), variables.begin(),
+                              variables.end());
+    }
+  }
+
+  for (NodeDef& node : new_nodes) *graph_def->add_node() = std::move(node);
+  return absl::OkStatus();
+}
+
 }  // namespace
 
 SavedModelBundleInterface::~SavedModelBundleInterface() = default;
@@ -423,9 +698,183 @@ class LiteSessionWrapper : public Session {
 
   absl::Status Finalize() override { return wrapped_->Finalize(); }
 
+ protected:
+  Session* wrapped() const { return wrapped_.get(); }
+
  private:
   const std::unique_ptr<Session> wrapped_;
 };
+
+// Restores the variables of a graph rewritten by AddLazyRestoreNodes(), on
+// first use. Thread-safe.
+class LazyRestorer {
+ public:
+  // Restores variables by running `lazy_graph` nodes in `session`, feeding
+  // `restore_inputs`.
+  LazyRestorer(const RunOptions& run_options,
+               std::vector<std::pair<string, Tensor>> restore_inputs,
+               LazyRestoreGraph lazy_graph, Session* session)
+      : run_options_(run_options),
+        restore_inputs_(std::move(restore_inputs)),
+        variables_by_output_(std::move(lazy_graph.variables_by_output)),
+        signature_variables_(std::move(lazy_graph.signature_variables)),
+        session_(session),
+        pending_(std::move(lazy_graph.restore_targets)) {
+    all_restored_ = pending_.empty();
+  }
+
+  // Restores the variables read to compute `output_tensor_names` and
+  // `target_node_names`, unless already restored. Restores all the variables
+  // if any of them isn't a signature output.
+  absl::Status RestoreFor(absl::Span<const string> output_tensor_names,
+                          absl::Span<const string> target_node_names) {
+    if (all_restored_) return absl::OkStatus();
+    std::vector<string> variables;
+    for (absl::Span<const string> names :
+         {output_tensor_names, target_node_names}) {
+      for (const string& name : names) {
+        const auto it =
+            variables_by_output_.find(ParseTensorName(name).node());
+        if (it == variables_by_output_.end()) return Restore(nullptr);
+        variables.insert(variables.end(), it->second.begin(),
+                         it->second.end());
+      }
+    }
+    return Restore(&variables);
+  }
+
+  // Restores the variables of each signature in turn, then the others, until
+  // `cancelled` is set.
+  void WarmUp(const std::atomic<bool>* cancelled) {
+    for (const std::vector<string>& variables : signature_variables_) {
+      if (*cancelled) return;
+      const absl::Status status = Restore(&variables);
+      if (!status.ok()) {
+        LOG(WARNING) << "SavedModel warm-up failed: " << status;
+        return;
+      }
+    }
+    if (*cancelled) return;
+    const absl::Status status = Restore(nullptr);
+    if (!status.ok()) LOG(WARNING) << "SavedModel warm-up failed: " << status;
+  }
+
+ private:
+  // Restores `variables`, or all the variables if null, unless already
+  // restored.
+  absl::Status Restore(const std::vector<string>* variables) {
+    mutex_lock l(mu_);
+    absl::flat_hash_set<string> restored;
+    std::vector<string> targets;
+    if (variables == nullptr) {
+      for (const auto& [variable, target] : pending_) {
+        restored.insert(variable);
+        targets.push_back(target);
+      }
+    } else {
+      for (const string& variable : *variables) {
+        const auto it = pending_.find(variable);
+        if (it != pending_.end() && restored.insert(variable).second) {
+          targets.push_back(it->second);
+        }
+      }
+    }
+    if (targets.empty()) return absl::OkStatus();
+    VLOG(1) << "Restoring " << targets.size() << " SavedModel variables.";
+    RunMetadata run_metadata;
+    TF_RETURN_IF_ERROR(RunOnce(run_options_, restore_inputs_, {}, targets,
+                               nullptr /* outputs */, &run_metadata,
+                               session_));
+    for (const string& variable : restored) pending_.erase(variable);
+    if (pending_.empty()) all_restored_ = true;
+    return absl::OkStatus();
+  }
+
+  const RunOptions run_options_;
+  const std::vector<std::pair<string, Tensor>> restore_inputs_;
+  const absl::flat_hash_map<string, std::vector<string>> variables_by_output_;
+  const std::vector<std::vector<string>> signature_variables_;
+  Session* const session_;  // Not owned.
+
+  mutex mu_;
+  // The nodes restoring the variables not restored yet, by variable name.
+  absl::flat_hash_map<string, string> pending_ TF_GUARDED_BY(mu_);
+  std::atomic<bool> all_restored_;
+};
+
+// LiteSessionWrapper restoring variables with a LazyRestorer before running
+// them, and optionally in the background.
+class LazyRestoreSessionWrapper : public LiteSessionWrapper {
+ public:
+  LazyRestoreSessionWrapper(
+      std::unique_ptr<Session> wrapped, const RunOptions& run_options,
+      std::vector<std::pair<string, Tensor>> restore_inputs,
+      LazyRestoreGraph lazy_graph)
+      : LiteSessionWrapper(std::move(wrapped)),
+        restorer_(run_options, std::move(restore_inputs),
+                  std::move(lazy_graph), this->wrapped()) {}
+
+  // Starts restoring the variables of each signature in the background.
+  void StartWarmUp() {
+    warm_up_thread_.reset(Env::Default()->StartThread(
+        ThreadOptions(), "saved_model_warm_up",
+        [this]() { restorer_.WarmUp(&cancelled_); }));
+  }
+
+  ~LazyRestoreSessionWrapper() override { StopWarmUp(); }
+
+  absl::Status Run(const std::vector<std::pair<string, Tensor>>& inputs,
+                   const std::vector<string>& output_tensor_names,
+                   const std::vector<string>& target_node_names,
+                   std::vector<Tensor>* outputs) override {
+    TF_RETURN_IF_ERROR(
+        restorer_.RestoreFor(output_tensor_names, target_node_names));
+    return LiteSessionWrapper::Run(inputs, output_tensor_names,
+                                   target_node_names, outputs);
+  }
+
+  absl::Status Run(const RunOptions& run_options,
+                   const std::vector<std::pair<string, Tensor>>& inputs,
+                   const std::vector<string>& output_tensor_names,
+                   const std::vector<string>& target_node_names,
+                   std::vector<Tensor>* outputs,
+                   RunMetadata* run_metadata) override {
+    TF_RETURN_IF_ERROR(
+        restorer_.RestoreFor(output_tensor_names, target_node_names));
+    return LiteSessionWrapper::Run(run_options, inputs, output_tensor_names,
+                                   target_node_names, outputs, run_metadata);
+  }
+
+  absl::Status MakeCallable(const CallableOptions& callable_options,
+                            CallableHandle* out_handle) override {
+    const std::vector<string> fetches(callable_options.fetch().begin(),
+                                      callable_options.fetch().end());
+    const std::vector<string> targets(callable_options.target().begin(),
+                                      callable_options.target().end());
+    TF_RETURN_IF_ERROR(restorer_.RestoreFor(fetches, targets));
+    return LiteSessionWrapper::MakeCallable(callable_options, out_handle);
+  }
+
+  absl::Status Close(const RunOptions& run_options) override {
+    StopWarmUp();
+    return LiteSessionWrapper::Close(run_options);
+  }
+
+  absl::Status Close() override {
+    StopWarmUp();
+    return LiteSessionWrapper::Close();
+  }
+
+ private:
+  void StopWarmUp() {
+    cancelled_ = true;
+    warm_up_thread_.reset();
+  }
+
+  LazyRestorer restorer_;
+  std::atomic<bool> cancelled_ = false;
+  std::unique_ptr<Thread> warm_up_thread_;
+};
 }  // namespace
 
 absl::Status LoadSavedModelInternal(const SessionOptions& session_options,
@@ -448,6 +897,76 @@ absl::Status LoadSavedModelInternal(const SessionOptions& session_options,
   return absl::OkStatus();
 }
 
+namespace {
+// A SavedModelBundleLite to load with LoadSavedModelLazily().
+struct LazySavedModelBundleLite {
+  SavedModelBundleLite* bundle;
+  bool warm_up_in_background;
+};
+}  // namespace
+
+absl::Status LoadSavedModelInternal(const SessionOptions& session_options,
+                                    const RunOptions& run_options,
+                                    const string& export_dir,
+                                    const std::unordered_set<string>& tags,
+                                    LazySavedModelBundleLite* const lazy) {
+  MetaGraphDef meta_graph_def;
+  TF_RETURN_IF_ERROR(
+      ReadMetaGraphDefFromSavedModel(export_dir, tags, &meta_graph_def));
+  string variables_path;
+  TF_RETURN_IF_ERROR(
+      GetVariablesPath(Env::Default(), export_dir, &variables_path));
+  string init_op_name;
+  TF_RETURN_IF_ERROR(
+      internal::GetInitOp(export_dir, meta_graph_def, &init_op_name));
+  LazyRestoreGraph lazy_graph;
+  absl::Status lazy_status =
+      absl::FailedPreconditionError("The SavedModel has no variables");
+  if (meta_graph_def.has_saver_def() && !variables_path.empty()) {
+    lazy_status = AddLazyRestoreNodes(
+        meta_graph_def.signature_def(),
+        meta_graph_def.saver_def().restore_op_name(), init_op_name,
+        meta_graph_def.mutable_graph_def(), &lazy_graph);
+  }
+  std::unique_ptr<Session> session;
+  TF_RETURN_IF_ERROR(LoadGraphDefIntoSession(
+      session_options, std::move(*meta_graph_def.mutable_graph_def()),
+      &session));
+  if (!lazy_status.ok()) {
+    LOG(INFO) << "Restoring all the variables of the SavedModel at load time: "
+              << lazy_status;
+    TF_RETURN_IF_ERROR(
+        RestoreSession(run_options, meta_graph_def, export_dir, &session));
+    *lazy->bundle = SavedModelBundleLite(
+        std::make_unique<LiteSessionWrapper>(std::move(session)),
+        std::move(*meta_graph_def.mutable_signature_def()));
+    return absl::OkStatus();
+  }
+
+  std::vector<AssetFileDef> asset_file_defs;
+  TF_RETURN_IF_ERROR(
+      internal::GetAssetFileDefs(meta_graph_def, &asset_file_defs));
+  std::vector<std::pair<string, Tensor>> restore_inputs = {
+      {meta_graph_def.saver_def().filename_tensor_name(),
+       CreateStringTensor(variables_path)}};
+  AddAssetsTensorsToInputs(export_dir, asset_file_defs, &restore_inputs);
+  LOG(INFO) << "Restoring the " << lazy_graph.restore_targets.size()
+            << " variables of the SavedModel on first use.";
+  auto lazy_session = std::make_unique<LazyRestoreSessionWrapper>(
+      std::move(session), run_options, std::move(restore_inputs),
+      std::move(lazy_graph));
+  // Running the init op through the wrapper first restores the variables it
+  // depends on.
+  TF_RETURN_IF_ERROR(RunInitOp(run_options, export_dir, meta_graph_def,
+                               asset_file_defs, lazy_session.get(),
+                               init_op_name));
+  if (lazy->warm_up_in_background) lazy_session->StartWarmUp();
+  *lazy->bundle = SavedModelBundleLite(
+      std::move(lazy_session),
+      std::move(*meta_graph_def.mutable_signature_def()));
+  return absl::OkStatus();
+}
+
 template <typename BundleType>
 absl::Status LoadSavedModelGeneric(const SessionOptions& session_options,
                                    const RunOptions& run_options,
@@ -497,11 +1016,19 @@ absl::Status RestoreSession(const RunOptions& run_options,
                             const MetaGraphDef& meta_graph,
                             const string& export_dir,
                             std::unique_ptr<Session>* session) {
+  return RestoreSession(run_options, meta_graph, export_dir, Env::Default(),
+                        session);
+}
+
+absl::Status RestoreSession(const RunOptions& run_options,
+                            const MetaGraphDef& meta_graph,
+                            const string& export_dir, Env* env,
+                            std::unique_ptr<Session>* session) {
   const uint64 read_start_microseconds = Env::Default()->NowMicros();
   std::vector<AssetFileDef> asset_file_defs;
   TF_RETURN_IF_ERROR(internal::GetAssetFileDefs(meta_graph, &asset_file_defs));
   if (meta_graph.has_saver_def()) {
-    TF_RETURN_IF_ERROR(RunRestore(run_options, export_dir,
+    TF_RETURN_IF_ERROR(RunRestore(run_options, env, export_dir,
                                   meta_graph.saver_def().restore_op_name(),
                                   meta_graph.saver_def().filename_tensor_name(),
                                   asset_file_defs, session->get()));
@@ -525,11 +1052,10 @@ absl::Status RestoreSession(const RunOptions& run_options,
   return absl::OkStatus();
 }
 
-absl::Status LoadSavedModel(const SessionOptions& session_options,
-                            const RunOptions& run_options,
-                            const string& export_dir,
-                            const std::unordered_set<string>& tags,
-                            SavedModelBundleLite* const bundle) {
+namespace {
+// Returns `session_options` rewritten for the sessions of
+// SavedModelBundleLite.
+SessionOptions GetLiteSessionOptions(const SessionOptions& session_options) {
   SessionOptions rewritten_options(session_options);
   // We disallow calls to Session::Extend() on the returned session, so we can
   // reduce memory consumption by not storing the original GraphDef.
@@ -540,13 +1066,34 @@ absl::Status LoadSavedModel(const SessionOptions& session_options,
   // not storing the rewritten subgraph for each signature.
   rewritten_options.config.mutable_experimental()
       ->set_disable_output_partition_graphs(true);
+  return rewritten_options;
+}
+}  // namespace
+
+absl::Status LoadSavedModel(const SessionOptions& session_options,
+                            const RunOptions& run_options,
+                            const string& export_dir,
+                            const std::unordered_set<string>& tags,
+                            SavedModelBundleLite* const bundle) {
   // TODO(mrry): Consider specializing the session creation to reduce peak
   // RAM consumption by using `Session::Create(GraphDef&&)`.
-  TF_RETURN_IF_ERROR(LoadSavedModelGeneric(rewritten_options, run_options,
-                                           export_dir, tags, bundle));
+  TF_RETURN_IF_ERROR(
+      LoadSavedModelGeneric(GetLiteSessionOptions(session_options),
+                            run_options, export_dir, tags, bundle));
   return absl::OkStatus();
 }
 
+absl::Status LoadSavedModelLazily(const SessionOptions& session_options,
+                                  const RunOptions& run_options,
+                                  const string& export_dir,
+                                  const std::unordered_set<string>& tags,
+                                  bool warm_up_in_background,
+                                  SavedModelBundleLite* const bundle) {
+  LazySavedModelBundleLite lazy = {bundle, warm_up_in_background};
+  return LoadSavedModelGeneric(GetLiteSessionOptions(session_options),
+                               run_options, export_dir, tags, &lazy);
+}
+
 bool MaybeSavedModelDirectory(const string& export_dir) {
   const string saved_model_pb_path =
       io::JoinPath(export_dir, kSavedModelFilenamePb);
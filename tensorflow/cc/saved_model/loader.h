@@ -106,6 +106,14 @@ absl::Status RestoreSession(const RunOptions& run_options,
                             const string& export_dir,
                             std::unique_ptr<Session>* session);
 
+// Like RestoreSession() above, but looks up the variables of `export_dir` in
+// `env`, which should be the Env of the session (SessionOptions::env), e.g. a
+// MemmappedEnv for a SavedModel packaged by WriteMemmappedSavedModel().
+absl::Status RestoreSession(const RunOptions& run_options,
+                            const MetaGraphDef& meta_graph,
+                            const string& export_dir, Env* env,
+                            std::unique_ptr<Session>* session);
+
 // Initialize a session which wraps this metagraph.
 // The recommended way to load a saved model is to call LoadSavedModel,
 // which provides an already initialized Metagraph, Session, and DebugInfo.
@@ -138,6 +146,25 @@ absl::Status LoadSavedModel(const SessionOptions& session_options,
                             const std::unordered_set<string>& tags,
                             SavedModelBundleLite* bundle);
 
+/// Like the SavedModelBundleLite overload of LoadSavedModel(), but restores the
+/// variables of each signature the first time the session fetches one of its
+/// outputs, instead of restoring all the variables at load time. Fetching any
+/// other tensor, or running any other node, restores all the variables left.
+/// If `warm_up_in_background` is true, a background thread also restores the
+/// variables of each signature in turn after loading.
+///
+/// The init op still runs at load time, after restoring the variables it reads
+/// or assigns. Variables are matched by container and shared name, so a
+/// variable read through another node than the one the Saver restores is
+/// restored too. Only the variables restored by TF1 Savers can be restored
+/// lazily: the variables of other SavedModels are all restored at load time.
+absl::Status LoadSavedModelLazily(const SessionOptions& session_options,
+                                  const RunOptions& run_options,
+                                  const string& export_dir,
+                                  const std::unordered_set<string>& tags,
+                                  bool warm_up_in_background,
+                                  SavedModelBundleLite* bundle);
+
 /// Checks whether the provided directory could contain a SavedModel. Note that
 /// the method does not load any data by itself. If the method returns `false`,
 /// the export directory definitely does not contain a SavedModel. If the method
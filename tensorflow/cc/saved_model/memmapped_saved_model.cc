@@ -0,0 +1,119 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/cc/saved_model/memmapped_saved_model.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "tensorflow/cc/saved_model/constants.h"
+#include "tensorflow/cc/saved_model/reader.h"
+#include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/statusor.h"
+#include "tensorflow/core/protobuf/meta_graph.pb.h"
+#include "tensorflow/core/protobuf/saved_model.pb.h"
+#include "tensorflow/core/util/memmapped_file_system_writer.h"
+
+namespace tensorflow {
+
+const char* const kMemmappedSavedModelExportDir =
+    MemmappedFileSystem::kMemmappedPackagePrefix;
+
+namespace {
+
+// Appends to `relative_paths` the paths of the files under `dir` of `env`,
+// relative to `dir` and prefixed with `relative_dir`.
+absl::Status ListFiles(Env* env, const std::string& dir,
+                       const std::string& relative_dir,
+                       std::vector<std::string>* relative_paths) {
+  std::vector<std::string> children;
+  TF_RETURN_IF_ERROR(env->GetChildren(dir, &children));
+  std::sort(children.begin(), children.end());
+  for (const std::string& child : children) {
+    const std::string path = io::JoinPath(dir, child);
+    const std::string relative_path =
+        relative_dir.empty() ? child : io::JoinPath(relative_dir, child);
+    if (env->IsDirectory(path).ok()) {
+      TF_RETURN_IF_ERROR(ListFiles(env, path, relative_path, relative_paths));
+    } else {
+      relative_paths->push_back(relative_path);
+    }
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+absl::Status WriteMemmappedSavedModel(Env* env, const std::string& export_dir,
+                                      const std::string& package_filename) {
+  std::vector<std::string> relative_paths;
+  TF_RETURN_IF_ERROR(ListFiles(env, export_dir, "", &relative_paths));
+
+  MemmappedFileSystemWriter writer;
+  TF_RETURN_IF_ERROR(writer.InitializeToFile(env, package_filename));
+  for (const std::string& relative_path : relative_paths) {
+    TF_RETURN_WITH_CONTEXT_IF_ERROR(
+        writer.SaveFile(env, io::JoinPath(export_dir, relative_path),
+                        io::JoinPath(kMemmappedSavedModelExportDir,
+                                     relative_path)),
+        "when packaging the SavedModel ", export_dir);
+  }
+  return writer.FlushAndClose();
+}
+
+absl::Status LoadMemmappedSavedModel(const SessionOptions& session_options,
+                                     const RunOptions& run_options,
+                                     MemmappedEnv* env,
+                                     const std::unordered_set<string>& tags,
+                                     SavedModelBundleLite* const bundle) {
+  const std::string export_dir = kMemmappedSavedModelExportDir;
+  SavedModel saved_model_proto;
+  const std::string saved_model_pb_path =
+      io::JoinPath(export_dir, kSavedModelFilenamePb);
+  if (env->FileExists(saved_model_pb_path).ok()) {
+    TF_RETURN_IF_ERROR(
+        ReadBinaryProto(env, saved_model_pb_path, &saved_model_proto));
+  } else {
+    TF_RETURN_IF_ERROR(ReadTextProto(
+        env, io::JoinPath(export_dir, kSavedModelFilenamePbTxt),
+        &saved_model_proto));
+  }
+  TF_ASSIGN_OR_RETURN(MetaGraphDef * meta_graph_def,
+                      FindMetaGraphDef(tags, &saved_model_proto));
+
+  SessionOptions package_session_options(session_options);
+  package_session_options.env = env;
+  // Like LoadSavedModel() for a SavedModelBundleLite, the session doesn't
+  // keep the GraphDef.
+  package_session_options.config.mutable_experimental()
+      ->set_optimize_for_static_graph(true);
+  std::unique_ptr<Session> session;
+  TF_RETURN_IF_ERROR(LoadMetagraphIntoSession(package_session_options,
+                                              *meta_graph_def, &session));
+  TF_RETURN_IF_ERROR(
+      RestoreSession(run_options, *meta_graph_def, export_dir, env, &session));
+  *bundle = SavedModelBundleLite(
+      std::move(session), std::move(*meta_graph_def->mutable_signature_def()));
+  return absl::OkStatus();
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,73 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Packages whole SavedModels (the SavedModel proto, variables and assets) in
+// the memmapped format read by MemmappedFileSystem.
+//
+// A package is a single file, memory-mapped read-only when loaded: processes
+// loading the same package share its pages, and its files are read from the
+// mapping without going through the file system. Usage:
+//
+//   // Package.
+//   WriteMemmappedSavedModel(env, "/models/half_plus_two/1", "/models/hp2.mm");
+//
+//   // Load.
+//   MemmappedEnv memmapped_env(Env::Default());
+//   memmapped_env.InitializeFromFile("/models/hp2.mm");
+//   LoadMemmappedSavedModel(session_options, run_options, &memmapped_env,
+//                           {kSavedModelTagServe}, &bundle);
+
+#ifndef TENSORFLOW_CC_SAVED_MODEL_MEMMAPPED_SAVED_MODEL_H_
+#define TENSORFLOW_CC_SAVED_MODEL_MEMMAPPED_SAVED_MODEL_H_
+
+#include <string>
+#include <unordered_set>
+
+#include "absl/status/status.h"
+#include "tensorflow/cc/saved_model/loader.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/protobuf/config.pb.h"
+#include "tensorflow/core/public/session_options.h"
+#include "tensorflow/core/util/memmapped_file_system.h"
+
+namespace tensorflow {
+
+// The export directory of the SavedModel of a package, in a MemmappedEnv
+// initialized from it. The paths of the assets fed to the graph start with it.
+extern const char* const kMemmappedSavedModelExportDir;
+
+// Writes each file of the SavedModel in `export_dir` of `env` to the package
+// `package_filename`, in a page-aligned region named after the path of the
+// file relative to `export_dir`. The relative paths may only include
+// [A-Za-z0-9_.-/].
+absl::Status WriteMemmappedSavedModel(Env* env, const std::string& export_dir,
+                                      const std::string& package_filename);
+
+// Loads the SavedModel of the package `env` was initialized from, like the
+// SavedModelBundleLite overload of LoadSavedModel(): the session runs in `env`
+// (overriding `session_options.env`), so that it restores the variables from
+// the package. `env` must outlive `bundle`.
+//
+// The init op is fed the paths of the assets in the package: the ops reading
+// them must use the Env of their kernel to open them.
+absl::Status LoadMemmappedSavedModel(const SessionOptions& session_options,
+                                     const RunOptions& run_options,
+                                     MemmappedEnv* env,
+                                     const std::unordered_set<string>& tags,
+                                     SavedModelBundleLite* bundle);
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CC_SAVED_MODEL_MEMMAPPED_SAVED_MODEL_H_
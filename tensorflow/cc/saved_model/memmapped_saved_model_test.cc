@@ -0,0 +1,88 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/cc/saved_model/memmapped_saved_model.h"
+
+#include <string>
+#include <vector>
+
+#include "tensorflow/cc/saved_model/loader.h"
+#include "tensorflow/cc/saved_model/signature_constants.h"
+#include "tensorflow/cc/saved_model/tag_constants.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/util/memmapped_file_system.h"
+
+namespace tensorflow {
+namespace {
+
+constexpr char kTestData[] = "cc/saved_model/testdata/half_plus_two/00000123";
+
+TEST(MemmappedSavedModelTest, WriteAndLoad) {
+  const string export_dir =
+      io::JoinPath(testing::TensorFlowSrcRoot(), kTestData);
+  const string package_filename =
+      io::JoinPath(testing::TmpDir(), "half_plus_two.memmapped");
+  TF_ASSERT_OK(
+      WriteMemmappedSavedModel(Env::Default(), export_dir, package_filename));
+
+  MemmappedEnv memmapped_env(Env::Default());
+  TF_ASSERT_OK(memmapped_env.InitializeFromFile(package_filename));
+  TF_EXPECT_OK(memmapped_env.FileExists(io::JoinPath(
+      kMemmappedSavedModelExportDir, "variables/variables.index")));
+
+  SavedModelBundleLite bundle;
+  TF_ASSERT_OK(LoadMemmappedSavedModel(SessionOptions(), RunOptions(),
+                                       &memmapped_env, {kSavedModelTagServe},
+                                       &bundle));
+
+  // The variables are restored from the package.
+  const SignatureDef& signature_def =
+      bundle.GetSignatures().at(kDefaultServingSignatureDefKey);
+  const string input_name = signature_def.inputs().at("x").name();
+  const string output_name = signature_def.outputs().at("y").name();
+  std::vector<Tensor> outputs;
+  TF_ASSERT_OK(bundle.GetSession()->Run(
+      {{input_name, test::AsTensor<float>({0, 1, 2, 3}, TensorShape({4, 1}))}},
+      {output_name}, {}, &outputs));
+  ASSERT_EQ(outputs.size(), 1);
+  test::ExpectTensorEqual<float>(
+      outputs[0], test::AsTensor<float>({2, 2.5, 3, 3.5}, TensorShape({4, 1})));
+}
+
+TEST(MemmappedSavedModelTest, MissingSavedModel) {
+  const string package_filename =
+      io::JoinPath(testing::TmpDir(), "not_a_saved_model.memmapped");
+  const string dir = io::JoinPath(testing::TmpDir(), "not_a_saved_model");
+  TF_ASSERT_OK(Env::Default()->RecursivelyCreateDir(dir));
+  TF_ASSERT_OK(
+      WriteStringToFile(Env::Default(), io::JoinPath(dir, "file"), "data"));
+  TF_ASSERT_OK(
+      WriteMemmappedSavedModel(Env::Default(), dir, package_filename));
+
+  MemmappedEnv memmapped_env(Env::Default());
+  TF_ASSERT_OK(memmapped_env.InitializeFromFile(package_filename));
+  SavedModelBundleLite bundle;
+  EXPECT_FALSE(LoadMemmappedSavedModel(SessionOptions(), RunOptions(),
+                                       &memmapped_env, {kSavedModelTagServe},
+                                       &bundle)
+                   .ok());
+}
+
+}  // namespace
+}  // namespace tensorflow
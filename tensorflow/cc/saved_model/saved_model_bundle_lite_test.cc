@@ -19,14 +19,17 @@ limitations under the License.
 #include "tensorflow/cc/saved_model/tag_constants.h"
 #include "tensorflow/core/example/example.pb.h"
 #include "tensorflow/core/example/feature.pb.h"
+#include "tensorflow/core/framework/node_def_util.h"
 #include "tensorflow/core/framework/tensor_testutil.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
 #include "tensorflow/core/lib/io/path.h"
 #include "tensorflow/core/lib/strings/str_util.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/test.h"
 #include "tensorflow/core/protobuf/config.pb.h"
+#include "tensorflow/core/protobuf/saved_model.pb.h"
 
 namespace tensorflow {
 namespace {
@@ -261,5 +264,133 @@ TEST_F(LoaderTest, SavedModelInitOpV2Format) {
   CheckSavedModelBundle(export_dir, bundle);
 }
 
+TEST_F(LoaderTest, LazyRestore) {
+  SavedModelBundleLite bundle;
+  SessionOptions session_options;
+  RunOptions run_options;
+
+  const string export_dir =
+      io::JoinPath(testing::TensorFlowSrcRoot(), kTestDataSharded);
+  TF_ASSERT_OK(LoadSavedModelLazily(session_options, run_options, export_dir,
+                                    {kSavedModelTagServe},
+                                    /*warm_up_in_background=*/false, &bundle));
+
+  // Restores a and c, but not b.
+  const auto& signature_def = bundle.GetSignatures().at("regress_x2_to_y3");
+  const string input_name = signature_def.inputs().at(kRegressInputs).name();
+  const string output_name =
+      signature_def.outputs().at(kRegressOutputs).name();
+  Tensor input = test::AsTensor<float>({0, 1}, TensorShape({2, 1}));
+  std::vector<Tensor> outputs;
+  TF_ASSERT_OK(bundle.GetSession()->Run({{input_name, input}}, {output_name},
+                                        {}, &outputs));
+  ASSERT_EQ(outputs.size(), 1);
+  test::ExpectTensorEqual<float>(
+      outputs[0], test::AsTensor<float>({3, 3.5}, TensorShape({2, 1})));
+
+  // Restores b.
+  CheckSavedModelBundle(export_dir, bundle);
+}
+
+TEST_F(LoaderTest, LazyRestoreCallable) {
+  SavedModelBundleLite bundle;
+  SessionOptions session_options;
+  RunOptions run_options;
+
+  const string export_dir =
+      io::JoinPath(testing::TensorFlowSrcRoot(), kTestDataPbTxt);
+  TF_ASSERT_OK(LoadSavedModelLazily(session_options, run_options, export_dir,
+                                    {kSavedModelTagServe},
+                                    /*warm_up_in_background=*/false, &bundle));
+
+  const auto& signature_def = bundle.GetSignatures().at("serving_default");
+  CallableOptions callable_options;
+  callable_options.add_feed(signature_def.inputs().at("x").name());
+  callable_options.add_fetch(signature_def.outputs().at("y").name());
+  Session::CallableHandle handle;
+  TF_ASSERT_OK(bundle.GetSession()->MakeCallable(callable_options, &handle));
+  std::vector<Tensor> outputs;
+  TF_ASSERT_OK(bundle.GetSession()->RunCallable(
+      handle, {test::AsTensor<float>({0, 2}, TensorShape({2, 1}))}, &outputs,
+      nullptr));
+  ASSERT_EQ(outputs.size(), 1);
+  test::ExpectTensorEqual<float>(
+      outputs[0], test::AsTensor<float>({2, 3}, TensorShape({2, 1})));
+  TF_ASSERT_OK(bundle.GetSession()->ReleaseCallable(handle));
+}
+
+TEST_F(LoaderTest, LazyRestoreInitOpReadsVariable) {
+  // Copy the SavedModel, with a legacy init op that assigns the value of `b`
+  // to a new variable `d`. The init op reads `b` through another node with
+  // the same shared name.
+  const string src_dir =
+      io::JoinPath(testing::TensorFlowSrcRoot(), kTestDataPbTxt);
+  const string export_dir =
+      io::JoinPath(testing::TmpDir(), "lazy_restore_init_op");
+  Env* env = Env::Default();
+  for (const string& dir : {kSavedModelAssetsDirectory,
+                            kSavedModelVariablesDirectory}) {
+    TF_ASSERT_OK(env->RecursivelyCreateDir(io::JoinPath(export_dir, dir)));
+  }
+  for (const string& file : {"assets/foo.txt", "variables/variables.index",
+                             "variables/variables.data-00000-of-00001"}) {
+    TF_ASSERT_OK(env->CopyFile(io::JoinPath(src_dir, file),
+                               io::JoinPath(export_dir, file)));
+  }
+  SavedModel saved_model;
+  TF_ASSERT_OK(ReadTextProto(
+      env, io::JoinPath(src_dir, kSavedModelFilenamePbTxt), &saved_model));
+  GraphDef* graph_def = saved_model.mutable_meta_graphs(0)->mutable_graph_def();
+  for (const string& name : {"b_alias", "d"}) {
+    NodeDef* variable = graph_def->add_node();
+    variable->set_name(name);
+    variable->set_op("VariableV2");
+    AddNodeAttr("shape", TensorShape({}), variable);
+    AddNodeAttr("dtype", DT_FLOAT, variable);
+    AddNodeAttr("container", "", variable);
+    AddNodeAttr("shared_name", name == "d" ? "" : "b", variable);
+  }
+  NodeDef* assign = graph_def->add_node();
+  assign->set_name("d/Assign");
+  assign->set_op("Assign");
+  assign->add_input("d");
+  assign->add_input("b_alias");
+  AddNodeAttr("T", DT_FLOAT, assign);
+  AddNodeAttr("validate_shape", true, assign);
+  AddNodeAttr("use_locking", true, assign);
+  for (NodeDef& node : *graph_def->mutable_node()) {
+    if (node.name() == "group_deps") node.add_input("^d/Assign");
+  }
+  TF_ASSERT_OK(WriteTextProto(
+      env, io::JoinPath(export_dir, kSavedModelFilenamePbTxt), saved_model));
+
+  SavedModelBundleLite bundle;
+  SessionOptions session_options;
+  RunOptions run_options;
+  TF_ASSERT_OK(LoadSavedModelLazily(session_options, run_options, export_dir,
+                                    {kSavedModelTagServe},
+                                    /*warm_up_in_background=*/false, &bundle));
+  std::vector<Tensor> outputs;
+  TF_ASSERT_OK(bundle.GetSession()->Run({}, {"d:0"}, {}, &outputs));
+  ASSERT_EQ(outputs.size(), 1);
+  test::ExpectTensorEqual<float>(outputs[0], test::AsScalar<float>(2));
+  CheckSavedModelBundle(export_dir, bundle);
+}
+
+TEST_F(LoaderTest, LazyRestoreWarmUp) {
+  SessionOptions session_options;
+  RunOptions run_options;
+
+  const string export_dir =
+      io::JoinPath(testing::TensorFlowSrcRoot(), kTestDataMainOp);
+  for (int i = 0; i < 10; ++i) {
+    SavedModelBundleLite bundle;
+    TF_ASSERT_OK(LoadSavedModelLazily(
+        session_options, run_options, export_dir, {kSavedModelTagServe},
+        /*warm_up_in_background=*/true, &bundle));
+    CheckSavedModelBundle(export_dir, bundle);
+  }
+}
+
 }  // namespace
 }  // namespace tensorflow
@@ -0,0 +1,328 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/cc/saved_model/warmup.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tensorflow/cc/saved_model/constants.h"
+#include "tensorflow/cc/saved_model/signature_constants.h"
+#include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/kernels/batching_util/warmup.h"
+#include "tensorflow/core/lib/core/threadpool.h"
+#include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/lib/io/record_reader.h"
+#include "tensorflow/core/platform/blocking_counter.h"
+#include "tensorflow/core/platform/coding.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/statusor.h"
+
+namespace tensorflow {
+namespace {
+
+// Field numbers of the TensorFlow Serving messages of warmup files, which are
+// decoded directly since their protos are not part of TensorFlow.
+constexpr uint32 kPredictionLogPredictLog = 6;
+constexpr uint32 kPredictLogRequest = 1;
+constexpr uint32 kPredictRequestModelSpec = 1;
+constexpr uint32 kPredictRequestInputs = 2;
+constexpr uint32 kModelSpecSignatureName = 3;
+constexpr uint32 kMapEntryKey = 1;
+constexpr uint32 kMapEntryValue = 2;
+
+// Protocol buffer wire types.
+constexpr uint32 kVarint = 0;
+constexpr uint32 kFixed64 = 1;
+constexpr uint32 kLengthDelimited = 2;
+constexpr uint32 kFixed32 = 5;
+
+// Calls `fn` with the number and value of each length delimited field of the
+// serialized message `message`, skipping the other fields.
+template <typename Fn>
+absl::Status ForEachLengthDelimitedField(absl::string_view message, Fn fn) {
+  while (!message.empty()) {
+    uint32 tag;
+    if (!core::GetVarint32(&message, &tag)) {
+      return errors::DataLoss("Invalid warmup request field tag");
+    }
+    const uint32 number = tag >> 3;
+    bool ok = true;
+    switch (tag & 7) {
+      case kVarint: {
+        uint64 value;
+        ok = core::GetVarint64(&message, &value);
+        break;
+      }
+      case kFixed64:
+        ok = message.size() >= 8;
+        if (ok) message.remove_prefix(8);
+        break;
+      case kFixed32:
+        ok = message.size() >= 4;
+        if (ok) message.remove_prefix(4);
+        break;
+      case kLengthDelimited: {
+        uint32 size;
+        ok = core::GetVarint32(&message, &size) && message.size() >= size;
+        if (ok) {
+          TF_RETURN_IF_ERROR(fn(number, message.substr(0, size)));
+          message.remove_prefix(size);
+        }
+        break;
+      }
+      default:
+        ok = false;
+    }
+    if (!ok) {
+      return errors::DataLoss("Invalid warmup request field ", number);
+    }
+  }
+  return absl::OkStatus();
+}
+
+// Decodes the serialized TensorFlow Serving PredictRequest `message`.
+absl::Status DecodePredictRequest(absl::string_view message,
+                                  WarmupRequest* request) {
+  return ForEachLengthDelimitedField(
+      message, [request](uint32 number, absl::string_view value) {
+        if (number == kPredictRequestModelSpec) {
+          return ForEachLengthDelimitedField(
+              value, [request](uint32 number, absl::string_view value) {
+                if (number == kModelSpecSignatureName) {
+                  request->signature_name = std::string(value);
+                }
+                return absl::OkStatus();
+              });
+        }
+        if (number != kPredictRequestInputs) return absl::OkStatus();
+        std::string key;
+        TensorProto proto;
+        TF_RETURN_IF_ERROR(ForEachLengthDelimitedField(
+            value, [&](uint32 number, absl::string_view value) {
+              if (number == kMapEntryKey) {
+                key = std::string(value);
+              } else if (number == kMapEntryValue &&
+                         !proto.ParseFromArray(value.data(), value.size())) {
+                return errors::DataLoss("Invalid warmup request tensor");
+              }
+              return absl::OkStatus();
+            }));
+        Tensor tensor;
+        if (!tensor.FromProto(proto)) {
+          return errors::DataLoss("Invalid warmup request tensor ", key);
+        }
+        request->inputs.emplace_back(std::move(key), std::move(tensor));
+        return absl::OkStatus();
+      });
+}
+
+void AddLatencyStats(std::vector<int64_t> latencies, int64_t num_errors,
+                     WarmupLatencyStats* stats) {
+  stats->num_runs = latencies.size() + num_errors;
+  stats->num_errors = num_errors;
+  if (latencies.empty()) return;
+  std::sort(latencies.begin(), latencies.end());
+  stats->min_micros = latencies.front();
+  stats->median_micros = latencies[latencies.size() / 2];
+  stats->p99_micros = latencies[latencies.size() * 99 / 100];
+  stats->max_micros = latencies.back();
+}
+
+}  // namespace
+
+absl::Status ReadWarmupRequests(const std::string& filename,
+                                std::vector<WarmupRequest>* requests) {
+  std::unique_ptr<RandomAccessFile> file;
+  TF_RETURN_IF_ERROR(Env::Default()->NewRandomAccessFile(filename, &file));
+  io::SequentialRecordReader reader(file.get());
+  int64_t num_skipped = 0;
+  tstring record;
+  while (true) {
+    const absl::Status status = reader.ReadRecord(&record);
+    if (errors::IsOutOfRange(status)) break;
+    TF_RETURN_IF_ERROR(status);
+    bool is_predict_log = false;
+    TF_RETURN_IF_ERROR(ForEachLengthDelimitedField(
+        absl::string_view(record.data(), record.size()),
+        [&](uint32 number, absl::string_view value) {
+          if (number != kPredictionLogPredictLog) return absl::OkStatus();
+          is_predict_log = true;
+          return ForEachLengthDelimitedField(
+              value, [&](uint32 number, absl::string_view value) {
+                if (number != kPredictLogRequest) return absl::OkStatus();
+                return DecodePredictRequest(value, &requests->emplace_back());
+              });
+        }));
+    if (!is_predict_log) ++num_skipped;
+  }
+  if (num_skipped > 0) {
+    LOG(WARNING) << "Skipped " << num_skipped
+                 << " warmup requests other than PredictRequests in "
+                 << filename;
+  }
+  return absl::OkStatus();
+}
+
+std::string WarmupReportToString(const WarmupReport& report) {
+  std::string result;
+  for (const auto& [signature_name, stats] : report) {
+    absl::StrAppend(&result, signature_name, ": ", stats.num_runs, " runs, ",
+                    stats.num_errors, " errors, latency min ",
+                    stats.min_micros, "us, median ", stats.median_micros,
+                    "us, p99 ", stats.p99_micros, "us, max ", stats.max_micros,
+                    "us\n");
+  }
+  return result;
+}
+
+absl::Status RunWarmupRequests(const SavedModelBundleInterface& bundle,
+                               absl::Span<const WarmupRequest> requests,
+                               const WarmupOptions& options,
+                               WarmupReport* report) {
+  serving::WarmupStateRegistry::Handle warmup_handle;
+  if (options.warmup_all_batch_sizes &&
+      !options.session_metadata.name().empty()) {
+    auto per_model_data =
+        std::make_unique<serving::WarmupStateRegistry::PerModelData>();
+    per_model_data->warmup_all_batch_sizes = true;
+    TF_ASSIGN_OR_RETURN(
+        warmup_handle,
+        serving::GetGlobalWarmupStateRegistry().Register(
+            {options.session_metadata.name(),
+             options.session_metadata.version()},
+            std::move(per_model_data)));
+  }
+
+  // Resolve the tensors of each request.
+  struct Run {
+    const std::string* signature_name;
+    std::vector<std::pair<std::string, Tensor>> inputs;
+    std::vector<std::string> output_tensor_names;
+  };
+  std::vector<Run> runs;
+  runs.reserve(requests.size());
+  std::set<std::string> signature_names;
+  for (const WarmupRequest& request : requests) {
+    const std::string& signature_name = request.signature_name.empty()
+                                            ? kDefaultServingSignatureDefKey
+                                            : request.signature_name;
+    const auto signature = bundle.GetSignatures().find(signature_name);
+    if (signature == bundle.GetSignatures().end()) {
+      return errors::NotFound("Warmup request signature ", signature_name,
+                              " not found");
+    }
+    Run& run = runs.emplace_back();
+    run.signature_name = &signature->first;
+    signature_names.insert(signature_name);
+    for (const auto& [key, tensor] : request.inputs) {
+      const auto input = signature->second.inputs().find(key);
+      if (input == signature->second.inputs().end() ||
+          input->second.name().empty()) {
+        return errors::InvalidArgument("Signature ", signature_name,
+                                       " has no dense input ", key);
+      }
+      run.inputs.emplace_back(input->second.name(), tensor);
+    }
+    for (const auto& output : signature->second.outputs()) {
+      if (output.second.name().empty()) {
+        return errors::Unimplemented("Signature ", signature_name,
+                                     " has a non-dense output ",
+                                     output.first);
+      }
+      run.output_tensor_names.push_back(output.second.name());
+    }
+  }
+
+  mutex mu;
+  absl::Status status;
+  std::map<std::string, std::vector<int64_t>> latencies;
+  std::map<std::string, int64_t> num_errors;
+  const int num_iterations = std::max(options.num_iterations, 0);
+  {
+    thread::ThreadPool pool(Env::Default(), "saved_model_warmup",
+                            std::max(options.num_threads, 1));
+    for (int i = 0; i < num_iterations; ++i) {
+      for (const Run& run : runs) {
+        pool.Schedule([&bundle, &run, &mu, &status, &latencies,
+                       &num_errors]() {
+          std::vector<Tensor> outputs;
+          const uint64 start_micros = Env::Default()->NowMicros();
+          const absl::Status run_status = bundle.GetSession()->Run(
+              run.inputs, run.output_tensor_names, {}, &outputs);
+          const int64_t latency_micros =
+              Env::Default()->NowMicros() - start_micros;
+          mutex_lock l(mu);
+          if (run_status.ok()) {
+            latencies[*run.signature_name].push_back(latency_micros);
+          } else {
+            ++num_errors[*run.signature_name];
+            status.Update(run_status);
+          }
+        });
+      }
+    }
+    // Waits for the runs when going out of scope.
+  }
+
+  if (report != nullptr) {
+    for (const std::string& signature_name : signature_names) {
+      AddLatencyStats(std::move(latencies[signature_name]),
+                      num_errors[signature_name], &(*report)[signature_name]);
+    }
+  }
+  return status;
+}
+
+absl::Status WarmUpSavedModel(const std::string& export_dir,
+                              const SavedModelBundleInterface& bundle,
+                              const WarmupOptions& options,
+                              WarmupReport* report) {
+  const std::string filename =
+      io::JoinPath(export_dir, kSavedModelAssetsExtraDirectory,
+                   kSavedModelWarmupRequestsFilename);
+  if (!Env::Default()->FileExists(filename).ok()) {
+    VLOG(1) << "No warmup requests in " << export_dir;
+    return absl::OkStatus();
+  }
+  std::vector<WarmupRequest> requests;
+  TF_RETURN_IF_ERROR(ReadWarmupRequests(filename, &requests));
+  WarmupReport local_report;
+  if (report == nullptr) report = &local_report;
+  const uint64 start_micros = Env::Default()->NowMicros();
+  const absl::Status status =
+      RunWarmupRequests(bundle, requests, options, report);
+  LOG(INFO) << "Ran " << requests.size() << " warmup requests "
+            << options.num_iterations << " times for SavedModel "
+            << export_dir << " in "
+            << Env::Default()->NowMicros() - start_micros << "us: " << status
+            << "\n"
+            << WarmupReportToString(*report);
+  return status;
+}
+
+}  // namespace tensorflow
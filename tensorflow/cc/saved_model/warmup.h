@@ -0,0 +1,98 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Replays the warmup requests of a SavedModel, to fill the caches of its
+// session (executors, compiled kernels) before serving demand requests.
+
+#ifndef TENSORFLOW_CC_SAVED_MODEL_WARMUP_H_
+#define TENSORFLOW_CC_SAVED_MODEL_WARMUP_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/types/span.h"
+#include "tensorflow/cc/saved_model/loader.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/protobuf/config.pb.h"
+
+namespace tensorflow {
+
+// A request running a signature of a SavedModel.
+struct WarmupRequest {
+  // Key of the signature, defaults to "serving_default" if empty.
+  std::string signature_name;
+
+  // Input tensors, by signature input key.
+  std::vector<std::pair<std::string, Tensor>> inputs;
+};
+
+// Reads the requests of a `tf_serving_warmup_requests` file: a TFRecord file
+// of TensorFlow Serving PredictionLogs. Only the PredictRequests of
+// PredictLogs are read; the other logs are skipped.
+absl::Status ReadWarmupRequests(const std::string& filename,
+                                std::vector<WarmupRequest>* requests);
+
+struct WarmupOptions {
+  // Number of requests run concurrently.
+  int num_threads = 4;
+
+  // Number of times each request is run.
+  int num_iterations = 1;
+
+  // If true, and the session was created with `session_metadata`, batch ops
+  // run every warmup batch with each of their allowed batch sizes, so that
+  // requests don't need to be logged with each batch size.
+  bool warmup_all_batch_sizes = false;
+  SessionMetadata session_metadata;
+};
+
+// Latencies of the runs of a signature.
+struct WarmupLatencyStats {
+  int64_t num_runs = 0;
+  int64_t num_errors = 0;
+  int64_t min_micros = 0;
+  int64_t median_micros = 0;
+  int64_t p99_micros = 0;
+  int64_t max_micros = 0;
+};
+
+// Latency stats, by signature key.
+using WarmupReport = std::map<std::string, WarmupLatencyStats>;
+
+// Returns a human readable report, with a line per signature.
+std::string WarmupReportToString(const WarmupReport& report);
+
+// Runs `requests` in the session of `bundle`, `options.num_threads` at a time,
+// and records the latency of each signature in `report`, if not null. Returns
+// the first error of a run, after running all the requests.
+absl::Status RunWarmupRequests(const SavedModelBundleInterface& bundle,
+                               absl::Span<const WarmupRequest> requests,
+                               const WarmupOptions& options,
+                               WarmupReport* report);
+
+// Runs the warmup requests of the SavedModel in `export_dir`, if it has any,
+// and logs the report.
+absl::Status WarmUpSavedModel(const std::string& export_dir,
+                              const SavedModelBundleInterface& bundle,
+                              const WarmupOptions& options,
+                              WarmupReport* report);
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CC_SAVED_MODEL_WARMUP_H_
@@ -0,0 +1,160 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/cc/saved_model/warmup.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tensorflow/cc/saved_model/loader.h"
+#include "tensorflow/cc/saved_model/tag_constants.h"
+#include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/lib/io/record_writer.h"
+#include "tensorflow/core/platform/coding.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+constexpr char kTestData[] = "cc/saved_model/testdata/half_plus_two/00000123";
+
+// Returns the length delimited protocol buffer field `number` of `value`.
+std::string Field(uint32 number, const std::string& value) {
+  std::string field;
+  core::PutVarint32(&field, number << 3 | 2);
+  core::PutVarint32(&field, value.size());
+  return field + value;
+}
+
+// Returns a serialized PredictionLog of a PredictRequest feeding `x`.
+std::string PredictionLog(const std::string& signature_name,
+                          const Tensor& x) {
+  TensorProto proto;
+  x.AsProtoTensorContent(&proto);
+  const std::string model_spec =
+      Field(1, "half_plus_two") + Field(3, signature_name);
+  const std::string input =
+      Field(1, "x") + Field(2, proto.SerializeAsString());
+  const std::string request = Field(1, model_spec) + Field(2, input);
+  return Field(6, Field(1, request));
+}
+
+void WriteWarmupRequests(const std::string& filename,
+                         const std::vector<std::string>& logs) {
+  std::unique_ptr<WritableFile> file;
+  TF_ASSERT_OK(Env::Default()->NewWritableFile(filename, &file));
+  io::RecordWriter writer(file.get());
+  for (const std::string& log : logs) TF_ASSERT_OK(writer.WriteRecord(log));
+  TF_ASSERT_OK(writer.Close());
+  TF_ASSERT_OK(file->Close());
+}
+
+TEST(WarmupTest, ReadWarmupRequests) {
+  const std::string filename = io::JoinPath(testing::TmpDir(), "warmup_read");
+  // The second log is a ClassifyLog, which is skipped.
+  WriteWarmupRequests(
+      filename,
+      {PredictionLog("", test::AsTensor<float>({1, 2}, TensorShape({2, 1}))),
+       Field(2, Field(1, "")),
+       PredictionLog("other", test::AsTensor<float>({3}, TensorShape({1})))});
+
+  std::vector<WarmupRequest> requests;
+  TF_ASSERT_OK(ReadWarmupRequests(filename, &requests));
+  ASSERT_EQ(requests.size(), 2);
+  EXPECT_EQ(requests[0].signature_name, "");
+  ASSERT_EQ(requests[0].inputs.size(), 1);
+  EXPECT_EQ(requests[0].inputs[0].first, "x");
+  test::ExpectTensorEqual<float>(
+      requests[0].inputs[0].second,
+      test::AsTensor<float>({1, 2}, TensorShape({2, 1})));
+  EXPECT_EQ(requests[1].signature_name, "other");
+}
+
+TEST(WarmupTest, ReadInvalidWarmupRequests) {
+  const std::string filename =
+      io::JoinPath(testing::TmpDir(), "warmup_invalid");
+  WriteWarmupRequests(filename, {"\x32\x10truncated"});
+  std::vector<WarmupRequest> requests;
+  EXPECT_TRUE(errors::IsDataLoss(ReadWarmupRequests(filename, &requests)));
+}
+
+TEST(WarmupTest, RunWarmupRequests) {
+  SavedModelBundleLite bundle;
+  const std::string export_dir =
+      io::JoinPath(testing::TensorFlowSrcRoot(), kTestData);
+  TF_ASSERT_OK(LoadSavedModel(SessionOptions(), RunOptions(), export_dir,
+                              {kSavedModelTagServe}, &bundle));
+
+  std::vector<WarmupRequest> requests(3);
+  for (int i = 0; i < 3; ++i) {
+    requests[i].inputs.emplace_back(
+        "x", test::AsTensor<float>(std::vector<float>(i + 1, 1.0f),
+                                   TensorShape({i + 1, 1})));
+  }
+  WarmupOptions options;
+  options.num_iterations = 4;
+  WarmupReport report;
+  TF_ASSERT_OK(RunWarmupRequests(bundle, requests, options, &report));
+  ASSERT_EQ(report.size(), 1);
+  const WarmupLatencyStats& stats = report["serving_default"];
+  EXPECT_EQ(stats.num_runs, 12);
+  EXPECT_EQ(stats.num_errors, 0);
+  EXPECT_LE(stats.min_micros, stats.median_micros);
+  EXPECT_LE(stats.median_micros, stats.p99_micros);
+  EXPECT_LE(stats.p99_micros, stats.max_micros);
+  EXPECT_NE(WarmupReportToString(report).find("serving_default: 12 runs"),
+            std::string::npos);
+}
+
+TEST(WarmupTest, RunWarmupRequestsErrors) {
+  SavedModelBundleLite bundle;
+  const std::string export_dir =
+      io::JoinPath(testing::TensorFlowSrcRoot(), kTestData);
+  TF_ASSERT_OK(LoadSavedModel(SessionOptions(), RunOptions(), export_dir,
+                              {kSavedModelTagServe}, &bundle));
+
+  std::vector<WarmupRequest> requests(1);
+  requests[0].signature_name = "missing";
+  EXPECT_TRUE(errors::IsNotFound(
+      RunWarmupRequests(bundle, requests, WarmupOptions(), nullptr)));
+
+  // x must be a float tensor.
+  requests[0].signature_name = "serving_default";
+  requests[0].inputs.emplace_back(
+      "x", test::AsTensor<int32>({1}, TensorShape({1, 1})));
+  WarmupReport report;
+  EXPECT_FALSE(
+      RunWarmupRequests(bundle, requests, WarmupOptions(), &report).ok());
+  EXPECT_EQ(report["serving_default"].num_errors, 1);
+}
+
+TEST(WarmupTest, WarmUpSavedModelWithoutRequests) {
+  SavedModelBundleLite bundle;
+  const std::string export_dir =
+      io::JoinPath(testing::TensorFlowSrcRoot(), kTestData);
+  TF_ASSERT_OK(LoadSavedModel(SessionOptions(), RunOptions(), export_dir,
+                              {kSavedModelTagServe}, &bundle));
+  WarmupReport report;
+  TF_EXPECT_OK(WarmUpSavedModel(export_dir, bundle, WarmupOptions(), &report));
+  EXPECT_TRUE(report.empty());
+}
+
+}  // namespace
+}  // namespace tensorflow
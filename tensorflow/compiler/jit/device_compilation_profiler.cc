@@ -21,6 +21,7 @@ limitations under the License.
 #include <utility>
 
 #include "absl/strings/str_cat.h"
+#include "tensorflow/compiler/jit/flags.h"
 #include "tensorflow/compiler/jit/xla_activity.pb.h"
 #include "tensorflow/compiler/jit/xla_activity_listener.h"
 #include "tensorflow/core/framework/attr_value.pb.h"
@@ -32,14 +33,16 @@ limitations under the License.
 namespace tensorflow {
 namespace {
 bool ShouldBeMegamorphic(int64_t compile_count, int64_t execution_count) {
-  const int64_t kCompileThreshold = 10;
-  const int64_t kMinExecutionsPerCompile = 50;
+  const XlaOpsCommonFlags& flags = *GetXlaOpsCommonFlags();
+  const int64_t compile_threshold = flags.tf_xla_megamorphic_compile_threshold;
+  const int64_t min_executions_per_compile =
+      flags.tf_xla_megamorphic_min_executions_per_compile;
 
   // This heuristic is trying to capture the following property: have we sunk a
   // certain minimum amount of compile time into the cluster that didn't quite
   // "pay off"?
-  return compile_count > kCompileThreshold &&
-         execution_count < kMinExecutionsPerCompile * compile_count;
+  return compile_count > compile_threshold &&
+         execution_count < min_executions_per_compile * compile_count;
 }
 
 void RegisterExecutionForCluster(
@@ -63,7 +66,8 @@ void RegisterExecutionForCluster(
 constexpr int64_t kDefaultCompilationThreshold = 2;
 
 // Maximum number of ongoing compilations.
-constexpr int64_t kMaxNumOngoingCompilations = kNumAsyncDeviceCompilerThreads;
+constexpr int64_t kMaxNumOngoingCompilations =
+    kMaxNumPendingAsyncDeviceCompilations;
 
 }  // namespace
 
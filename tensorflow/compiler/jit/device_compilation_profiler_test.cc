@@ -21,6 +21,7 @@ limitations under the License.
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "tensorflow/compiler/jit/flags.h"
 #include "tensorflow/compiler/jit/tests/device_compiler_test_helper.h"
 #include "tensorflow/compiler/jit/xla_activity.pb.h"
 #include "tensorflow/core/framework/attr_value.pb.h"
@@ -182,6 +183,44 @@ TEST(DeviceCompilationProfilerTest, ShouldCompileClusterMegamorphic) {
       profiler->ShouldCompileCluster(function, DeviceCompileMode::kStrict, 0));
 }
 
+TEST(DeviceCompilationProfilerTest, MegamorphicThresholdsFromFlags) {
+  XlaOpsCommonFlags* flags = GetXlaOpsCommonFlags();
+  const XlaOpsCommonFlags saved_flags = *flags;
+  flags->tf_xla_megamorphic_compile_threshold = 20;
+  flags->tf_xla_megamorphic_min_executions_per_compile = 2;
+
+  DeviceCompilationProfiler* profiler = new DeviceCompilationProfiler();
+  core::ScopedUnref profiler_ref(profiler);
+
+  NameAttrList function;
+  function.set_name("TestFunc");
+
+  // More compilations than the default threshold don't make the cluster
+  // megamorphic.
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_TRUE(profiler->RegisterCompilation(function, 1, false).ok());
+  }
+  for (int i = 0; i < 41; ++i) {
+    profiler->RegisterExecution(function);
+  }
+  TF_ASSERT_OK_AND_ASSIGN(auto stats, profiler->GetCompileStats(function));
+  EXPECT_FALSE(stats.is_megamorphic);
+
+  // Past the threshold, 2 executions per compilation are enough.
+  EXPECT_TRUE(profiler->RegisterCompilation(function, 1, false).ok());
+  profiler->RegisterExecution(function);
+  TF_ASSERT_OK_AND_ASSIGN(stats, profiler->GetCompileStats(function));
+  EXPECT_FALSE(stats.is_megamorphic);
+
+  // Fewer make the cluster megamorphic.
+  EXPECT_TRUE(profiler->RegisterCompilation(function, 1, false).ok());
+  profiler->RegisterExecution(function);
+  TF_ASSERT_OK_AND_ASSIGN(stats, profiler->GetCompileStats(function));
+  EXPECT_TRUE(stats.is_megamorphic);
+
+  *flags = saved_flags;
+}
+
 TEST(DeviceCompilationProfilerTest, ShouldCompileClusterAsync) {
   DeviceCompilationProfiler* profiler = new DeviceCompilationProfiler();
   core::ScopedUnref profiler_ref(profiler);
@@ -189,7 +228,7 @@ TEST(DeviceCompilationProfilerTest, ShouldCompileClusterAsync) {
   NameAttrList function;
   function.set_name("TestFunc");
 
-  const int64_t kMaxNumOngoingCompilations = 10;
+  const int64_t kMaxNumOngoingCompilations = 40;
   for (int i = 0; i < kMaxNumOngoingCompilations; ++i) {
     profiler->IncrementOngoingAsyncCompilations();
   }
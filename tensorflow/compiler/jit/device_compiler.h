@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_COMPILER_JIT_DEVICE_COMPILER_H_
 #define TENSORFLOW_COMPILER_JIT_DEVICE_COMPILER_H_
 
+#include <functional>
 #include <memory>
 #include <numeric>
 #include <optional>
@@ -116,6 +117,17 @@ class DeviceCompiler : public ResourceBase {
       const XlaCompiler::CompilationResult** out_compilation_result,
       ExecutableType** out_executable);
 
+  // Records a request for the cluster with `signature`, like CompileIfNeeded()
+  // does on a cache hit, for callers that run an executable it returned again
+  // without asking for it: registers the execution of `function` with
+  // `profiler` and counts the request in the cache.
+  void RegisterCacheHit(const NameAttrList& function,
+                        const DeviceCompilationClusterSignature& signature,
+                        DeviceCompilationProfiler* profiler) {
+    profiler->RegisterExecution(function);
+    cache_->Lookup(signature);
+  }
+
   ClientType* client() const { return compiler_client_->client(); }
   const DeviceType& device_type() const { return persistor_->device_type(); }
   DeviceCompilationCache<ExecutableType>* cache() { return cache_.get(); }
@@ -160,6 +172,10 @@ class DeviceCompiler : public ResourceBase {
       const NameAttrList& function, CompileScope scope, OpKernelContext* ctx,
       DeviceCompilationProfiler* profiler);
 
+  // Runs the pending asynchronous compilation of the cluster executed the most
+  // times so far.
+  void RunHottestPendingCompilation();
+
   std::unique_ptr<DeviceExecutablePersistor<ExecutableType, ClientType>>
       persistor_;
   std::unique_ptr<DeviceCompilerClient<ExecutableType, ClientType>>
@@ -169,6 +185,18 @@ class DeviceCompiler : public ResourceBase {
   // Pool of threads for asynchronous compilations.
   std::unique_ptr<thread::ThreadPool> async_compiler_threads_;
 
+  // Asynchronous compilations waiting for a compiler thread. Each compiler
+  // thread task runs the hottest one when it starts, so that clusters executed
+  // often get compiled first when compilations queue up.
+  struct PendingCompilation {
+    std::string function_name;
+    DeviceCompilationProfiler* profiler;
+    std::function<void()> compile;
+  };
+  mutex pending_compilations_mu_;
+  std::vector<PendingCompilation> pending_compilations_
+      TF_GUARDED_BY(pending_compilations_mu_);
+
   mutex cluster_mutexes_mu_;
   absl::flat_hash_map<DeviceCompilationClusterSignature, std::unique_ptr<mutex>,
                       DeviceCompilationClusterSignature::Hash>
@@ -373,7 +401,7 @@ absl::Status DeviceCompiler<ExecutableType, ClientType>::CompileAsynchronous(
   // All values are captured by value. Make sure that all pointer values (like
   // entry) do not get freed until the lambda has finished.
   const std::string& function_name = function.name();
-  async_compiler_threads_->Schedule([=] {
+  auto compile = [=] {
     VLOG(2) << "Starting asynchronous compilation of cluster " << function_name
             << '.';
     // We don't need to lock mu, but do it anyway to satisfy thread safety
@@ -391,10 +419,46 @@ absl::Status DeviceCompiler<ExecutableType, ClientType>::CompileAsynchronous(
       cache_->Store(signature, std::nullopt, s.status(), std::nullopt,
                     std::nullopt);
     }
-  });
+  };
+  {
+    mutex_lock lock(pending_compilations_mu_);
+    pending_compilations_.push_back(
+        PendingCompilation{function_name, profiler, std::move(compile)});
+  }
+  async_compiler_threads_->Schedule([this] { RunHottestPendingCompilation(); });
   return absl::OkStatus();
 }
 
+template <typename ExecutableType, typename ClientType>
+void DeviceCompiler<ExecutableType,
+                    ClientType>::RunHottestPendingCompilation() {
+  std::function<void()> compile;
+  {
+    mutex_lock lock(pending_compilations_mu_);
+    // There is one compiler thread task per pending compilation.
+    DCHECK(!pending_compilations_.empty());
+    auto hottest = pending_compilations_.end();
+    int64_t hottest_execution_count = -1;
+    for (auto it = pending_compilations_.begin();
+         it != pending_compilations_.end(); ++it) {
+      NameAttrList function;
+      function.set_name(it->function_name);
+      auto stats = it->profiler->GetCompileStats(function);
+      int64_t execution_count = stats.ok() ? stats->execution_count : 0;
+      if (execution_count > hottest_execution_count) {
+        hottest = it;
+        hottest_execution_count = execution_count;
+      }
+    }
+    compile = std::move(hottest->compile);
+    if (hottest != pending_compilations_.end() - 1) {
+      *hottest = std::move(pending_compilations_.back());
+    }
+    pending_compilations_.pop_back();
+  }
+  compile();
+}
+
 template <typename ExecutableType, typename ClientType>
 absl::Status DeviceCompiler<ExecutableType, ClientType>::CompileImpl(
     const XlaCompiler::CompileOptions& compile_options,
@@ -265,6 +265,36 @@ TEST_F(DeviceCompilerTest, CompileCacheHit) {
   EXPECT_EQ(xla_executable, new_xla_executable);
 }
 
+TEST_F(DeviceCompilerTest, RegisterCacheHit) {
+  const XlaCompiler::CompilationResult* compilation_result = nullptr;
+  xla::LocalExecutable* xla_executable = nullptr;
+
+  XlaCompiler::Options options = GetDefaultXlaOptions();
+
+  NameAttrList fn;
+  fn.set_name("foo");
+
+  auto args = SampleArgsForAddXY();
+  TF_EXPECT_OK(xla_device_compiler_->CompileIfNeeded(
+      options, fn, args, XlaCompiler::CompileOptions{},
+      DeviceCompileMode::kStrict, profiler_, &compilation_result,
+      &xla_executable));
+
+  // Reuse the executable twice without compiling it again.
+  TF_ASSERT_OK_AND_ASSIGN(auto signature, Signature::Build(fn, args));
+  xla_device_compiler_->RegisterCacheHit(fn, signature, profiler_);
+  xla_device_compiler_->RegisterCacheHit(fn, signature, profiler_);
+
+  TF_ASSERT_OK_AND_ASSIGN(auto stats, profiler_->GetCompileStats(fn));
+  EXPECT_EQ(stats.compile_count, 1);
+  EXPECT_EQ(stats.execution_count, 3);
+
+  // The lookup below counts as a fourth request.
+  auto cache_value = xla_device_compiler_->cache()->Lookup(signature);
+  ASSERT_TRUE(cache_value);
+  EXPECT_EQ(cache_value->request_count, 4);
+}
+
 TEST_F(DeviceCompilerTest, CompileAsyncSuccess) {
   const XlaCompiler::CompilationResult* compilation_result = nullptr;
   xla::LocalExecutable* xla_executable = nullptr;
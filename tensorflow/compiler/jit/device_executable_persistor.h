@@ -16,6 +16,8 @@ limitations under the License.
 #ifndef TENSORFLOW_COMPILER_JIT_DEVICE_EXECUTABLE_PERSISTOR_H_
 #define TENSORFLOW_COMPILER_JIT_DEVICE_EXECUTABLE_PERSISTOR_H_
 
+#include <algorithm>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <utility>
@@ -32,6 +34,7 @@ limitations under the License.
 #include "xla/util.h"
 #include "tensorflow/core/framework/device.h"
 #include "tensorflow/core/lib/strings/proto_serialization.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/path.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/statusor.h"
@@ -83,6 +86,14 @@ class DeviceExecutablePersistor {
 
     // Cache is read-only if set to true.
     bool persistent_cache_directory_read_only = false;
+
+    // If positive, an executable missing from the cache is marked as being
+    // compiled, with a marker file next to its entry, until it is persisted.
+    // Other processes missing the same entry wait for up to this many seconds
+    // after the marker was written for the entry to show up, instead of
+    // compiling it too. This lets the workers of a job sharing a cache
+    // directory (e.g. on GCS) compile each cluster once.
+    int64_t peer_compilation_wait_secs = 0;
   };
 
   DeviceExecutablePersistor(const Config& config,
@@ -153,6 +164,16 @@ class DeviceExecutablePersistor {
 
   std::string GetFilePath(const XlaSerializedCacheKey& key) const;
 
+  // Returns the path of the marker file of the entry for `key` being compiled.
+  std::string GetCompilationMarkerPath(const XlaSerializedCacheKey& key) const;
+
+  // Called when there is no entry for `key`. If another process marked the
+  // entry as being compiled at most `peer_compilation_wait_secs_` ago, waits
+  // for it to be persisted and returns it. Otherwise, marks the entry as being
+  // compiled by this process and returns std::nullopt.
+  absl::StatusOr<std::optional<XlaSerializedCacheEntry>>
+  WaitForPeerCompilation(const XlaSerializedCacheKey& key) const;
+
   const DeviceType device_type_;
   const bool disable_strict_signature_checks_;
   const std::string persistence_prefix_;
@@ -164,6 +185,8 @@ class DeviceExecutablePersistor {
   // Cache is read-only if set to true.
   const bool persistent_cache_directory_read_only_;
 
+  const int64_t peer_compilation_wait_secs_;
+
   DeviceExecutablePersistor(const DeviceExecutablePersistor&) = delete;
   void operator=(const DeviceExecutablePersistor&) = delete;
 };
@@ -177,7 +200,8 @@ DeviceExecutablePersistor<ExecutableType, ClientType>::
       persistence_prefix_(config.persistence_prefix),
       persistent_cache_directory_(config.persistent_cache_directory),
       persistent_cache_directory_read_only_(
-          config.persistent_cache_directory_read_only) {}
+          config.persistent_cache_directory_read_only),
+      peer_compilation_wait_secs_(config.peer_compilation_wait_secs) {}
 
 template <typename ExecutableType, typename ClientType>
 std::string DeviceExecutablePersistor<ExecutableType, ClientType>::GetFilePath(
@@ -186,6 +210,13 @@ std::string DeviceExecutablePersistor<ExecutableType, ClientType>::GetFilePath(
   return io::JoinPath(persistent_cache_directory_, file_name);
 }
 
+template <typename ExecutableType, typename ClientType>
+std::string
+DeviceExecutablePersistor<ExecutableType, ClientType>::GetCompilationMarkerPath(
+    const XlaSerializedCacheKey& key) const {
+  return absl::StrCat(GetFilePath(key), ".compiling");
+}
+
 template <typename ExecutableType, typename ClientType>
 XlaSerializedCacheKey
 DeviceExecutablePersistor<ExecutableType, ClientType>::BuildSerializedCacheKey(
@@ -232,6 +263,44 @@ DeviceExecutablePersistor<ExecutableType, ClientType>::TryToReadSerializedEntry(
   return std::optional<XlaSerializedCacheEntry>(entry);
 }
 
+template <typename ExecutableType, typename ClientType>
+absl::StatusOr<std::optional<XlaSerializedCacheEntry>>
+DeviceExecutablePersistor<ExecutableType, ClientType>::WaitForPeerCompilation(
+    const XlaSerializedCacheKey& key) const {
+  constexpr int64_t kPollIntervalMicros = 1000 * 1000;
+  Env* env = Env::Default();
+  const std::string marker_path = GetCompilationMarkerPath(key);
+
+  // The marker is only trusted for `peer_compilation_wait_secs_` after it was
+  // written, since the process that wrote it may have failed to compile or
+  // persist the entry.
+  FileStatistics marker_stats;
+  if (env->Stat(marker_path, &marker_stats).ok()) {
+    const int64_t deadline_micros =
+        marker_stats.mtime_nsec / 1000 + peer_compilation_wait_secs_ * 1000000;
+    int64_t now_micros = env->NowMicros();
+    if (now_micros < deadline_micros) {
+      VLOG(1) << "Waiting for another process to persist " << GetFilePath(key);
+    }
+    while (now_micros < deadline_micros) {
+      env->SleepForMicroseconds(
+          std::min(kPollIntervalMicros, deadline_micros - now_micros));
+      TF_ASSIGN_OR_RETURN(std::optional<XlaSerializedCacheEntry> entry,
+                          TryToReadSerializedEntry(key));
+      if (entry.has_value()) return entry;
+      now_micros = env->NowMicros();
+    }
+  }
+
+  if (!persistent_cache_directory_read_only_) {
+    // Best effort: processes missing the entry at the same time may all
+    // compile it, which is what happens without the marker.
+    env->RecursivelyCreateDir(persistent_cache_directory_).IgnoreError();
+    WriteStringToFile(env, marker_path, "").IgnoreError();
+  }
+  return absl::StatusOr<std::optional<XlaSerializedCacheEntry>>(std::nullopt);
+}
+
 template <typename ExecutableType, typename ClientType>
 absl::Status
 DeviceExecutablePersistor<ExecutableType, ClientType>::VerifyLoadedCacheEntry(
@@ -299,7 +368,11 @@ DeviceExecutablePersistor<ExecutableType, ClientType>::SaveSerializedEntry(
         "Could not create a unique file inside ", persistent_cache_directory_));
   }
   TF_RETURN_IF_ERROR(WriteBinaryProto(env, temp_path, entry));
-  return env->RenameFile(temp_path, GetFilePath(entry.key()));
+  TF_RETURN_IF_ERROR(env->RenameFile(temp_path, GetFilePath(entry.key())));
+  if (peer_compilation_wait_secs_ > 0) {
+    env->DeleteFile(GetCompilationMarkerPath(entry.key())).IgnoreError();
+  }
+  return absl::OkStatus();
 }
 
 template <typename ExecutableType, typename ClientType>
@@ -361,6 +434,12 @@ DeviceExecutablePersistor<ExecutableType, ClientType>::TryToLoadExecutable(
     TF_ASSIGN_OR_RETURN(serialized_entry, TryToReadSerializedEntry(cache_key));
   }
 
+  if (!serialized_entry.has_value() && peer_compilation_wait_secs_ > 0) {
+    XLA_SCOPED_LOGGING_TIMER(
+        absl::StrCat("Wait for peer compilation of:", signature_str));
+    TF_ASSIGN_OR_RETURN(serialized_entry, WaitForPeerCompilation(cache_key));
+  }
+
   if (!serialized_entry.has_value()) {
     return std::nullopt;
   }
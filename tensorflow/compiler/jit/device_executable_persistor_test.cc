@@ -38,6 +38,7 @@ limitations under the License.
 #include "xla/pjrt/plugin/xla_cpu/cpu_client_options.h"
 #include "xla/pjrt/plugin/xla_cpu/xla_cpu_pjrt_client.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/status_matchers.h"
 #include "tensorflow/core/platform/statusor.h"
@@ -430,6 +431,80 @@ TEST_F(DeviceExecutionPersistorTest, LoadFileDoesntExist) {
   EXPECT_FALSE(loaded_executable.has_value());
 }
 
+TEST_F(DeviceExecutionPersistorTest, LoadMarksPeerCompilation) {
+  XlaDeviceExecutablePersistor::Config config(
+      /*persistent_cache_directory=*/cache_dir_,
+      /*disable_strict_signature_checks=*/false,
+      /*persistence_prefix=*/"xla");
+  config.peer_compilation_wait_secs = 60;
+  XlaDeviceExecutablePersistor persistor(config,
+                                         DefaultXlaOptions().device_type);
+  auto key =
+      CreateCacheKey(/*signature_hash=*/777, compilation_result_add_,
+                     persistor.device_type(), persistor.persistence_prefix());
+  const std::string marker_path =
+      absl::StrCat(GetFilePath(key, cache_dir_), ".compiling");
+
+  MockXlaCompilerClient mock_client;
+  auto loaded_executable = persistor.TryToLoadExecutable(
+      /*signature_hash=*/777, "signature_string", DefaultXlaOptions(),
+      compilation_result_add_, &mock_client);
+  EXPECT_FALSE(loaded_executable.has_value());
+  TF_EXPECT_OK(Env::Default()->FileExists(marker_path));
+
+  // Persisting the executable removes the marker.
+  EXPECT_CALL(mock_client, SerializeExecutable(_))
+      .WillOnce(
+          Return(absl::StatusOr<std::string>(serialized_xla_executable_)));
+  TF_ASSERT_OK_AND_ASSIGN(auto executable, BuildSampleExecutable());
+  TF_EXPECT_OK(persistor.TryToPersistExecutable(
+      /*signature_hash=*/777, "signature_string", DefaultXlaOptions(),
+      compilation_result_add_, *executable, &mock_client));
+  EXPECT_FALSE(Env::Default()->FileExists(marker_path).ok());
+}
+
+TEST_F(DeviceExecutionPersistorTest, LoadWaitsForPeerCompilation) {
+  XlaDeviceExecutablePersistor::Config config(
+      /*persistent_cache_directory=*/cache_dir_,
+      /*disable_strict_signature_checks=*/false,
+      /*persistence_prefix=*/"xla");
+  config.peer_compilation_wait_secs = 60;
+  XlaDeviceExecutablePersistor persistor(config,
+                                         DefaultXlaOptions().device_type);
+  auto key =
+      CreateCacheKey(/*signature_hash=*/778, compilation_result_add_,
+                     persistor.device_type(), persistor.persistence_prefix());
+  // Another process is compiling the executable.
+  TF_ASSERT_OK(WriteStringToFile(
+      Env::Default(), absl::StrCat(GetFilePath(key, cache_dir_), ".compiling"),
+      ""));
+
+  MockXlaCompilerClient peer_client;
+  EXPECT_CALL(peer_client, SerializeExecutable(_))
+      .WillOnce(
+          Return(absl::StatusOr<std::string>(serialized_xla_executable_)));
+  TF_ASSERT_OK_AND_ASSIGN(auto peer_executable, BuildSampleExecutable());
+  std::unique_ptr<Thread> peer(Env::Default()->StartThread(
+      ThreadOptions(), "peer_compilation", [&] {
+        Env::Default()->SleepForMicroseconds(100 * 1000);
+        TF_EXPECT_OK(persistor.TryToPersistExecutable(
+            /*signature_hash=*/778, "signature_string", DefaultXlaOptions(),
+            compilation_result_add_, *peer_executable, &peer_client));
+      }));
+
+  MockXlaCompilerClient mock_client;
+  TF_ASSERT_OK_AND_ASSIGN(auto executable, BuildSampleExecutable());
+  EXPECT_CALL(mock_client, LoadExecutable(_, _, serialized_xla_executable_))
+      .WillOnce(Return(ByMove(std::move(executable))));
+  auto loaded_executable = persistor.TryToLoadExecutable(
+      /*signature_hash=*/778, "signature_string", DefaultXlaOptions(),
+      compilation_result_add_, &mock_client);
+  peer.reset();
+
+  ASSERT_TRUE(loaded_executable.has_value());
+  TF_EXPECT_OK(loaded_executable->status());
+}
+
 TEST_F(DeviceExecutionPersistorTest, LoadSerializedKeyMismatch) {
   XlaDeviceExecutablePersistor::Config config(
       /*persistent_cache_directory=*/cache_dir_,
@@ -167,6 +167,13 @@ void AppendMarkForCompilationPassFlagsInternal(std::vector<Flag>* flag_list) {
       Flag("tf_xla_persistent_cache_read_only",
            &mark_for_compilation_flags->tf_xla_persistent_cache_read_only,
            "If true, the persistent cache will be read-only."),
+      Flag("tf_xla_persistent_cache_peer_compilation_wait_secs",
+           &mark_for_compilation_flags
+                ->tf_xla_persistent_cache_peer_compilation_wait_secs,
+           "If positive, processes sharing the persistent cache mark the "
+           "executables they compile, and wait for up to this many seconds "
+           "for an executable marked by another process to be persisted "
+           "instead of compiling it too. Defaults to 0."),
       Flag("tf_xla_disable_strict_signature_checks",
            &mark_for_compilation_flags->tf_xla_disable_strict_signature_checks,
            "If true, entires loaded into the XLA compile cache will not have "
@@ -242,6 +249,8 @@ void AllocateAndParseFlags() {
   mark_for_compilation_flags->tf_xla_persistent_cache_directory = "";
   mark_for_compilation_flags->tf_xla_persistent_cache_device_types = "";
   mark_for_compilation_flags->tf_xla_persistent_cache_read_only = false;
+  mark_for_compilation_flags
+      ->tf_xla_persistent_cache_peer_compilation_wait_secs = 0;
   mark_for_compilation_flags->tf_xla_disable_strict_signature_checks = false;
   mark_for_compilation_flags->tf_xla_persistent_cache_prefix =
       "xla_compile_cache";
@@ -263,6 +272,8 @@ void AllocateAndParseFlags() {
   ops_flags = new XlaOpsCommonFlags;
   ops_flags->tf_xla_always_defer_compilation = false;
   ops_flags->tf_xla_async_compilation = false;
+  ops_flags->tf_xla_megamorphic_compile_threshold = 10;
+  ops_flags->tf_xla_megamorphic_min_executions_per_compile = 50;
   ops_flags->tf_xla_use_device_api.enabled_for_xla_launch_ = true;
   ops_flags->tf_xla_use_device_api.enabled_for_compile_on_demand_ = true;
   ops_flags->tf_xla_use_device_api.enabled_for_compile_and_run_ = true;
@@ -334,6 +345,18 @@ void AllocateAndParseFlags() {
             "When lazy compilation is enabled, asynchronous compilation starts "
             "the cluster compilation in the background, and the fallback path "
             "is executed until the compilation has finished."),
+       Flag("tf_xla_megamorphic_compile_threshold",
+            &ops_flags->tf_xla_megamorphic_compile_threshold,
+            "Number of compilations of a cluster after which it is marked "
+            "megamorphic if it hasn't been executed "
+            "tf_xla_megamorphic_min_executions_per_compile times per "
+            "compilation. Megamorphic clusters run in the TF executor in the "
+            "lazy and async compilation modes."),
+       Flag("tf_xla_megamorphic_min_executions_per_compile",
+            &ops_flags->tf_xla_megamorphic_min_executions_per_compile,
+            "Minimum number of executions per compilation for a cluster "
+            "compiled more than tf_xla_megamorphic_compile_threshold times "
+            "not to be marked megamorphic."),
        Flag("tf_xla_use_device_api_for_xla_launch",
             &ops_flags->tf_xla_use_device_api.enabled_for_xla_launch_,
             "If true, uses Device API (PjRt) for single device compilation and "
@@ -104,6 +104,11 @@ struct MarkForCompilationPassFlags {
 
   bool tf_xla_persistent_cache_read_only;
 
+  // If positive, processes sharing the persistent cache wait for up to this
+  // many seconds for an executable another one is compiling to be persisted,
+  // instead of compiling it too. Defaults to 0.
+  int64_t tf_xla_persistent_cache_peer_compilation_wait_secs;
+
   // If true, entries loaded into the XLA compile cache will not have their
   // signatures checked strictly. This should generally not be disabled except
   // for debugging. Defaults to false.
@@ -151,6 +156,15 @@ struct XlaOpsCommonFlags {
   // If true, _XlaCompile compiles the cluster asynchronously with respect to
   // the main execution. The fallback path is taken while compilation happens.
   bool tf_xla_async_compilation;
+  // A cluster is marked megamorphic, and no longer compiled in the lazy and
+  // async modes, once it has been compiled more than
+  // `tf_xla_megamorphic_compile_threshold` times with fewer than
+  // `tf_xla_megamorphic_min_executions_per_compile` executions per
+  // compilation. Clusters with dynamic shapes recompile for each new shape, so
+  // raising these trades compile time for fewer fallbacks to the TF executor.
+  // Default to 10 and 50.
+  int64_t tf_xla_megamorphic_compile_threshold;
+  int64_t tf_xla_megamorphic_min_executions_per_compile;
 
   class PjRtForSingleDeviceCompilationRollout {
    public:
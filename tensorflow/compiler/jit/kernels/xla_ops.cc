@@ -483,6 +483,51 @@ XlaLocalLaunchBase::XlaLocalLaunchBase(OpKernelConstruction* ctx,
       platform_info_(XlaPlatformInfoFromDevice(ctx->device())),
       has_ref_vars_(has_ref_vars) {}
 
+absl::Status XlaLocalLaunchBase::GetOrCompilePjRtExecutable(
+    OpKernelContext* ctx, const std::vector<XlaCompiler::Argument>& args,
+    const XlaCompiler::CompilationResult** compilation_result,
+    xla::PjRtClient** client, xla::PjRtLoadedExecutable** executable) {
+  {
+    mutex_lock lock(last_pjrt_compilation_mu_);
+    if (last_pjrt_compilation_.has_value() &&
+        last_pjrt_compilation_->args == args) {
+      last_pjrt_compilation_->device_compiler->RegisterCacheHit(
+          function_, last_pjrt_compilation_->signature,
+          last_pjrt_compilation_->profiler.get());
+      *compilation_result = last_pjrt_compilation_->compilation_result;
+      *client = last_pjrt_compilation_->client;
+      *executable = last_pjrt_compilation_->executable;
+      return absl::OkStatus();
+    }
+  }
+
+  TF_RETURN_IF_ERROR(CompileToPjRtLoadedExecutable(
+      *ctx, platform_info_, function_, args, DeviceCompileMode::kStrict,
+      has_ref_vars_, /*may_alias_resource_update=*/true, compilation_result,
+      client, executable));
+
+  // Executables are never evicted from the device compiler's cache, so they
+  // stay valid as long as the device compiler does.
+  PjRtDeviceCompiler* pjrt_device_compiler;
+  DeviceCompilationProfiler* profiler;
+  TF_RETURN_IF_ERROR(GetOrCreatePjRtDeviceCompilerAndProfiler(
+      *ctx, platform_info_, ctx->function_library(), &pjrt_device_compiler,
+      &profiler));
+  core::RefCountPtr<PjRtDeviceCompiler> device_compiler(pjrt_device_compiler);
+  core::RefCountPtr<DeviceCompilationProfiler> profiler_ref(profiler);
+  TF_ASSIGN_OR_RETURN(
+      auto signature, DeviceCompilationClusterSignature::Build(function_, args));
+  mutex_lock lock(last_pjrt_compilation_mu_);
+  last_pjrt_compilation_ = LastPjRtCompilation{args,
+                                               std::move(signature),
+                                               *compilation_result,
+                                               *client,
+                                               *executable,
+                                               std::move(device_compiler),
+                                               std::move(profiler_ref)};
+  return absl::OkStatus();
+}
+
 void XlaLocalLaunchBase::ComputeAsync(OpKernelContext* ctx, DoneCallback done) {
   VLOG(1) << "XlaLocalLaunchOpBase::Compute "
           << Canonicalize(function_.name(), AttrSlice(&function_.attr()));
@@ -529,11 +574,9 @@ void XlaLocalLaunchBase::ComputeAsync(OpKernelContext* ctx, DoneCallback done) {
                           platform_info_.device_type());
   if (use_pjrt) {
     VLOG(2) << "Compiling using PJRT";
-    absl::Status status = CompileToPjRtLoadedExecutable(
-        *ctx, platform_info_, function_, xla_compiler_args,
-        DeviceCompileMode::kStrict, has_ref_vars_,
-        /*may_alias_resource_update=*/true, &compilation_result, &pjrt_client,
-        &pjrt_executable);
+    absl::Status status =
+        GetOrCompilePjRtExecutable(ctx, xla_compiler_args, &compilation_result,
+                                   &pjrt_client, &pjrt_executable);
     OP_REQUIRES_OK_ASYNC(ctx, status, done);
 
     VLOG(2) << "Compiled using PJRT: " << status;
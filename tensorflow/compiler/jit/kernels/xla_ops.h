@@ -17,7 +17,11 @@ limitations under the License.
 #define TENSORFLOW_COMPILER_JIT_KERNELS_XLA_OPS_H_
 
 #include <atomic>
+#include <optional>
+#include <vector>
 
+#include "tensorflow/compiler/jit/device_compilation_cluster_signature.h"
+#include "tensorflow/compiler/jit/device_compilation_profiler.h"
 #include "tensorflow/compiler/jit/device_compiler.h"
 #include "tensorflow/compiler/jit/xla_device.h"
 #include "tensorflow/compiler/jit/xla_launch_util.h"
@@ -28,6 +32,9 @@ limitations under the License.
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/refcount.h"
+#include "tensorflow/core/platform/thread_annotations.h"
 #include "tensorflow/core/util/stream_executor_util.h"
 
 namespace tensorflow {
@@ -66,6 +73,35 @@ class XlaLocalLaunchBase : public AsyncOpKernel {
   const XlaPlatformInfo platform_info_;
 
   bool has_ref_vars_;
+
+ private:
+  // The PJRT executable compiled for the arguments of the last launch, reused
+  // as long as the arguments are the same to skip the lookup in the device
+  // compiler (building the options and the cluster signature, and taking the
+  // cluster lock). Reuses are still counted by the device compiler.
+  struct LastPjRtCompilation {
+    std::vector<XlaCompiler::Argument> args;
+    DeviceCompilationClusterSignature signature;
+    const XlaCompiler::CompilationResult* compilation_result;  // Not owned.
+    xla::PjRtClient* client;                                   // Not owned.
+    xla::PjRtLoadedExecutable* executable;                     // Not owned.
+    // Owns `compilation_result` and `executable` in its cache.
+    core::RefCountPtr<
+        DeviceCompiler<xla::PjRtLoadedExecutable, xla::PjRtClient>>
+        device_compiler;
+    core::RefCountPtr<DeviceCompilationProfiler> profiler;
+  };
+
+  // Compiles the PJRT executable for `args`, or returns the one compiled for
+  // the last launch if `args` are the same.
+  absl::Status GetOrCompilePjRtExecutable(
+      OpKernelContext* ctx, const std::vector<XlaCompiler::Argument>& args,
+      const XlaCompiler::CompilationResult** compilation_result,
+      xla::PjRtClient** client, xla::PjRtLoadedExecutable** executable);
+
+  mutex last_pjrt_compilation_mu_;
+  std::optional<LastPjRtCompilation> last_pjrt_compilation_
+      TF_GUARDED_BY(last_pjrt_compilation_mu_);
 };
 
 // XlaLocalLaunchOp is used to replace a region of the TensorFlow graph
@@ -26,6 +26,12 @@ namespace tensorflow {
 // The number of compiler threads to use for asynchronous device compilation.
 inline constexpr int64_t kNumAsyncDeviceCompilerThreads = 10;
 
+// The maximum number of asynchronous device compilations, running or waiting
+// for a compiler thread. Waiting compilations are started hottest cluster
+// first.
+inline constexpr int64_t kMaxNumPendingAsyncDeviceCompilations =
+    4 * kNumAsyncDeviceCompilerThreads;
+
 enum class DeviceCompileMode {
   kLazy,
   kStrict,
@@ -78,6 +78,9 @@ PjRtDeviceCompiler* CreatePjRtDeviceCompiler(DeviceType compilation_device_type,
       GetMarkForCompilationPassFlags()->tf_xla_disable_strict_signature_checks,
       GetMarkForCompilationPassFlags()->tf_xla_persistent_cache_prefix,
       GetMarkForCompilationPassFlags()->tf_xla_persistent_cache_read_only);
+  persistor_config.peer_compilation_wait_secs =
+      GetMarkForCompilationPassFlags()
+          ->tf_xla_persistent_cache_peer_compilation_wait_secs;
 
   return new PjRtDeviceCompiler(
       std::make_unique<PjRtDeviceExecutablePersistor>(
@@ -226,6 +229,9 @@ absl::Status BuildXlaDeviceCompiler(DeviceBase* device,
       GetMarkForCompilationPassFlags()->tf_xla_disable_strict_signature_checks,
       GetMarkForCompilationPassFlags()->tf_xla_persistent_cache_prefix,
       GetMarkForCompilationPassFlags()->tf_xla_persistent_cache_read_only);
+  persistor_config.peer_compilation_wait_secs =
+      GetMarkForCompilationPassFlags()
+          ->tf_xla_persistent_cache_peer_compilation_wait_secs;
 
   if (platform_info.xla_device_metadata()) {
     *xla_device_compiler = CreateXlaDeviceCompiler(
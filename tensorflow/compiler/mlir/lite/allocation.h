@@ -97,6 +97,12 @@ class MMAPAllocation : public Allocation {
     return offset_of_buffer_in_file_;
   }
 
+  /// Hints the OS not to read ahead the `length` bytes at `offset` from
+  /// base(), so that their pages are only loaded as they are accessed. Only
+  /// the pages entirely in the range are affected. Returns false if the hint
+  /// couldn't be given.
+  bool AdviseRandomAccess(size_t offset, size_t length) const;
+
   static bool IsSupported();
 
  protected:
@@ -129,6 +129,28 @@ size_t MMAPAllocation::bytes() const { return buffer_size_bytes_; }
 
 bool MMAPAllocation::valid() const { return mmapped_buffer_ != MAP_FAILED; }
 
+bool MMAPAllocation::AdviseRandomAccess(size_t offset, size_t length) const {
+  if (!valid() || offset > bytes() || length > bytes() - offset) {
+    return false;
+  }
+#ifdef __ANDROID__
+  static int pagesize = getpagesize();
+#else
+  static int pagesize = sysconf(_SC_PAGE_SIZE);
+#endif
+  // mmapped_buffer_ is page aligned: round the range inwards to whole pages.
+  const size_t range_begin = offset_in_buffer_ + offset;
+  const size_t range_end = range_begin + length;
+  const size_t begin = (range_begin + pagesize - 1) / pagesize * pagesize;
+  const size_t end = range_end / pagesize * pagesize;
+  if (begin >= end) {
+    return true;
+  }
+  char* mmapped_buffer =
+      reinterpret_cast<char*>(const_cast<void*>(mmapped_buffer_));
+  return madvise(mmapped_buffer + begin, end - begin, MADV_RANDOM) == 0;
+}
+
 bool MMAPAllocation::IsSupported() { return true; }
 
 }  // namespace tflite
@@ -0,0 +1,69 @@
+// RUN: tf-opt --split-input-file -tfl-deduplicate-funcs %s | FileCheck %s
+
+// CHECK-LABEL: func @main
+func.func @main(%arg0: tensor<4xf32>) -> (tensor<4xf32>, tensor<4xf32>, tensor<4xf32>) {
+  // CHECK: call @add_one
+  // CHECK: call @add_one
+  // CHECK: call @add_two
+  %0 = func.call @add_one(%arg0) : (tensor<4xf32>) -> tensor<4xf32>
+  %1 = func.call @add_one_copy(%arg0) : (tensor<4xf32>) -> tensor<4xf32>
+  %2 = func.call @add_two(%arg0) : (tensor<4xf32>) -> tensor<4xf32>
+  func.return %0, %1, %2 : tensor<4xf32>, tensor<4xf32>, tensor<4xf32>
+}
+
+// CHECK: func private @add_one
+func.func private @add_one(%arg0: tensor<4xf32>) -> tensor<4xf32> {
+  %cst = "tf.Const"() {value = dense<1.0> : tensor<4xf32>} : () -> tensor<4xf32>
+  %0 = "tf.AddV2"(%arg0, %cst) : (tensor<4xf32>, tensor<4xf32>) -> tensor<4xf32>
+  func.return %0 : tensor<4xf32>
+}
+
+// CHECK-NOT: func private @add_one_copy
+func.func private @add_one_copy(%arg0: tensor<4xf32>) -> tensor<4xf32> {
+  %cst = "tf.Const"() {value = dense<1.0> : tensor<4xf32>} : () -> tensor<4xf32>
+  %0 = "tf.AddV2"(%arg0, %cst) : (tensor<4xf32>, tensor<4xf32>) -> tensor<4xf32>
+  func.return %0 : tensor<4xf32>
+}
+
+// CHECK: func private @add_two
+func.func private @add_two(%arg0: tensor<4xf32>) -> tensor<4xf32> {
+  %cst = "tf.Const"() {value = dense<2.0> : tensor<4xf32>} : () -> tensor<4xf32>
+  %0 = "tf.AddV2"(%arg0, %cst) : (tensor<4xf32>, tensor<4xf32>) -> tensor<4xf32>
+  func.return %0 : tensor<4xf32>
+}
+
+// -----
+
+// Functions whose callees are merged become identical too.
+
+// CHECK-LABEL: func @nested
+func.func @nested(%arg0: tensor<4xf32>) -> (tensor<4xf32>, tensor<4xf32>) {
+  // CHECK: call @outer
+  // CHECK: call @outer
+  %0 = func.call @outer(%arg0) : (tensor<4xf32>) -> tensor<4xf32>
+  %1 = func.call @outer_copy(%arg0) : (tensor<4xf32>) -> tensor<4xf32>
+  func.return %0, %1 : tensor<4xf32>, tensor<4xf32>
+}
+
+func.func private @outer(%arg0: tensor<4xf32>) -> tensor<4xf32> {
+  %0 = func.call @inner(%arg0) : (tensor<4xf32>) -> tensor<4xf32>
+  func.return %0 : tensor<4xf32>
+}
+
+func.func private @outer_copy(%arg0: tensor<4xf32>) -> tensor<4xf32> {
+  %0 = func.call @inner_copy(%arg0) : (tensor<4xf32>) -> tensor<4xf32>
+  func.return %0 : tensor<4xf32>
+}
+
+func.func private @inner(%arg0: tensor<4xf32>) -> tensor<4xf32> {
+  %0 = "tf.Neg"(%arg0) : (tensor<4xf32>) -> tensor<4xf32>
+  func.return %0 : tensor<4xf32>
+}
+
+func.func private @inner_copy(%arg0: tensor<4xf32>) -> tensor<4xf32> {
+  %0 = "tf.Neg"(%arg0) : (tensor<4xf32>) -> tensor<4xf32>
+  func.return %0 : tensor<4xf32>
+}
+
+// CHECK-NOT: @outer_copy
+// CHECK-NOT: @inner_copy
@@ -432,6 +432,9 @@ void AddPostVariableFreezingTFToTFLConversionPasses(
 
   pass_manager->addPass(mlir::createInlinerPass());
   pass_manager->addPass(mlir::createSymbolDCEPass());
+  // Merge the identical functions left after inlining (e.g. the bodies of
+  // control flow traced several times) so that they are legalized once.
+  pass_manager->addPass(mlir::TFL::CreateDeduplicateFunctionsPass());
 
   if (pass_config.legalize_custom_tensor_list_ops) {
     pass_manager->addPass(mlir::TFL::CreateLegalizeTensorListPass());
@@ -0,0 +1,128 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "absl/container/flat_hash_map.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"  // from @llvm-project
+#include "mlir/IR/BuiltinAttributes.h"  // from @llvm-project
+#include "mlir/IR/BuiltinOps.h"  // from @llvm-project
+#include "mlir/IR/OperationSupport.h"  // from @llvm-project
+#include "mlir/IR/SymbolTable.h"  // from @llvm-project
+#include "mlir/Pass/Pass.h"  // from @llvm-project
+#include "mlir/Support/LLVM.h"  // from @llvm-project
+#include "mlir/Support/TypeID.h"  // from @llvm-project
+#include "tensorflow/compiler/mlir/lite/transforms/passes.h"
+
+namespace mlir {
+namespace TFL {
+namespace {
+#define GEN_PASS_DEF_DEDUPLICATEFUNCTIONSPASS
+#include "tensorflow/compiler/mlir/lite/transforms/passes.h.inc"
+
+// The attributes of `func` other than its name and visibility.
+DictionaryAttr GetComparedAttributes(func::FuncOp func) {
+  NamedAttrList attrs;
+  for (NamedAttribute attr : func->getAttrs()) {
+    if (attr.getName() == SymbolTable::getSymbolAttrName() ||
+        attr.getName() == SymbolTable::getVisibilityAttrName()) {
+      continue;
+    }
+    attrs.push_back(attr);
+  }
+  return attrs.getDictionary(func.getContext());
+}
+
+llvm::hash_code HashFunction(func::FuncOp func) {
+  llvm::hash_code hash = llvm::hash_combine(
+      func.getFunctionType(), GetComparedAttributes(func).getAsOpaquePointer());
+  func.getBody().walk([&](Operation* op) {
+    hash = llvm::hash_combine(
+        hash, OperationEquivalence::computeHash(
+                  op, OperationEquivalence::ignoreHashValue,
+                  OperationEquivalence::ignoreHashValue,
+                  OperationEquivalence::IgnoreLocations));
+  });
+  return hash;
+}
+
+bool IsSameFunction(func::FuncOp lhs, func::FuncOp rhs) {
+  return lhs.getFunctionType() == rhs.getFunctionType() &&
+         GetComparedAttributes(lhs) == GetComparedAttributes(rhs) &&
+         OperationEquivalence::isRegionEquivalentTo(
+             &lhs.getBody(), &rhs.getBody(),
+             OperationEquivalence::IgnoreLocations);
+}
+
+class DeduplicateFunctionsPass
+    : public impl::DeduplicateFunctionsPassBase<DeduplicateFunctionsPass> {
+ public:
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(DeduplicateFunctionsPass)
+
+ private:
+  void runOnOperation() override;
+  // Merges the duplicates of one round. Returns true if any were merged.
+  bool MergeDuplicates();
+};
+
+bool DeduplicateFunctionsPass::MergeDuplicates() {
+  ModuleOp module = getOperation();
+  // Functions by hash, in module order.
+  absl::flat_hash_map<size_t, SmallVector<func::FuncOp, 1>> candidates;
+  SmallVector<std::pair<func::FuncOp, func::FuncOp>> duplicates;
+  for (auto func : module.getOps<func::FuncOp>()) {
+    if (!func.isPrivate() || func.isExternal()) continue;
+    auto& same_hash = candidates[HashFunction(func)];
+    auto it = llvm::find_if(same_hash, [&](func::FuncOp representative) {
+      return IsSameFunction(representative, func);
+    });
+    if (it == same_hash.end()) {
+      same_hash.push_back(func);
+    } else {
+      duplicates.emplace_back(func, *it);
+    }
+  }
+  for (auto [duplicate, representative] : duplicates) {
+    if (failed(SymbolTable::replaceAllSymbolUses(
+            duplicate.getSymNameAttr(), representative.getSymNameAttr(),
+            module))) {
+      duplicate.emitError("failed to replace the uses of duplicate function");
+      signalPassFailure();
+      return false;
+    }
+    duplicate.erase();
+  }
+  return !duplicates.empty();
+}
+
+void DeduplicateFunctionsPass::runOnOperation() {
+  // Merging the duplicate callees of functions can make them identical.
+  while (MergeDuplicates()) {
+  }
+}
+
+}  // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>> CreateDeduplicateFunctionsPass() {
+  return std::make_unique<DeduplicateFunctionsPass>();
+}
+
+}  // namespace TFL
+}  // namespace mlir
@@ -163,6 +163,10 @@ std::unique_ptr<OperationPass<ModuleOp>> CreateTrimFunctionsPass();
 std::unique_ptr<OperationPass<ModuleOp>> CreateTrimFunctionsPass(
     const std::vector<std::string>& trim_funcs_allowlist);
 
+// Creates an instance of the TensorFlow Lite pass that merges identical
+// private functions.
+std::unique_ptr<OperationPass<ModuleOp>> CreateDeduplicateFunctionsPass();
+
 // Creates an instance of the TensorFlow Lite dialect PrepareCompositeFunctions
 // pass.
 std::unique_ptr<OperationPass<ModuleOp>> CreatePrepareCompositeFunctionsPass();
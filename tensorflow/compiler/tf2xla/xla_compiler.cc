@@ -30,6 +30,7 @@ limitations under the License.
 #include "tensorflow/compiler/mlir/tf2xla/mlir_bridge_rollout_policy.h"
 #include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/hash/hash.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
@@ -572,7 +573,26 @@ int64_t XlaCompiler::NextStepId() { return next_step_id_++; }
 
 uint64 XlaCompiler::SignatureHash::operator()(
     const std::pair<string, std::vector<Argument>>& signature) const {
-  return std::hash<string>()(signature.first);
+  // Hashes the fields compared by XlaArgument::operator== that tell apart the
+  // signatures a function is usually compiled with, so that they don't all
+  // fall in the same bucket.
+  uint64 h = Hash64(signature.first);
+  for (const Argument& arg : signature.second) {
+    h = Hash64Combine(h, static_cast<uint64>(arg.kind));
+    h = Hash64Combine(h, static_cast<uint64>(arg.type));
+    if (absl::holds_alternative<xla::Shape>(arg.shape)) {
+      h = Hash64Combine(h, absl::HashOf(absl::get<xla::Shape>(arg.shape)));
+    } else {
+      for (int64_t dim : absl::get<TensorShape>(arg.shape).dim_sizes()) {
+        h = Hash64Combine(h, static_cast<uint64>(dim));
+      }
+    }
+    if (arg.kind == Argument::kConstant) {
+      const absl::string_view data = arg.constant_value.tensor_data();
+      h = Hash64Combine(h, Hash64(data.data(), data.size()));
+    }
+  }
+  return h;
 }
 
 static absl::Status GetFunctionBody(const NameAttrList& function,
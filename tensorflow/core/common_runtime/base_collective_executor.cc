@@ -18,6 +18,7 @@ limitations under the License.
 #include <functional>
 #include <utility>
 
+#include "tensorflow/core/common_runtime/collective_peer_stats.h"
 #include "tensorflow/core/common_runtime/copy_tensor.h"
 #include "tensorflow/core/common_runtime/device_mgr.h"
 #include "tensorflow/core/common_runtime/dma_helper.h"
@@ -309,6 +310,7 @@ void BaseCollectiveExecutor::ExecuteAsync(OpKernelContext* ctx,
        col_params->instance.type == PERMUTE_COLLECTIVE ||
        col_params->instance.type == ALL_TO_ALL_COLLECTIVE ||
        col_params->instance.type == REDUCE_SCATTER_COLLECTIVE ||
+       col_params->instance.type == RAGGED_ALL_TO_ALL_COLLECTIVE ||
        (col_params->instance.type == BROADCAST_COLLECTIVE &&
         col_params->is_source))
           ? &ctx->input(0)
@@ -352,11 +354,28 @@ void BaseCollectiveExecutor::ExecuteAsync(OpKernelContext* ctx,
                {"collective", col_ctx->col_params->instance.type}});
         },
         context_id);
-    col_impl->Ref();
-    col_impl->Run([col_impl, col_ctx, done_safe](const absl::Status& s) {
-      core::ScopedUnref unref(col_impl);
-      done_safe(s);
+    // Spans the whole collective, unlike the consumer above which ends when
+    // the collective has been started.
+    const int64_t trace_id = tsl::profiler::TraceMe::ActivityStart([col_ctx] {
+      const Tensor* tensor =
+          col_ctx->input != nullptr ? col_ctx->input : col_ctx->output;
+      return tsl::profiler::TraceMeEncode(
+          "CollectiveExecutor::Run",
+          {{"instance_key", col_ctx->col_params->instance.instance_key},
+           {"group_key", col_ctx->col_params->group.group_key},
+           {"bytes", tensor->TotalBytes()}});
     });
+    col_impl->Ref();
+    col_impl->Run(
+        [col_impl, col_ctx, done_safe, trace_id](const absl::Status& s) {
+          core::ScopedUnref unref(col_impl);
+          tsl::profiler::TraceMe::ActivityEnd(trace_id);
+          if (s.ok() && col_ctx->col_params->group.num_tasks > 1) {
+            CollectivePeerStats::Global()->MaybeLogStraggler(
+                col_ctx->col_params->group);
+          }
+          done_safe(s);
+        });
   });
 }
 
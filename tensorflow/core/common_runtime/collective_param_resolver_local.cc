@@ -82,6 +82,9 @@ const char* GetCollectiveName(const CollectiveParams* cp, bool nccl) {
     case REDUCE_SCATTER_COLLECTIVE:
       return nccl ? "NcclReduceScatter" : "undef";
 
+    case RAGGED_ALL_TO_ALL_COLLECTIVE:
+      return "RaggedAllToAll";
+
     default:
       return "undef";
   }
@@ -700,6 +703,13 @@ void CollectiveParamResolverLocal::AssignCollectiveType(CollectiveParams* cp) {
       CollectiveRegistry::LookupParamResolverInstance("NcclReduce", &col_impl)
           .ok();
   cp->instance.impl_details.collective_name = GetCollectiveName(cp, use_nccl);
+  // The hierarchical all-reduce only differs from the ring when the group
+  // spans several tasks.
+  if (!use_nccl && cp->instance.type == REDUCTION_COLLECTIVE &&
+      cp->instance.impl_details.communication_hint == "hierarchical" &&
+      cp->group.num_tasks > 1 && cp->group.same_num_devices_per_task) {
+    cp->instance.impl_details.collective_name = "HierarchicalReduce";
+  }
   VLOG(1) << "AssignCollectiveType "
           << cp->instance.impl_details.collective_name;
 }
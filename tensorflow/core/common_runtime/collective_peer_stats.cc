@@ -0,0 +1,117 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/collective_peer_stats.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/logging.h"
+
+namespace tensorflow {
+
+string CollectivePeerStats::StragglerReport::DebugString() const {
+  string out = strings::StrCat("group_key ", group_key, " straggler ",
+                               straggler.empty() ? "<none>" : straggler);
+  for (const PeerStats& peer : peers) {
+    strings::StrAppend(&out, "\n  ", peer.task, ": ", peer.num_recvs,
+                       " recvs, ", peer.bytes, " bytes, mean ",
+                       static_cast<int64_t>(peer.MeanMicros()), "us, max ",
+                       peer.max_micros, "us");
+  }
+  return out;
+}
+
+CollectivePeerStats* CollectivePeerStats::Global() {
+  static CollectivePeerStats* stats = new CollectivePeerStats;
+  return stats;
+}
+
+void CollectivePeerStats::RecordRecv(const string& peer_task, int64_t bytes,
+                                     int64_t micros) {
+  mutex_lock l(mu_);
+  PeerStats& peer = peers_[peer_task];
+  ++peer.num_recvs;
+  peer.bytes += bytes;
+  peer.total_micros += micros;
+  peer.max_micros = std::max(peer.max_micros, micros);
+}
+
+CollectivePeerStats::StragglerReport CollectivePeerStats::GetStragglerReport(
+    const CollGroupParams& group) const {
+  StragglerReport report;
+  report.group_key = group.group_key;
+  {
+    absl::flat_hash_set<string> tasks;
+    mutex_lock l(mu_);
+    for (const CollGroupMember& member : group.members) {
+      if (!tasks.insert(member.task).second) continue;
+      auto it = peers_.find(member.task);
+      if (it == peers_.end()) continue;
+      report.peers.push_back(it->second);
+      report.peers.back().task = member.task;
+    }
+  }
+  std::sort(report.peers.begin(), report.peers.end(),
+            [](const PeerStats& a, const PeerStats& b) {
+              return a.MeanMicros() > b.MeanMicros();
+            });
+  std::vector<double> means;
+  for (const PeerStats& peer : report.peers) {
+    if (peer.num_recvs >= kMinRecvs) means.push_back(peer.MeanMicros());
+  }
+  // A straggler can only be told apart from the others with at least two
+  // peers to compare.
+  if (means.size() < 2) return report;
+  const double median = means[means.size() / 2];
+  for (const PeerStats& peer : report.peers) {
+    if (peer.num_recvs < kMinRecvs) continue;
+    if (peer.MeanMicros() >= kStragglerFactor * median) {
+      report.straggler = peer.task;
+    }
+    // The peers are sorted, so only the slowest one can be the straggler.
+    break;
+  }
+  return report;
+}
+
+void CollectivePeerStats::MaybeLogStraggler(const CollGroupParams& group) {
+  {
+    mutex_lock l(mu_);
+    if (++groups_[group.group_key].num_executions % kCheckInterval != 0) {
+      return;
+    }
+  }
+  StragglerReport report = GetStragglerReport(group);
+  {
+    mutex_lock l(mu_);
+    GroupState& state = groups_[group.group_key];
+    if (state.straggler == report.straggler) return;
+    state.straggler = report.straggler;
+  }
+  if (report.straggler.empty()) {
+    VLOG(1) << "Collective group " << group.group_key
+            << " no longer has a straggler: " << report.DebugString();
+  } else {
+    LOG(WARNING) << "Collectives of group " << group.group_key
+                 << " are consistently delayed by " << report.straggler
+                 << ": " << report.DebugString();
+  }
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,99 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_COLLECTIVE_PEER_STATS_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_COLLECTIVE_PEER_STATS_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "tensorflow/core/framework/collective.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+
+namespace tensorflow {
+
+// Accumulates the time spent receiving collective buffers from each remote
+// task of this process, to find the task that delays the collectives of a
+// group.
+//
+// The time of a receive spans from the request to the arrival of the buffer,
+// so it includes the time the peer took to produce the buffer. A task that
+// is consistently slower than the other members of a group is reported as
+// its straggler. Thread-safe.
+class CollectivePeerStats {
+ public:
+  struct PeerStats {
+    string task;
+    int64_t num_recvs = 0;
+    int64_t bytes = 0;
+    int64_t total_micros = 0;
+    int64_t max_micros = 0;
+
+    double MeanMicros() const {
+      return num_recvs == 0 ? 0.0
+                            : static_cast<double>(total_micros) / num_recvs;
+    }
+  };
+
+  struct StragglerReport {
+    int32 group_key = 0;
+    // The remote members of the group with at least one receive, from the
+    // slowest to the fastest on average.
+    std::vector<PeerStats> peers;
+    // The task whose mean receive time is at least kStragglerFactor times the
+    // median of the group, or empty if there is none.
+    string straggler;
+
+    string DebugString() const;
+  };
+
+  // Receives from a task are only compared after this many of them.
+  static constexpr int64_t kMinRecvs = 16;
+  static constexpr double kStragglerFactor = 2.0;
+  // Number of executions of the collectives of a group between two checks
+  // for a new straggler by MaybeLogStraggler().
+  static constexpr int64_t kCheckInterval = 256;
+
+  CollectivePeerStats() = default;
+
+  // Returns the statistics of this process.
+  static CollectivePeerStats* Global();
+
+  // Records a receive of `bytes` from `peer_task` that took `micros`.
+  void RecordRecv(const string& peer_task, int64_t bytes, int64_t micros);
+
+  // Returns the statistics of the remote members of `group`.
+  StragglerReport GetStragglerReport(const CollGroupParams& group) const;
+
+  // Called after each collective of `group`. Logs the straggler report of the
+  // group every kCheckInterval calls if its straggler changed.
+  void MaybeLogStraggler(const CollGroupParams& group);
+
+ private:
+  struct GroupState {
+    int64_t num_executions = 0;
+    string straggler;
+  };
+
+  mutable mutex mu_;
+  absl::flat_hash_map<string, PeerStats> peers_ TF_GUARDED_BY(mu_);
+  absl::flat_hash_map<int32, GroupState> groups_ TF_GUARDED_BY(mu_);
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_COLLECTIVE_PEER_STATS_H_
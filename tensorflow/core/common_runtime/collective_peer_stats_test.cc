@@ -0,0 +1,98 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/collective_peer_stats.h"
+
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/collective.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+CollGroupParams MakeGroup(int32 group_key, const std::vector<string>& tasks) {
+  CollGroupParams group;
+  group.group_key = group_key;
+  for (const string& task : tasks) {
+    CollGroupMember member;
+    member.task = task;
+    group.members.push_back(member);
+  }
+  group.group_size = group.members.size();
+  return group;
+}
+
+TEST(CollectivePeerStatsTest, ReportsStraggler) {
+  CollectivePeerStats stats;
+  for (int i = 0; i < CollectivePeerStats::kMinRecvs; ++i) {
+    stats.RecordRecv("/job:worker/task:1", 100, 10);
+    stats.RecordRecv("/job:worker/task:2", 100, 12);
+    stats.RecordRecv("/job:worker/task:3", 100, 50);
+  }
+  CollectivePeerStats::StragglerReport report = stats.GetStragglerReport(
+      MakeGroup(1, {"/job:worker/task:0", "/job:worker/task:1",
+                    "/job:worker/task:2", "/job:worker/task:3"}));
+  EXPECT_EQ(report.straggler, "/job:worker/task:3");
+  ASSERT_EQ(report.peers.size(), 3);
+  EXPECT_EQ(report.peers[0].task, "/job:worker/task:3");
+  EXPECT_EQ(report.peers[0].num_recvs, CollectivePeerStats::kMinRecvs);
+  EXPECT_EQ(report.peers[0].bytes, 100 * CollectivePeerStats::kMinRecvs);
+  EXPECT_EQ(report.peers[0].max_micros, 50);
+  EXPECT_EQ(report.peers[2].task, "/job:worker/task:1");
+}
+
+TEST(CollectivePeerStatsTest, NoStragglerWhenBalanced) {
+  CollectivePeerStats stats;
+  for (int i = 0; i < CollectivePeerStats::kMinRecvs; ++i) {
+    stats.RecordRecv("/job:worker/task:1", 100, 10);
+    stats.RecordRecv("/job:worker/task:2", 100, 15);
+  }
+  CollectivePeerStats::StragglerReport report = stats.GetStragglerReport(
+      MakeGroup(1, {"/job:worker/task:1", "/job:worker/task:2"}));
+  EXPECT_EQ(report.peers.size(), 2);
+  EXPECT_TRUE(report.straggler.empty());
+}
+
+TEST(CollectivePeerStatsTest, IgnoresPeersWithFewRecvs) {
+  CollectivePeerStats stats;
+  for (int i = 0; i < CollectivePeerStats::kMinRecvs; ++i) {
+    stats.RecordRecv("/job:worker/task:1", 100, 10);
+    stats.RecordRecv("/job:worker/task:2", 100, 10);
+  }
+  stats.RecordRecv("/job:worker/task:3", 100, 1000);
+  CollectivePeerStats::StragglerReport report = stats.GetStragglerReport(
+      MakeGroup(1, {"/job:worker/task:1", "/job:worker/task:2",
+                    "/job:worker/task:3"}));
+  EXPECT_EQ(report.peers.size(), 3);
+  EXPECT_TRUE(report.straggler.empty());
+}
+
+TEST(CollectivePeerStatsTest, OnlyReportsMembersOfTheGroup) {
+  CollectivePeerStats stats;
+  for (int i = 0; i < CollectivePeerStats::kMinRecvs; ++i) {
+    stats.RecordRecv("/job:worker/task:1", 100, 10);
+    stats.RecordRecv("/job:worker/task:2", 100, 10);
+    stats.RecordRecv("/job:worker/task:3", 100, 1000);
+  }
+  CollectivePeerStats::StragglerReport report = stats.GetStragglerReport(
+      MakeGroup(2, {"/job:worker/task:1", "/job:worker/task:2"}));
+  EXPECT_EQ(report.group_key, 2);
+  EXPECT_EQ(report.peers.size(), 2);
+  EXPECT_TRUE(report.straggler.empty());
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -17,12 +17,16 @@ limitations under the License.
 
 #include <algorithm>
 #include <atomic>
+#include <cstdint>
+#include <optional>
 #include <set>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_set.h"
+#include "tensorflow/core/common_runtime/constant_folding_cache.h"
 #include "tensorflow/core/common_runtime/device_factory.h"
 #include "tensorflow/core/common_runtime/executor.h"
 #include "tensorflow/core/common_runtime/function_utils.h"
@@ -30,6 +34,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/memory_types.h"
 #include "tensorflow/core/common_runtime/rendezvous_mgr.h"
 #include "tensorflow/core/framework/log_memory.h"
+#include "tensorflow/core/framework/op.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/framework/types.pb.h"
@@ -689,13 +694,39 @@ absl::Status ConstantFold(const ConstantFoldingOptions& opts,
     graph_runner.reset(nullptr);
   });
 
-  absl::Status s =
-      graph_runner->Run(constant_graph.get(), function_library, {} /* inputs*/,
-                        tensors_to_fetch_names, &outputs);
-  if (!s.ok()) {
-    VLOG(1) << "Could not fetch constants: " << s;
-    *was_mutated = false;
-    return s;
+  // Function calls are only cached by name, so graphs that call functions
+  // are always evaluated.
+  ConstantFoldingCache* cache = ConstantFoldingCache::Global();
+  std::optional<std::string> cache_key;
+  if (cache != nullptr &&
+      absl::c_all_of(constant_graph->op_nodes(), [](const Node* n) {
+        const OpRegistrationData* op_reg_data = nullptr;
+        return OpRegistry::Global()
+            ->LookUp(n->type_string(), &op_reg_data)
+            .ok();
+      })) {
+    GraphDef constant_graph_def;
+    constant_graph->ToGraphDef(&constant_graph_def);
+    cache_key =
+        ConstantFoldingCache::GraphKey(constant_graph_def,
+                                       tensors_to_fetch_names);
+    std::optional<std::vector<Tensor>> cached = cache->Lookup(*cache_key);
+    if (cached.has_value()) {
+      outputs = *std::move(cached);
+    }
+  }
+  if (outputs.empty()) {
+    absl::Status s = graph_runner->Run(constant_graph.get(), function_library,
+                                       {} /* inputs*/, tensors_to_fetch_names,
+                                       &outputs);
+    if (!s.ok()) {
+      VLOG(1) << "Could not fetch constants: " << s;
+      *was_mutated = false;
+      return s;
+    }
+    if (cache_key.has_value()) {
+      cache->Insert(*cache_key, outputs);
+    }
   }
 
   // Fetch the constant tensors and replace the corresponding tensors in the
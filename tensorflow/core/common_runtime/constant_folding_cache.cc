@@ -0,0 +1,166 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/constant_folding_cache.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/types/span.h"
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/strings/proto_serialization.h"
+#include "tensorflow/core/platform/coding.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/stringpiece.h"
+#include "tensorflow/core/platform/tstring.h"
+#include "tensorflow/core/util/env_var.h"
+
+namespace tensorflow {
+namespace {
+
+// Keeps the keys of nodes and graphs apart.
+constexpr char kNodeKeyPrefix = 'n';
+constexpr char kGraphKeyPrefix = 'g';
+
+// Appends `data` to `key`, prefixed by its length.
+void AppendData(StringPiece data, std::string* key) {
+  core::PutVarint64(key, data.size());
+  key->append(data.data(), data.size());
+}
+
+// Appends the dtype, shape and value of `tensor` to `key`. Returns false if
+// `tensor` is a resource or a variant, whose value can't be compared.
+bool AppendTensor(const Tensor& tensor, std::string* key) {
+  if (tensor.dtype() == DT_RESOURCE || tensor.dtype() == DT_VARIANT) {
+    return false;
+  }
+  core::PutVarint64(key, tensor.dtype());
+  core::PutVarint64(key, tensor.dims());
+  for (int64_t dim : tensor.shape().dim_sizes()) {
+    core::PutVarint64(key, dim);
+  }
+  if (tensor.dtype() == DT_STRING) {
+    for (const tstring& s : tensor.flat<tstring>()) {
+      AppendData(StringPiece(s.data(), s.size()), key);
+    }
+  } else {
+    AppendData(tensor.tensor_data(), key);
+  }
+  return true;
+}
+
+}  // namespace
+
+ConstantFoldingCache::ConstantFoldingCache(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+ConstantFoldingCache* ConstantFoldingCache::Global() {
+  static ConstantFoldingCache* cache = []() {
+    int64_t max_bytes = 0;
+    absl::Status s = ReadInt64FromEnvVar("TF_CONSTANT_FOLDING_CACHE_BYTES",
+                                         /*default_val=*/0, &max_bytes);
+    if (!s.ok()) {
+      LOG(WARNING) << "Disabling the constant folding cache: " << s;
+      max_bytes = 0;
+    }
+    if (max_bytes <= 0) {
+      return static_cast<ConstantFoldingCache*>(nullptr);
+    }
+    return new ConstantFoldingCache(max_bytes);
+  }();
+  return cache;
+}
+
+std::optional<std::string> ConstantFoldingCache::NodeKey(
+    const NodeDef& node, absl::Span<const Tensor* const> inputs) {
+  NodeDef computation;
+  computation.set_op(node.op());
+  *computation.mutable_attr() = node.attr();
+  std::string serialized;
+  if (!SerializeToStringDeterministic(computation, &serialized)) {
+    return std::nullopt;
+  }
+  std::string key(1, kNodeKeyPrefix);
+  AppendData(serialized, &key);
+  for (const Tensor* input : inputs) {
+    if (!AppendTensor(*input, &key)) return std::nullopt;
+  }
+  return key;
+}
+
+std::string ConstantFoldingCache::GraphKey(
+    const GraphDef& graph, absl::Span<const std::string> fetches) {
+  std::string serialized;
+  SerializeToStringDeterministic(graph, &serialized);
+  std::string key(1, kGraphKeyPrefix);
+  AppendData(serialized, &key);
+  for (const std::string& fetch : fetches) {
+    AppendData(fetch, &key);
+  }
+  return key;
+}
+
+std::optional<std::vector<Tensor>> ConstantFoldingCache::Lookup(
+    const std::string& key) {
+  mutex_lock l(mu_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+  return it->second.tensors;
+}
+
+void ConstantFoldingCache::Insert(const std::string& key,
+                                  std::vector<Tensor> tensors) {
+  size_t bytes = key.size();
+  for (const Tensor& tensor : tensors) {
+    bytes += tensor.TotalBytes();
+  }
+  if (bytes > max_bytes_ / 4) {
+    return;
+  }
+
+  mutex_lock l(mu_);
+  if (entries_.contains(key)) {
+    return;
+  }
+  while (bytes_ + bytes > max_bytes_) {
+    auto it = entries_.find(keys_.front());
+    bytes_ -= it->second.bytes;
+    entries_.erase(it);
+    keys_.pop_front();
+  }
+  entries_[key] = Entry{std::move(tensors), bytes};
+  keys_.push_back(key);
+  bytes_ += bytes;
+}
+
+void ConstantFoldingCache::Clear() {
+  mutex_lock l(mu_);
+  entries_.clear();
+  keys_.clear();
+  bytes_ = 0;
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,100 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_CONSTANT_FOLDING_CACHE_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_CONSTANT_FOLDING_CACHE_H_
+
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/types/span.h"
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+
+namespace tensorflow {
+
+// Caches the tensors computed by constant folding, so that the same
+// computation is not evaluated again when a graph is rewritten several times,
+// when a function is instantiated again, or when both Grappler's
+// ConstantFolding and the graph-level ConstantFold() see it.
+//
+// Entries are keyed by the full description of the computation, including
+// the values of its inputs, so a hit is only returned for the same
+// computation. Keys count towards the size of the cache.
+//
+// Cached tensors share their buffers with the tensors returned by Lookup(),
+// which must not be modified.
+//
+// ConstantFoldingCache is thread-safe.
+class ConstantFoldingCache {
+ public:
+  // Creates a cache that holds up to `max_bytes` bytes of tensors.
+  explicit ConstantFoldingCache(size_t max_bytes);
+
+  // Returns the process-wide cache, or nullptr if caching is disabled, which
+  // is the default. Setting TF_CONSTANT_FOLDING_CACHE_BYTES to a positive
+  // size in bytes enables it.
+  static ConstantFoldingCache* Global();
+
+  // Returns the key of the outputs of evaluating `node` on `inputs`. It
+  // covers the op, its attributes and the values of the inputs, but not the
+  // name or device of the node. Returns std::nullopt if the inputs can't be
+  // fingerprinted, which is the case for resources and variants.
+  static std::optional<std::string> NodeKey(
+      const NodeDef& node, absl::Span<const Tensor* const> inputs);
+
+  // Returns the key of the values of `fetches` in `graph`, a graph that only
+  // depends on constants.
+  static std::string GraphKey(const GraphDef& graph,
+                              absl::Span<const std::string> fetches);
+
+  // Returns the tensors cached under `key`, if any.
+  std::optional<std::vector<Tensor>> Lookup(const std::string& key)
+      TF_LOCKS_EXCLUDED(mu_);
+
+  // Caches `tensors` under `key`, evicting the oldest entries to stay within
+  // the size of the cache. Entries larger than a quarter of the cache are not
+  // cached.
+  void Insert(const std::string& key, std::vector<Tensor> tensors)
+      TF_LOCKS_EXCLUDED(mu_);
+
+  // Removes all the cached tensors.
+  void Clear() TF_LOCKS_EXCLUDED(mu_);
+
+ private:
+  struct Entry {
+    std::vector<Tensor> tensors;
+    size_t bytes;
+  };
+
+  const size_t max_bytes_;
+
+  mutex mu_;
+  absl::flat_hash_map<std::string, Entry> entries_ TF_GUARDED_BY(mu_);
+  // Keys in insertion order, to evict the oldest entries first.
+  std::deque<std::string> keys_ TF_GUARDED_BY(mu_);
+  size_t bytes_ TF_GUARDED_BY(mu_) = 0;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_CONSTANT_FOLDING_CACHE_H_
@@ -0,0 +1,124 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/constant_folding_cache.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+NodeDef MakeAddNode(const string& name, const string& device) {
+  NodeDef node;
+  node.set_name(name);
+  node.set_op("Add");
+  node.set_device(device);
+  node.add_input("x");
+  node.add_input("y");
+  (*node.mutable_attr())["T"].set_type(DT_FLOAT);
+  return node;
+}
+
+TEST(ConstantFoldingCacheTest, NodeKeyIgnoresNameAndDevice) {
+  const Tensor x = test::AsTensor<float>({1, 2});
+  const Tensor y = test::AsTensor<float>({3, 4});
+  EXPECT_EQ(ConstantFoldingCache::NodeKey(MakeAddNode("a", ""), {&x, &y}),
+            ConstantFoldingCache::NodeKey(MakeAddNode("b", "/device:CPU:0"),
+                                          {&x, &y}));
+}
+
+TEST(ConstantFoldingCacheTest, NodeKeyDependsOnInputs) {
+  const NodeDef node = MakeAddNode("a", "");
+  const Tensor x = test::AsTensor<float>({1, 2});
+  const Tensor y = test::AsTensor<float>({3, 4});
+  const Tensor reshaped_y = test::AsTensor<float>({3, 4}, {2, 1});
+  const std::optional<std::string> key =
+      ConstantFoldingCache::NodeKey(node, {&x, &y});
+  ASSERT_TRUE(key.has_value());
+  EXPECT_NE(key, ConstantFoldingCache::NodeKey(node, {&y, &x}));
+  EXPECT_NE(key, ConstantFoldingCache::NodeKey(node, {&x, &reshaped_y}));
+
+  NodeDef other_node = node;
+  other_node.set_op("Sub");
+  EXPECT_NE(key, ConstantFoldingCache::NodeKey(other_node, {&x, &y}));
+}
+
+TEST(ConstantFoldingCacheTest, NodeKeyOfStrings) {
+  NodeDef node;
+  node.set_op("StringJoin");
+  const Tensor a = test::AsTensor<tstring>({"a", "b"});
+  const Tensor b = test::AsTensor<tstring>({"a", "c"});
+  EXPECT_NE(ConstantFoldingCache::NodeKey(node, {&a}),
+            ConstantFoldingCache::NodeKey(node, {&b}));
+}
+
+TEST(ConstantFoldingCacheTest, NoNodeKeyForResources) {
+  NodeDef node;
+  node.set_op("ReadVariableOp");
+  const Tensor resource(DT_RESOURCE, TensorShape({}));
+  EXPECT_EQ(ConstantFoldingCache::NodeKey(node, {&resource}), std::nullopt);
+}
+
+TEST(ConstantFoldingCacheTest, DisabledByDefault) {
+  EXPECT_EQ(ConstantFoldingCache::Global(), nullptr);
+}
+
+TEST(ConstantFoldingCacheTest, LookupComparesFullKey) {
+  const NodeDef node = MakeAddNode("a", "");
+  const Tensor x = test::AsTensor<float>({1, 2});
+  const Tensor y = test::AsTensor<float>({3, 4});
+  const Tensor other_y = test::AsTensor<float>({3, 5});
+  ConstantFoldingCache cache(/*max_bytes=*/1024);
+  cache.Insert(*ConstantFoldingCache::NodeKey(node, {&x, &y}), {x});
+  EXPECT_TRUE(
+      cache.Lookup(*ConstantFoldingCache::NodeKey(node, {&x, &y})).has_value());
+  EXPECT_EQ(cache.Lookup(*ConstantFoldingCache::NodeKey(node, {&x, &other_y})),
+            std::nullopt);
+}
+
+TEST(ConstantFoldingCacheTest, EvictsOldestEntries) {
+  // Room for four tensors of 4 floats, with keys of 1 byte.
+  ConstantFoldingCache cache(/*max_bytes=*/80);
+  const Tensor t(DT_FLOAT, TensorShape({4}));
+  for (const std::string key : {"1", "2", "3", "4", "5"}) {
+    cache.Insert(key, {t});
+  }
+  EXPECT_EQ(cache.Lookup("1"), std::nullopt);
+  std::optional<std::vector<Tensor>> cached = cache.Lookup("2");
+  ASSERT_TRUE(cached.has_value());
+  ASSERT_EQ(cached->size(), 1);
+  EXPECT_TRUE(cached->front().SharesBufferWith(t));
+  EXPECT_TRUE(cache.Lookup("5").has_value());
+
+  cache.Clear();
+  EXPECT_EQ(cache.Lookup("5"), std::nullopt);
+}
+
+TEST(ConstantFoldingCacheTest, SkipsLargeEntries) {
+  ConstantFoldingCache cache(/*max_bytes=*/64);
+  cache.Insert("1", {Tensor(DT_FLOAT, TensorShape({4}))});
+  EXPECT_EQ(cache.Lookup("1"), std::nullopt);
+}
+
+}  // namespace
+}  // namespace tensorflow
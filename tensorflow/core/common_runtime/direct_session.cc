@@ -63,14 +63,18 @@ limitations under the License.
 #include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/core/threadpool_options.h"
 #include "tensorflow/core/lib/gtl/array_slice.h"
+#include "tensorflow/core/lib/io/path.h"
 #include "tensorflow/core/lib/monitoring/counter.h"
 #include "tensorflow/core/lib/random/random.h"
 #include "tensorflow/core/lib/strings/numbers.h"
+#include "tensorflow/core/lib/strings/proto_serialization.h"
 #include "tensorflow/core/lib/strings/str_util.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/nccl/collective_communicator.h"
 #include "tensorflow/core/platform/byte_order.h"
 #include "tensorflow/core/platform/cpu_info.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/fingerprint.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/types.h"
@@ -78,8 +82,11 @@ limitations under the License.
 #include "tensorflow/core/profiler/lib/device_profiler_session.h"
 #include "tensorflow/core/profiler/lib/traceme_encode.h"
 #include "tensorflow/core/protobuf/config.pb.h"
+#include "tensorflow/core/protobuf/partition_graph_cache.pb.h"
+#include "tensorflow/core/public/version.h"
 #include "tensorflow/core/util/device_name_utils.h"
 #include "tensorflow/core/util/env_var.h"
+#include "xla/tsl/profiler/backends/cpu/continuous_profiler.h"
 
 namespace tensorflow {
 
@@ -89,6 +96,11 @@ auto* direct_session_runs = monitoring::Counter<0>::New(
     "/tensorflow/core/direct_session_runs",
     "The number of times DirectSession::Run() has been called.");
 
+auto* partition_graph_cache_hits = monitoring::Counter<0>::New(
+    "/tensorflow/core/direct_session_partition_graph_cache_hits",
+    "The number of times DirectSession loaded the partition graphs of a "
+    "callable from ConfigProto.Experimental.partition_graph_cache_dir.");
+
 absl::Status NewThreadPoolFromThreadPoolOptions(
     const SessionOptions& options,
     const ThreadPoolOptionProto& thread_pool_options, int pool_number,
@@ -159,6 +171,55 @@ string GetRendezvousKey(const string& tensor_name,
                          frame_iter.frame_id, ":", frame_iter.iter_id);
 }
 
+// Returns the file in `cache_dir` that holds the partition graphs for running
+// the graph with fingerprint `graph_fingerprint` with `subgraph_options`, in a
+// session with `options` on `devices`.
+string PartitionGraphCacheFile(const string& cache_dir,
+                               uint64 graph_fingerprint,
+                               const SessionOptions& options,
+                               const BuildGraphOptions& subgraph_options,
+                               const std::vector<Device*>& devices) {
+  uint64 fingerprint = FingerprintCat64(
+      graph_fingerprint, DeterministicProtoHash64(options.config));
+  fingerprint = FingerprintCat64(
+      fingerprint, DeterministicProtoHash64(subgraph_options.callable_options));
+  fingerprint = FingerprintCat64(
+      fingerprint,
+      Fingerprint64(strings::StrCat(
+          subgraph_options.use_function_convention, ";",
+          subgraph_options.collective_graph_key, ";",
+          static_cast<int>(subgraph_options.collective_order), ";",
+          TF_GRAPH_DEF_VERSION, ";", TF_VERSION_STRING)));
+  for (const Device* device : devices) {
+    fingerprint = FingerprintCat64(
+        fingerprint,
+        Fingerprint64(strings::StrCat(
+            device->name(), ";", device->device_type(), ";",
+            device->attributes().memory_limit(), ";",
+            device->attributes().physical_device_desc())));
+  }
+  return io::JoinPath(cache_dir,
+                      strings::StrCat(strings::FpToString(fingerprint), ".pb"));
+}
+
+// Writes `entry` to `file_name` so that concurrent readers never see a
+// partially written file.
+absl::Status WritePartitionGraphCache(Env* env, const string& file_name,
+                                      const PartitionGraphCacheEntry& entry) {
+  TF_RETURN_IF_ERROR(env->RecursivelyCreateDir(string(io::Dirname(file_name))));
+  string temp_file_name = file_name;
+  if (!env->CreateUniqueFileName(&temp_file_name, ".tmp")) {
+    return errors::Unavailable("Could not create a temporary file name for ",
+                               file_name);
+  }
+  TF_RETURN_IF_ERROR(WriteBinaryProto(env, temp_file_name, entry));
+  absl::Status s = env->RenameFile(temp_file_name, file_name);
+  if (!s.ok()) {
+    env->DeleteFile(temp_file_name).IgnoreError();
+  }
+  return s;
+}
+
 }  // namespace
 
 class DirectSessionFactory : public SessionFactory {
@@ -440,6 +501,11 @@ absl::Status DirectSession::ExtendLocked(GraphDef&& graph) {
   if (finalized_) {
     return errors::FailedPrecondition("Session has been finalized.");
   }
+  uint64 graph_fingerprint = graph_fingerprint_;
+  if (!options_.config.experimental().partition_graph_cache_dir().empty()) {
+    graph_fingerprint =
+        FingerprintCat64(graph_fingerprint, DeterministicProtoHash64(graph));
+  }
   if (!(flib_def_ && execution_state_)) {
     // If this is the first call, we can initialize the execution state
     // with `graph` and do not need to call `Extend()`.
@@ -464,6 +530,7 @@ absl::Status DirectSession::ExtendLocked(GraphDef&& graph) {
     execution_state_.swap(state);
     TF_RETURN_IF_ERROR(flib_def_->AddLibrary(graph.library()));
   }
+  graph_fingerprint_ = graph_fingerprint;
   return absl::OkStatus();
 }
 
@@ -517,6 +584,8 @@ absl::Status DirectSession::RunInternal(
   RunState run_state(step_id, &devices_);
   const size_t num_executors = executors_and_keys->items.size();
 
+  // Started first, so that a sampled step records all of its TraceMes.
+  tsl::profiler::ContinuousProfiler::Step continuous_profiler_step;
   tsl::profiler::TraceMeProducer activity(
       // To TraceMeConsumers in ExecutorState::Process/Finish.
       [&] {
@@ -667,6 +736,9 @@ absl::Status DirectSession::RunInternal(
   args.session_state = &session_state_;
   args.session_handle = session_handle_;
   args.tensor_store = &run_state.tensor_store;
+  if (run_options.experimental().reuse_buffers_across_steps()) {
+    args.buffer_cache = &executors_and_keys->buffer_cache;
+  }
   args.step_container = &run_state.step_container;
   args.sync_on_finish = sync_on_finish_;
   args.user_intra_op_threadpool = threadpool_options.intra_op_threadpool;
@@ -1614,26 +1686,114 @@ absl::Status DirectSession::CreateGraphs(
   }
 
   std::unique_ptr<ClientGraph> client_graph;
+  std::unordered_map<string, GraphDef> partitions;
+  std::unordered_map<string, string> current_stateful_placements;
+
+  // Partial runs need the full graph, so they do not use the cache.
+  string cache_file;
+  const string& cache_dir =
+      options_.config.experimental().partition_graph_cache_dir();
+  if (!cache_dir.empty() && !run_state_args->is_partial_run) {
+    cache_file = PartitionGraphCacheFile(cache_dir, graph_fingerprint_,
+                                         options_, subgraph_options, devices_);
+  }
+  PartitionGraphCacheEntry cache_entry;
+  bool cache_hit = false;
+  if (!cache_file.empty() && options_.env->FileExists(cache_file).ok()) {
+    absl::Status s = ReadBinaryProto(options_.env, cache_file, &cache_entry);
+    if (s.ok()) {
+      cache_hit = true;
+    } else {
+      LOG(WARNING) << "Ignoring partition graph cache file " << cache_file
+                   << ": " << s;
+      cache_entry.Clear();
+    }
+  }
 
-  std::unique_ptr<GraphExecutionState> temp_exec_state_holder;
-  GraphExecutionState* execution_state = nullptr;
-  if (options_.config.graph_options().place_pruned_graph()) {
-    // Because we are placing pruned graphs, we need to create a
-    // new GraphExecutionState for every new unseen graph,
-    // and then place it.
-    GraphExecutionStateOptions prune_options;
-    prune_options.device_set = &device_set_;
-    prune_options.session_options = &options_;
-    prune_options.stateful_placements = stateful_placements_;
-    prune_options.session_handle = session_handle_;
-    TF_RETURN_IF_ERROR(GraphExecutionState::MakeForPrunedGraph(
-        *execution_state_, prune_options, subgraph_options,
-        &temp_exec_state_holder, &client_graph));
-    execution_state = temp_exec_state_holder.get();
+  if (cache_hit) {
+    VLOG(1) << "Loaded partition graphs from " << cache_file;
+    partition_graph_cache_hits->GetCell()->IncrementBy(1);
+    DataTypeVector feed_types;
+    for (int type : cache_entry.feed_types()) {
+      feed_types.push_back(static_cast<DataType>(type));
+    }
+    DataTypeVector fetch_types;
+    for (int type : cache_entry.fetch_types()) {
+      fetch_types.push_back(static_cast<DataType>(type));
+    }
+    client_graph = std::make_unique<ClientGraph>(
+        std::make_unique<FunctionLibraryDefinition>(OpRegistry::Global(),
+                                                    cache_entry.library()),
+        std::move(feed_types), std::move(fetch_types),
+        cache_entry.collective_graph_key());
+    for (auto& partition : *cache_entry.mutable_partitions()) {
+      partitions.emplace(partition.first, std::move(partition.second));
+    }
+    for (const auto& placement : cache_entry.stateful_placements()) {
+      current_stateful_placements.emplace(placement.first, placement.second);
+    }
   } else {
-    execution_state = execution_state_.get();
-    TF_RETURN_IF_ERROR(
-        execution_state->BuildGraph(subgraph_options, &client_graph));
+    std::unique_ptr<GraphExecutionState> temp_exec_state_holder;
+    GraphExecutionState* execution_state = nullptr;
+    if (options_.config.graph_options().place_pruned_graph()) {
+      // Because we are placing pruned graphs, we need to create a
+      // new GraphExecutionState for every new unseen graph,
+      // and then place it.
+      GraphExecutionStateOptions prune_options;
+      prune_options.device_set = &device_set_;
+      prune_options.session_options = &options_;
+      prune_options.stateful_placements = stateful_placements_;
+      prune_options.session_handle = session_handle_;
+      TF_RETURN_IF_ERROR(GraphExecutionState::MakeForPrunedGraph(
+          *execution_state_, prune_options, subgraph_options,
+          &temp_exec_state_holder, &client_graph));
+      execution_state = temp_exec_state_holder.get();
+    } else {
+      execution_state = execution_state_.get();
+      TF_RETURN_IF_ERROR(
+          execution_state->BuildGraph(subgraph_options, &client_graph));
+    }
+    current_stateful_placements = execution_state->GetStatefulPlacements();
+
+    // Remember the graph in run state if this is a partial run.
+    if (run_state_args->is_partial_run) {
+      run_state_args->graph.reset(new Graph(flib_def_.get()));
+      CopyGraph(*execution_state->full_graph(), run_state_args->graph.get());
+    }
+
+    // Partition the graph across devices.
+    PartitionOptions popts;
+    popts.node_to_loc = [](const Node* node) {
+      return node->assigned_device_name();
+    };
+    popts.new_name = [this](const string& prefix) {
+      return strings::StrCat(prefix, "/_", edge_name_counter_.fetch_add(1));
+    };
+    popts.get_incarnation = [](const string& name) {
+      // The direct session does not have changing incarnation numbers.
+      // Just return '1'.
+      return 1;
+    };
+    popts.flib_def = flib_def->get();
+    popts.control_flow_added = false;
+
+    TF_RETURN_IF_ERROR(Partition(popts, &client_graph->graph, &partitions));
+
+    if (!cache_file.empty()) {
+      cache_entry.mutable_partitions()->insert(partitions.begin(),
+                                               partitions.end());
+      *cache_entry.mutable_library() = client_graph->flib_def->ToProto();
+      for (DataType type : client_graph->feed_types) {
+        cache_entry.add_feed_types(type);
+      }
+      for (DataType type : client_graph->fetch_types) {
+        cache_entry.add_fetch_types(type);
+      }
+      cache_entry.set_collective_graph_key(client_graph->collective_graph_key);
+      cache_entry.mutable_stateful_placements()->insert(
+          current_stateful_placements.begin(),
+          current_stateful_placements.end());
+    }
   }
   *collective_graph_key = client_graph->collective_graph_key;
 
@@ -1654,7 +1814,6 @@ absl::Status DirectSession::CreateGraphs(
         client_graph->fetch_types.size());
   }
 
-  auto current_stateful_placements = execution_state->GetStatefulPlacements();
   // Update our current state based on the execution_state's
   // placements.  If there are any mismatches for a node,
   // we should fail, as this should never happen.
@@ -1672,33 +1831,10 @@ absl::Status DirectSession::CreateGraphs(
     }
   }
 
-  stateful_placements_ = execution_state->GetStatefulPlacements();
-
-  // Remember the graph in run state if this is a partial run.
-  if (run_state_args->is_partial_run) {
-    run_state_args->graph.reset(new Graph(flib_def_.get()));
-    CopyGraph(*execution_state->full_graph(), run_state_args->graph.get());
+  if (!cache_hit) {
+    stateful_placements_ = std::move(current_stateful_placements);
   }
 
-  // Partition the graph across devices.
-  PartitionOptions popts;
-  popts.node_to_loc = [](const Node* node) {
-    return node->assigned_device_name();
-  };
-  popts.new_name = [this](const string& prefix) {
-    return strings::StrCat(prefix, "/_", edge_name_counter_.fetch_add(1));
-  };
-  popts.get_incarnation = [](const string& name) {
-    // The direct session does not have changing incarnation numbers.
-    // Just return '1'.
-    return 1;
-  };
-  popts.flib_def = flib_def->get();
-  popts.control_flow_added = false;
-
-  std::unordered_map<string, GraphDef> partitions;
-  TF_RETURN_IF_ERROR(Partition(popts, &client_graph->graph, &partitions));
-
   std::vector<string> device_names;
   device_names.reserve(devices_.size());
   for (auto device : devices_) {
@@ -1720,6 +1856,15 @@ absl::Status DirectSession::CreateGraphs(
     }
   }
 
+  if (!cache_file.empty() && !cache_hit) {
+    absl::Status s =
+        WritePartitionGraphCache(options_.env, cache_file, cache_entry);
+    if (!s.ok()) {
+      LOG(WARNING) << "Failed to write partition graph cache file "
+                   << cache_file << ": " << s;
+    }
+  }
+
   for (auto& partition : partitions) {
     std::unique_ptr<Graph> device_graph(
         new Graph(client_graph->flib_def.get()));
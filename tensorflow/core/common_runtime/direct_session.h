@@ -34,6 +34,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/session_factory.h"
 #include "tensorflow/core/framework/cancellation.h"
 #include "tensorflow/core/framework/collective.h"
+#include "tensorflow/core/framework/cross_step_buffer_cache.h"
 #include "tensorflow/core/framework/graph.pb.h"
 #include "tensorflow/core/framework/session_state.h"
 #include "tensorflow/core/framework/tensor.h"
@@ -175,6 +176,10 @@ class DirectSession : public Session {
     CallableOptions callable_options;
 
     int64_t collective_graph_key = BuildGraphOptions::kNoCollectiveGraphKey;
+
+    // Buffers kept between steps when
+    // RunOptions.experimental.reuse_buffers_across_steps is set.
+    CrossStepBufferCache buffer_cache;
   };
 
   // A FunctionInfo object is created for every unique set of feeds/fetches.
@@ -398,6 +403,11 @@ class DirectSession : public Session {
   std::unique_ptr<GraphExecutionState> execution_state_
       TF_GUARDED_BY(graph_state_lock_);
 
+  // A fingerprint of the graphs passed to Create() and Extend(), which is part
+  // of the key of the partition graph cache. Only computed if
+  // `ConfigProto.Experimental.partition_graph_cache_dir` is set.
+  uint64 graph_fingerprint_ TF_GUARDED_BY(graph_state_lock_) = 0;
+
   // The function library, before any rewrites or optimizations have been
   // performed. In particular, CreateGraphs() may need to modify the function
   // library; it copies and modifies the function library.
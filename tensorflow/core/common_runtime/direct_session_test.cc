@@ -46,7 +46,9 @@ limitations under the License.
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
 #include "tensorflow/core/lib/core/threadpool.h"
+#include "tensorflow/core/lib/io/path.h"
 #include "tensorflow/core/lib/strings/str_util.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/protobuf.h"
 #include "tensorflow/core/platform/stacktrace.h"
 #include "tensorflow/core/platform/test.h"
@@ -799,6 +801,60 @@ TEST_F(DirectSessionMinusAXTest, UseRunHandlerPool) {
   EXPECT_FLOAT_EQ(5.0, mat(0, 0));
 }
 
+TEST_F(DirectSessionMinusAXTest, ReuseBuffersAcrossSteps) {
+  Initialize({3, 2, -1, 0});
+  auto session = CreateSession();
+  ASSERT_TRUE(session != nullptr);
+  TF_ASSERT_OK(session->Create(def_));
+  std::vector<std::pair<string, Tensor>> inputs;
+  std::vector<string> output_names = {y_ + ":0"};
+  std::vector<string> target_nodes = {y_neg_};
+
+  RunOptions run_options;
+  run_options.mutable_experimental()->set_reuse_buffers_across_steps(true);
+
+  // Fetched tensors from earlier steps must not be overwritten by later steps.
+  std::vector<std::vector<Tensor>> outputs(3);
+  for (auto& step_outputs : outputs) {
+    TF_ASSERT_OK(session->Run(run_options, inputs, output_names, target_nodes,
+                              &step_outputs, nullptr));
+  }
+  for (const auto& step_outputs : outputs) {
+    ASSERT_EQ(1, step_outputs.size());
+    EXPECT_FLOAT_EQ(5.0, step_outputs[0].matrix<float>()(0, 0));
+  }
+}
+
+TEST_F(DirectSessionMinusAXTest, PartitionGraphCache) {
+  Initialize({3, 2, -1, 0});
+  SessionOptions options = DefaultSessionOptions();
+  const string cache_dir =
+      io::JoinPath(testing::TmpDir(), "partition_graph_cache");
+  options.config.mutable_experimental()->set_partition_graph_cache_dir(
+      cache_dir);
+
+  // The first session stores the partition graphs, the second one loads them,
+  // and the third one ignores the corrupted cache file and rebuilds them.
+  for (int i = 0; i < 3; ++i) {
+    std::unique_ptr<Session> session(NewSession(options));
+    ASSERT_TRUE(session != nullptr);
+    TF_ASSERT_OK(session->Create(def_));
+    std::vector<Tensor> outputs;
+    TF_ASSERT_OK(session->Run({}, {z_ + ":0"}, {}, &outputs));
+    ASSERT_EQ(1, outputs.size());
+    EXPECT_FLOAT_EQ(-5.0, outputs[0].matrix<float>()(0, 0));
+
+    std::vector<string> cache_files;
+    TF_ASSERT_OK(Env::Default()->GetChildren(cache_dir, &cache_files));
+    ASSERT_EQ(1, cache_files.size());
+    if (i == 1) {
+      TF_ASSERT_OK(WriteStringToFile(Env::Default(),
+                                     io::JoinPath(cache_dir, cache_files[0]),
+                                     "not a proto"));
+    }
+  }
+}
+
 TEST(DirectSessionTest, KeepsStateAcrossRunsOfSession) {
   GraphDef def;
   Graph g(OpRegistry::Global());
@@ -19,6 +19,7 @@ limitations under the License.
 #include <functional>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/gtl/cleanup.h"
@@ -54,14 +55,20 @@ EagerExecutor::EagerExecutor(bool async, bool enable_streaming_enqueue,
 }
 
 EagerExecutor::~EagerExecutor() {
-  tensorflow::mutex_lock l(node_queue_mutex_);
-  state_ = ExecutorState::kShutDown;
-  nodes_pending_.notify_all();
-  for (const auto& cleanups_for_key : cleanups_) {
-    for (const std::function<void()>& cleanup : cleanups_for_key.second) {
-      cleanup();
+  std::forward_list<core::RefCountPtr<NodeItem>> items_to_abort;
+  {
+    tensorflow::mutex_lock l(node_queue_mutex_);
+    accepting_nodes_ = false;
+    state_ = ExecutorState::kShutDown;
+    DrainIncomingNodesLocked(&items_to_abort);
+    nodes_pending_.notify_all();
+    for (const auto& cleanups_for_key : cleanups_) {
+      for (const std::function<void()>& cleanup : cleanups_for_key.second) {
+        cleanup();
+      }
     }
   }
+  AbortItems(std::move(items_to_abort));
 }
 
 absl::Status EagerExecutor::ShutDown() {
@@ -77,6 +84,7 @@ absl::Status EagerExecutor::ShutDown() {
         // thread_exited_notification_.WaitForNotification() below.
         state_ = ExecutorState::kShuttingDown;
       }
+      accepting_nodes_ = false;
       // It is OK to ignore the returned status here because it will be saved
       // as the final status_.
       WaitForAllPendingNodesLocked(&l).IgnoreError();
@@ -148,6 +156,18 @@ absl::Status EagerExecutor::AddOrExecute(std::unique_ptr<EagerNode> node) {
   if (!Async()) {
     // In sync mode, run the node item regardless of executor status.
     return RunItem(std::move(item), /*from_queue=*/false);
+  } else if (in_flight_nodes_limit_ == 0 && ok() && accepting_nodes_) {
+    // Fast path, which does not need to wait for in-flight nodes. An error
+    // or a shutdown racing with the push aborts the node when it is drained,
+    // as if it had been queued just before.
+    DVLOG(3) << "Add node [id " << item->id << "]" << item->node->DebugString();
+    if (PushIncomingNode(std::move(item))) {
+      // Only the first node of a batch wakes up the run thread, which drains
+      // all the nodes pushed in the meantime.
+      tensorflow::mutex_lock l(node_queue_mutex_);
+      nodes_pending_.notify_all();
+    }
+    return absl::OkStatus();
   } else {
     tensorflow::mutex_lock l(node_queue_mutex_);
     DVLOG(3) << "Add node [id " << item->id << "]" << item->node->DebugString()
@@ -204,6 +224,13 @@ absl::Status EagerExecutor::WaitForAllPendingNodesLocked(mutex_lock* lock) {
   tensorflow::condition_variable cond;
   // Don't wait if an error is already set.
   if (!status_.ok()) return status_;
+  // Once shut down, the nodes left in incoming_nodes_ are not run, and the
+  // destructor aborts them.
+  if (state_ != ExecutorState::kShutDown) {
+    std::forward_list<core::RefCountPtr<NodeItem>> items_to_abort;
+    DrainIncomingNodesLocked(&items_to_abort);
+    DCHECK(items_to_abort.empty());
+  }
   if (node_queue_.empty() && unfinished_nodes_.empty()) return absl::OkStatus();
   // node_queue_ must be empty in sync mode.
   DCHECK(Async() || node_queue_.empty());
@@ -220,15 +247,21 @@ void EagerExecutor::ClearError() {
   // TODO(iga): Check state_ and return an error if it is not kActive.
   if (ok()) return;
 
-  tensorflow::mutex_lock l(node_queue_mutex_);
-  // If an error was set, node_done_notifications_ and node_queue_ should have
-  // been cleared, and no new entries should have been added since.
-  DCHECK(node_done_notifications_.empty());
-  DCHECK(node_queue_.empty());
-  status_ = absl::OkStatus();
-  ok_ = true;
-  last_eager_client_ = nullptr;
-  nodes_pending_.notify_all();
+  std::forward_list<core::RefCountPtr<NodeItem>> items_to_abort;
+  {
+    tensorflow::mutex_lock l(node_queue_mutex_);
+    // Nodes that raced with the error are aborted with it.
+    DrainIncomingNodesLocked(&items_to_abort);
+    // If an error was set, node_done_notifications_ and node_queue_ should
+    // have been cleared, and no new entries should have been added since.
+    DCHECK(node_done_notifications_.empty());
+    DCHECK(node_queue_.empty());
+    status_ = absl::OkStatus();
+    ok_ = true;
+    last_eager_client_ = nullptr;
+    nodes_pending_.notify_all();
+  }
+  AbortItems(std::move(items_to_abort));
 }
 
 void EagerExecutor::NodeDone(const core::RefCountPtr<NodeItem>& item,
@@ -250,6 +283,8 @@ void EagerExecutor::NodeDone(const core::RefCountPtr<NodeItem>& item,
   {
     mutex_lock l(node_queue_mutex_);
     if (!status_.ok()) return;
+    // NotifyWaiters() needs the first pending node.
+    DrainIncomingNodesLocked(&items_to_destroy);
 
     bool need_notification = from_queue;
     if (from_queue) {
@@ -287,6 +322,7 @@ void EagerExecutor::NodeDone(const core::RefCountPtr<NodeItem>& item,
                                 "EagerExecutor. This error cancels all future "
                                 "operations and poisons their output tensors.");
       }
+      DrainIncomingNodesLocked(&items_to_destroy);
       while (!node_queue_.empty()) {
         items_to_destroy.push_front(std::move(node_queue_.front()));
         node_queue_.pop();
@@ -348,21 +384,31 @@ void EagerExecutor::Run() {
       gtl::MakeCleanup([this] { thread_exited_notification_.Notify(); });
   while (true) {
     core::RefCountPtr<NodeItem> curr_item;
+    std::forward_list<core::RefCountPtr<NodeItem>> items_to_abort;
     {
       tensorflow::mutex_lock l(node_queue_mutex_);
-      while (node_queue_.empty() || !status_.ok()) {
+      DrainIncomingNodesLocked(&items_to_abort);
+      while ((node_queue_.empty() || !status_.ok()) &&
+             items_to_abort.empty()) {
         if (state_ == ExecutorState::kShutDown) return;
         nodes_pending_.wait(l);
+        DrainIncomingNodesLocked(&items_to_abort);
       }
-      // Obtain raw pointer since we don't want to remove from the queue until
-      // the node has been run. Otherwise, WaitForAllPendingNodes can return
-      // too early.
-      // Note, we don't std::move from the here because the front of the queue
-      // will then contain a nullptr. This can be a problem in
-      // WaitForAllPendingNodes where we get the top EagerNode pointer
-      // and register a notification for its completion.
-      curr_item.reset(node_queue_.front().get());
-      curr_item->Ref();
+      if (items_to_abort.empty()) {
+        // Obtain raw pointer since we don't want to remove from the queue
+        // until the node has been run. Otherwise, WaitForAllPendingNodes can
+        // return too early.
+        // Note, we don't std::move from the here because the front of the
+        // queue will then contain a nullptr. This can be a problem in
+        // WaitForAllPendingNodes where we get the top EagerNode pointer
+        // and register a notification for its completion.
+        curr_item.reset(node_queue_.front().get());
+        curr_item->Ref();
+      }
+    }
+    if (!items_to_abort.empty()) {
+      AbortItems(std::move(items_to_abort));
+      continue;
     }
     absl::Status status = RunItem(std::move(curr_item), /*from_queue=*/true);
     if (!status.ok()) {
@@ -443,6 +489,51 @@ absl::Status EagerExecutor::MoveToUnfinished(core::RefCountPtr<NodeItem> item,
   return absl::OkStatus();
 }
 
+bool EagerExecutor::PushIncomingNode(core::RefCountPtr<NodeItem> item) {
+  NodeItem* node_item = item.release();
+  node_item->next_incoming = incoming_nodes_.load(std::memory_order_relaxed);
+  while (!incoming_nodes_.compare_exchange_weak(
+      node_item->next_incoming, node_item, std::memory_order_release,
+      std::memory_order_relaxed)) {
+  }
+  return node_item->next_incoming == nullptr;
+}
+
+void EagerExecutor::DrainIncomingNodesLocked(
+    std::forward_list<core::RefCountPtr<NodeItem>>* items_to_abort) {
+  NodeItem* head = incoming_nodes_.exchange(nullptr, std::memory_order_acquire);
+  if (head == nullptr) return;
+  // The stack holds the most recent item first.
+  std::vector<core::RefCountPtr<NodeItem>> items;
+  for (NodeItem* node_item = head; node_item != nullptr;) {
+    NodeItem* next = node_item->next_incoming;
+    node_item->next_incoming = nullptr;
+    items.emplace_back(node_item);
+    node_item = next;
+  }
+  const bool abort = !status_.ok() || state_ == ExecutorState::kShutDown;
+  for (auto it = items.rbegin(); it != items.rend(); ++it) {
+    if (abort) {
+      items_to_abort->push_front(std::move(*it));
+    } else {
+      node_queue_.push(std::move(*it));
+    }
+  }
+}
+
+void EagerExecutor::AbortItems(
+    std::forward_list<core::RefCountPtr<NodeItem>> items) {
+  if (items.empty()) return;
+  absl::Status status = this->status();
+  if (status.ok()) {
+    status = errors::FailedPrecondition(
+        "EagerExecutor was shut down before running the EagerNode");
+  }
+  for (auto& item : items) {
+    item->node->Abort(status);
+  }
+}
+
 void EagerExecutor::AddCleanup(intptr_t key, std::function<void()> callback) {
   cleanups_[key].push_back(callback);
 }
@@ -18,6 +18,7 @@ limitations under the License.
 #include <algorithm>
 #include <atomic>
 #include <cstddef>
+#include <forward_list>
 #include <functional>
 #include <map>
 #include <memory>
@@ -195,6 +196,8 @@ class EagerExecutor {
     uint64 id;
     std::unique_ptr<EagerNode> node;
     NodeState state;
+    // Next item in incoming_nodes_. Owns a reference to it.
+    NodeItem* next_incoming = nullptr;
   };
 
   const char* StateStringLocked()
@@ -204,6 +207,22 @@ class EagerExecutor {
                 const absl::Status& status, bool from_queue);
   void NotifyWaiters(uint64 id) TF_EXCLUSIVE_LOCKS_REQUIRED(node_queue_mutex_);
 
+  // Pushes `item` onto incoming_nodes_ without taking node_queue_mutex_.
+  // Returns true if incoming_nodes_ was empty, in which case the caller must
+  // wake up the executor thread.
+  bool PushIncomingNode(core::RefCountPtr<NodeItem> item);
+
+  // Moves the items of incoming_nodes_ to the back of node_queue_, in the order
+  // they were pushed. If the executor is in an error state or shut down, moves
+  // them to `items_to_abort` instead, whose nodes the caller must abort
+  // without holding node_queue_mutex_.
+  void DrainIncomingNodesLocked(
+      std::forward_list<core::RefCountPtr<NodeItem>>* items_to_abort)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(node_queue_mutex_);
+
+  // Aborts the nodes of `items`. Must be called without node_queue_mutex_.
+  void AbortItems(std::forward_list<core::RefCountPtr<NodeItem>> items);
+
   // Starts execution of pending EagerNodes. This function loops till executor
   // state_ is set to kShutDown. If any errors are encountered, these are set
   // inside `status_`. The loop blocks anytime there are no pending nodes, or if
@@ -234,6 +253,18 @@ class EagerExecutor {
   std::queue<core::RefCountPtr<NodeItem>> node_queue_
       TF_GUARDED_BY(node_queue_mutex_);
 
+  // Lock-free stack of the items added by AddOrExecute() in async mode, most
+  // recent first, that have not yet been moved to node_queue_. This keeps
+  // node_queue_mutex_ off the path of threads that add nodes, except for the
+  // first node of each batch which wakes up the executor thread. Anything
+  // reading node_queue_ must drain it first with DrainIncomingNodesLocked().
+  std::atomic<NodeItem*> incoming_nodes_{nullptr};
+
+  // False once the executor stops accepting new nodes. AddOrExecute() reads it
+  // without the lock, so nodes that race with the transition are aborted when
+  // drained.
+  std::atomic<bool> accepting_nodes_{true};
+
   // Ordered by NodeItem::id.
   std::map<uint64, core::RefCountPtr<NodeItem>, std::less<uint64>>
       unfinished_nodes_ TF_GUARDED_BY(node_queue_mutex_);
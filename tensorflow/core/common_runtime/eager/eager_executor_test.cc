@@ -16,12 +16,15 @@ limitations under the License.
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "xla/tsl/lib/core/status_test_util.h"
 #include "xla/tsl/protobuf/error_codes.pb.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/status_matchers.h"
 #include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/platform/threadpool.h"
 #include "tsl/platform/status.h"
 
 namespace tensorflow {
@@ -213,6 +216,36 @@ TEST(EagerExecutorTest, TestAsyncExecutorWithEagerNode) {
   ASSERT_EQ(state->read_state(), TestState::State::kSuccess);
 }
 
+TEST(EagerExecutorTest, TestAsyncExecutorWithConcurrentProducers) {
+  auto async_executor = std::make_unique<EagerExecutor>(
+      /*async=*/true, /*enable_streaming_enqueue=*/true);
+
+  constexpr int kNumThreads = 8;
+  constexpr int kNodesPerThread = 100;
+  std::vector<TestState> states(kNumThreads * kNodesPerThread);
+  {
+    thread::ThreadPool pool(Env::Default(), "producers", kNumThreads);
+    for (int t = 0; t < kNumThreads; ++t) {
+      pool.Schedule([&, t]() {
+        for (int i = 0; i < kNodesPerThread; ++i) {
+          TestState* state = &states[t * kNodesPerThread + i];
+          if (i % 2 == 0) {
+            TF_ASSERT_OK(async_executor->AddOrExecute(
+                std::make_unique<TestEagerNode>(state)));
+          } else {
+            TF_ASSERT_OK(async_executor->AddOrExecute(
+                std::make_unique<TestAsyncEagerNode>(state)));
+          }
+        }
+      });
+    }
+  }
+  TF_ASSERT_OK(async_executor->WaitForAllPendingNodes());
+  for (TestState& state : states) {
+    ASSERT_EQ(state.read_state(), TestState::State::kSuccess);
+  }
+}
+
 TEST(EagerExecutorTest, TestAsyncExecutorFailPrepare) {
   auto async_executor = std::make_unique<EagerExecutor>(
       /*async=*/true, /*enable_streaming_enqueue=*/true);
@@ -367,6 +367,7 @@ absl::Status EagerOperation::Reset(
   stack_trace_.reset();
   is_function_ = is_function;
   cancellation_manager_ = nullptr;
+  kernel_cache_hint_ = nullptr;
   executor_ = executor ? executor : &ctx_.Executor();
   if (eager_func_params.has_value()) {
     eager_func_params_ = eager_func_params;
@@ -40,6 +40,20 @@ limitations under the License.
 
 namespace tensorflow {
 
+// Remembers the kernel cache key of the last op executed from a call site
+// that repeatedly executes the same primitive op, e.g. the body of a loop.
+// The call site owns the hint and hands it to each EagerOperation with
+// SetKernelCacheHint(). When the attributes and requested device of the op
+// match those of the last execution, the kernel is looked up with the
+// remembered key, skipping device selection and kernel key computation.
+// Must not be used by several threads at once.
+struct EagerKernelCacheHint {
+  // Fingerprint of the op attributes, requested device and placement policy.
+  Fprint128 op_key;
+  Fprint128 kernel_cache_key;
+  bool valid = false;
+};
+
 class EagerOperation : public ImmediateExecutionOperation {
  public:
   explicit EagerOperation(tensorflow::EagerContext* ctx)
@@ -155,6 +169,12 @@ class EagerOperation : public ImmediateExecutionOperation {
       absl::optional<EagerFunctionParams> eager_func_params = std::nullopt);
 
   bool is_function() const { return is_function_; }
+
+  // Not owned. Cleared by Reset().
+  void SetKernelCacheHint(EagerKernelCacheHint* hint) {
+    kernel_cache_hint_ = hint;
+  }
+  EagerKernelCacheHint* kernel_cache_hint() const { return kernel_cache_hint_; }
   bool colocation_exempt() const { return colocation_exempt_; }
 
   tensorflow::EagerContext& EagerContext() const { return ctx_; }
@@ -312,6 +332,7 @@ class EagerOperation : public ImmediateExecutionOperation {
   bool colocation_exempt_;
   CancellationManager* cancellation_manager_ = nullptr;  // Not owned.
   EagerExecutor* executor_;                              // Not owned.
+  EagerKernelCacheHint* kernel_cache_hint_ = nullptr;    // Not owned.
 
   std::optional<EagerFunctionParams> eager_func_params_;
 
@@ -35,6 +35,7 @@ limitations under the License.
 #include "absl/strings/str_replace.h"
 #include "tensorflow/core/common_runtime/arg_ret_placement.h"
 #include "tensorflow/core/common_runtime/eager/eager_operation.h"
+#include "tensorflow/core/common_runtime/eager/op_sequence_detector.h"
 #include "tensorflow/core/common_runtime/eager/small_constants_optimizer.h"
 #include "tensorflow/core/common_runtime/eager/summary_optimizer.h"
 #include "tensorflow/core/common_runtime/int32_fulltype.h"
@@ -56,6 +57,7 @@ limitations under the License.
 #include "absl/container/inlined_vector.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
 #include "absl/types/optional.h"
 #include "tensorflow/c/tf_tensor_internal.h"
 #include "tensorflow/compiler/jit/defs.h"
@@ -132,6 +134,46 @@ bool SendAsProtosWhenPossible() {
   return send_as_protos_when_possible;
 }
 
+// Copies of op inputs to another device are kept as mirrors of the input
+// handle, so that a host tensor fed to device ops again and again is only
+// uploaded once. Inputs larger than this many bytes are only mirrored once they
+// are copied a second time; -1 mirrors every copy.
+int64_t MaxInputMirrorBytes() {
+  static int64_t max_input_mirror_bytes = []() {
+    int64_t result;
+    TF_CHECK_OK(tsl::ReadInt64FromEnvVar("TF_EAGER_MAX_INPUT_MIRROR_BYTES",
+                                         int64_t{64} << 20, &result));
+    return result;
+  }();
+  return max_input_mirror_bytes;
+}
+
+bool DetectRepeatedOpSequences() {
+  static bool detect_repeated_op_sequences = []() {
+    bool result;
+    TF_CHECK_OK(tsl::ReadBoolFromEnvVar("TF_EAGER_DETECT_REPEATED_OP_SEQUENCES",
+                                        false, &result));
+    return result;
+  }();
+  return detect_repeated_op_sequences;
+}
+
+// Logs the sequences of ops that a thread executes again and again, e.g. in a
+// Python loop, as candidates for a tf.function.
+void RecordOpForSequenceDetection(EagerOperation* op) {
+  constexpr int kMaxSequenceLength = 64;
+  constexpr int kMinRepeats = 5;
+  thread_local OpSequenceDetector detector(kMaxSequenceLength, kMinRepeats);
+  std::vector<string> op_names = detector.Record(
+      op->MutableAttrs()->CacheKey(op->DeviceName()), op->Name());
+  if (op_names.empty()) return;
+  LOG(INFO) << "A sequence of " << op_names.size() << " eager ops was executed "
+            << kMinRepeats << " times in a row: "
+            << absl::StrJoin(op_names, ", ")
+            << ". Running the code that executes it in a tf.function would "
+               "remove the per-op dispatch overhead.";
+}
+
 const string& DeviceNameOrUnspecified(Device* device) {
   static string* unspecified_string = new string("<unspecified>");
   return (device == nullptr) ? *unspecified_string : device->name();
@@ -213,9 +255,13 @@ absl::Status CopyInputToExpectedDevice(EagerContext* ctx, EagerOperation* op,
                             " to ", expected_input_device->name());
       },
       tsl::profiler::TraceMeLevel::kInfo);
+  const bool mirror =
+      !expected_input_device->IsLocal() ||
+      handle->ShouldMirrorCopy(ctx->CanonicalDevice(expected_input_device),
+                               MaxInputMirrorBytes());
   absl::Status status =
       EagerCopyToDevice(handle, ctx, &op->Executor(), expected_input_device,
-                        /* mirror= */ true, &result_handle);
+                        mirror, &result_handle);
   activity.Stop();
   if (!status.ok()) {
     return absl::Status(
@@ -1238,12 +1284,55 @@ absl::Status SetOpDevice(EagerContext& ctx, EagerOperation* op,
   return absl::OkStatus();
 }
 
+// Returns the key of `op` for its kernel cache hint, or nullopt if `op` has no
+// hint or its kernel may depend on more than its attributes, requested device
+// and the soft placement policy, e.g. on the devices of its inputs.
+std::optional<Fprint128> GetKernelCacheHintKey(EagerOperation* op) {
+  EagerContext& ctx = op->EagerContext();
+  if (op->kernel_cache_hint() == nullptr || op->is_function() ||
+      ctx.RunEagerOpAsFunction()) {
+    return std::nullopt;
+  }
+  return tsl::FingerprintCat128(op->MutableAttrs()->CacheKey(op->DeviceName()),
+                                ctx.AllowSoftPlacement());
+}
+
+absl::Status SetOutKernel(core::RefCountPtr<KernelAndDevice> kernel,
+                          int* num_retvals,
+                          core::RefCountPtr<KernelAndDevice>* out_kernel) {
+  int num_outputs = kernel->num_outputs();
+  if (num_outputs > *num_retvals) {
+    return errors::InvalidArgument("Expecting ", num_outputs,
+                                   " outputs, but *num_retvals is ",
+                                   *num_retvals);
+  }
+  *num_retvals = num_outputs;
+  *out_kernel = std::move(kernel);
+  return absl::OkStatus();
+}
+
 absl::Status GetOrCreateKernelAndDevice(
     EagerOperation* op, TensorHandle** retvals, int* num_retvals,
     core::RefCountPtr<KernelAndDevice>* out_kernel) {
   EagerContext& ctx = op->EagerContext();
   Device* device = std::get<Device*>(op->Device());
 
+  // Fast path for call sites that execute the same op again. The kernel might
+  // have been evicted from the cache since, in which case we take the slow
+  // path.
+  const std::optional<Fprint128> hint_key = GetKernelCacheHintKey(op);
+  if (hint_key.has_value()) {
+    const EagerKernelCacheHint& hint = *op->kernel_cache_hint();
+    if (hint.valid && hint.op_key == *hint_key) {
+      core::RefCountPtr<KernelAndDevice> kernel =
+          ctx.GetCachedKernel(hint.kernel_cache_key);
+      if (kernel != nullptr) {
+        if (device == nullptr) op->SetDevice(kernel->device());
+        return SetOutKernel(std::move(kernel), num_retvals, out_kernel);
+      }
+    }
+  }
+
   // Update the EagerOperation with information about the boolean input tensors
   // when small constant optimization is enabled.
   auto is_small_constant_optimization_enabled =
@@ -1311,8 +1400,9 @@ absl::Status GetOrCreateKernelAndDevice(
   absl::flat_hash_map<string, const std::vector<string>*> composite_devices;
   std::unordered_map<int, DtypeAndPartialTensorShape>
       input_resource_variable_dtypes_and_shapes;
+  // The kernel def is only needed to run the op as a function.
   const KernelDef* kernel_def = nullptr;
-  if (!op->is_function()) {
+  if (!op->is_function() && ctx.RunEagerOpAsFunction()) {
     const NodeDef& node_def = op->MutableAttrs()->BuildNodeDef();
     auto get_kernel_def = [](const EagerOperation& op, const NodeDef& node_def,
                              const Device* op_device) -> const KernelDef* {
@@ -1570,17 +1660,13 @@ absl::Status GetOrCreateKernelAndDevice(
     }
   }
 
-  int num_outputs = kernel->num_outputs();
-  if (num_outputs > *num_retvals) {
-    return errors::InvalidArgument("Expecting ", num_outputs,
-                                   " outputs, but *num_retvals is ",
-                                   *num_retvals);
+  if (hint_key.has_value()) {
+    EagerKernelCacheHint* hint = op->kernel_cache_hint();
+    hint->op_key = *hint_key;
+    hint->kernel_cache_key = cache_key;
+    hint->valid = true;
   }
-  *num_retvals = num_outputs;
-
-  kernel->Ref();  // Ownership of reference is passed to out_kernel.
-  out_kernel->reset(kernel.get());
-  return absl::OkStatus();
+  return SetOutKernel(std::move(kernel), num_retvals, out_kernel);
 }
 
 absl::Status CreateUnshapedOutput(
@@ -2222,6 +2308,7 @@ absl::Status EagerKernelExecute(
 
 absl::Status EagerExecute(EagerOperation* op, TensorHandle** retvals,
                           int* num_retvals) {
+  if (DetectRepeatedOpSequences()) RecordOpForSequenceDetection(op);
   if (VLOG_IS_ON(1) && op->is_function()) {
     const std::string& op_name = op->Name();
     const std::string& exec_mode = op->IsLocal() ? "local" : "remote";
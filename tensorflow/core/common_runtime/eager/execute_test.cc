@@ -61,6 +61,59 @@ TEST(ExecuteTest, EagerOperationAsFunction) {
   ctx->Unref();
 }
 
+TEST(ExecuteTest, KernelCacheHint) {
+  StaticDeviceMgr device_mgr(
+      DeviceFactory::NewDevice("CPU", {}, "/job:localhost/replica:0/task:0"));
+  auto ctx = new EagerContext(
+      SessionOptions(),
+      tensorflow::ContextDevicePlacementPolicy::DEVICE_PLACEMENT_EXPLICIT,
+      false, &device_mgr, false, nullptr, nullptr);
+  ctx->SetRunEagerOpAsFunction(false);
+
+  EagerKernelCacheHint hint;
+  auto run_mul = [ctx, &hint](const Tensor& x, const Tensor& y,
+                              Tensor* result) -> absl::Status {
+    auto op = std::make_unique<EagerOperation>(ctx);
+    TF_RETURN_IF_ERROR(op->Reset(/*op=*/"Mul", /*raw_device_name=*/""));
+    op->SetKernelCacheHint(&hint);
+    auto input1 = core::RefCountPtr<ImmediateExecutionTensorHandle>(
+        ctx->CreateLocalHandleFromTFTensor(x, ctx->HostCPUName().c_str()));
+    TF_RETURN_IF_ERROR(op->AddInput(input1.get()));
+    auto input2 = core::RefCountPtr<ImmediateExecutionTensorHandle>(
+        ctx->CreateLocalHandleFromTFTensor(y, ctx->HostCPUName().c_str()));
+    TF_RETURN_IF_ERROR(op->AddInput(input2.get()));
+    std::vector<TensorHandle*> retvals(1);
+    int num_retvals = retvals.size();
+    TF_RETURN_IF_ERROR(EagerExecute(op.get(), retvals.data(), &num_retvals));
+    const Tensor* t = nullptr;
+    absl::Status s = retvals[0]->Tensor(&t);
+    if (s.ok()) *result = *t;
+    retvals[0]->Unref();
+    return s;
+  };
+
+  Tensor result;
+  TF_ASSERT_OK(run_mul(test::AsScalar<int64_t>(3), test::AsScalar<int64_t>(2),
+                       &result));
+  test::ExpectTensorEqual<int64_t>(result, test::AsScalar<int64_t>(6));
+  ASSERT_TRUE(hint.valid);
+  const Fprint128 int64_key = hint.kernel_cache_key;
+
+  // The second execution takes the kernel from the hint.
+  TF_ASSERT_OK(run_mul(test::AsScalar<int64_t>(4), test::AsScalar<int64_t>(5),
+                       &result));
+  test::ExpectTensorEqual<int64_t>(result, test::AsScalar<int64_t>(20));
+  EXPECT_EQ(hint.kernel_cache_key, int64_key);
+
+  // Different attributes do not match the hint.
+  TF_ASSERT_OK(run_mul(test::AsScalar<float>(1.5), test::AsScalar<float>(2),
+                       &result));
+  test::ExpectTensorEqual<float>(result, test::AsScalar<float>(3));
+  EXPECT_FALSE(hint.kernel_cache_key == int64_key);
+
+  ctx->Unref();
+}
+
 TEST(ExecuteTest, SimpleFunction) {
   StaticDeviceMgr device_mgr(
       DeviceFactory::NewDevice("CPU", {}, "/job:localhost/replica:0/task:0"));
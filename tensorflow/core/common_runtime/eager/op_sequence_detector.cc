@@ -0,0 +1,92 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/eager/op_sequence_detector.h"
+
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/platform/fingerprint.h"
+
+namespace tensorflow {
+
+OpSequenceDetector::OpSequenceDetector(int max_length, int min_repeats)
+    : max_length_(max_length), min_repeats_(min_repeats) {}
+
+std::vector<std::string> OpSequenceDetector::Record(
+    const Fprint128& signature, const std::string& op_name) {
+  history_.push_back({signature, op_name});
+  if (history_.size() > static_cast<size_t>(max_length_) * min_repeats_) {
+    history_.pop_front();
+  }
+  const int n = history_.size();
+  if (current_period_ > 0) {
+    // Still repeating the sequence that has already been detected.
+    const int previous = n - 1 - current_period_;
+    if (previous >= 0 &&
+        history_[n - 1].signature == history_[previous].signature) {
+      return {};
+    }
+    current_period_ = 0;
+  }
+  const int period = FindPeriod();
+  if (period == 0) return {};
+  current_period_ = period;
+  if (!detected_.insert(SequenceFingerprint(period)).second) return {};
+  std::vector<std::string> op_names;
+  op_names.reserve(period);
+  for (int i = n - period; i < n; ++i) {
+    op_names.push_back(history_[i].op_name);
+  }
+  return op_names;
+}
+
+int OpSequenceDetector::FindPeriod() const {
+  const int n = history_.size();
+  for (int period = 1; period <= max_length_; ++period) {
+    const int span = period * min_repeats_;
+    if (span > n) break;
+    bool repeats = true;
+    for (int i = n - span; i < n - period; ++i) {
+      if (!(history_[i].signature == history_[i + period].signature)) {
+        repeats = false;
+        break;
+      }
+    }
+    if (repeats) return period;
+  }
+  return 0;
+}
+
+Fprint128 OpSequenceDetector::SequenceFingerprint(int period) const {
+  // Uses the rotation of the sequence with the smallest fingerprint, so that
+  // entering a loop at a different op gives the same sequence.
+  const int n = history_.size();
+  Fprint128 best;
+  for (int start = 0; start < period; ++start) {
+    Fprint128 f = {0, 0};
+    for (int i = 0; i < period; ++i) {
+      f = tsl::FingerprintCat128(
+          f, history_[n - period + (start + i) % period].signature);
+    }
+    if (start == 0 || f.high64 < best.high64 ||
+        (f.high64 == best.high64 && f.low64 < best.low64)) {
+      best = f;
+    }
+  }
+  return best;
+}
+
+}  // namespace tensorflow
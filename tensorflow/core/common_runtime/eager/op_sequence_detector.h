@@ -0,0 +1,68 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_EAGER_OP_SEQUENCE_DETECTOR_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_EAGER_OP_SEQUENCE_DETECTOR_H_
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "tensorflow/core/platform/fingerprint.h"
+
+namespace tensorflow {
+
+// Finds sequences of eager ops that are executed again and again, e.g. the
+// body of a Python loop, which would run faster as a tf.function.
+//
+// Each op is described by a signature, e.g. the fingerprint of its name,
+// attributes and device. A sequence is detected once its signatures repeat
+// `min_repeats` times in a row. Each sequence is only detected once, whatever
+// op of the sequence it was entered at. Not thread-safe.
+class OpSequenceDetector {
+ public:
+  OpSequenceDetector(int max_length, int min_repeats);
+
+  // Records the next executed op. Returns the names of the ops of a sequence
+  // that has just been detected, in execution order, or an empty vector.
+  std::vector<std::string> Record(const Fprint128& signature,
+                                  const std::string& op_name);
+
+ private:
+  struct Entry {
+    Fprint128 signature;
+    std::string op_name;
+  };
+
+  // Returns the shortest period of the last entries that repeats
+  // min_repeats_ times, or 0.
+  int FindPeriod() const;
+
+  // Returns a fingerprint of the last `period` entries that does not depend
+  // on which of them comes first.
+  Fprint128 SequenceFingerprint(int period) const;
+
+  const int max_length_;
+  const int min_repeats_;
+  std::deque<Entry> history_;
+  // The period of the sequence being repeated when it was detected, or 0.
+  int current_period_ = 0;
+  absl::flat_hash_set<Fprint128, Fprint128Hasher> detected_;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_EAGER_OP_SEQUENCE_DETECTOR_H_
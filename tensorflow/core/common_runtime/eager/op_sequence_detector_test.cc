@@ -0,0 +1,78 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/eager/op_sequence_detector.h"
+
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/platform/fingerprint.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+std::vector<std::string> Record(OpSequenceDetector& detector,
+                                const std::string& op_name) {
+  return detector.Record(Fingerprint128(op_name), op_name);
+}
+
+TEST(OpSequenceDetectorTest, DetectsRepeatedSequence) {
+  OpSequenceDetector detector(/*max_length=*/4, /*min_repeats=*/3);
+  EXPECT_THAT(Record(detector, "Const"), IsEmpty());
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_THAT(Record(detector, "MatMul"), IsEmpty());
+    EXPECT_THAT(Record(detector, "Add"), IsEmpty());
+    EXPECT_THAT(Record(detector, "Relu"), IsEmpty());
+  }
+  EXPECT_THAT(Record(detector, "MatMul"), IsEmpty());
+  EXPECT_THAT(Record(detector, "Add"), IsEmpty());
+  EXPECT_THAT(Record(detector, "Relu"), ElementsAre("MatMul", "Add", "Relu"));
+  // The sequence is only detected once while it keeps repeating.
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_THAT(Record(detector, "MatMul"), IsEmpty());
+    EXPECT_THAT(Record(detector, "Add"), IsEmpty());
+    EXPECT_THAT(Record(detector, "Relu"), IsEmpty());
+  }
+}
+
+TEST(OpSequenceDetectorTest, DetectsSequenceOnce) {
+  OpSequenceDetector detector(/*max_length=*/4, /*min_repeats=*/2);
+  EXPECT_THAT(Record(detector, "Mul"), IsEmpty());
+  EXPECT_THAT(Record(detector, "Sub"), IsEmpty());
+  EXPECT_THAT(Record(detector, "Mul"), IsEmpty());
+  EXPECT_THAT(Record(detector, "Sub"), ElementsAre("Mul", "Sub"));
+  EXPECT_THAT(Record(detector, "Const"), IsEmpty());
+  // Entering the loop at another op gives the same sequence.
+  EXPECT_THAT(Record(detector, "Sub"), IsEmpty());
+  EXPECT_THAT(Record(detector, "Mul"), IsEmpty());
+  EXPECT_THAT(Record(detector, "Sub"), IsEmpty());
+  EXPECT_THAT(Record(detector, "Mul"), IsEmpty());
+}
+
+TEST(OpSequenceDetectorTest, IgnoresSequencesLongerThanMaxLength) {
+  OpSequenceDetector detector(/*max_length=*/2, /*min_repeats=*/2);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_THAT(Record(detector, "A"), IsEmpty());
+    EXPECT_THAT(Record(detector, "B"), IsEmpty());
+    EXPECT_THAT(Record(detector, "C"), IsEmpty());
+  }
+}
+
+}  // namespace
+}  // namespace tensorflow
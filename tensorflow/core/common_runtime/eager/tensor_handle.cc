@@ -44,6 +44,7 @@ limitations under the License.
 #endif  // IS_MOBILE_PLATFORM
 #include "tensorflow/core/framework/resource_var.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/framework/types.pb.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/stringpiece.h"
@@ -67,8 +68,75 @@ string SafeDeviceDebugString(Device* device) {
   }
 }
 
+#if defined(ADDRESS_SANITIZER) || defined(MEMORY_SANITIZER)
+// Recycling storage would hide use-after-free of TensorHandles from the
+// sanitizers.
+constexpr int kMaxFreeTensorHandles = 0;
+#else
+constexpr int kMaxFreeTensorHandles = 64;
+#endif
+
+// Bounded stack of released TensorHandle blocks. Blocks are freed with their
+// thread; a block released on another thread than the one that allocated it
+// simply joins the freelist of the releasing thread.
+class TensorHandleFreelist {
+ public:
+  ~TensorHandleFreelist() {
+    destroyed_ = true;
+    for (int i = 0; i < size_; ++i) {
+      ::operator delete(blocks_[i]);
+    }
+  }
+
+  // Returns a recycled block, or nullptr if there is none.
+  static void* Pop() {
+    if (destroyed_) return nullptr;
+    TensorHandleFreelist& list = Get();
+    return list.size_ > 0 ? list.blocks_[--list.size_] : nullptr;
+  }
+
+  // Returns false if the block was not kept and must be freed by the caller.
+  static bool Push(void* block) {
+    if (destroyed_) return false;
+    TensorHandleFreelist& list = Get();
+    if (list.size_ >= kMaxFreeTensorHandles) return false;
+    list.blocks_[list.size_++] = block;
+    return true;
+  }
+
+ private:
+  static TensorHandleFreelist& Get() {
+    static thread_local TensorHandleFreelist list;
+    return list;
+  }
+
+  // Trivially destructible, so it stays valid while other thread_local
+  // objects release their handles after the freelist is gone.
+  static thread_local bool destroyed_;
+
+  void* blocks_[kMaxFreeTensorHandles > 0 ? kMaxFreeTensorHandles : 1];
+  int size_ = 0;
+};
+
+thread_local bool TensorHandleFreelist::destroyed_ = false;
+
 }  // namespace
 
+void* TensorHandle::operator new(size_t size) {
+  if (size == sizeof(TensorHandle)) {
+    void* block = TensorHandleFreelist::Pop();
+    if (block != nullptr) return block;
+  }
+  return ::operator new(size);
+}
+
+void TensorHandle::operator delete(void* ptr, size_t size) {
+  if (size == sizeof(TensorHandle) && TensorHandleFreelist::Push(ptr)) {
+    return;
+  }
+  ::operator delete(ptr);
+}
+
 TensorHandle::PackedTensorHandleData::PackedTensorHandleData(
     std::vector<TensorHandle*>&& handles, const TensorShape& shape)
     : handles_(std::move(handles)), shape_(shape) {
@@ -689,6 +757,21 @@ bool TensorHandle::HasLocalMirror(const Device* d) const {
   return local_mirrors_.find(d) != local_mirrors_.end();
 }
 
+bool TensorHandle::ShouldMirrorCopy(const Device* d,
+                                    int64_t max_mirror_bytes) {
+  // The size of a handle that is not ready is unknown without blocking.
+  if (max_mirror_bytes < 0 || Type() != LOCAL || !IsReady()) return true;
+  int64_t num_elements;
+  if (!NumElements(&num_elements).ok() ||
+      num_elements * DataTypeSize(dtype) <= max_mirror_bytes) {
+    return true;
+  }
+
+  mutex_lock l(mu_);
+  if (local_mirrors_.find(d) != local_mirrors_.end()) return true;
+  return ++unmirrored_copies_ > 1;
+}
+
 absl::Status TensorHandle::AddEmptyLocalMirror(const Device* d) {
   DVLOG(3) << "AddEmptyLocalMirror on TensorHandle: " << this
            << " device: " << d;
@@ -187,6 +187,12 @@ class TensorHandle : public ImmediateExecutionTensorHandle {
   // Add a local mirror. This will fail if an empty local mirror was previously
   // added. For that case, SetTensor should be used instead.
   absl::Status AddLocalMirror(tensorflow::Tensor&& tensor, const Device* d);
+  // Returns whether a copy of this handle to the local device `d` should be
+  // kept as a mirror, so that later ops on `d` reuse it. A ready local tensor
+  // larger than `max_mirror_bytes` is only mirrored from its second copy on,
+  // so that a large tensor copied once doesn't hold memory on `d` for the
+  // lifetime of the handle. A negative `max_mirror_bytes` mirrors every copy.
+  bool ShouldMirrorCopy(const Device* d, int64_t max_mirror_bytes);
 
 #if !defined(IS_MOBILE_PLATFORM)
   bool HasRemoteMirror(const Device* d, uint64 context_view_id) const;
@@ -285,6 +291,12 @@ class TensorHandle : public ImmediateExecutionTensorHandle {
 
   void SetFullType(FullTypeDef& full_type) { full_type_ = full_type; }
 
+  // TensorHandles are allocated and released once or more per eager op, so
+  // their storage is recycled through a small per-thread freelist instead of
+  // going back to the system allocator every time.
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr, size_t size);
+
  private:
   friend class PackedTensorHandleTest;
 
@@ -326,6 +338,8 @@ class TensorHandle : public ImmediateExecutionTensorHandle {
   // Map of local mirrors. This can include both ready and non-ready mirrors.
   std::unordered_map<const tensorflow::Device*, LocalTensorHandleData>
       local_mirrors_ TF_GUARDED_BY(mu_);
+  // Number of copies to other devices that were not kept as local mirrors.
+  int unmirrored_copies_ TF_GUARDED_BY(mu_) = 0;
 #if !defined(IS_MOBILE_PLATFORM)
   // TODO(yujingzhang): Remove resource_shape_mirrors_ once scalable per-replica
   // variable is ready, since we could get the shape locally without remote copy
@@ -39,6 +39,32 @@ namespace {
 using tensorflow::testing::StatusIs;
 using ::testing::HasSubstr;
 
+TEST(TensorHandle_FreelistTest, ReleasedHandleIsRecycled) {
+  StaticDeviceMgr device_mgr(DeviceFactory::NewDevice(
+      "CPU", {}, "/job:localhost/replica:0/task:0/device:CPU:0"));
+  auto ctx = new EagerContext(
+      SessionOptions(),
+      tensorflow::ContextDevicePlacementPolicy::DEVICE_PLACEMENT_SILENT, false,
+      &device_mgr, false, nullptr, nullptr, nullptr,
+      /*run_eager_op_as_function=*/true);
+  absl::Cleanup ctx_cleanup = [&]() { ctx->Unref(); };
+
+  TensorHandle* first = TensorHandle::CreateLocalHandle(
+      Tensor(static_cast<float>(1.0)), nullptr, nullptr, ctx);
+  const void* first_address = first;
+  first->Unref();
+
+  TensorHandle* second = TensorHandle::CreateLocalHandle(
+      Tensor(static_cast<float>(2.0)), nullptr, nullptr, ctx);
+  absl::Cleanup second_cleanup = [&]() { second->Unref(); };
+#if !defined(ADDRESS_SANITIZER) && !defined(MEMORY_SANITIZER)
+  EXPECT_EQ(first_address, second);
+#endif
+  const Tensor* t = nullptr;
+  TF_ASSERT_OK(second->Tensor(&t));
+  EXPECT_EQ(t->scalar<float>()(), 2.0);
+}
+
 TEST(TensorHandle_ShapeTest, AsyncShape) {
   Tensor t(DT_UINT16, TensorShape({2, 2}));
   EXPECT_TRUE(t.shape().IsSameSize(TensorShape({2, 2})));
@@ -753,6 +779,50 @@ TEST(TensorHandle_LocalTest, TensorFromDeviceInvalidDevice) {
               StatusIs(tensorflow::error::INTERNAL));
 }
 
+TEST(TensorHandle_LocalTest, LargeTensorMirroredOnSecondCopy) {
+  std::vector<std::unique_ptr<Device>> devices;
+  devices.push_back(
+      CreateDevice("CPU", "/job:localhost/replica:0/task:0/device:CPU:0"));
+  devices.push_back(
+      CreateDevice("CPU", "/job:localhost/replica:0/task:0/device:CPU:1"));
+  StaticDeviceMgr device_mgr(std::move(devices));
+
+  EagerContext* context = new EagerContext(
+      SessionOptions(),
+      tensorflow::ContextDevicePlacementPolicy::DEVICE_PLACEMENT_SILENT,
+      /* async= */ false, &device_mgr,
+      /* device_mgr_owned= */ false, /* rendezvous= */ nullptr,
+      /* cluster_flr= */ nullptr, /*collective_executor_mgr=*/nullptr,
+      /*run_eager_op_as_function=*/true);
+  absl::Cleanup context_cleanup = [&]() { context->Unref(); };
+
+  Device* d0 = device_mgr.ListDevices().at(0);
+  Device* d1 = device_mgr.ListDevices().at(1);
+
+  Tensor t0(DT_FLOAT, TensorShape({4}));
+  TensorHandle* small =
+      TensorHandle::CreateLocalHandle(std::move(t0), d0, d0, d0, context);
+  absl::Cleanup small_cleanup = [&]() { small->Unref(); };
+  EXPECT_TRUE(small->ShouldMirrorCopy(d1, /*max_mirror_bytes=*/16));
+
+  Tensor t1(DT_FLOAT, TensorShape({8}));
+  TensorHandle* large =
+      TensorHandle::CreateLocalHandle(std::move(t1), d0, d0, d0, context);
+  absl::Cleanup large_cleanup = [&]() { large->Unref(); };
+  EXPECT_TRUE(large->ShouldMirrorCopy(d1, /*max_mirror_bytes=*/-1));
+  EXPECT_FALSE(large->ShouldMirrorCopy(d1, /*max_mirror_bytes=*/16));
+  EXPECT_TRUE(large->ShouldMirrorCopy(d1, /*max_mirror_bytes=*/16));
+
+  // A copy to a device that already holds a mirror reuses it.
+  Tensor t2(DT_FLOAT, TensorShape({8}));
+  TensorHandle* mirrored =
+      TensorHandle::CreateLocalHandle(std::move(t2), d0, d0, d0, context);
+  absl::Cleanup mirrored_cleanup = [&]() { mirrored->Unref(); };
+  TF_ASSERT_OK(
+      mirrored->AddLocalMirror(Tensor(DT_FLOAT, TensorShape({8})), d1));
+  EXPECT_TRUE(mirrored->ShouldMirrorCopy(d1, /*max_mirror_bytes=*/16));
+}
+
 TEST(TensorHandle_ResourceShapeMirror, CreateAndCheckMirror) {
   std::vector<std::unique_ptr<Device>> devices;
   devices.push_back(
@@ -36,6 +36,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/renamed_device.h"
 #include "tensorflow/core/common_runtime/simple_propagator_state.h"
 #include "tensorflow/core/common_runtime/step_stats_collector.h"
+#include "tensorflow/core/common_runtime/work_stealing_queues.h"
 #include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/cancellation.h"
 #include "tensorflow/core/framework/collective.h"
@@ -62,6 +63,7 @@ limitations under the License.
 #include "tensorflow/core/lib/gtl/manual_constructor.h"
 #include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/platform/context.h"
+#include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/logging.h"
@@ -77,6 +79,7 @@ limitations under the License.
 #include "tensorflow/core/profiler/lib/scoped_annotation.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/profiler/lib/traceme_encode.h"
+#include "tensorflow/core/protobuf/config.pb.h"
 #include "tensorflow/core/protobuf/error_codes.pb.h"
 #include "tensorflow/core/util/determinism.h"
 #include "tensorflow/core/util/managed_stack_trace.h"
@@ -145,9 +148,34 @@ struct KernelTimer {
 typedef absl::InlinedVector<TensorValue, 4UL> TensorValueVec;
 typedef absl::InlinedVector<AllocatorAttributes, 4UL> AllocatorAttributeVec;
 
+// Per-thread state of a work-stealing worker (see
+// `ExecutorState::RunWorkStealingWorker()`). `owner` identifies the
+// `ExecutorState` that the worker running on this thread belongs to, and
+// `queue_id` is the ready queue owned by that worker.
+struct WorkStealingWorkerState {
+  const void* owner = nullptr;
+  int queue_id = -1;
+};
+thread_local WorkStealingWorkerState current_work_stealing_worker;
+
+// Upper bound on the number of ready queues (and therefore concurrently active
+// workers) used by a single step in work-stealing mode.
+constexpr int kMaxWorkStealingQueues = 256;
+
 class ExecutorImpl : public Executor {
  public:
-  explicit ExecutorImpl(const LocalExecutorParams& p) : immutable_state_(p) {}
+  // If `use_work_stealing` is true, ready nodes that are not run inline are
+  // distributed among per-worker ready queues from which the inter-op workers
+  // steal, instead of being dispatched to `Args::runner` one closure at a time.
+  //
+  // If `use_lock_free_propagator` is true, graphs with control flow are run
+  // with a `LockFreePropagatorState` instead of a `PropagatorState`.
+  explicit ExecutorImpl(const LocalExecutorParams& p,
+                        bool use_work_stealing = false,
+                        bool use_lock_free_propagator = false)
+      : immutable_state_(p),
+        use_work_stealing_(use_work_stealing),
+        use_lock_free_propagator_(use_lock_free_propagator) {}
 
   absl::Status Initialize(const Graph& graph) {
     TF_RETURN_IF_ERROR(immutable_state_.Initialize(graph));
@@ -185,7 +213,34 @@ class ExecutorImpl : public Executor {
     bool IsExpensive(const NodeItem& node) const {
       return is_expensive_[node.node_id] &&
              (cost_estimates_[node.node_id].load(std::memory_order_relaxed) >
-              kOpIsExpensiveThresholdCycles);
+              expensive_threshold_cycles_.load(std::memory_order_relaxed));
+    }
+
+    // Returns true while the cost of dispatching a closure is being measured.
+    bool IsCalibratingDispatchCost() const {
+      return num_dispatch_cost_samples_.load(std::memory_order_relaxed) <
+             kNumDispatchCostSamples;
+    }
+
+    // Records that a closure started running `cycles` after it was handed to
+    // the runner. Once `kNumDispatchCostSamples` have been recorded, the
+    // average becomes the threshold above which a node is considered
+    // expensive: running a cheaper node inline is faster than dispatching it.
+    void RecordDispatchCost(uint64 cycles) {
+      dispatch_cost_cycles_sum_.fetch_add(cycles, std::memory_order_relaxed);
+      if (num_dispatch_cost_samples_.fetch_add(1, std::memory_order_relaxed) ==
+          kNumDispatchCostSamples - 1) {
+        const uint64 average =
+            dispatch_cost_cycles_sum_.load(std::memory_order_relaxed) /
+            kNumDispatchCostSamples;
+        expensive_threshold_cycles_.store(
+            std::clamp(average, kMinOpIsExpensiveThresholdCycles,
+                       kMaxOpIsExpensiveThresholdCycles),
+            std::memory_order_relaxed);
+        VLOG(1) << "Calibrated executor dispatch cost: " << average
+                << " cycles, using inline threshold of "
+                << expensive_threshold_cycles_.load() << " cycles.";
+      }
     }
 
     // Returns the value of kernel->IsExpensive().
@@ -215,16 +270,29 @@ class ExecutorImpl : public Executor {
     // determine whether an operation should be place in a threadpool.
     // Operations start out "expensive".
     static constexpr uint64 kInitialCostEstimateCycles = 100 * 1000 * 1000;
+    // Threshold used until the dispatch cost has been calibrated.
     static constexpr uint64 kOpIsExpensiveThresholdCycles = 8000;
+    // Bounds for the calibrated threshold, which protect against a few
+    // outliers (e.g. a runner that is saturated during the first steps).
+    static constexpr uint64 kMinOpIsExpensiveThresholdCycles = 2000;
+    static constexpr uint64 kMaxOpIsExpensiveThresholdCycles = 200 * 1000;
+    static constexpr int64_t kNumDispatchCostSamples = 1024;
     static constexpr uint64 kCostDecay = 10;
 
     std::vector<bool> is_expensive_;
     // std::unique_ptr<std::atomic<bool>[]> is_expensive_;
     std::unique_ptr<std::atomic_uint_fast64_t[]> cost_estimates_;
+
+    std::atomic<uint64> expensive_threshold_cycles_{
+        kOpIsExpensiveThresholdCycles};
+    std::atomic<int64_t> num_dispatch_cost_samples_{0};
+    std::atomic<uint64> dispatch_cost_cycles_sum_{0};
   };
 
   ImmutableExecutorState immutable_state_;
   KernelStats kernel_stats_;
+  const bool use_work_stealing_;
+  const bool use_lock_free_propagator_;
 
   ExecutorImpl(const ExecutorImpl&) = delete;
   void operator=(const ExecutorImpl&) = delete;
@@ -284,7 +352,8 @@ class ExecutorState {
  public:
   ExecutorState(const Executor::Args& args,
                 const ImmutableExecutorState& immutable_state_,
-                ExecutorImpl::KernelStats* kernel_stats_);
+                ExecutorImpl::KernelStats* kernel_stats_,
+                bool use_work_stealing = false);
   ~ExecutorState();
 
   void RunAsync(Executor::DoneCallback done);
@@ -310,7 +379,8 @@ class ExecutorState {
   void ProcessAsync(const NodeItem& item, const OpKernelContext::Params& params,
                     const TaggedNode& tagged_node, Entry* first_input,
                     NodeExecStatsInterface* stats,
-                    activity_watcher::ActivityId activity_id);
+                    activity_watcher::ActivityId activity_id,
+                    int64_t scheduled_nsec, int64_t start_nsec);
   void ProcessNoop(NodeExecStatsInterface* stats);
   void ProcessConstTensor(const NodeItem& item, EntryVector* outputs,
                           NodeExecStatsInterface* stats);
@@ -321,6 +391,14 @@ class ExecutorState {
                              AllocatorAttributeVec* input_alloc_attrs,
                              bool* is_input_dead);
 
+  // Records that `item` was made ready at `scheduled_nsec`, that its
+  // processing started at `start_nsec`, and that its computation has just
+  // finished.
+  //
+  // REQUIRES: `node_queueing_delay_usecs_ != nullptr`.
+  void RecordNodeTimings(const NodeItem& item, int64_t scheduled_nsec,
+                         int64_t start_nsec);
+
   // After item->kernel computation is done, processes its outputs.
   absl::Status ProcessOutputs(const NodeItem& item, OpKernelContext* ctx,
                               Entry* outputs, NodeExecStatsInterface* stats);
@@ -347,6 +425,25 @@ class ExecutorState {
   template <typename Closure>
   void RunTask(Closure&& c, int sample_rate = 0);
 
+  // A ready node waiting in one of the `work_stealing_queues_`.
+  struct ScheduledNode {
+    TaggedNode tagged_node;
+    int64_t scheduled_nsec;
+  };
+
+  // Adds the nodes in [begin, end) to the ready queue of the calling worker
+  // (or of an arbitrary worker if the caller is not a worker of this step),
+  // and starts more workers if some are idle.
+  //
+  // REQUIRES: `work_stealing_queues_ != nullptr`.
+  template <typename Iterator>
+  void EnqueueForWorkers(Iterator begin, Iterator end, int64_t scheduled_nsec);
+
+  // Runs nodes from the `work_stealing_queues_`, starting with the queue
+  // `queue_id`, until all queues are empty. Each active worker counts as an
+  // outstanding op, so the step cannot finish while a worker is running.
+  void RunWorkStealingWorker(int queue_id);
+
   // Clean up when this executor is done.
   void Finish();
   void ScheduleFinish();
@@ -379,9 +476,14 @@ class ExecutorState {
   string session_handle_;
   const SessionMetadata* session_metadata_ = nullptr;
   TensorStore* tensor_store_;
+  CrossStepBufferCache* const buffer_cache_;
   // Step-local container.
   ScopedStepContainer* step_container_;
   StepStatsCollectorInterface* const stats_collector_;
+  // Not null iff `ConfigProto.Experimental.record_node_queueing_delay` is set,
+  // in which case the timings of every node are recorded in these cells.
+  monitoring::SamplerCell* node_queueing_delay_usecs_ = nullptr;
+  monitoring::SamplerCell* node_compute_time_usecs_ = nullptr;
   const tsl::tracing::EventCollector* const event_collector_;
   Context context_;
 
@@ -402,6 +504,15 @@ class ExecutorState {
 
   PropagatorStateType propagator_;
 
+  // Not null iff ready nodes are distributed through per-worker queues. See
+  // `EnqueueForWorkers()`.
+  std::unique_ptr<WorkStealingQueues<ScheduledNode>> work_stealing_queues_;
+  // Number of workers that are running `RunWorkStealingWorker()`.
+  std::atomic<int> num_active_workers_{0};
+  // Used to pick the queue of newly started workers, and the queue that nodes
+  // made ready outside of any worker are pushed to.
+  std::atomic<uint32_t> next_work_stealing_queue_{0};
+
   // Invoked when the execution finishes.
   Executor::DoneCallback done_cb_;
 
@@ -420,7 +531,7 @@ class ExecutorState {
 template <class PropagatorStateType>
 ExecutorState<PropagatorStateType>::ExecutorState(
     const Executor::Args& args, const ImmutableExecutorState& immutable_state,
-    ExecutorImpl::KernelStats* kernel_stats)
+    ExecutorImpl::KernelStats* kernel_stats, bool use_work_stealing)
     : vlog_(VLOG_IS_ON(1)),
       log_memory_(LogMemory::IsEnabled()),
       step_id_(args.step_id),
@@ -434,6 +545,7 @@ ExecutorState<PropagatorStateType>::ExecutorState(
       session_handle_(args.session_handle),
       session_metadata_(immutable_state.params().session_metadata),
       tensor_store_(args.tensor_store),
+      buffer_cache_(args.buffer_cache),
       step_container_(args.step_container),
       stats_collector_(args.stats_collector),
       event_collector_(tsl::tracing::GetEventCollector(
@@ -456,6 +568,27 @@ ExecutorState<PropagatorStateType>::ExecutorState(
     user_device_ = RenamedDevice::NewRenamedDevice(
         device->name(), device, false, false, args.user_intra_op_threadpool);
   }
+  if (session_config_ != nullptr &&
+      session_config_->experimental().record_node_queueing_delay()) {
+    const string& session_name =
+        session_metadata_ != nullptr ? session_metadata_->name()
+                                     : session_handle_;
+    node_queueing_delay_usecs_ =
+        metrics::GetGraphNodeQueueingDelayUsecsSampler(session_name);
+    node_compute_time_usecs_ =
+        metrics::GetGraphNodeComputeTimeUsecsSampler(session_name);
+  }
+  if (use_work_stealing && !run_all_kernels_inline_) {
+    // Use one queue per inter-op worker that `runner_` may dispatch to.
+    int num_queues = port::MaxParallelism();
+    if (session_config_ != nullptr &&
+        session_config_->inter_op_parallelism_threads() > 0) {
+      num_queues = session_config_->inter_op_parallelism_threads();
+    }
+    num_queues = std::max(1, std::min(num_queues, kMaxWorkStealingQueues));
+    work_stealing_queues_ =
+        std::make_unique<WorkStealingQueues<ScheduledNode>>(num_queues);
+  }
 }
 
 template <class PropagatorStateType>
@@ -482,6 +615,16 @@ void ExecutorState<PropagatorStateType>::RunTask(Closure&& c, int sample_rate) {
     metrics::UpdateGraphPendingQueueLength(n_enqueues - n_dequeues);
   }
 
+  if (TF_PREDICT_FALSE(kernel_stats_->IsCalibratingDispatchCost())) {
+    runner_([kernel_stats = kernel_stats_, timer = KernelTimer(),
+             c = std::forward<Closure>(c)]() mutable {
+      kernel_stats->RecordDispatchCost(timer.ElapsedCycles());
+      num_dequeue_ops.fetch_add(1, std::memory_order_relaxed);
+      std::forward<Closure>(c)();
+    });
+    return;
+  }
+
   // mutable is needed because std::forward<Closure> in the lambda body may move
   // the Closure `c`.
   runner_([c = std::forward<Closure>(c)]() mutable {
@@ -490,6 +633,82 @@ void ExecutorState<PropagatorStateType>::RunTask(Closure&& c, int sample_rate) {
   });
 }
 
+template <class PropagatorStateType>
+template <typename Iterator>
+void ExecutorState<PropagatorStateType>::EnqueueForWorkers(
+    Iterator begin, Iterator end, int64_t scheduled_nsec) {
+  const int num_queues = work_stealing_queues_->num_queues();
+  int queue_id;
+  if (current_work_stealing_worker.owner == this) {
+    queue_id = current_work_stealing_worker.queue_id;
+  } else {
+    queue_id = next_work_stealing_queue_.fetch_add(
+                   1, std::memory_order_relaxed) %
+               num_queues;
+  }
+  int num_nodes = 0;
+  for (auto it = begin; it != end; ++it) {
+    work_stealing_queues_->Push(queue_id, ScheduledNode{*it, scheduled_nsec});
+    ++num_nodes;
+  }
+
+  // Start one worker per new node, as long as there are idle workers. A
+  // worker that observes empty queues re-checks them after it has become
+  // inactive (see `RunWorkStealingWorker()`), so either it or a worker started
+  // here will pick up the nodes that were just pushed.
+  for (int i = 0; i < num_nodes; ++i) {
+    int num_active = num_active_workers_.load();
+    do {
+      if (num_active >= num_queues) return;
+    } while (
+        !num_active_workers_.compare_exchange_weak(num_active, num_active + 1));
+    num_outstanding_ops_.fetch_add(1, std::memory_order_relaxed);
+    const int worker_queue_id =
+        next_work_stealing_queue_.fetch_add(1, std::memory_order_relaxed) %
+        num_queues;
+    RunTask([this, worker_queue_id]() {
+      RunWorkStealingWorker(worker_queue_id);
+    });
+  }
+}
+
+template <class PropagatorStateType>
+void ExecutorState<PropagatorStateType>::RunWorkStealingWorker(int queue_id) {
+  tsl::profiler::TraceMe activity(
+      [&]() {
+        return tsl::profiler::TraceMeEncode(
+            "ExecutorState::RunWorkStealingWorker",
+            {{"step_id", step_id_}, {"queue_id", queue_id}});
+      },
+      tsl::profiler::TraceMeLevel::kVerbose);
+  const WorkStealingWorkerState saved_state = current_work_stealing_worker;
+  current_work_stealing_worker = {this, queue_id};
+  while (true) {
+    if (std::optional<ScheduledNode> node =
+            work_stealing_queues_->PopOrSteal(queue_id)) {
+      Process(node->tagged_node, node->scheduled_nsec);
+      continue;
+    }
+    num_active_workers_.fetch_sub(1);
+    // A concurrent `EnqueueForWorkers()` may have seen this worker as active
+    // and therefore not started a new one.
+    if (work_stealing_queues_->Empty()) break;
+    int num_active = num_active_workers_.load();
+    bool reactivated = false;
+    while (num_active < work_stealing_queues_->num_queues()) {
+      if (num_active_workers_.compare_exchange_weak(num_active,
+                                                    num_active + 1)) {
+        reactivated = true;
+        break;
+      }
+    }
+    if (!reactivated) break;
+  }
+  current_work_stealing_worker = saved_state;
+  // `this` may be deleted by `ScheduleFinish()`, so it must be the last use.
+  if (num_outstanding_ops_.fetch_sub(1) == 1) ScheduleFinish();
+}
+
 template <class PropagatorStateType>
 void ExecutorState<PropagatorStateType>::RunAsync(Executor::DoneCallback done) {
   TaggedNodeSeq ready;
@@ -630,7 +849,8 @@ template <class PropagatorStateType>
 void ExecutorState<PropagatorStateType>::ProcessAsync(
     const NodeItem& item, const OpKernelContext::Params& params,
     const TaggedNode& tagged_node, Entry* first_input,
-    NodeExecStatsInterface* stats, activity_watcher::ActivityId activity_id) {
+    NodeExecStatsInterface* stats, activity_watcher::ActivityId activity_id,
+    int64_t scheduled_nsec, int64_t start_nsec) {
   AsyncOpKernel* async_kernel = item.kernel->AsAsync();
   DCHECK(async_kernel != nullptr);
   AsyncState* state =
@@ -658,7 +878,8 @@ void ExecutorState<PropagatorStateType>::ProcessAsync(
         },
         tsl::profiler::ContextType::kTfExecutor);
 
-    auto done = [this, state, activity_id, ctx_id = producer.GetContextId()]() {
+    auto done = [this, state, activity_id, scheduled_nsec, start_nsec,
+                 ctx_id = producer.GetContextId()]() {
       // Trace async op done.
       tsl::profiler::TraceMeConsumer consumer(
           [&] {
@@ -675,6 +896,9 @@ void ExecutorState<PropagatorStateType>::ProcessAsync(
       Entry* first_input = state->first_input;       // Shorthand
 
       nodestats::SetOpEnd(stats);
+      if (node_queueing_delay_usecs_) {
+        RecordNodeTimings(*state->item, scheduled_nsec, start_nsec);
+      }
       EntryVector outputs(state->item->num_outputs);
       absl::Status s =
           ProcessOutputs(*state->item, &state->ctx, outputs.data(), stats);
@@ -709,6 +933,31 @@ void ExecutorState<PropagatorStateType>::ProcessAsync(
   }
 }
 
+template <class PropagatorStateType>
+void ExecutorState<PropagatorStateType>::RecordNodeTimings(
+    const NodeItem& item, int64_t scheduled_nsec, int64_t start_nsec) {
+  const int64_t end_nsec = nodestats::NowInNsec();
+  // Nodes that are ready when the step starts have no scheduled time.
+  if (scheduled_nsec > 0) {
+    node_queueing_delay_usecs_->Add(
+        static_cast<double>(start_nsec - scheduled_nsec) /
+        EnvTime::kMicrosToNanos);
+  }
+  node_compute_time_usecs_->Add(static_cast<double>(end_nsec - start_nsec) /
+                                EnvTime::kMicrosToNanos);
+  tsl::profiler::TraceMe::InstantActivity(
+      [&] {
+        return tsl::profiler::TraceMeEncode(
+            "ExecutorState::NodeTimings",
+            {{"name", item.kernel->name()},
+             {"step_id", step_id_},
+             {"enqueued_ns", scheduled_nsec},
+             {"dequeued_ns", start_nsec},
+             {"compute_ended_ns", end_nsec}});
+      },
+      tsl::profiler::TraceMeLevel::kInfo);
+}
+
 template <class PropagatorStateType>
 void ExecutorState<PropagatorStateType>::ProcessNoop(
     NodeExecStatsInterface* stats) {
@@ -768,6 +1017,7 @@ void ExecutorState<PropagatorStateType>::ProcessInline(
   params->session_handle = session_handle_;
   params->session_metadata = session_metadata_;
   params->tensor_store = tensor_store_;
+  params->buffer_cache = buffer_cache_;
   params->cancellation_manager = cancellation_manager_;
   params->coordination_service_agent = coordination_service_agent_;
   params->stack_trace = stack_trace_;
@@ -833,6 +1083,8 @@ void ExecutorState<PropagatorStateType>::ProcessInline(
     inline_ready->pop_front();
     const NodeItem& item = tagged_node.get_node_item();
     const int id = item.node_id;
+    const int64_t start_nsec =
+        node_queueing_delay_usecs_ ? nodestats::NowInNsec() : 0;
 
     propagator_.MaybeMarkStarted(tagged_node);
     const activity_watcher::ActivityId activity_id =
@@ -924,7 +1176,7 @@ void ExecutorState<PropagatorStateType>::ProcessInline(
 
       if (item.kernel_is_async) {
         ProcessAsync(item, *params, tagged_node, first_input, stats,
-                     activity_id);
+                     activity_id, scheduled_nsec, start_nsec);
         launched_asynchronously = true;
       } else {
         s = ProcessSync(item, params.get(), &outputs, stats);
@@ -932,6 +1184,9 @@ void ExecutorState<PropagatorStateType>::ProcessInline(
     }
 
     if (!launched_asynchronously) {
+      if (node_queueing_delay_usecs_) {
+        RecordNodeTimings(item, scheduled_nsec, start_nsec);
+      }
       if (vlog_) {
         VLOG(2) << "Synchronous kernel done: " << id << " step "
                 << params->step_id << " "
@@ -958,7 +1213,7 @@ void ExecutorState<PropagatorStateType>::ProcessInline(
         outputs[i].ClearVal();
       }
 
-      if (stats) {
+      if (stats || node_queueing_delay_usecs_) {
         scheduled_nsec = nodestats::NowInNsec();
       }
       // Postprocess.
@@ -1279,7 +1534,7 @@ void ExecutorState<PropagatorStateType>::ScheduleReady(
   DCHECK(!ready->empty());
 
   int64_t scheduled_nsec = 0;
-  if (stats_collector_) {
+  if (stats_collector_ || node_queueing_delay_usecs_) {
     scheduled_nsec = nodestats::NowInNsec();
   }
 
@@ -1304,9 +1559,36 @@ void ExecutorState<PropagatorStateType>::ScheduleReady(
     TaggedNodeSeq expensive_nodes;
     if (inline_ready == nullptr) {
       // Schedule to run all the ready ops in thread pool.
-      for (auto& tagged_node : *ready) {
-        RunTask([=]() { Process(tagged_node, scheduled_nsec); },
-                /*sample_rate=*/ready->size());
+      if (work_stealing_queues_) {
+        EnqueueForWorkers(ready->begin(), ready->end(), scheduled_nsec);
+      } else {
+        // Each expensive node gets its own closure, while the inexpensive
+        // nodes are run one after the other from a single closure, since
+        // dispatching them separately would cost more than running them.
+        TaggedNodeSeq inexpensive_nodes;
+        for (auto& tagged_node : *ready) {
+          const NodeItem& item = *tagged_node.node_item;
+          if (tagged_node.get_is_dead() || !kernel_stats_->IsExpensive(item)) {
+            inexpensive_nodes.push_back(tagged_node);
+          } else {
+            RunTask([=]() { Process(tagged_node, scheduled_nsec); },
+                    /*sample_rate=*/ready->size());
+          }
+        }
+        if (inexpensive_nodes.size() == 1) {
+          RunTask([this, tagged_node = *inexpensive_nodes.begin(),
+                   scheduled_nsec]() { Process(tagged_node, scheduled_nsec); },
+                  /*sample_rate=*/ready->size());
+        } else if (!inexpensive_nodes.empty()) {
+          RunTask([this, inexpensive_nodes = std::move(inexpensive_nodes),
+                   scheduled_nsec]() {
+            TaggedNodeReadyQueue batch;
+            for (auto& tagged_node : inexpensive_nodes) {
+              batch.push_back(tagged_node);
+            }
+            ProcessInline(&batch, scheduled_nsec);
+          });
+        }
       }
     } else {
       for (auto& tagged_node : *ready) {
@@ -1332,7 +1614,12 @@ void ExecutorState<PropagatorStateType>::ScheduleReady(
       }
     }
     if (!expensive_nodes.empty()) {
-      if (expensive_nodes.size() < kInlineScheduleReadyThreshold) {
+      if (work_stealing_queues_) {
+        // Idle workers steal from the queue of this thread, so there is no
+        // need to fan out through child threads.
+        EnqueueForWorkers(expensive_nodes.begin(), expensive_nodes.end(),
+                          scheduled_nsec);
+      } else if (expensive_nodes.size() < kInlineScheduleReadyThreshold) {
         for (auto& tagged_node : expensive_nodes) {
           RunTask(std::bind(&ExecutorState::Process, this, tagged_node,
                             scheduled_nsec),
@@ -1518,12 +1805,18 @@ void ExecutorImpl::RunAsyncInternal(const Args& args, DoneCallback done) {
     (new ExecutorState<OrderedPropagatorState>(args, immutable_state_,
                                                &kernel_stats_))
         ->RunAsync(std::move(done));
+  } else if (immutable_state_.requires_control_flow_support() &&
+             use_lock_free_propagator_) {
+    (new ExecutorState<LockFreePropagatorState>(
+         args, immutable_state_, &kernel_stats_, use_work_stealing_))
+        ->RunAsync(std::move(done));
   } else if (immutable_state_.requires_control_flow_support()) {
-    (new ExecutorState<PropagatorState>(args, immutable_state_, &kernel_stats_))
+    (new ExecutorState<PropagatorState>(args, immutable_state_, &kernel_stats_,
+                                        use_work_stealing_))
         ->RunAsync(std::move(done));
   } else {
-    (new ExecutorState<SimplePropagatorState>(args, immutable_state_,
-                                              &kernel_stats_))
+    (new ExecutorState<SimplePropagatorState>(
+         args, immutable_state_, &kernel_stats_, use_work_stealing_))
         ->RunAsync(std::move(done));
   }
 }
@@ -1542,6 +1835,34 @@ absl::Status NewLocalExecutor(const LocalExecutorParams& params,
   return s;
 }
 
+absl::Status NewWorkStealingLocalExecutor(const LocalExecutorParams& params,
+                                          const Graph& graph,
+                                          Executor** executor) {
+  ExecutorImpl* impl = new ExecutorImpl(params, /*use_work_stealing=*/true);
+  const absl::Status s = impl->Initialize(graph);
+  if (s.ok()) {
+    *executor = impl;
+  } else {
+    delete impl;
+  }
+  return s;
+}
+
+absl::Status NewLockFreePropagatorLocalExecutor(
+    const LocalExecutorParams& params, const Graph& graph,
+    Executor** executor) {
+  ExecutorImpl* impl =
+      new ExecutorImpl(params, /*use_work_stealing=*/false,
+                       /*use_lock_free_propagator=*/true);
+  const absl::Status s = impl->Initialize(graph);
+  if (s.ok()) {
+    *executor = impl;
+  } else {
+    delete impl;
+  }
+  return s;
+}
+
 absl::Status CreateNonCachedKernel(
     Device* device, FunctionLibraryRuntime* flib,
     const std::shared_ptr<const NodeProperties>& props, int graph_def_version,
@@ -1579,6 +1900,47 @@ class DefaultExecutorRegistrar {
 };
 static DefaultExecutorRegistrar registrar;
 
+class WorkStealingExecutorRegistrar {
+ public:
+  WorkStealingExecutorRegistrar() {
+    ExecutorFactory::Register("WORK_STEALING", new Factory);
+  }
+
+ private:
+  class Factory : public ExecutorFactory {
+    absl::Status NewExecutor(const LocalExecutorParams& params,
+                             const Graph& graph,
+                             std::unique_ptr<Executor>* out_executor) override {
+      Executor* ret = nullptr;
+      TF_RETURN_IF_ERROR(NewWorkStealingLocalExecutor(params, graph, &ret));
+      out_executor->reset(ret);
+      return absl::OkStatus();
+    }
+  };
+};
+static WorkStealingExecutorRegistrar work_stealing_registrar;
+
+class LockFreePropagatorExecutorRegistrar {
+ public:
+  LockFreePropagatorExecutorRegistrar() {
+    ExecutorFactory::Register("LOCK_FREE_PROPAGATOR", new Factory);
+  }
+
+ private:
+  class Factory : public ExecutorFactory {
+    absl::Status NewExecutor(const LocalExecutorParams& params,
+                             const Graph& graph,
+                             std::unique_ptr<Executor>* out_executor) override {
+      Executor* ret = nullptr;
+      TF_RETURN_IF_ERROR(
+          NewLockFreePropagatorLocalExecutor(params, graph, &ret));
+      out_executor->reset(ret);
+      return absl::OkStatus();
+    }
+  };
+};
+static LockFreePropagatorExecutorRegistrar lock_free_propagator_registrar;
+
 }  // namespace
 
 }  // namespace tensorflow
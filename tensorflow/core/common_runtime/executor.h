@@ -37,6 +37,7 @@ limitations under the License.
 
 namespace tensorflow {
 
+class CrossStepBufferCache;
 class StepStatsCollector;
 
 // Executor runs a graph computation.
@@ -106,6 +107,9 @@ class Executor {
     // Unique session identifier. Can be empty.
     string session_handle;
     TensorStore* tensor_store = nullptr;
+    // If not null, kernel allocations reuse the buffers released in earlier
+    // steps that were run with the same cache.
+    CrossStepBufferCache* buffer_cache = nullptr;
     ScopedStepContainer* step_container = nullptr;
     CollectiveExecutor* collective_executor = nullptr;
     thread::ThreadPoolInterface* user_intra_op_threadpool = nullptr;
@@ -161,6 +165,25 @@ class Executor {
 absl::Status NewLocalExecutor(const LocalExecutorParams& params,
                               const Graph& graph, Executor** executor);
 
+// Like `NewLocalExecutor()`, but ready nodes that are not run inline are
+// placed on per-worker ready queues, and the inter-op workers steal from each
+// other's queues instead of receiving one closure per node. This executor is
+// also registered under the "WORK_STEALING" executor type, so that it can
+// be selected per session via `ConfigProto.Experimental.executor_type`.
+absl::Status NewWorkStealingLocalExecutor(const LocalExecutorParams& params,
+                                          const Graph& graph,
+                                          Executor** executor);
+
+// Like `NewLocalExecutor()`, but graphs with loops are run with a
+// `LockFreePropagatorState`, which updates the pending counts of loop
+// iterations with atomic operations instead of holding the frame lock. This
+// reduces contention for while loops with wide bodies and many parallel
+// iterations. This executor is also registered under the
+// "LOCK_FREE_PROPAGATOR" executor type.
+absl::Status NewLockFreePropagatorLocalExecutor(
+    const LocalExecutorParams& params, const Graph& graph,
+    Executor** executor);
+
 // A class to help run multiple executors in parallel and wait until
 // all of them are complete.
 //
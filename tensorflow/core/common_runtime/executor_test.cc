@@ -23,8 +23,10 @@ limitations under the License.
 #include "tensorflow/cc/ops/control_flow_ops_internal.h"
 #include "tensorflow/cc/ops/function_ops.h"
 #include "tensorflow/cc/ops/standard_ops.h"
+#include "tensorflow/cc/ops/while_loop.h"
 #include "tensorflow/core/common_runtime/device.h"
 #include "tensorflow/core/common_runtime/device_factory.h"
+#include "tensorflow/core/common_runtime/executor_factory.h"
 #include "tensorflow/core/common_runtime/graph_constructor.h"
 #include "tensorflow/core/common_runtime/kernel_benchmark_testlib.h"
 #include "tensorflow/core/common_runtime/lower_functional_ops.h"
@@ -32,6 +34,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/step_stats_collector.h"
 #include "tensorflow/core/framework/attr_value.pb.h"
 #include "tensorflow/core/framework/local_rendezvous.h"
+#include "tensorflow/core/framework/metrics.h"
 #include "tensorflow/core/framework/op.h"
 #include "tensorflow/core/framework/rendezvous.h"
 #include "tensorflow/core/framework/step_stats.pb.h"
@@ -76,8 +79,10 @@ class ExecutorTest : public ::testing::Test {
     delete exec_;
   }
 
-  // Resets executor_ with a new executor based on a graph 'gdef'.
-  void Create(std::unique_ptr<const Graph> graph) {
+  // Resets executor_ with a new executor based on a graph 'gdef'. The
+  // executor is created by the factory registered for `executor_type`.
+  void Create(std::unique_ptr<const Graph> graph,
+              const string& executor_type = "") {
     const int version = graph->versions().producer();
     LocalExecutorParams params;
     params.device = device_.get();
@@ -92,7 +97,9 @@ class ExecutorTest : public ::testing::Test {
     };
     rendez_ = NewLocalRendezvous();
     delete exec_;
-    TF_CHECK_OK(NewLocalExecutor(params, *graph, &exec_));
+    std::unique_ptr<Executor> executor;
+    TF_CHECK_OK(NewExecutor(executor_type, params, *graph, &executor));
+    exec_ = executor.release();
     runner_ = [this](std::function<void()> fn) { thread_pool_->Schedule(fn); };
   }
 
@@ -265,6 +272,101 @@ TEST_F(ExecutorTest, RandomTree) {
   EXPECT_EQ(4096.0, V(out));
 }
 
+TEST_F(ExecutorTest, RandomTreeWorkStealing) {
+  auto g = std::make_unique<Graph>(OpRegistry::Global());
+  BuildTree(4096, g.get());
+  Create(std::move(g), "WORK_STEALING");
+  Rendezvous::Args args;
+  for (int iters = 0; iters < 4; ++iters) {
+    TF_ASSERT_OK(
+        rendez_->Send(Key(ALICE, kIncarnation, BOB, "a"), args, V(1.0), false));
+    TF_ASSERT_OK(Run(rendez_));
+    Tensor out = V(-1);
+    bool is_dead = false;
+    TF_ASSERT_OK(rendez_->Recv(Key(BOB, kIncarnation, ALICE, "b"), args, &out,
+                               &is_dead));
+    EXPECT_EQ(4096.0, V(out));
+  }
+}
+
+// Builds a loop which adds 1 to each of `loop_vars` loop variables for
+// `loop_iters` iterations, and sends the sum of the loop variables as "b".
+void BuildWideLoop(int loop_iters, int loop_vars, Graph* g) {
+  Scope root = Scope::NewRootScope().ExitOnError();
+  auto zero = ops::Const(root.WithOpName("zero"), 0.0f);
+  std::vector<Output> inputs(loop_vars, zero);
+  ops::OutputList outputs;
+  TF_CHECK_OK(ops::BuildWhileLoop(
+      root, inputs,
+      [loop_iters](const Scope& s, const std::vector<Output>& inputs,
+                   Output* output) {
+        *output = ops::Less(s, inputs[0], static_cast<float>(loop_iters));
+        return s.status();
+      },
+      [](const Scope& s, const std::vector<Output>& inputs,
+         std::vector<Output>* outputs) {
+        for (const Output& input : inputs) {
+          outputs->push_back(ops::Add(s, input, 1.0f));
+        }
+        return s.status();
+      },
+      "wide_loop", &outputs));
+  auto sum = ops::AddN(root.WithOpName("sum"), outputs);
+  TF_CHECK_OK(root.ToGraph(g));
+  test::graph::Send(g, sum.node(), "b", BOB, 1, ALICE);
+}
+
+TEST_F(ExecutorTest, WideLoopLockFreePropagator) {
+  auto g = std::make_unique<Graph>(OpRegistry::Global());
+  BuildWideLoop(/*loop_iters=*/100, /*loop_vars=*/64, g.get());
+  Create(std::move(g), "LOCK_FREE_PROPAGATOR");
+  Rendezvous::Args args;
+  for (int iters = 0; iters < 4; ++iters) {
+    TF_ASSERT_OK(Run(rendez_));
+    Tensor out = V(-1);
+    bool is_dead = false;
+    TF_ASSERT_OK(rendez_->Recv(Key(BOB, kIncarnation, ALICE, "b"), args, &out,
+                               &is_dead));
+    EXPECT_FALSE(is_dead);
+    EXPECT_EQ(6400.0, V(out));
+  }
+}
+
+TEST_F(ExecutorTest, RecordNodeQueueingDelay) {
+  auto g = std::make_unique<Graph>(OpRegistry::Global());
+  BuildTree(64, g.get());
+  // Recv, Send, 64 Identity and 63 Add nodes.
+  const int num_nodes = 129;
+  Create(std::move(g));
+  ConfigProto config;
+  config.mutable_experimental()->set_record_node_queueing_delay(true);
+  Executor::Args exec_args;
+  exec_args.rendezvous = rendez_;
+  exec_args.runner = runner_;
+  exec_args.session_config = &config;
+  exec_args.session_handle = "record_node_queueing_delay_test";
+  Rendezvous::Args args;
+  TF_ASSERT_OK(
+      rendez_->Send(Key(ALICE, kIncarnation, BOB, "a"), args, V(1.0), false));
+  TF_ASSERT_OK(exec_->Run(exec_args));
+  Tensor out = V(-1);
+  bool is_dead = false;
+  TF_ASSERT_OK(
+      rendez_->Recv(Key(BOB, kIncarnation, ALICE, "b"), args, &out, &is_dead));
+  EXPECT_EQ(64.0, V(out));
+
+  EXPECT_GE(metrics::GetGraphNodeQueueingDelayUsecsSampler(
+                "record_node_queueing_delay_test")
+                ->value()
+                .num(),
+            num_nodes);
+  EXPECT_GE(metrics::GetGraphNodeComputeTimeUsecsSampler(
+                "record_node_queueing_delay_test")
+                ->value()
+                .num(),
+            num_nodes);
+}
+
 void BuildConcurrentAddAssign(Graph* g) {
   auto one = test::graph::Constant(g, V(1.0));
   // A variable holds one float.
@@ -0,0 +1,81 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/gpu/allocation_plan.h"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace tensorflow {
+
+AllocationPlan::AllocationPlan(std::vector<Buffer> buffers, size_t alignment)
+    : buffers_(std::move(buffers)),
+      alignment_(alignment),
+      offsets_(buffers_.size(), 0),
+      conflicts_(buffers_.size()) {
+  const int n = buffers_.size();
+  std::vector<int> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+    return buffers_[a].size > buffers_[b].size;
+  });
+
+  std::vector<int> placed;
+  placed.reserve(n);
+  std::vector<std::pair<size_t, size_t>> taken;
+  for (int i : order) {
+    const Buffer& buffer = buffers_[i];
+    // The memory used by the placed buffers that are live at the same time.
+    taken.clear();
+    for (int j : placed) {
+      const Buffer& other = buffers_[j];
+      if (buffer.alloc_time < other.free_time &&
+          other.alloc_time < buffer.free_time) {
+        taken.emplace_back(offsets_[j], offsets_[j] + AlignedSize(j));
+      }
+    }
+    std::sort(taken.begin(), taken.end());
+    const size_t size = AlignedSize(i);
+    size_t offset = 0;
+    for (const auto& [begin, end] : taken) {
+      if (offset + size <= begin) break;
+      offset = std::max(offset, end);
+    }
+    offsets_[i] = offset;
+    region_size_ = std::max(region_size_, offset + size);
+    placed.push_back(i);
+  }
+
+  // Sweep the buffers by offset to find those that share memory.
+  std::sort(order.begin(), order.end(),
+            [this](int a, int b) { return offsets_[a] < offsets_[b]; });
+  for (int k = 0; k < n; ++k) {
+    const int a = order[k];
+    const size_t end = offsets_[a] + AlignedSize(a);
+    for (int l = k + 1; l < n && offsets_[order[l]] < end; ++l) {
+      const int b = order[l];
+      conflicts_[a].push_back(b);
+      conflicts_[b].push_back(a);
+    }
+  }
+}
+
+size_t AllocationPlan::AlignedSize(int i) const {
+  return (buffers_[i].size + alignment_ - 1) / alignment_ * alignment_;
+}
+
+}  // namespace tensorflow
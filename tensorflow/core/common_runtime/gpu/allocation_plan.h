@@ -0,0 +1,76 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_GPU_ALLOCATION_PLAN_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_GPU_ALLOCATION_PLAN_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "absl/types/span.h"
+
+namespace tensorflow {
+
+// An AllocationPlan places the buffers allocated during one step of a graph in
+// one contiguous region, so that buffers whose lifetimes overlap do not overlap
+// in memory. Buffers are placed in order of decreasing size, each at the lowest
+// offset that is not used by an already placed buffer with an overlapping
+// lifetime.
+//
+// This class is thread-compatible.
+class AllocationPlan {
+ public:
+  static constexpr int64_t kNotFreed = std::numeric_limits<int64_t>::max();
+
+  struct Buffer {
+    size_t size = 0;
+    // The buffer is live from the allocation with the time `alloc_time` until
+    // just before the event with the time `free_time`. Times are the indices
+    // of the allocations and deallocations in the trace of the step.
+    int64_t alloc_time = 0;
+    int64_t free_time = kNotFreed;
+  };
+
+  // All the offsets and sizes in the plan are multiples of `alignment`.
+  AllocationPlan(std::vector<Buffer> buffers, size_t alignment);
+
+  int num_buffers() const { return buffers_.size(); }
+  const Buffer& buffer(int i) const { return buffers_[i]; }
+
+  // The offset of buffer `i` in the region.
+  size_t offset(int i) const { return offsets_[i]; }
+
+  // The size of the region that holds all the buffers.
+  size_t region_size() const { return region_size_; }
+
+  // The other buffers that share memory with buffer `i`. Their lifetimes do
+  // not overlap with that of buffer `i` in the recorded step.
+  absl::Span<const int> conflicts(int i) const { return conflicts_[i]; }
+
+ private:
+  size_t AlignedSize(int i) const;
+
+  const std::vector<Buffer> buffers_;
+  const size_t alignment_;
+  std::vector<size_t> offsets_;
+  size_t region_size_ = 0;
+  std::vector<std::vector<int>> conflicts_;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_GPU_ALLOCATION_PLAN_H_
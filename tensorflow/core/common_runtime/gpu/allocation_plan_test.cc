@@ -0,0 +1,75 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/gpu/allocation_plan.h"
+
+#include <vector>
+
+#include <gmock/gmock.h>
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::UnorderedElementsAre;
+
+TEST(AllocationPlanTest, ReusesMemoryOfFreedBuffers) {
+  // 0: [0, 2), 1: [1, 4), 2: [3, 5) -- buffers 0 and 2 can share memory.
+  AllocationPlan plan({{/*size=*/1000, /*alloc_time=*/0, /*free_time=*/2},
+                       {/*size=*/500, /*alloc_time=*/1, /*free_time=*/4},
+                       {/*size=*/1000, /*alloc_time=*/3, /*free_time=*/5}},
+                      /*alignment=*/256);
+  EXPECT_EQ(0, plan.offset(0));
+  EXPECT_EQ(1024, plan.offset(1));
+  EXPECT_EQ(0, plan.offset(2));
+  EXPECT_EQ(1536, plan.region_size());
+  EXPECT_THAT(plan.conflicts(0), ElementsAre(2));
+  EXPECT_THAT(plan.conflicts(1), IsEmpty());
+  EXPECT_THAT(plan.conflicts(2), ElementsAre(0));
+}
+
+TEST(AllocationPlanTest, BuffersThatAreNotFreedAreNeverReused) {
+  AllocationPlan plan({{/*size=*/256, /*alloc_time=*/0},
+                       {/*size=*/256, /*alloc_time=*/1, /*free_time=*/2},
+                       {/*size=*/256, /*alloc_time=*/3, /*free_time=*/4},
+                       {/*size=*/256, /*alloc_time=*/5}},
+                      /*alignment=*/256);
+  EXPECT_EQ(0, plan.offset(0));
+  EXPECT_EQ(256, plan.offset(1));
+  EXPECT_EQ(256, plan.offset(2));
+  EXPECT_EQ(256, plan.offset(3));
+  EXPECT_EQ(512, plan.region_size());
+  EXPECT_THAT(plan.conflicts(0), IsEmpty());
+  EXPECT_THAT(plan.conflicts(3), UnorderedElementsAre(1, 2));
+}
+
+TEST(AllocationPlanTest, FillsGaps) {
+  // A small buffer fits between two large ones that are live at the same time.
+  AllocationPlan plan({{/*size=*/1024, /*alloc_time=*/0, /*free_time=*/10},
+                       {/*size=*/512, /*alloc_time=*/1, /*free_time=*/3},
+                       {/*size=*/1024, /*alloc_time=*/2, /*free_time=*/10},
+                       {/*size=*/512, /*alloc_time=*/4, /*free_time=*/10}},
+                      /*alignment=*/256);
+  EXPECT_EQ(0, plan.offset(0));
+  EXPECT_EQ(1024, plan.offset(2));
+  EXPECT_EQ(2048, plan.offset(1));
+  EXPECT_EQ(2048, plan.offset(3));
+  EXPECT_EQ(2560, plan.region_size());
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -15,14 +15,20 @@ limitations under the License.
 
 #include "tensorflow/core/common_runtime/gpu/gpu_bfc_allocator.h"
 
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
 
+#include "absl/strings/numbers.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorflow/core/common_runtime/gpu/allocation_plan.h"
+#include "xla/tsl/framework/allocator.h"
 #include "xla/tsl/framework/bfc_allocator.h"
 #include "tsl/platform/logging.h"
+#include "tsl/profiler/lib/scoped_memory_debug_annotation.h"
 
 namespace tensorflow {
 
@@ -80,6 +86,62 @@ bool GetGarbageCollectionValue() {
       << " Using the default value \"true\".";
   return true;
 }
+
+size_t GetSmallAllocationCacheBytes(size_t orig_value) {
+  const char* cache_bytes_string =
+      std::getenv("TF_BFC_SMALL_ALLOCATION_CACHE_BYTES");
+  if (cache_bytes_string == nullptr) {
+    return orig_value;
+  }
+  uint64_t cache_bytes;
+  if (!absl::SimpleAtoi(cache_bytes_string, &cache_bytes)) {
+    LOG(ERROR)
+        << "The TF_BFC_SMALL_ALLOCATION_CACHE_BYTES environment variable is"
+        << " set but could not be parsed: \"" << cache_bytes_string << "\"."
+        << " Using original config value of " << orig_value << ".";
+    return orig_value;
+  }
+  return static_cast<size_t>(cache_bytes);
+}
+
+bool GetExportTelemetryValue(bool orig_value) {
+  const char* export_telemetry_string =
+      std::getenv("TF_GPU_BFC_EXPORT_TELEMETRY");
+  if (export_telemetry_string == nullptr) {
+    return orig_value;
+  }
+  if (strcmp("false", export_telemetry_string) == 0) {
+    return false;
+  } else if (strcmp("true", export_telemetry_string) == 0) {
+    return true;
+  }
+
+  LOG(ERROR)
+      << "The TF_GPU_BFC_EXPORT_TELEMETRY environment variable is set but"
+      << " could not be parsed: \"" << export_telemetry_string << "\"."
+      << " Valid values are \"true\" or \"false\"."
+      << " Using original config value of " << orig_value << ".";
+  return orig_value;
+}
+
+int64_t GetAllocationPlanRecordStep(int64_t orig_value) {
+  const char* record_step_string =
+      std::getenv("TF_GPU_BFC_ALLOCATION_PLAN_RECORD_STEP");
+  if (record_step_string == nullptr) {
+    return orig_value;
+  }
+  char* end = nullptr;
+  const long long record_step =  // NOLINT(runtime/int)
+      std::strtoll(record_step_string, &end, 10);
+  if (end == record_step_string || *end != '\0') {
+    LOG(ERROR)
+        << "The TF_GPU_BFC_ALLOCATION_PLAN_RECORD_STEP environment variable is"
+        << " set but could not be parsed: \"" << record_step_string << "\"."
+        << " Using original config value of " << orig_value << ".";
+    return orig_value;
+  }
+  return static_cast<int64_t>(record_step);
+}
 }  // anonymous namespace
 
 GPUBFCAllocator::GPUBFCAllocator(
@@ -95,7 +157,207 @@ GPUBFCAllocator::GPUBFCAllocator(
           o.garbage_collection = GetGarbageCollectionValue();
         }
         o.fragmentation_fraction = opts.fragmentation_fraction;
+        o.small_allocation_cache_bytes =
+            GetSmallAllocationCacheBytes(opts.small_allocation_cache_bytes);
+        o.export_telemetry = GetExportTelemetryValue(opts.export_telemetry);
         return o;
-      }()) {}
+      }()),
+      allocation_plan_record_step_(
+          GetAllocationPlanRecordStep(opts.allocation_plan_record_step)),
+      plan_state_(allocation_plan_record_step_ > 0 ? PlanState::kWaiting
+                                                   : PlanState::kDisabled) {}
+
+void* GPUBFCAllocator::AllocateRaw(
+    size_t alignment, size_t num_bytes,
+    const tsl::AllocationAttributes& allocation_attr) {
+  if (allocation_plan_record_step_ <= 0 || num_bytes == 0 ||
+      alignment > tsl::Allocator::kAllocatorAlignment) {
+    return BFCAllocator::AllocateRaw(alignment, num_bytes, allocation_attr);
+  }
+  // Allocations made outside of kernels, e.g. for the inputs of a step, are
+  // not part of the plan.
+  const int64_t step_id = tsl::profiler::ScopedMemoryDebugAnnotation::
+                              CurrentAnnotation()
+                                  .pending_step_id;
+  if (step_id == 0) {
+    return BFCAllocator::AllocateRaw(alignment, num_bytes, allocation_attr);
+  }
+  // `plan_mu_` is never held while calling into the BFC allocator: a retried
+  // allocation waits for other threads to deallocate memory, which takes
+  // `plan_mu_` as well.
+  size_t region_size = 0;
+  bool recording = false;
+  {
+    absl::MutexLock l(&plan_mu_);
+    region_size = ObserveStep(step_id);
+    if (plan_state_ == PlanState::kReplaying) {
+      void* ptr = AllocateFromPlan(num_bytes);
+      if (ptr != nullptr) return ptr;
+    }
+    recording = plan_state_ == PlanState::kRecording;
+  }
+  if (region_size > 0) {
+    void* region = BFCAllocator::AllocateRaw(
+        tsl::Allocator::kAllocatorAlignment, region_size,
+        tsl::AllocationAttributes());
+    absl::MutexLock l(&plan_mu_);
+    InstallRegion(static_cast<char*>(region));
+    if (plan_state_ == PlanState::kReplaying) {
+      void* ptr = AllocateFromPlan(num_bytes);
+      if (ptr != nullptr) return ptr;
+    }
+  }
+  void* ptr = BFCAllocator::AllocateRaw(alignment, num_bytes, allocation_attr);
+  if (recording && ptr != nullptr) {
+    absl::MutexLock l(&plan_mu_);
+    // The step may have ended while the allocation was in flight.
+    if (plan_state_ == PlanState::kRecording) {
+      AllocationPlan::Buffer buffer;
+      buffer.size = num_bytes;
+      buffer.alloc_time = trace_time_++;
+      recorded_ptrs_[ptr] = trace_.size();
+      trace_.push_back(buffer);
+    }
+  }
+  return ptr;
+}
+
+void GPUBFCAllocator::DeallocateRaw(void* ptr) {
+  if (allocation_plan_record_step_ > 0 && ptr != nullptr) {
+    absl::MutexLock l(&plan_mu_);
+    if (plan_state_ == PlanState::kRecording) {
+      auto it = recorded_ptrs_.find(ptr);
+      if (it != recorded_ptrs_.end()) {
+        trace_[it->second].free_time = trace_time_++;
+        recorded_ptrs_.erase(it);
+      }
+    } else if (plan_state_ == PlanState::kReplaying) {
+      auto it = planned_ptrs_.find(ptr);
+      if (it != planned_ptrs_.end()) {
+        live_[it->second] = false;
+        planned_ptrs_.erase(it);
+        return;
+      }
+    }
+  }
+  BFCAllocator::DeallocateRaw(ptr);
+}
+
+size_t GPUBFCAllocator::RequestedSize(const void* ptr) const {
+  if (allocation_plan_record_step_ > 0) {
+    absl::MutexLock l(&plan_mu_);
+    const int i = PlannedBuffer(ptr);
+    if (i >= 0) return plan_->buffer(i).size;
+  }
+  return BFCAllocator::RequestedSize(ptr);
+}
+
+size_t GPUBFCAllocator::AllocatedSize(const void* ptr) const {
+  if (allocation_plan_record_step_ > 0) {
+    absl::MutexLock l(&plan_mu_);
+    const int i = PlannedBuffer(ptr);
+    if (i >= 0) return plan_->buffer(i).size;
+  }
+  return BFCAllocator::AllocatedSize(ptr);
+}
+
+int64_t GPUBFCAllocator::AllocationId(const void* ptr) const {
+  if (allocation_plan_record_step_ > 0) {
+    absl::MutexLock l(&plan_mu_);
+    // The buffers of the plan share the id of their region.
+    if (PlannedBuffer(ptr) >= 0) return BFCAllocator::AllocationId(region_);
+  }
+  return BFCAllocator::AllocationId(ptr);
+}
+
+int GPUBFCAllocator::PlannedBuffer(const void* ptr) const {
+  auto it = planned_ptrs_.find(ptr);
+  return it == planned_ptrs_.end() ? -1 : it->second;
+}
+
+size_t GPUBFCAllocator::ObserveStep(int64_t step_id) {
+  if (step_id == current_step_id_ || plan_state_ == PlanState::kDisabled) {
+    return 0;
+  }
+  current_step_id_ = step_id;
+  ++num_steps_;
+  switch (plan_state_) {
+    case PlanState::kWaiting:
+      if (num_steps_ == allocation_plan_record_step_) {
+        plan_state_ = PlanState::kRecording;
+      }
+      break;
+    case PlanState::kRecording:
+      return BuildPlan();
+    case PlanState::kReplaying:
+      next_buffer_ = 0;
+      break;
+    case PlanState::kBuilding:
+    case PlanState::kDisabled:
+      break;
+  }
+  return 0;
+}
+
+size_t GPUBFCAllocator::BuildPlan() {
+  // The recorded buffers that are still in use were never freed in the step.
+  recorded_ptrs_.clear();
+  if (trace_.empty()) {
+    plan_state_ = PlanState::kDisabled;
+    return 0;
+  }
+  plan_ = std::make_unique<AllocationPlan>(std::move(trace_),
+                                           tsl::Allocator::kAllocatorAlignment);
+  trace_.clear();
+  plan_state_ = PlanState::kBuilding;
+  return plan_->region_size();
+}
+
+void GPUBFCAllocator::InstallRegion(char* region) {
+  region_ = region;
+  if (region_ == nullptr) {
+    LOG(WARNING) << Name() << ": could not allocate " << plan_->region_size()
+                 << " bytes for the allocation plan of "
+                 << plan_->num_buffers() << " buffers; not replaying it.";
+    plan_.reset();
+    plan_state_ = PlanState::kDisabled;
+    return;
+  }
+  VLOG(1) << Name() << ": replaying " << plan_->num_buffers()
+          << " allocations from a region of " << plan_->region_size()
+          << " bytes.";
+  live_.assign(plan_->num_buffers(), false);
+  next_buffer_ = 0;
+  plan_state_ = PlanState::kReplaying;
+}
+
+void* GPUBFCAllocator::AllocateFromPlan(size_t num_bytes) {
+  if (next_buffer_ < 0) return nullptr;
+  const int i = next_buffer_;
+  // A buffer may only be handed out once the buffers that share its memory
+  // are released, which is not the case if the step runs kernels in a
+  // different order than the recorded one.
+  bool diverged = i >= plan_->num_buffers() ||
+                  plan_->buffer(i).size != num_bytes || live_[i];
+  if (!diverged) {
+    for (int j : plan_->conflicts(i)) {
+      if (live_[j]) {
+        diverged = true;
+        break;
+      }
+    }
+  }
+  if (diverged) {
+    VLOG(2) << Name() << ": step " << current_step_id_
+            << " diverged from the allocation plan at allocation " << i;
+    next_buffer_ = -1;
+    return nullptr;
+  }
+  ++next_buffer_;
+  live_[i] = true;
+  void* ptr = region_ + plan_->offset(i);
+  planned_ptrs_[ptr] = i;
+  return ptr;
+}
 
 }  // namespace tensorflow
@@ -16,10 +16,17 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_BFC_ALLOCATOR_H_
 #define TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_BFC_ALLOCATOR_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorflow/core/common_runtime/gpu/allocation_plan.h"
 #include "xla/tsl/framework/allocator.h"
 #include "xla/tsl/framework/bfc_allocator.h"
 #include "tsl/platform/macros.h"
@@ -28,6 +35,13 @@ namespace tensorflow {
 
 // A GPU memory allocator that implements a 'best-fit with coalescing'
 // algorithm.
+//
+// Optionally, the allocator records the allocations made by the kernels of one
+// step, and serves the same allocations in the following steps from one
+// contiguous region laid out by an `AllocationPlan`. Steps are told apart by
+// the step id of the `ScopedMemoryDebugAnnotation` that the GPU device sets
+// around kernels. Once the allocations of a step diverge from the recorded
+// ones, the rest of that step is served by the BFC algorithm.
 class GPUBFCAllocator : public tsl::BFCAllocator {
  public:
   // See BFCAllocator::Options.
@@ -46,6 +60,20 @@ class GPUBFCAllocator : public tsl::BFCAllocator {
 
     double fragmentation_fraction = 0;
     bool allow_retry_on_failure = true;
+
+    // Overridden by TF_BFC_SMALL_ALLOCATION_CACHE_BYTES if that envvar is set.
+    // See `tsl::BFCAllocator::Options::small_allocation_cache_bytes`.
+    size_t small_allocation_cache_bytes = 0;
+
+    // If positive, the allocations made during the
+    // `allocation_plan_record_step`-th step are recorded, and replayed in the
+    // following steps. Overridden by TF_GPU_BFC_ALLOCATION_PLAN_RECORD_STEP if
+    // that envvar is set.
+    int64_t allocation_plan_record_step = 0;
+
+    // Overridden by TF_GPU_BFC_EXPORT_TELEMETRY if that envvar is set.
+    // See `tsl::BFCAllocator::Options::export_telemetry`.
+    bool export_telemetry = false;
   };
 
   GPUBFCAllocator(std::unique_ptr<tsl::SubAllocator> sub_allocator,
@@ -54,8 +82,68 @@ class GPUBFCAllocator : public tsl::BFCAllocator {
 
   ~GPUBFCAllocator() override {}
 
+  using BFCAllocator::AllocateRaw;
+  void* AllocateRaw(size_t alignment, size_t num_bytes,
+                    const tsl::AllocationAttributes& allocation_attr) override;
+  void DeallocateRaw(void* ptr) override;
+  size_t RequestedSize(const void* ptr) const override;
+  size_t AllocatedSize(const void* ptr) const override;
+  int64_t AllocationId(const void* ptr) const override;
+
   GPUBFCAllocator(const GPUBFCAllocator&) = delete;
   void operator=(const GPUBFCAllocator&) = delete;
+
+ private:
+  enum class PlanState {
+    kDisabled,
+    kWaiting,
+    kRecording,
+    // The plan is laid out, and its region is being allocated.
+    kBuilding,
+    kReplaying,
+  };
+
+  // Returns the buffer of the plan that starts at `ptr`, or -1.
+  int PlannedBuffer(const void* ptr) const
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(plan_mu_);
+
+  // Moves the plan to the state of a new step if `step_id` is not the id of
+  // the current step. Returns the size of the region that the caller must
+  // allocate and pass to `InstallRegion`, or 0.
+  size_t ObserveStep(int64_t step_id) ABSL_EXCLUSIVE_LOCKS_REQUIRED(plan_mu_);
+
+  // Lays out the recorded allocations, and returns the size of their region.
+  size_t BuildPlan() ABSL_EXCLUSIVE_LOCKS_REQUIRED(plan_mu_);
+
+  // Starts replaying the plan from `region`, or disables it if `region` is
+  // nullptr.
+  void InstallRegion(char* region) ABSL_EXCLUSIVE_LOCKS_REQUIRED(plan_mu_);
+
+  // Returns the memory of the next buffer of the plan, or nullptr if the
+  // allocation does not match the plan or the memory is still in use.
+  void* AllocateFromPlan(size_t num_bytes)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(plan_mu_);
+
+  const int64_t allocation_plan_record_step_;
+
+  mutable absl::Mutex plan_mu_;
+  PlanState plan_state_ ABSL_GUARDED_BY(plan_mu_);
+  int64_t current_step_id_ ABSL_GUARDED_BY(plan_mu_) = 0;
+  int64_t num_steps_ ABSL_GUARDED_BY(plan_mu_) = 0;
+
+  // The trace of the recorded step. Times are counted in allocator events.
+  std::vector<AllocationPlan::Buffer> trace_ ABSL_GUARDED_BY(plan_mu_);
+  int64_t trace_time_ ABSL_GUARDED_BY(plan_mu_) = 0;
+  absl::flat_hash_map<void*, int> recorded_ptrs_ ABSL_GUARDED_BY(plan_mu_);
+
+  std::unique_ptr<AllocationPlan> plan_ ABSL_GUARDED_BY(plan_mu_);
+  char* region_ ABSL_GUARDED_BY(plan_mu_) = nullptr;
+  // The index of the buffer that the next allocation of the step is matched
+  // against, or -1 once the step diverged from the plan.
+  int next_buffer_ ABSL_GUARDED_BY(plan_mu_) = 0;
+  std::vector<bool> live_ ABSL_GUARDED_BY(plan_mu_);
+  absl::flat_hash_map<const void*, int> planned_ptrs_
+      ABSL_GUARDED_BY(plan_mu_);
 };
 
 }  // namespace tensorflow
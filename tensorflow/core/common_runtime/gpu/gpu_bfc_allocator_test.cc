@@ -19,13 +19,16 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/gpu/gpu_bfc_allocator.h"
 
 #include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
 #include <optional>
+#include <thread>  // NOLINT(build/c++11)
 #include <vector>
 
 #include "xla/stream_executor/gpu/gpu_init.h"
 #include "xla/stream_executor/stream_executor.h"
 #include "xla/tsl/framework/device_id.h"
 #include "xla/tsl/lib/gtl/inlined_vector.h"
+#include "xla/tsl/lib/monitoring/cell_reader.h"
 #include "xla/tsl/lib/random/simple_philox.h"
 #include "tensorflow/core/common_runtime/device/device_mem_allocator.h"
 #include "tensorflow/core/framework/typed_allocator.h"
@@ -37,6 +40,7 @@ limitations under the License.
 #include "tsl/platform/test_benchmark.h"
 #include "tsl/platform/threadpool.h"
 #include "tsl/platform/types.h"
+#include "tsl/profiler/lib/scoped_memory_debug_annotation.h"
 
 namespace tsl {
 namespace {
@@ -220,6 +224,122 @@ TEST_P(GPUBFCAllocatorTest, AllocatedVsRequested) {
   a.DeallocateRaw(t1);
 }
 
+TEST_P(GPUBFCAllocatorTest, SmallAllocationCache) {
+  GPUBFCAllocator::Options options;
+  options.small_allocation_cache_bytes = 4096;
+  GPUBFCAllocator a(GetParam()(1ull << 32), 1 << 30, "GPU_0_bfc", options);
+
+  void* p1 = a.AllocateRaw(1, 1000);
+  // Allocations are rounded up to their size class.
+  EXPECT_EQ(1024, a.RequestedSize(p1));
+  a.DeallocateRaw(p1);
+  std::optional<AllocatorStats> stats = a.GetStats();
+  EXPECT_EQ(0, stats->bytes_in_use);
+  EXPECT_EQ(1024, stats->cached_bytes.value_or(0));
+
+  // An allocation of the same size class reuses the cached chunk.
+  void* p2 = a.AllocateRaw(1, 800);
+  EXPECT_EQ(p1, p2);
+  stats = a.GetStats();
+  EXPECT_EQ(2, stats->num_allocs);
+  EXPECT_EQ(1024, stats->bytes_in_use);
+  EXPECT_EQ(0, stats->cached_bytes.value_or(0));
+  a.DeallocateRaw(p2);
+
+  // Beyond the limit, chunks are returned to the allocator.
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 8; ++i) {
+    ptrs.push_back(a.AllocateRaw(1, 1024));
+  }
+  for (void* ptr : ptrs) {
+    a.DeallocateRaw(ptr);
+  }
+  stats = a.GetStats();
+  EXPECT_EQ(0, stats->bytes_in_use);
+  EXPECT_LE(stats->cached_bytes.value_or(0), 4096);
+
+  // Larger allocations bypass the cache.
+  void* p3 = a.AllocateRaw(1, 8192);
+  a.DeallocateRaw(p3);
+  EXPECT_LE(a.GetStats()->cached_bytes.value_or(0), 4096);
+}
+
+TEST_P(GPUBFCAllocatorTest, AllocationPlanReplay) {
+  GPUBFCAllocator::Options options;
+  options.allocation_plan_record_step = 1;
+  GPUBFCAllocator a(GetParam()(1ull << 32), 1 << 30, "GPU_0_bfc", options);
+
+  // Returns the buffers of one step, in which `t1` and `t3` are never live at
+  // the same time.
+  auto run_step = [&a](int64_t step_id, size_t first_size) {
+    tsl::profiler::ScopedMemoryDebugAnnotation annotation("op", step_id);
+    std::vector<void*> ptrs;
+    void* t1 = a.AllocateRaw(1, first_size);
+    void* t2 = a.AllocateRaw(1, 2048);
+    a.DeallocateRaw(t1);
+    void* t3 = a.AllocateRaw(1, 1024);
+    EXPECT_EQ(1024, a.RequestedSize(t3));
+    a.DeallocateRaw(t2);
+    a.DeallocateRaw(t3);
+    return std::vector<void*>{t1, t2, t3};
+  };
+
+  run_step(/*step_id=*/1, 1024);
+  const std::vector<void*> replayed = run_step(/*step_id=*/2, 1024);
+  // The buffers are laid out in one region, and `t3` reuses `t1`.
+  EXPECT_EQ(replayed[0], replayed[2]);
+  EXPECT_EQ(static_cast<char*>(replayed[1]) + 2048, replayed[0]);
+  EXPECT_EQ(replayed, run_step(/*step_id=*/3, 1024));
+
+  // A step that diverges from the plan falls back to the BFC algorithm.
+  const std::vector<void*> diverged = run_step(/*step_id=*/4, 4096);
+  EXPECT_NE(replayed[1], diverged[1]);
+  EXPECT_EQ(replayed, run_step(/*step_id=*/5, 1024));
+
+  // Only the region of the plan is still in use.
+  EXPECT_EQ(3072, a.GetStats()->bytes_in_use);
+}
+
+TEST_P(GPUBFCAllocatorTest, AllocationPlanRetryWaitsForDeallocation) {
+  GPUBFCAllocator::Options options;
+  options.allocation_plan_record_step = 1;
+  GPUBFCAllocator a(GetParam()(1ull << 32), 1 << 20, "GPU_0_bfc", options);
+
+  tsl::profiler::ScopedMemoryDebugAnnotation annotation("op", 1);
+  void* p1 = a.AllocateRaw(1, 768 << 10);
+  ASSERT_NE(nullptr, p1);
+  // The second allocation only fits once `p1` is released by another thread
+  // while the allocation is being retried.
+  std::thread releaser([&a, p1] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    a.DeallocateRaw(p1);
+  });
+  void* p2 = a.AllocateRaw(1, 768 << 10);
+  releaser.join();
+  EXPECT_NE(nullptr, p2);
+  a.DeallocateRaw(p2);
+}
+
+TEST_P(GPUBFCAllocatorTest, ExportTelemetry) {
+  monitoring::testing::CellReader<monitoring::testing::Histogram> lifetimes(
+      "/tensorflow/core/bfc_allocator/allocation_lifetime_usecs");
+  monitoring::testing::CellReader<int64_t> largest_free_chunk(
+      "/tensorflow/core/bfc_allocator/largest_free_chunk_bytes");
+  monitoring::testing::CellReader<int64_t> free_chunks(
+      "/tensorflow/core/bfc_allocator/free_chunks");
+  GPUBFCAllocator::Options options;
+  options.export_telemetry = true;
+  GPUBFCAllocator a(GetParam()(1ull << 32), 1 << 20, "GPU_telemetry_bfc",
+                    options);
+
+  // The first allocation exports the layout of the rest of the region.
+  void* p1 = a.AllocateRaw(1, 1024);
+  EXPECT_EQ((1 << 20) - 1024, largest_free_chunk.Read("GPU_telemetry_bfc"));
+  EXPECT_EQ(1, free_chunks.Read("GPU_telemetry_bfc", "524288"));
+  a.DeallocateRaw(p1);
+  EXPECT_FLOAT_EQ(1, lifetimes.Delta("GPU_telemetry_bfc").num());
+}
+
 TEST_P(GPUBFCAllocatorTest, TestCustomMemoryLimit) {
   // Configure a 2MiB byte limit
   GPUBFCAllocator a(GetParam()(1ull << 32), 2 << 20, "GPU_0_bfc", {});
@@ -570,20 +570,23 @@ Status BaseGPUDevice::Init(const SessionOptions& options) {
       options.config.gpu_options().experimental().kernel_tracker_max_pending());
   timestamped_allocator_ =
       options.config.gpu_options().experimental().timestamped_allocator();
+  SharedCounter* timing_counter = nullptr;
+  if (timestamped_allocator_) {
+    // In this case the SharedCounter was already created and set in the
+    // associated Allocator, with ownership by GPUProcessState.
+    // The GPUKernelTracker will use this SharedCounter, instead of
+    // owning its own.
+    timing_counter =
+        GPUProcessState::singleton()->GPUAllocatorCounter(tf_device_id_);
+    // Stream-ordered allocators, e.g. the CUDA malloc Async allocator, have
+    // no counter: memory freed on the compute stream is never reused before
+    // the kernels that used it complete.
+    timestamped_allocator_ = timing_counter != nullptr;
+  }
   pending_cap_ = tracker_params.max_pending;
   if (timestamped_allocator_ ||
       (tracker_params.max_interval > 0 || tracker_params.max_bytes > 0 ||
        tracker_params.max_pending > 0)) {
-    SharedCounter* timing_counter = nullptr;
-    if (timestamped_allocator_) {
-      // In this case the SharedCounter was already created and set in the
-      // associated Allocator, with ownership by GPUProcessState.
-      // The GPUKernelTracker will use this SharedCounter, instead of
-      // owning its own.
-      timing_counter =
-          GPUProcessState::singleton()->GPUAllocatorCounter(tf_device_id_);
-      DCHECK(timing_counter);
-    }
     kernel_tracker_.reset(new GPUKernelTracker(
         tracker_params, Env::Default(), stream_->compute, timing_counter,
         timestamped_allocator_ ? gpu_allocator_ : nullptr, em_));
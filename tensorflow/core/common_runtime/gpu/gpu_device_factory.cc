@@ -35,6 +35,7 @@ class GPUDevice : public BaseGPUDevice {
       : BaseGPUDevice(options, name, memory_limit, locality, tf_device_id,
                       physical_device_desc, gpu_allocator, cpu_allocator,
                       false /* sync every op */),
+        numa_node_(locality.numa_node()),
         gpu_options_(options.config.gpu_options()) {
     if (options.config.has_gpu_options()) {
       force_gpu_compatible_ =
@@ -46,8 +47,10 @@ class GPUDevice : public BaseGPUDevice {
     CHECK(cpu_allocator_) << "bad place 1";
     if (attr.on_host()) {
       if (attr.gpu_compatible() || force_gpu_compatible_) {
+        // Pinned memory on the NUMA node of the GPU, which is also used to
+        // stage copies from pageable memory.
         GPUProcessState* ps = GPUProcessState::singleton();
-        return ps->GetGpuHostAllocator(gpu_options_, 0);
+        return ps->GetGpuHostAllocator(gpu_options_, numa_node_);
       } else {
         return cpu_allocator_;
       }
@@ -57,6 +60,7 @@ class GPUDevice : public BaseGPUDevice {
   }
 
  private:
+  int numa_node_;
   GPUOptions gpu_options_;
   bool force_gpu_compatible_ = false;
 };
@@ -29,6 +29,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/gpu/gpu_process_state.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/numa.h"
 #include "tensorflow/core/platform/random.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/test.h"
@@ -222,6 +223,63 @@ TEST_F(GPUDeviceTest, DISABLED_ON_GPU_ROCM(CudaMallocAsyncPreallocate)) {
   EXPECT_EQ(status.code(), error::OK);
 }
 
+TEST_F(GPUDeviceTest, DISABLED_ON_GPU_ROCM(CudaMallocAsyncVirtualDevices)) {
+#ifndef GOOGLE_CUDA
+  return;
+#elif CUDA_VERSION < 11020
+  LOG(INFO) << "CUDA toolkit too old, skipping this test: " << CUDA_VERSION;
+  return;
+#else
+  int driverVersion;
+  cuDriverGetVersion(&driverVersion);
+  if (driverVersion < 11020) {
+    LOG(INFO) << "Driver version too old, skipping this test: "
+              << driverVersion;
+    return;
+  }
+
+  for (int64_t release_threshold : {int64_t{0}, int64_t{1000} << 20}) {
+    SessionOptions opts = MakeSessionOptions("0", 0, 1, {{123, 456}}, {}, {},
+                                             0, /*use_cuda_malloc_async=*/true);
+    opts.config.mutable_gpu_options()
+        ->mutable_experimental()
+        ->set_cuda_malloc_async_release_threshold_bytes(release_threshold);
+    std::vector<std::unique_ptr<Device>> devices;
+    TF_ASSERT_OK(DeviceFactory::GetFactory("GPU")->CreateDevices(
+        opts, kDeviceNamePrefix, &devices));
+    ASSERT_THAT(devices, SizeIs(2));
+
+    // Each allocator reports the memory limit of its own device.
+    AllocatorAttributes allocator_attributes;
+    allocator_attributes.set_gpu_compatible(true);
+    std::optional<AllocatorStats> stats0 =
+        devices[0]->GetAllocator(allocator_attributes)->GetStats();
+    std::optional<AllocatorStats> stats1 =
+        devices[1]->GetAllocator(allocator_attributes)->GetStats();
+    ASSERT_TRUE(stats0.has_value());
+    ASSERT_TRUE(stats1.has_value());
+    EXPECT_EQ(stats0->bytes_limit, int64_t{123} << 20);
+    EXPECT_EQ(stats1->bytes_limit, int64_t{456} << 20);
+
+    // The shared pool keeps the memory of both devices reserved, unless the
+    // release threshold is set explicitly.
+    CUmemoryPool pool;
+    ASSERT_EQ(cuDeviceGetDefaultMemPool(&pool, 0), CUDA_SUCCESS);
+    uint64_t pool_threshold = 0;
+    ASSERT_EQ(cuMemPoolGetAttribute(pool, CU_MEMPOOL_ATTR_RELEASE_THRESHOLD,
+                                    &pool_threshold),
+              CUDA_SUCCESS);
+    EXPECT_EQ(pool_threshold, release_threshold > 0
+                                  ? release_threshold
+                                  : (int64_t{123} + 456) << 20);
+
+    devices.clear();
+    BaseGPUDevice::TestOnlyReset();
+    GPUProcessState::singleton()->TestOnlyReset();
+  }
+#endif
+}
+
 TEST_F(GPUDeviceTest, FailedToParseVisibleDeviceList) {
   SessionOptions opts = MakeSessionOptions("0,abc");
   std::vector<std::unique_ptr<Device>> devices;
@@ -629,6 +687,46 @@ TEST_F(GPUDeviceTest, DeviceDetails) {
   }
 }
 
+TEST_F(GPUDeviceTest, GpuCompatibleHostAllocatorIsOnDeviceNumaNode) {
+  SessionOptions opts = MakeSessionOptions("0");
+  std::vector<std::unique_ptr<Device>> devices;
+  TF_ASSERT_OK(DeviceFactory::GetFactory("GPU")->CreateDevices(
+      opts, kDeviceNamePrefix, &devices));
+  Device* device = devices[0].get();
+  AllocatorAttributes attr;
+  attr.set_on_host(true);
+  attr.set_gpu_compatible(true);
+  Allocator* allocator = device->GetAllocator(attr);
+  EXPECT_EQ(allocator, GPUProcessState::singleton()->GetGpuHostAllocator(
+                           opts.config.gpu_options(),
+                           device->attributes().locality().numa_node()));
+
+  Tensor tensor(allocator, DT_FLOAT, TensorShape({1024}));
+  EXPECT_EQ(tensor.GetMemoryType(), AllocatorMemoryType::kHostPinned);
+}
+
+TEST_F(GPUDeviceTest, GpuHostAllocatorPerNumaNode) {
+  // Creates the GPU devices, which the host allocators are registered with.
+  SessionOptions opts = MakeSessionOptions("0");
+  std::vector<std::unique_ptr<Device>> devices;
+  TF_ASSERT_OK(DeviceFactory::GetFactory("GPU")->CreateDevices(
+      opts, kDeviceNamePrefix, &devices));
+  GPUProcessState* ps = GPUProcessState::singleton();
+  Allocator* node0 = ps->GetGpuHostAllocator(opts.config.gpu_options(), 0);
+  EXPECT_EQ(node0, ps->GetGpuHostAllocator(opts.config.gpu_options(),
+                                           port::kNUMANoAffinity));
+  if (!port::NUMAEnabled() || port::NUMANumNodes() < 2) {
+    // Without NUMA, all the nodes share the pool of node 0.
+    EXPECT_EQ(node0, ps->GetGpuHostAllocator(opts.config.gpu_options(), 1));
+    return;
+  }
+  Allocator* node1 = ps->GetGpuHostAllocator(opts.config.gpu_options(), 1);
+  EXPECT_NE(node0, node1);
+  EXPECT_EQ(node1, ps->GetGpuHostAllocator(opts.config.gpu_options(), 1));
+  Tensor tensor(node1, DT_FLOAT, TensorShape({1024}));
+  EXPECT_EQ(tensor.GetMemoryType(), AllocatorMemoryType::kHostPinned);
+}
+
 TEST_F(GPUDeviceTest, StreamToIdMultipleVirtualDevices) {
   // Valid range for priority values on AMD GPUs in (-1,1)
   // Valid range for priority values on NVidia GPUs in (-2, 0)
@@ -46,6 +46,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/shared_counter.h"
 #include "tensorflow/core/framework/log_memory.h"
 #include "tensorflow/core/framework/tracking_allocator.h"
+#include "tensorflow/core/platform/numa.h"
 #include "tsl/platform/logging.h"
 #include "tsl/platform/mutex.h"
 #include "tsl/platform/strcat.h"
@@ -206,9 +207,35 @@ Allocator* GPUProcessState::GetGPUAllocator(
       // TODO: **WARNING** probably will not work in a multi-gpu scenario
       gpu_bfc_allocator.reset();
 #if GOOGLE_CUDA
-      gpu_allocator =
+      // All the TF devices on one GPU allocate from its default memory pool,
+      // so by default the pool keeps the memory of all of them reserved.
+      // The bytes_limit of each allocator stays its own device's limit.
+      auto* async_allocator =
           new se::GpuCudaMallocAsyncAllocator(platform_device_id, total_bytes);
+      int64_t release_threshold =
+          options.experimental().cuda_malloc_async_release_threshold_bytes();
+      if (release_threshold <= 0) {
+        if (platform_device_id.value() >=
+            static_cast<int64_t>(cuda_malloc_async_pool_bytes_.size())) {
+          cuda_malloc_async_pool_bytes_.resize(platform_device_id.value() + 1);
+        }
+        cuda_malloc_async_pool_bytes_[platform_device_id.value()] +=
+            total_bytes;
+        release_threshold =
+            cuda_malloc_async_pool_bytes_[platform_device_id.value()];
+      }
+      async_allocator->SetReleaseThreshold(release_threshold);
+      gpu_allocator = async_allocator;
 #endif
+      // Memory freed to the pool is only reused in the order of the compute
+      // stream, so deallocations need not wait for the kernels that used them
+      // to complete.
+      if (timing_counter != nullptr) {
+        LOG(INFO) << "Ignoring timestamped_allocator with the CUDA malloc "
+                     "Async allocator.";
+        delete timing_counter;
+        timing_counter = nullptr;
+      }
     }
 
     Allocator* recording_allocator = nullptr;
@@ -290,7 +317,9 @@ Allocator* GPUProcessState::GetGpuHostAllocator(const GPUOptions& options,
       !process_state_->ProcessState::FLAGS_brain_mem_reg_gpu_dma) {
     return process_state_->GetCPUAllocator(numa_node);
   }
-  if (numa_node == port::kNUMANoAffinity) {
+  // There is one pool of pinned memory per NUMA node, so that the host side
+  // of a copy is close to the GPU it is copied to or from.
+  if (numa_node == port::kNUMANoAffinity || !port::NUMAEnabled()) {
     numa_node = 0;
   }
   {
@@ -300,16 +329,15 @@ Allocator* GPUProcessState::GetGpuHostAllocator(const GPUOptions& options,
     // we take a unique lock and populate these vectors.
     tf_shared_lock lock(mu_);
 
-    if (process_state_->ProcessState::FLAGS_brain_gpu_record_mem_types &&
-        !gpu_host_allocators_.empty() &&
-        gpu_host_allocators_[0].recording_allocator != nullptr) {
-      return gpu_host_allocators_[0].recording_allocator.get();
-    }
     if (static_cast<int>(gpu_host_allocators_.size()) > numa_node) {
+      if (process_state_->ProcessState::FLAGS_brain_gpu_record_mem_types &&
+          gpu_host_allocators_[numa_node].recording_allocator != nullptr) {
+        return gpu_host_allocators_[numa_node].recording_allocator.get();
+      }
 #ifdef TF_GPU_USE_PJRT
-      return gpu_host_allocators_[0].allocator_not_owned;
+      return gpu_host_allocators_[numa_node].allocator_not_owned;
 #else
-      return gpu_host_allocators_[0].allocator.get();
+      return gpu_host_allocators_[numa_node].allocator.get();
 #endif  // TF_GPU_USE_PJRT
     }
   }
@@ -358,16 +386,20 @@ Allocator* GPUProcessState::GetGpuHostAllocator(const GPUOptions& options,
     while (gpu_host_free_visitors_.size() <= numa_node) {
       gpu_host_free_visitors_.push_back({});
     }
+    const int node = gpu_host_allocators_.size();
     SubAllocator* sub_allocator = new DeviceHostAllocator(
-        se, numa_node, gpu_host_alloc_visitors_[numa_node],
-        gpu_host_free_visitors_[numa_node]);
+        se, port::NUMAEnabled() ? node : port::kNUMANoAffinity,
+        gpu_host_alloc_visitors_[node], gpu_host_free_visitors_[node]);
 
     tsl::BFCAllocator::Options allocator_opts;
     allocator_opts.allow_growth =
         !options.experimental().gpu_host_mem_disallow_growth();
     tsl::Allocator* allocator =
         new tsl::BFCAllocator(absl::WrapUnique(sub_allocator), mem_limit_bytes,
-                              /*name=*/"gpu_host_bfc", allocator_opts);
+                              /*name=*/
+                              node == 0 ? "gpu_host_bfc"
+                                        : strings::StrCat("gpu_host_bfc_", node),
+                              allocator_opts);
 
     if (LogMemory::IsEnabled() && !allocator->TracksAllocationSizes()) {
       // Wrap the allocator to track allocation ids for better logging
@@ -395,7 +427,7 @@ Allocator* GPUProcessState::GetGpuHostAllocator(const GPUOptions& options,
     if (process_state_->ProcessState::FLAGS_brain_gpu_record_mem_types) {
       ProcessState::MemDesc md;
       md.loc = ProcessState::MemDesc::CPU;
-      md.dev_index = 0;
+      md.dev_index = node;
       md.gpu_registered = true;
       md.nic_registered = false;
       allocator_parts.recording_allocator =
@@ -405,12 +437,12 @@ Allocator* GPUProcessState::GetGpuHostAllocator(const GPUOptions& options,
     }
   }
   if (process_state_->ProcessState::FLAGS_brain_gpu_record_mem_types) {
-    return gpu_host_allocators_[0].recording_allocator.get();
+    return gpu_host_allocators_[numa_node].recording_allocator.get();
   } else {
 #ifdef TF_GPU_USE_PJRT
-    return gpu_host_allocators_[0].allocator_not_owned;
+    return gpu_host_allocators_[numa_node].allocator_not_owned;
 #else
-    return gpu_host_allocators_[0].allocator.get();
+    return gpu_host_allocators_[numa_node].allocator.get();
 #endif  // TF_GPU_USE_PJRT
   }
 }
@@ -469,6 +501,7 @@ void GPUProcessState::TestOnlyReset() {
     mutex_lock lock(mu_);
     gpu_device_enabled_ = false;
     gpu_allocators_.clear();
+    cuda_malloc_async_pool_bytes_.clear();
     gpu_visitors_.clear();
     gpu_host_allocators_.clear();
     gpu_host_alloc_visitors_.clear();
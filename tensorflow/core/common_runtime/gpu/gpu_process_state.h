@@ -173,6 +173,9 @@ class GPUProcessState {
 #endif  // TF_GPU_USE_PJRT
   };
   std::vector<AllocatorParts> gpu_allocators_ TF_GUARDED_BY(mu_);
+  // The sum of the memory limits of the TF devices that allocate from the
+  // cudaMallocAsync pool of each GPU, indexed by platform device id.
+  std::vector<int64_t> cuda_malloc_async_pool_bytes_ TF_GUARDED_BY(mu_);
   std::vector<std::vector<SubAllocator::Visitor>> gpu_visitors_
       TF_GUARDED_BY(mu_);
 
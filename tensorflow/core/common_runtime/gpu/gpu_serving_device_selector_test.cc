@@ -67,6 +67,29 @@ TEST(GpuServingDeviceSelector, Basic) {
   EXPECT_EQ(reservation.device_index(), 0);
 }
 
+TEST(GpuServingDeviceSelector, LeastLoaded) {
+  GpuServingDeviceSelector selector(
+      /*num_devices=*/2, std::make_unique<tsl::LeastLoadedPolicy>());
+
+  // Keeps the reservations so that the programs stay enqueued.
+  const std::string program_fingerprint = "TensorFlow";
+  tsl::DeviceReservation first = selector.ReserveDevice(program_fingerprint);
+  EXPECT_EQ(first.device_index(), 0);
+  // Device 0 is loaded by one more program than device 1, which is within the
+  // affinity slack.
+  tsl::DeviceReservation second = selector.ReserveDevice(program_fingerprint);
+  EXPECT_EQ(second.device_index(), 0);
+  // Device 0 is now too loaded.
+  tsl::DeviceReservation third = selector.ReserveDevice(program_fingerprint);
+  EXPECT_EQ(third.device_index(), 1);
+
+  first.reset();
+  second.reset();
+  // Device 1 ran the program last and is not more loaded than device 0.
+  tsl::DeviceReservation fourth = selector.ReserveDevice(program_fingerprint);
+  EXPECT_EQ(fourth.device_index(), 1);
+}
+
 TEST(GpuServingDeviceSelector, DefaultPolicyOnlyEnqueueCall) {
   ServingDeviceSelectorTestHelper helper;
   auto policy = std::make_unique<tsl::RoundRobinPolicy>();
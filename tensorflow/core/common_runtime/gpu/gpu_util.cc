@@ -174,8 +174,8 @@ void GPUUtil::SetProtoFromGPU(const Tensor& tensor, Device* dev,
   const int64_t total_bytes = is_dead ? 0 : tensor.TotalBytes();
   if (total_bytes > 0) {
     tsl::profiler::ScopedAnnotation annotation("SetProtoFromGPU");
-    alloc =
-        GPUProcessState::singleton()->GetGpuHostAllocator(/*options=*/{}, 0);
+    alloc = GPUProcessState::singleton()->GetGpuHostAllocator(
+        /*options=*/{}, dev->attributes().locality().numa_node());
     buf = static_cast<char*>(
         alloc->AllocateRaw(Allocator::kAllocatorAlignment, total_bytes));
     if (LogMemory::IsEnabled()) {
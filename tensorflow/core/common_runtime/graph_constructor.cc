@@ -50,9 +50,13 @@ limitations under the License.
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/lib/strings/scanner.h"
 #include "tensorflow/core/lib/strings/str_util.h"
+#include "tensorflow/core/platform/cpu_info.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/threadpool.h"
 #include "tensorflow/core/public/version.h"
 
 namespace tensorflow {
@@ -63,6 +67,10 @@ namespace {
 // can skip expensive duplicates check in 'AddControlEdge'.
 static constexpr const bool kDoNotCheckDuplicates = true;
 
+// The NodeDefs of graphs with at least this many nodes are prepared in
+// parallel before the graph is converted, when they can be modified in place.
+constexpr int kMinNodesForParallelPrepare = 16384;
+
 inline bool IsMerge(const NodeDef& node_def) {
   return node_def.op() == "Merge" || node_def.op() == "RefMerge" ||
          node_def.op() == "_XlaMerge";
@@ -247,7 +255,18 @@ class GraphConstructor {
   absl::Status MakeEdge(Node* src, int output_index, Node* dst,
                         int input_index);
   absl::Status ValidateShape(Node* node);
-  absl::Status ModifyNodeDefForImport(NodeDef* node_def);
+  // Looks up `op` in the op registry of g_. The lookups are memoized by op
+  // type, since large graphs have few distinct ops.
+  absl::Status LookUpOp(const string& op,
+                        const OpRegistrationData** op_reg_data);
+  absl::Status LookUpOpDef(const string& op, const OpDef** op_def);
+  // Adds the default attributes to `node_def` and validates it, as required
+  // by opts_.
+  absl::Status PrepareNodeDef(const OpDef& op_def, NodeDef* node_def) const;
+  // Runs PrepareNodeDef() on all the NodeDefs in parallel for large graphs,
+  // when they can be modified in place and are all converted. Sets
+  // node_defs_prepared_ on success.
+  absl::Status PrepareNodeDefsInParallel();
   // Modifies node_def's inputs according to opts_.input_map.
   // input_already_exists is a pre-initialized vector of length
   // node_def->input_size(). This function will mark inputs that are remapped to
@@ -301,6 +320,10 @@ class GraphConstructor {
   // possible. After calling this method, the result of get_node_def(i) is
   // undefined.
   virtual NodeDef consume_node_def(int i) = 0;
+  // Returns the i^th node in the graph for modification in place, or nullptr
+  // if the nodes can't be modified. Must not be called after
+  // consume_node_def(i).
+  virtual NodeDef* mutable_node_def(int i) { return nullptr; }
   // Returns the version information for the graph, or nullptr if none is
   // available.
   virtual const VersionDef* versions() const = 0;
@@ -331,6 +354,13 @@ class GraphConstructor {
   // May be null. Not owned.
   std::vector<SafeTensorId>* missing_unused_input_map_keys_;
 
+  // Memoized LookUpOp() results. The registration data is owned by the op
+  // registry of g_, whose entries are never removed while converting.
+  absl::flat_hash_map<string, const OpRegistrationData*> op_reg_data_;
+
+  // True if PrepareNodeDefsInParallel() prepared all the NodeDefs.
+  bool node_defs_prepared_ = false;
+
   // Intermediate datastructure used to populate
   // `missing_unused_input_map_keys_`.
   std::set<TensorId> used_input_map_keys_;
@@ -478,6 +508,11 @@ class NodeDefMovingGraphConstructor : public GraphConstructor {
     is_consumed_[i] = true;
     return std::move(*graph_def_.mutable_node(i));
   }
+  NodeDef* mutable_node_def(int i) override {
+    CHECK(!is_consumed_[i])
+        << "NodeDef " << i << " accessed after it was consumed.";
+    return graph_def_.mutable_node(i);
+  }
   const VersionDef* versions() const override { return &graph_def_.versions(); }
   std::optional<FunctionDefLibrary> consume_library() override {
     return std::move(*graph_def_.mutable_library());
@@ -805,8 +840,10 @@ absl::Status GraphConstructor::ValidateColocationConstraints(
 
 absl::Status GraphConstructor::MakeNode(NodeDef&& node_def, Node** node) {
   // Add the node to the graph.
+  const OpRegistrationData* op_reg_data;
+  TF_RETURN_IF_ERROR(LookUpOp(node_def.op(), &op_reg_data));
   absl::Status status;
-  *node = g_->AddNode(std::move(node_def), &status);
+  *node = g_->AddNode(std::move(node_def), *op_reg_data, &status);
   if (!status.ok()) return status;
   if (opts_.expect_device_spec ||
       (opts_.propagate_device_spec && !(*node)->def().device().empty())) {
@@ -864,17 +901,83 @@ absl::Status GraphConstructor::ValidateShape(Node* node) {
   return absl::OkStatus();
 }
 
-absl::Status GraphConstructor::ModifyNodeDefForImport(NodeDef* node_def) {
-  const OpDef* op_def;
-  TF_RETURN_IF_ERROR(g_->op_registry()->LookUpOpDef(node_def->op(), &op_def));
-  AddDefaultsToNodeDef(*op_def, node_def);
-  TF_RETURN_IF_ERROR(ValidateNodeDef(*node_def, *op_def));
-  if (versions()) {
-    TF_RETURN_IF_ERROR(CheckOpDeprecation(*op_def, versions()->producer()));
+absl::Status GraphConstructor::LookUpOp(
+    const string& op, const OpRegistrationData** op_reg_data) {
+  auto it = op_reg_data_.find(op);
+  if (it != op_reg_data_.end()) {
+    *op_reg_data = it->second;
+    return absl::OkStatus();
+  }
+  TF_RETURN_IF_ERROR(g_->op_registry()->LookUp(op, op_reg_data));
+  op_reg_data_.emplace(op, *op_reg_data);
+  return absl::OkStatus();
+}
+
+absl::Status GraphConstructor::LookUpOpDef(const string& op,
+                                           const OpDef** op_def) {
+  const OpRegistrationData* op_reg_data;
+  TF_RETURN_IF_ERROR(LookUpOp(op, &op_reg_data));
+  *op_def = &op_reg_data->op_def;
+  return absl::OkStatus();
+}
+
+absl::Status GraphConstructor::PrepareNodeDef(const OpDef& op_def,
+                                              NodeDef* node_def) const {
+  if (opts_.importing) {
+    AddDefaultsToNodeDef(op_def, node_def);
+    TF_RETURN_IF_ERROR(ValidateNodeDef(*node_def, op_def));
+    if (versions()) {
+      TF_RETURN_IF_ERROR(CheckOpDeprecation(op_def, versions()->producer()));
+    }
+  } else {
+    if (opts_.add_default_attributes) {
+      AddDefaultsToNodeDef(op_def, node_def);
+    }
+    if (opts_.validate_nodes) {
+      TF_RETURN_IF_ERROR(ValidateNodeDef(*node_def, op_def));
+    }
   }
   return absl::OkStatus();
 }
 
+absl::Status GraphConstructor::PrepareNodeDefsInParallel() {
+  const int num_nodes = node_def_count();
+  // Skipped nodes must not be validated.
+  if (num_nodes < kMinNodesForParallelPrepare || opts_.skip_mapped_nodes ||
+      mutable_node_def(0) == nullptr) {
+    return absl::OkStatus();
+  }
+  // The registry lookups are memoized, so they are done up front.
+  std::vector<const OpDef*> op_defs(num_nodes);
+  for (int i = 0; i < num_nodes; ++i) {
+    TF_RETURN_IF_ERROR(LookUpOpDef(get_node_def(i).op(), &op_defs[i]));
+  }
+  // The node names in the errors are the original, unprefixed ones. The error
+  // of the first invalid node in the GraphDef is returned.
+  mutex mu;
+  int first_error_index = num_nodes;
+  absl::Status first_error;
+  thread::ThreadPool pool(Env::Default(), "graph_constructor",
+                          port::MaxParallelism());
+  pool.ParallelFor(
+      num_nodes, /*cost_per_unit=*/10000, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; ++i) {
+          absl::Status s = PrepareNodeDef(*op_defs[i], mutable_node_def(i));
+          if (!s.ok()) {
+            mutex_lock l(mu);
+            if (i < first_error_index) {
+              first_error_index = i;
+              first_error = std::move(s);
+            }
+            return;
+          }
+        }
+      });
+  TF_RETURN_IF_ERROR(first_error);
+  node_defs_prepared_ = true;
+  return absl::OkStatus();
+}
+
 void RemoveInputs(const std::vector<int>& inputs_to_remove, NodeDef* node_def,
                   std::vector<bool>* input_already_exists) {
   // Remove 'inputs_to_remove' from 'node_def'
@@ -1080,7 +1183,7 @@ string GraphConstructor::FindUniqueName(StringPiece original_name) {
 absl::Status GraphConstructor::IsNodeFullyMapped(const NodeDef& node_def,
                                                  bool* is_node_mapped) {
   const OpDef* op_def;
-  TF_RETURN_IF_ERROR(g_->op_registry()->LookUpOpDef(node_def.op(), &op_def));
+  TF_RETURN_IF_ERROR(LookUpOpDef(node_def.op(), &op_def));
   for (int i = 0; i < op_def->output_arg_size(); ++i) {
     if (opts_.input_map.find({node_def.name(), i}) == opts_.input_map.end()) {
       *is_node_mapped = false;
@@ -1186,6 +1289,8 @@ absl::Status GraphConstructor::Convert() {
         g_->AddFunctionLibrary(*std::move(library), library_traces));
   }
 
+  TF_RETURN_IF_ERROR(PrepareNodeDefsInParallel());
+
   std::vector<InputInfo> inputs;
   int processed = 0;
 
@@ -1296,18 +1401,10 @@ absl::Status GraphConstructor::Convert() {
       }
     }
 
-    if (opts_.importing) {
-      TF_RETURN_IF_ERROR(ModifyNodeDefForImport(&node_def));
-    } else {
+    if (!node_defs_prepared_) {
       const OpDef* op_def;
-      TF_RETURN_IF_ERROR(
-          g_->op_registry()->LookUpOpDef(node_def.op(), &op_def));
-      if (opts_.add_default_attributes) {
-        AddDefaultsToNodeDef(*op_def, &node_def);
-      }
-      if (opts_.validate_nodes) {
-        TF_RETURN_IF_ERROR(ValidateNodeDef(node_def, *op_def));
-      }
+      TF_RETURN_IF_ERROR(LookUpOpDef(node_def.op(), &op_def));
+      TF_RETURN_IF_ERROR(PrepareNodeDef(*op_def, &node_def));
     }
 
     TF_RETURN_IF_ERROR(MakeNode(std::move(node_def), &node));
@@ -1470,7 +1567,7 @@ absl::Status GraphConstructor::PopulateMissingUnusedInputMapKeys() {
     // opts_.skip_mapped_nodes is true.
     const NodeDef& node_def = get_node_def(pair->second.gdef_index);
     const OpDef* op_def;
-    TF_RETURN_IF_ERROR(g_->op_registry()->LookUpOpDef(node_def.op(), &op_def));
+    TF_RETURN_IF_ERROR(LookUpOpDef(node_def.op(), &op_def));
     int num_outputs;
     TF_RETURN_IF_ERROR(NumOutputsForNode(node_def, *op_def, &num_outputs));
     if (key.second >= num_outputs) {
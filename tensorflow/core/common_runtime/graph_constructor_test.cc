@@ -19,6 +19,8 @@ limitations under the License.
 #include <vector>
 
 #include <gtest/gtest.h>
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
 #include "tensorflow/core/common_runtime/shape_refiner.h"
 #include "tensorflow/core/framework/common_shape_fns.h"
 #include "tensorflow/core/framework/function.h"
@@ -1037,6 +1039,40 @@ TEST_F(GraphConstructorTest, ImportGraphDef_DefaultAttrs) {
   EXPECT_EQ(31415, value);
 }
 
+TEST_F(GraphConstructorTest, ConvertLargeGraphDef) {
+  // Large enough for the NodeDefs to be prepared in parallel.
+  constexpr int kNumNodes = 20000;
+  GraphDef def;
+  for (int i = 0; i < kNumNodes; ++i) {
+    NodeDef* node = def.add_node();
+    node->set_name(absl::StrCat("n", i));
+    node->set_op("TestDefaultAttr");
+  }
+  TF_ASSERT_OK(ConvertGraphDefToGraph(GraphConstructorOptions(),
+                                      std::move(def), &graph_));
+  EXPECT_EQ(graph_.num_op_nodes(), kNumNodes);
+  for (Node* n : graph_.op_nodes()) {
+    int value = 0;
+    TF_ASSERT_OK(GetNodeAttr(n->attrs(), "default_int", &value));
+    EXPECT_EQ(value, 31415);
+  }
+}
+
+TEST_F(GraphConstructorTest, ConvertLargeGraphDefWithInvalidNode) {
+  constexpr int kNumNodes = 20000;
+  GraphDef def;
+  for (int i = 0; i < kNumNodes; ++i) {
+    NodeDef* node = def.add_node();
+    node->set_name(absl::StrCat("n", i));
+    node->set_op("TestDefaultAttr");
+  }
+  (*def.mutable_node(kNumNodes / 2)->mutable_attr())["bogus"].set_i(1);
+  absl::Status s = ConvertGraphDefToGraph(GraphConstructorOptions(),
+                                          std::move(def), &graph_);
+  EXPECT_TRUE(absl::IsInvalidArgument(s)) << s;
+  EXPECT_TRUE(absl::StrContains(s.message(), "bogus")) << s;
+}
+
 TEST_F(GraphConstructorTest, ImportGraphDef_Versioning) {
   GraphDef def;
   const ImportGraphDefOptions opts;
@@ -0,0 +1,307 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/hierarchical_reducer.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/collective_rma_local.h"
+#include "tensorflow/core/common_runtime/collective_util.h"
+#include "tensorflow/core/common_runtime/device.h"
+#include "tensorflow/core/common_runtime/dma_helper.h"
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/framework/device_base.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/notification.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/profiler/lib/traceme.h"
+
+namespace tensorflow {
+namespace {
+
+// Returns the number of devices in each task, which must be the same for all
+// tasks, or an error if the devices of a task are not adjacent in the group.
+absl::Status DevicesPerTask(const CollGroupParams& group, int* num_devices) {
+  std::vector<int> dev_per_task;
+  for (int di = 0; di < group.group_size; ++di) {
+    if (di == 0 || group.members[di].task != group.members[di - 1].task) {
+      dev_per_task.push_back(0);
+    }
+    ++dev_per_task.back();
+  }
+  if (dev_per_task.size() != group.num_tasks) {
+    return errors::InvalidArgument(
+        "HierarchicalReduce requires the devices of each task to be adjacent "
+        "in the group");
+  }
+  for (int count : dev_per_task) {
+    if (count != dev_per_task[0]) {
+      return errors::InvalidArgument(
+          "HierarchicalReduce requires the same number of devices in every "
+          "task");
+    }
+  }
+  *num_devices = dev_per_task[0];
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+HierarchicalReducer::HierarchicalReducer()
+    : col_ctx_(nullptr), col_params_(nullptr) {}
+
+HierarchicalReducer::~HierarchicalReducer() {}
+
+absl::Status HierarchicalReducer::InitializeCollectiveParams(
+    CollectiveParams* col_params) {
+  if (col_params->instance.type != REDUCTION_COLLECTIVE) {
+    return errors::Internal("HierarchicalReduce only implements reductions");
+  }
+  int num_devices;
+  return DevicesPerTask(col_params->group, &num_devices);
+}
+
+absl::Status HierarchicalReducer::InitializeCollectiveContext(
+    std::shared_ptr<CollectiveContext> col_ctx) {
+  DCHECK(col_ctx->dev_mgr);
+  col_ctx_ = col_ctx;
+  col_params_ = col_ctx->col_params.get();
+  return collective_util::InitializeDeviceAndLocality(
+      col_ctx->dev_mgr, col_ctx->device_name, &col_ctx->device,
+      &col_ctx->device_locality);
+}
+
+void HierarchicalReducer::Run(StatusCallback done) {
+  CHECK(col_ctx_);
+  CHECK(col_params_);
+  col_ctx_->col_exec->UnblockDependencies(*col_params_);
+
+  absl::Status s;
+  // Start by copying input to output if they're not already the same, i.e. if
+  // we're not computing in-place on the input tensor.
+  if ((col_ctx_->input != col_ctx_->output) &&
+      (DMAHelper::base(col_ctx_->input) != DMAHelper::base(col_ctx_->output))) {
+    Notification note;
+    CollectiveRemoteAccessLocal::MemCpyAsync(
+        col_ctx_->op_ctx->op_device_context(),
+        col_ctx_->op_ctx->op_device_context(), col_ctx_->device,
+        col_ctx_->device, col_ctx_->op_ctx->input_alloc_attr(0),
+        col_ctx_->op_ctx->output_alloc_attr(0), col_ctx_->input,
+        col_ctx_->output, 0 /*dev_to_dev_stream_index*/,
+        [&note, &s](const absl::Status& status) {
+          s.Update(status);
+          note.Notify();
+        });
+    note.WaitForNotification();
+  }
+  if (s.ok()) s = RunPhases();
+  if (!s.ok()) {
+    LOG(ERROR) << "Aborting HierarchicalReduce with " << s;
+    // Unblocks the peers waiting for this device, unless the whole step is
+    // already being cancelled.
+    CancellationManager* cm = col_ctx_->op_ctx->cancellation_manager();
+    if (cm == nullptr || (!cm->IsCancelled() && !cm->IsCancelling())) {
+      col_ctx_->col_exec->StartAbort(s);
+    }
+  }
+  done(s);
+}
+
+absl::Status HierarchicalReducer::RunPhases() {
+  const CollGroupParams& group = col_params_->group;
+  int num_local;
+  TF_RETURN_IF_ERROR(DevicesPerTask(group, &num_local));
+  const int num_tasks = group.num_tasks;
+  const int rank = col_params_->default_rank;
+  const int task_idx = rank / num_local;
+  const int local_pos = rank % num_local;
+
+  std::vector<int> local_ring(num_local);
+  for (int i = 0; i < num_local; ++i) local_ring[i] = task_idx * num_local + i;
+  std::vector<int> cross_ring(num_tasks);
+  for (int t = 0; t < num_tasks; ++t) cross_ring[t] = t * num_local + local_pos;
+
+  AllocatorAttributes attr = col_ctx_->op_ctx->output_alloc_attr(0);
+  Allocator* allocator = col_ctx_->device->GetAllocator(attr);
+  std::unique_ptr<CollectiveAdapter> ca(
+      MakeCollectiveAdapter(col_ctx_->output, num_local, allocator));
+
+  TF_RETURN_IF_ERROR(
+      ReduceScatter("local_rs", local_ring, local_pos, ca.get()));
+  const int owned_idx = (local_pos + 1) % num_local;
+  // Devices at the same position in their task own the same chunk, so they
+  // all skip the exchange across tasks if it is empty.
+  if (ca->ChunkBytes(owned_idx) > 0) {
+    Tensor owned = ca->ChunkAlias(owned_idx);
+    std::unique_ptr<CollectiveAdapter> cross_ca(
+        MakeCollectiveAdapter(&owned, num_tasks, allocator));
+    TF_RETURN_IF_ERROR(
+        ReduceScatter("cross_rs", cross_ring, task_idx, cross_ca.get()));
+    const int final_idx = (task_idx + 1) % num_tasks;
+    if (col_params_->final_op != nullptr &&
+        cross_ca->ChunkBytes(final_idx) > 0) {
+      Tensor chunk = cross_ca->ChunkAlias(final_idx);
+      TF_RETURN_IF_ERROR(Finalize(cross_ca.get(), &chunk));
+    }
+    TF_RETURN_IF_ERROR(
+        AllGather("cross_ag", cross_ring, task_idx, cross_ca.get()));
+  }
+  TF_RETURN_IF_ERROR(AllGather("local_ag", local_ring, local_pos, ca.get()));
+
+  ca->ConsumeFinalValue(col_ctx_->output);
+  return absl::OkStatus();
+}
+
+absl::Status HierarchicalReducer::ReduceScatter(const std::string& phase,
+                                                const std::vector<int>& ring,
+                                                int pos,
+                                                CollectiveAdapter* ca) {
+  const int n = ring.size();
+  if (n == 1) return absl::OkStatus();
+  // The receive buffers are allocated up front, so that waiting once for the
+  // queued events of the compute stream makes all of them valid, e.g. for
+  // RDMA writes.
+  std::vector<Tensor> tmp_chunks(n - 1);
+  for (int step = 0; step < n - 1; ++step) {
+    tmp_chunks[step] = ca->TempChunk((pos - step - 1 + 2 * n) % n);
+  }
+  const DeviceBase::AcceleratorDeviceInfo* gpu_info =
+      col_ctx_->device->tensorflow_accelerator_device_info();
+  if (gpu_info != nullptr) {
+    tsl::profiler::TraceMe activity("WaitForQueuedEvents",
+                                    tsl::profiler::TraceMeLevel::kInfo);
+    Notification note;
+    TF_RETURN_IF_ERROR(gpu_info->default_context->ThenExecute(
+        col_ctx_->device, gpu_info->stream, [&note]() { note.Notify(); }));
+    note.WaitForNotification();
+  }
+
+  for (int step = 0; step < n - 1; ++step) {
+    const int send_idx = (pos - step + n) % n;
+    const int recv_idx = (pos - step - 1 + 2 * n) % n;
+    TF_RETURN_IF_ERROR(Exchange(phase, step, ring, pos, ca, send_idx,
+                                recv_idx, &tmp_chunks[step]));
+    if (ca->ChunkBytes(recv_idx) > 0) {
+      Tensor chunk = ca->ChunkAlias(recv_idx);
+      TF_RETURN_IF_ERROR(collective_util::ComputeBinOp(
+          col_ctx_->op_ctx, col_ctx_->op_params, col_ctx_->device,
+          col_params_->merge_op, &chunk, &tmp_chunks[step]));
+    }
+  }
+  return absl::OkStatus();
+}
+
+absl::Status HierarchicalReducer::AllGather(const std::string& phase,
+                                            const std::vector<int>& ring,
+                                            int pos, CollectiveAdapter* ca) {
+  const int n = ring.size();
+  for (int step = 0; step < n - 1; ++step) {
+    const int send_idx = (pos + 1 - step + n) % n;
+    const int recv_idx = (pos - step + n) % n;
+    Tensor chunk = ca->ChunkAlias(recv_idx);
+    TF_RETURN_IF_ERROR(
+        Exchange(phase, step, ring, pos, ca, send_idx, recv_idx, &chunk));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status HierarchicalReducer::Exchange(const std::string& phase, int step,
+                                           const std::vector<int>& ring,
+                                           int pos, CollectiveAdapter* ca,
+                                           int send_idx, int recv_idx,
+                                           Tensor* recv_buf) {
+  const int n = ring.size();
+  const CollGroupMember& to = col_params_->group.members[ring[(pos + 1) % n]];
+  const int from_rank = ring[(pos + n - 1) % n];
+  const CollGroupMember& from = col_params_->group.members[from_rank];
+
+  absl::Status send_status;
+  absl::Status recv_status;
+  Notification send_done;
+  Notification recv_done;
+  Tensor send_buf;
+  if (ca->ChunkBytes(send_idx) > 0) {
+    send_buf = ca->ChunkAlias(send_idx);
+    col_ctx_->col_exec->remote_access()->PostToPeer(
+        to.device.name(), to.task,
+        strings::StrCat(col_ctx_->exec_key, ":", phase, ":", step, ":",
+                        col_params_->default_rank),
+        col_ctx_->device, col_ctx_->op_ctx->op_device_context(),
+        col_ctx_->op_ctx->output_alloc_attr(0), &send_buf,
+        col_ctx_->device_locality, col_ctx_->op_ctx->cancellation_manager(),
+        [&send_status, &send_done](const absl::Status& s) {
+          send_status = s;
+          send_done.Notify();
+        });
+  } else {
+    send_done.Notify();
+  }
+  if (ca->ChunkBytes(recv_idx) > 0) {
+    col_ctx_->col_exec->remote_access()->RecvFromPeer(
+        from.device.name(), from.task, from.is_local,
+        strings::StrCat(col_ctx_->exec_key, ":", phase, ":", step, ":",
+                        from_rank),
+        col_ctx_->device, col_ctx_->op_ctx->op_device_context(),
+        col_ctx_->op_ctx->output_alloc_attr(0), recv_buf,
+        col_ctx_->device_locality, /*dev_to_dev_stream_index=*/0,
+        col_ctx_->op_ctx->cancellation_manager(),
+        [&recv_status, &recv_done](const absl::Status& s) {
+          recv_status = s;
+          recv_done.Notify();
+        });
+  } else {
+    recv_done.Notify();
+  }
+  send_done.WaitForNotification();
+  recv_done.WaitForNotification();
+  send_status.Update(recv_status);
+  return send_status;
+}
+
+absl::Status HierarchicalReducer::Finalize(CollectiveAdapter* ca,
+                                           Tensor* chunk) {
+  Tensor group_size = ca->Scalar(col_params_->group.group_size);
+  if (col_params_->group.device_type != DEVICE_CPU) {
+    Tensor device_group_size =
+        ca->Scalar(col_ctx_->device->GetAllocator(
+                       col_ctx_->op_ctx->input_alloc_attr(0)),
+                   AllocationAttributes());
+    Notification note;
+    absl::Status s;
+    col_ctx_->op_ctx->op_device_context()->CopyCPUTensorToDevice(
+        &group_size, col_ctx_->device, &device_group_size,
+        [&note, &s](const absl::Status& status) {
+          s = status;
+          note.Notify();
+        });
+    note.WaitForNotification();
+    TF_RETURN_IF_ERROR(s);
+    group_size = device_group_size;
+  }
+  return collective_util::ComputeBinOp(col_ctx_->op_ctx, col_ctx_->op_params,
+                                       col_ctx_->device, col_params_->final_op,
+                                       chunk, &group_size);
+}
+
+namespace {
+REGISTER_COLLECTIVE(HierarchicalReduce, HierarchicalReducer);
+}  // namespace
+
+}  // namespace tensorflow
@@ -0,0 +1,87 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_HIERARCHICAL_REDUCER_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_HIERARCHICAL_REDUCER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/base_collective_executor.h"
+#include "tensorflow/core/framework/collective.h"
+
+namespace tensorflow {
+
+// Hierarchical implementation of collective all-reduce for groups that span
+// several tasks, selected with communication_hint "hierarchical". With L
+// devices in each of T tasks, every device
+//   1. reduce-scatters the tensor in L chunks, in a ring of the devices of its
+//      task,
+//   2. all-reduces the chunk it owns, in a ring of the T devices with the same
+//      position in their task,
+//   3. all-gathers the L chunks in the ring of its task.
+// Only the 1/L of the tensor owned by each device crosses the network, and
+// the ring within a task follows the device order of the group, which the
+// param resolver derives from the link strengths of the devices.
+class HierarchicalReducer : public CollectiveImplementationInterface {
+ public:
+  HierarchicalReducer();
+  ~HierarchicalReducer() override;
+
+  // Checks that every task has the same number of devices and that the
+  // devices of a task are adjacent in the group.
+  absl::Status InitializeCollectiveParams(
+      CollectiveParams* col_params) override;
+
+  // Initializes members of CollectiveContext not yet initialized, i.e. device
+  // and device_locality.  Also saves the CollectiveContext in this object.
+  absl::Status InitializeCollectiveContext(
+      std::shared_ptr<CollectiveContext> col_ctx) override;
+
+  // Must be called in a blockable thread.
+  void Run(StatusCallback done) override;
+
+ private:
+  // Runs the three phases on the output tensor.
+  absl::Status RunPhases();
+
+  // Reduce-scatters the chunks of `ca` in `ring`, a vector of ranks that
+  // includes this device at `pos`. Afterwards this device holds the reduction
+  // of chunk (pos + 1) % ring.size().
+  absl::Status ReduceScatter(const std::string& phase,
+                             const std::vector<int>& ring, int pos,
+                             CollectiveAdapter* ca);
+
+  // All-gathers the chunks of `ca` reduced by ReduceScatter() in `ring`.
+  absl::Status AllGather(const std::string& phase,
+                         const std::vector<int>& ring, int pos,
+                         CollectiveAdapter* ca);
+
+  // Sends chunk `send_idx` of `ca` to the next device of `ring` while
+  // receiving chunk `recv_idx` from the previous one, into `recv_buf`.
+  absl::Status Exchange(const std::string& phase, int step,
+                        const std::vector<int>& ring, int pos,
+                        CollectiveAdapter* ca, int send_idx, int recv_idx,
+                        Tensor* recv_buf);
+
+  // Applies the final op of the reduction to `chunk`.
+  absl::Status Finalize(CollectiveAdapter* ca, Tensor* chunk);
+
+  std::shared_ptr<CollectiveContext> col_ctx_;
+  const CollectiveParams* col_params_;  // Not owned
+};
+
+}  // namespace tensorflow
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_HIERARCHICAL_REDUCER_H_
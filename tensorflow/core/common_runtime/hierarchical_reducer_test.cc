@@ -0,0 +1,151 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/hierarchical_reducer.h"
+
+#include <memory>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/collective_test_util.h"
+#include "tensorflow/core/common_runtime/device.h"
+#include "tensorflow/core/common_runtime/process_util.h"
+#include "tensorflow/core/framework/collective.h"
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/blocking_counter.h"
+#include "tensorflow/core/platform/refcount.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/public/version.h"
+
+namespace tensorflow {
+namespace {
+
+std::unique_ptr<OpKernel> GetBinOp(const string& op, DataType dtype,
+                                   const DeviceType& device_type,
+                                   DeviceBase* device) {
+  NodeDef node_def;
+  TF_CHECK_OK(NodeDefBuilder(strings::StrCat(op, "_node"), op)
+                  .Attr("T", dtype)
+                  .Input(FakeInput(dtype))
+                  .Input(FakeInput(dtype))
+                  .Finalize(&node_def));
+  absl::Status status;
+  std::unique_ptr<OpKernel> k = CreateOpKernel(
+      device_type, device, device->GetAllocator(AllocatorAttributes()),
+      node_def, TF_GRAPH_DEF_VERSION, &status);
+  TF_CHECK_OK(status);
+  return k;
+}
+
+class HierarchicalReducerTest : public ::testing::Test {
+ protected:
+  // Reduces a tensor of `tensor_len` floats on every device and returns the
+  // status of each device.
+  std::vector<absl::Status> Reduce(int num_workers, int num_devices,
+                                   int tensor_len, int fail_after) {
+    test_env_ = CreateCollectiveTestEnv(num_workers, num_devices, DEVICE_CPU);
+    test_env_->remote_access->set_fail_after(fail_after);
+    const int group_size = num_workers * num_devices;
+    tensors_.clear();
+    std::vector<float> expected(tensor_len);
+    for (int rank = 0; rank < group_size; ++rank) {
+      Tensor t(DT_FLOAT, TensorShape({tensor_len}));
+      for (int i = 0; i < tensor_len; ++i) {
+        t.flat<float>()(i) = rank * 10 + i;
+        expected[i] += (rank * 10 + i) / static_cast<float>(group_size);
+      }
+      tensors_.push_back(t);
+    }
+    expected_ = test::AsTensor<float>(expected);
+
+    std::vector<absl::Status> statuses(group_size);
+    BlockingCounter counter(group_size);
+    for (int rank = 0; rank < group_size; ++rank) {
+      SchedClosure([this, rank, &statuses, &counter]() {
+        auto col_params = CreateCollectiveParams(
+            *test_env_, rank, "HierarchicalReduce", REDUCTION_COLLECTIVE,
+            DT_FLOAT, tensors_[rank].shape());
+        Device* device = nullptr;
+        TF_CHECK_OK(test_env_->device_mgr->LookupDevice(
+            col_params->group.members[rank].device.name(), &device));
+        auto merge_op = GetBinOp("Add", DT_FLOAT, DEVICE_CPU, device);
+        auto final_op = GetBinOp("Div", DT_FLOAT, DEVICE_CPU, device);
+        col_params->merge_op = merge_op.get();
+        col_params->final_op = final_op.get();
+        statuses[rank] = RunCollective(test_env_.get(), col_params.get(),
+                                       device, &tensors_[rank],
+                                       &tensors_[rank]);
+        counter.DecrementCount();
+      });
+    }
+    counter.Wait();
+    return statuses;
+  }
+
+  void RunTest(int num_workers, int num_devices, int tensor_len) {
+    std::vector<absl::Status> statuses =
+        Reduce(num_workers, num_devices, tensor_len, /*fail_after=*/0);
+    for (int rank = 0; rank < statuses.size(); ++rank) {
+      TF_EXPECT_OK(statuses[rank]);
+      test::ExpectTensorNear<float>(tensors_[rank], expected_, 1e-4);
+    }
+  }
+
+  std::unique_ptr<CollectiveTestEnv> test_env_;
+  std::vector<Tensor> tensors_;
+  Tensor expected_;
+};
+
+TEST_F(HierarchicalReducerTest, TwoWorkersTwoDevices) { RunTest(2, 2, 128); }
+
+TEST_F(HierarchicalReducerTest, ThreeWorkersFourDevices) {
+  RunTest(3, 4, 1001);
+}
+
+TEST_F(HierarchicalReducerTest, SingleWorker) { RunTest(1, 4, 17); }
+
+TEST_F(HierarchicalReducerTest, SingleDevicePerWorker) { RunTest(4, 1, 33); }
+
+TEST_F(HierarchicalReducerTest, TensorSmallerThanGroup) { RunTest(2, 4, 3); }
+
+TEST_F(HierarchicalReducerTest, Failure) {
+  std::vector<absl::Status> statuses =
+      Reduce(/*num_workers=*/2, /*num_devices=*/4, /*tensor_len=*/1001,
+             /*fail_after=*/1);
+  for (const absl::Status& s : statuses) {
+    EXPECT_FALSE(s.ok());
+  }
+}
+
+TEST_F(HierarchicalReducerTest, RejectsUnevenTasks) {
+  test_env_ = CreateCollectiveTestEnv(/*num_workers=*/2,
+                                      /*num_devices_per_worker=*/2, DEVICE_CPU);
+  auto col_params =
+      CreateCollectiveParams(*test_env_, /*rank=*/0, "HierarchicalReduce",
+                             REDUCTION_COLLECTIVE, DT_FLOAT, TensorShape({8}));
+  col_params->group.members.pop_back();
+  col_params->group.group_size = 3;
+  core::RefCountPtr<HierarchicalReducer> reducer(new HierarchicalReducer());
+  EXPECT_TRUE(errors::IsInvalidArgument(
+      reducer->InitializeCollectiveParams(col_params.get())));
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -0,0 +1,180 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/huge_page_allocator.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+#include "tensorflow/core/common_runtime/bfc_allocator.h"
+#include "tensorflow/core/framework/allocator_registry.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mem.h"
+#include "tensorflow/core/platform/numa.h"
+#include "tensorflow/core/util/env_var.h"
+#include "tsl/profiler/lib/traceme.h"
+
+namespace tensorflow {
+
+namespace {
+
+size_t RoundUpTo(size_t num_bytes, size_t page_size) {
+  return (num_bytes + page_size - 1) / page_size * page_size;
+}
+
+#if defined(__linux__)
+// Maps `num_bytes` of explicitly reserved huge pages of size 1 << `page_shift`,
+// or returns nullptr if not enough are available.
+void* MapHugeTlb(size_t num_bytes, int page_shift) {
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+  void* ptr = mmap(nullptr, num_bytes, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB |
+                       (page_shift << MAP_HUGE_SHIFT),
+                   -1, 0);
+  return ptr == MAP_FAILED ? nullptr : ptr;
+#else
+  return nullptr;
+#endif
+}
+
+// Maps `num_bytes` of regular memory aligned to kHugePageSize and asks the
+// kernel to back it with transparent huge pages.
+void* MapTransparentHugePages(size_t num_bytes) {
+  constexpr size_t kAlignment = HugePageSubAllocator::kHugePageSize;
+  const size_t mapped_bytes = num_bytes + kAlignment;
+  void* mapped = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapped == MAP_FAILED) return nullptr;
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(mapped);
+  const uintptr_t aligned = RoundUpTo(begin, kAlignment);
+  // Trim the unaligned head and the unused tail so that the region can later
+  // be released with a single munmap of `num_bytes`.
+  if (aligned > begin) {
+    munmap(mapped, aligned - begin);
+  }
+  const size_t tail_bytes = mapped_bytes - (aligned - begin) - num_bytes;
+  if (tail_bytes > 0) {
+    munmap(reinterpret_cast<void*>(aligned + num_bytes), tail_bytes);
+  }
+  void* ptr = reinterpret_cast<void*>(aligned);
+#if defined(MADV_HUGEPAGE)
+  if (madvise(ptr, num_bytes, MADV_HUGEPAGE) != 0) {
+    LOG_FIRST_N(WARNING, 1) << "madvise(MADV_HUGEPAGE) failed; CPU memory "
+                            << "may not be backed by transparent huge pages.";
+  }
+#endif
+  return ptr;
+}
+#endif  // defined(__linux__)
+
+}  // namespace
+
+void* HugePageSubAllocator::Alloc(size_t alignment, size_t num_bytes,
+                                  size_t* bytes_received) {
+  tsl::profiler::TraceMe traceme("HugePageSubAllocator::Alloc");
+
+  *bytes_received = 0;
+  if (num_bytes == 0) return nullptr;
+  void* ptr = nullptr;
+  size_t region_bytes = 0;
+#if defined(__linux__)
+  if (num_bytes >= kGiganticPageSize) {
+    region_bytes = RoundUpTo(num_bytes, kGiganticPageSize);
+    ptr = MapHugeTlb(region_bytes, /*page_shift=*/30);
+  }
+  if (ptr == nullptr) {
+    region_bytes = RoundUpTo(num_bytes, kHugePageSize);
+    ptr = MapHugeTlb(region_bytes, /*page_shift=*/21);
+  }
+  if (ptr == nullptr) {
+    LOG_FIRST_N(INFO, 1) << "No reserved huge pages available, falling back "
+                         << "to transparent huge pages for CPU memory.";
+    ptr = MapTransparentHugePages(region_bytes);
+  }
+#else
+  region_bytes = num_bytes;
+  ptr = port::AlignedMalloc(region_bytes, static_cast<int>(alignment));
+#endif
+  if (ptr == nullptr) return nullptr;
+  *bytes_received = region_bytes;
+  VisitAlloc(ptr, port::kNUMANoAffinity, region_bytes);
+  return ptr;
+}
+
+void HugePageSubAllocator::Free(void* ptr, size_t num_bytes) {
+  tsl::profiler::TraceMe traceme("HugePageSubAllocator::Free");
+
+  if (ptr == nullptr || num_bytes == 0) return;
+  VisitFree(ptr, port::kNUMANoAffinity, num_bytes);
+#if defined(__linux__)
+  munmap(ptr, num_bytes);
+#else
+  port::AlignedFree(ptr);
+#endif
+}
+
+namespace {
+
+bool UseHugePageCPUAllocator() {
+  bool use_huge_pages = false;
+  absl::Status status = ReadBoolFromEnvVar("TF_CPU_ALLOCATOR_USE_HUGE_PAGES",
+                                           false, &use_huge_pages);
+  if (!status.ok()) {
+    LOG(ERROR) << "UseHugePageCPUAllocator: " << status.message();
+  }
+  return use_huge_pages;
+}
+
+class HugePageCPUAllocatorFactory : public AllocatorFactory {
+ public:
+  Allocator* CreateAllocator() override {
+    int64_t cpu_mem_limit_in_mb = -1;
+    absl::Status status = ReadInt64FromEnvVar(
+        "TF_CPU_BFC_MEM_LIMIT_IN_MB", 1LL << 16 /*64GB max by default*/,
+        &cpu_mem_limit_in_mb);
+    if (!status.ok()) {
+      LOG(ERROR) << "HugePageCPUAllocatorFactory: " << status.message();
+    }
+    BFCAllocator::Options allocator_opts;
+    allocator_opts.allow_growth = true;
+    VLOG(2) << "Using huge page backed BFCAllocator with memory limit of "
+            << cpu_mem_limit_in_mb << " MB for the CPU allocator";
+    return new BFCAllocator(
+        std::make_unique<HugePageSubAllocator>(
+            std::vector<SubAllocator::Visitor>(),
+            std::vector<SubAllocator::Visitor>()),
+        cpu_mem_limit_in_mb * (1LL << 20),
+        /*name=*/"huge_page_cpu_allocator", allocator_opts);
+  }
+
+  // Note: Ignores numa_node, for now.
+  SubAllocator* CreateSubAllocator(int numa_node) override {
+    return new HugePageSubAllocator({}, {});
+  }
+};
+
+// Takes precedence over the DefaultCPUAllocator only when requested.
+REGISTER_MEM_ALLOCATOR("HugePageCPUAllocator",
+                       UseHugePageCPUAllocator() ? 150 : 10,
+                       HugePageCPUAllocatorFactory);
+
+}  // namespace
+
+}  // namespace tensorflow
@@ -0,0 +1,66 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_HUGE_PAGE_ALLOCATOR_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_HUGE_PAGE_ALLOCATOR_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "tensorflow/core/framework/allocator.h"
+
+namespace tensorflow {
+
+// A SubAllocator that backs its regions with huge pages to reduce TLB misses
+// on large tensors.  Every region is rounded up to a whole number of huge
+// pages.  Explicitly reserved huge pages (MAP_HUGETLB) are tried first, using
+// 1GB pages for regions of at least 1GB and 2MB pages otherwise.  If none are
+// available the region falls back to 2MB aligned anonymous memory advised with
+// MADV_HUGEPAGE, so that transparent huge pages can back it.  On platforms
+// without mmap it behaves like BasicCPUAllocator.
+//
+// Regions are meant to be carved up and recycled by a BFCAllocator, which is
+// what the "HugePageCPUAllocator" factory returns when the
+// TF_CPU_ALLOCATOR_USE_HUGE_PAGES environment variable is set.
+class HugePageSubAllocator : public SubAllocator {
+ public:
+  static constexpr size_t kHugePageSize = 2 << 20;
+  static constexpr size_t kGiganticPageSize = 1 << 30;
+
+  HugePageSubAllocator(const std::vector<Visitor>& alloc_visitors,
+                       const std::vector<Visitor>& free_visitors)
+      : SubAllocator(alloc_visitors, free_visitors) {}
+
+  ~HugePageSubAllocator() override {}
+
+  void* Alloc(size_t alignment, size_t num_bytes,
+              size_t* bytes_received) override;
+
+  void Free(void* ptr, size_t num_bytes) override;
+
+  bool SupportsCoalescing() const override { return false; }
+
+  AllocatorMemoryType GetMemoryType() const override {
+    return AllocatorMemoryType::kHostPageable;
+  }
+
+ private:
+  HugePageSubAllocator(const HugePageSubAllocator&) = delete;
+  void operator=(const HugePageSubAllocator&) = delete;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_HUGE_PAGE_ALLOCATOR_H_
@@ -0,0 +1,82 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/huge_page_allocator.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/bfc_allocator.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+TEST(HugePageSubAllocatorTest, RoundsUpToHugePages) {
+  HugePageSubAllocator sub_allocator({}, {});
+  size_t bytes_received = 0;
+  void* ptr = sub_allocator.Alloc(64, 1000, &bytes_received);
+  ASSERT_NE(nullptr, ptr);
+#if defined(__linux__)
+  EXPECT_EQ(HugePageSubAllocator::kHugePageSize, bytes_received);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(ptr) %
+                   HugePageSubAllocator::kHugePageSize);
+#else
+  EXPECT_EQ(1000, bytes_received);
+#endif
+  std::memset(ptr, 1, bytes_received);
+  sub_allocator.Free(ptr, bytes_received);
+}
+
+TEST(HugePageSubAllocatorTest, CallsVisitors) {
+  int64_t bytes_visited = 0;
+  HugePageSubAllocator sub_allocator(
+      {[&bytes_visited](void*, int, size_t num_bytes) {
+        bytes_visited += num_bytes;
+      }},
+      {[&bytes_visited](void*, int, size_t num_bytes) {
+        bytes_visited -= num_bytes;
+      }});
+  size_t bytes_received = 0;
+  void* ptr = sub_allocator.Alloc(64, 3 << 20, &bytes_received);
+  ASSERT_NE(nullptr, ptr);
+  EXPECT_EQ(bytes_received, bytes_visited);
+  sub_allocator.Free(ptr, bytes_received);
+  EXPECT_EQ(0, bytes_visited);
+}
+
+TEST(HugePageSubAllocatorTest, BackingBFCAllocator) {
+  BFCAllocator::Options opts;
+  opts.allow_growth = true;
+  BFCAllocator allocator(std::make_unique<HugePageSubAllocator>(
+                             std::vector<SubAllocator::Visitor>(),
+                             std::vector<SubAllocator::Visitor>()),
+                         1LL << 30, "huge_page_test", opts);
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 16; ++i) {
+    void* ptr = allocator.AllocateRaw(64, 1024 * (i + 1));
+    ASSERT_NE(nullptr, ptr);
+    std::memset(ptr, i, 1024 * (i + 1));
+    ptrs.push_back(ptr);
+  }
+  for (void* ptr : ptrs) {
+    allocator.DeallocateRaw(ptr);
+  }
+}
+
+}  // namespace
+}  // namespace tensorflow
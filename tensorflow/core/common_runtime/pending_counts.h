@@ -99,6 +99,14 @@ class PendingCounts {
 
   ~PendingCounts() { delete[] bytes_; }
 
+  // Resets all counts to those of "other", which must have been created
+  // from the same Layout. Unlike the copy constructor, this does not
+  // allocate.
+  void CopyFrom(const PendingCounts& other) {
+    DCHECK_EQ(num_bytes_, other.num_bytes_);
+    memcpy(bytes_, other.bytes_, num_bytes_);
+  }
+
   void set_initial_count(Handle h, size_t pending_count) {
     if (h.is_large_) {
       std::atomic<LargeCounts>* c_ptr = Large(h);
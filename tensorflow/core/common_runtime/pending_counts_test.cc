@@ -80,6 +80,29 @@ TEST(PendingCounts, CopyConstructor) {
   }
 }
 
+TEST(PendingCounts, CopyFrom) {
+  const int C = 300;
+  PendingCounts::Layout layout;
+  std::vector<PendingCounts::Handle> h(C);
+  for (int id = 0; id < C; id++) {
+    h[id] = layout.CreateHandle(id, id);
+  }
+  PendingCounts initial(layout);
+  for (int id = 0; id < C; id++) {
+    initial.set_initial_count(h[id], id);
+  }
+  PendingCounts c(initial);
+  for (int id = 1; id < C; id++) {
+    c.decrement_pending(h[id], 1);
+    c.increment_dead_count(h[id]);
+  }
+  c.CopyFrom(initial);
+  for (int id = 0; id < C; id++) {
+    EXPECT_EQ(c.pending(h[id]), id);
+    EXPECT_EQ(c.dead_count(h[id]), 0);
+  }
+}
+
 TEST(PendingCounts, MarkLiveShowsUpAsCount) {
   PendingCounts::Layout layout;
   PendingCounts::Handle handles[2];
@@ -24,6 +24,7 @@ limitations under the License.
 #include <unordered_map>
 #include <utility>
 
+#include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
@@ -39,6 +40,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/optimize_function_graph_utils.h"
 #include "tensorflow/core/common_runtime/partitioning_utils.h"
 #include "tensorflow/core/common_runtime/placer.h"
+#include "tensorflow/core/common_runtime/rendezvous_mgr.h"
 #include "tensorflow/core/common_runtime/rendezvous_util.h"
 #include "tensorflow/core/common_runtime/replicate_per_replica_nodes.h"
 #include "tensorflow/core/common_runtime/single_threaded_executor.h"
@@ -58,6 +60,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/lib/gtl/map_util.h"
+#include "tensorflow/core/lib/strings/numbers.h"
 #include "tensorflow/core/platform/blocking_counter.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/notification.h"
@@ -86,6 +89,55 @@ int64_t GetParallelSubgraphThreshold() {
   return parallel_subgraph_threshold;
 }
 
+// The slots are off unless TF_PFLR_COMPONENT_RENDEZVOUS_SLOTS is true.
+bool UseComponentRendezvousSlots() {
+  static bool use_slots = []() {
+    bool result;
+    absl::Status status = tsl::ReadBoolFromEnvVar(
+        "TF_PFLR_COMPONENT_RENDEZVOUS_SLOTS", false, &result);
+    if (!status.ok()) {
+      LOG(WARNING) << status;
+      result = false;
+    }
+    return result;
+  }();
+  return use_slots;
+}
+
+// Returns a slot for each tensor passed between the component functions in
+// `subgraphs`, as the key of a send with exactly one receive, or nullptr if
+// there are none. The keys are the ones that the send and recv kernels cache
+// for the top-level frame, so the sends and recvs in loops don't match them.
+absl::StatusOr<std::shared_ptr<const RendezvousSlotTable>>
+BuildComponentRendezvousSlots(
+    const std::unordered_map<string, std::unique_ptr<Graph>>& subgraphs) {
+  absl::flat_hash_map<string, std::pair<int, int>> num_sends_and_recvs;
+  for (const auto& [target, subgraph] : subgraphs) {
+    for (const Node* n : subgraph->op_nodes()) {
+      if (!n->IsSend() && !n->IsRecv()) continue;
+      string send_device, recv_device, tensor_name;
+      int64_t send_device_incarnation;
+      TF_RETURN_IF_ERROR(GetNodeAttr(n->attrs(), "send_device", &send_device));
+      TF_RETURN_IF_ERROR(GetNodeAttr(n->attrs(), "recv_device", &recv_device));
+      TF_RETURN_IF_ERROR(GetNodeAttr(n->attrs(), "send_device_incarnation",
+                                     &send_device_incarnation));
+      TF_RETURN_IF_ERROR(GetNodeAttr(n->attrs(), "tensor_name", &tensor_name));
+      const string key = strings::StrCat(
+          send_device, ";",
+          strings::FpToString(static_cast<uint64>(send_device_incarnation)),
+          ";", recv_device, ";", tensor_name, ";0:0");
+      auto& [num_sends, num_recvs] = num_sends_and_recvs[key];
+      ++(n->IsSend() ? num_sends : num_recvs);
+    }
+  }
+  auto table = std::make_shared<RendezvousSlotTable>();
+  for (const auto& [key, counts] : num_sends_and_recvs) {
+    if (counts == std::make_pair(1, 1)) table->Add(key);
+  }
+  if (table->size() == 0) return nullptr;
+  return table;
+}
+
 }  // namespace
 
 const char ProcessFunctionLibraryRuntime::kDefaultFLRDevice[] = "null";
@@ -640,6 +692,17 @@ absl::Status ProcessFunctionLibraryRuntime::InstantiateMultiDevice(
   const int num_subgraphs = subgraphs->size();
   absl::InlinedVector<absl::Status, 4UL> instantiate_status(num_subgraphs);
 
+  // When the slots are enabled and every component runs in this process, the
+  // tensors passed between them go through the slots of a
+  // SlotIntraProcessRendezvous on each call.
+  if (UseComponentRendezvousSlots() && device_mgr_ != nullptr &&
+      absl::c_all_of(*subgraphs, [this](const auto& pair) {
+        return GetFLR(pair.first) != nullptr;
+      })) {
+    TF_ASSIGN_OR_RETURN(data->rendezvous_slots_,
+                        BuildComponentRendezvousSlots(*subgraphs));
+  }
+
   // Before instantiating component functions, determine synchronous execution.
   data->enable_sync_execution = false;
   if (options.allow_small_function_optimizations) {
@@ -758,16 +821,18 @@ absl::Status ProcessFunctionLibraryRuntime::InstantiateMultiDevice(
     }
   };
 
-  // Instantiate each component function (subgraph).
+  // Instantiate each component function (subgraph). Remote instantiations
+  // complete asynchronously, so all of them are in flight at once in both
+  // branches, and the statuses are combined once every component is done.
   //
   // NOTE: Only use thread pool to instantiate sub-function when there are
   // more than a threshold (default 8) of sub-functions. We want to avoid cost
   // of switching thread when there are only a few sub-functions. However, for
   // very large graphs, it may be necessary to increase this threshold to avoid
   // running out of memory.
+  BlockingCounter counter(static_cast<int>(num_subgraphs));
   if (default_thread_pool_ != nullptr &&
       num_subgraphs > GetParallelSubgraphThreshold()) {
-    BlockingCounter counter(static_cast<int>(num_subgraphs));
     for (auto& pair : *subgraphs) {
       absl::Status* status = &instantiate_status[i];
       ComponentFunctionData* comp_data = &data->glue_[pair.first];
@@ -782,22 +847,20 @@ absl::Status ProcessFunctionLibraryRuntime::InstantiateMultiDevice(
           });
       i += 1;
     }
-    counter.Wait();
   } else {
     for (auto& pair : *subgraphs) {
-      Notification n;
       absl::Status* status = &instantiate_status[i];
       ComponentFunctionData* comp_data = &data->glue_[pair.first];
       comp_data->name = name_generator.GetName();
       instantiate_component(pair.first, std::move(pair.second), comp_data,
-                            [&n, status](absl::Status s) {
+                            [&counter, status](absl::Status s) {
                               status->Update(s);
-                              n.Notify();
+                              counter.DecrementCount();
                             });
-      n.WaitForNotification();
       i += 1;
     }
   }
+  counter.Wait();
 
   StatusGroup group;
   for (auto& status : instantiate_status) {
@@ -940,6 +1003,12 @@ absl::Status ProcessFunctionLibraryRuntime::RunMultiDeviceSync(
   }
 
   FunctionLibraryRuntime::Options opts_copy = opts;
+  std::optional<SlotIntraProcessRendezvous> slot_rendezvous;
+  if (data->rendezvous_slots_ != nullptr && opts.rendezvous != nullptr) {
+    slot_rendezvous.emplace(device_mgr_, data->rendezvous_slots_,
+                            opts.rendezvous);
+    opts_copy.rendezvous = &*slot_rendezvous;
+  }
 
   // Sort the subgraphs topologically before execution to avoid deadlock:
   //
@@ -993,7 +1062,9 @@ absl::Status ProcessFunctionLibraryRuntime::RunMultiDeviceSync(
         const string function_and_msg = strings::StrCat(
             errors::FormatFunctionForError(data->function_name_), " ",
             run_status.message());
-        if (opts.rendezvous != nullptr) opts.rendezvous->StartAbort(run_status);
+        if (opts_copy.rendezvous != nullptr) {
+          opts_copy.rendezvous->StartAbort(run_status);
+        }
         return errors::CreateWithUpdatedMessage(run_status, function_and_msg);
       } else {
         VLOG(2) << "Component function execution succeeded.";
@@ -1047,12 +1118,25 @@ void ProcessFunctionLibraryRuntime::RunMultiDeviceAsync(
     cm = local_cm.get();
   }
 
+  // The tensors passed between the components go through the slots of a
+  // rendezvous private to this call, deleted once every component is done.
+  SlotIntraProcessRendezvous* slot_rendezvous = nullptr;
+  if (data->rendezvous_slots_ != nullptr && opts.rendezvous != nullptr) {
+    slot_rendezvous = new SlotIntraProcessRendezvous(
+        device_mgr_, data->rendezvous_slots_, opts.rendezvous);
+    done = [slot_rendezvous, done = std::move(done)](const absl::Status& s) {
+      delete slot_rendezvous;
+      done(s);
+    };
+  }
+
   auto* refcounted_done = new ReffedStatusCallback(std::move(done));
   for (int i = 0; i < data->glue_.size(); ++i) {
     refcounted_done->Ref();
   }
 
   FunctionLibraryRuntime::Options opts_copy = opts;
+  if (slot_rendezvous != nullptr) opts_copy.rendezvous = slot_rendezvous;
   for (const auto& pair : data->glue_) {
     const string& target = pair.first;
     const ComponentFunctionData& comp_data = pair.second;
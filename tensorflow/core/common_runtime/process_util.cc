@@ -26,6 +26,7 @@ limitations under the License.
 #include "tensorflow/core/platform/byte_order.h"
 #include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/strcat.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/util/util.h"
 #include "tsl/platform/tracing.h"
@@ -165,6 +166,27 @@ thread::ThreadPool* NewThreadPoolFromSessionOptions(
       /*allocator=*/nullptr);
 }
 
+thread::ThreadPool* NewNUMAThreadPoolFromSessionOptions(
+    const SessionOptions& options, int numa_node, int32_t num_threads) {
+  int32_t num_threads_real = num_threads;
+  if (num_threads_real <= 0) {
+    num_threads_real = options.config.inter_op_parallelism_threads();
+  }
+  if (num_threads_real <= 0) num_threads_real = GetEnvNumInterOpThreads();
+  if (num_threads_real <= 0) {
+    num_threads_real = port::MaxParallelism(numa_node);
+  }
+  VLOG(1) << "NUMA node " << numa_node
+          << " inter op parallelism threads: " << num_threads_real;
+  ThreadOptions thread_opts;
+  thread_opts.numa_node = numa_node;
+  return new thread::ThreadPool(
+      options.env, thread_opts, strings::StrCat("numa_", numa_node, "_Compute"),
+      num_threads_real,
+      !options.config.experimental().disable_thread_spinning(),
+      /*allocator=*/nullptr);
+}
+
 void SchedClosure(absl::AnyInvocable<void()> closure) {
   if (!tsl::tracing::EventCollector::IsEnabled()) {
     return Env::Default()->SchedClosure(std::move(closure));
@@ -51,6 +51,13 @@ int32 NumInterOpThreadsFromSessionOptions(const SessionOptions& options);
 thread::ThreadPool* NewThreadPoolFromSessionOptions(
     const SessionOptions& options, int32_t num_threads = 0);
 
+// Creates a thread pool for inter op work whose threads are bound to
+// `numa_node`. The number of threads is set if `num_threads` > 0, otherwise it
+// is configured by SessionOptions or the environment, and defaults to the
+// number of schedulable CPUs on `numa_node`.
+thread::ThreadPool* NewNUMAThreadPoolFromSessionOptions(
+    const SessionOptions& options, int numa_node, int32_t num_threads = 0);
+
 // Schedule "closure" in the default thread queue.
 void SchedClosure(absl::AnyInvocable<void()> closure);
 
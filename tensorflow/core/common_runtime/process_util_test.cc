@@ -34,5 +34,18 @@ TEST(ProcessUtilTest, ThreadPool) {
   delete pool;
 }
 
+TEST(ProcessUtilTest, NUMAThreadPool) {
+  SessionOptions opts;
+  opts.config.set_inter_op_parallelism_threads(3);
+
+  thread::ThreadPool* pool = NewNUMAThreadPoolFromSessionOptions(opts, 0);
+  EXPECT_EQ(3, pool->NumThreads());
+  delete pool;
+
+  pool = NewNUMAThreadPoolFromSessionOptions(opts, 0, /*num_threads=*/2);
+  EXPECT_EQ(2, pool->NumThreads());
+  delete pool;
+}
+
 }  // anonymous namespace
 }  // namespace tensorflow
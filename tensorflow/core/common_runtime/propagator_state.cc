@@ -27,20 +27,26 @@ namespace tensorflow {
 
 PropagatorState::PropagatorState(const ImmutableExecutorState& immutable_state,
                                  int64_t step_id, bool vlog)
+    : PropagatorState(immutable_state, step_id, vlog, /*lock_free=*/false) {}
+
+PropagatorState::PropagatorState(const ImmutableExecutorState& immutable_state,
+                                 int64_t step_id, bool vlog, bool lock_free)
     : immutable_state_(immutable_state),
       step_id_(step_id),
-      vlog_(vlog || VLOG_IS_ON(1)) {
+      vlog_(vlog || VLOG_IS_ON(1)),
+      lock_free_(lock_free) {
   // We start the entire execution in iteration 0 of the root frame
   // so let us create the root frame and the state for iteration 0.
   // We assume root_frame_->frame_name.empty().
-  root_frame_ = new FrameState(immutable_state_, 1);
+  root_frame_ =
+      new FrameState(immutable_state_, 1, &iteration_pool_, lock_free_);
   root_frame_->frame_id = 0;  // must be 0
   root_frame_->InitializeFrameInfo(immutable_state_.get_root_frame_info());
 
   // Initialize iteration 0.
   root_frame_->SetIteration(
-      0, new PropagatorState::IterationState(0, root_frame_->pending_counts,
-                                             root_frame_->total_input_tensors));
+      0, iteration_pool_.Get(0, root_frame_->pending_counts,
+                             root_frame_->total_input_tensors));
 
   outstanding_frames_.emplace(root_frame_->frame_id, root_frame_);
 }
@@ -136,6 +142,14 @@ void PropagatorState::PropagateOutputs(const TaggedNode& tagged_node,
     if (is_dead) {
       // Stop the deadness propagation.
       output_frame = nullptr;
+    } else if (lock_free_ && input_iter->next_iteration.load(
+                                 std::memory_order_acquire) != nullptr) {
+      // The next iteration has already been started, so there is no need to
+      // look it up under the frame lock.
+      output_iter = input_iter->next_iteration.load(std::memory_order_relaxed);
+      output_frame->ActivateNodesAndAdjustOutstanding(
+          item, is_dead, output_iter, outputs, ready,
+          /*decrement_activation=*/0);
     } else {
       bool need_create_iter = false;
       {
@@ -281,7 +295,8 @@ void PropagatorState::FindOrCreateChildFrame(FrameState* frame,
   }
 
   FrameState* temp =
-      new FrameState(immutable_state_, frame_info.parallel_iterations);
+      new FrameState(immutable_state_, frame_info.parallel_iterations,
+                     &iteration_pool_, lock_free_);
   temp->frame_id = child_id;
   temp->parent_frame = frame;
   temp->parent_iter = iter_state;
@@ -290,8 +305,8 @@ void PropagatorState::FindOrCreateChildFrame(FrameState* frame,
   // Initialize iteration 0.
   {
     mutex_lock l(temp->mu);
-    temp->SetIteration(0, new IterationState(0, temp->pending_counts,
-                                             temp->total_input_tensors));
+    temp->SetIteration(0, iteration_pool_.Get(0, temp->pending_counts,
+                                              temp->total_input_tensors));
   }
 
   {
@@ -332,6 +347,12 @@ void PropagatorState::DeleteFrame(FrameState* frame, TaggedNodeSeq* ready) {
       };
 
       auto propagate_to_non_merge = [&](PendingCounts::Handle dst_pending_id) {
+        if (lock_free_) {
+          return parent_iter_state
+                     ->adjust_for_activation_atomic(dst_pending_id,
+                                                    /*increment_dead=*/true)
+                     .pending_count == 0;
+        }
         parent_iter_state->increment_dead_count(dst_pending_id);
         return parent_iter_state->decrement_pending(dst_pending_id, 1) == 0;
       };
@@ -344,7 +365,13 @@ void PropagatorState::DeleteFrame(FrameState* frame, TaggedNodeSeq* ready) {
         bool dst_dead = true;
         bool dst_ready;
         // We know this is a dead input to dst.
-        if (dst_item.is_merge) {
+        if (dst_item.is_merge && lock_free_) {
+          const PendingCounts::AdjustResult adjust_result =
+              parent_iter_state->adjust_for_increment_dead_atomic(
+                  dst_pending_id);
+          dst_dead = (adjust_result.dead_count == dst_item.num_inputs);
+          dst_ready = (adjust_result.pending_count == 1) && dst_dead;
+        } else if (dst_item.is_merge) {
           parent_iter_state->increment_dead_count(dst_pending_id);
           const int dead_cnt = parent_iter_state->dead_count(dst_pending_id);
           dst_dead = (dead_cnt == dst_item.num_inputs);
@@ -364,7 +391,14 @@ void PropagatorState::DeleteFrame(FrameState* frame, TaggedNodeSeq* ready) {
         bool dst_dead;
         bool dst_ready;
         // We know this is a dead input to dst.
-        if (dst_item.is_merge) {
+        if (dst_item.is_merge && lock_free_) {
+          const PendingCounts::AdjustResult adjust_result =
+              parent_iter_state->adjust_for_decrement_pending_atomic(
+                  dst_pending_id, 2);
+          dst_dead = (adjust_result.dead_count == dst_item.num_inputs);
+          dst_ready = (adjust_result.pending_count == 0) ||
+                      ((adjust_result.pending_count == 1) && dst_dead);
+        } else if (dst_item.is_merge) {
           parent_iter_state->decrement_pending(dst_pending_id, 2);
           int count = parent_iter_state->pending(dst_pending_id);
           int dead_cnt = parent_iter_state->dead_count(dst_pending_id);
@@ -645,6 +679,16 @@ int PropagatorState::FrameState::ActivateNodesSlowPathShared(
 bool PropagatorState::FrameState::ActivateNodesAndAdjustOutstanding(
     const NodeItem* item, const bool is_dead, IterationState* iter_state,
     EntryVector* outputs, TaggedNodeSeq* ready, int decrement_activation) {
+  if (lock_free) {
+    const int activated =
+        TF_PREDICT_FALSE(item->is_any_consumer_merge_or_control_trigger)
+            ? ActivateNodesSlowPathInternal<true>(item, is_dead, iter_state,
+                                                  outputs, ready)
+            : ActivateNodesFastPathInternal<true>(item, is_dead, iter_state,
+                                                  outputs, ready);
+    return AdjustOutstandingOpsLockFree(
+        iter_state, activated - decrement_activation, ready);
+  }
   if (TF_PREDICT_FALSE(item->is_any_consumer_merge_or_control_trigger)) {
     tf_shared_lock l(mu);
     int activated =
@@ -674,9 +718,17 @@ int PropagatorState::FrameState::ActivateNodesLocked(const NodeItem* item,
                                                      EntryVector* outputs,
                                                      TaggedNodeSeq* ready) {
   if (TF_PREDICT_FALSE(item->is_any_consumer_merge_or_control_trigger)) {
+    if (lock_free) {
+      return ActivateNodesSlowPathShared(item, is_dead, iter_state, outputs,
+                                         ready);
+    }
     return ActivateNodesSlowPathLocked(item, is_dead, iter_state, outputs,
                                        ready);
   } else {
+    if (lock_free) {
+      return ActivateNodesFastPathShared(item, is_dead, iter_state, outputs,
+                                         ready);
+    }
     return ActivateNodesFastPathLocked(item, is_dead, iter_state, outputs,
                                        ready);
   }
@@ -750,11 +802,12 @@ bool PropagatorState::FrameState::IsIterationDone(IterationState* iter_state) {
 
 PropagatorState::IterationState*
 PropagatorState::FrameState::IncrementIteration(TaggedNodeSeq* ready) {
+  IterationState* prev_iter = GetIteration(iteration_count);
   iteration_count++;
 
   // Initialize the next iteration.
-  IterationState* next_iter =
-      new IterationState(iteration_count, pending_counts, total_input_tensors);
+  IterationState* next_iter = iteration_pool->Get(
+      iteration_count, pending_counts, total_input_tensors);
   SetIteration(iteration_count, next_iter);
   num_outstanding_iterations++;
   {
@@ -768,6 +821,9 @@ PropagatorState::FrameState::IncrementIteration(TaggedNodeSeq* ready) {
   // Activate the loop invariants in the new iteration.
   ActivateLoopInvs(next_iter, ready);
 
+  if (prev_iter != nullptr) {
+    prev_iter->next_iteration.store(next_iter, std::memory_order_release);
+  }
   return next_iter;
 }
 
@@ -775,7 +831,7 @@ bool PropagatorState::FrameState::CleanupIterations(IterationState* iter_state,
                                                     TaggedNodeSeq* ready) {
   int64_t curr_iter = iter_state->iter_num;
   while (curr_iter <= iteration_count && IsIterationDone(iter_state)) {
-    delete iter_state;
+    iteration_pool->Release(iter_state);
     SetIteration(curr_iter, nullptr);
     --num_outstanding_iterations;
     ++curr_iter;
@@ -798,6 +854,38 @@ bool PropagatorState::FrameState::CleanupIterations(IterationState* iter_state,
   return IsFrameDone();
 }
 
+PropagatorState::IterationStatePool::~IterationStatePool() {
+  for (auto& it : free_iterations_) {
+    for (IterationState* iter_state : it.second) {
+      delete iter_state;
+    }
+  }
+}
+
+PropagatorState::IterationState* PropagatorState::IterationStatePool::Get(
+    int64_t iter_num, const PendingCounts* pending_counts,
+    int total_input_tensors) {
+  {
+    mutex_lock l(mu_);
+    auto it = free_iterations_.find(pending_counts);
+    if (it != free_iterations_.end() && !it->second.empty()) {
+      IterationState* iter_state = it->second.back();
+      it->second.pop_back();
+      DCHECK_EQ(iter_state->num_input_tensors, total_input_tensors);
+      iter_state->iter_num = iter_num;
+      return iter_state;
+    }
+  }
+  return new IterationState(iter_num, pending_counts, total_input_tensors);
+}
+
+void PropagatorState::IterationStatePool::Release(IterationState* iter_state) {
+  // Reset outside the lock, since this may release tensors.
+  iter_state->Reset();
+  mutex_lock l(mu_);
+  free_iterations_[iter_state->initial_counts].push_back(iter_state);
+}
+
 void PropagatorState::FrameState::InitializeFrameInfo(
     const ImmutableExecutorState::FrameInfo& finfo) {
   pending_counts = finfo.pending_counts.get();
@@ -850,6 +938,9 @@ bool PropagatorState::FrameState::AdjustOutstandingOps(
   if (delta == 0) {
     return false;
   }
+  if (lock_free) {
+    return AdjustOutstandingOpsLockFree(iter_state, delta, ready);
+  }
   {
     tf_shared_lock sl(mu);
     if (TF_PREDICT_TRUE(!AdjustOutstandingOpsFastPath(iter_state, delta))) {
@@ -867,6 +958,28 @@ bool PropagatorState::FrameState::AdjustOutstandingOpsFastPath(
   return (old_val + delta == 0) && IsIterationDone(iter_state);
 }
 
+bool PropagatorState::FrameState::AdjustOutstandingOpsLockFree(
+    IterationState* iter_state, int delta, TaggedNodeSeq* ready) {
+  DCHECK(lock_free);
+  if (delta == 0) {
+    return false;
+  }
+  // Only the adjustment that brings the count to zero is made under the lock.
+  // Until then this thread holds on to the iteration, so it cannot be cleaned
+  // up by another thread.
+  size_t old_val = iter_state->outstanding_ops.load(std::memory_order_relaxed);
+  while (old_val + delta != 0) {
+    if (iter_state->outstanding_ops.compare_exchange_weak(
+            old_val, old_val + delta, std::memory_order_acq_rel,
+            std::memory_order_relaxed)) {
+      return false;
+    }
+  }
+  mutex_lock l(mu);
+  iter_state->outstanding_ops.fetch_add(delta, std::memory_order_acq_rel);
+  return CleanupIterations(iter_state, ready);
+}
+
 // Decrement the outstanding op count and clean up the iterations in the
 // frame. Return true iff the execution of the frame is done.
 bool PropagatorState::FrameState::DecrementOutstandingOpsLocked(
@@ -877,13 +990,21 @@ bool PropagatorState::FrameState::DecrementOutstandingOpsLocked(
 
 bool PropagatorState::FrameState::AdjustOutstandingOpsLocked(
     IterationState* iter_state, int delta, TaggedNodeSeq* ready) {
-  // We hold the lock, so we don't need to use an atomic modification.
-  auto cur_val = iter_state->outstanding_ops.load(std::memory_order_relaxed);
-  DCHECK(delta >= 0 || cur_val >= -delta)
-      << "cannot adjust outstanding_ops by " << delta
-      << " when current value is " << cur_val;
-  auto new_val = cur_val + delta;
-  iter_state->outstanding_ops.store(new_val, std::memory_order_relaxed);
+  size_t new_val;
+  if (lock_free) {
+    // Other threads may adjust the count without holding the lock.
+    new_val = iter_state->outstanding_ops.fetch_add(
+                  delta, std::memory_order_acq_rel) +
+              delta;
+  } else {
+    // We hold the lock, so we don't need to use an atomic modification.
+    auto cur_val = iter_state->outstanding_ops.load(std::memory_order_relaxed);
+    DCHECK(delta >= 0 || cur_val >= -delta)
+        << "cannot adjust outstanding_ops by " << delta
+        << " when current value is " << cur_val;
+    new_val = cur_val + delta;
+    iter_state->outstanding_ops.store(new_val, std::memory_order_relaxed);
+  }
   if (new_val != 0) {
     return false;
   }
@@ -15,9 +15,11 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_COMMON_RUNTIME_PROPAGATOR_STATE_H_
 #define TENSORFLOW_CORE_COMMON_RUNTIME_PROPAGATOR_STATE_H_
 
+#include <atomic>
 #include <queue>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "tensorflow/core/common_runtime/entry.h"
 #include "tensorflow/core/common_runtime/immutable_executor_state.h"
 #include "tensorflow/core/common_runtime/pending_counts.h"
@@ -50,6 +52,13 @@ class PropagatorState {
                   int64_t step_id, bool vlog);
   ~PropagatorState();
 
+ protected:
+  // If `lock_free` is true, all pending and dead counts are updated with
+  // atomic operations, and the frame lock is only acquired when frames or
+  // iterations are created or completed. See `LockFreePropagatorState`.
+  PropagatorState(const ImmutableExecutorState& immutable_state,
+                  int64_t step_id, bool vlog, bool lock_free);
+
  private:
   // Forward declaration so that `TaggedNode` can include a `FrameState*` and an
   // `IterationState*`.
@@ -132,11 +141,14 @@ class PropagatorState {
           input_tensors(new Entry[total_input_tensors]),
           outstanding_ops(0),
           outstanding_frame_count(0),
+          initial_counts(pending_counts),
+          num_input_tensors(total_input_tensors),
           counts(*pending_counts) {  // Initialize with copy of *pending_counts
     }
 
-    const int64_t
-        iter_num;  // The index of this iteration in the enclosing loop.
+    // The index of this iteration in the enclosing loop. Only modified when
+    // a done iteration is recycled by an `IterationStatePool`.
+    int64_t iter_num;
 
     // One copy per iteration. For iteration k, i-th node's j-th input is in
     // input_tensors[k][immutable_state_.nodes[i].input_start + j]. An entry is
@@ -206,16 +218,71 @@ class PropagatorState {
       return counts.adjust_for_activation_atomic(h, increment_dead);
     }
 
+    // Returns this (done) iteration to the state of a newly created one,
+    // releasing any remaining input tensors, so that it can be reused for
+    // another iteration of a frame with the same static information.
+    void Reset() {
+      for (int i = 0; i < num_input_tensors; ++i) {
+        input_tensors[i].ClearVal();
+      }
+      outstanding_ops = 0;
+      outstanding_frame_count = 0;
+      next_iteration.store(nullptr, std::memory_order_relaxed);
+      counts.CopyFrom(*initial_counts);
+    }
+
     ~IterationState() { delete[] input_tensors; }
 
+    // The next iteration of the same frame, once it has been started. Since
+    // an iteration is not done before its predecessor, the next iteration
+    // stays valid while this one is live.
+    std::atomic<IterationState*> next_iteration{nullptr};
+
+    // The static pending counts and number of inputs of the frame that this
+    // iteration was created for.
+    const PendingCounts* const initial_counts;
+    const int num_input_tensors;
+
    private:
     PendingCounts counts;
   };
 
+  // Recycles the `IterationState` objects of a step. Starting an iteration of
+  // a loop would otherwise allocate its state, input tensors and pending
+  // counts, which are all freed again when the iteration is done. Since all
+  // iterations of a frame have the same layout, a done iteration is kept in
+  // this pool and handed out again for the next iteration of a frame with the
+  // same static information. The pool holds at most as many objects as were
+  // live at the same time, and frees them when the step is done.
+  class IterationStatePool {
+   public:
+    IterationStatePool() = default;
+    ~IterationStatePool();
+
+    // Returns a new or recycled iteration state for iteration `iter_num` of
+    // a frame with the given static information.
+    IterationState* Get(int64_t iter_num, const PendingCounts* pending_counts,
+                        int total_input_tensors);
+
+    // Takes ownership of `iter_state`, which must be done.
+    void Release(IterationState* iter_state);
+
+   private:
+    mutex mu_;
+    absl::flat_hash_map<const PendingCounts*, std::vector<IterationState*>>
+        free_iterations_ TF_GUARDED_BY(mu_);
+
+    IterationStatePool(const IterationStatePool&) = delete;
+    void operator=(const IterationStatePool&) = delete;
+  };
+
   struct FrameState {
     explicit FrameState(const ImmutableExecutorState& immutable_state,
-                        int parallel_iters)
+                        int parallel_iters, IterationStatePool* iteration_pool,
+                        bool lock_free)
         : immutable_state(immutable_state),
+          iteration_pool(iteration_pool),
+          lock_free(lock_free),
           max_parallel_iterations(parallel_iters),
           num_outstanding_iterations(1),
           iterations(parallel_iters + 1),
@@ -252,6 +319,15 @@ class PropagatorState {
     // The immutable state of the executor the frame is in.
     const ImmutableExecutorState& immutable_state;
 
+    // Allocates the iteration states of this frame. Not owned.
+    IterationStatePool* const iteration_pool;
+
+    // True if this frame belongs to a `LockFreePropagatorState`. Then even
+    // the methods that hold `mu` in exclusive mode must update pending counts
+    // and outstanding ops atomically, because other threads update them
+    // without holding `mu`.
+    const bool lock_free;
+
     // The name of this frame, which is the concatenation of its parent
     // frame name, the iteration of the parent frame when this frame was
     // created, and the value of the attr 'frame_name'.
@@ -348,6 +424,14 @@ class PropagatorState {
     bool AdjustOutstandingOpsFastPath(IterationState* iter_state, int delta)
         TF_SHARED_LOCKS_REQUIRED(mu);
 
+    // Like `AdjustOutstandingOps()`, but only acquires `mu` if the adjustment
+    // may complete the iteration, which is safe because neither the iteration
+    // nor the frame can be deleted while the count is non-zero.
+    // REQUIRES: `lock_free`.
+    bool AdjustOutstandingOpsLockFree(IterationState* iter_state, int delta,
+                                      TaggedNodeSeq* ready)
+        TF_LOCKS_EXCLUDED(mu);
+
     // Convenience methods for the above 'Adjust' calls where delta takes the
     // common value of -1.
     bool DecrementOutstandingOps(IterationState* iter_state,
@@ -387,7 +471,8 @@ class PropagatorState {
     //
     // In the case that 'item' is a simple node (no merge/control outputs) this
     // will acquire a shared lock and can run concurrently with other
-    // invocations.
+    // invocations. If `lock_free` is true, no lock is acquired unless the
+    // iteration is done.
     //
     // Return true if the frame is done after activation.
     bool ActivateNodesAndAdjustOutstanding(
@@ -416,8 +501,10 @@ class PropagatorState {
 
     ~FrameState() {
       for (size_t i = 0; i < iterations.size(); ++i) {
-        delete iterations[i];
-        iterations[i] = nullptr;
+        if (iterations[i] != nullptr) {
+          iteration_pool->Release(iterations[i]);
+          iterations[i] = nullptr;
+        }
       }
     }
 
@@ -492,10 +579,14 @@ class PropagatorState {
   void DumpState();
 
   // For debugging/logging only.
+  //
+  // The node states are updated non-atomically, so they are not tracked by a
+  // lock-free propagator, which changes pending counts without holding the
+  // frame lock.
   void MaybeMarkStarted(const TaggedNode& tagged_node) {
     // TODO(misard) Replace with a finer-grain enabling flag once we add better
     // optional debugging support.
-    if (TF_PREDICT_FALSE(vlog_) && VLOG_IS_ON(1)) {
+    if (TF_PREDICT_FALSE(vlog_) && !lock_free_ && VLOG_IS_ON(1)) {
       mutex_lock l(tagged_node.input_frame->mu);
       tagged_node.input_iter->mark_started(
           immutable_state_.pending_ids()[tagged_node.node_item->node_id]);
@@ -505,7 +596,7 @@ class PropagatorState {
   void MaybeMarkCompleted(const TaggedNode& tagged_node) {
     // TODO(misard) Replace with a finer-grain enabling flag once we add better
     // optional debugging support.
-    if (TF_PREDICT_FALSE(vlog_) && VLOG_IS_ON(1)) {
+    if (TF_PREDICT_FALSE(vlog_) && !lock_free_ && VLOG_IS_ON(1)) {
       mutex_lock l(tagged_node.input_frame->mu);
       tagged_node.input_iter->mark_completed(
           immutable_state_.pending_ids()[tagged_node.node_item->node_id]);
@@ -532,6 +623,11 @@ class PropagatorState {
   const ImmutableExecutorState& immutable_state_;
   const int64_t step_id_;
   const bool vlog_;
+  const bool lock_free_;
+
+  // Owns the iteration states of all frames of this step. Must outlive the
+  // frames.
+  IterationStatePool iteration_pool_;
 
   mutex mu_;
 
@@ -554,6 +650,25 @@ inline int64_t PropagatorState::TaggedNode::get_iter_num() const {
   return input_iter->iter_num;
 }
 
+// `LockFreePropagatorState` is a `PropagatorState` for steps that run wide
+// loop bodies with many parallel iterations, where the frame lock taken when
+// propagating each output becomes contended. Pending and dead counts are
+// always updated with atomic operations, so propagating the outputs of a node
+// within an iteration, into the next iteration once it has been started
+// (through `IterationState::next_iteration`), or out of a frame does not
+// acquire the frame lock. The lock is still acquired to create and delete
+// frames, to start and complete iterations, and for `Enter` nodes and dead
+// `Exit` nodes.
+//
+// This propagator is used by the executor selected with the
+// "LOCK_FREE_PROPAGATOR" executor type.
+class LockFreePropagatorState : public PropagatorState {
+ public:
+  LockFreePropagatorState(const ImmutableExecutorState& immutable_state,
+                          int64_t step_id, bool vlog)
+      : PropagatorState(immutable_state, step_id, vlog, /*lock_free=*/true) {}
+};
+
 // `OrderedPropagatorState` replaces `PropagatorState`s `TaggedNodeReadyQueue`
 // with a priority queue. This ensures that the order in which we dequeue
 // `TaggedNode&`s is stable with respect to ASLR.
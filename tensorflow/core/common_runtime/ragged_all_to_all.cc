@@ -0,0 +1,181 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/ragged_all_to_all.h"
+
+#include <utility>
+
+#include "tensorflow/core/common_runtime/collective_util.h"
+#include "tensorflow/core/common_runtime/device.h"
+#include "tensorflow/core/common_runtime/device_mgr.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+namespace {
+
+// Checks that `sizes` is a vector of `group_size` non-negative chunk sizes
+// that add up to `num_rows`.
+absl::Status ValidateChunkSizes(const Tensor& sizes, const char* name,
+                                int group_size, int64_t num_rows,
+                                const char* tensor_name) {
+  if (sizes.dtype() != DT_INT64 || sizes.dims() != 1 ||
+      sizes.dim_size(0) != group_size) {
+    return errors::InvalidArgument(
+        "ragged all-to-all ", name, " must be an int64 vector of the group ",
+        "size (", group_size, "), got ", DataTypeString(sizes.dtype()), " ",
+        sizes.shape().DebugString());
+  }
+  int64_t total = 0;
+  for (int64_t size : sizes.vec<int64_t>()) {
+    if (size < 0) {
+      return errors::InvalidArgument("ragged all-to-all ", name,
+                                     " must be non-negative, got ", size);
+    }
+    total += size;
+  }
+  if (total != num_rows) {
+    return errors::InvalidArgument(
+        "ragged all-to-all ", name, " add up to ", total, " but the ",
+        tensor_name, " first dimension size is ", num_rows);
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+RaggedAllToAll::RaggedAllToAll()
+    : col_ctx_(nullptr), col_params_(nullptr), done_(nullptr), pending_(0) {}
+
+absl::Status RaggedAllToAll::InitializeCollectiveContext(
+    std::shared_ptr<CollectiveContext> col_ctx) {
+  const int group_size = col_ctx->col_params->group.group_size;
+  OpKernelContext* op_ctx = col_ctx->op_ctx;
+  if (op_ctx->num_inputs() < 3) {
+    return errors::InvalidArgument(
+        "ragged all-to-all expects the send and receive sizes as inputs 1 and "
+        "2, got ",
+        op_ctx->num_inputs(), " inputs");
+  }
+  if (col_ctx->input->dims() < 1 || col_ctx->output->dims() < 1) {
+    return errors::InvalidArgument(
+        "input and output to ragged all-to-all must have at least one "
+        "dimension, got ",
+        col_ctx->input->shape().DebugString(), " and ",
+        col_ctx->output->shape().DebugString());
+  }
+  TF_RETURN_IF_ERROR(ValidateChunkSizes(op_ctx->input(1), "send sizes",
+                                        group_size,
+                                        col_ctx->input->dim_size(0), "input"));
+  TF_RETURN_IF_ERROR(ValidateChunkSizes(
+      op_ctx->input(2), "receive sizes", group_size,
+      col_ctx->output->dim_size(0), "output"));
+  DCHECK(col_ctx->dev_mgr);
+  col_ctx_ = col_ctx;
+  col_params_ = col_ctx->col_params.get();
+  return collective_util::InitializeDeviceAndLocality(
+      col_ctx->dev_mgr, col_ctx->device_name, &col_ctx->device,
+      &col_ctx->device_locality);
+}
+
+void RaggedAllToAll::Run(StatusCallback done) {
+  done_ = std::move(done);
+  const int group_size = col_params_->group.group_size;
+  const int default_rank = col_params_->default_rank;
+  auto send_sizes = col_ctx_->op_ctx->input(1).vec<int64_t>();
+  auto recv_sizes = col_ctx_->op_ctx->input(2).vec<int64_t>();
+  input_chunks_.reserve(group_size);
+  output_chunks_.reserve(group_size);
+  int64_t input_offset = 0;
+  int64_t output_offset = 0;
+  int num_transfers = 0;
+  for (int i = 0; i < group_size; ++i) {
+    input_chunks_.push_back(col_ctx_->input->Slice(
+        input_offset, input_offset + send_sizes(i)));
+    input_offset += send_sizes(i);
+    output_chunks_.push_back(col_ctx_->output->Slice(
+        output_offset, output_offset + recv_sizes(i)));
+    output_offset += recv_sizes(i);
+    // Empty chunks are skipped on both sides, which relies on the receive
+    // sizes matching the send sizes of the peers.
+    if (send_sizes(i) > 0) ++num_transfers;
+    if (recv_sizes(i) > 0) ++num_transfers;
+  }
+  if (num_transfers == 0) {
+    done_(absl::OkStatus());
+    return;
+  }
+  {
+    mutex_lock l(mu_);
+    pending_ = num_transfers;
+  }
+  auto transfer_done = [this](const absl::Status& s) { OnTransferDone(s); };
+  for (int i = 0; i < group_size; ++i) {
+    if (send_sizes(i) > 0) {
+      DispatchSend(default_rank, i, &input_chunks_[i], transfer_done);
+    }
+    if (recv_sizes(i) > 0) {
+      DispatchRecv(i, default_rank, &output_chunks_[i], transfer_done);
+    }
+  }
+}
+
+void RaggedAllToAll::OnTransferDone(const absl::Status& s) {
+  absl::Status final_status;
+  {
+    mutex_lock l(mu_);
+    status_.Update(s);
+    if (--pending_ > 0) {
+      return;
+    }
+    final_status = status_;
+  }
+  done_(final_status);
+}
+
+void RaggedAllToAll::DispatchSend(int src_rank, int target_rank,
+                                  const Tensor* tensor,
+                                  const StatusCallback& done) {
+  string send_buf_key =
+      strings::StrCat(col_ctx_->exec_key, ":", src_rank, ":", target_rank);
+  col_ctx_->col_exec->remote_access()->PostToPeer(
+      col_params_->group.members[target_rank].device.name(),
+      col_params_->group.members[target_rank].task, send_buf_key,
+      col_ctx_->device, col_ctx_->op_ctx->op_device_context(),
+      col_ctx_->op_ctx->input_alloc_attr(0), tensor, col_ctx_->device_locality,
+      col_ctx_->op_ctx->cancellation_manager(), done);
+}
+
+void RaggedAllToAll::DispatchRecv(int src_rank, int target_rank, Tensor* tensor,
+                                  const StatusCallback& done) {
+  string recv_buf_key =
+      strings::StrCat(col_ctx_->exec_key, ":", src_rank, ":", target_rank);
+  col_ctx_->col_exec->remote_access()->RecvFromPeer(
+      col_params_->group.members[src_rank].device.name(),
+      col_params_->group.members[src_rank].task,
+      col_params_->group.members[src_rank].is_local, recv_buf_key,
+      col_ctx_->device, col_ctx_->op_ctx->op_device_context(),
+      col_ctx_->op_ctx->output_alloc_attr(0), tensor, col_ctx_->device_locality,
+      0, col_ctx_->op_ctx->cancellation_manager(), done);
+}
+
+namespace {
+REGISTER_COLLECTIVE(RaggedAllToAll, RaggedAllToAll);
+}  // namespace
+
+}  // namespace tensorflow
@@ -0,0 +1,77 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_RAGGED_ALL_TO_ALL_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_RAGGED_ALL_TO_ALL_H_
+
+#include <memory>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/base_collective_executor.h"
+#include "tensorflow/core/framework/collective.h"
+#include "tensorflow/core/framework/device.h"
+
+namespace tensorflow {
+
+// Implementation of collective all-to-all with chunks of different sizes, as
+// needed to exchange the ids and embeddings of sharded embedding lookups.
+//
+// The op inputs 1 and 2 are the int64 vectors `send_sizes` and `recv_sizes`,
+// with one element per group member. Member i sends `send_sizes[j]` rows of
+// its input, following the rows it sends to the members before j, to member
+// j. It receives `recv_sizes[j]` rows from member j into its output, in the
+// order of the members. `recv_sizes[j]` of member i must be `send_sizes[i]`
+// of member j, e.g. by exchanging the send sizes with a dense all-to-all
+// first, and the output must have `sum(recv_sizes)` rows.
+class RaggedAllToAll : public CollectiveImplementationInterface {
+ public:
+  RaggedAllToAll();
+
+  void Run(StatusCallback done) override;
+
+  absl::Status InitializeCollectiveParams(
+      CollectiveParams* col_params) override {
+    return absl::OkStatus();
+  }
+
+  // Initializes members of CollectiveContext not yet initialized, i.e. device
+  // and device_locality, and checks the chunk sizes.  Also saves the
+  // CollectiveContext in this object.
+  absl::Status InitializeCollectiveContext(
+      std::shared_ptr<CollectiveContext> col_ctx) override;
+
+ private:
+  std::shared_ptr<CollectiveContext> col_ctx_;
+  const CollectiveParams* col_params_;  // Not owned
+  // The chunks must outlive the transfers.
+  std::vector<Tensor> input_chunks_;
+  std::vector<Tensor> output_chunks_;
+  StatusCallback done_;
+  mutex mu_;
+  absl::Status status_ TF_GUARDED_BY(mu_);
+  int pending_ TF_GUARDED_BY(mu_);
+
+  void DispatchSend(int src_rank, int target_rank, const Tensor* tensor,
+                    const StatusCallback& done);
+
+  void DispatchRecv(int src_rank, int target_rank, Tensor* tensor,
+                    const StatusCallback& done);
+
+  // Called when a send or receive completes. Invokes done_ once all of them
+  // have completed.
+  void OnTransferDone(const absl::Status& s);
+};
+
+}  // namespace tensorflow
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_RAGGED_ALL_TO_ALL_H_
@@ -0,0 +1,150 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/ragged_all_to_all.h"
+
+#include <memory>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/collective_test_util.h"
+#include "tensorflow/core/common_runtime/process_util.h"
+#include "tensorflow/core/framework/collective.h"
+#include "tensorflow/core/framework/device.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/lib/core/notification.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/blocking_counter.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+class RaggedAllToAllTest : public ::testing::Test {
+ protected:
+  // Like RunCollective, but also feeds the send and receive sizes as the op
+  // inputs 1 and 2. Only supports CPU devices.
+  absl::Status RunRaggedAllToAll(CollectiveParams* col_params, Device* device,
+                                 Tensor* input, Tensor send_sizes,
+                                 Tensor recv_sizes, Tensor* output) {
+    OpKernelContext::Params op_params;
+    CancellationManager cancellation_manager;
+    op_params.step_id = kStepId;
+    op_params.device = device;
+    op_params.cancellation_manager = &cancellation_manager;
+    absl::InlinedVector<TensorValue, 4UL> inputs = {
+        TensorValue(input), TensorValue(&send_sizes), TensorValue(&recv_sizes)};
+    op_params.inputs = inputs;
+    absl::InlinedVector<AllocatorAttributes, 4UL> input_aa(3);
+    op_params.input_alloc_attrs = input_aa;
+    DeviceContext* dev_ctx = new DeviceContext;
+    core::ScopedUnref unref_dev_ctx(dev_ctx);
+    op_params.op_device_context = dev_ctx;
+    AllocatorAttributes generic_alloc_attr;
+    op_params.output_attr_array = &generic_alloc_attr;
+    op_params.resource_manager = device->resource_manager();
+    OpKernelContext ctx(&op_params, 1);
+
+    CollectiveImplementationInterface* collective_impl = nullptr;
+    TF_CHECK_OK(CollectiveRegistry::Lookup("RaggedAllToAll", &collective_impl));
+    core::ScopedUnref unref_collective_impl(collective_impl);
+    TF_RETURN_IF_ERROR(collective_impl->InitializeCollectiveParams(col_params));
+    string exec_key =
+        strings::StrCat(col_params->instance.instance_key, ":0:0");
+    auto col_ctx = std::make_shared<CollectiveContext>(
+        test_env_->col_exec.get(), test_env_->nccl_communicator.get(),
+        test_env_->device_mgr.get(), &ctx, &op_params, col_params, exec_key,
+        kStepId, input, output);
+    TF_RETURN_IF_ERROR(collective_impl->InitializeCollectiveContext(col_ctx));
+
+    absl::Status status;
+    Notification n;
+    collective_impl->Run([&status, &n](absl::Status s) {
+      status = s;
+      n.Notify();
+    });
+    n.WaitForNotification();
+    return status;
+  }
+
+  static constexpr int64_t kStepId = 10;
+  std::unique_ptr<CollectiveTestEnv> test_env_;
+};
+
+TEST_F(RaggedAllToAllTest, Success) {
+  test_env_ = CreateCollectiveTestEnv(/*num_workers*/ 1,
+                                      /*num_devices_per_worker*/ 3, DEVICE_CPU);
+  // send_sizes[i][j] is the number of rows that member i sends to member j.
+  const std::vector<std::vector<int64_t>> send_sizes = {
+      {1, 2, 0}, {0, 0, 1}, {2, 1, 1}};
+  std::vector<Tensor> inputs = {
+      test::AsTensor<float>({1, 2, 3, 4, 5, 6}, {3, 2}),
+      test::AsTensor<float>({7, 8}, {1, 2}),
+      test::AsTensor<float>({9, 10, 11, 12, 13, 14, 15, 16}, {4, 2}),
+  };
+  std::vector<Tensor> outputs = {
+      Tensor(DT_FLOAT, TensorShape({3, 2})),
+      Tensor(DT_FLOAT, TensorShape({3, 2})),
+      Tensor(DT_FLOAT, TensorShape({2, 2})),
+  };
+  BlockingCounter counter(3);
+  for (int i = 0; i < 3; ++i) {
+    SchedClosure([this, &send_sizes, &inputs, &outputs, i, &counter]() {
+      std::vector<int64_t> recv_sizes;
+      for (int j = 0; j < 3; ++j) recv_sizes.push_back(send_sizes[j][i]);
+      // The instance shape only needs to agree across the members.
+      auto col_params = CreateCollectiveParams(
+          *test_env_, i, "RaggedAllToAll", RAGGED_ALL_TO_ALL_COLLECTIVE,
+          DT_FLOAT, TensorShape({3}));
+      Device* device = nullptr;
+      TF_CHECK_OK(test_env_->device_mgr->LookupDevice(
+          col_params->group.members[i].device.name(), &device));
+      TF_CHECK_OK(RunRaggedAllToAll(col_params.get(), device, &inputs[i],
+                                    test::AsTensor<int64_t>(send_sizes[i]),
+                                    test::AsTensor<int64_t>(recv_sizes),
+                                    &outputs[i]));
+      counter.DecrementCount();
+    });
+  }
+  counter.Wait();
+  test::ExpectTensorEqual<float>(
+      outputs[0], test::AsTensor<float>({1, 2, 9, 10, 11, 12}, {3, 2}));
+  test::ExpectTensorEqual<float>(
+      outputs[1], test::AsTensor<float>({3, 4, 5, 6, 13, 14}, {3, 2}));
+  test::ExpectTensorEqual<float>(
+      outputs[2], test::AsTensor<float>({7, 8, 15, 16}, {2, 2}));
+}
+
+TEST_F(RaggedAllToAllTest, MismatchedSendSizes) {
+  test_env_ = CreateCollectiveTestEnv(/*num_workers*/ 1,
+                                      /*num_devices_per_worker*/ 2, DEVICE_CPU);
+  auto col_params = CreateCollectiveParams(
+      *test_env_, 0, "RaggedAllToAll", RAGGED_ALL_TO_ALL_COLLECTIVE, DT_FLOAT,
+      TensorShape({2}));
+  Device* device = nullptr;
+  TF_CHECK_OK(test_env_->device_mgr->LookupDevice(
+      col_params->group.members[0].device.name(), &device));
+  Tensor input = test::AsTensor<float>({1, 2, 3});
+  Tensor output(DT_FLOAT, TensorShape({2}));
+  absl::Status status = RunRaggedAllToAll(
+      col_params.get(), device, &input, test::AsTensor<int64_t>({1, 1}),
+      test::AsTensor<int64_t>({1, 1}), &output);
+  EXPECT_TRUE(errors::IsInvalidArgument(status)) << status;
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -15,12 +15,18 @@ limitations under the License.
 
 #include "tensorflow/core/common_runtime/rendezvous_mgr.h"
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <unordered_set>
+#include <utility>
 
+#include "absl/strings/string_view.h"
 #include "tensorflow/core/common_runtime/copy_tensor.h"
 #include "tensorflow/core/common_runtime/device.h"
 #include "tensorflow/core/common_runtime/device_mgr.h"
 #include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/framework/cancellation.h"
 #include "tensorflow/core/framework/device_factory.h"
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/lib/core/errors.h"
@@ -29,6 +35,7 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/str_util.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/profiler/lib/scoped_memory_debug_annotation.h"
 
@@ -129,6 +136,34 @@ void SameWorkerRecvDone(const DeviceMgr* device_mgr,
       out, 0 /*dev_to_dev_stream_index*/, std::move(done), sync_dst_compute);
 }
 
+// Hands the tensor `in` received under `parsed` to `done`, copying it to the
+// receiving device if needed.
+void FinishIntraProcessRecv(const DeviceMgr* device_mgr,
+                            const Rendezvous::ParsedKey& parsed,
+                            const absl::Status& status,
+                            const Rendezvous::Args& send_args,
+                            const Rendezvous::Args& recv_args, const Tensor& in,
+                            bool is_dead,
+                            RendezvousInterface::DoneCallback done) {
+  // If "in" is an uninitialized tensor, do copy-construction to
+  // preserve the uninitialized state, along with data type and shape
+  // info, which is useful for debugger purposes.
+  Tensor* out = in.IsInitialized() ? new Tensor : new Tensor(in);
+
+  auto final_callback = [send_args, recv_args, out, is_dead,
+                         done = std::move(done)](const absl::Status& s) {
+    done(s, send_args, recv_args, *out, is_dead);
+    delete out;
+  };
+
+  if (status.ok() && in.IsInitialized()) {
+    SameWorkerRecvDone(device_mgr, parsed, send_args, recv_args, in, out,
+                       std::move(final_callback));
+  } else {
+    final_callback(status);
+  }
+}
+
 void IntraProcessRecvAsyncImpl(const DeviceMgr* device_mgr,
                                LocalRendezvous* local,
                                const RendezvousInterface::ParsedKey& parsed,
@@ -144,26 +179,25 @@ void IntraProcessRecvAsyncImpl(const DeviceMgr* device_mgr,
           const absl::Status& status, const Rendezvous::Args& send_args,
           const Rendezvous::Args& recv_args, const Tensor& in,
           bool is_dead) mutable {
-        // If "in" is an uninitialized tensor, do copy-construction to
-        // preserve the uninitialized state, along with data type and shape
-        // info, which is useful for debugger purposes.
-        Tensor* out = in.IsInitialized() ? new Tensor : new Tensor(in);
-
-        auto final_callback = [send_args, recv_args, out, is_dead,
-                               done = std::move(done)](const absl::Status& s) {
-          done(s, send_args, recv_args, *out, is_dead);
-          delete out;
-        };
-
-        if (status.ok() && in.IsInitialized()) {
-          SameWorkerRecvDone(device_mgr, parsed, send_args, recv_args, in, out,
-                             std::move(final_callback));
-        } else {
-          final_callback(status);
-        }
+        FinishIntraProcessRecv(device_mgr, parsed, status, send_args,
+                               recv_args, in, is_dead, std::move(done));
       });
 }
 
+// The state bits of a slot of a SlotIntraProcessRendezvous. Each bit is set
+// at most once, and the waiter of a slot is called by whoever sets the bit
+// that completes kRecvWaiting.
+constexpr uint32_t kSlotSent = 1;
+constexpr uint32_t kSlotRecvWaiting = 2;
+constexpr uint32_t kSlotAborted = 4;
+constexpr uint32_t kSlotCancelled = 8;
+constexpr uint32_t kSlotCompleted = kSlotSent | kSlotAborted | kSlotCancelled;
+
+absl::Status RecvCancelledError() {
+  return StatusGroup::MakeDerived(errors::Cancelled("RecvAsync is cancelled."));
+}
+
+
 }  // namespace
 
 RefCountedIntraProcessRendezvous::RefCountedIntraProcessRendezvous(
@@ -225,4 +259,181 @@ void PrivateIntraProcessRendezvous::StartAbort(const absl::Status& s) {
   local_.StartAbort(s);
 }
 
+int RendezvousSlotTable::Add(absl::string_view key) {
+  return slots_.emplace(key, slots_.size()).first->second;
+}
+
+int RendezvousSlotTable::Find(absl::string_view key) const {
+  auto it = slots_.find(key);
+  return it == slots_.end() ? -1 : it->second;
+}
+
+struct SlotIntraProcessRendezvous::Slot {
+  std::atomic<uint32_t> state{0};
+  // Written before kSlotSent is set.
+  Rendezvous::Args send_args;
+  Tensor val;
+  bool is_dead = false;
+  // Written before kSlotRecvWaiting is set.
+  Rendezvous::Args recv_args;
+  DoneCallback waiter;
+  CancellationManager* cm = nullptr;
+  CancellationToken token = CancellationManager::kInvalidToken;
+
+  // Sets `bit` and returns whether this completed a pending receive, whose
+  // waiter must then be called by the caller.
+  bool SetCompletionBit(uint32_t bit) {
+    const uint32_t prev = state.fetch_or(bit, std::memory_order_acq_rel);
+    return (prev & (kSlotRecvWaiting | kSlotCompleted)) == kSlotRecvWaiting;
+  }
+
+  void DeregisterCancellation() {
+    if (cm != nullptr) cm->TryDeregisterCallback(token);
+  }
+};
+
+struct SlotIntraProcessRendezvous::Slots {
+  explicit Slots(int size) : slots(new Slot[size]), size(size) {}
+
+  absl::Status status() {
+    mutex_lock l(mu);
+    return abort_status;
+  }
+
+  mutex mu;
+  absl::Status abort_status TF_GUARDED_BY(mu);
+  const std::unique_ptr<Slot[]> slots;
+  const int size;
+};
+
+SlotIntraProcessRendezvous::SlotIntraProcessRendezvous(
+    const DeviceMgr* device_mgr,
+    std::shared_ptr<const RendezvousSlotTable> table, RendezvousInterface* base)
+    : device_mgr_(device_mgr),
+      table_(std::move(table)),
+      base_(base),
+      slots_(std::make_shared<Slots>(table_->size())) {}
+
+SlotIntraProcessRendezvous::~SlotIntraProcessRendezvous() {
+  AbortSlots(absl::CancelledError("SlotIntraProcessRendezvous deleted"));
+}
+
+absl::Status SlotIntraProcessRendezvous::Send(const ParsedKey& key,
+                                              const Rendezvous::Args& args,
+                                              const Tensor& val,
+                                              const bool is_dead) {
+  const int index = table_->Find(key.FullKey());
+  if (index < 0) return base_->Send(key, args, val, is_dead);
+  DVLOG(1) << "SlotIntraProcessRendezvous Send " << this << " "
+           << key.FullKey();
+
+  Slot& slot = slots_->slots[index];
+  const uint32_t state = slot.state.load(std::memory_order_acquire);
+  if (state & kSlotAborted) return slots_->status();
+  if (state & kSlotSent) {
+    return errors::Internal("Send of an already sent tensor: ", key.FullKey());
+  }
+  slot.send_args = args;
+  slot.val = val;
+  slot.is_dead = is_dead;
+  if (slot.SetCompletionBit(kSlotSent)) {
+    slot.DeregisterCancellation();
+    slot.val = Tensor();
+    FinishIntraProcessRecv(device_mgr_, key, absl::OkStatus(), args,
+                           slot.recv_args, val, is_dead,
+                           std::move(slot.waiter));
+    return absl::OkStatus();
+  }
+  if (slot.state.load(std::memory_order_acquire) & kSlotAborted) {
+    return slots_->status();
+  }
+  return absl::OkStatus();
+}
+
+void SlotIntraProcessRendezvous::RecvAsync(const ParsedKey& key,
+                                           const Rendezvous::Args& args,
+                                           DoneCallback done) {
+  const int index = table_->Find(key.FullKey());
+  if (index < 0) {
+    base_->RecvAsync(key, args, std::move(done));
+    return;
+  }
+  DVLOG(1) << "SlotIntraProcessRendezvous Recv " << this << " "
+           << key.FullKey();
+
+  Slot& slot = slots_->slots[index];
+  const uint32_t state = slot.state.load(std::memory_order_acquire);
+  if (state & kSlotAborted) {
+    done(slots_->status(), Rendezvous::Args(), args, Tensor(), false);
+    return;
+  }
+  if (state & kSlotRecvWaiting) {
+    done(errors::Internal("Recv of an already received tensor: ",
+                          key.FullKey()),
+         Rendezvous::Args(), args, Tensor(), false);
+    return;
+  }
+  // A cancellation between the registration and the publication of the
+  // receive only sets kSlotCancelled, and the receive then completes itself.
+  CancellationManager* cm = args.cancellation_manager;
+  if (cm != nullptr) {
+    const CancellationToken token = cm->get_cancellation_token();
+    const bool registered = cm->RegisterCallback(
+        token, [slots = slots_, index]() {
+          Slot& cancelled = slots->slots[index];
+          if (cancelled.SetCompletionBit(kSlotCancelled)) {
+            cancelled.waiter(RecvCancelledError(), Rendezvous::Args(),
+                             cancelled.recv_args, Tensor(), /*is_dead=*/false);
+          }
+        });
+    if (!registered) {
+      done(RecvCancelledError(), Rendezvous::Args(), args, Tensor(),
+           /*is_dead=*/false);
+      return;
+    }
+    slot.cm = cm;
+    slot.token = token;
+  }
+  slot.recv_args = args;
+  slot.waiter = std::move(done);
+
+  const uint32_t prev =
+      slot.state.fetch_or(kSlotRecvWaiting, std::memory_order_acq_rel);
+  if ((prev & kSlotCompleted) == 0) return;  // The sender completes it.
+  slot.DeregisterCancellation();
+  if (prev & kSlotAborted) {
+    slot.waiter(slots_->status(), Rendezvous::Args(), slot.recv_args, Tensor(),
+                /*is_dead=*/false);
+  } else if (prev & kSlotCancelled) {
+    slot.waiter(RecvCancelledError(), Rendezvous::Args(), slot.recv_args,
+                Tensor(), /*is_dead=*/false);
+  } else {
+    const Tensor val = std::move(slot.val);
+    FinishIntraProcessRecv(device_mgr_, key, absl::OkStatus(), slot.send_args,
+                           slot.recv_args, val, slot.is_dead,
+                           std::move(slot.waiter));
+  }
+}
+
+void SlotIntraProcessRendezvous::StartAbort(const absl::Status& status) {
+  AbortSlots(status);
+  base_->StartAbort(status);
+}
+
+void SlotIntraProcessRendezvous::AbortSlots(const absl::Status& status) {
+  {
+    mutex_lock l(slots_->mu);
+    if (!slots_->abort_status.ok()) return;
+    slots_->abort_status = status;
+  }
+  for (int i = 0; i < slots_->size; ++i) {
+    Slot& slot = slots_->slots[i];
+    if (slot.SetCompletionBit(kSlotAborted)) {
+      slot.DeregisterCancellation();
+      slot.waiter(status, Rendezvous::Args(), slot.recv_args, Tensor(),
+                  /*is_dead=*/false);
+    }
+  }
+}
+
 }  // end namespace tensorflow
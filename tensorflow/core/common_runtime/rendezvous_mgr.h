@@ -16,9 +16,12 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_COMMON_RUNTIME_RENDEZVOUS_MGR_H_
 #define TENSORFLOW_CORE_COMMON_RUNTIME_RENDEZVOUS_MGR_H_
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
 #include "tensorflow/core/common_runtime/device_mgr.h"
 #include "tensorflow/core/framework/local_rendezvous.h"
 #include "tensorflow/core/framework/rendezvous.h"
@@ -101,6 +104,63 @@ class PrivateIntraProcessRendezvous : public RendezvousInterface {
   void operator=(const PrivateIntraProcessRendezvous&) = delete;
 };
 
+// Assigns a slot to each rendezvous key of a fixed set, such as the keys of
+// the send/recv pairs between the components of a multi-device function. The
+// table is built once and is read-only afterwards.
+class RendezvousSlotTable {
+ public:
+  // Adds `key`, a full key as built by the send and recv kernels, and returns
+  // its slot.
+  int Add(absl::string_view key);
+
+  // Returns the slot of `key`, or -1 if `key` isn't in the table.
+  int Find(absl::string_view key) const;
+
+  int size() const { return slots_.size(); }
+
+ private:
+  absl::flat_hash_map<std::string, int> slots_;
+};
+
+// Non-reference-counted implementation for a single run of a graph whose
+// producers and consumers of the keys in a RendezvousSlotTable all run in
+// this process. Each of those keys is sent and received at most once, and its
+// tensor is handed over through a preallocated slot with atomic operations:
+// no queue items are allocated and no lock is taken. The other keys are
+// forwarded to `base`.
+class SlotIntraProcessRendezvous : public RendezvousInterface {
+ public:
+  // `base` is not owned and must outlive this rendezvous.
+  SlotIntraProcessRendezvous(const DeviceMgr* device_mgr,
+                             std::shared_ptr<const RendezvousSlotTable> table,
+                             RendezvousInterface* base);
+  ~SlotIntraProcessRendezvous() override;
+
+  // Implementation of RendezvousInterface methods.
+  absl::Status Send(const ParsedKey& key, const Rendezvous::Args& args,
+                    const Tensor& val, const bool is_dead) override;
+  void RecvAsync(const ParsedKey& key, const Rendezvous::Args& args,
+                 DoneCallback done) override;
+  // Also aborts `base`.
+  void StartAbort(const absl::Status& status) override;
+
+ private:
+  struct Slot;
+  struct Slots;
+
+  // Aborts the slots without a value and with a pending receive.
+  void AbortSlots(const absl::Status& status);
+
+  const DeviceMgr* const device_mgr_;
+  const std::shared_ptr<const RendezvousSlotTable> table_;
+  RendezvousInterface* const base_;
+  // Shared with the cancellation callbacks of the pending receives.
+  const std::shared_ptr<Slots> slots_;
+
+  SlotIntraProcessRendezvous(const SlotIntraProcessRendezvous&) = delete;
+  void operator=(const SlotIntraProcessRendezvous&) = delete;
+};
+
 }  // end namespace tensorflow
 
 #endif  // TENSORFLOW_CORE_COMMON_RUNTIME_RENDEZVOUS_MGR_H_
@@ -0,0 +1,176 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/rendezvous_mgr.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/device_factory.h"
+#include "tensorflow/core/common_runtime/device_mgr.h"
+#include "tensorflow/core/framework/cancellation.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/notification.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/public/session_options.h"
+
+namespace tensorflow {
+namespace {
+
+string Key(const string& name) {
+  return Rendezvous::CreateKey("/job:a/replica:0/task:0/device:CPU:0", 1,
+                               "/job:a/replica:0/task:0/device:CPU:0", name,
+                               FrameAndIter(0, 0));
+}
+
+Rendezvous::ParsedKey Parse(const string& key) {
+  Rendezvous::ParsedKey parsed;
+  TF_CHECK_OK(Rendezvous::ParseKey(key, &parsed));
+  return parsed;
+}
+
+class SlotIntraProcessRendezvousTest : public ::testing::Test {
+ protected:
+  SlotIntraProcessRendezvousTest() {
+    std::vector<std::unique_ptr<Device>> devices;
+    TF_CHECK_OK(DeviceFactory::AddDevices(
+        SessionOptions(), "/job:a/replica:0/task:0", &devices));
+    device_mgr_ = std::make_unique<StaticDeviceMgr>(std::move(devices));
+    base_ = std::make_unique<PrivateIntraProcessRendezvous>(device_mgr_.get());
+    auto table = std::make_shared<RendezvousSlotTable>();
+    table->Add(Key("a"));
+    table->Add(Key("b"));
+    table_ = std::move(table);
+  }
+
+  std::unique_ptr<StaticDeviceMgr> device_mgr_;
+  std::unique_ptr<PrivateIntraProcessRendezvous> base_;
+  std::shared_ptr<const RendezvousSlotTable> table_;
+};
+
+TEST(RendezvousSlotTableTest, AddAndFind) {
+  RendezvousSlotTable table;
+  EXPECT_EQ(table.Add("x"), 0);
+  EXPECT_EQ(table.Add("y"), 1);
+  EXPECT_EQ(table.Add("x"), 0);
+  EXPECT_EQ(table.size(), 2);
+  EXPECT_EQ(table.Find("y"), 1);
+  EXPECT_EQ(table.Find("z"), -1);
+}
+
+TEST_F(SlotIntraProcessRendezvousTest, SendThenRecv) {
+  SlotIntraProcessRendezvous rendezvous(device_mgr_.get(), table_,
+                                        base_.get());
+  TF_ASSERT_OK(rendezvous.Send(Parse(Key("a")), Rendezvous::Args(),
+                               test::AsScalar<float>(1.0f), false));
+  Tensor val;
+  bool is_dead;
+  TF_ASSERT_OK(
+      rendezvous.Recv(Parse(Key("a")), Rendezvous::Args(), &val, &is_dead));
+  test::ExpectTensorEqual<float>(val, test::AsScalar<float>(1.0f));
+  EXPECT_FALSE(is_dead);
+}
+
+TEST_F(SlotIntraProcessRendezvousTest, RecvThenSend) {
+  SlotIntraProcessRendezvous rendezvous(device_mgr_.get(), table_,
+                                        base_.get());
+  Notification n;
+  Tensor val;
+  bool val_is_dead = false;
+  rendezvous.RecvAsync(
+      Parse(Key("b")), Rendezvous::Args(),
+      [&](const absl::Status& s, const Rendezvous::Args&,
+          const Rendezvous::Args&, const Tensor& v, bool is_dead) {
+        TF_EXPECT_OK(s);
+        val = v;
+        val_is_dead = is_dead;
+        n.Notify();
+      });
+  EXPECT_FALSE(n.HasBeenNotified());
+  TF_ASSERT_OK(rendezvous.Send(Parse(Key("b")), Rendezvous::Args(),
+                               test::AsScalar<int32>(7), true));
+  ASSERT_TRUE(n.HasBeenNotified());
+  test::ExpectTensorEqual<int32>(val, test::AsScalar<int32>(7));
+  EXPECT_TRUE(val_is_dead);
+}
+
+TEST_F(SlotIntraProcessRendezvousTest, ForwardsOtherKeysToBase) {
+  SlotIntraProcessRendezvous rendezvous(device_mgr_.get(), table_,
+                                        base_.get());
+  TF_ASSERT_OK(rendezvous.Send(Parse(Key("other")), Rendezvous::Args(),
+                               test::AsScalar<float>(2.0f), false));
+  Tensor val;
+  bool is_dead;
+  TF_ASSERT_OK(
+      base_->Recv(Parse(Key("other")), Rendezvous::Args(), &val, &is_dead));
+  test::ExpectTensorEqual<float>(val, test::AsScalar<float>(2.0f));
+}
+
+TEST_F(SlotIntraProcessRendezvousTest, RejectsSecondSend) {
+  SlotIntraProcessRendezvous rendezvous(device_mgr_.get(), table_,
+                                        base_.get());
+  TF_ASSERT_OK(rendezvous.Send(Parse(Key("a")), Rendezvous::Args(),
+                               test::AsScalar<float>(1.0f), false));
+  EXPECT_TRUE(absl::IsInternal(rendezvous.Send(
+      Parse(Key("a")), Rendezvous::Args(), test::AsScalar<float>(1.0f),
+      false)));
+}
+
+TEST_F(SlotIntraProcessRendezvousTest, AbortCompletesPendingRecv) {
+  SlotIntraProcessRendezvous rendezvous(device_mgr_.get(), table_,
+                                        base_.get());
+  Notification n;
+  rendezvous.RecvAsync(Parse(Key("a")), Rendezvous::Args(),
+                       [&n](const absl::Status& s, const Rendezvous::Args&,
+                            const Rendezvous::Args&, const Tensor&, bool) {
+                         EXPECT_TRUE(absl::IsAborted(s));
+                         n.Notify();
+                       });
+  rendezvous.StartAbort(absl::AbortedError("test"));
+  ASSERT_TRUE(n.HasBeenNotified());
+  EXPECT_TRUE(absl::IsAborted(rendezvous.Send(
+      Parse(Key("b")), Rendezvous::Args(), test::AsScalar<float>(1.0f),
+      false)));
+  // The abort is forwarded to the base rendezvous.
+  EXPECT_TRUE(absl::IsAborted(base_->Send(Parse(Key("other")),
+                                          Rendezvous::Args(),
+                                          test::AsScalar<float>(1.0f), false)));
+}
+
+TEST_F(SlotIntraProcessRendezvousTest, CancellationCompletesPendingRecv) {
+  SlotIntraProcessRendezvous rendezvous(device_mgr_.get(), table_,
+                                        base_.get());
+  CancellationManager cm;
+  Rendezvous::Args args;
+  args.cancellation_manager = &cm;
+  Notification n;
+  rendezvous.RecvAsync(Parse(Key("a")), args,
+                       [&n](const absl::Status& s, const Rendezvous::Args&,
+                            const Rendezvous::Args&, const Tensor&, bool) {
+                         EXPECT_TRUE(absl::IsCancelled(s));
+                         n.Notify();
+                       });
+  cm.StartCancel();
+  ASSERT_TRUE(n.HasBeenNotified());
+  // A late send still succeeds.
+  TF_EXPECT_OK(rendezvous.Send(Parse(Key("a")), Rendezvous::Args(),
+                               test::AsScalar<float>(1.0f), false));
+}
+
+}  // namespace
+}  // namespace tensorflow
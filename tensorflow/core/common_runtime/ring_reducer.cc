@@ -211,9 +211,15 @@ bool RingReducer::RunAsyncParts() {
     }
   }
 
+  // On the CPU the reductions run on the collective executor's threads, so
+  // that this thread keeps dispatching the sends and recvs of the other fields
+  // meanwhile. Other devices only enqueue the reduction on a stream.
+  const bool async_reduce = (gpu_info == nullptr);
+
   int field_done_count = 0;
   int send_pending_count = 0;
   int recv_pending_count = 0;
+  int reduce_pending_count = 0;
   std::atomic<bool> aborted(false);
 
   {
@@ -257,18 +263,33 @@ bool RingReducer::RunAsyncParts() {
             --recv_pending_count;
             if (!rf->second_pass) {
               rf->action = RF_REDUCE;
-              absl::Status s = collective_util::ComputeBinOp(
-                  col_ctx_->op_ctx, col_ctx_->op_params, col_ctx_->device,
-                  col_params_->merge_op, &rf->chunk, &rf->tmp_chunk);
-              if (!s.ok()) {
-                aborted = true;
-                StartAbort(s);
+              ++reduce_pending_count;
+              auto reduce = [this, rf, &aborted]() {
+                absl::Status s = collective_util::ComputeBinOp(
+                    col_ctx_->op_ctx, col_ctx_->op_params, col_ctx_->device,
+                    col_params_->merge_op, &rf->chunk, &rf->tmp_chunk);
+                if (!s.ok()) {
+                  aborted = true;
+                  StartAbort(s);
+                }
+              };
+              if (async_reduce) {
+                col_ctx_->col_exec->RunClosure(
+                    [rf, &ready_queue, reduce = std::move(reduce)]() {
+                      reduce();
+                      ready_queue.Enqueue(rf);
+                    });
+                dispatched = true;
+              } else {
+                reduce();
               }
             } else {
               rf->action = RF_SEND_READY;
             }
             break;
           case RF_REDUCE:
+            CHECK_GT(reduce_pending_count, 0);
+            --reduce_pending_count;
             if (!rf->second_pass && col_params_->final_op && rf->is_final) {
               rf->action = RF_FINALIZE;
               group_size_tensor_ready_.WaitForNotification();
@@ -327,12 +348,16 @@ bool RingReducer::RunAsyncParts() {
     if (aborted) {
       // All of the pending data actions should be aborted; field the
       // callbacks and clear the queue before quitting.
-      while ((send_pending_count > 0) || (recv_pending_count > 0)) {
+      while ((send_pending_count > 0) || (recv_pending_count > 0) ||
+             (reduce_pending_count > 0)) {
         RingField* rf = ready_queue.Dequeue();
         switch (rf->action) {
           case RF_RECV:
             --recv_pending_count;
             break;
+          case RF_REDUCE:
+            --reduce_pending_count;
+            break;
           case RF_SEND:
             --send_pending_count;
             break;
@@ -345,6 +370,7 @@ bool RingReducer::RunAsyncParts() {
 
   CHECK_EQ(send_pending_count, 0);
   CHECK_EQ(recv_pending_count, 0);
+  CHECK_EQ(reduce_pending_count, 0);
 
   VLOG(2) << this << " device=" << col_ctx_->device_name << " finish;"
           << " final value " << TensorDebugString(ca_->Value());
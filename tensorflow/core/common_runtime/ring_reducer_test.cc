@@ -427,6 +427,24 @@ DEF_TEST(INT64, CPU, 2, 8, 3, 4095, 0)
 DEF_TEST(FLOAT, CPU, 2, 8, 1, 9408, 1)
 DEF_TEST(FLOAT, CPU, 2, 8, 1, 9408, 7)
 DEF_TEST(FLOAT, CPU, 2, 8, 2, 9408, 11)
+
+// On the CPU, reductions run on the collective executor while other fields
+// are sent and received. A failing reduction must abort the collective on
+// every device without waiting for the pending reductions forever.
+TEST_F(RingReducerTest, FailedAsyncReductionAborts) {
+  Init(/*num_workers=*/1, /*num_devices=*/4, DT_INT32, TensorShape({4095}),
+       DEVICE_CPU, /*num_subdivs=*/3, /*fail_after=*/0);
+  for (auto& instance : instances_) {
+    // Integer division by the zeros received from the other devices fails.
+    instance->merge_op_ = GetDiv(DT_INT32, DEVICE_CPU, instance->device_);
+    instance->col_params_->merge_op = instance->merge_op_.get();
+    instance->InitTensor([](Tensor* t) { t->flat<int32>().setZero(); });
+  }
+  Reduce(/*fail_after=*/0);
+  for (auto& instance : instances_) {
+    EXPECT_FALSE(instance->status_.ok());
+  }
+}
 #endif
 
 #if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
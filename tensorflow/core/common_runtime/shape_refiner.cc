@@ -14,19 +14,25 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/common_runtime/shape_refiner.h"
 
+#include <algorithm>
 #include <deque>
 #include <limits>
 #include <memory>
 #include <optional>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/strings/str_cat.h"
 #include "tensorflow/core/common_runtime/eval_const_tensor.h"
 #include "tensorflow/core/common_runtime/function_utils.h"
 #include "tensorflow/core/common_runtime/graph_constructor.h"
+#include "tensorflow/core/framework/attr_value_util.h"
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/common_shape_fns.h"
+#include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/framework/node_def.pb.h"
 #include "tensorflow/core/framework/shape_inference.h"
 #include "tensorflow/core/framework/tensor.h"
@@ -34,6 +40,7 @@ limitations under the License.
 #include "tensorflow/core/framework/versions.pb.h"
 #include "tensorflow/core/graph/algorithm.h"
 #include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/hash/hash.h"
 #include "tsl/platform/statusor.h"
 
 namespace tensorflow {
@@ -43,6 +50,71 @@ using shape_inference::InferenceContext;
 using shape_inference::ShapeAndType;
 using shape_inference::ShapeHandle;
 
+FunctionShapeCache* FunctionShapeCache::Global() {
+  static FunctionShapeCache* cache = new FunctionShapeCache();
+  return cache;
+}
+
+namespace {
+
+bool SameFunctions(absl::Span<const core::RefCountPtr<FunctionRecord>> a,
+                   absl::Span<const core::RefCountPtr<FunctionRecord>> b) {
+  if (a.size() != b.size()) return false;
+  for (int i = 0; i < a.size(); ++i) {
+    if (a[i].get() != b[i].get() &&
+        !FunctionDefsEqual(a[i]->fdef(), b[i]->fdef())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameAttributes(const AttrValueMap& a, const AttrValueMap& b) {
+  if (a.size() != b.size()) return false;
+  for (const auto& [name, value] : a) {
+    auto it = b.find(name);
+    if (it == b.end() || !AreAttrValuesEqual(value, it->second)) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+std::shared_ptr<const FunctionShapeCache::Entry> FunctionShapeCache::Lookup(
+    const std::string& key,
+    absl::Span<const core::RefCountPtr<FunctionRecord>> functions,
+    const AttrValueMap& attributes) const {
+  std::shared_ptr<const Entry> entry;
+  {
+    mutex_lock l(mu_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) return nullptr;
+    entry = it->second;
+  }
+  if (!SameFunctions(entry->functions, functions) ||
+      !SameAttributes(entry->attributes, attributes)) {
+    return nullptr;
+  }
+  return entry;
+}
+
+void FunctionShapeCache::Insert(const std::string& key, Entry entry) {
+  auto shared_entry = std::make_shared<const Entry>(std::move(entry));
+  mutex_lock l(mu_);
+  if (entries_.size() >= kMaxEntries) entries_.clear();
+  entries_.insert_or_assign(key, std::move(shared_entry));
+}
+
+void FunctionShapeCache::Clear() {
+  mutex_lock l(mu_);
+  entries_.clear();
+}
+
+int FunctionShapeCache::size() const {
+  mutex_lock l(mu_);
+  return entries_.size();
+}
+
 ShapeRefiner::ShapeRefiner(int graph_def_version,
                            const OpRegistryInterface* ops)
     : graph_def_version_(graph_def_version),
@@ -64,6 +136,72 @@ namespace {
 constexpr char kArgOp[] = "_Arg";
 constexpr char kRetvalOp[] = "_Retval";
 
+bool HasRequestedInputTensors(const InferenceContext& c) {
+  for (int i = 0; i < c.num_inputs(); ++i) {
+    if (c.requested_input_tensor(i) ||
+        c.requested_input_tensor_as_partial_shape(i)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void AppendHandleData(InferenceContext* c,
+                      const std::vector<ShapeAndType>* handle_data,
+                      std::string* key) {
+  if (handle_data == nullptr) return;
+  for (const ShapeAndType& shape_and_type : *handle_data) {
+    absl::StrAppend(key, "(", c->DebugString(shape_and_type.shape), ",",
+                    DataTypeString(shape_and_type.dtype), ",",
+                    shape_and_type.type.ShortDebugString(), ")");
+  }
+}
+
+// Returns false if an output of `c` wasn't set.
+bool GetFunctionShapeCacheEntry(InferenceContext* c,
+                                FunctionShapeCache::Entry* entry) {
+  entry->output_shapes.resize(c->num_outputs());
+  entry->output_handle_data.resize(c->num_outputs());
+  for (int i = 0; i < c->num_outputs(); ++i) {
+    if (!c->output(i).IsSet()) return false;
+    c->ShapeHandleToProto(c->output(i), &entry->output_shapes[i]);
+    const std::vector<ShapeAndType>* handle_data =
+        c->output_handle_shapes_and_types(i);
+    if (handle_data == nullptr) continue;
+    for (const ShapeAndType& shape_and_type : *handle_data) {
+      FunctionShapeCache::HandleShapeAndType& cached =
+          entry->output_handle_data[i].emplace_back();
+      c->ShapeHandleToProto(shape_and_type.shape, &cached.shape);
+      cached.dtype = shape_and_type.dtype;
+      cached.type = shape_and_type.type;
+    }
+  }
+  return true;
+}
+
+absl::Status SetFunctionShapeCacheEntry(const FunctionShapeCache::Entry& entry,
+                                        InferenceContext* c) {
+  if (entry.output_shapes.size() != c->num_outputs()) {
+    return errors::Internal("Cached function shapes have ",
+                            entry.output_shapes.size(), " outputs, expected ",
+                            c->num_outputs());
+  }
+  for (int i = 0; i < c->num_outputs(); ++i) {
+    ShapeHandle handle;
+    TF_RETURN_IF_ERROR(
+        c->MakeShapeFromShapeProto(entry.output_shapes[i], &handle));
+    c->set_output(i, handle);
+    if (entry.output_handle_data[i].empty()) continue;
+    std::vector<ShapeAndType> handle_data;
+    for (const auto& cached : entry.output_handle_data[i]) {
+      TF_RETURN_IF_ERROR(c->MakeShapeFromShapeProto(cached.shape, &handle));
+      handle_data.push_back(ShapeAndType(handle, cached.dtype, cached.type));
+    }
+    c->set_output_handle_shapes_and_types(i, handle_data);
+  }
+  return absl::OkStatus();
+}
+
 }  // namespace
 
 // Runs shape inference for the given node using the given ShapeRefiner.
@@ -158,9 +296,103 @@ absl::Status ShapeRefiner::InferShapesForFunctionSubNode(
 // NOTE: Recursive user-defined functions are not supported.
 // Maybe we won't support recursive functions at all in TF, because of
 // other maintainability issues.
+absl::StatusOr<const ShapeRefiner::ReachableFunctions*>
+ShapeRefiner::GetReachableFunctions(const FunctionDef& function_def) {
+  const string& fname = function_def.signature().name();
+  auto it = reachable_functions_.find(fname);
+  if (it != reachable_functions_.end()) {
+    // The records are held, so a replaced function has another record.
+    const bool replaced = absl::c_any_of(
+        it->second.records, [this](const auto& record) {
+          return function_library_->FindRecord(
+                     record->fdef().signature().name()) != record;
+        });
+    if (!replaced) return &it->second;
+    reachable_functions_.erase(it);
+    functions_.erase(fname);
+  }
+
+  ReachableFunctions reachable;
+  reachable.records.push_back(function_library_->FindRecord(fname));
+  std::vector<string> names =
+      function_library_->ReachableDefinitions(function_def).ListFunctionNames();
+  std::sort(names.begin(), names.end());
+  for (const string& name : names) {
+    if (name == fname) continue;
+    reachable.records.push_back(function_library_->FindRecord(name));
+  }
+  for (const auto& record : reachable.records) {
+    if (record == nullptr) {
+      return errors::NotFound("A function reached by ", fname,
+                              " isn't in the function library");
+    }
+    reachable.fingerprint =
+        Hash64Combine(reachable.fingerprint, FunctionDefHash(record->fdef()));
+  }
+  return &reachable_functions_.emplace(fname, std::move(reachable))
+              .first->second;
+}
+
+bool ShapeRefiner::FunctionShapeCacheKey(const ReachableFunctions& functions,
+                                         AttrSlice attributes,
+                                         InferenceContext* outer_context,
+                                         std::string* key) {
+  // The values requested by an earlier run of the call's inference may have
+  // been materialized in the meantime.
+  if (HasRequestedInputTensors(*outer_context)) return false;
+
+  // The attributes are unordered. Like the function fingerprint, their hash
+  // only narrows down the entries that FunctionShapeCache::Lookup compares.
+  uint64 attributes_hash = 0;
+  if (attributes.attrs() != nullptr) {
+    for (const auto& [name, value] : attributes) {
+      attributes_hash += Hash64Combine(Hash64(name), AttrValueHash(value));
+    }
+  }
+
+  *key = absl::StrCat(functions.fingerprint, ";", attributes_hash, ";",
+                      graph_def_version_, ";", require_shape_inference_fns_,
+                      disable_constant_propagation_);
+  for (int i = 0; i < outer_context->num_inputs(); ++i) {
+    absl::StrAppend(key, ";",
+                    outer_context->DebugString(outer_context->input(i)));
+    AppendHandleData(outer_context,
+                     outer_context->input_handle_shapes_and_types(i), key);
+  }
+  return true;
+}
+
 absl::Status ShapeRefiner::InferShapesForFunction(
     const FunctionDef* function_def, AttrSlice attributes,
     InferenceContext* outer_context) {
+  const ReachableFunctions* reachable = nullptr;
+  const AttrValueMap no_attributes;
+  const AttrValueMap& attribute_map =
+      attributes.attrs() != nullptr ? *attributes.attrs() : no_attributes;
+  std::string cache_key;
+  bool cacheable = false;
+  if (function_shape_cache_ != nullptr) {
+    absl::StatusOr<const ReachableFunctions*> reachable_or =
+        GetReachableFunctions(*function_def);
+    if (reachable_or.ok()) {
+      reachable = *reachable_or;
+      cacheable = FunctionShapeCacheKey(*reachable, attributes, outer_context,
+                                        &cache_key);
+    } else {
+      VLOG(4) << "Not caching the shapes of function \""
+              << function_def->signature().name()
+              << "\": " << reachable_or.status();
+    }
+  }
+  if (cacheable) {
+    if (auto entry = function_shape_cache_->Lookup(
+            cache_key, reachable->records, attribute_map)) {
+      VLOG(4) << "Using cached shapes for function \""
+              << function_def->signature().name() << "\".";
+      return SetFunctionShapeCacheEntry(*entry, outer_context);
+    }
+  }
+
   const Graph* graph;
   const string& fname = function_def->signature().name();
   auto it = functions_.find(fname);
@@ -205,6 +437,20 @@ absl::Status ShapeRefiner::InferShapesForFunction(
     node_to_context_.erase(node);
   }
 
+  // Shapes that depend on the values of the inputs aren't cached.
+  if (cacheable && inference_status.ok() &&
+      !HasRequestedInputTensors(*outer_context)) {
+    FunctionShapeCache::Entry entry;
+    for (const auto& record : reachable->records) {
+      record->Ref();
+      entry.functions.emplace_back(record.get());
+    }
+    entry.attributes = attribute_map;
+    if (GetFunctionShapeCacheEntry(outer_context, &entry)) {
+      function_shape_cache_->Insert(cache_key, std::move(entry));
+    }
+  }
+
   return inference_status;
 }
 
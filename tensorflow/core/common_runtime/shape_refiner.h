@@ -21,18 +21,74 @@ limitations under the License.
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
 #include "tensorflow/core/common_runtime/graph_runner.h"
+#include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/full_type.pb.h"
+#include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/framework/function.pb.h"
 #include "tensorflow/core/framework/shape_inference.h"
+#include "tensorflow/core/framework/tensor_shape.pb.h"
+#include "tensorflow/core/framework/types.pb.h"
 #include "tensorflow/core/graph/graph.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
 
 namespace tensorflow {
 namespace grappler {
 class GraphProperties;
 }
 
+// A cache of the output shapes inferred for function calls, keyed by the
+// fingerprint of the function and of the functions it calls and of the call
+// attributes, and by the input shapes and handle data. Since the fingerprint
+// may collide, the functions and attributes are compared on a hit. A cache
+// shared by the ShapeRefiners of several graphs, e.g. Global(), saves the
+// shape inference of the functions that are imported or traced again.
+class FunctionShapeCache {
+ public:
+  struct HandleShapeAndType {
+    TensorShapeProto shape;
+    DataType dtype = DT_INVALID;
+    FullTypeDef type;
+  };
+
+  struct Entry {
+    // The function of the call followed by the functions it reaches, in name
+    // order, and the call attributes.
+    std::vector<core::RefCountPtr<FunctionRecord>> functions;
+    AttrValueMap attributes;
+
+    std::vector<TensorShapeProto> output_shapes;
+    // Indexed like output_shapes, empty for the outputs without handle data.
+    std::vector<std::vector<HandleShapeAndType>> output_handle_data;
+  };
+
+  // The cache is cleared when it would grow beyond this many entries.
+  static constexpr int kMaxEntries = 4096;
+
+  static FunctionShapeCache* Global();
+
+  // Returns nullptr if there is no entry for `key` with the same functions
+  // and attributes.
+  std::shared_ptr<const Entry> Lookup(
+      const std::string& key,
+      absl::Span<const core::RefCountPtr<FunctionRecord>> functions,
+      const AttrValueMap& attributes) const;
+  void Insert(const std::string& key, Entry entry);
+
+  void Clear();
+  int size() const;
+
+ private:
+  mutable mutex mu_;
+  absl::flat_hash_map<std::string, std::shared_ptr<const Entry>> entries_
+      TF_GUARDED_BY(mu_);
+};
+
 // ShapeRefiner performs shape inference for TensorFlow Graphs.  It is
 // responsible for instantiating InferenceContext objects for each
 // Node in the Graph, and providing/storing the 'input_tensor' Tensors
@@ -106,12 +162,20 @@ class ShapeRefiner {
   void set_function_library_for_shape_inference(
       const tensorflow::FunctionLibraryDefinition* lib) {
     function_library_ = lib;
+    reachable_functions_.clear();
   }
 
   bool function_shape_inference_supported() const {
     return function_library_ != nullptr;
   }
 
+  // Sets the cache of the shapes inferred for function calls. Calls aren't
+  // cached by default, nullptr disables caching again. The cache must outlive
+  // the shape refiner.
+  void set_function_shape_cache(FunctionShapeCache* cache) {
+    function_shape_cache_ = cache;
+  }
+
  private:
   friend class ShapeRefinerTest;
   friend class ::tensorflow::grappler::GraphProperties;
@@ -143,6 +207,27 @@ class ShapeRefiner {
       const FunctionDef* function_def, AttrSlice attributes,
       shape_inference::InferenceContext* outer_context);
 
+  // The function of a call followed by the functions it reaches, in name
+  // order, and their fingerprint. The records are held so that a replaced
+  // function is detected by comparing the records of the library.
+  struct ReachableFunctions {
+    uint64 fingerprint = 0;
+    std::vector<core::RefCountPtr<FunctionRecord>> records;
+  };
+
+  // Returns the reachable functions of `function_def`, computing them again
+  // if a function of function_library_ was replaced since the last call.
+  absl::StatusOr<const ReachableFunctions*> GetReachableFunctions(
+      const FunctionDef& function_def);
+
+  // Computes the function_shape_cache_ key of the call of `function_def` in
+  // `outer_context`. Returns false if the call must not be cached because
+  // its inference already depends on the values of its inputs.
+  bool FunctionShapeCacheKey(const ReachableFunctions& functions,
+                             AttrSlice attributes,
+                             shape_inference::InferenceContext* outer_context,
+                             std::string* key);
+
   // Performs shape inference for a node inside a function.
   //
   // 'outer_context' is the 'InferenceContext' for the function's call op.
@@ -284,6 +369,13 @@ class ShapeRefiner {
   // are refined.
   absl::flat_hash_map<std::string, std::unique_ptr<const Graph>> functions_;
 
+  // Not owned. May be null.
+  FunctionShapeCache* function_shape_cache_ = nullptr;
+
+  // The functions reached by the functions of function_library_, by function
+  // name. Only used with a function_shape_cache_.
+  absl::flat_hash_map<std::string, ReachableFunctions> reachable_functions_;
+
   ShapeRefiner(const ShapeRefiner&) = delete;
   void operator=(const ShapeRefiner&) = delete;
 };
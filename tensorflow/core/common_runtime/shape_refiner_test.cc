@@ -61,6 +61,10 @@ class ShapeRefinerTest : public ::testing::Test {
 
   static constexpr int64_t kMaxTensorSize = ShapeRefiner::kMaxTensorSize;
 
+  static int NumInstantiatedFunctions(const ShapeRefiner& m) {
+    return m.functions_.size();
+  }
+
   void TestStridedSlice(const PartialTensorShape& input_shape, int begin,
                         int end, int stride, const char* expected,
                         int begin_mask = 0, int end_mask = 0,
@@ -1527,6 +1531,91 @@ TEST_F(ShapeRefinerTest, ChainedFunctionShapeInferenceWithMultipleInputs) {
   EXPECT_SHAPE("[3,3]", m, wxplusb16, 0);
 }
 
+TEST_F(ShapeRefinerTest, FunctionShapesAreCachedAcrossRefiners) {
+  FunctionDefLibrary f_lib_proto;
+  *(f_lib_proto.add_function()) = test::function::XTimesTwo();
+  FunctionLibraryDefinition f_lib(OpRegistry::Global(), f_lib_proto);
+
+  Scope root = Scope::NewRootScope();
+  TF_ASSERT_OK(root.graph()->AddFunctionLibrary(f_lib_proto));
+  auto x = ops::Const(root, {{1.0f, 2.0f}});
+  auto x2 = test::function::Call(&root, "x2", "XTimesTwo", {x});
+  auto y = ops::Const(root, {1.0f, 2.0f, 3.0f});
+  auto y2 = test::function::Call(&root, "y2", "XTimesTwo", {y});
+
+  FunctionShapeCache cache;
+  ShapeRefiner m1(TF_GRAPH_DEF_VERSION, &f_lib);
+  m1.set_function_library_for_shape_inference(&f_lib);
+  m1.set_function_shape_cache(&cache);
+  TF_ASSERT_OK(m1.AddNode(x.node()));
+  TF_ASSERT_OK(m1.AddNode(x2.node()));
+  EXPECT_SHAPE("[1,2]", m1, x2, 0);
+  EXPECT_EQ(NumInstantiatedFunctions(m1), 1);
+  EXPECT_EQ(cache.size(), 1);
+
+  // The same call in another graph doesn't instantiate the function.
+  ShapeRefiner m2(TF_GRAPH_DEF_VERSION, &f_lib);
+  m2.set_function_library_for_shape_inference(&f_lib);
+  m2.set_function_shape_cache(&cache);
+  TF_ASSERT_OK(m2.AddNode(x.node()));
+  TF_ASSERT_OK(m2.AddNode(x2.node()));
+  EXPECT_SHAPE("[1,2]", m2, x2, 0);
+  EXPECT_EQ(NumInstantiatedFunctions(m2), 0);
+
+  // Other input shapes are inferred.
+  TF_ASSERT_OK(m2.AddNode(y.node()));
+  TF_ASSERT_OK(m2.AddNode(y2.node()));
+  EXPECT_SHAPE("[3]", m2, y2, 0);
+  EXPECT_EQ(NumInstantiatedFunctions(m2), 1);
+  EXPECT_EQ(cache.size(), 2);
+}
+
+TEST_F(ShapeRefinerTest, FunctionShapeCacheMissesReplacedFunctions) {
+  FunctionDefLibrary f_lib_proto;
+  *(f_lib_proto.add_function()) = test::function::XTimesTwo();
+  FunctionLibraryDefinition f_lib(OpRegistry::Global(), f_lib_proto);
+
+  Scope root = Scope::NewRootScope();
+  TF_ASSERT_OK(root.graph()->AddFunctionLibrary(f_lib_proto));
+  auto x = ops::Const(root, {{1.0f, 2.0f}});
+  auto x2 = test::function::Call(&root, "x2", "XTimesTwo", {x});
+  auto z2 = test::function::Call(&root, "z2", "XTimesTwo", {x});
+
+  FunctionShapeCache cache;
+  ShapeRefiner m(TF_GRAPH_DEF_VERSION, &f_lib);
+  m.set_function_library_for_shape_inference(&f_lib);
+  m.set_function_shape_cache(&cache);
+  TF_ASSERT_OK(m.AddNode(x.node()));
+  TF_ASSERT_OK(m.AddNode(x2.node()));
+  EXPECT_EQ(cache.size(), 1);
+
+  FunctionDef replacement = test::function::XTimesTwo();
+  (*replacement.mutable_attr())["_test"].set_b(true);
+  TF_ASSERT_OK(f_lib.ReplaceFunction("XTimesTwo", replacement));
+  TF_ASSERT_OK(m.AddNode(z2.node()));
+  EXPECT_SHAPE("[1,2]", m, z2, 0);
+  EXPECT_EQ(cache.size(), 2);
+}
+
+TEST_F(ShapeRefinerTest, FunctionShapesAreNotCachedByDefault) {
+  FunctionDefLibrary f_lib_proto;
+  *(f_lib_proto.add_function()) = test::function::XTimesTwo();
+  FunctionLibraryDefinition f_lib(OpRegistry::Global(), f_lib_proto);
+
+  Scope root = Scope::NewRootScope();
+  TF_ASSERT_OK(root.graph()->AddFunctionLibrary(f_lib_proto));
+  auto x = ops::Const(root, {{1.0f, 2.0f}});
+  auto x2 = test::function::Call(&root, "x2", "XTimesTwo", {x});
+
+  FunctionShapeCache::Global()->Clear();
+  ShapeRefiner m(TF_GRAPH_DEF_VERSION, &f_lib);
+  m.set_function_library_for_shape_inference(&f_lib);
+  TF_ASSERT_OK(m.AddNode(x.node()));
+  TF_ASSERT_OK(m.AddNode(x2.node()));
+  EXPECT_SHAPE("[1,2]", m, x2, 0);
+  EXPECT_EQ(FunctionShapeCache::Global()->size(), 0);
+}
+
 TEST_F(ShapeRefinerTest, FunctionShapeInferenceWorksForResourceHandles) {
   FunctionDefLibrary f_lib_proto;
   *(f_lib_proto.add_function()) = test::function::Swap();
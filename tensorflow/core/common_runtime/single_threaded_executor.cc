@@ -314,6 +314,7 @@ class SingleThreadedExecutorImpl : public Executor {
     params.session_state = args.session_state;
     params.session_metadata = params_.session_metadata;
     params.tensor_store = args.tensor_store;
+    params.buffer_cache = args.buffer_cache;
     params.cancellation_manager = args.cancellation_manager;
     params.session_config = args.session_config;
     params.call_frame = args.call_frame;
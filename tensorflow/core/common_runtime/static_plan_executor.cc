@@ -0,0 +1,639 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/static_plan_executor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/container/inlined_vector.h"
+#include "tensorflow/core/common_runtime/entry.h"
+#include "tensorflow/core/common_runtime/executor.h"
+#include "tensorflow/core/common_runtime/executor_factory.h"
+#include "tensorflow/core/common_runtime/renamed_device.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/graph/algorithm.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
+
+namespace tensorflow {
+namespace {
+
+typedef absl::InlinedVector<TensorValue, 4UL> TensorValueVec;
+typedef absl::InlinedVector<AllocatorAttributes, 4UL> AllocatorAttributeVec;
+// Indices into `StaticPlanExecutorImpl::kernels_`.
+typedef absl::InlinedVector<int, 8UL> KernelIdVec;
+
+static const string& kStaticPlanExecutor =
+    *new string("STATIC_PLAN_EXECUTOR");
+
+absl::Status ValidateOpIsSafeForStaticPlan(const Node& n) {
+  for (DataType dt : n.output_types()) {
+    if (IsRefType(dt)) {
+      return errors::Unimplemented(
+          "Static plan executor does not support reference-typed edges. But "
+          "saw type ",
+          DataTypeString(dt), " in outputs of node ", n.name());
+    }
+  }
+  if (n.IsControlFlow()) {
+    return errors::FailedPrecondition(
+        "Static plan executor does not support low level control flow, but "
+        "saw control flow node ",
+        n.name(),
+        ". Perhaps your graph contains old-style control flow primitives? "
+        "Try using tf.compat.v1.enable_control_flow_v2().");
+  }
+  return absl::OkStatus();
+}
+
+class StaticPlanExecutorImpl : public Executor {
+ public:
+  explicit StaticPlanExecutorImpl(const LocalExecutorParams& params)
+      : params_(params) {}
+
+  ~StaticPlanExecutorImpl() override {
+    for (const KernelState& kernel_state : kernels_) {
+      if (kernel_state.kernel != nullptr) {
+        params_.delete_kernel(kernel_state.kernel);
+      }
+    }
+  }
+
+  absl::Status Initialize(const Graph& graph) {
+    // Topologically sort `graph` to get a sequence of OpKernels.
+    std::vector<Node*> ordered_nodes;
+    ordered_nodes.reserve(graph.num_nodes());
+    GetReversePostOrder(graph, &ordered_nodes);
+    if (ordered_nodes.size() != graph.num_nodes()) {
+      return errors::InvalidArgument("Graph had ", graph.num_nodes(),
+                                     " but reverse post-order had ",
+                                     ordered_nodes.size());
+    }
+
+    // Assign a kernel index to every node except the source and sink, and
+    // lay out the inputs of each kernel contiguously in the flat `inputs`
+    // vector of a step.
+    std::vector<int> node_to_kernel(graph.num_node_ids(), -1);
+    std::vector<const Node*> kernel_nodes;
+    kernel_nodes.reserve(ordered_nodes.size());
+    kernels_.reserve(ordered_nodes.size());
+    size_t input_start_index = 0;
+    for (Node* n : ordered_nodes) {
+      if (n->IsSource() || n->IsSink()) continue;
+      TF_RETURN_IF_ERROR(ValidateOpIsSafeForStaticPlan(*n));
+
+      kernels_.emplace_back();
+      KernelState& kernel_state = kernels_.back();
+      TF_RETURN_IF_ERROR(
+          params_.create_kernel(n->properties(), &kernel_state.kernel));
+      kernel_state.is_async = kernel_state.kernel->AsAsync() != nullptr;
+      kernel_state.is_expensive = kernel_state.kernel->IsExpensive();
+      kernel_state.input_start_index = input_start_index;
+      kernel_state.num_inputs = n->num_inputs();
+      kernel_state.num_outputs = n->num_outputs();
+      input_start_index += kernel_state.num_inputs;
+
+      kernel_state.output_alloc_attrs.resize(kernel_state.num_outputs);
+      for (size_t j = 0; j < kernel_state.num_outputs; ++j) {
+        if (kernel_state.kernel->output_memory_types()[j] == HOST_MEMORY) {
+          kernel_state.output_alloc_attrs[j].set_on_host(true);
+        }
+      }
+
+      node_to_kernel[n->id()] = kernels_.size() - 1;
+      kernel_nodes.push_back(n);
+    }
+    total_num_inputs_ = input_start_index;
+    input_alloc_attrs_.resize(total_num_inputs_);
+
+    // Resolve the edges of the graph into output locations, successor lists
+    // and the number of predecessors that each kernel waits for.
+    for (size_t i = 0; i < kernels_.size(); ++i) {
+      KernelState& kernel_state = kernels_[i];
+      kernel_state.output_locations.resize(kernel_state.num_outputs);
+      for (const Edge* e : kernel_nodes[i]->out_edges()) {
+        const int dst_id = node_to_kernel[e->dst()->id()];
+        // Edges into the sink node do not need to be tracked.
+        if (dst_id < 0) continue;
+        kernel_state.successors.push_back(dst_id);
+        if (!e->IsControlEdge()) {
+          const size_t location =
+              kernels_[dst_id].input_start_index + e->dst_input();
+          kernel_state.output_locations[e->src_output()].push_back(location);
+          input_alloc_attrs_[location] =
+              kernel_state.output_alloc_attrs[e->src_output()];
+        }
+      }
+      // Multiple edges between the same pair of nodes are counted once.
+      std::sort(kernel_state.successors.begin(),
+                kernel_state.successors.end());
+      kernel_state.successors.erase(
+          std::unique(kernel_state.successors.begin(),
+                      kernel_state.successors.end()),
+          kernel_state.successors.end());
+      for (int successor : kernel_state.successors) {
+        ++kernels_[successor].num_predecessors;
+      }
+    }
+
+    for (size_t i = 0; i < kernels_.size(); ++i) {
+      if (kernels_[i].num_predecessors == 0) root_kernels_.push_back(i);
+    }
+    return absl::OkStatus();
+  }
+
+ private:
+  class RunState;
+
+  void RunAsyncInternal(const Args& args, DoneCallback done) override;
+
+  const LocalExecutorParams params_;
+
+  // All following members are read-only after Initialize().
+
+  // The sum of the number of inputs for each kernel in the graph. This
+  // determines the length of the flat `inputs` vector of a step.
+  size_t total_num_inputs_ = 0;
+
+  // Represents cached graph structure state for each kernel.
+  struct KernelState {
+    // The kernel object. Not owned.
+    //
+    // This pointer is managed by `params_.create_kernel()` and
+    // `params_.delete_kernel()`.
+    OpKernel* kernel = nullptr;
+
+    bool is_async = false;
+    bool is_expensive = false;
+
+    // These fields determine the range of elements in `inputs` that corresponds
+    // to the inputs of `kernel`.
+    size_t input_start_index = 0;
+    size_t num_inputs = 0;
+
+    size_t num_outputs = 0;
+
+    // The number of distinct kernels (connected by data or control edges) that
+    // must complete before `kernel` can run.
+    int num_predecessors = 0;
+
+    // For the `j`th output of `kernel`, `output_locations[j]` contains the
+    // locations in the flat `inputs` vector to which that output must be
+    // copied.
+    std::vector<std::vector<size_t>>
+        output_locations;  // Length = `num_outputs`.
+
+    // Memory space information for each output of `kernel`.
+    std::vector<AllocatorAttributes>
+        output_alloc_attrs;  // Length = `num_outputs`.
+
+    // The distinct kernels that wait for `kernel` to complete.
+    std::vector<int> successors;
+  };
+  std::vector<KernelState> kernels_;
+
+  // The kernels that have no predecessors, and are ready at the start of a
+  // step.
+  std::vector<int> root_kernels_;
+
+  // Memory space information for each input. This information is stored in the
+  // same order as the flat `inputs` vector.
+  std::vector<AllocatorAttributes>
+      input_alloc_attrs_;  // Length = `total_num_inputs_`.
+
+  StaticPlanExecutorImpl(const StaticPlanExecutorImpl&) = delete;
+  void operator=(const StaticPlanExecutorImpl&) = delete;
+};
+
+// The state of a single step. A RunState deletes itself when the last kernel
+// of the step completes, before invoking the done callback.
+class StaticPlanExecutorImpl::RunState {
+ public:
+  RunState(const StaticPlanExecutorImpl* impl, const Args& args,
+           DoneCallback done)
+      : impl_(impl),
+        inputs_(impl->total_num_inputs_),
+        pending_(new std::atomic<int>[impl->kernels_.size()]),
+        rendezvous_(args.rendezvous),
+        collective_executor_(args.collective_executor),
+        cancellation_manager_(args.cancellation_manager),
+        runner_(args.runner),
+        sync_on_finish_(args.sync_on_finish),
+        done_(std::move(done)) {
+    for (size_t i = 0; i < impl_->kernels_.size(); ++i) {
+      pending_[i].store(impl_->kernels_[i].num_predecessors,
+                        std::memory_order_relaxed);
+    }
+
+    // Override intra op thread pool if requested.
+    device_ = impl_->params_.device;
+    if (args.user_intra_op_threadpool != nullptr) {
+      user_device_ = RenamedDevice::NewRenamedDevice(
+          device_->name(), device_, /*owns_underlying=*/false,
+          /*isolate_session_state=*/false, args.user_intra_op_threadpool);
+      device_ = user_device_.get();
+    }
+
+    // Prepare the parameters that will be the same for all kernels.
+    params_.step_id = args.step_id;
+    params_.device = device_;
+    params_.log_memory = false;
+    params_.rendezvous = args.rendezvous;
+    params_.session_state = args.session_state;
+    params_.session_metadata = impl_->params_.session_metadata;
+    params_.tensor_store = args.tensor_store;
+    params_.buffer_cache = args.buffer_cache;
+    params_.cancellation_manager = args.cancellation_manager;
+    params_.session_config = args.session_config;
+    params_.call_frame = args.call_frame;
+    params_.function_library = impl_->params_.function_library;
+    params_.resource_manager = device_->resource_manager();
+    params_.step_container = args.step_container;
+    params_.collective_executor = args.collective_executor;
+    params_.stack_trace = args.stack_trace;
+    params_.slice_reader_cache = nullptr;
+    params_.runner = &runner_;
+    params_.run_all_kernels_inline = args.run_all_kernels_inline;
+    params_.stats_collector = args.stats_collector;
+    params_.executor_type = &kStaticPlanExecutor;
+    params_.frame_iter = FrameAndIter(0, 0);
+    params_.is_input_dead = false;
+    params_.forward_from_array = nullptr;
+  }
+
+  ~RunState() {
+    if (params_.op_device_context != nullptr) {
+      params_.op_device_context->Unref();
+    }
+  }
+
+  void Start() {
+    absl::Status s =
+        impl_->params_.device->TryGetDeviceContext(&params_.op_device_context);
+    if (!s.ok() || impl_->root_kernels_.empty()) {
+      DoneCallback done = std::move(done_);
+      delete this;
+      done(s);
+      return;
+    }
+    KernelIdVec ready(impl_->root_kernels_.begin(),
+                      impl_->root_kernels_.end());
+    num_outstanding_kernels_.store(ready.size(), std::memory_order_relaxed);
+    ScheduleReady(&ready, nullptr);
+  }
+
+ private:
+  // A FIFO of kernels that are run on the current thread.
+  struct InlineQueue {
+    KernelIdVec ids;
+    size_t front = 0;
+    bool empty() const { return front == ids.size(); }
+    int pop_front() { return ids[front++]; }
+  };
+
+  // The state that must outlive the call to `ComputeAsync()`.
+  struct AsyncState {
+    AsyncState(const OpKernelContext::Params& p, const TensorValueVec* in,
+               const AllocatorAttributeVec* in_attrs, int num_outputs)
+        : saved_inputs(*in),
+          saved_input_alloc_attrs(*in_attrs),
+          params(p),
+          ctx(&params, num_outputs) {
+      params.inputs = saved_inputs;
+      params.input_alloc_attrs = saved_input_alloc_attrs;
+    }
+
+    TensorValueVec saved_inputs;
+    AllocatorAttributeVec saved_input_alloc_attrs;
+    OpKernelContext::Params params;
+    OpKernelContext ctx;
+  };
+
+  void RunTask(std::function<void()>&& fn) { runner_(std::move(fn)); }
+
+  // Runs the kernels in `inline_ready`, and any kernels that they make ready,
+  // on the current thread.
+  void Process(InlineQueue* inline_ready) {
+    KernelIdVec ready;
+    bool completed = false;
+    TensorValueVec inputs;
+    AllocatorAttributeVec input_alloc_attrs;
+    while (!inline_ready->empty()) {
+      const int id = inline_ready->pop_front();
+      const KernelState& kernel_state = impl_->kernels_[id];
+
+      absl::Status s = PrepareInputs(kernel_state, &inputs, &input_alloc_attrs);
+      if (s.ok()) {
+        OpKernelContext::Params params = params_;
+        params.inputs = inputs;
+        params.input_alloc_attrs = input_alloc_attrs;
+        params.op_kernel = kernel_state.kernel;
+        params.output_attr_array = kernel_state.output_alloc_attrs.data();
+        if (kernel_state.is_async) {
+          ProcessAsync(id, params, &inputs, &input_alloc_attrs);
+          continue;
+        }
+        OpKernelContext ctx(&params, kernel_state.num_outputs);
+        device_->Compute(kernel_state.kernel, &ctx);
+        ClearInputs(kernel_state);
+        s = ctx.status();
+        if (s.ok()) s = PropagateOutputs(kernel_state, &ctx, &ready);
+      } else {
+        ClearInputs(kernel_state);
+      }
+      completed = KernelDone(s, &ready, inline_ready);
+    }
+    if (completed) Finish();
+  }
+
+  void ProcessAsync(int id, const OpKernelContext::Params& params,
+                    const TensorValueVec* inputs,
+                    const AllocatorAttributeVec* input_alloc_attrs) {
+    const KernelState& kernel_state = impl_->kernels_[id];
+    AsyncState* state = new AsyncState(params, inputs, input_alloc_attrs,
+                                       kernel_state.num_outputs);
+    auto done = [this, state, id]() {
+      const KernelState& kernel_state = impl_->kernels_[id];
+      ClearInputs(kernel_state);
+      KernelIdVec ready;
+      absl::Status s = state->ctx.status();
+      if (s.ok()) s = PropagateOutputs(kernel_state, &state->ctx, &ready);
+      delete state;
+      if (KernelDone(s, &ready, nullptr)) Finish();
+    };
+    device_->ComputeAsync(kernel_state.kernel->AsAsync(), &state->ctx,
+                          std::move(done));
+  }
+
+  absl::Status PrepareInputs(const KernelState& kernel_state,
+                             TensorValueVec* inputs,
+                             AllocatorAttributeVec* input_alloc_attrs) {
+    inputs->resize(kernel_state.num_inputs);
+    input_alloc_attrs->resize(kernel_state.num_inputs);
+    for (size_t j = 0; j < kernel_state.num_inputs; ++j) {
+      const size_t location = kernel_state.input_start_index + j;
+      Entry& input = inputs_[location];
+      switch (input.state) {
+        case Entry::State::HAS_VALUE:
+          (*inputs)[j].tensor = input.val.get();
+          break;
+        case Entry::State::HAS_CONST_TENSOR:
+          (*inputs)[j].tensor = const_cast<Tensor*>(input.const_tensor);
+          break;
+        default:
+          return errors::Internal("Input ", j, " of node ",
+                                  kernel_state.kernel->name(),
+                                  " was not provided.");
+      }
+      (*input_alloc_attrs)[j] = impl_->input_alloc_attrs_[location];
+    }
+    return absl::OkStatus();
+  }
+
+  // Frees the inputs of a kernel once it has run.
+  void ClearInputs(const KernelState& kernel_state) {
+    for (size_t j = 0; j < kernel_state.num_inputs; ++j) {
+      inputs_[kernel_state.input_start_index + j].ClearVal();
+    }
+  }
+
+  // Forwards the outputs of a kernel to the inputs of its consumers, and
+  // appends the successors that become ready to `ready`.
+  absl::Status PropagateOutputs(const KernelState& kernel_state,
+                                OpKernelContext* ctx, KernelIdVec* ready) {
+    for (size_t j = 0; j < kernel_state.num_outputs; ++j) {
+      const std::vector<size_t>& locations = kernel_state.output_locations[j];
+      if (locations.empty()) continue;
+      std::unique_ptr<Tensor> val(ctx->release_output(j).tensor);
+      if (val == nullptr) {
+        return errors::Unimplemented(
+            "Static plan executor does not support dead tensors, but output ",
+            j, " of node ", kernel_state.kernel->name(), " was not produced.");
+      }
+      const size_t num_destinations = locations.size();
+      for (size_t k = 0; k < num_destinations - 1; ++k) {
+        Entry& input = inputs_[locations[k]];
+        input.state = Entry::State::HAS_VALUE;
+        input.val.Init(*val);
+      }
+      // Move the output to the last consumer to avoid the cost of copying it,
+      // and so that a sole consumer can forward the buffer.
+      Entry& input = inputs_[locations[num_destinations - 1]];
+      input.state = Entry::State::HAS_VALUE;
+      input.val.Init(std::move(*val));
+    }
+    // The acquire-release decrement publishes the inputs written above to
+    // whichever thread runs the successor.
+    for (int successor : kernel_state.successors) {
+      if (pending_[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        ready->push_back(successor);
+      }
+    }
+    return absl::OkStatus();
+  }
+
+  // Accounts for a completed kernel, and schedules the kernels in `ready`.
+  // Returns true if the step has completed, in which case the caller must
+  // call `Finish()`.
+  bool KernelDone(const absl::Status& s, KernelIdVec* ready,
+                  InlineQueue* inline_ready) {
+    if (!s.ok()) {
+      bool abort_run = false;
+      {
+        mutex_lock l(mu_);
+        if (status_.ok()) {
+          abort_run = true;
+          status_ = s;
+        }
+      }
+      if (abort_run) {
+        if (rendezvous_ != nullptr) rendezvous_->StartAbort(s);
+        if (cancellation_manager_ != nullptr) {
+          cancellation_manager_->StartCancelWithStatus(s);
+        } else if (collective_executor_ != nullptr) {
+          collective_executor_->StartAbort(s);
+        }
+      }
+      // The successors of a failed kernel never run, so the step completes
+      // once the kernels that are already outstanding are done.
+      ready->clear();
+    }
+    if (ready->empty()) {
+      return num_outstanding_kernels_.fetch_sub(1) == 1;
+    }
+    // The current kernel is replaced by the first ready kernel.
+    if (ready->size() > 1) {
+      num_outstanding_kernels_.fetch_add(ready->size() - 1,
+                                         std::memory_order_relaxed);
+    }
+    ScheduleReady(ready, inline_ready);
+    return false;
+  }
+
+  // Cheap kernels are appended to `inline_ready`, and expensive kernels get a
+  // closure of their own. If `inline_ready` is null, all cheap kernels are
+  // batched into a single closure.
+  void ScheduleReady(KernelIdVec* ready, InlineQueue* inline_ready) {
+    if (params_.run_all_kernels_inline) {
+      if (inline_ready == nullptr) {
+        RunTask([this, ids = std::move(*ready)]() {
+          InlineQueue queue{ids};
+          Process(&queue);
+        });
+      } else {
+        inline_ready->ids.insert(inline_ready->ids.end(), ready->begin(),
+                                 ready->end());
+      }
+      ready->clear();
+      return;
+    }
+
+    KernelIdVec cheap;
+    int curr_expensive = -1;
+    for (int id : *ready) {
+      if (!impl_->kernels_[id].is_expensive) {
+        if (inline_ready != nullptr) {
+          inline_ready->ids.push_back(id);
+        } else {
+          cheap.push_back(id);
+        }
+        continue;
+      }
+      if (curr_expensive >= 0) {
+        RunTask([this, curr_expensive]() {
+          InlineQueue queue{{curr_expensive}};
+          Process(&queue);
+        });
+      }
+      curr_expensive = id;
+    }
+    ready->clear();
+    if (curr_expensive >= 0) {
+      if (inline_ready != nullptr && inline_ready->empty()) {
+        // Nothing else is left to run on this thread, so run the last
+        // expensive kernel here instead of paying for a dispatch.
+        inline_ready->ids.push_back(curr_expensive);
+      } else {
+        RunTask([this, curr_expensive]() {
+          InlineQueue queue{{curr_expensive}};
+          Process(&queue);
+        });
+      }
+    }
+    if (!cheap.empty()) {
+      RunTask([this, cheap = std::move(cheap)]() {
+        InlineQueue queue{cheap};
+        Process(&queue);
+      });
+    }
+  }
+
+  void Finish() {
+    absl::Status status;
+    {
+      mutex_lock l(mu_);
+      status = status_;
+    }
+    DoneCallback done = std::move(done_);
+    Args::Runner runner = std::move(runner_);
+    Device* device = impl_->params_.device;
+    if (sync_on_finish_ && status.ok()) {
+      // Block until the device has finished all queued operations.
+      device->Sync([this, runner = std::move(runner),
+                    done = std::move(done)](const absl::Status& s) {
+        delete this;
+        runner([s, done = std::move(done)]() { done(s); });
+      });
+      return;
+    }
+    delete this;
+    runner([status, done = std::move(done)]() { done(status); });
+  }
+
+  const StaticPlanExecutorImpl* const impl_;
+
+  // The flat vector of kernel inputs for this step.
+  std::vector<Entry> inputs_;
+
+  // The number of predecessors that each kernel is still waiting for.
+  std::unique_ptr<std::atomic<int>[]> pending_;
+
+  // The number of kernels that are ready or running.
+  std::atomic<int64_t> num_outstanding_kernels_{0};
+
+  RendezvousInterface* const rendezvous_;
+  CollectiveExecutor* const collective_executor_;
+  CancellationManager* const cancellation_manager_;
+  Args::Runner runner_;
+  const bool sync_on_finish_;
+  DoneCallback done_;
+
+  Device* device_;
+  std::unique_ptr<Device> user_device_;
+
+  // The parameters that are the same for all kernels of this step.
+  OpKernelContext::Params params_;
+
+  mutex mu_;
+  absl::Status status_ TF_GUARDED_BY(mu_);
+
+  RunState(const RunState&) = delete;
+  void operator=(const RunState&) = delete;
+};
+
+void StaticPlanExecutorImpl::RunAsyncInternal(const Args& args,
+                                              DoneCallback done) {
+  (new RunState(this, args, std::move(done)))->Start();
+}
+
+class StaticPlanExecutorRegistrar {
+ public:
+  StaticPlanExecutorRegistrar() {
+    ExecutorFactory::Register(kStaticPlanExecutor, new Factory());
+  }
+
+ private:
+  class Factory : public ExecutorFactory {
+    absl::Status NewExecutor(const LocalExecutorParams& params,
+                             const Graph& graph,
+                             std::unique_ptr<Executor>* out_executor) override {
+      Executor* ret;
+      TF_RETURN_IF_ERROR(NewStaticPlanExecutor(params, graph, &ret));
+      out_executor->reset(ret);
+      return absl::OkStatus();
+    }
+  };
+};
+static StaticPlanExecutorRegistrar registrar;
+
+}  // namespace
+
+absl::Status NewStaticPlanExecutor(const LocalExecutorParams& params,
+                                   const Graph& graph, Executor** executor) {
+  auto impl = std::make_unique<StaticPlanExecutorImpl>(params);
+  TF_RETURN_IF_ERROR(impl->Initialize(graph));
+  *executor = impl.release();
+  return absl::OkStatus();
+}
+
+}  // namespace tensorflow
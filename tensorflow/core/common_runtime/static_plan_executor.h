@@ -0,0 +1,58 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_STATIC_PLAN_EXECUTOR_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_STATIC_PLAN_EXECUTOR_H_
+
+#include "tensorflow/core/common_runtime/executor.h"
+
+namespace tensorflow {
+
+// Creates a new `Executor` for executing `graph`, which must not contain
+// control flow, on multiple threads by following a plan that is computed once
+// when the executor is created.
+//
+// At creation time the graph is sorted topologically, and for every kernel the
+// executor precomputes the offset of its inputs in a flat per-step array of
+// input slots, the slots that each of its outputs is copied to, and the number
+// of predecessors that it has to wait for. Running a step only copies the
+// initial pending counts and decrements them as kernels complete; there are no
+// frames, iterations or deadness to track. An output is moved (instead of
+// copied) into the slot of its last consumer, so that a kernel that is the only
+// consumer of an input may forward its buffer.
+//
+// Kernels are run inline on the thread that made them ready, unless they are
+// expensive (see `OpKernel::IsExpensive()`), in which case they are dispatched
+// to `Executor::Args::runner`. Asynchronous kernels, including "_Recv", are
+// supported, so the executor can run partitioned graphs.
+//
+// The current implementation has the following limitations:
+//
+// 1. Reference-typed tensors are not supported.
+// 2. Graphs with control flow are not supported. Dead tensors received from
+//    other partitions are reported as errors.
+// 3. Step stats and memory logging are not supported.
+// 4. Ops that defer work (via `OpKernelContext::inc_num_deferred_ops()`) and
+//    ops that rely on `OpKernelContext::slice_reader_cache()` being non-null
+//    are not supported.
+//
+// This executor is also registered under the "STATIC_PLAN_EXECUTOR" executor
+// type.
+absl::Status NewStaticPlanExecutor(const LocalExecutorParams& params,
+                                   const Graph& graph, Executor** executor);
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_STATIC_PLAN_EXECUTOR_H_
@@ -26,9 +26,12 @@ info. It does not have any negative impact on performance. */
 #endif
 #endif  // ENABLE_ONEDNN_OPENMP && ENABLE_MKL &&_OPENMP
 
+#include <vector>
+
 #include "absl/base/call_once.h"
 #include "absl/container/flat_hash_set.h"
 #include "tensorflow/core/common_runtime/local_device.h"
+#include "tensorflow/core/common_runtime/process_util.h"
 #include "tensorflow/core/common_runtime/scoped_allocator.h"
 #include "tensorflow/core/common_runtime/scoped_allocator_mgr.h"
 #include "tensorflow/core/common_runtime/threadpool_device.h"
@@ -41,6 +44,8 @@ info. It does not have any negative impact on performance. */
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/graph/types.h"
 #include "tensorflow/core/lib/hash/hash.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/numa.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/public/session_options.h"
 #include "tensorflow/core/util/port.h"
@@ -53,6 +58,28 @@ info. It does not have any negative impact on performance. */
 
 namespace tensorflow {
 
+namespace {
+
+// Returns the process-wide inter op thread pool for `numa_node`. Like the
+// intra op thread pools in LocalDevice, the pool is created with the options of
+// the first session that asks for it, and is never deleted.
+thread::ThreadPool* NUMAInterOpThreadPool(const SessionOptions& options,
+                                          int numa_node) {
+  static mutex* mu = new mutex;
+  static auto* pools = new std::vector<thread::ThreadPool*>;
+  mutex_lock l(*mu);
+  if (static_cast<size_t>(numa_node) >= pools->size()) {
+    pools->resize(numa_node + 1, nullptr);
+  }
+  if ((*pools)[numa_node] == nullptr) {
+    (*pools)[numa_node] =
+        NewNUMAThreadPoolFromSessionOptions(options, numa_node);
+  }
+  return (*pools)[numa_node];
+}
+
+}  // namespace
+
 ThreadPoolDevice::ThreadPoolDevice(const SessionOptions& options,
                                    const string& name, Bytes memory_limit,
                                    const DeviceLocality& locality,
@@ -72,6 +99,16 @@ ThreadPoolDevice::ThreadPoolDevice(const SessionOptions& options,
     }
   }
 
+  // With NUMA affinity, run the inter op work of this device on threads bound
+  // to its node, next to its intra op threads and its memory, instead of on
+  // the session-wide inter op pool.
+  if (options.config.experimental().use_numa_affinity() &&
+      locality.numa_node() != port::kNUMANoAffinity &&
+      port::NUMANumNodes() > 1) {
+    set_tensorflow_device_thread_pool(
+        NUMAInterOpThreadPool(options, locality.numa_node()));
+  }
+
 #if defined(ENABLE_ONEDNN_OPENMP) && defined(INTEL_MKL)
   // Early return when MKL is disabled
   if (!IsMKLEnabled()) return;
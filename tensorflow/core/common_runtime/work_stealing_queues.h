@@ -0,0 +1,134 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_WORK_STEALING_QUEUES_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_WORK_STEALING_QUEUES_H_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+
+namespace tensorflow {
+
+// WorkStealingQueues is an internal helper class holding one double-ended
+// queue per worker, for use in the ExecutorState module when ready nodes are
+// distributed among inter-op workers instead of being dispatched as one
+// closure per node.
+//
+// A worker pushes and pops at the back of its own queue, so that a node is
+// usually run by the thread that made it ready while its inputs are still hot
+// in cache. When its own queue is empty, a worker steals from the front of the
+// other queues, which takes the oldest (and typically largest) pieces of
+// outstanding work.
+//
+//    WorkStealingQueues<int> queues(num_workers);
+//    queues.Push(my_id, 17);
+//    ...
+//    while (std::optional<int> value = queues.PopOrSteal(my_id)) { ... }
+//
+// All methods are thread-safe.
+template <typename T>
+class WorkStealingQueues {
+ public:
+  explicit WorkStealingQueues(int num_queues)
+      : num_queues_(num_queues), queues_(new Queue[num_queues]) {
+    CHECK_GT(num_queues, 0);
+  }
+
+  int num_queues() const { return num_queues_; }
+
+  // Adds `value` to the back of the queue owned by `queue_id`.
+  void Push(int queue_id, T value) {
+    DCHECK_GE(queue_id, 0);
+    DCHECK_LT(queue_id, num_queues_);
+    Queue& q = queues_[queue_id];
+    {
+      mutex_lock l(q.mu);
+      q.items.push_back(std::move(value));
+    }
+    size_.fetch_add(1);
+  }
+
+  // Removes and returns the most recently pushed element of the queue owned
+  // by `queue_id`. Returns std::nullopt if that queue is empty.
+  std::optional<T> Pop(int queue_id) {
+    DCHECK_GE(queue_id, 0);
+    DCHECK_LT(queue_id, num_queues_);
+    Queue& q = queues_[queue_id];
+    mutex_lock l(q.mu);
+    if (q.items.empty()) return std::nullopt;
+    std::optional<T> value(std::move(q.items.back()));
+    q.items.pop_back();
+    size_.fetch_sub(1);
+    return value;
+  }
+
+  // Removes and returns the oldest element of some queue other than the one
+  // owned by `thief_id`. Victims are visited in order, starting with the
+  // neighbour of `thief_id`, so that concurrent thieves tend to pick different
+  // victims. Returns std::nullopt if all other queues are empty.
+  std::optional<T> Steal(int thief_id) {
+    for (int i = 1; i < num_queues_; ++i) {
+      if (size_.load(std::memory_order_relaxed) == 0) return std::nullopt;
+      Queue& q = queues_[(thief_id + i) % num_queues_];
+      mutex_lock l(q.mu);
+      if (q.items.empty()) continue;
+      std::optional<T> value(std::move(q.items.front()));
+      q.items.pop_front();
+      size_.fetch_sub(1);
+      return value;
+    }
+    return std::nullopt;
+  }
+
+  // Pops from the queue owned by `queue_id`, and steals from the other queues
+  // if that one is empty.
+  std::optional<T> PopOrSteal(int queue_id) {
+    std::optional<T> value = Pop(queue_id);
+    if (!value.has_value()) value = Steal(queue_id);
+    return value;
+  }
+
+  // Returns true if no queue holds an element. Elements pushed by
+  // `Push()` calls that happen before this call are always observed.
+  bool Empty() const { return size_.load() == 0; }
+
+ private:
+  // Padded to a cache line so that workers operating on their own queues do
+  // not contend with each other.
+  struct alignas(64) Queue {
+    mutex mu;
+    std::deque<T> items TF_GUARDED_BY(mu);
+  };
+
+  const int num_queues_;
+  std::unique_ptr<Queue[]> queues_;
+  // Total number of elements in all queues.
+  std::atomic<int64_t> size_{0};
+
+  WorkStealingQueues(const WorkStealingQueues&) = delete;
+  void operator=(const WorkStealingQueues&) = delete;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_WORK_STEALING_QUEUES_H_
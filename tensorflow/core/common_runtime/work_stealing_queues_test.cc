@@ -0,0 +1,94 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/work_stealing_queues.h"
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "tensorflow/core/lib/core/threadpool.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+
+TEST(WorkStealingQueues, PopIsLifo) {
+  WorkStealingQueues<int> queues(2);
+  queues.Push(0, 1);
+  queues.Push(0, 2);
+  queues.Push(0, 3);
+  EXPECT_EQ(queues.Pop(0), 3);
+  EXPECT_EQ(queues.Pop(0), 2);
+  EXPECT_EQ(queues.Pop(1), std::nullopt);
+  EXPECT_FALSE(queues.Empty());
+}
+
+TEST(WorkStealingQueues, StealIsFifo) {
+  WorkStealingQueues<int> queues(3);
+  queues.Push(1, 1);
+  queues.Push(1, 2);
+  // Never steals from its own queue.
+  EXPECT_EQ(queues.Steal(1), std::nullopt);
+  EXPECT_EQ(queues.Steal(0), 1);
+  EXPECT_EQ(queues.PopOrSteal(2), 2);
+  EXPECT_TRUE(queues.Empty());
+  EXPECT_EQ(queues.PopOrSteal(0), std::nullopt);
+}
+
+TEST(WorkStealingQueues, SingleQueue) {
+  WorkStealingQueues<int> queues(1);
+  queues.Push(0, 7);
+  EXPECT_EQ(queues.Steal(0), std::nullopt);
+  EXPECT_EQ(queues.PopOrSteal(0), 7);
+  EXPECT_TRUE(queues.Empty());
+}
+
+TEST(WorkStealingQueues, ConcurrentPushAndSteal) {
+  const int kNumWorkers = 8;
+  const int kItemsPerWorker = 10000;
+  WorkStealingQueues<int> queues(kNumWorkers);
+  std::vector<std::atomic<int>> seen(kNumWorkers * kItemsPerWorker);
+  for (auto& s : seen) s = 0;
+  {
+    thread::ThreadPool pool(Env::Default(), "test", kNumWorkers);
+    for (int w = 0; w < kNumWorkers; ++w) {
+      pool.Schedule([&queues, &seen, w]() {
+        for (int i = 0; i < kItemsPerWorker; ++i) {
+          queues.Push(w, w * kItemsPerWorker + i);
+          // Drain a little in between pushes so that pops, steals and pushes
+          // race with each other.
+          if (i % 3 != 0) continue;
+          if (std::optional<int> value = queues.PopOrSteal(w)) {
+            seen[*value].fetch_add(1);
+          }
+        }
+        while (std::optional<int> value = queues.PopOrSteal(w)) {
+          seen[*value].fetch_add(1);
+        }
+      });
+    }
+  }
+  while (std::optional<int> value = queues.PopOrSteal(0)) {
+    seen[*value].fetch_add(1);
+  }
+  EXPECT_TRUE(queues.Empty());
+  for (int i = 0; i < seen.size(); ++i) {
+    EXPECT_EQ(seen[i].load(), 1) << i;
+  }
+}
+
+}  // namespace tensorflow
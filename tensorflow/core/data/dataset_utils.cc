@@ -19,6 +19,7 @@ limitations under the License.
 #include <array>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <queue>
@@ -32,6 +33,7 @@ limitations under the License.
 #include "absl/status/status.h"
 #include "absl/strings/str_join.h"
 #include "tensorflow/core/common_runtime/function.h"
+#include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/attr_value.pb.h"
 #include "tensorflow/core/framework/dataset.h"
 #include "tensorflow/core/framework/function.h"
@@ -88,9 +90,11 @@ constexpr char kMapAndBatchFusionOpt[] = "map_and_batch_fusion";
 constexpr char kNoopEliminationOpt[] = "noop_elimination";
 constexpr char kMapParallelizationOpt[] = "map_parallelization";
 constexpr char kShuffleAndRepeatFusionOpt[] = "shuffle_and_repeat_fusion";
+constexpr char kDecodeAndCropFusionOpt[] = "decode_and_crop_fusion";
 constexpr char kFilterFusionOpt[] = "filter_fusion";
 constexpr char kMapAndFilterFusionOpt[] = "map_and_filter_fusion";
 constexpr char kMapFusionOpt[] = "map_fusion";
+constexpr char kMapVectorizationOpt[] = "map_vectorization";
 constexpr char kParallelBatchOpt[] = "parallel_batch";
 constexpr char kAutotuneBufferSizesOpt[] = "autotune_buffer_sizes";
 constexpr char kDisablePrefetchLegacyAutotuneOpt[] =
@@ -145,6 +149,14 @@ void DefaultOptimizationGraphRewrites(
   if (OpDeterminismRequired()) {
     optimization_enabled->insert(kMakeDeterministicOpt);
   }
+  if (optimization_options.optional_decode_and_crop_fusion_case() ==
+      OptimizationOptions::kDecodeAndCropFusion) {
+    if (optimization_options.decode_and_crop_fusion()) {
+      optimization_enabled->insert(kDecodeAndCropFusionOpt);
+    } else {
+      optimization_disabled->insert(kDecodeAndCropFusionOpt);
+    }
+  }
   if (optimization_options.optional_filter_fusion_case() ==
       OptimizationOptions::kFilterFusion) {
     if (optimization_options.filter_fusion()) {
@@ -193,6 +205,14 @@ void DefaultOptimizationGraphRewrites(
       optimization_disabled->insert(kMapFusionOpt);
     }
   }
+  if (optimization_options.optional_map_vectorization_case() ==
+      OptimizationOptions::kMapVectorization) {
+    if (optimization_options.map_vectorization()) {
+      optimization_enabled->insert(kMapVectorizationOpt);
+    } else {
+      optimization_disabled->insert(kMapVectorizationOpt);
+    }
+  }
   if (optimization_options.optional_noop_elimination_case() ==
       OptimizationOptions::kNoopElimination) {
     if (optimization_options.noop_elimination()) {
@@ -625,6 +645,53 @@ Tensor MaybeCopySubSlice(const Tensor& tensor, int64 index) {
   }
 }
 
+void StagePageableComponents(Allocator* allocator,
+                             std::vector<Tensor>* components) {
+  std::vector<size_t> to_stage;
+  std::vector<int64_t> offsets;
+  int64_t total_bytes = 0;
+  for (size_t i = 0; i < components->size(); ++i) {
+    const Tensor& component = (*components)[i];
+    // Empty tensors may have no buffer to get the memory type of.
+    if (component.TotalBytes() == 0 ||
+        !DataTypeCanUseMemcpy(component.dtype()) ||
+        component.GetMemoryType() != AllocatorMemoryType::kHostPageable) {
+      continue;
+    }
+    to_stage.push_back(i);
+    offsets.push_back(total_bytes);
+    // Keep every packed component aligned like a standalone allocation.
+    const int64_t alignment = Allocator::kAllocatorAlignment;
+    total_bytes +=
+        (component.TotalBytes() + alignment - 1) / alignment * alignment;
+  }
+  if (to_stage.empty()) return;
+  if (to_stage.size() == 1) {
+    Tensor& component = (*components)[to_stage[0]];
+    Tensor staged(allocator, component.dtype(), component.shape());
+    if (!staged.IsInitialized()) return;
+    std::memcpy(const_cast<char*>(staged.tensor_data().data()),
+                component.tensor_data().data(), component.TotalBytes());
+    component = std::move(staged);
+    return;
+  }
+  Tensor packed(allocator, DT_UINT8, TensorShape({total_bytes}));
+  if (!packed.IsInitialized()) return;
+  for (size_t k = 0; k < to_stage.size(); ++k) {
+    Tensor& component = (*components)[to_stage[k]];
+    Tensor slice =
+        packed.Slice(offsets[k], offsets[k] + component.TotalBytes());
+    std::memcpy(slice.data(), component.tensor_data().data(),
+                component.TotalBytes());
+    Tensor staged;
+    if (!staged.BitcastFrom(slice, component.dtype(), component.shape())
+             .ok()) {
+      continue;
+    }
+    component = std::move(staged);
+  }
+}
+
 void StripDevicePlacement(FunctionDefLibrary* library) {
   for (auto& function : (*library->mutable_function())) {
     for (auto& node : (*function.mutable_node_def())) {
@@ -798,12 +865,18 @@ absl::Status CopyBatch(AnyContext ctx,
   const size_t num_tuple_components = batch_elements.at(0).size();
   out_tensors->reserve(num_tuple_components);
   const int64_t num_batch_elements = batch_elements.size();
+  // The shapes of the first element are captured up front because the first
+  // element is moved into the batch while the other elements are still being
+  // checked against it.
+  std::vector<TensorShape> first_element_shapes;
+  first_element_shapes.reserve(num_tuple_components);
+  int64_t total_bytes = 0;
   for (size_t component_index = 0; component_index < num_tuple_components;
        ++component_index) {
     const Tensor& first_element = batch_elements.at(0)[component_index];
-    TensorShape first_element_shape(first_element.shape());
+    first_element_shapes.push_back(first_element.shape());
     TensorShape batch_component_shape({num_batch_elements});
-    batch_component_shape.AppendShape(first_element_shape);
+    batch_component_shape.AppendShape(first_element_shapes.back());
     out_tensors->emplace_back(ctx.allocator, first_element.dtype(),
                               batch_component_shape);
     if (!out_tensors->back().IsInitialized()) {
@@ -811,66 +884,67 @@ absl::Status CopyBatch(AnyContext ctx,
           "Failed to allocate memory for the batch of component ",
           component_index);
     }
-  }
-  for (size_t component_index = 0; component_index < num_tuple_components;
-       ++component_index) {
-    Tensor& batch_component = out_tensors->at(component_index);
-    const Tensor& first_element = batch_elements.at(0)[component_index];
-    TensorShape first_element_shape(first_element.shape());
-    // Build the output tuple component by copying one slice from each input
-    // element in the batch.
-    auto copy_element_fn = [component_index, &batch_elements, &batch_component,
-                            &first_element_shape](int index) {
-      if (batch_elements.at(index)[component_index].shape() !=
-          first_element_shape) {
-        return errors::InvalidArgument(
-            "Cannot batch tensors with different shapes in component ",
-            component_index, ". First element had shape ",
-            first_element_shape.DebugString(), " and element ", index,
-            " had shape ",
-            batch_elements.at(index)[component_index].shape().DebugString(),
-            ".");
-      }
-      return batch_util::CopyElementToSlice(
-          std::move(batch_elements.at(index)[component_index]),
-          &batch_component, index);
-    };
-    const auto total_bytes =
-        first_element.AllocatedBytes() * num_batch_elements;
-    // Use parallelism for creating the batch as long as the final batch is at
-    // least 1MB.
-    if (parallel_copy && total_bytes >= (1 << 20)) {
-      absl::Status status;
-      mutex status_mu;
-      const auto num_threads = ctx.runner_threadpool_size;
-      const auto slice_size = num_batch_elements / num_threads;
-      int64_t offset = 0;
-      BlockingCounter counter(num_threads);
-      for (size_t i = 0; i < num_threads; ++i) {
-        int64_t length = slice_size;
-        // When the number of threads does not divide the number of elements
-        // evenly, the size of some slices is incremented to guarantee their
-        // sizes add up to the total number of elements.
-        if (i < num_batch_elements % num_threads) ++length;
-        (*ctx.runner)([offset, length, &status, &status_mu, &counter,
-                       &copy_element_fn]() {
-          absl::Status s;
-          for (size_t j = offset; j < offset + length; ++j) {
-            s.Update(copy_element_fn(j));
-          }
-          {
-            mutex_lock l(status_mu);
-            status.Update(s);
+    total_bytes += first_element.AllocatedBytes() * num_batch_elements;
+  }
+  // Build the output tuple by copying one slice from each input element in the
+  // batch into every component.
+  auto copy_element_fn = [&batch_elements, &first_element_shapes, out_tensors](
+                             size_t component_index, int64_t index) {
+    if (batch_elements.at(index)[component_index].shape() !=
+        first_element_shapes[component_index]) {
+      return errors::InvalidArgument(
+          "Cannot batch tensors with different shapes in component ",
+          component_index, ". First element had shape ",
+          first_element_shapes[component_index].DebugString(), " and element ",
+          index, " had shape ",
+          batch_elements.at(index)[component_index].shape().DebugString(), ".");
+    }
+    return batch_util::CopyElementToSlice(
+        std::move(batch_elements.at(index)[component_index]),
+        &out_tensors->at(component_index), index);
+  };
+  // Use parallelism for creating the batch as long as the final batch is at
+  // least 1MB. The threshold applies to the batch as a whole, and each task
+  // copies all components of a range of elements, so that elements with many
+  // small components (e.g. hundreds of parsed features) are copied in a single
+  // parallel pass rather than one synchronized pass per component.
+  if (parallel_copy && total_bytes >= (1 << 20)) {
+    absl::Status status;
+    mutex status_mu;
+    const auto num_threads = ctx.runner_threadpool_size;
+    const auto slice_size = num_batch_elements / num_threads;
+    int64_t offset = 0;
+    BlockingCounter counter(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+      int64_t length = slice_size;
+      // When the number of threads does not divide the number of elements
+      // evenly, the size of some slices is incremented to guarantee their
+      // sizes add up to the total number of elements.
+      if (i < num_batch_elements % num_threads) ++length;
+      (*ctx.runner)([offset, length, num_tuple_components, &status, &status_mu,
+                     &counter, &copy_element_fn]() {
+        absl::Status s;
+        for (size_t j = offset; j < offset + length; ++j) {
+          for (size_t component_index = 0;
+               component_index < num_tuple_components; ++component_index) {
+            s.Update(copy_element_fn(component_index, j));
           }
-          counter.DecrementCount();
-        });
-        offset += length;
-      }
-      counter.Wait();
-      TF_RETURN_IF_ERROR(status);
-    } else {
+        }
+        {
+          mutex_lock l(status_mu);
+          status.Update(s);
+        }
+        counter.DecrementCount();
+      });
+      offset += length;
+    }
+    counter.Wait();
+    TF_RETURN_IF_ERROR(status);
+  } else {
+    for (size_t component_index = 0; component_index < num_tuple_components;
+         ++component_index) {
       for (size_t i = 0; i < num_batch_elements; ++i) {
-        TF_RETURN_IF_ERROR(copy_element_fn(i));
+        TF_RETURN_IF_ERROR(copy_element_fn(component_index, i));
       }
     }
   }
@@ -1007,16 +1081,24 @@ REGISTER_DATASET_EXPERIMENT(kFilterParallelizationOpt,
                             RandomJobSamplePercentage<0>, AllTasks);
 REGISTER_DATASET_EXPERIMENT("min_outer_interleave_parallelism",
                             RandomJobSamplePercentage<0>, AllTasks);
+REGISTER_DATASET_EXPERIMENT("elastic_interleave_cycle",
+                            RandomJobSamplePercentage<0>, AllTasks);
 REGISTER_DATASET_EXPERIMENT("reduce_interleave_prefetch",
                             RandomJobSamplePercentage<0>, AllTasks);
 REGISTER_DATASET_EXPERIMENT("serialize_input_cycle_length",
                             RandomJobSamplePercentage<0>, AllTasks);
+REGISTER_DATASET_EXPERIMENT("snapshot_format_v3", RandomJobSamplePercentage<0>,
+                            AllTasks);
 REGISTER_DATASET_EXPERIMENT("stage_based_autotune",
                             RandomJobSamplePercentage<0>, IndependentHostTasks);
 REGISTER_DATASET_EXPERIMENT("stage_based_autotune_v2",
                             RandomJobSamplePercentage<0>, IndependentHostTasks);
 REGISTER_DATASET_EXPERIMENT("data_transfer", RandomJobSamplePercentage<0>,
                             AllTasks);
+REGISTER_DATASET_EXPERIMENT("data_service_batched_get_element",
+                            RandomJobSamplePercentage<0>, AllTasks);
+REGISTER_DATASET_EXPERIMENT("data_service_locality_aware_reads",
+                            RandomJobSamplePercentage<0>, AllTasks);
 REGISTER_DATASET_EXPERIMENT("file_locality", RandomJobSamplePercentage<0>,
                             AllTasks);
 REGISTER_DATASET_EXPERIMENT("file_locality_v2", RandomJobSamplePercentage<0>,
@@ -251,6 +251,15 @@ bool MatchesAnyVersion(StringPiece op_prefix, StringPiece op_to_match);
 // the tensor is not aligned, returns a deep copy of the tensor.
 Tensor MaybeCopySubSlice(const Tensor& tensor, int64 index);
 
+// Moves the components of `components` that are in pageable host memory, and
+// can be copied with memcpy, to memory from `allocator`. When several
+// components are moved, they are packed into a single allocation, each
+// aligned to Allocator::kAllocatorAlignment, so that the element costs one
+// allocation and is held in contiguous memory. Components that cannot be
+// allocated are left unchanged.
+void StagePageableComponents(Allocator* allocator,
+                             std::vector<Tensor>* components);
+
 // Removes device placements from the ops of all functions in `library`.
 void StripDevicePlacement(FunctionDefLibrary* library);
 
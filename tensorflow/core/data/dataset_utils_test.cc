@@ -26,12 +26,15 @@ limitations under the License.
 #include "tensorflow/core/data/dataset_test_base.h"
 #include "tensorflow/core/data/serialization_utils.h"
 #include "tensorflow/core/data/test_utils.h"
+#include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/dataset.h"
 #include "tensorflow/core/framework/dataset.pb.h"
 #include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/framework/function.pb.h"
 #include "tensorflow/core/framework/node_def_builder.h"
 #include "tensorflow/core/framework/op.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/framework/tensor_util.h"
 #include "tensorflow/core/framework/types.pb.h"
 #include "tensorflow/core/framework/variant.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
@@ -169,6 +172,111 @@ TEST(DatasetUtilsTest, RunnerWithMaxParallelism) {
   runner(fn);
 }
 
+TEST(DatasetUtilsTest, CopyBatchWithManyComponents) {
+  constexpr int64_t kNumElements = 8;
+  constexpr int64_t kNumComponents = 300;
+  constexpr int64_t kComponentSize = 128;
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<TestContext> test_ctx,
+                          TestContext::Create());
+  IteratorContext::Params params(test_ctx->op_ctx());
+  params.runner = [](std::function<void()> fn) { fn(); };
+  params.runner_threadpool_size = 3;
+  IteratorContext ctx(std::move(params));
+
+  // Every component is small, but the batch as a whole exceeds the parallel
+  // copy threshold.
+  std::vector<std::vector<Tensor>> batch_elements(kNumElements);
+  for (int64_t i = 0; i < kNumElements; ++i) {
+    for (int64_t j = 0; j < kNumComponents; ++j) {
+      Tensor t(DT_FLOAT, TensorShape({kComponentSize}));
+      t.flat<float>().setConstant(i * kNumComponents + j);
+      batch_elements[i].push_back(std::move(t));
+    }
+  }
+  std::vector<Tensor> batch;
+  TF_ASSERT_OK(CopyBatch(AnyContext(&ctx), std::move(batch_elements),
+                         /*parallel_copy=*/true, &batch));
+  ASSERT_EQ(batch.size(), kNumComponents);
+  for (int64_t j = 0; j < kNumComponents; ++j) {
+    EXPECT_EQ(batch[j].shape(), TensorShape({kNumElements, kComponentSize}));
+    auto values = batch[j].matrix<float>();
+    for (int64_t i = 0; i < kNumElements; ++i) {
+      EXPECT_EQ(values(i, kComponentSize - 1), i * kNumComponents + j);
+    }
+  }
+}
+
+// Allocates from the CPU allocator, reporting memory of type `memory_type`,
+// and counts its allocations.
+class MemoryTypeAllocator : public AllocatorWrapper {
+ public:
+  explicit MemoryTypeAllocator(AllocatorMemoryType memory_type)
+      : AllocatorWrapper(cpu_allocator()), memory_type_(memory_type) {}
+
+  using AllocatorWrapper::AllocateRaw;
+  void* AllocateRaw(size_t alignment, size_t num_bytes,
+                    const AllocationAttributes& allocation_attr) override {
+    ++num_allocations_;
+    return AllocatorWrapper::AllocateRaw(alignment, num_bytes,
+                                         allocation_attr);
+  }
+
+  AllocatorMemoryType GetMemoryType() const override { return memory_type_; }
+
+  int num_allocations() const { return num_allocations_; }
+
+ private:
+  const AllocatorMemoryType memory_type_;
+  int num_allocations_ = 0;
+};
+
+TEST(DatasetUtilsTest, StagePageableComponentsPacksComponents) {
+  MemoryTypeAllocator pageable(AllocatorMemoryType::kHostPageable);
+  MemoryTypeAllocator pinned(AllocatorMemoryType::kHostPinned);
+  std::vector<Tensor> components = {
+      Tensor(&pageable, DT_FLOAT, TensorShape({3})),
+      Tensor(&pageable, DT_INT64, TensorShape({2, 5})),
+      Tensor(&pageable, DT_UINT8, TensorShape({7}))};
+  test::FillValues<float>(&components[0], {1.0f, 2.0f, 3.0f});
+  components[1].flat<int64_t>().setRandom();
+  components[2].flat<uint8>().setRandom();
+  std::vector<Tensor> expected;
+  for (const Tensor& component : components) {
+    expected.push_back(tensor::DeepCopy(component));
+  }
+
+  StagePageableComponents(&pinned, &components);
+  EXPECT_EQ(pinned.num_allocations(), 1);
+  for (int i = 0; i < components.size(); ++i) {
+    EXPECT_EQ(components[i].GetMemoryType(), AllocatorMemoryType::kHostPinned);
+    EXPECT_TRUE(components[i].IsAligned()) << i;
+    test::ExpectEqual(expected[i], components[i]);
+  }
+  EXPECT_TRUE(components[0].SharesBufferWith(components[2]));
+}
+
+TEST(DatasetUtilsTest, StagePageableComponentsSkipsOtherComponents) {
+  MemoryTypeAllocator pageable(AllocatorMemoryType::kHostPageable);
+  MemoryTypeAllocator pinned(AllocatorMemoryType::kHostPinned);
+  Tensor string_component(&pageable, DT_STRING, TensorShape({1}));
+  string_component.flat<tstring>()(0) = "a";
+  std::vector<Tensor> components = {
+      Tensor(&pinned, DT_FLOAT, TensorShape({3})), string_component,
+      Tensor(&pageable, DT_FLOAT, TensorShape({0})),
+      Tensor(&pageable, DT_INT32, TensorShape({4}))};
+  test::FillIota<int32_t>(&components[3], 0);
+  const Tensor already_pinned = components[0];
+
+  StagePageableComponents(&pinned, &components);
+  // Only the last component is staged, in an allocation of its own.
+  EXPECT_EQ(pinned.num_allocations(), 2);
+  EXPECT_TRUE(components[0].SharesBufferWith(already_pinned));
+  EXPECT_TRUE(components[1].SharesBufferWith(string_component));
+  EXPECT_EQ(components[2].NumElements(), 0);
+  EXPECT_EQ(components[3].GetMemoryType(), AllocatorMemoryType::kHostPinned);
+  test::ExpectEqual(test::AsTensor<int32_t>({0, 1, 2, 3}), components[3]);
+}
+
 TEST(DatasetUtilsTest, ParseDeterminismPolicy) {
   DeterminismPolicy determinism;
   TF_ASSERT_OK(DeterminismPolicy::FromString("true", &determinism));
@@ -672,6 +780,8 @@ GetOptimizationsTestCase GetOptimizationTestCase4() {
   options.mutable_optimization_options()->set_shuffle_and_repeat_fusion(true);
   options.mutable_optimization_options()->set_inject_prefetch(true);
   options.mutable_optimization_options()->set_seq_interleave_prefetch(true);
+  options.mutable_optimization_options()->set_map_vectorization(true);
+  options.mutable_optimization_options()->set_decode_and_crop_fusion(true);
   options.set_slack(true);
   return {options,
           /*expected_enabled=*/
@@ -679,7 +789,8 @@ GetOptimizationsTestCase GetOptimizationTestCase4() {
            "map_and_batch_fusion", "map_and_filter_fusion", "map_fusion",
            "map_parallelization", "noop_elimination", "parallel_batch",
            "shuffle_and_repeat_fusion", "slack", "inject_prefetch",
-           "seq_interleave_prefetch"},
+           "seq_interleave_prefetch", "map_vectorization",
+           "decode_and_crop_fusion"},
           /*expected_disabled=*/{},
           /*expected_default=*/{}};
 }
@@ -22,14 +22,18 @@ limitations under the License.
 #include <numeric>
 #include <optional>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
 #include "absl/time/time.h"
 #include "tensorflow/core/framework/metrics.h"
+#include "tsl/platform/errors.h"
 #include "tsl/platform/mutex.h"
 #include "tsl/platform/thread_annotations.h"
 
@@ -38,6 +42,20 @@ namespace data {
 
 constexpr double kAutoScalerOutlierSigmas = 1.0;
 
+namespace {
+tsl::mutex* get_actuator_factories_lock() {
+  static tsl::mutex lock(tsl::LINKER_INITIALIZED);
+  return &lock;
+}
+
+using WorkerCountActuatorFactories =
+    std::unordered_map<std::string, WorkerCountActuator::FactoryT>;
+WorkerCountActuatorFactories& worker_count_actuator_factories() {
+  static auto& factories = *new WorkerCountActuatorFactories();
+  return factories;
+}
+}  // namespace
+
 template <typename T>
 double GetMedian(const absl::flat_hash_map<T, double>& rates) {
   std::vector<double> sorted_rates;
@@ -188,6 +206,42 @@ absl::Status AutoScaler::RemoveConsumer(int64_t consumer_id)
   return absl::OkStatus();
 }
 
+void WorkerCountActuator::Register(std::string name, FactoryT factory) {
+  tsl::mutex_lock l(*get_actuator_factories_lock());
+  if (!worker_count_actuator_factories().insert({name, factory}).second) {
+    LOG(ERROR)
+        << "Two worker count actuator factories are being registered with name "
+        << name << ". Which one gets used is undefined.";
+  }
+}
+
+absl::Status WorkerCountActuator::Build(
+    std::string name, std::unique_ptr<WorkerCountActuator>& out) {
+  tsl::mutex_lock l(*get_actuator_factories_lock());
+  auto it = worker_count_actuator_factories().find(name);
+  if (it != worker_count_actuator_factories().end()) {
+    return it->second(out);
+  }
+
+  std::vector<std::string> available_names;
+  for (const auto& factory : worker_count_actuator_factories()) {
+    available_names.push_back(factory.first);
+  }
+  return absl::NotFoundError(absl::StrCat(
+      "No worker count actuator factory has been registered for name ", name,
+      ". The available names are: [ ", absl::StrJoin(available_names, ", "),
+      " ]"));
+}
+
+void MultipleIterationsAutoScaler::SetWorkerCountActuator(
+    std::unique_ptr<WorkerCountActuator> actuator,
+    WorkerCountActuatorOptions options) TF_LOCKS_EXCLUDED(actuator_mu_) {
+  tsl::mutex_lock l(actuator_mu_);
+  actuator_ = std::move(actuator);
+  actuator_options_ = std::move(options);
+  requested_number_of_workers_.reset();
+}
+
 void MultipleIterationsAutoScaler::EnsureIterationIsRegistered(
     int64_t iteration_id) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
   if (!auto_scalers_.contains(iteration_id)) {
@@ -240,6 +294,45 @@ absl::Status MultipleIterationsAutoScaler::UpdateOptimalNumberOfWorkersMetric(
   metrics::RecordTFDataServiceOptimalNumberOfWorkers(
       bound_optimal_number_of_workers);
 
+  tsl::mutex_lock l(actuator_mu_);
+  last_optimal_number_of_workers_ = bound_optimal_number_of_workers;
+  return MaybeRequestNumberOfWorkers(current_number_of_workers,
+                                     bound_optimal_number_of_workers);
+}
+
+std::optional<int64_t>
+MultipleIterationsAutoScaler::GetLastOptimalNumberOfWorkers() const
+    TF_LOCKS_EXCLUDED(actuator_mu_) {
+  tsl::mutex_lock l(actuator_mu_);
+  return last_optimal_number_of_workers_;
+}
+
+absl::Status MultipleIterationsAutoScaler::MaybeRequestNumberOfWorkers(
+    int64_t current_number_of_workers, int64_t optimal_number_of_workers)
+    TF_EXCLUSIVE_LOCKS_REQUIRED(actuator_mu_) {
+  if (actuator_ == nullptr) return absl::OkStatus();
+
+  const absl::Time now = actuator_options_.clock();
+  if (!requested_number_of_workers_.has_value()) {
+    requested_number_of_workers_ = current_number_of_workers;
+    last_request_time_ = now;
+  }
+
+  const int64_t requested = *requested_number_of_workers_;
+  const bool scale_up = optimal_number_of_workers > requested;
+  const bool scale_down =
+      optimal_number_of_workers <
+          requested * (1.0 - actuator_options_.scale_down_tolerance) &&
+      now - last_request_time_ >= actuator_options_.scale_down_delay;
+  if (!scale_up && !scale_down) return absl::OkStatus();
+
+  VLOG(1) << "Requesting " << optimal_number_of_workers
+          << " tf.data service workers. Previously requested: " << requested
+          << ", registered: " << current_number_of_workers << ".";
+  TF_RETURN_IF_ERROR(
+      actuator_->RequestNumberOfWorkers(optimal_number_of_workers));
+  requested_number_of_workers_ = optimal_number_of_workers;
+  last_request_time_ = now;
   return absl::OkStatus();
 }
 
@@ -17,6 +17,7 @@ limitations under the License.
 #define TENSORFLOW_CORE_DATA_SERVICE_AUTO_SCALER_H_
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
@@ -105,17 +106,59 @@ class AutoScaler {
   absl::flat_hash_map<int64_t, double> consumption_rates_ TF_GUARDED_BY(mu_);
 };
 
+// Asks a cluster manager to change the number of tf.data service workers.
+// Implementations are registered by name with `Register`, and the dispatcher
+// uses the one named by `DispatcherConfig.worker_count_actuator`.
+class WorkerCountActuator {
+ public:
+  using FactoryT =
+      std::function<absl::Status(std::unique_ptr<WorkerCountActuator>&)>;
+
+  virtual ~WorkerCountActuator() = default;
+
+  // Requests that the cluster runs `number_of_workers` workers. It should not
+  // block until the workers are running.
+  virtual absl::Status RequestNumberOfWorkers(int64_t number_of_workers) = 0;
+
+  // Registers a `WorkerCountActuator` factory under `name`.
+  static void Register(std::string name, FactoryT factory);
+
+  // Builds the `WorkerCountActuator` registered under `name`.
+  static absl::Status Build(std::string name,
+                            std::unique_ptr<WorkerCountActuator>& out);
+};
+
+// Controls how `MultipleIterationsAutoScaler` acts on its estimates.
+struct WorkerCountActuatorOptions {
+  // Scale-downs are only requested when the estimate is this fraction below
+  // the last requested number of workers...
+  double scale_down_tolerance = 0.2;
+  // ... and this long after the last request, so that estimates that
+  // fluctuate do not make the cluster thrash. Scale-ups are always requested
+  // immediately, before consumers stall.
+  absl::Duration scale_down_delay = absl::Minutes(5);
+  // Returns the current time. Overridden in tests.
+  std::function<absl::Time()> clock = absl::Now;
+};
+
 // Exports a metric (/tensorflow/data/service/optimal_number_of_workers) with
 // the estimated optimal number of tf.data service workers, according to
 // the observed cluster workload.
 //
 // It estimates the number of workers as the maximum of the estimated optimal
 // number of workers for all Iterations running in the tf.data service cluster.
+// If a `WorkerCountActuator` is set, it also requests the bounded estimate
+// from the cluster manager.
 //
 // MultipleIterationsAutoScaler is thread-safe.
 class MultipleIterationsAutoScaler {
  public:
   MultipleIterationsAutoScaler() = default;
+  // Makes `UpdateOptimalNumberOfWorkersMetric` request the estimated number of
+  // workers from `actuator`.
+  void SetWorkerCountActuator(std::unique_ptr<WorkerCountActuator> actuator,
+                              WorkerCountActuatorOptions options = {})
+      TF_LOCKS_EXCLUDED(actuator_mu_);
   // Unregisters iteration with `iteration_id`, removing its reported
   // times from consideration of the current workload estimation.
   // Returns an error if the specified iteration does not exist.
@@ -124,9 +167,15 @@ class MultipleIterationsAutoScaler {
   // workers. The estimate is limited to min(4 * `current_number_of_workers`,
   // `current_number_of_workers` + 500). Returns an error if there are no
   // previously reported processing and target processing times for at least one
-  // iteration, or `current_number_of_workers` is not positive.
+  // iteration, or `current_number_of_workers` is not positive. If a
+  // `WorkerCountActuator` is set, also returns its errors.
   absl::Status UpdateOptimalNumberOfWorkersMetric(
-      int64_t current_number_of_workers) TF_LOCKS_EXCLUDED(mu_);
+      int64_t current_number_of_workers)
+      TF_LOCKS_EXCLUDED(mu_, actuator_mu_);
+  // Returns the bounded estimate last exported by
+  // `UpdateOptimalNumberOfWorkersMetric`, or nullopt if none has been exported.
+  std::optional<int64_t> GetLastOptimalNumberOfWorkers() const
+      TF_LOCKS_EXCLUDED(actuator_mu_);
   // Returns the estimated optimal number of workers according to the current
   // observed workload. If there are no previously reported processing and
   // target processing times for at least one iteration, returns nullopt.
@@ -168,10 +217,26 @@ class MultipleIterationsAutoScaler {
   // workload estimation.
   void EnsureIterationIsRegistered(int64_t iteration_id)
       TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Requests `optimal_number_of_workers` from `actuator_` if the hysteresis
+  // described in `WorkerCountActuatorOptions` allows it.
+  absl::Status MaybeRequestNumberOfWorkers(int64_t current_number_of_workers,
+                                           int64_t optimal_number_of_workers)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(actuator_mu_);
   mutable tsl::mutex mu_;
   // Map from iteration id to AutoScaler.
   absl::flat_hash_map<int64_t, std::unique_ptr<AutoScaler>> auto_scalers_
       TF_GUARDED_BY(mu_);
+
+  mutable tsl::mutex actuator_mu_;
+  std::optional<int64_t> last_optimal_number_of_workers_
+      TF_GUARDED_BY(actuator_mu_);
+  std::unique_ptr<WorkerCountActuator> actuator_ TF_GUARDED_BY(actuator_mu_);
+  WorkerCountActuatorOptions actuator_options_ TF_GUARDED_BY(actuator_mu_);
+  // The number of workers last requested from `actuator_`, or the number of
+  // workers when the actuator was first consulted.
+  std::optional<int64_t> requested_number_of_workers_
+      TF_GUARDED_BY(actuator_mu_);
+  absl::Time last_request_time_ TF_GUARDED_BY(actuator_mu_);
 };
 
 }  // namespace data
@@ -15,7 +15,10 @@ limitations under the License.
 
 #include "tensorflow/core/data/service/auto_scaler.h"
 
+#include <cstdint>
+#include <memory>
 #include <optional>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -30,8 +33,25 @@ namespace tensorflow {
 namespace data {
 namespace {
 
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
 using ::tsl::testing::StatusIs;
 
+// Records the requested numbers of workers.
+class FakeWorkerCountActuator : public WorkerCountActuator {
+ public:
+  explicit FakeWorkerCountActuator(std::vector<int64_t>& requests)
+      : requests_(requests) {}
+
+  absl::Status RequestNumberOfWorkers(int64_t number_of_workers) override {
+    requests_.push_back(number_of_workers);
+    return absl::OkStatus();
+  }
+
+ private:
+  std::vector<int64_t>& requests_;
+};
+
 TEST(AutoScalerTest, GetOptimalNumberOfWorkersInitialState) {
   AutoScaler auto_scaler;
   EXPECT_EQ(auto_scaler.GetOptimalNumberOfWorkers(), std::nullopt);
@@ -746,6 +766,77 @@ TEST(MultipleIterationsAutoScalerTest, RemoveConsumerAfterNewTPTReported) {
   TF_ASSERT_OK(auto_scaler.RemoveConsumer(0, 0));
 }
 
+TEST(MultipleIterationsAutoScalerTest, ActuatorScalesUpImmediately) {
+  std::vector<int64_t> requests;
+  MultipleIterationsAutoScaler auto_scaler;
+  auto_scaler.SetWorkerCountActuator(
+      std::make_unique<FakeWorkerCountActuator>(requests));
+  EXPECT_EQ(auto_scaler.GetLastOptimalNumberOfWorkers(), std::nullopt);
+
+  TF_ASSERT_OK(
+      auto_scaler.ReportTargetProcessingTime(0, 0, absl::Microseconds(10)));
+  TF_ASSERT_OK(auto_scaler.ReportProcessingTime(0, "/worker/task/0:20000",
+                                                absl::Microseconds(500)));
+  // Estimated workers = 50.
+  TF_ASSERT_OK(auto_scaler.UpdateOptimalNumberOfWorkersMetric(15));
+  EXPECT_EQ(auto_scaler.GetLastOptimalNumberOfWorkers(), 50);
+  // The same estimate is not requested again.
+  TF_ASSERT_OK(auto_scaler.UpdateOptimalNumberOfWorkersMetric(15));
+  EXPECT_THAT(requests, ElementsAre(50));
+  metrics::RecordTFDataServiceOptimalNumberOfWorkers(0);
+}
+
+TEST(MultipleIterationsAutoScalerTest, ActuatorScalesDownWithHysteresis) {
+  std::vector<int64_t> requests;
+  absl::Time now = absl::UnixEpoch();
+  WorkerCountActuatorOptions options;
+  options.scale_down_tolerance = 0.2;
+  options.scale_down_delay = absl::Minutes(5);
+  options.clock = [&now]() { return now; };
+  MultipleIterationsAutoScaler auto_scaler;
+  auto_scaler.SetWorkerCountActuator(
+      std::make_unique<FakeWorkerCountActuator>(requests), options);
+
+  TF_ASSERT_OK(
+      auto_scaler.ReportTargetProcessingTime(0, 0, absl::Microseconds(10)));
+  TF_ASSERT_OK(auto_scaler.ReportProcessingTime(0, "/worker/task/0:20000",
+                                                absl::Microseconds(450)));
+  // Estimated workers = 45, within 20% of the current 50 workers.
+  TF_ASSERT_OK(auto_scaler.UpdateOptimalNumberOfWorkersMetric(50));
+  EXPECT_THAT(requests, IsEmpty());
+
+  TF_ASSERT_OK(auto_scaler.ReportProcessingTime(0, "/worker/task/0:20000",
+                                                absl::Microseconds(300)));
+  // Estimated workers = 30, but the scale-down delay has not passed.
+  now += absl::Minutes(1);
+  TF_ASSERT_OK(auto_scaler.UpdateOptimalNumberOfWorkersMetric(50));
+  EXPECT_THAT(requests, IsEmpty());
+
+  now += absl::Minutes(5);
+  TF_ASSERT_OK(auto_scaler.UpdateOptimalNumberOfWorkersMetric(50));
+  EXPECT_THAT(requests, ElementsAre(30));
+  metrics::RecordTFDataServiceOptimalNumberOfWorkers(0);
+}
+
+TEST(WorkerCountActuatorTest, BuildUnregisteredActuator) {
+  std::unique_ptr<WorkerCountActuator> actuator;
+  EXPECT_THAT(WorkerCountActuator::Build("unregistered", actuator),
+              StatusIs(absl::StatusCode::kNotFound));
+}
+
+TEST(WorkerCountActuatorTest, BuildRegisteredActuator) {
+  static auto* requests = new std::vector<int64_t>();
+  WorkerCountActuator::Register(
+      "fake", [](std::unique_ptr<WorkerCountActuator>& out) {
+        out = std::make_unique<FakeWorkerCountActuator>(*requests);
+        return absl::OkStatus();
+      });
+  std::unique_ptr<WorkerCountActuator> actuator;
+  TF_ASSERT_OK(WorkerCountActuator::Build("fake", actuator));
+  TF_ASSERT_OK(actuator->RequestNumberOfWorkers(10));
+  EXPECT_THAT(*requests, ElementsAre(10));
+}
+
 }  // namespace
 
 }  // namespace data
@@ -42,6 +42,13 @@ struct DataServiceParams final {
   TargetWorkers target_workers = TargetWorkers::TARGET_WORKERS_UNSPECIFIED;
   DataServiceMetadata metadata;
   std::optional<CrossTrainerCacheOptions> cross_trainer_cache_options;
+  // Upper bound on the number of elements to fetch from a worker in one
+  // GetElement call. Batching is not used for coordinated reads.
+  int64_t max_elements_per_request = 1;
+  // If true, non-coordinated reads only fetch from the nearest workers (local,
+  // then same host, then same rack) unless the client runs out of buffered
+  // elements.
+  bool prefer_nearby_workers = false;
 };
 
 }  // namespace data
@@ -17,6 +17,7 @@ limitations under the License.
 #include <algorithm>
 #include <chrono>
 #include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <limits>
 #include <memory>
@@ -33,7 +34,9 @@ limitations under the License.
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 #include "absl/strings/substitute.h"
 #include "absl/time/time.h"
 #include "xla/tsl/protobuf/error_codes.pb.h"
@@ -61,6 +64,7 @@ limitations under the License.
 #include "tensorflow/core/platform/thread_annotations.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/profiler/lib/traceme_encode.h"
+#include "tsl/platform/host_info.h"
 #include "tsl/platform/retrying_utils.h"
 
 namespace tensorflow {
@@ -73,6 +77,40 @@ bool IsColocatedTask(const TaskInfo& task) {
   });
 }
 
+// Environment variable naming the rack of the client.
+constexpr char kRackEnvVar[] = "TF_DATA_SERVICE_RACK";
+
+// Returns the rack of the worker running `task`, or an empty string if the
+// worker does not have a rack tag.
+std::string WorkerRack(const TaskInfo& task) {
+  for (const std::string& worker_tag : task.worker_tags()) {
+    if (absl::StartsWithIgnoreCase(worker_tag, kRackWorkerTagPrefix)) {
+      return worker_tag.substr(kRackWorkerTagPrefix.size());
+    }
+  }
+  return "";
+}
+
+// Ranks how far the worker running `task` is from this client: 0 for a
+// worker in this process, 1 for the same host, 2 for the same rack, and 3
+// otherwise.
+int64_t WorkerDistance(const TaskInfo& task) {
+  const std::string& address = task.worker_address();
+  if (LocalWorkers::Get(address) != nullptr) {
+    return 0;
+  }
+  absl::string_view host = address;
+  host = host.substr(0, host.rfind(':'));
+  if (host == tsl::port::Hostname() || host == "localhost") {
+    return 1;
+  }
+  const char* rack = std::getenv(kRackEnvVar);
+  if (rack != nullptr && *rack != '\0' && WorkerRack(task) == rack) {
+    return 2;
+  }
+  return 3;
+}
+
 absl::StatusOr<DataTransferServerInfo> GetTransferServer(
     const std::string& protocol, const TaskInfo& task_info) {
   for (const auto& transfer_server : task_info.transfer_servers()) {
@@ -430,6 +468,7 @@ absl::Status DataServiceClient::AddTask(const TaskInfo& task_info)
       worker->GetDataTransferProtocol(),
       /*user_specified=*/!params_.data_transfer_protocol.empty());
   tasks_.push_back(std::make_shared<Task>(task_info, std::move(worker)));
+  tasks_.back()->distance = WorkerDistance(task_info);
   worker_thread_cv_.notify_one();
   if (IsCoordinatedRead()) {
     VLOG(1) << "Consumer " << params_.consumer_index.value() << " adding task "
@@ -631,7 +670,7 @@ void DataServiceClient::RunWorkerThread(std::function<void()> done)
       mutex_lock l(mu_);
       if (task_to_process) {
         task_to_process->in_use = false;
-        --outstanding_requests_;
+        outstanding_requests_ -= task_to_process->max_elements;
         task_to_process = nullptr;
         worker_thread_cv_.notify_one();
       }
@@ -649,7 +688,8 @@ void DataServiceClient::RunWorkerThread(std::function<void()> done)
       }
       DCHECK(task_to_process != nullptr);
       task_to_process->in_use = true;
-      ++outstanding_requests_;
+      task_to_process->max_elements = MaxElementsToRequest(*task_to_process);
+      outstanding_requests_ += task_to_process->max_elements;
       if (IsCoordinatedRead()) {
         // Reserve a spot in the results_ queue.
         results_.push(std::make_shared<Result>());
@@ -670,7 +710,7 @@ void DataServiceClient::RunWorkerThread(std::function<void()> done)
       VLOG(1) << "Failed to get element from worker "
               << task_to_process->info.worker_address() << ": " << s;
       task_to_process->in_use = false;
-      --outstanding_requests_;
+      outstanding_requests_ -= task_to_process->max_elements;
       status_ = errors::CreateWithUpdatedMessage(
           s, absl::StrCat("Failed to get element from worker ",
                           task_to_process->info.worker_address(), ": ",
@@ -713,6 +753,19 @@ bool DataServiceClient::ShouldProcessTask() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
   return results_.size() + outstanding_requests_ < max_outstanding_requests_;
 }
 
+int64_t DataServiceClient::MaxElementsToRequest(const Task& task)
+    TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+  if (IsCoordinatedRead() || params_.cross_trainer_cache_options) {
+    return 1;
+  }
+  // `ShouldProcessTask` guarantees a free slot for this request.
+  int64_t free_slots = max_outstanding_requests_ -
+                       static_cast<int64_t>(results_.size()) -
+                       outstanding_requests_;
+  return std::max<int64_t>(1, std::min({task.batch_size, free_slots,
+                                        params_.max_elements_per_request}));
+}
+
 // Searches for a task to process, visiting tasks in-order and giving every
 // task a chance to proceed.
 std::shared_ptr<DataServiceClient::Task> DataServiceClient::GetTaskToProcess()
@@ -721,6 +774,7 @@ std::shared_ptr<DataServiceClient::Task> DataServiceClient::GetTaskToProcess()
     return nullptr;
   }
 
+  const int64_t nearest_distance = NearestTaskDistance();
   for (int i = 0; i < tasks_.size(); ++i) {
     std::shared_ptr<Task>& task = tasks_[next_task_index_];
     if (IsCoordinatedRead() &&
@@ -744,6 +798,14 @@ std::shared_ptr<DataServiceClient::Task> DataServiceClient::GetTaskToProcess()
       AdvanceTaskIndex();
       continue;
     }
+    if (nearest_distance >= 0 && task->distance > nearest_distance &&
+        !results_.empty()) {
+      VLOG(3) << "Skipping task " << next_task_index_
+              << " in favor of nearer workers. distance: " << task->distance
+              << ". nearest distance: " << nearest_distance;
+      AdvanceTaskIndex();
+      continue;
+    }
     task->round = current_round_;
     AdvanceTaskIndex();
     return task;
@@ -751,6 +813,23 @@ std::shared_ptr<DataServiceClient::Task> DataServiceClient::GetTaskToProcess()
   return nullptr;
 }
 
+int64_t DataServiceClient::NearestTaskDistance() const
+    TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+  if (!params_.prefer_nearby_workers || IsCoordinatedRead()) {
+    return -1;
+  }
+  int64_t nearest_distance = -1;
+  for (const std::shared_ptr<Task>& task : tasks_) {
+    if (task->end_of_sequence || task->removed) {
+      continue;
+    }
+    if (nearest_distance < 0 || task->distance < nearest_distance) {
+      nearest_distance = task->distance;
+    }
+  }
+  return nearest_distance;
+}
+
 // Increments the next task index, starting over if all tasks have been
 // processed.
 void DataServiceClient::AdvanceTaskIndex() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
@@ -761,8 +840,8 @@ void DataServiceClient::AdvanceTaskIndex() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
   }
 }
 
-absl::Status DataServiceClient::TryGetElement(const Task& task, bool allow_skip,
-                                              GetElementResult& result) {
+absl::Status DataServiceClient::TryGetElement(
+    const Task& task, bool allow_skip, std::vector<GetElementResult>& results) {
   GetElementRequest req;
   req.set_task_id(task.info.task_id());
   req.set_skipped_previous_round(task.skipped_previous_round);
@@ -776,13 +855,34 @@ absl::Status DataServiceClient::TryGetElement(const Task& task, bool allow_skip,
   if (params_.cross_trainer_cache_options) {
     req.set_trainer_id(params_.cross_trainer_cache_options->trainer_id());
   }
-  return task.worker->GetElement(req, result);
+  if (task.max_elements > 1) {
+    req.set_max_elements(task.max_elements);
+    return task.worker->GetElements(req, results);
+  }
+  results.clear();
+  results.emplace_back();
+  return task.worker->GetElement(req, results.back());
 }
 
 void DataServiceClient::ProcessGetElementResponse(
-    bool enqueue_result, GetElementResult& get_element_result,
+    bool enqueue_result, std::vector<GetElementResult>& get_element_results,
     std::shared_ptr<Result> result, Task& task) TF_LOCKS_EXCLUDED(mu_) {
   mutex_lock l(mu_);
+  DCHECK(!get_element_results.empty());
+  for (int64_t i = 0; i < get_element_results.size(); ++i) {
+    // Only non-coordinated reads are batched, and their results are always
+    // enqueued, so the extra elements get results of their own.
+    ProcessGetElementResult(enqueue_result, get_element_results[i],
+                            i == 0 ? result : std::make_shared<Result>(), task);
+  }
+  UpdateBatchSize(task, get_element_results.size());
+  get_next_cv_.notify_all();
+}
+
+void DataServiceClient::ProcessGetElementResult(
+    bool enqueue_result, GetElementResult& get_element_result,
+    std::shared_ptr<Result> result, Task& task)
+    TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
   result->ready = true;
   result->end_of_sequence = get_element_result.end_of_sequence;
   result->skip = get_element_result.skip;
@@ -801,7 +901,20 @@ void DataServiceClient::ProcessGetElementResponse(
     ctx_->RecordBufferEnqueue(result->element);
     results_.push(std::move(result));
   }
-  get_next_cv_.notify_all();
+}
+
+void DataServiceClient::UpdateBatchSize(Task& task, int64_t num_results)
+    TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+  if (params_.max_elements_per_request <= 1) {
+    return;
+  }
+  if (num_results < task.max_elements) {
+    // The worker did not have enough elements ready to fill the request.
+    task.batch_size = std::max<int64_t>(1, task.batch_size / 2);
+  } else if (task.max_elements == task.batch_size) {
+    task.batch_size =
+        std::min(2 * task.batch_size, params_.max_elements_per_request);
+  }
 }
 
 absl::Status DataServiceClient::GetElementTraced(
@@ -865,9 +978,9 @@ absl::Status DataServiceClient::GetElement(Task* task, int64_t deadline_micros,
                                            bool enqueue_result, bool allow_skip,
                                            std::shared_ptr<Result> result)
     TF_LOCKS_EXCLUDED(mu_) {
-  GetElementResult get_element_result;
+  std::vector<GetElementResult> get_element_results;
   while (true) {
-    absl::Status s = TryGetElement(*task, allow_skip, get_element_result);
+    absl::Status s = TryGetElement(*task, allow_skip, get_element_results);
     if (s.ok()) {
       task->num_retries = 0;
       break;
@@ -924,7 +1037,8 @@ absl::Status DataServiceClient::GetElement(Task* task, int64_t deadline_micros,
       return absl::OkStatus();
     }
   }
-  ProcessGetElementResponse(enqueue_result, get_element_result, result, *task);
+  ProcessGetElementResponse(enqueue_result, get_element_results, result,
+                            *task);
   return absl::OkStatus();
 }
 
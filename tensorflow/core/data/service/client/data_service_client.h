@@ -118,6 +118,16 @@ class DataServiceClient {
     // Number of retries. The more it is retried, the longer it should wait
     // before the next retry.
     int64_t num_retries = 0;
+    // Number of elements to ask the worker for in a GetElement call. It
+    // doubles while the worker returns full batches, and halves when the
+    // worker has fewer elements ready than requested, so it tracks how many
+    // elements the worker produces during a request round trip.
+    int64_t batch_size = 1;
+    // Number of elements requested by the in-progress GetElement call, which
+    // is `batch_size` limited by the free space in the results buffer.
+    int64_t max_elements = 1;
+    // How far the worker is from the client. See `WorkerDistance`.
+    int64_t distance = 0;
   };
 
   struct Result {
@@ -178,12 +188,23 @@ class DataServiceClient {
   // Searches for a task to process, visiting tasks in-order and giving every
   // task a chance to proceed.
   std::shared_ptr<Task> GetTaskToProcess();
+  // Returns the distance of the nearest task that still has elements, or -1
+  // if reads should not be restricted to nearby workers.
+  int64_t NearestTaskDistance() const;
   void AdvanceTaskIndex();
+  // Returns the number of elements the next request for `task` may fetch
+  // without violating `max_outstanding_requests_`.
+  int64_t MaxElementsToRequest(const Task& task);
   absl::Status TryGetElement(const Task& task, bool allow_skip,
-                             GetElementResult& result);
-  void ProcessGetElementResponse(bool enqueue_result,
-                                 GetElementResult& get_element_result,
-                                 std::shared_ptr<Result> result, Task& task);
+                             std::vector<GetElementResult>& results);
+  void ProcessGetElementResponse(
+      bool enqueue_result, std::vector<GetElementResult>& get_element_results,
+      std::shared_ptr<Result> result, Task& task);
+  void ProcessGetElementResult(bool enqueue_result,
+                               GetElementResult& get_element_result,
+                               std::shared_ptr<Result> result, Task& task);
+  // Adjusts `task.batch_size` after a request returned `num_results` results.
+  void UpdateBatchSize(Task& task, int64_t num_results);
   absl::Status GetElementTraced(Task* task, int64_t deadline_micros,
                                 bool enqueue_result, bool allow_skip,
                                 std::shared_ptr<Result> result);
@@ -206,7 +227,8 @@ class DataServiceClient {
 
   bool cancelled_ TF_GUARDED_BY(mu_) = false;
 
-  // Number of outstanding requests.
+  // Number of outstanding requests. A request that fetches several elements
+  // counts once per element it may return.
   int64_t outstanding_requests_ TF_GUARDED_BY(mu_) = 0;
 
   // max_outstanding_requests controls how many elements may be held in memory
@@ -163,6 +163,42 @@ TEST(DataServiceClientTest, DynamicSharding) {
   client.Cancel();
 }
 
+TEST(DataServiceClientTest, BatchedGetElement) {
+  TestCluster test_cluster(/*num_workers=*/3);
+  TF_ASSERT_OK(test_cluster.Initialize());
+  DatasetClient<int64_t> test_dataset(test_cluster);
+  TF_ASSERT_OK_AND_ASSIGN(std::string dataset_id,
+                          test_dataset.RegisterDataset(RangeDataset(100)));
+
+  DataServiceParams params = GetDataServiceParams(
+      dataset_id, test_cluster.DispatcherAddress(), ProcessingModeDef::DYNAMIC);
+  params.max_elements_per_request = 8;
+  DataServiceClient client(params);
+  TF_ASSERT_OK(client.Initialize(/*accelerator_device_info=*/nullptr,
+                                 /*allocator=*/nullptr));
+  EXPECT_THAT(GetResults<int64_t>(client),
+              IsOkAndHolds(UnorderedElementsAreArray(Range(100))));
+  client.Cancel();
+}
+
+TEST(DataServiceClientTest, PreferNearbyWorkers) {
+  TestCluster test_cluster(/*num_workers=*/3);
+  TF_ASSERT_OK(test_cluster.Initialize());
+  DatasetClient<int64_t> test_dataset(test_cluster);
+  TF_ASSERT_OK_AND_ASSIGN(std::string dataset_id,
+                          test_dataset.RegisterDataset(RangeDataset(100)));
+
+  DataServiceParams params = GetDataServiceParams(
+      dataset_id, test_cluster.DispatcherAddress(), ProcessingModeDef::DYNAMIC);
+  params.prefer_nearby_workers = true;
+  DataServiceClient client(params);
+  TF_ASSERT_OK(client.Initialize(/*accelerator_device_info=*/nullptr,
+                                 /*allocator=*/nullptr));
+  EXPECT_THAT(GetResults<int64_t>(client),
+              IsOkAndHolds(UnorderedElementsAreArray(Range(100))));
+  client.Cancel();
+}
+
 TEST(DataServiceClientTest, StaticSharding) {
   TestCluster test_cluster(/*num_workers=*/3);
   TF_ASSERT_OK(test_cluster.Initialize());
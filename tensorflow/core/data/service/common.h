@@ -39,6 +39,11 @@ constexpr int kDataServiceVersion = 9;
 // workers on other TF hosts when the host runs a local tf.data service worker.
 constexpr absl::string_view kColocatedWorkerTag = "COLOCATED";
 
+// Workers tagged "RACK:<name>" are considered to be in rack <name>. Clients
+// whose `TF_DATA_SERVICE_RACK` environment variable names the same rack prefer
+// reading from them when `DataServiceParams::prefer_nearby_workers` is set.
+constexpr absl::string_view kRackWorkerTagPrefix = "RACK:";
+
 // Container to hold the result of a `GetNext` call.
 struct GetNextResult final {
   explicit GetNextResult() = default;
@@ -20,14 +20,21 @@ limitations under the License.
 #include <functional>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 #include "tensorflow/core/data/service/byte_size.h"
 #include "tensorflow/core/framework/metrics.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/file_system.h"
 #include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/path.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/statusor.h"
 #include "tensorflow/core/platform/thread_annotations.h"
@@ -78,7 +85,8 @@ namespace data {
 // To use the cache, the user needs to define a `CachableSequence` to generate
 // an infinite sequence of data. It should implement a `GetNext` method to
 // produce elements, and a `GetElementSizeBytes` method to estimate the element
-// size in bytes.
+// size in bytes. To support spilling elements to disk, it should also
+// implement `SerializeElement` and `DeserializeElement`.
 template <class ElementType>
 class CachableSequence {
  public:
@@ -89,6 +97,29 @@ class CachableSequence {
 
   // Returns the estimated size of the element in bytes.
   virtual size_t GetElementSizeBytes(const ElementType&) const = 0;
+
+  // Serializes an element evicted from memory so it can be spilled to disk.
+  virtual absl::Status SerializeElement(const ElementType& element,
+                                        std::string& out) const {
+    return errors::Unimplemented(
+        "This cachable sequence does not support spilling to disk.");
+  }
+
+  // Reverses `SerializeElement`.
+  virtual StatusOr<ElementType> DeserializeElement(
+      absl::string_view serialized) const {
+    return errors::Unimplemented(
+        "This cachable sequence does not support spilling to disk.");
+  }
+};
+
+// Configures the on-disk tier of a `CrossTrainerCache`. Elements evicted from
+// memory are appended to log files under `directory`, where trainers that fall
+// behind the in-memory window can still read them. The oldest spilled elements
+// are discarded once the logs hold more than `max_size_bytes`.
+struct CrossTrainerCacheSpillOptions {
+  std::string directory;
+  size_t max_size_bytes = 0;
 };
 
 // Sliding-window cache shared across concurrent trainers.
@@ -98,10 +129,13 @@ class CrossTrainerCache {
   // Creates a `CrossTrainerCache` with `max_cache_size_bytes` of memory budget.
   // The cache should be able to hold at least one element, i.e.:
   // REQUIRES: `max_cache_size_bytes >= max(GetElementSizeBytes(*))`
+  // If `spill_options` is set, evicted elements are spilled to disk.
   explicit CrossTrainerCache(
       size_t max_cache_size_bytes,
-      std::unique_ptr<CachableSequence<ElementType>> cachable_sequence);
-  virtual ~CrossTrainerCache() = default;
+      std::unique_ptr<CachableSequence<ElementType>> cachable_sequence,
+      std::optional<CrossTrainerCacheSpillOptions> spill_options =
+          std::nullopt);
+  virtual ~CrossTrainerCache();
   CrossTrainerCache(const CrossTrainerCache&) = delete;
   CrossTrainerCache& operator=(const CrossTrainerCache&) = delete;
 
@@ -126,6 +160,15 @@ class CrossTrainerCache {
     bool cache_hit;
   };
 
+  // The location of an element in the spill files.
+  struct SpilledElement {
+    std::shared_ptr<RandomAccessFile> file;
+    // Index of the file in the sequence of spill files.
+    size_t file_index;
+    uint64_t offset;
+    size_t size_bytes;
+  };
+
   // Returns the next element and metrics about this query.
   StatusOr<CacheQueryResult> GetCacheQueryResult(const std::string& trainer_id);
 
@@ -147,8 +190,35 @@ class CrossTrainerCache {
 
   // Frees old elements to keep the cache size below `max_cache_size_bytes_`.
   // `new_element_size_bytes` is the size of the new element being inserted.
+  // If spilling is enabled, the freed elements are queued in `pending_spill_`.
   void FreeSpace(size_t new_element_size_bytes);
 
+  // Spills the elements queued in `pending_spill_`, disabling spilling if it
+  // fails. The disk I/O happens without holding `mu_`. Only called by the
+  // thread extending the cache.
+  void SpillPendingElements();
+
+  // Appends an element evicted from memory to the spill files, and discards
+  // the oldest spilled elements to stay within the spill budget.
+  absl::Status Spill(const ElementType& element);
+
+  // Starts a new spill file for `Spill` to append to.
+  absl::Status OpenSpillFile();
+
+  // Discards all spilled elements and stops spilling.
+  void DisableSpilling();
+
+  // Reads a spilled element.
+  StatusOr<std::shared_ptr<const ElementType>> ReadSpilledElement(
+      const SpilledElement& spilled_element) const;
+
+  // Discards the oldest spilled element. If no other spilled element remains
+  // in its file, adds the file to `files_to_delete`.
+  void DiscardOldestSpilledElement(std::vector<std::string>& files_to_delete);
+
+  // Deletes the files discarded by `DiscardOldestSpilledElement`.
+  static void DeleteSpillFiles(const std::vector<std::string>& filenames);
+
   // Records the cache hit rate and cache size.
   void RecordMetrics(const CacheQueryResult& result);
 
@@ -173,6 +243,33 @@ class CrossTrainerCache {
   // True if one thread is extending the cache.
   bool extending_cache_ TF_GUARDED_BY(mu_) = false;
 
+  // Options for the on-disk tier.
+  const std::optional<CrossTrainerCacheSpillOptions> spill_options_;
+  // False if there are no `spill_options_`, or if spilling failed.
+  bool spill_enabled_ TF_GUARDED_BY(mu_);
+  // Spilled elements, followed by the elements evicted from `cache_` that are
+  // waiting to be spilled. Together, they precede the elements in `cache_`.
+  std::deque<SpilledElement> spilled_ TF_GUARDED_BY(mu_);
+  std::deque<std::shared_ptr<const ElementType>> pending_spill_
+      TF_GUARDED_BY(mu_);
+  size_t spilled_size_bytes_ TF_GUARDED_BY(mu_) = 0;
+  size_t spill_start_index_ TF_GUARDED_BY(mu_) = 0;
+  // Names of the spill files that still hold spilled elements. The first one
+  // has index `spill_files_start_index_`, and the last one is being appended
+  // to.
+  std::deque<std::string> spill_files_ TF_GUARDED_BY(mu_);
+  size_t spill_files_start_index_ TF_GUARDED_BY(mu_) = 0;
+
+  // The spill file being appended to. Only used by the thread extending the
+  // cache, so not guarded by `mu_`. The reader is shared with in-progress
+  // reads, so that the file stays readable if it is deleted while being read.
+  std::string spill_file_prefix_;
+  std::unique_ptr<WritableFile> spill_writer_;
+  std::shared_ptr<RandomAccessFile> spill_reader_;
+  size_t spill_writer_file_index_ = 0;
+  uint64_t spill_writer_size_bytes_ = 0;
+  size_t num_spill_files_ = 0;
+
   // Maps trainer IDs to element indices. The indices are absolute indices
   // within the dataset. The actual index to use with `cache_` would be
   // `trainer_to_element_index_map_[trainer_id] - cache_start_index_`.
@@ -183,13 +280,28 @@ class CrossTrainerCache {
 template <class ElementType>
 CrossTrainerCache<ElementType>::CrossTrainerCache(
     size_t max_cache_size_bytes,
-    std::unique_ptr<CachableSequence<ElementType>> cachable_sequence)
+    std::unique_ptr<CachableSequence<ElementType>> cachable_sequence,
+    std::optional<CrossTrainerCacheSpillOptions> spill_options)
     : max_cache_size_bytes_(max_cache_size_bytes),
-      cachable_sequence_(std::move(cachable_sequence)) {
+      cachable_sequence_(std::move(cachable_sequence)),
+      spill_options_(std::move(spill_options)),
+      spill_enabled_(spill_options_.has_value()) {
   DCHECK_GT(max_cache_size_bytes, 0)
       << "CrossTrainerCache size must be greater than 0.";
   VLOG(2) << "Initialized tf.data service cross-trainer cache with "
           << ByteSize::Bytes(max_cache_size_bytes) << " of memory.";
+  if (spill_options_.has_value()) {
+    VLOG(2) << "Spilling tf.data service cross-trainer cache elements to "
+            << spill_options_->directory << ", using up to "
+            << ByteSize::Bytes(spill_options_->max_size_bytes) << ".";
+  }
+}
+
+template <class ElementType>
+CrossTrainerCache<ElementType>::~CrossTrainerCache() {
+  mutex_lock l(mu_);
+  DeleteSpillFiles(
+      std::vector<std::string>(spill_files_.begin(), spill_files_.end()));
 }
 
 template <class ElementType>
@@ -212,20 +324,30 @@ CrossTrainerCache<ElementType>::GetCacheQueryResult(
     const std::string& trainer_id) {
   bool should_extend_cache = false;
   while (true) {
+    std::optional<SpilledElement> spilled_element;
     {
       mutex_lock l(mu_);
       TF_RETURN_IF_ERROR(status_);
-      if (IsElementReady(trainer_id)) {
+      const size_t element_index = GetElementIndex(trainer_id);
+      if (element_index < cache_start_index_) {
+        const size_t spilled_index = element_index - spill_start_index_;
+        trainer_to_element_index_map_[trainer_id] = element_index + 1;
+        if (spilled_index >= spilled_.size()) {
+          // The element is still in memory, waiting to be spilled.
+          return CacheQueryResult{
+              pending_spill_[spilled_index - spilled_.size()],
+              /*is_cache_hit=*/true};
+        }
+        spilled_element = spilled_[spilled_index];
+      } else if (IsElementReady(trainer_id)) {
         TF_ASSIGN_OR_RETURN(std::shared_ptr<const ElementType> element,
                             GetElement(trainer_id));
         return CacheQueryResult{element,
                                 /*is_cache_hit=*/!should_extend_cache};
-      }
-
-      // Extends the cache or waits for another thread to extend the cache. When
-      // concurrent trainers wait for the next element, only one of them should
-      // extend the cache.
-      if (extending_cache_) {
+      } else if (extending_cache_) {
+        // Extends the cache or waits for another thread to extend the cache.
+        // When concurrent trainers wait for the next element, only one of
+        // them should extend the cache.
         should_extend_cache = false;
         cv_.wait(l);
       } else {
@@ -234,6 +356,13 @@ CrossTrainerCache<ElementType>::GetCacheQueryResult(
       }
     }
 
+    if (spilled_element.has_value()) {
+      // Reads outside the lock so other trainers are not blocked on disk.
+      TF_ASSIGN_OR_RETURN(std::shared_ptr<const ElementType> element,
+                          ReadSpilledElement(*spilled_element));
+      return CacheQueryResult{element, /*is_cache_hit=*/true};
+    }
+
     if (should_extend_cache) {
       absl::Status s = ExtendCache();
       mutex_lock l(mu_);
@@ -271,8 +400,8 @@ template <class ElementType>
 size_t CrossTrainerCache<ElementType>::GetElementIndex(
     const std::string& trainer_id) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
   size_t element_index = trainer_to_element_index_map_[trainer_id];
-  if (element_index < cache_start_index_) {
-    element_index = cache_start_index_;
+  if (element_index < spill_start_index_) {
+    element_index = spill_start_index_;
   }
   return element_index;
 }
@@ -290,11 +419,14 @@ absl::Status CrossTrainerCache<ElementType>::ExtendCache()
         " and cache size: ", max_cache_size_bytes_);
   }
 
-  mutex_lock l(mu_);
-  TF_RETURN_IF_ERROR(status_);
-  FreeSpace(new_element_size_bytes);
-  cache_.push_back(std::make_shared<ElementType>(std::move(element)));
-  cache_size_bytes_ += new_element_size_bytes;
+  {
+    mutex_lock l(mu_);
+    TF_RETURN_IF_ERROR(status_);
+    FreeSpace(new_element_size_bytes);
+    cache_.push_back(std::make_shared<ElementType>(std::move(element)));
+    cache_size_bytes_ += new_element_size_bytes;
+  }
+  SpillPendingElements();
   return absl::OkStatus();
 }
 
@@ -306,17 +438,186 @@ void CrossTrainerCache<ElementType>::FreeSpace(size_t new_element_size_bytes)
          cache_size_bytes_ + new_element_size_bytes > max_cache_size_bytes_) {
     size_t free_bytes =
         cachable_sequence_->GetElementSizeBytes(*cache_.front());
+    if (spill_enabled_) {
+      pending_spill_.push_back(std::move(cache_.front()));
+    }
     cache_.pop_front();
     cache_size_bytes_ -= free_bytes;
     ++cache_start_index_;
     ++num_elements_discarded;
   }
+  if (!spill_enabled_) {
+    spill_start_index_ = cache_start_index_;
+  }
 
   VLOG(3) << "Freed " << num_elements_discarded << " element(s) from "
           << "tf.data service cross-trainer cache. Memory usage: "
           << ByteSize::Bytes(cache_size_bytes_) << ".";
 }
 
+template <class ElementType>
+void CrossTrainerCache<ElementType>::SpillPendingElements()
+    TF_LOCKS_EXCLUDED(mu_) {
+  while (true) {
+    std::shared_ptr<const ElementType> element;
+    {
+      mutex_lock l(mu_);
+      if (pending_spill_.empty()) {
+        return;
+      }
+      element = pending_spill_.front();
+    }
+    absl::Status s = Spill(*element);
+    if (!s.ok()) {
+      LOG(WARNING) << "Disabling spilling of tf.data service cross-trainer "
+                   << "cache elements to disk: " << s;
+      DisableSpilling();
+      return;
+    }
+  }
+}
+
+template <class ElementType>
+absl::Status CrossTrainerCache<ElementType>::Spill(const ElementType& element)
+    TF_LOCKS_EXCLUDED(mu_) {
+  std::string serialized;
+  TF_RETURN_IF_ERROR(cachable_sequence_->SerializeElement(element, serialized));
+  std::vector<std::string> files_to_delete;
+  if (serialized.size() > spill_options_->max_size_bytes) {
+    // The element does not fit on disk either. Since spilled elements must be
+    // contiguous, it drops everything spilled before it.
+    {
+      mutex_lock l(mu_);
+      while (!spilled_.empty()) {
+        DiscardOldestSpilledElement(files_to_delete);
+      }
+      pending_spill_.pop_front();
+      ++spill_start_index_;
+    }
+    DeleteSpillFiles(files_to_delete);
+    return absl::OkStatus();
+  }
+
+  // Starts a new file once the current one holds a quarter of the budget, so
+  // that discarded elements are eventually deleted along with their file.
+  if (spill_writer_ == nullptr ||
+      spill_writer_size_bytes_ >= spill_options_->max_size_bytes / 4) {
+    TF_RETURN_IF_ERROR(OpenSpillFile());
+  }
+  TF_RETURN_IF_ERROR(spill_writer_->Append(serialized));
+  TF_RETURN_IF_ERROR(spill_writer_->Flush());
+  {
+    mutex_lock l(mu_);
+    while (!spilled_.empty() && spilled_size_bytes_ + serialized.size() >
+                                    spill_options_->max_size_bytes) {
+      DiscardOldestSpilledElement(files_to_delete);
+    }
+    spilled_.push_back(SpilledElement{spill_reader_, spill_writer_file_index_,
+                                      spill_writer_size_bytes_,
+                                      serialized.size()});
+    spilled_size_bytes_ += serialized.size();
+    pending_spill_.pop_front();
+  }
+  spill_writer_size_bytes_ += serialized.size();
+  DeleteSpillFiles(files_to_delete);
+  return absl::OkStatus();
+}
+
+template <class ElementType>
+absl::Status CrossTrainerCache<ElementType>::OpenSpillFile()
+    TF_LOCKS_EXCLUDED(mu_) {
+  Env* env = Env::Default();
+  if (spill_file_prefix_.empty()) {
+    TF_RETURN_IF_ERROR(env->RecursivelyCreateDir(spill_options_->directory));
+    std::string prefix =
+        io::JoinPath(spill_options_->directory, "cross_trainer_cache");
+    if (!env->CreateUniqueFileName(&prefix, "")) {
+      return errors::Internal("Failed to create a unique spill file name in ",
+                              spill_options_->directory);
+    }
+    spill_file_prefix_ = std::move(prefix);
+  }
+  const std::string filename =
+      absl::StrCat(spill_file_prefix_, "_", num_spill_files_);
+  std::unique_ptr<WritableFile> writer;
+  TF_RETURN_IF_ERROR(env->NewWritableFile(filename, &writer));
+  std::unique_ptr<RandomAccessFile> reader;
+  TF_RETURN_IF_ERROR(env->NewRandomAccessFile(filename, &reader));
+  spill_writer_ = std::move(writer);
+  spill_reader_ = std::move(reader);
+  spill_writer_file_index_ = num_spill_files_++;
+  spill_writer_size_bytes_ = 0;
+  mutex_lock l(mu_);
+  spill_files_.push_back(filename);
+  return absl::OkStatus();
+}
+
+template <class ElementType>
+void CrossTrainerCache<ElementType>::DisableSpilling() TF_LOCKS_EXCLUDED(mu_) {
+  std::vector<std::string> files_to_delete;
+  {
+    mutex_lock l(mu_);
+    spill_enabled_ = false;
+    while (!spilled_.empty()) {
+      DiscardOldestSpilledElement(files_to_delete);
+    }
+    pending_spill_.clear();
+    spill_start_index_ = cache_start_index_;
+    files_to_delete.insert(files_to_delete.end(), spill_files_.begin(),
+                           spill_files_.end());
+    spill_files_start_index_ += spill_files_.size();
+    spill_files_.clear();
+  }
+  spill_writer_.reset();
+  spill_reader_.reset();
+  DeleteSpillFiles(files_to_delete);
+}
+
+template <class ElementType>
+void CrossTrainerCache<ElementType>::DiscardOldestSpilledElement(
+    std::vector<std::string>& files_to_delete)
+    TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+  spilled_size_bytes_ -= spilled_.front().size_bytes;
+  spilled_.pop_front();
+  ++spill_start_index_;
+  // Discards the files that no longer hold spilled elements, except for the
+  // one being appended to.
+  while (spill_files_.size() > 1 &&
+         (spilled_.empty() ||
+          spilled_.front().file_index > spill_files_start_index_)) {
+    files_to_delete.push_back(std::move(spill_files_.front()));
+    spill_files_.pop_front();
+    ++spill_files_start_index_;
+  }
+}
+
+template <class ElementType>
+void CrossTrainerCache<ElementType>::DeleteSpillFiles(
+    const std::vector<std::string>& filenames) {
+  for (const std::string& filename : filenames) {
+    Env::Default()->DeleteFile(filename).IgnoreError();
+  }
+}
+
+template <class ElementType>
+StatusOr<std::shared_ptr<const ElementType>>
+CrossTrainerCache<ElementType>::ReadSpilledElement(
+    const SpilledElement& spilled_element) const {
+  std::string scratch(spilled_element.size_bytes, '\0');
+  absl::string_view serialized;
+  TF_RETURN_IF_ERROR(spilled_element.file->Read(
+      spilled_element.offset, spilled_element.size_bytes, &serialized,
+      scratch.data()));
+  if (serialized.size() != spilled_element.size_bytes) {
+    return errors::DataLoss("Failed to read a spilled cross-trainer cache ",
+                            "element: expected ", spilled_element.size_bytes,
+                            " bytes, got ", serialized.size(), ".");
+  }
+  TF_ASSIGN_OR_RETURN(ElementType element,
+                      cachable_sequence_->DeserializeElement(serialized));
+  return std::make_shared<const ElementType>(std::move(element));
+}
+
 template <class ElementType>
 void CrossTrainerCache<ElementType>::Cancel(absl::Status status)
     TF_LOCKS_EXCLUDED(mu_) {
@@ -22,7 +22,9 @@ limitations under the License.
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/memory/memory.h"
+#include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 #include "absl/time/time.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_testutil.h"
@@ -30,6 +32,8 @@ limitations under the License.
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/notification.h"
+#include "tensorflow/core/platform/path.h"
 #include "tensorflow/core/platform/random.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/status_matchers.h"
@@ -61,6 +65,54 @@ class InfiniteRange : public CachableSequence<int64_t> {
   int64_t next_ = 0;
 };
 
+// An `InfiniteRange` whose elements can be spilled to disk.
+class SpillableInfiniteRange : public InfiniteRange {
+ public:
+  absl::Status SerializeElement(const int64_t& element,
+                                std::string& out) const override {
+    out = absl::StrCat(element);
+    return absl::OkStatus();
+  }
+
+  absl::StatusOr<int64_t> DeserializeElement(
+      absl::string_view serialized) const override {
+    int64_t element;
+    if (!absl::SimpleAtoi(serialized, &element)) {
+      return errors::DataLoss("Failed to parse element ", serialized);
+    }
+    return element;
+  }
+};
+
+// A `SpillableInfiniteRange` whose serialization notifies `serializing` and
+// blocks until `unblock` is notified.
+class BlockingSpillableInfiniteRange : public SpillableInfiniteRange {
+ public:
+  BlockingSpillableInfiniteRange(Notification& serializing,
+                                 Notification& unblock)
+      : serializing_(serializing), unblock_(unblock) {}
+
+  absl::Status SerializeElement(const int64_t& element,
+                                std::string& out) const override {
+    if (!serializing_.HasBeenNotified()) {
+      serializing_.Notify();
+    }
+    unblock_.WaitForNotification();
+    return SpillableInfiniteRange::SerializeElement(element, out);
+  }
+
+ private:
+  Notification& serializing_;
+  Notification& unblock_;
+};
+
+CrossTrainerCacheSpillOptions SpillOptions(size_t max_size_bytes) {
+  CrossTrainerCacheSpillOptions options;
+  options.directory = io::JoinPath(testing::TmpDir(), "cross_trainer_cache");
+  options.max_size_bytes = max_size_bytes;
+  return options;
+}
+
 class TensorDataset : public CachableSequence<Tensor> {
  public:
   absl::StatusOr<Tensor> GetNext() override { return Tensor("Test Tensor"); }
@@ -190,6 +242,87 @@ TEST(CrossTrainerCacheTest, SlowTrainersSkipData) {
   EXPECT_THAT(cache.Get("Slow trainer 2"), IsOkAndHolds(Pointee(Gt(94))));
 }
 
+TEST(CrossTrainerCacheTest, SlowTrainersReadSpilledData) {
+  CrossTrainerCache<int64_t> cache(
+      /*max_cache_size_bytes=*/5 * sizeof(int64_t),
+      std::make_unique<SpillableInfiniteRange>(),
+      SpillOptions(/*max_size_bytes=*/1024));
+  EXPECT_THAT(cache.Get("Fast trainer"), IsOkAndHolds(Pointee(0)));
+  EXPECT_THAT(cache.Get("Slow trainer"), IsOkAndHolds(Pointee(0)));
+  for (int i = 1; i < 100; ++i) {
+    EXPECT_THAT(cache.Get("Fast trainer"), IsOkAndHolds(Pointee(i)));
+  }
+
+  // The elements evicted from memory are read from disk.
+  for (int i = 1; i < 100; ++i) {
+    EXPECT_THAT(cache.Get("Slow trainer"), IsOkAndHolds(Pointee(i)));
+  }
+  EXPECT_THAT(cache.Get("Slow trainer"), IsOkAndHolds(Pointee(100)));
+  EXPECT_THAT(cache.Get("Fast trainer"), IsOkAndHolds(Pointee(100)));
+}
+
+TEST(CrossTrainerCacheTest, SpilledDataIsBounded) {
+  // Holds 10 two-digit elements.
+  CrossTrainerCache<int64_t> cache(
+      /*max_cache_size_bytes=*/5 * sizeof(int64_t),
+      std::make_unique<SpillableInfiniteRange>(),
+      SpillOptions(/*max_size_bytes=*/20));
+  EXPECT_THAT(cache.Get("Fast trainer"), IsOkAndHolds(Pointee(0)));
+  EXPECT_THAT(cache.Get("Slow trainer"), IsOkAndHolds(Pointee(0)));
+  for (int i = 1; i < 100; ++i) {
+    EXPECT_THAT(cache.Get("Fast trainer"), IsOkAndHolds(Pointee(i)));
+  }
+
+  // 95 to 99 are in memory, and 85 to 94 are on disk.
+  for (int i = 85; i < 100; ++i) {
+    EXPECT_THAT(cache.Get("Slow trainer"), IsOkAndHolds(Pointee(i)));
+  }
+}
+
+TEST(CrossTrainerCacheTest, SpillingDoesNotBlockReaders) {
+  Notification serializing, unblock;
+  CrossTrainerCache<int64_t> cache(
+      /*max_cache_size_bytes=*/5 * sizeof(int64_t),
+      std::make_unique<BlockingSpillableInfiniteRange>(serializing, unblock),
+      SpillOptions(/*max_size_bytes=*/1024));
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_THAT(cache.Get("Fast trainer"), IsOkAndHolds(Pointee(i)));
+  }
+
+  // Reading 5 evicts 0, whose spilling blocks.
+  std::unique_ptr<Thread> fast_trainer(Env::Default()->StartThread(
+      /*thread_options=*/{}, /*name=*/"fast_trainer", [&cache]() {
+        EXPECT_THAT(cache.Get("Fast trainer"), IsOkAndHolds(Pointee(5)));
+      }));
+  serializing.WaitForNotification();
+
+  // Other trainers read the element waiting to be spilled from memory.
+  EXPECT_THAT(cache.Get("Slow trainer"), IsOkAndHolds(Pointee(0)));
+  EXPECT_THAT(cache.Get("Slow trainer"), IsOkAndHolds(Pointee(1)));
+  unblock.Notify();
+  fast_trainer.reset();
+
+  // Once spilled, the element is read from disk.
+  EXPECT_THAT(cache.Get("New trainer"), IsOkAndHolds(Pointee(0)));
+  for (int i = 2; i < 6; ++i) {
+    EXPECT_THAT(cache.Get("Slow trainer"), IsOkAndHolds(Pointee(i)));
+  }
+}
+
+TEST(CrossTrainerCacheTest, SpillingUnsupported) {
+  CrossTrainerCache<int64_t> cache(
+      /*max_cache_size_bytes=*/5 * sizeof(int64_t),
+      std::make_unique<InfiniteRange>(), SpillOptions(/*max_size_bytes=*/1024));
+  EXPECT_THAT(cache.Get("Fast trainer"), IsOkAndHolds(Pointee(0)));
+  EXPECT_THAT(cache.Get("Slow trainer"), IsOkAndHolds(Pointee(0)));
+  for (int i = 1; i < 20; ++i) {
+    EXPECT_THAT(cache.Get("Fast trainer"), IsOkAndHolds(Pointee(i)));
+  }
+
+  // Falls back to skipping the evicted elements.
+  EXPECT_THAT(cache.Get("Slow trainer"), IsOkAndHolds(Pointee(Gt(14))));
+}
+
 TEST(CrossTrainerCacheTest, NewTrainersStartLate) {
   CrossTrainerCache<int64_t> cache(
       /*max_cache_size_bytes=*/5 * sizeof(int64_t),
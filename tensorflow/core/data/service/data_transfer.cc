@@ -82,6 +82,13 @@ size_t GetElementResult::EstimatedMemoryUsageBytes() const {
   return size_bytes;
 }
 
+absl::Status DataTransferClient::GetElements(
+    const GetElementRequest& req, std::vector<GetElementResult>& results) {
+  results.clear();
+  results.emplace_back();
+  return GetElement(req, results.back());
+}
+
 void DataTransferServer::Register(std::string name, ServerFactoryT factory) {
   mutex_lock l(*get_lock());
   if (!transfer_server_factories().insert({name, factory}).second) {
@@ -81,6 +81,13 @@ class DataTransferClient {
   virtual absl::Status GetElement(const GetElementRequest& req,
                                   GetElementResult& result) = 0;
 
+  // Fetches the next element, followed by up to `req.max_elements() - 1`
+  // further elements of the task if the server has them available. Only the
+  // last result may have `end_of_sequence` or `skip` set. Protocols that do not
+  // support batching fetch a single element.
+  virtual absl::Status GetElements(const GetElementRequest& req,
+                                   std::vector<GetElementResult>& results);
+
   // Makes a best effort to cancel all outstanding calls in progress for the
   // client, and causes further calls to return Cancelled status.
   virtual void TryCancel() = 0;
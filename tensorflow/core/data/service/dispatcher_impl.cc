@@ -213,6 +213,12 @@ DataServiceDispatcherImpl::~DataServiceDispatcherImpl() {
 
 absl::Status DataServiceDispatcherImpl::Start() {
   mutex_lock l(mu_);
+  if (!config_.worker_count_actuator().empty()) {
+    std::unique_ptr<WorkerCountActuator> actuator;
+    TF_RETURN_IF_ERROR(
+        WorkerCountActuator::Build(config_.worker_count_actuator(), actuator));
+    auto_scaler_.SetWorkerCountActuator(std::move(actuator));
+  }
   if (config_.job_gc_timeout_ms() >= 0) {
     maintenance_thread_ = absl::WrapUnique(env_->StartThread(
         {}, "maintenance-thread", [&] { MaintenanceThread(); }));
@@ -252,6 +258,11 @@ absl::Status DataServiceDispatcherImpl::Start() {
     }
     absl::Duration duration = absl::Microseconds(env_->NowMicros() - start);
     LOG(INFO) << "Restored from journal in " << duration << ".";
+    absl::Status compaction_status = DropObsoleteJournalUpdates();
+    if (!compaction_status.ok()) {
+      LOG(WARNING) << "Failed to compact the dispatcher journal: "
+                   << compaction_status;
+    }
   }
   for (const auto& iteration : state_.ListIterations()) {
     if (IsDynamicShard(iteration->job->processing_mode)) {
@@ -1371,6 +1382,46 @@ absl::Status DataServiceDispatcherImpl::RecordSplitProduced(
   return Apply(update);
 }
 
+absl::Status DataServiceDispatcherImpl::DropObsoleteJournalUpdates()
+    TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+  // Split and task completion updates of garbage collected iterations make up
+  // most of a long-running journal, but garbage collection marks the tasks as
+  // finished, and the split providers of such iterations are never read.
+  absl::flat_hash_set<int64_t> obsolete_iterations;
+  absl::flat_hash_set<int64_t> obsolete_tasks;
+  for (const auto& iteration : state_.ListIterations()) {
+    if (!iteration->garbage_collected) {
+      continue;
+    }
+    obsolete_iterations.insert(iteration->iteration_id);
+    std::vector<std::shared_ptr<const Task>> tasks;
+    TF_RETURN_IF_ERROR(state_.TasksForIteration(iteration->iteration_id, tasks));
+    for (const auto& task : tasks) {
+      obsolete_tasks.insert(task->task_id);
+    }
+  }
+  if (obsolete_iterations.empty()) {
+    return absl::OkStatus();
+  }
+  TF_ASSIGN_OR_RETURN(
+      int64_t num_dropped,
+      CompactJournal(env_, JournalDir(config_.work_dir()),
+                     [&](const Update& update) {
+                       if (update.has_produce_split()) {
+                         return !obsolete_iterations.contains(
+                             update.produce_split().iteration_id());
+                       }
+                       if (update.has_finish_task()) {
+                         return !obsolete_tasks.contains(
+                             update.finish_task().task_id());
+                       }
+                       return true;
+                     }));
+  LOG(INFO) << "Dropped " << num_dropped
+            << " obsolete updates from the dispatcher journal.";
+  return absl::OkStatus();
+}
+
 absl::Status DataServiceDispatcherImpl::ApplyWithoutJournaling(
     const Update& update) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
   return state_.Apply(update);
@@ -315,6 +315,10 @@ class DataServiceDispatcherImpl {
   absl::Status CheckStarted() TF_LOCKS_EXCLUDED(mu_);
   // Restores ongoing tf.data snapshots.
   absl::Status RestoreSnapshots();
+  // Rewrites the journal without the updates that are not needed to restore
+  // the current state. Called on start, before the journal writer is
+  // initialized.
+  absl::Status DropObsoleteJournalUpdates() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
   // Records that a split was produced by a call to `GetSplit`.
   absl::Status RecordSplitProduced(int64_t iteration_id, int64_t repetition,
                                    int64_t split_provider_index, bool finished)
@@ -16,12 +16,16 @@ limitations under the License.
 #include "tensorflow/core/data/service/journal.h"
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
 #include "tensorflow/core/data/service/journal.pb.h"
 #include "tensorflow/core/lib/io/record_reader.h"
 #include "tensorflow/core/lib/io/record_writer.h"
@@ -29,12 +33,15 @@ limitations under the License.
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/path.h"
 #include "tensorflow/core/platform/regexp.h"
+#include "tensorflow/core/platform/statusor.h"
 
 namespace tensorflow {
 namespace data {
 
 namespace {
 constexpr StringPiece kJournal = "journal";
+constexpr StringPiece kCheckpoint = "checkpoint";
+constexpr StringPiece kTempFileSuffix = ".tmp";
 
 absl::Status ParseSequenceNumber(const std::string& journal_file,
                                  int64_t* sequence_number) {
@@ -44,6 +51,41 @@ absl::Status ParseSequenceNumber(const std::string& journal_file,
   }
   return absl::OkStatus();
 }
+
+// Finds the latest journal file and the latest checkpoint in `journal_dir`.
+// Sequence numbers are -1 if there is no such file.
+absl::Status LatestSequenceNumbers(Env* env, const std::string& journal_dir,
+                                   int64_t& latest_journal,
+                                   int64_t& latest_checkpoint) {
+  latest_journal = -1;
+  latest_checkpoint = -1;
+  std::vector<std::string> files;
+  TF_RETURN_IF_ERROR(env->GetChildren(journal_dir, &files));
+  for (const auto& file : files) {
+    if (absl::EndsWith(file, kTempFileSuffix)) {
+      // Left behind by an interrupted compaction.
+      continue;
+    }
+    int64_t sequence_number;
+    TF_RETURN_IF_ERROR(ParseSequenceNumber(file, &sequence_number));
+    if (absl::StartsWith(file, kCheckpoint)) {
+      latest_checkpoint = std::max(latest_checkpoint, sequence_number);
+    } else {
+      latest_journal = std::max(latest_journal, sequence_number);
+    }
+  }
+  return absl::OkStatus();
+}
+
+// Returns the sequence number of the next journal file to write.
+absl::StatusOr<int64_t> NextSequenceNumber(Env* env,
+                                           const std::string& journal_dir) {
+  int64_t latest_journal, latest_checkpoint;
+  TF_RETURN_IF_ERROR(LatestSequenceNumbers(env, journal_dir, latest_journal,
+                                           latest_checkpoint));
+  // `checkpoint_<n>` replaces the journal files before `journal_<n>`.
+  return std::max(latest_journal + 1, latest_checkpoint);
+}
 }  // namespace
 
 std::string DataServiceJournalFile(const std::string& journal_dir,
@@ -52,6 +94,12 @@ std::string DataServiceJournalFile(const std::string& journal_dir,
                       absl::StrCat(kJournal, "_", sequence_number));
 }
 
+std::string DataServiceJournalCheckpointFile(const std::string& journal_dir,
+                                             int64_t sequence_number) {
+  return io::JoinPath(journal_dir,
+                      absl::StrCat(kCheckpoint, "_", sequence_number));
+}
+
 FileJournalWriter::FileJournalWriter(Env* env, const std::string& journal_dir)
     : env_(env), journal_dir_(journal_dir) {}
 
@@ -59,17 +107,11 @@ absl::Status FileJournalWriter::EnsureInitialized() {
   if (writer_) {
     return absl::OkStatus();
   }
-  std::vector<std::string> journal_files;
   TF_RETURN_IF_ERROR(env_->RecursivelyCreateDir(journal_dir_));
-  TF_RETURN_IF_ERROR(env_->GetChildren(journal_dir_, &journal_files));
-  int64_t latest_sequence_number = -1;
-  for (const auto& file : journal_files) {
-    int64_t sequence_number;
-    TF_RETURN_IF_ERROR(ParseSequenceNumber(file, &sequence_number));
-    latest_sequence_number = std::max(latest_sequence_number, sequence_number);
-  }
-  std::string journal_file =
-      DataServiceJournalFile(journal_dir_, latest_sequence_number + 1);
+  TF_ASSIGN_OR_RETURN(int64_t sequence_number,
+                      NextSequenceNumber(env_, journal_dir_));
+  std::string journal_file = DataServiceJournalFile(journal_dir_,
+                                                    sequence_number);
   TF_RETURN_IF_ERROR(env_->NewAppendableFile(journal_file, &file_));
   writer_ = std::make_unique<io::RecordWriter>(file_.get());
   VLOG(1) << "Created journal writer to write to " << journal_file;
@@ -99,6 +141,19 @@ absl::Status FileJournalReader::EnsureInitialized() {
   if (reader_) {
     return absl::OkStatus();
   }
+  int64_t latest_journal = -1, latest_checkpoint = -1;
+  if (env_->IsDirectory(journal_dir_).ok()) {
+    TF_RETURN_IF_ERROR(LatestSequenceNumbers(env_, journal_dir_,
+                                             latest_journal,
+                                             latest_checkpoint));
+  }
+  if (latest_checkpoint >= 0) {
+    // Continue with the journal file following the checkpoint once the
+    // checkpoint has been read.
+    sequence_number_ = latest_checkpoint - 1;
+    return UpdateFile(
+        DataServiceJournalCheckpointFile(journal_dir_, latest_checkpoint));
+  }
   return UpdateFile(DataServiceJournalFile(journal_dir_, 0));
 }
 
@@ -141,5 +196,64 @@ absl::Status FileJournalReader::UpdateFile(const std::string& filename) {
   return absl::OkStatus();
 }
 
+absl::StatusOr<int64_t> CompactJournal(
+    Env* env, const std::string& journal_dir,
+    const std::function<bool(const Update&)>& keep) {
+  if (absl::IsNotFound(env->IsDirectory(journal_dir))) {
+    return 0;
+  }
+  TF_ASSIGN_OR_RETURN(int64_t sequence_number,
+                      NextSequenceNumber(env, journal_dir));
+  const std::string checkpoint_file =
+      DataServiceJournalCheckpointFile(journal_dir, sequence_number);
+  const std::string temp_file = absl::StrCat(checkpoint_file, kTempFileSuffix);
+  int64_t num_dropped = 0;
+  {
+    std::unique_ptr<WritableFile> file;
+    TF_RETURN_IF_ERROR(env->NewWritableFile(temp_file, &file));
+    io::RecordWriter writer(file.get());
+    FileJournalReader reader(env, journal_dir);
+    Update update;
+    bool end_of_journal = false;
+    absl::Status s = reader.Read(update, end_of_journal);
+    if (absl::IsNotFound(s)) {
+      end_of_journal = true;
+    } else {
+      TF_RETURN_IF_ERROR(s);
+    }
+    while (!end_of_journal) {
+      if (keep(update)) {
+        TF_RETURN_IF_ERROR(writer.WriteRecord(update.SerializeAsString()));
+      } else {
+        ++num_dropped;
+      }
+      TF_RETURN_IF_ERROR(reader.Read(update, end_of_journal));
+    }
+    TF_RETURN_IF_ERROR(writer.Close());
+    TF_RETURN_IF_ERROR(file->Sync());
+    TF_RETURN_IF_ERROR(file->Close());
+  }
+  if (num_dropped == 0) {
+    TF_RETURN_IF_ERROR(env->DeleteFile(temp_file));
+    return 0;
+  }
+  // Once the checkpoint exists, readers ignore the files it replaces, so it is
+  // safe to be interrupted while deleting them.
+  TF_RETURN_IF_ERROR(env->RenameFile(temp_file, checkpoint_file));
+  for (int64_t i = 0; i < sequence_number; ++i) {
+    for (const std::string& file : {DataServiceJournalFile(journal_dir, i),
+                                    DataServiceJournalCheckpointFile(
+                                        journal_dir, i)}) {
+      absl::Status s = env->DeleteFile(file);
+      if (!s.ok() && !absl::IsNotFound(s)) {
+        return s;
+      }
+    }
+  }
+  VLOG(1) << "Compacted journal in " << journal_dir << " into "
+          << checkpoint_file << ", dropping " << num_dropped << " updates.";
+  return num_dropped;
+}
+
 }  // namespace data
 }  // namespace tensorflow
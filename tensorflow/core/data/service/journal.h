@@ -15,9 +15,12 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_DATA_SERVICE_JOURNAL_H_
 #define TENSORFLOW_CORE_DATA_SERVICE_JOURNAL_H_
 
+#include <functional>
 #include <memory>
 #include <string>
 
+#include "absl/status/statusor.h"
+
 #include "tensorflow/core/data/service/journal.pb.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/io/record_reader.h"
@@ -31,6 +34,11 @@ namespace data {
 std::string DataServiceJournalFile(const std::string& journal_dir,
                                    int64_t sequence_number);
 
+// Returns the location of the journal checkpoint within the journal directory.
+// `checkpoint_<n>` holds the updates of all journal files before `journal_<n>`.
+std::string DataServiceJournalCheckpointFile(const std::string& journal_dir,
+                                             int64_t sequence_number);
+
 // Interface for writing to a journal.
 class JournalWriter {
  public:
@@ -52,6 +60,14 @@ class JournalWriter {
 //   journal_1
 //   ...
 //
+// After `CompactJournal`, the earlier journal files are replaced by a
+// checkpoint, and new journal files continue the numbering:
+//
+// journal_dir/
+//   checkpoint_3
+//   journal_3
+//   ...
+//
 // When the writer is created, it lists the directory to find the next available
 // journal file name. For example, if the journal directory contains
 // "journal_0", "journal_1", and "journal_2", the writer will write to
@@ -112,6 +128,15 @@ class FileJournalReader : public JournalReader {
   std::unique_ptr<io::SequentialRecordReader> reader_;
 };
 
+// Rewrites the journal in `journal_dir` into a checkpoint that only contains
+// the updates for which `keep` returns true, and deletes the journal files it
+// replaces. Returns the number of dropped updates. If no update is dropped,
+// the journal is left untouched. Must not be called while a `JournalWriter` is
+// writing to `journal_dir`.
+absl::StatusOr<int64_t> CompactJournal(
+    Env* env, const std::string& journal_dir,
+    const std::function<bool(const Update&)>& keep);
+
 }  // namespace data
 }  // namespace tensorflow
 
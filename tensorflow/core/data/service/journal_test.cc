@@ -25,6 +25,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/status_test_util.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/path.h"
+#include "tensorflow/core/platform/status_matchers.h"
 #include "tensorflow/core/platform/test.h"
 #include "tensorflow/core/protobuf/data_service.pb.h"
 
@@ -32,6 +33,7 @@ namespace tensorflow {
 namespace data {
 
 namespace {
+using ::tensorflow::testing::IsOkAndHolds;
 using ::testing::HasSubstr;
 
 bool NewJournalDir(std::string& journal_dir) {
@@ -165,5 +167,51 @@ TEST(Journal, InvalidRecordData) {
   EXPECT_THAT(s.message(), HasSubstr("Failed to parse journal record"));
   EXPECT_EQ(s.code(), error::DATA_LOSS);
 }
+TEST(Journal, CompactJournal) {
+  std::string journal_dir;
+  EXPECT_TRUE(NewJournalDir(journal_dir));
+  for (const auto& update :
+       {MakeCreateIterationUpdate(), MakeFinishTaskUpdate(),
+        MakeRegisterDatasetUpdate(), MakeFinishTaskUpdate()}) {
+    FileJournalWriter writer(Env::Default(), journal_dir);
+    TF_EXPECT_OK(writer.Write(update));
+  }
+  EXPECT_THAT(CompactJournal(Env::Default(), journal_dir,
+                             [](const Update& update) {
+                               return !update.has_finish_task();
+                             }),
+              IsOkAndHolds(2));
+  EXPECT_TRUE(absl::IsNotFound(Env::Default()->FileExists(
+      DataServiceJournalFile(journal_dir, /*sequence_number=*/0))));
+  TF_EXPECT_OK(CheckJournalContent(
+      journal_dir, {MakeCreateIterationUpdate(), MakeRegisterDatasetUpdate()}));
+
+  // New updates are appended after the checkpoint.
+  {
+    FileJournalWriter writer(Env::Default(), journal_dir);
+    TF_EXPECT_OK(writer.Write(MakeFinishTaskUpdate()));
+  }
+  TF_EXPECT_OK(CheckJournalContent(
+      journal_dir, {MakeCreateIterationUpdate(), MakeRegisterDatasetUpdate(),
+                    MakeFinishTaskUpdate()}));
+}
+
+TEST(Journal, CompactJournalWithoutDroppedUpdates) {
+  std::string journal_dir;
+  EXPECT_TRUE(NewJournalDir(journal_dir));
+  std::vector<Update> updates = {MakeCreateIterationUpdate(),
+                                 MakeRegisterDatasetUpdate()};
+  FileJournalWriter writer(Env::Default(), journal_dir);
+  for (const auto& update : updates) {
+    TF_EXPECT_OK(writer.Write(update));
+  }
+  EXPECT_THAT(CompactJournal(Env::Default(), journal_dir,
+                             [](const Update& update) { return true; }),
+              IsOkAndHolds(0));
+  std::vector<std::string> files;
+  TF_ASSERT_OK(Env::Default()->GetChildren(journal_dir, &files));
+  EXPECT_EQ(files, std::vector<std::string>{"journal_0"});
+  TF_EXPECT_OK(CheckJournalContent(journal_dir, updates));
+}
 }  // namespace data
 }  // namespace tensorflow
@@ -0,0 +1,940 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/service/shared_memory_transfer.h"
+
+#if !defined(PLATFORM_WINDOWS)
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tensorflow/core/data/service/data_transfer.h"
+#include "tensorflow/core/data/service/worker.pb.h"
+#include "tensorflow/core/framework/allocation_description.pb.h"
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/framework/metrics.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/random/random.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/refcount.h"
+#include "tensorflow/core/platform/threadpool.h"
+#include "tensorflow/core/protobuf/service_config.pb.h"
+#include "tensorflow/core/util/env_var.h"
+#include "tsl/platform/host_info.h"
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+constexpr uint64_t kMagic = 0x7466646174617368;  // "tfdatash"
+constexpr char kSharedMemoryDir[] = "/dev/shm";
+constexpr char kNamePrefix[] = "tf_data_shm_";
+constexpr char kNumSlotsEnvVar[] = "TF_DATA_SERVICE_SHM_NUM_SLOTS";
+constexpr char kSlotBytesEnvVar[] = "TF_DATA_SERVICE_SHM_SLOT_BYTES";
+constexpr char kNumThreadsEnvVar[] = "TF_DATA_SERVICE_SHM_NUM_THREADS";
+constexpr int64_t kDefaultNumSlots = 16;
+constexpr int64_t kDefaultSlotBytes = 32LL << 20;  // 32MB
+constexpr int64_t kMinSlotBytes = 4LL << 10;       // 4KB
+constexpr int64_t kDefaultNumThreads = 8;
+constexpr int64_t kMaxBackoffMicros = 1000;
+// How long a client may hold a claimed or filled slot before the server
+// reclaims it.
+constexpr int64_t kLeaseTimeoutMicros = 60 * 1000 * 1000;
+constexpr int64_t kReclaimIntervalMicros = 1000 * 1000;
+constexpr int kMaxCreateAttempts = 10;
+constexpr size_t kAlignment = Allocator::kAllocatorAlignment;
+
+// Lifecycle of a slot. The client moves a slot from `kFree` to `kRequested`,
+// the server from `kRequested` to `kFilled`, and the client back to `kFree`
+// once it no longer uses the response. The server also frees the slots held
+// by clients that exited, and the `kClaimed` or `kFilled` slots whose lease
+// expired.
+enum SlotState : uint32_t {
+  kFree = 0,
+  // A client is writing a request.
+  kClaimed = 1,
+  // The request is ready for the server.
+  kRequested = 2,
+  // The server is producing the response.
+  kProcessing = 3,
+  // The response is ready for the client.
+  kFilled = 4,
+  // The client reads the response, or tensors alias it.
+  kInUse = 5,
+  // The client was cancelled while the server was producing the response,
+  // so the server frees the slot when it is done.
+  kAbandoned = 6,
+};
+
+enum ComponentEncoding : uint32_t {
+  // The raw bytes of a tensor whose type supports memcpy.
+  kRaw = 0,
+  // A serialized `TensorProto`.
+  kProto = 1,
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free &&
+                  std::atomic<uint64_t>::is_always_lock_free &&
+                  std::atomic<int64_t>::is_always_lock_free,
+              "Slot states are shared between processes.");
+
+struct alignas(64) RegionHeader {
+  uint64_t magic;
+  uint64_t num_slots;
+  uint64_t slot_bytes;
+  int64_t server_pid;
+};
+
+struct alignas(64) SlotHeader {
+  // The state of the slot and the generation of its lease, see `SlotWord`.
+  std::atomic<uint64_t> word;
+  // The generation of the lease that `client_pid` and `lease_deadline_micros`
+  // belong to. They are only valid while it matches the generation in `word`.
+  std::atomic<uint32_t> lease_generation;
+  // The client process that claimed the slot.
+  std::atomic<int64_t> client_pid;
+  // When a `kClaimed` or `kFilled` slot may be reclaimed, in microseconds.
+  std::atomic<int64_t> lease_deadline_micros;
+  uint64_t request_bytes;
+  uint64_t response_bytes;
+};
+
+// Packs the state of a slot with the generation of its lease. The generation
+// is bumped every time the slot is claimed, so that a client whose lease was
+// reclaimed never takes a later response for its own.
+uint64_t SlotWord(uint32_t generation, SlotState state) {
+  return static_cast<uint64_t>(generation) << 32 | state;
+}
+
+SlotState StateOf(uint64_t word) {
+  return static_cast<SlotState>(word & std::numeric_limits<uint32_t>::max());
+}
+
+uint32_t GenerationOf(uint64_t word) { return word >> 32; }
+
+// Returns false if the process `pid` has exited. Processes are only compared
+// within a host, and are assumed to share a pid namespace.
+bool ProcessIsAlive(int64_t pid) { return kill(pid, 0) == 0 || errno != ESRCH; }
+
+size_t AlignUp(size_t n) {
+  return (n + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+size_t SlotStride(uint64_t slot_bytes) {
+  return AlignUp(sizeof(SlotHeader) + slot_bytes);
+}
+
+size_t RegionBytes(uint64_t num_slots, uint64_t slot_bytes) {
+  return sizeof(RegionHeader) + num_slots * SlotStride(slot_bytes);
+}
+
+std::string RegionName(int64_t id) {
+  return absl::StrCat("/", kNamePrefix, id);
+}
+
+absl::Status ErrnoError(absl::string_view operation, absl::string_view name) {
+  return errors::Internal("Failed to ", operation, " shared memory region ",
+                          name, ": ", strerror(errno));
+}
+
+// A mapping of a shared memory region. The server creates the region and
+// unlinks it when the mapping is destroyed; clients open an existing region.
+class SharedMemoryRegion {
+ public:
+  static absl::StatusOr<std::shared_ptr<SharedMemoryRegion>> Create(
+      const std::string& name, uint64_t num_slots, uint64_t slot_bytes) {
+    const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+      if (errno == EEXIST) {
+        return errors::AlreadyExists("Shared memory region ", name,
+                                     " already exists.");
+      }
+      return ErrnoError("create", name);
+    }
+    const size_t size = RegionBytes(num_slots, slot_bytes);
+    if (ftruncate(fd, size) != 0) {
+      absl::Status s = ErrnoError("resize", name);
+      close(fd);
+      shm_unlink(name.c_str());
+      return s;
+    }
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+      absl::Status s = ErrnoError("map", name);
+      shm_unlink(name.c_str());
+      return s;
+    }
+    auto region = std::shared_ptr<SharedMemoryRegion>(
+        new SharedMemoryRegion(name, data, size, /*owner=*/true));
+    RegionHeader* header = region->header();
+    header->num_slots = num_slots;
+    header->slot_bytes = slot_bytes;
+    header->server_pid = getpid();
+    for (uint64_t i = 0; i < num_slots; ++i) {
+      SlotHeader* slot = region->slot(i);
+      new (&slot->word) std::atomic<uint64_t>(SlotWord(0, kFree));
+      new (&slot->lease_generation) std::atomic<uint32_t>(0);
+      new (&slot->client_pid) std::atomic<int64_t>(0);
+      new (&slot->lease_deadline_micros) std::atomic<int64_t>(0);
+    }
+    // Publish the header last, so that clients never see a partially
+    // initialized region.
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = kMagic;
+    return region;
+  }
+
+  static absl::StatusOr<std::shared_ptr<SharedMemoryRegion>> Open(
+      const std::string& name) {
+    const int fd = shm_open(name.c_str(), O_RDWR, 0600);
+    if (fd < 0) return ErrnoError("open", name);
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      absl::Status s = ErrnoError("stat", name);
+      close(fd);
+      return s;
+    }
+    const size_t size = st.st_size;
+    if (size < sizeof(RegionHeader)) {
+      close(fd);
+      return errors::FailedPrecondition("Shared memory region ", name,
+                                        " is not initialized.");
+    }
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return ErrnoError("map", name);
+    auto region = std::shared_ptr<SharedMemoryRegion>(
+        new SharedMemoryRegion(name, data, size, /*owner=*/false));
+    const RegionHeader* header = region->header();
+    if (header->magic != kMagic ||
+        RegionBytes(header->num_slots, header->slot_bytes) > size) {
+      return errors::FailedPrecondition(
+          "Shared memory region ", name,
+          " is not a tf.data service transfer region.");
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return region;
+  }
+
+  ~SharedMemoryRegion() {
+    munmap(data_, size_);
+    if (owner_) shm_unlink(name_.c_str());
+  }
+
+  uint64_t num_slots() const { return header()->num_slots; }
+  uint64_t slot_bytes() const { return header()->slot_bytes; }
+  int64_t server_pid() const { return header()->server_pid; }
+
+  SlotHeader* slot(uint64_t index) const {
+    return reinterpret_cast<SlotHeader*>(
+        static_cast<char*>(data_) + sizeof(RegionHeader) +
+        index * SlotStride(header()->slot_bytes));
+  }
+
+  // Returns the payload of the slot, which is aligned to `kAlignment`.
+  char* slot_data(uint64_t index) const {
+    return reinterpret_cast<char*>(slot(index)) + sizeof(SlotHeader);
+  }
+
+ private:
+  SharedMemoryRegion(std::string name, void* data, size_t size, bool owner)
+      : name_(std::move(name)), data_(data), size_(size), owner_(owner) {}
+
+  RegionHeader* header() const { return static_cast<RegionHeader*>(data_); }
+
+  const std::string name_;
+  void* const data_;
+  const size_t size_;
+  const bool owner_;
+};
+
+// Sleeps for an exponentially growing duration while polling a slot.
+void Backoff(Env* env, int64_t* backoff_micros) {
+  *backoff_micros = std::min(kMaxBackoffMicros, *backoff_micros * 2 + 1);
+  env->SleepForMicroseconds(*backoff_micros);
+}
+
+// Serializes values into a slot, failing when the slot is full.
+class SlotWriter {
+ public:
+  SlotWriter(char* data, size_t capacity) : data_(data), capacity_(capacity) {}
+
+  bool Write(const void* bytes, size_t n) {
+    if (n > capacity_ - pos_) return false;
+    memcpy(data_ + pos_, bytes, n);
+    pos_ += n;
+    return true;
+  }
+
+  template <typename T>
+  bool Put(T value) {
+    return Write(&value, sizeof(value));
+  }
+
+  // Returns a pointer to the next `n` bytes, aligned to `kAlignment`.
+  char* Reserve(size_t n) {
+    const size_t start = AlignUp(pos_);
+    if (start > capacity_ || n > capacity_ - start) return nullptr;
+    pos_ = start + n;
+    return data_ + start;
+  }
+
+  size_t size() const { return pos_; }
+
+  // Discards everything written so far.
+  void Reset() { pos_ = 0; }
+
+ private:
+  char* const data_;
+  const size_t capacity_;
+  size_t pos_ = 0;
+};
+
+// Parses values written by a `SlotWriter`.
+class SlotReader {
+ public:
+  SlotReader(const char* data, size_t size) : data_(data), size_(size) {}
+
+  bool Read(void* bytes, size_t n) {
+    if (n > size_ - pos_) return false;
+    memcpy(bytes, data_ + pos_, n);
+    pos_ += n;
+    return true;
+  }
+
+  template <typename T>
+  bool Get(T* value) {
+    return Read(value, sizeof(*value));
+  }
+
+  const char* Skip(size_t n, bool aligned) {
+    const size_t start = aligned ? AlignUp(pos_) : pos_;
+    if (start > size_ || n > size_ - start) return nullptr;
+    pos_ = start + n;
+    return data_ + start;
+  }
+
+ private:
+  const char* const data_;
+  const size_t size_;
+  size_t pos_ = 0;
+};
+
+// Writes `status` and, if it is OK, `result` to `writer`. Returns false if
+// they do not fit.
+bool WriteResponse(const absl::Status& status, const GetElementResult& result,
+                   SlotWriter& writer) {
+  const std::string message(status.message());
+  if (!writer.Put<uint32_t>(static_cast<uint32_t>(status.code())) ||
+      !writer.Put<uint32_t>(message.size()) ||
+      !writer.Write(message.data(), message.size())) {
+    return false;
+  }
+  if (!status.ok()) return true;
+  if (!writer.Put<int64_t>(result.element_index) ||
+      !writer.Put<uint32_t>(result.end_of_sequence) ||
+      !writer.Put<uint32_t>(result.skip) ||
+      !writer.Put<uint32_t>(result.components.size())) {
+    return false;
+  }
+  for (const Tensor& component : result.components) {
+    const bool raw = DataTypeCanUseMemcpy(component.dtype());
+    if (!writer.Put<uint32_t>(component.dtype()) ||
+        !writer.Put<uint32_t>(raw ? kRaw : kProto) ||
+        !writer.Put<uint32_t>(component.dims())) {
+      return false;
+    }
+    for (int64_t dim : component.shape().dim_sizes()) {
+      if (!writer.Put<int64_t>(dim)) return false;
+    }
+    if (raw) {
+      const absl::string_view bytes = component.tensor_data();
+      char* dest = writer.Put<uint64_t>(bytes.size())
+                       ? writer.Reserve(bytes.size())
+                       : nullptr;
+      if (dest == nullptr) return false;
+      memcpy(dest, bytes.data(), bytes.size());
+    } else {
+      TensorProto proto;
+      component.AsProtoTensorContent(&proto);
+      const size_t proto_bytes = proto.ByteSizeLong();
+      char* dest =
+          writer.Put<uint64_t>(proto_bytes) ? writer.Reserve(proto_bytes)
+                                            : nullptr;
+      if (dest == nullptr || !proto.SerializeToArray(dest, proto_bytes)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Returns a slot to the pool once the client no longer uses its response.
+class SlotLease {
+ public:
+  SlotLease(std::shared_ptr<SharedMemoryRegion> region, uint64_t index,
+            uint32_t generation)
+      : region_(std::move(region)), index_(index), generation_(generation) {}
+  ~SlotLease() {
+    uint64_t expected = SlotWord(generation_, kInUse);
+    region_->slot(index_)->word.compare_exchange_strong(
+        expected, SlotWord(generation_, kFree), std::memory_order_release);
+  }
+
+ private:
+  const std::shared_ptr<SharedMemoryRegion> region_;
+  const uint64_t index_;
+  const uint32_t generation_;
+};
+
+// Removes the regions left behind by servers that exited without unlinking
+// them, e.g. because they crashed.
+void RemoveStaleRegions() {
+  std::vector<std::string> names;
+  if (!Env::Default()->GetChildren(kSharedMemoryDir, &names).ok()) return;
+  for (const std::string& name : names) {
+    if (!absl::StartsWith(name, kNamePrefix)) continue;
+    const std::string region_name = absl::StrCat("/", name);
+    // Regions that are still being created fail to open and are kept.
+    absl::StatusOr<std::shared_ptr<SharedMemoryRegion>> region =
+        SharedMemoryRegion::Open(region_name);
+    if (!region.ok()) continue;
+    const int64_t server_pid = (*region)->server_pid();
+    if (ProcessIsAlive(server_pid)) continue;
+    if (shm_unlink(region_name.c_str()) == 0) {
+      LOG(WARNING) << "Removed shared memory region " << region_name
+                   << " of exited tf.data service worker process "
+                   << server_pid << ".";
+    }
+  }
+}
+
+// A tensor buffer that aliases a response in shared memory.
+class SharedMemoryBuffer : public TensorBuffer {
+ public:
+  SharedMemoryBuffer(const char* data, size_t size,
+                     std::shared_ptr<SlotLease> lease)
+      : TensorBuffer(const_cast<char*>(data)),
+        size_(size),
+        lease_(std::move(lease)) {}
+
+  size_t size() const override { return size_; }
+  TensorBuffer* root_buffer() override { return this; }
+  void FillAllocationDescription(AllocationDescription* proto) const override {
+    proto->set_requested_bytes(size_);
+    proto->set_allocator_name("shared_memory_transfer");
+  }
+  bool OwnsMemory() const override { return false; }
+
+ private:
+  const size_t size_;
+  const std::shared_ptr<SlotLease> lease_;
+};
+
+// Parses a response written by `WriteResponse`. If `lease` is set, raw
+// components alias the response; otherwise they are copied.
+absl::Status ReadResponse(const char* data, size_t size,
+                          const std::shared_ptr<SlotLease>& lease,
+                          Allocator* allocator, GetElementResult& result) {
+  SlotReader reader(data, size);
+  const absl::Status malformed =
+      errors::DataLoss("Malformed shared memory transfer response.");
+  uint32_t code = 0;
+  uint32_t message_size = 0;
+  if (!reader.Get(&code) || !reader.Get(&message_size)) return malformed;
+  const char* message = reader.Skip(message_size, /*aligned=*/false);
+  if (message == nullptr) return malformed;
+  if (code != static_cast<uint32_t>(absl::StatusCode::kOk)) {
+    return absl::Status(static_cast<absl::StatusCode>(code),
+                        absl::string_view(message, message_size));
+  }
+  uint32_t end_of_sequence = 0;
+  uint32_t skip = 0;
+  uint32_t num_components = 0;
+  if (!reader.Get(&result.element_index) || !reader.Get(&end_of_sequence) ||
+      !reader.Get(&skip) || !reader.Get(&num_components)) {
+    return malformed;
+  }
+  result.end_of_sequence = end_of_sequence;
+  result.skip = skip;
+  result.components.clear();
+  result.components.reserve(num_components);
+  for (uint32_t i = 0; i < num_components; ++i) {
+    uint32_t dtype = 0;
+    uint32_t encoding = 0;
+    uint32_t rank = 0;
+    if (!reader.Get(&dtype) || !reader.Get(&encoding) || !reader.Get(&rank)) {
+      return malformed;
+    }
+    TensorShape shape;
+    for (uint32_t d = 0; d < rank; ++d) {
+      int64_t dim = 0;
+      if (!reader.Get(&dim)) return malformed;
+      TF_RETURN_IF_ERROR(shape.AddDimWithStatus(dim));
+    }
+    uint64_t num_bytes = 0;
+    if (!reader.Get(&num_bytes)) return malformed;
+    const char* bytes = reader.Skip(num_bytes, /*aligned=*/true);
+    if (bytes == nullptr) return malformed;
+    if (encoding == kProto) {
+      TensorProto proto;
+      if (!proto.ParseFromArray(bytes, num_bytes)) return malformed;
+      result.components.emplace_back();
+      const bool success =
+          allocator != nullptr
+              ? result.components.back().FromProto(allocator, proto)
+              : result.components.back().FromProto(proto);
+      if (!success) return errors::Internal("Failed to parse tensor.");
+      continue;
+    }
+    const DataType type = static_cast<DataType>(dtype);
+    if (encoding != kRaw || !DataTypeCanUseMemcpy(type) ||
+        num_bytes != shape.num_elements() * DataTypeSize(type)) {
+      return malformed;
+    }
+    if (lease != nullptr) {
+      result.components.emplace_back(
+          type, shape,
+          core::RefCountPtr<TensorBuffer>(
+              new SharedMemoryBuffer(bytes, num_bytes, lease)));
+    } else {
+      result.components.emplace_back(
+          allocator != nullptr ? allocator : cpu_allocator(), type, shape);
+      memcpy(const_cast<char*>(result.components.back().tensor_data().data()),
+             bytes, num_bytes);
+    }
+  }
+  return absl::OkStatus();
+}
+
+class SharedMemoryTransferServer : public DataTransferServer {
+ public:
+  explicit SharedMemoryTransferServer(GetElementT get_element)
+      : get_element_(std::move(get_element)) {}
+
+  ~SharedMemoryTransferServer() override {
+    cancelled_.store(true, std::memory_order_relaxed);
+    // Stops dispatching requests and waits for the ones being served before
+    // the region is unmapped.
+    dispatcher_.reset();
+    thread_pool_.reset();
+  }
+
+  absl::Status Start(const experimental::WorkerConfig& config) override {
+    int64_t num_slots = 0;
+    int64_t slot_bytes = 0;
+    int64_t num_threads = 0;
+    TF_RETURN_IF_ERROR(
+        ReadInt64FromEnvVar(kNumSlotsEnvVar, kDefaultNumSlots, &num_slots));
+    TF_RETURN_IF_ERROR(
+        ReadInt64FromEnvVar(kSlotBytesEnvVar, kDefaultSlotBytes, &slot_bytes));
+    TF_RETURN_IF_ERROR(ReadInt64FromEnvVar(kNumThreadsEnvVar,
+                                           kDefaultNumThreads, &num_threads));
+    if (num_slots <= 0) {
+      return errors::InvalidArgument(kNumSlotsEnvVar,
+                                     " must be positive, got ", num_slots);
+    }
+    if (slot_bytes < kMinSlotBytes) {
+      return errors::InvalidArgument(kSlotBytesEnvVar, " must be at least ",
+                                     kMinSlotBytes, ", got ", slot_bytes);
+    }
+    if (num_threads <= 0) {
+      return errors::InvalidArgument(kNumThreadsEnvVar,
+                                     " must be positive, got ", num_threads);
+    }
+    RemoveStaleRegions();
+    absl::Status s;
+    for (int attempt = 0; attempt < kMaxCreateAttempts; ++attempt) {
+      // The region is identified by a random id that takes the place of the
+      // port in the advertised transfer address.
+      id_ = 1 + random::New64() % (std::numeric_limits<int32_t>::max() - 1);
+      absl::StatusOr<std::shared_ptr<SharedMemoryRegion>> region =
+          SharedMemoryRegion::Create(RegionName(id_), num_slots, slot_bytes);
+      s = region.status();
+      if (s.ok()) {
+        region_ = *std::move(region);
+        break;
+      }
+      if (!errors::IsAlreadyExists(s)) return s;
+    }
+    TF_RETURN_IF_ERROR(s);
+    thread_pool_ = std::make_unique<thread::ThreadPool>(
+        Env::Default(), "tf_data_shm_transfer",
+        std::min(num_threads, num_slots));
+    dispatcher_.reset(Env::Default()->StartThread(
+        ThreadOptions(), "tf_data_shm_transfer_dispatcher",
+        [this]() { Dispatch(); }));
+    return absl::OkStatus();
+  }
+
+  int Port() const override { return id_; }
+
+  absl::StatusOr<std::string> GetCompatibilityInfo() const override {
+    return tsl::port::Hostname();
+  }
+
+ private:
+  // Hands the requests written to the slots over to the thread pool, and
+  // reclaims the slots of exited or stuck clients, until the server is
+  // destroyed.
+  void Dispatch() {
+    Env* env = Env::Default();
+    int64_t backoff_micros = 0;
+    int64_t next_reclaim_micros = 0;
+    while (!cancelled_.load(std::memory_order_relaxed)) {
+      const int64_t now_micros = env->NowMicros();
+      if (now_micros >= next_reclaim_micros) {
+        ReclaimSlots(now_micros);
+        next_reclaim_micros = now_micros + kReclaimIntervalMicros;
+      }
+      bool dispatched = false;
+      for (uint64_t i = 0; i < region_->num_slots(); ++i) {
+        std::atomic<uint64_t>& word = region_->slot(i)->word;
+        uint64_t current = word.load(std::memory_order_relaxed);
+        if (StateOf(current) != kRequested) continue;
+        const uint32_t generation = GenerationOf(current);
+        if (!word.compare_exchange_strong(current,
+                                          SlotWord(generation, kProcessing),
+                                          std::memory_order_acquire)) {
+          continue;
+        }
+        dispatched = true;
+        thread_pool_->Schedule(
+            [this, i, generation]() { ServeRequest(i, generation); });
+      }
+      if (dispatched) {
+        backoff_micros = 0;
+      } else {
+        Backoff(env, &backoff_micros);
+      }
+    }
+  }
+
+  // Answers the request written to the slot `index`, which `Dispatch` moved
+  // to `kProcessing`.
+  void ServeRequest(uint64_t index, uint32_t generation) {
+    SlotHeader* slot = region_->slot(index);
+    char* data = region_->slot_data(index);
+    GetElementRequest request;
+    GetElementResult result;
+    absl::Status s;
+    if (slot->request_bytes > region_->slot_bytes() ||
+        !request.ParseFromArray(data, slot->request_bytes)) {
+      s = errors::DataLoss("Malformed shared memory transfer request.");
+    } else {
+      s = get_element_(&request, &result);
+    }
+    SlotWriter writer(data, region_->slot_bytes());
+    if (!WriteResponse(s, result, writer)) {
+      writer.Reset();
+      WriteResponse(
+          errors::ResourceExhausted(
+              "The element of task ", request.task_id(),
+              " does not fit in a shared memory transfer slot of ",
+              region_->slot_bytes(), " bytes. Increase ", kSlotBytesEnvVar,
+              " on the tf.data service worker."),
+          result, writer);
+    }
+    slot->response_bytes = writer.size();
+    slot->lease_deadline_micros.store(
+        Env::Default()->NowMicros() + kLeaseTimeoutMicros,
+        std::memory_order_relaxed);
+    uint64_t expected = SlotWord(generation, kProcessing);
+    if (!slot->word.compare_exchange_strong(expected,
+                                            SlotWord(generation, kFilled),
+                                            std::memory_order_release)) {
+      // The client has given up on the request.
+      slot->word.store(SlotWord(generation, kFree), std::memory_order_release);
+    }
+  }
+
+  // Frees the slots held by clients that exited, and the `kClaimed` or
+  // `kFilled` slots whose lease expired. `kInUse` slots may be aliased by
+  // tensors for as long as the client wants, so they never expire.
+  void ReclaimSlots(int64_t now_micros) {
+    for (uint64_t i = 0; i < region_->num_slots(); ++i) {
+      SlotHeader* slot = region_->slot(i);
+      uint64_t current = slot->word.load(std::memory_order_acquire);
+      const SlotState state = StateOf(current);
+      const uint32_t generation = GenerationOf(current);
+      if ((state != kClaimed && state != kFilled && state != kInUse) ||
+          slot->lease_generation.load(std::memory_order_acquire) !=
+              generation) {
+        continue;
+      }
+      const int64_t client_pid =
+          slot->client_pid.load(std::memory_order_relaxed);
+      const bool expired =
+          state != kInUse &&
+          now_micros >
+              slot->lease_deadline_micros.load(std::memory_order_relaxed);
+      if (!expired && ProcessIsAlive(client_pid)) continue;
+      if (slot->word.compare_exchange_strong(current,
+                                             SlotWord(generation, kFree),
+                                             std::memory_order_acq_rel)) {
+        LOG(WARNING) << "Reclaimed shared memory transfer slot " << i
+                     << " of client process " << client_pid << ", which "
+                     << (expired ? "did not release it in time." : "exited.");
+      }
+    }
+  }
+
+  const GetElementT get_element_;
+  int id_ = 0;
+  std::shared_ptr<SharedMemoryRegion> region_;
+  std::atomic<bool> cancelled_ = false;
+  std::unique_ptr<thread::ThreadPool> thread_pool_;
+  std::unique_ptr<Thread> dispatcher_;
+};
+
+class SharedMemoryTransferClient : public DataTransferClient {
+ public:
+  SharedMemoryTransferClient(std::shared_ptr<SharedMemoryRegion> region,
+                             Allocator* allocator)
+      : region_(std::move(region)), allocator_(allocator) {}
+
+  static absl::StatusOr<std::unique_ptr<DataTransferClient>> Create(
+      const Config& config) {
+    const size_t colon = config.address.rfind(':');
+    int64_t id = 0;
+    if (colon == std::string::npos ||
+        !absl::SimpleAtoi(absl::string_view(config.address).substr(colon + 1),
+                          &id)) {
+      return errors::InvalidArgument(
+          "Invalid shared memory transfer address: ", config.address);
+    }
+    TF_ASSIGN_OR_RETURN(std::shared_ptr<SharedMemoryRegion> region,
+                        SharedMemoryRegion::Open(RegionName(id)));
+    return std::make_unique<SharedMemoryTransferClient>(std::move(region),
+                                                        config.allocator);
+  }
+
+  absl::Status GetElement(const GetElementRequest& req,
+                          GetElementResult& result) override {
+    const std::string request = req.SerializeAsString();
+    if (request.size() > region_->slot_bytes()) {
+      return errors::InvalidArgument(
+          "The GetElement request does not fit in a shared memory transfer "
+          "slot.");
+    }
+    const int64_t start_time_us = env_->NowMicros();
+    uint64_t index = 0;
+    uint32_t generation = 0;
+    TF_RETURN_IF_ERROR(ClaimSlot(&index, &generation));
+    SlotHeader* slot = region_->slot(index);
+    memcpy(region_->slot_data(index), request.data(), request.size());
+    slot->request_bytes = request.size();
+    uint64_t expected = SlotWord(generation, kClaimed);
+    if (!slot->word.compare_exchange_strong(expected,
+                                            SlotWord(generation, kRequested),
+                                            std::memory_order_release)) {
+      return LeaseExpiredError();
+    }
+    TF_RETURN_IF_ERROR(WaitForResponse(index, generation));
+
+    // Only alias the response if enough slots stay available for further
+    // requests, since consumers may buffer elements.
+    auto lease = std::make_shared<SlotLease>(region_, index, generation);
+    const bool zero_copy = NumFreeSlots() >= region_->num_slots() / 2;
+    TF_RETURN_IF_ERROR(ReadResponse(region_->slot_data(index),
+                                    slot->response_bytes,
+                                    zero_copy ? lease : nullptr, allocator_,
+                                    result));
+    metrics::RecordTFDataServiceGetElementDuration(
+        kSharedMemoryTransferProtocol, env_->NowMicros() - start_time_us);
+    return absl::OkStatus();
+  }
+
+  void TryCancel() override {
+    cancelled_.store(true, std::memory_order_relaxed);
+  }
+
+  absl::Status CheckCompatibility(
+      const std::string& server_compatibility_info) const override {
+    const std::string hostname = tsl::port::Hostname();
+    if (server_compatibility_info != hostname) {
+      return errors::FailedPrecondition(
+          "The shared memory transfer protocol requires the tf.data service "
+          "worker to run on the same host, but the worker runs on ",
+          server_compatibility_info, " and the client on ", hostname, ".");
+    }
+    return absl::OkStatus();
+  }
+
+ private:
+  absl::Status CheckNotCancelled() const {
+    if (cancelled_.load(std::memory_order_relaxed)) {
+      return errors::Cancelled("Client was cancelled.");
+    }
+    return absl::OkStatus();
+  }
+
+  // Returns an error if the server has exited. Only checked once the backoff
+  // is at its maximum, to keep the polling cheap.
+  absl::Status CheckServerAlive(int64_t backoff_micros) const {
+    if (backoff_micros < kMaxBackoffMicros ||
+        ProcessIsAlive(region_->server_pid())) {
+      return absl::OkStatus();
+    }
+    return errors::Unavailable("The tf.data service worker process ",
+                               region_->server_pid(), " exited.");
+  }
+
+  static absl::Status LeaseExpiredError() {
+    return errors::Unavailable(
+        "The tf.data service worker reclaimed the shared memory transfer "
+        "slot of the request.");
+  }
+
+  // Claims a free slot, and returns its index and the generation of the
+  // lease.
+  absl::Status ClaimSlot(uint64_t* index, uint32_t* generation) {
+    const uint64_t num_slots = region_->num_slots();
+    int64_t backoff_micros = 0;
+    while (true) {
+      TF_RETURN_IF_ERROR(CheckNotCancelled());
+      TF_RETURN_IF_ERROR(CheckServerAlive(backoff_micros));
+      const uint64_t start = next_slot_.fetch_add(1, std::memory_order_relaxed);
+      for (uint64_t i = 0; i < num_slots; ++i) {
+        *index = (start + i) % num_slots;
+        SlotHeader* slot = region_->slot(*index);
+        uint64_t current = slot->word.load(std::memory_order_relaxed);
+        if (StateOf(current) != kFree) continue;
+        *generation = GenerationOf(current) + 1;
+        if (slot->word.compare_exchange_strong(
+                current, SlotWord(*generation, kClaimed),
+                std::memory_order_acquire)) {
+          slot->client_pid.store(pid_, std::memory_order_relaxed);
+          slot->lease_deadline_micros.store(
+              env_->NowMicros() + kLeaseTimeoutMicros,
+              std::memory_order_relaxed);
+          slot->lease_generation.store(*generation, std::memory_order_release);
+          return absl::OkStatus();
+        }
+      }
+      Backoff(env_, &backoff_micros);
+    }
+  }
+
+  absl::Status WaitForResponse(uint64_t index, uint32_t generation) {
+    std::atomic<uint64_t>& word = region_->slot(index)->word;
+    int64_t backoff_micros = 0;
+    while (true) {
+      uint64_t expected = SlotWord(generation, kFilled);
+      if (word.compare_exchange_strong(expected, SlotWord(generation, kInUse),
+                                       std::memory_order_acquire)) {
+        return absl::OkStatus();
+      }
+      if (GenerationOf(expected) != generation || StateOf(expected) == kFree) {
+        return LeaseExpiredError();
+      }
+      absl::Status s = CheckNotCancelled();
+      if (s.ok()) s = CheckServerAlive(backoff_micros);
+      if (!s.ok()) {
+        Abandon(word, generation);
+        return s;
+      }
+      Backoff(env_, &backoff_micros);
+    }
+  }
+
+  // Releases a slot whose response is no longer wanted. Depending on how far
+  // the server got, the slot is freed here or by the server.
+  static void Abandon(std::atomic<uint64_t>& word, uint32_t generation) {
+    while (true) {
+      uint64_t current = word.load(std::memory_order_acquire);
+      const SlotState state = StateOf(current);
+      if (GenerationOf(current) != generation || state == kFree ||
+          state == kAbandoned) {
+        return;
+      }
+      const SlotState next = state == kProcessing ? kAbandoned : kFree;
+      if (word.compare_exchange_strong(current, SlotWord(generation, next),
+                                       std::memory_order_acq_rel)) {
+        return;
+      }
+    }
+  }
+
+  uint64_t NumFreeSlots() const {
+    uint64_t num_free = 0;
+    for (uint64_t i = 0; i < region_->num_slots(); ++i) {
+      if (StateOf(region_->slot(i)->word.load(std::memory_order_relaxed)) ==
+          kFree) {
+        ++num_free;
+      }
+    }
+    return num_free;
+  }
+
+  const std::shared_ptr<SharedMemoryRegion> region_;
+  Allocator* const allocator_;
+  const int64_t pid_ = getpid();
+  std::atomic<uint64_t> next_slot_ = 0;
+  std::atomic<bool> cancelled_ = false;
+};
+
+class SharedMemoryTransferRegistrar {
+ public:
+  SharedMemoryTransferRegistrar() {
+    DataTransferServer::Register(
+        kSharedMemoryTransferProtocol,
+        [](DataTransferServer::GetElementT get_element,
+           std::shared_ptr<DataTransferServer>* out) {
+          *out = std::make_shared<SharedMemoryTransferServer>(
+              std::move(get_element));
+          return absl::OkStatus();
+        });
+    DataTransferClient::Register(
+        kSharedMemoryTransferProtocol,
+        [](DataTransferClient::Config config,
+           std::unique_ptr<DataTransferClient>* out) {
+          TF_ASSIGN_OR_RETURN(*out,
+                              SharedMemoryTransferClient::Create(config));
+          return absl::OkStatus();
+        });
+  }
+};
+static SharedMemoryTransferRegistrar shared_memory_transfer_registrar;
+
+}  // namespace
+}  // namespace data
+}  // namespace tensorflow
+
+#endif  // !defined(PLATFORM_WINDOWS)
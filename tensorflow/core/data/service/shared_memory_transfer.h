@@ -0,0 +1,49 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_DATA_SERVICE_SHARED_MEMORY_TRANSFER_H_
+#define TENSORFLOW_CORE_DATA_SERVICE_SHARED_MEMORY_TRANSFER_H_
+
+namespace tensorflow {
+namespace data {
+
+// A data transfer protocol for tf.data service workers and clients that run
+// on the same host, e.g. one process preprocessing data for several local
+// training processes.
+//
+// The worker creates a POSIX shared memory region with a fixed number of
+// slots. A client claims a free slot, writes its `GetElementRequest` into it,
+// and waits for the worker to write the element back in the same slot. When
+// enough slots are free, the components of the element alias the shared
+// memory, so they reach the consumer without being copied; the slot is
+// released once the last of them is destroyed.
+//
+// The worker frees the slots of clients that exited, and the slots that a
+// client neither filled with a request nor picked the response of within a
+// minute. Clients fail with an `Unavailable` error once the worker exits, and
+// the next worker on the host removes the region the exited worker left
+// behind.
+//
+// The number of slots, their size and the number of threads serving them are
+// set on the worker with the `TF_DATA_SERVICE_SHM_NUM_SLOTS`,
+// `TF_DATA_SERVICE_SHM_SLOT_BYTES` and `TF_DATA_SERVICE_SHM_NUM_THREADS`
+// environment variables. Elements that do not fit in a slot fail with a
+// `ResourceExhausted` error. Clients on another host fail the compatibility
+// check and fall back to gRPC.
+constexpr const char kSharedMemoryTransferProtocol[] = "shm";
+
+}  // namespace data
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_DATA_SERVICE_SHARED_MEMORY_TRANSFER_H_
@@ -0,0 +1,244 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/service/shared_memory_transfer.h"
+
+#if !defined(PLATFORM_WINDOWS)
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif  // !defined(PLATFORM_WINDOWS)
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "tensorflow/core/data/service/data_transfer.h"
+#include "tensorflow/core/data/service/worker.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+#if !defined(PLATFORM_WINDOWS)
+
+absl::Status BuildClient(int port,
+                         std::unique_ptr<DataTransferClient>* client) {
+  DataTransferClient::Config config;
+  config.protocol = kSharedMemoryTransferProtocol;
+  config.address = absl::StrCat("localhost:", port);
+  config.allocator = nullptr;
+  return DataTransferClient::Build(kSharedMemoryTransferProtocol, config,
+                                   client);
+}
+
+std::unique_ptr<DataTransferClient> MakeClient(
+    const DataTransferServer& server) {
+  std::unique_ptr<DataTransferClient> client;
+  TF_CHECK_OK(BuildClient(server.Port(), &client));
+  return client;
+}
+
+TEST(SharedMemoryTransferTest, GetElement) {
+  std::shared_ptr<DataTransferServer> server;
+  TF_ASSERT_OK(DataTransferServer::Build(
+      kSharedMemoryTransferProtocol,
+      [](const GetElementRequest* request, GetElementResult* result) {
+        result->components.push_back(
+            test::AsTensor<int64_t>({request->task_id(), 2, 3}));
+        result->components.push_back(test::AsScalar<tstring>("element"));
+        result->element_index = 7;
+        return absl::OkStatus();
+      },
+      &server));
+  TF_ASSERT_OK(server->Start(/*config=*/{}));
+  std::unique_ptr<DataTransferClient> client = MakeClient(*server);
+  TF_ASSERT_OK(client->CheckCompatibility(*server->GetCompatibilityInfo()));
+
+  // Issue more requests than there are slots, to check that slots are
+  // released once the elements are destroyed.
+  for (int i = 0; i < 100; ++i) {
+    GetElementRequest request;
+    request.set_task_id(i);
+    GetElementResult result;
+    TF_ASSERT_OK(client->GetElement(request, result));
+    ASSERT_EQ(result.components.size(), 2);
+    test::ExpectEqual(result.components[0],
+                      test::AsTensor<int64_t>({i, 2, 3}));
+    test::ExpectEqual(result.components[1], test::AsScalar<tstring>("element"));
+    EXPECT_EQ(result.element_index, 7);
+    EXPECT_FALSE(result.end_of_sequence);
+  }
+}
+
+TEST(SharedMemoryTransferTest, EndOfSequence) {
+  std::shared_ptr<DataTransferServer> server;
+  TF_ASSERT_OK(DataTransferServer::Build(
+      kSharedMemoryTransferProtocol,
+      [](const GetElementRequest* request, GetElementResult* result) {
+        result->end_of_sequence = true;
+        return absl::OkStatus();
+      },
+      &server));
+  TF_ASSERT_OK(server->Start(/*config=*/{}));
+  std::unique_ptr<DataTransferClient> client = MakeClient(*server);
+
+  GetElementResult result;
+  TF_ASSERT_OK(client->GetElement(GetElementRequest(), result));
+  EXPECT_TRUE(result.end_of_sequence);
+  EXPECT_TRUE(result.components.empty());
+}
+
+TEST(SharedMemoryTransferTest, PropagatesErrors) {
+  std::shared_ptr<DataTransferServer> server;
+  TF_ASSERT_OK(DataTransferServer::Build(
+      kSharedMemoryTransferProtocol,
+      [](const GetElementRequest* request, GetElementResult* result) {
+        return errors::NotFound("Task not found.");
+      },
+      &server));
+  TF_ASSERT_OK(server->Start(/*config=*/{}));
+  std::unique_ptr<DataTransferClient> client = MakeClient(*server);
+
+  GetElementResult result;
+  absl::Status s = client->GetElement(GetElementRequest(), result);
+  EXPECT_TRUE(errors::IsNotFound(s)) << s;
+  EXPECT_EQ(s.message(), "Task not found.");
+}
+
+TEST(SharedMemoryTransferTest, IncompatibleHost) {
+  std::shared_ptr<DataTransferServer> server;
+  TF_ASSERT_OK(DataTransferServer::Build(
+      kSharedMemoryTransferProtocol,
+      [](const GetElementRequest* request, GetElementResult* result) {
+        return absl::OkStatus();
+      },
+      &server));
+  TF_ASSERT_OK(server->Start(/*config=*/{}));
+  std::unique_ptr<DataTransferClient> client = MakeClient(*server);
+  EXPECT_TRUE(errors::IsFailedPrecondition(
+      client->CheckCompatibility("some-other-host")));
+}
+
+TEST(SharedMemoryTransferTest, CancelledClient) {
+  std::shared_ptr<DataTransferServer> server;
+  TF_ASSERT_OK(DataTransferServer::Build(
+      kSharedMemoryTransferProtocol,
+      [](const GetElementRequest* request, GetElementResult* result) {
+        return absl::OkStatus();
+      },
+      &server));
+  TF_ASSERT_OK(server->Start(/*config=*/{}));
+  std::unique_ptr<DataTransferClient> client = MakeClient(*server);
+  client->TryCancel();
+  GetElementResult result;
+  EXPECT_TRUE(
+      errors::IsCancelled(client->GetElement(GetElementRequest(), result)));
+}
+
+TEST(SharedMemoryTransferTest, ReclaimsSlotOfExitedClient) {
+  tensorflow::setenv("TF_DATA_SERVICE_SHM_NUM_SLOTS", "1", 1 /* overwrite */);
+  std::shared_ptr<DataTransferServer> server;
+  TF_ASSERT_OK(DataTransferServer::Build(
+      kSharedMemoryTransferProtocol,
+      [](const GetElementRequest* request, GetElementResult* result) {
+        result->components.push_back(test::AsTensor<int64_t>({1, 2, 3}));
+        return absl::OkStatus();
+      },
+      &server));
+  TF_ASSERT_OK(server->Start(/*config=*/{}));
+  tensorflow::unsetenv("TF_DATA_SERVICE_SHM_NUM_SLOTS");
+
+  // The child exits while its element aliases the only slot.
+  const pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    std::unique_ptr<DataTransferClient> client = MakeClient(*server);
+    GetElementResult result;
+    _exit(client->GetElement(GetElementRequest(), result).ok() ? 0 : 1);
+  }
+  int wstatus = 0;
+  ASSERT_EQ(waitpid(pid, &wstatus, 0), pid);
+  ASSERT_TRUE(WIFEXITED(wstatus));
+  ASSERT_EQ(WEXITSTATUS(wstatus), 0);
+
+  std::unique_ptr<DataTransferClient> client = MakeClient(*server);
+  GetElementResult result;
+  TF_ASSERT_OK(client->GetElement(GetElementRequest(), result));
+  ASSERT_EQ(result.components.size(), 1);
+  test::ExpectEqual(result.components[0], test::AsTensor<int64_t>({1, 2, 3}));
+}
+
+TEST(SharedMemoryTransferTest, ExitedServer) {
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  const pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    // Sends the port of a server to the parent, and waits to be killed.
+    std::shared_ptr<DataTransferServer> server;
+    int port = 0;
+    if (DataTransferServer::Build(
+            kSharedMemoryTransferProtocol,
+            [](const GetElementRequest* request, GetElementResult* result) {
+              return absl::OkStatus();
+            },
+            &server)
+            .ok() &&
+        server->Start(/*config=*/{}).ok()) {
+      port = server->Port();
+    }
+    if (write(fds[1], &port, sizeof(port)) != sizeof(port)) _exit(1);
+    while (true) pause();
+  }
+  close(fds[1]);
+  int port = 0;
+  ASSERT_EQ(read(fds[0], &port, sizeof(port)), sizeof(port));
+  close(fds[0]);
+  ASSERT_GT(port, 0);
+  std::unique_ptr<DataTransferClient> client;
+  TF_ASSERT_OK(BuildClient(port, &client));
+  ASSERT_EQ(kill(pid, SIGKILL), 0);
+  ASSERT_EQ(waitpid(pid, nullptr, 0), pid);
+
+  GetElementResult result;
+  absl::Status s = client->GetElement(GetElementRequest(), result);
+  EXPECT_TRUE(errors::IsUnavailable(s)) << s;
+
+  // The next server removes the region of the exited one.
+  std::shared_ptr<DataTransferServer> server;
+  TF_ASSERT_OK(DataTransferServer::Build(
+      kSharedMemoryTransferProtocol,
+      [](const GetElementRequest* request, GetElementResult* result) {
+        return absl::OkStatus();
+      },
+      &server));
+  TF_ASSERT_OK(server->Start(/*config=*/{}));
+  EXPECT_FALSE(BuildClient(port, &client).ok());
+}
+
+#endif  // !defined(PLATFORM_WINDOWS)
+
+}  // namespace
+}  // namespace data
+}  // namespace tensorflow
@@ -17,9 +17,11 @@ limitations under the License.
 #include <algorithm>
 #include <memory>
 #include <optional>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/strings/string_view.h"
 #include "tensorflow/core/data/service/byte_size.h"
 #include "tensorflow/core/data/service/common.h"
 #include "tensorflow/core/data/service/cross_trainer_cache.h"
@@ -31,6 +33,7 @@ limitations under the License.
 #include "tensorflow/core/framework/dataset.h"
 #include "tensorflow/core/framework/model.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/framework/tensor_util.h"
 #include "tensorflow/core/lib/gtl/cleanup.h"
 #include "tensorflow/core/platform/env.h"
@@ -48,6 +51,8 @@ namespace {
 constexpr int64_t kWaitBeforeSkipUs = 100 * 1000;  // 100ms.
 constexpr size_t kDefaultCrossTrainerCacheSizeBytes =
     10 * (size_t{1} << 30);  // 10GB
+constexpr size_t kDefaultCrossTrainerCacheSpillSizeBytes =
+    100 * (size_t{1} << 30);  // 100GB
 
 }  // namespace
 
@@ -100,17 +105,28 @@ absl::Status TaskRunner::Create(const experimental::WorkerConfig& worker_config,
         worker_config.cross_trainer_cache_size_bytes() > 0
             ? worker_config.cross_trainer_cache_size_bytes()
             : kDefaultCrossTrainerCacheSizeBytes;
-    out = std::make_unique<CachingTaskRunner>(std::move(iterator),
-                                              max_cache_size_bytes);
+    std::optional<CrossTrainerCacheSpillOptions> spill_options;
+    if (!worker_config.cross_trainer_cache_spill_dir().empty()) {
+      spill_options = CrossTrainerCacheSpillOptions{
+          worker_config.cross_trainer_cache_spill_dir(),
+          worker_config.cross_trainer_cache_spill_size_bytes() > 0
+              ? static_cast<size_t>(
+                    worker_config.cross_trainer_cache_spill_size_bytes())
+              : kDefaultCrossTrainerCacheSpillSizeBytes};
+    }
+    out = std::make_unique<CachingTaskRunner>(
+        std::move(iterator), max_cache_size_bytes, std::move(spill_options));
   } else {
-    out = std::make_unique<FirstComeFirstServedTaskRunner>(std::move(iterator));
+    out = std::make_unique<FirstComeFirstServedTaskRunner>(
+        std::move(iterator),
+        std::max<int64_t>(1, worker_config.task_prefetch_buffer_size()));
   }
   return absl::OkStatus();
 }
 
 FirstComeFirstServedTaskRunner::FirstComeFirstServedTaskRunner(
-    std::unique_ptr<TaskIterator> iterator)
-    : iterator_(std::move(iterator)), buffer_(/*buffer_size=*/1) {
+    std::unique_ptr<TaskIterator> iterator, int64_t buffer_size)
+    : iterator_(std::move(iterator)), buffer_(buffer_size) {
   RunPrefetchThread();
 }
 
@@ -118,8 +134,16 @@ FirstComeFirstServedTaskRunner::~FirstComeFirstServedTaskRunner() { Cancel(); }
 
 absl::Status FirstComeFirstServedTaskRunner::GetNext(
     const GetElementRequest& req, GetElementResult& result) {
-  if (req.allow_skip() && buffer_.Empty()) {
-    result.skip = true;
+  if (req.allow_skip()) {
+    // Checks and pops under one lock, so that another request can't take the
+    // element in between and make this one block.
+    TF_ASSIGN_OR_RETURN(std::optional<GetElementResult> buffered,
+                        buffer_.TryPop());
+    if (!buffered.has_value()) {
+      result.skip = true;
+      return absl::OkStatus();
+    }
+    result = *std::move(buffered);
     return absl::OkStatus();
   }
   return GetNext(result);
@@ -177,11 +201,13 @@ std::shared_ptr<model::Model> FirstComeFirstServedTaskRunner::model() const {
   return model_;
 }
 
-CachingTaskRunner::CachingTaskRunner(std::unique_ptr<TaskIterator> iterator,
-                                     size_t max_cache_size_bytes)
+CachingTaskRunner::CachingTaskRunner(
+    std::unique_ptr<TaskIterator> iterator, size_t max_cache_size_bytes,
+    std::optional<CrossTrainerCacheSpillOptions> spill_options)
     : fcfs_task_runner_(std::move(iterator)),
       cache_(max_cache_size_bytes,
-             std::make_unique<GetElementResultSequence>(fcfs_task_runner_)) {
+             std::make_unique<GetElementResultSequence>(fcfs_task_runner_),
+             std::move(spill_options)) {
   LOG(INFO) << "Initialized tf.data service cross-trainer cache with "
             << ByteSize::Bytes(max_cache_size_bytes) << " of memory.";
 }
@@ -217,6 +243,42 @@ size_t CachingTaskRunner::GetElementResultSequence::GetElementSizeBytes(
   return element.EstimatedMemoryUsageBytes();
 }
 
+absl::Status CachingTaskRunner::GetElementResultSequence::SerializeElement(
+    const GetElementResult& element, std::string& out) const {
+  GetElementResponse response;
+  for (const Tensor& component : element.components) {
+    component.AsProtoTensorContent(
+        response.mutable_uncompressed()->add_components());
+  }
+  response.set_element_index(element.element_index);
+  if (!response.SerializeToString(&out)) {
+    return errors::Internal(
+        "Failed to serialize a cross-trainer cache element.");
+  }
+  return absl::OkStatus();
+}
+
+absl::StatusOr<GetElementResult>
+CachingTaskRunner::GetElementResultSequence::DeserializeElement(
+    absl::string_view serialized) const {
+  GetElementResponse response;
+  if (!response.ParseFromString(serialized)) {
+    return errors::DataLoss(
+        "Failed to parse a spilled cross-trainer cache element.");
+  }
+  GetElementResult result;
+  for (const TensorProto& proto : response.uncompressed().components()) {
+    Tensor component;
+    if (!component.FromProto(proto)) {
+      return errors::DataLoss(
+          "Failed to parse a spilled cross-trainer cache element component.");
+    }
+    result.components.push_back(std::move(component));
+  }
+  result.element_index = response.element_index();
+  return result;
+}
+
 void CachingTaskRunner::Cancel() {
   VLOG(2) << "Cancelling tf.data service cross-trainer cache task.";
   if (!cache_.IsCancelled()) {
@@ -17,8 +17,11 @@ limitations under the License.
 
 #include <memory>
 #include <optional>
+#include <string>
 #include <vector>
 
+#include "absl/strings/string_view.h"
+
 #include "tensorflow/core/data/service/common.pb.h"
 #include "tensorflow/core/data/service/cross_trainer_cache.h"
 #include "tensorflow/core/data/service/data_transfer.h"
@@ -109,8 +112,9 @@ class TaskRunner {
 // It does not consider which consumer is making the request.
 class FirstComeFirstServedTaskRunner : public TaskRunner {
  public:
+  // Up to `buffer_size` elements are prefetched ahead of the requests.
   explicit FirstComeFirstServedTaskRunner(
-      std::unique_ptr<TaskIterator> iterator);
+      std::unique_ptr<TaskIterator> iterator, int64_t buffer_size = 1);
   ~FirstComeFirstServedTaskRunner() override;
 
   // Gets the next element. It may block if the element is not ready yet.
@@ -154,8 +158,12 @@ class FirstComeFirstServedTaskRunner : public TaskRunner {
 // read the full dataset.
 class CachingTaskRunner : public TaskRunner {
  public:
-  explicit CachingTaskRunner(std::unique_ptr<TaskIterator> iterator,
-                             size_t max_cache_size_bytes);
+  // If `spill_options` is set, elements evicted from the cache are spilled to
+  // disk so that slow trainers can still read them.
+  explicit CachingTaskRunner(
+      std::unique_ptr<TaskIterator> iterator, size_t max_cache_size_bytes,
+      std::optional<CrossTrainerCacheSpillOptions> spill_options =
+          std::nullopt);
   ~CachingTaskRunner() override;
 
   // Gets the next element from the cross-trainer cache, blocking if the data is
@@ -181,6 +189,10 @@ class CachingTaskRunner : public TaskRunner {
         FirstComeFirstServedTaskRunner& fcfs_task_runner);
     absl::StatusOr<GetElementResult> GetNext() override;
     size_t GetElementSizeBytes(const GetElementResult& element) const override;
+    absl::Status SerializeElement(const GetElementResult& element,
+                                  std::string& out) const override;
+    absl::StatusOr<GetElementResult> DeserializeElement(
+        absl::string_view serialized) const override;
 
    private:
     FirstComeFirstServedTaskRunner& fcfs_task_runner_;
@@ -214,6 +214,27 @@ TEST(FirstComeFirstServedTaskRunnerTest, GetNext) {
   EXPECT_TRUE(result.end_of_sequence);
 }
 
+TEST(FirstComeFirstServedTaskRunnerTest, AllowSkipOnlyReturnsPrefetched) {
+  size_t range = 10;
+  FirstComeFirstServedTaskRunner runner(
+      std::make_unique<RangeIterator>(range, /*repeat=*/false),
+      /*buffer_size=*/4);
+  GetElementRequest request;
+  request.set_allow_skip(true);
+  std::vector<int64_t> output;
+  while (true) {
+    GetElementResult result;
+    TF_ASSERT_OK(runner.GetNext(request, result));
+    if (result.end_of_sequence) break;
+    if (result.skip) {
+      Env::Default()->SleepForMicroseconds(1000);
+      continue;
+    }
+    output.push_back(result.components[0].flat<int64_t>()(0));
+  }
+  EXPECT_THAT(output, ElementsAreArray(GetRange(range)));
+}
+
 TEST(FirstComeFirstServedTaskRunnerTest, EmptyDataset) {
   FirstComeFirstServedTaskRunner runner(
       std::make_unique<RangeIterator>(/*range=*/0, /*repeat=*/false));
@@ -16,6 +16,7 @@ limitations under the License.
 #define TENSORFLOW_CORE_DATA_SERVICE_THREAD_SAFE_BUFFER_H_
 
 #include <deque>
+#include <optional>
 #include <utility>
 
 #include "tensorflow/core/platform/macros.h"
@@ -38,6 +39,10 @@ class ThreadSafeBuffer final {
   // a non-OK status was pushed or the buffer has been cancelled.
   StatusOr<T> Pop();
 
+  // Like `Pop`, but returns std::nullopt instead of blocking if the buffer is
+  // empty.
+  StatusOr<std::optional<T>> TryPop();
+
   // Writes the next element. Blocks if the buffer is full. Returns an error if
   // the buffer has been cancelled.
   absl::Status Push(StatusOr<T> value);
@@ -92,6 +97,24 @@ StatusOr<T> ThreadSafeBuffer<T>::Pop() {
   return result;
 }
 
+template <class T>
+StatusOr<std::optional<T>> ThreadSafeBuffer<T>::TryPop() {
+  mutex_lock l(mu_);
+  if (!status_.ok()) {
+    return status_;
+  }
+  if (results_.empty()) {
+    return std::optional<T>();
+  }
+  StatusOr<T> result = std::move(results_.front());
+  results_.pop_front();
+  ready_to_push_.notify_one();
+  if (!result.ok()) {
+    return result.status();
+  }
+  return std::optional<T>(*std::move(result));
+}
+
 template <class T>
 absl::Status ThreadSafeBuffer<T>::Push(StatusOr<T> value) {
   mutex_lock l(mu_);
@@ -15,6 +15,7 @@ limitations under the License.
 #include "tensorflow/core/data/service/thread_safe_buffer.h"
 
 #include <memory>
+#include <optional>
 #include <tuple>
 #include <vector>
 
@@ -213,6 +214,22 @@ TEST_P(ThreadSafeBufferTest, CancelWriters) {
   buffer.Cancel(errors::Cancelled("Cancelled"));
 }
 
+TEST_P(ThreadSafeBufferTest, TryPop) {
+  ThreadSafeBuffer<int> buffer(GetBufferSize());
+  TF_ASSERT_OK_AND_ASSIGN(std::optional<int> empty, buffer.TryPop());
+  EXPECT_FALSE(empty.has_value());
+
+  ASSERT_THAT(buffer.Push(1), IsOk());
+  TF_ASSERT_OK_AND_ASSIGN(std::optional<int> next, buffer.TryPop());
+  EXPECT_EQ(next, 1);
+
+  ASSERT_THAT(buffer.Push(errors::DataLoss("Data loss")), IsOk());
+  EXPECT_THAT(buffer.TryPop(), StatusIs(error::DATA_LOSS));
+
+  buffer.Cancel(errors::Cancelled("Cancelled"));
+  EXPECT_THAT(buffer.TryPop(), StatusIs(error::CANCELLED));
+}
+
 TEST_P(ThreadSafeBufferTest, CancelMultipleTimes) {
   ThreadSafeBuffer<Tensor> buffer(GetBufferSize());
   buffer.Cancel(errors::Unknown("Unknown"));
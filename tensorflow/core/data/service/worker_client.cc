@@ -80,6 +80,12 @@ absl::Status DataServiceWorkerClient::GetElement(const GetElementRequest& req,
   return client_->GetElement(req, result);
 }
 
+absl::Status DataServiceWorkerClient::GetElements(
+    const GetElementRequest& req, std::vector<GetElementResult>& results) {
+  TF_RETURN_IF_ERROR(EnsureInitialized());
+  return client_->GetElements(req, results);
+}
+
 absl::Status DataServiceWorkerClient::EnsureInitialized() {
   mutex_lock l(mu_);
   if (client_) {
@@ -114,6 +120,39 @@ class GrpcDataTransferClient : public DataTransferClient {
 
   absl::Status GetElement(const GetElementRequest& req,
                           GetElementResult& result) override {
+    GetElementResponse resp;
+    TF_RETURN_IF_ERROR(CallGetElement(req, resp));
+    return ParseResponse(resp, result);
+  }
+
+  absl::Status GetElements(const GetElementRequest& req,
+                           std::vector<GetElementResult>& results) override {
+    GetElementResponse resp;
+    TF_RETURN_IF_ERROR(CallGetElement(req, resp));
+    results.clear();
+    results.reserve(resp.additional_elements_size() + 1);
+    results.emplace_back();
+    TF_RETURN_IF_ERROR(ParseResponse(resp, results.back()));
+    for (GetElementResponse& element : *resp.mutable_additional_elements()) {
+      results.emplace_back();
+      TF_RETURN_IF_ERROR(ParseResponse(element, results.back()));
+    }
+    return absl::OkStatus();
+  }
+
+  void TryCancel() override {
+    VLOG(2) << "Cancel GrpcDataTransferClient.";
+    mutex_lock l(mu_);
+    cancelled_ = true;
+    for (const auto& ctx : active_contexts_) {
+      ctx->TryCancel();
+    }
+  }
+
+ private:
+  // Sends `req` to the worker and stores its response in `resp`.
+  absl::Status CallGetElement(const GetElementRequest& req,
+                              GetElementResponse& resp) {
     VLOG(3) << "GetElement for task " << req.task_id() << " from gRPC worker "
             << "server.";
     {
@@ -132,7 +171,6 @@ class GrpcDataTransferClient : public DataTransferClient {
         active_contexts_.erase(&ctx);
       });
     }
-    GetElementResponse resp;
     int64_t start_time_us = env_->NowMicros();
     grpc::Status s = stub_->GetElement(&ctx, req, &resp);
     int64_t end_time_us = env_->NowMicros();
@@ -141,12 +179,19 @@ class GrpcDataTransferClient : public DataTransferClient {
     }
     metrics::RecordTFDataServiceGetElementDuration(kGrpcTransferProtocol,
                                                    end_time_us - start_time_us);
+    return absl::OkStatus();
+  }
+
+  // Converts the element in `resp` into `result`, consuming `resp`'s element.
+  absl::Status ParseResponse(GetElementResponse& resp,
+                             GetElementResult& result) {
+    result.element_index = resp.element_index();
     result.end_of_sequence = resp.end_of_sequence();
     result.skip = resp.skip_task();
     switch (resp.element_case()) {
       case GetElementResponse::kCompressed: {
         Tensor tensor(DT_VARIANT, TensorShape{});
-        tensor.scalar<Variant>()() = std::move(resp.compressed());
+        tensor.scalar<Variant>()() = std::move(*resp.mutable_compressed());
         result.components.push_back(tensor);
         break;
       }
@@ -168,16 +213,6 @@ class GrpcDataTransferClient : public DataTransferClient {
     return absl::OkStatus();
   }
 
-  void TryCancel() override {
-    VLOG(2) << "Cancel GrpcDataTransferClient.";
-    mutex_lock l(mu_);
-    cancelled_ = true;
-    for (const auto& ctx : active_contexts_) {
-      ctx->TryCancel();
-    }
-  }
-
- private:
   Allocator* const allocator_;
   mutex mu_;
   std::unique_ptr<WorkerService::Stub> stub_;
@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "tensorflow/core/data/service/common.h"
 #include "tensorflow/core/data/service/common.pb.h"
@@ -47,6 +48,10 @@ class DataServiceWorkerClient : public DataServiceClientBase {
   // Fetches an element from the worker.
   absl::Status GetElement(const GetElementRequest& req,
                           GetElementResult& result);
+  // Fetches up to `req.max_elements()` consecutive elements from the worker.
+  // See `DataTransferClient::GetElements`.
+  absl::Status GetElements(const GetElementRequest& req,
+                           std::vector<GetElementResult>& results);
 
   // Makes a best effort to cancel all outstanding calls in progress for the
   // client, and causes further calls to return Cancelled status.
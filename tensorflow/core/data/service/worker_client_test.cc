@@ -18,6 +18,7 @@ limitations under the License.
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
@@ -275,6 +276,43 @@ TEST_P(DataTransferProtocolWorkerClientTest, NetworkRead) {
   }
 }
 
+TEST_F(WorkerClientTest, BatchedNetworkRead) {
+  LocalWorkers::Remove(GetWorkerAddress());
+  const int64_t range = 10;
+  TF_ASSERT_OK_AND_ASSIGN(const std::string dataset_id, RegisterDataset(range));
+  TF_ASSERT_OK_AND_ASSIGN(const int64_t iteration_client_id,
+                          CreateIteration(dataset_id));
+  TF_ASSERT_OK_AND_ASSIGN(const int64_t task_id,
+                          GetTaskToRead(iteration_client_id));
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<DataServiceWorkerClient> client,
+                          GetWorkerClient(kGrpcTransferProtocol));
+
+  GetElementRequest request;
+  request.set_task_id(task_id);
+  request.set_max_elements(4);
+  std::vector<int64_t> elements;
+  bool end_of_sequence = false;
+  while (!end_of_sequence) {
+    std::vector<GetElementResult> results;
+    TF_ASSERT_OK(client->GetElements(request, results));
+    ASSERT_GE(results.size(), 1);
+    ASSERT_LE(results.size(), 4);
+    for (int i = 0; i < results.size(); ++i) {
+      if (results[i].end_of_sequence) {
+        EXPECT_EQ(i, results.size() - 1);
+        end_of_sequence = true;
+        break;
+      }
+      elements.push_back(results[i].components[0].scalar<int64_t>()());
+    }
+  }
+  std::vector<int64_t> expected;
+  for (int64_t i = 0; i < range; ++i) {
+    expected.push_back(i * i);
+  }
+  EXPECT_EQ(elements, expected);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     NetworkProtocols, DataTransferProtocolWorkerClientTest,
     ::testing::Values(kGrpcTransferProtocol, kAltTransferProtocol),
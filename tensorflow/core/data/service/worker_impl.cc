@@ -76,12 +76,16 @@ namespace {
 constexpr absl::Duration kRetryInterval = absl::Seconds(5);
 constexpr absl::Duration kDefaultHeartBeatInterval = absl::Seconds(30);
 constexpr absl::Duration kDefaultDispatcherTimeout = absl::Hours(1);
+// Limits the number of bytes of elements batched into a single GetElement
+// response.
+constexpr int64_t kMaxBatchedResponseBytes = 16 << 20;
 
 using WorkerConfig = experimental::WorkerConfig;
 
 // Moves the element into the response. If the tensor contains a single
-// CompressedElement variant, the move will be zero-copy. Otherwise, the tensor
-// data will be serialized as TensorProtos.
+// CompressedElement variant that is not shared with other tensors, the move
+// will be zero-copy. Otherwise, the tensor data will be copied or serialized
+// as TensorProtos.
 absl::Status MoveElementToResponse(std::vector<Tensor>&& element,
                                    GetElementResponse& resp) {
   if (element.size() != 1 || element[0].dtype() != DT_VARIANT ||
@@ -100,7 +104,13 @@ absl::Status MoveElementToResponse(std::vector<Tensor>&& element,
         "it produced ",
         variant.TypeName());
   }
-  *resp.mutable_compressed() = *compressed;
+  if (element[0].RefCountIsOne()) {
+    // Nothing else references the compressed bytes, e.g. a cached copy of the
+    // element, so they can be handed to the response without a copy.
+    resp.mutable_compressed()->Swap(compressed);
+  } else {
+    *resp.mutable_compressed() = *compressed;
+  }
   return absl::OkStatus();
 }
 
@@ -256,7 +266,8 @@ DataServiceWorkerImpl::CreateDispatcherClient() const TF_LOCKS_EXCLUDED(mu_) {
 }
 
 absl::Status DataServiceWorkerImpl::GetElementResult(
-    const GetElementRequest* request, struct GetElementResult* result) {
+    const GetElementRequest* request, struct GetElementResult* result,
+    bool defer_runner_errors) {
   Task* task = nullptr;
   {
     mutex_lock l(mu_);
@@ -299,7 +310,21 @@ absl::Status DataServiceWorkerImpl::GetElementResult(
     cv_.notify_all();
   });
   TF_RETURN_IF_ERROR(EnsureTaskInitialized(*task));
-  TF_RETURN_IF_ERROR(task->task_runner->GetNext(*request, *result));
+  std::optional<absl::StatusOr<struct GetElementResult>> returned_result;
+  {
+    mutex_lock l(task->mu);
+    returned_result.swap(task->returned_result);
+  }
+  if (returned_result.has_value()) {
+    TF_RETURN_IF_ERROR(returned_result->status());
+    *result = **std::move(returned_result);
+  } else if (absl::Status s = task->task_runner->GetNext(*request, *result);
+             !s.ok()) {
+    if (defer_runner_errors) {
+      ReturnElementResult(request->task_id(), s);
+    }
+    return s;
+  }
 
   if (result->end_of_sequence) {
     mutex_lock l(mu_);
@@ -484,13 +509,76 @@ absl::Status DataServiceWorkerImpl::GetElement(const GetElementRequest* request,
   response->set_end_of_sequence(result.end_of_sequence);
   response->set_skip_task(result.skip);
   if (!response->end_of_sequence() && !response->skip_task()) {
+    int64_t response_bytes = result.EstimatedMemoryUsageBytes();
     TF_RETURN_IF_ERROR(
         MoveElementToResponse(std::move(result.components), *response));
     VLOG(3) << "Producing an element for task " << request->task_id();
+    if (request->max_elements() > 1 && !request->has_consumer_index() &&
+        request->trainer_id().empty()) {
+      TF_RETURN_IF_ERROR(
+          AddAvailableElements(*request, response_bytes, *response));
+    }
   }
   return absl::OkStatus();
 }
 
+absl::Status DataServiceWorkerImpl::AddAvailableElements(
+    const GetElementRequest& request, int64_t response_bytes,
+    GetElementResponse& response) {
+  // Only take elements that are already buffered, so that batching never
+  // delays the element the client asked for.
+  GetElementRequest nonblocking_request = request;
+  nonblocking_request.set_allow_skip(true);
+  while (response.additional_elements_size() + 1 < request.max_elements() &&
+         response_bytes < kMaxBatchedResponseBytes) {
+    struct GetElementResult result;
+    absl::Status s = GetElementResult(&nonblocking_request, &result,
+                                      /*defer_runner_errors=*/true);
+    if (!s.ok()) {
+      // The error is returned by the next request.
+      VLOG(3) << "Stopped batching elements for task " << request.task_id()
+              << ": " << s;
+      return absl::OkStatus();
+    }
+    if (result.skip) {
+      return absl::OkStatus();
+    }
+    GetElementResponse* element = response.add_additional_elements();
+    element->set_element_index(result.element_index);
+    if (result.end_of_sequence) {
+      element->set_end_of_sequence(true);
+      return absl::OkStatus();
+    }
+    response_bytes += result.EstimatedMemoryUsageBytes();
+    absl::Status s =
+        MoveElementToResponse(std::move(result.components), *element);
+    if (!s.ok()) {
+      // MoveElementToResponse fails before taking the element. The elements
+      // already in the response are sent, and this one is returned by the
+      // next request so that it reports the error.
+      VLOG(3) << "Stopped batching elements for task " << request.task_id()
+              << ": " << s;
+      response.mutable_additional_elements()->RemoveLast();
+      ReturnElementResult(request.task_id(), std::move(result));
+      return absl::OkStatus();
+    }
+  }
+  return absl::OkStatus();
+}
+
+void DataServiceWorkerImpl::ReturnElementResult(
+    int64_t task_id, absl::StatusOr<struct GetElementResult> result) {
+  std::shared_ptr<Task> task;
+  {
+    mutex_lock l(mu_);
+    auto it = tasks_.find(task_id);
+    if (it == tasks_.end()) return;
+    task = it->second;
+  }
+  mutex_lock l(task->mu);
+  task->returned_result = std::move(result);
+}
+
 absl::Status DataServiceWorkerImpl::GetWorkerTasks(
     const GetWorkerTasksRequest* request, GetWorkerTasksResponse* response) {
   mutex_lock l(mu_);
@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -24,6 +25,7 @@ limitations under the License.
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/hash/hash.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "tensorflow/core/data/service/common.pb.h"
 #include "tensorflow/core/data/service/data_transfer.h"
@@ -63,9 +65,12 @@ class DataServiceWorkerImpl {
   void Stop();
 
   // Serves a GetElement request, storing the result in `*result`. See
-  // worker.proto for GetElement API documentation.
+  // worker.proto for GetElement API documentation. If `defer_runner_errors`,
+  // an error of the task runner is also returned by the next request for the
+  // task, since the error element has been consumed.
   absl::Status GetElementResult(const GetElementRequest* request,
-                                GetElementResult* result);
+                                GetElementResult* result,
+                                bool defer_runner_errors = false);
 
   // Deletes the local task and iterator. Only called by local clients to delete
   // unused task iterators assuming the task is not read by remote clients. This
@@ -99,6 +104,10 @@ class DataServiceWorkerImpl {
     bool initialized TF_GUARDED_BY(mu) = false;
     int64_t outstanding_requests TF_GUARDED_BY(&DataServiceWorkerImpl::mu_) = 0;
     std::unique_ptr<TaskRunner> task_runner;
+    // An element or error taken from `task_runner` for a batched response but
+    // not sent. It is returned by the next request for the task.
+    std::optional<absl::StatusOr<struct GetElementResult>> returned_result
+        TF_GUARDED_BY(mu);
   };
 
   struct SnapshotTask {
@@ -149,6 +158,17 @@ class DataServiceWorkerImpl {
   // Returns the task IDs of `active_tasks`.
   std::vector<int64_t> GetTaskIds(
       const std::vector<ActiveTask>& active_tasks) const;
+  // Appends elements that are already available for `request`'s task to
+  // `response.additional_elements`, up to `request.max_elements()` elements in
+  // total. `response_bytes` is the size of the element already in `response`.
+  absl::Status AddAvailableElements(const GetElementRequest& request,
+                                    int64_t response_bytes,
+                                    GetElementResponse& response);
+  // Keeps `result`, taken from the runner of the task but not sent, for the
+  // next request for the task.
+  void ReturnElementResult(int64_t task_id,
+                           absl::StatusOr<struct GetElementResult> result)
+      TF_LOCKS_EXCLUDED(mu_);
   // Builds a heartbeat request.
   WorkerHeartbeatRequest BuildWorkerHeartbeatRequest() const
       TF_LOCKS_EXCLUDED(mu_);
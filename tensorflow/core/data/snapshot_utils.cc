@@ -35,6 +35,7 @@ limitations under the License.
 #include "tensorflow/core/framework/graph.pb.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/lib/hash/crc32c.h"
 #include "tensorflow/core/lib/io/buffered_inputstream.h"
 #include "tensorflow/core/lib/io/random_inputstream.h"
 #include "tensorflow/core/lib/io/record_writer.h"
@@ -42,11 +43,14 @@ limitations under the License.
 #include "tensorflow/core/lib/io/zlib_inputstream.h"
 #include "tensorflow/core/lib/io/zlib_outputbuffer.h"
 #include "tensorflow/core/platform/coding.h"
+#include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/file_system.h"
+#include "tensorflow/core/platform/notification.h"
 #include "tensorflow/core/platform/path.h"
 #include "tensorflow/core/platform/random.h"
 #include "tensorflow/core/platform/strcat.h"
 #include "tensorflow/core/platform/stringprintf.h"
+#include "tensorflow/core/platform/threadpool.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/protobuf/snapshot.pb.h"
 #include "tsl/platform/errors.h"
@@ -78,6 +82,37 @@ std::string ProtoSerializationErrorMessage(const TensorProto& proto,
   return error_message;
 }
 
+// Maximum number of threads compressing the blocks of a `ChunkedWriter`.
+constexpr int kMaxChunkedWriterThreads = 8;
+
+absl::Status ValidateChunkedCompression(const std::string& compression_type) {
+  if (compression_type != io::compression::kNone &&
+      compression_type != io::compression::kSnappy) {
+    return errors::InvalidArgument(
+        "Snapshot file format version ", kChunkedFileFormatVersion,
+        " does not support compression ", compression_type,
+        ". Use SNAPPY or no compression.");
+  }
+  return absl::OkStatus();
+}
+
+void AppendFixed64(uint64_t value, std::string* dest) {
+  char buf[sizeof(uint64_t)];
+  core::EncodeFixed64(buf, value);
+  dest->append(buf, sizeof(buf));
+}
+
+// Decodes the fixed64 at `*position` of `data` and advances `*position`.
+bool ConsumeFixed64(absl::string_view data, size_t* position,
+                    uint64_t* value) {
+  if (data.size() - *position < sizeof(uint64_t)) {
+    return false;
+  }
+  *value = core::DecodeFixed64(data.data() + *position);
+  *position += sizeof(uint64_t);
+  return true;
+}
+
 }  // namespace
 
 /* static */ constexpr const int64_t
@@ -128,6 +163,10 @@ absl::Status Writer::Create(Env* env, const std::string& filename,
       *out_writer =
           std::make_unique<TFRecordWriter>(filename, compression_type);
       break;
+    case kChunkedFileFormatVersion:
+      *out_writer =
+          std::make_unique<ChunkedWriter>(filename, compression_type);
+      break;
     default:
       return errors::InvalidArgument("Snapshot writer version: ", version,
                                      " is not supported.");
@@ -361,6 +400,133 @@ absl::Status CustomWriter::WriteRecord(const absl::Cord& data) {
 }
 #endif  // TF_CORD_SUPPORT
 
+struct ChunkedWriter::Block {
+  // Uncompressed contents, replaced by the compressed contents once
+  // `compressed` is notified.
+  std::string data;
+  uint64_t first_element = 0;
+  uint64_t uncompressed_size = 0;
+  uint32_t crc = 0;
+  absl::Status status;
+  Notification compressed;
+};
+
+ChunkedWriter::ChunkedWriter(const std::string& filename,
+                             const std::string& compression_type)
+    : filename_(filename), compression_type_(compression_type) {}
+
+absl::Status ChunkedWriter::Initialize(tensorflow::Env* env) {
+  TF_RETURN_IF_ERROR(ValidateChunkedCompression(compression_type_));
+  TF_RETURN_IF_ERROR(env->NewWritableFile(filename_, &dest_));
+  const int num_threads =
+      std::max(1, std::min(port::MaxParallelism(), kMaxChunkedWriterThreads));
+  compression_pool_ = std::make_unique<thread::ThreadPool>(
+      env, ThreadOptions(), "snapshot_chunked_writer", num_threads);
+  // Bounds the memory used by blocks waiting to be compressed or written.
+  max_pending_blocks_ = 2 * num_threads;
+  return absl::OkStatus();
+}
+
+absl::Status ChunkedWriter::WriteTensors(const std::vector<Tensor>& tensors) {
+  if (current_block_ == nullptr) {
+    current_block_ = std::make_shared<Block>();
+    current_block_->first_element = num_elements_;
+  }
+  std::string& data = current_block_->data;
+  AppendFixed64(tensors.size(), &data);
+  for (const auto& tensor : tensors) {
+    TensorProto proto;
+    tensor.AsProtoTensorContent(&proto);
+    const size_t size = proto.ByteSizeLong();
+    AppendFixed64(size, &data);
+    const size_t position = data.size();
+    data.resize(position + size);
+    if (!proto.SerializeToArray(&data[position], size)) {
+      return errors::DataLoss(ProtoSerializationErrorMessage(proto, filename_));
+    }
+  }
+  ++num_elements_;
+  if (data.size() >= kBlockSizeBytes) {
+    SubmitBlock();
+    while (pending_blocks_.size() > max_pending_blocks_) {
+      TF_RETURN_IF_ERROR(WriteOldestBlock());
+    }
+  }
+  return absl::OkStatus();
+}
+
+void ChunkedWriter::SubmitBlock() {
+  std::shared_ptr<Block> block = std::move(current_block_);
+  pending_blocks_.push_back(block);
+  compression_pool_->Schedule([block, compression_type = compression_type_]() {
+    tsl::profiler::TraceMe activity("SnapshotChunkedWriterCompress",
+                                    tsl::profiler::TraceMeLevel::kInfo);
+    block->uncompressed_size = block->data.size();
+    if (compression_type == io::compression::kSnappy) {
+      std::string compressed;
+      if (tsl::port::Snappy_Compress(block->data.data(), block->data.size(),
+                                     &compressed)) {
+        block->data = std::move(compressed);
+      } else {
+        block->status = errors::Internal("Failed to compress using snappy.");
+      }
+    }
+    block->crc = crc32c::Value(block->data.data(), block->data.size());
+    block->compressed.Notify();
+  });
+}
+
+absl::Status ChunkedWriter::WriteOldestBlock() {
+  std::shared_ptr<Block> block = std::move(pending_blocks_.front());
+  pending_blocks_.pop_front();
+  block->compressed.WaitForNotification();
+  TF_RETURN_IF_ERROR(block->status);
+  TF_RETURN_IF_ERROR(dest_->Append(block->data));
+  AppendFixed64(block->first_element, &index_);
+  AppendFixed64(offset_, &index_);
+  AppendFixed64(block->data.size(), &index_);
+  AppendFixed64(block->uncompressed_size, &index_);
+  AppendFixed64(block->crc, &index_);
+  offset_ += block->data.size();
+  ++num_blocks_;
+  return absl::OkStatus();
+}
+
+absl::Status ChunkedWriter::Sync() {
+  if (current_block_ != nullptr) {
+    SubmitBlock();
+  }
+  while (!pending_blocks_.empty()) {
+    TF_RETURN_IF_ERROR(WriteOldestBlock());
+  }
+  return dest_->Flush();
+}
+
+absl::Status ChunkedWriter::Close() {
+  if (dest_ != nullptr) {
+    TF_RETURN_IF_ERROR(Sync());
+    std::string trailer;
+    AppendFixed64(offset_, &trailer);
+    AppendFixed64(num_blocks_, &trailer);
+    AppendFixed64(num_elements_, &trailer);
+    AppendFixed64(kMagic, &trailer);
+    TF_RETURN_IF_ERROR(dest_->Append(index_));
+    TF_RETURN_IF_ERROR(dest_->Append(trailer));
+    TF_RETURN_IF_ERROR(dest_->Close());
+    dest_ = nullptr;
+  }
+  return absl::OkStatus();
+}
+
+ChunkedWriter::~ChunkedWriter() {
+  absl::Status s = Close();
+  if (!s.ok()) {
+    LOG(ERROR) << "Failed to close snapshot file " << filename_ << ": " << s;
+  }
+  // Waits for outstanding compressions before the blocks are released.
+  compression_pool_ = nullptr;
+}
+
 absl::Status Reader::Create(Env* env, const std::string& filename,
                             const string& compression_type, int version,
                             const DataTypeVector& dtypes,
@@ -378,6 +544,10 @@ absl::Status Reader::Create(Env* env, const std::string& filename,
       *out_reader =
           std::make_unique<TFRecordReader>(filename, compression_type, dtypes);
       break;
+    case kChunkedFileFormatVersion:
+      *out_reader =
+          std::make_unique<ChunkedReader>(filename, compression_type);
+      break;
     default:
       return errors::InvalidArgument("Snapshot reader version: ", version,
                                      " is not supported.");
@@ -528,13 +698,8 @@ class Reader::Dataset : public DatasetBase {
                                    current_checkpoint_id_);
     }
 
-    // TODO(frankchn): Optimize this to not parse every single element.
     absl::Status AdvanceToStartIndex(IteratorContext* ctx) {
-      for (int64_t i = 0; i < start_index_; ++i) {
-        std::vector<Tensor> unused;
-        TF_RETURN_IF_ERROR(reader_->ReadTensors(&unused));
-      }
-      return absl::OkStatus();
+      return reader_->SkipRecords(start_index_);
     }
 
     std::unique_ptr<Reader> reader_;
@@ -1008,6 +1173,175 @@ absl::Status CustomReader::ReadRecord(absl::Cord* record) {
 }
 #endif  // TF_CORD_SUPPORT
 
+ChunkedReader::ChunkedReader(const std::string& filename,
+                             const std::string& compression_type)
+    : filename_(filename), compression_type_(compression_type) {}
+
+absl::Status ChunkedReader::Initialize(Env* env) {
+  TF_RETURN_IF_ERROR(ValidateChunkedCompression(compression_type_));
+  TF_RETURN_IF_ERROR(env->NewRandomAccessFile(filename_, &file_));
+  uint64_t file_size = 0;
+  TF_RETURN_IF_ERROR(env->GetFileSize(filename_, &file_size));
+  const absl::Status corrupted = errors::DataLoss(
+      "Snapshot file ", filename_, " is not a valid version ",
+      kChunkedFileFormatVersion, " snapshot file.");
+  if (file_size < ChunkedWriter::kTrailerSize) {
+    return corrupted;
+  }
+  char trailer_scratch[ChunkedWriter::kTrailerSize];
+  StringPiece trailer;
+  TF_RETURN_IF_ERROR(file_->Read(file_size - ChunkedWriter::kTrailerSize,
+                                 ChunkedWriter::kTrailerSize, &trailer,
+                                 trailer_scratch));
+  size_t position = 0;
+  uint64_t index_offset = 0;
+  uint64_t num_blocks = 0;
+  uint64_t magic = 0;
+  if (!ConsumeFixed64(trailer, &position, &index_offset) ||
+      !ConsumeFixed64(trailer, &position, &num_blocks) ||
+      !ConsumeFixed64(trailer, &position, &num_elements_) ||
+      !ConsumeFixed64(trailer, &position, &magic) ||
+      magic != ChunkedWriter::kMagic || index_offset > file_size ||
+      (file_size - index_offset - ChunkedWriter::kTrailerSize) !=
+          num_blocks * ChunkedWriter::kIndexEntrySize) {
+    return corrupted;
+  }
+  std::string index_scratch(num_blocks * ChunkedWriter::kIndexEntrySize, '\0');
+  StringPiece index;
+  TF_RETURN_IF_ERROR(file_->Read(index_offset, index_scratch.size(), &index,
+                                 index_scratch.data()));
+  position = 0;
+  blocks_.resize(num_blocks);
+  for (BlockInfo& block : blocks_) {
+    if (!ConsumeFixed64(index, &position, &block.first_element) ||
+        !ConsumeFixed64(index, &position, &block.offset) ||
+        !ConsumeFixed64(index, &position, &block.size) ||
+        !ConsumeFixed64(index, &position, &block.uncompressed_size) ||
+        !ConsumeFixed64(index, &position, &block.crc) ||
+        block.offset > index_offset ||
+        block.size > index_offset - block.offset ||
+        block.first_element >= num_elements_) {
+      return corrupted;
+    }
+  }
+  return absl::OkStatus();
+}
+
+absl::Status ChunkedReader::LoadBlock(int64_t index) {
+  tsl::profiler::TraceMe activity("SnapshotChunkedReaderLoadBlock",
+                                  tsl::profiler::TraceMeLevel::kInfo);
+  if (index >= blocks_.size()) {
+    return errors::DataLoss("Snapshot file ", filename_,
+                            " has fewer blocks than elements.");
+  }
+  const BlockInfo& block = blocks_[index];
+  std::string scratch(block.size, '\0');
+  StringPiece data;
+  TF_RETURN_IF_ERROR(
+      file_->Read(block.offset, block.size, &data, scratch.data()));
+  if (data.size() != block.size ||
+      crc32c::Value(data.data(), data.size()) != block.crc) {
+    return errors::DataLoss("Corrupted block ", index, " in snapshot file ",
+                            filename_);
+  }
+  if (compression_type_ == io::compression::kSnappy) {
+    size_t uncompressed_size = 0;
+    if (!tsl::port::Snappy_GetUncompressedLength(data.data(), data.size(),
+                                                 &uncompressed_size) ||
+        uncompressed_size != block.uncompressed_size) {
+      return errors::DataLoss("Failed to get the uncompressed size of block ",
+                              index, " in snapshot file ", filename_);
+    }
+    block_.resize(uncompressed_size);
+    if (!tsl::port::Snappy_Uncompress(data.data(), data.size(), &block_[0])) {
+      return errors::DataLoss("Failed to uncompress block ", index,
+                              " in snapshot file ", filename_);
+    }
+  } else {
+    block_.assign(data.data(), data.size());
+  }
+  block_index_ = index;
+  block_position_ = 0;
+  next_element_ = block.first_element;
+  return absl::OkStatus();
+}
+
+absl::Status ChunkedReader::SkipInBlock(uint64_t num_elements) {
+  for (uint64_t i = 0; i < num_elements; ++i) {
+    uint64_t num_components = 0;
+    if (!ConsumeFixed64(block_, &block_position_, &num_components)) {
+      return errors::DataLoss("Corrupted element in snapshot file ", filename_);
+    }
+    for (uint64_t j = 0; j < num_components; ++j) {
+      uint64_t size = 0;
+      if (!ConsumeFixed64(block_, &block_position_, &size) ||
+          size > block_.size() - block_position_) {
+        return errors::DataLoss("Corrupted element in snapshot file ",
+                                filename_);
+      }
+      block_position_ += size;
+    }
+    ++next_element_;
+  }
+  return absl::OkStatus();
+}
+
+absl::Status ChunkedReader::ReadTensors(std::vector<Tensor>* read_tensors) {
+  if (next_element_ >= num_elements_) {
+    return errors::OutOfRange("End of snapshot file ", filename_);
+  }
+  if (block_index_ == -1 || block_position_ == block_.size()) {
+    TF_RETURN_IF_ERROR(LoadBlock(block_index_ + 1));
+  }
+  const absl::Status corrupted =
+      errors::DataLoss("Corrupted element in snapshot file ", filename_);
+  uint64_t num_components = 0;
+  if (!ConsumeFixed64(block_, &block_position_, &num_components)) {
+    return corrupted;
+  }
+  read_tensors->clear();
+  read_tensors->reserve(num_components);
+  for (uint64_t i = 0; i < num_components; ++i) {
+    uint64_t size = 0;
+    if (!ConsumeFixed64(block_, &block_position_, &size) ||
+        size > block_.size() - block_position_) {
+      return corrupted;
+    }
+    TensorProto proto;
+    if (!proto.ParseFromArray(block_.data() + block_position_, size)) {
+      return corrupted;
+    }
+    block_position_ += size;
+    read_tensors->emplace_back();
+    if (!read_tensors->back().FromProto(proto)) {
+      return corrupted;
+    }
+  }
+  ++next_element_;
+  return absl::OkStatus();
+}
+
+absl::Status ChunkedReader::SkipRecords(int64_t num_records) {
+  if (num_records <= 0) {
+    return absl::OkStatus();
+  }
+  if (num_records > num_elements_ - next_element_) {
+    next_element_ = num_elements_;
+    return errors::OutOfRange("End of snapshot file ", filename_);
+  }
+  const uint64_t target = next_element_ + num_records;
+  // Finds the block that holds `target`.
+  auto it = std::upper_bound(blocks_.begin(), blocks_.end(), target,
+                             [](uint64_t element, const BlockInfo& block) {
+                               return element < block.first_element;
+                             });
+  const int64_t index = std::distance(blocks_.begin(), it) - 1;
+  if (index != block_index_) {
+    TF_RETURN_IF_ERROR(LoadBlock(index));
+  }
+  return SkipInBlock(target - next_element_);
+}
+
 absl::Status WriteMetadataFile(
     Env* env, const string& dir,
     const experimental::SnapshotMetadataRecord* metadata) {
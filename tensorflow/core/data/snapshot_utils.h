@@ -37,6 +37,7 @@ limitations under the License.
 #include "tensorflow/core/platform/file_system.h"
 #include "tensorflow/core/platform/path.h"
 #include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/threadpool.h"
 #include "tensorflow/core/protobuf/snapshot.pb.h"
 
 namespace tensorflow {
@@ -56,6 +57,9 @@ namespace snapshot_util {
 
 constexpr char kMetadataFilename[] = "snapshot.metadata";
 
+// File format version of snapshots written with `ChunkedWriter`.
+constexpr int kChunkedFileFormatVersion = 3;
+
 constexpr char kModeAuto[] = "auto";
 constexpr char kModeWrite[] = "write";
 constexpr char kModeRead[] = "read";
@@ -173,6 +177,66 @@ class CustomWriter : public Writer {
   int num_complex_ = 0;
 };
 
+// Writes snapshots as a sequence of independently compressed blocks, followed
+// by an index of the blocks. Blocks are compressed in parallel and the index
+// lets `ChunkedReader` start reading at any element.
+//
+// File layout:
+//   block_0 ... block_{n-1}
+//   index entry for each block: first element, offset, size,
+//     uncompressed size and crc32c of the block, as fixed64 values
+//   trailer: index offset, number of blocks, number of elements, magic
+//
+// A block holds consecutive elements. Each element is encoded as the
+// number of its components followed by their length-prefixed serialized
+// `TensorProto`s. Only no compression and snappy compression are supported.
+class ChunkedWriter : public Writer {
+ public:
+  // A block is compressed once it holds at least this many bytes.
+  static constexpr const size_t kBlockSizeBytes = 4 << 20;  // 4 MiB
+  static constexpr const uint64_t kMagic = 0x33564b4e4843534eULL;
+  static constexpr const size_t kIndexEntrySize = 5 * sizeof(uint64_t);
+  static constexpr const size_t kTrailerSize = 4 * sizeof(uint64_t);
+
+  ChunkedWriter(const std::string& filename,
+                const std::string& compression_type);
+
+  absl::Status WriteTensors(const std::vector<Tensor>& tensors) override;
+
+  absl::Status Sync() override;
+
+  absl::Status Close() override;
+
+  ~ChunkedWriter() override;
+
+ protected:
+  absl::Status Initialize(tensorflow::Env* env) override;
+
+ private:
+  struct Block;
+
+  // Schedules the compression of the current block.
+  void SubmitBlock();
+
+  // Waits for the oldest submitted block to be compressed and appends it to
+  // the file.
+  absl::Status WriteOldestBlock();
+
+  const std::string filename_;
+  const std::string compression_type_;
+  std::unique_ptr<WritableFile> dest_;
+  std::unique_ptr<thread::ThreadPool> compression_pool_;
+  size_t max_pending_blocks_ = 0;
+
+  std::shared_ptr<Block> current_block_;
+  std::deque<std::shared_ptr<Block>> pending_blocks_;
+  // Serialized index entries of the blocks written so far.
+  std::string index_;
+  uint64_t num_blocks_ = 0;
+  uint64_t num_elements_ = 0;
+  uint64_t offset_ = 0;
+};
+
 // Interface class for reading snapshot files previous written with Writer.
 class Reader {
  public:
@@ -364,6 +428,51 @@ class CustomReader : public Reader {
   std::vector<bool> simple_tensor_mask_;  // true for simple, false for complex.
 };
 
+// Reads snapshots previously written with `ChunkedWriter`.
+class ChunkedReader : public Reader {
+ public:
+  ChunkedReader(const std::string& filename,
+                const std::string& compression_type);
+
+  absl::Status ReadTensors(std::vector<Tensor>* read_tensors) override;
+
+  // Skips `num_records` by seeking to the block that holds the target
+  // element, so only that block is read and decompressed.
+  absl::Status SkipRecords(int64_t num_records) override;
+
+ protected:
+  absl::Status Initialize(Env* env) override;
+
+ private:
+  struct BlockInfo {
+    uint64_t first_element;
+    uint64_t offset;
+    uint64_t size;
+    uint64_t uncompressed_size;
+    uint64_t crc;
+  };
+
+  // Reads and decompresses the block `index` and positions the reader at its
+  // first element.
+  absl::Status LoadBlock(int64_t index);
+
+  // Advances past `num_elements` elements of the loaded block.
+  absl::Status SkipInBlock(uint64_t num_elements);
+
+  const std::string filename_;
+  const std::string compression_type_;
+  std::unique_ptr<RandomAccessFile> file_;
+  std::vector<BlockInfo> blocks_;
+  uint64_t num_elements_ = 0;
+
+  // Index of the next element to read.
+  uint64_t next_element_ = 0;
+  // Index of the block in `block_`, or -1 if no block is loaded.
+  int64_t block_index_ = -1;
+  std::string block_;
+  size_t block_position_ = 0;
+};
+
 // Writes snapshot metadata to the given directory.
 absl::Status WriteMetadataFile(
     Env* env, const string& dir,
@@ -19,6 +19,7 @@ limitations under the License.
 #include <string>
 #include <vector>
 
+#include "absl/status/status.h"
 #include "tensorflow/core/data/service/test_util.h"
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
@@ -97,6 +98,55 @@ TEST(SnapshotUtilTest, CombinationRoundTripTest) {
   SnapshotRoundTrip(io::compression::kNone, 2);
   SnapshotRoundTrip(io::compression::kGzip, 2);
   SnapshotRoundTrip(io::compression::kSnappy, 2);
+
+  SnapshotRoundTrip(io::compression::kNone, kChunkedFileFormatVersion);
+  SnapshotRoundTrip(io::compression::kSnappy, kChunkedFileFormatVersion);
+}
+
+TEST(SnapshotUtilTest, ChunkedReaderSkipRecords) {
+  std::string filename;
+  EXPECT_TRUE(Env::Default()->LocalTempFilename(&filename));
+  const DataTypeVector dtypes = {DT_INT64, DT_STRING};
+  // Writes enough data to span several blocks.
+  const int64_t kNumElements = 1000;
+  const tstring padding(16 << 10, 'a');
+  std::unique_ptr<Writer> writer;
+  TF_ASSERT_OK(Writer::Create(Env::Default(), filename,
+                              io::compression::kSnappy,
+                              kChunkedFileFormatVersion, dtypes, &writer));
+  for (int64_t i = 0; i < kNumElements; ++i) {
+    TF_ASSERT_OK(writer->WriteTensors({Tensor(i), Tensor(padding)}));
+  }
+  TF_ASSERT_OK(writer->Close());
+
+  std::unique_ptr<Reader> reader;
+  TF_ASSERT_OK(Reader::Create(Env::Default(), filename,
+                              io::compression::kSnappy,
+                              kChunkedFileFormatVersion, dtypes, &reader));
+  int64_t expected = 0;
+  for (int64_t skip : {0, 1, 300, 2, 500}) {
+    TF_ASSERT_OK(reader->SkipRecords(skip));
+    expected += skip;
+    std::vector<Tensor> read_tensors;
+    TF_ASSERT_OK(reader->ReadTensors(&read_tensors));
+    ASSERT_EQ(read_tensors.size(), 2);
+    EXPECT_EQ(read_tensors[0].scalar<int64_t>()(), expected);
+    EXPECT_EQ(read_tensors[1].scalar<tstring>()(), padding);
+    ++expected;
+  }
+  EXPECT_TRUE(absl::IsOutOfRange(reader->SkipRecords(kNumElements)));
+  std::vector<Tensor> read_tensors;
+  EXPECT_TRUE(absl::IsOutOfRange(reader->ReadTensors(&read_tensors)));
+  TF_ASSERT_OK(Env::Default()->DeleteFile(filename));
+}
+
+TEST(SnapshotUtilTest, ChunkedWriterUnsupportedCompression) {
+  std::string filename;
+  EXPECT_TRUE(Env::Default()->LocalTempFilename(&filename));
+  std::unique_ptr<Writer> writer;
+  EXPECT_TRUE(absl::IsInvalidArgument(
+      Writer::Create(Env::Default(), filename, io::compression::kGzip,
+                     kChunkedFileFormatVersion, {DT_INT64}, &writer)));
 }
 
 TEST(SnapshotUtilTest, MetadataFileRoundTrip) {
@@ -0,0 +1,142 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/tfrecord_index.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tensorflow/core/lib/core/coding.h"
+#include "tensorflow/core/lib/core/raw_coding.h"
+#include "tensorflow/core/lib/io/record_reader.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/file_system.h"
+#include "tsl/platform/statusor.h"
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+constexpr char kIndexSuffix[] = ".index";
+constexpr char kMagic[] = "TFRIDX01";
+constexpr size_t kMagicSize = sizeof(kMagic) - 1;
+constexpr size_t kHeaderSize = kMagicSize + sizeof(uint64_t);
+// Buffer size used when scanning a TFRecord file to build its index.
+constexpr int64_t kScanBufferSize = 4LL << 20;  // 4MB
+
+}  // namespace
+
+std::string TFRecordIndexFilename(absl::string_view filename) {
+  return absl::StrCat(filename, kIndexSuffix);
+}
+
+absl::Status WriteTFRecordIndex(Env* env, const std::string& index_filename,
+                                absl::Span<const uint64_t> offsets) {
+  std::string contents(kMagic, kMagicSize);
+  contents.reserve(kHeaderSize + offsets.size() * sizeof(uint64_t));
+  core::PutFixed64(&contents, offsets.size());
+  for (uint64_t offset : offsets) {
+    core::PutFixed64(&contents, offset);
+  }
+  // Write to a temporary file first so that readers never observe a partial
+  // index.
+  const std::string tmp_filename = absl::StrCat(index_filename, ".tmp");
+  TF_RETURN_IF_ERROR(WriteStringToFile(env, tmp_filename, contents));
+  return env->RenameFile(tmp_filename, index_filename);
+}
+
+absl::StatusOr<std::unique_ptr<TFRecordIndexReader>>
+TFRecordIndexReader::Create(Env* env, const std::string& index_filename) {
+  std::unique_ptr<RandomAccessFile> file;
+  TF_RETURN_IF_ERROR(env->NewRandomAccessFile(index_filename, &file));
+  char header[kHeaderSize];
+  absl::string_view result;
+  absl::Status s = file->Read(/*offset=*/0, kHeaderSize, &result, header);
+  if (!s.ok() && !errors::IsOutOfRange(s)) return s;
+  if (result.size() < kHeaderSize ||
+      result.substr(0, kMagicSize) != absl::string_view(kMagic, kMagicSize)) {
+    return absl::DataLossError(
+        absl::StrCat(index_filename, " is not a TFRecord index."));
+  }
+  const uint64_t num_records = core::DecodeFixed64(result.data() + kMagicSize);
+  uint64 file_size = 0;
+  TF_RETURN_IF_ERROR(env->GetFileSize(index_filename, &file_size));
+  if (file_size != kHeaderSize + num_records * sizeof(uint64_t)) {
+    return absl::DataLossError(absl::StrCat(
+        "TFRecord index ", index_filename, " has ", file_size,
+        " bytes, which does not match its ", num_records, " records."));
+  }
+  return absl::WrapUnique(
+      new TFRecordIndexReader(index_filename, std::move(file), num_records));
+}
+
+TFRecordIndexReader::TFRecordIndexReader(std::string index_filename,
+                                         std::unique_ptr<RandomAccessFile> file,
+                                         uint64_t num_records)
+    : index_filename_(std::move(index_filename)),
+      file_(std::move(file)),
+      num_records_(num_records) {}
+
+absl::StatusOr<uint64_t> TFRecordIndexReader::GetOffset(uint64_t index) const {
+  if (index >= num_records_) {
+    return absl::OutOfRangeError(
+        absl::StrCat("Record ", index, " is out of range for TFRecord index ",
+                     index_filename_, " with ", num_records_, " records."));
+  }
+  char scratch[sizeof(uint64_t)];
+  absl::string_view result;
+  TF_RETURN_IF_ERROR(file_->Read(kHeaderSize + index * sizeof(uint64_t),
+                                 sizeof(uint64_t), &result, scratch));
+  return core::DecodeFixed64(result.data());
+}
+
+absl::StatusOr<std::vector<uint64_t>> ComputeTFRecordOffsets(
+    Env* env, const std::string& filename) {
+  std::unique_ptr<RandomAccessFile> file;
+  TF_RETURN_IF_ERROR(env->NewRandomAccessFile(filename, &file));
+  io::RecordReaderOptions options;
+  options.buffer_size = kScanBufferSize;
+  io::RecordReader reader(file.get(), options);
+  std::vector<uint64_t> offsets;
+  uint64 offset = 0;
+  while (true) {
+    const uint64 record_offset = offset;
+    int num_skipped = 0;
+    absl::Status s =
+        reader.SkipRecords(&offset, /*num_to_skip=*/1, &num_skipped);
+    if (errors::IsOutOfRange(s)) break;
+    TF_RETURN_IF_ERROR(s);
+    offsets.push_back(record_offset);
+  }
+  return offsets;
+}
+
+absl::Status BuildTFRecordIndex(Env* env, const std::string& filename) {
+  TF_ASSIGN_OR_RETURN(std::vector<uint64_t> offsets,
+                      ComputeTFRecordOffsets(env, filename));
+  return WriteTFRecordIndex(env, TFRecordIndexFilename(filename), offsets);
+}
+
+}  // namespace data
+}  // namespace tensorflow
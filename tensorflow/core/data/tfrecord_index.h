@@ -0,0 +1,86 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_DATA_TFRECORD_INDEX_H_
+#define TENSORFLOW_CORE_DATA_TFRECORD_INDEX_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/file_system.h"
+
+namespace tensorflow {
+namespace data {
+
+// A TFRecord index is a sidecar file that stores the byte offset of every
+// record of an uncompressed TFRecord file, so that the file can be read at
+// random positions without scanning it. It has the following format:
+//
+//   char      magic[8]      "TFRIDX01"
+//   uint64    num_records
+//   uint64    offsets[num_records]
+//
+// where all integers are little-endian fixed-width values.
+
+// Returns the name of the index file for the TFRecord file `filename`.
+std::string TFRecordIndexFilename(absl::string_view filename);
+
+// Writes an index with the record `offsets` to `index_filename`.
+absl::Status WriteTFRecordIndex(Env* env, const std::string& index_filename,
+                                absl::Span<const uint64_t> offsets);
+
+// Reads record offsets from a TFRecord index without loading the whole index
+// in memory, so that looking up a record costs a single small read.
+class TFRecordIndexReader {
+ public:
+  // Opens the index `index_filename` and validates its header.
+  static absl::StatusOr<std::unique_ptr<TFRecordIndexReader>> Create(
+      Env* env, const std::string& index_filename);
+
+  // Returns the number of records of the indexed file.
+  uint64_t num_records() const { return num_records_; }
+
+  // Returns the byte offset of the record at position `index`. Thread-safe.
+  absl::StatusOr<uint64_t> GetOffset(uint64_t index) const;
+
+ private:
+  TFRecordIndexReader(std::string index_filename,
+                      std::unique_ptr<RandomAccessFile> file,
+                      uint64_t num_records);
+
+  const std::string index_filename_;
+  const std::unique_ptr<RandomAccessFile> file_;
+  const uint64_t num_records_;
+};
+
+// Scans the uncompressed TFRecord file `filename` and returns the offsets of
+// its records.
+absl::StatusOr<std::vector<uint64_t>> ComputeTFRecordOffsets(
+    Env* env, const std::string& filename);
+
+// Scans the uncompressed TFRecord file `filename` and writes its index to
+// `TFRecordIndexFilename(filename)`.
+absl::Status BuildTFRecordIndex(Env* env, const std::string& filename);
+
+}  // namespace data
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_DATA_TFRECORD_INDEX_H_
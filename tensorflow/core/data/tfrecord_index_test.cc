@@ -0,0 +1,115 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/tfrecord_index.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "tensorflow/core/lib/io/record_reader.h"
+#include "tensorflow/core/lib/io/record_writer.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/file_system.h"
+#include "tensorflow/core/platform/test.h"
+#include "tsl/platform/status_matchers.h"
+#include "tsl/platform/statusor.h"
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ::tsl::testing::StatusIs;
+
+absl::Status WriteRecords(const std::string& filename,
+                          const std::vector<std::string>& records) {
+  std::unique_ptr<WritableFile> file;
+  TF_RETURN_IF_ERROR(Env::Default()->NewWritableFile(filename, &file));
+  io::RecordWriter writer(file.get());
+  for (const std::string& record : records) {
+    TF_RETURN_IF_ERROR(writer.WriteRecord(record));
+  }
+  TF_RETURN_IF_ERROR(writer.Close());
+  return file->Close();
+}
+
+TEST(TFRecordIndexTest, BuildAndRead) {
+  const std::string filename =
+      absl::StrCat(testing::TmpDir(), "/tfrecord_index_build_and_read");
+  const std::vector<std::string> records = {"a", "bb", "", "dddd"};
+  TF_ASSERT_OK(WriteRecords(filename, records));
+  TF_ASSERT_OK(BuildTFRecordIndex(Env::Default(), filename));
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<TFRecordIndexReader> index_reader,
+      TFRecordIndexReader::Create(Env::Default(),
+                                  TFRecordIndexFilename(filename)));
+  ASSERT_EQ(index_reader->num_records(), records.size());
+  std::unique_ptr<RandomAccessFile> file;
+  TF_ASSERT_OK(Env::Default()->NewRandomAccessFile(filename, &file));
+  io::RecordReader reader(file.get());
+  for (int i = records.size() - 1; i >= 0; --i) {
+    TF_ASSERT_OK_AND_ASSIGN(uint64 offset, index_reader->GetOffset(i));
+    tstring record;
+    TF_ASSERT_OK(reader.ReadRecord(&offset, &record));
+    EXPECT_EQ(record, records[i]);
+  }
+  EXPECT_THAT(index_reader->GetOffset(records.size()),
+              StatusIs(absl::StatusCode::kOutOfRange));
+}
+
+TEST(TFRecordIndexTest, EmptyFile) {
+  const std::string filename =
+      absl::StrCat(testing::TmpDir(), "/tfrecord_index_empty_file");
+  TF_ASSERT_OK(WriteRecords(filename, {}));
+  TF_ASSERT_OK_AND_ASSIGN(std::vector<uint64_t> offsets,
+                          ComputeTFRecordOffsets(Env::Default(), filename));
+  EXPECT_TRUE(offsets.empty());
+}
+
+TEST(TFRecordIndexTest, WriteOffsets) {
+  const std::string index_filename =
+      absl::StrCat(testing::TmpDir(), "/tfrecord_index_write_offsets.index");
+  TF_ASSERT_OK(WriteTFRecordIndex(Env::Default(), index_filename,
+                                  std::vector<uint64_t>{0, 17, 42}));
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<TFRecordIndexReader> index_reader,
+      TFRecordIndexReader::Create(Env::Default(), index_filename));
+  std::vector<uint64_t> offsets;
+  for (uint64_t i = 0; i < index_reader->num_records(); ++i) {
+    TF_ASSERT_OK_AND_ASSIGN(uint64_t offset, index_reader->GetOffset(i));
+    offsets.push_back(offset);
+  }
+  EXPECT_THAT(offsets, ElementsAre(0, 17, 42));
+}
+
+TEST(TFRecordIndexTest, InvalidIndex) {
+  const std::string index_filename =
+      absl::StrCat(testing::TmpDir(), "/tfrecord_index_invalid.index");
+  TF_ASSERT_OK(
+      WriteStringToFile(Env::Default(), index_filename, "not an index"));
+  EXPECT_THAT(TFRecordIndexReader::Create(Env::Default(), index_filename),
+              StatusIs(absl::StatusCode::kDataLoss,
+                       HasSubstr("is not a TFRecord index")));
+}
+
+}  // namespace
+}  // namespace data
+}  // namespace tensorflow
@@ -14,7 +14,12 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/distributed_runtime/collective_param_resolver_distributed.h"
 
+#include <string>
+#include <utility>
+
 #include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
 #include "tensorflow/core/common_runtime/device.h"
 #include "tensorflow/core/common_runtime/device_mgr.h"
 #include "tensorflow/core/distributed_runtime/cancellable_call.h"
@@ -85,6 +90,16 @@ class CompleteInstanceCall : public CancellableCall {
   CompleteInstanceResponse resp_;
 };
 
+// Identifies the instances of a group that resolve to the same params, up to
+// the instance key and step id.
+string InstanceSignature(const CollectiveParams& cp) {
+  return absl::StrCat(cp.group.group_key, ";", cp.instance.type, ";",
+                      cp.instance.data_type, ";",
+                      cp.instance.shape.DebugString(), ";",
+                      absl::StrJoin(cp.instance.impl_details.subdiv_offsets,
+                                    ","));
+}
+
 }  // namespace
 
 CollectiveParamResolverDistributed::CollectiveParamResolverDistributed(
@@ -97,7 +112,9 @@ CollectiveParamResolverDistributed::CollectiveParamResolverDistributed(
       worker_cache_(worker_cache),
       group_leader_(task_name == config.experimental().collective_group_leader()
                         ? ""
-                        : config.experimental().collective_group_leader()) {
+                        : config.experimental().collective_group_leader()),
+      cache_instance_params_(
+          config.experimental().cache_collective_instance_params()) {
   VLOG(1) << "CompleteParamResolverDistributed ctor task={" << task_name
           << "} config.collective_group_leader={"
           << config.experimental().collective_group_leader() << "}"
@@ -363,6 +380,20 @@ absl::Status CollectiveParamResolverDistributed::UpdateInstanceCache(
   return ir->status;
 }
 
+bool CollectiveParamResolverDistributed::InstanceSignatureIsResolved(
+    const CollectiveParams& cp) {
+  const string signature = InstanceSignature(cp);
+  mutex_lock l(signature_mu_);
+  return resolved_instance_signatures_.contains(signature);
+}
+
+void CollectiveParamResolverDistributed::AddResolvedInstanceSignature(
+    const CollectiveParams& cp) {
+  string signature = InstanceSignature(cp);
+  mutex_lock l(signature_mu_);
+  resolved_instance_signatures_.insert(std::move(signature));
+}
+
 void CollectiveParamResolverDistributed::CompleteInstanceDistributed(
     const string& device, CollectiveParams* cp, CancellationManager* cancel_mgr,
     const StatusCallback& done) {
@@ -371,6 +402,12 @@ void CollectiveParamResolverDistributed::CompleteInstanceDistributed(
     return CompleteInstanceLocal(device, cp, done);
   } else if (InstanceIsCached(cp->group.group_key, cp->instance)) {
     return CompleteInstanceLocal(device, cp, done);
+  } else if (cache_instance_params_ &&
+             cp->instance.type != BROADCAST_COLLECTIVE &&
+             InstanceSignatureIsResolved(*cp)) {
+    // The leader only checks that the members agree on the params of
+    // non-broadcast instances, so this one can be resolved locally.
+    return CompleteInstanceLocal(device, cp, done);
   } else {
     CompleteInstanceCall* call = new CompleteInstanceCall(
         cp->group, cp->instance, cp->name, device, cp->is_source, cancel_mgr,
@@ -389,6 +426,9 @@ void CollectiveParamResolverDistributed::CompleteInstanceDistributed(
       if (s.ok()) {
         s = UpdateInstanceCache(cp, call->resp_);
       }
+      if (s.ok() && cache_instance_params_) {
+        AddResolvedInstanceSignature(*cp);
+      }
       if (s.ok()) {
         CompleteInstanceLocal(device, cp, done);
       } else {
@@ -15,9 +15,11 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_COLLECTIVE_PARAM_RESOLVER_DISTRIBUTED_H_
 #define TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_COLLECTIVE_PARAM_RESOLVER_DISTRIBUTED_H_
 
+#include "absl/container/flat_hash_set.h"
 #include "tensorflow/core/common_runtime/collective_param_resolver_local.h"
 #include "tensorflow/core/framework/cancellation.h"
 #include "tensorflow/core/framework/device_attributes.pb.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/status.h"
 
 namespace tensorflow {
@@ -87,9 +89,22 @@ class CollectiveParamResolverDistributed : public CollectiveParamResolverLocal {
                                    const StatusCallback& done)
       TF_LOCKS_EXCLUDED(instance_mu_, group_mu_);
 
+  // Returns true iff an instance with the same group, type, data type, shape
+  // and subdivision offsets as cp->instance was resolved through the leader.
+  bool InstanceSignatureIsResolved(const CollectiveParams& cp)
+      TF_LOCKS_EXCLUDED(signature_mu_);
+  void AddResolvedInstanceSignature(const CollectiveParams& cp)
+      TF_LOCKS_EXCLUDED(signature_mu_);
+
   WorkerCacheInterface* worker_cache_;  // Not owned
   const string group_leader_;
   CancellationManager abortion_cancel_mgr_;
+
+  // True if ConfigProto.Experimental.cache_collective_instance_params is set.
+  const bool cache_instance_params_;
+  mutex signature_mu_;
+  absl::flat_hash_set<string> resolved_instance_signatures_
+      TF_GUARDED_BY(signature_mu_);
 };
 
 }  // namespace tensorflow
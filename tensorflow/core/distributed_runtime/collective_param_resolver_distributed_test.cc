@@ -89,6 +89,22 @@ class FakeCache : public TestWorkerCache {
     }
     done(errors::Internal("device not found: ", device));
   }
+
+  // Counts the calls, so that tests can check which RPCs a resolver made.
+  WorkerInterface* GetOrCreateWorker(const string& target) override {
+    mutex_lock l(mu_);
+    ++num_get_worker_calls_[target];
+    return TestWorkerCache::GetOrCreateWorker(target);
+  }
+
+  int num_get_worker_calls(const string& target) {
+    mutex_lock l(mu_);
+    return num_get_worker_calls_[target];
+  }
+
+ private:
+  mutex mu_;
+  absl::flat_hash_map<string, int> num_get_worker_calls_ TF_GUARDED_BY(mu_);
 };
 
 class FakeNcclCommunicator : public NcclCommunicatorInterface {
@@ -127,6 +143,8 @@ class DeviceResDistTest : public ::testing::Test {
     config.mutable_experimental()->set_collective_group_leader(
         "/job:worker/replica:0/task:0");
     config.mutable_experimental()->set_collective_nccl(nccl);
+    config.mutable_experimental()->set_cache_collective_instance_params(
+        cache_instance_params_);
 
     std::vector<std::unique_ptr<Device>> devices;
     for (int i = 0; i < num_devices; ++i) {
@@ -270,6 +288,40 @@ class DeviceResDistTest : public ::testing::Test {
     }
   }
 
+  // Resolves a new instance with the same params as the first one on the
+  // devices of the non-leader task 1 only, and returns the number of workers
+  // that task 1 looked up to do it.
+  int ResolveNewInstanceOnTask1(int num_workers, int num_devices) {
+    const string task_name = "/job:worker/replica:0/task:1";
+    const string leader = "/job:worker/replica:0/task:0";
+    const int calls_before = wc_.num_get_worker_calls(leader);
+    {
+      mutex_lock l(mu_);
+      num_done_ = 0;
+    }
+    for (int di = 0; di < num_devices; ++di) {
+      string device_name = strings::StrCat(task_name, "/device:CPU:", di);
+      cp_[device_name]->Unref();
+      cp_[device_name] = CreateCollectiveParams(
+          num_workers, num_devices, "CPU", REDUCTION_COLLECTIVE,
+          /*is_source=*/false);
+      cp_[device_name]->instance.instance_key = 4;
+      IssueRequest(task_name, device_name, num_devices);
+    }
+    {
+      mutex_lock l(mu_);
+      while (num_done_ < num_devices) {
+        done_.wait(l);
+      }
+    }
+    for (int di = 0; di < num_devices; ++di) {
+      string device_name = strings::StrCat(task_name, "/device:CPU:", di);
+      TF_EXPECT_OK(status_[device_name]);
+      EXPECT_EQ(cp_[device_name]->default_rank, num_devices + di);
+    }
+    return wc_.num_get_worker_calls(leader) - calls_before;
+  }
+
   void ValidateDeviceResolver(const CollectiveParams& cp, const string& task) {
     for (const CollGroupMember& member : cp.group.members) {
       DeviceAttributes attributes;
@@ -316,6 +368,7 @@ class DeviceResDistTest : public ::testing::Test {
   mutex mu_;
   int num_done_ TF_GUARDED_BY(mu_);
   condition_variable done_;
+  bool cache_instance_params_ = false;
 };
 
 TEST_F(DeviceResDistTest, Workers1Devices1) {
@@ -371,6 +424,27 @@ TEST_F(DeviceResDistTest, BroadcastSourceRank3) {
   ValidateCollectiveParams(num_workers, num_devices);
 }
 
+TEST_F(DeviceResDistTest, NewInstanceIsResolvedByLeader) {
+  const int num_workers = 2;
+  const int num_devices = 2;
+  DefineWorkers(num_workers, num_devices, "CPU", /*nccl*/ false);
+  DefineCollectiveParams(num_workers, num_devices, "CPU");
+  IssueRequests(num_workers, num_devices);
+  ValidateCollectiveParams(num_workers, num_devices);
+  EXPECT_GT(ResolveNewInstanceOnTask1(num_workers, num_devices), 0);
+}
+
+TEST_F(DeviceResDistTest, CacheCollectiveInstanceParams) {
+  const int num_workers = 2;
+  const int num_devices = 2;
+  cache_instance_params_ = true;
+  DefineWorkers(num_workers, num_devices, "CPU", /*nccl*/ false);
+  DefineCollectiveParams(num_workers, num_devices, "CPU");
+  IssueRequests(num_workers, num_devices);
+  ValidateCollectiveParams(num_workers, num_devices);
+  EXPECT_EQ(ResolveNewInstanceOnTask1(num_workers, num_devices), 0);
+}
+
 TEST_F(DeviceResDistTest, Workers4Devices3) {
   const int num_workers = 4;
   const int num_devices = 3;
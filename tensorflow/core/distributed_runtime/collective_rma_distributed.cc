@@ -18,6 +18,7 @@ limitations under the License.
 
 #include "absl/status/status.h"
 #include "tensorflow/core/common_runtime/base_collective_executor.h"
+#include "tensorflow/core/common_runtime/collective_peer_stats.h"
 #include "tensorflow/core/common_runtime/copy_tensor.h"
 #include "tensorflow/core/common_runtime/device_mgr.h"
 #include "tensorflow/core/common_runtime/dma_helper.h"
@@ -28,8 +29,10 @@ limitations under the License.
 #include "tensorflow/core/distributed_runtime/worker_cache.h"
 #include "tensorflow/core/framework/cancellation.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/protobuf_internal.h"
 #include "tensorflow/core/profiler/lib/scoped_memory_debug_annotation.h"
+#include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/protobuf/transport_options.pb.h"
 #include "tensorflow/core/protobuf/worker.pb.h"
 
@@ -120,6 +123,26 @@ void CollectiveRemoteAccessDistributed::RecvFromPeer(
     return;
   }
 
+  // Records the time until the buffer arrived, which includes the time the
+  // peer took to produce it.
+  const int64_t num_bytes = to_tensor->TotalBytes();
+  const int64_t start_micros = Env::Default()->NowMicros();
+  const int64_t trace_id =
+      tsl::profiler::TraceMe::ActivityStart([&peer_task, &key, num_bytes]() {
+        return tsl::profiler::TraceMeEncode(
+            "CollectiveRemoteAccessDistributed::RecvFromPeer",
+            {{"peer_task", peer_task}, {"key", key}, {"bytes", num_bytes}});
+      });
+  StatusCallback done_with_stats = [peer_task, num_bytes, start_micros,
+                                    trace_id, done](const absl::Status& s) {
+    tsl::profiler::TraceMe::ActivityEnd(trace_id);
+    if (s.ok()) {
+      CollectivePeerStats::Global()->RecordRecv(
+          peer_task, num_bytes, Env::Default()->NowMicros() - start_micros);
+    }
+    done(s);
+  };
+
   // State that needs to be threaded through a couple of async calls
   // in order to make this function completely non-blocking.
   struct State {
@@ -133,7 +156,7 @@ void CollectiveRemoteAccessDistributed::RecvFromPeer(
       peer_device, &state->server_attributes);
   if (!s.ok()) {
     delete state;
-    done(s);
+    done_with_stats(s);
     return;
   }
 
@@ -147,7 +170,7 @@ void CollectiveRemoteAccessDistributed::RecvFromPeer(
     absl::Status status = dev_mgr_->LookupDevice("CPU:0", &cpu_dev);
     if (!status.ok()) {
       delete state;
-      done(s);
+      done_with_stats(s);
       return;
     }
     AllocatorAttributes cpu_attr;
@@ -169,7 +192,8 @@ void CollectiveRemoteAccessDistributed::RecvFromPeer(
   // Logic to be executed on the RecvBufAsync callback.
   auto recv_buf_callback =
       [this, state, to_device, to_alloc_attr, to_device_ctx, to_tensor, cpu_dev,
-       dev_to_dev_stream_index, dst_tensor, done](const absl::Status& s) {
+       dev_to_dev_stream_index, dst_tensor,
+       done = std::move(done_with_stats)](const absl::Status& s) {
         if (s.ok()) {
           // In this generic implementation the bytes come back in one of 2
           // ways:
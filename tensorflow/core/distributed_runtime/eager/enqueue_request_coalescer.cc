@@ -0,0 +1,125 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/distributed_runtime/eager/enqueue_request_coalescer.h"
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "tensorflow/core/platform/errors.h"
+
+namespace tensorflow {
+namespace eager {
+
+EnqueueRequestCoalescer::EnqueueRequestCoalescer(const Options& options,
+                                                 Env* env, SendFn send)
+    : options_(options), env_(env), send_(std::move(send)) {}
+
+EnqueueRequestCoalescer::~EnqueueRequestCoalescer() {
+  mutex_lock l(mu_);
+  FlushLocked();
+}
+
+void EnqueueRequestCoalescer::Enqueue(const EnqueueRequest& request,
+                                      EnqueueResponse* response,
+                                      StatusCallback done) {
+  mutex_lock l(mu_);
+  if (batch_ != nullptr &&
+      batch_->request.context_id() != request.context_id()) {
+    FlushLocked();
+  }
+  const bool start_window = batch_ == nullptr;
+  if (start_window) {
+    batch_ = std::make_unique<Batch>();
+    batch_->request.set_context_id(request.context_id());
+  }
+  for (const QueueItem& item : request.queue()) {
+    batch_->bytes += item.ByteSizeLong();
+    *batch_->request.add_queue() = item;
+  }
+  batch_->calls.push_back({response, request.queue_size(), std::move(done)});
+
+  if (batch_->request.queue_size() >= options_.max_items ||
+      batch_->bytes >= options_.max_bytes || options_.window_micros <= 0) {
+    FlushLocked();
+    return;
+  }
+  if (start_window) {
+    Ref();
+    env_->SchedClosureAfter(options_.window_micros,
+                            [this, batch_id = batch_id_]() {
+                              {
+                                mutex_lock l(mu_);
+                                if (batch_id == batch_id_) FlushLocked();
+                              }
+                              Unref();
+                            });
+  }
+}
+
+void EnqueueRequestCoalescer::Flush() {
+  mutex_lock l(mu_);
+  FlushLocked();
+}
+
+void EnqueueRequestCoalescer::FlushLocked() {
+  if (batch_ == nullptr) return;
+  ++batch_id_;
+  std::shared_ptr<Batch> batch = std::move(batch_);
+  auto response = std::make_shared<EnqueueResponse>();
+  auto sent = std::make_shared<std::atomic<bool>>(false);
+  // Sent under `mu_` so that batches reach `send_` in order. A batch that
+  // completes before `send_` returns is completed on another thread, since the
+  // callbacks of its calls may enqueue again.
+  send_(batch->request, response.get(),
+        [env = env_, batch, response, sent](const absl::Status& status) {
+          if (sent->load()) {
+            Complete(*batch, *response, status);
+          } else {
+            env->SchedClosure([batch, response, status]() {
+              Complete(*batch, *response, status);
+            });
+          }
+        });
+  sent->store(true);
+}
+
+void EnqueueRequestCoalescer::Complete(const Batch& batch,
+                                       EnqueueResponse& response,
+                                       absl::Status status) {
+  if (status.ok() &&
+      response.queue_response_size() != batch.request.queue_size()) {
+    status = errors::Internal(
+        "Expected ", batch.request.queue_size(),
+        " queue responses for a coalesced EnqueueRequest but got ",
+        response.queue_response_size());
+  }
+  int offset = 0;
+  for (const PendingCall& call : batch.calls) {
+    if (status.ok()) {
+      for (int i = 0; i < call.num_items; ++i) {
+        call.response->add_queue_response()->Swap(
+            response.mutable_queue_response(offset + i));
+      }
+    }
+    offset += call.num_items;
+    call.done(status);
+  }
+}
+
+}  // namespace eager
+}  // namespace tensorflow
@@ -0,0 +1,100 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_EAGER_ENQUEUE_REQUEST_COALESCER_H_
+#define TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_EAGER_ENQUEUE_REQUEST_COALESCER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "tensorflow/core/lib/core/refcount.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/protobuf/eager_service.pb.h"
+
+namespace tensorflow {
+namespace eager {
+
+// Merges consecutive EnqueueRequests of one remote context into a single
+// request, so that a burst of small remote ops costs one round trip instead of
+// one per op. The queue items of the merged request keep their order, and the
+// per-item responses are split back into the response of each caller.
+//
+// A batch is sent once it holds `max_items` queue items or `max_bytes` of
+// serialized items, or `window_micros` after its first request was added,
+// whichever comes first. Because the service stops processing a request at the
+// first failing item, an error fails every request of the batch.
+class EnqueueRequestCoalescer : public core::RefCounted {
+ public:
+  struct Options {
+    int64_t window_micros = 0;
+    int max_items = 64;
+    size_t max_bytes = 1 << 20;
+  };
+
+  // Sends `request` and fills `response` with one QueueResponse per queue
+  // item. Must not block, and must send requests in the order it is called.
+  using SendFn = std::function<void(const EnqueueRequest& request,
+                                    EnqueueResponse* response,
+                                    StatusCallback done)>;
+
+  EnqueueRequestCoalescer(const Options& options, Env* env, SendFn send);
+  ~EnqueueRequestCoalescer() override;
+
+  // Adds the items of `request` to the current batch. `response` must stay
+  // valid until `done` is called; `request` can be deleted when this returns.
+  void Enqueue(const EnqueueRequest& request, EnqueueResponse* response,
+               StatusCallback done);
+
+  // Sends the current batch, if any, without waiting for the window.
+  void Flush();
+
+ private:
+  struct PendingCall {
+    EnqueueResponse* response;
+    int num_items;
+    StatusCallback done;
+  };
+
+  struct Batch {
+    EnqueueRequest request;
+    std::vector<PendingCall> calls;
+    size_t bytes = 0;
+  };
+
+  void FlushLocked() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  static void Complete(const Batch& batch, EnqueueResponse& response,
+                       absl::Status status);
+
+  const Options options_;
+  Env* const env_;
+  const SendFn send_;
+
+  mutex mu_;
+  std::unique_ptr<Batch> batch_ TF_GUARDED_BY(mu_);
+  // Incremented on every flush, so that a window timer only flushes the batch
+  // it was started for.
+  uint64_t batch_id_ TF_GUARDED_BY(mu_) = 0;
+};
+
+}  // namespace eager
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_EAGER_ENQUEUE_REQUEST_COALESCER_H_
@@ -0,0 +1,162 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/distributed_runtime/eager/enqueue_request_coalescer.h"
+
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/blocking_counter.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/notification.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace eager {
+namespace {
+
+EnqueueRequest MakeRequest(const std::vector<string>& op_names) {
+  EnqueueRequest request;
+  request.set_context_id(1);
+  for (const string& name : op_names) {
+    request.add_queue()->mutable_operation()->set_name(name);
+  }
+  return request;
+}
+
+// Records the requests it is asked to send, and answers each queue item with
+// a QueueResponse whose device is the name of the op.
+class FakeSender {
+ public:
+  EnqueueRequestCoalescer::SendFn AsSendFn() {
+    return [this](const EnqueueRequest& request, EnqueueResponse* response,
+                  StatusCallback done) {
+      {
+        mutex_lock l(mu_);
+        sent_.push_back(request);
+      }
+      for (const QueueItem& item : request.queue()) {
+        response->add_queue_response()->add_device(item.operation().name());
+      }
+      done(status_);
+    };
+  }
+
+  std::vector<EnqueueRequest> sent() {
+    mutex_lock l(mu_);
+    return sent_;
+  }
+
+  void set_status(absl::Status status) { status_ = status; }
+
+ private:
+  mutex mu_;
+  std::vector<EnqueueRequest> sent_;
+  absl::Status status_;
+};
+
+TEST(EnqueueRequestCoalescerTest, MergesRequestsUntilFlush) {
+  FakeSender sender;
+  EnqueueRequestCoalescer::Options options;
+  options.window_micros = 60 * 1000 * 1000;
+  core::RefCountPtr<EnqueueRequestCoalescer> coalescer(
+      new EnqueueRequestCoalescer(options, Env::Default(), sender.AsSendFn()));
+
+  EnqueueResponse response_a;
+  EnqueueResponse response_b;
+  BlockingCounter counter(2);
+  auto done = [&counter](const absl::Status& s) {
+    TF_EXPECT_OK(s);
+    counter.DecrementCount();
+  };
+  coalescer->Enqueue(MakeRequest({"a"}), &response_a, done);
+  coalescer->Enqueue(MakeRequest({"b1", "b2"}), &response_b, done);
+  EXPECT_TRUE(sender.sent().empty());
+
+  coalescer->Flush();
+  counter.Wait();
+  ASSERT_EQ(sender.sent().size(), 1);
+  EXPECT_EQ(sender.sent()[0].queue_size(), 3);
+  ASSERT_EQ(response_a.queue_response_size(), 1);
+  EXPECT_EQ(response_a.queue_response(0).device(0), "a");
+  ASSERT_EQ(response_b.queue_response_size(), 2);
+  EXPECT_EQ(response_b.queue_response(0).device(0), "b1");
+  EXPECT_EQ(response_b.queue_response(1).device(0), "b2");
+}
+
+TEST(EnqueueRequestCoalescerTest, FlushesAtMaxItems) {
+  FakeSender sender;
+  EnqueueRequestCoalescer::Options options;
+  options.window_micros = 60 * 1000 * 1000;
+  options.max_items = 2;
+  core::RefCountPtr<EnqueueRequestCoalescer> coalescer(
+      new EnqueueRequestCoalescer(options, Env::Default(), sender.AsSendFn()));
+
+  BlockingCounter counter(2);
+  auto done = [&counter](const absl::Status& s) { counter.DecrementCount(); };
+  EnqueueResponse response_a;
+  EnqueueResponse response_b;
+  coalescer->Enqueue(MakeRequest({"a"}), &response_a, done);
+  coalescer->Enqueue(MakeRequest({"b"}), &response_b, done);
+  counter.Wait();
+  EXPECT_EQ(sender.sent().size(), 1);
+}
+
+TEST(EnqueueRequestCoalescerTest, FlushesAfterWindow) {
+  FakeSender sender;
+  EnqueueRequestCoalescer::Options options;
+  options.window_micros = 1000;
+  core::RefCountPtr<EnqueueRequestCoalescer> coalescer(
+      new EnqueueRequestCoalescer(options, Env::Default(), sender.AsSendFn()));
+
+  Notification n;
+  EnqueueResponse response;
+  coalescer->Enqueue(MakeRequest({"a"}), &response,
+                     [&n](const absl::Status& s) { n.Notify(); });
+  n.WaitForNotification();
+  EXPECT_EQ(sender.sent().size(), 1);
+  EXPECT_EQ(response.queue_response_size(), 1);
+}
+
+TEST(EnqueueRequestCoalescerTest, ErrorFailsAllCallsOfBatch) {
+  FakeSender sender;
+  sender.set_status(errors::Internal("remote failure"));
+  EnqueueRequestCoalescer::Options options;
+  options.window_micros = 60 * 1000 * 1000;
+  core::RefCountPtr<EnqueueRequestCoalescer> coalescer(
+      new EnqueueRequestCoalescer(options, Env::Default(), sender.AsSendFn()));
+
+  BlockingCounter counter(2);
+  auto done = [&counter](const absl::Status& s) {
+    EXPECT_EQ(s.code(), error::INTERNAL);
+    counter.DecrementCount();
+  };
+  EnqueueResponse response_a;
+  EnqueueResponse response_b;
+  coalescer->Enqueue(MakeRequest({"a"}), &response_a, done);
+  coalescer->Enqueue(MakeRequest({"b"}), &response_b, done);
+  coalescer->Flush();
+  counter.Wait();
+  EXPECT_EQ(response_a.queue_response_size(), 0);
+  EXPECT_EQ(response_b.queue_response_size(), 0);
+}
+
+}  // namespace
+}  // namespace eager
+}  // namespace tensorflow
@@ -1252,7 +1252,9 @@ MasterSession::MasterSession(
       stats_publisher_factory_(std::move(stats_publisher_factory)),
       graph_version_(0),
       run_graphs_(5),
-      partial_run_graphs_(5) {
+      partial_run_graphs_(5),
+      max_concurrent_steps_(
+          opt.config.experimental().max_concurrent_steps()) {
   UpdateLastAccessTime();
   CHECK(devices_) << "device_set was null!";
 
@@ -1697,6 +1699,28 @@ void MasterSession::MarkRunCompletion() {
   }
 }
 
+absl::Status MasterSession::AcquireStepSlot() {
+  if (max_concurrent_steps_ <= 0) return absl::OkStatus();
+  mutex_lock l(mu_);
+  while (!closed_ && num_executing_steps_ >= max_concurrent_steps_) {
+    step_slot_available_.wait(l);
+  }
+  if (closed_) {
+    return errors::Cancelled(
+        "Step was cancelled because the session was closed while it was "
+        "waiting for one of the max_concurrent_steps to finish.");
+  }
+  ++num_executing_steps_;
+  return absl::OkStatus();
+}
+
+void MasterSession::ReleaseStepSlot() {
+  if (max_concurrent_steps_ <= 0) return;
+  mutex_lock l(mu_);
+  --num_executing_steps_;
+  step_slot_available_.notify_one();
+}
+
 absl::Status MasterSession::BuildAndRegisterPartitions(ReffedClientGraph* rcg) {
   // Registers subgraphs if haven't done so.
   PartitionOptions popts;
@@ -2015,8 +2039,10 @@ absl::Status MasterSession::DoRunWithLocalExecution(
         "disable_output_partition_graphs is true.");
   }
 
+  TF_RETURN_IF_ERROR(AcquireStepSlot());
   absl::Status s = rcg->RunPartitions(env_, step_id, count, &pss, opts, req,
                                       resp, &cancellation_manager_, false);
+  ReleaseStepSlot();
 
   cleanup.release();  // MarkRunCompletion called in PostRunCleanup().
   return PostRunCleanup(rcg, step_id, req.options(), &pss, ph, s,
@@ -2086,8 +2112,10 @@ absl::Status MasterSession::DoRunCallable(CallOptions* opts,
 
   std::unique_ptr<ProfileHandler> ph;
   FillPerStepState(rcg, run_options, step_id, count, &pss, &ph);
+  TF_RETURN_IF_ERROR(AcquireStepSlot());
   absl::Status s = rcg->RunPartitions(env_, step_id, count, &pss, opts, req,
                                       resp, &cancellation_manager_);
+  ReleaseStepSlot();
   cleanup.release();  // MarkRunCompletion called in PostRunCleanup().
   return PostRunCleanup(rcg, step_id, run_options, &pss, ph, s,
                         resp->mutable_metadata());
@@ -2142,6 +2170,7 @@ absl::Status MasterSession::Close() {
   {
     mutex_lock l(mu_);
     closed_ = true;  // All subsequent calls to Run() or Extend() will fail.
+    step_slot_available_.notify_all();
   }
   cancellation_manager_.StartCancel();
   std::vector<ReffedClientGraph*> to_unref;
@@ -197,6 +197,12 @@ class MasterSession : public core::RefCounted {
   condition_variable num_running_is_zero_;
   int32 num_running_ TF_GUARDED_BY(mu_) = 0;
 
+  // Steps that are running their partitions. Only counted if
+  // max_concurrent_steps_ is positive.
+  const int32 max_concurrent_steps_;
+  condition_variable step_slot_available_;
+  int32 num_executing_steps_ TF_GUARDED_BY(mu_) = 0;
+
   bool closed_ TF_GUARDED_BY(mu_) = false;
   bool garbage_collected_ TF_GUARDED_BY(mu_) = false;
 
@@ -246,6 +252,12 @@ class MasterSession : public core::RefCounted {
                               const absl::Status& run_status,
                               RunMetadata* out_run_metadata);
 
+  // Waits until fewer than max_concurrent_steps_ steps are running their
+  // partitions, then counts the calling step until ReleaseStepSlot() is
+  // called. Fails if the session is closed while waiting.
+  absl::Status AcquireStepSlot();
+  void ReleaseStepSlot();
+
   void MarkRunCompletion();
   void UpdateLastAccessTime();
 
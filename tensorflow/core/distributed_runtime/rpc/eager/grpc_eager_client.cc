@@ -21,6 +21,7 @@ limitations under the License.
 #include "grpcpp/generic/generic_stub.h"
 #include "xla/tsl/distributed_runtime/call_options.h"
 #include "tensorflow/core/distributed_runtime/call_options.h"
+#include "tensorflow/core/distributed_runtime/eager/enqueue_request_coalescer.h"
 #include "tensorflow/core/distributed_runtime/rpc/eager/grpc_eager_service.h"
 #include "tensorflow/core/distributed_runtime/rpc/grpc_client_cq_tag.h"
 #include "tensorflow/core/distributed_runtime/rpc/grpc_state.h"
@@ -74,6 +75,35 @@ bool EnableStreaming() {
   return result;
 }
 
+// Setting "TF_EAGER_CLIENT_ENQUEUE_COALESCE_USECS" to a positive value makes
+// streaming enqueue hold requests for up to that many microseconds and send
+// the ones of the same context in a single request, saving round trips when a
+// client issues many small remote ops. "TF_EAGER_CLIENT_ENQUEUE_COALESCE_ITEMS"
+// bounds the number of queue items in a coalesced request.
+EnqueueRequestCoalescer::Options CoalesceOptions() {
+  static const EnqueueRequestCoalescer::Options* options = []() {
+    auto* options = new EnqueueRequestCoalescer::Options();
+    const EnqueueRequestCoalescer::Options defaults;
+    absl::Status status =
+        ReadInt64FromEnvVar("TF_EAGER_CLIENT_ENQUEUE_COALESCE_USECS",
+                            defaults.window_micros, &options->window_micros);
+    if (!status.ok()) {
+      LOG(WARNING) << status;
+      options->window_micros = defaults.window_micros;
+    }
+    int64_t max_items;
+    status = ReadInt64FromEnvVar("TF_EAGER_CLIENT_ENQUEUE_COALESCE_ITEMS",
+                                 defaults.max_items, &max_items);
+    if (!status.ok()) {
+      LOG(WARNING) << status;
+      max_items = defaults.max_items;
+    }
+    options->max_items = static_cast<int>(max_items);
+    return options;
+  }();
+  return *options;
+}
+
 // Ref-counted thread to handle callbacks for completed requests a GRPC
 // completion queue. The thread might be shared by multiple eager clients, and
 // each one of them should hold a reference count to ensure that the thread
@@ -125,7 +155,11 @@ class GrpcEagerClient : public EagerClient {
     thread_->Ref();
     cq_ = thread->completion_queue();
   }
-  ~GrpcEagerClient() override { thread_->Unref(); }
+  ~GrpcEagerClient() override {
+    // Pending coalesced requests hold a reference to the client, so none are
+    // left here.
+    thread_->Unref();
+  }
 
   bool allow_multiple_pending_requests() const override {
     return EnableStreaming();
@@ -206,6 +240,19 @@ class GrpcEagerClient : public EagerClient {
     VLOG(1) << "Sending RPC to close remote eager context "
             << request->DebugString();
 
+    core::RefCountPtr<EnqueueRequestCoalescer> coalescer;
+    {
+      mutex_lock l(mu_);
+      auto it = enqueue_coalescers_.find(request->context_id());
+      if (it != enqueue_coalescers_.end()) {
+        coalescer = std::move(it->second);
+        enqueue_coalescers_.erase(it);
+      }
+    }
+    // Send what is still coalesced before the stream is cancelled, like the
+    // requests already sent on it.
+    if (coalescer) coalescer->Flush();
+
     mutex_lock l(mu_);
     const auto& it = enqueue_dispatchers_.find(request->context_id());
     if (it != enqueue_dispatchers_.end()) {
@@ -228,19 +275,27 @@ class GrpcEagerClient : public EagerClient {
     // 2. The flag set in the eager executor.
     // Streaming enqueue is allowed only when the both are enabled.
     if (EnableStreaming() && enable_streaming_enqueue) {
-      mutex_lock l(mu_);
-      auto it = enqueue_dispatchers_.find(request->context_id());
-      if (it == enqueue_dispatchers_.end()) {
-        auto it_and_bool = enqueue_dispatchers_.emplace(
-            std::piecewise_construct,
-            std::forward_as_tuple(request->context_id()),
-            std::forward_as_tuple(
-                &stub_, cq_,
-                "/tensorflow.eager.EagerService/StreamingEnqueue"));
-        it = it_and_bool.first;
+      if (CoalesceOptions().window_micros > 0) {
+        EnqueueRequestCoalescer* coalescer;
+        {
+          mutex_lock l(mu_);
+          auto& entry = enqueue_coalescers_[request->context_id()];
+          if (!entry) {
+            entry.reset(new EnqueueRequestCoalescer(
+                CoalesceOptions(), Env::Default(),
+                [this](const EnqueueRequest& request, EnqueueResponse* response,
+                       StatusCallback done) {
+                  SendNextStreamingRequest(request, response, std::move(done));
+                }));
+          }
+          coalescer = entry.get();
+          coalescer->Ref();
+        }
+        core::ScopedUnref coalescer_unref(coalescer);
+        coalescer->Enqueue(*request, response, std::move(done_wrapped));
+        return;
       }
-      // TODO(haoyuzhang): Consider supporting cancellation for streaming RPC?
-      it->second.SendNextRequest(*request, response, std::move(done_wrapped));
+      SendNextStreamingRequest(*request, response, std::move(done_wrapped));
     } else {
       Notification n;
       absl::Status status;
@@ -265,6 +320,25 @@ class GrpcEagerClient : public EagerClient {
 
   std::unordered_map<uint64, StreamingRPCDispatcher<EnqueueResponse>>
       enqueue_dispatchers_ TF_GUARDED_BY(mu_);
+  std::unordered_map<uint64, core::RefCountPtr<EnqueueRequestCoalescer>>
+      enqueue_coalescers_ TF_GUARDED_BY(mu_);
+
+  void SendNextStreamingRequest(const EnqueueRequest& request,
+                                EnqueueResponse* response,
+                                StatusCallback done) {
+    mutex_lock l(mu_);
+    auto it = enqueue_dispatchers_.find(request.context_id());
+    if (it == enqueue_dispatchers_.end()) {
+      auto it_and_bool = enqueue_dispatchers_.emplace(
+          std::piecewise_construct,
+          std::forward_as_tuple(request.context_id()),
+          std::forward_as_tuple(
+              &stub_, cq_, "/tensorflow.eager.EagerService/StreamingEnqueue"));
+      it = it_and_bool.first;
+    }
+    // TODO(haoyuzhang): Consider supporting cancellation for streaming RPC?
+    it->second.SendNextRequest(request, response, std::move(done));
+  }
 
   StatusCallback callback_wrapper(StatusCallback done) {
     Ref();
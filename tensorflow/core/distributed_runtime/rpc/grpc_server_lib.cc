@@ -47,6 +47,7 @@ limitations under the License.
 #include "tensorflow/core/distributed_runtime/rpc/rpc_rendezvous_mgr.h"
 #include "tensorflow/core/distributed_runtime/rpc_collective_executor_mgr.h"
 #include "tensorflow/core/distributed_runtime/server_lib.h"
+#include "tensorflow/core/distributed_runtime/tensor_compression.h"
 #include "tensorflow/core/distributed_runtime/worker_cache_wrapper.h"
 #include "tensorflow/core/distributed_runtime/worker_env.h"
 #include "tensorflow/core/framework/op.h"
@@ -119,6 +120,7 @@ GrpcServer::~GrpcServer() {
 
   // Shut down all outstanding rendezvous.
   delete worker_env_.rendezvous_mgr;
+  delete worker_env_.recv_tensor_transport;
 
   // We must delete graph_mgr before device_mgr, due to shared
   // ownership of OpKernels in the executors. (The graph_mgr will
@@ -229,9 +231,20 @@ absl::Status GrpcServer::Init(const GrpcServerOptions& opts) {
   master_env_.experimental_num_shards = std::max(1, num_tasks);
   worker_env_.experimental_num_shards = master_env_.experimental_num_shards;
 
-  worker_env_.rendezvous_mgr = opts.rendezvous_mgr_func == nullptr
-                                   ? new RpcRendezvousMgr(&worker_env_)
-                                   : opts.rendezvous_mgr_func(&worker_env_);
+  RpcRendezvousMgrOptions rendezvous_options;
+  rendezvous_options.batch_recv_tensor =
+      config.experimental().batch_recv_tensor();
+  TF_RETURN_IF_ERROR(RecvTensorCompressionFromString(
+      config.experimental().recv_tensor_compression(),
+      &rendezvous_options.recv_tensor_compression));
+  worker_env_.rendezvous_mgr =
+      opts.rendezvous_mgr_func == nullptr
+          ? new RpcRendezvousMgr(&worker_env_, rendezvous_options)
+          : opts.rendezvous_mgr_func(&worker_env_);
+  if (opts.recv_tensor_transport_func != nullptr) {
+    worker_env_.recv_tensor_transport =
+        opts.recv_tensor_transport_func(&worker_env_);
+  }
   string unused;
   string default_worker_name;
   if (!DeviceNameUtils::SplitDeviceName(master_env_.local_devices[0]->name(),
@@ -32,6 +32,7 @@ limitations under the License.
 #include "tensorflow/core/distributed_runtime/rpc/grpc_channel.h"
 #include "tensorflow/core/distributed_runtime/rpc/grpc_worker_cache.h"
 #include "tensorflow/core/distributed_runtime/rpc/grpc_worker_service.h"
+#include "tensorflow/core/distributed_runtime/rpc/recv_tensor_transport.h"
 #include "tensorflow/core/distributed_runtime/server_lib.h"
 #include "tensorflow/core/distributed_runtime/session_mgr.h"
 #include "tensorflow/core/distributed_runtime/worker_env.h"
@@ -49,6 +50,10 @@ class Master;
 typedef std::function<RendezvousMgrInterface*(const WorkerEnv*)>
     RendezvousMgrCreationFunction;
 
+// function that creates a RecvTensorTransport.
+typedef std::function<RecvTensorTransport*(const WorkerEnv*)>
+    RecvTensorTransportCreationFunction;
+
 // function that creates a CollectiveExecutorMgr.
 typedef std::function<CollectiveExecutorMgrInterface*(
     const ConfigProto&, const WorkerEnv*, WorkerCacheInterface*)>
@@ -67,6 +72,8 @@ typedef std::function<std::unique_ptr<GrpcWorker>(WorkerEnv*,
 struct GrpcServerOptions {
   ServiceInitFunction service_func = nullptr;
   RendezvousMgrCreationFunction rendezvous_mgr_func = nullptr;
+  // If set, large tensors are received through the returned transport.
+  RecvTensorTransportCreationFunction recv_tensor_transport_func = nullptr;
   CollectiveMgrCreationFunction collective_mgr_func = nullptr;
   WorkerCreationFunction worker_func = nullptr;
   StatsPublisherFactory stats_factory = CreateNoOpStatsPublisher;
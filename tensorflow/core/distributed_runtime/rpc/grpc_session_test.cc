@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/rpc/grpc_session.h"
 
+#include <memory>
 #include <string>
 
 #include "xla/tsl/lib/core/status_test_util.h"
@@ -1316,6 +1317,91 @@ TEST(SessionTest, RunTimeoutWithRunOptions) {
               error::INTERNAL == status.code());
 }
 
+// Tests that "max_concurrent_steps" serializes the steps of concurrent
+// Run() calls.
+TEST(SessionTest, MaxConcurrentSteps) {
+  std::unique_ptr<test::TestCluster> cluster;
+  TF_ASSERT_OK(test::TestCluster::MakeTestCluster(
+      TestClusterConfig()
+          .Options(Devices(1, 0))
+          .Jobs({TestJob{"localhost", /*num_tasks=*/1}}),
+      &cluster));
+  SessionOptions options = Options(cluster->targets()[0], 1);
+  options.config.mutable_experimental()->set_max_concurrent_steps(1);
+  std::unique_ptr<Session> session(NewRemote(options));
+
+  Graph graph(OpRegistry::Global());
+  Node* b = test::graph::Constant(&graph, Tensor());
+  Node* b_delay = test::graph::Delay(&graph, b, Microseconds(1000000));
+  GraphDef gdef;
+  test::graph::ToGraphDef(&graph, &gdef);
+  TF_ASSERT_OK(session->Create(gdef));
+  // Registers the partitions before timing the steps.
+  TF_ASSERT_OK(session->Run({}, {}, {b_delay->name()}, nullptr));
+
+  // Each step sleeps for a second, so two steps that run one at a time
+  // take at least two seconds.
+  const uint64 start_micros = Env::Default()->NowMicros();
+  absl::Status statuses[2];
+  {
+    std::unique_ptr<Thread> threads[2];
+    for (int i = 0; i < 2; ++i) {
+      threads[i].reset(Env::Default()->StartThread(
+          ThreadOptions(), strings::StrCat("step", i), [&, i]() {
+            statuses[i] = session->Run({}, {}, {b_delay->name()}, nullptr);
+          }));
+    }
+  }
+  EXPECT_GE(Env::Default()->NowMicros() - start_micros, 2000000);
+  TF_EXPECT_OK(statuses[0]);
+  TF_EXPECT_OK(statuses[1]);
+  TF_ASSERT_OK(session->Close());
+}
+
+// Tests that Close() cancels the steps waiting for "max_concurrent_steps".
+TEST(SessionTest, MaxConcurrentStepsCancelledByClose) {
+  std::unique_ptr<test::TestCluster> cluster;
+  TF_ASSERT_OK(test::TestCluster::MakeTestCluster(
+      TestClusterConfig()
+          .Options(Devices(1, 0))
+          .Jobs({TestJob{"localhost", /*num_tasks=*/1}}),
+      &cluster));
+  SessionOptions options = Options(cluster->targets()[0], 1);
+  options.config.mutable_experimental()->set_max_concurrent_steps(1);
+  std::unique_ptr<Session> session(NewRemote(options));
+
+  Graph graph(OpRegistry::Global());
+  Node* b = test::graph::Constant(&graph, Tensor());
+  Node* b_delay = test::graph::Delay(&graph, b, Microseconds(5000000));
+  GraphDef gdef;
+  test::graph::ToGraphDef(&graph, &gdef);
+  TF_ASSERT_OK(session->Create(gdef));
+
+  // The first step holds the only slot for five seconds, and the second
+  // one waits for it until the session is closed.
+  absl::Status waiting_status;
+  {
+    std::unique_ptr<Thread> running(Env::Default()->StartThread(
+        ThreadOptions(), "running_step", [&]() {
+          session->Run({}, {}, {b_delay->name()}, nullptr).IgnoreError();
+        }));
+    Env::Default()->SleepForMicroseconds(1000000);
+    std::unique_ptr<Thread> waiting(Env::Default()->StartThread(
+        ThreadOptions(), "waiting_step", [&]() {
+          waiting_status = session->Run({}, {}, {b_delay->name()}, nullptr);
+        }));
+    Env::Default()->SleepForMicroseconds(1000000);
+    TF_EXPECT_OK(session->Close());
+  }
+  EXPECT_EQ(error::CANCELLED, waiting_status.code());
+  EXPECT_NE(waiting_status.ToString().find("max_concurrent_steps"),
+            string::npos);
+
+  // Sleep a bit so that most of asynchronous works finishes before
+  // the test process finishes.
+  Env::Default()->SleepForMicroseconds(2000000);
+}
+
 TEST(SessionTest, TestCompression) {
   std::unique_ptr<test::TestCluster> cluster;
   TF_ASSERT_OK(test::TestCluster::MakeTestCluster(
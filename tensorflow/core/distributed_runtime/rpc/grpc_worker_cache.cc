@@ -24,12 +24,18 @@ limitations under the License.
 #include "tensorflow/core/distributed_runtime/worker_interface.h"
 #include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/random.h"
 #include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 
 namespace {
 
+// Bounds the number of pooled channels to a target that are warmed up, in
+// case concurrent users of the channel cache keep the warm up from cycling
+// back to the first channel of the pool.
+constexpr int kMaxWarmUpChannelsPerTarget = 64;
+
 class GrpcWorkerCache : public WorkerCachePartial {
  public:
   explicit GrpcWorkerCache(std::shared_ptr<GrpcChannelCache> channel_cache,
@@ -40,7 +46,22 @@ class GrpcWorkerCache : public WorkerCachePartial {
         local_worker_(local_worker),
         channel_cache_(channel_cache),
         worker_env_(worker_env),
-        next_round_robin_assignment_(0) {}
+        next_round_robin_assignment_(0) {
+    bool warm_up = false;
+    absl::Status status =
+        ReadBoolFromEnvVar("TF_GRPC_WORKER_CACHE_WARMUP", false, &warm_up);
+    if (!status.ok()) {
+      LOG(ERROR) << "Error parsing TF_GRPC_WORKER_CACHE_WARMUP: " << status;
+    }
+    int64_t spread_ms = 0;
+    status = ReadInt64FromEnvVar("TF_GRPC_WORKER_CACHE_WARMUP_SPREAD_MS", 1000,
+                                 &spread_ms);
+    if (!status.ok()) {
+      LOG(ERROR) << "Error parsing TF_GRPC_WORKER_CACHE_WARMUP_SPREAD_MS: "
+                 << status;
+    }
+    if (warm_up) WarmUpGrpcChannels(channel_cache_, local_target_, spread_ms);
+  }
 
   void ListWorkers(std::vector<string>* workers) const override {
     channel_cache_->ListWorkers(workers);
@@ -125,8 +146,41 @@ class GrpcWorkerCache : public WorkerCachePartial {
   size_t next_round_robin_assignment_ TF_GUARDED_BY(assignment_mu_);
 };
 
+void WarmUpChannelsToTarget(const std::shared_ptr<GrpcChannelCache>& cc,
+                            const string& target) {
+  SharedGrpcChannelPtr first = cc->FindWorkerChannel(target);
+  if (!first) return;
+  // The channel cache hands out the channels of the pool of `target` in
+  // round-robin order, so this visits each of them once.
+  SharedGrpcChannelPtr channel = first;
+  for (int i = 0; i < kMaxWarmUpChannelsPerTarget; ++i) {
+    // Does not block: only starts connecting if the channel is idle.
+    channel->GetState(/*try_to_connect=*/true);
+    channel = cc->FindWorkerChannel(target);
+    if (!channel || channel == first) break;
+  }
+}
+
 }  // namespace
 
+void WarmUpGrpcChannels(std::shared_ptr<GrpcChannelCache> cc,
+                        const string& local_target, int64_t spread_ms) {
+  std::vector<string> workers;
+  cc->ListWorkers(&workers);
+  VLOG(1) << "Warming up the channels to " << workers.size()
+          << " workers over " << spread_ms << "ms";
+  for (const string& target : workers) {
+    if (target == local_target) continue;
+    if (spread_ms > 0) {
+      const int64_t delay_us = random::New64() % (spread_ms * 1000);
+      Env::Default()->SchedClosureAfter(
+          delay_us, [cc, target]() { WarmUpChannelsToTarget(cc, target); });
+    } else {
+      WarmUpChannelsToTarget(cc, target);
+    }
+  }
+}
+
 GrpcWorkerEnv::GrpcWorkerEnv(size_t num_completion_queues, size_t num_threads)
     : threadpool_(new thread::ThreadPool(
           Env::Default(), ThreadOptions(), "GrpcWorkerEnvQueues", num_threads,
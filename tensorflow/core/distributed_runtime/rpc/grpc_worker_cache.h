@@ -16,6 +16,9 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_RPC_GRPC_WORKER_CACHE_H_
 #define TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_RPC_GRPC_WORKER_CACHE_H_
 
+#include <cstdint>
+#include <memory>
+
 #include "tensorflow/core/distributed_runtime/rpc/grpc_channel.h"
 #include "tensorflow/core/distributed_runtime/rpc/grpc_client_cq_tag.h"
 #include "tensorflow/core/distributed_runtime/worker_cache.h"
@@ -72,5 +75,18 @@ WorkerCacheInterface* NewGrpcWorkerCacheWithLocalWorker(
     std::shared_ptr<GrpcChannelCache> cc, GrpcWorkerEnv* worker_env,
     WorkerInterface* local_worker, const string& local_target);
 
+// Starts connecting all the channels of "cc", except the ones to
+// "local_target", so that the first RPCs of a job don't wait for connection
+// setup. The channels of each target start connecting after a random delay of
+// up to "spread_ms", so that the workers of a large job don't all connect to
+// their peers at the same moment; with "spread_ms" <= 0 they start
+// immediately. Never blocks on the connections.
+//
+// The worker caches created above call this when the environment variable
+// TF_GRPC_WORKER_CACHE_WARMUP is true, with "spread_ms" set by
+// TF_GRPC_WORKER_CACHE_WARMUP_SPREAD_MS (1000 by default).
+void WarmUpGrpcChannels(std::shared_ptr<GrpcChannelCache> cc,
+                        const string& local_target, int64_t spread_ms);
+
 }  // namespace tensorflow
 #endif  // TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_RPC_GRPC_WORKER_CACHE_H_
@@ -15,10 +15,14 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/rpc/grpc_worker_cache.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "tensorflow/c/tf_status.h"
 #include "tensorflow/core/distributed_runtime/rpc/grpc_channel.h"
 #include "tensorflow/core/distributed_runtime/test_utils.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/strcat.h"
 #include "tensorflow/core/platform/test.h"
@@ -86,4 +90,33 @@ TEST(GrpcWorkerCacheTest, DestructWorkerCacheInThreadPool) {
   n.WaitForNotification();
 }
 
+TEST(GrpcWorkerCacheTest, WarmUpGrpcChannels) {
+  GrpcChannelSpec spec;
+  TF_ASSERT_OK(
+      spec.AddHostPortsJob("worker", {{0, "a:0"}, {1, "b:1"}, {2, "c:2"}}));
+  mutex mu;
+  std::vector<string> created;
+  ChannelCreationFunction channel_func =
+      [&mu, &created](const string& target) -> SharedGrpcChannelPtr {
+    SharedGrpcChannelPtr channel;
+    TF_CHECK_OK(NewHostPortGrpcChannel(target, /*rpc_options=*/nullptr,
+                                       &channel));
+    mutex_lock l(mu);
+    created.push_back(target);
+    return channel;
+  };
+  RPCOptions rpc_options;
+  rpc_options.set_num_channels_per_target(2);
+  auto channel_cache = std::shared_ptr<GrpcChannelCache>(
+      NewGrpcChannelCache(spec, channel_func, rpc_options));
+
+  WarmUpGrpcChannels(channel_cache, "/job:worker/replica:0/task:0",
+                     /*spread_ms=*/0);
+
+  // Both channels of the pools of the remote tasks were created.
+  mutex_lock l(mu);
+  std::sort(created.begin(), created.end());
+  EXPECT_EQ(created, std::vector<string>({"b:1", "b:1", "c:2", "c:2"}));
+}
+
 }  // namespace tensorflow
@@ -39,7 +39,9 @@ limitations under the License.
 #include "tensorflow/core/distributed_runtime/rpc/grpc_tensor_coding.h"
 #include "tensorflow/core/distributed_runtime/rpc/grpc_util.h"
 #include "tensorflow/core/distributed_runtime/rpc/grpc_worker_service_impl.h"
+#include "tensorflow/core/distributed_runtime/rpc/recv_tensor_transport.h"
 #include "tensorflow/core/distributed_runtime/rpc/rpc_response_cache.h"
+#include "tensorflow/core/distributed_runtime/tensor_compression.h"
 #include "tensorflow/core/distributed_runtime/worker.h"
 #include "tensorflow/core/distributed_runtime/worker_cache.h"
 #include "tensorflow/core/distributed_runtime/worker_session.h"
@@ -148,6 +150,7 @@ class GrpcWorkerServiceThread {
     SETUP_FOR_REQUEST(RunGraph, 100, true);
     SETUP_FOR_REQUEST(CleanupGraph, 100, false);
     SETUP_FOR_REQUEST(MarkRecvFinished, 10, false);
+    SETUP_FOR_REQUEST(BatchRecvTensor, 100, true);
 
     // TODO(ncteisen): Determine a better policy for enqueuing the
     // appropriate number of each request type.
@@ -301,6 +304,25 @@ class GrpcWorkerServiceThread {
     ENQUEUE_REQUEST(RecvBuf, true);
   }
 
+  void BatchRecvTensorHandler(
+      WorkerCall<BatchRecvTensorRequest, BatchRecvTensorResponse>* call) {
+    Schedule([this, call]() {
+      CallOptions* call_opts = new CallOptions;
+      call->SetCancelCallback([call_opts]() { call_opts->StartCancel(); });
+      worker_->BatchRecvTensorAsync(
+          call_opts, &call->request, &call->response,
+          [call, call_opts](const absl::Status& s) {
+            call->ClearCancelCallback();
+            delete call_opts;
+            if (!s.ok()) {
+              VLOG(3) << "Bad response from BatchRecvTensor:" << s;
+            }
+            call->SendResponse(ToGrpcStatus(s));
+          });
+    });
+    ENQUEUE_REQUEST(BatchRecvTensor, true);
+  }
+
   void CompleteGroupHandler(
       WorkerCall<CompleteGroupRequest, CompleteGroupResponse>* call) {
     Schedule([this, call]() {
@@ -424,6 +446,75 @@ class GrpcWorkerService : public tsl::AsyncServiceInterface {
   void operator=(const GrpcWorkerService&) = delete;
 };
 
+// Encodes the metadata of `tensor` into `response` and exposes its content to
+// `transport`. If `cache_enabled`, the exposed buffer is kept until the step is
+// released, since the cached response may be sent again. Returns false if the
+// content must be sent inline instead.
+bool EncodeTensorForTransport(RecvTensorTransport* transport, int64_t step_id,
+                              bool is_dead, const Tensor& tensor,
+                              bool cache_enabled,
+                              ::grpc::ByteBuffer* response) {
+  if (is_dead || !DataTypeCanUseMemcpy(tensor.dtype()) ||
+      static_cast<int64_t>(tensor.TotalBytes()) < transport->min_bytes()) {
+    return false;
+  }
+  RecvTensorResponse proto;
+  absl::Status s = transport->Expose(step_id, tensor, cache_enabled,
+                                     proto.mutable_transport_options());
+  if (!s.ok()) {
+    VLOG(1) << "Sending tensor inline after failing to expose it: " << s;
+    return false;
+  }
+  proto.set_send_start_micros(Env::Default()->NowMicros());
+  proto.mutable_tensor()->set_dtype(tensor.dtype());
+  tensor.shape().AsProto(proto.mutable_tensor()->mutable_tensor_shape());
+  grpc::EncodeRecvTensorResponseToByteBuffer(proto, response);
+  return true;
+}
+
+// Encodes `tensor` into `response` with `compression`. Returns false if the
+// tensor must be sent uncompressed instead.
+bool EncodeCompressedTensor(RecvTensorCompression compression, bool is_dead,
+                            const Tensor& tensor, bool require_ack,
+                            ::grpc::ByteBuffer* response) {
+  if (is_dead || compression == RECV_TENSOR_COMPRESSION_NONE) return false;
+  RecvTensorResponse proto;
+  if (!CompressTensor(compression, tensor, proto.mutable_tensor())) {
+    return false;
+  }
+  proto.set_compression(compression);
+  proto.set_send_start_micros(Env::Default()->NowMicros());
+  proto.set_require_ack(require_ack);
+  grpc::EncodeRecvTensorResponseToByteBuffer(proto, response);
+  return true;
+}
+
+// The state of a BatchRecvTensor call, shared by the callbacks of its requests,
+// which may outlive the call.
+struct BatchRecvTensorState {
+  mutex mu;
+  // Whether all the requests were queued.
+  bool started TF_GUARDED_BY(mu) = false;
+  bool responded TF_GUARDED_BY(mu) = false;
+  absl::Status status TF_GUARDED_BY(mu);
+  // Only modified with `mu` held, until `responded` is set.
+  BatchRecvTensorResponse* response = nullptr;
+
+  // Returns true, once, if the call must respond with `*response_status`
+  // after releasing `mu`: when all the requests are queued and a tensor or an
+  // error is available.
+  bool ShouldRespond(absl::Status* response_status)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu) {
+    if (!started || responded ||
+        (status.ok() && response->response_size() == 0)) {
+      return false;
+    }
+    responded = true;
+    *response_status = status;
+    return true;
+  }
+};
+
 }  // namespace
 
 GrpcWorker::GrpcWorker(WorkerEnv* worker_env, const ConfigProto& config)
@@ -454,11 +545,20 @@ void GrpcWorker::GrpcRecvTensorAsync(CallOptions* opts,
   const int64_t step_id = request->step_id();
 
   bool cache_enabled = (response_cache_ != nullptr && request_id != 0);
-
-  auto do_response = [response, done, cache_enabled](
-                         const Tensor& tensor, bool is_dead,
-                         const absl::Status& status) {
-    if (status.ok()) {
+  RecvTensorTransport* transport =
+      request->dma_ok() ? env_->recv_tensor_transport : nullptr;
+
+  const RecvTensorCompression compression = request->compression();
+
+  auto do_response = [response, done, cache_enabled, transport, step_id,
+                      compression](const Tensor& tensor, bool is_dead,
+                                   const absl::Status& status) {
+    if (status.ok() &&
+        (transport == nullptr ||
+         !EncodeTensorForTransport(transport, step_id, is_dead, tensor,
+                                   cache_enabled, response)) &&
+        !EncodeCompressedTensor(compression, is_dead, tensor, cache_enabled,
+                                response)) {
       grpc::EncodeTensorToByteBuffer(is_dead, tensor, cache_enabled, response);
     }
     done(status);
@@ -484,27 +584,29 @@ void GrpcWorker::GrpcRecvTensorAsync(CallOptions* opts,
     }
   };
 
-  auto fail = [&rendezvous_done](const absl::Status& status) {
-    rendezvous_done(Tensor(), false, status);
-  };
-
   absl::Status s = recent_request_ids_.TrackUnique(
       request_id, "RecvTensor (GrpcWorker)", *request);
   if (!s.ok()) {
-    fail(s);
+    rendezvous_done(Tensor(), false, s);
     return;
   }
+  RecvLocalTensorAsync(opts, *request, std::move(rendezvous_done));
+}
 
-  const string& key = request->rendezvous_key();
+void GrpcWorker::RecvLocalTensorAsync(CallOptions* opts,
+                                      const RecvTensorRequest& request,
+                                      RpcResponseCache::FinishResponseCB done) {
+  const int64_t step_id = request.step_id();
+  const string& key = request.rendezvous_key();
   TRACEPRINTF("RecvTensor: %lld %s", step_id, key);
   Rendezvous::ParsedKey parsed;
-  s = Rendezvous::ParseKey(key, &parsed);
+  absl::Status s = Rendezvous::ParseKey(key, &parsed);
   Device* src_dev = nullptr;
   if (s.ok()) {
     s = PrepareRecvTensor(parsed, &src_dev);
   }
   if (!s.ok()) {
-    fail(s);
+    done(Tensor(), false, s);
     return;
   }
 
@@ -516,24 +618,28 @@ void GrpcWorker::GrpcRecvTensorAsync(CallOptions* opts,
   // failures, and the client might not observe any errors or cancellations but
   // simply waits for the responses. Aborting the step would report an error to
   // the client, and avoid permanent hanging in distributed function execution.
-  opts->SetCancelCallback([this, step_id]() {
-    LOG(WARNING) << "RecvTensor cancelled for " << step_id;
-    AbortStep(step_id);
-  });
+  if (opts != nullptr) {
+    opts->SetCancelCallback([this, step_id]() {
+      LOG(WARNING) << "RecvTensor cancelled for " << step_id;
+      AbortStep(step_id);
+    });
+  }
+  // The request may be destroyed before the tensor is produced if it is part
+  // of a BatchRecvTensorRequest, so the callback copies the key.
   env_->rendezvous_mgr->RecvLocalAsync(
       step_id, parsed,
-      [opts, rendezvous_done, src_dev, request](
+      [opts, done = std::move(done), src_dev, step_id, key](
           const absl::Status& status, const Rendezvous::Args& send_args,
           const Rendezvous::Args& recv_args, const Tensor& val,
           const bool is_dead) {
-        opts->ClearCancelCallback();
+        if (opts != nullptr) opts->ClearCancelCallback();
         if (!status.ok()) {
-          return rendezvous_done(val, is_dead, status);
+          return done(val, is_dead, status);
         }
 
         const bool on_host = send_args.alloc_attrs.on_host();
         if (!src_dev->tensorflow_accelerator_device_info() || on_host) {
-          return rendezvous_done(val, is_dead, status);
+          return done(val, is_dead, status);
         }
 
         DeviceContext* send_dev_context = send_args.device_context;
@@ -541,8 +647,8 @@ void GrpcWorker::GrpcRecvTensorAsync(CallOptions* opts,
         alloc_attrs.set_gpu_compatible(true);
         alloc_attrs.set_on_host(true);
         tsl::profiler::ScopedMemoryDebugAnnotation op_annotation(
-            "GrpcWorker::RecvTensorAsync::consumer_callback",
-            request->step_id(), "dynamic", val.dtype(),
+            "GrpcWorker::RecvTensorAsync::consumer_callback", step_id,
+            "dynamic", val.dtype(),
             [shape = val.shape()]() { return shape.DebugString(); });
         Allocator* alloc = src_dev->GetAllocator(alloc_attrs);
         Tensor* copy = new Tensor(alloc, val.dtype(), val.shape());
@@ -550,18 +656,112 @@ void GrpcWorker::GrpcRecvTensorAsync(CallOptions* opts,
             << "send dev name: " << src_dev->name()
             << " gpu_info: " << src_dev->tensorflow_accelerator_device_info();
 
-        StatusCallback copy_ready = [rendezvous_done, copy,
+        StatusCallback copy_ready = [done, copy,
                                      is_dead](const absl::Status& s) {
           // The value is now ready to be returned on the wire.
-          rendezvous_done(*copy, is_dead, s);
+          done(*copy, is_dead, s);
           delete copy;
         };
 
-        CopyDeviceToHost(&val, alloc, alloc, request->rendezvous_key(), src_dev,
-                         copy, send_dev_context, copy_ready);
+        CopyDeviceToHost(&val, alloc, alloc, key, src_dev, copy,
+                         send_dev_context, copy_ready);
       });
 }
 
+void GrpcWorker::BatchRecvTensorAsync(CallOptions* opts,
+                                      const BatchRecvTensorRequest* request,
+                                      BatchRecvTensorResponse* response,
+                                      StatusCallback done) {
+  VLOG(3) << "BatchRecvTensorAsync with " << request->request_size()
+          << " requests";
+  if (request->request_size() == 0) {
+    done(errors::InvalidArgument("Empty BatchRecvTensorRequest"));
+    return;
+  }
+  for (const RecvTensorRequest& r : request->request()) {
+    if (r.request_id() == 0) {
+      done(errors::InvalidArgument(
+          "BatchRecvTensorRequest without request_id for ",
+          r.rendezvous_key()));
+      return;
+    }
+  }
+
+  // The receiver has the tensors of the earlier batches. The tensors of this
+  // batch stay cached until a later batch lists them, since this batch may be
+  // retried if its response is lost.
+  for (int64_t id : request->finished_request_id()) {
+    batch_response_cache_.EraseRequestId(id);
+  }
+
+  auto state = std::make_shared<BatchRecvTensorState>();
+  state->response = response;
+  auto respond = [opts, done = std::move(done)](const absl::Status& status) {
+    opts->ClearCancelCallback();
+    done(status);
+  };
+
+  opts->SetCancelCallback([this, step_id = request->request(0).step_id()]() {
+    LOG(WARNING) << "BatchRecvTensor cancelled for " << step_id;
+    AbortStep(step_id);
+  });
+  for (const RecvTensorRequest& r : request->request()) {
+    const int64_t request_id = r.request_id();
+    const RecvTensorCompression compression = r.compression();
+    auto tensor_ready = [state, request_id, compression, respond](
+                            const Tensor& tensor, bool is_dead,
+                            const absl::Status& status) {
+      absl::Status response_status;
+      {
+        mutex_lock l(state->mu);
+        if (state->responded) return;
+        if (!status.ok()) {
+          state->status.Update(status);
+        } else {
+          RecvTensorResponse* proto = state->response->add_response();
+          proto->set_is_dead(is_dead);
+          proto->set_send_start_micros(Env::Default()->NowMicros());
+          if (!is_dead &&
+              CompressTensor(compression, tensor, proto->mutable_tensor())) {
+            proto->set_compression(compression);
+          } else {
+            tensor.AsProtoTensorContent(proto->mutable_tensor());
+          }
+          state->response->add_request_id(request_id);
+        }
+        if (!state->ShouldRespond(&response_status)) return;
+      }
+      respond(response_status);
+    };
+    // Requests that were part of an earlier batch, or of an earlier attempt of
+    // this one, are already in the cache and must not be tracked again.
+    if (batch_response_cache_.QueueRequest(request_id, r.step_id(),
+                                           tensor_ready)) {
+      continue;
+    }
+    auto finished = [this, request_id](const Tensor& tensor, bool is_dead,
+                                       const absl::Status& status) {
+      batch_response_cache_.RequestFinished(request_id, tensor, is_dead,
+                                            status);
+    };
+    absl::Status s = recent_request_ids_.TrackUnique(
+        request_id, "BatchRecvTensor (GrpcWorker)", r);
+    if (!s.ok()) {
+      finished(Tensor(), false, s);
+      continue;
+    }
+    RecvLocalTensorAsync(/*opts=*/nullptr, r, std::move(finished));
+  }
+
+  absl::Status response_status;
+  {
+    mutex_lock l(state->mu);
+    state->started = true;
+    if (!state->ShouldRespond(&response_status)) return;
+  }
+  respond(response_status);
+}
+
 namespace {
 // If RecvBufRespExtra.tensor_content is a single large string, then gRPC
 // can stall on the recv side when the string buffer needs to be enlarged,
@@ -744,6 +944,10 @@ void GrpcWorker::CleanupGraphAsync(const CleanupGraphRequest* request,
     // a worker crashes before acking a request.
     response_cache_->CleanEntriesForStep(request->step_id());
   }
+  batch_response_cache_.CleanEntriesForStep(request->step_id());
+  if (env_->recv_tensor_transport != nullptr) {
+    env_->recv_tensor_transport->ReleaseStep(request->step_id());
+  }
   Worker::CleanupGraphAsync(request, response, done);
 }
 
@@ -753,6 +957,7 @@ void GrpcWorker::RemoveCacheEntryForId(int64_t request_id) {
   if (response_cache_) {
     response_cache_->EraseRequestId(request_id);
   }
+  batch_response_cache_.EraseRequestId(request_id);
 }
 
 std::unique_ptr<GrpcWorker> NewGrpcWorker(WorkerEnv* env,
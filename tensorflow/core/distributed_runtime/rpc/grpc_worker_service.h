@@ -51,6 +51,11 @@ class GrpcWorker : public Worker {
                                    ::grpc::ByteBuffer* response,
                                    StatusCallback done);
 
+  void BatchRecvTensorAsync(CallOptions* opts,
+                            const BatchRecvTensorRequest* request,
+                            BatchRecvTensorResponse* response,
+                            StatusCallback done) override;
+
   void LoggingAsync(const LoggingRequest* request, LoggingResponse* response,
                     StatusCallback done) override;
 
@@ -68,7 +73,16 @@ class GrpcWorker : public Worker {
   void RemoveCacheEntryForId(int64_t request_id);
 
  private:
+  // Receives the tensor requested by `request` from the local rendezvous, and
+  // copies it to host memory if needed. If `opts` is not null, cancelling it
+  // aborts the step.
+  void RecvLocalTensorAsync(CallOptions* opts, const RecvTensorRequest& request,
+                            RpcResponseCache::FinishResponseCB done);
+
   std::unique_ptr<RpcResponseCache> response_cache_;
+  // Holds the tensors that were not ready when a BatchRecvTensor response was
+  // sent, until they are requested again.
+  RpcResponseCache batch_response_cache_;
   const int32 recv_buf_max_chunk_;
 };
 
@@ -0,0 +1,78 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_RPC_RECV_TENSOR_TRANSPORT_H_
+#define TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_RPC_RECV_TENSOR_TRANSPORT_H_
+
+#include <cstdint>
+
+#include "google/protobuf/any.pb.h"
+#include "absl/status/status.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/platform/status.h"
+
+namespace tensorflow {
+
+// Moves the content of large tensors between workers outside of the
+// RecvTensor RPC, e.g. with one-sided RDMA reads from buffers registered with
+// the NIC. The RPC still carries the request, the tensor metadata and the
+// content of small tensors, so the transport only needs to move bytes.
+//
+// The protocol is:
+//   1. A receiver whose destination tensor is in host memory sets
+//      RecvTensorRequest.dma_ok.
+//   2. If the tensor has at least min_bytes() of content, the sender calls
+//      Expose() and responds with the dtype and shape of the tensor and the
+//      `transport_options` filled by Expose(), instead of the content.
+//   3. The receiver allocates the tensor and calls ReadAsync() with the
+//      `transport_options` of the response.
+//
+// Both workers must be configured with compatible transports. Implementations
+// must be thread-safe.
+class RecvTensorTransport {
+ public:
+  virtual ~RecvTensorTransport() = default;
+
+  // Returns the size in bytes of the smallest tensor content that is worth
+  // moving by the transport rather than inline in the RPC.
+  virtual int64_t min_bytes() const = 0;
+
+  // Sender side. Makes the content of `tensor`, which is in host memory and
+  // has a memcpy-able dtype, readable by the receiver, and describes how to
+  // read it in `transport_options`. The transport keeps a reference to the
+  // buffer of `tensor` until the receiver has read it, and at the latest until
+  // ReleaseStep(step_id). If `keep_until_released` is true, the response may
+  // be delivered again from the response cache, so the reference must be kept
+  // until ReleaseStep(step_id) even after a read. If this returns an error,
+  // the content is sent inline.
+  virtual absl::Status Expose(int64_t step_id, const Tensor& tensor,
+                              bool keep_until_released,
+                              google::protobuf::Any* transport_options) = 0;
+
+  // Receiver side. Reads the content described by `transport_options` into
+  // the buffer of `tensor`, which is in host memory and already has the dtype
+  // and shape of the sent tensor.
+  virtual void ReadAsync(const google::protobuf::Any& transport_options,
+                         Tensor* tensor, StatusCallback done) = 0;
+
+  // Sender side. Releases the buffers exposed for `step_id`. Called when the
+  // step is cleaned up, including when it was aborted before the receiver
+  // read them.
+  virtual void ReleaseStep(int64_t step_id) = 0;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_RPC_RECV_TENSOR_TRANSPORT_H_
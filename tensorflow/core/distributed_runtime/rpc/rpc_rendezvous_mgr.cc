@@ -15,11 +15,13 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/rpc/rpc_rendezvous_mgr.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "tensorflow/core/common_runtime/device.h"
 #include "tensorflow/core/common_runtime/device_mgr.h"
 #include "tensorflow/core/common_runtime/dma_helper.h"
 #include "tensorflow/core/common_runtime/process_util.h"
 #include "tensorflow/core/distributed_runtime/request_id.h"
+#include "tensorflow/core/distributed_runtime/rpc/recv_tensor_transport.h"
 #include "tensorflow/core/distributed_runtime/tensor_coding.h"
 #include "tensorflow/core/distributed_runtime/worker_cache.h"
 #include "tensorflow/core/distributed_runtime/worker_interface.h"
@@ -36,10 +38,13 @@ namespace tensorflow {
 
 namespace {
 
+class RpcRecvTensorCall;
+
 class RpcRemoteRendezvous : public BaseRemoteRendezvous {
  public:
-  RpcRemoteRendezvous(const WorkerEnv* env, int64_t step_id)
-      : BaseRemoteRendezvous(env, step_id) {}
+  RpcRemoteRendezvous(const WorkerEnv* env, int64_t step_id,
+                      const RpcRendezvousMgrOptions& options)
+      : BaseRemoteRendezvous(env, step_id), options_(options) {}
 
  protected:
   void RecvFromRemoteAsync(const Rendezvous::ParsedKey& parsed,
@@ -47,8 +52,35 @@ class RpcRemoteRendezvous : public BaseRemoteRendezvous {
                            DoneCallback done) override;
 
  private:
+  friend class BatchRecvTensorCall;
+
+  // A started call whose request is waiting to be sent in a batch.
+  struct PendingRecv {
+    RpcRecvTensorCall* call;
+    std::function<void()> recv_done;
+    // Whether the request was sent in an earlier batch, whose response did
+    // not include its tensor.
+    bool resent = false;
+  };
+
   ~RpcRemoteRendezvous() override {}
 
+  // Queues `recvs` to be sent in the next batch to `worker`. The batch is sent
+  // from the compute pool, so that the requests queued until then share it.
+  void EnqueueBatchRecv(const string& worker, std::vector<PendingRecv> recvs);
+
+  // Sends the requests queued for `worker`.
+  void FlushBatchRecv(const string& worker);
+
+  const RpcRendezvousMgrOptions options_;
+  mutex batch_mu_;
+  absl::flat_hash_map<string, std::vector<PendingRecv>> pending_recvs_
+      TF_GUARDED_BY(batch_mu_);
+  // The request ids of the tensors received from each worker in a batch, which
+  // the next batch to the worker lists so that it can drop them.
+  absl::flat_hash_map<string, std::vector<int64_t>> finished_request_ids_
+      TF_GUARDED_BY(batch_mu_);
+
   RpcRemoteRendezvous(const RpcRemoteRendezvous&) = delete;
   void operator=(const RpcRemoteRendezvous&) = delete;
 };
@@ -60,6 +92,8 @@ class RpcRecvTensorCall : public BaseRecvTensorCall {
 
   void Init(WorkerInterface* wi, int64_t step_id, StringPiece key,
             AllocatorAttributes alloc_attrs, Device* dst_device,
+            RecvTensorTransport* transport,
+            RecvTensorCompression compression,
             const Rendezvous::Args& recv_args, Rendezvous::DoneCallback done) {
     wi_ = wi;
     alloc_attrs_ = alloc_attrs;
@@ -69,6 +103,13 @@ class RpcRecvTensorCall : public BaseRecvTensorCall {
     req_.set_step_id(step_id);
     req_.set_rendezvous_key(key.data(), key.size());
     req_.set_request_id(GetUniqueRequestId());
+    req_.set_compression(compression);
+    // The transport can only write into host memory.
+    if (transport != nullptr &&
+        (alloc_attrs.on_host() || dst_device->device_type() == DEVICE_CPU)) {
+      transport_ = transport;
+      req_.set_dma_ok(true);
+    }
   }
 
   void Reset() {
@@ -79,6 +120,8 @@ class RpcRecvTensorCall : public BaseRecvTensorCall {
 
     alloc_attrs_ = AllocatorAttributes();
     dst_device_ = nullptr;
+    transport_ = nullptr;
+    transport_tensor_ = Tensor();
     // We don't clear opts_ and assume that Init will set up the state for
     // opts_ appropriately.
     req_.Clear();
@@ -131,6 +174,7 @@ class RpcRecvTensorCall : public BaseRecvTensorCall {
   const Rendezvous::DoneCallback& done() const { return done_; }
 
  private:
+  friend class BatchRecvTensorCall;
   friend class RpcRemoteRendezvous;
 
   // Start the main RecvTensor call, checking for an async abort.
@@ -145,6 +189,9 @@ class RpcRecvTensorCall : public BaseRecvTensorCall {
       if (!s.ok()) {
         mutex_lock l(mu_);
         status_.Update(s);
+      } else if (resp_.metadata().has_transport_options()) {
+        ReadFromTransport(std::move(recv_done));
+        return;
       }
       recv_done();
     };
@@ -167,11 +214,39 @@ class RpcRecvTensorCall : public BaseRecvTensorCall {
     abort_checked->Notify();
   }
 
+  // Fills the tensor whose metadata was received with the content sent by the
+  // transport.
+  void ReadFromTransport(std::function<void()> recv_done) {
+    if (transport_ == nullptr) {
+      {
+        mutex_lock l(mu_);
+        status_.Update(errors::Internal(
+            "Received a tensor sent by a RecvTensorTransport without using "
+            "one"));
+      }
+      recv_done();
+      return;
+    }
+    // Shares the buffer of the response tensor, and outlives the read.
+    transport_tensor_ = resp_.tensor();
+    transport_->ReadAsync(
+        resp_.metadata().transport_options(), &transport_tensor_,
+        [this, recv_done = std::move(recv_done)](const absl::Status& s) {
+          if (!s.ok()) {
+            mutex_lock l(mu_);
+            status_.Update(s);
+          }
+          recv_done();
+        });
+  }
+
   string src_worker_;
   string src_rel_device_;
   WorkerInterface* wi_;  // Not owned.
   AllocatorAttributes alloc_attrs_;
   Device* dst_device_;
+  RecvTensorTransport* transport_ = nullptr;  // Not owned.
+  Tensor transport_tensor_;
   CallOptions opts_;
   RecvTensorRequest req_;
   TensorResponse resp_;
@@ -185,6 +260,120 @@ class RpcRecvTensorCall : public BaseRecvTensorCall {
   void operator=(const RpcRecvTensorCall&) = delete;
 };
 
+// Receives the tensors of several calls to the same worker with one
+// BatchRecvTensor RPC, and queues the calls whose tensors were not ready in
+// the next batch. Deletes itself when done.
+class BatchRecvTensorCall {
+ public:
+  BatchRecvTensorCall(RpcRemoteRendezvous* rendezvous,
+                      std::vector<RpcRemoteRendezvous::PendingRecv> recvs,
+                      const std::vector<int64_t>& finished_request_ids)
+      : rendezvous_(rendezvous), recvs_(std::move(recvs)) {
+    rendezvous_->Ref();
+    for (int64_t id : finished_request_ids) {
+      req_.add_finished_request_id(id);
+    }
+  }
+
+  void Start() {
+    for (RpcRemoteRendezvous::PendingRecv& recv : recvs_) {
+      *req_.add_request() = recv.call->req_;
+      // Aborting any of the calls cancels the batch.
+      recv.call->opts_.SetCancelCallback([this]() { opts_.StartCancel(); });
+    }
+    auto abort_checked = std::make_shared<Notification>();
+    recvs_[0].call->wi_->BatchRecvTensorAsync(
+        &opts_, &req_, &resp_, [this, abort_checked](const absl::Status& s) {
+          abort_checked->WaitForNotification();
+          Done(s);
+        });
+    // As in RpcRecvTensorCall::StartRTCall, a call may have been aborted
+    // before the RPC registered its cancellation.
+    for (const RpcRemoteRendezvous::PendingRecv& recv : recvs_) {
+      if (!recv.call->status().ok()) {
+        opts_.StartCancel();
+        break;
+      }
+    }
+    abort_checked->Notify();
+  }
+
+ private:
+  void Done(const absl::Status& s) {
+    for (RpcRemoteRendezvous::PendingRecv& recv : recvs_) {
+      recv.call->opts_.ClearCancelCallback();
+    }
+    if (absl::IsUnimplemented(s)) {
+      // The worker does not support batching.
+      VLOG(1) << "Sending RecvTensor requests one by one after " << s;
+      for (RpcRemoteRendezvous::PendingRecv& recv : recvs_) {
+        recv.call->StartRTCall(std::move(recv.recv_done));
+      }
+      Finish();
+      return;
+    }
+
+    absl::flat_hash_map<int64_t, int> response_index;
+    if (s.ok()) {
+      for (int i = 0; i < resp_.request_id_size(); ++i) {
+        response_index[resp_.request_id(i)] = i;
+      }
+    }
+    std::vector<RpcRemoteRendezvous::PendingRecv> ready;
+    std::vector<RpcRemoteRendezvous::PendingRecv> remaining;
+    for (RpcRemoteRendezvous::PendingRecv& recv : recvs_) {
+      RpcRecvTensorCall* call = recv.call;
+      auto it = response_index.find(call->req_.request_id());
+      if (!s.ok()) {
+        mutex_lock l(call->mu_);
+        call->status_.Update(s);
+      } else if (it != response_index.end()) {
+        call->resp_.InitAlloc(call->dst_device_, call->alloc_attrs_);
+        absl::Status init_status =
+            call->resp_.InitFrom(resp_.mutable_response(it->second));
+        if (!init_status.ok()) {
+          mutex_lock l(call->mu_);
+          call->status_.Update(init_status);
+        }
+      } else if (call->status().ok()) {
+        recv.resent = true;
+        remaining.push_back(std::move(recv));
+        continue;
+      }
+      ready.push_back(std::move(recv));
+    }
+    const string worker = recvs_[0].call->src_worker_;
+    if (s.ok() && resp_.request_id_size() > 0) {
+      mutex_lock l(rendezvous_->batch_mu_);
+      std::vector<int64_t>& finished =
+          rendezvous_->finished_request_ids_[worker];
+      finished.insert(finished.end(), resp_.request_id().begin(),
+                      resp_.request_id().end());
+    }
+    if (!remaining.empty()) {
+      rendezvous_->EnqueueBatchRecv(worker, std::move(remaining));
+    }
+    for (RpcRemoteRendezvous::PendingRecv& recv : ready) {
+      recv.recv_done();
+    }
+    Finish();
+  }
+
+  void Finish() {
+    rendezvous_->Unref();
+    delete this;
+  }
+
+  RpcRemoteRendezvous* const rendezvous_;
+  std::vector<RpcRemoteRendezvous::PendingRecv> recvs_;
+  CallOptions opts_;
+  BatchRecvTensorRequest req_;
+  BatchRecvTensorResponse resp_;
+
+  BatchRecvTensorCall(const BatchRecvTensorCall&) = delete;
+  void operator=(const BatchRecvTensorCall&) = delete;
+};
+
 class RpcRecvTensorFreeList {
  public:
   RpcRecvTensorFreeList() {}
@@ -270,6 +459,7 @@ void RpcRemoteRendezvous::RecvFromRemoteAsync(
   }
 
   call->Init(rwi, step_id_, parsed.FullKey(), recv_args.alloc_attrs, dst_device,
+             env_->recv_tensor_transport, options_.recv_tensor_compression,
              recv_args, std::move(done));
 
   // Record "call" in calls_ so that it can be aborted cleanly.
@@ -289,7 +479,7 @@ void RpcRemoteRendezvous::RecvFromRemoteAsync(
 
   // Start "call".
   Ref();
-  call->Start([this, call, recv_args, worker_cache]() {
+  auto recv_done = [this, call, recv_args, worker_cache]() {
     // Removes "call" from calls_. Prevent StartAbort().
     DeregisterCall(call, recv_args);
     // If StartAbort was called prior to DeregisterCall, then the
@@ -302,18 +492,75 @@ void RpcRemoteRendezvous::RecvFromRemoteAsync(
     call->done()(s, Args(), call->recv_args(), call->tensor(), call->is_dead());
     get_call_freelist()->Release(call);
     Unref();
-  });
+  };
+  // Tensors received by a RecvTensorTransport are large, so batching would not
+  // save much.
+  if (options_.batch_recv_tensor && call->transport_ == nullptr) {
+    std::vector<PendingRecv> recvs;
+    recvs.push_back({call, std::move(recv_done)});
+    EnqueueBatchRecv(call->src_worker_, std::move(recvs));
+  } else {
+    call->Start(std::move(recv_done));
+  }
+}
+
+void RpcRemoteRendezvous::EnqueueBatchRecv(const string& worker,
+                                           std::vector<PendingRecv> recvs) {
+  bool schedule_flush;
+  {
+    mutex_lock l(batch_mu_);
+    std::vector<PendingRecv>& pending = pending_recvs_[worker];
+    schedule_flush = pending.empty();
+    for (PendingRecv& recv : recvs) {
+      pending.push_back(std::move(recv));
+    }
+  }
+  if (schedule_flush) {
+    Ref();
+    env_->compute_pool->Schedule([this, worker]() {
+      FlushBatchRecv(worker);
+      Unref();
+    });
+  }
+}
+
+void RpcRemoteRendezvous::FlushBatchRecv(const string& worker) {
+  std::vector<PendingRecv> recvs;
+  std::vector<int64_t> finished_request_ids;
+  {
+    mutex_lock l(batch_mu_);
+    auto it = pending_recvs_.find(worker);
+    recvs.swap(it->second);
+    pending_recvs_.erase(it);
+    // A single new request is sent with RecvTensor, which returns its tensor
+    // as soon as it is ready. A request that was sent in a batch must be sent
+    // in a batch again, since the worker keeps its tensor in the batch cache.
+    if (recvs.size() > 1 || recvs[0].resent) {
+      auto finished = finished_request_ids_.find(worker);
+      if (finished != finished_request_ids_.end()) {
+        finished_request_ids.swap(finished->second);
+        finished_request_ids_.erase(finished);
+      }
+    }
+  }
+  if (recvs.size() == 1 && !recvs[0].resent) {
+    recvs[0].call->Start(std::move(recvs[0].recv_done));
+    return;
+  }
+  (new BatchRecvTensorCall(this, std::move(recvs), finished_request_ids))
+      ->Start();
 }
 
 }  // namespace
 
-RpcRendezvousMgr::RpcRendezvousMgr(const WorkerEnv* env)
-    : BaseRendezvousMgr(env) {}
+RpcRendezvousMgr::RpcRendezvousMgr(const WorkerEnv* env,
+                                   const RpcRendezvousMgrOptions& options)
+    : BaseRendezvousMgr(env), options_(options) {}
 
 tsl::core::RefCountPtr<BaseRemoteRendezvous> RpcRendezvousMgr::Create(
     int64_t step_id, const WorkerEnv* worker_env) {
   return tsl::core::RefCountPtr<BaseRemoteRendezvous>(
-      new RpcRemoteRendezvous(worker_env, step_id));
+      new RpcRemoteRendezvous(worker_env, step_id, options_));
 }
 
 }  // end namespace tensorflow
@@ -19,11 +19,21 @@ limitations under the License.
 #include "tensorflow/core/distributed_runtime/base_rendezvous_mgr.h"
 #include "tensorflow/core/distributed_runtime/worker_env.h"
 #include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/protobuf/worker.pb.h"
 
 namespace tensorflow {
 
 class DeviceMgr;
 
+struct RpcRendezvousMgrOptions {
+  // If true, the tensors of a step are received with BatchRecvTensor RPCs, see
+  // ConfigProto.Experimental.batch_recv_tensor.
+  bool batch_recv_tensor = false;
+  // How the sending workers are asked to compress the received tensors, see
+  // ConfigProto.Experimental.recv_tensor_compression.
+  RecvTensorCompression recv_tensor_compression = RECV_TENSOR_COMPRESSION_NONE;
+};
+
 // RendezvousMgr keeps track of a set of local rendezvous instances.
 // All tensors sent by this worker are buffered in a RendezvousMgr
 // until the tensor is received.  Each global unique "step_id"
@@ -44,13 +54,16 @@ class DeviceMgr;
 // RendezvousMgr must have keys generated by Rendezvous::CreateKey.
 class RpcRendezvousMgr : public BaseRendezvousMgr {
  public:
-  explicit RpcRendezvousMgr(const WorkerEnv* env);
+  explicit RpcRendezvousMgr(const WorkerEnv* env,
+                            const RpcRendezvousMgrOptions& options = {});
 
  protected:
   tsl::core::RefCountPtr<BaseRemoteRendezvous> Create(
       int64_t step_id, const WorkerEnv* worker_env) override;
 
  private:
+  const RpcRendezvousMgrOptions options_;
+
   RpcRendezvousMgr(const RpcRendezvousMgr&) = delete;
   void operator=(const RpcRendezvousMgr&) = delete;
 };
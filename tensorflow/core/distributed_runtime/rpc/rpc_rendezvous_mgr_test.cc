@@ -15,18 +15,27 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/rpc/rpc_rendezvous_mgr.h"
 
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
 #include "tensorflow/core/common_runtime/process_util.h"
+#include "tensorflow/core/distributed_runtime/rpc/recv_tensor_transport.h"
 #include "tensorflow/core/distributed_runtime/test_utils.h"
 #include "tensorflow/core/framework/cancellation.h"
 #include "tensorflow/core/framework/control_flow.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/notification.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/blocking_counter.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/random.h"
 #include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/platform/threadpool.h"
 
 namespace tensorflow {
 
@@ -52,11 +61,26 @@ Rendezvous::ParsedKey MakeKey(const string& s) {
 
 namespace {
 // A dummy worker interface implementation that simply triggers the callback
-// with OK status for RecvTensor request.
+// with OK status for RecvTensor request, and answers the first request of each
+// BatchRecvTensor request. The received tensors hold their rendezvous key. Like
+// GrpcWorker, it expects the requests that were not answered to be sent again
+// with the same request id, and the answered ones to be listed as finished.
 class DummyWorker : public TestWorkerInterface {
  public:
   void RecvTensorAsync(CallOptions* opts, const RecvTensorRequest* request,
                        TensorResponse* response, StatusCallback done) override {
+    if (!request->dma_ok()) {
+      RecvTensorResponse proto;
+      V(request->rendezvous_key()).AsProtoTensorContent(proto.mutable_tensor());
+      TF_CHECK_OK(response->InitFrom(&proto));
+    } else {
+      // Responds with the metadata of a tensor sent by a RecvTensorTransport.
+      RecvTensorResponse proto;
+      proto.mutable_tensor()->set_dtype(DT_FLOAT);
+      TensorShape({4}).AsProto(proto.mutable_tensor()->mutable_tensor_shape());
+      proto.mutable_transport_options()->set_type_url("fake_transport");
+      response->InitPartial(proto, AllocationAttributes());
+    }
     SchedClosure([done = std::move(done)]() {
       // Simulate a random delay for RPC. This is needed to fill the entire
       // object buffer in `RpcRecvTensorFreeList` and trigger the destruction of
@@ -66,10 +90,53 @@ class DummyWorker : public TestWorkerInterface {
       done(absl::OkStatus());
     });
   }
+
+  void BatchRecvTensorAsync(CallOptions* opts,
+                            const BatchRecvTensorRequest* request,
+                            BatchRecvTensorResponse* response,
+                            StatusCallback done) override {
+    absl::Status s;
+    {
+      mutex_lock l(mu_);
+      num_batches_++;
+      for (int64_t id : request->finished_request_id()) {
+        if (answered_ids_.erase(id) == 0) {
+          s.Update(errors::InvalidArgument("Unknown finished request ", id));
+        }
+        num_finished_++;
+      }
+      for (const RecvTensorRequest& r : request->request()) {
+        if (answered_ids_.contains(r.request_id())) {
+          s.Update(errors::InvalidArgument("Answered request was sent again"));
+        } else if (!sent_ids_.insert(r.request_id()).second) {
+          num_resent_++;
+        }
+      }
+      const RecvTensorRequest& first = request->request(0);
+      answered_ids_.insert(first.request_id());
+      response->add_request_id(first.request_id());
+      V(first.rendezvous_key())
+          .AsProtoTensorContent(response->add_response()->mutable_tensor());
+    }
+    SchedClosure([s, done = std::move(done)]() { done(s); });
+  }
+
+  int num_batches() const { return num_batches_; }
+  int num_resent() const { return num_resent_; }
+  int num_finished() const { return num_finished_; }
+
+ private:
+  std::atomic<int> num_batches_{0};
+  mutex mu_;
+  absl::flat_hash_set<int64_t> sent_ids_ TF_GUARDED_BY(mu_);
+  absl::flat_hash_set<int64_t> answered_ids_ TF_GUARDED_BY(mu_);
+  std::atomic<int> num_resent_{0};
+  std::atomic<int> num_finished_{0};
 };
 
 // Fake cache implementation for WorkerEnv.
 class DummyWorkerCache : public WorkerCacheInterface {
+ public:
   void ListWorkers(std::vector<string>* workers) const override {}
   void ListWorkersInJob(const string& job_name,
                         std::vector<string>* workers) const override {}
@@ -95,6 +162,8 @@ class DummyWorkerCache : public WorkerCacheInterface {
   void GetDeviceLocalityAsync(const string& device, DeviceLocality* locality,
                               StatusCallback done) override {}
 
+  DummyWorker* dummy_remote_worker() { return dummy_remote_worker_; }
+
  private:
   DummyWorker* dummy_remote_worker_ = nullptr;
 };
@@ -104,7 +173,9 @@ static Device* CreateDevice(const char* type, const char* name) {
    public:
     explicit FakeDevice(const DeviceAttributes& attr) : Device(nullptr, attr) {}
     absl::Status Sync() override { return absl::OkStatus(); }
-    Allocator* GetAllocator(AllocatorAttributes) override { return nullptr; }
+    Allocator* GetAllocator(AllocatorAttributes) override {
+      return cpu_allocator();
+    }
   };
   DeviceAttributes attr;
   attr.set_name(name);
@@ -112,6 +183,27 @@ static Device* CreateDevice(const char* type, const char* name) {
   return new FakeDevice(attr);
 }
 
+// Fills the received tensors with a constant.
+class FakeRecvTensorTransport : public RecvTensorTransport {
+ public:
+  int64_t min_bytes() const override { return 0; }
+  absl::Status Expose(int64_t step_id, const Tensor& tensor,
+                      bool keep_until_released,
+                      google::protobuf::Any* transport_options) override {
+    return errors::Unimplemented("Unimplemented.");
+  }
+  void ReadAsync(const google::protobuf::Any& transport_options,
+                 Tensor* tensor, StatusCallback done) override {
+    if (transport_options.type_url() != "fake_transport") {
+      done(errors::InvalidArgument("Unexpected transport options"));
+      return;
+    }
+    tensor->flat<float>().setConstant(42);
+    done(absl::OkStatus());
+  }
+  void ReleaseStep(int64_t step_id) override {}
+};
+
 static DeviceMgr* CreateDeviceMgr() {
   std::unique_ptr<Device> d0(
       CreateDevice("CPU", "/job:mnist/replica:1/task:2/cpu:1"));
@@ -342,4 +434,83 @@ TEST_F(RpcRendezvousMgrTest, RemoteRecvAsyncMany) {
   rmgr_.Cleanup(step_id);
 }
 
+TEST_F(RpcRendezvousMgrTest, RemoteRecvThroughTransport) {
+  FakeRecvTensorTransport transport;
+  env.recv_tensor_transport = &transport;
+  const int64_t step_id = 123;
+  const Rendezvous::ParsedKey key = MakeKey(Rendezvous::CreateKey(
+      "/job:worker/replica:1/task:2/cpu:0", 7890,
+      "/job:mnist/replica:1/task:2/cpu:1", "foo", FrameAndIter(0, 0)));
+  {
+    tsl::core::RefCountPtr<RemoteRendezvous> rendez = rmgr_.Find(step_id);
+    TF_ASSERT_OK(rendez->Initialize(&worker_session_));
+    Rendezvous::Args args;
+
+    Tensor val;
+    bool val_dead = false;
+
+    TF_ASSERT_OK(rendez->Recv(key, args, &val, &val_dead));
+    EXPECT_FALSE(val_dead);
+    test::ExpectTensorEqual<float>(
+        val, test::AsTensor<float>({42, 42, 42, 42}, TensorShape({4})));
+  }
+  rmgr_.Cleanup(step_id);
+  env.recv_tensor_transport = nullptr;
+}
+
+TEST_F(RpcRendezvousMgrTest, RemoteRecvBatched) {
+  RpcRendezvousMgrOptions options;
+  options.batch_recv_tensor = true;
+  RpcRendezvousMgr rmgr(&env, options);
+  thread::ThreadPool pool(Env::Default(), "batch_recv", 1);
+  env.compute_pool = &pool;
+  const int64_t step_id = 123;
+  const int num_recvs = 4;
+  std::vector<string> keys;
+  for (int i = 0; i < num_recvs; ++i) {
+    keys.push_back(Rendezvous::CreateKey(
+        "/job:worker/replica:1/task:2/cpu:0", 7890,
+        "/job:mnist/replica:1/task:2/cpu:1", strings::StrCat("foo", i),
+        FrameAndIter(0, 0)));
+  }
+  {
+    tsl::core::RefCountPtr<RemoteRendezvous> rendez = rmgr.Find(step_id);
+    TF_ASSERT_OK(rendez->Initialize(&worker_session_));
+
+    // Blocks the pool until all the requests are queued, so that they are
+    // sent in one batch.
+    Notification all_queued;
+    pool.Schedule([&all_queued]() { all_queued.WaitForNotification(); });
+    mutex mu;
+    absl::Status status;
+    std::vector<string> values;
+    BlockingCounter counter(num_recvs);
+    for (const string& key : keys) {
+      rendez->RecvAsync(MakeKey(key), Rendezvous::Args(),
+                        [&](const absl::Status& s, const Rendezvous::Args&,
+                            const Rendezvous::Args&, const Tensor& val,
+                            const bool) {
+                          {
+                            mutex_lock l(mu);
+                            status.Update(s);
+                            if (s.ok()) values.push_back(V(val));
+                          }
+                          counter.DecrementCount();
+                        });
+    }
+    all_queued.Notify();
+    counter.Wait();
+    TF_ASSERT_OK(status);
+    EXPECT_THAT(values, ::testing::UnorderedElementsAreArray(keys));
+  }
+  rmgr.Cleanup(step_id);
+  // Each batch returns one tensor, and the others are sent again. Each batch
+  // after the first lists the tensor returned by the previous one.
+  DummyWorker* worker = cache_->dummy_remote_worker();
+  EXPECT_EQ(worker->num_batches(), num_recvs);
+  EXPECT_EQ(worker->num_resent(), num_recvs * (num_recvs - 1) / 2);
+  EXPECT_EQ(worker->num_finished(), num_recvs - 1);
+  env.compute_pool = nullptr;
+}
+
 }  // namespace tensorflow
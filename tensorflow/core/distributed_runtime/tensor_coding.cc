@@ -18,6 +18,7 @@ limitations under the License.
 #include "google/protobuf/any.pb.h"
 
 #include "tensorflow/core/common_runtime/device.h"
+#include "tensorflow/core/distributed_runtime/tensor_compression.h"
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/framework/tensor_shape.pb.h"
 
@@ -51,14 +52,18 @@ void TensorResponse::InitAlloc(DeviceBase* d, const AllocatorAttributes& aa) {
 }
 
 absl::Status TensorResponse::InitFrom(RecvTensorResponse* response) {
-  absl::Status s;
   meta_.Swap(response);
-  if (on_host_) {
-    if (!tensor_.FromProto(allocator_, meta_.tensor())) {
-      s = errors::InvalidArgument("Cannot parse tensor from response");
+  absl::Status s =
+      UncompressTensorProto(meta_.compression(), meta_.mutable_tensor());
+  if (s.ok()) {
+    if (on_host_) {
+      if (!tensor_.FromProto(allocator_, meta_.tensor())) {
+        s = errors::InvalidArgument("Cannot parse tensor from response");
+      }
+    } else {
+      s = device_->MakeTensorFromProto(meta_.tensor(), alloc_attrs_,
+                                       &tensor_);
     }
-  } else {
-    s = device_->MakeTensorFromProto(meta_.tensor(), alloc_attrs_, &tensor_);
   }
   {
     TensorProto empty;
@@ -88,7 +93,10 @@ absl::Status TensorResponse::ParseFrom(Source* source) {
       return errors::InvalidArgument("Cannot parse tensor from response");
     }
     absl::Status s =
-        device_->MakeTensorFromProto(meta_.tensor(), alloc_attrs_, &tensor_);
+        UncompressTensorProto(meta_.compression(), meta_.mutable_tensor());
+    if (s.ok()) {
+      s = device_->MakeTensorFromProto(meta_.tensor(), alloc_attrs_, &tensor_);
+    }
     // Reduce memory usage for big tensors.
     {
       TensorProto empty;
@@ -279,6 +287,10 @@ bool TensorResponse::ParseSlow(Source* source) {
   if (!meta_.ParseFromZeroCopyStream(source->contents())) {
     return false;
   }
+  if (!UncompressTensorProto(meta_.compression(), meta_.mutable_tensor())
+           .ok()) {
+    return false;
+  }
 
   Tensor parsed(meta_.tensor().dtype());
   if (!parsed.FromProto(allocator_, meta_.tensor())) {
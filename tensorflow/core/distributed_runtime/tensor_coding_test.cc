@@ -15,10 +15,12 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/tensor_coding.h"
 
+#include "tensorflow/core/distributed_runtime/tensor_compression.h"
 #include "tensorflow/core/framework/device_attributes.pb.h"
 #include "tensorflow/core/framework/device_base.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/env.h"
@@ -156,6 +158,28 @@ TEST_F(TensorResponseTest, Simple) {
 
 TEST_F(TensorResponseTest, StringTensor) { DoTestForStrings(DT_STRING); }
 
+TEST_F(TensorResponseTest, CompressedTensor) {
+  Tensor src(DT_INT32, TensorShape({4096}));
+  test::FillFn<int32>(&src, [](int i) { return i % 7; });
+
+  RecvTensorResponse proto;
+  proto.set_send_start_micros(123456);
+  proto.set_compression(RECV_TENSOR_COMPRESSION_SNAPPY);
+  ASSERT_TRUE(CompressTensor(RECV_TENSOR_COMPRESSION_SNAPPY, src,
+                             proto.mutable_tensor()));
+  string encoded;
+  proto.AppendToString(&encoded);
+  EXPECT_LT(encoded.size(), src.TotalBytes());
+
+  StringSource source(&encoded, 1024);
+  TensorResponse response;
+  DummyDevice cpu_device(Env::Default());
+  response.InitAlloc(&cpu_device, AllocatorAttributes());
+  TF_EXPECT_OK(response.ParseFrom(&source));
+  EXPECT_EQ(response.metadata().send_start_micros(), 123456);
+  test::ExpectTensorEqual<int32>(response.tensor(), src);
+}
+
 string MakeFloatTensorTestCase(int num_elems) {
   std::vector<int8> v(num_elems);
   for (int i = 0; i < num_elems; i++) {
@@ -0,0 +1,138 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/distributed_runtime/tensor_compression.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "tensorflow/core/framework/bfloat16.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/platform/snappy.h"
+
+namespace tensorflow {
+namespace {
+
+// Smaller tensors are sent uncompressed, since they are dominated by the RPC
+// overhead.
+constexpr size_t kMinCompressedBytes = 1024;
+
+}  // namespace
+
+bool CompressTensor(RecvTensorCompression compression, const Tensor& tensor,
+                    TensorProto* proto) {
+  if (tensor.TotalBytes() < kMinCompressedBytes ||
+      !DataTypeCanUseMemcpy(tensor.dtype())) {
+    return false;
+  }
+  switch (compression) {
+    case RECV_TENSOR_COMPRESSION_BFLOAT16: {
+      if (tensor.dtype() != DT_FLOAT) return false;
+      Tensor truncated(DT_BFLOAT16, tensor.shape());
+      RoundFloatToBFloat16(tensor.flat<float>().data(),
+                           truncated.flat<bfloat16>().data(),
+                           tensor.NumElements());
+      truncated.AsProtoTensorContent(proto);
+      return true;
+    }
+    case RECV_TENSOR_COMPRESSION_SNAPPY: {
+      StringPiece data = tensor.tensor_data();
+      std::string compressed;
+      if (!port::Snappy_Compress(data.data(), data.size(), &compressed) ||
+          compressed.size() >= data.size()) {
+        return false;
+      }
+      proto->Clear();
+      proto->set_dtype(tensor.dtype());
+      tensor.shape().AsProto(proto->mutable_tensor_shape());
+      *proto->mutable_tensor_content() = std::move(compressed);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+absl::Status UncompressTensorProto(RecvTensorCompression compression,
+                                   TensorProto* proto) {
+  switch (compression) {
+    case RECV_TENSOR_COMPRESSION_NONE:
+      return absl::OkStatus();
+    case RECV_TENSOR_COMPRESSION_BFLOAT16: {
+      Tensor truncated;
+      if (proto->dtype() != DT_BFLOAT16 || !truncated.FromProto(*proto)) {
+        return errors::InvalidArgument(
+            "Cannot parse a tensor compressed to bfloat16");
+      }
+      Tensor tensor(DT_FLOAT, truncated.shape());
+      BFloat16ToFloat(truncated.flat<bfloat16>().data(),
+                      tensor.flat<float>().data(), tensor.NumElements());
+      tensor.AsProtoTensorContent(proto);
+      return absl::OkStatus();
+    }
+    case RECV_TENSOR_COMPRESSION_SNAPPY: {
+      TensorShape shape;
+      TF_RETURN_IF_ERROR(
+          TensorShape::BuildTensorShape(proto->tensor_shape(), &shape));
+      if (!DataTypeCanUseMemcpy(proto->dtype())) {
+        return errors::InvalidArgument("Cannot uncompress a tensor of type ",
+                                       DataTypeString(proto->dtype()));
+      }
+      const std::string& compressed = proto->tensor_content();
+      const size_t num_bytes =
+          shape.num_elements() * DataTypeSize(proto->dtype());
+      size_t uncompressed_size;
+      if (!port::Snappy_GetUncompressedLength(
+              compressed.data(), compressed.size(), &uncompressed_size) ||
+          uncompressed_size != num_bytes) {
+        return errors::InvalidArgument(
+            "Snappy compressed tensor content of the wrong size");
+      }
+      std::string uncompressed(num_bytes, '\0');
+      if (!port::Snappy_Uncompress(compressed.data(), compressed.size(),
+                                   &uncompressed[0])) {
+        return errors::InvalidArgument(
+            "Cannot uncompress Snappy compressed tensor content");
+      }
+      *proto->mutable_tensor_content() = std::move(uncompressed);
+      return absl::OkStatus();
+    }
+    default:
+      return errors::InvalidArgument("Unknown RecvTensorCompression ",
+                                     static_cast<int>(compression));
+  }
+}
+
+absl::Status RecvTensorCompressionFromString(
+    absl::string_view name, RecvTensorCompression* compression) {
+  if (name.empty()) {
+    *compression = RECV_TENSOR_COMPRESSION_NONE;
+  } else if (name == "bfloat16") {
+    *compression = RECV_TENSOR_COMPRESSION_BFLOAT16;
+  } else if (name == "snappy") {
+    *compression = RECV_TENSOR_COMPRESSION_SNAPPY;
+  } else {
+    return errors::InvalidArgument("Unknown recv_tensor_compression \"", name,
+                                   "\". Expected \"bfloat16\" or \"snappy\".");
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,46 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_TENSOR_COMPRESSION_H_
+#define TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_TENSOR_COMPRESSION_H_
+
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/protobuf/worker.pb.h"
+
+namespace tensorflow {
+
+// Compression of the tensors sent by RecvTensor, see RecvTensorCompression.
+
+// Encodes `tensor` into `*proto` with `compression`. Returns false, leaving
+// `*proto` unchanged, if `compression` does not apply to `tensor` or would not
+// make it smaller, in which case the tensor should be sent uncompressed.
+bool CompressTensor(RecvTensorCompression compression, const Tensor& tensor,
+                    TensorProto* proto);
+
+// Replaces `*proto`, encoded by CompressTensor() with `compression`, by the
+// uncompressed tensor.
+absl::Status UncompressTensorProto(RecvTensorCompression compression,
+                                   TensorProto* proto);
+
+// Parses the value of ConfigProto.Experimental.recv_tensor_compression.
+absl::Status RecvTensorCompressionFromString(
+    absl::string_view name, RecvTensorCompression* compression);
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_TENSOR_COMPRESSION_H_
@@ -0,0 +1,83 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/distributed_runtime/tensor_compression.h"
+
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/protobuf/worker.pb.h"
+
+namespace tensorflow {
+namespace {
+
+Tensor RoundTrip(RecvTensorCompression compression, const Tensor& tensor) {
+  TensorProto proto;
+  EXPECT_TRUE(CompressTensor(compression, tensor, &proto));
+  EXPECT_LT(proto.tensor_content().size(), tensor.TotalBytes());
+  TF_EXPECT_OK(UncompressTensorProto(compression, &proto));
+  Tensor result;
+  EXPECT_TRUE(result.FromProto(proto));
+  return result;
+}
+
+TEST(TensorCompressionTest, BFloat16) {
+  Tensor tensor(DT_FLOAT, TensorShape({32, 32}));
+  test::FillFn<float>(&tensor, [](int i) { return i * 0.001f; });
+  Tensor result = RoundTrip(RECV_TENSOR_COMPRESSION_BFLOAT16, tensor);
+  EXPECT_EQ(result.dtype(), DT_FLOAT);
+  test::ExpectTensorNear<float>(result, tensor, 0.01);
+}
+
+TEST(TensorCompressionTest, Snappy) {
+  Tensor tensor(DT_INT64, TensorShape({16, 64}));
+  test::FillFn<int64_t>(&tensor, [](int i) { return i % 3; });
+  Tensor result = RoundTrip(RECV_TENSOR_COMPRESSION_SNAPPY, tensor);
+  test::ExpectTensorEqual<int64_t>(result, tensor);
+}
+
+TEST(TensorCompressionTest, SkipsTensorsThatDoNotApply) {
+  TensorProto proto;
+  // Too small.
+  EXPECT_FALSE(CompressTensor(RECV_TENSOR_COMPRESSION_SNAPPY,
+                              test::AsTensor<int32>({1, 2, 3}), &proto));
+  // Not a float.
+  EXPECT_FALSE(CompressTensor(RECV_TENSOR_COMPRESSION_BFLOAT16,
+                              Tensor(DT_INT32, TensorShape({1024})), &proto));
+  // Not memcpy-able.
+  EXPECT_FALSE(CompressTensor(RECV_TENSOR_COMPRESSION_SNAPPY,
+                              Tensor(DT_STRING, TensorShape({1024})), &proto));
+  EXPECT_FALSE(CompressTensor(RECV_TENSOR_COMPRESSION_NONE,
+                              Tensor(DT_FLOAT, TensorShape({1024})), &proto));
+  EXPECT_EQ(proto.ByteSizeLong(), 0);
+}
+
+TEST(TensorCompressionTest, FromString) {
+  RecvTensorCompression compression;
+  TF_EXPECT_OK(RecvTensorCompressionFromString("", &compression));
+  EXPECT_EQ(compression, RECV_TENSOR_COMPRESSION_NONE);
+  TF_EXPECT_OK(RecvTensorCompressionFromString("bfloat16", &compression));
+  EXPECT_EQ(compression, RECV_TENSOR_COMPRESSION_BFLOAT16);
+  TF_EXPECT_OK(RecvTensorCompressionFromString("snappy", &compression));
+  EXPECT_EQ(compression, RECV_TENSOR_COMPRESSION_SNAPPY);
+  EXPECT_TRUE(errors::IsInvalidArgument(
+      RecvTensorCompressionFromString("zstd", &compression)));
+}
+
+}  // namespace
+}  // namespace tensorflow
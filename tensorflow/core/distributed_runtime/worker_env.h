@@ -36,6 +36,7 @@ using tsl::thread::ThreadPool;
 class CollectiveExecutorMgrInterface;
 class Device;
 class DeviceMgr;
+class RecvTensorTransport;
 class RendezvousMgrInterface;
 class SessionMgr;
 
@@ -66,6 +67,10 @@ struct WorkerEnv {
   // A set of rendezvous keyed by step ids.
   RendezvousMgrInterface* rendezvous_mgr = nullptr;
 
+  // If set, moves the content of large tensors received by RecvTensor outside
+  // of the RPC.
+  RecvTensorTransport* recv_tensor_transport = nullptr;
+
   // Generates per-step CollectiveExecutors and has access to utilities
   // supporting collective operations.
   std::unique_ptr<CollectiveExecutorMgrInterface> collective_executor_mgr;
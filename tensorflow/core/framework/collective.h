@@ -49,6 +49,7 @@ enum CollectiveType {
   PERMUTE_COLLECTIVE,
   ALL_TO_ALL_COLLECTIVE,
   REDUCE_SCATTER_COLLECTIVE,
+  RAGGED_ALL_TO_ALL_COLLECTIVE,
   UNDEFINED_COLLECTIVE,
 };
 
@@ -0,0 +1,168 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/framework/cross_step_buffer_cache.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/types/optional.h"
+
+namespace tensorflow {
+
+// Wraps one allocator. Like `TrackingAllocator`, a ReuseAllocator must outlive
+// the buffers that it handed out, so once the owning cache calls `Close()` it
+// deletes itself when the last outstanding buffer is released.
+class CrossStepBufferCache::ReuseAllocator : public Allocator {
+ public:
+  ReuseAllocator(Allocator* allocator, size_t max_cached_bytes)
+      : allocator_(allocator), max_cached_bytes_(max_cached_bytes) {}
+
+  std::string Name() override { return allocator_->Name(); }
+
+  void* AllocateRaw(size_t alignment, size_t num_bytes) override {
+    return AllocateRaw(alignment, num_bytes, AllocationAttributes());
+  }
+
+  void* AllocateRaw(size_t alignment, size_t num_bytes,
+                    const AllocationAttributes& allocation_attr) override {
+    const Key key(num_bytes, alignment);
+    {
+      mutex_lock l(mu_);
+      auto it = free_buffers_.find(key);
+      if (it != free_buffers_.end() && !it->second.empty()) {
+        void* ptr = it->second.back();
+        it->second.pop_back();
+        cached_bytes_ -= num_bytes;
+        in_use_.emplace(ptr, key);
+        return ptr;
+      }
+    }
+    void* ptr = allocator_->AllocateRaw(alignment, num_bytes, allocation_attr);
+    if (ptr != nullptr) {
+      mutex_lock l(mu_);
+      in_use_.emplace(ptr, key);
+    }
+    return ptr;
+  }
+
+  void DeallocateRaw(void* ptr) override {
+    bool cached = false;
+    bool should_delete = false;
+    {
+      mutex_lock l(mu_);
+      auto it = in_use_.find(ptr);
+      DCHECK(it != in_use_.end());
+      const Key key = it->second;
+      in_use_.erase(it);
+      if (!closed_ && cached_bytes_ + key.first <= max_cached_bytes_) {
+        free_buffers_[key].push_back(ptr);
+        cached_bytes_ += key.first;
+        cached = true;
+      }
+      should_delete = closed_ && in_use_.empty();
+    }
+    if (!cached) allocator_->DeallocateRaw(ptr);
+    if (should_delete) delete this;
+  }
+
+  bool TracksAllocationSizes() const override {
+    return allocator_->TracksAllocationSizes();
+  }
+  size_t RequestedSize(const void* ptr) const override {
+    return allocator_->RequestedSize(ptr);
+  }
+  size_t AllocatedSize(const void* ptr) const override {
+    return allocator_->AllocatedSize(ptr);
+  }
+  int64_t AllocationId(const void* ptr) const override {
+    return allocator_->AllocationId(ptr);
+  }
+  bool AllocatesOpaqueHandle() const override {
+    return allocator_->AllocatesOpaqueHandle();
+  }
+  absl::optional<AllocatorStats> GetStats() override {
+    return allocator_->GetStats();
+  }
+  bool ClearStats() override { return allocator_->ClearStats(); }
+  AllocatorMemoryType GetMemoryType() const override {
+    return allocator_->GetMemoryType();
+  }
+
+  // Returns the cached buffers to the wrapped allocator. After this call the
+  // only further calls allowed are calls to `DeallocateRaw()` for buffers that
+  // are still in use.
+  void Close() {
+    std::vector<void*> to_free;
+    bool should_delete = false;
+    {
+      mutex_lock l(mu_);
+      closed_ = true;
+      for (auto& entry : free_buffers_) {
+        to_free.insert(to_free.end(), entry.second.begin(),
+                       entry.second.end());
+      }
+      free_buffers_.clear();
+      cached_bytes_ = 0;
+      should_delete = in_use_.empty();
+    }
+    for (void* ptr : to_free) allocator_->DeallocateRaw(ptr);
+    if (should_delete) delete this;
+  }
+
+ private:
+  ~ReuseAllocator() override = default;
+
+  // The size in bytes and alignment of a buffer.
+  typedef std::pair<size_t, size_t> Key;
+
+  Allocator* const allocator_;  // Not owned.
+  const size_t max_cached_bytes_;
+
+  mutex mu_;
+  bool closed_ TF_GUARDED_BY(mu_) = false;
+  size_t cached_bytes_ TF_GUARDED_BY(mu_) = 0;
+  absl::flat_hash_map<Key, std::vector<void*>> free_buffers_
+      TF_GUARDED_BY(mu_);
+  absl::flat_hash_map<void*, Key> in_use_ TF_GUARDED_BY(mu_);
+};
+
+CrossStepBufferCache::CrossStepBufferCache(size_t max_cached_bytes)
+    : max_cached_bytes_(max_cached_bytes) {}
+
+CrossStepBufferCache::~CrossStepBufferCache() {
+  mutex_lock l(mu_);
+  for (auto& entry : allocators_) entry.second->Close();
+}
+
+Allocator* CrossStepBufferCache::Wrap(Allocator* allocator) {
+  {
+    tf_shared_lock l(mu_);
+    for (const auto& entry : allocators_) {
+      if (entry.first == allocator) return entry.second;
+    }
+  }
+  mutex_lock l(mu_);
+  for (const auto& entry : allocators_) {
+    if (entry.first == allocator) return entry.second;
+  }
+  ReuseAllocator* wrapped = new ReuseAllocator(allocator, max_cached_bytes_);
+  allocators_.emplace_back(allocator, wrapped);
+  return wrapped;
+}
+
+}  // namespace tensorflow
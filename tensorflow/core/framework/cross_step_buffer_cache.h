@@ -0,0 +1,75 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_FRAMEWORK_CROSS_STEP_BUFFER_CACHE_H_
+#define TENSORFLOW_CORE_FRAMEWORK_CROSS_STEP_BUFFER_CACHE_H_
+
+#include <cstddef>
+#include <utility>
+
+#include "absl/container/inlined_vector.h"
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+
+namespace tensorflow {
+
+// A CrossStepBufferCache keeps the buffers that are released while running a
+// graph, so that allocations of the same size and alignment in later steps of
+// the same graph are served without going to the device allocator. For graphs
+// whose shapes do not change between steps, every temporary and output buffer
+// of a step is then recycled from the previous step.
+//
+// The cache is passed to kernels through `OpKernelContext::Params`, and
+// `OpKernelContext::get_allocator()` wraps the device allocators in it.
+// Buffers that escape from a step (e.g. fetched tensors) are simply not
+// released until their last reference is dropped; they are returned to the
+// cache, or to the device allocator if the cache has been destroyed.
+//
+// All methods are thread-safe.
+class CrossStepBufferCache {
+ public:
+  static constexpr size_t kDefaultMaxCachedBytes = 256 << 20;
+
+  // At most `max_cached_bytes` are kept for each wrapped allocator. Buffers
+  // released beyond that limit are returned to the wrapped allocator.
+  explicit CrossStepBufferCache(
+      size_t max_cached_bytes = kDefaultMaxCachedBytes);
+
+  // Returns the cached buffers to the wrapped allocators. Buffers that are
+  // still in use are returned when they are released.
+  ~CrossStepBufferCache();
+
+  // Returns an allocator that serves requests from the buffers previously
+  // released to it, and otherwise from `allocator`. The returned allocator is
+  // owned by the cache.
+  Allocator* Wrap(Allocator* allocator);
+
+ private:
+  class ReuseAllocator;
+
+  const size_t max_cached_bytes_;
+
+  mutex mu_;
+  absl::InlinedVector<std::pair<Allocator*, ReuseAllocator*>, 2> allocators_
+      TF_GUARDED_BY(mu_);
+
+  CrossStepBufferCache(const CrossStepBufferCache&) = delete;
+  void operator=(const CrossStepBufferCache&) = delete;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_FRAMEWORK_CROSS_STEP_BUFFER_CACHE_H_
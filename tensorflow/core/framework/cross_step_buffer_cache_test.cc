@@ -0,0 +1,101 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/framework/cross_step_buffer_cache.h"
+
+#include <memory>
+
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/platform/mem.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+class CountingAllocator : public Allocator {
+ public:
+  string Name() override { return "counting"; }
+  void* AllocateRaw(size_t /*alignment*/, size_t num_bytes) override {
+    ++num_allocations_;
+    ++num_live_;
+    return port::Malloc(num_bytes);
+  }
+  void DeallocateRaw(void* ptr) override {
+    --num_live_;
+    port::Free(ptr);
+  }
+  absl::optional<AllocatorStats> GetStats() override { return absl::nullopt; }
+
+  int num_allocations() const { return num_allocations_; }
+  int num_live() const { return num_live_; }
+
+ private:
+  int num_allocations_ = 0;
+  int num_live_ = 0;
+};
+
+TEST(CrossStepBufferCacheTest, ReusesBuffersOfTheSameSize) {
+  CountingAllocator base;
+  {
+    CrossStepBufferCache cache;
+    Allocator* a = cache.Wrap(&base);
+    EXPECT_EQ(a, cache.Wrap(&base));
+    for (int step = 0; step < 3; ++step) {
+      void* p1 = a->AllocateRaw(64, 128);
+      void* p2 = a->AllocateRaw(64, 256);
+      a->DeallocateRaw(p1);
+      a->DeallocateRaw(p2);
+    }
+    // Only the first step went to the wrapped allocator.
+    EXPECT_EQ(2, base.num_allocations());
+    EXPECT_EQ(2, base.num_live());
+
+    // A different size is not served from the cache.
+    void* p3 = a->AllocateRaw(64, 512);
+    EXPECT_EQ(3, base.num_allocations());
+    a->DeallocateRaw(p3);
+  }
+  // Destroying the cache returns the cached buffers.
+  EXPECT_EQ(0, base.num_live());
+}
+
+TEST(CrossStepBufferCacheTest, RespectsMaxCachedBytes) {
+  CountingAllocator base;
+  CrossStepBufferCache cache(/*max_cached_bytes=*/256);
+  Allocator* a = cache.Wrap(&base);
+  void* p1 = a->AllocateRaw(64, 256);
+  void* p2 = a->AllocateRaw(64, 256);
+  a->DeallocateRaw(p1);
+  a->DeallocateRaw(p2);
+  // Only one of the two buffers fits in the cache.
+  EXPECT_EQ(1, base.num_live());
+}
+
+TEST(CrossStepBufferCacheTest, BuffersMayOutliveTheCache) {
+  CountingAllocator base;
+  std::unique_ptr<Tensor> escaped;
+  {
+    CrossStepBufferCache cache;
+    escaped = std::make_unique<Tensor>(cache.Wrap(&base), DT_FLOAT,
+                                       TensorShape({16}));
+  }
+  EXPECT_EQ(1, base.num_live());
+  escaped.reset();
+  EXPECT_EQ(0, base.num_live());
+}
+
+}  // namespace
+}  // namespace tensorflow
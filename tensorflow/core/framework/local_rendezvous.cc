@@ -15,7 +15,9 @@ limitations under the License.
 
 #include "tensorflow/core/framework/local_rendezvous.h"
 
+#include <atomic>
 #include <memory>
+#include <new>
 #include <string>
 #include <utility>
 
@@ -138,16 +140,46 @@ LocalRendezvous::~LocalRendezvous() {
   if (table_not_empty) {
     DoAbort(absl::CancelledError("LocalRendezvous deleted"));
   }
+  for (int i = 0; i < num_buckets_; ++i) {
+    auto& bucket = table_buckets_[i];
+    mutex_lock l(bucket.mu);
+    while (bucket.free_items != nullptr) {
+      FreeItem* free_item = bucket.free_items;
+      bucket.free_items = free_item->next;
+      ::operator delete(free_item);
+    }
+  }
 }
 
 namespace {
-uint64 KeyHash(const StringPiece& k) { return Hash64(k.data(), k.size()); }
+// Bounds the storage kept by a bucket after a burst of pending items.
+constexpr int kMaxFreeItemsPerBucket = 64;
 }  // namespace
 
+void* LocalRendezvous::AllocateItemLocked(TableBucket& bucket) {
+  static_assert(sizeof(Item) >= sizeof(FreeItem));
+  if (bucket.free_items == nullptr) return ::operator new(sizeof(Item));
+  FreeItem* free_item = bucket.free_items;
+  bucket.free_items = free_item->next;
+  --bucket.num_free_items;
+  return free_item;
+}
+
+void LocalRendezvous::RecycleItemLocked(TableBucket& bucket, void* storage) {
+  // Items are also deleted with `delete`, which works for the storage from
+  // ::operator new(sizeof(Item)).
+  if (bucket.num_free_items >= kMaxFreeItemsPerBucket) {
+    ::operator delete(storage);
+    return;
+  }
+  bucket.free_items = new (storage) FreeItem{bucket.free_items};
+  ++bucket.num_free_items;
+}
+
 Status LocalRendezvous::Send(const Rendezvous::ParsedKey& key,
                              const Rendezvous::Args& send_args,
                              const Tensor& val, const bool is_dead) {
-  uint64 key_hash = KeyHash(key.FullKey());
+  uint64 key_hash = key.hash();
   DVLOG(2) << "Send " << this << " " << key_hash << " " << key.FullKey();
 
   if (is_dead) {
@@ -160,7 +192,9 @@ Status LocalRendezvous::Send(const Rendezvous::ParsedKey& key,
         ->IncrementBy(1);
   }
 
-  TF_RETURN_IF_ERROR(status());
+  if (TF_PREDICT_FALSE(aborted_.load(std::memory_order_acquire))) {
+    return status();
+  }
 
   int bucket_index = key_hash % num_buckets_;
   auto& bucket = table_buckets_[bucket_index];
@@ -188,8 +222,9 @@ Status LocalRendezvous::Send(const Rendezvous::ParsedKey& key,
               });
         },
         /*level=*/1);
-    queue->push_back(new Item(std::move(rc_owner), send_args, val, is_dead,
-                              std::move(activity_scope)));
+    queue->push_back(new (AllocateItemLocked(bucket)) Item(
+        std::move(rc_owner), send_args, val, is_dead,
+        std::move(activity_scope)));
     bucket.mu.unlock();
     return absl::OkStatus();
   }
@@ -212,29 +247,30 @@ Status LocalRendezvous::Send(const Rendezvous::ParsedKey& key,
   DCHECK_EQ(item->type, Item::kRecv);
   (*item->recv_state.waiter)(absl::OkStatus(), send_args, item->args, val,
                              is_dead);
+  // Release the owner at last since it may unref and destruct the rendezvous.
+  tsl::core::RefCountPtr<Rendezvous> rc_owner = std::move(item->rc_owner);
+  item->~Item();
   {
     mutex_lock l(bucket.mu);
+    RecycleItemLocked(bucket, item);
     bucket.pending_callback_counter--;
     if (bucket.pending_callback_counter == 0) {
       bucket.pending_callback_cond_var.notify_all();
     }
   }
-  // Delete the item at last since it may unref and destruct the rendezvous.
-  delete item;
   return absl::OkStatus();
 }
 
 void LocalRendezvous::RecvAsync(const Rendezvous::ParsedKey& key,
                                 const Rendezvous::Args& recv_args,
                                 Rendezvous::DoneCallback done) {
-  uint64 key_hash = KeyHash(key.FullKey());
+  uint64 key_hash = key.hash();
   DVLOG(2) << "Recv " << this << " " << key_hash << " " << key.FullKey();
   tsl::core::RefCountPtr<Rendezvous> rc_keep_alive;
 
-  auto s = status();
-  if (!s.ok()) {
+  if (TF_PREDICT_FALSE(aborted_.load(std::memory_order_acquire))) {
     // Rendezvous has been aborted.
-    done(s, Rendezvous::Args(), recv_args, Tensor(), false);
+    done(status(), Rendezvous::Args(), recv_args, Tensor(), false);
     return;
   }
 
@@ -327,7 +363,7 @@ void LocalRendezvous::RecvAsync(const Rendezvous::ParsedKey& key,
       // NOTE(mrry): We must wrap `done` with code that deregisters the
       // cancellation callback before calling the `done` callback, because the
       // cancellation manager may no longer be live after `done` is called.
-      queue->push_back(new Item(
+      queue->push_back(new (AllocateItemLocked(bucket)) Item(
           std::move(rc_owner), recv_args,
           [this, cm, token, done = std::move(done)](
               const Status& s, const Rendezvous::Args& send_args,
@@ -343,7 +379,8 @@ void LocalRendezvous::RecvAsync(const Rendezvous::ParsedKey& key,
           },
           token, std::move(activity_scope)));
     } else {
-      queue->push_back(new Item(std::move(rc_owner), recv_args, std::move(done),
+      queue->push_back(new (AllocateItemLocked(bucket))
+                           Item(std::move(rc_owner), recv_args, std::move(done),
                                 token, std::move(activity_scope)));
     }
 
@@ -370,15 +407,17 @@ void LocalRendezvous::RecvAsync(const Rendezvous::ParsedKey& key,
   DCHECK_EQ(item->type, Item::kSend);
   done(absl::OkStatus(), item->args, recv_args, *item->send_state.value,
        item->send_state.is_dead);
+  // Release the owner at last since it may unref and destruct the rendezvous.
+  tsl::core::RefCountPtr<Rendezvous> rc_owner = std::move(item->rc_owner);
+  item->~Item();
   {
     mutex_lock l(bucket.mu);
+    RecycleItemLocked(bucket, item);
     bucket.pending_callback_counter--;
     if (bucket.pending_callback_counter == 0) {
       bucket.pending_callback_cond_var.notify_all();
     }
   }
-  // Delete the item at last since it may unref and destruct the rendezvous.
-  delete item;
 }
 
 mutex& LocalRendezvous::aborted_rendezs_mu_ = *new mutex();
@@ -402,6 +441,7 @@ void LocalRendezvous::DoAbort(const Status& status) {
     mutex_lock l(mu_);
     status_.Update(status);
   }
+  aborted_.store(true, std::memory_order_release);
   LOG_EVERY_POW_2(INFO) << "Local rendezvous is aborting with status: "
                         << status;
 
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_FRAMEWORK_LOCAL_RENDEZVOUS_H_
 #define TENSORFLOW_CORE_FRAMEWORK_LOCAL_RENDEZVOUS_H_
 
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -89,19 +90,40 @@ class LocalRendezvous {
   // nullptr otherwise.
   Rendezvous* rc_owner_;
 
+  // Storage of a destroyed Item, kept for reuse by later items of the bucket.
+  struct FreeItem {
+    FreeItem* next;
+  };
+
   struct TableBucket {
     mutex mu;
     Table table TF_GUARDED_BY(mu);
 
+    // The storage of a rendezvous serving a single step is reused by the
+    // items of later edges of the step, instead of allocating an Item for
+    // each send or recv.
+    FreeItem* free_items TF_GUARDED_BY(mu) = nullptr;
+    int num_free_items TF_GUARDED_BY(mu) = 0;
+
     // Track the number of pening callbacks using a counter.
     int pending_callback_counter TF_GUARDED_BY(mu) = 0;
     condition_variable pending_callback_cond_var TF_GUARDED_BY(mu);
   };
 
+  // Returns the storage for an Item, reused from `bucket` if possible.
+  static void* AllocateItemLocked(TableBucket& bucket)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(bucket.mu);
+  // Keeps the storage of a destroyed Item in `bucket` for reuse.
+  static void RecycleItemLocked(TableBucket& bucket, void* storage)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(bucket.mu);
+
   // Immutable set of buckets. This uses less memory than std::vector.
   const std::unique_ptr<TableBucket[]> table_buckets_;
   mutex mu_;
   absl::Status status_ TF_GUARDED_BY(mu_);
+  // Set once `status_` is not OK, so that Send and RecvAsync don't take `mu_`
+  // to check the status.
+  std::atomic<bool> aborted_{false};
 
   // We deliberately leak one reference of the aborted rendezvous here, so that
   // they won't be destructed, and lose the status_.
@@ -63,6 +63,24 @@ auto* graph_pending_queue_length_histogram = tsl::monitoring::Sampler<0>::New(
     // Power of 1.5 with bucket count 30 (> 191k)
     {tsl::monitoring::Buckets::Exponential(1, 1.5, 30)});
 
+auto* graph_node_queueing_delay_usecs_histogram =
+    tsl::monitoring::Sampler<1>::New(
+        {"/tensorflow/core/graph_node_queueing_delay_usecs_histogram",
+         "The time in microseconds between a graph node becoming ready and an "
+         "executor thread starting to process it.",
+         "session"},
+        // Power of 2 with bucket count 24 (> 8 seconds)
+        {tsl::monitoring::Buckets::Exponential(1, 2, 24)});
+
+auto* graph_node_compute_time_usecs_histogram =
+    tsl::monitoring::Sampler<1>::New(
+        {"/tensorflow/core/graph_node_compute_time_usecs_histogram",
+         "The time in microseconds between an executor thread starting to "
+         "process a graph node and the node's computation finishing.",
+         "session"},
+        // Power of 2 with bucket count 24 (> 8 seconds)
+        {tsl::monitoring::Buckets::Exponential(1, 2, 24)});
+
 auto* graph_run_input_tensor_bytes = tsl::monitoring::Sampler<0>::New(
     {"/tensorflow/core/graph_run_input_tensor_bytes",
      "The size of input tensors in bytes."},
@@ -305,6 +323,20 @@ auto* tf_data_pipeline_processing_time = tsl::monitoring::Gauge<double, 1>::New(
     "in microseconds",
     "id");
 
+auto* tf_data_bottleneck_node = tsl::monitoring::Gauge<std::string, 1>::New(
+    "/tensorflow/data/bottleneck_node",
+    "The node with the largest self time in the slowest stage of the input "
+    "pipeline.",
+    "id");
+
+auto* tf_data_bottleneck_stats = tsl::monitoring::Gauge<double, 2>::New(
+    "/tensorflow/data/bottleneck_stats",
+    "Statistics of the bottleneck of the input pipeline: the fraction of the "
+    "bottleneck node's time spent waiting for its inputs (input_time_ratio) "
+    "and the utilization of the buffer of the slowest stage "
+    "(buffer_utilization).",
+    "id", "name");
+
 auto* tf_data_auto_shard = tsl::monitoring::Gauge<int64, 2>::New(
     "/tensorflow/data/autoshard", "tf.data autoshard statistics.", "id",
     "name");
@@ -815,6 +847,16 @@ void UpdateGraphPendingQueueLength(uint64 len) {
   graph_pending_queue_length_cell->Add(len);
 }
 
+tsl::monitoring::SamplerCell* GetGraphNodeQueueingDelayUsecsSampler(
+    const string& session_name) {
+  return graph_node_queueing_delay_usecs_histogram->GetCell(session_name);
+}
+
+tsl::monitoring::SamplerCell* GetGraphNodeComputeTimeUsecsSampler(
+    const string& session_name) {
+  return graph_node_compute_time_usecs_histogram->GetCell(session_name);
+}
+
 void UpdateGraphBuildTime(const uint64 running_time_usecs) {
   if (running_time_usecs > 0) {
     static auto* build_graph_calls_cell = build_graph_calls->GetCell();
@@ -930,6 +972,16 @@ void RecordPipelineProcessingTime(const string& id,
   GetTFDataPipelineProcessingTimeGauge(id)->Set(pipeline_processing_time_usec);
 }
 
+void RecordTFDataBottleneck(const string& id, const string& node_name,
+                            double input_time_ratio,
+                            double buffer_utilization) {
+  tf_data_bottleneck_node->GetCell(id)->Set(node_name);
+  tf_data_bottleneck_stats->GetCell(id, "input_time_ratio")
+      ->Set(input_time_ratio);
+  tf_data_bottleneck_stats->GetCell(id, "buffer_utilization")
+      ->Set(buffer_utilization);
+}
+
 void IncrementTestCounter(const string& name, const string& label) {
   test_counters->GetCell(name, label)->IncrementBy(1);
 }
@@ -22,6 +22,7 @@ limitations under the License.
 #include "tensorflow/core/framework/dataset_options.pb.h"
 #include "tensorflow/core/lib/monitoring/counter.h"
 #include "tensorflow/core/lib/monitoring/gauge.h"
+#include "tensorflow/core/lib/monitoring/sampler.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/statusor.h"
 #include "tensorflow/core/platform/types.h"
@@ -269,6 +270,20 @@ void RecordTPUXlaSpmdCoresPerReplica(int64_t cores_per_replica);
 void UpdateGraphExecTime(const uint64 running_time_usecs);
 void UpdateGraphPendingQueueLength(uint64 len);
 
+// Returns a sampler that records the time in microseconds between a graph node
+// becoming ready and an executor thread starting to process it.
+//
+// The `session_name` argument identifies the session that runs the graph.
+monitoring::SamplerCell* GetGraphNodeQueueingDelayUsecsSampler(
+    const string& session_name);
+
+// Returns a sampler that records the time in microseconds between an executor
+// thread starting to process a graph node and the node's computation finishing.
+//
+// The `session_name` argument identifies the session that runs the graph.
+monitoring::SamplerCell* GetGraphNodeComputeTimeUsecsSampler(
+    const string& session_name);
+
 // Records that one output of an op of type `op_name` was unused.
 void RecordUnusedOutput(const string& op_name);
 
@@ -276,6 +291,14 @@ void RecordUnusedOutput(const string& op_name);
 void RecordPipelineProcessingTime(const string& id,
                                   double pipeline_processing_time_usec);
 
+// Records the bottleneck of the input pipeline identified by `id`: the name of
+// the node with the largest self time in the slowest stage, the fraction of
+// that node's time spent waiting for its inputs, and the utilization of the
+// buffer of the slowest stage (-1 if the stage has no buffer).
+void RecordTFDataBottleneck(const string& id, const string& node_name,
+                            double input_time_ratio,
+                            double buffer_utilization);
+
 // Increments the count of binaries loaded from the persistent cache.
 void UpdatePersistentCacheLoadCount();
 
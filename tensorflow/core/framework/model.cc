@@ -2297,6 +2297,7 @@ Model::~Model() {
   safe_to_collect_metrics_->val = false;
   // Reset the pipeline processing time to 0
   metrics::RecordPipelineProcessingTime(model_id_, 0);
+  metrics::RecordTFDataBottleneck(model_id_, "", 0, -1);
 }
 
 void Model::AddNode(Node::Factory factory, const string& name,
@@ -2420,6 +2421,7 @@ void Model::Optimize(AutotuneAlgorithm algorithm,
 
     if (snapshot_) {
       double pipeline_processing_usec = 0;
+      std::shared_ptr<Node> slowest_stage_root;
       ModelTiming model_timing(snapshot_);
       auto bfs_stage_roots = model_timing.GetStageRoots();
       for (const auto& root : bfs_stage_roots) {
@@ -2431,6 +2433,7 @@ void Model::Optimize(AutotuneAlgorithm algorithm,
                  "time for "
                  "/tensorflow/data/pipeline_processing_time";
           pipeline_processing_usec = 0;
+          slowest_stage_root = nullptr;
           break;
         }
 
@@ -2438,8 +2441,10 @@ void Model::Optimize(AutotuneAlgorithm algorithm,
                                       root_timing->pipeline_ratio /
                                       EnvTime::kMicrosToNanos;
 
-        pipeline_processing_usec =
-            std::max(pipeline_processing_usec, root_total_time_usec);
+        if (root_total_time_usec > pipeline_processing_usec) {
+          pipeline_processing_usec = root_total_time_usec;
+          slowest_stage_root = root;
+        }
       }
       // Only updates the pipeline processing time when it is greater than 0.
       // If it is zero, we assume the pipeline processing time is the same
@@ -2447,6 +2452,9 @@ void Model::Optimize(AutotuneAlgorithm algorithm,
       if (pipeline_processing_usec > 0) {
         metrics::RecordPipelineProcessingTime(model_id_,
                                               pipeline_processing_usec);
+        if (slowest_stage_root != nullptr) {
+          RecordBottleneck(model_timing, slowest_stage_root);
+        }
       }
     }
   }
@@ -2803,6 +2811,48 @@ double Model::ComputeExperimentalTargetTimeNsec() {
          1.0e3;
 }
 
+void Model::RecordBottleneck(const ModelTiming& model_timing,
+                             std::shared_ptr<Node> stage_root) {
+  // The bottleneck is the node of the slowest stage that contributes the most
+  // self time to producing an element at the root of the pipeline.
+  std::vector<std::shared_ptr<Node>> stage_nodes =
+      model_timing.GetStageNodes(stage_root);
+  stage_nodes.push_back(stage_root);
+  const Node* bottleneck = nullptr;
+  const ModelTiming::NodeTiming* bottleneck_timing = nullptr;
+  for (const auto& node : stage_nodes) {
+    const ModelTiming::NodeTiming* timing = model_timing.GetTiming(node.get());
+    if (timing == nullptr) continue;
+    if (bottleneck_timing == nullptr ||
+        timing->self_time_nsec > bottleneck_timing->self_time_nsec) {
+      bottleneck = node.get();
+      bottleneck_timing = timing;
+    }
+  }
+  if (bottleneck == nullptr || bottleneck_timing->total_time_nsec <= 0) {
+    return;
+  }
+  // The fraction of the bottleneck's time that is spent waiting for its
+  // inputs. A ratio close to 1 means the node is mostly input-bound.
+  const double input_time_ratio =
+      (bottleneck_timing->total_time_nsec - bottleneck_timing->self_time_nsec) /
+      bottleneck_timing->total_time_nsec;
+  // The utilization of the buffer that the slowest stage produces into. A
+  // mostly empty buffer means the consumer is waiting on this stage.
+  double buffer_utilization = -1.0;
+  for (const char* capacity_parameter : {kBufferSize, kParallelism}) {
+    absl::StatusOr<double> capacity =
+        stage_root->ParameterValue(capacity_parameter);
+    if (capacity.ok() && *capacity > 0) {
+      buffer_utilization =
+          static_cast<double>(stage_root->buffered_elements()) / *capacity;
+      break;
+    }
+  }
+  metrics::RecordTFDataBottleneck(model_id_, bottleneck->long_name(),
+                                  input_time_ratio, buffer_utilization);
+}
+
 double Model::ComputeSnapshotProcessingTimeNsec() const {
   std::unique_ptr<ModelTiming> model_timing = nullptr;
   {
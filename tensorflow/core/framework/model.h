@@ -178,10 +178,15 @@ class RamBudgetManager {
   //   ApplyModel(potential_new_params);
   // }
   //
+  // Requests that do not grow the current allocation always succeed, so that
+  // the model can shrink its buffers after the budget has been reduced below
+  // what is already allocated.
+  //
   // Returns whether the request succeeded.
   bool RequestModelAllocation(int64_t total_bytes) {
     mutex_lock l(mu_);
-    if (total_bytes > budget_ - legacy_prefetch_allocated_) {
+    if (total_bytes > model_allocated_ &&
+        total_bytes > budget_ - legacy_prefetch_allocated_) {
       return false;
     }
     model_allocated_ = total_bytes;
@@ -929,6 +934,8 @@ std::shared_ptr<Node> MakeUnknownNode(Node::Args args);
 // The order of locks acquired is SharedState lock, Model lock, Node lock.
 // SharedState lock is acquired first because it shares the same lock as the
 // dataset iterator that contains it.
+class ModelTiming;
+
 class Model {
  public:
   using OptimizationParams = ModelProto::OptimizationParams;
@@ -1061,6 +1068,11 @@ class Model {
   // increase mutex contention with `GetNext()`.
   void MaybeSyncStateValuesToValues(std::shared_ptr<Node> snapshot);
 
+  // Exports the bottleneck of the stage rooted at `stage_root`, which is the
+  // slowest stage of the pipeline, to the tf.data monitoring metrics.
+  void RecordBottleneck(const ModelTiming& model_timing,
+                        std::shared_ptr<Node> stage_root);
+
   // Downsizes buffers that are too large for all nodes rooted at `snapshot`.
   // Returns true if any buffer is downsized.
   bool DownsizeBuffers(std::shared_ptr<Node> snapshot);
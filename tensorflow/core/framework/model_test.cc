@@ -1457,6 +1457,30 @@ TEST(ModelTest, ModelCollectOptimizationMetrics) {
             HasSubstr("gap_times: 11"), HasSubstr("gap_times: 12")));
 }
 
+TEST(ModelTest, ModelRecordsBottleneck) {
+  CellReader<std::string> node_reader("/tensorflow/data/bottleneck_node");
+  CellReader<double> stats_reader("/tensorflow/data/bottleneck_stats");
+  model::Model model;
+  std::shared_ptr<Node> root = model::MakeUnknownNode({0, "unknown0", nullptr});
+  model.AddNode([&root](model::Node::Args args) { return root; }, root->name(),
+                nullptr, &root);
+  model.output()->record_element();
+  model.output()->record_start(100);
+  model.output()->record_stop(200);
+  std::string model_id = strings::StrCat(reinterpret_cast<uintptr_t>(&model));
+  CancellationManager cancellation_manager;
+  RamBudgetManager ram_budget_manager(0);
+  model.Optimize(AutotuneAlgorithm::STAGE_BASED, CpuBudgetFunc(40),
+                 /*ram_budget_share=*/1.0,
+                 /*fixed_ram_budget=*/1000,
+                 /*model_input_time=*/50, ram_budget_manager,
+                 &cancellation_manager);
+  EXPECT_EQ(node_reader.Read(model_id), "unknown0(id:0)");
+  // The node has no inputs and no buffer.
+  EXPECT_EQ(stats_reader.Read(model_id, "input_time_ratio"), 0.0);
+  EXPECT_EQ(stats_reader.Read(model_id, "buffer_utilization"), -1.0);
+}
+
 TEST(ModelTest, ModelCollectAndDestroyRaceCondition) {
   CellReader<std::string> cell_reader("/tensorflow/data/model");
   auto* model = new model::Model();
@@ -3574,6 +3598,20 @@ TEST(RamBudgetManagerTest, RequestAllocationsWithBudgetAdjustment) {
   EXPECT_TRUE(rbm.RequestLegacyPrefetchBytes(4));
 }
 
+TEST(RamBudgetManagerTest, ShrinkingAllocationSucceedsAfterBudgetReduction) {
+  RamBudgetManager rbm(10);
+  EXPECT_TRUE(rbm.RequestModelAllocation(10));
+  // Available RAM dropped below what the model already holds.
+  rbm.UpdateBudget(4);
+  // Growing is still rejected.
+  EXPECT_FALSE(rbm.RequestModelAllocation(11));
+  // Shrinking is accepted even though 6 > 4, so the model can release memory.
+  EXPECT_TRUE(rbm.RequestModelAllocation(6));
+  EXPECT_FALSE(rbm.RequestModelAllocation(7));
+  EXPECT_TRUE(rbm.RequestModelAllocation(4));
+  EXPECT_EQ(rbm.AvailableModelRam(), 4);
+}
+
 TEST(NodeTest, OnlyCollectParametersThatHaveElementsProduced) {
   // Builds a graph:
   // root <- parallel_map <- parallel_interleave
@@ -30,6 +30,7 @@ limitations under the License.
 #include "tensorflow/core/framework/allocation_description.pb.h"
 #include "tensorflow/core/framework/attr_value.pb.h"
 #include "tensorflow/core/framework/attr_value_util.h"
+#include "tensorflow/core/framework/cross_step_buffer_cache.h"
 #include "tensorflow/core/framework/device_attributes.pb.h"
 #include "tensorflow/core/framework/device_factory.h"
 #include "tensorflow/core/framework/graph.pb.h"
@@ -381,6 +382,9 @@ Allocator* OpKernelContext::get_allocator(AllocatorAttributes attr) {
     CHECK(allocator);
   } else {
     allocator = params_->device->GetAllocator(attr);
+    if (TF_PREDICT_FALSE(params_->buffer_cache != nullptr)) {
+      allocator = params_->buffer_cache->Wrap(allocator);
+    }
   }
   if (TF_PREDICT_FALSE(track_allocations())) {
     DCHECK(tracking_state_);
@@ -524,6 +528,35 @@ std::unique_ptr<Tensor> OpKernelContext::forward_input(
     int input_index, int output_index, DataType output_dtype,
     const TensorShape& output_shape, MemoryType output_memory_type,
     const AllocatorAttributes& output_attr) {
+  return forward_input_internal(input_index, output_index, output_dtype,
+                                output_shape, output_memory_type, output_attr,
+                                /*allow_aliased_inputs=*/false);
+}
+
+bool OpKernelContext::input_buffer_only_held_by_inputs(int input_index) const {
+  const Tensor& input = *params_->inputs[input_index].tensor;
+  int num_holders = 0;
+  for (int i = 0; i < num_inputs(); ++i) {
+    const TensorValue& value = params_->inputs[i];
+    if (value.tensor == nullptr || !value.tensor->SharesBufferWith(input)) {
+      continue;
+    }
+    // A ref input means a variable holds the buffer, and an input holding a
+    // different view of the buffer may be read at other positions.
+    if (value.is_ref() || value.tensor->data() != input.data() ||
+        value.tensor->dtype() != input.dtype() ||
+        value.tensor->NumElements() != input.NumElements()) {
+      return false;
+    }
+    ++num_holders;
+  }
+  return input.RefCountIs(num_holders);
+}
+
+std::unique_ptr<Tensor> OpKernelContext::forward_input_internal(
+    int input_index, int output_index, DataType output_dtype,
+    const TensorShape& output_shape, MemoryType output_memory_type,
+    const AllocatorAttributes& output_attr, bool allow_aliased_inputs) {
   CHECK_GE(input_index, 0);
   CHECK_LT(input_index, num_inputs());
   const TensorValue& input = params_->inputs[input_index];
@@ -570,7 +603,9 @@ std::unique_ptr<Tensor> OpKernelContext::forward_input(
     return nullptr;
   }
   if (!forward_expected) {
-    if (!input->RefCountIsOne()) {
+    if (!input->RefCountIsOne() &&
+        !(allow_aliased_inputs &&
+          input_buffer_only_held_by_inputs(input_index))) {
       return nullptr;
     }
     // Check that output allocator attributes are not more restrictive than
@@ -622,6 +657,27 @@ Status OpKernelContext::forward_input_or_allocate_output(
   return allocate_output(output_index, output_shape, output);
 }
 
+Status OpKernelContext::forward_elementwise_input_or_allocate_output(
+    absl::Span<const int> candidate_input_indices, int output_index,
+    const TensorShape& output_shape, Tensor** output) {
+  const auto output_attr = params_->output_attr_array == nullptr
+                               ? AllocatorAttributes()
+                               : output_alloc_attr(output_index);
+  for (int input_index : candidate_input_indices) {
+    std::unique_ptr<Tensor> new_tensor = forward_input_internal(
+        input_index, output_index, expected_output_dtype(output_index),
+        output_shape, output_memory_type(output_index), output_attr,
+        /*allow_aliased_inputs=*/true);
+    if (new_tensor != nullptr) {
+      // Transfer ownership to the output slot in OpKernelContext.
+      outputs_[output_index] = TensorValue(new_tensor.release());
+      *output = outputs_[output_index].tensor;
+      return absl::OkStatus();
+    }
+  }
+  return allocate_output(output_index, output_shape, output);
+}
+
 Status OpKernelContext::forward_input_or_allocate_output(
     absl::Span<const StringPiece> candidate_input_names,
     StringPiece output_name, const TensorShape& output_shape, Tensor** output) {
@@ -86,6 +86,7 @@ class TensorSliceReaderCacheWrapper;
 
 class AsyncOpKernel;
 class CallFrameInterface;
+class CrossStepBufferCache;
 class DeviceMgr;
 class FunctionLibraryRuntime;
 class OpKernelConstruction;  // declared below
@@ -624,6 +625,10 @@ class OpKernelContext {
     bool track_allocations = false;
     bool log_memory = false;
 
+    // If not null, non-scoped allocations are served from the buffers that
+    // were released in earlier steps of the same graph.
+    CrossStepBufferCache* buffer_cache = nullptr;
+
     // Array indexed by output number for this node
     const AllocatorAttributes* output_attr_array = nullptr;
 
@@ -916,6 +921,16 @@ class OpKernelContext {
       StringPiece output_name, const TensorShape& output_shape,
       Tensor** output) TF_MUST_USE_RESULT;
 
+  // Like forward_input_or_allocate_output(), for kernels that compute every
+  // element of the output only from the elements at the same position in
+  // their inputs. Such kernels can also safely write into a buffer that is
+  // passed to them in several inputs, e.g. for `Mul(x, x)`, so an input is
+  // forwarded if all the references to its buffer are held by inputs of this
+  // kernel rather than only if the refcount is one.
+  absl::Status forward_elementwise_input_or_allocate_output(
+      absl::Span<const int> candidate_input_indices, int output_index,
+      const TensorShape& output_shape, Tensor** output) TF_MUST_USE_RESULT;
+
   // Tries to reuse one of the inputs given in input_indices as a temporary.
   // If none of the given inputs can be forwarded, calls
   // allocate_temp() to allocate a new temporary buffer.
@@ -1289,6 +1304,18 @@ class OpKernelContext {
                                AllocatorAttributes allocator_attr,
                                const AllocationAttributes& allocation_attr);
 
+  // Implements forward_input(). If `allow_aliased_inputs` is true, the input
+  // may also be forwarded when its buffer is only referenced by inputs of this
+  // kernel.
+  std::unique_ptr<Tensor> forward_input_internal(
+      int input_index, int output_index, DataType output_dtype,
+      const TensorShape& output_shape, MemoryType output_memory_type,
+      const AllocatorAttributes& output_attr, bool allow_aliased_inputs);
+
+  // Returns true if every reference to the buffer of input `input_index` is
+  // held by an input of this kernel that has the same type and shape.
+  bool input_buffer_only_held_by_inputs(int input_index) const;
+
   // Helpers for `set_output()`.
 
   // Returns `true` if the tensor was copied into an allocated output.
@@ -57,6 +57,13 @@ REGISTER_OP("Test1").Input("a: float").Input("b: int32").Output("o: uint8");
 REGISTER_KERNEL_BUILDER(Name("Test1").Device(tensorflow::DEVICE_CPU),
                         DummyKernel);
 
+REGISTER_OP("ElementwiseTest")
+    .Input("a: float")
+    .Input("b: float")
+    .Output("o: float");
+REGISTER_KERNEL_BUILDER(Name("ElementwiseTest").Device(tensorflow::DEVICE_CPU),
+                        DummyKernel);
+
 namespace foo {
 bool match_signature_ = false;
 
@@ -533,6 +540,52 @@ TEST_F(OpKernelTest, AllocateOutput) {
   EXPECT_THAT(s.message(), ::testing::ContainsRegex("bad index=1"));
 }
 
+TEST_F(OpKernelTest, ForwardElementwiseAliasedInputs) {
+  Env* env = Env::Default();
+  OpKernelContext::Params params;
+  DummyDevice device(env);
+  params.device = &device;
+  Status status;
+  std::unique_ptr<OpKernel> op(
+      CreateOpKernel(DEVICE_CPU, params.device, cpu_allocator(),
+                     CreateNodeDef("ElementwiseTest", {DT_FLOAT, DT_FLOAT}),
+                     TF_GRAPH_DEF_VERSION, &status));
+  TF_ASSERT_OK(status);
+  params.op_kernel = op.get();
+  const TensorShape shape({4});
+
+  {
+    // Both references to the buffer are inputs of the kernel.
+    Tensor a(DT_FLOAT, shape);
+    Tensor a_alias = a;
+    absl::InlinedVector<TensorValue, 4> inputs{TensorValue(&a),
+                                               TensorValue(&a_alias)};
+    params.inputs = inputs;
+    auto ctx = std::make_unique<OpKernelContext>(&params);
+    EXPECT_EQ(nullptr, ctx->forward_input(0, 0, DT_FLOAT, shape, DEVICE_MEMORY,
+                                          AllocatorAttributes()));
+    Tensor* output = nullptr;
+    TF_ASSERT_OK(ctx->forward_elementwise_input_or_allocate_output(
+        {0, 1}, 0, shape, &output));
+    EXPECT_EQ(a.data(), output->data());
+  }
+
+  {
+    // The buffer is also referenced from outside the kernel.
+    Tensor a(DT_FLOAT, shape);
+    Tensor a_alias = a;
+    Tensor a_elsewhere = a;
+    absl::InlinedVector<TensorValue, 4> inputs{TensorValue(&a),
+                                               TensorValue(&a_alias)};
+    params.inputs = inputs;
+    auto ctx = std::make_unique<OpKernelContext>(&params);
+    Tensor* output = nullptr;
+    TF_ASSERT_OK(ctx->forward_elementwise_input_or_allocate_output(
+        {0, 1}, 0, shape, &output));
+    EXPECT_NE(a.data(), output->data());
+  }
+}
+
 // A mock device that mimics the behavior of scoped allocator upon calling
 // GetAllocator with a positive scope_id.
 class ScopedAllocatorDevice : public DeviceBase {
@@ -62,6 +62,17 @@ Status GetBroadcastSize(const int index, const int in_size, const int ksize,
   return absl::OkStatus();
 }
 
+bool LeadingDimsAreOne(const TensorShape& s, int dim,
+                       TensorShape* trailing_shape) {
+  for (int i = 0; i < dim; ++i) {
+    if (s.dim_size(i) != 1) return false;
+  }
+  for (int i = dim; i < s.dims(); ++i) {
+    trailing_shape->AddDim(s.dim_size(i));
+  }
+  return true;
+}
+
 string SanitizeThreadSuffix(string suffix) {
   string clean;
   for (int i = 0; i < suffix.size(); ++i) {
@@ -81,6 +81,13 @@ bool IsDim0SliceAligned(const TensorShape& s, int64_t start,
   }
 }
 
+// Given a shape 's', returns true iff all the dimensions before 'dim' have
+// size 1, and then sets 'trailing_shape' to the dimensions of 's' from 'dim'
+// on. A slice of dimension 'dim' of such a tensor is then laid out like a dim
+// 0 slice of a tensor of shape 'trailing_shape'.
+bool LeadingDimsAreOne(const TensorShape& s, int dim,
+                       TensorShape* trailing_shape);
+
 // Returns <suffix> sanitized to have only [a-zA-Z0-9-_].
 std::string SanitizeThreadSuffix(std::string suffix);
 
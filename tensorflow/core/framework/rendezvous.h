@@ -70,12 +70,16 @@ class RendezvousInterface {
 
     ParsedKey& operator=(const ParsedKey& b);
     StringPiece FullKey() const { return buf_; }
+    // Hash64 of FullKey(), computed once by ParseKey. The send and recv
+    // kernels parse their top-level keys at construction.
+    uint64 hash() const { return hash_; }
 
    private:
     friend class Rendezvous;
     friend class SendOp;
     friend class RecvOp;
     std::string buf_;
+    uint64 hash_ = 0;
   };
 
   // The caller is a tensor producer and it sends a message (a tensor
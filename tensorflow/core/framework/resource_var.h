@@ -110,6 +110,15 @@ class Var : public ResourceBase {
   // so desired.
   std::atomic<bool> copy_on_read_mode{false};
 
+  // Set by the _EnableVariableHogwildMode op. On CPU, training ops that don't
+  // request locking then update the variable in place without taking its
+  // mutex and without ever copying its buffer, and sparse updates don't put
+  // it in copy-on-read mode. Concurrent updates may then be lost or interleave
+  // element-wise, and reads that alias the buffer observe later updates. The
+  // accesses stay memory safe: each op holds a reference to the buffer it
+  // updates, even if the variable is assigned a new one concurrently.
+  std::atomic<bool> hogwild_mode{false};
+
  private:
   mutex mu_;
   Tensor tensor_;
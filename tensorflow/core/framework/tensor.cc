@@ -906,6 +906,11 @@ bool Tensor::RefCountIsOne() const {
          buf_->root_buffer()->RefCountIsOne() && buf_->OwnsMemory();
 }
 
+bool Tensor::RefCountIs(int count) const {
+  return buf_ != nullptr && buf_->root_buffer() == buf_ &&
+         buf_->OwnsMemory() && buf_->RefCount() == count;
+}
+
 int Tensor::RefCount() const {
   if (buf_->root_buffer() != buf_) {
     LOG(ERROR) << "Tensor RefCount not reliable if buf_ points to a SubBuffer.";
@@ -678,6 +678,11 @@ class Tensor {
   // TensorBuffer. If buf_ points to a SubBuffer, returns -1.
   int RefCount() const;
 
+  // Returns true if buf_ points to a regular TensorBuffer that owns its memory
+  // and has exactly `count` references. Used to detect buffers whose only
+  // references are known to the caller.
+  bool RefCountIs(int count) const;
+
   // Returns the type of the underlying memory.
   AllocatorMemoryType GetMemoryType() const { return buf_->GetMemoryType(); }
 
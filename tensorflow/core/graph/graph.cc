@@ -547,17 +547,21 @@ Node* Graph::AddNode(NodeDef node_def, absl::Status* status) {
   const OpRegistrationData* op_reg_data;
   status->Update(ops_.LookUp(node_def.op(), &op_reg_data));
   if (!status->ok()) return nullptr;
+  return AddNode(std::move(node_def), *op_reg_data, status);
+}
 
+Node* Graph::AddNode(NodeDef node_def, const OpRegistrationData& op_reg_data,
+                     absl::Status* status) {
   DataTypeVector inputs;
   DataTypeVector outputs;
   status->Update(
-      InOutTypesForNode(node_def, op_reg_data->op_def, &inputs, &outputs));
+      InOutTypesForNode(node_def, op_reg_data.op_def, &inputs, &outputs));
   if (!status->ok()) {
     *status = AttachDef(*status, node_def);
     return nullptr;
   }
 
-  Node::NodeClass node_class = op_reg_data->is_function_op
+  Node::NodeClass node_class = op_reg_data.is_function_op
                                    ? Node::NC_FUNCTION_OP
                                    : Node::GetNodeClassForOp(node_def.op());
 
@@ -565,10 +569,10 @@ Node* Graph::AddNode(NodeDef node_def, absl::Status* status) {
     VLOG(3) << "AddNode: node has type set, skipping type constructor "
             << node_def.name();
   } else {
-    if (op_reg_data->type_ctor != nullptr) {
+    if (op_reg_data.type_ctor != nullptr) {
       VLOG(3) << "AddNode: found type constructor for " << node_def.name();
       absl::Status s =
-          full_type::SpecializeType(AttrSlice(node_def), op_reg_data->op_def,
+          full_type::SpecializeType(AttrSlice(node_def), op_reg_data.op_def,
                                     *(node_def.mutable_experimental_type()));
       if (!s.ok()) {
         *status = errors::InvalidArgument("type error: ", s.ToString());
@@ -582,7 +586,7 @@ Node* Graph::AddNode(NodeDef node_def, absl::Status* status) {
   }
 
   Node* node = AllocateNode(
-      std::make_shared<NodeProperties>(&op_reg_data->op_def,
+      std::make_shared<NodeProperties>(&op_reg_data.op_def,
                                        std::move(node_def), inputs, outputs),
       nullptr, node_class);
   return node;
@@ -563,6 +563,11 @@ class Graph {
   // Returns nullptr and sets *status on error.
   Node* AddNode(NodeDef node_def, absl::Status* status);
 
+  // Same as above, but with the registration data of `node_def.op()` already
+  // looked up in op_registry() by the caller.
+  Node* AddNode(NodeDef node_def, const OpRegistrationData& op_reg_data,
+                absl::Status* status);
+
   // Same as above, but using StatusOr. This method is always preferred.
   absl::StatusOr<Node*> AddNode(NodeDef node_def);
 
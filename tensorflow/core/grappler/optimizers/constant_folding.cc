@@ -18,11 +18,17 @@ limitations under the License.
 #include "tensorflow/core/grappler/optimizers/constant_folding.h"
 
 #include <cmath>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/strings/substitute.h"
+#include "tensorflow/core/common_runtime/constant_folding_cache.h"
 #include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/attr_value.pb.h"
 #include "tensorflow/core/framework/function.pb.h"
@@ -193,21 +199,26 @@ float QuantizedTypeMaxAsFloat(DataType data_type) {
 ConstantFolding::ConstantFolding(RewriterConfig::Toggle opt_level,
                                  DeviceBase* cpu_device,
                                  bool disable_compressed_tensor_optimization,
-                                 bool fold_quantization_emulation)
+                                 bool fold_quantization_emulation,
+                                 int64_t max_constant_size_bytes)
     : opt_level_(opt_level),
       cpu_device_(cpu_device),
       disable_compressed_tensor_optimization_(
           disable_compressed_tensor_optimization),
-      fold_quantization_emulation_(fold_quantization_emulation) {
+      fold_quantization_emulation_(fold_quantization_emulation),
+      max_constant_size_bytes_(max_constant_size_bytes > 0
+                                   ? max_constant_size_bytes
+                                   : kMaxConstantSize) {
   resource_mgr_.reset(new ResourceMgr());
 }
 
 ConstantFolding::ConstantFolding(DeviceBase* cpu_device,
                                  bool disable_compressed_tensor_optimization,
-                                 bool fold_quantization_ops)
+                                 bool fold_quantization_ops,
+                                 int64_t max_constant_size_bytes)
     : ConstantFolding(RewriterConfig::ON, cpu_device,
                       disable_compressed_tensor_optimization,
-                      fold_quantization_ops) {}
+                      fold_quantization_ops, max_constant_size_bytes) {}
 
 // static
 string ConstantFolding::AddControlDependency(const string& input_name,
@@ -1040,7 +1051,8 @@ bool ConstantFolding::IsFoldableUncached(
         if (num_bytes < 0) {  // Overflown
           return false;
         }
-        if (num_bytes > input_size_bytes && num_bytes > kMaxConstantSize) {
+        if (num_bytes > input_size_bytes &&
+            num_bytes > max_constant_size_bytes_) {
           // Do not fold nodes if the in-memory size of output is too large.
           // Notice that this is not exactly the same check used in
           // CreateNodeDef() where the actual encoded size is checked.
@@ -1251,7 +1263,8 @@ bool IsValidConstShapeForMulConvPushDown(
 absl::Status ConstantFolding::CreateNodeDef(const string& name,
                                             const TensorValue& tensor,
                                             NodeDef* node,
-                                            size_t original_size) {
+                                            size_t original_size,
+                                            int64_t max_constant_size) {
   node->set_name(name);
   node->set_op("Const");
 
@@ -1330,10 +1343,10 @@ absl::Status ConstantFolding::CreateNodeDef(const string& name,
   }
   node->mutable_attr()->insert({"value", attr_tensor});
 
-  if (encoded_size > original_size && encoded_size >= kMaxConstantSize) {
+  if (encoded_size > original_size && encoded_size >= max_constant_size) {
     return absl::InvalidArgumentError(
         absl::StrCat("Can't fold ", name, ", its size would be too large (",
-                     encoded_size, " >= ", kMaxConstantSize, " bytes)"));
+                     encoded_size, " >= ", max_constant_size, " bytes)"));
   }
   return absl::OkStatus();
 }
@@ -1399,7 +1412,40 @@ absl::Status ConstantFolding::EvaluateOneFoldable(const NodeDef& node,
     total_inputs_size += value->TotalBytes();
   }
 
-  TF_RETURN_IF_ERROR(EvaluateNode(node, inputs, &output_tensors));
+  // The same computation shows up again when the graph is optimized again,
+  // or in each instantiation of a function.
+  ConstantFoldingCache* cache = ConstantFoldingCache::Global();
+  std::optional<std::string> cache_key;
+  if (cache != nullptr) {
+    std::vector<const Tensor*> input_tensors;
+    input_tensors.reserve(inputs.size());
+    for (const TensorValue& input : inputs) {
+      input_tensors.push_back(input.tensor);
+    }
+    cache_key = ConstantFoldingCache::NodeKey(node, input_tensors);
+  }
+  std::optional<std::vector<Tensor>> cached;
+  if (cache_key.has_value()) {
+    cached = cache->Lookup(*cache_key);
+  }
+  if (cached.has_value()) {
+    for (Tensor& tensor : *cached) {
+      output_tensors.emplace_back(new Tensor(std::move(tensor)));
+    }
+  } else {
+    TF_RETURN_IF_ERROR(EvaluateNode(node, inputs, &output_tensors));
+    const bool has_all_outputs = absl::c_all_of(
+        output_tensors,
+        [](const TensorValue& output) { return output.tensor != nullptr; });
+    if (cache_key.has_value() && !output_tensors.empty() && has_all_outputs) {
+      std::vector<Tensor> results;
+      results.reserve(output_tensors.size());
+      for (const TensorValue& output : output_tensors) {
+        results.push_back(*output.tensor);
+      }
+      cache->Insert(*cache_key, std::move(results));
+    }
+  }
   if (output_tensors.empty()) {
     return absl::Status(absl::StatusCode::kInvalidArgument,
                         "Expected at least one output.");
@@ -1412,8 +1458,9 @@ absl::Status ConstantFolding::EvaluateOneFoldable(const NodeDef& node,
       node_name = strings::StrCat(node_name, "-", i);
     }
     if (output_tensors[i].tensor) {
-      absl::Status s = CreateNodeDef(node_name, output_tensors[i],
-                                     &outputs->at(i), total_inputs_size);
+      absl::Status s =
+          CreateNodeDef(node_name, output_tensors[i], &outputs->at(i),
+                        total_inputs_size, max_constant_size_bytes_);
       if (!s.ok()) {
         *result_too_large = true;
         return s;
@@ -16,6 +16,8 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_CONSTANT_FOLDING_H_
 #define TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_CONSTANT_FOLDING_H_
 
+#include <cstdint>
+
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/types/span.h"
@@ -40,18 +42,23 @@ class ConstantFolding : public GraphOptimizer {
  public:
   // The size limit will only be considered if the newly created node is greater
   // than original_size (optional).
-  static absl::Status CreateNodeDef(const string& name,
-                                    const TensorValue& tensor, NodeDef* node,
-                                    size_t original_size = 0);
+  static absl::Status CreateNodeDef(
+      const string& name, const TensorValue& tensor, NodeDef* node,
+      size_t original_size = 0, int64_t max_constant_size = kMaxConstantSize);
   static string AddControlDependency(const string& input_name, GraphDef* graph,
                                      NodeMap* node_map);
 
+  // max_constant_size_bytes: The largest constant created by folding a node
+  //   whose output is larger than its inputs. Non-positive values mean
+  //   kMaxConstantSize. See RewriterConfig::constant_folding_max_size_bytes.
   explicit ConstantFolding(DeviceBase* cpu_device,
                            bool disable_compressed_tensor_optimization = false,
-                           bool fold_quantization_emulation = true);
+                           bool fold_quantization_emulation = true,
+                           int64_t max_constant_size_bytes = 0);
   ConstantFolding(RewriterConfig::Toggle opt_level, DeviceBase* cpu_device,
                   bool disable_compressed_tensor_optimization = false,
-                  bool fold_quantization_emulation = true);
+                  bool fold_quantization_emulation = true,
+                  int64_t max_constant_size_bytes = 0);
 
   ~ConstantFolding() override {}
 
@@ -352,6 +359,7 @@ class ConstantFolding : public GraphOptimizer {
   bool graph_contains_assign_or_inplace_op_;
   bool disable_compressed_tensor_optimization_;
   bool fold_quantization_emulation_;
+  int64_t max_constant_size_bytes_;
 };
 
 }  // end namespace grappler
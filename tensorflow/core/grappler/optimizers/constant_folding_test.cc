@@ -2942,6 +2942,34 @@ TEST_F(ConstantFoldingTest, LargeConstantNoSizeIncrease) {
   EXPECT_LT(output.ByteSizeLong(), sizeof(float) * large_constant_size + 500);
 }
 
+TEST_F(ConstantFoldingTest, MaxConstantSize) {
+  // Folding the Fill creates a 4000 byte constant from 8 bytes of inputs.
+  tensorflow::Scope scope = tensorflow::Scope::NewRootScope();
+  Output x = ops::Placeholder(scope.WithOpName("x"), DT_FLOAT,
+                              ops::Placeholder::Shape({1000}));
+  Output fill = ops::Fill(scope.WithOpName("fill"), {1000}, 2.0f);
+  Output y = ops::Mul(scope.WithOpName("y"), x, fill);
+
+  GrapplerItem item;
+  item.fetch = {"y"};
+  TF_CHECK_OK(scope.ToGraphDef(&item.graph));
+
+  for (const int64_t max_constant_size_bytes : {0, 1024}) {
+    ConstantFolding optimizer(/*cpu_device=*/nullptr,
+                              /*disable_compressed_tensor_optimization=*/false,
+                              /*fold_quantization_emulation=*/true,
+                              max_constant_size_bytes);
+    GraphDef output;
+    TF_EXPECT_OK(optimizer.Optimize(/*cluster=*/nullptr, item, &output));
+
+    NodeMap node_map(&output);
+    const NodeDef* new_fill = node_map.GetNode("fill");
+    ASSERT_NE(new_fill, nullptr);
+    EXPECT_EQ(new_fill->op(), max_constant_size_bytes == 0 ? "Const" : "Fill")
+        << max_constant_size_bytes;
+  }
+}
+
 TEST_F(ConstantFoldingTest, MaterializeBroadcastGradientArgs) {
   tensorflow::Scope s = tensorflow::Scope::NewRootScope();
   Output a =
@@ -0,0 +1,230 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/cost_based_placement_optimizer.h"
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/op.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/grappler/costs/analytical_cost_estimator.h"
+#include "tensorflow/core/grappler/costs/cost_estimator.h"
+#include "tensorflow/core/grappler/costs/op_context.h"
+#include "tensorflow/core/grappler/costs/op_level_cost_estimator.h"
+#include "tensorflow/core/grappler/costs/virtual_scheduler.h"
+#include "tensorflow/core/grappler/graph_view.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/op_types.h"
+#include "tensorflow/core/grappler/utils/tpu.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/util/device_name_utils.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+// Returns true if the placement of `node` is not constrained by anything but
+// kernel availability.
+bool IsMovable(const NodeDef& node,
+               const std::unordered_set<string>& nodes_to_preserve) {
+  if (node.device().empty() || nodes_to_preserve.count(node.name()) > 0) {
+    return false;
+  }
+  if (IsControlFlow(node) || IsCollective(node) || IsNoOp(node) ||
+      IsSend(node) || IsRecv(node) || IsStateful(node)) {
+    return false;
+  }
+  if (node.attr().count(kColocationAttrName) > 0) return false;
+
+  // Resources must stay on the device that owns them. Also skips function
+  // calls, whose ops are not in the registry.
+  const OpDef* op_def = nullptr;
+  if (!OpRegistry::Global()->LookUpOpDef(node.op(), &op_def).ok()) {
+    return false;
+  }
+  DataTypeVector input_types;
+  DataTypeVector output_types;
+  if (!InOutTypesForNode(node, *op_def, &input_types, &output_types).ok()) {
+    return false;
+  }
+  for (const DataTypeVector* types : {&input_types, &output_types}) {
+    for (DataType type : *types) {
+      if (type == DT_RESOURCE) return false;
+    }
+  }
+  return true;
+}
+
+// Returns true if `node` may be moved from its device to `target`, which is
+// the CPU or a GPU in the same address space as a device of the other type.
+bool IsMoveAllowed(const NodeDef& node, const string& target) {
+  DeviceNameUtils::ParsedName current;
+  DeviceNameUtils::ParsedName parsed_target;
+  if (!DeviceNameUtils::ParseFullName(node.device(), &current) ||
+      !DeviceNameUtils::ParseFullName(target, &parsed_target) ||
+      !current.has_type || !parsed_target.has_type) {
+    return false;
+  }
+  const bool is_cpu_gpu_move =
+      (current.type == DEVICE_CPU && parsed_target.type == DEVICE_GPU) ||
+      (current.type == DEVICE_GPU && parsed_target.type == DEVICE_CPU);
+  if (!is_cpu_gpu_move ||
+      !DeviceNameUtils::IsSameAddressSpace(current, parsed_target)) {
+    return false;
+  }
+  return FindKernelDef(DeviceType(parsed_target.type), node,
+                       /*def=*/nullptr, /*kernel_class_name=*/nullptr)
+      .ok();
+}
+
+// The OpLevelCostEstimator treats _Send and _Recv as free. Copying a tensor
+// between host and device has a fixed latency plus the time to move the
+// bytes over PCIe, which is what cost-based placement trades off against
+// compute time.
+constexpr double kTransferLatencyNs = 10000;
+constexpr double kTransferBytesPerNs = 12.0;  // PCIe gen3 x16.
+
+class TransferCostEstimator : public OpLevelCostEstimator {
+ public:
+  Costs PredictCosts(const OpContext& op_context) const override {
+    // The VirtualScheduler places each _Send on the channel between two
+    // devices, so charging the transfer to the _Send also serializes the
+    // transfers on the same channel.
+    if (op_context.op_info.op() != "_Send") {
+      return OpLevelCostEstimator::PredictCosts(op_context);
+    }
+    int64_t num_bytes = 0;
+    bool inaccurate = false;
+    for (const auto& input : op_context.op_info.inputs()) {
+      num_bytes += CalculateTensorSize(input, &inaccurate);
+    }
+    Costs costs = Costs::ZeroCosts(inaccurate);
+    costs.compute_time = Costs::Duration(static_cast<int64_t>(
+        kTransferLatencyNs + num_bytes / kTransferBytesPerNs));
+    costs.execution_time = costs.compute_time;
+    return costs;
+  }
+};
+
+// Estimates the step time of `item` with the placement in `item.graph`.
+absl::Status EstimateStepTime(Cluster* cluster, const GrapplerItem& item,
+                              Costs::Duration* step_time) {
+  AnalyticalCostEstimator estimator(
+      cluster, std::make_unique<TransferCostEstimator>(),
+      ReadyNodeManagerFactory("FirstReady"), /*use_static_shapes=*/true,
+      /*use_aggressive_shape_inference=*/false);
+  TF_RETURN_IF_ERROR(estimator.Initialize(item));
+  Costs costs;
+  TF_RETURN_IF_ERROR(
+      estimator.PredictCosts(item.graph, /*run_metadata=*/nullptr, &costs));
+  *step_time = costs.execution_time;
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+absl::Status CostBasedPlacementOptimizer::Optimize(Cluster* cluster,
+                                                   const GrapplerItem& item,
+                                                   GraphDef* optimized_graph) {
+  if (cluster == nullptr) {
+    return errors::Aborted(
+        "Cost-based placement needs a cluster to estimate costs.");
+  }
+  // Skip Legacy TPU bridge graphs.
+  if (IsLegacyTPUBridgeGraphDef(item.graph)) {
+    return errors::Aborted("Nothing to do.");
+  }
+
+  GrapplerItem optimized_item = item;
+  GraphDef& graph = optimized_item.graph;
+  GraphView graph_view(&graph);
+  const std::unordered_set<string> nodes_to_preserve = item.NodesToPreserve();
+
+  // A node is only moved to the device of one of its neighbors, since that is
+  // the only way a move can save a transfer.
+  std::vector<std::pair<NodeDef*, string>> moves;
+  for (NodeDef& node : *graph.mutable_node()) {
+    if (!IsMovable(node, nodes_to_preserve)) continue;
+    std::set<string> neighbor_devices;
+    for (const GraphView::OutputPort& fanin :
+         graph_view.GetFanins(node, /*include_controlling_nodes=*/false)) {
+      neighbor_devices.insert(fanin.node->device());
+    }
+    for (const GraphView::InputPort& fanout :
+         graph_view.GetFanouts(node, /*include_controlled_nodes=*/false)) {
+      neighbor_devices.insert(fanout.node->device());
+    }
+    for (const string& device : neighbor_devices) {
+      if (IsMoveAllowed(node, device)) moves.emplace_back(&node, device);
+    }
+  }
+  if (moves.empty()) {
+    return errors::Aborted("Nothing to do.");
+  }
+
+  Costs::Duration best_step_time;
+  absl::Status s = EstimateStepTime(cluster, optimized_item, &best_step_time);
+  if (!s.ok()) {
+    return errors::Aborted("Failed to estimate the step time: ", s.message());
+  }
+
+  // Greedily keeps every move that lowers the estimated step time, until no
+  // move helps or the evaluation budget runs out.
+  int num_evaluations = 0;
+  int num_moved = 0;
+  bool improved = true;
+  while (improved && num_evaluations < max_evaluations_) {
+    improved = false;
+    for (auto& [node, target] : moves) {
+      if (num_evaluations >= max_evaluations_) break;
+      if (node->device() == target) continue;
+      GRAPPLER_RETURN_IF_DEADLINE_EXCEEDED();
+
+      string original = node->device();
+      node->set_device(target);
+      ++num_evaluations;
+      Costs::Duration step_time;
+      if (EstimateStepTime(cluster, optimized_item, &step_time).ok() &&
+          step_time < best_step_time) {
+        VLOG(2) << "Moving node " << node->name() << " from " << original
+                << " to " << target << " lowers the estimated step time from "
+                << best_step_time.count() << "ns to " << step_time.count()
+                << "ns";
+        best_step_time = step_time;
+        improved = true;
+        ++num_moved;
+      } else {
+        node->set_device(std::move(original));
+      }
+    }
+  }
+  VLOG(1) << "Moved " << num_moved << " nodes after evaluating "
+          << num_evaluations << " moves";
+
+  *optimized_graph = std::move(graph);
+  return absl::OkStatus();
+}
+
+}  // end namespace grappler
+}  // end namespace tensorflow
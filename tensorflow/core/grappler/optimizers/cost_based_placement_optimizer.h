@@ -0,0 +1,65 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_COST_BASED_PLACEMENT_OPTIMIZER_H_
+#define TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_COST_BASED_PLACEMENT_OPTIMIZER_H_
+
+#include "tensorflow/core/grappler/optimizers/graph_optimizer.h"
+#include "tensorflow/core/protobuf/rewriter_config.pb.h"
+
+namespace tensorflow {
+namespace grappler {
+
+// Refines the placement chosen by the Placer using the analytical cost model.
+//
+// The Placer only looks at kernel availability and colocation constraints, so
+// cheap ops such as shape computations often end up on a different device
+// than their neighbors, and each of them costs a pair of host<->device
+// copies. This optimizer simulates the graph with the VirtualScheduler and
+// greedily moves nodes between the CPU and GPU devices of their neighbors
+// whenever that lowers the estimated step time, including transfers.
+//
+// Only nodes that are free to move are considered: stateless nodes without
+// colocation constraints or resource inputs and outputs, that have a kernel
+// on the new device.
+class CostBasedPlacementOptimizer : public GraphOptimizer {
+ public:
+  // Estimating the step time simulates the whole graph, so the number of
+  // moves that are evaluated is bounded.
+  static constexpr int kDefaultMaxEvaluations = 200;
+
+  CostBasedPlacementOptimizer() = default;
+  explicit CostBasedPlacementOptimizer(
+      RewriterConfig::Toggle opt_level,
+      int max_evaluations = kDefaultMaxEvaluations)
+      : max_evaluations_(max_evaluations) {}
+
+  ~CostBasedPlacementOptimizer() override = default;
+
+  string name() const override { return "cost_based_placement"; };
+
+  bool UsesFunctionLibrary() const override { return false; }
+
+  absl::Status Optimize(Cluster* cluster, const GrapplerItem& item,
+                        GraphDef* optimized_graph) override;
+
+ private:
+  int max_evaluations_ = kDefaultMaxEvaluations;
+};
+
+}  // end namespace grappler
+}  // end namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_COST_BASED_PLACEMENT_OPTIMIZER_H_
@@ -0,0 +1,134 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/cost_based_placement_optimizer.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "absl/status/status.h"
+#include "tensorflow/cc/ops/standard_ops.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/grappler/clusters/virtual_cluster.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/utils/grappler_test.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/protobuf/device_properties.pb.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+constexpr char kCpu[] = "/job:localhost/replica:0/task:0/device:CPU:0";
+constexpr char kGpu[] = "/job:localhost/replica:0/task:0/device:GPU:0";
+
+class CostBasedPlacementOptimizerTest : public GrapplerTest {
+ protected:
+  static std::unique_ptr<VirtualCluster> CreateVirtualCluster() {
+    DeviceProperties cpu_device;
+    cpu_device.set_type("CPU");
+    cpu_device.set_frequency(1000);
+    cpu_device.set_num_cores(4);
+    cpu_device.set_bandwidth(32);
+    DeviceProperties gpu_device;
+    gpu_device.set_type("GPU");
+    gpu_device.set_frequency(1000);
+    gpu_device.set_num_cores(24);
+    gpu_device.set_bandwidth(128);
+    gpu_device.mutable_environment()->insert({"architecture", "6"});
+    std::unordered_map<string, DeviceProperties> devices;
+    devices[kCpu] = cpu_device;
+    devices[kGpu] = gpu_device;
+    return std::make_unique<VirtualCluster>(devices);
+  }
+
+  // Builds x -> a -> b -> c, where only b is placed on the GPU.
+  static GrapplerItem CreateItem(bool colocate_b) {
+    tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+    Output x = ops::Placeholder(s.WithOpName("x").WithDevice(kCpu), DT_FLOAT,
+                                ops::Placeholder::Shape({1000}));
+    Output a = ops::Neg(s.WithOpName("a").WithDevice(kCpu), x);
+    Output b = ops::Square(s.WithOpName("b").WithDevice(kGpu), a);
+    Output c = ops::Sqrt(s.WithOpName("c").WithDevice(kCpu), b);
+
+    GrapplerItem item;
+    item.fetch = {"c"};
+    TF_CHECK_OK(s.ToGraphDef(&item.graph));
+    if (colocate_b) {
+      for (NodeDef& node : *item.graph.mutable_node()) {
+        if (node.name() != "b") continue;
+        (*node.mutable_attr())["_class"].mutable_list()->add_s("loc:@a");
+      }
+    }
+    return item;
+  }
+};
+
+TEST_F(CostBasedPlacementOptimizerTest, MovesNodeToAvoidTransfers) {
+  GrapplerItem item = CreateItem(/*colocate_b=*/false);
+  std::unique_ptr<VirtualCluster> cluster = CreateVirtualCluster();
+
+  CostBasedPlacementOptimizer optimizer(RewriterConfig::ON);
+  GraphDef output;
+  TF_EXPECT_OK(optimizer.Optimize(cluster.get(), item, &output));
+
+  ASSERT_EQ(output.node_size(), 4);
+  for (const NodeDef& node : output.node()) {
+    EXPECT_EQ(node.device(), kCpu) << node.name();
+  }
+}
+
+TEST_F(CostBasedPlacementOptimizerTest, KeepsColocatedNode) {
+  GrapplerItem item = CreateItem(/*colocate_b=*/true);
+  std::unique_ptr<VirtualCluster> cluster = CreateVirtualCluster();
+
+  CostBasedPlacementOptimizer optimizer(RewriterConfig::ON);
+  GraphDef output;
+  absl::Status status = optimizer.Optimize(cluster.get(), item, &output);
+  if (absl::IsAborted(status)) return;
+  TF_EXPECT_OK(status);
+
+  for (const NodeDef& node : output.node()) {
+    if (node.name() == "b") EXPECT_EQ(node.device(), kGpu);
+  }
+}
+
+TEST_F(CostBasedPlacementOptimizerTest, NoMovesWithinBudget) {
+  GrapplerItem item = CreateItem(/*colocate_b=*/false);
+  std::unique_ptr<VirtualCluster> cluster = CreateVirtualCluster();
+
+  CostBasedPlacementOptimizer optimizer(RewriterConfig::ON,
+                                        /*max_evaluations=*/0);
+  GraphDef output;
+  TF_EXPECT_OK(optimizer.Optimize(cluster.get(), item, &output));
+
+  for (const NodeDef& node : output.node()) {
+    if (node.name() == "b") EXPECT_EQ(node.device(), kGpu);
+  }
+}
+
+TEST_F(CostBasedPlacementOptimizerTest, NeedsCluster) {
+  GrapplerItem item = CreateItem(/*colocate_b=*/false);
+
+  CostBasedPlacementOptimizer optimizer(RewriterConfig::ON);
+  GraphDef output;
+  EXPECT_TRUE(absl::IsAborted(optimizer.Optimize(nullptr, item, &output)));
+}
+
+}  // namespace
+}  // namespace grappler
+}  // namespace tensorflow
@@ -68,7 +68,10 @@ const ConfigList& DefaultPluginConfigs() {
        {"auto_mixed_precision_onednn_bfloat16", RewriterConfig::ON},
        {"auto_mixed_precision_mkl", RewriterConfig::ON},
        {"auto_mixed_precision_cpu", RewriterConfig::ON},
+       {"dynamic_quantization", RewriterConfig::ON},
+       {"sparse_apply_grouping", RewriterConfig::ON},
        {"pin_to_host_optimization", RewriterConfig::ON},
+       {"cost_based_placement", RewriterConfig::ON},
        {"layout_optimizer", RewriterConfig::ON},
        {"remapping", RewriterConfig::ON},
        {"loop_optimization", RewriterConfig::ON},
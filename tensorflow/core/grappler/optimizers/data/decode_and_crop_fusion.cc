@@ -0,0 +1,337 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/data/decode_and_crop_fusion.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/str_cat.h"
+#include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/function.pb.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/grappler/clusters/cluster.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/optimizers/custom_graph_optimizer_registry.h"
+#include "tensorflow/core/grappler/optimizers/data/function_utils.h"
+#include "tensorflow/core/grappler/optimizers/data/graph_utils.h"
+#include "tensorflow/core/grappler/utils.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+constexpr char kDecodeJpeg[] = "DecodeJpeg";
+constexpr char kDecodeAndCropJpeg[] = "DecodeAndCropJpeg";
+constexpr char kSlice[] = "Slice";
+constexpr char kConst[] = "Const";
+constexpr char kConcatV2[] = "ConcatV2";
+constexpr char kCast[] = "Cast";
+constexpr std::array<const char*, 4> kMapOps = {
+    "MapDataset", "ParallelMapDataset", "ParallelMapDatasetV2",
+    "MapAndBatchDataset"};
+constexpr std::array<const char*, 2> kSampleDistortedBoundingBoxOps = {
+    "SampleDistortedBoundingBox", "SampleDistortedBoundingBoxV2"};
+// Attributes of `DecodeJpeg` that `DecodeAndCropJpeg` accepts as well.
+constexpr std::array<const char*, 6> kDecodeAttrs = {
+    "channels",
+    "ratio",
+    "fancy_upscaling",
+    "try_recover_truncated",
+    "acceptable_fraction",
+    "dct_method"};
+
+template <size_t N>
+bool IsOneOf(const string& op, const std::array<const char*, N>& ops) {
+  for (const char* candidate : ops) {
+    if (op == candidate) return true;
+  }
+  return false;
+}
+
+// Returns whether the only reference to `node_name` in `function`, as an input
+// of a node, a control dependency or a return value, is `tensor`.
+bool IsOnlyReferencedAs(const FunctionDef& function, const string& node_name,
+                        const string& tensor) {
+  int num_references = 0;
+  auto check = [&](const string& input) {
+    const string producer = IsControlInput(input)
+                                ? input.substr(1)
+                                : function_utils::FunctionDefTensorDesc(input)
+                                      .node_name;
+    if (producer != node_name) return true;
+    ++num_references;
+    return input == tensor;
+  };
+  for (const NodeDef& node : function.node_def()) {
+    for (const string& input : node.input()) {
+      if (!check(input)) return false;
+    }
+  }
+  for (const auto& ret : function.ret()) {
+    if (!check(ret.second)) return false;
+  }
+  return num_references == 1;
+}
+
+const NodeDef* ProducerNode(const FunctionDef& function, const string& input) {
+  const int index = function_utils::FindFunctionNodeWithName(
+      function_utils::FunctionDefTensorDesc(input).node_name, function);
+  return index == -1 ? nullptr : &function.node_def(index);
+}
+
+// Returns the values of a constant integer vector `node`, or an empty vector.
+std::vector<int64_t> GetConstVector(const NodeDef* node) {
+  if (node == nullptr || node->op() != kConst ||
+      !node->attr().contains("value")) {
+    return {};
+  }
+  Tensor tensor;
+  if (!tensor.FromProto(node->attr().at("value").tensor()) ||
+      tensor.dims() != 1) {
+    return {};
+  }
+  std::vector<int64_t> values;
+  for (int64_t i = 0; i < tensor.NumElements(); ++i) {
+    if (tensor.dtype() == DT_INT32) {
+      values.push_back(tensor.vec<int32>()(i));
+    } else if (tensor.dtype() == DT_INT64) {
+      values.push_back(tensor.vec<int64_t>()(i));
+    } else {
+      return {};
+    }
+  }
+  return values;
+}
+
+AttrValue MakeInt32TensorAttr(const std::vector<int32>& values,
+                              const TensorShape& shape) {
+  Tensor tensor(DT_INT32, shape);
+  for (int64_t i = 0; i < tensor.NumElements(); ++i) {
+    tensor.flat<int32>()(i) = values[i];
+  }
+  AttrValue value;
+  tensor.AsProtoTensorContent(value.mutable_tensor());
+  return value;
+}
+
+string AddInt32Const(const std::vector<int32>& values,
+                     const TensorShape& shape, FunctionDef* function) {
+  AttrValue dtype;
+  dtype.set_type(DT_INT32);
+  NodeDef* node = function_utils::AddNode(
+      /*name=*/"", kConst, /*inputs=*/{},
+      {{"value", MakeInt32TensorAttr(values, shape)}, {"dtype", dtype}},
+      function);
+  return absl::StrCat(node->name(), ":output:0");
+}
+
+// Describes how to compute the `[y, x, height, width]` crop window of
+// `DecodeAndCropJpeg` from the `begin` and `size` inputs of a `Slice` of the
+// decoded image.
+struct CropWindow {
+  // Set if the crop window is constant.
+  std::vector<int32> values;
+  // Set if the crop window comes from a `SampleDistortedBoundingBox`, whose
+  // outputs have type `dtype`.
+  string begin;
+  string size;
+  DataType dtype = DT_INT32;
+};
+
+// Returns whether the `Slice` with inputs `begin` and `size` only crops the
+// spatial dimensions of an image with `channels` channels, and if so sets
+// `crop_window`.
+bool GetCropWindow(const FunctionDef& function, const string& begin,
+                   const string& size, int64_t channels,
+                   CropWindow* crop_window) {
+  const std::vector<int64_t> begin_values =
+      GetConstVector(ProducerNode(function, begin));
+  const std::vector<int64_t> size_values =
+      GetConstVector(ProducerNode(function, size));
+  if (begin_values.size() == 3 && size_values.size() == 3) {
+    const bool keeps_channels =
+        begin_values[2] == 0 &&
+        (size_values[2] == -1 || (channels > 0 && size_values[2] == channels));
+    if (!keeps_channels || begin_values[0] < 0 || begin_values[1] < 0 ||
+        size_values[0] <= 0 || size_values[1] <= 0) {
+      return false;
+    }
+    for (int i = 0; i < 2; ++i) {
+      if (begin_values[i] + size_values[i] >
+          std::numeric_limits<int32>::max()) {
+        return false;
+      }
+    }
+    crop_window->values = {static_cast<int32>(begin_values[0]),
+                           static_cast<int32>(begin_values[1]),
+                           static_cast<int32>(size_values[0]),
+                           static_cast<int32>(size_values[1])};
+    return true;
+  }
+  // `SampleDistortedBoundingBox` returns a `begin` of `[y, x, 0]` and a `size`
+  // of `[height, width, -1]`, which always keep all channels.
+  const function_utils::FunctionDefTensorDesc begin_desc(begin);
+  const function_utils::FunctionDefTensorDesc size_desc(size);
+  const NodeDef* producer = ProducerNode(function, begin);
+  if (producer == nullptr ||
+      !IsOneOf(producer->op(), kSampleDistortedBoundingBoxOps) ||
+      begin_desc.node_output != "begin" || size_desc.node_output != "size" ||
+      size_desc.node_name != begin_desc.node_name ||
+      !producer->attr().contains("T")) {
+    return false;
+  }
+  crop_window->begin = begin;
+  crop_window->size = size;
+  crop_window->dtype = producer->attr().at("T").type();
+  return true;
+}
+
+// Adds the nodes that compute `crop_window` to `function`, and returns the
+// name of the resulting int32 tensor.
+string AddCropWindow(const CropWindow& crop_window, FunctionDef* function) {
+  if (!crop_window.values.empty()) {
+    return AddInt32Const(crop_window.values, TensorShape({4}), function);
+  }
+  AttrValue int32_type;
+  int32_type.set_type(DT_INT32);
+  AttrValue window_type;
+  window_type.set_type(crop_window.dtype);
+  AttrValue num_values;
+  num_values.set_i(2);
+  const string zero = AddInt32Const({0}, TensorShape({1}), function);
+  const string two = AddInt32Const({2}, TensorShape({1}), function);
+  const string axis = AddInt32Const({0}, TensorShape({}), function);
+  std::vector<string> spatial;
+  for (const string& input : {crop_window.begin, crop_window.size}) {
+    NodeDef* slice = function_utils::AddNode(
+        /*name=*/"", kSlice, {input, zero, two},
+        {{"T", window_type}, {"Index", int32_type}}, function);
+    spatial.push_back(absl::StrCat(slice->name(), ":output:0"));
+  }
+  NodeDef* concat = function_utils::AddNode(
+      /*name=*/"", kConcatV2, {spatial[0], spatial[1], axis},
+      {{"N", num_values}, {"T", window_type}, {"Tidx", int32_type}}, function);
+  const string window = absl::StrCat(concat->name(), ":output:0");
+  if (crop_window.dtype == DT_INT32) return window;
+  // `DecodeAndCropJpeg` only accepts an int32 crop window.
+  NodeDef* cast = function_utils::AddNode(
+      /*name=*/"", kCast, {window},
+      {{"SrcT", window_type}, {"DstT", int32_type}}, function);
+  return absl::StrCat(cast->name(), ":y:0");
+}
+
+// Fuses every `DecodeJpeg` of `function` whose output is only cropped by a
+// `Slice` into a `DecodeAndCropJpeg`. Returns the number of fused pairs.
+int FuseDecodeAndCrop(FunctionDef* function) {
+  int num_fused = 0;
+  absl::flat_hash_set<string> nodes_to_delete;
+  // Nodes are only appended while iterating, so existing indices stay valid.
+  const int num_nodes = function->node_def_size();
+  for (int i = 0; i < num_nodes; ++i) {
+    const NodeDef decode = function->node_def(i);
+    if (decode.op() != kDecodeJpeg || decode.input_size() != 1) continue;
+    const string decoded_image = absl::StrCat(decode.name(), ":image:0");
+    if (!IsOnlyReferencedAs(*function, decode.name(), decoded_image)) {
+      continue;
+    }
+    int slice_index = -1;
+    for (int j = 0; j < num_nodes; ++j) {
+      const NodeDef& node = function->node_def(j);
+      if (node.op() == kSlice && node.input_size() == 3 &&
+          node.input(0) == decoded_image) {
+        slice_index = j;
+        break;
+      }
+    }
+    if (slice_index == -1) continue;
+    const NodeDef slice = function->node_def(slice_index);
+    const string cropped_image = absl::StrCat(slice.name(), ":output:0");
+    if (!IsOnlyReferencedAs(*function, slice.name(), cropped_image)) {
+      continue;
+    }
+    const int64_t channels =
+        decode.attr().contains("channels") ? decode.attr().at("channels").i()
+                                           : 0;
+    CropWindow crop_window;
+    if (!GetCropWindow(*function, slice.input(1), slice.input(2), channels,
+                       &crop_window)) {
+      continue;
+    }
+
+    const string window = AddCropWindow(crop_window, function);
+    NodeDef* fused = function_utils::AddNode(
+        /*name=*/"", kDecodeAndCropJpeg, {decode.input(0), window},
+        /*attributes=*/{}, function);
+    for (const char* attr : kDecodeAttrs) {
+      if (decode.attr().contains(attr)) {
+        (*fused->mutable_attr())[attr] = decode.attr().at(attr);
+      }
+    }
+    function_utils::ReplaceReferences(
+        cropped_image, absl::StrCat(fused->name(), ":image:0"), function);
+    nodes_to_delete.insert(decode.name());
+    nodes_to_delete.insert(slice.name());
+    ++num_fused;
+  }
+  if (nodes_to_delete.empty()) return 0;
+
+  auto* nodes = function->mutable_node_def();
+  nodes->erase(std::remove_if(nodes->begin(), nodes->end(),
+                              [&](const NodeDef& node) {
+                                return nodes_to_delete.contains(node.name());
+                              }),
+               nodes->end());
+  return num_fused;
+}
+
+}  // namespace
+
+absl::Status DecodeAndCropFusion::OptimizeAndCollectStats(
+    Cluster* cluster, const GrapplerItem& item, GraphDef* output,
+    OptimizationStats* stats) {
+  *output = item.graph;
+  for (NodeDef& node : *output->mutable_node()) {
+    if (!IsOneOf(node.op(), kMapOps) || !node.attr().contains("f")) continue;
+    const int function_index = graph_utils::FindGraphFunctionWithName(
+        node.attr().at("f").func().name(), output->library());
+    if (function_index == -1) continue;
+
+    FunctionDef function = output->library().function(function_index);
+    const int num_fused = FuseDecodeAndCrop(&function);
+    if (num_fused == 0) continue;
+    graph_utils::SetUniqueGraphFunctionName(
+        absl::StrCat("decode_and_crop_", function.signature().name()),
+        &output->library(), &function);
+    (*node.mutable_attr())["f"].mutable_func()->set_name(
+        function.signature().name());
+    *output->mutable_library()->add_function() = std::move(function);
+    stats->num_changes += num_fused;
+  }
+  return absl::OkStatus();
+}
+
+REGISTER_GRAPH_OPTIMIZER_AS(DecodeAndCropFusion, "decode_and_crop_fusion");
+
+}  // namespace grappler
+}  // namespace tensorflow
@@ -0,0 +1,228 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/data/decode_and_crop_fusion.h"
+
+#include "tensorflow/core/framework/attr_value_util.h"
+#include "tensorflow/core/framework/function_testlib.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/optimizers/data/function_utils.h"
+#include "tensorflow/core/grappler/optimizers/data/graph_test_utils.h"
+#include "tensorflow/core/grappler/optimizers/data/graph_utils.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+using graph_tests_utils::MakeMapNode;
+using test::function::NDef;
+using FDH = FunctionDefHelper;
+
+// Returns a function that decodes a JPEG and crops it with `Slice` using the
+// `begin` and `size` nodes.
+FunctionDef DecodeAndSlice(const string& name, std::vector<FDH::Node> nodes,
+                           const string& begin, const string& size) {
+  nodes.push_back({{"decode"},
+                   "DecodeJpeg",
+                   {"contents"},
+                   {{"channels", 3}, {"dct_method", "INTEGER_FAST"}}});
+  nodes.push_back({{"slice"},
+                   "Slice",
+                   {"decode:image:0", begin, size},
+                   {{"T", DT_UINT8}, {"Index", DT_INT32}}});
+  return FDH::Create(name, {"contents: string"}, {"image: uint8"}, {}, nodes,
+                     {{"image", "slice:output:0"}});
+}
+
+GrapplerItem MakeItem(const FunctionDef& function) {
+  GrapplerItem item;
+  item.graph = test::function::GDef(
+      {NDef("filenames", "Const", {},
+            {{"value", test::AsTensor<tstring>({"a.jpg"})},
+             {"dtype", DT_STRING}}),
+       NDef("files", "TensorSliceDataset", {"filenames"},
+            {{"output_shapes", absl::Span<const TensorShape>{{}}},
+             {"Toutput_types", absl::Span<const DataType>{DT_STRING}}}),
+       MakeMapNode("map", "files", function.signature().name()),
+       NDef("Sink", "Identity", {"map"}, {})},
+      {function});
+  item.fetch.push_back("Sink");
+  return item;
+}
+
+const FunctionDef& MapFunction(const GraphDef& graph) {
+  const NodeDef& map =
+      graph.node(graph_utils::FindGraphNodeWithName("map", graph));
+  return graph.library().function(graph_utils::FindGraphFunctionWithName(
+      map.attr().at("f").func().name(), graph.library()));
+}
+
+TEST(DecodeAndCropFusionTest, FusesConstantCrop) {
+  FunctionDef function = DecodeAndSlice(
+      "ConstantCrop",
+      {{{"begin"},
+        "Const",
+        {},
+        {{"value", test::AsTensor<int32>({10, 20, 0})}, {"dtype", DT_INT32}}},
+       {{"size"},
+        "Const",
+        {},
+        {{"value", test::AsTensor<int32>({30, 40, -1})},
+         {"dtype", DT_INT32}}}},
+      "begin:output:0", "size:output:0");
+  DecodeAndCropFusion optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, MakeItem(function), &output));
+
+  const FunctionDef& fused = MapFunction(output);
+  EXPECT_NE(fused.signature().name(), "ConstantCrop");
+  EXPECT_FALSE(function_utils::ContainsFunctionNodeWithOp("DecodeJpeg", fused));
+  EXPECT_FALSE(function_utils::ContainsFunctionNodeWithOp("Slice", fused));
+  const NodeDef& decode_and_crop = fused.node_def(
+      function_utils::FindFunctionNodeWithOp("DecodeAndCropJpeg", fused));
+  EXPECT_EQ(decode_and_crop.input(0), "contents");
+  EXPECT_EQ(decode_and_crop.attr().at("channels").i(), 3);
+  EXPECT_EQ(decode_and_crop.attr().at("dct_method").s(), "INTEGER_FAST");
+  EXPECT_EQ(fused.ret().at("image"),
+            absl::StrCat(decode_and_crop.name(), ":image:0"));
+
+  const NodeDef& crop_window = fused.node_def(
+      function_utils::FindFunctionNodeWithName(
+          function_utils::FunctionDefTensorDesc(decode_and_crop.input(1))
+              .node_name,
+          fused));
+  Tensor window;
+  ASSERT_TRUE(window.FromProto(crop_window.attr().at("value").tensor()));
+  test::ExpectTensorEqual<int32>(window,
+                                 test::AsTensor<int32>({10, 20, 30, 40}));
+  // The original function is kept for other users.
+  EXPECT_TRUE(graph_utils::ContainsGraphFunctionWithName(
+      "ConstantCrop", output.library()));
+}
+
+// Returns a function that crops a JPEG with `SampleDistortedBoundingBoxV2`
+// of type `dtype`.
+FunctionDef RandomCrop(DataType dtype) {
+  return DecodeAndSlice(
+      "RandomCrop",
+      {{{"shape"},
+        "ExtractJpegShape",
+        {"contents"},
+        {{"output_type", DT_INT32}}},
+       {{"boxes"},
+        "Const",
+        {},
+        {{"value", test::AsTensor<float>({0, 0, 1, 1}, {1, 1, 4})},
+         {"dtype", DT_FLOAT}}},
+       {{"min_object_covered"},
+        "Const",
+        {},
+        {{"value", 0.1f}, {"dtype", DT_FLOAT}}},
+       {{"bbox"},
+        "SampleDistortedBoundingBoxV2",
+        {"shape:image_shape:0", "boxes:output:0",
+         "min_object_covered:output:0"},
+        {{"T", dtype}}}},
+      "bbox:begin:0", "bbox:size:0");
+}
+
+TEST(DecodeAndCropFusionTest, FusesRandomCrop) {
+  DecodeAndCropFusion optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(
+      optimizer.Optimize(nullptr, MakeItem(RandomCrop(DT_INT32)), &output));
+
+  const FunctionDef& fused = MapFunction(output);
+  EXPECT_FALSE(function_utils::ContainsFunctionNodeWithOp("DecodeJpeg", fused));
+  EXPECT_TRUE(function_utils::ContainsFunctionNodeWithOp("ConcatV2", fused));
+  EXPECT_FALSE(function_utils::ContainsFunctionNodeWithOp("Cast", fused));
+  const NodeDef& decode_and_crop = fused.node_def(
+      function_utils::FindFunctionNodeWithOp("DecodeAndCropJpeg", fused));
+  const NodeDef& concat = fused.node_def(
+      function_utils::FindFunctionNodeWithOp("ConcatV2", fused));
+  EXPECT_EQ(decode_and_crop.input(1), absl::StrCat(concat.name(), ":output:0"));
+}
+
+TEST(DecodeAndCropFusionTest, FusesInt64RandomCrop) {
+  DecodeAndCropFusion optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(
+      optimizer.Optimize(nullptr, MakeItem(RandomCrop(DT_INT64)), &output));
+
+  // The crop window is computed in int64 and then cast to int32.
+  const FunctionDef& fused = MapFunction(output);
+  const NodeDef& decode_and_crop = fused.node_def(
+      function_utils::FindFunctionNodeWithOp("DecodeAndCropJpeg", fused));
+  const NodeDef& concat = fused.node_def(
+      function_utils::FindFunctionNodeWithOp("ConcatV2", fused));
+  const NodeDef& cast =
+      fused.node_def(function_utils::FindFunctionNodeWithOp("Cast", fused));
+  EXPECT_EQ(concat.attr().at("T").type(), DT_INT64);
+  EXPECT_EQ(cast.input(0), absl::StrCat(concat.name(), ":output:0"));
+  EXPECT_EQ(cast.attr().at("SrcT").type(), DT_INT64);
+  EXPECT_EQ(cast.attr().at("DstT").type(), DT_INT32);
+  EXPECT_EQ(decode_and_crop.input(1), absl::StrCat(cast.name(), ":y:0"));
+}
+
+TEST(DecodeAndCropFusionTest, KeepsChannelSlice) {
+  // Slicing the channels cannot be expressed with a crop window.
+  FunctionDef function = DecodeAndSlice(
+      "ChannelSlice",
+      {{{"begin"},
+        "Const",
+        {},
+        {{"value", test::AsTensor<int32>({0, 0, 1})}, {"dtype", DT_INT32}}},
+       {{"size"},
+        "Const",
+        {},
+        {{"value", test::AsTensor<int32>({10, 10, 1})},
+         {"dtype", DT_INT32}}}},
+      "begin:output:0", "size:output:0");
+  DecodeAndCropFusion optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, MakeItem(function), &output));
+
+  EXPECT_EQ(MapFunction(output).signature().name(), "ChannelSlice");
+}
+
+TEST(DecodeAndCropFusionTest, KeepsReusedDecode) {
+  // The full decoded image is also returned, so it must still be decoded.
+  FunctionDef function = DecodeAndSlice(
+      "ReusedDecode",
+      {{{"begin"},
+        "Const",
+        {},
+        {{"value", test::AsTensor<int32>({0, 0, 0})}, {"dtype", DT_INT32}}},
+       {{"size"},
+        "Const",
+        {},
+        {{"value", test::AsTensor<int32>({10, 10, -1})},
+         {"dtype", DT_INT32}}}},
+      "begin:output:0", "size:output:0");
+  function_utils::AddFunctionOutputWithUniqueName("full", "decode:image:0",
+                                                  &function, DT_UINT8);
+  DecodeAndCropFusion optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, MakeItem(function), &output));
+
+  EXPECT_EQ(MapFunction(output).signature().name(), "ReusedDecode");
+}
+
+}  // namespace
+}  // namespace grappler
+}  // namespace tensorflow
@@ -0,0 +1,304 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/data/map_vectorization.h"
+
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/function.h"
+#include "tensorflow/core/framework/function.pb.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/op.h"
+#include "tensorflow/core/framework/tensor_shape.pb.h"
+#include "tensorflow/core/grappler/clusters/cluster.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/mutable_graph_view.h"
+#include "tensorflow/core/grappler/optimizers/custom_graph_optimizer_registry.h"
+#include "tensorflow/core/grappler/optimizers/data/graph_utils.h"
+#include "tensorflow/core/grappler/utils.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+constexpr char kMapDataset[] = "MapDataset";
+constexpr char kParallelMapDataset[] = "ParallelMapDataset";
+constexpr char kParallelMapDatasetV2[] = "ParallelMapDatasetV2";
+constexpr char kBatchDataset[] = "BatchDataset";
+constexpr char kBatchDatasetV2[] = "BatchDatasetV2";
+constexpr char kOutputShapes[] = "output_shapes";
+constexpr char kOutputTypes[] = "output_types";
+constexpr char kOutputShapesHint[] = "_output_shapes";
+
+bool IsMapDataset(const NodeDef& node) {
+  return node.op() == kMapDataset || node.op() == kParallelMapDataset ||
+         node.op() == kParallelMapDatasetV2;
+}
+
+bool IsBatchDataset(const NodeDef& node) {
+  return node.op() == kBatchDataset || node.op() == kBatchDatasetV2;
+}
+
+// Ops whose single output has the shape of their single input and whose
+// value at each position only depends on the input at that position.
+bool IsUnaryElementwise(const NodeDef& node) {
+  static const auto* const kOps = new absl::flat_hash_set<std::string>{
+      "Abs",   "Cast",    "Ceil",     "Cos",        "Erf",        "Exp",
+      "Expm1", "Floor",   "Identity", "IsFinite",   "IsNan",      "Log",
+      "Log1p", "Neg",     "Relu",     "LogicalNot", "Reciprocal", "Relu6",
+      "Rint",  "Round",   "Rsqrt",    "Sigmoid",    "Sign",       "Sin",
+      "Sqrt",  "Square",  "Tanh"};
+  return kOps->contains(node.op());
+}
+
+// Binary ops that are elementwise when one of their operands is a scalar.
+bool IsBinaryElementwise(const NodeDef& node) {
+  static const auto* const kOps = new absl::flat_hash_set<std::string>{
+      "Add",        "AddV2",     "Div",          "DivNoNan",
+      "Equal",      "FloorDiv",  "FloorMod",     "Greater",
+      "GreaterEqual", "Less",    "LessEqual",    "LogicalAnd",
+      "LogicalOr",  "Maximum",   "Minimum",      "Mul",
+      "NotEqual",   "Pow",       "RealDiv",      "SquaredDifference",
+      "Sub"};
+  return kOps->contains(node.op());
+}
+
+bool IsScalarConst(const NodeDef& node) {
+  if (node.op() != "Const" || !node.attr().contains("value")) return false;
+  return node.attr().at("value").tensor().tensor_shape().dim_size() == 0;
+}
+
+// Returns the name of the node or function argument that produces `input`,
+// which is a function body input of the form "arg" or "node:output:index".
+absl::string_view ProducerName(absl::string_view input) {
+  return input.substr(0, input.find(':'));
+}
+
+// Returns whether every output of `function` is computed from its arguments
+// using only elementwise operations, optionally combined with scalar
+// constants. Such a function computes the same values when it is applied to a
+// batch of elements as when it is applied to each element separately. Sets
+// `output_args` to the index of the argument whose shape each output has.
+bool IsVectorizable(const FunctionDef& function,
+                    std::vector<int>* output_args) {
+  if (function.signature().is_stateful()) return false;
+  // Values that have the shape of (a component of) the input element, by the
+  // index of the argument they are computed from, and values that are scalar
+  // constants.
+  absl::flat_hash_map<std::string, int> element_values;
+  absl::flat_hash_set<std::string> scalar_values;
+  for (int i = 0; i < function.signature().input_arg_size(); ++i) {
+    element_values[function.signature().input_arg(i).name()] = i;
+  }
+  // Function bodies are not necessarily topologically sorted, so iterate
+  // until no more nodes can be classified.
+  absl::flat_hash_set<std::string> pending;
+  for (const NodeDef& node : function.node_def()) {
+    pending.insert(node.name());
+  }
+  bool changed = true;
+  while (!pending.empty() && changed) {
+    changed = false;
+    for (const NodeDef& node : function.node_def()) {
+      if (!pending.contains(node.name())) continue;
+      if (IsScalarConst(node)) {
+        scalar_values.insert(node.name());
+        pending.erase(node.name());
+        changed = true;
+        continue;
+      }
+      int num_element_inputs = 0;
+      int num_scalar_inputs = 0;
+      int element_arg = -1;
+      bool ready = true;
+      for (const std::string& input : node.input()) {
+        if (IsControlInput(input)) return false;
+        const std::string producer(ProducerName(input));
+        if (auto it = element_values.find(producer);
+            it != element_values.end()) {
+          ++num_element_inputs;
+          element_arg = it->second;
+        } else if (scalar_values.contains(producer)) {
+          ++num_scalar_inputs;
+        } else {
+          ready = false;
+        }
+      }
+      if (!ready) continue;
+      const bool is_elementwise =
+          (IsUnaryElementwise(node) && node.input_size() == 1) ||
+          (IsBinaryElementwise(node) && node.input_size() == 2 &&
+           num_scalar_inputs >= 1);
+      if (!is_elementwise) return false;
+      if (num_element_inputs == 1) {
+        element_values[node.name()] = element_arg;
+      } else {
+        scalar_values.insert(node.name());
+      }
+      pending.erase(node.name());
+      changed = true;
+    }
+  }
+  if (!pending.empty()) return false;
+  // Every output must trace back to an argument. A scalar output would not be
+  // batched by the rewritten pipeline.
+  output_args->clear();
+  for (const auto& output_arg : function.signature().output_arg()) {
+    auto ret = function.ret().find(output_arg.name());
+    if (ret == function.ret().end()) return false;
+    auto it = element_values.find(std::string(ProducerName(ret->second)));
+    if (it == element_values.end()) return false;
+    output_args->push_back(it->second);
+  }
+  return true;
+}
+
+// Returns `shape` with a leading `batch_dim`.
+TensorShapeProto BatchedShape(const TensorShapeProto& shape,
+                              int64_t batch_dim) {
+  if (shape.unknown_rank()) return shape;
+  TensorShapeProto batched;
+  batched.add_dim()->set_size(batch_dim);
+  for (const auto& dim : shape.dim()) {
+    *batched.add_dim() = dim;
+  }
+  return batched;
+}
+
+// Returns a copy of `function` without the shape hints that describe
+// unbatched elements.
+FunctionDef MakeVectorizedFunction(const FunctionDef& function,
+                                   const FunctionDefLibrary& library) {
+  FunctionDef vectorized = function;
+  graph_utils::SetUniqueGraphFunctionName(
+      absl::StrCat("vectorized_", function.signature().name()), &library,
+      &vectorized);
+  for (auto& arg_attr : *vectorized.mutable_arg_attr()) {
+    arg_attr.second.mutable_attr()->erase(kOutputShapesHint);
+  }
+  for (NodeDef& node : *vectorized.mutable_node_def()) {
+    node.mutable_attr()->erase(kOutputShapesHint);
+  }
+  return vectorized;
+}
+
+}  // namespace
+
+absl::Status MapVectorization::OptimizeAndCollectStats(
+    Cluster* cluster, const GrapplerItem& item, GraphDef* output,
+    OptimizationStats* stats) {
+  *output = item.graph;
+  MutableGraphView graph(output);
+  absl::flat_hash_set<string> nodes_to_delete;
+  FunctionLibraryDefinition function_library(OpRegistry::Global(),
+                                             item.graph.library());
+  for (const NodeDef& node : item.graph.node()) {
+    if (!IsBatchDataset(node)) continue;
+
+    // Use a more descriptive variable name now that we know the node type.
+    const NodeDef& batch_node = node;
+    NodeDef* map_node = graph_utils::GetInputNode(batch_node, graph);
+    if (!IsMapDataset(*map_node)) continue;
+    // Captured inputs are not batched, so they are only safe to pass to the
+    // function if they are scalars; conservatively skip such maps.
+    if (map_node->attr().contains("Targuments") &&
+        map_node->attr().at("Targuments").list().type_size() > 0) {
+      continue;
+    }
+    // The map must only feed the batch, since it is removed.
+    if (graph.NumFanouts(*map_node, /*include_controlled_nodes=*/true) != 1) {
+      continue;
+    }
+    const FunctionDef* function =
+        function_library.Find(map_node->attr().at("f").func().name());
+    std::vector<int> output_args;
+    if (function == nullptr || !IsVectorizable(*function, &output_args)) {
+      continue;
+    }
+
+    NodeDef* input_node = graph_utils::GetInputNode(*map_node, graph);
+    if (!input_node->attr().contains(kOutputTypes) ||
+        !input_node->attr().contains(kOutputShapes) ||
+        !batch_node.attr().contains(kOutputShapes) ||
+        !map_node->attr().contains(kOutputTypes)) {
+      continue;
+    }
+    const AttrValue& input_types = input_node->attr().at(kOutputTypes);
+    const AttrValue& input_shapes = input_node->attr().at(kOutputShapes);
+    const AttrValue& batch_shapes = batch_node.attr().at(kOutputShapes);
+    if (input_types.list().type_size() !=
+            function->signature().input_arg_size() ||
+        input_shapes.list().shape_size() != input_types.list().type_size() ||
+        batch_shapes.list().shape_size() == 0 ||
+        batch_shapes.list().shape(0).dim_size() == 0) {
+      continue;
+    }
+    // All the components of a batch share its leading dimension.
+    const int64_t batch_dim = batch_shapes.list().shape(0).dim(0).size();
+
+    // Batch the input of the map.
+    NodeDef new_batch_node = batch_node;
+    graph_utils::SetUniqueGraphNodeName(batch_node.op(), graph.graph(),
+                                        &new_batch_node);
+    new_batch_node.set_input(0, map_node->input(0));
+    (*new_batch_node.mutable_attr())[kOutputTypes] = input_types;
+    AttrValue new_batch_shapes;
+    for (const auto& shape : input_shapes.list().shape()) {
+      *new_batch_shapes.mutable_list()->add_shape() =
+          BatchedShape(shape, batch_dim);
+    }
+    (*new_batch_node.mutable_attr())[kOutputShapes] = new_batch_shapes;
+    auto* new_batch = graph.AddNode(std::move(new_batch_node));
+
+    FunctionDef vectorized_function =
+        MakeVectorizedFunction(*function, output->library());
+    NodeDef new_map_node = *map_node;
+    graph_utils::SetUniqueGraphNodeName(map_node->op(), graph.graph(),
+                                        &new_map_node);
+    new_map_node.set_input(0, new_batch->name());
+    (*new_map_node.mutable_attr())["f"].mutable_func()->set_name(
+        vectorized_function.signature().name());
+    // Elementwise functions give each output the shape of the argument it is
+    // computed from, and the types of the original map outputs.
+    AttrValue& new_map_shapes = (*new_map_node.mutable_attr())[kOutputShapes];
+    new_map_shapes.mutable_list()->clear_shape();
+    for (int arg : output_args) {
+      *new_map_shapes.mutable_list()->add_shape() =
+          new_batch_shapes.list().shape(arg);
+    }
+    graph_utils::CopyAttribute(kOutputTypes, *map_node, &new_map_node);
+    *output->mutable_library()->add_function() = std::move(vectorized_function);
+    auto* new_map = graph.AddNode(std::move(new_map_node));
+
+    TF_RETURN_IF_ERROR(graph.UpdateFanouts(batch_node.name(), new_map->name()));
+    nodes_to_delete.insert(map_node->name());
+    nodes_to_delete.insert(batch_node.name());
+    stats->num_changes++;
+  }
+
+  TF_RETURN_IF_ERROR(graph.DeleteNodes(nodes_to_delete));
+  return absl::OkStatus();
+}
+
+REGISTER_GRAPH_OPTIMIZER_AS(MapVectorization, "map_vectorization");
+
+}  // namespace grappler
+}  // namespace tensorflow
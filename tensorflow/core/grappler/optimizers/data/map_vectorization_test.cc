@@ -0,0 +1,149 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/data/map_vectorization.h"
+
+#include <vector>
+
+#include "tensorflow/core/framework/attr_value_util.h"
+#include "tensorflow/core/framework/function.h"
+#include "tensorflow/core/framework/function_testlib.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/optimizers/data/graph_test_utils.h"
+#include "tensorflow/core/grappler/optimizers/data/graph_utils.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+using graph_tests_utils::MakeBatchV2Node;
+using graph_tests_utils::MakeMapNode;
+using test::function::NDef;
+
+FunctionDef CastToFloat() {
+  return FunctionDefHelper::Define(
+      "CastToFloat", {"x: int64"}, {"y: float"}, {},
+      {{{"y"}, "Cast", {"x"}, {{"SrcT", DT_INT64}, {"DstT", DT_FLOAT}}}});
+}
+
+void SetDatasetAttrs(DataType type, const PartialTensorShape& shape,
+                     NodeDef* node) {
+  SetAttrValue(std::vector<DataType>{type},
+               &(*node->mutable_attr())["output_types"]);
+  SetAttrValue(std::vector<PartialTensorShape>{shape},
+               &(*node->mutable_attr())["output_shapes"]);
+}
+
+string OutputShape(const NodeDef& node) {
+  return PartialTensorShape(node.attr().at("output_shapes").list().shape(0))
+      .DebugString();
+}
+
+GrapplerItem MakeMapAndBatchItem(const string& function_name,
+                                 DataType map_output_type = DT_INT64) {
+  NodeDef map = MakeMapNode("map", "range", function_name);
+  SetDatasetAttrs(map_output_type, PartialTensorShape({}), &map);
+  NodeDef batch = MakeBatchV2Node("batch", "map", "batch_size",
+                                  "drop_remainder", /*parallel_copy=*/false);
+  SetDatasetAttrs(map_output_type, PartialTensorShape({-1}), &batch);
+  GrapplerItem item;
+  item.graph = test::function::GDef(
+      {NDef("start", "Const", {}, {{"value", 0}, {"dtype", DT_INT64}}),
+       NDef("stop", "Const", {}, {{"value", 10}, {"dtype", DT_INT64}}),
+       NDef("step", "Const", {}, {{"value", 1}, {"dtype", DT_INT64}}),
+       NDef("range", "RangeDataset", {"start", "stop", "step"},
+            {{"output_shapes", absl::Span<const TensorShape>{{}}},
+             {"output_types", absl::Span<const DataType>{DT_INT64}}}),
+       map,
+       NDef("batch_size", "Const", {}, {{"value", 5}, {"dtype", DT_INT64}}),
+       NDef("drop_remainder", "Const", {},
+            {{"value", false}, {"dtype", DT_BOOL}}),
+       batch, NDef("Sink", "Identity", {"batch"}, {})},
+      // FunctionLib
+      {
+          test::function::XTimesTwo(),
+          test::function::XAddX(),
+          CastToFloat(),
+      });
+  item.fetch.push_back("Sink");
+  return item;
+}
+
+TEST(MapVectorizationTest, SwapsElementwiseMapWithBatch) {
+  GrapplerItem item = MakeMapAndBatchItem("XTimesTwo");
+  MapVectorization optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  EXPECT_FALSE(graph_utils::ContainsGraphNodeWithName("map", output));
+  EXPECT_FALSE(graph_utils::ContainsGraphNodeWithName("batch", output));
+  const NodeDef& new_map =
+      output.node(graph_utils::FindGraphNodeWithOp("MapDataset", output));
+  const NodeDef& new_batch =
+      output.node(graph_utils::FindGraphNodeWithOp("BatchDatasetV2", output));
+  const NodeDef& sink =
+      output.node(graph_utils::FindGraphNodeWithName("Sink", output));
+  EXPECT_EQ(sink.input(0), new_map.name());
+  EXPECT_EQ(new_map.input(0), new_batch.name());
+  EXPECT_EQ(new_batch.input(0), "range");
+  EXPECT_EQ(new_batch.input(1), "batch_size");
+  EXPECT_EQ(new_batch.input(2), "drop_remainder");
+  EXPECT_EQ(new_batch.attr().at("output_types").list().type(0), DT_INT64);
+  EXPECT_TRUE(graph_utils::ContainsGraphFunctionWithName(
+      new_map.attr().at("f").func().name(), output.library()));
+}
+
+TEST(MapVectorizationTest, SetsTypesAndShapesOfSwappedNodes) {
+  GrapplerItem item = MakeMapAndBatchItem("CastToFloat", DT_FLOAT);
+  MapVectorization optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  const NodeDef& new_map =
+      output.node(graph_utils::FindGraphNodeWithOp("MapDataset", output));
+  const NodeDef& new_batch =
+      output.node(graph_utils::FindGraphNodeWithOp("BatchDatasetV2", output));
+  // The batch now batches the int64 input of the cast.
+  ASSERT_EQ(new_batch.attr().at("output_types").list().type_size(), 1);
+  EXPECT_EQ(new_batch.attr().at("output_types").list().type(0), DT_INT64);
+  ASSERT_EQ(new_batch.attr().at("output_shapes").list().shape_size(), 1);
+  EXPECT_EQ(OutputShape(new_batch), "[?]");
+  ASSERT_EQ(new_map.attr().at("output_types").list().type_size(), 1);
+  EXPECT_EQ(new_map.attr().at("output_types").list().type(0), DT_FLOAT);
+  ASSERT_EQ(new_map.attr().at("output_shapes").list().shape_size(), 1);
+  EXPECT_EQ(OutputShape(new_map), "[?]");
+}
+
+TEST(MapVectorizationTest, KeepsNonElementwiseMap) {
+  // `XAddX` combines two non-scalar values, which is not supported.
+  GrapplerItem item = MakeMapAndBatchItem("XAddX");
+  MapVectorization optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  EXPECT_TRUE(graph_utils::ContainsGraphNodeWithName("map", output));
+  EXPECT_TRUE(graph_utils::ContainsGraphNodeWithName("batch", output));
+  const NodeDef& batch =
+      output.node(graph_utils::FindGraphNodeWithName("batch", output));
+  EXPECT_EQ(batch.input(0), "map");
+}
+
+}  // namespace
+}  // namespace grappler
+}  // namespace tensorflow
@@ -0,0 +1,339 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/dynamic_quantization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/grappler/clusters/cluster.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/op_types.h"
+#include "tensorflow/core/grappler/utils.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/strings/str_util.h"
+#include "tensorflow/core/util/env_var.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+constexpr char kSuffix[] = "DynamicQuantization";
+
+// The default `ensure_minimum_range` of QuantizeV2.
+constexpr float kEnsureMinimumRange = 0.01f;
+
+// Adds or removes entries from `list` if the environment variables for
+// `list_name` are set.
+void UpdateList(const string& list_name, bool allow_add, bool allow_remove,
+                gtl::FlatSet<string>* list) {
+  const string prefix = "TF_DYNAMIC_QUANTIZATION_GRAPH_REWRITE_" + list_name;
+  string to_add, to_remove;
+  if (allow_add) {
+    TF_CHECK_OK(ReadStringFromEnvVar(prefix + "_ADD", "", &to_add));
+  }
+  if (allow_remove) {
+    TF_CHECK_OK(ReadStringFromEnvVar(prefix + "_REMOVE", "", &to_remove));
+  }
+  for (const auto& x : str_util::Split(to_add, ",", str_util::SkipEmpty())) {
+    list->insert(x);
+  }
+  for (const auto& x :
+       str_util::Split(to_remove, ",", str_util::SkipEmpty())) {
+    list->erase(x);
+  }
+}
+
+// Returns the rank of the weights of `node`, or 0 if the attributes of `node`
+// are not supported by its quantized kernel.
+int SupportedWeightsRank(const NodeDef& node) {
+  DataType dtype;
+  if (!TryGetNodeAttr(node, "T", &dtype) || dtype != DT_FLOAT) return 0;
+  if (NumNonControlInputs(node) != 2) return 0;
+  if (IsMatMul(node)) return 2;
+  if (!IsConv2D(node)) return 0;
+
+  // The QuantizedConv2D kernel only supports NHWC, equal strides in the
+  // spatial dimensions and no dilations.
+  string data_format = "NHWC";
+  TryGetNodeAttr(node, "data_format", &data_format);
+  string padding;
+  std::vector<int32> strides;
+  if (data_format != "NHWC" || !TryGetNodeAttr(node, "padding", &padding) ||
+      (padding != "SAME" && padding != "VALID") ||
+      !TryGetNodeAttr(node, "strides", &strides) || strides.size() != 4 ||
+      strides[0] != 1 || strides[3] != 1 || strides[1] != strides[2]) {
+    return 0;
+  }
+  std::vector<int32> dilations;
+  if (TryGetNodeAttr(node, "dilations", &dilations)) {
+    for (int32 dilation : dilations) {
+      if (dilation != 1) return 0;
+    }
+  }
+  return 4;
+}
+
+// Returns true if `node` is a float constant of rank `rank` with finite
+// values, and stores its value in `value`.
+bool GetConstantWeights(const NodeDef* node, int rank, Tensor* value) {
+  if (node == nullptr || !IsConstant(*node) ||
+      NumNonControlInputs(*node) != 0) {
+    return false;
+  }
+  DataType dtype;
+  if (!TryGetNodeAttr(*node, "dtype", &dtype) || dtype != DT_FLOAT ||
+      !node->attr().contains("value") ||
+      !value->FromProto(node->attr().at("value").tensor()) ||
+      value->dims() != rank || value->NumElements() == 0) {
+    return false;
+  }
+  const auto flat = value->flat<float>();
+  for (int64_t i = 0; i < flat.size(); ++i) {
+    if (!std::isfinite(flat(i))) return false;
+  }
+  return true;
+}
+
+// Quantizes `weights` to quint8 the way QuantizeV2 does in MIN_FIRST mode,
+// and measures the error this introduces.
+Tensor QuantizeWeights(const Tensor& weights,
+                       DynamicQuantizationReport* report) {
+  const auto flat = weights.flat<float>();
+  float min_value = 0;
+  float max_value = 0;
+  for (int64_t i = 0; i < flat.size(); ++i) {
+    min_value = std::min(min_value, flat(i));
+    max_value = std::max(max_value, flat(i));
+  }
+  const float epsilon =
+      std::max(1.0f, std::max(std::fabs(min_value), std::fabs(max_value))) *
+      kEnsureMinimumRange;
+  max_value = std::max(max_value, min_value + epsilon);
+
+  const float scale = 255.0f / (max_value - min_value);
+  const float min_rounded = std::round(min_value * scale);
+  Tensor quantized(DT_QUINT8, weights.shape());
+  auto quantized_flat = quantized.flat<quint8>();
+  float max_error = 0;
+  for (int64_t i = 0; i < flat.size(); ++i) {
+    const float q = std::clamp(std::round(flat(i) * scale) - min_rounded,
+                               0.0f, 255.0f);
+    quantized_flat(i) = static_cast<uint8_t>(q);
+    max_error =
+        std::max(max_error, std::fabs(flat(i) - (min_value + q / scale)));
+  }
+  report->weights_min = min_value;
+  report->weights_max = max_value;
+  report->max_weights_error = max_error;
+  return quantized;
+}
+
+NodeDef* AddNode(const string& name, const string& op, const string& device,
+                 GraphDef* graph) {
+  NodeDef* node = graph->add_node();
+  node->set_name(name);
+  node->set_op(op);
+  node->set_device(device);
+  return node;
+}
+
+NodeDef* AddConstant(const string& name, const Tensor& value,
+                     const string& device,
+                     const std::vector<string>& control_inputs,
+                     GraphDef* graph) {
+  NodeDef* node = AddNode(name, "Const", device, graph);
+  for (const string& input : control_inputs) {
+    node->add_input(input);
+  }
+  AddNodeAttr("dtype", value.dtype(), node);
+  value.AsProtoTensorContent(
+      (*node->mutable_attr())["value"].mutable_tensor());
+  return node;
+}
+
+// Replaces `node` with its quantized computation. `node` becomes the
+// Dequantize node at the end of it.
+void Rewrite(const NodeDef& weights, const Tensor& quantized_weights,
+             int rank, const DynamicQuantizationReport& report, NodeDef* node,
+             GraphDef* graph) {
+  const string prefix = absl::StrCat(node->name(), "/", kSuffix, "/");
+  const string device = node->device();
+  const string input = node->input(0);
+
+  // The quantized weights have the same control inputs as the weights, so
+  // they are in the same frame.
+  const std::vector<string> weights_control_inputs(weights.input().begin(),
+                                                   weights.input().end());
+  AddConstant(prefix + "Weights", quantized_weights, device,
+              weights_control_inputs, graph);
+  AddConstant(prefix + "WeightsMin", Tensor(report.weights_min), device,
+              weights_control_inputs, graph);
+  AddConstant(prefix + "WeightsMax", Tensor(report.weights_max), device,
+              weights_control_inputs, graph);
+
+  // The range of the activations is computed over all their elements. The
+  // control input places the axes in the frame of the activations.
+  Tensor axes(DT_INT32, TensorShape({rank}));
+  for (int i = 0; i < rank; ++i) axes.vec<int32>()(i) = i;
+  AddConstant(prefix + "Axes", axes, device,
+              {AsControlDependency(NodeName(input))}, graph);
+  for (const char* reduction : {"Min", "Max"}) {
+    NodeDef* range = AddNode(absl::StrCat(prefix, "Input", reduction),
+                             reduction, device, graph);
+    range->add_input(input);
+    range->add_input(prefix + "Axes");
+    AddNodeAttr("T", DT_FLOAT, range);
+    AddNodeAttr("Tidx", DT_INT32, range);
+    AddNodeAttr("keep_dims", false, range);
+  }
+
+  NodeDef* quantize = AddNode(prefix + "QuantizeInput", "QuantizeV2", device,
+                              graph);
+  quantize->add_input(input);
+  quantize->add_input(prefix + "InputMin");
+  quantize->add_input(prefix + "InputMax");
+  AddNodeAttr("T", DT_QUINT8, quantize);
+  AddNodeAttr("mode", "MIN_FIRST", quantize);
+  AddNodeAttr("round_mode", "HALF_AWAY_FROM_ZERO", quantize);
+  AddNodeAttr("narrow_range", false, quantize);
+  AddNodeAttr("axis", -1, quantize);
+  AddNodeAttr("ensure_minimum_range", kEnsureMinimumRange, quantize);
+
+  const string quantized_name = prefix + "Quantized" + node->op();
+  NodeDef* quantized =
+      AddNode(quantized_name, "Quantized" + node->op(), device, graph);
+  quantized->add_input(prefix + "QuantizeInput");
+  quantized->add_input(prefix + "Weights");
+  quantized->add_input(prefix + "QuantizeInput:1");
+  quantized->add_input(prefix + "QuantizeInput:2");
+  quantized->add_input(prefix + "WeightsMin");
+  quantized->add_input(prefix + "WeightsMax");
+  for (const string& control_input : node->input()) {
+    if (IsControlInput(control_input)) quantized->add_input(control_input);
+  }
+  if (IsMatMul(*node)) {
+    AddNodeAttr("T1", DT_QUINT8, quantized);
+    AddNodeAttr("T2", DT_QUINT8, quantized);
+    AddNodeAttr("Toutput", DT_QINT32, quantized);
+    AddNodeAttr("Tactivation", DT_QUINT8, quantized);
+    for (const char* attr : {"transpose_a", "transpose_b"}) {
+      bool value = false;
+      TryGetNodeAttr(*node, attr, &value);
+      AddNodeAttr(attr, value, quantized);
+    }
+  } else {
+    AddNodeAttr("Tinput", DT_QUINT8, quantized);
+    AddNodeAttr("Tfilter", DT_QUINT8, quantized);
+    AddNodeAttr("out_type", DT_QINT32, quantized);
+    for (const char* attr : {"strides", "padding", "dilations"}) {
+      if (node->attr().contains(attr)) {
+        (*quantized->mutable_attr())[attr] = node->attr().at(attr);
+      }
+    }
+  }
+
+  node->set_op("Dequantize");
+  node->clear_input();
+  node->add_input(quantized_name);
+  node->add_input(quantized_name + ":1");
+  node->add_input(quantized_name + ":2");
+  node->clear_attr();
+  AddNodeAttr("T", DT_QINT32, node);
+  AddNodeAttr("mode", "MIN_FIRST", node);
+  AddNodeAttr("narrow_range", false, node);
+  AddNodeAttr("axis", -1, node);
+  AddNodeAttr("dtype", DT_FLOAT, node);
+}
+
+}  // namespace
+
+gtl::FlatSet<string> DynamicQuantizationLists::AllowList() {
+  // Adding ops is not supported, since the rewrite is specific to each op.
+  gtl::FlatSet<string> list = {"Conv2D", "MatMul"};
+  UpdateList("ALLOWLIST", /*allow_add=*/false, /*allow_remove=*/true, &list);
+  return list;
+}
+
+gtl::FlatSet<string> DynamicQuantizationLists::DenyList() {
+  gtl::FlatSet<string> list;
+  UpdateList("DENYLIST", /*allow_add=*/true, /*allow_remove=*/false, &list);
+  return list;
+}
+
+absl::Status DynamicQuantization::Optimize(Cluster* cluster,
+                                           const GrapplerItem& item,
+                                           GraphDef* optimized_graph) {
+  // Nodes without a device are only quantized when they can only be placed on
+  // the CPU.
+  bool has_gpu = false;
+  if (cluster != nullptr) {
+    for (const auto& device : cluster->GetDevices()) {
+      if (device.second.type() == "GPU") has_gpu = true;
+    }
+  }
+  const gtl::FlatSet<string> allow_list = DynamicQuantizationLists::AllowList();
+  const gtl::FlatSet<string> deny_list = DynamicQuantizationLists::DenyList();
+
+  *optimized_graph = item.graph;
+  NodeMap node_map(optimized_graph);
+  std::vector<DynamicQuantizationReport> reports;
+  const int num_nodes = optimized_graph->node_size();
+  for (int i = 0; i < num_nodes; ++i) {
+    GRAPPLER_RETURN_IF_DEADLINE_EXCEEDED();
+    NodeDef* node = optimized_graph->mutable_node(i);
+    if (!allow_list.contains(node->op()) || deny_list.contains(node->name())) {
+      continue;
+    }
+    if (node->device().empty() ? has_gpu : !NodeIsOnCpu(node)) continue;
+    const int rank = SupportedWeightsRank(*node);
+    if (rank == 0) continue;
+    int weights_port;
+    const NodeDef* weights =
+        node_map.GetNode(ParseNodeName(node->input(1), &weights_port));
+    Tensor weights_value;
+    if (weights_port != 0 ||
+        !GetConstantWeights(weights, rank, &weights_value)) {
+      continue;
+    }
+
+    DynamicQuantizationReport report;
+    report.node_name = node->name();
+    report.op = node->op();
+    const Tensor quantized_weights = QuantizeWeights(weights_value, &report);
+    Rewrite(*weights, quantized_weights, rank, report, node, optimized_graph);
+    VLOG(1) << "Quantized " << report.op << " node " << report.node_name
+            << ": weights range [" << report.weights_min << ", "
+            << report.weights_max << "], max weights error "
+            << report.max_weights_error;
+    reports.push_back(std::move(report));
+  }
+  if (reports.empty()) {
+    return errors::Aborted("Nothing to do.");
+  }
+  if (report_callback_) report_callback_(reports);
+  return absl::OkStatus();
+}
+
+}  // end namespace grappler
+}  // end namespace tensorflow
@@ -0,0 +1,96 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_DYNAMIC_QUANTIZATION_H_
+#define TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_DYNAMIC_QUANTIZATION_H_
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/grappler/optimizers/graph_optimizer.h"
+#include "tensorflow/core/lib/gtl/flatset.h"
+#include "tensorflow/core/protobuf/rewriter_config.pb.h"
+
+namespace tensorflow {
+namespace grappler {
+
+// Describes the quantization of the weights of a rewritten node, so that
+// users can check which layers lose too much accuracy and deny them.
+struct DynamicQuantizationReport {
+  string node_name;
+  string op;
+  // The range of the quantized weights, which always includes zero.
+  float weights_min = 0;
+  float weights_max = 0;
+  // The largest absolute difference between a weight and its quantized value.
+  float max_weights_error = 0;
+};
+
+// Determines which nodes are quantized.
+class DynamicQuantizationLists {
+ public:
+  // Returns the set of ops that are quantized. Ops can be removed by setting
+  // TF_DYNAMIC_QUANTIZATION_GRAPH_REWRITE_ALLOWLIST_REMOVE to a comma separated
+  // list of op names.
+  static gtl::FlatSet<string> AllowList();
+  // Returns the set of node names that are never quantized, typically the
+  // accuracy sensitive first and last layers of a model. Nodes can be added by
+  // setting TF_DYNAMIC_QUANTIZATION_GRAPH_REWRITE_DENYLIST_ADD to a comma
+  // separated list of node names.
+  static gtl::FlatSet<string> DenyList();
+};
+
+// Rewrites float MatMul and Conv2D nodes placed on the CPU whose weights are
+// constants to compute in 8 bits ("dynamic range quantization"). The weights
+// are quantized once, by this optimizer. The range of the activations is only
+// known when the graph runs, so they are quantized on the fly:
+//
+//   x --+-- Min --+
+//       +-- Max --+
+//       +---------+-- QuantizeV2 -- QuantizedMatMul -- Dequantize
+//                                          |
+//                              quantized weights, min, max
+//
+// The Dequantize node takes the name of the original node, so its consumers
+// are unchanged. This trades accuracy for throughput, so it is off by default.
+class DynamicQuantization : public GraphOptimizer {
+ public:
+  // Called with the reports of the nodes quantized by each call to Optimize.
+  using ReportCallback =
+      std::function<void(const std::vector<DynamicQuantizationReport>&)>;
+
+  DynamicQuantization() = default;
+  explicit DynamicQuantization(RewriterConfig::Toggle opt_level,
+                               ReportCallback report_callback = nullptr)
+      : report_callback_(std::move(report_callback)) {}
+
+  ~DynamicQuantization() override = default;
+
+  string name() const override { return "dynamic_quantization"; };
+
+  bool UsesFunctionLibrary() const override { return false; }
+
+  absl::Status Optimize(Cluster* cluster, const GrapplerItem& item,
+                        GraphDef* optimized_graph) override;
+
+ private:
+  ReportCallback report_callback_;
+};
+
+}  // end namespace grappler
+}  // end namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_DYNAMIC_QUANTIZATION_H_
@@ -0,0 +1,162 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/dynamic_quantization.h"
+
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "tensorflow/cc/ops/standard_ops.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/utils/grappler_test.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+constexpr char kCpu[] = "/job:localhost/replica:0/task:0/device:CPU:0";
+constexpr char kGpu[] = "/job:localhost/replica:0/task:0/device:GPU:0";
+
+class DynamicQuantizationTest : public GrapplerTest {
+ protected:
+  // Returns a tensor with values in [0, 1), unlike GenerateRandomTensor whose
+  // values grow with the number of elements.
+  static Tensor RandomTensor(const TensorShape& shape) {
+    Tensor tensor(DT_FLOAT, shape);
+    tensor.flat<float>().setRandom();
+    return tensor;
+  }
+
+  const NodeDef* FindNode(const GraphDef& graph, const string& name) {
+    for (const NodeDef& node : graph.node()) {
+      if (node.name() == name) return &node;
+    }
+    return nullptr;
+  }
+};
+
+TEST_F(DynamicQuantizationTest, QuantizesMatMul) {
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  Output x = ops::Placeholder(s.WithOpName("x").WithDevice(kCpu), DT_FLOAT,
+                              ops::Placeholder::Shape({4, 16}));
+  Output w = ops::Const(s.WithOpName("w").WithDevice(kCpu),
+                        Input::Initializer(RandomTensor({8, 16})));
+  Output matmul = ops::MatMul(s.WithOpName("matmul").WithDevice(kCpu), x, w,
+                              ops::MatMul::TransposeB(true));
+  Output y = ops::Identity(s.WithOpName("y").WithDevice(kCpu), matmul);
+
+  GrapplerItem item;
+  item.fetch = {"y"};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  std::vector<DynamicQuantizationReport> reports;
+  DynamicQuantization optimizer(
+      RewriterConfig::ON,
+      [&reports](const std::vector<DynamicQuantizationReport>& r) {
+        reports = r;
+      });
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(/*cluster=*/nullptr, item, &output));
+
+  const NodeDef* dequantize = FindNode(output, "matmul");
+  ASSERT_NE(dequantize, nullptr);
+  EXPECT_EQ(dequantize->op(), "Dequantize");
+  const NodeDef* quantized =
+      FindNode(output, "matmul/DynamicQuantization/QuantizedMatMul");
+  ASSERT_NE(quantized, nullptr);
+  EXPECT_TRUE(quantized->attr().at("transpose_b").b());
+
+  ASSERT_EQ(reports.size(), 1);
+  EXPECT_EQ(reports[0].node_name, "matmul");
+  EXPECT_LE(reports[0].weights_min, 0);
+  EXPECT_GE(reports[0].weights_max, 0);
+  EXPECT_LE(reports[0].max_weights_error,
+            (reports[0].weights_max - reports[0].weights_min) / 255);
+
+  Tensor x_value = RandomTensor({4, 16});
+  auto expected = EvaluateNodes(item.graph, item.fetch, {{"x", x_value}});
+  auto actual = EvaluateNodes(output, item.fetch, {{"x", x_value}});
+  ASSERT_EQ(expected.size(), 1);
+  ASSERT_EQ(actual.size(), 1);
+  test::ExpectTensorNear<float>(actual[0], expected[0], 0.1);
+}
+
+TEST_F(DynamicQuantizationTest, QuantizesConv2D) {
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  Output x = ops::Placeholder(s.WithOpName("x").WithDevice(kCpu), DT_FLOAT,
+                              ops::Placeholder::Shape({1, 6, 6, 3}));
+  Output w = ops::Const(s.WithOpName("w").WithDevice(kCpu),
+                        Input::Initializer(RandomTensor({3, 3, 3, 4})));
+  Output conv = ops::Conv2D(s.WithOpName("conv").WithDevice(kCpu), x, w,
+                            {1, 1, 1, 1}, "SAME");
+  Output y = ops::Identity(s.WithOpName("y").WithDevice(kCpu), conv);
+
+  GrapplerItem item;
+  item.fetch = {"y"};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  DynamicQuantization optimizer(RewriterConfig::ON);
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(/*cluster=*/nullptr, item, &output));
+  ASSERT_NE(FindNode(output, "conv/DynamicQuantization/QuantizedConv2D"),
+            nullptr);
+
+  Tensor x_value = RandomTensor({1, 6, 6, 3});
+  auto expected = EvaluateNodes(item.graph, item.fetch, {{"x", x_value}});
+  auto actual = EvaluateNodes(output, item.fetch, {{"x", x_value}});
+  ASSERT_EQ(expected.size(), 1);
+  ASSERT_EQ(actual.size(), 1);
+  test::ExpectTensorNear<float>(actual[0], expected[0], 0.2);
+}
+
+TEST_F(DynamicQuantizationTest, SkipsUnsupportedNodes) {
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  Output x = ops::Placeholder(s.WithOpName("x").WithDevice(kCpu), DT_FLOAT,
+                              ops::Placeholder::Shape({4, 8}));
+  Output w = ops::Const(s.WithOpName("w").WithDevice(kCpu),
+                        Input::Initializer(RandomTensor({8, 8})));
+  // The weights are not constant.
+  Output a = ops::MatMul(s.WithOpName("a").WithDevice(kCpu), x, x,
+                         ops::MatMul::TransposeB(true));
+  // The node is not on the CPU.
+  Output b = ops::MatMul(s.WithOpName("b").WithDevice(kGpu), x, w);
+  // Strided convolutions in the batch dimension are not supported.
+  Output image =
+      ops::Placeholder(s.WithOpName("image").WithDevice(kCpu), DT_FLOAT,
+                       ops::Placeholder::Shape({2, 4, 4, 8}));
+  Output filter = ops::Const(s.WithOpName("filter").WithDevice(kCpu),
+                             Input::Initializer(RandomTensor({1, 1, 8, 8})));
+  Output c = ops::Conv2D(s.WithOpName("c").WithDevice(kCpu), image, filter,
+                         {2, 1, 1, 1}, "VALID");
+
+  GrapplerItem item;
+  item.fetch = {"a", "b", "c"};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  DynamicQuantization optimizer(RewriterConfig::ON);
+  GraphDef output;
+  absl::Status status =
+      optimizer.Optimize(/*cluster=*/nullptr, item, &output);
+  EXPECT_TRUE(absl::IsAborted(status)) << status;
+}
+
+}  // namespace
+}  // namespace grappler
+}  // namespace tensorflow
@@ -0,0 +1,178 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/function_optimization_cache.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "tensorflow/core/framework/function.h"
+#include "tensorflow/core/framework/function.pb.h"
+#include "tensorflow/core/lib/strings/proto_serialization.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/hash.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/path.h"
+#include "tensorflow/core/platform/random.h"
+#include "tensorflow/core/protobuf/rewriter_config.pb.h"
+#include "tensorflow/core/util/env_var.h"
+
+namespace tensorflow {
+namespace grappler {
+
+FunctionOptimizationCache::FunctionOptimizationCache(Env* env,
+                                                     size_t max_entries,
+                                                     std::string directory)
+    : env_(env), max_entries_(max_entries), directory_(std::move(directory)) {}
+
+FunctionOptimizationCache* FunctionOptimizationCache::Global() {
+  static FunctionOptimizationCache* cache = []() {
+    int64_t max_entries = 0;
+    TF_CHECK_OK(ReadInt64FromEnvVar("TF_GRAPPLER_FUNCTION_CACHE_SIZE",
+                                    /*default_val=*/0, &max_entries));
+    std::string directory;
+    TF_CHECK_OK(ReadStringFromEnvVar("TF_GRAPPLER_FUNCTION_CACHE_DIR",
+                                     /*default_val=*/"", &directory));
+    if (max_entries <= 0 && directory.empty()) {
+      return static_cast<FunctionOptimizationCache*>(nullptr);
+    }
+    if (!directory.empty()) {
+      absl::Status s = Env::Default()->RecursivelyCreateDir(directory);
+      if (!s.ok()) {
+        LOG(WARNING) << "Not caching optimized functions in " << directory
+                     << ": " << s;
+        directory.clear();
+        if (max_entries <= 0) {
+          return static_cast<FunctionOptimizationCache*>(nullptr);
+        }
+      }
+    }
+    return new FunctionOptimizationCache(
+        Env::Default(), std::max<int64_t>(max_entries, 0), directory);
+  }();
+  return cache;
+}
+
+uint64_t FunctionOptimizationCache::Key(
+    const FunctionDef& func, const FunctionLibraryDefinition& flib,
+    int graph_def_version, const RewriterConfig& config,
+    const std::vector<std::string>& devices,
+    bool allow_non_differentiable_rewrites, bool is_tpu_graph) {
+  uint64_t key = DeterministicProtoHash64(func);
+
+  // Optimization may inline or specialize the functions `func` calls, so they
+  // are part of the key. Sorts them, since the library order is arbitrary.
+  FunctionLibraryDefinition reachable = flib.ReachableDefinitions(func);
+  std::vector<std::string> function_names = reachable.ListFunctionNames();
+  std::sort(function_names.begin(), function_names.end());
+  for (const std::string& name : function_names) {
+    key = Hash64Combine(key, DeterministicProtoHash64(*reachable.Find(name)));
+    key = Hash64Combine(key, Hash64(reachable.FindGradient(name)));
+  }
+
+  std::vector<std::string> sorted_devices = devices;
+  std::sort(sorted_devices.begin(), sorted_devices.end());
+  for (const std::string& device : sorted_devices) {
+    key = Hash64Combine(key, Hash64(device));
+  }
+  key = Hash64Combine(key, DeterministicProtoHash64(config));
+  key = Hash64Combine(key, graph_def_version);
+  key = Hash64Combine(key, allow_non_differentiable_rewrites);
+  return Hash64Combine(key, is_tpu_graph);
+}
+
+std::optional<FunctionDefLibrary> FunctionOptimizationCache::Lookup(
+    uint64_t key) {
+  {
+    mutex_lock l(mu_);
+    auto it = results_.find(key);
+    if (it != results_.end()) {
+      return it->second;
+    }
+  }
+  if (directory_.empty()) {
+    return std::nullopt;
+  }
+
+  const std::string filename = FileName(key);
+  if (!env_->FileExists(filename).ok()) {
+    return std::nullopt;
+  }
+  FunctionDefLibrary result;
+  absl::Status s = ReadBinaryProto(env_, filename, &result);
+  if (!s.ok() || result.function_size() == 0) {
+    LOG(WARNING) << "Failed to read cached optimized function " << filename
+                 << ": " << s;
+    return std::nullopt;
+  }
+  mutex_lock l(mu_);
+  InsertInMemory(key, result);
+  return result;
+}
+
+void FunctionOptimizationCache::Insert(uint64_t key,
+                                       const FunctionDefLibrary& result) {
+  {
+    mutex_lock l(mu_);
+    InsertInMemory(key, result);
+  }
+  if (directory_.empty()) {
+    return;
+  }
+
+  // Writes to a temporary file first so that concurrent readers never see a
+  // partially written result.
+  const std::string filename = FileName(key);
+  const std::string temp_filename =
+      absl::StrCat(filename, ".tmp.", random::New64());
+  absl::Status s = WriteBinaryProto(env_, temp_filename, result);
+  if (s.ok()) {
+    s = env_->RenameFile(temp_filename, filename);
+  }
+  if (!s.ok()) {
+    LOG(WARNING) << "Failed to cache optimized function in " << filename
+                 << ": " << s;
+    env_->DeleteFile(temp_filename).IgnoreError();
+  }
+}
+
+std::string FunctionOptimizationCache::FileName(uint64_t key) const {
+  return io::JoinPath(directory_,
+                      absl::StrCat(absl::Hex(key, absl::kZeroPad16), ".pb"));
+}
+
+void FunctionOptimizationCache::InsertInMemory(
+    uint64_t key, const FunctionDefLibrary& result) {
+  if (max_entries_ == 0 || results_.contains(key)) {
+    return;
+  }
+  while (results_.size() >= max_entries_) {
+    results_.erase(keys_.front());
+    keys_.pop_front();
+  }
+  results_[key] = result;
+  keys_.push_back(key);
+}
+
+}  // namespace grappler
+}  // namespace tensorflow
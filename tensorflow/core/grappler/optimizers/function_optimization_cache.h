@@ -0,0 +1,98 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_FUNCTION_OPTIMIZATION_CACHE_H_
+#define TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_FUNCTION_OPTIMIZATION_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "tensorflow/core/framework/function.h"
+#include "tensorflow/core/framework/function.pb.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/protobuf/rewriter_config.pb.h"
+
+namespace tensorflow {
+namespace grappler {
+
+// Caches the results of optimizing function bodies in the MetaOptimizer, so
+// that functions that have not changed are not optimized again when a model is
+// traced again or a new session is created.
+//
+// A cached result is a `FunctionDefLibrary` whose first function is the
+// optimized function, followed by the specialized functions its optimization
+// added to the library.
+//
+// FunctionOptimizationCache is thread-safe.
+class FunctionOptimizationCache {
+ public:
+  // Creates a cache that holds up to `max_entries` results in memory. If
+  // `directory` is not empty, results are also stored in files there, which
+  // are shared by all processes that use the same directory.
+  FunctionOptimizationCache(Env* env, size_t max_entries,
+                            std::string directory);
+
+  // Returns the process-wide cache, or nullptr if caching is disabled. The
+  // in-memory cache is enabled by setting TF_GRAPPLER_FUNCTION_CACHE_SIZE to
+  // a positive number of entries, and the on-disk one by setting
+  // TF_GRAPPLER_FUNCTION_CACHE_DIR.
+  static FunctionOptimizationCache* Global();
+
+  // Returns the key of the result of optimizing `func`. It covers everything
+  // that optimization depends on: the function and the functions it calls,
+  // the graph version, the optimizer config, the devices, and whether the
+  // optimization may be non-differentiable.
+  static uint64_t Key(const FunctionDef& func,
+                      const FunctionLibraryDefinition& flib,
+                      int graph_def_version, const RewriterConfig& config,
+                      const std::vector<std::string>& devices,
+                      bool allow_non_differentiable_rewrites,
+                      bool is_tpu_graph);
+
+  // Returns the result cached under `key`, if any.
+  std::optional<FunctionDefLibrary> Lookup(uint64_t key) TF_LOCKS_EXCLUDED(mu_);
+
+  // Caches `result` under `key`. Failures to write to disk are logged and
+  // otherwise ignored.
+  void Insert(uint64_t key, const FunctionDefLibrary& result)
+      TF_LOCKS_EXCLUDED(mu_);
+
+ private:
+  std::string FileName(uint64_t key) const;
+  void InsertInMemory(uint64_t key, const FunctionDefLibrary& result)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  Env* const env_;
+  const size_t max_entries_;
+  const std::string directory_;
+
+  mutex mu_;
+  absl::flat_hash_map<uint64_t, FunctionDefLibrary> results_
+      TF_GUARDED_BY(mu_);
+  // Keys in insertion order, to evict the oldest results first.
+  std::deque<uint64_t> keys_ TF_GUARDED_BY(mu_);
+};
+
+}  // namespace grappler
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_FUNCTION_OPTIMIZATION_CACHE_H_
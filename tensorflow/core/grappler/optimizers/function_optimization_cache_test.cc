@@ -0,0 +1,126 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/function_optimization_cache.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/function.h"
+#include "tensorflow/core/framework/function.pb.h"
+#include "tensorflow/core/framework/function_testlib.h"
+#include "tensorflow/core/framework/op.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/path.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/protobuf/rewriter_config.pb.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+FunctionDefLibrary MakeLibrary(const std::vector<FunctionDef>& functions) {
+  FunctionDefLibrary library;
+  for (const FunctionDef& function : functions) {
+    *library.add_function() = function;
+  }
+  return library;
+}
+
+uint64_t KeyOfXTimesFour(const FunctionDefLibrary& library,
+                         const RewriterConfig& config) {
+  FunctionLibraryDefinition flib(OpRegistry::Global(), library);
+  return FunctionOptimizationCache::Key(
+      *flib.Find("XTimesFour"), flib, /*graph_def_version=*/1, config,
+      /*devices=*/{"/device:CPU:0"},
+      /*allow_non_differentiable_rewrites=*/true, /*is_tpu_graph=*/false);
+}
+
+TEST(FunctionOptimizationCacheTest, KeyIgnoresUnreachableFunctions) {
+  RewriterConfig config;
+  EXPECT_EQ(KeyOfXTimesFour(MakeLibrary({test::function::XTimesFour(),
+                                         test::function::XTimesTwo()}),
+                            config),
+            KeyOfXTimesFour(MakeLibrary({test::function::XTimesTwoInt32(),
+                                         test::function::XTimesTwo(),
+                                         test::function::XTimesFour()}),
+                            config));
+}
+
+TEST(FunctionOptimizationCacheTest, KeyDependsOnCallees) {
+  RewriterConfig config;
+  FunctionDef modified_callee = test::function::XTimesTwo();
+  (*modified_callee.mutable_attr())["_noinline"].set_b(true);
+  EXPECT_NE(KeyOfXTimesFour(MakeLibrary({test::function::XTimesFour(),
+                                         test::function::XTimesTwo()}),
+                            config),
+            KeyOfXTimesFour(
+                MakeLibrary({test::function::XTimesFour(), modified_callee}),
+                config));
+}
+
+TEST(FunctionOptimizationCacheTest, KeyDependsOnConfig) {
+  const FunctionDefLibrary library = MakeLibrary(
+      {test::function::XTimesFour(), test::function::XTimesTwo()});
+  RewriterConfig config;
+  RewriterConfig other_config;
+  other_config.set_constant_folding(RewriterConfig::OFF);
+  EXPECT_NE(KeyOfXTimesFour(library, config),
+            KeyOfXTimesFour(library, other_config));
+}
+
+TEST(FunctionOptimizationCacheTest, InMemory) {
+  FunctionOptimizationCache cache(Env::Default(), /*max_entries=*/1,
+                                  /*directory=*/"");
+  const FunctionDefLibrary result = MakeLibrary({test::function::XTimesTwo()});
+  EXPECT_EQ(cache.Lookup(1), std::nullopt);
+  cache.Insert(1, result);
+  std::optional<FunctionDefLibrary> cached = cache.Lookup(1);
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_EQ(cached->function(0).signature().name(), "XTimesTwo");
+
+  // Evicts the oldest result.
+  cache.Insert(2, result);
+  EXPECT_EQ(cache.Lookup(1), std::nullopt);
+  EXPECT_TRUE(cache.Lookup(2).has_value());
+}
+
+TEST(FunctionOptimizationCacheTest, OnDisk) {
+  const std::string directory =
+      io::JoinPath(testing::TmpDir(), "function_optimization_cache");
+  TF_ASSERT_OK(Env::Default()->RecursivelyCreateDir(directory));
+  const FunctionDefLibrary result = MakeLibrary(
+      {test::function::XTimesFour(), test::function::XTimesTwo()});
+  FunctionOptimizationCache writer(Env::Default(), /*max_entries=*/0,
+                                   directory);
+  writer.Insert(3, result);
+
+  // Another process sharing the directory finds the result.
+  FunctionOptimizationCache reader(Env::Default(), /*max_entries=*/10,
+                                   directory);
+  std::optional<FunctionDefLibrary> cached = reader.Lookup(3);
+  ASSERT_TRUE(cached.has_value());
+  ASSERT_EQ(cached->function_size(), 2);
+  EXPECT_EQ(cached->function(0).signature().name(), "XTimesFour");
+  EXPECT_EQ(cached->function(1).signature().name(), "XTimesTwo");
+  EXPECT_EQ(reader.Lookup(4), std::nullopt);
+}
+
+}  // namespace
+}  // namespace grappler
+}  // namespace tensorflow
@@ -34,6 +34,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/status_test_util.h"
 #include "tensorflow/core/platform/tensor_float_32_utils.h"
 #include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/util/util.h"
 
 namespace tensorflow {
 namespace grappler {
@@ -385,6 +386,50 @@ TEST_F(GenericLayoutOptimizerTest, CPUDevice) {
 #endif  // (GOOGLE_CUDA || TENSORFLOW_USE_ROCM)
 }
 
+TEST_F(GenericLayoutOptimizerTest, CPUDeviceNHWCToNCHW) {
+#if (GOOGLE_CUDA || TENSORFLOW_USE_ROCM)
+  GTEST_SKIP() << "Only runs without a GPU";
+#endif  // (GOOGLE_CUDA || TENSORFLOW_USE_ROCM)
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  Tensor input_data(DT_FLOAT, TensorShape({8, 4, 4, 3}));
+  test::FillIota<float>(&input_data, 1.0f);
+  Output input =
+      ops::Const(s.WithOpName("Input"), Input::Initializer(input_data));
+  Tensor filter_data(DT_FLOAT, TensorShape({2, 2, 3, 4}));
+  test::FillIota<float>(&filter_data, 1.0f);
+  Output filter =
+      ops::Const(s.WithOpName("Filter"), Input::Initializer(filter_data));
+  Output conv = ops::Conv2D(s.WithOpName("Conv2D").WithDevice("/CPU:0"),
+                            input, filter, {1, 1, 1, 1}, "VALID");
+  // There is no oneDNN kernel of DepthToSpace, so it stays in NHWC.
+  Output depth_to_space = ops::DepthToSpace(
+      s.WithOpName("DepthToSpace").WithDevice("/CPU:0"), conv, 2);
+  Output fetch = ops::Identity(s.WithOpName("Fetch"), {depth_to_space});
+  GrapplerItem item;
+  item.fetch.push_back("Fetch");
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  GenericLayoutOptimizer optimizer(RewriterConfig::DEFAULT,
+                                   RewriterConfig::NHWC_TO_NCHW);
+  GraphDef output;
+  absl::Status status =
+      optimizer.Optimize(virtual_cluster_.get(), item, &output);
+  if (!IsMKLEnabled()) {
+    EXPECT_TRUE(absl::IsAborted(status)) << status;
+    return;
+  }
+  TF_ASSERT_OK(status);
+
+  utils::GraphView graph_view(&output, &status);
+  TF_ASSERT_OK(status);
+  auto* conv_node = graph_view.GetNode("Conv2D");
+  ASSERT_NE(conv_node, nullptr);
+  VerifyDataFormatAttributeMatch(conv_node, "NCHW");
+  auto* depth_to_space_node = graph_view.GetNode("DepthToSpace");
+  ASSERT_NE(depth_to_space_node, nullptr);
+  VerifyDataFormatAttributeMatch(depth_to_space_node, "NHWC");
+}
+
 TEST_F(GenericLayoutOptimizerTest, NoOptimizeIntegerConvolution) {
   tensorflow::Scope s = tensorflow::Scope::NewRootScope();
   auto conv = SimpleConv2D<int32>(&s, 4, 2, "VALID", "");
@@ -20,6 +20,7 @@ limitations under the License.
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/strings/ascii.h"
 #include "absl/strings/match.h"
 #include "absl/strings/numbers.h"
@@ -28,6 +29,7 @@ limitations under the License.
 #include "tensorflow/core/framework/graph.pb.h"
 #include "tensorflow/core/framework/memory_types.h"
 #include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/node_def_util.h"
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/framework/tensor_shape.pb.h"
 #include "tensorflow/core/framework/types.h"
@@ -40,6 +42,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/protobuf/device_properties.pb.h"
 #include "tensorflow/core/util/device_name_utils.h"
+#include "tensorflow/core/util/util.h"
 
 namespace tensorflow {
 namespace grappler {
@@ -233,6 +236,33 @@ class ScopedDataFormatUpgrader {
   std::string old_dst_format_;
 };
 
+// Returns true if the CPU kernel of the layout sensitive `node` supports the
+// channels-first formats NCHW and NCDHW. BiasAdd supports them everywhere, the
+// other ops only through their oneDNN kernels, which are used for float and
+// bfloat16 nodes.
+bool SupportsChannelsFirstOnCpu(const NodeDef& node) {
+  if (IsBiasAddV2(node) || IsBiasAddGrad(node)) {
+    return true;
+  }
+  static const absl::flat_hash_set<string>* onednn_ops =
+      new absl::flat_hash_set<string>(
+          {"AvgPool", "AvgPoolGrad", "Conv2D", "Conv2DBackpropFilter",
+           "Conv2DBackpropInput", "Conv3D", "Conv3DBackpropFilterV2",
+           "Conv3DBackpropInputV2", "DepthwiseConv2dNative",
+           "DepthwiseConv2dNativeBackpropFilter",
+           "DepthwiseConv2dNativeBackpropInput", "FusedBatchNorm",
+           "FusedBatchNormGrad", "FusedBatchNormGradV2", "FusedBatchNormGradV3",
+           "FusedBatchNormV2", "FusedBatchNormV3", "MaxPool", "MaxPool3D"});
+  if (!IsMKLEnabled() || !onednn_ops->contains(node.op())) {
+    return false;
+  }
+  DataType dtype;
+  if (!TryGetNodeAttr(node, "T", &dtype)) {
+    return false;
+  }
+  return dtype == DT_FLOAT || dtype == DT_BFLOAT16;
+}
+
 }  // namespace
 
 // TransposeContext.
@@ -288,12 +318,18 @@ bool Transposer::ShouldProcess(const TransposeContext& context,
   const bool data_format_match = !IsLayoutSensitiveOp(*node_def) ||
                                  AttrDataFormatMatch(node, context.src_format);
 
+  // Most CPU kernels only support channels-last formats.
+  const bool dst_format_supported =
+      !IsLayoutSensitiveOp(*node_def) || context.target_device != kCPU ||
+      !absl::StartsWith(context.dst_format, "NC") ||
+      SupportsChannelsFirstOnCpu(*node_def);
+
   // Only transposes floating point nodes.
   const bool is_integer_conv2d = IsNonFloatingConv2D(node);
   const bool is_integer_conv3d = IsNonFloatingConv3D(node);
 
-  return is_on_target_device && data_format_match && !is_integer_conv2d &&
-         !is_integer_conv3d &&
+  return is_on_target_device && data_format_match && dst_format_supported &&
+         !is_integer_conv2d && !is_integer_conv3d &&
          !context.nodes_to_preserve.contains(node_def->name()) &&
          !(node.NumRegularFanouts() == 0 && node.NumControlledFanouts() == 0);
 }
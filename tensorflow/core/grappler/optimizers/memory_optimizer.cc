@@ -16,10 +16,14 @@ limitations under the License.
 #include "tensorflow/core/grappler/optimizers/memory_optimizer.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
 #include <queue>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "tensorflow/core/framework/attr_value.pb.h"
@@ -440,8 +444,104 @@ void RecomputeSubgraph(
   }
 }
 
+// Keeps only the subgraphs in `subgraphs` that are needed to bring the
+// estimated peak memory usage of every device under `memory_budget_bytes`.
+// Recomputing a subgraph saves the memory of the tensors it produces that are
+// live at the peak, and costs roughly one op execution per recomputed node, so
+// subgraphs are picked greedily by decreasing savings per recomputed node.
+void SelectRecomputationsWithinBudget(
+    Cluster* cluster, const GrapplerItem& item, int64_t memory_budget_bytes,
+    std::vector<RecomputedSubGraph>* subgraphs) {
+  GraphMemory memory(item);
+  absl::Status s = memory.InferStatically(cluster->GetDevices());
+  if (!s.ok()) {
+    VLOG(1) << "Failed to infer memory usage, recomputing all candidates: "
+            << s.message();
+    return;
+  }
+
+  std::unordered_map<string, int> subgraph_of_node;
+  for (int i = 0; i < subgraphs->size(); ++i) {
+    for (const NodeDef* node : (*subgraphs)[i].recomputed_source_nodes) {
+      subgraph_of_node.emplace(node->name(), i);
+    }
+  }
+  // Bytes saved on each device by recomputing each subgraph.
+  std::vector<std::unordered_map<string, int64_t>> savings(subgraphs->size());
+  std::map<string, int64_t> peak_memory;
+  std::unordered_map<string, int64_t> required_savings;
+  for (const auto& device : cluster->GetDevices()) {
+    const string& name = device.first;
+    const GraphMemory::MemoryUsage& mem_usage = memory.GetPeakMemoryUsage(name);
+    if (mem_usage.used_memory <= memory_budget_bytes) {
+      continue;
+    }
+    peak_memory[name] = mem_usage.used_memory;
+    required_savings[name] = mem_usage.used_memory - memory_budget_bytes;
+    for (const auto& live_tensor : mem_usage.live_tensors) {
+      auto it = subgraph_of_node.find(live_tensor.node);
+      if (it != subgraph_of_node.end()) {
+        savings[it->second][name] += live_tensor.memory_used;
+      }
+    }
+  }
+
+  std::vector<int> order;
+  std::vector<double> savings_per_node(subgraphs->size(), 0.0);
+  for (int i = 0; i < subgraphs->size(); ++i) {
+    if (savings[i].empty()) {
+      continue;
+    }
+    int64_t total_savings = 0;
+    for (const auto& device_savings : savings[i]) {
+      total_savings += device_savings.second;
+    }
+    savings_per_node[i] = static_cast<double>(total_savings) /
+                          (*subgraphs)[i].recomputed_source_nodes.size();
+    order.push_back(i);
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [&savings_per_node](int first, int second) {
+                     return savings_per_node[first] > savings_per_node[second];
+                   });
+
+  std::vector<RecomputedSubGraph> selected;
+  for (int i : order) {
+    bool needed = false;
+    for (const auto& device_savings : savings[i]) {
+      if (required_savings[device_savings.first] > 0) {
+        needed = true;
+        break;
+      }
+    }
+    if (!needed) {
+      continue;
+    }
+    for (const auto& device_savings : savings[i]) {
+      required_savings[device_savings.first] -= device_savings.second;
+    }
+    selected.push_back((*subgraphs)[i]);
+  }
+
+  for (const auto& device_peak : peak_memory) {
+    const string& name = device_peak.first;
+    VLOG(1) << "Estimated peak memory usage on " << name << ": "
+            << device_peak.second << " bytes before recomputation, "
+            << memory_budget_bytes + required_savings[name]
+            << " bytes after (budget " << memory_budget_bytes << ")";
+    if (required_savings[name] > 0) {
+      VLOG(1) << "Recomputation alone can't meet the memory budget on "
+              << name;
+    }
+  }
+  VLOG(1) << "Recomputing " << selected.size() << " of " << subgraphs->size()
+          << " candidate subgraphs to meet the memory budget";
+  subgraphs->swap(selected);
+}
+
 void RecomputationRewritingPass(RewriterConfig::MemOptType optimization_level,
                                 const string& recomputation_targets_name_scope,
+                                Cluster* cluster, int64_t memory_budget_bytes,
                                 GraphDef* graph, const GrapplerItem& item) {
   // The topological numberings and NodeMap will be stale as soon as we start
   // modifying the graph in RecomputeSubgraph. However, RecomputeSubgraph only
@@ -497,6 +597,13 @@ void RecomputationRewritingPass(RewriterConfig::MemOptType optimization_level,
         },
         is_target);
   }
+  // With a memory budget, only recompute what is needed to fit in it.
+  if (memory_budget_bytes > 0 && cluster != nullptr &&
+      !recomputed_subgraphs.empty()) {
+    GrapplerItem budget_item = item.WithGraph(GraphDef(*graph));
+    SelectRecomputationsWithinBudget(cluster, budget_item, memory_budget_bytes,
+                                     &recomputed_subgraphs);
+  }
   if (!recomputed_subgraphs.empty()) {
     std::unordered_map<const NodeDef*, int> topological_numbering;
     for (int node_number = 0; node_number < graph->node().size();
@@ -742,6 +849,212 @@ bool SchedulingPass(Cluster* cluster, std::unique_ptr<GraphMemory>* memory_ptr,
   return updated_graph;
 }
 
+bool IsOnGpu(const NodeDef& node) {
+  DeviceNameUtils::ParsedName parsed;
+  return DeviceNameUtils::ParseFullName(node.device(), &parsed) &&
+         parsed.has_type && parsed.type == DEVICE_GPU;
+}
+
+// Returns the highest peak memory usage of the GPU devices of `cluster`.
+int64_t MaxGpuPeakMemoryUsage(Cluster* cluster, const GraphMemory& memory) {
+  int64_t max_peak = 0;
+  for (const auto& device : cluster->GetDevices()) {
+    if (device.second.type() != DEVICE_GPU) continue;
+    max_peak = std::max(
+        max_peak, memory.GetPeakMemoryUsage(device.first).used_memory);
+  }
+  return max_peak;
+}
+
+// Computes a topological order of `graph` that greedily keeps the memory used
+// by GPU tensors low: among the nodes that are ready, it always runs the one
+// that allocates the fewest bytes net of the inputs it is the last consumer
+// of. Returns false if the graph has a cycle.
+bool ComputeMinPeakMemoryOrder(const GraphDef& graph,
+                               const GraphProperties& properties,
+                               std::vector<int>* order) {
+  const int num_nodes = graph.node_size();
+  std::unordered_map<string, int> node_index;
+  for (int i = 0; i < num_nodes; ++i) {
+    node_index[graph.node(i).name()] = i;
+  }
+
+  struct TensorInfo {
+    int64_t size = 0;
+    int num_pending_consumers = 0;
+    std::vector<int> consumers;
+  };
+  std::vector<std::vector<TensorInfo>> outputs(num_nodes);
+  for (int i = 0; i < num_nodes; ++i) {
+    const NodeDef& node = graph.node(i);
+    if (!properties.HasOutputProperties(node.name())) continue;
+    const auto& output_properties = properties.GetOutputProperties(node.name());
+    outputs[i].resize(output_properties.size());
+    if (!IsOnGpu(node)) continue;
+    for (size_t port = 0; port < output_properties.size(); ++port) {
+      outputs[i][port].size = CalculateTensorSize(output_properties[port]);
+    }
+  }
+
+  // The tensors each node reads and the nodes it has to wait for.
+  std::vector<std::vector<TensorInfo*>> inputs(num_nodes);
+  std::vector<std::vector<int>> fanouts(num_nodes);
+  std::vector<int> num_pending_fanins(num_nodes, 0);
+  for (int i = 0; i < num_nodes; ++i) {
+    std::unordered_set<int> fanins;
+    for (const string& input : graph.node(i).input()) {
+      const TensorId tensor = ParseTensorName(input);
+      auto it = node_index.find(string(tensor.node()));
+      if (it == node_index.end()) continue;
+      const int fanin = it->second;
+      if (fanins.insert(fanin).second) {
+        fanouts[fanin].push_back(i);
+        ++num_pending_fanins[i];
+      }
+      if (tensor.index() < 0 ||
+          static_cast<size_t>(tensor.index()) >= outputs[fanin].size()) {
+        continue;
+      }
+      TensorInfo* info = &outputs[fanin][tensor.index()];
+      if (std::find(inputs[i].begin(), inputs[i].end(), info) ==
+          inputs[i].end()) {
+        inputs[i].push_back(info);
+        info->consumers.push_back(i);
+        ++info->num_pending_consumers;
+      }
+    }
+  }
+
+  std::vector<bool> scheduled(num_nodes, false);
+  auto net_allocation = [&](int i) {
+    int64_t bytes = 0;
+    for (const TensorInfo& output : outputs[i]) bytes += output.size;
+    for (const TensorInfo* input : inputs[i]) {
+      if (input->num_pending_consumers == 1) bytes -= input->size;
+    }
+    return bytes;
+  };
+
+  // The net allocation of a ready node only decreases as other consumers of
+  // its inputs run, so stale entries are skipped instead of being updated.
+  using Entry = std::pair<int64_t, int>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> ready;
+  std::vector<int64_t> cost(num_nodes, 0);
+  auto push = [&](int i) {
+    cost[i] = net_allocation(i);
+    ready.emplace(cost[i], i);
+  };
+  for (int i = 0; i < num_nodes; ++i) {
+    if (num_pending_fanins[i] == 0) push(i);
+  }
+
+  order->clear();
+  order->reserve(num_nodes);
+  while (!ready.empty()) {
+    const auto [entry_cost, i] = ready.top();
+    ready.pop();
+    if (scheduled[i] || entry_cost != cost[i]) continue;
+    scheduled[i] = true;
+    order->push_back(i);
+    for (TensorInfo* input : inputs[i]) {
+      if (--input->num_pending_consumers != 1) continue;
+      for (int consumer : input->consumers) {
+        if (!scheduled[consumer] && num_pending_fanins[consumer] == 0) {
+          push(consumer);
+        }
+      }
+    }
+    for (int fanout : fanouts[i]) {
+      if (--num_pending_fanins[fanout] == 0) push(fanout);
+    }
+  }
+  return order->size() == static_cast<size_t>(num_nodes);
+}
+
+// Reorders the nodes placed on GPUs to lower their peak memory usage. The
+// order is enforced by chaining the nodes of each GPU with control
+// dependencies, following a single topological order so that the chains of
+// different devices can't form a cycle. A GPU runs its kernels one at a time
+// on its compute stream, so the chain costs little concurrency.
+bool OrderingPass(Cluster* cluster, std::unique_ptr<GraphMemory>* memory_ptr,
+                  GrapplerItem* item) {
+  bool has_gpu_nodes = false;
+  for (const NodeDef& node : item->graph.node()) {
+    // Control dependencies can't cross frames.
+    if (IsControlFlow(node)) return false;
+    has_gpu_nodes |= IsOnGpu(node);
+  }
+  if (!has_gpu_nodes) return false;
+
+  if ((*memory_ptr) == nullptr) {
+    memory_ptr->reset(new GraphMemory(*item));
+    absl::Status s = (*memory_ptr)->InferStatically(cluster->GetDevices());
+    if (!s.ok()) {
+      memory_ptr->reset();
+      VLOG(1) << "Failed to infer memory usage: " << s.message();
+      return false;
+    }
+  }
+  const int64_t original_peak = MaxGpuPeakMemoryUsage(cluster, **memory_ptr);
+
+  GraphProperties properties(*item);
+  absl::Status s =
+      properties.InferStatically(/*assume_valid_feeds=*/false,
+                                 /*aggressive_shape_inference=*/false,
+                                 /*include_tensor_values=*/false);
+  if (!s.ok()) {
+    VLOG(1) << "Failed to infer shapes: " << s.message();
+    return false;
+  }
+  std::vector<int> order;
+  if (!ComputeMinPeakMemoryOrder(item->graph, properties, &order)) {
+    VLOG(1) << "Failed to compute a topological order";
+    return false;
+  }
+
+  std::unordered_set<string> feeds;
+  for (const auto& feed : item->feed) feeds.insert(NodeName(feed.first));
+  GrapplerItem reordered_item(*item);
+  GraphDef& graph = reordered_item.graph;
+  std::unordered_map<string, const NodeDef*> previous_on_device;
+  int num_added = 0;
+  for (int i : order) {
+    NodeDef* node = graph.mutable_node(i);
+    if (!IsOnGpu(*node)) continue;
+    const NodeDef*& previous = previous_on_device[node->device()];
+    if (previous != nullptr && feeds.count(node->name()) == 0) {
+      const bool already_ordered =
+          std::any_of(node->input().begin(), node->input().end(),
+                      [previous](const string& input) {
+                        return NodeName(input) == previous->name();
+                      });
+      if (!already_ordered) {
+        *node->add_input() = AsControlDependency(previous->name());
+        ++num_added;
+      }
+    }
+    previous = node;
+  }
+  if (num_added == 0) return false;
+
+  // Only keep the new order if the simulation agrees that it helps.
+  GraphMemory reordered_memory(reordered_item);
+  s = reordered_memory.InferStatically(cluster->GetDevices());
+  if (!s.ok()) {
+    VLOG(1) << "Failed to infer memory usage: " << s.message();
+    return false;
+  }
+  const int64_t reordered_peak =
+      MaxGpuPeakMemoryUsage(cluster, reordered_memory);
+  if (reordered_peak >= original_peak) return false;
+
+  VLOG(1) << "Added " << num_added
+          << " control dependencies, lowering the peak GPU memory usage from "
+          << original_peak << " to " << reordered_peak << " bytes";
+  item->graph.Swap(&graph);
+  return true;
+}
+
 absl::Status BuildSwapPair(
     NodeDef* node, int input_to_swap,
     const std::unordered_map<string, const NodeDef*>& name_map, GraphDef* graph,
@@ -804,6 +1117,12 @@ struct SwapInfo {
   Costs::NanoSeconds time_to_swap = 0;
 };
 
+// Estimates the time it takes to copy `bytes` between the device and the host.
+// Let's assume we're going to swap over PCIe running at 16 GBps.
+static Costs::NanoSeconds EstimateSwapTime(int64_t bytes) {
+  return Costs::NanoSeconds(bytes / 16);
+}
+
 static const NodeDef* FindSwapInTrigger(
     const NodeDef* node, const SwapInfo& swap_info,
     const std::unordered_map<string, const NodeDef*>& name_map,
@@ -980,8 +1299,8 @@ struct MemInfo {
 };
 
 static bool IdentifySwappingCandidates(
-    Cluster* cluster, GrapplerItem* item,
-    std::unique_ptr<GraphMemory>* memory_ptr,
+    Cluster* cluster, GrapplerItem* item, int64_t memory_budget_bytes,
+    bool skip_unhidden_swaps, std::unique_ptr<GraphMemory>* memory_ptr,
     std::unordered_set<string>* skip_list,
     std::unordered_map<NodeDef*, SwapInfo>* nodes_to_swap) {
   if ((*memory_ptr) == nullptr) {
@@ -1008,10 +1327,14 @@ static bool IdentifySwappingCandidates(
     }
     const GraphMemory::MemoryUsage& mem_usage = memory.GetPeakMemoryUsage(name);
 
-    if (mem_usage.used_memory <= prop.memory_size()) {
+    int64_t memory_limit = prop.memory_size();
+    if (memory_budget_bytes > 0) {
+      memory_limit = std::min(memory_limit, memory_budget_bytes);
+    }
+    if (mem_usage.used_memory <= memory_limit) {
       continue;
     }
-    int64_t required_savings = mem_usage.used_memory - prop.memory_size();
+    int64_t required_savings = mem_usage.used_memory - memory_limit;
 
     std::unordered_map<string, Costs::NanoSeconds> op_completion_times;
     {
@@ -1106,6 +1429,16 @@ static bool IdentifySwappingCandidates(
         mem_info.uses_left.emplace_back(input);
         earliest_use = std::min(earliest_use, it->second);
       }
+      // The tensor has to make it to the host and back between the time it's
+      // generated and the time it's needed again, otherwise the copies can't
+      // be overlapped with the computation and swapping would only slow the
+      // step down.
+      if (skip_unhidden_swaps && valid && !mem_info.uses_left.empty() &&
+          earliest_use - allocation_time <
+              2 * EstimateSwapTime(live_tensor.memory_used)) {
+        VLOG(1) << "Swap can't be hidden: skipping " << live_tensor.node;
+        valid = false;
+      }
       if (valid && !mem_info.uses_left.empty()) {
         // Compute the fitness: we need the tensor to be generated way away of
         // the time of peak memory usage (to ensure there is enough time to swap
@@ -1150,6 +1483,7 @@ static bool IdentifySwappingCandidates(
 }
 
 bool SwappingPass(RewriterConfig::MemOptType optimization_level,
+                  int64_t memory_budget_bytes, bool skip_unhidden_swaps,
                   Cluster* cluster, std::unique_ptr<GraphMemory>* memory,
                   GrapplerItem* item, std::unordered_set<string>* skip_list) {
   std::unordered_map<NodeDef*, SwapInfo> nodes_to_swap;
@@ -1157,7 +1491,8 @@ bool SwappingPass(RewriterConfig::MemOptType optimization_level,
       optimization_level == RewriterConfig::SWAPPING_HEURISTICS ||
       optimization_level == RewriterConfig::HEURISTICS) {
     // Use heuristics to figure out what needs to be swapped;
-    IdentifySwappingCandidates(cluster, item, memory, skip_list,
+    IdentifySwappingCandidates(cluster, item, memory_budget_bytes,
+                               skip_unhidden_swaps, memory, skip_list,
                                &nodes_to_swap);
   }
   // Look for manual annotations in the graph.
@@ -1199,8 +1534,7 @@ bool SwappingPass(RewriterConfig::MemOptType optimization_level,
       const OpInfo::TensorProperties& t = props[input_id];
       bytes_to_swap += CalculateTensorSize(t);
     }
-    // Let's assume we're going to swap over PCIe running at 16 GBps.
-    swap_info.time_to_swap = bytes_to_swap / 16;
+    swap_info.time_to_swap = EstimateSwapTime(bytes_to_swap);
   }
 
   std::unordered_map<const NodeDef*, Costs::NanoSeconds> execution_times;
@@ -1399,9 +1733,9 @@ absl::Status MemoryOptimizer::Optimize(Cluster* cluster,
   RelaxAssignNodes(nodes_to_relax, &optimized_item.graph);
 
   if (run_recomputation_pass) {
-    RecomputationRewritingPass(optimization_level_,
-                               recomputation_targets_name_scope_,
-                               &optimized_item.graph, item);
+    RecomputationRewritingPass(
+        optimization_level_, recomputation_targets_name_scope_, cluster,
+        memory_budget_bytes_, &optimized_item.graph, item);
   }
 
   std::unordered_set<string> skip_list;
@@ -1410,6 +1744,12 @@ absl::Status MemoryOptimizer::Optimize(Cluster* cluster,
   // SchedulingPass() and SwappingPass() rely on defined fetches in order to
   // infer the memory usage, so skip optimization if there are no fetches.
   std::unique_ptr<GraphMemory> memory;
+  if (!item.fetch.empty() && cluster != nullptr &&
+      optimization_level_ == RewriterConfig::ORDERING_HEURISTICS) {
+    GRAPPLER_RETURN_IF_DEADLINE_EXCEEDED();
+    OrderingPass(cluster, &memory, &optimized_item);
+    memory.reset();
+  }
   if (!item.fetch.empty() && cluster != nullptr) {
     bool updated_graph = true;
     for (int i = 0; i < 25 && updated_graph; ++i) {
@@ -1432,8 +1772,9 @@ absl::Status MemoryOptimizer::Optimize(Cluster* cluster,
            optimization_level_ == RewriterConfig::HEURISTICS ||
            optimization_level_ == RewriterConfig::MANUAL) &&
           cluster != nullptr) {
-        if (SwappingPass(optimization_level_, cluster, &memory, &optimized_item,
-                         &skip_list)) {
+        if (SwappingPass(optimization_level_, memory_budget_bytes_,
+                         skip_unhidden_swaps_, cluster, &memory,
+                         &optimized_item, &skip_list)) {
           // Reset the inferred memory usage since the graph changed.
           memory.reset();
           updated_graph = true;
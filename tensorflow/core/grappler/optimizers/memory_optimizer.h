@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_MEMORY_OPTIMIZER_H_
 #define TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_MEMORY_OPTIMIZER_H_
 
+#include <cstdint>
 #include <string>
 #include "tensorflow/core/grappler/clusters/cluster.h"
 #include "tensorflow/core/grappler/grappler_item.h"
@@ -33,11 +34,20 @@ class MemoryOptimizer : public GraphOptimizer {
   // recomputation_targets_name_scope: Name scope for potential outputs of
   //   recomputations. See
   //   RewriterConfig::memory_optimizer_target_node_name_scope.
+  // memory_budget_bytes: If positive, the peak memory usage per device that
+  //   the swapping and recomputation heuristics aim for. See
+  //   RewriterConfig::memory_optimizer_budget_bytes.
+  // skip_unhidden_swaps: Whether the swapping heuristics skip the tensors
+  //   whose copies can't be overlapped with computation. See
+  //   RewriterConfig::memory_optimizer_skip_unhidden_swaps.
   explicit MemoryOptimizer(
       RewriterConfig::MemOptType optimization_level,
-      const string& recomputation_targets_name_scope = "gradients/")
+      const string& recomputation_targets_name_scope = "gradients/",
+      int64_t memory_budget_bytes = 0, bool skip_unhidden_swaps = false)
       : optimization_level_(optimization_level),
-        recomputation_targets_name_scope_(recomputation_targets_name_scope) {}
+        recomputation_targets_name_scope_(recomputation_targets_name_scope),
+        memory_budget_bytes_(memory_budget_bytes),
+        skip_unhidden_swaps_(skip_unhidden_swaps) {}
   ~MemoryOptimizer() override {}
 
   string name() const override { return "memory_optimizer"; };
@@ -50,6 +60,8 @@ class MemoryOptimizer : public GraphOptimizer {
  private:
   RewriterConfig::MemOptType optimization_level_;
   string recomputation_targets_name_scope_;
+  int64_t memory_budget_bytes_;
+  bool skip_unhidden_swaps_;
 };
 
 }  // end namespace grappler
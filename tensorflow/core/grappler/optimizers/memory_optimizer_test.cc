@@ -20,6 +20,7 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "absl/strings/match.h"
 #include "tensorflow/cc/ops/standard_ops.h"
 #include "tensorflow/core/framework/graph.pb.h"
 #include "tensorflow/core/framework/node_def.pb.h"
@@ -203,7 +204,8 @@ TEST_F(RecomputeSubgraphTest, MultiNode) {
 
 class MemoryOptimizerTest : public GrapplerTest {
  public:
-  static std::unique_ptr<VirtualCluster> CreateVirtualCluster() {
+  static std::unique_ptr<VirtualCluster> CreateVirtualCluster(
+      int64_t gpu_memory_size = 1024 * 1024, int64_t gpu_bandwidth = 128) {
     DeviceProperties cpu_device;
     cpu_device.set_type("CPU");
     cpu_device.set_frequency(1000);
@@ -214,14 +216,45 @@ class MemoryOptimizerTest : public GrapplerTest {
     gpu_device.set_type("GPU");
     gpu_device.set_frequency(1000);
     gpu_device.set_num_cores(24);
-    gpu_device.set_bandwidth(128);
-    gpu_device.set_memory_size(1024 * 1024);
+    gpu_device.set_bandwidth(gpu_bandwidth);
+    gpu_device.set_memory_size(gpu_memory_size);
     gpu_device.mutable_environment()->insert({"architecture", "6"});
     std::unordered_map<string, DeviceProperties> devices;
     devices["/job:localhost/replica:0/task:0/cpu:0"] = cpu_device;
     devices["/job:localhost/replica:0/task:0/gpu:0"] = gpu_device;
     return std::unique_ptr<VirtualCluster>(new VirtualCluster(devices));
   }
+
+  // Returns a graph whose peak memory usage is a little over 1MB.
+  static GrapplerItem CreateSwappableItem() {
+    tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+    Output v = ops::Variable(s.WithOpName("v").WithDevice("/gpu:0"),
+                             {128, 128, 8}, DT_FLOAT);
+    Output a = ops::Identity(s.WithOpName("a").WithDevice("/gpu:0"), v);
+    Output b = ops::Square(s.WithOpName("b").WithDevice("/gpu:0"), v);
+    Output c = ops::Sqrt(s.WithOpName("c").WithDevice("/gpu:0"), a);
+    Output d = ops::Identity(s.WithOpName("d").WithDevice("/gpu:0"), b);
+    Output axis = ops::Const(s.WithOpName("axis"), 0);
+    Output e = ops::Concat(s.WithOpName("e").WithDevice("/gpu:0"),
+                           {a, b, c, d}, axis);
+    Output f = ops::Square(s.WithOpName("f").WithDevice("/gpu:0"), a);
+    Output g = ops::Sqrt(s.WithOpName("g").WithDevice("/gpu:0"), b);
+    Output h = ops::Exp(s.WithOpName("h").WithDevice("/gpu:0"), c);
+    Output i = ops::Log(s.WithOpName("i").WithDevice("/gpu:0"), d);
+
+    GrapplerItem item;
+    TF_CHECK_OK(s.ToGraphDef(&item.graph));
+    item.fetch = {"e", "f", "g", "h", "i"};
+    return item;
+  }
+
+  static int NumSwapIns(const GraphDef& graph) {
+    int num_swap_ins = 0;
+    for (const auto& node : graph.node()) {
+      if (absl::StartsWith(node.name(), "swap_in_")) ++num_swap_ins;
+    }
+    return num_swap_ins;
+  }
 };
 
 TEST_F(MemoryOptimizerTest, SimpleSwapping) {
@@ -346,6 +379,105 @@ TEST_F(MemoryOptimizerTest, SwappingHeuristics) {
 #endif
 }
 
+TEST_F(MemoryOptimizerTest, SwappingMemoryBudget) {
+  GrapplerItem item = CreateSwappableItem();
+
+  // The graph fits in the memory of the device, so nothing gets swapped unless
+  // a smaller budget is requested.
+  std::unique_ptr<VirtualCluster> cluster(
+      CreateVirtualCluster(/*gpu_memory_size=*/1024 * 1024 * 1024));
+
+  MemoryOptimizer unbudgeted(RewriterConfig::SWAPPING_HEURISTICS);
+  GraphDef output;
+  TF_EXPECT_OK(unbudgeted.Optimize(cluster.get(), item, &output));
+  EXPECT_EQ(item.graph.node_size(), output.node_size());
+
+  MemoryOptimizer budgeted(RewriterConfig::SWAPPING_HEURISTICS, "gradients/",
+                           /*memory_budget_bytes=*/1024 * 1024);
+  TF_EXPECT_OK(budgeted.Optimize(cluster.get(), item, &output));
+  for (const auto& node : output.node()) {
+    if (node.name() == "e") {
+      EXPECT_EQ(5, node.input_size());
+      EXPECT_EQ("a", node.input(0));
+      EXPECT_EQ("swap_in_e_1", node.input(1));
+      EXPECT_EQ("swap_in_e_2", node.input(2));
+      EXPECT_EQ("swap_in_e_3", node.input(3));
+      EXPECT_EQ("axis", node.input(4));
+    }
+  }
+}
+
+TEST_F(MemoryOptimizerTest, RecomputationMemoryBudget) {
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  Output a = ops::Variable(s.WithOpName("a").WithDevice("/gpu:0"), {2, 3, 4},
+                           DT_FLOAT);
+  Output b = ops::Identity(s.WithOpName("b").WithDevice("/gpu:0"), a);
+  Output c = ops::Identity(s.WithOpName("c").WithDevice("/gpu:0"), b);
+  Output d = ops::AddN(s.WithOpName("gradients/d").WithDevice("/gpu:0"), {c});
+  Output e =
+      ops::AddN(s.WithOpName("gradients/e").WithDevice("/gpu:0"), {d, b});
+  Output f =
+      ops::AddN(s.WithOpName("gradients/f").WithDevice("/gpu:0"), {e, a});
+
+  GrapplerItem item;
+  TF_CHECK_OK(s.ToGraphDef(&item.graph));
+  item.fetch = {"gradients/f"};
+  NodeMap node_map(&item.graph);
+  (*node_map.GetNode("b")->mutable_attr())["_recompute_hint"].set_i(0);
+
+  std::unique_ptr<VirtualCluster> cluster(CreateVirtualCluster());
+
+  // Without a budget the hinted node is recomputed.
+  MemoryOptimizer unbudgeted(RewriterConfig::RECOMPUTATION_HEURISTICS);
+  GraphDef output;
+  TF_EXPECT_OK(unbudgeted.Optimize(cluster.get(), item, &output));
+  NodeMap unbudgeted_node_map(&output);
+  EXPECT_NE(nullptr, unbudgeted_node_map.GetNode("Recomputed/b"));
+
+  // The graph already fits in the budget, so nothing is recomputed.
+  MemoryOptimizer budgeted(RewriterConfig::RECOMPUTATION_HEURISTICS,
+                           "gradients/",
+                           /*memory_budget_bytes=*/1024 * 1024);
+  TF_EXPECT_OK(budgeted.Optimize(cluster.get(), item, &output));
+  NodeMap budgeted_node_map(&output);
+  EXPECT_EQ(nullptr, budgeted_node_map.GetNode("Recomputed/b"));
+  EXPECT_EQ(item.graph.node_size(), output.node_size());
+
+  // The graph can't fit in a budget of one byte, so the hinted node, which is
+  // live at the peak, is recomputed.
+  MemoryOptimizer tight(RewriterConfig::RECOMPUTATION_HEURISTICS, "gradients/",
+                        /*memory_budget_bytes=*/1);
+  TF_EXPECT_OK(tight.Optimize(cluster.get(), item, &output));
+  NodeMap tight_node_map(&output);
+  const NodeDef* recomputed_b = tight_node_map.GetNode("Recomputed/b");
+  ASSERT_NE(nullptr, recomputed_b);
+  EXPECT_EQ("a", recomputed_b->input(0));
+  EXPECT_EQ("Recomputed/b", tight_node_map.GetNode("gradients/e")->input(1));
+}
+
+TEST_F(MemoryOptimizerTest, SkipUnhiddenSwaps) {
+  GrapplerItem item = CreateSwappableItem();
+  // The device computes so fast that copying any of the tensors to the host
+  // and back takes longer than the whole step.
+  std::unique_ptr<VirtualCluster> cluster(
+      CreateVirtualCluster(/*gpu_memory_size=*/1024 * 1024 * 1024,
+                           /*gpu_bandwidth=*/int64_t{1} << 40));
+
+  // These swaps are kept by default.
+  MemoryOptimizer swapping(RewriterConfig::SWAPPING_HEURISTICS, "gradients/",
+                           /*memory_budget_bytes=*/1024 * 1024);
+  GraphDef output;
+  TF_EXPECT_OK(swapping.Optimize(cluster.get(), item, &output));
+  EXPECT_GT(NumSwapIns(output), 0);
+
+  MemoryOptimizer skipping(RewriterConfig::SWAPPING_HEURISTICS, "gradients/",
+                           /*memory_budget_bytes=*/1024 * 1024,
+                           /*skip_unhidden_swaps=*/true);
+  TF_EXPECT_OK(skipping.Optimize(cluster.get(), item, &output));
+  EXPECT_EQ(NumSwapIns(output), 0);
+  EXPECT_EQ(item.graph.node_size(), output.node_size());
+}
+
 TEST_F(MemoryOptimizerTest, UnswappableInputs) {
   tensorflow::Scope s = tensorflow::Scope::NewRootScope();
   Output v = ops::Variable(s.WithOpName("v").WithDevice("/gpu:0"),
@@ -448,6 +580,43 @@ TEST_F(MemoryOptimizerTest, AccumulationRewrites) {
   }
 }
 
+TEST_F(MemoryOptimizerTest, OrderingLowersPeakMemory) {
+  // Each branch tiles x into a large tensor and reduces it to a scalar. Both
+  // large tensors are live at once unless one branch finishes before the
+  // other one starts.
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope().WithDevice("/gpu:0");
+  Output x = ops::Placeholder(s.WithOpName("x"), DT_FLOAT,
+                              ops::Placeholder::Shape({100}));
+  Output multiples = ops::Const(s.WithOpName("multiples"), {1000});
+  Output axis = ops::Const(s.WithOpName("axis"), 0);
+  Output big1 = ops::Tile(s.WithOpName("big1"), x, multiples);
+  Output big2 = ops::Tile(s.WithOpName("big2"), x, multiples);
+  Output small1 = ops::Sum(s.WithOpName("small1"), big1, axis);
+  Output small2 = ops::Sum(s.WithOpName("small2"), big2, axis);
+  Output result = ops::AddN(s.WithOpName("result"), {small1, small2});
+
+  GrapplerItem item;
+  TF_CHECK_OK(s.ToGraphDef(&item.graph));
+  item.fetch = {"result"};
+
+  std::unique_ptr<VirtualCluster> cluster(CreateVirtualCluster());
+  MemoryOptimizer optimizer(RewriterConfig::ORDERING_HEURISTICS);
+  GraphDef output;
+  TF_EXPECT_OK(optimizer.Optimize(cluster.get(), item, &output));
+
+  NodeMap node_map(&output);
+  const NodeDef* new_big2 = node_map.GetNode("big2");
+  ASSERT_NE(new_big2, nullptr);
+  ASSERT_EQ(new_big2->input_size(), 3);
+  EXPECT_EQ(new_big2->input(2), "^small1");
+  // The branches were already ordered by their data dependencies.
+  for (const char* name : {"big1", "small1", "small2", "result"}) {
+    for (const string& input : node_map.GetNode(name)->input()) {
+      EXPECT_FALSE(IsControlInput(input)) << name;
+    }
+  }
+}
+
 class RelaxAllocatorConstraintsTest : public GrapplerTest {};
 
 TEST_F(RelaxAllocatorConstraintsTest, SameDevice) {
@@ -16,10 +16,13 @@ limitations under the License.
 #include "tensorflow/core/grappler/optimizers/meta_optimizer.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <optional>
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/strings/match.h"
@@ -41,9 +44,12 @@ limitations under the License.
 #include "tensorflow/core/grappler/optimizers/auto_parallel.h"
 #include "tensorflow/core/grappler/optimizers/common_subgraph_elimination.h"
 #include "tensorflow/core/grappler/optimizers/constant_folding.h"
+#include "tensorflow/core/grappler/optimizers/cost_based_placement_optimizer.h"
 #include "tensorflow/core/grappler/optimizers/custom_graph_optimizer_registry.h"
 #include "tensorflow/core/grappler/optimizers/debug_stripper.h"
 #include "tensorflow/core/grappler/optimizers/dependency_optimizer.h"
+#include "tensorflow/core/grappler/optimizers/dynamic_quantization.h"
+#include "tensorflow/core/grappler/optimizers/function_optimization_cache.h"
 #include "tensorflow/core/grappler/optimizers/function_optimizer.h"
 #include "tensorflow/core/grappler/optimizers/generic_layout_optimizer.h"
 #include "tensorflow/core/grappler/optimizers/implementation_selector.h"
@@ -54,13 +60,16 @@ limitations under the License.
 #include "tensorflow/core/grappler/optimizers/remapper.h"
 #include "tensorflow/core/grappler/optimizers/scoped_allocator_optimizer.h"
 #include "tensorflow/core/grappler/optimizers/shape_optimizer.h"
+#include "tensorflow/core/grappler/optimizers/sparse_apply_grouping.h"
 #include "tensorflow/core/grappler/utils/canonicalizer.h"
 #include "tensorflow/core/grappler/utils/colocation.h"
 #include "tensorflow/core/grappler/utils/functions.h"
 #include "tensorflow/core/grappler/utils/topological_sort.h"
 #include "tensorflow/core/grappler/utils/tpu.h"
 #include "tensorflow/core/grappler/verifiers/structure_verifier.h"
+#include "tensorflow/core/lib/core/blocking_counter.h"
 #include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/gtl/map_util.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/util/dump_graph.h"
@@ -106,7 +115,7 @@ int NumIterations(const RewriterConfig& cfg) {
 // Check if optimizer is allowed to run only once.
 bool IsRunOnceOptimizer(const string& name) {
   return name == "layout" || name == "memory_optimizer" ||
-         name == "loop_optimizer" ||
+         name == "loop_optimizer" || name == "dynamic_quantization" ||
          absl::StartsWith(name, "auto_mixed_precision");
 }
 
@@ -219,7 +228,8 @@ std::unique_ptr<GraphOptimizer> MetaOptimizer::MakeNewOptimizer(
          new ConstantFolding(
              cpu_device_,
              cfg_.experimental_disable_compressed_tensor_optimization(),
-             !cfg_.experimental_disable_folding_quantization_emulation()));
+             !cfg_.experimental_disable_folding_quantization_emulation(),
+             cfg_.constant_folding_max_size_bytes()));
   MK_OPT("shape", "shape_optimization", new ShapeOptimizer());
   MK_OPT("remap", "remapping",
          new Remapper(cfg_.remapping(), cfg_.cpu_layout_conversion(),
@@ -243,6 +253,10 @@ std::unique_ptr<GraphOptimizer> MetaOptimizer::MakeNewOptimizer(
 #endif
   MK_OPT("auto_mixed_precision_cpu", "auto_mixed_precision_cpu",
          new AutoMixedPrecision(AutoMixedPrecisionMode::CPU));
+  MK_OPT("dynamic_quantization", "dynamic_quantization",
+         new DynamicQuantization(cfg_.dynamic_quantization()));
+  MK_OPT("sparse_apply_grouping", "sparse_apply_grouping",
+         new SparseApplyGrouping(cfg_.sparse_apply_grouping()));
   MK_OPT("memory", "memory_optimization",
          new MemoryOptimizer(RewriterConfig::MANUAL));
   MK_OPT("common_subgraph_elimination", "common_subgraph_elimination",
@@ -261,6 +275,8 @@ std::unique_ptr<GraphOptimizer> MetaOptimizer::MakeNewOptimizer(
                                       cfg_.scoped_allocator_opts()));
   MK_OPT("pin_to_host", "pin_to_host_optimization",
          new PinToHostOptimizer(cfg_.pin_to_host_optimization()));
+  MK_OPT("cost_based_placement", "cost_based_placement",
+         new CostBasedPlacementOptimizer(cfg_.cost_based_placement()));
 
   return std::unique_ptr<GraphOptimizer>();
 }
@@ -364,7 +380,8 @@ absl::Status MetaOptimizer::InitializeOptimizers(
       optimizers->push_back(std::make_unique<ConstantFolding>(
           cfg_.constant_folding(), cpu_device_,
           cfg_.experimental_disable_compressed_tensor_optimization(),
-          !cfg_.experimental_disable_folding_quantization_emulation()));
+          !cfg_.experimental_disable_folding_quantization_emulation(),
+          cfg_.constant_folding_max_size_bytes()));
     }
   }
   if (BOTH_NOT_OFF(shape_optimization)) {
@@ -408,6 +425,10 @@ absl::Status MetaOptimizer::InitializeOptimizers(
     optimizers->push_back(
         std::make_unique<AutoMixedPrecision>(AutoMixedPrecisionMode::CPU));
   }
+  if (BOTH_ARE_ON(dynamic_quantization)) {
+    optimizers->push_back(
+        std::make_unique<DynamicQuantization>(cfg_.dynamic_quantization()));
+  }
   if (BOTH_ARE_ON(pin_to_host_optimization))
     optimizers->push_back(std::make_unique<PinToHostOptimizer>());
   else if (BOTH_ARE_EXPERIMENTAL_MLIR(pin_to_host_optimization) ||
@@ -476,17 +497,34 @@ absl::Status MetaOptimizer::InitializeOptimizers(
     if (cfg_.memory_optimizer_target_node_name_scope().empty()) {
       optimizers->push_back(
           // Use the default target node name prefix "gradients/"
-          std::make_unique<MemoryOptimizer>(cfg_.memory_optimization()));
+          std::make_unique<MemoryOptimizer>(
+              cfg_.memory_optimization(), "gradients/",
+              cfg_.memory_optimizer_budget_bytes(),
+              cfg_.memory_optimizer_skip_unhidden_swaps()));
     } else {
       optimizers->push_back(std::make_unique<MemoryOptimizer>(
           cfg_.memory_optimization(),
-          cfg_.memory_optimizer_target_node_name_scope()));
+          cfg_.memory_optimizer_target_node_name_scope(),
+          cfg_.memory_optimizer_budget_bytes(),
+          cfg_.memory_optimizer_skip_unhidden_swaps()));
     }
   }
+  // Runs after the dependency optimizer, which may remove control dependencies
+  // that would prevent grouping.
+  if (BOTH_ARE_ON(sparse_apply_grouping)) {
+    optimizers->push_back(
+        std::make_unique<SparseApplyGrouping>(cfg_.sparse_apply_grouping()));
+  }
   if (cfg_.auto_parallel().enable() && PLUGIN_IS_ON(auto_parallel)) {
     optimizers->push_back(
         std::make_unique<AutoParallel>(cfg_.auto_parallel().num_replicas()));
   }
+  // Runs after the passes that add or remove nodes, so that it places the
+  // graph that is actually executed.
+  if (BOTH_ARE_ON(cost_based_placement)) {
+    optimizers->push_back(std::make_unique<CostBasedPlacementOptimizer>(
+        cfg_.cost_based_placement()));
+  }
 
 #ifndef ENABLE_MKL
   if (BOTH_ARE_ON(scoped_allocator_optimization)) {
@@ -637,6 +675,9 @@ void MetaOptimizer::PrintUserAndPluginConfigs(
     PRINT_CFG(constant_folding)
     PRINT_CFG(shape_optimization)
     PRINT_CFG(pin_to_host_optimization)
+    PRINT_CFG(cost_based_placement)
+    PRINT_CFG(dynamic_quantization)
+    PRINT_CFG(sparse_apply_grouping)
     PRINT_CFG(layout_optimizer)
     PRINT_CFG(remapping)
     PRINT_CFG(loop_optimization)
@@ -689,7 +730,10 @@ void MetaOptimizer::PrintUserAndPluginConfigs(
                 "auto_mixed_precision_onednn_bfloat16")
       PRINT_CFG("auto_mixed_precision_mkl", "auto_mixed_precision_mkl")
       PRINT_CFG("auto_mixed_precision_cpu", "auto_mixed_precision_cpu")
+      PRINT_CFG("dynamic_quantization", "dynamic_quantization")
+      PRINT_CFG("sparse_apply_grouping", "sparse_apply_grouping")
       PRINT_CFG("pin_to_host", "pin_to_host_optimization")
+      PRINT_CFG("cost_based_placement", "cost_based_placement")
       PRINT_CFG("layout", "layout_optimizer")
       PRINT_CFG("remap", "remapping")
       PRINT_CFG("loop", "loop_optimization")
@@ -730,7 +774,10 @@ void MetaOptimizer::PrintUserAndPluginConfigs(
         pair.first == "auto_mixed_precision_onednn_bfloat16" ||
         pair.first == "auto_mixed_precision_mkl" ||
         pair.first == "auto_mixed_precision_cpu" ||
+        pair.first == "dynamic_quantization" ||
+        pair.first == "sparse_apply_grouping" ||
         pair.first == "pin_to_host_optimization" ||
+        pair.first == "cost_based_placement" ||
         pair.first == "scoped_allocator_optimization") {
       // These optimizers are turned off by default.
       // TODO(penporn): Remove the hard-coded length and change it to max length
@@ -889,7 +936,10 @@ absl::Status MetaOptimizer::OptimizeGraph(
                                    }) != optimization_result.results.end();
 
   // Record graph optimization result.
-  optimization_results_.push_back(optimization_result);
+  {
+    mutex_lock l(optimization_results_mu_);
+    optimization_results_.push_back(optimization_result);
+  }
 
   if (is_optimized) {
     TF_RETURN_IF_ERROR(TopologicalSort(optimized_graph));
@@ -917,6 +967,39 @@ absl::Status MetaOptimizer::OptimizeGraph(Cluster* cluster, GrapplerItem&& item,
                        optimized_graph);
 }
 
+absl::Status MetaOptimizer::OptimizeFunctionBody(
+    Cluster* cluster, bool is_tpu_graph, GrapplerFunctionItem& func_item,
+    GraphDef* optimized_func_graph) {
+  if (!is_tpu_graph) {
+    GrapplerFunctionItem func_item_copy = func_item;
+    return OptimizeGraph(cluster, std::move(func_item_copy),
+                         optimized_func_graph);
+  }
+
+  // Skip optimizing functions if this is a TPU graph. Currently, Grappler
+  // passes do not handle TPU functions correctly in a variety of ways
+  // (Note that due to the pre-placement TPU graph rewriting passes, the
+  // TPU-related ops are encapsulated away into functions). For example,
+  // TPU graphs contain TPUReplicateMetadata node that carries relevant
+  // TPU metadata and Grappler passes could prune that away. Grappler
+  // passes could also cause issues around shape inference. Since the
+  // desired and existing behavior is to not optimize TPU functions with
+  // Grappler, this check preserves that. The only exception is
+  // implementation selector what is required to swap in some TPU specific
+  // lowering code and is verified the work correctly on TPUs.
+  ImplementationSelector implementation_selector;
+
+  // Implementation selector needs to have access to valid function
+  // signature and attributes, and it doesn't need actual function body.
+  std::unique_ptr<FunctionDefLibrary> func_item_function_library(
+      func_item.graph.release_library());
+  *func_item.graph.mutable_library() =
+      GetFunctionDefLibraryStub(*func_item_function_library);
+
+  return implementation_selector.Optimize(cluster, func_item,
+                                          optimized_func_graph);
+}
+
 absl::Status MetaOptimizer::RunOptimizer(
     GraphOptimizer* optimizer, Cluster* cluster, GrapplerItem* optimized_item,
     GraphDef* optimized_graph, GraphOptimizationResult* optimization_result) {
@@ -1057,7 +1140,10 @@ absl::Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster,
       {kGrapplerCategory, "*"});
 
   VLOG(1) << "Starting optimization for grappler item: " << item.id;
-  optimization_results_.clear();
+  {
+    mutex_lock l(optimization_results_mu_);
+    optimization_results_.clear();
+  }
 
   // Constructs a FunctionLibraryDefinition with functions that are reachable
   // from the nodes of the graph.
@@ -1166,8 +1252,92 @@ absl::Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster,
   // True if this is a TPU graph using the old bridge.
   bool is_tpu_graph = IsLegacyTPUBridgeGraphDef(*optimized_graph);
 
+  // Reuse the results of optimizing unchanged functions in earlier calls.
+  FunctionOptimizationCache* function_cache =
+      FunctionOptimizationCache::Global();
+  const std::vector<string> cluster_devices =
+      cluster != nullptr ? cluster->GetDeviceNames() : std::vector<string>();
+
   // Optimize each function only once.
   absl::flat_hash_set<string> optimized_funcs;
+
+  // Function bodies are optimized concurrently in batches of up to
+  // `function_optimization_parallelism` functions. A function only sees the
+  // unoptimized bodies of the other functions in its batch.
+  const int parallelism =
+      std::max(1, cfg_.function_optimization_parallelism());
+  std::unique_ptr<thread::ThreadPool> thread_pool;
+  if (parallelism > 1) {
+    thread_pool = std::make_unique<thread::ThreadPool>(
+        Env::Default(), "grappler_function_optimization", parallelism);
+  }
+  struct FunctionOptimization {
+    string func_name;
+    uint64_t cache_key = 0;
+    GrapplerFunctionItem func_item;
+    GraphDef optimized_func_graph;
+    absl::Status status;
+  };
+  std::vector<FunctionOptimization> batch;
+
+  // Optimizes the function bodies in `batch` and replaces the functions in
+  // `flib`, in the order they were added to the batch.
+  auto optimize_batch = [&]() -> absl::Status {
+    if (thread_pool == nullptr || batch.size() <= 1) {
+      for (FunctionOptimization& optimization : batch) {
+        optimization.status =
+            OptimizeFunctionBody(cluster, is_tpu_graph, optimization.func_item,
+                                 &optimization.optimized_func_graph);
+      }
+    } else {
+      BlockingCounter counter(batch.size());
+      for (FunctionOptimization& optimization : batch) {
+        thread_pool->Schedule([&, optimization_ptr = &optimization]() {
+          optimization_ptr->status = OptimizeFunctionBody(
+              cluster, is_tpu_graph, optimization_ptr->func_item,
+              &optimization_ptr->optimized_func_graph);
+          counter.DecrementCount();
+        });
+      }
+      counter.Wait();
+    }
+
+    for (FunctionOptimization& optimization : batch) {
+      TF_RETURN_IF_ERROR(optimization.status);
+
+      // Function body optimization might have created new specialized
+      // functions for each instantiation context. Add them to the library.
+      FunctionDefLibrary cached_result;
+      cached_result.add_function();
+      for (const FunctionDef& func_def :
+           optimization.optimized_func_graph.library().function()) {
+        if (flib.Find(func_def.signature().name()) == nullptr) {
+          TF_RETURN_IF_ERROR(flib.AddFunctionDef(func_def));
+          if (function_cache != nullptr) {
+            *cached_result.add_function() = func_def;
+          }
+        }
+      }
+
+      // Convert optimized graph back to FunctionDef.
+      FunctionDef optimized_func;
+      optimization.func_item.SwapFunctionBody(
+          std::move(optimization.optimized_func_graph));
+      TF_RETURN_IF_ERROR(
+          MakeFunctionDef(optimization.func_item, flib, &optimized_func));
+      if (function_cache != nullptr) {
+        *cached_result.mutable_function(0) = optimized_func;
+        function_cache->Insert(optimization.cache_key, cached_result);
+      }
+
+      // Replace optimized function with a new FunctionDef.
+      TF_RETURN_IF_ERROR(
+          flib.ReplaceFunction(optimization.func_name, optimized_func));
+    }
+    batch.clear();
+    return absl::OkStatus();
+  };
+
   while (optimize_function_library) {
     optimize_function_library = false;
 
@@ -1203,15 +1373,40 @@ absl::Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster,
       optimize_function_library = true;
       optimized_funcs.insert(func_name);
 
+      // If we need to compute the gradient of optimized function at runtime, we
+      // can't perform non-differentiable rewrites.
+      const bool allow_non_differentiable_rewrites =
+          !differentiable_functions.contains(func_name);
+
+      uint64_t cache_key = 0;
+      if (function_cache != nullptr) {
+        cache_key = FunctionOptimizationCache::Key(
+            func, flib, producer, cfg_, cluster_devices,
+            allow_non_differentiable_rewrites, is_tpu_graph);
+        std::optional<FunctionDefLibrary> cached =
+            function_cache->Lookup(cache_key);
+        if (cached.has_value()) {
+          VLOG(3) << "Found optimized function " << func_name << " in cache.";
+          for (int i = 1; i < cached->function_size(); ++i) {
+            if (flib.Find(cached->function(i).signature().name()) == nullptr) {
+              TF_RETURN_IF_ERROR(flib.AddFunctionDef(cached->function(i)));
+            }
+          }
+          TF_RETURN_IF_ERROR(
+              flib.ReplaceFunction(func_name, cached->function(0)));
+          continue;
+        }
+      }
+
       // Make a GrapplerItem from a FunctionDef.
-      GrapplerFunctionItem func_item;
+      FunctionOptimization& optimization = batch.emplace_back();
+      optimization.func_name = func_name;
+      optimization.cache_key = cache_key;
+      GrapplerFunctionItem& func_item = optimization.func_item;
       TF_RETURN_IF_ERROR(
           MakeGrapplerFunctionItem(func, flib, producer, &func_item));
-
-      // If we need to compute the gradient of optimized function at runtime, we
-      // can't perform non-differentiable rewrites.
       func_item.optimization_options().allow_non_differentiable_rewrites =
-          !differentiable_functions.contains(func_name);
+          allow_non_differentiable_rewrites;
 
       // Device set available to the function is defined only by the runtime,
       // when we instantiate and execute the function. We can't use all devices
@@ -1228,54 +1423,11 @@ absl::Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster,
       func_item.optimization_options().allow_pruning_stateful_and_dataset_ops =
           false;
 
-      // Optimize function body graph.
-      GraphDef optimized_func_graph;
-      if (is_tpu_graph) {
-        // Skip optimizing functions if this is a TPU graph. Currently, Grappler
-        // passes do not handle TPU functions correctly in a variety of ways
-        // (Note that due to the pre-placement TPU graph rewriting passes, the
-        // TPU-related ops are encapsulated away into functions). For example,
-        // TPU graphs contain TPUReplicateMetadata node that carries relevant
-        // TPU metadata and Grappler passes could prune that away. Grappler
-        // passes could also cause issues around shape inference. Since the
-        // desired and existing behavior is to not optimize TPU functions with
-        // Grappler, this check preserves that. The only exception is
-        // implementation selector what is required to swap in some TPU specific
-        // lowering code and is verified the work correctly on TPUs.
-        ImplementationSelector implementation_selector;
-
-        // Implementation selector needs to have access to valid function
-        // signature and attributes, and it doesn't need actual function body.
-        std::unique_ptr<FunctionDefLibrary> func_item_function_library(
-            func_item.graph.release_library());
-        *func_item.graph.mutable_library() =
-            GetFunctionDefLibraryStub(*func_item_function_library);
-
-        TF_RETURN_IF_ERROR(implementation_selector.Optimize(
-            cluster, func_item, &optimized_func_graph));
-      } else {
-        GrapplerFunctionItem func_item_copy = func_item;
-        TF_RETURN_IF_ERROR(OptimizeGraph(cluster, std::move(func_item_copy),
-                                         &optimized_func_graph));
-      }
-
-      // Function body optimization might have created new specialized
-      // functions for each instantiation context. Add them to the library.
-      for (const FunctionDef& func_def :
-           optimized_func_graph.library().function()) {
-        if (flib.Find(func_def.signature().name()) == nullptr) {
-          TF_RETURN_IF_ERROR(flib.AddFunctionDef(func_def));
-        }
+      if (static_cast<int>(batch.size()) >= parallelism) {
+        TF_RETURN_IF_ERROR(optimize_batch());
       }
-
-      // Convert optimized graph back to FunctionDef.
-      FunctionDef optimized_func;
-      func_item.SwapFunctionBody(std::move(optimized_func_graph));
-      TF_RETURN_IF_ERROR(MakeFunctionDef(func_item, flib, &optimized_func));
-
-      // Replace optimized function with a new FunctionDef.
-      TF_RETURN_IF_ERROR(flib.ReplaceFunction(func_name, optimized_func));
     }
+    TF_RETURN_IF_ERROR(optimize_batch());
 
     // If optimized at least one function, update the graph library.
     if (optimize_function_library) {
@@ -1323,6 +1475,7 @@ absl::Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster,
 
 string MetaOptimizer::GetResultString() const {
   std::string result_string;
+  mutex_lock l(optimization_results_mu_);
   for (const GraphOptimizationResult& graph_result : optimization_results_) {
     absl::StrAppend(&result_string,
                     "Optimization results for grappler item: ", graph_result.id,
@@ -1359,11 +1512,14 @@ bool MetaOptimizerEnabled(const ConfigProto& cfg) {
          rewrite_cfg.scoped_allocator_optimization() == RewriterConfig::ON ||
 #endif
          rewrite_cfg.pin_to_host_optimization() == RewriterConfig::ON ||
+         rewrite_cfg.cost_based_placement() == RewriterConfig::ON ||
          AutoMixedPrecisionEnabled(rewrite_cfg.auto_mixed_precision()) ||
          AutoMixedPrecisionEnabled(
              rewrite_cfg.auto_mixed_precision_onednn_bfloat16()) ||
          AutoMixedPrecisionEnabled(rewrite_cfg.auto_mixed_precision_mkl()) ||
          AutoMixedPrecisionEnabled(rewrite_cfg.auto_mixed_precision_cpu()) ||
+         rewrite_cfg.dynamic_quantization() == RewriterConfig::ON ||
+         rewrite_cfg.sparse_apply_grouping() == RewriterConfig::ON ||
          !rewrite_cfg.optimizers().empty() ||
          !rewrite_cfg.custom_optimizers().empty();
 }
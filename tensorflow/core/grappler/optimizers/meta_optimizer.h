@@ -22,8 +22,10 @@ limitations under the License.
 #include "tensorflow/core/graph/graph.h"
 #include "tensorflow/core/grappler/grappler_item.h"
 #include "tensorflow/core/grappler/optimizers/graph_optimizer.h"
+#include "tensorflow/core/grappler/utils/functions.h"
 #include "tensorflow/core/grappler/verifiers/graph_verifier.h"
 #include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/protobuf/config.pb.h"
 #include "tensorflow/core/protobuf/rewriter_config.pb.h"
 #include "tensorflow/core/protobuf/verifier_config.pb.h"
@@ -94,6 +96,11 @@ class MetaOptimizer : public GraphOptimizer {
   absl::Status OptimizeGraph(
       const std::vector<std::unique_ptr<GraphOptimizer>>& optimizers,
       Cluster* cluster, GrapplerItem&& item, GraphDef* optimized_graph);
+  // Optimizes the body of a library function. May be called concurrently for
+  // different functions.
+  absl::Status OptimizeFunctionBody(Cluster* cluster, bool is_tpu_graph,
+                                    GrapplerFunctionItem& func_item,
+                                    GraphDef* optimized_func_graph);
   absl::Status OptimizeGraph(Cluster* cluster, GrapplerItem&& item,
                              GraphDef* optimized_graph);
 
@@ -119,7 +126,11 @@ class MetaOptimizer : public GraphOptimizer {
                             GraphDef* optimized_graph,
                             GraphOptimizationResult* optimization_result);
 
-  std::vector<GraphOptimizationResult> optimization_results_;
+  // Guards `optimization_results_` while function bodies are optimized
+  // concurrently.
+  mutable mutex optimization_results_mu_;
+  std::vector<GraphOptimizationResult> optimization_results_
+      TF_GUARDED_BY(optimization_results_mu_);
 };
 
 bool MetaOptimizerEnabled(const ConfigProto& cfg);
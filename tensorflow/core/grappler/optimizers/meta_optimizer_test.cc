@@ -18,6 +18,7 @@ limitations under the License.
 #include <atomic>
 
 #include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/substitute.h"
 #include "tensorflow/cc/ops/standard_ops.h"
 #include "tensorflow/core/framework/dataset.h"
@@ -420,6 +421,89 @@ TEST_F(MetaOptimizerTest, OptimizeFunctionLibrary) {
   test::ExpectTensorEqual<int>(tensors_expected[1], tensors[1]);
 }
 
+TEST_F(MetaOptimizerTest, OptimizeFunctionLibraryInParallel) {
+  using test::function::NDef;
+
+  ConfigProto config_proto;
+  auto& rewriter_config =
+      *config_proto.mutable_graph_options()->mutable_rewrite_options();
+
+  rewriter_config.set_meta_optimizer_iterations(RewriterConfig::TWO);
+  rewriter_config.set_function_optimization(RewriterConfig::ON);
+  rewriter_config.add_optimizers("function");
+  rewriter_config.set_min_graph_nodes(-1);
+  rewriter_config.set_function_optimization_parallelism(3);
+
+  MetaOptimizer optimizer(nullptr, config_proto);
+
+  // Define function library:
+  //
+  //    MyMul(x, y)    = x * y
+  //   *MySquare_i(x)  = MyMul(x, x)   for i in [0, 5)
+  //
+  //  * - marked as noinline
+  FunctionDef mul_func = FunctionDefHelper::Create(
+      "MyMul", {"x:T", "y:T"}, {"z:T"}, {"T: {float, double}"},
+      {{{"mul"}, "Mul", {"x", "y"}, {{"T", "$T"}}}},
+      /*ret_def=*/
+      {{"z", "mul:z:0"}});
+
+  constexpr int kNumFunctions = 5;
+  std::vector<string> fetch;
+  std::vector<FunctionDef> funcs = {mul_func};
+  std::vector<NodeDef> nodes = {
+      NDef("a", "Placeholder", {}, {{"dtype", DT_FLOAT}}, kDevice)};
+  for (int i = 0; i < kNumFunctions; ++i) {
+    const string func_name = absl::StrCat("MySquare_", i);
+    FunctionDef square_func = FunctionDefHelper::Create(
+        func_name, {"x:float"}, {"z:float"}, {},
+        {{{"my_mul"}, "MyMul", {"x", "x"}, {{"T", DT_FLOAT}}}},
+        /*ret_def=*/
+        {{"z", "my_mul:z:0"}});
+    (*square_func.mutable_attr())["_noinline"].set_b(true);
+    funcs.push_back(square_func);
+    nodes.push_back(NDef(absl::StrCat("square_", i), func_name, {"a"}, {},
+                         kDevice));
+    nodes.push_back(NDef(absl::StrCat("out_", i), "Identity",
+                         {absl::StrCat("square_", i, ":0")},
+                         {{"T", DT_FLOAT}}, kDevice));
+    fetch.push_back(absl::StrCat("out_", i));
+  }
+
+  GrapplerItem item;
+  item.id = "tf_graph";
+  item.graph = test::function::GDef(nodes, funcs);
+
+  GraphDef output;
+  TF_EXPECT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  // MyMul should be inlined into all optimized versions of MySquare_i.
+  int num_optimized = 0;
+  for (const FunctionDef& func : output.library().function()) {
+    if (!absl::StartsWith(func.signature().name(), "MySquare_")) continue;
+    ++num_optimized;
+    bool has_mul = false;
+    for (const NodeDef& node : func.node_def()) {
+      EXPECT_NE("MyMul", node.op());
+      if (node.op() == "Mul") has_mul = true;
+    }
+    EXPECT_TRUE(has_mul) << func.signature().name();
+  }
+  EXPECT_EQ(kNumFunctions, num_optimized);
+
+  item.fetch = fetch;
+  item.feed.emplace_back("a", test::AsScalar<float>(3.0f));
+  auto tensors_expected = EvaluateFetchNodes(item);
+
+  GrapplerItem optimized = item.WithGraph(std::move(output));
+  auto tensors = EvaluateFetchNodes(optimized);
+
+  ASSERT_EQ(kNumFunctions, tensors.size());
+  for (int i = 0; i < kNumFunctions; ++i) {
+    test::ExpectTensorEqual<float>(tensors_expected[i], tensors[i]);
+  }
+}
+
 TEST_F(MetaOptimizerTest, OptimizeFunctionLibraryPruneUnusedOutputs) {
   using test::function::NDef;
 
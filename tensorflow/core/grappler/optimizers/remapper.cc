@@ -25,6 +25,7 @@ limitations under the License.
 #include <vector>
 
 #include "absl/container/flat_hash_set.h"
+#include "tensorflow/core/framework/attr_value_util.h"
 #include "tensorflow/core/framework/tensor_shape.h"
 #include "tensorflow/core/framework/versions.pb.h"
 #include "tensorflow/core/grappler/costs/graph_properties.h"
@@ -91,7 +92,11 @@ constexpr char kFusedMatMul[] = "_FusedMatMul";
 constexpr char kFusedDepthwiseConv2dNative[] = "_FusedDepthwiseConv2dNative";
 constexpr char kFusedBatchNormEx[] = "_FusedBatchNormEx";
 constexpr char kFusedBatchNormGradEx[] = "_FusedBatchNormGradEx";
+constexpr char kFusedScaledDotProductAttention[] =
+    "_FusedScaledDotProductAttention";
 constexpr char kTensorToHashBucket[] = "_TensorToHashBucketFast";
+constexpr char kStringNGramsHashBucket[] = "_StringNGramsHashBucketFast";
+constexpr char kFusedMinMax[] = "_FusedMinMax";
 constexpr char kLeakyRelu[] = "LeakyRelu";
 constexpr char kMklFusedMish[] = "_MklFusedMish";
 constexpr char kRelu[] = "Relu";
@@ -170,6 +175,36 @@ struct TensorToHashBucket {
   int string_to_hash_bucket = kMissingIndex;
 };
 
+// SegmentSum or SegmentMean of the rows picked by a Gather.
+struct GatherWithSegmentReduction {
+  GatherWithSegmentReduction() = default;
+  GatherWithSegmentReduction(int gather, int segment_reduction)
+      : gather(gather), segment_reduction(segment_reduction) {}
+
+  int gather = kMissingIndex;
+  int segment_reduction = kMissingIndex;
+};
+
+// StringToHashBucketFast of the ngrams of a StringNGrams.
+struct StringNGramsToHashBucket {
+  StringNGramsToHashBucket() = default;
+  StringNGramsToHashBucket(int string_ngrams, int string_to_hash_bucket)
+      : string_ngrams(string_ngrams),
+        string_to_hash_bucket(string_to_hash_bucket) {}
+
+  int string_ngrams = kMissingIndex;
+  int string_to_hash_bucket = kMissingIndex;
+};
+
+// Min and Max of the same tensor over the same axes.
+struct SiblingMinMax {
+  SiblingMinMax() = default;
+  SiblingMinMax(int min, int max) : min(min), max(max) {}
+
+  int min = kMissingIndex;
+  int max = kMissingIndex;
+};
+
 // Pad followed by Conv3D/FusedConv3D
 struct PadWithConv3D {
   PadWithConv3D() = default;
@@ -2746,6 +2781,154 @@ bool FindTensorToHashBucket(const RemapperContext& ctx, int node_index,
   return true;
 }
 
+// SparseSegmentSum and SparseSegmentMean read the rows of their data through
+// their indices, so they compute a segment reduction of gathered rows without
+// writing the gathered rows to memory:
+//
+//   SegmentSum(Gather(params, ids), segment_ids)
+//     => SparseSegmentSum(params, ids, segment_ids)
+bool FindGatherWithSegmentReduction(const RemapperContext& ctx, int node_index,
+                                    GatherWithSegmentReduction* matched) {
+  const auto* node_view = ctx.graph_view.GetNode(node_index);
+  const auto* node_def = node_view->node();
+  if ((node_def->op() != "SegmentSum" && node_def->op() != "SegmentMean") ||
+      !NodeIsOnCpu(node_def) || HasControlFaninOrFanout(*node_view)) {
+    return false;
+  }
+  // The types for which the sparse segment reductions have CPU kernels.
+  if (!HasDataType(node_def, DT_FLOAT) && !HasDataType(node_def, DT_DOUBLE) &&
+      !HasDataType(node_def, DT_HALF) && !HasDataType(node_def, DT_BFLOAT16)) {
+    return false;
+  }
+
+  if (node_view->NumRegularFanins() < 2) return false;
+  const auto* gather_node_view = node_view->GetRegularFanin(0).node_view();
+  const auto* gather_node_def = gather_node_view->node();
+  if ((gather_node_def->op() != "Gather" &&
+       gather_node_def->op() != "GatherV2") ||
+      !NodeIsOnCpu(gather_node_def) ||
+      HasControlFaninOrFanout(*gather_node_view) ||
+      !HasAtMostOneFanoutAtPort0(*gather_node_view) ||
+      IsInPreserveSet(ctx, gather_node_def)) {
+    return false;
+  }
+
+  if (gather_node_def->op() == "GatherV2") {
+    // Only a gather of rows, with axis 0 and no batch dimensions.
+    int batch_dims = 0;
+    if (HasNodeAttr(*gather_node_def, "batch_dims") &&
+        (!GetNodeAttr(*gather_node_def, "batch_dims", &batch_dims).ok() ||
+         batch_dims != 0)) {
+      return false;
+    }
+    if (gather_node_view->NumRegularFanins() < 3) return false;
+    const auto* axis_node_def =
+        gather_node_view->GetRegularFanin(2).node_view()->node();
+    Tensor axis;
+    if (!IsConstant(*axis_node_def) ||
+        !axis.FromProto(axis_node_def->attr().at("value").tensor()) ||
+        axis.NumElements() != 1) {
+      return false;
+    }
+    const int64_t axis_value = axis.dtype() == DT_INT32
+                                   ? axis.flat<int32>()(0)
+                                   : axis.flat<int64_t>()(0);
+    if (axis_value != 0) return false;
+  }
+
+  // Gather takes indices of any rank, but the sparse segment reductions only
+  // take a vector of indices.
+  const auto& gather_props =
+      ctx.graph_properties.GetInputProperties(gather_node_def->name());
+  if (gather_props.size() < 2 || Rank(gather_props[1].shape()) != 1) {
+    return false;
+  }
+
+  *matched = GatherWithSegmentReduction(gather_node_view->node_index(),
+                                        node_index);
+  return true;
+}
+
+// Hashing the ngrams as they are formed saves allocating a string per ngram:
+//
+//   StringToHashBucketFast(StringNGrams(data, data_splits):0)
+//     => _StringNGramsHashBucketFast(data, data_splits):0
+bool FindStringNGramsToHashBucket(const RemapperContext& ctx, int node_index,
+                                  StringNGramsToHashBucket* matched) {
+  const auto* node_view = ctx.graph_view.GetNode(node_index);
+  const auto* node_def = node_view->node();
+  if (!IsStringToHashBucketFast(*node_def) || !NodeIsOnCpu(node_def) ||
+      HasControlFaninOrFanout(*node_view)) {
+    return false;
+  }
+
+  if (node_view->NumRegularFanins() < 1) return false;
+  const auto& regular_fanin_0 = node_view->GetRegularFanin(0);
+  const auto* ngrams_node_view = regular_fanin_0.node_view();
+  const auto* ngrams_node_def = ngrams_node_view->node();
+  if (ngrams_node_def->op() != "StringNGrams" || regular_fanin_0.index() != 0 ||
+      !NodeIsOnCpu(ngrams_node_def) ||
+      HasControlFaninOrFanout(*ngrams_node_view) ||
+      !HasAtMostOneFanoutAtPort0(*ngrams_node_view) ||
+      IsInPreserveSet(ctx, ngrams_node_def)) {
+    return false;
+  }
+
+  *matched = StringNGramsToHashBucket(ngrams_node_view->node_index(),
+                                      node_index);
+  return true;
+}
+
+// Min and Max over the same axes of the same tensor are computed together to
+// read the tensor once:
+//
+//   Min(x, axes), Max(x, axes) => _FusedMinMax(x, axes):0, :1
+bool FindSiblingMinMax(const RemapperContext& ctx, int node_index,
+                       const std::vector<bool>& invalidated_nodes,
+                       const std::vector<bool>& nodes_to_delete,
+                       SiblingMinMax* matched) {
+  const auto* node_view = ctx.graph_view.GetNode(node_index);
+  const auto* node_def = node_view->node();
+  if (!IsMax(*node_def) || !NodeIsOnCpu(node_def) ||
+      HasControlFaninOrFanout(*node_view) ||
+      node_view->NumRegularFanins() != 2) {
+    return false;
+  }
+  DataType dtype;
+  if (!GetNodeAttr(*node_def, "T", &dtype).ok() ||
+      DataTypeIsQuantized(dtype)) {
+    return false;
+  }
+
+  const auto& input = node_view->GetRegularFanin(0);
+  const auto& input_fanouts =
+      input.node_view()->GetRegularFanout(input.index());
+  for (const auto& fanout : input_fanouts) {
+    const auto* sibling_view = fanout.node_view();
+    const auto* sibling_def = sibling_view->node();
+    if (!IsMin(*sibling_def) || fanout.index() != 0 ||
+        invalidated_nodes[sibling_view->node_index()] ||
+        nodes_to_delete[sibling_view->node_index()] ||
+        sibling_def->device() != node_def->device() ||
+        HasControlFaninOrFanout(*sibling_view) ||
+        sibling_view->NumRegularFanins() != 2 ||
+        sibling_def->input(1) != node_def->input(1)) {
+      continue;
+    }
+    bool same_attrs = sibling_def->attr_size() == node_def->attr_size();
+    for (const auto& [name, value] : node_def->attr()) {
+      const auto it = sibling_def->attr().find(name);
+      same_attrs = same_attrs && it != sibling_def->attr().end() &&
+                   AreAttrValuesEqual(it->second, value);
+    }
+    if (!same_attrs) continue;
+
+    *matched = SiblingMinMax(sibling_view->node_index(), node_index);
+    return true;
+  }
+  return false;
+}
+
 // clang-format off
 // HardSwish pattern
 //                        input     Const (value: 3)
@@ -2997,6 +3180,115 @@ bool FindFusedBatchMatMul(RemapperContext* ctx, int node_index,
   return found_op_type_match;
 }
 
+// Finds BatchMatMul(Softmax(Mul(BatchMatMul(query, key, adj_y=true), scale)),
+// value), the scaled dot-product attention of transformer models, so that it
+// can be computed by _FusedScaledDotProductAttention without materializing the
+// attention matrix.
+bool FindScaledDotProductAttention(RemapperContext* ctx, int node_index,
+                                   std::map<string, int>* matched_nodes_map,
+                                   std::set<int>* remove_node_indices) {
+  if (ctx->xla_cpu_jit_disable_fusion) return false;
+
+  using utils::MatchingDirection;
+  using utils::NodeStatus;
+  // clang-format off
+  utils::OpTypePattern attention_pattern =
+    {"BatchMatMulV2", "output", NodeStatus::kReplace,
+      {
+        {"Softmax", "softmax", NodeStatus::kRemove,
+          {
+            {"Mul", "mul", NodeStatus::kRemove,
+              {
+                {"BatchMatMulV2", "scores", NodeStatus::kRemove,
+                  {
+                    {"*", "query", NodeStatus::kRemain},
+                    {"*", "key", NodeStatus::kRemain}
+                  }
+                },
+                {"*", "scale", NodeStatus::kRemain}
+              }
+            }
+          }
+        },
+        {"*", "value", NodeStatus::kRemain}
+      }
+    };
+  // clang-format on
+
+  utils::SubGraphMatcher<MatchingDirection::kFollowInputs> graph_matcher(
+      &(ctx->graph_view));
+  matched_nodes_map->clear();
+  remove_node_indices->clear();
+  if (!graph_matcher.GetMatchedNodes(attention_pattern, ctx->nodes_to_preserve,
+                                     ctx->graph_view.GetNode(node_index),
+                                     matched_nodes_map, remove_node_indices)) {
+    return false;
+  }
+
+  const auto* output_node =
+      ctx->graph_view.GetNode(matched_nodes_map->at("output"))->node();
+  const auto* scores_node =
+      ctx->graph_view.GetNode(matched_nodes_map->at("scores"))->node();
+  if (!NodeIsOnCpu(output_node) || !HasDataType(output_node, DT_FLOAT)) {
+    return false;
+  }
+  // The kernel computes query * key^T * value with no other transposes.
+  bool adj_x = false;
+  bool adj_y = false;
+  if (!TryGetNodeAttr(*output_node, "adj_x", &adj_x) || adj_x ||
+      !TryGetNodeAttr(*output_node, "adj_y", &adj_y) || adj_y) {
+    return false;
+  }
+  if (!TryGetNodeAttr(*scores_node, "adj_x", &adj_x) || adj_x ||
+      !TryGetNodeAttr(*scores_node, "adj_y", &adj_y) || !adj_y) {
+    return false;
+  }
+
+  // The kernel does not broadcast, so query, key and value must have the same
+  // known batch dimensions, and the scale must be a scalar. The properties are
+  // shared by the later fusions, so they are inferred as in Optimize().
+  if (!ctx->inferred_graph_properties) {
+    absl::Status s = ctx->graph_properties.InferStatically(
+        /*assume_valid_feeds=*/false,
+        /*aggressive_shape_inference=*/false,
+        /*include_input_tensor_values=*/true,
+        /*include_output_tensor_values=*/false);
+    if (!s.ok()) return false;
+    ctx->inferred_graph_properties = true;
+  }
+  const auto& scores_props =
+      ctx->graph_properties.GetInputProperties(scores_node->name());
+  const auto& output_props =
+      ctx->graph_properties.GetInputProperties(output_node->name());
+  const auto* mul_node =
+      ctx->graph_view.GetNode(matched_nodes_map->at("mul"))->node();
+  const auto& mul_props =
+      ctx->graph_properties.GetInputProperties(mul_node->name());
+  if (scores_props.size() != 2 || output_props.size() != 2 ||
+      mul_props.size() != 2) {
+    return false;
+  }
+  const int scale_port =
+      NodeName(mul_node->input(0)) == scores_node->name() ? 1 : 0;
+  if (Rank(mul_props[scale_port].shape()) != 0) return false;
+
+  const TensorShapeProto& query_shape = scores_props[0].shape();
+  const TensorShapeProto& key_shape = scores_props[1].shape();
+  const TensorShapeProto& value_shape = output_props[1].shape();
+  const int rank = Rank(query_shape);
+  if (rank < 2 || Rank(key_shape) != rank || Rank(value_shape) != rank) {
+    return false;
+  }
+  for (int i = 0; i < rank - 2; ++i) {
+    const int64_t batch_dim = query_shape.dim(i).size();
+    if (batch_dim < 0 || key_shape.dim(i).size() != batch_dim ||
+        value_shape.dim(i).size() != batch_dim) {
+      return false;
+    }
+  }
+  return true;
+}
+
 // Helper function to check if the reduction axes for a given input
 // shape align with instance normalization's mean computation.
 // Mean reduction axes for instance norm are expected to be:
@@ -4377,6 +4669,128 @@ absl::Status AddTensorToHashBucketNode(RemapperContext* ctx,
   return absl::OkStatus();
 }
 
+absl::Status AddSparseSegmentReductionNode(
+    RemapperContext* ctx, const GatherWithSegmentReduction& matched,
+    std::vector<bool>* invalidated_nodes, std::vector<bool>* nodes_to_delete) {
+  const GraphDef* graph = ctx->graph_view.graph();
+  const NodeDef& gather = graph->node(matched.gather);
+  const NodeDef& segment_reduction = graph->node(matched.segment_reduction);
+  VLOG(2) << "Fuse " << gather.op() << " with " << segment_reduction.op()
+          << ": gather=" << gather.name()
+          << " segment_reduction=" << segment_reduction.name();
+
+  NodeDef fused_op;
+  fused_op.set_name(segment_reduction.name());
+  fused_op.set_device(segment_reduction.device());
+  fused_op.set_op(segment_reduction.op() == "SegmentSum" ? "SparseSegmentSum"
+                                                         : "SparseSegmentMean");
+  fused_op.add_input(gather.input(0));             // 0: data
+  fused_op.add_input(gather.input(1));             // 1: indices
+  fused_op.add_input(segment_reduction.input(1));  // 2: segment_ids
+
+  auto* attr = fused_op.mutable_attr();
+  (*attr)["T"] = segment_reduction.attr().at("T");
+  (*attr)["Tidx"] = gather.attr().at("Tindices");
+  (*attr)["Tsegmentids"] = segment_reduction.attr().at("Tindices");
+
+  utils::Mutation* mutation = ctx->graph_view.GetMutationBuilder();
+  absl::Status status;
+  mutation->AddNode(std::move(fused_op), &status);
+  TF_RETURN_IF_ERROR(status);
+  TF_RETURN_IF_ERROR(mutation->Apply());
+
+  (*invalidated_nodes)[matched.segment_reduction] = true;
+  (*nodes_to_delete)[matched.gather] = true;
+
+  return absl::OkStatus();
+}
+
+absl::Status AddStringNGramsHashBucketNode(
+    RemapperContext* ctx, const StringNGramsToHashBucket& matched,
+    std::vector<bool>* invalidated_nodes, std::vector<bool>* nodes_to_delete) {
+  const GraphDef* graph = ctx->graph_view.graph();
+  const NodeDef& string_ngrams = graph->node(matched.string_ngrams);
+  const NodeDef& string_to_hash_bucket =
+      graph->node(matched.string_to_hash_bucket);
+  VLOG(2) << "Fuse StringNGrams with StringToHashBucketFast:"
+          << " string_ngrams=" << string_ngrams.name()
+          << " string_to_hash_bucket=" << string_to_hash_bucket.name();
+
+  // The fused node replaces StringNGrams, whose ngrams_splits output may have
+  // other consumers, and the consumers of the hashes read them through an
+  // Identity that replaces StringToHashBucketFast.
+  NodeDef fused_op = string_ngrams;
+  fused_op.set_op(kStringNGramsHashBucket);
+  (*fused_op.mutable_attr())["num_buckets"] =
+      string_to_hash_bucket.attr().at("num_buckets");
+
+  NodeDef identity;
+  identity.set_name(string_to_hash_bucket.name());
+  identity.set_device(string_to_hash_bucket.device());
+  identity.set_op("Identity");
+  identity.add_input(string_ngrams.name());
+  SetAttrValue(DT_INT64, &(*identity.mutable_attr())["T"]);
+
+  utils::Mutation* mutation = ctx->graph_view.GetMutationBuilder();
+  absl::Status status;
+  mutation->AddNode(std::move(fused_op), &status);
+  TF_RETURN_IF_ERROR(status);
+  mutation->AddNode(std::move(identity), &status);
+  TF_RETURN_IF_ERROR(status);
+  TF_RETURN_IF_ERROR(mutation->Apply());
+
+  (*invalidated_nodes)[matched.string_ngrams] = true;
+  (*invalidated_nodes)[matched.string_to_hash_bucket] = true;
+
+  return absl::OkStatus();
+}
+
+absl::Status AddFusedMinMaxNode(RemapperContext* ctx,
+                                const SiblingMinMax& matched,
+                                std::vector<bool>* invalidated_nodes,
+                                std::vector<bool>* nodes_to_delete) {
+  const GraphDef* graph = ctx->graph_view.graph();
+  const NodeDef& min = graph->node(matched.min);
+  const NodeDef& max = graph->node(matched.max);
+  VLOG(2) << "Fuse Min with Max: min=" << min.name() << " max=" << max.name();
+
+  // Min and Max become Identities of the outputs of the fused node, so that
+  // their consumers are unchanged.
+  NodeDef fused_op = max;
+  fused_op.set_name(AddPrefixToNodeName("MinMax", max.name()));
+  fused_op.set_op(kFusedMinMax);
+  if (ctx->graph_view.GetNode(fused_op.name()) != nullptr) {
+    return absl::OkStatus();
+  }
+
+  auto make_identity = [&fused_op](const NodeDef& node, int port) {
+    NodeDef identity;
+    identity.set_name(node.name());
+    identity.set_device(node.device());
+    identity.set_op("Identity");
+    identity.add_input(absl::StrCat(fused_op.name(), ":", port));
+    (*identity.mutable_attr())["T"] = node.attr().at("T");
+    return identity;
+  };
+  NodeDef min_identity = make_identity(min, 0);
+  NodeDef max_identity = make_identity(max, 1);
+
+  utils::Mutation* mutation = ctx->graph_view.GetMutationBuilder();
+  absl::Status status;
+  mutation->AddNode(std::move(fused_op), &status);
+  TF_RETURN_IF_ERROR(status);
+  mutation->AddNode(std::move(min_identity), &status);
+  TF_RETURN_IF_ERROR(status);
+  mutation->AddNode(std::move(max_identity), &status);
+  TF_RETURN_IF_ERROR(status);
+  TF_RETURN_IF_ERROR(mutation->Apply());
+
+  (*invalidated_nodes)[matched.min] = true;
+  (*invalidated_nodes)[matched.max] = true;
+
+  return absl::OkStatus();
+}
+
 absl::Status AddFusedBatchMatMul(RemapperContext* ctx,
                                  const std::map<string, int>& matched_nodes_map,
                                  const std::set<int>& remove_node_indices,
@@ -4410,6 +4824,41 @@ absl::Status AddFusedBatchMatMul(RemapperContext* ctx,
   return absl::OkStatus();
 }
 
+absl::Status AddFusedScaledDotProductAttention(
+    RemapperContext* ctx, const std::map<string, int>& matched_nodes_map,
+    const std::set<int>& remove_node_indices,
+    std::vector<bool>* invalidated_nodes, std::vector<bool>* nodes_to_delete) {
+  auto* output_node =
+      ctx->graph_view.GetNode(matched_nodes_map.at("output"))->node();
+  auto* scores_node =
+      ctx->graph_view.GetNode(matched_nodes_map.at("scores"))->node();
+  auto* mul_node = ctx->graph_view.GetNode(matched_nodes_map.at("mul"))->node();
+
+  NodeDef fused_node;
+  fused_node.set_name(output_node->name());
+  fused_node.set_op(kFusedScaledDotProductAttention);
+  fused_node.set_device(output_node->device());
+  fused_node.add_input(scores_node->input(0));
+  fused_node.add_input(scores_node->input(1));
+  fused_node.add_input(output_node->input(1));
+  fused_node.add_input(NodeName(mul_node->input(0)) == scores_node->name()
+                           ? mul_node->input(1)
+                           : mul_node->input(0));
+  (*fused_node.mutable_attr())["T"] = output_node->attr().at("T");
+
+  utils::Mutation* mutation = ctx->graph_view.GetMutationBuilder();
+  absl::Status status;
+  mutation->AddNode(std::move(fused_node), &status);
+  TF_RETURN_IF_ERROR(status);
+  TF_RETURN_IF_ERROR(mutation->Apply());
+  (*invalidated_nodes)[matched_nodes_map.at("output")] = true;
+
+  for (const auto& node_idx : remove_node_indices) {
+    (*nodes_to_delete)[node_idx] = true;
+  }
+  return absl::OkStatus();
+}
+
 // Helper function to get data of type T from a given tensor and
 // return them in a vector and casted to type U.
 // Note - use this function only when type cast is safe from T to U.
@@ -4713,6 +5162,7 @@ absl::Status ReplaceSoftplusTanhAndMulWithMish(
 //   (3) Fusing Conv2D biasadd and relu on GPU
 //   (4) INTEL_MKL specific: Conv2D -> Add or Conv2D -> BiasAdd -> Add.
 //   (5) Fusing side output and/or activation into FusedBatchNormGrad.
+//   (6) Remapping Gather+SegmentSum/SegmentMean into SparseSegmentSum/Mean.
 bool RequiresInferredShapes(const RemapperContext& ctx, int node_index,
                             const Cluster* cluster) {
   // Candidate for a FusedBatchNorm splitting.
@@ -4850,17 +5300,30 @@ bool RequiresInferredShapes(const RemapperContext& ctx, int node_index,
     return true;
   };
 
+  // Candidate for a Gather+SegmentSum/SegmentMean remapping.
+  const auto is_gather_segment_reduction_candidate = [&]() -> bool {
+    if (node_def->op() != "SegmentSum" && node_def->op() != "SegmentMean") {
+      return false;
+    }
+    if (node_view->NumRegularFanins() < 2) return false;
+    const auto* gather_node_def =
+        node_view->GetRegularFanin(0).node_view()->node();
+    return gather_node_def->op() == "Gather" ||
+           gather_node_def->op() == "GatherV2";
+  };
+
   if (IsMKLEnabled())
     return is_batch_norm_candidate() || is_batch_norm_fusion_candidate() ||
            IsContractionWithAdd(ctx, node_index) ||
            is_act_biasadd_conv_candidate() || IsBiasAdd(*node_def) ||
-           IsTranspose(*node_def);
+           IsTranspose(*node_def) || is_gather_segment_reduction_candidate();
 
   return is_act_biasadd_conv_candidate() || is_batch_norm_candidate() ||
          is_batch_norm_fusion_candidate() ||
          is_batch_norm_grad_fusion_candidate() ||
          is_matmul_gelu_exact_fusion_candidate() ||
-         is_act_biasadd_matmul_candidate();
+         is_act_biasadd_matmul_candidate() ||
+         is_gather_segment_reduction_candidate();
 }
 
 inline bool IsXlaCpuGlobalJitOn() {
@@ -5132,6 +5595,19 @@ absl::Status Remapper::Optimize(Cluster* cluster, const GrapplerItem& item,
       continue;
     }
 
+    // Remap BatchMatMul+Mul+Softmax+BatchMatMul attention into the
+    // _FusedScaledDotProductAttention.
+    matched_nodes_map.clear();
+    remove_node_indices.clear();
+    if (allow_non_differentiable_rewrites &&
+        FindScaledDotProductAttention(&ctx, i, &matched_nodes_map,
+                                      &remove_node_indices)) {
+      TF_RETURN_IF_ERROR(AddFusedScaledDotProductAttention(
+          &ctx, matched_nodes_map, remove_node_indices, &invalidated_nodes,
+          &nodes_to_delete));
+      continue;
+    }
+
     // Fusions are disabled on XLA CPU in IsCpuCompatible(...) invoked by the
     // following fusions.
     //
@@ -5223,6 +5699,35 @@ absl::Status Remapper::Optimize(Cluster* cluster, const GrapplerItem& item,
       continue;
     }
 
+    // Remap Gather+SegmentSum/SegmentMean into SparseSegmentSum/Mean.
+    GatherWithSegmentReduction gather_with_segment_reduction;
+    if (FindGatherWithSegmentReduction(ctx, i,
+                                       &gather_with_segment_reduction)) {
+      TF_RETURN_IF_ERROR(AddSparseSegmentReductionNode(
+          &ctx, gather_with_segment_reduction, &invalidated_nodes,
+          &nodes_to_delete));
+      continue;
+    }
+
+    StringNGramsToHashBucket string_ngrams_to_hash_bucket;
+    if (allow_non_differentiable_rewrites &&
+        FindStringNGramsToHashBucket(ctx, i, &string_ngrams_to_hash_bucket)) {
+      TF_RETURN_IF_ERROR(AddStringNGramsHashBucketNode(
+          &ctx, string_ngrams_to_hash_bucket, &invalidated_nodes,
+          &nodes_to_delete));
+      continue;
+    }
+
+    SiblingMinMax sibling_min_max;
+    if (allow_non_differentiable_rewrites &&
+        FindSiblingMinMax(ctx, i, invalidated_nodes, nodes_to_delete,
+                          &sibling_min_max)) {
+      TF_RETURN_IF_ERROR(AddFusedMinMaxNode(&ctx, sibling_min_max,
+                                            &invalidated_nodes,
+                                            &nodes_to_delete));
+      continue;
+    }
+
     // During inference, most of the inputs to FusedBatchNorm are constant, and
     // we can therefore replace the op with a much cheaper set of primitives.
     FusedBatchNorm fused_batch_norm;
@@ -1767,6 +1767,217 @@ TEST_F(RemapperTensorToHashBucketTest, I32) { RunTest<DT_INT32>(); }
 
 TEST_F(RemapperTensorToHashBucketTest, I64) { RunTest<DT_INT64>(); }
 
+class RemapperGatherWithSegmentReductionTest : public RemapperTest {
+ public:
+  void RunTest(bool mean) {
+    using ::tensorflow::ops::Placeholder;
+
+    tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+    auto params = Placeholder(s.WithOpName("params"), DT_FLOAT,
+                              ops::Placeholder::Shape({16, 8}));
+    auto ids = ops::Const(s.WithOpName("ids"), {3, 0, 7, 7, 15, 2});
+    auto segment_ids =
+        ops::Const(s.WithOpName("segment_ids"), {0, 0, 1, 2, 2, 2});
+    auto axis = ops::Const(s.WithOpName("axis"), 0);
+    auto gather = ops::GatherV2(s.WithOpName("gather"), params, ids, axis);
+    Output segment_reduction =
+        mean ? ops::SegmentMean(s.WithOpName("segment_reduction"), gather,
+                                segment_ids)
+                   .output
+             : ops::SegmentSum(s.WithOpName("segment_reduction"), gather,
+                               segment_ids)
+                   .output;
+    auto fetch = ops::Identity(s.WithOpName("fetch"), segment_reduction);
+
+    auto params_t = GenerateRandomTensor<DT_FLOAT>({16, 8});
+
+    GrapplerItem item;
+    item.fetch = {"fetch"};
+    item.feed = {{"params", params_t}};
+    TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+    for (int i = 0; i < item.graph.node_size(); ++i) {
+      item.graph.mutable_node(i)->set_device("/device:CPU:0");
+    }
+
+    Remapper optimizer(RewriterConfig::ON);
+    GraphDef output;
+    TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+    int found = 0;
+    for (const NodeDef& node : output.node()) {
+      EXPECT_NE(node.name(), "gather");
+      if (node.name() == "segment_reduction") {
+        EXPECT_EQ(node.op(), mean ? "SparseSegmentMean" : "SparseSegmentSum");
+        ASSERT_EQ(node.input_size(), 3);
+        EXPECT_EQ(node.input(0), "params");
+        EXPECT_EQ(node.input(1), "ids");
+        EXPECT_EQ(node.input(2), "segment_ids");
+        found++;
+      }
+    }
+    EXPECT_EQ(found, 1);
+
+    auto tensors_expected = EvaluateNodes(item.graph, item.fetch, item.feed);
+    ASSERT_EQ(tensors_expected.size(), 1);
+    auto tensors = EvaluateNodes(output, item.fetch, item.feed);
+    ASSERT_EQ(tensors.size(), 1);
+    test::ExpectTensorNear<float>(tensors[0], tensors_expected[0], 1e-6);
+  }
+};
+
+TEST_F(RemapperGatherWithSegmentReductionTest, SegmentSum) { RunTest(false); }
+
+TEST_F(RemapperGatherWithSegmentReductionTest, SegmentMean) { RunTest(true); }
+
+TEST_F(RemapperGatherWithSegmentReductionTest, MatrixIndicesNotRemapped) {
+  using ::tensorflow::ops::Placeholder;
+
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+  auto params = Placeholder(s.WithOpName("params"), DT_FLOAT,
+                            ops::Placeholder::Shape({16, 8}));
+  // The sparse segment reductions only take a vector of indices.
+  auto ids = ops::Const(s.WithOpName("ids"), {{3, 0}, {7, 15}});
+  auto segment_ids = ops::Const(s.WithOpName("segment_ids"), {0, 1});
+  auto axis = ops::Const(s.WithOpName("axis"), 0);
+  auto gather = ops::GatherV2(s.WithOpName("gather"), params, ids, axis);
+  auto segment_sum =
+      ops::SegmentSum(s.WithOpName("segment_reduction"), gather, segment_ids);
+  auto fetch = ops::Identity(s.WithOpName("fetch"), segment_sum);
+
+  GrapplerItem item;
+  item.fetch = {"fetch"};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  for (int i = 0; i < item.graph.node_size(); ++i) {
+    item.graph.mutable_node(i)->set_device("/device:CPU:0");
+  }
+
+  Remapper optimizer(RewriterConfig::ON);
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  int found = 0;
+  for (const NodeDef& node : output.node()) {
+    if (node.name() == "gather") {
+      EXPECT_EQ(node.op(), "GatherV2");
+      found++;
+    }
+    if (node.name() == "segment_reduction") {
+      EXPECT_EQ(node.op(), "SegmentSum");
+      found++;
+    }
+  }
+  EXPECT_EQ(found, 2);
+}
+
+TEST_F(RemapperTest, FuseStringNGramsWithHashBucket) {
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+  auto data = ops::Placeholder(s.WithOpName("data"), DT_STRING,
+                               ops::Placeholder::Shape({6}));
+  auto data_splits =
+      ops::Const<int64_t>(s.WithOpName("data_splits"), {0, 4, 6}, {3});
+  auto ngrams = ops::StringNGrams(s.WithOpName("ngrams"), data, data_splits,
+                                  /*separator=*/" ", /*ngram_widths=*/{1, 2},
+                                  /*left_pad=*/"<", /*right_pad=*/">",
+                                  /*pad_width=*/-1,
+                                  /*preserve_short_sequences=*/false);
+  auto to_bucket = ops::StringToHashBucketFast(s.WithOpName("to_bucket"),
+                                               ngrams.ngrams, 100);
+  auto fetch = ops::Identity(s.WithOpName("fetch"), to_bucket);
+  auto fetch_splits =
+      ops::Identity(s.WithOpName("fetch_splits"), ngrams.ngrams_splits);
+
+  Tensor data_t(DT_STRING, TensorShape({6}));
+  test::FillValues<tstring>(&data_t, {"a", "b", "c", "d", "e", "f"});
+
+  GrapplerItem item;
+  item.fetch = {"fetch", "fetch_splits"};
+  item.feed = {{"data", data_t}};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  for (int i = 0; i < item.graph.node_size(); ++i) {
+    item.graph.mutable_node(i)->set_device("/device:CPU:0");
+  }
+
+  Remapper optimizer(RewriterConfig::ON);
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  int found = 0;
+  for (const NodeDef& node : output.node()) {
+    if (node.name() == "ngrams") {
+      EXPECT_EQ(node.op(), "_StringNGramsHashBucketFast");
+      EXPECT_EQ(node.attr().at("num_buckets").i(), 100);
+      found++;
+    } else if (node.name() == "to_bucket") {
+      EXPECT_EQ(node.op(), "Identity");
+      ASSERT_EQ(node.input_size(), 1);
+      EXPECT_EQ(node.input(0), "ngrams");
+      found++;
+    }
+  }
+  EXPECT_EQ(found, 2);
+
+  auto tensors_expected = EvaluateNodes(item.graph, item.fetch, item.feed);
+  ASSERT_EQ(tensors_expected.size(), 2);
+  auto tensors = EvaluateNodes(output, item.fetch, item.feed);
+  ASSERT_EQ(tensors.size(), 2);
+  test::ExpectTensorEqual<int64_t>(tensors[0], tensors_expected[0]);
+  test::ExpectTensorEqual<int64_t>(tensors[1], tensors_expected[1]);
+}
+
+TEST_F(RemapperTest, FuseSiblingMinMax) {
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+  auto x = ops::Placeholder(s.WithOpName("x"), DT_FLOAT,
+                            ops::Placeholder::Shape({4, 8, 16}));
+  auto axes = ops::Const(s.WithOpName("axes"), {0, 2});
+  auto min = ops::Min(s.WithOpName("min"), x, axes);
+  auto max = ops::Max(s.WithOpName("max"), x, axes);
+  auto fetch_min = ops::Identity(s.WithOpName("fetch_min"), min);
+  auto fetch_max = ops::Identity(s.WithOpName("fetch_max"), max);
+
+  auto x_t = GenerateRandomTensor<DT_FLOAT>({4, 8, 16});
+
+  GrapplerItem item;
+  item.fetch = {"fetch_min", "fetch_max"};
+  item.feed = {{"x", x_t}};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  for (int i = 0; i < item.graph.node_size(); ++i) {
+    item.graph.mutable_node(i)->set_device("/device:CPU:0");
+  }
+
+  Remapper optimizer(RewriterConfig::ON);
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  int found = 0;
+  for (const NodeDef& node : output.node()) {
+    if (node.op() == "_FusedMinMax") {
+      ASSERT_EQ(node.input_size(), 2);
+      EXPECT_EQ(node.input(0), "x");
+      EXPECT_EQ(node.input(1), "axes");
+      found++;
+    } else if (node.name() == "min" || node.name() == "max") {
+      EXPECT_EQ(node.op(), "Identity");
+      found++;
+    }
+  }
+  EXPECT_EQ(found, 3);
+
+  auto tensors_expected = EvaluateNodes(item.graph, item.fetch, item.feed);
+  ASSERT_EQ(tensors_expected.size(), 2);
+  auto tensors = EvaluateNodes(output, item.fetch, item.feed);
+  ASSERT_EQ(tensors.size(), 2);
+  test::ExpectTensorEqual<float>(tensors[0], tensors_expected[0]);
+  test::ExpectTensorEqual<float>(tensors[1], tensors_expected[1]);
+}
+
 class RemapperFuseMatMulWithBiasTest : public RemapperTest {
  public:
   template <DataType DTYPE>
@@ -3044,6 +3255,91 @@ TEST_F(RemapperControlDependencyPatternMatcher, BF16) {
   RunTest<DT_BFLOAT16>();
 }
 
+class RemapperFuseScaledDotProductAttention : public RemapperTest {
+ public:
+  void RunTest(bool transpose_key, bool expect_fused) {
+    using ::tensorflow::ops::Placeholder;
+    tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+    const TensorShape query_shape = {2, 4, 8, 16};
+    const TensorShape key_shape = transpose_key ? TensorShape({2, 4, 16, 100})
+                                                : TensorShape({2, 4, 100, 16});
+    const TensorShape value_shape = {2, 4, 100, 32};
+
+    auto query = Placeholder(s.WithOpName("query"), DT_FLOAT,
+                             ops::Placeholder::Shape(query_shape));
+    auto key = Placeholder(s.WithOpName("key"), DT_FLOAT,
+                           ops::Placeholder::Shape(key_shape));
+    auto value = Placeholder(s.WithOpName("value"), DT_FLOAT,
+                             ops::Placeholder::Shape(value_shape));
+    auto scores = ops::BatchMatMulV2(
+        s.WithOpName("scores"), query, key,
+        ops::BatchMatMulV2::Attrs().AdjY(!transpose_key));
+    auto scale = ops::Const(s.WithOpName("scale"), 0.25f);
+    auto mul = ops::Multiply(s.WithOpName("mul"), scores, scale);
+    auto softmax = ops::Softmax(s.WithOpName("softmax"), mul);
+    auto attention = ops::BatchMatMulV2(s.WithOpName("attention"), softmax,
+                                        value);
+    auto fetch = ops::Identity(s.WithOpName("fetch"), attention);
+
+    auto query_t = GenerateTensorWithSetRandom<DT_FLOAT>(query_shape);
+    auto key_t = GenerateTensorWithSetRandom<DT_FLOAT>(key_shape);
+    auto value_t = GenerateTensorWithSetRandom<DT_FLOAT>(value_shape);
+
+    GrapplerItem item;
+    item.fetch = {"fetch"};
+    item.feed = {{"query", query_t}, {"key", key_t}, {"value", value_t}};
+    TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+    // Place all nodes on CPU.
+    for (int i = 0; i < item.graph.node_size(); ++i) {
+      item.graph.mutable_node(i)->set_device("/device:CPU:0");
+    }
+
+    Remapper optimizer(RewriterConfig::ON);
+    GraphDef output;
+    TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+    int found = 0;
+    for (const NodeDef& node : output.node()) {
+      if (node.name() == "attention") {
+        if (!expect_fused) {
+          EXPECT_EQ(node.op(), "BatchMatMulV2");
+          continue;
+        }
+        EXPECT_EQ(node.op(), "_FusedScaledDotProductAttention");
+        ASSERT_EQ(node.input_size(), 4);
+        EXPECT_EQ(node.input(0), "query");
+        EXPECT_EQ(node.input(1), "key");
+        EXPECT_EQ(node.input(2), "value");
+        EXPECT_EQ(node.input(3), "scale");
+        found++;
+      }
+      if (expect_fused) {
+        EXPECT_NE(node.op(), "Softmax");
+      }
+    }
+    EXPECT_EQ(expect_fused ? 1 : 0, found);
+
+    auto tensors_expected = EvaluateNodes(item.graph, item.fetch, item.feed);
+    ASSERT_EQ(tensors_expected.size(), 1);
+    auto tensors = EvaluateNodes(output, item.fetch, item.feed);
+    ASSERT_EQ(tensors.size(), 1);
+    test::ExpectClose(tensors[0], tensors_expected[0], 1e-5);
+  }
+};
+
+TEST_F(RemapperFuseScaledDotProductAttention, F32) {
+  RunTest(/*transpose_key=*/false, /*expect_fused=*/true);
+}
+
+TEST_F(RemapperFuseScaledDotProductAttention, KeyNotTransposed) {
+  // Attention over a key that is already transposed is not fused, since the
+  // kernel expects keys in the same layout as the queries.
+  RunTest(/*transpose_key=*/true, /*expect_fused=*/false);
+}
+
+
 class XlaCpuJitDisableFusionTest : public RemapperTest {
  protected:
   void SetUp() override {
@@ -25,6 +25,7 @@ limitations under the License.
 #include "tensorflow/core/grappler/op_types.h"
 #include "tensorflow/core/grappler/utils/frame.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
+#include "tensorflow/core/lib/math/math_util.h"
 
 // Like TF_RETURN_IF_ERROR, but also logs a WARNING.
 #define LOG_WARNING_AND_RETURN_IF_ERROR(...)            \
@@ -896,7 +897,7 @@ class UnaryElementwiseRewriter : public ScopedAllocatorOptimizer::Rewriter {
 
 ScopedAllocatorOptimizer::ScopedAllocatorOptimizer(
     RewriterConfig::Toggle opt_level, const ScopedAllocatorOptions& opts)
-    : opt_level_(opt_level) {
+    : opt_level_(opt_level), max_bucket_bytes_(opts.max_bucket_bytes()) {
   VLOG(1) << "ScopedAllocatorOptimizer::ScopedAllocatorOptimizer";
   Rewriter* r = new UnaryElementwiseRewriter();
   to_delete_.push_back(r);
@@ -1069,6 +1070,40 @@ void PartitionByLoopStructure(const FrameView& frame_view,
   }
 }
 
+// Splits `nodes` into consecutive buckets whose backing buffers, laid out as by
+// ScopedAllocatorMgr::PopulateFields, don't exceed `max_bucket_bytes`.  A node
+// whose output size is unknown doesn't count towards the limit; the rewriter
+// rejects its bucket later if the size turns out to be needed.
+void PartitionIntoSizeBuckets(const GraphProperties& graph_properties,
+                              int64_t max_bucket_bytes,
+                              const std::vector<NodeDef*>& nodes,
+                              std::vector<std::vector<NodeDef*>>* buckets) {
+  if (max_bucket_bytes <= 0) {
+    buckets->push_back(nodes);
+    return;
+  }
+  int64_t bucket_bytes = 0;
+  for (NodeDef* nd : nodes) {
+    int64_t bytes = 0;
+    const std::vector<OpInfo::TensorProperties>& prop_list =
+        graph_properties.GetOutputProperties(nd->name());
+    if (prop_list.size() == 1 && TensorShape::IsValid(prop_list[0].shape()) &&
+        !prop_list[0].shape().unknown_rank()) {
+      bytes = TensorShape(prop_list[0].shape()).num_elements() *
+              DataTypeSize(prop_list[0].dtype());
+      bytes = MathUtil::CeilOfRatio<int64_t>(bytes,
+                                             Allocator::kAllocatorAlignment) *
+              Allocator::kAllocatorAlignment;
+    }
+    if (buckets->empty() || bucket_bytes + bytes > max_bucket_bytes) {
+      buckets->emplace_back();
+      bucket_bytes = 0;
+    }
+    buckets->back().push_back(nd);
+    bucket_bytes += bytes;
+  }
+}
+
 // Identify outputs that are inputs to multiple sets of nodes.
 void IdentifyRepeatedInputs(const std::vector<NodeDef*>& nodes,
                             absl::flat_hash_set<string>* seen_outputs,
@@ -1130,7 +1165,8 @@ absl::Status ScopedAllocatorOptimizer::ProcessGraphDef(
         // in the same Tree struct.  Split those groups into subgroups that
         // share identical loop nesting.
         status = ApplyToAll(root.get(), [this, rewriter, graph, &frame_view,
-                                         &op_name, invocation_count](Tree* t) {
+                                         &graph_properties, &op_name,
+                                         invocation_count](Tree* t) {
           VLOG(2) << "applied to tree node " << t->edge_ << " at depth "
                   << t->depth_ << " of size " << t->nodes_.size();
           if (t->nodes_.size() > 1) {
@@ -1138,13 +1174,20 @@ absl::Status ScopedAllocatorOptimizer::ProcessGraphDef(
             PartitionByLoopStructure(frame_view, t->nodes_, &loop_groups);
             for (auto& lg : loop_groups) {
               if (lg.size() > 1) {
-                bool applied = false;
                 absl::Status s = OrderNodeSet(&lg);
                 TF_RETURN_IF_ERROR(s);
-                VLOG(1) << "Applying Rewriter for " << op_name;
-                s = rewriter->Rewrite(this, invocation_count, graph, op_name,
-                                      lg, &applied);
-                LOG_WARNING_AND_RETURN_IF_ERROR(s);
+                std::vector<std::vector<NodeDef*>> buckets;
+                PartitionIntoSizeBuckets(graph_properties, max_bucket_bytes_,
+                                         lg, &buckets);
+                for (auto& bucket : buckets) {
+                  if (bucket.size() <= 1) continue;
+                  bool applied = false;
+                  VLOG(1) << "Applying Rewriter for " << op_name
+                          << " to a bucket of size " << bucket.size();
+                  s = rewriter->Rewrite(this, invocation_count, graph, op_name,
+                                        bucket, &applied);
+                  LOG_WARNING_AND_RETURN_IF_ERROR(s);
+                }
               }
             }
           }
@@ -1203,7 +1246,12 @@ absl::Status ScopedAllocatorOptimizer::OrderNodeSet(
     std::vector<NodeDef*>* nodes) const {
   // Nodes should be identical type.  Default order is by name but for
   // collectives we order by increasing instance_key so each group gets
-  // the same instance_key.
+  // the same instance_key.  The order must only depend on the collectives,
+  // not on the rest of the graph, which differs between tasks: every task
+  // must fill the size buckets with the same collectives.  Instance keys are
+  // assigned in the order the collectives are created, which for gradients
+  // is the order of the backward pass, so the collectives of a bucket
+  // become ready at about the same time.
   if (nodes->size() <= 1) return absl::OkStatus();
   if (IsCollectiveNode(*nodes->at(0))) {
     std::sort(nodes->begin(), nodes->end(), InstanceKeyLess());
@@ -14,11 +14,15 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/grappler/optimizers/scoped_allocator_optimizer.h"
 
+#include <set>
 #include <unordered_set>
+#include <vector>
 
 #include "tensorflow/cc/ops/array_ops.h"
 #include "tensorflow/cc/ops/standard_ops.h"
+#include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/node_def_builder.h"
 #include "tensorflow/core/framework/tensor.pb.h"  // NOLINT
 #include "tensorflow/core/framework/tensor_shape.pb.h"
 #include "tensorflow/core/framework/tensor_testutil.h"
@@ -596,6 +600,108 @@ TEST_F(ScopedAllocatorOptimizerTest, ConstInput) {
   }
   EXPECT_EQ(num_identity_ops, 2);
 }
+
+TEST_F(ScopedAllocatorOptimizerTest, SizeBuckets) {
+  // Four 2x2 float outputs each take one kAllocatorAlignment sized field, so a
+  // limit of two fields splits the group into two scoped allocators.
+  Scope s = Scope::NewRootScope();
+  s = s.WithDevice("/job:localhost/replica:0/task:0/device:CPU:0");
+  for (int i = 1; i <= 4; ++i) {
+    Output c = ops::Const<float>(s.WithOpName(strings::StrCat("c", i)),
+                                 {1.0, -2.0, 3.0, -4.0}, {2, 2});
+    Output d = ops::Const<float>(s.WithOpName(strings::StrCat("d", i)),
+                                 {1.0, 1.0, 1.0, 1.0}, {2, 2});
+    Output add = ops::Add(s.WithOpName(strings::StrCat("s", i)), c, d);
+    Output abs = ops::Abs(s.WithOpName(strings::StrCat("a", i)), add);
+    ops::Reshape(s.WithOpName(strings::StrCat("r", i)), abs, {1, 4});
+  }
+  GrapplerItem item;
+  TF_CHECK_OK(s.ToGraphDef(&item.graph));
+  SetShapes(&item.graph);
+
+  ScopedAllocatorOptions opts;
+  opts.add_enable_op("Abs");
+  opts.set_max_bucket_bytes(2 * Allocator::kAllocatorAlignment);
+  ScopedAllocatorOptimizer sao(RewriterConfig::ON, opts);
+  GraphDef optimized_graph;
+  TF_ASSERT_OK(sao.Optimize(/*cluster=*/nullptr, item, &optimized_graph));
+
+  int num_scoped_allocators = 0;
+  for (const NodeDef& node : optimized_graph.node()) {
+    if (node.op() == "_ScopedAllocator") {
+      ++num_scoped_allocators;
+      std::vector<TensorShape> shapes;
+      TF_ASSERT_OK(GetNodeAttr(AttrSlice(node), "shapes", &shapes));
+      EXPECT_EQ(2, shapes.size());
+    }
+  }
+  EXPECT_EQ(2, num_scoped_allocators);
+}
+
+// Returns the instance keys of the CollectiveReduce ops of the graph of
+// `task`, once optimized with size buckets of two collectives. The graph has
+// four CollectiveReduce ops, and the input of collective `delayed` goes
+// through a chain of Identity ops.
+std::set<int> CollectiveInstanceKeysAfterBucketing(int task, int delayed) {
+  const string device =
+      strings::StrCat("/job:worker/replica:0/task:", task, "/device:CPU:0");
+  Scope s = Scope::NewRootScope().WithDevice(device);
+  std::vector<Output> inputs;
+  for (int i = 1; i <= 4; ++i) {
+    Output input = ops::Const<float>(s.WithOpName(strings::StrCat("c", i)),
+                                     {1.0, -2.0, 3.0, -4.0}, {2, 2});
+    if (i == delayed) {
+      for (int j = 0; j < 3; ++j) {
+        input = ops::Identity(s.WithOpName(strings::StrCat("i", i, "_", j)),
+                              input);
+      }
+    }
+    inputs.push_back(input);
+  }
+  GrapplerItem item;
+  TF_CHECK_OK(s.ToGraphDef(&item.graph));
+  for (int i = 1; i <= 4; ++i) {
+    const Output& input = inputs[i - 1];
+    NodeDef* reduce = item.graph.add_node();
+    TF_CHECK_OK(NodeDefBuilder(strings::StrCat("r", i), "CollectiveReduce")
+                    .Input(input.node()->name(), input.index(), DT_FLOAT)
+                    .Attr("group_size", 2)
+                    .Attr("group_key", 1)
+                    .Attr("instance_key", i)
+                    .Attr("merge_op", "Add")
+                    .Attr("final_op", "Id")
+                    .Attr("subdiv_offsets", std::vector<int>({0}))
+                    .Device(device)
+                    .Finalize(reduce));
+  }
+
+  ScopedAllocatorOptions opts;
+  opts.set_max_bucket_bytes(2 * Allocator::kAllocatorAlignment);
+  ScopedAllocatorOptimizer sao(RewriterConfig::ON, opts);
+  GraphDef optimized_graph;
+  TF_CHECK_OK(sao.Optimize(/*cluster=*/nullptr, item, &optimized_graph));
+
+  std::set<int> instance_keys;
+  for (const NodeDef& node : optimized_graph.node()) {
+    if (node.op() != "CollectiveReduce") continue;
+    int instance_key;
+    TF_CHECK_OK(GetNodeAttr(AttrSlice(node), "instance_key", &instance_key));
+    instance_keys.insert(instance_key);
+  }
+  return instance_keys;
+}
+
+TEST_F(ScopedAllocatorOptimizerTest, SameCollectiveBucketsOnAllTasks) {
+  // The input of the first collective is ready later on task 1 than on task
+  // 0. Both tasks must still bucket the collectives by instance key, so that
+  // the fused collectives match across tasks.
+  const std::set<int> task0_keys =
+      CollectiveInstanceKeysAfterBucketing(/*task=*/0, /*delayed=*/0);
+  const std::set<int> task1_keys =
+      CollectiveInstanceKeysAfterBucketing(/*task=*/1, /*delayed=*/1);
+  EXPECT_EQ(task0_keys, std::set<int>({1, 3}));
+  EXPECT_EQ(task1_keys, task0_keys);
+}
 #endif  // ENABLE_MKL
 
 }  // namespace
@@ -0,0 +1,196 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/sparse_apply_grouping.h"
+
+#include <map>
+#include <set>
+#include <unordered_set>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/utils.h"
+#include "tensorflow/core/grappler/utils/frame.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+constexpr char kSparseApplyOp[] = "ResourceSparseApplyAdagradV2";
+constexpr char kGroupedSparseApplyOp[] = "_GroupedResourceSparseApplyAdagradV2";
+
+// Input positions of ResourceSparseApplyAdagradV2.
+constexpr int kVar = 0;
+constexpr int kAccum = 1;
+constexpr int kLr = 2;
+constexpr int kEpsilon = 3;
+constexpr int kGrad = 4;
+constexpr int kIndices = 5;
+constexpr int kNumInputs = 6;
+
+// Returns true if the grouped kernel is registered for the type of `node`.
+bool HasSupportedType(const NodeDef& node) {
+  auto it = node.attr().find("T");
+  if (it == node.attr().end()) return false;
+  switch (it->second.type()) {
+    case DT_HALF:
+    case DT_BFLOAT16:
+    case DT_FLOAT:
+    case DT_DOUBLE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns the key of the group of `node`: the nodes of a group run on the same
+// device, with the same learning rate, epsilon and attributes.
+string GroupKey(const NodeDef& node) {
+  string key = absl::StrCat(node.device(), "|", node.input(kLr), "|",
+                            node.input(kEpsilon));
+  for (const char* attr : {"T", "Tindices", "use_locking", "update_slots"}) {
+    auto it = node.attr().find(attr);
+    if (it != node.attr().end()) {
+      absl::StrAppend(&key, "|", attr, "=", it->second.ShortDebugString());
+    }
+  }
+  return key;
+}
+
+// Returns true if there is a path from `from` to one of `targets` other than
+// `from`.
+bool ReachesAnyOf(const NodeDef* from, const NodeMap& node_map,
+                  const absl::flat_hash_set<const NodeDef*>& targets) {
+  std::vector<const NodeDef*> stack = {from};
+  absl::flat_hash_set<const NodeDef*> visited = {from};
+  while (!stack.empty()) {
+    const NodeDef* node = stack.back();
+    stack.pop_back();
+    for (const NodeDef* output : node_map.GetOutputs(node->name())) {
+      if (!visited.insert(output).second) continue;
+      if (targets.contains(output)) return true;
+      stack.push_back(output);
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+absl::Status SparseApplyGrouping::Optimize(Cluster* cluster,
+                                           const GrapplerItem& item,
+                                           GraphDef* optimized_graph) {
+  *optimized_graph = item.graph;
+  const std::unordered_set<string> nodes_to_preserve = item.NodesToPreserve();
+  FrameView frame_view;
+  TF_RETURN_IF_ERROR(frame_view.InferFromGraph(*optimized_graph));
+
+  absl::flat_hash_set<const NodeDef*> candidates;
+  for (const NodeDef& node : optimized_graph->node()) {
+    if (node.op() != kSparseApplyOp || !NodeIsOnCpu(&node) ||
+        NumNonControlInputs(node) != kNumInputs || !HasSupportedType(node) ||
+        nodes_to_preserve.count(node.name()) > 0 ||
+        !frame_view.Frames(node).empty()) {
+      continue;
+    }
+    candidates.insert(&node);
+  }
+  if (candidates.size() < 2) return absl::OkStatus();
+
+  // A candidate with a path to another candidate is left on its own, as
+  // grouping it could create a cycle. Grouping the other candidates is then
+  // safe, since none of them has a path to a grouped node.
+  NodeMap node_map(optimized_graph);
+  std::map<string, std::vector<const NodeDef*>> groups;
+  for (const NodeDef& node : optimized_graph->node()) {
+    if (!candidates.contains(&node)) continue;
+    if (ReachesAnyOf(&node, node_map, candidates)) continue;
+    groups[GroupKey(node)].push_back(&node);
+  }
+
+  absl::flat_hash_map<string, string> grouped_name;
+  std::set<string> nodes_to_delete;
+  std::vector<NodeDef> grouped_nodes;
+  for (const auto& [key, members] : groups) {
+    if (members.size() < 2) continue;
+    const NodeDef& first = *members.front();
+    NodeDef grouped;
+    grouped.set_name(AddPrefixToNodeName(first.name(), "GroupedSparseApply"));
+    while (node_map.NodeExists(grouped.name())) {
+      grouped.set_name(AddPrefixToNodeName(grouped.name(), "_"));
+    }
+    grouped.set_op(kGroupedSparseApplyOp);
+    grouped.set_device(first.device());
+    for (const int input : {kVar, kAccum}) {
+      for (const NodeDef* member : members) {
+        grouped.add_input(member->input(input));
+      }
+    }
+    grouped.add_input(first.input(kLr));
+    grouped.add_input(first.input(kEpsilon));
+    for (const int input : {kGrad, kIndices}) {
+      for (const NodeDef* member : members) {
+        grouped.add_input(member->input(input));
+      }
+    }
+    for (const NodeDef* member : members) {
+      for (int i = kNumInputs; i < member->input_size(); ++i) {
+        grouped.add_input(member->input(i));
+      }
+      grouped_name[member->name()] = grouped.name();
+      nodes_to_delete.insert(member->name());
+    }
+    DedupControlInputs(&grouped);
+    auto* attr = grouped.mutable_attr();
+    for (const char* name : {"T", "Tindices", "use_locking", "update_slots"}) {
+      auto it = first.attr().find(name);
+      if (it != first.attr().end()) (*attr)[name] = it->second;
+    }
+    (*attr)["N"].set_i(members.size());
+    VLOG(2) << "Grouped " << members.size() << " " << kSparseApplyOp
+            << " nodes into " << grouped.name();
+    grouped_nodes.push_back(std::move(grouped));
+  }
+  if (grouped_nodes.empty()) return absl::OkStatus();
+
+  // Moves the control dependencies on the grouped nodes to their group.
+  for (NodeDef& node : *optimized_graph->mutable_node()) {
+    bool changed = false;
+    for (string& input : *node.mutable_input()) {
+      if (!IsControlInput(input)) continue;
+      auto it = grouped_name.find(NodeName(input));
+      if (it == grouped_name.end()) continue;
+      input = AsControlDependency(it->second);
+      changed = true;
+    }
+    if (changed) DedupControlInputs(&node);
+  }
+  EraseNodesFromGraph(nodes_to_delete, optimized_graph);
+  for (NodeDef& grouped : grouped_nodes) {
+    *optimized_graph->add_node() = std::move(grouped);
+  }
+  return absl::OkStatus();
+}
+
+}  // end namespace grappler
+}  // end namespace tensorflow
@@ -0,0 +1,51 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_SPARSE_APPLY_GROUPING_H_
+#define TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_SPARSE_APPLY_GROUPING_H_
+
+#include "tensorflow/core/grappler/optimizers/graph_optimizer.h"
+#include "tensorflow/core/protobuf/rewriter_config.pb.h"
+
+namespace tensorflow {
+namespace grappler {
+
+// Merges the ResourceSparseApplyAdagradV2 nodes on the same CPU device that
+// share their learning rate and epsilon into a single
+// _GroupedResourceSparseApplyAdagradV2 node. Models with many embedding tables
+// otherwise run one small kernel, and lock one pair of variables, per table.
+//
+// Nodes are only grouped when none of them depends on another, so that the
+// grouped node can't create a cycle. Control dependencies on the grouped nodes
+// are moved to the grouped node.
+class SparseApplyGrouping : public GraphOptimizer {
+ public:
+  SparseApplyGrouping() = default;
+  explicit SparseApplyGrouping(RewriterConfig::Toggle opt_level) {}
+
+  ~SparseApplyGrouping() override = default;
+
+  string name() const override { return "sparse_apply_grouping"; };
+
+  bool UsesFunctionLibrary() const override { return false; }
+
+  absl::Status Optimize(Cluster* cluster, const GrapplerItem& item,
+                        GraphDef* optimized_graph) override;
+};
+
+}  // end namespace grappler
+}  // end namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_SPARSE_APPLY_GROUPING_H_
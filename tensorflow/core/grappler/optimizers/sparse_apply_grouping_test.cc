@@ -0,0 +1,189 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/sparse_apply_grouping.h"
+
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "tensorflow/core/framework/function_testlib.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/utils/grappler_test.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+using test::function::NDef;
+
+constexpr char kCpu[] = "/job:localhost/replica:0/task:0/device:CPU:0";
+
+class SparseApplyGroupingTest : public GrapplerTest {
+ protected:
+  // Adds the inputs of a sparse update of table `i` to `item`.
+  void AddTable(int i, GrapplerItem* item) {
+    const string suffix = std::to_string(i);
+    for (const string& name : {"var", "accum"}) {
+      *item->graph.add_node() = NDef(name + suffix, "Placeholder", {},
+                                     {{"dtype", DT_RESOURCE}}, kCpu);
+    }
+    *item->graph.add_node() =
+        NDef("grad" + suffix, "Placeholder", {}, {{"dtype", DT_FLOAT}}, kCpu);
+    *item->graph.add_node() = NDef("indices" + suffix, "Placeholder", {},
+                                   {{"dtype", DT_INT64}}, kCpu);
+  }
+
+  NodeDef Apply(int i, const std::vector<string>& control_inputs = {}) {
+    const string suffix = std::to_string(i);
+    std::vector<string> inputs = {"var" + suffix,  "accum" + suffix,
+                                  "lr",            "epsilon",
+                                  "grad" + suffix, "indices" + suffix};
+    inputs.insert(inputs.end(), control_inputs.begin(), control_inputs.end());
+    return NDef("apply" + suffix, "ResourceSparseApplyAdagradV2", inputs,
+                {{"T", DT_FLOAT},
+                 {"Tindices", DT_INT64},
+                 {"use_locking", false},
+                 {"update_slots", true}},
+                kCpu);
+  }
+
+  void AddHyperparameters(GrapplerItem* item) {
+    for (const string& name : {"lr", "epsilon"}) {
+      *item->graph.add_node() =
+          NDef(name, "Placeholder", {}, {{"dtype", DT_FLOAT}}, kCpu);
+    }
+  }
+};
+
+TEST_F(SparseApplyGroupingTest, GroupsSiblingUpdates) {
+  GrapplerItem item;
+  AddHyperparameters(&item);
+  for (int i = 0; i < 3; ++i) AddTable(i, &item);
+  *item.graph.add_node() = NDef("dep", "NoOp", {}, {}, kCpu);
+  *item.graph.add_node() = Apply(0, {"^dep"});
+  *item.graph.add_node() = Apply(1);
+  *item.graph.add_node() = Apply(2);
+  *item.graph.add_node() =
+      NDef("train", "NoOp", {"^apply0", "^apply1", "^apply2"}, {}, kCpu);
+  item.fetch = {"train"};
+
+  SparseApplyGrouping optimizer(RewriterConfig::ON);
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  int found = 0;
+  for (const NodeDef& node : output.node()) {
+    EXPECT_NE(node.op(), "ResourceSparseApplyAdagradV2") << node.name();
+    if (node.op() == "_GroupedResourceSparseApplyAdagradV2") {
+      EXPECT_EQ(node.attr().at("N").i(), 3);
+      ASSERT_EQ(node.input_size(), 15);
+      EXPECT_EQ(node.input(0), "var0");
+      EXPECT_EQ(node.input(2), "var2");
+      EXPECT_EQ(node.input(3), "accum0");
+      EXPECT_EQ(node.input(6), "lr");
+      EXPECT_EQ(node.input(7), "epsilon");
+      EXPECT_EQ(node.input(8), "grad0");
+      EXPECT_EQ(node.input(11), "indices0");
+      EXPECT_EQ(node.input(14), "^dep");
+      ++found;
+    }
+    if (node.name() == "train") {
+      ASSERT_EQ(node.input_size(), 1);
+      EXPECT_EQ(node.input(0), "^GroupedSparseApply/apply0");
+    }
+  }
+  EXPECT_EQ(found, 1);
+}
+
+TEST_F(SparseApplyGroupingTest, KeepsDependentUpdatesApart) {
+  GrapplerItem item;
+  AddHyperparameters(&item);
+  for (int i = 0; i < 3; ++i) AddTable(i, &item);
+  *item.graph.add_node() = Apply(0);
+  // apply1 runs after apply0, so they can't be grouped.
+  *item.graph.add_node() = Apply(1, {"^apply0"});
+  *item.graph.add_node() = Apply(2);
+  *item.graph.add_node() =
+      NDef("train", "NoOp", {"^apply0", "^apply1", "^apply2"}, {}, kCpu);
+  item.fetch = {"train"};
+
+  SparseApplyGrouping optimizer(RewriterConfig::ON);
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  int num_grouped = 0;
+  int num_single = 0;
+  for (const NodeDef& node : output.node()) {
+    if (node.op() == "_GroupedResourceSparseApplyAdagradV2") {
+      EXPECT_EQ(node.attr().at("N").i(), 2);
+      EXPECT_EQ(node.input(0), "var1");
+      EXPECT_EQ(node.input(1), "var2");
+      ++num_grouped;
+    }
+    if (node.op() == "ResourceSparseApplyAdagradV2") {
+      EXPECT_EQ(node.name(), "apply0");
+      ++num_single;
+    }
+  }
+  EXPECT_EQ(num_grouped, 1);
+  EXPECT_EQ(num_single, 1);
+}
+
+TEST_F(SparseApplyGroupingTest, KeepsDifferentHyperparametersApart) {
+  GrapplerItem item;
+  AddHyperparameters(&item);
+  *item.graph.add_node() =
+      NDef("lr2", "Placeholder", {}, {{"dtype", DT_FLOAT}}, kCpu);
+  for (int i = 0; i < 2; ++i) AddTable(i, &item);
+  *item.graph.add_node() = Apply(0);
+  NodeDef apply1 = Apply(1);
+  apply1.set_input(2, "lr2");
+  *item.graph.add_node() = apply1;
+
+  SparseApplyGrouping optimizer(RewriterConfig::ON);
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+  for (const NodeDef& node : output.node()) {
+    EXPECT_NE(node.op(), "_GroupedResourceSparseApplyAdagradV2");
+  }
+}
+
+TEST_F(SparseApplyGroupingTest, KeepsUnsupportedTypesApart) {
+  GrapplerItem item;
+  AddHyperparameters(&item);
+  for (int i = 0; i < 2; ++i) AddTable(i, &item);
+  // The grouped kernel is only registered for real floating point types.
+  for (int i = 0; i < 2; ++i) {
+    NodeDef apply = Apply(i);
+    (*apply.mutable_attr())["T"].set_type(DT_COMPLEX64);
+    *item.graph.add_node() = apply;
+  }
+
+  SparseApplyGrouping optimizer(RewriterConfig::ON);
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+  for (const NodeDef& node : output.node()) {
+    EXPECT_NE(node.op(), "_GroupedResourceSparseApplyAdagradV2");
+  }
+}
+
+}  // namespace
+}  // namespace grappler
+}  // namespace tensorflow
@@ -122,6 +122,14 @@ int32 NumBatchThreadsFromEnvironmentWithDefault(int default_num_batch_threads) {
                                                    : default_num_batch_threads;
 }
 
+// Returns true iff the TF_BATCH_BY_INPUT_SHAPE environment variable is set to
+// a non-zero integer.
+bool BatchByInputShapeFromEnvironment() {
+  int32_t enabled;
+  const char* val = std::getenv("TF_BATCH_BY_INPUT_SHAPE");
+  return val && strings::safe_strto32(val, &enabled) && enabled != 0;
+}
+
 static thread::ThreadPool* GetOrCreateBatchThreadsPool() {
   static thread::ThreadPool* shared_thread_pool = [&]() -> thread::ThreadPool* {
     serving::BoundedExecutor::Options options;
@@ -423,6 +431,8 @@ void BatchFunctionKernel::ComputeAsync(OpKernelContext* c, DoneCallback done) {
       if (session_metadata) {
         new_resource->set_session_metadata(*session_metadata);
       }
+      new_resource->set_batch_by_input_shape(
+          BatchByInputShapeFromEnvironment());
       *r = new_resource.release();
       return absl::OkStatus();
     };
@@ -445,6 +455,8 @@ void BatchFunctionKernel::ComputeAsync(OpKernelContext* c, DoneCallback done) {
       if (session_metadata) {
         new_resource->set_session_metadata(*session_metadata);
       }
+      new_resource->set_batch_by_input_shape(
+          BatchByInputShapeFromEnvironment());
       *r = new_resource.release();
       return absl::OkStatus();
     };
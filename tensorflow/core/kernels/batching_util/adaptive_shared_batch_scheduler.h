@@ -26,6 +26,7 @@ limitations under the License.
 
 #include "absl/types/optional.h"
 #include "tensorflow/core/kernels/batching_util/batch_scheduler.h"
+#include "tensorflow/core/kernels/batching_util/batch_scheduler_utils.h"
 #include "tensorflow/core/kernels/batching_util/periodic_function.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/status.h"
@@ -172,6 +173,14 @@ class AdaptiveSharedBatchScheduler
 
     // If true, the padding will not be appended.
     bool disable_padding = false;
+
+    // If positive, the size and timeout of the batches are picked dynamically
+    // (see BatchTimeoutController) from the arrival rate of the tasks and the
+    // processing latency of the batches of the queue, so as to maximize
+    // throughput while keeping the latency of the tasks under this target (in
+    // microseconds). `max_batch_size` then bounds the batch size, and
+    // `batch_timeout_micros` is ignored.
+    int64_t latency_slo_micros = 0;
   };
 
   using BatchProcessor = std::function<void(std::unique_ptr<Batch<TaskType>>)>;
@@ -323,6 +332,12 @@ class ASBSQueue : public BatchScheduler<TaskType> {
 
   size_t max_task_size() const override { return options_.max_batch_size; }
 
+  // The controller of the batch size and timeout, if
+  // `options.latency_slo_micros` is positive.
+  const std::shared_ptr<BatchTimeoutController>& timeout_controller() const {
+    return timeout_controller_;
+  }
+
  private:
   // Number of size 1 tasks which could currently be scheduled without failing.
   size_t SchedulingCapacityLocked() const TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
@@ -333,8 +348,11 @@ class ASBSQueue : public BatchScheduler<TaskType> {
 
   std::shared_ptr<AdaptiveSharedBatchScheduler<TaskType>> scheduler_;
   const QueueOptions options_;
+  const std::shared_ptr<BatchTimeoutController> timeout_controller_;
   // Owned by scheduler_.
   ASBSBatch<TaskType>* current_batch_ TF_GUARDED_BY(mu_) = nullptr;
+  // The size at which `current_batch_` is closed.
+  int current_batch_target_size_ TF_GUARDED_BY(mu_) = 0;
   int64_t num_enqueued_batches_ TF_GUARDED_BY(mu_) = 0;
   int64_t num_enqueued_tasks_ TF_GUARDED_BY(mu_) = 0;
   mutable mutex mu_;
@@ -468,9 +486,29 @@ absl::Status AdaptiveSharedBatchScheduler<TaskType>::AddQueue(
           options.max_batch_size);
     }
   }
+  if (options.latency_slo_micros < 0) {
+    return errors::InvalidArgument(
+        "latency_slo_micros can't be negative; was ",
+        options.latency_slo_micros);
+  }
   internal::ASBSQueue<TaskType>* asbs_queue_raw;
   queue->reset(asbs_queue_raw = new internal::ASBSQueue<TaskType>(
                    this->shared_from_this(), options));
+  if (std::shared_ptr<BatchTimeoutController> timeout_controller =
+          asbs_queue_raw->timeout_controller()) {
+    // Measure the processing latency of the batches of the queue. The
+    // controller is shared, as the queue may be destroyed before its last
+    // batch is processed.
+    process_batch_callback =
+        [process_batch_callback, timeout_controller,
+         env = GetEnv()](std::unique_ptr<Batch<TaskType>> batch) {
+          const int batch_size = batch->size();
+          const int64_t start_time_micros = env->NowMicros();
+          process_batch_callback(std::move(batch));
+          timeout_controller->RecordBatchLatency(
+              batch_size, env->NowMicros() - start_time_micros);
+        };
+  }
   mutex_lock l(mu_);
   queues_and_callbacks_[asbs_queue_raw] = process_batch_callback;
   return absl::OkStatus();
@@ -711,7 +749,15 @@ template <typename TaskType>
 ASBSQueue<TaskType>::ASBSQueue(
     std::shared_ptr<AdaptiveSharedBatchScheduler<TaskType>> scheduler,
     const QueueOptions& options)
-    : scheduler_(scheduler), options_(options) {}
+    : scheduler_(scheduler),
+      options_(options),
+      timeout_controller_(
+          options.latency_slo_micros > 0
+              ? std::make_shared<BatchTimeoutController>(
+                    BatchTimeoutController::Options{
+                        .latency_slo_micros = options.latency_slo_micros,
+                        .max_batch_size = options.max_batch_size})
+              : nullptr) {}
 
 template <typename TaskType>
 ASBSQueue<TaskType>::~ASBSQueue() {
@@ -753,6 +799,10 @@ absl::Status ASBSQueue<TaskType>::Schedule(std::unique_ptr<TaskType>* task) {
     if (size > SchedulingCapacityLocked()) {
       return errors::Unavailable("The batch scheduling queue is full");
     }
+    if (timeout_controller_ != nullptr) {
+      timeout_controller_->RecordArrival(scheduler_->GetEnv()->NowMicros(),
+                                         size);
+    }
 
     int remaining_batch_size =
         current_batch_ == nullptr
@@ -785,9 +835,17 @@ absl::Status ASBSQueue<TaskType>::Schedule(std::unique_ptr<TaskType>* task) {
         // TraceMeConsumer.
         // When multiple calls to "ASBS::Schedule" accumulate to one batch, they
         // are processed in the same batch and should share traceme_context_id.
+        int64_t batch_timeout_micros = options_.batch_timeout_micros;
+        current_batch_target_size_ = options_.max_batch_size;
+        if (timeout_controller_ != nullptr) {
+          const BatchTimeoutController::Decision decision =
+              timeout_controller_->Decide();
+          batch_timeout_micros = decision.batch_timeout_micros;
+          current_batch_target_size_ = decision.batch_size;
+        }
         current_batch_ = new ASBSBatch<TaskType>(
-            this, scheduler_->GetEnv()->NowMicros(),
-            options_.batch_timeout_micros, NewTraceMeContextIdForBatch());
+            this, scheduler_->GetEnv()->NowMicros(), batch_timeout_micros,
+            NewTraceMeContextIdForBatch());
         new_batches.push_back(current_batch_);
       }
 
@@ -807,7 +865,7 @@ absl::Status ASBSQueue<TaskType>::Schedule(std::unique_ptr<TaskType>* task) {
       bool reached_max_tasks =
           (options_.max_tasks_per_batch.has_value() &&
            current_batch_->num_tasks() >= options_.max_tasks_per_batch.value());
-      if (current_batch_->size() == options_.max_batch_size ||
+      if (current_batch_->size() >= current_batch_target_size_ ||
           reached_max_tasks) {
         current_batch_->Close();
         closed_batch = true;
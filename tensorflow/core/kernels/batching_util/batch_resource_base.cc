@@ -123,6 +123,40 @@ void RecordPaddingSizeV2(int32_t padding_size, const string& model_name,
       ->Add(static_cast<double>(padding_size));
 }
 
+// Returns the bucket limits of a histogram of fractions, in steps of 5%.
+std::vector<double> FractionBucketLimits() {
+  std::vector<double> bucket_limits;
+  for (int i = 1; i <= 20; ++i) {
+    bucket_limits.push_back(i * 0.05);
+  }
+  return bucket_limits;
+}
+
+// Records the fraction of a processed batch made of padding.
+void RecordPaddingFraction(double padding_fraction, const string& model_name,
+                           const string& op_name) {
+  static auto* cell = monitoring::Sampler<2>::New(
+      {"/tensorflow/serving/batching/padding_fraction",
+       "Tracks the fraction of the processed batches made of padding by "
+       "model_name (if available).",
+       "model_name", "op_name"},
+      monitoring::Buckets::Explicit(FractionBucketLimits()));
+  cell->GetCell(model_name, op_name)->Add(padding_fraction);
+}
+
+// Records the size of a batch before padding, as a fraction of the maximum
+// batch size.
+void RecordBatchFillRatio(double batch_fill_ratio, const string& model_name,
+                          const string& op_name) {
+  static auto* cell = monitoring::Sampler<2>::New(
+      {"/tensorflow/serving/batching/batch_fill_ratio",
+       "Tracks the size of the batches before padding, as a fraction of the "
+       "maximum batch size, by model_name (if available).",
+       "model_name", "op_name"},
+      monitoring::Buckets::Explicit(FractionBucketLimits()));
+  cell->GetCell(model_name, op_name)->Add(batch_fill_ratio);
+}
+
 // TODO(b/181883417): Replace with RecordInputBatchSizeV2.
 void RecordInputBatchSize(int32_t batch_size, const string& model_name,
                           const string& op_name) {
@@ -484,9 +518,13 @@ absl::Status BatchResourceBase::RegisterInput(
     batch_components->request_cost = request_cost_accessor->GetRequestCost();
   }
 
+  const std::string queue_name =
+      batch_by_input_shape_
+          ? InputShapeQueueName(batcher_queue_name, batch_components->inputs)
+          : batcher_queue_name;
   BatcherQueueT* batcher_queue;
   TF_RETURN_IF_ERROR(LookupOrCreateBatcherQueue(
-      /* queue_name= */ batcher_queue_name,
+      /* queue_name= */ queue_name,
       /* model_name= */ GetModelName(context),
       /* op_name= */ context->op_kernel().name(), /* queue= */ &batcher_queue));
 
@@ -707,6 +745,20 @@ absl::Status BatchResourceBase::ConcatInputTensors(
                              context->op_kernel().name());
   RecordBatchSize(batch.size(), GetModelName(context),
                   context->op_kernel().name());
+  if (!just_for_warmup) {
+    RecordPaddingFraction(static_cast<double>(padding_amount) /
+                              padded_batch_size,
+                          GetModelName(context), context->op_kernel().name());
+    const int max_batch_size =
+        batcher_ ? batcher_queue_options_.max_execution_batch_size
+                 : adaptive_batcher_queue_options_.max_batch_size;
+    if (max_batch_size > 0) {
+      RecordBatchFillRatio(
+          static_cast<double>(batch.size() + unbatched_tasks_size) /
+              max_batch_size,
+          GetModelName(context), context->op_kernel().name());
+    }
+  }
 
   // All tasks should have the same number of input edges.
   const int num_inputs = batch.task(0).inputs.size();
@@ -858,6 +910,38 @@ absl::Status BatchResourceBase::ConcatInputTensors(
   return absl::OkStatus();
 }
 
+absl::Status BatchResourceBase::SplitOutputTensor(
+    const Tensor& output, absl::Span<const int64_t> sizes, bool has_padding,
+    std::vector<Tensor>* split) {
+  // Alias the slices of the batched output rather than copying them. This
+  // saves a copy of the outputs of most batches, and two for the splits of
+  // large tasks, which are concatenated once all of them complete. But each
+  // slice keeps the whole batched output alive, so only alias them when that
+  // doesn't hold on to much more memory than the slices themselves: when the
+  // batch isn't padded and no task is much smaller than the batch. The
+  // consumers of the outputs may also require aligned tensors, so copy the
+  // slices if any of them isn't.
+  bool alias_slices = !has_padding;
+  for (const int64_t size : sizes) {
+    if (size * kMaxBatchToAliasedSliceRatio < output.dim_size(0)) {
+      alias_slices = false;
+    }
+  }
+  if (alias_slices) {
+    split->clear();
+    split->reserve(sizes.size());
+    int64_t slice_start = 0;
+    for (const int64_t size : sizes) {
+      split->push_back(output.Slice(slice_start, slice_start + size));
+      alias_slices &= split->back().IsAligned();
+      slice_start += size;
+    }
+    if (alias_slices) return absl::OkStatus();
+  }
+  split->clear();
+  return tensor::Split(output, sizes, split);
+}
+
 absl::Status BatchResourceBase::SplitOutputTensors(
     const std::vector<Tensor>& combined_outputs, BatchT* batch,
     std::vector<std::unique_ptr<BatchTask>>& unbatched_tasks) const {
@@ -915,8 +999,9 @@ absl::Status BatchResourceBase::SplitOutputTensors(
     }
 
     std::vector<Tensor> split_tensor;
-    const absl::Status split_status = tensor::Split(
-        output_tensor, task_sizes_plus_optional_padding, &split_tensor);
+    const absl::Status split_status =
+        SplitOutputTensor(output_tensor, task_sizes_plus_optional_padding,
+                          /*has_padding=*/padding_size > 0, &split_tensor);
     DCHECK(split_status.ok()) << split_status;
     if (!split_status.ok()) {
       return errors::Internal("Tensor split operation failed: ",
@@ -1041,6 +1126,12 @@ void BatchResourceBase::ProcessFuncBatch(
   args.insert(args.end(), captured_inputs.begin(), captured_inputs.end());
 
   uint64 current_time = EnvTime::NowNanos();
+  CostTracker& queuing_delay =
+      GlobalBatchStatsRegistry()
+          .model(/* model_name= */ model_name,
+                 /* op_name= */ last_task_context->op_kernel().name())
+          .batch_size(processed_size)
+          .queuing_delay();
   for (int i = 0; i < batch->num_tasks(); ++i) {
     RecordBatchDelayUs((current_time - batch->task(i).start_time) * 1e-3,
                        model_name, last_task_context->op_kernel().name(),
@@ -1048,6 +1139,10 @@ void BatchResourceBase::ProcessFuncBatch(
     RecordBatchDelayUsV2((current_time - batch->task(i).start_time) * 1e-3,
                          model_name, last_task_context->op_kernel().name(),
                          processed_size);
+    if (current_time > batch->task(i).start_time) {
+      queuing_delay.Register(
+          absl::Nanoseconds(current_time - batch->task(i).start_time));
+    }
   }
   // Releases the cleanup method here, because the callback of the function
   // library runtime will handle it now.
@@ -1234,6 +1329,33 @@ absl::Status BatchResourceBase::LookupOrCreateBatcherQueue(
   return absl::OkStatus();
 }
 
+string BatchResourceBase::InputShapeQueueName(
+    const string& batcher_queue_name, const std::vector<Tensor>& inputs) {
+  // Inputs can only be concatenated with inputs of the same shape, except for
+  // the batch dimension: key the sub-queue on the remaining dimensions.
+  std::string queue_name = batcher_queue_name;
+  for (const Tensor& tensor : inputs) {
+    TensorShape shape = tensor.shape();
+    shape.RemoveDim(0);
+    absl::StrAppend(&queue_name, "/", shape.DebugString());
+  }
+
+  mutex_lock l(batcher_queues_mu_);
+  if (input_shape_queue_names_.count(queue_name) > 0) {
+    return queue_name;
+  }
+  if (input_shape_queue_names_.size() >= kMaxInputShapeQueues) {
+    LOG_EVERY_N_SEC(WARNING, 60)
+        << "Reached the maximum of " << kMaxInputShapeQueues
+        << " input shape queues for batcher queue " << batcher_queue_name
+        << ", batching inputs of shape " << queue_name
+        << " with inputs of any shape.";
+    return batcher_queue_name;
+  }
+  input_shape_queue_names_.insert(queue_name);
+  return queue_name;
+}
+
 void BatchResourceBase::SplitBatchCostsAndRecordMetrics(
     const std::string& model_name, const std::string& op_name,
     const std::vector<std::unique_ptr<CostMeasurement>>&
@@ -20,6 +20,7 @@ limitations under the License.
 #include <functional>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -27,6 +28,7 @@ limitations under the License.
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/blocking_counter.h"
+#include "absl/types/span.h"
 #include "tensorflow/core/common_runtime/cost_measurement_registry.h"
 #include "tensorflow/core/common_runtime/request_cost.h"
 #include "tensorflow/core/framework/op_kernel.h"
@@ -186,6 +188,20 @@ class BatchResourceBase : public ResourceBase {
 
   const SessionMetadata& session_metadata() const { return session_metadata_; }
 
+  // If true, inputs are batched only with inputs of the same shape except for
+  // the 0th (batch) dimension: each distinct shape gets its own sub-queue of
+  // the batcher queue passed to `RegisterInput`. This lets variable-length
+  // inputs (e.g. padded up to a few sequence length buckets by the caller) be
+  // batched without being padded to a single length. Defaults to false.
+  //
+  // At most kMaxInputShapeQueues sub-queues are created. Inputs of any other
+  // shape go to the batcher queue itself, as if this was false.
+  //
+  // Must be called before any input is registered.
+  void set_batch_by_input_shape(bool batch_by_input_shape) {
+    batch_by_input_shape_ = batch_by_input_shape;
+  }
+
   using CreateBatchTaskFn =
       std::function<StatusOr<std::unique_ptr<BatchTask>>()>;
 
@@ -274,6 +290,23 @@ class BatchResourceBase : public ResourceBase {
           batch_cost_measurements,
       int64_t processed_size, BatchT& batch);
 
+  // Splits the batched `output` along its first dimension into tensors of
+  // `sizes`, the sizes of the tasks of the batch followed by the padding if
+  // `has_padding`. The tensors alias `output` if none of the tasks is more than
+  // kMaxBatchToAliasedSliceRatio times smaller than the batch, the batch isn't
+  // padded and the slices are aligned. Otherwise they are copied, so that the
+  // outputs of small tasks don't keep the whole batched output alive.
+  static absl::Status SplitOutputTensor(const Tensor& output,
+                                        absl::Span<const int64_t> sizes,
+                                        bool has_padding,
+                                        std::vector<Tensor>* split);
+
+  static constexpr int64_t kMaxBatchToAliasedSliceRatio = 4;
+
+  // The maximum number of sub-queues created by `set_batch_by_input_shape`.
+  // Queues are never removed and each one may run its own batch threads.
+  static constexpr int kMaxInputShapeQueues = 16;
+
  private:
   // Implementation of calling the process batch function.
   virtual void ProcessFuncBatchImpl(
@@ -346,8 +379,17 @@ class BatchResourceBase : public ResourceBase {
                                     const string& op_name,
                                     BatcherQueueT** queue);
 
+  // Returns the name of the sub-queue of 'batcher_queue_name' for 'inputs'
+  // (see `set_batch_by_input_shape`), or 'batcher_queue_name' itself once
+  // kMaxInputShapeQueues sub-queues have been named.
+  string InputShapeQueueName(const string& batcher_queue_name,
+                             const std::vector<Tensor>& inputs);
+
   SessionMetadata session_metadata_;
 
+  // See `set_batch_by_input_shape`.
+  bool batch_by_input_shape_ = false;
+
   absl::Mutex outstanding_batch_mu_;
   int num_outstanding_batched_items_ TF_GUARDED_BY(outstanding_batch_mu_) = 0;
 
@@ -367,6 +409,8 @@ class BatchResourceBase : public ResourceBase {
   mutable mutex batcher_queues_mu_;
   std::map<string, std::unique_ptr<BatcherQueueT>> batcher_queues_
       TF_GUARDED_BY(batcher_queues_mu_);
+  // The names returned by `InputShapeQueueName`, at most kMaxInputShapeQueues.
+  std::set<string> input_shape_queue_names_ TF_GUARDED_BY(batcher_queues_mu_);
 
   std::vector<int32> allowed_batch_sizes_;
   // A concatenated string of <allowed_batch_sizes_>, separated by ",". This is
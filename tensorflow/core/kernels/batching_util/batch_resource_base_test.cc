@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/kernels/batching_util/batch_resource_base.h"
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -25,6 +26,7 @@ limitations under the License.
 #include <gtest/gtest.h>
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "tensorflow/core/common_runtime/cost_constants.h"
@@ -43,6 +45,7 @@ limitations under the License.
 #include "tensorflow/core/kernels/batching_util/batch_scheduler_utils.h"
 #include "tensorflow/core/kernels/batching_util/batch_stats.h"
 #include "tensorflow/core/kernels/batching_util/shared_batch_scheduler.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
 #include "tensorflow/core/lib/monitoring/cell_reader.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/notification.h"
@@ -418,6 +421,59 @@ TEST(SplitBatchCostsAndRecordMetricsTest, GlobalBatchStatsProcessedSize) {
             original_cumulative_processed_size + 4);
 }
 
+// Returns a batched output of `batch_size` rows of 2 elements, holding the
+// numbers from 0.
+Tensor MakeBatchedOutput(int64_t batch_size) {
+  Tensor output(DataType::DT_INT64, TensorShape({batch_size, 2}));
+  auto flat = output.flat<int64_t>();
+  for (int64_t i = 0; i < flat.size(); ++i) flat(i) = i;
+  return output;
+}
+
+// Expects `split` to hold the consecutive rows of the output of
+// MakeBatchedOutput() of `sizes`.
+void ExpectSplitOfBatchedOutput(const std::vector<Tensor>& split,
+                                const std::vector<int64_t>& sizes) {
+  ASSERT_EQ(split.size(), sizes.size());
+  int64_t value = 0;
+  for (int i = 0; i < split.size(); ++i) {
+    ASSERT_EQ(split[i].shape(), TensorShape({sizes[i], 2}));
+    auto flat = split[i].flat<int64_t>();
+    for (int64_t j = 0; j < flat.size(); ++j) EXPECT_EQ(flat(j), value++);
+  }
+}
+
+TEST(SplitOutputTensorTest, AliasesSlicesOfSimilarSizes) {
+  const Tensor output = MakeBatchedOutput(8);
+  std::vector<Tensor> split;
+  TF_ASSERT_OK(BatchResourceBase::SplitOutputTensor(
+      output, {4, 4}, /*has_padding=*/false, &split));
+  ExpectSplitOfBatchedOutput(split, {4, 4});
+  EXPECT_TRUE(split[0].SharesBufferWith(output));
+  EXPECT_TRUE(split[1].SharesBufferWith(output));
+}
+
+TEST(SplitOutputTensorTest, CopiesSlicesOfPaddedBatch) {
+  const Tensor output = MakeBatchedOutput(8);
+  std::vector<Tensor> split;
+  TF_ASSERT_OK(BatchResourceBase::SplitOutputTensor(
+      output, {4, 3, 1}, /*has_padding=*/true, &split));
+  ExpectSplitOfBatchedOutput(split, {4, 3, 1});
+  for (const Tensor& tensor : split) {
+    EXPECT_FALSE(tensor.SharesBufferWith(output));
+  }
+}
+
+TEST(SplitOutputTensorTest, CopiesSlicesOfSmallTasks) {
+  const Tensor output = MakeBatchedOutput(8);
+  std::vector<Tensor> split;
+  TF_ASSERT_OK(BatchResourceBase::SplitOutputTensor(
+      output, {1, 7}, /*has_padding=*/false, &split));
+  ExpectSplitOfBatchedOutput(split, {1, 7});
+  EXPECT_FALSE(split[0].SharesBufferWith(output));
+  EXPECT_FALSE(split[1].SharesBufferWith(output));
+}
+
 class BatchResourceBaseTest : public ::testing::Test {
  protected:
   // Like BatchResourceBase but overrides abstract methods, one of which
@@ -622,6 +678,113 @@ TEST_F(BatchResourceBaseTest, ConfiguredBatchPaddingPolicyMetric) {
   my_batch_resource->Unref();
 }
 
+TEST_F(BatchResourceBaseTest, BatchesByInputShape) {
+  using BatchTask = BatchResourceBase::BatchTask;
+  using SharedBatchScheduler = SharedBatchScheduler<BatchTask>;
+
+  // Like SharedBatchScheduler but counts the queues added.
+  class MySharedBatchScheduler : public SharedBatchScheduler {
+   public:
+    MySharedBatchScheduler() : SharedBatchScheduler::SharedBatchScheduler({}) {}
+
+    absl::Status AddQueue(
+        const QueueOptions& options,
+        ProcessBatchCallback process_batch_callback,
+        std::unique_ptr<BatchScheduler<BatchTask>>* queue) override {
+      ++num_queues_;
+      return SharedBatchScheduler::AddQueue(options, process_batch_callback,
+                                            queue);
+    }
+
+    int num_queues() const { return num_queues_; }
+
+   private:
+    std::atomic<int> num_queues_ = 0;
+  };
+
+  // Like MyBatchResource, but counts the rows of the processed batches.
+  class CountingBatchResource : public BatchResourceBase {
+   public:
+    using BatchResourceBase::BatchResourceBase;
+
+    std::string DebugString() const override { return ""; }
+
+    void ProcessFuncBatchImpl(
+        const BatchResourceBase::BatchTask& /* last_task */,
+        absl::Span<const Tensor> inputs,
+        std::vector<Tensor>* /* combined_outputs */,
+        std::function<void(const absl::Status&)> /* done */) const override {
+      absl::MutexLock lock(&mu_);
+      num_processed_rows_ += inputs[0].dim_size(0);
+    }
+
+    bool WaitForProcessedRows(int64_t num_rows) {
+      absl::MutexLock lock(&mu_);
+      auto processed = [this, num_rows]() {
+        mu_.AssertHeld();
+        return num_processed_rows_ >= num_rows;
+      };
+      return mu_.AwaitWithTimeout(absl::Condition(&processed),
+                                  absl::Seconds(1));
+    }
+
+   private:
+    mutable absl::Mutex mu_;
+    mutable int64_t num_processed_rows_ ABSL_GUARDED_BY(mu_) = 0;
+  };
+
+  auto batcher = std::make_shared<MySharedBatchScheduler>();
+
+  CountingBatchResource* batch_resource = new CountingBatchResource(
+      /* has_process_batch_function */ true,
+      /* batcher= */ batcher,
+      /* batcher_queue_options */ {},
+      /* allowed_batch_sizes */ {});
+  batch_resource->set_batch_by_input_shape(true);
+
+  auto register_input = [&](const TensorShape& shape) {
+    Tensor tensor(DataType::DT_INT64, shape);
+    std::vector<TensorValue> inputs = {TensorValue(&tensor),
+                                       TensorValue(&tensor),
+                                       TensorValue(&tensor)};
+    OpKernelContext::Params params = params_;
+    params.inputs = inputs;
+    OpKernelContext context(&params);
+    TF_CHECK_OK(batch_resource->RegisterInput(
+        /* guid= */ 0, /* context= */ &context,
+        /* batcher_queue_name= */ "batcher_queue_name",
+        /* create_batch_task_fn= */
+        []() -> absl::StatusOr<std::unique_ptr<BatchTask>> {
+          return std::make_unique<BatchTask>();
+        },
+        /* done_callback= */ [] {}, /* forced_warmup_batch_size= */ 0));
+  };
+
+  // Inputs whose shapes only differ in the batch dimension share a queue.
+  register_input(TensorShape({5, 2, 1}));
+  register_input(TensorShape({4, 2, 1}));
+  EXPECT_EQ(batcher->num_queues(), 1);
+  register_input(TensorShape({5, 3, 1}));
+  EXPECT_EQ(batcher->num_queues(), 2);
+
+  // Once all the sub-queues are used, inputs of new shapes share the batcher
+  // queue itself.
+  constexpr int kMaxQueues = BatchResourceBase::kMaxInputShapeQueues;
+  for (int i = 2; i < kMaxQueues; ++i) {
+    register_input(TensorShape({1, 4 + i, 1}));
+  }
+  EXPECT_EQ(batcher->num_queues(), kMaxQueues);
+  register_input(TensorShape({2, 1, 1}));
+  register_input(TensorShape({3, 1, 1}));
+  EXPECT_EQ(batcher->num_queues(), kMaxQueues + 1);
+
+  EXPECT_TRUE(batch_resource->WaitForProcessedRows(5 + 4 + 5 +
+                                                   (kMaxQueues - 2) + 2 + 3));
+
+  // This is how we have to destroy the BatchResource.
+  batch_resource->Unref();
+}
+
 }  // namespace
 }  // namespace serving
 }  // namespace tensorflow
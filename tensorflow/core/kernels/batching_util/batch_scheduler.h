@@ -94,6 +94,13 @@ class BatchTask {
   virtual tsl::criticality::Criticality criticality() const {
     return tsl::criticality::Criticality::kCritical;
   }
+
+  // Returns the time, in Env::NowMicros() microseconds, by which the task
+  // should have been processed, if any. Only used by schedulers that enable
+  // deadline scheduling. It defaults to no deadline.
+  virtual std::optional<uint64> deadline_micros() const {
+    return std::nullopt;
+  }
 };
 
 // A thread-safe collection of BatchTasks. Tasks can be either added or removed
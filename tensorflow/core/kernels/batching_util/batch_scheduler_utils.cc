@@ -16,10 +16,13 @@ limitations under the License.
 #include "tensorflow/core/kernels/batching_util/batch_scheduler_utils.h"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <vector>
 
 #include "absl/algorithm/container.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/types.h"
 
 namespace tensorflow {
@@ -67,5 +70,92 @@ int32 GetPrevAllowedBatchSize(int batch_size,
   return *result;
 }
 
+BatchTimeoutController::BatchTimeoutController(const Options& options)
+    : options_(options) {
+  DCHECK_GT(options.latency_slo_micros, 0);
+  DCHECK_GT(options.max_batch_size, 0);
+  DCHECK_GT(options.smoothing_factor, 0);
+  DCHECK_LE(options.smoothing_factor, 1);
+  for (int batch_size = 1; batch_size < options.max_batch_size;
+       batch_size *= 2) {
+    batch_sizes_.push_back(batch_size);
+  }
+  batch_sizes_.push_back(options.max_batch_size);
+}
+
+void BatchTimeoutController::RecordArrival(int64_t now_micros, int size) {
+  if (size <= 0) return;
+  mutex_lock l(mu_);
+  if (last_arrival_micros_.has_value()) {
+    const double micros_per_unit =
+        static_cast<double>(std::max<int64_t>(
+            now_micros - *last_arrival_micros_, 0)) /
+        size;
+    micros_per_unit_ =
+        micros_per_unit_.has_value()
+            ? *micros_per_unit_ + options_.smoothing_factor *
+                                      (micros_per_unit - *micros_per_unit_)
+            : micros_per_unit;
+  }
+  last_arrival_micros_ = now_micros;
+}
+
+void BatchTimeoutController::RecordBatchLatency(int batch_size,
+                                                int64_t latency_micros) {
+  mutex_lock l(mu_);
+  const double decay = 1 - options_.smoothing_factor;
+  const double size = batch_size;
+  const double latency = latency_micros;
+  weight_sum_ = decay * weight_sum_ + 1;
+  size_sum_ = decay * size_sum_ + size;
+  latency_sum_ = decay * latency_sum_ + latency;
+  size_squared_sum_ = decay * size_squared_sum_ + size * size;
+  size_latency_sum_ = decay * size_latency_sum_ + size * latency;
+}
+
+double BatchTimeoutController::EstimatedLatencyMicros(int batch_size) const {
+  const double mean_size = size_sum_ / weight_sum_;
+  const double mean_latency = latency_sum_ / weight_sum_;
+  const double size_variance =
+      size_squared_sum_ / weight_sum_ - mean_size * mean_size;
+  // Until batches of different sizes have been observed, assume that the
+  // latency doesn't depend on the batch size.
+  double slope = 0;
+  if (size_variance > 1e-6) {
+    slope = std::max(
+        0.0, (size_latency_sum_ / weight_sum_ - mean_size * mean_latency) /
+                 size_variance);
+  }
+  return std::max(0.0, mean_latency + slope * (batch_size - mean_size));
+}
+
+BatchTimeoutController::Decision BatchTimeoutController::Decide() const {
+  mutex_lock l(mu_);
+  if (weight_sum_ == 0) {
+    return {options_.max_batch_size, options_.latency_slo_micros};
+  }
+
+  // Larger batches have a higher throughput: pick the largest batch size
+  // expected to be filled and processed within the latency target, or the
+  // smallest batch size if none is.
+  int batch_size = batch_sizes_.front();
+  for (int candidate : batch_sizes_) {
+    const double fill_micros =
+        micros_per_unit_.has_value() ? *micros_per_unit_ * (candidate - 1)
+                                     : 0;
+    if (fill_micros + EstimatedLatencyMicros(candidate) <=
+        options_.latency_slo_micros) {
+      batch_size = candidate;
+    }
+  }
+
+  // Don't let the first task of the batch wait longer than the latency target
+  // allows for if the batch doesn't fill up.
+  const double timeout_micros =
+      options_.latency_slo_micros - EstimatedLatencyMicros(batch_size);
+  return {batch_size,
+          static_cast<int64_t>(std::max(0.0, std::floor(timeout_micros)))};
+}
+
 }  // namespace serving
 }  // namespace tensorflow
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_KERNELS_BATCHING_UTIL_BATCH_SCHEDULER_UTILS_H_
 #define TENSORFLOW_CORE_KERNELS_BATCHING_UTIL_BATCH_SCHEDULER_UTILS_H_
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -25,6 +26,8 @@ limitations under the License.
 #include "tensorflow/core/kernels/batching_util/batch_scheduler.h"
 #include "tensorflow/core/kernels/batching_util/batch_stats.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
 #include "tensorflow/core/platform/types.h"
 
 namespace tensorflow {
@@ -151,6 +154,80 @@ void MaybeBatchDown(Batch<TaskType>& batch,
   batch.TryTrimToNewSize(batch_down_size, out_trimmed_tasks);
 }
 
+// Picks the size and timeout of the batches of a queue so as to maximize
+// throughput while keeping the latency of its tasks under a target.
+//
+// The controller tracks the arrival rate of the tasks, and fits the processing
+// latency of the batches as a linear function of their size. Both estimates
+// are exponentially weighted, so that they follow changes in traffic and
+// hardware within a few dozen batches. It then picks the largest candidate
+// batch size (powers of 2 and `max_batch_size`) that is expected to be filled
+// and processed within the latency target, and a timeout bounding the time the
+// first task of a batch waits for it to fill up.
+//
+// The latency target applies to the estimated mean latencies: leave headroom
+// when mapping a percentile SLO to it.
+//
+// Thread-safe.
+class BatchTimeoutController {
+ public:
+  struct Options {
+    // The latency target (in microseconds) of a task, from its arrival to the
+    // end of the processing of its batch. Must be positive.
+    int64_t latency_slo_micros = 0;
+
+    // The largest batch size to pick. Must be positive.
+    int max_batch_size = 1000;
+
+    // The weight (in (0, 1]) of a new observation in the estimates.
+    double smoothing_factor = 0.1;
+  };
+
+  struct Decision {
+    int batch_size;
+    int64_t batch_timeout_micros;
+  };
+
+  explicit BatchTimeoutController(const Options& options);
+
+  // Records the arrival of a task of `size` at `now_micros`.
+  void RecordArrival(int64_t now_micros, int size);
+
+  // Records that processing a batch of `batch_size` took `latency_micros`.
+  void RecordBatchLatency(int batch_size, int64_t latency_micros);
+
+  // Returns the batch size and timeout to use for the next batch. Until batch
+  // latencies have been recorded, returns `max_batch_size` with a timeout of
+  // the latency target.
+  Decision Decide() const;
+
+ private:
+  // Returns the estimated processing latency of a batch of `batch_size`.
+  double EstimatedLatencyMicros(int batch_size) const
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  const Options options_;
+
+  // The candidate batch sizes, in increasing order.
+  std::vector<int> batch_sizes_;
+
+  mutable mutex mu_;
+
+  // The time of the last arrival, if any.
+  std::optional<int64_t> last_arrival_micros_ TF_GUARDED_BY(mu_);
+  // The estimated time between the arrival of two consecutive units of task
+  // size, if any.
+  std::optional<double> micros_per_unit_ TF_GUARDED_BY(mu_);
+
+  // Exponentially weighted sums for the least squares fit of the latency of a
+  // batch as a linear function of its size.
+  double weight_sum_ TF_GUARDED_BY(mu_) = 0;
+  double size_sum_ TF_GUARDED_BY(mu_) = 0;
+  double latency_sum_ TF_GUARDED_BY(mu_) = 0;
+  double size_squared_sum_ TF_GUARDED_BY(mu_) = 0;
+  double size_latency_sum_ TF_GUARDED_BY(mu_) = 0;
+};
+
 }  // namespace serving
 }  // namespace tensorflow
 
@@ -16,6 +16,7 @@ limitations under the License.
 #include "tensorflow/core/kernels/batching_util/batch_scheduler_utils.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -275,6 +276,74 @@ TEST(MaybeBatchDownTest, MinimizeTpuCostPerRequestDoesPadUpWhenNoModelStats) {
   EXPECT_EQ(batch.size(), 3);
 }
 
+// Records `num_arrivals` arrivals of tasks of size 1, `interval_micros` apart.
+void RecordArrivals(BatchTimeoutController& controller, int num_arrivals,
+                    int64_t interval_micros) {
+  for (int i = 0; i < num_arrivals; ++i) {
+    controller.RecordArrival(/* now_micros= */ i * interval_micros,
+                             /* size= */ 1);
+  }
+}
+
+// Records batch latencies following 500 + 62.5 * batch_size microseconds.
+void RecordLinearLatencies(BatchTimeoutController& controller) {
+  for (int i = 0; i < 10; ++i) {
+    controller.RecordBatchLatency(/* batch_size= */ 8,
+                                  /* latency_micros= */ 1000);
+    controller.RecordBatchLatency(/* batch_size= */ 32,
+                                  /* latency_micros= */ 2500);
+  }
+}
+
+TEST(BatchTimeoutControllerTest, DefaultsToMaxBatchSizeWithoutLatencies) {
+  BatchTimeoutController controller(
+      {.latency_slo_micros = 10000, .max_batch_size = 64});
+  RecordArrivals(controller, /* num_arrivals= */ 10,
+                 /* interval_micros= */ 100);
+
+  BatchTimeoutController::Decision decision = controller.Decide();
+  EXPECT_EQ(decision.batch_size, 64);
+  EXPECT_EQ(decision.batch_timeout_micros, 10000);
+}
+
+TEST(BatchTimeoutControllerTest, PicksLargestBatchSizeMeetingTheTarget) {
+  BatchTimeoutController controller(
+      {.latency_slo_micros = 10000, .max_batch_size = 64});
+  RecordArrivals(controller, /* num_arrivals= */ 10,
+                 /* interval_micros= */ 100);
+  RecordLinearLatencies(controller);
+
+  // A batch of 64 takes 6300us to fill up and 4500us to process, a batch of 32
+  // 3100us and 2500us.
+  BatchTimeoutController::Decision decision = controller.Decide();
+  EXPECT_EQ(decision.batch_size, 32);
+  EXPECT_NEAR(decision.batch_timeout_micros, 10000 - 2500, 1);
+}
+
+TEST(BatchTimeoutControllerTest, PicksLargerBatchesUnderHigherLoad) {
+  BatchTimeoutController controller(
+      {.latency_slo_micros = 10000, .max_batch_size = 64});
+  RecordArrivals(controller, /* num_arrivals= */ 10,
+                 /* interval_micros= */ 10);
+  RecordLinearLatencies(controller);
+
+  BatchTimeoutController::Decision decision = controller.Decide();
+  EXPECT_EQ(decision.batch_size, 64);
+  EXPECT_NEAR(decision.batch_timeout_micros, 10000 - 4500, 1);
+}
+
+TEST(BatchTimeoutControllerTest, PicksSmallestBatchSizeWhenTargetIsMissed) {
+  BatchTimeoutController controller(
+      {.latency_slo_micros = 500, .max_batch_size = 64});
+  RecordArrivals(controller, /* num_arrivals= */ 10,
+                 /* interval_micros= */ 100);
+  RecordLinearLatencies(controller);
+
+  BatchTimeoutController::Decision decision = controller.Decide();
+  EXPECT_EQ(decision.batch_size, 1);
+  EXPECT_EQ(decision.batch_timeout_micros, 0);
+}
+
 }  // namespace
 
 }  // namespace serving
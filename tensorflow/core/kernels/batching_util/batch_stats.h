@@ -122,8 +122,14 @@ class BatchSizeStats {
  public:
   CostTracker& tpu_cost() { return tpu_cost_; };
 
+  // The time the tasks of the batches of this size spent queued, from their
+  // arrival to the start of the processing of their batch. Comparing it with
+  // `tpu_cost` tells queueing from compute bottlenecks apart.
+  CostTracker& queuing_delay() { return queuing_delay_; };
+
  private:
   CostTracker tpu_cost_;
+  CostTracker queuing_delay_;
 };
 
 // Tracks statistics for a particular model.
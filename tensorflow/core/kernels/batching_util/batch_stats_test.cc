@@ -55,6 +55,16 @@ TEST(BatchStatsTest, BatchSizeStatsAreUniqueForEachBatchSize) {
   ASSERT_NE(&stats.batch_size(1), &stats.batch_size(2));
 }
 
+TEST(BatchStatsTest, QueuingDelayIsTrackedSeparatelyFromCost) {
+  BatchSizeStats stats;
+  stats.tpu_cost().Register(absl::Milliseconds(5));
+  stats.queuing_delay().Register(absl::Milliseconds(2));
+  stats.queuing_delay().Register(absl::Milliseconds(4));
+
+  ASSERT_EQ(stats.tpu_cost().mean(), absl::Milliseconds(5));
+  ASSERT_EQ(stats.queuing_delay().mean(), absl::Milliseconds(3));
+}
+
 TEST(BatchStatsTest, CostTrackerStartsWithNoMean) {
   CostTracker tracker;
 
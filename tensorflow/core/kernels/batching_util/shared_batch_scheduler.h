@@ -26,6 +26,7 @@ limitations under the License.
 #include <functional>
 #include <list>
 #include <memory>
+#include <optional>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -111,9 +112,12 @@ namespace serving {
 // For bulk processing jobs and throughput-oriented benchmarks, you may want to
 // set the maximum queue size to a large value.
 //
-// TODO(b/26539183): Support queue servicing policies other than round-robin.
-// E.g. let each queue specify a "share" (an int >= 1), so e.g. with queues A
-// and B having shares 1 and 2 respectively, the servicing pattern is ABBABB...
+// Queues may specify a share (QueueOptions::scheduling_share) to get a larger
+// fraction of the batch threads: e.g. with queues A and B having shares 1 and 2
+// respectively, and both having batches ready, the servicing pattern is
+// ABBABB... A queue with share s is guaranteed at least s / (sum of the shares
+// of the queues having batches ready) of the batches. If all queues have the
+// default share of 1, this is the round-robin order described above.
 //
 //
 // PERFORMANCE TUNING: See README.md.
@@ -268,6 +272,31 @@ class SharedBatchScheduler
     // effective only when enable_priority_queue is true.
     MixedPriorityBatchingPolicy mixed_priority_batching_policy =
         MixedPriorityBatchingPolicy::kLowPriorityPaddingWithMaxBatchSize;
+
+    // If true, the deadlines of the tasks (see BatchTask::deadline_micros())
+    // are taken into account: Schedule() rejects a task with a
+    // DEADLINE_EXCEEDED error if it can't be processed in time, and the open
+    // batch is closed before `batch_timeout_micros` if waiting any longer
+    // would make one of its tasks miss its deadline.
+    //
+    // Tasks that aren't derived from BatchTask have no deadline.
+    bool enable_deadline_scheduling = false;
+
+    // The expected time (in microseconds) it takes to process a batch once
+    // scheduled. Used iff `enable_deadline_scheduling` is true: a task is
+    // expected to be processed in time iff it is scheduled at least this
+    // long before its deadline.
+    //
+    // Must be non-negative.
+    int64_t expected_batch_processing_micros = 0;
+
+    // The share of the batch threads of this queue, relative to the other
+    // queues of the scheduler (see the class documentation above). Among the
+    // queues having batches ready, the scheduler serves the queue that has
+    // processed the fewest batches per unit of share.
+    //
+    // Must be positive.
+    int scheduling_share = 1;
   };
   // This method is marked virtual for testing purposes only.
   virtual absl::Status AddQueue(
@@ -313,6 +342,25 @@ class SharedBatchScheduler
   // available batch thread should grab work.
   typename QueueList::iterator next_queue_to_schedule_ TF_GUARDED_BY(mu_);
 
+  // The virtual time of the last batch obtained from the queues: the number of
+  // batches per unit of share processed by its queue when it was scheduled.
+  // Queues that become ready start from it, rather than from their own virtual
+  // time, so that they can't monopolize the threads after being idle.
+  double system_virtual_time_ TF_GUARDED_BY(mu_) = 0;
+
+  // Like GetNextWorkItem_Locked(), but tries the queues in increasing order of
+  // virtual time, to honor their scheduling shares. Used iff some queue has a
+  // share other than 1.
+  void GetNextSharedWorkItem_Locked(
+      internal::Queue<TaskType>** queue_for_batch_out,
+      BatchTaskUniquePtr* batch_to_process_out)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Removes the queue `it` points to from 'queues_', keeping
+  // 'next_queue_to_schedule_' valid.
+  void EraseQueue_Locked(typename QueueList::iterator it)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   // Used by idle batch threads to wait for work to enter the system. Notified
   // whenever a batch becomes schedulable.
   condition_variable schedulable_batch_cv_;
@@ -415,6 +463,13 @@ class Queue {
 
   bool closed() const TF_NO_THREAD_SAFETY_ANALYSIS { return closed_.load(); }
 
+  int scheduling_share() const { return options_.scheduling_share; }
+
+  // The number of batches per unit of share processed by this queue, as
+  // accounted by the scheduler. Only accessed under the scheduler's mutex.
+  double virtual_time() const { return virtual_time_; }
+  void set_virtual_time(double virtual_time) { virtual_time_ = virtual_time; }
+
  private:
   // Computes the max_execution_batch_size of the queue based on queue options.
   static size_t GetMaxExecutionBatchSize(
@@ -438,6 +493,19 @@ class Queue {
   // Returns true iff the task is a low priority task based on the queue option.
   bool IsLowPriorityTask(std::unique_ptr<TaskType>* task);
 
+  // Returns the deadline of `task`, if deadline scheduling is enabled and the
+  // task has one.
+  std::optional<uint64> TaskDeadline(const TaskType& task) const;
+
+  // Returns true iff a batch scheduled now is expected to be processed after
+  // `deadline_micros`.
+  bool IsPastDeadline(uint64 deadline_micros) const;
+
+  // Accounts for the deadline of a task being added to the open batch in
+  // `open_batch_deadline_micros_`.
+  void UpdateOpenBatchDeadline(std::optional<uint64> deadline_micros)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   // Implementation of Schedule above. Enqueues `task` as it
   // is or split it inline (eagerly) to form batches to be processed by
   // `Queue<TaskType>::ProcessBatch`
@@ -534,6 +602,9 @@ class Queue {
   // for the duration of this object's life.
   std::atomic<bool> closed_ TF_GUARDED_BY(mu_){false};
 
+  // See virtual_time().
+  double virtual_time_ = 0;
+
   // The enqueued tasks for low priority inputs.
   // Each element corresponds to a task to be dequeued. These tasks to be
   // consumed by `Queue<TaskType>::ProcessBatch` to either pad the high priority
@@ -557,6 +628,11 @@ class Queue {
   // might contain an approximate value.
   uint64 open_batch_start_time_micros_ TF_GUARDED_BY(mu_);
 
+  // The earliest deadline of the tasks in the open (back-most) batch in
+  // 'high_priority_batches_', if any of them has one. Only tracked when
+  // deadline scheduling is enabled.
+  std::optional<uint64> open_batch_deadline_micros_ TF_GUARDED_BY(mu_);
+
   // Whether this queue contains a batch that is eligible to be scheduled.
   // Used to keep track of when to call 'schedulable_batch_callback_'.
   bool schedulable_batch_ TF_GUARDED_BY(mu_) = false;
@@ -674,6 +750,15 @@ absl::Status SharedBatchScheduler<TaskType>::AddQueueAfterRewritingOptions(
         "max_enqueued_batches must be positive; was ",
         options.max_enqueued_batches);
   }
+  if (options.scheduling_share < 1) {
+    return errors::InvalidArgument("scheduling_share must be positive; was ",
+                                   options.scheduling_share);
+  }
+  if (options.expected_batch_processing_micros < 0) {
+    return errors::InvalidArgument(
+        "expected_batch_processing_micros must be non-negative; was ",
+        options.expected_batch_processing_micros);
+  }
 
   if (options.enable_large_batch_splitting &&
       options.split_input_task_func == nullptr) {
@@ -740,6 +825,13 @@ template <typename TaskType>
 void SharedBatchScheduler<TaskType>::GetNextWorkItem_Locked(
     internal::Queue<TaskType>** queue_for_batch_out,
     BatchTaskUniquePtr* batch_to_process_out) {
+  for (const auto& queue : queues_) {
+    if (queue->scheduling_share() != 1) {
+      GetNextSharedWorkItem_Locked(queue_for_batch_out, batch_to_process_out);
+      return;
+    }
+  }
+
   BatchTaskUniquePtr batch_to_process;
   internal::Queue<TaskType>* queue_for_batch = nullptr;
   const int num_queues = queues_.size();
@@ -766,19 +858,69 @@ void SharedBatchScheduler<TaskType>::GetNextWorkItem_Locked(
         !BatchExists(batch_to_process)) {
       // We've encountered a closed queue with no work to do. Drop it.
       DCHECK_NE(queue_for_batch, next_queue_to_schedule_->get());
-      next_queue_to_schedule_ = queues_.erase(next_queue_to_schedule_);
+      EraseQueue_Locked(next_queue_to_schedule_);
     } else {
       ++next_queue_to_schedule_;
-    }
-    if (next_queue_to_schedule_ == queues_.end() && !queues_.empty()) {
-      // We've hit the end. Wrap to the first queue.
-      next_queue_to_schedule_ = queues_.begin();
+      if (next_queue_to_schedule_ == queues_.end()) {
+        // We've hit the end. Wrap to the first queue.
+        next_queue_to_schedule_ = queues_.begin();
+      }
     }
   }
   *queue_for_batch_out = queue_for_batch;
   *batch_to_process_out = std::move(batch_to_process);
 }
 
+template <typename TaskType>
+void SharedBatchScheduler<TaskType>::GetNextSharedWorkItem_Locked(
+    internal::Queue<TaskType>** queue_for_batch_out,
+    BatchTaskUniquePtr* batch_to_process_out) {
+  std::vector<typename QueueList::iterator> queues_to_try;
+  queues_to_try.reserve(queues_.size());
+  for (auto it = queues_.begin(); it != queues_.end(); ++it) {
+    queues_to_try.push_back(it);
+  }
+  // Ties are broken in the order the queues were added.
+  std::stable_sort(queues_to_try.begin(), queues_to_try.end(),
+                   [](const auto& a, const auto& b) {
+                     return (*a)->virtual_time() < (*b)->virtual_time();
+                   });
+
+  *queue_for_batch_out = nullptr;
+  for (const auto& it : queues_to_try) {
+    // See GetNextWorkItem_Locked() for why closedness is checked first.
+    const bool queue_closed = (*it)->closed();
+    BatchTaskUniquePtr batch_to_process = (*it)->ScheduleBatch();
+    if (BatchExists(batch_to_process)) {
+      internal::Queue<TaskType>* queue = it->get();
+      const double start_virtual_time =
+          std::max(queue->virtual_time(), system_virtual_time_);
+      system_virtual_time_ = start_virtual_time;
+      queue->set_virtual_time(start_virtual_time +
+                              1.0 / queue->scheduling_share());
+      *queue_for_batch_out = queue;
+      *batch_to_process_out = std::move(batch_to_process);
+      return;
+    }
+    if (queue_closed && (*it)->IsEmpty()) {
+      // We've encountered a closed queue with no work to do. Drop it.
+      EraseQueue_Locked(it);
+    }
+  }
+  *batch_to_process_out = nullptr;
+}
+
+template <typename TaskType>
+void SharedBatchScheduler<TaskType>::EraseQueue_Locked(
+    typename QueueList::iterator it) {
+  const bool erasing_next_queue = (it == next_queue_to_schedule_);
+  auto next = queues_.erase(it);
+  if (erasing_next_queue) {
+    // Wrap to the first queue if we've hit the end.
+    next_queue_to_schedule_ = next == queues_.end() ? queues_.begin() : next;
+  }
+}
+
 template <typename TaskType>
 void SharedBatchScheduler<TaskType>::ThreadLogic() {
   // A batch to process next (or nullptr if no work to do).
@@ -852,6 +994,42 @@ bool Queue<TaskType>::IsLowPriorityTask(std::unique_ptr<TaskType>* task) {
   return false;
 }
 
+template <typename TaskType>
+std::optional<uint64> Queue<TaskType>::TaskDeadline(
+    const TaskType& task) const {
+  if (!options_.enable_deadline_scheduling) {
+    return std::nullopt;
+  }
+
+  // The deadline is defined only when the task is a derived class of
+  // BatchTask.
+  if constexpr (std::is_base_of_v<BatchTask, TaskType>) {
+    return task.deadline_micros();
+  }
+  return std::nullopt;
+}
+
+template <typename TaskType>
+bool Queue<TaskType>::IsPastDeadline(uint64 deadline_micros) const {
+  return env_->NowMicros() + options_.expected_batch_processing_micros >=
+         deadline_micros;
+}
+
+template <typename TaskType>
+void Queue<TaskType>::UpdateOpenBatchDeadline(
+    std::optional<uint64> deadline_micros) {
+  if (GetBatches().back()->empty()) {
+    open_batch_deadline_micros_ = std::nullopt;
+  }
+  if (!deadline_micros.has_value()) {
+    return;
+  }
+  open_batch_deadline_micros_ =
+      open_batch_deadline_micros_.has_value()
+          ? std::min(*open_batch_deadline_micros_, *deadline_micros)
+          : *deadline_micros;
+}
+
 template <typename TaskType>
 absl::Status Queue<TaskType>::ScheduleWithoutOrEagerSplitImpl(
     std::unique_ptr<TaskType>* task) {
@@ -867,6 +1045,9 @@ absl::Status Queue<TaskType>::ScheduleWithoutOrEagerSplitImpl(
 
   const int64_t input_task_size = (*task)->size();
 
+  // The subtasks of a split task share its deadline.
+  const std::optional<uint64> deadline_micros = TaskDeadline(**task);
+
   std::vector<std::unique_ptr<TaskType>> output_tasks;
 
   if (input_task_size <= open_batch_remaining_slot ||
@@ -885,6 +1066,7 @@ absl::Status Queue<TaskType>::ScheduleWithoutOrEagerSplitImpl(
     if (batches.back()->empty()) {
       open_batch_start_time_micros_ = env_->NowMicros();
     }
+    UpdateOpenBatchDeadline(deadline_micros);
     tsl::profiler::TraceMeProducer trace_me(
         [&output_tasks, i] {
           return profiler::TraceMeEncode("ScheduleOutputTask",
@@ -958,6 +1140,7 @@ void Queue<TaskType>::PadOpenBatchWithLowPriorityTasks() {
         open_batch_start_time_micros_ =
             std::min(open_batch_start_time_micros_, task_time);
       }
+      UpdateOpenBatchDeadline(TaskDeadline(*output_tasks[i]));
 
       tsl::profiler::TraceMeProducer trace_me(
           [&output_tasks, i] {
@@ -988,6 +1171,16 @@ absl::Status Queue<TaskType>::Schedule(std::unique_ptr<TaskType>* task) {
 
     DCHECK(!closed_);
 
+    const std::optional<uint64> deadline_micros = TaskDeadline(**task);
+    if (deadline_micros.has_value() && IsPastDeadline(*deadline_micros)) {
+      return absl::DeadlineExceededError(absl::StrFormat(
+          "Task would miss its deadline: expected to be processed in %d "
+          "microseconds, but the deadline is in %d microseconds",
+          options_.expected_batch_processing_micros,
+          static_cast<int64_t>(*deadline_micros) -
+              static_cast<int64_t>(env_->NowMicros())));
+    }
+
     if (IsLowPriorityTask(task)) {
       // Insert the task to the low priority task queue instead of the high
       // priority batch queue below.
@@ -1157,6 +1350,7 @@ Queue<TaskType>::ScheduleBatch() {
       // Move the trimmed tasks, if any, into the new batch.
       Batch<TaskType>& new_batch = *batches[1];
       for (std::unique_ptr<TaskType>& task : trimmed_tasks) {
+        UpdateOpenBatchDeadline(TaskDeadline(*task));
         new_batch.AddTask(std::move(task));
       }
       if (!new_batch.empty()) {
@@ -1310,6 +1504,7 @@ void Queue<TaskType>::StartNewBatch() {
   std::deque<std::unique_ptr<Batch<TaskType>>>& batches = GetBatches();
   batches.back()->Close();
   batches.emplace_back(new Batch<TaskType>(++traceme_context_id_counter_));
+  open_batch_deadline_micros_ = std::nullopt;
 }
 
 template <typename TaskType>
@@ -1357,6 +1552,13 @@ bool Queue<TaskType>::IsOpenBatchSchedulable() const {
     return false;
   }
 
+  if (open_batch->size() > 0 && open_batch_deadline_micros_.has_value() &&
+      IsPastDeadline(*open_batch_deadline_micros_)) {
+    // Waiting for more tasks would make a task of the open batch miss its
+    // deadline.
+    return true;
+  }
+
   return closed_ || effective_batch_size >= max_execution_batch_size() ||
          env_->NowMicros() >=
              effective_start_time_micros + effective_batch_timeout_micros;
@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <string>
 #include <thread>  // NOLINT(build/c++11)
 #include <tuple>
@@ -54,9 +55,13 @@ using ::testing::HasSubstr;
 
 class FakeTask : public BatchTask {
  public:
-  explicit FakeTask(size_t size, tsl::criticality::Criticality criticality =
-                                     tsl::criticality::Criticality::kCritical)
-      : size_(size), criticality_(criticality) {}
+  explicit FakeTask(size_t size,
+                    tsl::criticality::Criticality criticality =
+                        tsl::criticality::Criticality::kCritical,
+                    std::optional<uint64> deadline_micros = std::nullopt)
+      : size_(size),
+        criticality_(criticality),
+        deadline_micros_(deadline_micros) {}
 
   ~FakeTask() override = default;
 
@@ -66,9 +71,14 @@ class FakeTask : public BatchTask {
     return criticality_;
   }
 
+  std::optional<uint64> deadline_micros() const override {
+    return deadline_micros_;
+  }
+
  private:
   const size_t size_;
   const tsl::criticality::Criticality criticality_;
+  const std::optional<uint64> deadline_micros_;
 
   FakeTask(const FakeTask&) = delete;
   void operator=(const FakeTask&) = delete;
@@ -112,6 +122,18 @@ absl::Status ScheduleTask(size_t task_size, BatchScheduler<FakeTask>* scheduler,
   return status;
 }
 
+// Creates a critical FakeTask of size 'task_size' due at 'deadline_micros',
+// and calls 'scheduler->Schedule()' on that task. Returns the resulting status.
+absl::Status ScheduleTaskWithDeadline(size_t task_size, uint64 deadline_micros,
+                                      BatchScheduler<FakeTask>* scheduler) {
+  std::unique_ptr<FakeTask> task(new FakeTask(
+      task_size, tsl::criticality::Criticality::kCritical, deadline_micros));
+  absl::Status status = scheduler->Schedule(&task);
+  // Schedule() should have consumed 'task' iff it returned Status::OK.
+  CHECK_EQ(status.ok(), task == nullptr);
+  return status;
+}
+
 // Helper function similar to the function above. Creates a FakeTask of size
 // 'task_size' and calls 'scheduler->Schedule()' on that task. Returns the
 // resulting status.
@@ -653,6 +675,86 @@ TEST_P(SharedBatchSchedulerTest, ObeysTimeout) {
   stop_teardown.Notify();
 }
 
+TEST_P(SharedBatchSchedulerTest, RejectsTasksThatWouldMissTheirDeadline) {
+  test_util::FakeClockEnv env(Env::Default());
+  Notification start_teardown, stop_teardown;
+  std::unique_ptr<Thread> teardown_thread =
+      CreateFakeClockAdvancerThread(&env, &start_teardown, &stop_teardown);
+
+  {
+    auto callback = [](std::unique_ptr<Batch<FakeTask>> batch) {
+      ASSERT_TRUE(batch->IsClosed());
+    };
+
+    auto scheduler = CreateSharedBatchScheduler(1, &env);
+
+    QueueOptions options =
+        CreateQueueOptions(/*max_execution_batch_size=*/4,
+                           /*input_batch_size_limit=*/4,
+                           /*batch_timeout_micros=*/100,
+                           /*max_enqueued_batches=*/2);
+    options.enable_deadline_scheduling = true;
+    options.expected_batch_processing_micros = 10;
+    auto queue = CreateQueue(scheduler, options, callback);
+
+    EXPECT_THAT(
+        ScheduleTaskWithDeadline(1, env.NowMicros() + 5, queue.get()),
+        testing::StatusIs(error::DEADLINE_EXCEEDED,
+                          HasSubstr("Task would miss its deadline")));
+    EXPECT_EQ(0, queue->NumEnqueuedTasks());
+
+    // Tasks without a deadline are never rejected.
+    TF_ASSERT_OK(ScheduleTask(1, queue.get()));
+    TF_ASSERT_OK(
+        ScheduleTaskWithDeadline(1, env.NowMicros() + 50, queue.get()));
+
+    start_teardown.Notify();
+  }
+  stop_teardown.Notify();
+}
+
+TEST_P(SharedBatchSchedulerTest, ClosesOpenBatchBeforeDeadline) {
+  test_util::FakeClockEnv env(Env::Default());
+  Notification start_teardown, stop_teardown;
+  std::unique_ptr<Thread> teardown_thread =
+      CreateFakeClockAdvancerThread(&env, &start_teardown, &stop_teardown);
+
+  {
+    Notification batch_processed;
+    auto callback = [&batch_processed](std::unique_ptr<Batch<FakeTask>> batch) {
+      ASSERT_TRUE(batch->IsClosed());
+      EXPECT_EQ(2, batch->num_tasks());
+      batch_processed.Notify();
+    };
+
+    auto scheduler = CreateSharedBatchScheduler(1, &env);
+
+    QueueOptions options =
+        CreateQueueOptions(/*max_execution_batch_size=*/4,
+                           /*input_batch_size_limit=*/4,
+                           /*batch_timeout_micros=*/1000,
+                           /*max_enqueued_batches=*/2);
+    options.enable_deadline_scheduling = true;
+    options.expected_batch_processing_micros = 10;
+    auto queue = CreateQueue(scheduler, options, callback);
+
+    // The earliest deadline of the open batch is in 50 microseconds: the batch
+    // must be scheduled 40 microseconds from now, well before its timeout.
+    TF_ASSERT_OK(
+        ScheduleTaskWithDeadline(1, env.NowMicros() + 100, queue.get()));
+    TF_ASSERT_OK(
+        ScheduleTaskWithDeadline(1, env.NowMicros() + 50, queue.get()));
+    env.AdvanceByMicroseconds(39);
+    Env::Default()->SleepForMicroseconds(10 * 1000 /* 10 milliseconds */);
+    EXPECT_FALSE(batch_processed.HasBeenNotified());
+    env.AdvanceByMicroseconds(1);
+    batch_processed.WaitForNotification();
+
+    start_teardown.Notify();
+  }
+  stop_teardown.Notify();
+}
+
 TEST_P(SharedBatchSchedulerTest, ObeysTimeoutWithRealClock) {
   Notification first_batch_processed, second_batch_processed;
   auto callback = [&first_batch_processed, &second_batch_processed](
@@ -801,6 +903,66 @@ TEST_P(SharedBatchSchedulerTest, Fairness) {
   stop_teardown.Notify();
 }
 
+TEST_P(SharedBatchSchedulerTest, HonorsSchedulingShares) {
+  mutex mu;
+  std::vector<char> processed_queues;
+  Notification first_batch_scheduled, first_batch_proceed;
+  auto make_callback = [&](char queue_name) {
+    return [&, queue_name](std::unique_ptr<Batch<FakeTask>> batch) {
+      if (!first_batch_scheduled.HasBeenNotified()) {
+        first_batch_scheduled.Notify();
+        first_batch_proceed.WaitForNotification();
+        return;
+      }
+      mutex_lock l(mu);
+      processed_queues.push_back(queue_name);
+    };
+  };
+
+  {
+    auto scheduler = CreateSharedBatchScheduler(1);
+    QueueOptions queue_options = CreateQueueOptions(
+        1 /* max_execution_batch_size */, 1 /* input_batch_size_limit */,
+        0 /* batch_timeout_micros */, 10 /* max_enqueued_batches */);
+    std::vector<std::unique_ptr<BatchScheduler<FakeTask>>> queues(2);
+    queue_options.scheduling_share = 3;
+    TF_ASSERT_OK(
+        scheduler->AddQueue(queue_options, make_callback('A'), &queues[0]));
+    queue_options.scheduling_share = 1;
+    TF_ASSERT_OK(
+        scheduler->AddQueue(queue_options, make_callback('B'), &queues[1]));
+
+    // Occupy the only batch thread while both queues fill up.
+    TF_ASSERT_OK(ScheduleTask(1, queues[0].get()));
+    first_batch_scheduled.WaitForNotification();
+    for (int i = 0; i < 8; ++i) {
+      TF_ASSERT_OK(ScheduleTask(1, queues[0].get()));
+      TF_ASSERT_OK(ScheduleTask(1, queues[1].get()));
+    }
+    first_batch_proceed.Notify();
+  }
+
+  // The first batch, from queue A, is not recorded.
+  mutex_lock l(mu);
+  ASSERT_EQ(processed_queues.size(), 16);
+  EXPECT_EQ(std::string(processed_queues.begin(), processed_queues.begin() + 8),
+            "BAAABAAA");
+}
+
+TEST_P(SharedBatchSchedulerTest, RejectsNonPositiveSchedulingShare) {
+  auto scheduler = CreateSharedBatchScheduler(1);
+  QueueOptions queue_options = CreateQueueOptions(
+      10 /* max_execution_batch_size */, 10 /* input_batch_size_limit */,
+      0 /* batch_timeout_micros */, 10 /* max_enqueued_batches */);
+  queue_options.scheduling_share = 0;
+  std::unique_ptr<BatchScheduler<FakeTask>> queue;
+  EXPECT_THAT(
+      scheduler->AddQueue(
+          queue_options, [](std::unique_ptr<Batch<FakeTask>> batch) {}, &queue),
+      testing::StatusIs(error::INVALID_ARGUMENT,
+                        HasSubstr("scheduling_share must be positive")));
+}
+
 TEST_P(SharedBatchSchedulerTest, ConstMethods) {
   for (const int max_enqueued_batches : {1, 2, 5}) {
     Notification processing, proceed;
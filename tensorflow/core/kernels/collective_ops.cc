@@ -1383,6 +1383,73 @@ REGISTER_KERNEL_BUILDER(Name("CollectiveAllToAllV2")
                             .HostMemory("instance_key"),
                         CollectiveAllToAllV2OpKernel);
 
+class CollectiveRaggedAllToAllOpKernel : public CollectiveOpV2Kernel {
+ public:
+  explicit CollectiveRaggedAllToAllOpKernel(OpKernelConstruction* c)
+      : CollectiveOpV2Kernel(c) {
+    name_ = strings::StrCat(c->def().name(), ": RaggedAllToAll");
+    VLOG(2) << "CollectiveRaggedAllToAll " << this << " name " << name_
+            << " communication_hint " << communication_hint_;
+  }
+
+  void ComputeAsync(OpKernelContext* c, DoneCallback done) override {
+    auto col_params = new CollectiveParams();
+    auto done_with_cleanup = [col_params, done = std::move(done)]() {
+      done();
+      col_params->Unref();
+    };
+    OP_REQUIRES_OK_ASYNC(
+        c,
+        FillCollectiveParams(col_params, c, RAGGED_ALL_TO_ALL_COLLECTIVE,
+                             /*group_size*/ c->input(3),
+                             /*group_key*/ c->input(4),
+                             /*instance_key*/ c->input(5)),
+        done_with_cleanup);
+    // The number of rows differs across the members, so the instance shape,
+    // which must agree across them, is the shape of the chunk sizes.
+    col_params->instance.shape = c->input(1).shape();
+    VLOG(1) << "CollectiveRaggedAllToAll group_size "
+            << col_params->group.group_size << " group_key "
+            << col_params->group.group_key << " instance_key "
+            << col_params->instance.instance_key;
+    const Tensor& input = c->input(0);
+    const Tensor& recv_sizes = c->input(2);
+    OP_REQUIRES_ASYNC(c, input.dims() >= 1,
+                      errors::InvalidArgument(
+                          "input must have at least one dimension, got ",
+                          input.shape().DebugString()),
+                      done_with_cleanup);
+    OP_REQUIRES_ASYNC(
+        c,
+        TensorShapeUtils::IsVector(recv_sizes.shape()) &&
+            recv_sizes.NumElements() == col_params->group.group_size,
+        errors::InvalidArgument("recv_sizes must be a vector of group_size (",
+                                col_params->group.group_size,
+                                ") elements, got ",
+                                recv_sizes.shape().DebugString()),
+        done_with_cleanup);
+    int64_t num_rows = 0;
+    for (int64_t size : recv_sizes.vec<int64_t>()) {
+      OP_REQUIRES_ASYNC(c, size >= 0,
+                        errors::InvalidArgument(
+                            "recv_sizes must be non-negative, got ", size),
+                        done_with_cleanup);
+      num_rows += size;
+    }
+    TensorShape output_shape = input.shape();
+    output_shape.set_dim(0, num_rows);
+    // The sizes of the input and output differ, so the input is never
+    // forwarded.
+    Tensor* output = nullptr;
+    OP_REQUIRES_OK_ASYNC(c, c->allocate_output(0, output_shape, &output),
+                         done_with_cleanup);
+    Run(c, col_params, std::move(done_with_cleanup));
+  }
+};
+
+REGISTER_KERNEL_BUILDER(Name("CollectiveRaggedAllToAll").Device(DEVICE_CPU),
+                        CollectiveRaggedAllToAllOpKernel);
+
 class CollectiveAllToAllV3OpKernel : public CollectiveOpV3Kernel {
  public:
   explicit CollectiveAllToAllV3OpKernel(OpKernelConstruction* c)
@@ -810,6 +810,33 @@ struct use_bcast_optimization<double> {
   static constexpr bool value = true;
 };
 
+// Types for which a 2-D broadcast of a row or a column is computed one output
+// row at a time on the CPU, see BinaryFunctor<CPUDevice, Functor, 2>.
+template <typename T>
+struct use_rowwise_bcast {
+  static constexpr bool value = use_bcast_optimization<T>::value;
+};
+
+template <>
+struct use_rowwise_bcast<Eigen::half> {
+  static constexpr bool value = true;
+};
+
+template <>
+struct use_rowwise_bcast<bfloat16> {
+  static constexpr bool value = true;
+};
+
+template <>
+struct use_rowwise_bcast<int8> {
+  static constexpr bool value = true;
+};
+
+template <>
+struct use_rowwise_bcast<int32> {
+  static constexpr bool value = true;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 // Unary functors
 ////////////////////////////////////////////////////////////////////////////////
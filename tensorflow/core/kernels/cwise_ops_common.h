@@ -107,7 +107,7 @@ class BinaryOp : public BinaryOpShared {
     if (input_0.shape() == input_1.shape()) {
       // tensor op tensor with no broadcasting.
       Tensor* out;
-      OP_REQUIRES_OK(ctx, ctx->forward_input_or_allocate_output(
+      OP_REQUIRES_OK(ctx, ctx->forward_elementwise_input_or_allocate_output(
                               {0, 1}, 0, input_0.shape(), &out));
       functor::BinaryFunctor<Device, Functor, 1>()(
           eigen_device, out->template flat<Tout>(),
@@ -453,6 +453,65 @@ struct BinaryFunctor<CPUDevice, Functor, 2, false> {
     return ret;
   }
 
+  // Handles a full matrix op a row vector or a column vector, in either
+  // order, e.g. a bias add or a per-channel scale, by applying the op to one
+  // contiguous output row at a time. Unlike a broadcast expression, the rows
+  // are vectorized without computing the broadcast index of each element.
+  // Returns false, without touching `out`, for other shapes.
+  bool RowwiseBCast(
+      const CPUDevice& dev,
+      typename TTypes<typename Functor::out_type, NDIMS>::Tensor out,
+      typename TTypes<typename Functor::in_type, NDIMS>::ConstTensor in0,
+      typename TTypes<typename Functor::in_type, NDIMS>::ConstTensor in1) {
+    typedef typename Functor::out_type Tout;
+    typedef typename Functor::in_type Tin;
+    typedef typename Functor::func Binary;
+    // Shorter rows are faster with the broadcast expressions.
+    constexpr Eigen::DenseIndex kMinCols = 16;
+    const Eigen::DenseIndex rows = out.dimension(0);
+    const Eigen::DenseIndex cols = out.dimension(1);
+    if (cols < kMinCols) return false;
+    const bool in0_full = in0.dimension(0) == rows && in0.dimension(1) == cols;
+    const bool in1_full = in1.dimension(0) == rows && in1.dimension(1) == cols;
+    if (in0_full == in1_full) return false;
+    const auto& full = in0_full ? in0 : in1;
+    const auto& other = in0_full ? in1 : in0;
+    const bool other_is_row =
+        other.dimension(0) == 1 && other.dimension(1) == cols;
+    const bool other_is_column =
+        other.dimension(0) == rows && other.dimension(1) == 1;
+    if (!other_is_row && !other_is_column) return false;
+
+    Binary func;
+    auto work = [&](Eigen::Index begin, Eigen::Index end) {
+      for (Eigen::Index r = begin; r < end; ++r) {
+        typename TTypes<Tout>::Flat out_row(out.data() + r * cols, cols);
+        typename TTypes<Tin>::ConstFlat full_row(full.data() + r * cols, cols);
+        if (other_is_row) {
+          typename TTypes<Tin>::ConstFlat other_row(other.data(), cols);
+          if (in0_full) {
+            out_row = full_row.binaryExpr(other_row, func);
+          } else {
+            out_row = other_row.binaryExpr(full_row, func);
+          }
+        } else if (in0_full) {
+          out_row = full_row.unaryExpr(
+              Eigen::internal::scalar_right<Tout, Tin, Binary>(other.data() +
+                                                               r));
+        } else {
+          out_row = full_row.unaryExpr(
+              Eigen::internal::scalar_left<Tout, Tin, Binary>(other.data() +
+                                                              r));
+        }
+      }
+    };
+    const Eigen::TensorOpCost cost(
+        2 * cols * sizeof(Tin), cols * sizeof(Tout),
+        cols * Eigen::internal::functor_traits<Binary>::Cost);
+    dev.parallelFor(rows, cost, work);
+    return true;
+  }
+
   void BCast(const CPUDevice& dev,
              typename TTypes<typename Functor::out_type, NDIMS>::Tensor out,
              typename TTypes<typename Functor::in_type, NDIMS>::ConstTensor in0,
@@ -462,6 +521,10 @@ struct BinaryFunctor<CPUDevice, Functor, 2, false> {
              bool* error) {
     typedef typename Functor::in_type T;
     typename Functor::func func;
+    if (Functor::use_bcast_optimization && use_rowwise_bcast<T>::value &&
+        RowwiseBCast(dev, out, in0, in1)) {
+      return;
+    }
     if (Functor::use_bcast_optimization && use_bcast_optimization<T>::value) {
       // Optimize for speed by using Eigen::type2index and avoid
       // .broadcast() when we know it's a no-op.
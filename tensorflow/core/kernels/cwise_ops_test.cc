@@ -14,9 +14,14 @@ limitations under the License.
 ==============================================================================*/
 
 #include "tensorflow/core/common_runtime/kernel_benchmark_testlib.h"
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def_builder.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
 #include "tensorflow/core/graph/node_builder.h"
+#include "tensorflow/core/kernels/ops_testutil.h"
 #include "tensorflow/core/kernels/ops_util.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
 #include "tensorflow/core/platform/test.h"
 #include "tensorflow/core/platform/test_benchmark.h"
 #include "tensorflow/core/util/tensor_format.h"
@@ -473,5 +478,82 @@ BM_BCAST_ADD_CROSS_CR_ALL(gpu);
 #undef BM_BCAST_ADD_CROSS_CR_ALL
 #undef BM_BCAST_ADD_CROSS_CR
 
+// Runs a binary cwise op on the CPU.
+class BinaryOpRunner : public OpsTestBase {
+ public:
+  void TestBody() override {}
+
+  template <typename T>
+  Tensor Run(const string& op, const Tensor& x, const Tensor& y) {
+    TF_CHECK_OK(NodeDefBuilder("op", op)
+                    .Input(FakeInput(DataTypeToEnum<T>::value))
+                    .Input(FakeInput(DataTypeToEnum<T>::value))
+                    .Finalize(node_def()));
+    TF_CHECK_OK(InitOp());
+    AddInputFromArray<T>(x.shape(), gtl::ArraySlice<T>(x.flat<T>().data(),
+                                                       x.NumElements()));
+    AddInputFromArray<T>(y.shape(), gtl::ArraySlice<T>(y.flat<T>().data(),
+                                                       y.NumElements()));
+    TF_CHECK_OK(RunOpKernel());
+    return *GetOutput(0);
+  }
+};
+
+// Returns `vector`, a row or a column, repeated to the shape of `full`.
+template <typename T>
+Tensor TileLike(const Tensor& vector, const Tensor& full) {
+  Tensor tiled(DataTypeToEnum<T>::value, full.shape());
+  const int64_t rows = full.dim_size(0);
+  const int64_t cols = full.dim_size(1);
+  const bool is_row = vector.dim_size(0) == 1;
+  for (int64_t r = 0; r < rows; ++r) {
+    for (int64_t c = 0; c < cols; ++c) {
+      tiled.matrix<T>()(r, c) = vector.matrix<T>()(is_row ? 0 : r,
+                                                   is_row ? c : 0);
+    }
+  }
+  return tiled;
+}
+
+// Checks that broadcasting a row or a column, which takes the row-wise path
+// of ops like AddV2, Sub and Mul for rows of at least 16 elements, matches
+// the op on explicitly tiled inputs, which takes the non-broadcasting path.
+template <typename T>
+void CheckRowwiseBCast(const string& op, int64_t rows, int64_t cols) {
+  Tensor full(DataTypeToEnum<T>::value, TensorShape({rows, cols}));
+  test::FillFn<T>(&full, [](int i) { return static_cast<T>(i % 7 + 1); });
+  Tensor row(DataTypeToEnum<T>::value, TensorShape({1, cols}));
+  test::FillFn<T>(&row, [](int i) { return static_cast<T>(i % 5 + 2); });
+  Tensor column(DataTypeToEnum<T>::value, TensorShape({rows, 1}));
+  test::FillFn<T>(&column, [](int i) { return static_cast<T>(i % 3 + 3); });
+  for (const Tensor& vector : {row, column}) {
+    const Tensor tiled = TileLike<T>(vector, full);
+    test::ExpectTensorEqual<T>(BinaryOpRunner().Run<T>(op, full, vector),
+                               BinaryOpRunner().Run<T>(op, full, tiled));
+    test::ExpectTensorEqual<T>(BinaryOpRunner().Run<T>(op, vector, full),
+                               BinaryOpRunner().Run<T>(op, tiled, full));
+  }
+}
+
+TEST(RowwiseBCastTest, Float) {
+  CheckRowwiseBCast<float>("Sub", /*rows=*/67, /*cols=*/33);
+  CheckRowwiseBCast<float>("Mul", /*rows=*/67, /*cols=*/33);
+  CheckRowwiseBCast<float>("AddV2", /*rows=*/3, /*cols=*/16);
+}
+
+TEST(RowwiseBCastTest, Int32) {
+  CheckRowwiseBCast<int32>("Sub", /*rows=*/67, /*cols=*/33);
+  CheckRowwiseBCast<int32>("Mul", /*rows=*/2, /*cols=*/100);
+}
+
+TEST(RowwiseBCastTest, Half) {
+  CheckRowwiseBCast<Eigen::half>("AddV2", /*rows=*/9, /*cols=*/40);
+}
+
+TEST(RowwiseBCastTest, ShortRows) {
+  // Rows of fewer than 16 elements keep the broadcast expressions.
+  CheckRowwiseBCast<float>("Sub", /*rows=*/67, /*cols=*/15);
+}
+
 }  // namespace
 }  // namespace tensorflow
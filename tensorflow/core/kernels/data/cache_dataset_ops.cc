@@ -23,11 +23,15 @@ limitations under the License.
 #include <vector>
 
 #include "absl/status/status.h"
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
 #include "tensorflow/core/data/global_shuffle_utils.h"
+#include "tensorflow/core/data/hash_utils.h"
 #include "tensorflow/core/data/name_utils.h"
 #include "tensorflow/core/data/serialization_utils.h"
 #include "tensorflow/core/framework/dataset.h"
 #include "tensorflow/core/framework/dataset_options.pb.h"
+#include "tensorflow/core/framework/graph.pb.h"
 #include "tensorflow/core/framework/partial_tensor_shape.h"
 #include "tensorflow/core/framework/resource_mgr.h"
 #include "tensorflow/core/framework/tensor.h"
@@ -64,6 +68,11 @@ constexpr char kIterationCompleted[] = "iteration_completed";
 constexpr char kCurIndex[] = "cur_index";
 constexpr char kShardId[] = "shard_id";
 constexpr char kCreatedAt[] = "Created at";
+constexpr char kRefreshedAt[] = "Refreshed at";
+// How often the writer of a shared cache refreshes its lockfile, and how long
+// other iterators wait for a refresh before they take the writer for dead.
+constexpr uint64 kLockFileRefreshSeconds = 60;
+constexpr uint64 kStaleLockFileSeconds = 10 * 60;
 constexpr char kMemoryDatasetPrefix[] = "Memory";
 constexpr char kMemoryCache[] = "MemoryCache";
 constexpr char kCacheCompleted[] = "cache_completed";
@@ -76,6 +85,26 @@ constexpr char kIncompleteCacheErrorMessage[] =
     "contents of the dataset  will be discarded. This can happen if you have "
     "an input pipeline similar to `dataset.cache().take(k).repeat()`. You "
     "should use `dataset.take(k).cache().repeat()` instead.";
+
+// Returns the prefix of the content-addressed cache of `input` in `directory`.
+// The prefix is derived from the hash of the input pipeline's graph, so that
+// jobs that cache identical pipelines share the cache files.
+absl::Status ContentAddressedCachePrefix(OpKernelContext* ctx,
+                                         const DatasetBase* input,
+                                         const string& directory,
+                                         string* prefix) {
+  GraphDef graph_def;
+  SerializationContext::Params params(ctx);
+  std::vector<std::pair<string, Tensor>> input_list;
+  params.input_list = &input_list;
+  params.external_state_policy = ExternalStatePolicy::POLICY_IGNORE;
+  TF_RETURN_IF_ERROR(
+      AsGraphDef(input, SerializationContext(params), &graph_def));
+  uint64 hash;
+  TF_RETURN_IF_ERROR(HashGraph(graph_def, &hash));
+  *prefix = strings::StrCat(directory, strings::Hex(hash, strings::kZeroPad16));
+  return absl::OkStatus();
+}
 }  // namespace
 
 class DatasetRandomAccessCache {
@@ -167,11 +196,19 @@ class IteratorRandomAccessCache {
 
 class CacheDatasetOp::FileDatasetBase : public DatasetBase {
  public:
+  // If `content_addressed_prefix` is non-empty, the cache is stored under that
+  // prefix instead of `filename`, and is shared with other jobs: an iterator
+  // that finds another writer already filling the cache passes its input
+  // through instead of failing.
   FileDatasetBase(OpKernelContext* ctx, const DatasetBase* input,
-                  string filename, Env* env)
+                  string filename, Env* env,
+                  string content_addressed_prefix = "")
       : DatasetBase(DatasetContext(ctx)),
         input_(input),
-        filename_(std::move(filename)),
+        filename_(content_addressed_prefix.empty() ? filename
+                                                   : content_addressed_prefix),
+        serialized_filename_(std::move(filename)),
+        content_addressed_(!content_addressed_prefix.empty()),
         env_(env),
         num_tensors_(input->output_dtypes().size()),
         tensor_index_padding_size_(StringPaddingSize(num_tensors_)),
@@ -223,7 +260,12 @@ class CacheDatasetOp::FileDatasetBase : public DatasetBase {
 
  protected:
   const DatasetBase* const input_;
+  // The prefix of the cache files.
   const tstring filename_;
+  // The `filename` argument of the op, which differs from `filename_` for a
+  // content-addressed cache.
+  const tstring serialized_filename_;
+  const bool content_addressed_;
 
  private:
   static size_t StringPaddingSize(size_t num_tensors) {
@@ -326,10 +368,14 @@ class CacheDatasetOp::FileDatasetBase : public DatasetBase {
                 strings::StrCat(params.dataset->filename_, "_", shard_id_)),
             lockfile_(strings::StrCat(filename_, kLockFileSuffix)),
             lockfile_created_(false),
-            iteration_completed_(false) {}
+            iteration_completed_(false),
+            passthrough_(false) {}
 
       ~FileWriterIterator() override {
-        if (!dataset()->env_->FileExists(MetaFilename(filename_)).ok()) {
+        // The files of a shared cache may belong to another job's writer, so
+        // they are only cleaned up by the iterator that created them.
+        if ((!dataset()->content_addressed_ || lockfile_created_) &&
+            !dataset()->env_->FileExists(MetaFilename(filename_)).ok()) {
           LOG(WARNING) << kIncompleteCacheErrorMessage;
           std::vector<string> cache_files;
           absl::Status s = dataset()->env_->GetMatchingPaths(
@@ -362,6 +408,9 @@ class CacheDatasetOp::FileDatasetBase : public DatasetBase {
         if (*end_of_sequence) {
           return absl::OkStatus();
         }
+        if (passthrough_) {
+          return input_impl_->GetNext(ctx, out_tensors, end_of_sequence);
+        }
         TF_RETURN_IF_ERROR(writer_->status());
         if (cur_index_ >= kMaxItems) {
           // As a courtesy, close the [truncated] cache file.
@@ -393,6 +442,9 @@ class CacheDatasetOp::FileDatasetBase : public DatasetBase {
           string key = dataset()->FormatName(cur_index_, tensor_index++);
           TF_RETURN_IF_ERROR(writer_->Add(key, t));
         }
+        if (dataset()->content_addressed_) {
+          TF_RETURN_IF_ERROR(MaybeRefreshSharedLockFile());
+        }
         if (*end_of_sequence) {
           TF_RETURN_IF_ERROR(Finish());
         }
@@ -486,13 +538,42 @@ class CacheDatasetOp::FileDatasetBase : public DatasetBase {
           *end_of_sequence = true;
           return absl::OkStatus();
         }
-        if (lockfile_created_) {
+        if (lockfile_created_ || passthrough_) {
           return absl::OkStatus();
         }
 
         // Perform rudimentary locking to help catch concurrent writes to the
         // same cache files.
 
+        // A shared cache that is already being written by another iterator
+        // (typically in another job) is left to that writer, and elements are
+        // produced from the input instead.
+        if (dataset()->content_addressed_ &&
+            (dataset()->env_->FileExists(MetaFilename(filename_)).ok() ||
+             dataset()->env_->FileExists(lockfile_).ok())) {
+          uint64 lockfile_age_seconds = 0;
+          if (!SharedLockFileIsStale(&lockfile_age_seconds)) {
+            LOG(INFO) << "The shared cache " << dataset()->filename_
+                      << " is being written by another iterator. Reading "
+                      << "from the input instead.";
+            passthrough_ = true;
+            return absl::OkStatus();
+          }
+          // The writer exited without finishing the cache, e.g. because its
+          // job was killed: take over.
+          LOG(WARNING) << "The writer of the shared cache "
+                       << dataset()->filename_ << " last refreshed its "
+                       << "lockfile " << lockfile_age_seconds
+                       << " seconds ago. Deleting its files and writing the "
+                       << "cache instead.";
+          std::vector<string> cache_files;
+          TF_RETURN_IF_ERROR(dataset()->env_->GetMatchingPaths(
+              strings::StrCat(dataset()->filename_, "_*"), &cache_files));
+          for (const string& path : cache_files) {
+            TF_RETURN_IF_ERROR(dataset()->env_->DeleteFile(path));
+          }
+        }
+
         // 1. Check that a checkpoint for the shard has not already been
         // written.
         if (dataset()->env_->FileExists(MetaFilename(filename_)).ok()) {
@@ -542,6 +623,50 @@ class CacheDatasetOp::FileDatasetBase : public DatasetBase {
         return absl::OkStatus();
       }
 
+      // The lockfile of the first shard of a shared cache. Its writer keeps it
+      // until the cache is finished, and refreshes it while it is running.
+      string SharedLockFile() const {
+        return strings::StrCat(dataset()->filename_, "_0", kLockFileSuffix);
+      }
+
+      absl::Status MaybeRefreshSharedLockFile()
+          TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+        const uint64 now = EnvTime::NowSeconds();
+        if (now < lockfile_refreshed_at_ + kLockFileRefreshSeconds) {
+          return absl::OkStatus();
+        }
+        TF_RETURN_IF_ERROR(WriteStringToFile(
+            dataset()->env_, SharedLockFile(),
+            strings::StrCat(kRefreshedAt, ": ", now)));
+        lockfile_refreshed_at_ = now;
+        return absl::OkStatus();
+      }
+
+      // Returns true if the writer of the shared cache has neither created nor
+      // refreshed its lockfile for the last `kStaleLockFileSeconds`. Sets
+      // `age_seconds` to the time since then.
+      bool SharedLockFileIsStale(uint64* age_seconds) const {
+        string contents;
+        if (!ReadFileToString(dataset()->env_, SharedLockFile(), &contents)
+                 .ok()) {
+          return false;
+        }
+        // The lockfile holds "<kCreatedAt or kRefreshedAt>: <seconds>".
+        const size_t pos = contents.rfind(": ");
+        uint64 updated_at = 0;
+        if (pos == string::npos ||
+            !absl::SimpleAtoi(absl::string_view(contents).substr(pos + 2),
+                              &updated_at)) {
+          return false;
+        }
+        const uint64 now = EnvTime::NowSeconds();
+        if (now < updated_at + kStaleLockFileSeconds) {
+          return false;
+        }
+        *age_seconds = now - updated_at;
+        return true;
+      }
+
       absl::Status Finish() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
         iteration_completed_ = true;
         // Flush the current bundle.
@@ -584,6 +709,11 @@ class CacheDatasetOp::FileDatasetBase : public DatasetBase {
       string lockfile_ TF_GUARDED_BY(mu_);
       bool lockfile_created_ TF_GUARDED_BY(mu_);
       bool iteration_completed_ TF_GUARDED_BY(mu_);
+      // Whether another iterator is writing the shared cache, in which case
+      // this iterator only forwards the elements of its input.
+      bool passthrough_ TF_GUARDED_BY(mu_);
+      // When `SharedLockFile()` was last refreshed by this iterator.
+      uint64 lockfile_refreshed_at_ TF_GUARDED_BY(mu_) = 0;
     };  // FileWriterIterator
 
     class FileReaderIterator : public DatasetIterator<FileDatasetBase> {
@@ -725,7 +855,7 @@ class CacheDatasetOp::FileDataset : public CacheDatasetOp::FileDatasetBase {
     Node* input_graph = nullptr;
     TF_RETURN_IF_ERROR(b->AddInputDataset(ctx, input_, &input_graph));
     Node* filename = nullptr;
-    TF_RETURN_IF_ERROR(b->AddScalar(filename_, &filename));
+    TF_RETURN_IF_ERROR(b->AddScalar(serialized_filename_, &filename));
     TF_RETURN_IF_ERROR(b->AddDataset(this, {input_graph, filename}, output));
     return absl::OkStatus();
   }
@@ -735,8 +865,10 @@ class CacheDatasetOp::FileDatasetV2 : public CacheDatasetOp::FileDatasetBase {
  public:
   explicit FileDatasetV2(OpKernelContext* ctx, const DatasetBase* input,
                          string filename, Env* env,
-                         const Tensor& resource_handle)
-      : FileDatasetBase(ctx, input, filename, env),
+                         const Tensor& resource_handle,
+                         string content_addressed_prefix = "")
+      : FileDatasetBase(ctx, input, filename, env,
+                        std::move(content_addressed_prefix)),
         resource_handle_(resource_handle) {}
 
  protected:
@@ -746,7 +878,7 @@ class CacheDatasetOp::FileDatasetV2 : public CacheDatasetOp::FileDatasetBase {
     Node* input_node = nullptr;
     TF_RETURN_IF_ERROR(b->AddInputDataset(ctx, input_, &input_node));
     Node* filename_node = nullptr;
-    TF_RETURN_IF_ERROR(b->AddScalar(filename_, &filename_node));
+    TF_RETURN_IF_ERROR(b->AddScalar(serialized_filename_, &filename_node));
     Node* resource_handle_node = nullptr;
     TF_RETURN_IF_ERROR(b->AddTensor(resource_handle_, &resource_handle_node));
     TF_RETURN_IF_ERROR(b->AddDataset(
@@ -1225,11 +1357,19 @@ void CacheDatasetOp::MakeDataset(OpKernelContext* ctx, DatasetBase* input,
       *output = new MemoryDataset(ctx, input, manager, std::move(handle));
     }
   } else {
+    // A filename naming a directory selects a cache that is shared by all
+    // pipelines with the same input graph.
+    string content_addressed_prefix;
+    if (absl::EndsWith(filename, "/")) {
+      OP_REQUIRES_OK(ctx, ContentAddressedCachePrefix(
+                              ctx, input, filename, &content_addressed_prefix));
+    }
     if (op_version_ == 2) {
-      *output =
-          new FileDatasetV2(ctx, input, filename, ctx->env(), ctx->input(2));
+      *output = new FileDatasetV2(ctx, input, filename, ctx->env(),
+                                  ctx->input(2), content_addressed_prefix);
     } else {
-      *output = new FileDataset(ctx, input, filename, ctx->env());
+      *output = new FileDataset(ctx, input, filename, ctx->env(),
+                                content_addressed_prefix);
     }
   }
 }
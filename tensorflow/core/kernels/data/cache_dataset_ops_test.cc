@@ -204,6 +204,111 @@ TEST_P(ParameterizedGetNextTest, GetNext) {
 INSTANTIATE_TEST_SUITE_P(CacheDatasetOpTest, ParameterizedGetNextTest,
                          ::testing::ValuesIn(GetNextTestCases()));
 
+TEST_F(CacheDatasetOpTest, ContentAddressedCacheIsShared) {
+  auto tensor_slice_dataset_params = TensorSliceDatasetParams(
+      /*components=*/{CreateTensor<int64_t>(TensorShape{3, 3, 1},
+                                            {0, 1, 2, 3, 4, 5, 6, 7, 8})},
+      /*node_name=*/"tensor_slice");
+  auto dataset_params = CacheDatasetParams(
+      std::move(tensor_slice_dataset_params),
+      /*filename=*/io::JoinPath(testing::TmpDir(), "shared_cache/"),
+      /*output_dtypes=*/{DT_INT64},
+      /*output_shapes=*/{PartialTensorShape({3, 1})}, kNodeName);
+  TF_ASSERT_OK(Initialize(dataset_params));
+  const std::vector<Tensor> expected_outputs = CreateTensors<int64_t>(
+      TensorShape({3, 1}), {{0, 1, 2}, {3, 4, 5}, {6, 7, 8}});
+
+  // The first iterator becomes the writer of the cache.
+  bool end_of_sequence = false;
+  std::vector<Tensor> out_tensors;
+  TF_ASSERT_OK(
+      iterator_->GetNext(iterator_ctx_.get(), &out_tensors, &end_of_sequence));
+
+  // A concurrent iterator reads from the input instead of failing.
+  std::unique_ptr<IteratorBase> concurrent_iterator;
+  TF_ASSERT_OK(dataset_->MakeIterator(iterator_ctx_.get(), /*parent=*/nullptr,
+                                      dataset_params.iterator_prefix(),
+                                      &concurrent_iterator));
+  std::vector<Tensor> concurrent_tensors;
+  bool concurrent_end_of_sequence = false;
+  while (!concurrent_end_of_sequence) {
+    TF_ASSERT_OK(concurrent_iterator->GetNext(iterator_ctx_.get(),
+                                              &concurrent_tensors,
+                                              &concurrent_end_of_sequence));
+  }
+  TF_EXPECT_OK(ExpectEqual(concurrent_tensors, expected_outputs,
+                           /*compare_order=*/true));
+  concurrent_iterator.reset();
+
+  while (!end_of_sequence) {
+    TF_ASSERT_OK(iterator_->GetNext(iterator_ctx_.get(), &out_tensors,
+                                    &end_of_sequence));
+  }
+  TF_EXPECT_OK(
+      ExpectEqual(out_tensors, expected_outputs, /*compare_order=*/true));
+
+  // Once written, the cache is read back.
+  TF_ASSERT_OK(dataset_->MakeIterator(iterator_ctx_.get(), /*parent=*/nullptr,
+                                      dataset_params.iterator_prefix(),
+                                      &iterator_));
+  end_of_sequence = false;
+  out_tensors.clear();
+  while (!end_of_sequence) {
+    TF_ASSERT_OK(iterator_->GetNext(iterator_ctx_.get(), &out_tensors,
+                                    &end_of_sequence));
+  }
+  TF_EXPECT_OK(
+      ExpectEqual(out_tensors, expected_outputs, /*compare_order=*/true));
+}
+
+TEST_F(CacheDatasetOpTest, StaleLockFileOfSharedCacheIsTakenOver) {
+  auto tensor_slice_dataset_params = TensorSliceDatasetParams(
+      /*components=*/{CreateTensor<int64_t>(TensorShape{3, 3, 1},
+                                            {0, 1, 2, 3, 4, 5, 6, 7, 8})},
+      /*node_name=*/"tensor_slice");
+  const std::string cache_dir =
+      io::JoinPath(testing::TmpDir(), "stale_shared_cache");
+  auto dataset_params = CacheDatasetParams(
+      std::move(tensor_slice_dataset_params),
+      /*filename=*/strings::StrCat(cache_dir, "/"),
+      /*output_dtypes=*/{DT_INT64},
+      /*output_shapes=*/{PartialTensorShape({3, 1})}, kNodeName);
+  TF_ASSERT_OK(Initialize(dataset_params));
+  const std::vector<Tensor> expected_outputs = CreateTensors<int64_t>(
+      TensorShape({3, 1}), {{0, 1, 2}, {3, 4, 5}, {6, 7, 8}});
+  const std::string lockfile_pattern = io::JoinPath(cache_dir, "*.lockfile");
+
+  // Start writing the cache to find its lockfile, and leave the lockfile
+  // behind as if the writer had been killed long ago.
+  bool end_of_sequence = false;
+  std::vector<Tensor> out_tensors;
+  TF_ASSERT_OK(
+      iterator_->GetNext(iterator_ctx_.get(), &out_tensors, &end_of_sequence));
+  std::vector<std::string> lockfiles;
+  TF_ASSERT_OK(Env::Default()->GetMatchingPaths(lockfile_pattern, &lockfiles));
+  ASSERT_EQ(lockfiles.size(), 1);
+  iterator_.reset();
+  TF_ASSERT_OK(
+      WriteStringToFile(Env::Default(), lockfiles[0], "Created at: 0"));
+
+  // A new iterator writes the cache instead of reading from the input, and
+  // removes the lockfile once it is done.
+  TF_ASSERT_OK(dataset_->MakeIterator(iterator_ctx_.get(), /*parent=*/nullptr,
+                                      dataset_params.iterator_prefix(),
+                                      &iterator_));
+  end_of_sequence = false;
+  out_tensors.clear();
+  while (!end_of_sequence) {
+    TF_ASSERT_OK(iterator_->GetNext(iterator_ctx_.get(), &out_tensors,
+                                    &end_of_sequence));
+  }
+  TF_EXPECT_OK(
+      ExpectEqual(out_tensors, expected_outputs, /*compare_order=*/true));
+  lockfiles.clear();
+  TF_ASSERT_OK(Env::Default()->GetMatchingPaths(lockfile_pattern, &lockfiles));
+  EXPECT_TRUE(lockfiles.empty());
+}
+
 TEST_F(CacheDatasetOpTest, DatasetNodeName) {
   auto dataset_params = CacheDatasetParams1();
   TF_ASSERT_OK(Initialize(dataset_params));
@@ -105,6 +105,9 @@ constexpr absl::Duration kDefaultTaskRefreshInterval = absl::Seconds(1);
 
 // Default starting `max_outstanding_requests` when it is autotuned.
 constexpr int64_t kStartingMaxOutstandingRequests = 16;
+// Upper bound on the number of elements fetched in one GetElement call when
+// the `data_service_batched_get_element` experiment is enabled.
+constexpr int64_t kMaxElementsPerRequest = 32;
 
 }  // namespace
 
@@ -163,16 +166,21 @@ class DataServiceDatasetOp::Dataset : public DatasetBase {
 
   std::unique_ptr<IteratorBase> MakeIteratorInternal(
       const string& prefix) const override {
+    DataServiceParams params{
+        dataset_id_, processing_mode_, address_, protocol_,
+        data_transfer_protocol_, job_name_,
+        /*repetition=*/iteration_counter_->GetAndIncrement(), num_consumers_,
+        consumer_index_, max_outstanding_requests_, task_refresh_interval_,
+        target_workers_, metadata_, cross_trainer_cache_options_};
+    if (GetExperiments().contains("data_service_batched_get_element")) {
+      params.max_elements_per_request = kMaxElementsPerRequest;
+    }
+    params.prefer_nearby_workers =
+        GetExperiments().contains("data_service_locality_aware_reads");
     return std::make_unique<Iterator>(
         Iterator::Params{this,
                          name_utils::IteratorPrefix(kDatasetType, prefix)},
-        DataServiceParams{dataset_id_, processing_mode_, address_, protocol_,
-                          data_transfer_protocol_, job_name_,
-                          /*repetition=*/iteration_counter_->GetAndIncrement(),
-                          num_consumers_, consumer_index_,
-                          max_outstanding_requests_, task_refresh_interval_,
-                          target_workers_, metadata_,
-                          cross_trainer_cache_options_});
+        params);
   }
 
   const DataTypeVector& output_dtypes() const override { return output_types_; }
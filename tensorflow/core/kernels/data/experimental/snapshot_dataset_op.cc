@@ -23,6 +23,7 @@ limitations under the License.
 #include <vector>
 
 #include "absl/time/clock.h"
+#include "tensorflow/core/data/dataset_utils.h"
 #include "tensorflow/core/data/hash_utils.h"
 #include "tensorflow/core/data/serialization_utils.h"
 #include "tensorflow/core/data/snapshot_utils.h"
@@ -337,6 +338,7 @@ class SnapshotDatasetV2Op::Dataset : public DatasetBase {
 
     explicit Writer(const Params& params)
         : DatasetIterator<Dataset>(params),
+          file_format_version_(FileFormatVersion(params.dataset->compression_)),
           writers_closed_(false),
           run_id_(0),
           current_checkpoint_id_(0) {}
@@ -417,7 +419,7 @@ class SnapshotDatasetV2Op::Dataset : public DatasetBase {
           auto writer = std::make_unique<snapshot_util::AsyncWriter>(
               ctx->env(), shard_index, snapshot_shard_directory,
               current_checkpoint_id_, dataset()->compression_,
-              kFileFormatVersion, dataset()->output_dtypes(),
+              file_format_version_, dataset()->output_dtypes(),
               [this](absl::Status s) {
                 if (!s.ok()) {
                   LOG(ERROR) << "AsyncWriter in snapshot writer failed: " << s;
@@ -501,7 +503,7 @@ class SnapshotDatasetV2Op::Dataset : public DatasetBase {
       metadata.set_creation_timestamp(EnvTime::NowMicros());
       metadata.set_graph_hash(strings::StrCat(dataset()->hash_));
       metadata.set_run_id(strings::StrCat(run_id_));
-      metadata.set_version(kFileFormatVersion);
+      metadata.set_version(file_format_version_);
       for (const auto& output_dtype : dataset()->output_dtypes()) {
         metadata.add_dtype(output_dtype);
       }
@@ -526,6 +528,20 @@ class SnapshotDatasetV2Op::Dataset : public DatasetBase {
       }
     }
 
+    // Returns the file format version to write snapshots with. The chunked
+    // format lets readers resume at any element without reading the elements
+    // before it, but it only supports snappy or no compression.
+    static int FileFormatVersion(const std::string& compression) {
+      if (GetExperiments().contains("snapshot_format_v3") &&
+          (compression == io::compression::kSnappy ||
+           compression == io::compression::kNone)) {
+        return snapshot_util::kChunkedFileFormatVersion;
+      }
+      return kFileFormatVersion;
+    }
+
+    const int file_format_version_;
+
     mutex mu_;
     mutex writer_status_mu_;
     std::unique_ptr<IteratorBase> input_impl_ TF_GUARDED_BY(mu_);
@@ -17,15 +17,18 @@ limitations under the License.
 #include <deque>
 #include <functional>
 #include <utility>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/time/time.h"
+#include "tensorflow/core/common_runtime/device_mgr.h"
 #include "tensorflow/core/common_runtime/input_colocation_exemption_registry.h"
 #include "tensorflow/core/common_runtime/process_function_library_runtime.h"
 #include "tensorflow/core/data/dataset_utils.h"
 #include "tensorflow/core/data/metric_utils.h"
 #include "tensorflow/core/data/root_dataset.h"
 #include "tensorflow/core/data/unbounded_thread_pool.h"
+#include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/cancellation.h"
 #include "tensorflow/core/framework/dataset.h"
 #include "tensorflow/core/framework/function.h"
@@ -97,6 +100,20 @@ class MultiDeviceIterator : public ResourceBase {
         function_handle_cache_(std::move(function_handle_cache)) {
     DCHECK(flr_ != nullptr);
     VLOG(2) << "Creating multi-device iterator.";
+    const DeviceMgr* device_mgr = flr_->device_mgr();
+    for (const string& device_name : devices_) {
+      Device* device = nullptr;
+      Allocator* staging_allocator = nullptr;
+      if (device_mgr != nullptr &&
+          device_mgr->LookupDevice(device_name, &device).ok() &&
+          device->device_type() == DEVICE_GPU) {
+        AllocatorAttributes attr;
+        attr.set_on_host(true);
+        attr.set_gpu_compatible(true);
+        staging_allocator = device->GetAllocator(attr);
+      }
+      staging_allocators_.push_back(staging_allocator);
+    }
   }
 
   ~MultiDeviceIterator() override {
@@ -134,6 +151,16 @@ class MultiDeviceIterator : public ResourceBase {
     return absl::OkStatus();
   }
 
+  // Moves the components of an element for the shard `shard_num` that are in
+  // pageable host memory to pinned memory close to the GPU of the shard. The
+  // copy to the GPU is then an asynchronous DMA, instead of staging the
+  // element when it is transferred.
+  void StageElement(int shard_num, std::vector<Tensor>* components) const {
+    Allocator* staging_allocator = staging_allocators_[shard_num];
+    if (staging_allocator == nullptr) return;
+    StagePageableComponents(staging_allocator, components);
+  }
+
   absl::Status GetNextFromShard(OpKernelContext* ctx, int shard_num,
                                 int64_t incarnation_id,
                                 MultiDeviceIteratorCallback callback) {
@@ -380,6 +407,8 @@ class MultiDeviceIterator : public ResourceBase {
 
         if (elem.status.ok() && elem.end_of_sequence) {
           end_of_iterator = true;
+        } else if (elem.status.ok()) {
+          parent_->StageElement(shard_to_fetch, &elem.value);
         }
 
         std::shared_ptr<HostBuffer::CallbackContainer> callback_container;
@@ -470,6 +499,9 @@ class MultiDeviceIterator : public ResourceBase {
   const DataTypeVector output_types_;
   const std::vector<PartialTensorShape> output_shapes_;
   const std::vector<string> devices_;
+  // The allocators of pinned host memory for the GPUs among `devices_`, or
+  // nullptr for the other devices.
+  std::vector<Allocator*> staging_allocators_;
   const std::unique_ptr<FunctionLibraryDefinition> flib_def_;
   FunctionLibraryRuntime* const flr_ = nullptr;  // not owned.
   const std::unique_ptr<ProcessFunctionLibraryRuntime> pflr_;
@@ -123,6 +123,10 @@ constexpr double kDefaultPerIteratorPrefetchFactor = 2.0L;
 // Period between reporting dataset statistics.
 constexpr int kStatsReportingPeriodMillis = 1000;
 
+// When enabled, a nondeterministic iterator whose current cycle is stalled
+// consumes results that future elements have already prefetched.
+constexpr char kElasticInterleaveCycle[] = "elastic_interleave_cycle";
+
 inline int64_t CeilDiv(int64_t numerator, int64_t denominator) {
   return (numerator + denominator - 1) / denominator;
 }
@@ -366,6 +370,8 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
               params.dataset->num_parallel_calls_, mu_,
               num_parallel_calls_cond_var_)),
           deterministic_(deterministic),
+          elastic_cycle_(!deterministic &&
+                         GetExperiments().contains(kElasticInterleaveCycle)),
           current_elements_(params.dataset->cycle_length_) {}
 
     ~ParallelInterleaveIterator() override { CancelThreads(/*wait=*/true); }
@@ -772,9 +778,56 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
         }
         AdvanceToNextInCycle();
       }
+      return elastic_cycle_ && ConsumeFutureResult(result);
+    }
+
+    // Consumes a result prefetched by a future element, returning whether one
+    // was available. This is used when every element of the current cycle is
+    // waiting on its input, e.g. on a cold remote file, so that elements whose
+    // files turned out to be fast can make progress in the meantime. Future
+    // elements drained this way are refilled by the future workers, and
+    // exhausted ones make room for new future elements, so the number of
+    // inputs being read grows while the cycle is stalled and falls back to
+    // `cycle_length` once it is not. Buffered results remain bounded by
+    // `prefetch_input_elements * buffer_output_elements`.
+    bool ConsumeFutureResult(std::shared_ptr<Result>* result)
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      for (auto it = future_elements_.begin(); it != future_elements_.end();
+           ++it) {
+        std::shared_ptr<Element>& element = *it;
+        if (element->results.empty()) {
+          continue;
+        }
+        std::swap(*result, element->results.front());
+        element->results.pop_front();
+        VLOG(3) << "Consumed a result of future element " << element->id;
+        if (element->results.empty() && !element->active &&
+            element->initialized && !element->iterator && !element->no_input) {
+          future_elements_.erase(it);
+        }
+        future_workers_cond_var_.notify_one();
+        return true;
+      }
       return false;
     }
 
+    // Returns a future element whose results were consumed by
+    // `ConsumeFutureResult` and which can produce more, or null if there is
+    // none.
+    std::shared_ptr<Element> FutureElementToRefill()
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      if (!elastic_cycle_) {
+        return nullptr;
+      }
+      for (const std::shared_ptr<Element>& element : future_elements_) {
+        if (!element->active && element->iterator &&
+            element->results.size() < dataset()->buffer_output_elements_) {
+          return element;
+        }
+      }
+      return nullptr;
+    }
+
     // Consumes a result (if available), returning an indication of whether
     // a result is available. If `true` is returned, `result` either
     // points to a valid result or is null if end of input has been reached.
@@ -1037,23 +1090,35 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
               current_workers_cond_var_.notify_one();
             }
           }
-          while (!cancelled_ && (future_elements_.size() >=
-                                     dataset()->prefetch_input_elements_ ||
-                                 wait_for_checkpoint_)) {
+          std::shared_ptr<Element> element_to_refill;
+          while (!cancelled_) {
+            if (!wait_for_checkpoint_) {
+              element_to_refill = FutureElementToRefill();
+              if (element_to_refill ||
+                  future_elements_.size() <
+                      dataset()->prefetch_input_elements_) {
+                break;
+              }
+            }
             WaitWorkerThread(ctx.get(), &future_workers_cond_var_, &l);
           }
           if (cancelled_) {
             done();
             return;
           }
-          element = MakeElement(ctx.get());
-          if (!element) {
-            done();
-            return;
+          if (element_to_refill) {
+            element = std::move(element_to_refill);
+            VLOG(3) << "Future worker refilling element " << element->id;
+          } else {
+            element = MakeElement(ctx.get());
+            if (!element) {
+              done();
+              return;
+            }
+            VLOG(3) << "Future worker created element " << element->id;
+            future_elements_.push_back(element);
           }
-          VLOG(3) << "Future worker created element " << element->id;
           element->active = true;
-          future_elements_.push_back(element);
         }
         ProcessElement(ctx.get(), element);
       }
@@ -1675,6 +1740,10 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
     // Determines whether outputs can be produced in deterministic order.
     const bool deterministic_;
 
+    // Whether a stalled cycle may consume results of future elements. Only
+    // set when `deterministic_` is false.
+    const bool elastic_cycle_;
+
     // Controls cancellation of `input_impl_`. Must be ordered before
     // `input_impl_` so that `input_impl_` is destroyed first.
     std::unique_ptr<CancellationManager> cancellation_manager_;
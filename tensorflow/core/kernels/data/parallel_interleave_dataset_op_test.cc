@@ -429,6 +429,31 @@ ParallelInterleaveDatasetParams LongCycleDeterministicParams() {
       /*node_name=*/kNodeName);
 }
 
+ParallelInterleaveDatasetParams ElasticCycleParams() {
+  auto tensor_slice_dataset_params = TensorSliceDatasetParams(
+      /*components=*/{CreateTensor<tstring>(
+          TensorShape{3, 3, 1}, {"a", "b", "c", "d", "e", "f", "g", "h", "i"})},
+      /*node_name=*/"tensor_slice");
+  return ParallelInterleaveDatasetParams(
+      tensor_slice_dataset_params,
+      /*other_arguments=*/{},
+      /*cycle_length=*/1,
+      /*block_length=*/1,
+      /*buffer_output_elements=*/1,
+      /*prefetch_input_elements=*/2,
+      /*num_parallel_calls=*/1,
+      /*func=*/
+      MakeTensorSliceDatasetFunc(
+          DataTypeVector({DT_STRING}),
+          std::vector<PartialTensorShape>({PartialTensorShape({1})})),
+      /*func_lib=*/{test::function::MakeTensorSliceDataset()},
+      /*type_arguments=*/{},
+      /*output_dtypes=*/{DT_STRING},
+      /*output_shapes=*/{PartialTensorShape({1})},
+      /*deterministic=*/DeterminismPolicy::kNondeterministic,
+      /*node_name=*/kNodeName);
+}
+
 ParallelInterleaveDatasetParams
 ParallelInterleaveDatasetParamsWithInvalidCycleLength() {
   auto tensor_slice_dataset_params = TensorSliceDatasetParams(
@@ -729,6 +754,25 @@ TEST_F(ParallelInterleaveDatasetOpTest, InputCycleLengthPreservedInGraphDef) {
   unsetenv("TF_DATA_EXPERIMENT_OPT_IN");
 }
 
+// Test that consuming results of future elements when the cycle is stalled
+// still produces every element exactly once.
+TEST_F(ParallelInterleaveDatasetOpTest, ElasticCycle) {
+  setenv("TF_JOB_NAME", "test_job", /*overwrite=*/1);
+  setenv("TF_TASK_ID", "0", /*overwrite=*/1);
+  setenv("TF_DATA_EXPERIMENT_OPT_IN", "elastic_interleave_cycle",
+         /*overwrite=*/1);
+  auto dataset_params = ElasticCycleParams();
+  TF_ASSERT_OK(Initialize(dataset_params));
+  TF_EXPECT_OK(CheckIteratorGetNext(
+      CreateTensors<tstring>(
+          TensorShape{1},
+          {{"a"}, {"b"}, {"c"}, {"d"}, {"e"}, {"f"}, {"g"}, {"h"}, {"i"}}),
+      /*compare_order=*/false));
+  unsetenv("TF_JOB_NAME");
+  unsetenv("TF_TASK_ID");
+  unsetenv("TF_DATA_EXPERIMENT_OPT_IN");
+}
+
 TEST_F(ParallelInterleaveDatasetOpTest, DatasetNodeName) {
   auto dataset_params = ParallelInterleaveDatasetParams1();
   TF_ASSERT_OK(Initialize(dataset_params));
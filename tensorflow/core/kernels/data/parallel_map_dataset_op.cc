@@ -536,10 +536,17 @@ class ParallelMapDatasetOp::Dataset : public DatasetBase {
     void CallCompleted(const std::shared_ptr<IteratorContext>& ctx,
                        const std::shared_ptr<InvocationResult>& result)
         TF_LOCKS_EXCLUDED(*mu_) {
-      mutex_lock l(*mu_);
-      num_calls_--;
-      result->notification.Notify();
-      cond_var_->notify_all();
+      // The iterator may be destroyed as soon as `num_calls_` reaches zero and
+      // `mu_` is released, so hold on to the condition variable.
+      std::shared_ptr<condition_variable> cond_var = cond_var_;
+      {
+        mutex_lock l(*mu_);
+        num_calls_--;
+        result->notification.Notify();
+      }
+      // Notify outside of the critical section, so that the woken threads do
+      // not immediately block on `mu_` held by this thread.
+      cond_var->notify_all();
     }
 
     void CallFunction(const std::shared_ptr<IteratorContext>& ctx,
@@ -670,8 +677,10 @@ class ParallelMapDatasetOp::Dataset : public DatasetBase {
             new_calls.push_back(invocation_results_.back());
             num_calls_++;
           }
-          cond_var_->notify_all();
         }
+        // The runner thread is joined before the iterator is destroyed, so it
+        // is safe to notify outside of the critical section.
+        cond_var_->notify_all();
         for (const auto& call : new_calls) {
           CallFunction(ctx, call);
         }
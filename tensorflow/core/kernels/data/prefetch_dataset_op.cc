@@ -218,7 +218,9 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
             buffer_size_->value = auto_tuner_->buffer_limit();
           }
           RecordStop(ctx);
+          ++num_waiting_consumers_;
           cond_var_->wait(l);
+          --num_waiting_consumers_;
           RecordStart(ctx);
         }
 
@@ -488,11 +490,11 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
       *end_of_sequence = false;
 
       // Wake the prefetch thread, in case it has been waiting for space
-      // in the buffer. Also wake up threads from other calls to GetNext.
-      //
-      // TODO(mrry): Consider using different condition variables for
-      // GetNext and Prefetch.
-      cond_var_->notify_all();
+      // in the buffer. Consuming an element cannot unblock other calls to
+      // GetNext, so there is nobody to wake otherwise.
+      if (prefetch_thread_waiting_) {
+        cond_var_->notify_all();
+      }
       return s;
     }
 
@@ -521,7 +523,9 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
           mutex_lock l(*mu_);
           while (!cancelled_ && buffer_.size() >= buffer_limit()) {
             RecordStop(ctx.get());
+            prefetch_thread_waiting_ = true;
             cond_var_->wait(l);
+            prefetch_thread_waiting_ = false;
             RecordStart(ctx.get());
           }
 
@@ -572,7 +576,11 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
           RecordBufferEnqueue(ctx.get(), buffer_element.value);
           buffer_element.created_us = EnvTime::NowMicros();
           buffer_.push_back(std::move(buffer_element));
-          cond_var_->notify_all();
+          // A single new element can satisfy at most one waiting GetNext
+          // call, and the prefetch thread is the only other waiter.
+          if (num_waiting_consumers_ > 0) {
+            cond_var_->notify_one();
+          }
         }
         ++num_produced;
       }
@@ -637,6 +645,11 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
     std::deque<BufferElement> buffer_ TF_GUARDED_BY(*mu_);
     bool cancelled_ TF_GUARDED_BY(*mu_) = false;
     bool prefetch_thread_finished_ TF_GUARDED_BY(*mu_) = false;
+    // Whether the prefetch thread is waiting for space in `buffer_`.
+    bool prefetch_thread_waiting_ TF_GUARDED_BY(*mu_) = false;
+    // The number of GetNext calls waiting for an element in `buffer_`. Used
+    // to avoid waking up threads that have nothing to consume.
+    int64_t num_waiting_consumers_ TF_GUARDED_BY(*mu_) = 0;
     const bool legacy_autotune_;
 
     std::atomic<int64_t> slack_us_;
@@ -12,7 +12,13 @@ limitations under the License.
 
 #include "tensorflow/core/kernels/data/prefetch_dataset_op.h"
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 #include "tensorflow/core/data/dataset_test_base.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/threadpool.h"
 
 namespace tensorflow {
 namespace data {
@@ -326,6 +332,47 @@ IteratorSaveAndRestoreTestCases() {
 ITERATOR_SAVE_AND_RESTORE_TEST_P(PrefetchDatasetOpTest, PrefetchDatasetParams,
                                  IteratorSaveAndRestoreTestCases())
 
+TEST_F(PrefetchDatasetOpTest, ConcurrentGetNext) {
+  constexpr int kNumElements = 1000;
+  constexpr int kNumConsumers = 8;
+  std::vector<int64_t> values(kNumElements);
+  std::iota(values.begin(), values.end(), 0);
+  auto tensor_slice_dataset_params = TensorSliceDatasetParams(
+      /*components=*/{CreateTensor<int64_t>(TensorShape{kNumElements}, values)},
+      /*node_name=*/"tensor_slice");
+  auto dataset_params = PrefetchDatasetParams(
+      /*input_dataset_params=*/tensor_slice_dataset_params,
+      /*buffer_size=*/2,
+      /*output_dtypes=*/{DT_INT64},
+      /*output_shapes=*/{PartialTensorShape({})},
+      /*slack_period=*/0,
+      /*legacy_autotune=*/false,
+      /*buffer_size_min=*/0,
+      /*node_name=*/kNodeName);
+  TF_ASSERT_OK(Initialize(dataset_params));
+
+  mutex mu;
+  std::vector<int64_t> produced;
+  {
+    thread::ThreadPool pool(Env::Default(), "consumers", kNumConsumers);
+    for (int i = 0; i < kNumConsumers; ++i) {
+      pool.Schedule([this, &mu, &produced]() {
+        while (true) {
+          std::vector<Tensor> next;
+          bool end_of_sequence = false;
+          TF_EXPECT_OK(iterator_->GetNext(iterator_ctx_.get(), &next,
+                                          &end_of_sequence));
+          if (end_of_sequence) return;
+          mutex_lock l(mu);
+          produced.push_back(next[0].scalar<int64_t>()());
+        }
+      });
+    }
+  }
+  std::sort(produced.begin(), produced.end());
+  EXPECT_EQ(produced, values);
+}
+
 TEST_F(PrefetchDatasetOpTest, InvalidBufferSize) {
   auto dataset_params = InvalidBufferSizePrefetchDatasetParams();
   EXPECT_EQ(Initialize(dataset_params).code(), error::INVALID_ARGUMENT);
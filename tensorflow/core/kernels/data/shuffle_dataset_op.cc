@@ -14,6 +14,8 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/kernels/data/shuffle_dataset_op.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <deque>
 #include <memory>
@@ -39,6 +41,7 @@ limitations under the License.
 #include "tensorflow/core/lib/random/random_distributions.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/stringprintf.h"
+#include "tensorflow/core/platform/threadpool.h"
 
 namespace tensorflow {
 namespace data {
@@ -63,6 +66,9 @@ namespace data {
 
 const int64_t kLogIntervalMicros = 10 * 1000000;  // 10 seconds.
 const int64_t kMaxEpochsInBuffer = 3;
+// The minimum number of free buffer slots for which the buffer is filled by
+// concurrent calls to the input iterator, when determinism is not required.
+const int64_t kMinElementsForParallelFill = 1024;
 
 constexpr char kNumRandomSamples[] = "num_random_samples";
 constexpr char kDataProduced[] = "data_produced";
@@ -206,6 +212,15 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
       mutex_lock l(mu_);
       seed_generator_->GenerateSeeds(&seed_, &seed2_);
       ResetRngs();
+      // The order in which elements enter the buffer only matters for
+      // reproducibility, so the fill may be done out of order if the user
+      // opted out of determinism.
+      const Options* options = ctx->options();
+      parallel_fill_ = options != nullptr &&
+                       options->optional_deterministic_case() ==
+                           Options::kDeterministic &&
+                       !options->deterministic() &&
+                       ctx->runner_threadpool_size() > 1;
       // Initialize checkpoint_indices_ to the entire buffer.
       if (ctx->symbolic_checkpoint()) {
         for (int64_t i = 0; i < buffer_->size(); ++i) {
@@ -457,17 +472,24 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
         if (!input_impl_) {
           TF_RETURN_IF_ERROR(PrepareNextEpoch(ctx));
         }
-        std::vector<Tensor> input_element;
         bool end_of_input_sequence = false;
-        TF_RETURN_IF_ERROR(
-            input_impl_->GetNext(ctx, &input_element, &end_of_input_sequence));
-        if (end_of_input_sequence) {
-          slices_.back()->reached_end_of_sequence = true;
+        const int64_t num_free_slots = buffer_->size() - num_elements_;
+        if (parallel_fill_ && !IsShuffleAll() &&
+            num_free_slots >= kMinElementsForParallelFill) {
+          TF_RETURN_IF_ERROR(FillBufferInParallel(ctx, num_free_slots,
+                                                  &end_of_input_sequence));
+        } else {
+          std::vector<Tensor> input_element;
+          TF_RETURN_IF_ERROR(input_impl_->GetNext(ctx, &input_element,
+                                                  &end_of_input_sequence));
+          if (!end_of_input_sequence) {
+            AddToShuffleBuffer(ctx, std::move(input_element));
+          }
         }
         if (!end_of_input_sequence) {
-          AddToShuffleBuffer(ctx, std::move(input_element));
           continue;
         }
+        slices_.back()->reached_end_of_sequence = true;
         input_impl_.reset();
         // Reached end of input_impl_.
         if (ctx->split_providers().empty() && !data_produced_ &&
@@ -484,6 +506,56 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
       return absl::OkStatus();
     }
 
+    // Requests up to `num_elements` elements from the input iterator using
+    // concurrent `GetNext()` calls and adds them to the buffer. This lets
+    // inputs that do not serialize `GetNext()` (e.g. a sequential `map`) fill
+    // a large buffer in parallel.
+    // Memory stays bounded by the buffer size since no more elements are
+    // requested than there are free slots.
+    absl::Status FillBufferInParallel(IteratorContext* ctx,
+                                      int64_t num_elements,
+                                      bool* end_of_input_sequence)
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      IteratorBase* const input = input_impl_.get();
+      const int64_t num_threads = std::min<int64_t>(
+          ctx->runner_threadpool_size(), num_elements);
+      std::atomic<int64_t> num_requested(0);
+      std::atomic<bool> done(false);
+      std::vector<std::vector<std::vector<Tensor>>> elements(num_threads);
+      std::vector<absl::Status> statuses(num_threads);
+      {
+        // Use dedicated threads rather than `ctx->runner()`, since the input
+        // may itself block on work scheduled through the runner.
+        thread::ThreadPool pool(ctx->env(), ThreadOptions(),
+                                "tf_data_shuffle_fill", num_threads);
+        for (int64_t i = 0; i < num_threads; ++i) {
+          pool.Schedule([ctx, input, num_elements, i, &num_requested, &done,
+                         &elements, &statuses]() {
+            while (!done && num_requested.fetch_add(1) < num_elements) {
+              std::vector<Tensor> element;
+              bool end_of_sequence = false;
+              statuses[i] = input->GetNext(ctx, &element, &end_of_sequence);
+              if (!statuses[i].ok() || end_of_sequence) {
+                done = true;
+                break;
+              }
+              elements[i].push_back(std::move(element));
+            }
+          });
+        }
+      }
+      absl::Status status;
+      for (int64_t i = 0; i < num_threads; ++i) {
+        for (auto& element : elements[i]) {
+          AddToShuffleBuffer(ctx, std::move(element));
+        }
+        status.Update(statuses[i]);
+      }
+      TF_RETURN_IF_ERROR(status);
+      *end_of_input_sequence = done;
+      return absl::OkStatus();
+    }
+
     bool ShouldFillBuffer() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
       if (!input_impl_ && dataset()->count_ != -1 &&
           epoch_ >= dataset()->count_) {
@@ -581,6 +653,8 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
         TF_GUARDED_BY(mu_);
     int64_t num_random_samples_ TF_GUARDED_BY(mu_) = 0;
     bool data_produced_ TF_GUARDED_BY(mu_) = false;
+    // Whether the buffer may be filled by concurrent calls to the input.
+    bool parallel_fill_ TF_GUARDED_BY(mu_) = false;
   };
 
   const DatasetBase* const input_;
@@ -11,8 +11,10 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/kernels/data/shuffle_dataset_op.h"
 
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "tensorflow/core/data/dataset_test_base.h"
 #include "tensorflow/core/data/dataset_utils.h"
@@ -594,6 +596,45 @@ TEST_F(ShuffleDatasetOpTest, InvalidArguments) {
   }
 }
 
+TEST_F(ShuffleDatasetOpTest, NondeterministicParallelFill) {
+  auto dataset_params = ShuffleDatasetParams(
+      RangeDatasetParams(0, 3000, 1),
+      /*buffer_size=*/2048,
+      /*seed=*/1,
+      /*seed2=*/2,
+      /*count=*/2,
+      /*reshuffle_each_iteration=*/true,
+      /*output_dtypes=*/{DT_INT64},
+      /*output_shapes=*/{PartialTensorShape({})},
+      /*node_name=*/kShuffleAndRepeatNodeName);
+  TF_ASSERT_OK(Initialize(dataset_params));
+  Options options;
+  options.set_deterministic(false);
+  IteratorContext::Params params(iterator_ctx_.get());
+  params.options = &options;
+  params.runner_threadpool_size = 4;
+  auto iterator_ctx = std::make_unique<IteratorContext>(params);
+  std::unique_ptr<IteratorBase> iterator;
+  TF_ASSERT_OK(dataset_->MakeIterator(iterator_ctx.get(), /*parent=*/nullptr,
+                                      dataset_params.iterator_prefix(),
+                                      &iterator));
+
+  std::vector<int64_t> counts(3000, 0);
+  bool end_of_sequence = false;
+  while (true) {
+    std::vector<Tensor> next;
+    TF_ASSERT_OK(
+        iterator->GetNext(iterator_ctx.get(), &next, &end_of_sequence));
+    if (end_of_sequence) break;
+    ASSERT_EQ(next.size(), 1);
+    counts[next[0].scalar<int64_t>()()]++;
+  }
+  // Every element of both epochs is produced exactly once.
+  for (int64_t count : counts) {
+    EXPECT_EQ(count, 2);
+  }
+}
+
 }  // namespace
 }  // namespace data
 }  // namespace tensorflow
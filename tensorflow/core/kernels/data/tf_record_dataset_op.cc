@@ -14,10 +14,18 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/kernels/data/tf_record_dataset_op.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdlib>
+#include <memory>
+#include <utility>
+#include <vector>
 
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "tensorflow/core/data/global_shuffle_utils.h"
 #include "tensorflow/core/data/name_utils.h"
+#include "tensorflow/core/data/tfrecord_index.h"
 #include "tensorflow/core/data/utils.h"
 #include "tensorflow/core/framework/metrics.h"
 #include "tensorflow/core/framework/partial_tensor_shape.h"
@@ -28,8 +36,11 @@ limitations under the License.
 #include "tensorflow/core/lib/io/record_reader.h"
 #include "tensorflow/core/lib/io/zlib_compression_options.h"
 #include "tensorflow/core/lib/io/zlib_inputstream.h"
+#include "tensorflow/core/platform/file_system.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/protobuf.h"
+#include "tensorflow/core/util/env_var.h"
+#include "tsl/platform/statusor.h"
 #include "tsl/profiler/lib/traceme.h"
 
 namespace tensorflow {
@@ -63,6 +74,8 @@ constexpr int64_t kDefaultBufferSize = 256LL << 10;  // 256KB
 constexpr int64_t kCloudTpuBlockSize = 127LL << 20;  // 127MB.
 constexpr int64_t kS3BlockSize = kCloudTpuBlockSize;
 constexpr char kEnableMFPhase2[] = "ENABLE_MF_PHASE_2";
+constexpr char kUseMmap[] = "TF_DATA_TFRECORD_USE_MMAP";
+constexpr char kUseIndex[] = "TF_DATA_TFRECORD_USE_INDEX";
 
 constexpr int kContextFeatureFieldNumber = 1;
 constexpr int kDocumentFeatureFieldNumber = 2;
@@ -82,6 +95,36 @@ struct BufferView {
   size_t size;
 };
 
+// A `RandomAccessFile` over a memory-mapped file. Reads return views into the
+// mapping, so the record reader copies each record straight from the page
+// cache into its `tstring` instead of going through a read syscall and an
+// intermediate buffer.
+class MemmappedRandomAccessFile : public RandomAccessFile {
+ public:
+  explicit MemmappedRandomAccessFile(
+      std::unique_ptr<ReadOnlyMemoryRegion> region)
+      : region_(std::move(region)) {}
+
+  absl::Status Read(uint64 offset, size_t n, absl::string_view* result,
+                    char* scratch) const override {
+    const uint64 length = region_->length();
+    if (offset >= length) {
+      *result = absl::string_view();
+      return errors::OutOfRange("Read after file end");
+    }
+    const size_t available = std::min<uint64>(n, length - offset);
+    *result = absl::string_view(
+        static_cast<const char*>(region_->data()) + offset, available);
+    if (available < n) {
+      return errors::OutOfRange("Read less bytes than requested");
+    }
+    return absl::OkStatus();
+  }
+
+ private:
+  const std::unique_ptr<ReadOnlyMemoryRegion> region_;
+};
+
 absl::Status parse(const tstring& tensor, std::deque<tstring>* records) {
   std::unique_ptr<ZeroCopyInputStream> raw_input =
       absl::make_unique<ArrayInputStream>(tensor.c_str(), tensor.size());
@@ -165,17 +208,26 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
  public:
   explicit Dataset(OpKernelContext* ctx, std::vector<string> filenames,
                    const string& compression_type, int64_t buffer_size,
-                   std::vector<int64_t> byte_offsets, int op_version)
+                   std::vector<int64_t> byte_offsets,
+                   std::vector<std::unique_ptr<TFRecordIndexReader>>
+                       index_readers,
+                   std::vector<int64_t> cumulative_num_records, int op_version)
       : DatasetBase(DatasetContext(ctx)),
+        env_(ctx->env()),
         filenames_(std::move(filenames)),
         compression_type_(compression_type),
         options_(io::RecordReaderOptions::CreateRecordReaderOptions(
             compression_type)),
         byte_offsets_(std::move(byte_offsets)),
+        index_readers_(std::move(index_readers)),
+        cumulative_num_records_(std::move(cumulative_num_records)),
         op_version_(op_version) {
     if (buffer_size > 0) {
       options_.buffer_size = buffer_size;
     }
+    if (!index_readers_.empty()) {
+      files_.resize(filenames_.size());
+    }
   }
 
   std::unique_ptr<IteratorBase> MakeIteratorInternal(
@@ -210,6 +262,55 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
 
   absl::Status CheckExternalState() const override { return absl::OkStatus(); }
 
+  int64_t CardinalityInternal(CardinalityOptions options) const override {
+    if (cumulative_num_records_.empty()) return kUnknownCardinality;
+    return cumulative_num_records_.back();
+  }
+
+  absl::Status RandomIndexingCompatible() const override {
+    if (cumulative_num_records_.empty()) {
+      return absl::FailedPreconditionError(absl::StrCat(
+          type_string(),
+          " only supports random access for uncompressed files with index "
+          "files when ",
+          kUseIndex, " is set."));
+    }
+    return absl::OkStatus();
+  }
+
+  absl::Status Get(OpKernelContext* ctx, int64 index,
+                   std::vector<Tensor>* out_tensors) const override {
+    return Get(AnyContext(ctx), index, out_tensors);
+  }
+
+  // Reads the record at `index` by looking up its offset in the index of the
+  // file that contains it, so that only that record is read.
+  absl::Status Get(AnyContext ctx, int64 index,
+                   std::vector<Tensor>* out_tensors) const override {
+    TF_RETURN_IF_ERROR(CheckRandomAccessCompatible(index));
+    const size_t file_index =
+        std::upper_bound(cumulative_num_records_.begin(),
+                         cumulative_num_records_.end(), index) -
+        cumulative_num_records_.begin();
+    const int64_t record_index =
+        index - (file_index == 0 ? 0 : cumulative_num_records_[file_index - 1]);
+    TF_ASSIGN_OR_RETURN(uint64 offset,
+                        index_readers_[file_index]->GetOffset(record_index));
+    TF_ASSIGN_OR_RETURN(RandomAccessFile * file, GetFile(file_index));
+    io::RecordReaderOptions options = options_;
+    // Only one record is read, so buffering would read unrelated bytes.
+    options.buffer_size = 0;
+    io::RecordReader reader(file, options);
+    out_tensors->clear();
+    out_tensors->emplace_back(ctx.allocator, DT_STRING, TensorShape({}));
+    TF_RETURN_IF_ERROR(
+        reader.ReadRecord(&offset, &out_tensors->back().scalar<tstring>()()));
+    static monitoring::CounterCell* bytes_counter =
+        metrics::GetTFDataBytesReadCounter(kDatasetType);
+    bytes_counter->IncrementBy(out_tensors->back().scalar<tstring>()().size());
+    return absl::OkStatus();
+  }
+
  protected:
   absl::Status AsGraphDefInternal(SerializationContext* ctx,
                                   DatasetGraphDefBuilder* b,
@@ -230,9 +331,15 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
  private:
   class Iterator : public DatasetIterator<Dataset> {
    public:
-    explicit Iterator(const Params& params) : DatasetIterator<Dataset>(params) {
+    explicit Iterator(const Params& params)
+        : DatasetIterator<Dataset>(params),
+          global_shuffle_iterator_(dataset()) {
       const char* enable_mf_phase2 = std::getenv(kEnableMFPhase2);
       enable_mf_phase2_ = (enable_mf_phase2 != nullptr);
+      absl::Status s = ReadBoolFromEnvVar(kUseMmap, false, &use_mmap_);
+      if (!s.ok()) {
+        LOG(ERROR) << s;
+      }
     }
 
     bool SymbolicCheckpointCompatible() const override { return true; }
@@ -240,6 +347,10 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
     absl::Status GetNextInternal(IteratorContext* ctx,
                                  std::vector<Tensor>* out_tensors,
                                  bool* end_of_sequence) override {
+      if (ctx->index_mapper() != nullptr) {
+        return global_shuffle_iterator_.GetNext(ctx, out_tensors,
+                                                end_of_sequence);
+      }
       out_tensors->reserve(1);
       mutex_lock l(mu_);
       do {
@@ -360,11 +471,15 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
         TF_RETURN_IF_ERROR(
             writer->WriteScalar(prefix(), kOffset, reader_->TellOffset()));
       }
+      TF_RETURN_IF_ERROR(global_shuffle_iterator_.Save(prefix(), ctx, writer));
       return absl::OkStatus();
     }
 
     absl::Status RestoreInternal(IteratorContext* ctx,
                                  IteratorStateReader* reader) override {
+      if (ctx->restored_element_count().has_value()) {
+        return global_shuffle_iterator_.Restore(prefix(), ctx, reader);
+      }
       mutex_lock l(mu_);
       ResetStreamsLocked();
       int64_t current_file_index;
@@ -398,11 +513,28 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
           },
           tsl::profiler::kInfo);
 
-      TF_RETURN_IF_ERROR(env->NewRandomAccessFile(
-          TranslateFileName(dataset()->filenames_[current_file_index_]),
-          &file_));
-      reader_ = std::make_unique<io::SequentialRecordReader>(
-          file_.get(), dataset()->options_);
+      const string filename =
+          TranslateFileName(dataset()->filenames_[current_file_index_]);
+      io::RecordReaderOptions options = dataset()->options_;
+      if (use_mmap_ &&
+          options.compression_type == io::RecordReaderOptions::NONE) {
+        std::unique_ptr<ReadOnlyMemoryRegion> region;
+        absl::Status s = env->NewReadOnlyMemoryRegionFromFile(filename, &region);
+        if (s.ok()) {
+          file_ = std::make_unique<MemmappedRandomAccessFile>(std::move(region));
+          // The mapping already serves as the read buffer.
+          options.buffer_size = 0;
+        } else {
+          // Not every file system supports mapping (and empty files cannot be
+          // mapped), so fall back to regular reads.
+          VLOG(2) << "Failed to memory-map " << filename << ": " << s;
+        }
+      }
+      if (!file_) {
+        TF_RETURN_IF_ERROR(env->NewRandomAccessFile(filename, &file_));
+      }
+      reader_ =
+          std::make_unique<io::SequentialRecordReader>(file_.get(), options);
       if (!dataset()->byte_offsets_.empty()) {
         TF_RETURN_IF_ERROR(
             reader_->SeekOffset(dataset()->byte_offsets_[current_file_index_]));
@@ -424,16 +556,72 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
     std::unique_ptr<RandomAccessFile> file_ TF_GUARDED_BY(mu_);
     std::unique_ptr<io::SequentialRecordReader> reader_ TF_GUARDED_BY(mu_);
     bool enable_mf_phase2_;
+    // Whether uncompressed files are memory-mapped rather than read through a
+    // buffered stream.
+    bool use_mmap_ = false;
     std::deque<tstring> buffered_records_;
+    GlobalShuffleIterator global_shuffle_iterator_;
   };
 
+  // Returns the file at `file_index`, which is opened on first use and then
+  // kept open for the following calls to `Get`.
+  absl::StatusOr<RandomAccessFile*> GetFile(size_t file_index) const {
+    mutex_lock l(files_mu_);
+    if (files_[file_index] == nullptr) {
+      TF_RETURN_IF_ERROR(env_->NewRandomAccessFile(
+          TranslateFileName(filenames_[file_index]), &files_[file_index]));
+    }
+    return files_[file_index].get();
+  }
+
+  Env* const env_;
   const std::vector<string> filenames_;
   const tstring compression_type_;
   io::RecordReaderOptions options_;
   const std::vector<int64_t> byte_offsets_;
+  // When every file has an index, the open index of each file. Empty
+  // otherwise.
+  const std::vector<std::unique_ptr<TFRecordIndexReader>> index_readers_;
+  // When every file has an index, the running totals of their numbers of
+  // records, which map a global record index to a file. Empty otherwise.
+  const std::vector<int64_t> cumulative_num_records_;
   const int op_version_;
+  mutable mutex files_mu_;
+  // The files read by `Get`, or nullptr for files not read yet.
+  mutable std::vector<std::unique_ptr<RandomAccessFile>> files_
+      TF_GUARDED_BY(files_mu_);
 };
 
+// Opens the index files of `filenames` into `index_readers`, and sets
+// `cumulative_num_records` to the running totals of their numbers of records.
+// Leaves both empty if some file has no valid index.
+void OpenIndices(
+    Env* env, const std::vector<string>& filenames,
+    std::vector<std::unique_ptr<TFRecordIndexReader>>* index_readers,
+    std::vector<int64_t>* cumulative_num_records) {
+  index_readers->reserve(filenames.size());
+  cumulative_num_records->reserve(filenames.size());
+  int64_t total = 0;
+  for (const string& filename : filenames) {
+    const std::string index_filename =
+        TFRecordIndexFilename(TranslateFileName(filename));
+    absl::StatusOr<std::unique_ptr<TFRecordIndexReader>> index_reader =
+        TFRecordIndexReader::Create(env, index_filename);
+    if (!index_reader.ok()) {
+      LOG_FIRST_N(WARNING, 1)
+          << "Random access is disabled for TFRecordDataset because "
+          << "reading " << index_filename
+          << " failed: " << index_reader.status();
+      index_readers->clear();
+      cumulative_num_records->clear();
+      return;
+    }
+    total += (*index_reader)->num_records();
+    cumulative_num_records->push_back(total);
+    index_readers->push_back(*std::move(index_reader));
+  }
+}
+
 TFRecordDatasetOp::TFRecordDatasetOp(OpKernelConstruction* ctx)
     : DatasetOpKernel(ctx),
       op_version_(ctx->def().op() == kTFRecordDataset ? 1 : 2) {}
@@ -514,8 +702,22 @@ void TFRecordDatasetOp::MakeDataset(OpKernelContext* ctx,
         << buffer_size;
   }
 
+  std::vector<std::unique_ptr<TFRecordIndexReader>> index_readers;
+  std::vector<int64_t> cumulative_num_records;
+  bool use_index = false;
+  OP_REQUIRES_OK(ctx, ReadBoolFromEnvVar(kUseIndex, false, &use_index));
+  if (use_index && std::getenv(kEnableMFPhase2) == nullptr &&
+      byte_offsets.empty() &&
+      io::RecordReaderOptions::CreateRecordReaderOptions(compression_type)
+              .compression_type == io::RecordReaderOptions::NONE) {
+    OpenIndices(ctx->env(), filenames, &index_readers,
+                &cumulative_num_records);
+  }
+
   *output = new Dataset(ctx, std::move(filenames), compression_type,
-                        buffer_size, std::move(byte_offsets), op_version_);
+                        buffer_size, std::move(byte_offsets),
+                        std::move(index_readers),
+                        std::move(cumulative_num_records), op_version_);
 }
 
 namespace {
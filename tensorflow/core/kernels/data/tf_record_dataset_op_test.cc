@@ -11,8 +11,10 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/kernels/data/tf_record_dataset_op.h"
 
+#include <cstdlib>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include "absl/log/log.h"
@@ -23,6 +25,7 @@ limitations under the License.
 #include "xla/tsl/lib/core/status_test_util.h"
 #include "tensorflow/core/data/dataset_test_base.h"
 #include "tensorflow/core/data/name_utils.h"
+#include "tensorflow/core/data/tfrecord_index.h"
 #include "tensorflow/core/example/example.pb.h"
 #include "tensorflow/core/framework/dataset.h"
 #include "tensorflow/core/framework/tensor.h"
@@ -373,6 +376,62 @@ TEST_F(TFRecordDatasetOpTest, IteratorPrefix) {
       iterator_prefix_params)));
 }
 
+TEST_F(TFRecordDatasetOpTest, ReadWithMmap) {
+  setenv("TF_DATA_TFRECORD_USE_MMAP", "1", /*overwrite=*/1);
+  auto dataset_params = TFRecordDatasetParams4();
+  TF_ASSERT_OK(Initialize(dataset_params));
+  unsetenv("TF_DATA_TFRECORD_USE_MMAP");
+  bool end_of_sequence = false;
+  std::vector<Tensor> out_tensors;
+  while (!end_of_sequence) {
+    TF_ASSERT_OK(
+        iterator_->GetNext(iterator_ctx_.get(), &out_tensors, &end_of_sequence));
+  }
+  TF_EXPECT_OK(ExpectEqual(
+      out_tensors,
+      CreateTensors<tstring>(TensorShape({}), {{"1"}, {"22"}, {"333"}, {"bb"},
+                                               {"ccc"}, {"zzz"}}),
+      /*compare_order=*/true));
+}
+
+TEST_F(TFRecordDatasetOpTest, RandomAccessWithIndex) {
+  auto dataset_params = TFRecordDatasetParams3();
+  for (const auto& filename : {"tf_record_UNCOMPRESSED_1",
+                               "tf_record_UNCOMPRESSED_2"}) {
+    TF_ASSERT_OK(BuildTFRecordIndex(
+        Env::Default(), absl::StrCat(testing::TmpDir(), "/", filename)));
+  }
+  setenv("TF_DATA_TFRECORD_USE_INDEX", "1", /*overwrite=*/1);
+  TF_ASSERT_OK(Initialize(dataset_params));
+  unsetenv("TF_DATA_TFRECORD_USE_INDEX");
+  TF_ASSERT_OK(CheckDatasetCardinality(6));
+  TF_ASSERT_OK(dataset_->RandomIndexingCompatible());
+  // The dataset keeps the indices open, so it does not read them again.
+  for (const auto& filename : {"tf_record_UNCOMPRESSED_1",
+                               "tf_record_UNCOMPRESSED_2"}) {
+    TF_ASSERT_OK(Env::Default()->DeleteFile(TFRecordIndexFilename(
+        absl::StrCat(testing::TmpDir(), "/", filename))));
+  }
+  const std::vector<tstring> expected = {"1", "22", "333", "a", "bb", "ccc"};
+  for (int64_t i : {4, 0, 5, 2, 3, 1}) {
+    std::vector<Tensor> out_tensors;
+    TF_ASSERT_OK(dataset_->Get(dataset_ctx_.get(), i, &out_tensors));
+    ASSERT_EQ(out_tensors.size(), 1);
+    EXPECT_EQ(out_tensors[0].scalar<tstring>()(), expected[i]);
+  }
+  std::vector<Tensor> out_tensors;
+  EXPECT_FALSE(dataset_->Get(dataset_ctx_.get(), 6, &out_tensors).ok());
+}
+
+TEST_F(TFRecordDatasetOpTest, NoRandomAccessWithoutIndex) {
+  auto dataset_params = TFRecordDatasetParams1();
+  setenv("TF_DATA_TFRECORD_USE_INDEX", "1", /*overwrite=*/1);
+  TF_ASSERT_OK(Initialize(dataset_params));
+  unsetenv("TF_DATA_TFRECORD_USE_INDEX");
+  TF_ASSERT_OK(CheckDatasetCardinality(kUnknownCardinality));
+  EXPECT_FALSE(dataset_->RandomIndexingCompatible().ok());
+}
+
 TEST_F(TFRecordDatasetOpTest, InvalidByteOffsetsToSeek) {
   auto dataset_params = InvalidByteOffsets();
   TF_ASSERT_OK(Initialize(dataset_params));
@@ -0,0 +1,286 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/types/span.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/resource_mgr.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/kernels/dynamic_embedding_table.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/mutex.h"
+
+namespace tensorflow {
+namespace {
+
+absl::Span<const int64_t> Ids(const Tensor& ids) {
+  return absl::MakeConstSpan(ids.flat<int64_t>().data(), ids.NumElements());
+}
+
+absl::Span<const float> Floats(const Tensor& t) {
+  return absl::MakeConstSpan(t.flat<float>().data(), t.NumElements());
+}
+
+// Checks that `values` has a row of the table's dimension per id.
+absl::Status CheckRows(const DynamicEmbeddingTable& table, const Tensor& ids,
+                       const Tensor& values, const char* values_name) {
+  if (!TensorShapeUtils::IsVector(ids.shape())) {
+    return errors::InvalidArgument("ids must be a vector, got shape ",
+                                   ids.shape().DebugString());
+  }
+  if (!TensorShapeUtils::IsMatrix(values.shape()) ||
+      values.dim_size(0) != ids.dim_size(0) ||
+      values.dim_size(1) != table.options().dim) {
+    return errors::InvalidArgument(
+        values_name, " must have shape [", ids.dim_size(0), ", ",
+        table.options().dim, "], got ", values.shape().DebugString());
+  }
+  return absl::OkStatus();
+}
+
+// Checks that the `dim` attribute of the op matches the table, since it gives
+// the static shape of the op's output.
+absl::Status CheckDim(const DynamicEmbeddingTable& table, int64_t dim) {
+  if (dim != table.options().dim) {
+    return errors::InvalidArgument("Attribute dim is ", dim,
+                                   " but the table has dimension ",
+                                   table.options().dim);
+  }
+  return absl::OkStatus();
+}
+
+// Scalar float input `index`.
+absl::Status GetScalar(OpKernelContext* ctx, int index, float* value) {
+  const Tensor& t = ctx->input(index);
+  if (!TensorShapeUtils::IsScalar(t.shape())) {
+    return errors::InvalidArgument("Input ", index, " must be a scalar, got ",
+                                   t.shape().DebugString());
+  }
+  *value = t.scalar<float>()();
+  return absl::OkStatus();
+}
+
+class DynamicEmbeddingTableOp : public OpKernel {
+ public:
+  explicit DynamicEmbeddingTableOp(OpKernelConstruction* ctx)
+      : OpKernel(ctx) {
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("dim", &options_.dim));
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("num_slots", &options_.num_slots));
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("max_rows", &options_.max_rows));
+    std::string eviction_policy;
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("eviction_policy", &eviction_policy));
+    options_.eviction_policy =
+        eviction_policy == "lfu"
+            ? DynamicEmbeddingTable::EvictionPolicy::kLfu
+            : DynamicEmbeddingTable::EvictionPolicy::kLru;
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("initializer_stddev",
+                                     &options_.initializer_stddev));
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("initial_slot_value",
+                                     &options_.initial_slot_value));
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("seed", &options_.seed));
+  }
+
+  ~DynamicEmbeddingTableOp() override {
+    if (handle_initialized_ && cinfo_.resource_is_private_to_kernel()) {
+      cinfo_.resource_manager()
+          ->Delete<DynamicEmbeddingTable>(cinfo_.container(), cinfo_.name())
+          .IgnoreError();
+    }
+  }
+
+  void Compute(OpKernelContext* ctx) override {
+    mutex_lock l(mu_);
+    if (!handle_initialized_) {
+      OP_REQUIRES_OK(ctx, cinfo_.Init(ctx->resource_manager(), def()));
+      handle_ = MakeResourceHandle<DynamicEmbeddingTable>(
+          ctx, cinfo_.container(), cinfo_.name());
+      handle_initialized_ = true;
+    }
+    core::RefCountPtr<DynamicEmbeddingTable> table;
+    OP_REQUIRES_OK(ctx, LookupOrCreateResource<DynamicEmbeddingTable>(
+                            ctx, handle_, &table,
+                            [this](DynamicEmbeddingTable** ret) {
+                              *ret = new DynamicEmbeddingTable(options_);
+                              return absl::OkStatus();
+                            }));
+    Tensor* output;
+    OP_REQUIRES_OK(ctx, ctx->allocate_output(0, TensorShape({}), &output));
+    output->scalar<ResourceHandle>()() = handle_;
+  }
+
+ private:
+  DynamicEmbeddingTable::Options options_;
+  mutex mu_;
+  ContainerInfo cinfo_ TF_GUARDED_BY(mu_);
+  ResourceHandle handle_ TF_GUARDED_BY(mu_);
+  bool handle_initialized_ TF_GUARDED_BY(mu_) = false;
+};
+
+REGISTER_KERNEL_BUILDER(Name("DynamicEmbeddingTable").Device(DEVICE_CPU),
+                        DynamicEmbeddingTableOp);
+
+class DynamicEmbeddingLookupOp : public OpKernel {
+ public:
+  explicit DynamicEmbeddingLookupOp(OpKernelConstruction* ctx)
+      : OpKernel(ctx) {
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("dim", &dim_));
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("insert_missing", &insert_missing_));
+  }
+
+  void Compute(OpKernelContext* ctx) override {
+    core::RefCountPtr<DynamicEmbeddingTable> table;
+    OP_REQUIRES_OK(ctx, LookupResource(ctx, HandleFromInput(ctx, 0), &table));
+    OP_REQUIRES_OK(ctx, CheckDim(*table, dim_));
+    const Tensor& ids = ctx->input(1);
+    TensorShape values_shape = ids.shape();
+    values_shape.AddDim(table->options().dim);
+    Tensor* values;
+    OP_REQUIRES_OK(ctx, ctx->allocate_output(0, values_shape, &values));
+    table->Lookup(Ids(ids), insert_missing_,
+                  absl::MakeSpan(values->flat<float>().data(),
+                                 values->NumElements()));
+  }
+
+ private:
+  int64_t dim_;
+  bool insert_missing_;
+};
+
+REGISTER_KERNEL_BUILDER(Name("DynamicEmbeddingLookup").Device(DEVICE_CPU),
+                        DynamicEmbeddingLookupOp);
+
+class DynamicEmbeddingSparseApplyAdagradOp : public OpKernel {
+ public:
+  using OpKernel::OpKernel;
+
+  void Compute(OpKernelContext* ctx) override {
+    core::RefCountPtr<DynamicEmbeddingTable> table;
+    OP_REQUIRES_OK(ctx, LookupResource(ctx, HandleFromInput(ctx, 0), &table));
+    const Tensor& ids = ctx->input(1);
+    const Tensor& grad = ctx->input(2);
+    OP_REQUIRES_OK(ctx, CheckRows(*table, ids, grad, "grad"));
+    float lr, epsilon;
+    OP_REQUIRES_OK(ctx, GetScalar(ctx, 3, &lr));
+    OP_REQUIRES_OK(ctx, GetScalar(ctx, 4, &epsilon));
+    OP_REQUIRES_OK(ctx,
+                   table->ApplyAdagrad(Ids(ids), Floats(grad), lr, epsilon));
+  }
+};
+
+REGISTER_KERNEL_BUILDER(
+    Name("DynamicEmbeddingSparseApplyAdagrad").Device(DEVICE_CPU),
+    DynamicEmbeddingSparseApplyAdagradOp);
+
+class DynamicEmbeddingSparseApplyAdamOp : public OpKernel {
+ public:
+  using OpKernel::OpKernel;
+
+  void Compute(OpKernelContext* ctx) override {
+    core::RefCountPtr<DynamicEmbeddingTable> table;
+    OP_REQUIRES_OK(ctx, LookupResource(ctx, HandleFromInput(ctx, 0), &table));
+    const Tensor& ids = ctx->input(1);
+    const Tensor& grad = ctx->input(2);
+    OP_REQUIRES_OK(ctx, CheckRows(*table, ids, grad, "grad"));
+    float lr, beta1, beta2, beta1_power, beta2_power, epsilon;
+    OP_REQUIRES_OK(ctx, GetScalar(ctx, 3, &lr));
+    OP_REQUIRES_OK(ctx, GetScalar(ctx, 4, &beta1));
+    OP_REQUIRES_OK(ctx, GetScalar(ctx, 5, &beta2));
+    OP_REQUIRES_OK(ctx, GetScalar(ctx, 6, &beta1_power));
+    OP_REQUIRES_OK(ctx, GetScalar(ctx, 7, &beta2_power));
+    OP_REQUIRES_OK(ctx, GetScalar(ctx, 8, &epsilon));
+    OP_REQUIRES_OK(ctx, table->ApplyAdam(Ids(ids), Floats(grad), lr, beta1,
+                                         beta2, beta1_power, beta2_power,
+                                         epsilon));
+  }
+};
+
+REGISTER_KERNEL_BUILDER(
+    Name("DynamicEmbeddingSparseApplyAdam").Device(DEVICE_CPU),
+    DynamicEmbeddingSparseApplyAdamOp);
+
+class DynamicEmbeddingSizeOp : public OpKernel {
+ public:
+  using OpKernel::OpKernel;
+
+  void Compute(OpKernelContext* ctx) override {
+    core::RefCountPtr<DynamicEmbeddingTable> table;
+    OP_REQUIRES_OK(ctx, LookupResource(ctx, HandleFromInput(ctx, 0), &table));
+    Tensor* size;
+    OP_REQUIRES_OK(ctx, ctx->allocate_output(0, TensorShape({}), &size));
+    size->scalar<int64_t>()() = table->size();
+  }
+};
+
+REGISTER_KERNEL_BUILDER(Name("DynamicEmbeddingSize").Device(DEVICE_CPU),
+                        DynamicEmbeddingSizeOp);
+
+class DynamicEmbeddingExportOp : public OpKernel {
+ public:
+  explicit DynamicEmbeddingExportOp(OpKernelConstruction* ctx)
+      : OpKernel(ctx) {
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("dim", &dim_));
+  }
+
+  void Compute(OpKernelContext* ctx) override {
+    core::RefCountPtr<DynamicEmbeddingTable> table;
+    OP_REQUIRES_OK(ctx, LookupResource(ctx, HandleFromInput(ctx, 0), &table));
+    OP_REQUIRES_OK(ctx, CheckDim(*table, dim_));
+    std::vector<int64_t> ids;
+    std::vector<float> values;
+    table->Export(&ids, &values);
+
+    const int64_t size = ids.size();
+    Tensor* ids_t;
+    OP_REQUIRES_OK(ctx, ctx->allocate_output(0, TensorShape({size}), &ids_t));
+    std::copy(ids.begin(), ids.end(), ids_t->flat<int64_t>().data());
+    Tensor* values_t;
+    OP_REQUIRES_OK(
+        ctx, ctx->allocate_output(
+                 1, TensorShape({size, table->options().dim}), &values_t));
+    std::copy(values.begin(), values.end(), values_t->flat<float>().data());
+  }
+
+ private:
+  int64_t dim_;
+};
+
+REGISTER_KERNEL_BUILDER(Name("DynamicEmbeddingExport").Device(DEVICE_CPU),
+                        DynamicEmbeddingExportOp);
+
+class DynamicEmbeddingImportOp : public OpKernel {
+ public:
+  using OpKernel::OpKernel;
+
+  void Compute(OpKernelContext* ctx) override {
+    core::RefCountPtr<DynamicEmbeddingTable> table;
+    OP_REQUIRES_OK(ctx, LookupResource(ctx, HandleFromInput(ctx, 0), &table));
+    const Tensor& ids = ctx->input(1);
+    const Tensor& values = ctx->input(2);
+    OP_REQUIRES_OK(ctx, CheckRows(*table, ids, values, "values"));
+    OP_REQUIRES_OK(ctx, table->Import(Ids(ids), Floats(values)));
+  }
+};
+
+REGISTER_KERNEL_BUILDER(Name("DynamicEmbeddingImport").Device(DEVICE_CPU),
+                        DynamicEmbeddingImportOp);
+
+}  // namespace
+}  // namespace tensorflow
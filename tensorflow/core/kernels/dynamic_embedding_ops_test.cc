@@ -0,0 +1,118 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <cstdint>
+
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/kernels/dynamic_embedding_table.h"
+#include "tensorflow/core/kernels/ops_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+class DynamicEmbeddingOpsTest : public OpsTestBase {
+ protected:
+  // Returns a table of dimension 2 that holds {1: [1, 2], 2: [3, 4]}. The
+  // table is owned by the resource manager of the test device.
+  DynamicEmbeddingTable* AddTableInput() {
+    DynamicEmbeddingTable::Options options;
+    options.dim = 2;
+    auto* table = new DynamicEmbeddingTable(options);
+    TF_CHECK_OK(table->Import({1, 2}, {1.0f, 2.0f, 3.0f, 4.0f}));
+    AddResourceInput("", "table", table);
+    return table;
+  }
+
+  absl::Status InitLookup(int64_t dim, bool insert_missing) {
+    TF_CHECK_OK(NodeDefBuilder("lookup", "DynamicEmbeddingLookup")
+                    .Input(FakeInput(DT_RESOURCE))
+                    .Input(FakeInput(DT_INT64))
+                    .Attr("dim", dim)
+                    .Attr("insert_missing", insert_missing)
+                    .Finalize(node_def()));
+    return InitOp();
+  }
+
+  absl::Status InitExport(int64_t dim) {
+    TF_CHECK_OK(NodeDefBuilder("export", "DynamicEmbeddingExport")
+                    .Input(FakeInput(DT_RESOURCE))
+                    .Attr("dim", dim)
+                    .Finalize(node_def()));
+    return InitOp();
+  }
+};
+
+TEST_F(DynamicEmbeddingOpsTest, Lookup) {
+  TF_ASSERT_OK(InitLookup(/*dim=*/2, /*insert_missing=*/true));
+  DynamicEmbeddingTable* table = AddTableInput();
+  AddInputFromArray<int64_t>(TensorShape({3}), {2, 5, 1});
+  TF_ASSERT_OK(RunOpKernel());
+
+  Tensor expected(allocator(), DT_FLOAT, TensorShape({3, 2}));
+  test::FillValues<float>(&expected, {3, 4, 0, 0, 1, 2});
+  test::ExpectTensorEqual<float>(expected, *GetOutput(0));
+  EXPECT_EQ(table->size(), 3);
+}
+
+TEST_F(DynamicEmbeddingOpsTest, LookupWithoutInsert) {
+  TF_ASSERT_OK(InitLookup(/*dim=*/2, /*insert_missing=*/false));
+  DynamicEmbeddingTable* table = AddTableInput();
+  AddInputFromArray<int64_t>(TensorShape({2, 2}), {2, 5, 1, 1});
+  TF_ASSERT_OK(RunOpKernel());
+
+  Tensor expected(allocator(), DT_FLOAT, TensorShape({2, 2, 2}));
+  test::FillValues<float>(&expected, {3, 4, 0, 0, 1, 2, 1, 2});
+  test::ExpectTensorEqual<float>(expected, *GetOutput(0));
+  EXPECT_EQ(table->size(), 2);
+}
+
+TEST_F(DynamicEmbeddingOpsTest, LookupRejectsMismatchedDim) {
+  TF_ASSERT_OK(InitLookup(/*dim=*/3, /*insert_missing=*/true));
+  AddTableInput();
+  AddInputFromArray<int64_t>(TensorShape({1}), {1});
+  EXPECT_TRUE(errors::IsInvalidArgument(RunOpKernel()));
+}
+
+TEST_F(DynamicEmbeddingOpsTest, Export) {
+  TF_ASSERT_OK(InitExport(/*dim=*/2));
+  AddTableInput();
+  TF_ASSERT_OK(RunOpKernel());
+
+  const Tensor& ids = *GetOutput(0);
+  const Tensor& values = *GetOutput(1);
+  ASSERT_EQ(ids.NumElements(), 2);
+  ASSERT_EQ(values.shape(), TensorShape({2, 2}));
+  for (int i = 0; i < 2; ++i) {
+    const int64_t id = ids.vec<int64_t>()(i);
+    EXPECT_EQ(values.matrix<float>()(i, 0), 2 * id - 1);
+    EXPECT_EQ(values.matrix<float>()(i, 1), 2 * id);
+  }
+}
+
+TEST_F(DynamicEmbeddingOpsTest, ExportRejectsMismatchedDim) {
+  TF_ASSERT_OK(InitExport(/*dim=*/1));
+  AddTableInput();
+  EXPECT_TRUE(errors::IsInvalidArgument(RunOpKernel()));
+}
+
+}  // namespace
+}  // namespace tensorflow
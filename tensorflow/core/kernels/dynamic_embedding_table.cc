@@ -0,0 +1,303 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/kernels/dynamic_embedding_table.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
+
+namespace tensorflow {
+
+namespace {
+
+// Number of least recently used rows among which the LFU policy evicts the one
+// with the lowest access count.
+constexpr int kLfuCandidates = 8;
+
+constexpr float kTwoPi = 6.28318530717958647692f;
+
+}  // namespace
+
+DynamicEmbeddingTable::DynamicEmbeddingTable(const Options& options)
+    : options_(options),
+      philox_(static_cast<uint64>(options.seed),
+              static_cast<uint64>(options.seed) ^ 0x5bd1e995u),
+      rng_(&philox_) {
+  DCHECK_GT(options_.dim, 0);
+  DCHECK_GE(options_.num_slots, 0);
+}
+
+std::string DynamicEmbeddingTable::DebugString() const {
+  return absl::StrCat("DynamicEmbeddingTable(dim=", options_.dim,
+                      ", num_slots=", options_.num_slots,
+                      ", rows=", size(), ")");
+}
+
+int64_t DynamicEmbeddingTable::MemoryUsed() const {
+  tf_shared_lock l(mu_);
+  return sizeof(DynamicEmbeddingTable) +
+         blocks_.size() * kRowsPerBlock * row_width() * sizeof(float) +
+         rows_.capacity() * (sizeof(int64_t) + sizeof(int32_t)) +
+         row_ids_.capacity() * (sizeof(int64_t) + sizeof(uint32_t) +
+                                2 * sizeof(int32_t));
+}
+
+int64_t DynamicEmbeddingTable::size() const {
+  tf_shared_lock l(mu_);
+  return rows_.size();
+}
+
+float* DynamicEmbeddingTable::RowData(int32_t row) {
+  return blocks_[row / kRowsPerBlock].get() +
+         (row % kRowsPerBlock) * row_width();
+}
+
+const float* DynamicEmbeddingTable::RowData(int32_t row) const {
+  return blocks_[row / kRowsPerBlock].get() +
+         (row % kRowsPerBlock) * row_width();
+}
+
+void DynamicEmbeddingTable::Unlink(int32_t row) {
+  if (prev_[row] != kNoRow) {
+    next_[prev_[row]] = next_[row];
+  } else {
+    head_ = next_[row];
+  }
+  if (next_[row] != kNoRow) {
+    prev_[next_[row]] = prev_[row];
+  } else {
+    tail_ = prev_[row];
+  }
+}
+
+void DynamicEmbeddingTable::PushFront(int32_t row) {
+  prev_[row] = kNoRow;
+  next_[row] = head_;
+  if (head_ != kNoRow) prev_[head_] = row;
+  head_ = row;
+  if (tail_ == kNoRow) tail_ = row;
+}
+
+void DynamicEmbeddingTable::Touch(int32_t row) {
+  if (access_counts_[row] < std::numeric_limits<uint32_t>::max()) {
+    ++access_counts_[row];
+  }
+  if (head_ != row) {
+    Unlink(row);
+    PushFront(row);
+  }
+}
+
+int32_t DynamicEmbeddingTable::PickVictim() {
+  int32_t victim = tail_;
+  if (options_.eviction_policy == EvictionPolicy::kLfu) {
+    int32_t row = tail_;
+    for (int i = 0; i < kLfuCandidates && row != kNoRow; ++i) {
+      if (access_counts_[row] < access_counts_[victim]) victim = row;
+      row = prev_[row];
+    }
+  }
+  return victim;
+}
+
+int32_t DynamicEmbeddingTable::AllocateRow() {
+  if (options_.max_rows > 0 &&
+      static_cast<int64_t>(rows_.size()) >= options_.max_rows) {
+    const int32_t victim = PickVictim();
+    Unlink(victim);
+    rows_.erase(row_ids_[victim]);
+    return victim;
+  }
+  if (num_allocated_rows_ % kRowsPerBlock == 0) {
+    blocks_.emplace_back(new float[kRowsPerBlock * row_width()]);
+    const size_t capacity = blocks_.size() * kRowsPerBlock;
+    row_ids_.resize(capacity);
+    access_counts_.resize(capacity);
+    prev_.resize(capacity);
+    next_.resize(capacity);
+  }
+  return num_allocated_rows_++;
+}
+
+void DynamicEmbeddingTable::InitializeRow(int32_t row) {
+  float* data = RowData(row);
+  if (options_.initializer_stddev == 0.0f) {
+    std::fill_n(data, options_.dim, 0.0f);
+  } else {
+    // Box-Muller transform of uniform samples in (0, 1].
+    for (int64_t i = 0; i < options_.dim; ++i) {
+      const float u1 = 1.0f - rng_.RandFloat();
+      const float u2 = rng_.RandFloat();
+      data[i] = options_.initializer_stddev * std::sqrt(-2.0f * std::log(u1)) *
+                std::cos(kTwoPi * u2);
+    }
+  }
+  std::fill(data + options_.dim, data + row_width(),
+            options_.initial_slot_value);
+}
+
+int32_t DynamicEmbeddingTable::FindRow(int64_t id, bool insert) {
+  auto it = rows_.find(id);
+  if (it != rows_.end()) {
+    Touch(it->second);
+    return it->second;
+  }
+  if (!insert) return kNoRow;
+  const int32_t row = AllocateRow();
+  rows_.emplace(id, row);
+  row_ids_[row] = id;
+  access_counts_[row] = 1;
+  PushFront(row);
+  InitializeRow(row);
+  return row;
+}
+
+void DynamicEmbeddingTable::LookupExisting(absl::Span<const int64_t> ids,
+                                           absl::Span<float> values) const {
+  const int64_t dim = options_.dim;
+  tf_shared_lock l(mu_);
+  for (size_t i = 0; i < ids.size(); ++i) {
+    float* out = values.data() + i * dim;
+    auto it = rows_.find(ids[i]);
+    if (it == rows_.end()) {
+      std::fill_n(out, dim, 0.0f);
+    } else {
+      std::copy_n(RowData(it->second), dim, out);
+    }
+  }
+}
+
+void DynamicEmbeddingTable::Lookup(absl::Span<const int64_t> ids,
+                                   bool insert_missing,
+                                   absl::Span<float> values) {
+  const int64_t dim = options_.dim;
+  DCHECK_EQ(values.size(), ids.size() * dim);
+  if (!insert_missing) {
+    LookupExisting(ids, values);
+    return;
+  }
+  mutex_lock l(mu_);
+  for (size_t i = 0; i < ids.size(); ++i) {
+    float* out = values.data() + i * dim;
+    std::copy_n(RowData(FindRow(ids[i], /*insert=*/true)), dim, out);
+  }
+}
+
+absl::Status DynamicEmbeddingTable::ApplyAdagrad(
+    absl::Span<const int64_t> ids, absl::Span<const float> grads, float lr,
+    float epsilon) {
+  if (options_.num_slots < 1) {
+    return errors::FailedPrecondition(
+        "Adagrad needs a DynamicEmbeddingTable with at least 1 slot, got ",
+        options_.num_slots);
+  }
+  const int64_t dim = options_.dim;
+  DCHECK_EQ(grads.size(), ids.size() * dim);
+  mutex_lock l(mu_);
+  for (size_t i = 0; i < ids.size(); ++i) {
+    float* var = RowData(FindRow(ids[i], /*insert=*/true));
+    float* accum = var + dim;
+    const float* grad = grads.data() + i * dim;
+    for (int64_t j = 0; j < dim; ++j) {
+      accum[j] += grad[j] * grad[j];
+      var[j] -= lr * grad[j] / (std::sqrt(accum[j]) + epsilon);
+    }
+  }
+  return absl::OkStatus();
+}
+
+absl::Status DynamicEmbeddingTable::ApplyAdam(
+    absl::Span<const int64_t> ids, absl::Span<const float> grads, float lr,
+    float beta1, float beta2, float beta1_power, float beta2_power,
+    float epsilon) {
+  if (options_.num_slots < 2) {
+    return errors::FailedPrecondition(
+        "Adam needs a DynamicEmbeddingTable with at least 2 slots, got ",
+        options_.num_slots);
+  }
+  const int64_t dim = options_.dim;
+  DCHECK_EQ(grads.size(), ids.size() * dim);
+  const float alpha = lr * std::sqrt(1 - beta2_power) / (1 - beta1_power);
+  mutex_lock l(mu_);
+  for (size_t i = 0; i < ids.size(); ++i) {
+    float* var = RowData(FindRow(ids[i], /*insert=*/true));
+    float* m = var + dim;
+    float* v = m + dim;
+    const float* grad = grads.data() + i * dim;
+    for (int64_t j = 0; j < dim; ++j) {
+      m[j] += (grad[j] - m[j]) * (1 - beta1);
+      v[j] += (grad[j] * grad[j] - v[j]) * (1 - beta2);
+      var[j] -= (m[j] * alpha) / (std::sqrt(v[j]) + epsilon);
+    }
+  }
+  return absl::OkStatus();
+}
+
+void DynamicEmbeddingTable::Export(std::vector<int64_t>* ids,
+                                   std::vector<float>* values) const {
+  const int64_t dim = options_.dim;
+  tf_shared_lock l(mu_);
+  ids->clear();
+  ids->reserve(rows_.size());
+  values->resize(rows_.size() * dim);
+  float* out = values->data();
+  for (const auto& [id, row] : rows_) {
+    ids->push_back(id);
+    out = std::copy_n(RowData(row), dim, out);
+  }
+}
+
+void DynamicEmbeddingTable::ClearLocked() {
+  rows_.clear();
+  blocks_.clear();
+  row_ids_.clear();
+  access_counts_.clear();
+  prev_.clear();
+  next_.clear();
+  num_allocated_rows_ = 0;
+  head_ = kNoRow;
+  tail_ = kNoRow;
+}
+
+absl::Status DynamicEmbeddingTable::Import(absl::Span<const int64_t> ids,
+                                           absl::Span<const float> values) {
+  const int64_t dim = options_.dim;
+  if (values.size() != ids.size() * dim) {
+    return errors::InvalidArgument("Expected ", ids.size() * dim,
+                                   " values for ", ids.size(),
+                                   " ids, got ", values.size());
+  }
+  mutex_lock l(mu_);
+  ClearLocked();
+  for (size_t i = 0; i < ids.size(); ++i) {
+    float* var = RowData(FindRow(ids[i], /*insert=*/true));
+    std::copy_n(values.data() + i * dim, dim, var);
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,151 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_KERNELS_DYNAMIC_EMBEDDING_TABLE_H_
+#define TENSORFLOW_CORE_KERNELS_DYNAMIC_EMBEDDING_TABLE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/types/span.h"
+#include "tensorflow/core/framework/resource_base.h"
+#include "tensorflow/core/lib/random/philox_random.h"
+#include "tensorflow/core/lib/random/simple_philox.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+
+namespace tensorflow {
+
+// Embedding table of float rows keyed by int64 ids, e.g. hashed feature ids,
+// whose rows are created the first time their id is looked up or updated.
+// This lets the id space be unbounded while only the ids actually seen use
+// memory.
+//
+// Each row holds the embedding followed by `num_slots` optimizer slots of the
+// same dimension (1 for Adagrad, 2 for Adam), so that a sparse update touches a
+// single contiguous block per id. Rows live in blocks of kRowsPerBlock rows
+// that are allocated as the table grows.
+//
+// With `max_rows` > 0, creating a row when the table is full reuses the row of
+// the least recently used id (EvictionPolicy::kLru), or of the id with the
+// lowest access count among the few least recently used ones
+// (EvictionPolicy::kLfu).
+//
+// The table is thread-safe.
+class DynamicEmbeddingTable : public ResourceBase {
+ public:
+  enum class EvictionPolicy { kLru, kLfu };
+
+  struct Options {
+    int64_t dim = 0;
+    int num_slots = 0;
+    int64_t max_rows = 0;
+    EvictionPolicy eviction_policy = EvictionPolicy::kLru;
+    // New embeddings are drawn from N(0, initializer_stddev^2), or are zero if
+    // the stddev is 0. Slots always start at `initial_slot_value`.
+    float initializer_stddev = 0.0f;
+    float initial_slot_value = 0.0f;
+    int64_t seed = 0;
+  };
+
+  explicit DynamicEmbeddingTable(const Options& options);
+
+  std::string DebugString() const override;
+  int64_t MemoryUsed() const override;
+
+  const Options& options() const { return options_; }
+  int64_t size() const;
+
+  // Copies the embedding of each id into the rows of `values`, which has
+  // `ids.size() * dim` elements. With `insert_missing`, missing ids get a new
+  // row, else their embedding is zero. Without `insert_missing`, the lookup
+  // only takes a shared lock and doesn't count as a use for eviction.
+  void Lookup(absl::Span<const int64_t> ids, bool insert_missing,
+              absl::Span<float> values);
+
+  // Applies an Adagrad update of the rows of `ids` with `grads`, creating
+  // missing rows. Slot 0 holds the accumulators. Repeated ids are applied in
+  // order, like the sparse Adagrad kernels.
+  absl::Status ApplyAdagrad(absl::Span<const int64_t> ids,
+                            absl::Span<const float> grads, float lr,
+                            float epsilon);
+
+  // Applies an Adam update of the rows of `ids` with `grads`, creating missing
+  // rows. Slots 0 and 1 hold the first and second moments.
+  absl::Status ApplyAdam(absl::Span<const int64_t> ids,
+                         absl::Span<const float> grads, float lr,
+                         float beta1, float beta2, float beta1_power,
+                         float beta2_power, float epsilon);
+
+  // Returns the ids in the table and their embeddings.
+  void Export(std::vector<int64_t>* ids, std::vector<float>* values) const;
+
+  // Replaces the content of the table with `ids` and their embeddings, with
+  // slots reset to their initial value.
+  absl::Status Import(absl::Span<const int64_t> ids,
+                      absl::Span<const float> values);
+
+ private:
+  static constexpr int32_t kRowsPerBlock = 1024;
+  static constexpr int32_t kNoRow = -1;
+
+  // Number of floats in a row: the embedding and its slots.
+  int64_t row_width() const { return options_.dim * (1 + options_.num_slots); }
+
+  // Lookup of the existing ids, without recording their accesses.
+  void LookupExisting(absl::Span<const int64_t> ids,
+                      absl::Span<float> values) const;
+
+  float* RowData(int32_t row) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  const float* RowData(int32_t row) const TF_SHARED_LOCKS_REQUIRED(mu_);
+
+  // Returns the row of `id`, after recording an access to it, creating it if
+  // `insert` is true. Returns kNoRow if the row doesn't exist.
+  int32_t FindRow(int64_t id, bool insert) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  int32_t AllocateRow() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void InitializeRow(int32_t row) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void Touch(int32_t row) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  int32_t PickVictim() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void Unlink(int32_t row) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void PushFront(int32_t row) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void ClearLocked() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  const Options options_;
+
+  mutable mutex mu_;
+  absl::flat_hash_map<int64_t, int32_t> rows_ TF_GUARDED_BY(mu_);
+  std::vector<std::unique_ptr<float[]>> blocks_ TF_GUARDED_BY(mu_);
+  int32_t num_allocated_rows_ TF_GUARDED_BY(mu_) = 0;
+
+  // Per-row metadata, indexed by row. `prev_` and `next_` link the rows in use
+  // from the most to the least recently used one.
+  std::vector<int64_t> row_ids_ TF_GUARDED_BY(mu_);
+  std::vector<uint32_t> access_counts_ TF_GUARDED_BY(mu_);
+  std::vector<int32_t> prev_ TF_GUARDED_BY(mu_);
+  std::vector<int32_t> next_ TF_GUARDED_BY(mu_);
+  int32_t head_ TF_GUARDED_BY(mu_) = kNoRow;
+  int32_t tail_ TF_GUARDED_BY(mu_) = kNoRow;
+
+  random::PhiloxRandom philox_ TF_GUARDED_BY(mu_);
+  random::SimplePhilox rng_ TF_GUARDED_BY(mu_);
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_KERNELS_DYNAMIC_EMBEDDING_TABLE_H_
@@ -0,0 +1,142 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/kernels/dynamic_embedding_table.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "tensorflow/core/framework/resource_base.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+using Options = DynamicEmbeddingTable::Options;
+
+core::RefCountPtr<DynamicEmbeddingTable> MakeTable(const Options& options) {
+  return core::RefCountPtr<DynamicEmbeddingTable>(
+      new DynamicEmbeddingTable(options));
+}
+
+std::vector<float> Lookup(DynamicEmbeddingTable* table,
+                          const std::vector<int64_t>& ids,
+                          bool insert_missing = true) {
+  std::vector<float> values(ids.size() * table->options().dim);
+  table->Lookup(ids, insert_missing, absl::MakeSpan(values));
+  return values;
+}
+
+TEST(DynamicEmbeddingTableTest, InsertsOnMiss) {
+  Options options;
+  options.dim = 2;
+  auto table = MakeTable(options);
+
+  EXPECT_EQ(Lookup(table.get(), {7}, /*insert_missing=*/false),
+            std::vector<float>({0, 0}));
+  EXPECT_EQ(table->size(), 0);
+  EXPECT_EQ(Lookup(table.get(), {7, 1LL << 40, 7}),
+            std::vector<float>({0, 0, 0, 0, 0, 0}));
+  EXPECT_EQ(table->size(), 2);
+}
+
+TEST(DynamicEmbeddingTableTest, ApplyAdagrad) {
+  Options options;
+  options.dim = 2;
+  options.num_slots = 1;
+  options.initial_slot_value = 0.1f;
+  auto table = MakeTable(options);
+
+  TF_ASSERT_OK(table->ApplyAdagrad({3}, {1.0f, 2.0f}, /*lr=*/0.5f,
+                                   /*epsilon=*/0.0f));
+  std::vector<float> values = Lookup(table.get(), {3});
+  EXPECT_NEAR(values[0], -0.5f / std::sqrt(1.1f), 1e-6);
+  EXPECT_NEAR(values[1], -1.0f / std::sqrt(4.1f), 1e-6);
+}
+
+TEST(DynamicEmbeddingTableTest, ApplyAdamNeedsTwoSlots) {
+  Options options;
+  options.dim = 1;
+  options.num_slots = 1;
+  auto table = MakeTable(options);
+
+  EXPECT_TRUE(errors::IsFailedPrecondition(
+      table->ApplyAdam({1}, {1.0f}, 0.1f, 0.9f, 0.999f, 0.9f, 0.999f, 1e-7f)));
+}
+
+TEST(DynamicEmbeddingTableTest, ApplyAdam) {
+  Options options;
+  options.dim = 1;
+  options.num_slots = 2;
+  auto table = MakeTable(options);
+
+  TF_ASSERT_OK(table->ApplyAdam({1}, {2.0f}, /*lr=*/0.1f, /*beta1=*/0.9f,
+                                /*beta2=*/0.999f, /*beta1_power=*/0.9f,
+                                /*beta2_power=*/0.999f, /*epsilon=*/0.0f));
+  // The first bias-corrected step moves by lr in the direction of -grad.
+  EXPECT_NEAR(Lookup(table.get(), {1})[0], -0.1f, 1e-5);
+}
+
+TEST(DynamicEmbeddingTableTest, EvictsLeastRecentlyUsed) {
+  Options options;
+  options.dim = 1;
+  options.max_rows = 2;
+  auto table = MakeTable(options);
+
+  TF_ASSERT_OK(table->Import({1, 2}, {1.0f, 2.0f}));
+  Lookup(table.get(), {1});
+  Lookup(table.get(), {3});
+  EXPECT_EQ(table->size(), 2);
+  EXPECT_EQ(Lookup(table.get(), {1, 2}, /*insert_missing=*/false),
+            std::vector<float>({1.0f, 0.0f}));
+}
+
+TEST(DynamicEmbeddingTableTest, EvictsLeastFrequentlyUsed) {
+  Options options;
+  options.dim = 1;
+  options.max_rows = 2;
+  options.eviction_policy = DynamicEmbeddingTable::EvictionPolicy::kLfu;
+  auto table = MakeTable(options);
+
+  TF_ASSERT_OK(table->Import({1, 2}, {1.0f, 2.0f}));
+  Lookup(table.get(), {1, 1, 1, 2});
+  // 1 is the least recently used id, but 2 is used less often.
+  Lookup(table.get(), {3});
+  EXPECT_EQ(Lookup(table.get(), {1, 2}, /*insert_missing=*/false),
+            std::vector<float>({1.0f, 0.0f}));
+}
+
+TEST(DynamicEmbeddingTableTest, ExportImportRoundTrip) {
+  Options options;
+  options.dim = 2;
+  options.initializer_stddev = 1.0f;
+  auto table = MakeTable(options);
+  std::vector<float> values = Lookup(table.get(), {5, 6});
+
+  std::vector<int64_t> exported_ids;
+  std::vector<float> exported_values;
+  table->Export(&exported_ids, &exported_values);
+  ASSERT_EQ(exported_ids.size(), 2);
+
+  auto copy = MakeTable(options);
+  TF_ASSERT_OK(copy->Import(exported_ids, exported_values));
+  EXPECT_EQ(Lookup(copy.get(), {5, 6}, /*insert_missing=*/false), values);
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -0,0 +1,170 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// See docs in ../ops/nn_ops.cc.
+
+#define EIGEN_USE_THREADS
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include "Eigen/Core"  // from @eigen_archive
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/util/work_sharder.h"
+
+namespace tensorflow {
+namespace {
+
+// Number of keys whose attention scores are computed at once. The scores of
+// a block and the rows of `key` and `value` it reads stay in cache.
+constexpr int64_t kKeyBlockSize = 64;
+
+// Computes softmax(scale * query * key^T) * value one query at a time. The
+// keys are visited in blocks, keeping the running maximum and sum of the
+// exponentiated scores (online softmax), so only one block of scores per
+// query is ever in memory.
+template <typename T>
+class FusedScaledDotProductAttentionOp : public OpKernel {
+ public:
+  explicit FusedScaledDotProductAttentionOp(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    const Tensor& query = context->input(0);
+    const Tensor& key = context->input(1);
+    const Tensor& value = context->input(2);
+    const Tensor& scale = context->input(3);
+
+    OP_REQUIRES(context, TensorShapeUtils::IsScalar(scale.shape()),
+                errors::InvalidArgument("scale must be a scalar, got shape ",
+                                        scale.shape().DebugString()));
+    const int dims = query.dims();
+    OP_REQUIRES(context, dims >= 2,
+                errors::InvalidArgument("query must be at least 2-D, got ",
+                                        query.shape().DebugString()));
+    OP_REQUIRES(context, key.dims() == dims && value.dims() == dims,
+                errors::InvalidArgument(
+                    "query, key and value must have the same rank, got ",
+                    query.shape().DebugString(), ", ",
+                    key.shape().DebugString(), " and ",
+                    value.shape().DebugString()));
+    int64_t batch_size = 1;
+    for (int i = 0; i < dims - 2; ++i) {
+      OP_REQUIRES(context,
+                  key.dim_size(i) == query.dim_size(i) &&
+                      value.dim_size(i) == query.dim_size(i),
+                  errors::InvalidArgument(
+                      "query, key and value must have the same batch "
+                      "dimensions, got ",
+                      query.shape().DebugString(), ", ",
+                      key.shape().DebugString(), " and ",
+                      value.shape().DebugString()));
+      batch_size *= query.dim_size(i);
+    }
+    const int64_t num_queries = query.dim_size(dims - 2);
+    const int64_t depth = query.dim_size(dims - 1);
+    const int64_t num_keys = key.dim_size(dims - 2);
+    const int64_t value_depth = value.dim_size(dims - 1);
+    OP_REQUIRES(context, key.dim_size(dims - 1) == depth,
+                errors::InvalidArgument(
+                    "query and key must have the same inner dimension, got ",
+                    query.shape().DebugString(), " and ",
+                    key.shape().DebugString()));
+    OP_REQUIRES(context, value.dim_size(dims - 2) == num_keys,
+                errors::InvalidArgument(
+                    "key and value must have the same number of rows, got ",
+                    key.shape().DebugString(), " and ",
+                    value.shape().DebugString()));
+
+    TensorShape output_shape = query.shape();
+    output_shape.set_dim(dims - 1, value_depth);
+    Tensor* output = nullptr;
+    OP_REQUIRES_OK(context,
+                   context->allocate_output(0, output_shape, &output));
+    if (output->NumElements() == 0) return;
+    if (num_keys == 0) {
+      // Attending to no keys produces zeros, as the unfused BatchMatMul does.
+      output->flat<T>().setZero();
+      return;
+    }
+
+    using Vector = Eigen::Matrix<T, Eigen::Dynamic, 1>;
+    using ConstVectorMap = Eigen::Map<const Vector>;
+    using Matrix =
+        Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    using ConstMatrixMap = Eigen::Map<const Matrix>;
+
+    const T* query_data = query.flat<T>().data();
+    const T* key_data = key.flat<T>().data();
+    const T* value_data = value.flat<T>().data();
+    T* output_data = output->flat<T>().data();
+    const T scale_value = scale.scalar<T>()();
+
+    auto compute_queries = [&](int64_t begin, int64_t end) {
+      Vector scores(std::min(kKeyBlockSize, num_keys));
+      Vector accumulator(value_depth);
+      for (int64_t row = begin; row < end; ++row) {
+        const int64_t batch = row / num_queries;
+        const ConstVectorMap query_row(query_data + row * depth, depth);
+        const T* batch_key = key_data + batch * num_keys * depth;
+        const T* batch_value = value_data + batch * num_keys * value_depth;
+
+        T running_max = -std::numeric_limits<T>::infinity();
+        T running_sum = T(0);
+        accumulator.setZero();
+        for (int64_t start = 0; start < num_keys; start += kKeyBlockSize) {
+          const int64_t block_size = std::min(kKeyBlockSize, num_keys - start);
+          const ConstMatrixMap key_block(batch_key + start * depth, block_size,
+                                         depth);
+          const ConstMatrixMap value_block(batch_value + start * value_depth,
+                                           block_size, value_depth);
+          auto block_scores = scores.head(block_size);
+          block_scores.noalias() = scale_value * (key_block * query_row);
+
+          // Rescales what was accumulated relative to the previous maximum.
+          const T new_max = std::max(running_max, block_scores.maxCoeff());
+          const T correction = Eigen::numext::exp(running_max - new_max);
+          block_scores = (block_scores.array() - new_max).exp().matrix();
+          running_sum = running_sum * correction + block_scores.sum();
+          accumulator *= correction;
+          accumulator.noalias() += value_block.transpose() * block_scores;
+          running_max = new_max;
+        }
+        Eigen::Map<Vector>(output_data + row * value_depth, value_depth) =
+            accumulator / running_sum;
+      }
+    };
+
+    const int64_t cost_per_query =
+        num_keys * (2 * depth + 2 * value_depth + 10);
+    const DeviceBase::CpuWorkerThreads& worker_threads =
+        *context->device()->tensorflow_cpu_worker_threads();
+    Shard(worker_threads.num_threads, worker_threads.workers,
+          batch_size * num_queries, cost_per_query, compute_queries);
+  }
+};
+
+}  // namespace
+
+REGISTER_KERNEL_BUILDER(Name("_FusedScaledDotProductAttention")
+                            .Device(DEVICE_CPU)
+                            .TypeConstraint<float>("T"),
+                        FusedScaledDotProductAttentionOp<float>);
+
+}  // namespace tensorflow
@@ -0,0 +1,175 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/types/span.h"
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/kernels/ops_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+class FusedScaledDotProductAttentionOpTest : public OpsTestBase {
+ protected:
+  void MakeOp() {
+    TF_ASSERT_OK(NodeDefBuilder("attention", "_FusedScaledDotProductAttention")
+                     .Input(FakeInput(DT_FLOAT))
+                     .Input(FakeInput(DT_FLOAT))
+                     .Input(FakeInput(DT_FLOAT))
+                     .Input(FakeInput(DT_FLOAT))
+                     .Finalize(node_def()));
+    TF_ASSERT_OK(InitOp());
+  }
+
+  // Computes softmax(scale * query * key^T) * value for inputs of shape
+  // [batch, num_queries, depth], [batch, num_keys, depth] and
+  // [batch, num_keys, value_depth].
+  static Tensor Reference(const Tensor& query, const Tensor& key,
+                          const Tensor& value, float scale) {
+    const int64_t batch_size = query.dim_size(0);
+    const int64_t num_queries = query.dim_size(1);
+    const int64_t depth = query.dim_size(2);
+    const int64_t num_keys = key.dim_size(1);
+    const int64_t value_depth = value.dim_size(2);
+    auto q = query.tensor<float, 3>();
+    auto k = key.tensor<float, 3>();
+    auto v = value.tensor<float, 3>();
+    Tensor output(DT_FLOAT, {batch_size, num_queries, value_depth});
+    auto out = output.tensor<float, 3>();
+    for (int64_t b = 0; b < batch_size; ++b) {
+      for (int64_t i = 0; i < num_queries; ++i) {
+        std::vector<float> scores(num_keys);
+        for (int64_t j = 0; j < num_keys; ++j) {
+          float dot = 0;
+          for (int64_t d = 0; d < depth; ++d) dot += q(b, i, d) * k(b, j, d);
+          scores[j] = scale * dot;
+        }
+        const float max = *std::max_element(scores.begin(), scores.end());
+        float sum = 0;
+        for (float& score : scores) {
+          score = std::exp(score - max);
+          sum += score;
+        }
+        for (int64_t d = 0; d < value_depth; ++d) {
+          float result = 0;
+          for (int64_t j = 0; j < num_keys; ++j) {
+            result += scores[j] * v(b, j, d);
+          }
+          out(b, i, d) = result / sum;
+        }
+      }
+    }
+    return output;
+  }
+
+  Tensor AddRandomInput(const TensorShape& shape) {
+    Tensor input(DT_FLOAT, shape);
+    input.flat<float>().setRandom();
+    AddInputFromArray<float>(
+        shape, absl::Span<const float>(input.flat<float>().data(),
+                                       input.NumElements()));
+    return input;
+  }
+
+  void RunAndCompare(int64_t batch_size, int64_t num_queries, int64_t num_keys,
+                     int64_t depth, int64_t value_depth, float scale) {
+    MakeOp();
+    const Tensor query = AddRandomInput({batch_size, num_queries, depth});
+    const Tensor key = AddRandomInput({batch_size, num_keys, depth});
+    const Tensor value = AddRandomInput({batch_size, num_keys, value_depth});
+    AddInputFromArray<float>(TensorShape({}), {scale});
+    TF_ASSERT_OK(RunOpKernel());
+    test::ExpectClose(*GetOutput(0), Reference(query, key, value, scale),
+                      /*atol=*/1e-4, /*rtol=*/1e-4);
+  }
+};
+
+TEST_F(FusedScaledDotProductAttentionOpTest, SingleKeyBlock) {
+  RunAndCompare(/*batch_size=*/2, /*num_queries=*/3, /*num_keys=*/5,
+                /*depth=*/4, /*value_depth=*/6, /*scale=*/0.5f);
+}
+
+TEST_F(FusedScaledDotProductAttentionOpTest, ManyKeyBlocks) {
+  RunAndCompare(/*batch_size=*/3, /*num_queries=*/17, /*num_keys=*/200,
+                /*depth=*/8, /*value_depth=*/8, /*scale=*/1.0f / std::sqrt(8));
+}
+
+TEST_F(FusedScaledDotProductAttentionOpTest, LargeScores) {
+  // Scores this large overflow exp() unless the running maximum is
+  // subtracted.
+  RunAndCompare(/*batch_size=*/1, /*num_queries=*/4, /*num_keys=*/130,
+                /*depth=*/4, /*value_depth=*/2, /*scale=*/200.0f);
+}
+
+TEST_F(FusedScaledDotProductAttentionOpTest, RankFour) {
+  MakeOp();
+  AddInputFromArray<float>(TensorShape({1, 2, 1, 1}), {1, 2});
+  AddInputFromArray<float>(TensorShape({1, 2, 2, 1}), {1, 1, 1, 2});
+  AddInputFromArray<float>(TensorShape({1, 2, 2, 1}), {3, 5, 0, 4});
+  AddInputFromArray<float>(TensorShape({}), {std::log(3.0f)});
+  TF_ASSERT_OK(RunOpKernel());
+
+  // Head 0 attends equally to both keys. Head 1 has scores 2 * log(3) and
+  // 4 * log(3), so weights 1/10 and 9/10.
+  Tensor expected(DT_FLOAT, TensorShape({1, 2, 1, 1}));
+  test::FillValues<float>(&expected, {4.0f, 3.6f});
+  test::ExpectClose(*GetOutput(0), expected);
+}
+
+TEST_F(FusedScaledDotProductAttentionOpTest, NoKeys) {
+  MakeOp();
+  AddInputFromArray<float>(TensorShape({1, 2, 1}), {1, 2});
+  AddInputFromArray<float>(TensorShape({1, 0, 1}), {});
+  AddInputFromArray<float>(TensorShape({1, 0, 3}), {});
+  AddInputFromArray<float>(TensorShape({}), {1.0f});
+  TF_ASSERT_OK(RunOpKernel());
+
+  Tensor expected(DT_FLOAT, TensorShape({1, 2, 3}));
+  test::FillValues<float>(&expected, {0, 0, 0, 0, 0, 0});
+  test::ExpectTensorEqual<float>(*GetOutput(0), expected);
+}
+
+TEST_F(FusedScaledDotProductAttentionOpTest, MismatchedBatchDimensions) {
+  MakeOp();
+  AddInputFromArray<float>(TensorShape({2, 1, 1}), {1, 2});
+  AddInputFromArray<float>(TensorShape({1, 1, 1}), {1});
+  AddInputFromArray<float>(TensorShape({1, 1, 1}), {1});
+  AddInputFromArray<float>(TensorShape({}), {1.0f});
+  absl::Status s = RunOpKernel();
+  EXPECT_TRUE(absl::IsInvalidArgument(s)) << s;
+}
+
+TEST_F(FusedScaledDotProductAttentionOpTest, NonScalarScale) {
+  MakeOp();
+  AddInputFromArray<float>(TensorShape({1, 1, 1}), {1});
+  AddInputFromArray<float>(TensorShape({1, 1, 1}), {1});
+  AddInputFromArray<float>(TensorShape({1, 1, 1}), {1});
+  AddInputFromArray<float>(TensorShape({2}), {1.0f, 2.0f});
+  absl::Status s = RunOpKernel();
+  EXPECT_TRUE(absl::IsInvalidArgument(s)) << s;
+}
+
+}  // namespace
+}  // namespace tensorflow
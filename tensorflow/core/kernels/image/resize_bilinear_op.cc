@@ -22,11 +22,8 @@ limitations under the License.
 
 #include "tensorflow/core/kernels/image/resize_bilinear_op.h"
 
-#ifdef __SSE4_1__
-#include <xmmintrin.h>
-#endif
-
 #include <memory>
+#include <vector>
 
 #include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
 #include "tensorflow/core/framework/op_kernel.h"
@@ -105,112 +102,42 @@ inline void compute_interpolation_weights(const Scaler scaler,
   }
 }
 
-/**
- * Computes the bilinear interpolation from the appropriate 4 float points
- * and the linear interpolation weights.
- */
-inline float compute_lerp(const float top_left, const float top_right,
-                          const float bottom_left, const float bottom_right,
-                          const float x_lerp, const float y_lerp) {
-  const float top = top_left + (top_right - top_left) * x_lerp;
-  const float bottom = bottom_left + (bottom_right - bottom_left) * x_lerp;
-  return top + (bottom - top) * y_lerp;
-}
-
-#ifdef __SSE4_1__
-/* Vector version of the above */
-inline __m128 compute_lerp_v(const __m128 top_left, const __m128 top_right,
-                             const __m128 bottom_left,
-                             const __m128 bottom_right, const __m128 x_lerp,
-                             const __m128 y_lerp) {
-  const __m128 top =
-      _mm_add_ps(top_left, _mm_mul_ps(_mm_sub_ps(top_right, top_left), x_lerp));
-  const __m128 bottom = _mm_add_ps(
-      bottom_left, _mm_mul_ps(_mm_sub_ps(bottom_right, bottom_left), x_lerp));
-  return _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), y_lerp));
-}
-#endif
-
-template <typename T>
-void ResizeLineChannels(const T* const ys_input_lower_ptr,
-                        const T* const ys_input_upper_ptr,
-                        const CachedInterpolation* const xs,
-                        const float ys_lerp, const int64_t out_width,
-                        float* out_y, const int channels) {
+// Interpolates the input row `in_row` horizontally at the columns `xs`, whose
+// indices are scaled by the number of channels, into the `out_width` pixels of
+// `out_row`.
+template <int kChannels, typename T>
+void ResizeRowHorizontally(const T* const in_row,
+                           const CachedInterpolation* const xs,
+                           const int64_t out_width, const int num_channels,
+                           float* const out_row) {
+  const int channels = kChannels > 0 ? kChannels : num_channels;
   for (int64_t x = 0; x < out_width; ++x) {
     const int64_t xs_lower = xs[x].lower;
     const int64_t xs_upper = xs[x].upper;
     const float xs_lerp = xs[x].lerp;
-
     for (int c = 0; c < channels; ++c) {
-      const float top_left(ys_input_lower_ptr[xs_lower + c]);
-      const float top_right(ys_input_lower_ptr[xs_upper + c]);
-      const float bottom_left(ys_input_upper_ptr[xs_lower + c]);
-      const float bottom_right(ys_input_upper_ptr[xs_upper + c]);
-
-      out_y[x * channels + c] = compute_lerp(top_left, top_right, bottom_left,
-                                             bottom_right, xs_lerp, ys_lerp);
+      const float left(in_row[xs_lower + c]);
+      const float right(in_row[xs_upper + c]);
+      out_row[x * channels + c] = left + (right - left) * xs_lerp;
     }
   }
 }
 
-#ifdef __SSE4_1__
-
-// Load 3 floats from the given buffer, which must be of size at least 4.
-template <typename T>
-inline __m128 load_3xfloat_v(T* values) {
-  return _mm_set_ps(0.0f, static_cast<float>(values[2]),
-                    static_cast<float>(values[1]),
-                    static_cast<float>(values[0]));
-}
-
-// Specialize cases that can be done more efficiently.
-template <>
-inline __m128 load_3xfloat_v(float* values) {
-  return _mm_loadu_ps(values);
-}
-
-template <typename T>
-void ResizeLine3ChannelsVector(const T* const ys_input_lower_ptr,
-                               const T* const ys_input_upper_ptr,
-                               const CachedInterpolation* const xs,
-                               const float ys_lerp, const int64_t out_width,
-                               float* out_y) {
-  const __m128 ys_lerp_v = _mm_set1_ps(ys_lerp);
-  // All pixels but the last one can overflow, vectorize the inside of the
-  // row.
-  int64_t x = 0;
-  for (x = 0; x < out_width - 1; ++x) {
-    const int64_t xs_lower = xs[x].lower;
-    const int64_t xs_upper = xs[x].upper;
-    const __m128 xs_lerp_v = _mm_set1_ps(xs[x].lerp);
-
-    const __m128 top_left_v = load_3xfloat_v(ys_input_lower_ptr + xs_lower);
-    const __m128 top_right_v = load_3xfloat_v(ys_input_lower_ptr + xs_upper);
-    const __m128 bottom_left_v = load_3xfloat_v(ys_input_upper_ptr + xs_lower);
-    const __m128 bottom_right_v = load_3xfloat_v(ys_input_upper_ptr + xs_upper);
-
-    _mm_storeu_ps(out_y + x * 3,
-                  compute_lerp_v(top_left_v, top_right_v, bottom_left_v,
-                                 bottom_right_v, xs_lerp_v, ys_lerp_v));
-  }
-  // The last pixel of each row must be done in a non-vectorized way
-  // because we cannot overflow.
-  ResizeLineChannels(ys_input_lower_ptr, ys_input_upper_ptr, xs + out_width - 1,
-                     ys_lerp, 1, out_y + (out_width - 1) * 3, 3);
-}
-#endif
-
+// Resizes the images separably: each input row an output row reads is first
+// interpolated horizontally, and the output row is then interpolated
+// vertically between two such rows. Consecutive output rows that read the same
+// input rows, as when upsampling, reuse their horizontal interpolations.
 template <typename T>
 void resize_image(
-    typename TTypes<T, 4>::ConstTensor images, const int batch_size,
-    const int64_t in_height, const int64_t in_width, const int64_t out_height,
-    const int64_t out_width, const int channels,
+    const CPUDevice& d, typename TTypes<T, 4>::ConstTensor images,
+    const int batch_size, const int64_t in_height, const int64_t in_width,
+    const int64_t out_height, const int64_t out_width, const int channels,
     const std::vector<CachedInterpolation>& xs,
     const std::vector<CachedInterpolation>& ys,
     typename TTypes<float, 4>::Tensor output) TF_ATTRIBUTE_NOINLINE;
 template <typename T>
-void resize_image(typename TTypes<T, 4>::ConstTensor images,
+void resize_image(const CPUDevice& d,
+                  typename TTypes<T, 4>::ConstTensor images,
                   const int batch_size, const int64_t in_height,
                   const int64_t in_width, const int64_t out_height,
                   const int64_t out_width, const int channels,
@@ -218,44 +145,53 @@ void resize_image(typename TTypes<T, 4>::ConstTensor images,
                   const std::vector<CachedInterpolation>& ys,
                   typename TTypes<float, 4>::Tensor output) {
   const int64_t in_row_size = in_width * channels;
-  const int64_t in_batch_num_values = in_height * in_row_size;
   const int64_t out_row_size = out_width * channels;
-
-  const T* input_b_ptr = images.data();
   const CachedInterpolation* xs = xs_vec.data();
 
-  if (channels == 3) {
-    float* output_y_ptr = output.data();
-    for (int b = 0; b < batch_size; ++b) {
-      for (int64_t y = 0; y < out_height; ++y) {
-        const T* ys_input_lower_ptr = input_b_ptr + ys[y].lower * in_row_size;
-        const T* ys_input_upper_ptr = input_b_ptr + ys[y].upper * in_row_size;
-#ifdef __SSE4_1__
-        ResizeLine3ChannelsVector(ys_input_lower_ptr, ys_input_upper_ptr, xs,
-                                  ys[y].lerp, out_width, output_y_ptr);
-#else
-        ResizeLineChannels(ys_input_lower_ptr, ys_input_upper_ptr, xs,
-                           ys[y].lerp, out_width, output_y_ptr, 3);
-#endif
-        output_y_ptr += out_row_size;
+  auto resize_rows = [&](int64_t begin, int64_t end) {
+    // Two horizontally interpolated input rows, and the indices of these rows
+    // in the batch, or -1.
+    std::vector<float> buffer(2 * out_row_size);
+    float* rows[2] = {buffer.data(), buffer.data() + out_row_size};
+    int64_t row_indices[2] = {-1, -1};
+    // Returns the slot holding the horizontal interpolation of the input row
+    // `index` of the batch, computing it in a slot other than `keep` if needed.
+    auto get_row = [&](int64_t index, int keep) {
+      for (int slot = 0; slot < 2; ++slot) {
+        if (row_indices[slot] == index) return slot;
       }
-      input_b_ptr += in_batch_num_values;
-    }
-  } else {
-    float* output_y_ptr = output.data();
-    for (int b = 0; b < batch_size; ++b) {
-      for (int64_t y = 0; y < out_height; ++y) {
-        const T* ys_input_lower_ptr = input_b_ptr + ys[y].lower * in_row_size;
-        const T* ys_input_upper_ptr = input_b_ptr + ys[y].upper * in_row_size;
-
-        ResizeLineChannels(ys_input_lower_ptr, ys_input_upper_ptr, xs,
-                           ys[y].lerp, out_width, output_y_ptr, channels);
-
-        output_y_ptr += out_row_size;
+      const int slot = keep == 0 ? 1 : 0;
+      const T* in_row = images.data() + index * in_row_size;
+      if (channels == 3) {
+        ResizeRowHorizontally<3>(in_row, xs, out_width, channels, rows[slot]);
+      } else {
+        ResizeRowHorizontally<0>(in_row, xs, out_width, channels, rows[slot]);
+      }
+      row_indices[slot] = index;
+      return slot;
+    };
+
+    for (int64_t i = begin; i < end; ++i) {
+      const int64_t b = i / out_height;
+      const int64_t y = i % out_height;
+      const int top = get_row(b * in_height + ys[y].lower, /*keep=*/-1);
+      const int bottom = get_row(b * in_height + ys[y].upper, top);
+      const float* top_row = rows[top];
+      const float* bottom_row = rows[bottom];
+      const float ys_lerp = ys[y].lerp;
+      float* out_row = output.data() + i * out_row_size;
+      for (int64_t j = 0; j < out_row_size; ++j) {
+        out_row[j] = top_row[j] + (bottom_row[j] - top_row[j]) * ys_lerp;
       }
-      input_b_ptr += in_batch_num_values;
     }
-  }
+  };
+  const Eigen::TensorOpCost cost(
+      /*bytes_loaded=*/2 * out_row_size * sizeof(T),
+      /*bytes_stored=*/out_row_size * sizeof(float),
+      /*compute_cycles=*/3 * out_row_size *
+          (Eigen::TensorOpCost::AddCost<float>() +
+           Eigen::TensorOpCost::MulCost<float>()));
+  d.parallelFor(batch_size * out_height, cost, resize_rows);
 }
 
 // Casts from float16 to T.
@@ -324,7 +260,7 @@ struct ResizeBilinear<CPUDevice, T> {
       xs[i].upper *= channels;
     }
 
-    resize_image<T>(images, batch_size, in_height, in_width, out_height,
+    resize_image<T>(d, images, batch_size, in_height, in_width, out_height,
                     out_width, channels, xs, ys, output);
   }
 };
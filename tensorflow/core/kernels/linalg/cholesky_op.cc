@@ -43,12 +43,39 @@ class CholeskyOp : public LinearAlgebraOp<Scalar> {
       // Therefore, we return X.
       return;
     }
+    Factorize<Matrix>(input, &outputs->at(0));
+  }
+
+  bool ComputeMatrixBatch(OpKernelContext* context,
+                          const TensorShapes& input_matrix_shapes,
+                          const TensorInputs& inputs,
+                          const TensorOutputs& outputs, int64_t begin,
+                          int64_t end) final {
+    return CallWithFixedMatrixSize(
+        input_matrix_shapes[0].dim_size(0), [&](auto size) {
+          constexpr int kSize = decltype(size)::value;
+          using FixedMatrix =
+              Eigen::Matrix<Scalar, kSize, kSize, Eigen::RowMajor>;
+          const Scalar* in = inputs[0]->flat<Scalar>().data();
+          Scalar* out = outputs[0]->flat<Scalar>().data();
+          for (int64_t i = begin; i < end; ++i) {
+            Eigen::Map<FixedMatrix> output(out + i * kSize * kSize);
+            Factorize<FixedMatrix>(
+                Eigen::Map<const FixedMatrix>(in + i * kSize * kSize),
+                &output);
+          }
+        });
+  }
+
+ private:
+  // Writes the Cholesky factor of `input` to `output`, using a decomposition
+  // of type Eigen::LLT<MatrixType>.
+  template <typename MatrixType, typename Input, typename Output>
+  static void Factorize(const Input& input, Output* output) {
     // Perform the actual LL^T Cholesky decomposition. This will only use
     // the lower triangular part of data_in by default. The upper triangular
     // part of the matrix will not be read.
-    Eigen::LLT<
-        Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>
-        llt_decomposition(input);
+    Eigen::LLT<MatrixType> llt_decomposition(input);
 
     // If decomposition fails, fill output with NaNs so the failure can
     // be detected at runtime.
@@ -57,11 +84,11 @@ class CholeskyOp : public LinearAlgebraOp<Scalar> {
                       "Eigen::LLT failed with error code "
                    << llt_decomposition.info()
                    << ". Filling lower-triangular output with NaNs.";
-      outputs->at(0).template triangularView<Eigen::Lower>().fill(
+      output->template triangularView<Eigen::Lower>().fill(
           Eigen::NumTraits<Scalar>::quiet_NaN());
     } else {
       // Output the lower triangular in a dense form.
-      outputs->at(0) = llt_decomposition.matrixL();
+      *output = llt_decomposition.matrixL();
     }
   }
 };
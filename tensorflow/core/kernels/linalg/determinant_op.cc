@@ -46,10 +46,9 @@ namespace tensorflow {
 //
 // Returns the log of the absolute value of the determinant, and its sign in
 // 'sign'.
-template <class Scalar>
+template <class MatrixType, class Scalar>
 static typename Eigen::NumTraits<Scalar>::Real SLogDet(
-    const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>& inputs,
-    Scalar* sign) {
+    const MatrixType& inputs, Scalar* sign) {
   using RealScalar = typename Eigen::NumTraits<Scalar>::Real;
   RealScalar log_abs_det = 0;
   *sign = 1;
@@ -57,9 +56,8 @@ static typename Eigen::NumTraits<Scalar>::Real SLogDet(
   // (https://en.wikipedia.org/wiki/Determinant)
   if (inputs.size() > 0) {
     // Compute the log determinant through a Partially Pivoted LU decomposition
-    using Eigen::Dynamic;
-    Eigen::PartialPivLU<Eigen::Matrix<Scalar, Dynamic, Dynamic>> lu(inputs);
-    Eigen::Matrix<Scalar, Dynamic, Dynamic> LU = lu.matrixLU();
+    Eigen::PartialPivLU<MatrixType> lu(inputs);
+    const MatrixType& LU = lu.matrixLU();
     *sign = lu.permutationP().determinant();
     auto diag = LU.diagonal().array().eval();
     auto abs_diag = diag.cwiseAbs().eval();
@@ -69,6 +67,26 @@ static typename Eigen::NumTraits<Scalar>::Real SLogDet(
   return log_abs_det;
 }
 
+// Calls `fn(matrix, i)` for each matrix i in [begin, end) of the batch of
+// `inputs`, as a fixed-size Eigen matrix, if the matrices are small enough.
+// Returns false otherwise.
+template <class Scalar, class Fn>
+static bool ForEachFixedSizeMatrix(const Tensor& inputs, int64_t size,
+                                   int64_t begin, int64_t end, Fn fn) {
+  return CallWithFixedMatrixSize(size, [&](auto fixed_size) {
+    constexpr int kSize = decltype(fixed_size)::value;
+    using FixedMatrix = Eigen::Matrix<Scalar, kSize, kSize>;
+    using RowMajorFixedMatrix =
+        Eigen::Matrix<Scalar, kSize, kSize, Eigen::RowMajor>;
+    const Scalar* in = inputs.flat<Scalar>().data();
+    for (int64_t i = begin; i < end; ++i) {
+      const FixedMatrix matrix =
+          Eigen::Map<const RowMajorFixedMatrix>(in + i * kSize * kSize);
+      fn(matrix, i);
+    }
+  });
+}
+
 template <class Scalar>
 class LogDeterminantOp : public LinearAlgebraOp<Scalar> {
  public:
@@ -91,6 +109,20 @@ class LogDeterminantOp : public LinearAlgebraOp<Scalar> {
     outputs->at(0)(0, 0) = sign;
     outputs->at(1)(0, 0) = log_abs_det;
   }
+
+  bool ComputeMatrixBatch(OpKernelContext* context,
+                          const TensorShapes& input_matrix_shapes,
+                          const TensorInputs& inputs,
+                          const TensorOutputs& outputs, int64_t begin,
+                          int64_t end) final {
+    Scalar* signs = outputs[0]->flat<Scalar>().data();
+    Scalar* log_abs_dets = outputs[1]->flat<Scalar>().data();
+    return ForEachFixedSizeMatrix<Scalar>(
+        *inputs[0], input_matrix_shapes[0].dim_size(0), begin, end,
+        [&](const auto& matrix, int64_t i) {
+          log_abs_dets[i] = SLogDet(matrix, &signs[i]);
+        });
+  }
 };
 
 template <class Scalar>
@@ -113,6 +145,21 @@ class DeterminantOp : public LinearAlgebraOp<Scalar> {
         &sign);
     outputs->at(0)(0, 0) = sign * std::exp(log_abs_det);
   }
+
+  bool ComputeMatrixBatch(OpKernelContext* context,
+                          const TensorShapes& input_matrix_shapes,
+                          const TensorInputs& inputs,
+                          const TensorOutputs& outputs, int64_t begin,
+                          int64_t end) final {
+    Scalar* dets = outputs[0]->flat<Scalar>().data();
+    return ForEachFixedSizeMatrix<Scalar>(
+        *inputs[0], input_matrix_shapes[0].dim_size(0), begin, end,
+        [&](const auto& matrix, int64_t i) {
+          Scalar sign;
+          const RealScalar log_abs_det = SLogDet(matrix, &sign);
+          dets[i] = sign * std::exp(log_abs_det);
+        });
+  }
 };
 
 #if GOOGLE_CUDA
@@ -109,6 +109,10 @@ void LinearAlgebraOp<InputScalar, OutputScalar>::Compute(
   // Process the individual matrix problems in parallel using a threadpool.
   auto shard = [this, &inputs, &input_matrix_shapes, &outputs,
                 &output_matrix_shapes, context](int64_t begin, int64_t end) {
+    if (ComputeMatrixBatch(context, input_matrix_shapes, inputs, outputs, begin,
+                           end)) {
+      return;
+    }
     for (int64_t i = begin; i < end; ++i) {
       ComputeTensorSlice(context, i, inputs, input_matrix_shapes, outputs,
                          output_matrix_shapes);
@@ -20,6 +20,7 @@ limitations under the License.
 // computations across different threads if necessary.
 #include <algorithm>
 #include <cstdint>
+#include <type_traits>
 
 #include "Eigen/Core"  // from @eigen_archive
 #include "tensorflow/core/framework/kernel_def_builder.h"
@@ -35,6 +36,40 @@ limitations under the License.
 
 namespace tensorflow {
 
+// If `n` is one of the sizes of the small square matrices for which ops use
+// fixed-size Eigen matrices, calls `fn(std::integral_constant<int, n>())` and
+// returns true. Otherwise returns false. Fixed-size Eigen matrices live on the
+// stack and their decompositions are unrolled, which matters when a batch holds
+// many tiny matrices.
+template <typename Fn>
+bool CallWithFixedMatrixSize(int64_t n, Fn fn) {
+  switch (n) {
+    case 2:
+      fn(std::integral_constant<int, 2>());
+      return true;
+    case 3:
+      fn(std::integral_constant<int, 3>());
+      return true;
+    case 4:
+      fn(std::integral_constant<int, 4>());
+      return true;
+    case 5:
+      fn(std::integral_constant<int, 5>());
+      return true;
+    case 6:
+      fn(std::integral_constant<int, 6>());
+      return true;
+    case 7:
+      fn(std::integral_constant<int, 7>());
+      return true;
+    case 8:
+      fn(std::integral_constant<int, 8>());
+      return true;
+    default:
+      return false;
+  }
+}
+
 // Base class for linear algebra operators.
 template <class InputScalar, class OutputScalar = InputScalar>
 class LinearAlgebraOp : public OpKernel {
@@ -45,6 +80,8 @@ class LinearAlgebraOp : public OpKernel {
 
  protected:
   using TensorShapes = absl::InlinedVector<TensorShape, 4UL>;
+  using TensorInputs = absl::InlinedVector<const Tensor*, 4UL>;
+  using TensorOutputs = absl::InlinedVector<Tensor*, 4UL>;
   // Returns the number of leading inputs that are to be treated as matrix
   // inputs. By default this is all the inputs. Derived classes can override
   // this to tell the base class to ignore one or more trailing inputs.
@@ -152,9 +189,21 @@ class LinearAlgebraOp : public OpKernel {
                              const InputConstMatrixMaps& inputs,
                              OutputMatrixMaps* outputs) = 0;
 
+  // Performs the computations of the matrices [begin, end) of the batch at
+  // once and returns true, or returns false to have ComputeMatrix called for
+  // each of them instead. The matrices of input i and output i are stored
+  // contiguously in row major order in `inputs[i]` and `outputs[i]`. Derived
+  // classes can override this to avoid the per-matrix overhead of
+  // ComputeMatrix, which dominates for batches of tiny matrices.
+  virtual bool ComputeMatrixBatch(OpKernelContext* context,
+                                  const TensorShapes& input_matrix_shapes,
+                                  const TensorInputs& inputs,
+                                  const TensorOutputs& outputs, int64_t begin,
+                                  int64_t end) {
+    return false;
+  }
+
  private:
-  using TensorInputs = absl::InlinedVector<const Tensor*, 4UL>;
-  using TensorOutputs = absl::InlinedVector<Tensor*, 4UL>;
   // This function maps 2-d slices (matrices) of the input and output tensors
   // using Eigen::Map and calls ComputeMatrix implemented in terms of the
   // Eigen::MatrixBase API by the derived class.
@@ -207,7 +256,9 @@ extern template class LinearAlgebraOp<complex128>;
   using ConstMatrixMap = typename Base::ConstMatrixMap;       \
   using ConstMatrixMaps = typename Base::ConstMatrixMaps;     \
   using ConstVectorMap = typename Base::ConstVectorMap;       \
-  using TensorShapes = typename Base::TensorShapes;
+  using TensorShapes = typename Base::TensorShapes;           \
+  using TensorInputs = typename Base::TensorInputs;           \
+  using TensorOutputs = typename Base::TensorOutputs;
 
 #define REGISTER_LINALG_OP_CPU(OpName, OpClass, Scalar) \
   REGISTER_KERNEL_BUILDER(                              \
@@ -0,0 +1,191 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Eigen/Core"  // from @eigen_archive
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/kernels/ops_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/lib/gtl/array_slice.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+using Matrix =
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+using MatrixMap = Eigen::Map<Matrix>;
+
+// Matrices of this size are not handled by CallWithFixedMatrixSize, so ops
+// on them take the generic ComputeMatrix path.
+constexpr int64_t kGenericSize = 9;
+
+// Returns a batch of `batch` random [rows, cols] matrices. With `spd`, the
+// square matrices are symmetric positive definite, otherwise they are
+// diagonally dominant.
+Tensor RandomMatrices(int64_t batch, int64_t rows, int64_t cols, bool spd) {
+  Tensor t(DT_DOUBLE, TensorShape({batch, rows, cols}));
+  t.flat<double>().setRandom();
+  for (int64_t i = 0; i < batch; ++i) {
+    MatrixMap m(t.flat<double>().data() + i * rows * cols, rows, cols);
+    if (spd) m = (m * m.transpose()).eval();
+    if (rows == cols) m.diagonal().array() += rows;
+  }
+  return t;
+}
+
+// Returns the [batch, size, cols] tensor whose matrices hold the matrices of
+// `t` in their top-left corner. With `identity`, the rest of the diagonal is
+// set to one, so that square matrices have the same factorizations,
+// determinants and solutions as those of `t`.
+Tensor Embed(const Tensor& t, int64_t size, int64_t cols, bool identity) {
+  const int64_t batch = t.dim_size(0);
+  const int64_t rows = t.dim_size(1);
+  Tensor embedded(DT_DOUBLE, TensorShape({batch, size, cols}));
+  for (int64_t i = 0; i < batch; ++i) {
+    MatrixMap out(embedded.flat<double>().data() + i * size * cols, size,
+                  cols);
+    out.setZero();
+    if (identity) out.diagonal().setOnes();
+    out.topLeftCorner(rows, t.dim_size(2)) = Eigen::Map<const Matrix>(
+        t.flat<double>().data() + i * rows * t.dim_size(2), rows,
+        t.dim_size(2));
+  }
+  return embedded;
+}
+
+// Returns the top-left [rows, cols] corners of the matrices of `t`.
+Tensor TopLeft(const Tensor& t, int64_t rows, int64_t cols) {
+  const int64_t batch = t.dim_size(0);
+  Tensor corner(DT_DOUBLE, TensorShape({batch, rows, cols}));
+  for (int64_t i = 0; i < batch; ++i) {
+    MatrixMap(corner.flat<double>().data() + i * rows * cols, rows, cols) =
+        Eigen::Map<const Matrix>(
+            t.flat<double>().data() + i * t.dim_size(1) * t.dim_size(2),
+            t.dim_size(1), t.dim_size(2))
+            .topLeftCorner(rows, cols);
+  }
+  return corner;
+}
+
+// Checks the ComputeMatrixBatch path taken for batches of small matrices
+// against the generic path taken for the same matrices embedded in larger
+// ones.
+class FixedSizeMatrixBatchTest : public OpsTestBase {
+ protected:
+  // Runs `op` on `inputs` and returns its outputs.
+  absl::Status RunOp(const std::string& op, const std::vector<Tensor>& inputs,
+                     std::vector<Tensor>* outputs, bool adjoint = false) {
+    inputs_.clear();
+    NodeDefBuilder builder("linalg", op);
+    for (int i = 0; i < inputs.size(); ++i) {
+      builder.Input(FakeInput(DT_DOUBLE));
+    }
+    if (op == "MatrixSolve") builder.Attr("adjoint", adjoint);
+    TF_CHECK_OK(builder.Finalize(node_def()));
+    TF_RETURN_IF_ERROR(InitOp());
+    for (const Tensor& input : inputs) {
+      AddInputFromArray<double>(
+          input.shape(), gtl::ArraySlice<double>(input.flat<double>().data(),
+                                                 input.NumElements()));
+    }
+    TF_RETURN_IF_ERROR(RunOpKernel());
+    outputs->clear();
+    for (int i = 0; i < kernel_->num_outputs(); ++i) {
+      outputs->push_back(*GetOutput(i));
+    }
+    return absl::OkStatus();
+  }
+};
+
+constexpr double kTolerance = 1e-10;
+
+TEST_F(FixedSizeMatrixBatchTest, Cholesky) {
+  for (int64_t n = 2; n <= 8; ++n) {
+    const Tensor input = RandomMatrices(/*batch=*/10, n, n, /*spd=*/true);
+    std::vector<Tensor> fixed, generic;
+    TF_ASSERT_OK(RunOp("Cholesky", {input}, &fixed));
+    TF_ASSERT_OK(RunOp(
+        "Cholesky", {Embed(input, kGenericSize, kGenericSize, true)},
+        &generic));
+    test::ExpectTensorNear<double>(TopLeft(generic[0], n, n), fixed[0],
+                                   kTolerance);
+  }
+}
+
+TEST_F(FixedSizeMatrixBatchTest, CholeskyFailureFillsNaNs) {
+  Tensor input = RandomMatrices(/*batch=*/2, 3, 3, /*spd=*/true);
+  // The second matrix is not positive definite.
+  MatrixMap(input.flat<double>().data() + 9, 3, 3).diagonal().setConstant(-1);
+  std::vector<Tensor> outputs;
+  TF_ASSERT_OK(RunOp("Cholesky", {input}, &outputs));
+  auto out = outputs[0].tensor<double, 3>();
+  EXPECT_FALSE(std::isnan(out(0, 2, 0)));
+  EXPECT_TRUE(std::isnan(out(1, 2, 0)));
+}
+
+TEST_F(FixedSizeMatrixBatchTest, Determinants) {
+  for (int64_t n = 2; n <= 8; ++n) {
+    const Tensor input = RandomMatrices(/*batch=*/10, n, n, /*spd=*/false);
+    const Tensor embedded = Embed(input, kGenericSize, kGenericSize, true);
+    for (const char* op : {"MatrixDeterminant", "LogMatrixDeterminant"}) {
+      std::vector<Tensor> fixed, generic;
+      TF_ASSERT_OK(RunOp(op, {input}, &fixed));
+      TF_ASSERT_OK(RunOp(op, {embedded}, &generic));
+      ASSERT_EQ(fixed.size(), generic.size());
+      for (int i = 0; i < fixed.size(); ++i) {
+        test::ExpectTensorNear<double>(generic[i], fixed[i], kTolerance);
+      }
+    }
+  }
+}
+
+TEST_F(FixedSizeMatrixBatchTest, MatrixSolve) {
+  for (const bool adjoint : {false, true}) {
+    for (int64_t n = 2; n <= 8; ++n) {
+      const Tensor matrix = RandomMatrices(/*batch=*/10, n, n, /*spd=*/false);
+      const Tensor rhs = RandomMatrices(/*batch=*/10, n, /*cols=*/3, false);
+      std::vector<Tensor> fixed, generic;
+      TF_ASSERT_OK(RunOp("MatrixSolve", {matrix, rhs}, &fixed, adjoint));
+      TF_ASSERT_OK(RunOp("MatrixSolve",
+                         {Embed(matrix, kGenericSize, kGenericSize, true),
+                          Embed(rhs, kGenericSize, 3, false)},
+                         &generic, adjoint));
+      test::ExpectTensorNear<double>(TopLeft(generic[0], n, 3), fixed[0],
+                                     kTolerance);
+    }
+  }
+}
+
+TEST_F(FixedSizeMatrixBatchTest, MatrixSolveSingular) {
+  Tensor matrix = RandomMatrices(/*batch=*/2, 4, 4, /*spd=*/false);
+  MatrixMap(matrix.flat<double>().data() + 16, 4, 4).setZero();
+  const Tensor rhs = RandomMatrices(/*batch=*/2, 4, /*cols=*/1, false);
+  std::vector<Tensor> outputs;
+  EXPECT_TRUE(
+      errors::IsInvalidArgument(RunOp("MatrixSolve", {matrix, rhs}, &outputs)));
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -82,13 +82,54 @@ class MatrixSolveOp : public LinearAlgebraOp<Scalar> {
       return;
     }
     Eigen::PartialPivLU<Matrix> lu_decomposition(matrix.rows());
+    Solve(context, matrix, rhs, &lu_decomposition, &outputs->at(0));
+  }
+
+  bool ComputeMatrixBatch(OpKernelContext* context,
+                          const TensorShapes& input_matrix_shapes,
+                          const TensorInputs& inputs,
+                          const TensorOutputs& outputs, int64_t begin,
+                          int64_t end) final {
+    const int64_t num_rhss = input_matrix_shapes[1].dim_size(1);
+    if (num_rhss == 0) return false;
+    return CallWithFixedMatrixSize(
+        input_matrix_shapes[0].dim_size(0), [&](auto size) {
+          constexpr int kSize = decltype(size)::value;
+          using FixedMatrix =
+              Eigen::Matrix<Scalar, kSize, kSize, Eigen::RowMajor>;
+          using FixedRowsMatrix =
+              Eigen::Matrix<Scalar, kSize, Eigen::Dynamic, Eigen::RowMajor>;
+          const Scalar* matrices = inputs[0]->flat<Scalar>().data();
+          const Scalar* rhss = inputs[1]->flat<Scalar>().data();
+          Scalar* out = outputs[0]->flat<Scalar>().data();
+          Eigen::PartialPivLU<FixedMatrix> lu_decomposition;
+          for (int64_t i = begin; i < end; ++i) {
+            Eigen::Map<FixedRowsMatrix> output(out + i * kSize * num_rhss,
+                                               kSize, num_rhss);
+            Solve(context,
+                  Eigen::Map<const FixedMatrix>(matrices + i * kSize * kSize),
+                  Eigen::Map<const FixedRowsMatrix>(
+                      rhss + i * kSize * num_rhss, kSize, num_rhss),
+                  &lu_decomposition, &output);
+            if (!context->status().ok()) return;
+          }
+        });
+  }
+
+ private:
+  // Solves `matrix` * `output` = `rhs` with `lu_decomposition`.
+  template <typename Decomposition, typename MatrixInput, typename RhsInput,
+            typename Output>
+  void Solve(OpKernelContext* context, const MatrixInput& matrix,
+             const RhsInput& rhs, Decomposition* lu_decomposition,
+             Output* output) {
     if (adjoint_) {
       // TODO(rmlarsen): For Eigen 3.2, this creates a temporary copy.
       // Make sure to backport: https://bitbucket.org/eigen/eigen/commits/
       // bd2219a74c96dfe3f6bc2c23588749e36d2d8173
-      lu_decomposition.compute(matrix.adjoint());
+      lu_decomposition->compute(matrix.adjoint());
     } else {
-      lu_decomposition.compute(matrix);
+      lu_decomposition->compute(matrix);
     }
 
     // PartialPivLU cannot give strong guarantees on invertibility,
@@ -97,7 +138,7 @@ class MatrixSolveOp : public LinearAlgebraOp<Scalar> {
     // matrices that are exactly singular, or due to underflow if this
     // code is run with denormals being flushed to zero.
     const RealScalar min_abs_pivot =
-        lu_decomposition.matrixLU().diagonal().cwiseAbs().minCoeff();
+        lu_decomposition->matrixLU().diagonal().cwiseAbs().minCoeff();
     OP_REQUIRES(context, min_abs_pivot > RealScalar(0),
                 errors::InvalidArgument(kErrMsg));
 
@@ -105,10 +146,9 @@ class MatrixSolveOp : public LinearAlgebraOp<Scalar> {
     // The necessary changes to Eigen are in
     // https://bitbucket.org/eigen/eigen/pull-requests/174/
     // add-matrix-condition-number-estimation/diff
-    outputs->at(0) = lu_decomposition.solve(rhs);
+    *output = lu_decomposition->solve(rhs);
   }
 
- private:
   bool adjoint_;
 
   MatrixSolveOp(const MatrixSolveOp&) = delete;
@@ -16,10 +16,15 @@ limitations under the License.
 #include "tensorflow/core/kernels/lookup_table_op.h"
 #define EIGEN_USE_THREADS
 
+#include <algorithm>
+#include <array>
+#include <functional>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 
+#include "absl/types/span.h"
 #include "tensorflow/core/framework/register_types.h"
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/framework/variant.h"
@@ -36,11 +41,152 @@ std::string UniqueNodeName(const std::string& base) {
   return strings::StrCat(base, "/", counter.fetch_add(1), "/", random::New64());
 }
 
+// Hash map split into shards that each have their own lock, so that
+// concurrent lookups and inserts of different keys rarely contend on the same
+// mutex. Operations on a batch of keys lock each shard once and process its
+// keys in their original order, so the last of duplicate keys in a batch wins
+// as with a single map.
+template <class K, class V>
+class ShardedHashMap {
+ public:
+  using Map = std::unordered_map<K, V>;
+
+  size_t size() const {
+    size_t size = 0;
+    for (const Shard& shard : shards_) {
+      tf_shared_lock l(shard.mu);
+      size += shard.map.size();
+    }
+    return size;
+  }
+
+  // Calls `fn(map, i)` for every index `i` of `keys`, with `map` the read-only
+  // shard of keys(i).
+  template <typename KeysFlat, typename Fn>
+  void ForEachKeyShared(const KeysFlat& keys, Fn fn) const {
+    ShardOrder order(keys);
+    for (int s = 0; s < kNumShards; ++s) {
+      if (order.empty(s)) continue;
+      const Shard& shard = shards_[s];
+      tf_shared_lock l(shard.mu);
+      for (int64_t i : order.indices(s)) fn(shard.map, i);
+    }
+  }
+
+  // Like ForEachKeyShared, with `map` the mutable shard of keys(i).
+  template <typename KeysFlat, typename Fn>
+  void ForEachKeyExclusive(const KeysFlat& keys, Fn fn) {
+    ShardOrder order(keys);
+    for (int s = 0; s < kNumShards; ++s) {
+      if (order.empty(s)) continue;
+      Shard& shard = shards_[s];
+      mutex_lock l(shard.mu);
+      for (int64_t i : order.indices(s)) fn(&shard.map, i);
+    }
+  }
+
+  // Replaces the content of the map with the calls to `fn(map, i)` for every
+  // index `i` of `keys`, without exposing an intermediate state.
+  template <typename KeysFlat, typename Fn>
+  void ClearAndInsert(const KeysFlat& keys, Fn fn)
+      TF_NO_THREAD_SAFETY_ANALYSIS {
+    for (Shard& shard : shards_) shard.mu.lock();
+    for (Shard& shard : shards_) shard.map.clear();
+    for (int64_t i = 0; i < keys.size(); ++i) {
+      fn(&shards_[ShardOf(SubtleMustCopyIfIntegral(keys(i)))].map, i);
+    }
+    for (Shard& shard : shards_) shard.mu.unlock();
+  }
+
+  // Returns `fn(size, maps)` for a consistent view of all shards, where `size`
+  // is their total number of entries.
+  template <typename Fn>
+  auto ReadAll(Fn fn) const TF_NO_THREAD_SAFETY_ANALYSIS {
+    std::array<const Map*, kNumShards> maps;
+    int64_t size = 0;
+    for (int s = 0; s < kNumShards; ++s) {
+      shards_[s].mu.lock_shared();
+      maps[s] = &shards_[s].map;
+      size += maps[s]->size();
+    }
+    auto result = fn(size, maps);
+    for (const Shard& shard : shards_) shard.mu.unlock_shared();
+    return result;
+  }
+
+  int64_t MemoryUsed() const {
+    int64_t ret = 0;
+    for (const Shard& shard : shards_) {
+      tf_shared_lock l(shard.mu);
+      for (unsigned i = 0; i < shard.map.bucket_count(); ++i) {
+        size_t bucket_size = shard.map.bucket_size(i);
+        if (bucket_size == 0) {
+          ret++;
+        } else {
+          ret += bucket_size;
+        }
+      }
+    }
+    return ret;
+  }
+
+  static constexpr int kNumShards = 16;
+
+ private:
+  struct Shard {
+    mutable mutex mu;
+    Map map TF_GUARDED_BY(mu);
+  };
+
+  // Indices of a batch of keys grouped by shard, in their original order.
+  class ShardOrder {
+   public:
+    template <typename KeysFlat>
+    explicit ShardOrder(const KeysFlat& keys) : order_(keys.size()) {
+      gtl::InlinedVector<int, 16> shard_of(keys.size());
+      offsets_.fill(0);
+      for (int64_t i = 0; i < keys.size(); ++i) {
+        shard_of[i] = ShardOf(SubtleMustCopyIfIntegral(keys(i)));
+        ++offsets_[shard_of[i] + 1];
+      }
+      for (int s = 0; s < kNumShards; ++s) offsets_[s + 1] += offsets_[s];
+      std::array<int64_t, kNumShards> next;
+      std::copy(offsets_.begin(), offsets_.end() - 1, next.begin());
+      for (int64_t i = 0; i < keys.size(); ++i) {
+        order_[next[shard_of[i]]++] = i;
+      }
+    }
+
+    bool empty(int s) const { return offsets_[s] == offsets_[s + 1]; }
+
+    absl::Span<const int64_t> indices(int s) const {
+      return absl::MakeConstSpan(order_).subspan(offsets_[s],
+                                                 offsets_[s + 1] - offsets_[s]);
+    }
+
+   private:
+    gtl::InlinedVector<int64_t, 16> order_;
+    std::array<int64_t, kNumShards + 1> offsets_;
+  };
+
+  static int ShardOf(const K& key) {
+    // Use the high bits of a multiplicative hash, so that the shard is
+    // independent of the bucket that the shard's map picks for the key.
+    const uint64 hash = static_cast<uint64>(std::hash<K>()(key));
+    return static_cast<int>((hash * 0x9E3779B97F4A7C15ull) >> 60);
+  }
+
+  Shard shards_[kNumShards];
+};
+
 // Lookup table that wraps an unordered_map, where the key and value data type
 // is specified. Each individual value must be a scalar. If vector values are
 // required, use MutableHashTableOfTensors.
 //
 // This table is mutable and thread safe - Insert can be called at any time.
+// The map is split into lock-striped shards, so concurrent calls mostly
+// proceed in parallel. A concurrent Find may observe a subset of the keys of
+// an Insert or Remove batch; ImportValues replaces the content atomically.
 //
 // Sample use case:
 //
@@ -55,10 +201,7 @@ class MutableHashTableOfScalars final : public LookupInterface {
  public:
   MutableHashTableOfScalars(OpKernelContext* ctx, OpKernel* kernel) {}
 
-  size_t size() const override {
-    tf_shared_lock l(mu_);
-    return table_.size();
-  }
+  size_t size() const override { return table_.size(); }
 
   absl::Status Find(OpKernelContext* ctx, const Tensor& key, Tensor* value,
                     const Tensor& default_value) override {
@@ -70,18 +213,18 @@ class MutableHashTableOfScalars final : public LookupInterface {
     int64_t default_total = default_flat.size();
     bool is_full_size_default = (total == default_total);
 
-    tf_shared_lock l(mu_);
-    for (int64_t i = 0; i < key_values.size(); ++i) {
-      // is_full_size_default is true:
-      //   Each key has an independent default value, key_values(i)
-      //   corresponding uses default_flat(i) as its default value.
-      //
-      // is_full_size_default is false:
-      //   All keys will share the default_flat(0) as default value.
-      value_values(i) = gtl::FindWithDefault(
-          table_, SubtleMustCopyIfIntegral(key_values(i)),
-          is_full_size_default ? default_flat(i) : default_flat(0));
-    }
+    table_.ForEachKeyShared(
+        key_values, [&](const std::unordered_map<K, V>& table, int64_t i) {
+          // is_full_size_default is true:
+          //   Each key has an independent default value, key_values(i)
+          //   corresponding uses default_flat(i) as its default value.
+          //
+          // is_full_size_default is false:
+          //   All keys will share the default_flat(0) as default value.
+          value_values(i) = gtl::FindWithDefault(
+              table, SubtleMustCopyIfIntegral(key_values(i)),
+              is_full_size_default ? default_flat(i) : default_flat(0));
+        });
 
     return absl::OkStatus();
   }
@@ -90,13 +233,14 @@ class MutableHashTableOfScalars final : public LookupInterface {
     const auto key_values = keys.flat<K>();
     const auto value_values = values.flat<V>();
 
-    mutex_lock l(mu_);
-    if (clear) {
-      table_.clear();
-    }
-    for (int64_t i = 0; i < key_values.size(); ++i) {
-      gtl::InsertOrUpdate(&table_, SubtleMustCopyIfIntegral(key_values(i)),
+    auto insert = [&](std::unordered_map<K, V>* table, int64_t i) {
+      gtl::InsertOrUpdate(table, SubtleMustCopyIfIntegral(key_values(i)),
                           SubtleMustCopyIfIntegral(value_values(i)));
+    };
+    if (clear) {
+      table_.ClearAndInsert(key_values, insert);
+    } else {
+      table_.ForEachKeyExclusive(key_values, insert);
     }
     return absl::OkStatus();
   }
@@ -109,10 +253,10 @@ class MutableHashTableOfScalars final : public LookupInterface {
   absl::Status Remove(OpKernelContext* ctx, const Tensor& keys) override {
     const auto key_values = keys.flat<K>();
 
-    mutex_lock l(mu_);
-    for (int64_t i = 0; i < key_values.size(); ++i) {
-      table_.erase(SubtleMustCopyIfIntegral(key_values(i)));
-    }
+    table_.ForEachKeyExclusive(
+        key_values, [&](std::unordered_map<K, V>* table, int64_t i) {
+          table->erase(SubtleMustCopyIfIntegral(key_values(i)));
+        });
     return absl::OkStatus();
   }
 
@@ -122,17 +266,16 @@ class MutableHashTableOfScalars final : public LookupInterface {
   }
 
   absl::Status ExportValues(OpKernelContext* ctx) override {
-    tf_shared_lock l(mu_);
-    int64_t size = table_.size();
-
-    Tensor* keys;
-    Tensor* values;
-    TF_RETURN_IF_ERROR(
-        ctx->allocate_output("keys", TensorShape({size}), &keys));
-    TF_RETURN_IF_ERROR(
-        ctx->allocate_output("values", TensorShape({size}), &values));
-    ExportKeysAndValues(keys, values);
-    return absl::OkStatus();
+    return table_.ReadAll([&](int64_t size, const Maps& maps) {
+      Tensor* keys;
+      Tensor* values;
+      TF_RETURN_IF_ERROR(
+          ctx->allocate_output("keys", TensorShape({size}), &keys));
+      TF_RETURN_IF_ERROR(
+          ctx->allocate_output("values", TensorShape({size}), &values));
+      ExportKeysAndValues(maps, keys, values);
+      return absl::OkStatus();
+    });
   }
 
   DataType key_dtype() const override { return DataTypeToEnum<K>::v(); }
@@ -144,25 +287,18 @@ class MutableHashTableOfScalars final : public LookupInterface {
   TensorShape value_shape() const override { return TensorShape(); }
 
   int64_t MemoryUsed() const override {
-    int64_t ret = 0;
-    tf_shared_lock l(mu_);
-    for (unsigned i = 0; i < table_.bucket_count(); ++i) {
-      size_t bucket_size = table_.bucket_size(i);
-      if (bucket_size == 0) {
-        ret++;
-      } else {
-        ret += bucket_size;
-      }
-    }
-    return sizeof(MutableHashTableOfScalars) + ret;
+    return sizeof(MutableHashTableOfScalars) + table_.MemoryUsed();
   }
 
   absl::Status AsGraphDef(GraphDefBuilder* builder, Node** out) const override {
-    tf_shared_lock l(mu_);
-    int64_t size = table_.size();
-    Tensor keys(key_dtype(), TensorShape({size}));
-    Tensor values(value_dtype(), TensorShape({size}));
-    ExportKeysAndValues(&keys, &values);
+    Tensor keys;
+    Tensor values;
+    table_.ReadAll([&](int64_t size, const Maps& maps) {
+      keys = Tensor(key_dtype(), TensorShape({size}));
+      values = Tensor(value_dtype(), TensorShape({size}));
+      ExportKeysAndValues(maps, &keys, &values);
+      return true;
+    });
 
     // We set use_node_name_sharing with a unique node name so that the resource
     // can outlive the MutableHashTableV2 kernel. This means that the lifetime
@@ -195,21 +331,25 @@ class MutableHashTableOfScalars final : public LookupInterface {
   }
 
  private:
-  // Writes all keys and values into `keys` and `values`. `keys` and `values`
-  // must point to tensors of size `table_.size()`.
-  void ExportKeysAndValues(Tensor* keys, Tensor* values) const
-      TF_SHARED_LOCKS_REQUIRED(mu_) {
+  using Table = ShardedHashMap<K, V>;
+  using Maps = std::array<const typename Table::Map*, Table::kNumShards>;
+
+  // Writes all keys and values of `maps` into `keys` and `values`, which must
+  // have as many elements as `maps` in total.
+  static void ExportKeysAndValues(const Maps& maps, Tensor* keys,
+                                  Tensor* values) {
     auto keys_data = keys->flat<K>();
     auto values_data = values->flat<V>();
     int64_t i = 0;
-    for (auto it = table_.begin(); it != table_.end(); ++it, ++i) {
-      keys_data(i) = it->first;
-      values_data(i) = it->second;
+    for (const auto* map : maps) {
+      for (auto it = map->begin(); it != map->end(); ++it, ++i) {
+        keys_data(i) = it->first;
+        values_data(i) = it->second;
+      }
     }
   }
 
-  mutable mutex mu_;
-  std::unordered_map<K, V> table_ TF_GUARDED_BY(mu_);
+  Table table_;
 };
 
 // Lookup table that wraps an unordered_map. Behaves identical to
@@ -226,10 +366,7 @@ class MutableHashTableOfTensors final : public LookupInterface {
                                 value_shape_.DebugString()));
   }
 
-  size_t size() const override {
-    tf_shared_lock l(mu_);
-    return table_.size();
-  }
+  size_t size() const override { return table_.size(); }
 
   absl::Status Find(OpKernelContext* ctx, const Tensor& key, Tensor* value,
                     const Tensor& default_value) override {
@@ -242,10 +379,10 @@ class MutableHashTableOfTensors final : public LookupInterface {
     int64_t default_total = default_flat.size();
     bool is_full_size_default = (total == default_total);
 
-    tf_shared_lock l(mu_);
-    for (int64_t i = 0; i < key_values.size(); ++i) {
-      ValueArray* value_vec =
-          gtl::FindOrNull(table_, SubtleMustCopyIfIntegral(key_values(i)));
+    table_.ForEachKeyShared(key_values, [&](const typename Table::Map& table,
+                                            int64_t i) {
+      const ValueArray* value_vec =
+          gtl::FindOrNull(table, SubtleMustCopyIfIntegral(key_values(i)));
       if (value_vec != nullptr) {
         for (int64_t j = 0; j < value_dim; j++) {
           value_values(i, j) = value_vec->at(j);
@@ -262,7 +399,7 @@ class MutableHashTableOfTensors final : public LookupInterface {
               is_full_size_default ? default_flat(i, j) : default_flat(0, j);
         }
       }
-    }
+    });
 
     return absl::OkStatus();
   }
@@ -272,18 +409,19 @@ class MutableHashTableOfTensors final : public LookupInterface {
     const auto value_values = values.flat_inner_dims<V, 2>();
     int64_t value_dim = value_shape_.dim_size(0);
 
-    mutex_lock l(mu_);
-    if (clear) {
-      table_.clear();
-    }
-    for (int64_t i = 0; i < key_values.size(); ++i) {
+    auto insert = [&](typename Table::Map* table, int64_t i) {
       ValueArray value_vec;
       for (int64_t j = 0; j < value_dim; j++) {
         V value = value_values(i, j);
         value_vec.push_back(value);
       }
-      gtl::InsertOrUpdate(&table_, SubtleMustCopyIfIntegral(key_values(i)),
+      gtl::InsertOrUpdate(table, SubtleMustCopyIfIntegral(key_values(i)),
                           value_vec);
+    };
+    if (clear) {
+      table_.ClearAndInsert(key_values, insert);
+    } else {
+      table_.ForEachKeyExclusive(key_values, insert);
     }
     return absl::OkStatus();
   }
@@ -296,10 +434,10 @@ class MutableHashTableOfTensors final : public LookupInterface {
   absl::Status Remove(OpKernelContext* ctx, const Tensor& keys) override {
     const auto key_values = keys.flat<K>();
 
-    mutex_lock l(mu_);
-    for (int64_t i = 0; i < key_values.size(); ++i) {
-      table_.erase(SubtleMustCopyIfIntegral(key_values(i)));
-    }
+    table_.ForEachKeyExclusive(
+        key_values, [&](typename Table::Map* table, int64_t i) {
+          table->erase(SubtleMustCopyIfIntegral(key_values(i)));
+        });
     return absl::OkStatus();
   }
 
@@ -309,18 +447,17 @@ class MutableHashTableOfTensors final : public LookupInterface {
   }
 
   absl::Status ExportValues(OpKernelContext* ctx) override {
-    tf_shared_lock l(mu_);
-    int64_t size = table_.size();
     int64_t value_dim = value_shape_.dim_size(0);
-
-    Tensor* keys;
-    Tensor* values;
-    TF_RETURN_IF_ERROR(
-        ctx->allocate_output("keys", TensorShape({size}), &keys));
-    TF_RETURN_IF_ERROR(ctx->allocate_output(
-        "values", TensorShape({size, value_dim}), &values));
-    ExportKeysAndValues(keys, values);
-    return absl::OkStatus();
+    return table_.ReadAll([&](int64_t size, const Maps& maps) {
+      Tensor* keys;
+      Tensor* values;
+      TF_RETURN_IF_ERROR(
+          ctx->allocate_output("keys", TensorShape({size}), &keys));
+      TF_RETURN_IF_ERROR(ctx->allocate_output(
+          "values", TensorShape({size, value_dim}), &values));
+      ExportKeysAndValues(maps, keys, values);
+      return absl::OkStatus();
+    });
   }
 
   DataType key_dtype() const override { return DataTypeToEnum<K>::v(); }
@@ -332,25 +469,19 @@ class MutableHashTableOfTensors final : public LookupInterface {
   TensorShape value_shape() const override { return value_shape_; }
 
   int64_t MemoryUsed() const override {
-    int64_t ret = 0;
-    tf_shared_lock l(mu_);
-    for (unsigned i = 0; i < table_.bucket_count(); ++i) {
-      size_t bucket_size = table_.bucket_size(i);
-      if (bucket_size == 0) {
-        ret++;
-      } else {
-        ret += bucket_size;
-      }
-    }
-    return sizeof(MutableHashTableOfTensors) + ret;
+    return sizeof(MutableHashTableOfTensors) + table_.MemoryUsed();
   }
 
   absl::Status AsGraphDef(GraphDefBuilder* builder, Node** out) const override {
-    tf_shared_lock l(mu_);
-    int64_t size = table_.size();
-    Tensor keys(key_dtype(), TensorShape({size}));
-    Tensor values(value_dtype(), TensorShape({size, value_shape_.dim_size(0)}));
-    ExportKeysAndValues(&keys, &values);
+    Tensor keys;
+    Tensor values;
+    table_.ReadAll([&](int64_t size, const Maps& maps) {
+      keys = Tensor(key_dtype(), TensorShape({size}));
+      values =
+          Tensor(value_dtype(), TensorShape({size, value_shape_.dim_size(0)}));
+      ExportKeysAndValues(maps, &keys, &values);
+      return true;
+    });
 
     // We set use_node_name_sharing with a unique node name so that the resource
     // can outlive the MutableHashTableOfTensorsV2 kernel. This means that the
@@ -384,28 +515,32 @@ class MutableHashTableOfTensors final : public LookupInterface {
   }
 
  private:
-  // Writes all keys and values into `keys` and `values`. `keys` and `values`
-  // must point to tensors of size `table_.size()`.
-  void ExportKeysAndValues(Tensor* keys, Tensor* values) const
-      TF_SHARED_LOCKS_REQUIRED(mu_) {
+  typedef gtl::InlinedVector<V, 4> ValueArray;
+  using Table = ShardedHashMap<K, ValueArray>;
+  using Maps = std::array<const typename Table::Map*, Table::kNumShards>;
+
+  // Writes all keys and values of `maps` into `keys` and `values`, which must
+  // have as many rows as `maps` have entries in total.
+  void ExportKeysAndValues(const Maps& maps, Tensor* keys,
+                           Tensor* values) const {
     int64_t value_dim = value_shape_.dim_size(0);
     auto keys_data = keys->flat<K>();
     auto values_data = values->matrix<V>();
     int64_t i = 0;
-    for (auto it = table_.begin(); it != table_.end(); ++it, ++i) {
-      K key = it->first;
-      ValueArray value = it->second;
-      keys_data(i) = key;
-      for (int64_t j = 0; j < value_dim; j++) {
-        values_data(i, j) = value[j];
+    for (const auto* map : maps) {
+      for (auto it = map->begin(); it != map->end(); ++it, ++i) {
+        K key = it->first;
+        const ValueArray& value = it->second;
+        keys_data(i) = key;
+        for (int64_t j = 0; j < value_dim; j++) {
+          values_data(i, j) = value[j];
+        }
       }
     }
   }
 
   TensorShape value_shape_;
-  mutable mutex mu_;
-  typedef gtl::InlinedVector<V, 4> ValueArray;
-  std::unordered_map<K, ValueArray> table_ TF_GUARDED_BY(mu_);
+  Table table_;
 };
 
 namespace {
@@ -407,5 +407,24 @@ TEST_F(OpsUtilTest, MisalignedEmptyDim0) {
   EXPECT_EQ(output, false);
 }
 
+TEST_F(OpsUtilTest, LeadingDimsAreOne) {
+  TensorShape trailing_shape;
+  EXPECT_TRUE(LeadingDimsAreOne(TensorShape({1, 1, 6, 4}), 2,
+                                &trailing_shape));
+  EXPECT_EQ(trailing_shape, TensorShape({6, 4}));
+}
+
+TEST_F(OpsUtilTest, LeadingDimsAreOneForDim0) {
+  TensorShape trailing_shape;
+  EXPECT_TRUE(LeadingDimsAreOne(TensorShape({6, 4}), 0, &trailing_shape));
+  EXPECT_EQ(trailing_shape, TensorShape({6, 4}));
+}
+
+TEST_F(OpsUtilTest, LeadingDimsAreNotOne) {
+  TensorShape trailing_shape;
+  EXPECT_FALSE(LeadingDimsAreOne(TensorShape({1, 2, 6, 4}), 2,
+                                 &trailing_shape));
+}
+
 }  // namespace
 }  // namespace tensorflow
@@ -0,0 +1,192 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "tensorflow/core/kernels/reduction_ops_common.h"
+
+namespace tensorflow {
+
+namespace {
+
+// With fewer outputs than threads, the reduced dimension is split into chunks
+// of at least this many input elements reduced in parallel.
+constexpr int64_t kMinChunkElements = 16 * 1024;
+
+// Reduces `in`, viewed as [outer, reduced, inner], along its middle dimension
+// into the [outer, inner] outputs `min` and `max` in a single pass.
+template <typename T>
+void MinMaxReduce(const CPUDevice& d, const T* in, int64_t outer,
+                  int64_t reduced, int64_t inner, T* min, T* max) {
+  const Eigen::internal::MinReducer<T, Eigen::PropagateNaN> min_reducer;
+  const Eigen::internal::MaxReducer<T, Eigen::PropagateNaN> max_reducer;
+  // Reduces rows [begin, end) of the [reduced, inner] matrix `rows` into the
+  // `inner` results `row_min` and `row_max`.
+  auto reduce_rows = [&](const T* rows, int64_t begin, int64_t end, T* row_min,
+                         T* row_max) {
+    std::fill_n(row_min, inner, min_reducer.initialize());
+    std::fill_n(row_max, inner, max_reducer.initialize());
+    for (int64_t r = begin; r < end; ++r) {
+      const T* row = rows + r * inner;
+      for (int64_t i = 0; i < inner; ++i) {
+        min_reducer.reduce(row[i], &row_min[i]);
+        max_reducer.reduce(row[i], &row_max[i]);
+      }
+    }
+  };
+
+  const int num_threads = d.numThreads();
+  const int64_t num_chunks =
+      outer >= num_threads
+          ? 1
+          : std::clamp<int64_t>(reduced * inner / kMinChunkElements, 1,
+                                num_threads);
+  const Eigen::TensorOpCost cost(
+      /*bytes_loaded=*/reduced * inner * sizeof(T) / num_chunks,
+      /*bytes_stored=*/2 * inner * sizeof(T),
+      /*compute_cycles=*/2 * reduced * inner *
+          Eigen::TensorOpCost::AddCost<T>() / num_chunks);
+  if (num_chunks == 1) {
+    d.parallelFor(outer, cost, [&](int64_t begin, int64_t end) {
+      for (int64_t o = begin; o < end; ++o) {
+        reduce_rows(in + o * reduced * inner, 0, reduced, min + o * inner,
+                    max + o * inner);
+      }
+    });
+    return;
+  }
+
+  // Few outputs: each chunk of the reduced dimension writes its partial
+  // results, which are then combined.
+  const int64_t chunk_size = (reduced + num_chunks - 1) / num_chunks;
+  std::vector<T> partial_min(num_chunks * inner);
+  std::vector<T> partial_max(num_chunks * inner);
+  for (int64_t o = 0; o < outer; ++o) {
+    const T* outer_in = in + o * reduced * inner;
+    d.parallelFor(num_chunks, cost, [&](int64_t begin, int64_t end) {
+      for (int64_t c = begin; c < end; ++c) {
+        reduce_rows(outer_in, c * chunk_size,
+                    std::min(reduced, (c + 1) * chunk_size),
+                    partial_min.data() + c * inner,
+                    partial_max.data() + c * inner);
+      }
+    });
+    T* outer_min = min + o * inner;
+    T* outer_max = max + o * inner;
+    std::copy_n(partial_min.data(), inner, outer_min);
+    std::copy_n(partial_max.data(), inner, outer_max);
+    for (int64_t c = 1; c < num_chunks; ++c) {
+      for (int64_t i = 0; i < inner; ++i) {
+        min_reducer.reduce(partial_min[c * inner + i], &outer_min[i]);
+        max_reducer.reduce(partial_max[c * inner + i], &outer_max[i]);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+// Computes both Min and Max of the input over the same axes while reading the
+// input once. Created by the remapper from sibling Min and Max nodes.
+template <typename T, typename Tidx>
+class FusedMinMaxOp : public OpKernel {
+ public:
+  explicit FusedMinMaxOp(OpKernelConstruction* ctx) : OpKernel(ctx) {
+    const DataType dt = DataTypeToEnum<T>::v();
+    const DataType pt = DataTypeToEnum<Tidx>::v();
+    OP_REQUIRES_OK(ctx, ctx->MatchSignature({dt, pt}, {dt, dt}));
+
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("keep_dims", &keep_dims_));
+  }
+
+  void Compute(OpKernelContext* ctx) override {
+    const Tensor& data = ctx->input(0);
+    const Tensor& axes = ctx->input(1);
+
+    ReductionHelper helper;
+    OP_REQUIRES_OK(ctx, helper.Simplify(data, axes, keep_dims_));
+    CHECK_GE(helper.ndims(), 0);
+
+    Tensor* min_out = nullptr;
+    OP_REQUIRES_OK(ctx, ctx->allocate_output(0, helper.out_shape(), &min_out));
+    Tensor* max_out = nullptr;
+    OP_REQUIRES_OK(ctx, ctx->allocate_output(1, helper.out_shape(), &max_out));
+    if (min_out->NumElements() == 0) return;
+
+    // View the simplified input as [outer, reduced, inner].
+    const TensorShape data_reshape = helper.data_reshape();
+    Tensor shuffled = data;
+    int64_t outer = 1;
+    int64_t reduced = 1;
+    int64_t inner = 1;
+    if (helper.ndims() == 0 ||
+        (helper.ndims() == 1 && !helper.reduce_first_axis())) {
+      // Reduces nothing.
+      outer = data.NumElements();
+    } else if (helper.ndims() == 1) {
+      reduced = data_reshape.dim_size(0);
+    } else if (helper.ndims() == 2 && helper.reduce_first_axis()) {
+      reduced = data_reshape.dim_size(0);
+      inner = data_reshape.dim_size(1);
+    } else if (helper.ndims() == 2) {
+      outer = data_reshape.dim_size(0);
+      reduced = data_reshape.dim_size(1);
+    } else if (helper.ndims() == 3 && !helper.reduce_first_axis()) {
+      outer = data_reshape.dim_size(0);
+      reduced = data_reshape.dim_size(1);
+      inner = data_reshape.dim_size(2);
+    } else {
+      // Transpose the data so that all reduced dimensions are last, as done by
+      // ReductionOp.
+      Tensor data_reshaped;
+      OP_REQUIRES(ctx, data_reshaped.CopyFrom(data, data_reshape),
+                  errors::Internal("Error during reduction copy."));
+      OP_REQUIRES_OK(ctx, ctx->allocate_temp(DataTypeToEnum<T>::value,
+                                             helper.shuffled_shape(),
+                                             &shuffled));
+      OP_REQUIRES_OK(ctx, DoTranspose(ctx->eigen_device<CPUDevice>(),
+                                      data_reshaped, helper.permutation(),
+                                      &shuffled));
+      outer = min_out->NumElements();
+      reduced = shuffled.NumElements() / outer;
+    }
+
+    MinMaxReduce<T>(ctx->eigen_device<CPUDevice>(),
+                    shuffled.flat<T>().data(), outer, reduced, inner,
+                    min_out->flat<T>().data(), max_out->flat<T>().data());
+  }
+
+ private:
+  // True if the number of dimensions should be maintained.
+  bool keep_dims_;
+};
+
+#define REGISTER_CPU_KERNELS(type)                               \
+  REGISTER_KERNEL_BUILDER(Name("_FusedMinMax")                   \
+                              .Device(DEVICE_CPU)                \
+                              .TypeConstraint<type>("T")         \
+                              .TypeConstraint<int32>("Tidx"),    \
+                          FusedMinMaxOp<type, int32>);           \
+  REGISTER_KERNEL_BUILDER(Name("_FusedMinMax")                   \
+                              .Device(DEVICE_CPU)                \
+                              .TypeConstraint<type>("T")         \
+                              .TypeConstraint<int64_t>("Tidx"),  \
+                          FusedMinMaxOp<type, int64_t>);
+TF_CALL_REAL_NUMBER_TYPES(REGISTER_CPU_KERNELS);
+#undef REGISTER_CPU_KERNELS
+
+}  // namespace tensorflow
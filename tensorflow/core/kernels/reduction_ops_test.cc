@@ -13,11 +13,28 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#define EIGEN_USE_THREADS
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
 #include "tensorflow/core/common_runtime/kernel_benchmark_testlib.h"
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def_builder.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
 #include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/kernels/ops_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/lib/gtl/array_slice.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/test.h"
 #include "tensorflow/core/platform/test_benchmark.h"
+#include "tensorflow/core/platform/threadpool.h"
 
 namespace tensorflow {
 
@@ -256,4 +273,103 @@ static void BM_Mean2DToScalarCPUBF16(::testing::benchmark::State& state) {
 }
 BENCHMARK(BM_Mean2DToScalarCPUBF16)->RangePair(2048, 8192, 2048, 8192);
 
+namespace {
+
+// Checks _FusedMinMax against the separate Min and Max kernels on a device
+// with 4 threads, so that reductions to fewer than 4 outputs are split into
+// chunks of the reduced dimension.
+class FusedMinMaxOpTest : public OpsTestBase {
+ protected:
+  FusedMinMaxOpTest()
+      : workers_(Env::Default(), "fused_min_max_test", /*num_threads=*/4),
+        eigen_device_(workers_.AsEigenThreadPool(), /*num_cores=*/4) {
+    // The last Eigen device added is used by kernels that do not limit their
+    // parallelism.
+    device_->set_eigen_cpu_device(&eigen_device_);
+  }
+
+  // Returns the outputs of `op` reducing `input` over `axes`.
+  std::vector<Tensor> Reduce(const std::string& op, const Tensor& input,
+                             const std::vector<int32_t>& axes,
+                             bool keep_dims) {
+    inputs_.clear();
+    TF_CHECK_OK(NodeDefBuilder("reduce", op)
+                    .Input(FakeInput(DT_FLOAT))
+                    .Input(FakeInput(DT_INT32))
+                    .Attr("keep_dims", keep_dims)
+                    .Finalize(node_def()));
+    TF_CHECK_OK(InitOp());
+    AddInputFromArray<float>(
+        input.shape(),
+        gtl::ArraySlice<float>(input.flat<float>().data(),
+                               input.NumElements()));
+    AddInputFromArray<int32_t>(TensorShape({static_cast<int64_t>(axes.size())}),
+                               axes);
+    TF_CHECK_OK(RunOpKernel());
+    std::vector<Tensor> outputs;
+    for (int i = 0; i < kernel_->num_outputs(); ++i) {
+      outputs.push_back(*GetOutput(i));
+    }
+    return outputs;
+  }
+
+  void CheckMatchesMinAndMax(const Tensor& input,
+                             const std::vector<int32_t>& axes,
+                             bool keep_dims = false) {
+    const Tensor min = Reduce("Min", input, axes, keep_dims)[0];
+    const Tensor max = Reduce("Max", input, axes, keep_dims)[0];
+    const std::vector<Tensor> fused =
+        Reduce("_FusedMinMax", input, axes, keep_dims);
+    test::ExpectTensorEqual<float>(min, fused[0]);
+    test::ExpectTensorEqual<float>(max, fused[1]);
+  }
+
+ private:
+  thread::ThreadPool workers_;
+  Eigen::ThreadPoolDevice eigen_device_;
+};
+
+Tensor RandomInput(const TensorShape& shape) {
+  Tensor input(DT_FLOAT, shape);
+  input.flat<float>().setRandom();
+  return input;
+}
+
+TEST_F(FusedMinMaxOpTest, ReduceAllChunked) {
+  CheckMatchesMinAndMax(RandomInput({100000}), {0});
+}
+
+TEST_F(FusedMinMaxOpTest, ReduceFirstAxisChunked) {
+  CheckMatchesMinAndMax(RandomInput({50000, 8}), {0}, /*keep_dims=*/true);
+}
+
+TEST_F(FusedMinMaxOpTest, ReduceLastAxisChunked) {
+  // 2 outputs for 4 threads: each row is split into chunks.
+  CheckMatchesMinAndMax(RandomInput({2, 100000}), {1});
+}
+
+TEST_F(FusedMinMaxOpTest, ReduceMiddleAxisChunked) {
+  CheckMatchesMinAndMax(RandomInput({2, 40000, 3}), {1});
+}
+
+TEST_F(FusedMinMaxOpTest, ReduceManyOutputs) {
+  CheckMatchesMinAndMax(RandomInput({64, 1000}), {1});
+}
+
+TEST_F(FusedMinMaxOpTest, ReduceTransposed) {
+  CheckMatchesMinAndMax(RandomInput({4, 10, 5, 7}), {0, 2});
+}
+
+TEST_F(FusedMinMaxOpTest, ChunkedPropagatesNaN) {
+  Tensor input = RandomInput({2, 100000});
+  // A NaN in the last chunk of the first row only.
+  input.matrix<float>()(0, 99999) = std::numeric_limits<float>::quiet_NaN();
+  CheckMatchesMinAndMax(input, {1});
+  const std::vector<Tensor> fused = Reduce("_FusedMinMax", input, {1}, false);
+  EXPECT_TRUE(std::isnan(fused[0].vec<float>()(0)));
+  EXPECT_TRUE(std::isnan(fused[1].vec<float>()(0)));
+  EXPECT_FALSE(std::isnan(fused[0].vec<float>()(1)));
+}
+
+}  // namespace
 }  // end namespace tensorflow
@@ -396,6 +396,26 @@ REGISTER_KERNEL_BUILDER(
     Name("DisableCopyOnRead").Device(DEVICE_DEFAULT).HostMemory("resource"),
     DisableCopyOnReadOp);
 
+void EnableVariableHogwildModeOp::Compute(OpKernelContext* ctx) {
+  core::RefCountPtr<Var> variable;
+  const ResourceHandle& handle = HandleFromInput(ctx, 0);
+  const auto status = LookupResource(ctx, handle, &variable);
+  OP_REQUIRES(ctx, status.ok(),
+              errors::FailedPrecondition(
+                  "Could not find variable ", handle.name(), ". ",
+                  "This could mean that the variable has been deleted. ",
+                  "In TF1, it can also mean the variable is uninitialized. ",
+                  "Debug info: container=", handle.container(),
+                  ", status error message=", status.message()));
+  // Reads must alias the buffer that updates write to in place.
+  mutex_lock ml(*variable->mu());
+  variable->copy_on_read_mode.store(false);
+  variable->hogwild_mode.store(true);
+}
+
+REGISTER_KERNEL_BUILDER(Name("_EnableVariableHogwildMode").Device(DEVICE_CPU),
+                        EnableVariableHogwildModeOp);
+
 template <typename Device, typename T>
 class AssignVariableOp : public OpKernel {
  public:
@@ -74,6 +74,13 @@ class DisableCopyOnReadOp : public OpKernel {
   void Compute(OpKernelContext* ctx) override;
 };
 
+class EnableVariableHogwildModeOp : public OpKernel {
+ public:
+  explicit EnableVariableHogwildModeOp(OpKernelConstruction* c)
+      : OpKernel(c) {}
+  void Compute(OpKernelContext* ctx) override;
+};
+
 template <typename T>
 class VariableShapeOp : public OpKernel {
  public:
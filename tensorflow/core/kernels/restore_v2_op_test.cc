@@ -31,9 +31,12 @@ limitations under the License.
 #include "tensorflow/core/kernels/ops_testutil.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
 #include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/test.h"
 #include "tensorflow/core/public/session_options.h"
 #include "tensorflow/core/public/version.h"
+#include "tensorflow/core/util/tensor_bundle/tensor_bundle.h"
 
 namespace tensorflow {
 namespace {
@@ -352,9 +355,93 @@ class RestoreV2OpTest : public OpsTestBase {
 
 // The intended use case (write in V2, read in V2).
 TEST_F(RestoreV2OpTest, RestoreAfterSaveV2) { RunTest("SaveV2"); }
+TEST_F(RestoreV2OpTest, RestoreAfterSaveV2WithMmap) {
+  tensorflow::setenv("TF_RESTORE_USE_MMAP", "true", 1 /* overwrite */);
+  RunTest("SaveV2");
+  tensorflow::unsetenv("TF_RESTORE_USE_MMAP");
+}
 // For backward compatibility.
 TEST_F(RestoreV2OpTest, RestoreAfterSaveSlicesV1) { RunTest("SaveSlices"); }
 TEST_F(RestoreV2OpTest, RestoreAfterSaveV1) { RunTest("Save"); }
 
+// Restores a large tensor, several 8MB batches of 4MB tensors and small
+// tensors, with and without an intra-op parallelism.
+TEST_F(RestoreV2OpTest, RestoreLargeAndBatchedTensors) {
+  const string prefix = io::JoinPath(testing::TmpDir(), "tensor_batches");
+  std::vector<string> tensor_names;
+  std::vector<Tensor> tensors;
+  tensor_names.push_back("large");
+  tensors.push_back(MakeInput<int8>(TensorShape({(16 << 20) + 1}),
+                                    [](int x) -> int8 { return x % 7; }));
+  for (int i = 0; i < 5; ++i) {
+    tensor_names.push_back(strings::StrCat("medium_", i));
+    tensors.push_back(MakeInput<float>(
+        TensorShape({1 << 20}), [i](int x) -> float { return i + x % 11; }));
+    tensor_names.push_back(strings::StrCat("small_", i));
+    tensors.push_back(MakeInput<int32>(TensorShape({10}),
+                                       [i](int x) -> int32 { return i * x; }));
+  }
+  {
+    BundleWriter writer(Env::Default(), prefix);
+    for (int i = 0; i < tensors.size(); ++i) {
+      TF_ASSERT_OK(writer.Add(tensor_names[i], tensors[i]));
+    }
+    TF_ASSERT_OK(writer.Finish());
+  }
+
+  std::vector<DataType> dtypes;
+  for (const Tensor& tensor : tensors) {
+    dtypes.push_back(tensor.dtype());
+  }
+  NodeDef restore;
+  TF_ASSERT_OK(NodeDefBuilder("restore", "RestoreV2")
+                   .Input(FakeInput())  // prefix
+                   .Input(FakeInput())  // tensor_names
+                   .Input(FakeInput())  // shape_and_slices
+                   .Attr("dtypes", dtypes)
+                   .Finalize(&restore));
+  std::unique_ptr<Device> device(
+      DeviceFactory::NewDevice("CPU", {}, "/job:a/replica:0/task:0"));
+  absl::Status status;
+  std::unique_ptr<OpKernel> op(CreateOpKernel(DEVICE_CPU, device.get(),
+                                              cpu_allocator(), restore,
+                                              TF_GRAPH_DEF_VERSION, &status));
+  TF_ASSERT_OK(status);
+
+  Tensor prefix_tensor(DT_STRING, TensorShape({}));
+  prefix_tensor.scalar<tstring>()() = prefix;
+  Tensor names_tensor = MakeInput<tstring>(
+      TensorShape({static_cast<int>(tensor_names.size())}),
+      [&tensor_names](int x) -> string { return tensor_names[x]; });
+  Tensor slices_tensor = MakeInput<tstring>(
+      TensorShape({static_cast<int>(tensor_names.size())}),
+      [](int x) -> string { return ""; });
+  absl::InlinedVector<TensorValue, 4> inputs = {
+      {nullptr, &prefix_tensor}, {nullptr, &names_tensor},
+      {nullptr, &slices_tensor}};
+
+  for (const int intra_op_parallelism : {0, 4}) {
+    ConfigProto config;
+    config.set_intra_op_parallelism_threads(intra_op_parallelism);
+    OpKernelContext::Params params;
+    params.device = device.get();
+    params.frame_iter = FrameAndIter(0, 0);
+    params.inputs = inputs;
+    params.op_kernel = op.get();
+    params.session_config = &config;
+    std::vector<AllocatorAttributes> attrs;
+    test::SetOutputAttrs(&params, &attrs);
+
+    OpKernelContext ctx(&params);
+    op->Compute(&ctx);
+    TF_ASSERT_OK(ctx.status());
+    for (int i = 0; i < tensors.size(); ++i) {
+      SCOPED_TRACE(
+          strings::StrCat(tensor_names[i], " with ", intra_op_parallelism));
+      test::ExpectEqual(*ctx.mutable_output(i), tensors[i]);
+    }
+  }
+}
+
 }  // namespace
 }  // namespace tensorflow
@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <algorithm>
 #include <cstdint>
+#include <string>
 
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/op_kernel.h"
@@ -28,6 +29,7 @@ limitations under the License.
 #include "tensorflow/core/lib/gtl/array_slice.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/strcat.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/util/work_sharder.h"
 
@@ -173,8 +175,14 @@ void DoRoll(const OpKernelContext* context, const int64_t num_elements,
   auto worker_threads = context->device()->tensorflow_cpu_worker_threads();
   // 15 - experimentally determined with float and bool types
   const int cost_per_element = 15 * sizeof(T);  // rough estimate
+  // The estimate above is only a starting point; the real cost is learned
+  // per dtype and size bucket.
+  static const std::string* const cost_name = new std::string(
+      strings::StrCat("Roll/", DataTypeString(DataTypeToEnum<T>::v())));
+  AdaptiveShardCost* adaptive_cost =
+      GetAdaptiveShardCost(*cost_name, ShardSizeBucket(num_elements));
   Shard(worker_threads->num_threads, worker_threads->workers, num_elements,
-        cost_per_element, std::move(work));
+        cost_per_element, adaptive_cost, std::move(work));
 }
 
 // dim_size - the size of each dimension
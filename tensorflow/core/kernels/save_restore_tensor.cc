@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "tensorflow/core/kernels/save_restore_tensor.h"
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <numeric>
 #include <unordered_map>
@@ -33,6 +35,7 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/stringprintf.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/tensor_bundle/tensor_bundle.h"
 #include "tensorflow/core/util/tensor_slice_reader.h"
 #include "tensorflow/core/util/tensor_slice_reader_cache.h"
@@ -44,6 +47,7 @@ namespace tensorflow {
 namespace {
 constexpr char kCkptFilePathEnv[] = "var_name_mapping_path";
 constexpr char kFloat32CkptPrefixEnv[] = "float32_ckpt_file_prefix";
+constexpr char kRestoreUseMmapEnv[] = "TF_RESTORE_USE_MMAP";
 
 const std::string GetEnvAsStr(const char* var) {
   const char* val = std::getenv(var);
@@ -261,6 +265,45 @@ namespace {
 // Tensors larger than this threshold will be restored from a thread-pool.
 const int64_t kLargeShapeThreshold = 16 << 20;  // 16M
 
+// When the session config sets the intra-op parallelism, smaller tensors are
+// also restored from the thread-pool, in batches of consecutive tensors, in
+// file order, of up to this many bytes.
+const int64_t kSmallBatchBytes = 8 << 20;  // 8MB
+
+// Whether tensors are restored from a memory-mapped checkpoint, see
+// BundleReader::Options::use_mmap. Restored tensors then share the pages of
+// the data files, e.g. between the processes serving the same model. Enabled
+// by setting TF_RESTORE_USE_MMAP to true.
+bool RestoreUsesMmap() {
+  bool use_mmap = false;
+  const absl::Status status =
+      ReadBoolFromEnvVar(kRestoreUseMmapEnv, /*default_val=*/false, &use_mmap);
+  if (!status.ok()) {
+    LOG(WARNING) << "Reading the checkpoint without mapping it: " << status;
+    return false;
+  }
+  return use_mmap;
+}
+
+// Reads "prefix" with "env", the Env of the restoring kernel, so that sessions
+// with a custom Env (e.g. a MemmappedEnv) restore from their own file systems.
+std::unique_ptr<AbstractBundleReader> NewBundleReader(tsl::Env* env,
+                                                      const string& prefix,
+                                                      BundleCache* cache) {
+  const std::string ckptPath = GetEnvAsStr(kCkptFilePathEnv);
+  const std::string float32CkptPrefix = GetEnvAsStr(kFloat32CkptPrefixEnv);
+
+  if (ckptPath.empty()) {
+    BundleReader::Options options;
+    options.cache = cache;
+    options.use_mmap = RestoreUsesMmap();
+    return absl::WrapUnique<BundleReader>(
+        new BundleReader(env, prefix, options));
+  }
+  return absl::WrapUnique<MixedBundleReaderWrapper>(
+      new MixedBundleReaderWrapper(env, float32CkptPrefix, ckptPath));
+}
+
 // A restore operation for a single tensor.  Small tensors may be restored
 // directly from the op thread to improve read locality.  Large tensors can be
 // restored from a thread pool: this requires creating a separate
@@ -293,21 +336,22 @@ struct RestoreOp {
     return restored_full_shape.num_elements() > kLargeShapeThreshold;
   }
 
+  // Approximate size in bytes of the full stored tensor, or 0 if unknown.
+  int64_t full_tensor_bytes(AbstractBundleReader* reader) const {
+    TensorShape restored_full_shape;
+    if (!reader->LookupTensorShape(tensor_name, &restored_full_shape).ok()) {
+      return 0;
+    }
+    const int64_t element_size = DataTypeCanUseMemcpy(dtype)
+                                     ? DataTypeSize(dtype)
+                                     : static_cast<int64_t>(sizeof(tstring));
+    return restored_full_shape.num_elements() * element_size;
+  }
+
   // Run this restore operation using a new AbstractBundleReader.
   void run_with_new_reader(BundleCache* cache) {
-    std::unique_ptr<AbstractBundleReader> reader;
-
-    const std::string ckptPath = GetEnvAsStr(kCkptFilePathEnv);
-    const std::string float32CkptPrefix = GetEnvAsStr(kFloat32CkptPrefixEnv);
-
-    if (ckptPath.empty()) {
-      reader = absl::WrapUnique<BundleReader>(
-          new BundleReader(tsl::Env::Default(), reader_prefix, {cache, false}));
-    } else {
-      reader = absl::WrapUnique<MixedBundleReaderWrapper>(
-          new MixedBundleReaderWrapper(tsl::Env::Default(), float32CkptPrefix,
-                                       ckptPath));
-    }
+    std::unique_ptr<AbstractBundleReader> reader =
+        NewBundleReader(context->env(), reader_prefix, cache);
     if (!reader->status().ok()) {
       status = reader->status();
       return;
@@ -382,6 +426,27 @@ struct RestoreOp {
   absl::Status status;
 };
 
+// Runs the restore operations of the batches claimed from "next_batch" using a
+// single new AbstractBundleReader, so that the index is read once per thread
+// rather than once per batch. The operations of a batch run in order, so that
+// consecutive tensors of a data file are read sequentially through the same
+// buffer.
+void RunBatchesWithNewReader(
+    absl::Span<const std::vector<RestoreOp*>> batches,
+    std::atomic<size_t>* next_batch, BundleCache* cache) {
+  const RestoreOp* first = batches.front().front();
+  std::unique_ptr<AbstractBundleReader> reader =
+      NewBundleReader(first->context->env(), first->reader_prefix, cache);
+  for (size_t i = next_batch->fetch_add(1); i < batches.size();
+       i = next_batch->fetch_add(1)) {
+    for (RestoreOp* op : batches[i]) {
+      op->status = reader->status().ok() ? op->run(reader.get())
+                                         : reader->status();
+      if (!op->status.ok()) break;
+    }
+  }
+}
+
 }  // namespace
 
 absl::Status RestoreTensorsV2(OpKernelContext* context, const Tensor& prefix,
@@ -400,21 +465,11 @@ absl::Status RestoreTensorsV2(OpKernelContext* context, const Tensor& prefix,
                            shape_and_slices_flat(i), prefix_string, dtypes[i]});
   }
 
-  tsl::Env* const env = tsl::Env::Default();
+  tsl::Env* const env = context->env();
   BundleCache cache(env);
 
-  std::unique_ptr<AbstractBundleReader> default_reader;
-
-  const std::string ckptPath = GetEnvAsStr(kCkptFilePathEnv);
-  const std::string float32CkptPrefix = GetEnvAsStr(kFloat32CkptPrefixEnv);
-
-  if (ckptPath.empty()) {
-    default_reader = absl::WrapUnique<BundleReader>(
-        new BundleReader(env, prefix_string, {&cache, false}));
-  } else {
-    default_reader = absl::WrapUnique<MixedBundleReaderWrapper>(
-        new MixedBundleReaderWrapper(env, float32CkptPrefix, ckptPath));
-  }
+  std::unique_ptr<AbstractBundleReader> default_reader =
+      NewBundleReader(env, prefix_string, &cache);
 
   TF_RETURN_IF_ERROR(default_reader->status());
 
@@ -453,22 +508,43 @@ absl::Status RestoreTensorsV2(OpKernelContext* context, const Tensor& prefix,
     }
   }
 
-  if (context->session_config() != nullptr &&
-      context->session_config()->intra_op_parallelism_threads() > 0) {
-    // If an explicit restore parallelism is specified, we use it to run
-    // run both small and large restore ops in parallel.
+  const int num_threads =
+      context->session_config() != nullptr
+          ? context->session_config()->intra_op_parallelism_threads()
+          : 0;
+  if (num_threads > 0) {
+    // If an explicit restore parallelism is specified, we use it to run both
+    // small and large restore ops in parallel. Small ops are batched in file
+    // order, so that each batch reads a contiguous range of a data file, and
+    // each thread reads its batches with one reader.
+    std::vector<std::vector<RestoreOp*>> small_restore_batches;
+    int64_t batch_bytes = 0;
+    for (RestoreOp* op : small_restore_ops) {
+      const int64_t bytes = op->full_tensor_bytes(default_reader.get());
+      if (small_restore_batches.empty() ||
+          (batch_bytes > 0 && batch_bytes + bytes > kSmallBatchBytes)) {
+        small_restore_batches.emplace_back();
+        batch_bytes = 0;
+      }
+      small_restore_batches.back().push_back(op);
+      batch_bytes += bytes;
+    }
+
     auto reader_pool = std::make_unique<thread::ThreadPool>(
-        tsl::Env::Default(), "restore_tensors",
-        context->session_config()->intra_op_parallelism_threads());
+        tsl::Env::Default(), "restore_tensors", num_threads);
 
     // Schedule large ops first, followed by the small.
     for (auto* op : large_restore_ops) {
       reader_pool->Schedule(
           [op, &cache]() { op->run_with_new_reader(&cache); });
     }
-    for (auto* op : small_restore_ops) {
-      reader_pool->Schedule(
-          [op, &cache]() { op->run_with_new_reader(&cache); });
+    std::atomic<size_t> next_batch(0);
+    const size_t num_batch_readers =
+        std::min<size_t>(num_threads, small_restore_batches.size());
+    for (size_t i = 0; i < num_batch_readers; ++i) {
+      reader_pool->Schedule([&small_restore_batches, &next_batch, &cache]() {
+        RunBatchesWithNewReader(small_restore_batches, &next_batch, &cache);
+      });
     }
 
     // Wait for all scheduled work to finish and check the status of all
@@ -484,8 +560,8 @@ absl::Status RestoreTensorsV2(OpKernelContext* context, const Tensor& prefix,
     // Avoid creating a pool if there are no large restore ops.
     std::unique_ptr<thread::ThreadPool> reader_pool;
     if (!large_restore_ops.empty()) {
-      reader_pool.reset(
-          new thread::ThreadPool(Env::Default(), "restore_tensors", 8));
+      reader_pool = std::make_unique<thread::ThreadPool>(
+          tsl::Env::Default(), "restore_tensors", 8);
       for (auto* op : large_restore_ops) {
         reader_pool->Schedule(
             [op, &cache]() { op->run_with_new_reader(&cache); });
@@ -16,22 +16,32 @@ limitations under the License.
 // See docs in ../ops/io_ops.cc.
 
 #include <cstddef>
+#include <functional>
 #include <limits>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/types/span.h"
+
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/resource_mgr.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_util.h"
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/framework/types.pb.h"
 #include "tensorflow/core/kernels/checkpoint_callback_manager.h"
 #include "tensorflow/core/kernels/save_restore_tensor.h"
 #include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/io/path.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/logging.h"  // IWYU pragma: keep
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/notification.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/util/saved_tensor_slice_util.h"
 #include "tensorflow/core/util/tensor_bundle/naming.h"
@@ -90,6 +100,184 @@ void ValidateInputs(bool is_save_op, OpKernelContext* context,
   }
 }
 
+// Writes the named tensors, or the slices of them given by the non-empty
+// "shape_and_slices", to the tensor bundle at "prefix".
+absl::Status WriteTensorBundle(const string& prefix,
+                               absl::Span<const tstring> tensor_names,
+                               absl::Span<const tstring> shape_and_slices,
+                               absl::Span<const Tensor> tensors) {
+  BundleWriter writer(Env::Default(), prefix);
+  TF_RETURN_IF_ERROR(writer.status());
+  VLOG(1) << "BundleWriter, prefix_string: " << prefix;
+
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    const string& tensor_name = tensor_names[i];
+    const Tensor& tensor = tensors[i];
+    VLOG(2) << "Starting save of " << tensor_name;
+
+    if (!shape_and_slices[i].empty()) {
+      const string& shape_spec = shape_and_slices[i];
+      TensorShape shape;
+      TensorSlice slice(tensor.dims());
+      TensorShape slice_shape;
+
+      TF_RETURN_IF_ERROR(checkpoint::ParseShapeAndSlice(shape_spec, &shape,
+                                                        &slice, &slice_shape));
+      if (!slice_shape.IsSameSize(tensor.shape())) {
+        return errors::InvalidArgument(
+            "Slice in shape_and_slice specification does not match the shape "
+            "of the tensor to  save: ",
+            shape_spec, ", tensor: ", tensor.shape().DebugString());
+      }
+
+      TF_RETURN_IF_ERROR(writer.AddSlice(tensor_name, shape, slice, tensor));
+    } else {
+      TF_RETURN_IF_ERROR(writer.Add(tensor_name, tensor));
+    }
+
+    if (VLOG_IS_ON(5)) {
+      if (tensor.dtype() == DT_FLOAT) {
+        const float* t_data = tensor.flat<float>().data();
+        float min = std::numeric_limits<float>::infinity();
+        float max = -std::numeric_limits<float>::infinity();
+        double avg = 0.0;
+        for (int i = 0; i < tensor.NumElements(); ++i) {
+          if (t_data[i] < min) min = t_data[i];
+          if (t_data[i] > max) max = t_data[i];
+          avg += t_data[i];
+        }
+        VLOG(5) << " min " << min << " max " << max << " avg "
+                << avg / tensor.NumElements() << " total elts "
+                << tensor.NumElements();
+      }
+    }
+
+    VLOG(2) << "Done save of " << tensor_name;
+  }
+  TF_RETURN_IF_ERROR(writer.Finish());
+  VLOG(1) << "Done BundleWriter, prefix_string: " << prefix;
+  return absl::OkStatus();
+}
+
+// Runs the checkpoint callbacks registered for a save to "prefix".
+absl::Status NotifyCheckpointSaved(OpKernelContext* context,
+                                   const string& prefix) {
+  ResourceMgr* resource_manager = context->resource_manager();
+  if (resource_manager == nullptr) return absl::OkStatus();
+  checkpoint::CheckpointCallbackManager* checkpoint_callback_manager;
+  TF_RETURN_IF_ERROR(
+      resource_manager->LookupOrCreate<checkpoint::CheckpointCallbackManager>(
+          resource_manager->default_container(),
+          std::string(checkpoint::kCheckpointCallbackManagerResourceName),
+          &checkpoint_callback_manager,
+          [](checkpoint::CheckpointCallbackManager** out) {
+            *out = new checkpoint::CheckpointCallbackManager();
+            return absl::OkStatus();
+          }));
+  checkpoint_callback_manager->Save(prefix);
+  checkpoint_callback_manager->Unref();
+  return absl::OkStatus();
+}
+
+// The checkpoint saves started by _AsyncSaveV2 that haven't been waited for
+// by _WaitForAsyncSaves, by prefix. A finished save that is never waited for
+// is dropped after kExpiryMicros, or when a new save to its prefix starts.
+class AsyncSaves {
+ public:
+  static AsyncSaves* Global() {
+    static AsyncSaves* saves = new AsyncSaves();
+    return saves;
+  }
+
+  // Runs "save" in the background as the save to "prefix".
+  absl::Status Start(const string& prefix, std::function<absl::Status()> save) {
+    auto pending = std::make_shared<PendingSave>();
+    {
+      mutex_lock l(mu_);
+      ExpireSavesLocked();
+      auto [it, inserted] = saves_.emplace(prefix, pending);
+      if (!inserted) {
+        if (!it->second->done.HasBeenNotified()) {
+          return errors::AlreadyExists(
+              "A checkpoint save to ", prefix,
+              " is already in progress; wait for it with _WaitForAsyncSaves "
+              "before saving to the same prefix again");
+        }
+        DropSave(prefix, *it->second);
+        it->second = pending;
+      }
+    }
+    pool_.Schedule([pending, save = std::move(save)]() {
+      pending->status = save();
+      pending->done_micros = Env::Default()->NowMicros();
+      pending->done.Notify();
+    });
+    return absl::OkStatus();
+  }
+
+  // Blocks until the save to "prefix" is done, and returns its status.
+  absl::Status Wait(const string& prefix) {
+    std::shared_ptr<PendingSave> pending;
+    {
+      mutex_lock l(mu_);
+      ExpireSavesLocked();
+      auto it = saves_.find(prefix);
+      if (it == saves_.end()) {
+        return errors::NotFound("No checkpoint save to ", prefix,
+                                " is in progress");
+      }
+      pending = it->second;
+    }
+    pending->done.WaitForNotification();
+    mutex_lock l(mu_);
+    auto it = saves_.find(prefix);
+    if (it != saves_.end() && it->second == pending) saves_.erase(it);
+    return pending->status;
+  }
+
+ private:
+  struct PendingSave {
+    Notification done;
+    // Set before `done` is notified.
+    absl::Status status;
+    uint64 done_micros = 0;
+  };
+
+  AsyncSaves() : pool_(Env::Default(), "async_checkpoint_save", kNumThreads) {}
+
+  // Drops the finished saves that were not waited for in time.
+  void ExpireSavesLocked() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    const uint64 now_micros = Env::Default()->NowMicros();
+    for (auto it = saves_.begin(); it != saves_.end();) {
+      const PendingSave& save = *it->second;
+      if (save.done.HasBeenNotified() &&
+          now_micros - save.done_micros > kExpiryMicros) {
+        DropSave(it->first, save);
+        saves_.erase(it++);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  static void DropSave(const string& prefix, const PendingSave& save) {
+    LOG(WARNING) << "Dropping the checkpoint save to " << prefix
+                 << " that was never waited for with _WaitForAsyncSaves. "
+                 << "Its status was: " << save.status;
+  }
+
+  // Number of bundles written concurrently.
+  static constexpr int kNumThreads = 4;
+
+  // How long a finished save is kept for _WaitForAsyncSaves.
+  static constexpr uint64 kExpiryMicros = 10 * 60 * 1000 * 1000ULL;
+
+  mutex mu_;
+  absl::flat_hash_map<string, std::shared_ptr<PendingSave>> saves_
+      TF_GUARDED_BY(mu_);
+  thread::ThreadPool pool_;
+};
+
 }  // namespace
 
 // Saves a list of named tensors using the tensor bundle library.
@@ -108,82 +296,86 @@ class SaveV2 : public OpKernel {
     const int kFixedInputs = 3;  // Prefix, tensor names, shape_and_slices.
     const int num_tensors = static_cast<int>(tensor_names.NumElements());
     const string& prefix_string = prefix.scalar<tstring>()();
-    const auto& tensor_names_flat = tensor_names.flat<tstring>();
-    const auto& shape_and_slices_flat = shape_and_slices.flat<tstring>();
+    std::vector<Tensor> tensors;
+    tensors.reserve(num_tensors);
+    for (int i = 0; i < num_tensors; ++i) {
+      tensors.push_back(context->input(i + kFixedInputs));
+    }
+
+    const absl::Span<const tstring> names(tensor_names.flat<tstring>());
+    const absl::Span<const tstring> slices(shape_and_slices.flat<tstring>());
+    OP_REQUIRES_OK(context,
+                   WriteTensorBundle(prefix_string, names, slices, tensors));
+    OP_REQUIRES_OK(context, NotifyCheckpointSaved(context, prefix_string));
+  }
+};
+REGISTER_KERNEL_BUILDER(Name("SaveV2").Device(DEVICE_CPU), SaveV2);
 
-    BundleWriter writer(Env::Default(), prefix_string);
-    OP_REQUIRES_OK(context, writer.status());
-    VLOG(1) << "BundleWriter, prefix_string: " << prefix_string;
+// Starts saving a list of named tensors from a background thread, and returns
+// once the tensors are copied.
+class AsyncSaveV2 : public OpKernel {
+ public:
+  explicit AsyncSaveV2(OpKernelConstruction* context) : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    const Tensor& prefix = context->input(0);
+    const Tensor& tensor_names = context->input(1);
+    const Tensor& shape_and_slices = context->input(2);
+    ValidateInputs(true /* is save op */, context, prefix, tensor_names,
+                   shape_and_slices);
+    if (!context->status().ok()) return;
 
+    const int kFixedInputs = 3;  // Prefix, tensor names, shape_and_slices.
+    const int num_tensors = static_cast<int>(tensor_names.NumElements());
+    string prefix_string = prefix.scalar<tstring>()();
+    const auto& tensor_names_flat = tensor_names.flat<tstring>();
+    const auto& shape_and_slices_flat = shape_and_slices.flat<tstring>();
+    std::vector<tstring> names(tensor_names_flat.data(),
+                               tensor_names_flat.data() + num_tensors);
+    std::vector<tstring> slices(shape_and_slices_flat.data(),
+                                shape_and_slices_flat.data() + num_tensors);
+    // The inputs may alias the buffers of reference variables, or of resource
+    // variables in Hogwild mode, which are updated in place. Copy them, so
+    // that the checkpoint holds their values at the time of this op.
+    std::vector<Tensor> tensors;
+    tensors.reserve(num_tensors);
     for (int i = 0; i < num_tensors; ++i) {
-      const string& tensor_name = tensor_names_flat(i);
-      const Tensor& tensor = context->input(i + kFixedInputs);
-      VLOG(2) << "Starting save of " << tensor_name;
-
-      if (!shape_and_slices_flat(i).empty()) {
-        const string& shape_spec = shape_and_slices_flat(i);
-        TensorShape shape;
-        TensorSlice slice(tensor.dims());
-        TensorShape slice_shape;
-
-        OP_REQUIRES_OK(context, checkpoint::ParseShapeAndSlice(
-                                    shape_spec, &shape, &slice, &slice_shape));
-        OP_REQUIRES(context, slice_shape.IsSameSize(tensor.shape()),
-                    errors::InvalidArgument("Slice in shape_and_slice "
-                                            "specification does not match the "
-                                            "shape of the tensor to  save: ",
-                                            shape_spec, ", tensor: ",
-                                            tensor.shape().DebugString()));
-
-        OP_REQUIRES_OK(context,
-                       writer.AddSlice(tensor_name, shape, slice, tensor));
-      } else {
-        OP_REQUIRES_OK(context, writer.Add(tensor_name, tensor));
-      }
+      tensors.push_back(tensor::DeepCopy(context->input(i + kFixedInputs)));
+    }
 
-      if (VLOG_IS_ON(5)) {
-        if (tensor.dtype() == DT_FLOAT) {
-          const float* t_data = tensor.flat<float>().data();
-          float min = std::numeric_limits<float>::infinity();
-          float max = -std::numeric_limits<float>::infinity();
-          double avg = 0.0;
-          for (int i = 0; i < tensor.NumElements(); ++i) {
-            if (t_data[i] < min) min = t_data[i];
-            if (t_data[i] > max) max = t_data[i];
-            avg += t_data[i];
-          }
-          VLOG(5) << " min " << min << " max " << max << " avg "
-                  << avg / tensor.NumElements() << " total elts "
-                  << tensor.NumElements();
-        }
-      }
+    OP_REQUIRES_OK(
+        context,
+        AsyncSaves::Global()->Start(
+            prefix_string, [prefix_string, names = std::move(names),
+                            slices = std::move(slices),
+                            tensors = std::move(tensors)]() {
+              return WriteTensorBundle(prefix_string, names, slices, tensors);
+            }));
+  }
+};
+REGISTER_KERNEL_BUILDER(Name("_AsyncSaveV2").Device(DEVICE_CPU), AsyncSaveV2);
 
-      VLOG(2) << "Done save of " << tensor_name;
-    }
-    OP_REQUIRES_OK(context, writer.Finish());
-    VLOG(1) << "Done BundleWriter, prefix_string: " << prefix_string;
+// Waits for the saves started by _AsyncSaveV2 to the given prefixes.
+class WaitForAsyncSaves : public OpKernel {
+ public:
+  explicit WaitForAsyncSaves(OpKernelConstruction* context)
+      : OpKernel(context) {}
 
-    ResourceMgr* resource_manager = context->resource_manager();
-    if (resource_manager != nullptr) {
-      checkpoint::CheckpointCallbackManager* checkpoint_callback_manager;
-      OP_REQUIRES_OK(
-          context,
-          resource_manager
-              ->LookupOrCreate<checkpoint::CheckpointCallbackManager>(
-                  resource_manager->default_container(),
-                  std::string(
-                      checkpoint::kCheckpointCallbackManagerResourceName),
-                  &checkpoint_callback_manager,
-                  [](checkpoint::CheckpointCallbackManager** out) {
-                    *out = new checkpoint::CheckpointCallbackManager();
-                    return absl::OkStatus();
-                  }));
-      checkpoint_callback_manager->Save(prefix_string);
-      checkpoint_callback_manager->Unref();
+  void Compute(OpKernelContext* context) override {
+    const Tensor& prefixes = context->input(0);
+    const auto& prefixes_flat = prefixes.flat<tstring>();
+    absl::Status status;
+    for (int64_t i = 0; i < prefixes_flat.size(); ++i) {
+      const string& prefix = prefixes_flat(i);
+      const absl::Status s = AsyncSaves::Global()->Wait(prefix);
+      if (s.ok()) status.Update(NotifyCheckpointSaved(context, prefix));
+      status.Update(s);
     }
+    OP_REQUIRES_OK(context, status);
   }
 };
-REGISTER_KERNEL_BUILDER(Name("SaveV2").Device(DEVICE_CPU), SaveV2);
+REGISTER_KERNEL_BUILDER(Name("_WaitForAsyncSaves").Device(DEVICE_CPU),
+                        WaitForAsyncSaves);
 
 // Restores a list of named tensors from a tensor bundle (V2 checkpoint format).
 class RestoreV2 : public OpKernel {
@@ -211,7 +403,7 @@ class RestoreV2 : public OpKernel {
     // reader as we upgrade to the V2 format.  This allows transparent upgrade.
     // We here attempt to read a V1 checkpoint, if "prefix_string" does not
     // refer to a V2 checkpoint.
-    Env* env = Env::Default();
+    Env* env = context->env();
     std::vector<string> paths;
     if (!env->GetMatchingPaths(MetaFilename(prefix_string), &paths).ok() ||
         paths.empty()) {
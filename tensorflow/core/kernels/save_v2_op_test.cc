@@ -20,6 +20,7 @@ limitations under the License.
 #include "tensorflow/core/framework/node_def_builder.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/framework/types.pb.h"
 #include "tensorflow/core/kernels/ops_testutil.h"
@@ -340,5 +341,107 @@ TEST_F(SaveV2OpTest, Simple) {
   }
 }
 
+class AsyncSaveV2OpTest : public OpsTestBase {
+ protected:
+  void MakeSaveOp() {
+    TF_ASSERT_OK(NodeDefBuilder("save", "_AsyncSaveV2")
+                     .Input(FakeInput())  // prefix
+                     .Input(FakeInput())  // tensor_names
+                     .Input(FakeInput())  // shape_and_slices
+                     .Input(FakeInput({DT_INT32, DT_FLOAT}))  // tensors
+                     .Finalize(node_def()));
+    TF_ASSERT_OK(InitOp());
+  }
+
+  absl::Status RunWaitOp(const string& prefix) {
+    TF_RETURN_IF_ERROR(NodeDefBuilder("wait", "_WaitForAsyncSaves")
+                           .Input(FakeInput())  // prefixes
+                           .Finalize(node_def()));
+    TF_RETURN_IF_ERROR(InitOp());
+    inputs_.clear();
+    AddInputFromArray<tstring>(TensorShape({1}), {prefix});
+    return RunOpKernel();
+  }
+};
+
+TEST_F(AsyncSaveV2OpTest, SaveThenWait) {
+  const string prefix = io::JoinPath(testing::TmpDir(), "tensor_async");
+  MakeSaveOp();
+  AddInputFromArray<tstring>(TensorShape({}), {prefix});
+  AddInputFromArray<tstring>(TensorShape({2}), {"tensor_int", "tensor_float"});
+  AddInputFromArray<tstring>(TensorShape({2}), {"", ""});
+  AddInput<int32>(TensorShape({10}), [](int x) -> int32 { return x + 1; });
+  AddInput<float>(TensorShape({2, 4}),
+                  [](int x) -> float { return static_cast<float>(x) / 10; });
+  TF_ASSERT_OK(RunOpKernel());
+
+  // Saving again to the same prefix before waiting fails.
+  EXPECT_TRUE(absl::IsAlreadyExists(RunOpKernel()));
+
+  TF_ASSERT_OK(RunWaitOp(prefix));
+
+  BundleReader reader(Env::Default(), prefix);
+  TF_ASSERT_OK(reader.status());
+  Tensor val;
+  TF_EXPECT_OK(reader.Lookup("tensor_int", &val));
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(i + 1, val.flat<int32>()(i));
+  }
+  TF_EXPECT_OK(reader.Lookup("tensor_float", &val));
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(static_cast<float>(i) / 10, val.flat<float>()(i));
+  }
+}
+
+TEST_F(AsyncSaveV2OpTest, SavesValuesAtTimeOfOp) {
+  const string prefix = io::JoinPath(testing::TmpDir(), "tensor_async_copy");
+  MakeSaveOp();
+  AddInputFromArray<tstring>(TensorShape({}), {prefix});
+  AddInputFromArray<tstring>(TensorShape({2}), {"tensor_int", "tensor_float"});
+  AddInputFromArray<tstring>(TensorShape({2}), {"", ""});
+  AddInputFromArray<int32>(TensorShape({2}), {1, 2});
+  AddInputFromArray<float>(TensorShape({1}), {0.5f});
+  TF_ASSERT_OK(RunOpKernel());
+  // Update the inputs in place, as the Assign of a reference variable does.
+  mutable_input(3).tensor->flat<int32>().setZero();
+  mutable_input(4).tensor->flat<float>().setZero();
+  TF_ASSERT_OK(RunWaitOp(prefix));
+
+  BundleReader reader(Env::Default(), prefix);
+  TF_ASSERT_OK(reader.status());
+  Tensor val;
+  TF_EXPECT_OK(reader.Lookup("tensor_int", &val));
+  test::ExpectTensorEqual<int32>(val, test::AsTensor<int32>({1, 2}));
+  TF_EXPECT_OK(reader.Lookup("tensor_float", &val));
+  test::ExpectTensorEqual<float>(val, test::AsTensor<float>({0.5f}));
+}
+
+TEST_F(AsyncSaveV2OpTest, ReplacesFinishedSaveThatWasNotWaitedFor) {
+  const string prefix = io::JoinPath(testing::TmpDir(), "tensor_async_again");
+  MakeSaveOp();
+  AddInputFromArray<tstring>(TensorShape({}), {prefix});
+  AddInputFromArray<tstring>(TensorShape({2}), {"tensor_int", "tensor_float"});
+  AddInputFromArray<tstring>(TensorShape({2}), {"", ""});
+  AddInputFromArray<int32>(TensorShape({2}), {1, 2});
+  AddInputFromArray<float>(TensorShape({1}), {0.5f});
+  TF_ASSERT_OK(RunOpKernel());
+
+  // Saving again succeeds once the first save is done.
+  absl::Status status;
+  for (int i = 0; i < 1000; ++i) {
+    status = RunOpKernel();
+    if (!absl::IsAlreadyExists(status)) break;
+    Env::Default()->SleepForMicroseconds(10 * 1000);
+  }
+  TF_ASSERT_OK(status);
+  TF_ASSERT_OK(RunWaitOp(prefix));
+  EXPECT_TRUE(absl::IsNotFound(RunWaitOp(prefix)));
+}
+
+TEST_F(AsyncSaveV2OpTest, WaitWithoutSave) {
+  const string prefix = io::JoinPath(testing::TmpDir(), "tensor_not_saved");
+  EXPECT_TRUE(absl::IsNotFound(RunWaitOp(prefix)));
+}
+
 }  // namespace
 }  // namespace tensorflow
@@ -20,8 +20,11 @@ limitations under the License.
 
 #define EIGEN_USE_THREADS
 
+#include <algorithm>
 #include <atomic>
+#include <vector>
 
+#include "absl/base/prefetch.h"
 #include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
 
 #include "tensorflow/core/framework/bounds_check.h"
@@ -102,6 +105,73 @@ class UpdateExecutor<T, Input, Update, Output, scatter_nd_op::UpdateOp::MAX> {
 
 namespace functor {
 
+// Updates with at least this many elements in total, and slices of at most
+// this many elements, are applied in parallel by partitioning the output rows.
+// Larger slices are each updated with all threads instead.
+constexpr int64_t kScatterNdParallelMinElements = 32 * 1024;
+constexpr int64_t kScatterNdParallelMaxSliceElements = 32 * 1024;
+
+// Applies the updates of `Tupdates` to the rows `dest` of `Toutput` on the
+// threads of `d`. Negative rows are skipped.
+//
+// The output rows are split into contiguous ranges, one per thread, and the
+// updates of each range are applied by a single thread in their original
+// order. This makes the parallel updates conflict free, and gives the same
+// result as applying the updates in order, also for duplicate rows.
+template <typename T, typename Index, scatter_nd_op::UpdateOp OP>
+void ParallelScatterNdUpdate(const CPUDevice& d,
+                             const std::vector<Index>& dest,
+                             typename TTypes<T, 2>::ConstTensor Tupdates,
+                             typename TTypes<T, 2>::Tensor Toutput) {
+  const int64_t num_rows = Toutput.dimension(0);
+  const int64_t num_updates = dest.size();
+  const int num_partitions = static_cast<int>(
+      std::min<int64_t>(std::max(1, 4 * d.numThreads()), num_rows));
+  auto partition_of = [num_rows, num_partitions](Index row) {
+    return static_cast<int>(static_cast<int64_t>(row) * num_partitions /
+                            num_rows);
+  };
+
+  // Buckets the updates by partition, in their original order.
+  std::vector<Index> partition_begin(num_partitions + 1, 0);
+  for (const Index row : dest) {
+    if (row >= 0) ++partition_begin[partition_of(row) + 1];
+  }
+  for (int p = 0; p < num_partitions; ++p) {
+    partition_begin[p + 1] += partition_begin[p];
+  }
+  std::vector<Index> cursors(partition_begin.begin(),
+                             partition_begin.end() - 1);
+  std::vector<Index> order(partition_begin[num_partitions]);
+  for (Index loc = 0; loc < num_updates; ++loc) {
+    if (dest[loc] >= 0) order[cursors[partition_of(dest[loc])]++] = loc;
+  }
+
+  const Eigen::DefaultDevice serial_device;
+  const Eigen::TensorOpCost cost(
+      0, 0, static_cast<double>(Toutput.dimension(1)) * num_updates /
+                num_partitions);
+  auto work = [&](Eigen::Index begin, Eigen::Index end) {
+    const Index limit = partition_begin[end];
+    for (Index k = partition_begin[begin]; k < limit; ++k) {
+      const Index loc = order[k];
+      if (k + 1 < limit) {
+        // Rows are accessed in random order, so fetch the next ones early.
+        absl::PrefetchToLocalCache(&Toutput(dest[order[k + 1]], 0));
+        absl::PrefetchToLocalCache(&Tupdates(order[k + 1], 0));
+      }
+      auto input_chip = Toutput.template chip<0>(dest[loc]);
+      auto output_chip = input_chip;
+      auto update_chip = Tupdates.template chip<0>(loc);
+      update_executor::UpdateExecutor<
+          Eigen::DefaultDevice, decltype(input_chip), decltype(update_chip),
+          decltype(output_chip), OP>::Execute(serial_device, input_chip,
+                                              update_chip, output_chip);
+    }
+  };
+  d.parallelFor(num_partitions, cost, work);
+}
+
 // Implementation of update functor for CPU.
 template <typename T, typename Index, scatter_nd_op::UpdateOp OP, int IXDIM>
 struct ScatterNdFunctor<CPUDevice, T, Index, OP, IXDIM> {
@@ -127,6 +197,15 @@ struct ScatterNdFunctor<CPUDevice, T, Index, OP, IXDIM> {
           batch_strides[dim + 1] * output_shape_prefix[dim + 1];
     }
 
+    const int64_t total_elements =
+        static_cast<int64_t>(batch_size) * Toutput.dimension(1);
+    const bool parallel = d.numThreads() > 1 && Toutput.dimension(0) > 1 &&
+                          total_elements >= kScatterNdParallelMinElements &&
+                          Toutput.dimension(1) <=
+                              kScatterNdParallelMaxSliceElements;
+    std::vector<Index> dest;
+    if (parallel) dest.resize(batch_size);
+
     for (Eigen::DenseIndex loc = 0; loc < batch_size; ++loc) {
       Index i = 0;
       bool out_of_bounds = false;
@@ -139,7 +218,10 @@ struct ScatterNdFunctor<CPUDevice, T, Index, OP, IXDIM> {
         error_loc = loc;
         // Don't break the loop here, but continue to update the rest because
         // the caller might ignore bad indices.
+        if (parallel) dest[loc] = -1;
         continue;
+      } else if (parallel) {
+        dest[loc] = i;
       } else {
         auto input_chip = Toutput.template chip<0>(i);
         auto output_chip = input_chip;
@@ -150,6 +232,9 @@ struct ScatterNdFunctor<CPUDevice, T, Index, OP, IXDIM> {
                                                 output_chip);
       }
     }
+    if (parallel) {
+      ParallelScatterNdUpdate<T, Index, OP>(d, dest, Tupdates, Toutput);
+    }
 
     return error_loc;
   }
@@ -522,6 +522,33 @@ TEST_F(ScatterNdOpTest, Simple_OneD) {
   test::ExpectTensorEqual<float>(expected, *GetOutput(0));
 }
 
+TEST_F(ScatterNdOpTest, LargeWithDuplicates) {
+  MakeOp(DT_FLOAT, DT_INT32);
+
+  // Enough updates to be applied in parallel.
+  const int kNumRows = 1000;
+  const int kSliceSize = 4;
+  const int kNumUpdates = 20000;
+  std::vector<int32> indices(kNumUpdates);
+  std::vector<float> updates(kNumUpdates * kSliceSize);
+  std::vector<float> expected_values(kNumRows * kSliceSize, 0);
+  for (int i = 0; i < kNumUpdates; ++i) {
+    indices[i] = (i * 7919) % kNumRows;
+    for (int j = 0; j < kSliceSize; ++j) {
+      updates[i * kSliceSize + j] = i % 13 + j;
+      expected_values[indices[i] * kSliceSize + j] += i % 13 + j;
+    }
+  }
+  AddInputFromArray<int32>(TensorShape({kNumUpdates, 1}), indices);
+  AddInputFromArray<float>(TensorShape({kNumUpdates, kSliceSize}), updates);
+  AddInputFromArray<int32>(TensorShape({2}), {kNumRows, kSliceSize});
+  TF_ASSERT_OK(RunOpKernel());
+
+  Tensor expected(allocator(), DT_FLOAT, TensorShape({kNumRows, kSliceSize}));
+  test::FillValues<float>(&expected, expected_values);
+  test::ExpectTensorEqual<float>(expected, *GetOutput(0));
+}
+
 TEST_F(ScatterNdOpTest, Error_IndexOutOfRange) {
   MakeOp(DT_FLOAT, DT_INT32);
 
@@ -28,6 +28,7 @@ class OpKernelContext;
 
 bool UseDeterministicSegmentReductions();
 bool DisableSegmentReductionOpDeterminismExceptions();
+bool SortSegmentIdsForWideUnsortedSegmentReductions();
 
 // Type of SparseSegmentReduction operation to perform gradient of.
 enum class SparseSegmentReductionOperation { kSum, kMean, kSqrtN };
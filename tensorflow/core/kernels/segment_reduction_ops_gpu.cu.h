@@ -846,6 +846,12 @@ void SegmentReductionFunctor<
   }
 }
 
+// Minimum row size and number of rows of the input of an unsorted segment
+// reduction for it to sort the segment ids rather than use atomics, when
+// TF_SORT_WIDE_UNSORTED_SEGMENT_REDUCTIONS is set.
+constexpr int64_t kMinInnerDimSizeForSortedReduction = 32;
+constexpr int64_t kMinOuterDimSizeForSortedReduction = 4096;
+
 template <typename T, typename Index, typename InitialValueF,
           typename ReductionF>
 struct UnsortedSegmentFunctor<GPUDevice, T, Index, InitialValueF, ReductionF> {
@@ -883,6 +889,18 @@ struct UnsortedSegmentFunctor<GPUDevice, T, Index, InitialValueF, ReductionF> {
     const Index output_outer_dim_size = output.dimension(0);
     const Index num_segments = output.size() / input_inner_dim_size;
 
+    // With rows as wide as embeddings, e.g. for the gradient of a gather, the
+    // atomic kernel serializes the updates of frequent segment ids. Sorting
+    // costs one key per row while the reduction processes a whole row, so the
+    // sorted kernels, which reduce each segment without atomics, are used for
+    // such inputs even when determinism is not required. This is opt-in until
+    // the thresholds are tuned on more GPUs.
+    if (SortSegmentIdsForWideUnsortedSegmentReductions() &&
+        input_inner_dim_size >= kMinInnerDimSizeForSortedReduction &&
+        input_outer_dim_size >= kMinOuterDimSizeForSortedReduction) {
+      use_deterministic_kernels = true;
+    }
+
     // TODO(benbarsdell): If there are no performance concerns with the new
     // deterministic kernels, remove this runtime check and the old
     // non-deterministic kernels.
@@ -44,6 +44,23 @@ bool DisableSegmentReductionOpDeterminismExceptions() {
   return cached_disable;
 }
 
+bool SortSegmentIdsForWideUnsortedSegmentReductions() {
+  static bool cached_result = [] {
+    bool result = false;
+    absl::Status status = tensorflow::ReadBoolFromEnvVar(
+        "TF_SORT_WIDE_UNSORTED_SEGMENT_REDUCTIONS",
+        /*default_val=*/false, &result);
+    if (!status.ok()) {
+      LOG(WARNING) << "Sorting the segment ids of unsorted segment reductions "
+                      "is disabled: "
+                   << status;
+      return false;
+    }
+    return result;
+  }();
+  return cached_result;
+}
+
 namespace functor {
 
 #define DEFINE_SORTED_GPU_SPECS_INDEX(T, Index)               \
@@ -19,12 +19,16 @@ limitations under the License.
 
 #include "tensorflow/core/kernels/sparse_tensor_dense_matmul_op.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "Eigen/Core"  // from @eigen_archive
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/op.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/kernels/fill_functor.h"
 #include "tensorflow/core/platform/bfloat16.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
 
@@ -251,8 +255,84 @@ absl::Status MOutOfBoundsError(int64_t m, std::size_t i, int lhs_index_a,
                                  "] out of bounds (>=", out_dim0, ")");
 }
 
+// Products with at least this many nonzeros, and rows of B at least this long,
+// are computed in parallel over the rows of the output.
+constexpr std::size_t kParallelMinNnz = 4096;
+constexpr std::size_t kParallelMinRhsRight = 32;
+// Number of columns of the output updated by each pass over the nonzeros of a
+// row, so that the columns stay in cache across the nonzeros.
+constexpr std::size_t kParallelColumnTile = 256;
+
+// Computes the product with the nonzeros grouped by row of the output, as in
+// CSR format, and the rows computed in parallel. With the nonzeros of each
+// row kept in their original order, the sums are accumulated in the same order
+// as by the sequential loop.
+template <typename T, typename Tsum, typename Tindices, bool ADJ_A>
+absl::Status ParallelSparseTensorDenseMatMulImpl(
+    const DeviceBase::CpuWorkerThreads& worker_threads,
+    typename TTypes<Tsum>::Matrix out,
+    typename TTypes<Tindices>::ConstMatrix a_indices,
+    typename TTypes<T>::ConstVec a_values, typename TTypes<T>::ConstMatrix b) {
+  const std::size_t nnz = a_values.size();
+  const int64_t num_rows = out.dimension(0);
+  const std::size_t rhs_right = b.dimension(1);
+  const std::size_t lhs_right = b.dimension(0);
+  const int lhs_index_a = ADJ_A ? 1 : 0;
+  const int rhs_index_a = ADJ_A ? 0 : 1;
+
+  // Row offsets of the nonzeros, and the nonzeros sorted by row.
+  std::vector<int64_t> row_starts(num_rows + 1, 0);
+  for (std::size_t i = 0; i < nnz; ++i) {
+    const Tindices m = internal::SubtleMustCopy(a_indices(i, lhs_index_a));
+    const Tindices k = internal::SubtleMustCopy(a_indices(i, rhs_index_a));
+    if (!FastBoundsCheck(k, lhs_right)) {
+      return KOutOfBoundsError(k, i, rhs_index_a, lhs_right);
+    }
+    if (!FastBoundsCheck(m, num_rows)) {
+      return MOutOfBoundsError(m, i, lhs_index_a, num_rows);
+    }
+    ++row_starts[m + 1];
+  }
+  for (int64_t m = 0; m < num_rows; ++m) row_starts[m + 1] += row_starts[m];
+  std::vector<Tindices> cols(nnz);
+  std::vector<Tsum> values(nnz);
+  {
+    std::vector<int64_t> next(row_starts.begin(), row_starts.end() - 1);
+    for (std::size_t i = 0; i < nnz; ++i) {
+      const int64_t pos = next[a_indices(i, lhs_index_a)]++;
+      cols[pos] = a_indices(i, rhs_index_a);
+      values[pos] =
+          static_cast<Tsum>(ADJ_A ? MaybeConj(a_values(i)) : a_values(i));
+    }
+  }
+
+  auto compute_rows = [&](int64_t begin, int64_t end) {
+    for (int64_t m = begin; m < end; ++m) {
+      Tsum* out_row = &out(m, 0);
+      for (std::size_t n0 = 0; n0 < rhs_right; n0 += kParallelColumnTile) {
+        const std::size_t n1 = std::min(rhs_right, n0 + kParallelColumnTile);
+        for (int64_t j = row_starts[m]; j < row_starts[m + 1]; ++j) {
+          const T* b_row = &b(cols[j], 0);
+          const Tsum a_value = values[j];
+          for (std::size_t n = n0; n < n1; ++n) {
+            out_row[n] += a_value * static_cast<Tsum>(b_row[n]);
+          }
+        }
+      }
+    }
+  };
+  const int64_t cost_per_row =
+      std::max<int64_t>(1, nnz / num_rows) * rhs_right *
+      (Eigen::TensorOpCost::AddCost<Tsum>() +
+       Eigen::TensorOpCost::MulCost<Tsum>());
+  Shard(worker_threads.num_threads, worker_threads.workers, num_rows,
+        cost_per_row, compute_rows);
+  return absl::OkStatus();
+}
+
 template <typename T, typename Tsum, typename Tindices, bool ADJ_A, bool ADJ_B>
 absl::Status SparseTensorDenseMatMulImpl(
+    const DeviceBase::CpuWorkerThreads& worker_threads,
     typename TTypes<Tsum>::Matrix out,
     typename TTypes<Tindices>::ConstMatrix a_indices,
     typename TTypes<T>::ConstVec a_values, typename TTypes<T>::ConstMatrix b) {
@@ -265,6 +345,12 @@ absl::Status SparseTensorDenseMatMulImpl(
   const int lhs_index_a = ADJ_A ? 1 : 0;
   const int rhs_index_a = ADJ_A ? 0 : 1;
 
+  if (!ADJ_B && nnz >= kParallelMinNnz && rhs_right >= kParallelMinRhsRight &&
+      out.dimension(0) > 1 && worker_threads.num_threads > 1) {
+    return ParallelSparseTensorDenseMatMulImpl<T, Tsum, Tindices, ADJ_A>(
+        worker_threads, out, a_indices, a_values, b);
+  }
+
   // TODO(ebrevdo): After many failed experiments, can't find a multi-threaded
   // approach that achieves the performance of the single threaded
   // one.  Perhaps Eigen threadpool implementation is just too slow?
@@ -332,6 +418,8 @@ struct SparseTensorDenseMatMulFunctor<CPUDevice, T, Tindices, ADJ_A, ADJ_B> {
                               typename TTypes<T>::ConstVec a_values,
                               typename TTypes<T>::ConstMatrix b) {
     using Tsum = typename SumType<T>::type;
+    const auto& worker_threads =
+        *ctx->device()->tensorflow_cpu_worker_threads();
     Tensor temp_out_t;
     if (!std::is_same<T, Tsum>::value) {
       TF_RETURN_IF_ERROR(ctx->allocate_temp(
@@ -341,7 +429,7 @@ struct SparseTensorDenseMatMulFunctor<CPUDevice, T, Tindices, ADJ_A, ADJ_B> {
       temp_out.setZero();
       TF_RETURN_IF_ERROR(
           SparseTensorDenseMatMulImpl<T, Tsum, Tindices, ADJ_A, ADJ_B>(
-              temp_out, a_indices, a_values, b));
+              worker_threads, temp_out, a_indices, a_values, b));
       out = temp_out.template cast<T>();
     } else {
       out.setZero();
@@ -351,7 +439,7 @@ struct SparseTensorDenseMatMulFunctor<CPUDevice, T, Tindices, ADJ_A, ADJ_B> {
           *reinterpret_cast<typename TTypes<Tsum>::Matrix*>(&out);
       TF_RETURN_IF_ERROR(
           SparseTensorDenseMatMulImpl<T, Tsum, Tindices, ADJ_A, ADJ_B>(
-              out_workaround, a_indices, a_values, b));
+              worker_threads, out_workaround, a_indices, a_values, b));
     }
     return absl::OkStatus();
   }
@@ -13,15 +13,139 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <cstdint>
 #include <random>
+#include <vector>
 
 #include "tensorflow/core/common_runtime/kernel_benchmark_testlib.h"
+#include "tensorflow/core/framework/device_base.h"
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def_builder.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
 #include "tensorflow/core/graph/node_builder.h"
+#include "tensorflow/core/kernels/ops_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/lib/gtl/array_slice.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/test.h"
 #include "tensorflow/core/platform/test_benchmark.h"
+#include "tensorflow/core/platform/threadpool.h"
 
 namespace tensorflow {
+namespace {
+
+// Runs SparseTensorDenseMatMul on products large enough for the parallel
+// path with 4 worker threads, and checks the result against the sequential
+// path run with a single worker thread.
+class SparseTensorDenseMatMulOpTest : public OpsTestBase {
+ protected:
+  SparseTensorDenseMatMulOpTest()
+      : workers_(Env::Default(), "sparse_matmul_test", /*num_threads=*/4),
+        saved_worker_threads_(device_->tensorflow_cpu_worker_threads()) {}
+
+  ~SparseTensorDenseMatMulOpTest() override {
+    device_->set_tensorflow_cpu_worker_threads(
+        const_cast<DeviceBase::CpuWorkerThreads*>(saved_worker_threads_));
+  }
+
+  // Builds a random A of shape [m, k] (or [k, m] with `adjoint_a`) with `nnz`
+  // unsorted, possibly repeated, nonzeros, and a random B of shape [k, n].
+  void MakeInputs(int64_t nnz, int64_t m, int64_t k, int64_t n,
+                  bool adjoint_a) {
+    std::mt19937 gen(/*seed=*/1234);
+    const int64_t lhs = adjoint_a ? k : m;
+    const int64_t rhs = adjoint_a ? m : k;
+    std::uniform_int_distribution<int64_t> lhs_dist(0, lhs - 1);
+    std::uniform_int_distribution<int64_t> rhs_dist(0, rhs - 1);
+    std::uniform_real_distribution<float> value_dist(-1.0f, 1.0f);
+    a_indices_.clear();
+    a_values_.clear();
+    for (int64_t i = 0; i < nnz; ++i) {
+      a_indices_.push_back(lhs_dist(gen));
+      a_indices_.push_back(rhs_dist(gen));
+      a_values_.push_back(value_dist(gen));
+    }
+    a_shape_ = {lhs, rhs};
+    b_shape_ = TensorShape({k, n});
+    b_.clear();
+    for (int64_t i = 0; i < k * n; ++i) b_.push_back(value_dist(gen));
+  }
+
+  absl::Status RunMatMul(int num_threads, bool adjoint_a) {
+    worker_threads_.num_threads = num_threads;
+    worker_threads_.workers = &workers_;
+    device_->set_tensorflow_cpu_worker_threads(&worker_threads_);
+
+    inputs_.clear();
+    TF_CHECK_OK(NodeDefBuilder("matmul", "SparseTensorDenseMatMul")
+                    .Input(FakeInput(DT_INT64))
+                    .Input(FakeInput(DT_FLOAT))
+                    .Input(FakeInput(DT_INT64))
+                    .Input(FakeInput(DT_FLOAT))
+                    .Attr("adjoint_a", adjoint_a)
+                    .Finalize(node_def()));
+    TF_CHECK_OK(InitOp());
+    const int64_t nnz = a_values_.size();
+    AddInputFromArray<int64_t>(TensorShape({nnz, 2}), a_indices_);
+    AddInputFromArray<float>(TensorShape({nnz}), a_values_);
+    AddInputFromArray<int64_t>(TensorShape({2}), a_shape_);
+    AddInputFromArray<float>(b_shape_, b_);
+    return RunOpKernel();
+  }
+
+  void CheckParallelMatchesSequential(bool adjoint_a) {
+    TF_ASSERT_OK(RunMatMul(/*num_threads=*/4, adjoint_a));
+    const Tensor parallel = *GetOutput(0);
+    TF_ASSERT_OK(RunMatMul(/*num_threads=*/1, adjoint_a));
+    // Both paths accumulate the nonzeros of a row in the same order, but may
+    // contract the multiply-adds differently.
+    test::ExpectClose(*GetOutput(0), parallel);
+  }
+
+  std::vector<int64_t> a_indices_;
+  std::vector<float> a_values_;
+  std::vector<int64_t> a_shape_;
+  TensorShape b_shape_;
+  std::vector<float> b_;
+
+ private:
+  thread::ThreadPool workers_;
+  DeviceBase::CpuWorkerThreads worker_threads_;
+  const DeviceBase::CpuWorkerThreads* const saved_worker_threads_;
+};
+
+TEST_F(SparseTensorDenseMatMulOpTest, ParallelRows) {
+  MakeInputs(/*nnz=*/8192, /*m=*/64, /*k=*/128, /*n=*/300,
+             /*adjoint_a=*/false);
+  CheckParallelMatchesSequential(/*adjoint_a=*/false);
+}
+
+TEST_F(SparseTensorDenseMatMulOpTest, ParallelRowsAdjointA) {
+  MakeInputs(/*nnz=*/8192, /*m=*/64, /*k=*/128, /*n=*/300,
+             /*adjoint_a=*/true);
+  CheckParallelMatchesSequential(/*adjoint_a=*/true);
+}
+
+TEST_F(SparseTensorDenseMatMulOpTest, ParallelRowsWithEmptyRows) {
+  // Most of the 4096 output rows have no nonzeros.
+  MakeInputs(/*nnz=*/4096, /*m=*/4096, /*k=*/16, /*n=*/32,
+             /*adjoint_a=*/false);
+  CheckParallelMatchesSequential(/*adjoint_a=*/false);
+}
+
+TEST_F(SparseTensorDenseMatMulOpTest, ParallelRowsOutOfBounds) {
+  MakeInputs(/*nnz=*/8192, /*m=*/64, /*k=*/128, /*n=*/64,
+             /*adjoint_a=*/false);
+  a_indices_[2 * 100] = 64;
+  const absl::Status parallel = RunMatMul(/*num_threads=*/4, false);
+  const absl::Status sequential = RunMatMul(/*num_threads=*/1, false);
+  EXPECT_TRUE(errors::IsInvalidArgument(parallel)) << parallel;
+  EXPECT_EQ(sequential.message(), parallel.message());
+}
+
+}  // namespace
 
 Node* SparseTensorDenseMatMulNode(Graph* g, Node* a_indices, Node* a_values,
                                   Node* a_shape, Node* b, bool adjoint_a,
@@ -82,19 +82,33 @@ class SplitOpBase : public OpKernel {
       return;
     }
 
-    // Special case 2: split along the 1st dimension. We can share the
-    // underlying buffer.
+    // Special case 2: split along the 1st dimension, or along a dimension
+    // preceded only by dimensions of size 1. We can share the underlying
+    // buffer.
     //
     // Apply this optimization conservatively: if input is aligned,
     // the resulting tensors must be aligned. It's conservative
     // because if the immediate consumer of the resulting tensors are
     // not using eigen for computation, its perfectly fine to avoid
     // the copying.
-    if ((split_dim == 0) && IsInnerDimsSizeAligned<T>(input_shape)) {
-      VLOG(1) << "Slice dim 0: " << input_shape.DebugString();
-      const int64_t delta = input_shape.dim_size(0) / num_split;
+    TensorShape sliced_shape;
+    if (LeadingDimsAreOne(input_shape, split_dim, &sliced_shape) &&
+        IsInnerDimsSizeAligned<T>(sliced_shape)) {
+      VLOG(1) << "Slice dim " << split_dim << ": "
+              << input_shape.DebugString();
+      Tensor sliced;
+      OP_REQUIRES(context, sliced.CopyFrom(input, sliced_shape),
+                  errors::Internal("Error during split reshape."));
+      const int64_t delta = sliced_shape.dim_size(0) / num_split;
+      TensorShape output_shape = input_shape;
+      output_shape.set_dim(split_dim, delta);
       for (int i = 0; i < num_split; ++i) {
-        context->set_output(i, input.Slice(i * delta, (i + 1) * delta));
+        Tensor output;
+        OP_REQUIRES(context,
+                    output.CopyFrom(sliced.Slice(i * delta, (i + 1) * delta),
+                                    output_shape),
+                    errors::Internal("Error during split reshape."));
+        context->set_output(i, output);
       }
       *done = true;
       return;
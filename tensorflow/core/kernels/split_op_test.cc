@@ -13,13 +13,20 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <cstdint>
 #include <initializer_list>
+
 #include "tensorflow/core/common_runtime/kernel_benchmark_testlib.h"
 #include "tensorflow/core/framework/bfloat16.h"
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def_builder.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_testutil.h"
 #include "tensorflow/core/framework/types.pb.h"
 #include "tensorflow/core/graph/node_builder.h"
+#include "tensorflow/core/kernels/ops_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/lib/gtl/array_slice.h"
 #include "tensorflow/core/lib/strings/stringprintf.h"
 #include "tensorflow/core/platform/test.h"
 #include "tensorflow/core/platform/test_benchmark.h"
@@ -96,4 +103,70 @@ BM_SPLIT_2D(1, 20, 100000, 5);
 BM_SPLIT_2D(1, 2, 3, 524288);
 BM_SPLIT_2D(1, 100, 4096, 512);
 
+namespace {
+
+// Returns the slice of `size` elements from `start` along dimension `dim` of
+// the 3-D `input`, as computed by the generic path with Eigen.
+Tensor Slice3D(const Tensor& input, int dim, int64_t start, int64_t size) {
+  Eigen::DSizes<Eigen::DenseIndex, 3> offsets(0, 0, 0);
+  Eigen::DSizes<Eigen::DenseIndex, 3> sizes(
+      input.dim_size(0), input.dim_size(1), input.dim_size(2));
+  offsets[dim] = start;
+  sizes[dim] = size;
+  TensorShape shape = input.shape();
+  shape.set_dim(dim, size);
+  Tensor slice(DT_FLOAT, shape);
+  slice.tensor<float, 3>() = input.tensor<float, 3>().slice(offsets, sizes);
+  return slice;
+}
+
+// Returns true if `output` is a view of the buffer of `input`.
+bool IsViewOf(const Tensor& output, const Tensor& input) {
+  const char* begin = input.tensor_data().data();
+  const char* end = begin + input.tensor_data().size();
+  const char* data = output.tensor_data().data();
+  return output.SharesBufferWith(input) && data >= begin && data < end;
+}
+
+class SplitOpTest : public OpsTestBase {
+ protected:
+  void RunSplit(const Tensor& input, int32_t split_dim, int num_split) {
+    TF_ASSERT_OK(NodeDefBuilder("split", "Split")
+                     .Input(FakeInput(DT_INT32))
+                     .Input(FakeInput(DT_FLOAT))
+                     .Attr("num_split", num_split)
+                     .Finalize(node_def()));
+    TF_ASSERT_OK(InitOp());
+    AddInputFromArray<int32_t>(TensorShape({}), {split_dim});
+    AddInputFromArray<float>(
+        input.shape(), gtl::ArraySlice<float>(input.flat<float>().data(),
+                                              input.NumElements()));
+    TF_ASSERT_OK(RunOpKernel());
+  }
+};
+
+TEST_F(SplitOpTest, AliasesAfterLeadingDimsOfSizeOne) {
+  // Rows of 16 floats are aligned for any EIGEN_MAX_ALIGN_BYTES up to 64.
+  Tensor input(DT_FLOAT, TensorShape({1, 6, 16}));
+  input.flat<float>().setRandom();
+  RunSplit(input, /*split_dim=*/1, /*num_split=*/3);
+  for (int i = 0; i < 3; ++i) {
+    test::ExpectTensorEqual<float>(Slice3D(input, 1, 2 * i, 2),
+                                   *GetOutput(i));
+    EXPECT_TRUE(IsViewOf(*GetOutput(i), *GetInput(1))) << i;
+  }
+}
+
+TEST_F(SplitOpTest, CopiesAfterLeadingDimsLargerThanOne) {
+  Tensor input(DT_FLOAT, TensorShape({2, 6, 16}));
+  input.flat<float>().setRandom();
+  RunSplit(input, /*split_dim=*/1, /*num_split=*/3);
+  for (int i = 0; i < 3; ++i) {
+    test::ExpectTensorEqual<float>(Slice3D(input, 1, 2 * i, 2),
+                                   *GetOutput(i));
+    EXPECT_FALSE(IsViewOf(*GetOutput(i), *GetInput(1))) << i;
+  }
+}
+
+}  // namespace
 }  // namespace tensorflow
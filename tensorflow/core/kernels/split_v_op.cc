@@ -151,7 +151,8 @@ class SplitVOpBase : public OpKernel {
                                           " must be >= 0. Got: ", split_size));
     }
 
-    // Special case 2: split along the 1st dimension. The requirements are that
+    // Special case 2: split along the 1st dimension, or along a dimension
+    // preceded only by dimensions of size 1. The requirements are that
     // either we are splitting the outer dimension of two or more such that
     // every outer subpart is aligned or that the split sizes mean that they are
     // always aligned. In these cases, we can share the underlying buffer.
@@ -161,13 +162,25 @@ class SplitVOpBase : public OpKernel {
     // because if the immediate consumer of the resulting tensors are
     // not using eigen for computation, its perfectly fine to avoid
     // the copying.
+    TensorShape sliced_shape;
     if (SplitHasAlignedOutputsInFirstDimension(
-            input_shape, split_dim, absl::MakeConstSpan(*split_sizes_vec))) {
+            input_shape, split_dim, absl::MakeConstSpan(*split_sizes_vec),
+            &sliced_shape)) {
+      Tensor sliced;
+      OP_REQUIRES(context, sliced.CopyFrom(input, sliced_shape),
+                  errors::Internal("Error during split reshape."));
+      TensorShape output_shape = input_shape;
       Tlen start = 0;
       for (int i = 0; i < num_split; ++i) {
-        context->set_output(i,
-                            input.Slice(start, start + (*split_sizes_vec)[i]));
-        start += (*split_sizes_vec)[i];
+        const Tlen split_size = (*split_sizes_vec)[i];
+        output_shape.set_dim(split_dim, split_size);
+        Tensor output;
+        OP_REQUIRES(context,
+                    output.CopyFrom(sliced.Slice(start, start + split_size),
+                                    output_shape),
+                    errors::Internal("Error during split reshape."));
+        context->set_output(i, output);
+        start += split_size;
       }
       *done = true;
       return;
@@ -198,17 +211,19 @@ class SplitVOpBase : public OpKernel {
 
  private:
   // Determines whether the given split configuration can be done using slicing
-  // on the first dimension of the tensor. The requirement is that each result
-  // tensor from the slice is correctly aligned within the input tensor.
+  // on the first dimension of the tensor, once the dimensions of size 1 before
+  // `split_dim` are dropped to give `sliced_shape`. The requirement is that
+  // each result tensor from the slice is correctly aligned within the input
+  // tensor.
   static bool SplitHasAlignedOutputsInFirstDimension(
       const TensorShape& input_shape, int32_t split_dim,
-      absl::Span<const Tlen> split_sizes) {
-    if (split_dim != 0) {
+      absl::Span<const Tlen> split_sizes, TensorShape* sliced_shape) {
+    if (!LeadingDimsAreOne(input_shape, split_dim, sliced_shape)) {
       return false;
     }
     Tlen start = 0;
     for (const Tlen split_size : split_sizes) {
-      if (!IsDim0SliceAligned<T>(input_shape, start, start + split_size)) {
+      if (!IsDim0SliceAligned<T>(*sliced_shape, start, start + split_size)) {
         return false;
       }
       start += split_size;
@@ -15,16 +15,22 @@ limitations under the License.
 
 #include <stdlib.h>
 
+#include <cstdint>
 #include <initializer_list>
 #include <iterator>
 #include <vector>
 
 #include "tensorflow/core/common_runtime/kernel_benchmark_testlib.h"
 #include "tensorflow/core/framework/bfloat16.h"
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def_builder.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_testutil.h"
 #include "tensorflow/core/framework/types.pb.h"
 #include "tensorflow/core/graph/node_builder.h"
+#include "tensorflow/core/kernels/ops_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/lib/gtl/array_slice.h"
 #include "tensorflow/core/lib/strings/stringprintf.h"
 #include "tensorflow/core/platform/test.h"
 #include "tensorflow/core/platform/test_benchmark.h"
@@ -173,4 +179,81 @@ BM_SPLITV_3D(2, 20, 1000, 52, 256);
 BM_SPLITV_3D(2, 2, 3, 524288, 10);
 BM_SPLITV_3D(2, 1, 4096, 512, 1);
 
+namespace {
+
+// Returns the slice of `size` elements from `start` along dimension `dim` of
+// the 3-D `input`, as computed by the generic path with Eigen.
+Tensor Slice3D(const Tensor& input, int dim, int64_t start, int64_t size) {
+  Eigen::DSizes<Eigen::DenseIndex, 3> offsets(0, 0, 0);
+  Eigen::DSizes<Eigen::DenseIndex, 3> sizes(
+      input.dim_size(0), input.dim_size(1), input.dim_size(2));
+  offsets[dim] = start;
+  sizes[dim] = size;
+  TensorShape shape = input.shape();
+  shape.set_dim(dim, size);
+  Tensor slice(DT_FLOAT, shape);
+  slice.tensor<float, 3>() = input.tensor<float, 3>().slice(offsets, sizes);
+  return slice;
+}
+
+// Returns true if `output` is a view of the buffer of `input`.
+bool IsViewOf(const Tensor& output, const Tensor& input) {
+  const char* begin = input.tensor_data().data();
+  const char* end = begin + input.tensor_data().size();
+  const char* data = output.tensor_data().data();
+  return output.SharesBufferWith(input) && data >= begin && data < end;
+}
+
+class SplitVOpTest : public OpsTestBase {
+ protected:
+  void RunSplitV(const Tensor& input, const std::vector<int64_t>& size_splits,
+                 int32_t split_dim) {
+    const int num_split = size_splits.size();
+    TF_ASSERT_OK(NodeDefBuilder("split_v", "SplitV")
+                     .Input(FakeInput(DT_FLOAT))
+                     .Input(FakeInput(DT_INT64))
+                     .Input(FakeInput(DT_INT32))
+                     .Attr("num_split", num_split)
+                     .Finalize(node_def()));
+    TF_ASSERT_OK(InitOp());
+    AddInputFromArray<float>(
+        input.shape(), gtl::ArraySlice<float>(input.flat<float>().data(),
+                                              input.NumElements()));
+    AddInputFromArray<int64_t>(TensorShape({num_split}), size_splits);
+    AddInputFromArray<int32_t>(TensorShape({}), {split_dim});
+    TF_ASSERT_OK(RunOpKernel());
+  }
+};
+
+TEST_F(SplitVOpTest, AliasesAfterLeadingDimsOfSizeOne) {
+  // Rows of 16 floats are aligned for any EIGEN_MAX_ALIGN_BYTES up to 64.
+  Tensor input(DT_FLOAT, TensorShape({1, 7, 16}));
+  input.flat<float>().setRandom();
+  RunSplitV(input, {1, 4, 2}, /*split_dim=*/1);
+  int64_t start = 0;
+  for (int i = 0; i < 3; ++i) {
+    const int64_t size = GetOutput(i)->dim_size(1);
+    test::ExpectTensorEqual<float>(Slice3D(input, 1, start, size),
+                                   *GetOutput(i));
+    EXPECT_TRUE(IsViewOf(*GetOutput(i), *GetInput(0))) << i;
+    start += size;
+  }
+  EXPECT_EQ(start, 7);
+}
+
+TEST_F(SplitVOpTest, CopiesAfterLeadingDimsLargerThanOne) {
+  Tensor input(DT_FLOAT, TensorShape({2, 7, 16}));
+  input.flat<float>().setRandom();
+  RunSplitV(input, {1, 4, 2}, /*split_dim=*/1);
+  int64_t start = 0;
+  for (int i = 0; i < 3; ++i) {
+    const int64_t size = GetOutput(i)->dim_size(1);
+    test::ExpectTensorEqual<float>(Slice3D(input, 1, start, size),
+                                   *GetOutput(i));
+    EXPECT_FALSE(IsViewOf(*GetOutput(i), *GetInput(0))) << i;
+    start += size;
+  }
+}
+
+}  // namespace
 }  // namespace tensorflow
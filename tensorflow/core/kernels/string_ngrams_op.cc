@@ -17,18 +17,32 @@ limitations under the License.
 #include <locale>
 #include <string>
 
+#include <type_traits>
+
 #include "absl/strings/ascii.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/op_requires.h"
 #include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/fingerprint.h"
 #include "tensorflow/core/platform/types.h"
 
 namespace tensorflow {
 namespace text {
 
 namespace {
-template <typename SPLITS_TYPE>
+
+// Appends `s` to `out` without converting it to the type of `out` first.
+template <typename STRING_TYPE>
+void Append(absl::string_view s, STRING_TYPE* out) {
+  out->append(s.data(), s.size());
+}
+
+// Computes the ngrams of StringNGrams as strings or, with an OUTPUT_TYPE of
+// int64 for _StringNGramsHashBucketFast, hashes each ngram into a bucket like
+// StringToHashBucketFast instead.
+template <typename SPLITS_TYPE, typename OUTPUT_TYPE = tstring>
 class StringNGramsOp : public tensorflow::OpKernel {
  public:
   explicit StringNGramsOp(tensorflow::OpKernelConstruction* context)
@@ -40,6 +54,9 @@ class StringNGramsOp : public tensorflow::OpKernel {
     OP_REQUIRES_OK(context, context->GetAttr("pad_width", &pad_width_));
     OP_REQUIRES_OK(context, context->GetAttr("preserve_short_sequences",
                                              &preserve_short_));
+    if (std::is_same<OUTPUT_TYPE, int64_t>::value) {
+      OP_REQUIRES_OK(context, context->GetAttr("num_buckets", &num_buckets_));
+    }
   }
 
   int get_pad_width(const int ngram_width) const {
@@ -138,7 +155,7 @@ class StringNGramsOp : public tensorflow::OpKernel {
         context,
         context->allocate_output(
             0, TensorShape({ngrams_splits_data[num_batch_items]}), &ngrams));
-    auto ngrams_data = ngrams->flat<tstring>().data();
+    auto ngrams_data = ngrams->flat<OUTPUT_TYPE>().data();
 
     for (int i = 0; i < num_batch_items; ++i) {
       auto data_start = &input_data[splits_vec(i)];
@@ -188,67 +205,90 @@ class StringNGramsOp : public tensorflow::OpKernel {
   void CreateNgrams(const tstring* data, tstring* output, int num_ngrams,
                     int ngram_width) const {
     for (int ngram_index = 0; ngram_index < num_ngrams; ++ngram_index) {
-      int pad_width = get_pad_width(ngram_width);
-      int left_padding = std::max(0, pad_width - ngram_index);
-      int right_padding =
-          std::max(0, pad_width - (num_ngrams - (ngram_index + 1)));
-      int num_tokens = ngram_width - (left_padding + right_padding);
-      int data_start_index = left_padding > 0 ? 0 : ngram_index - pad_width;
-
-      // Calculate the total expected size of the ngram so we can reserve the
-      // correct amount of space in the string.
-      int ngram_size = 0;
-      // Size of the left padding.
-      ngram_size += left_padding * left_pad_.length();
-      // Size of the tokens.
-      for (int n = 0; n < num_tokens; ++n) {
-        ngram_size += data[data_start_index + n].length();
-      }
-      // Size of the right padding.
-      ngram_size += right_padding * right_pad_.length();
-      // Size of the separators.
-      int num_separators = left_padding + right_padding + num_tokens - 1;
-      ngram_size += num_separators * separator_.length();
-
-      // Build the ngram.
-      tstring* ngram = &output[ngram_index];
-      ngram->reserve(ngram_size);
-      for (int n = 0; n < left_padding; ++n) {
-        ngram->append(left_pad_);
-        ngram->append(separator_);
-      }
-      // Only output first num_tokens - 1 pairs of data and separator
-      for (int n = 0; n < num_tokens - 1; ++n) {
-        ngram->append(data[data_start_index + n]);
-        ngram->append(separator_);
+      BuildNgram(data, num_ngrams, ngram_width, ngram_index,
+                 &output[ngram_index]);
+    }
+  }
+
+  // Builds each ngram in the same buffer, so that hashing the ngrams doesn't
+  // allocate a string per ngram.
+  void CreateNgrams(const tstring* data, int64_t* output, int num_ngrams,
+                    int ngram_width) const {
+    std::string ngram;
+    for (int ngram_index = 0; ngram_index < num_ngrams; ++ngram_index) {
+      ngram.clear();
+      BuildNgram(data, num_ngrams, ngram_width, ngram_index, &ngram);
+      // The number of buckets is always in the positive range of int64 so is
+      // the resulting bucket id.
+      output[ngram_index] =
+          static_cast<int64_t>(Fingerprint64(ngram) % num_buckets_);
+    }
+  }
+
+  // Appends the `ngram_index`-th ngram of width `ngram_width` to the empty
+  // string `ngram`.
+  template <typename STRING_TYPE>
+  void BuildNgram(const tstring* data, int num_ngrams, int ngram_width,
+                  int ngram_index, STRING_TYPE* ngram) const {
+    int pad_width = get_pad_width(ngram_width);
+    int left_padding = std::max(0, pad_width - ngram_index);
+    int right_padding =
+        std::max(0, pad_width - (num_ngrams - (ngram_index + 1)));
+    int num_tokens = ngram_width - (left_padding + right_padding);
+    int data_start_index = left_padding > 0 ? 0 : ngram_index - pad_width;
+
+    // Calculate the total expected size of the ngram so we can reserve the
+    // correct amount of space in the string.
+    int ngram_size = 0;
+    // Size of the left padding.
+    ngram_size += left_padding * left_pad_.length();
+    // Size of the tokens.
+    for (int n = 0; n < num_tokens; ++n) {
+      ngram_size += data[data_start_index + n].length();
+    }
+    // Size of the right padding.
+    ngram_size += right_padding * right_pad_.length();
+    // Size of the separators.
+    int num_separators = left_padding + right_padding + num_tokens - 1;
+    ngram_size += num_separators * separator_.length();
+
+    // Build the ngram.
+    ngram->reserve(ngram_size);
+    for (int n = 0; n < left_padding; ++n) {
+      Append(left_pad_, ngram);
+      Append(separator_, ngram);
+    }
+    // Only output first num_tokens - 1 pairs of data and separator
+    for (int n = 0; n < num_tokens - 1; ++n) {
+      Append(data[data_start_index + n], ngram);
+      Append(separator_, ngram);
+    }
+    // Handle case when there are no tokens or no right padding as these can
+    // result in consecutive separators.
+    if (num_tokens > 0) {
+      // If we have tokens, then output last and then pair each separator with
+      // the right padding that follows, to ensure ngram ends either with the
+      // token or with the right pad.
+      Append(data[data_start_index + num_tokens - 1], ngram);
+      for (int n = 0; n < right_padding; ++n) {
+        Append(separator_, ngram);
+        Append(right_pad_, ngram);
       }
-      // Handle case when there are no tokens or no right padding as these can
-      // result in consecutive separators.
-      if (num_tokens > 0) {
-        // If we have tokens, then output last and then pair each separator with
-        // the right padding that follows, to ensure ngram ends either with the
-        // token or with the right pad.
-        ngram->append(data[data_start_index + num_tokens - 1]);
-        for (int n = 0; n < right_padding; ++n) {
-          ngram->append(separator_);
-          ngram->append(right_pad_);
-        }
-      } else {
-        // If we don't have tokens, then the last item inserted into the ngram
-        // has been the separator from the left padding loop above. Hence,
-        // output right pad and separator and make sure to finish with a
-        // padding, not a separator.
-        for (int n = 0; n < right_padding - 1; ++n) {
-          ngram->append(right_pad_);
-          ngram->append(separator_);
-        }
-        ngram->append(right_pad_);
+    } else {
+      // If we don't have tokens, then the last item inserted into the ngram
+      // has been the separator from the left padding loop above. Hence,
+      // output right pad and separator and make sure to finish with a
+      // padding, not a separator.
+      for (int n = 0; n < right_padding - 1; ++n) {
+        Append(right_pad_, ngram);
+        Append(separator_, ngram);
       }
-
-      // In debug mode only: validate that we've reserved enough space for the
-      // ngram.
-      DCHECK_EQ(ngram_size, ngram->size());
+      Append(right_pad_, ngram);
     }
+
+    // In debug mode only: validate that we've reserved enough space for the
+    // ngram.
+    DCHECK_EQ(ngram_size, ngram->size());
   }
 
   string separator_;
@@ -260,6 +300,7 @@ class StringNGramsOp : public tensorflow::OpKernel {
 
   std::vector<int> ngram_widths_;
   int pad_width_;
+  int64_t num_buckets_ = 0;
 };
 
 }  // namespace
@@ -271,6 +312,14 @@ REGISTER_KERNEL_BUILDER(Name("StringNGrams")
                             .Device(tensorflow::DEVICE_CPU)
                             .TypeConstraint<int64_t>("Tsplits"),
                         StringNGramsOp<int64_t>);
+REGISTER_KERNEL_BUILDER(Name("_StringNGramsHashBucketFast")
+                            .Device(tensorflow::DEVICE_CPU)
+                            .TypeConstraint<int32>("Tsplits"),
+                        StringNGramsOp<int32, int64_t>);
+REGISTER_KERNEL_BUILDER(Name("_StringNGramsHashBucketFast")
+                            .Device(tensorflow::DEVICE_CPU)
+                            .TypeConstraint<int64_t>("Tsplits"),
+                        StringNGramsOp<int64_t, int64_t>);
 
 }  // namespace text
 }  // namespace tensorflow
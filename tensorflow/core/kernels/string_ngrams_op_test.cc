@@ -25,6 +25,7 @@ limitations under the License.
 #include "tensorflow/core/kernels/ops_testutil.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/fingerprint.h"
 
 namespace tensorflow {
 namespace text {
@@ -578,6 +579,39 @@ TEST_F(NgramKernelTest, TestNoTokensNoPad) {
   assert_int64_equal(expected_splits, *GetOutput(1));
 }
 
+TEST_F(NgramKernelTest, TestHashBucketFast) {
+  const int64_t num_buckets = 1000;
+  TF_ASSERT_OK(NodeDefBuilder("tested_op", "_StringNGramsHashBucketFast")
+                   .Attr("separator", "|")
+                   .Attr("ngram_widths", std::vector<int>({2, 3}))
+                   .Attr("left_pad", "LP")
+                   .Attr("right_pad", "RP")
+                   .Attr("pad_width", 1)
+                   .Attr("preserve_short_sequences", false)
+                   .Attr("num_buckets", num_buckets)
+                   .Input(FakeInput())
+                   .Input(FakeInput())
+                   .Finalize(node_def()));
+  TF_ASSERT_OK(InitOp());
+  // Batch items are:
+  // 0: "a", "b", "c", "d"
+  // 1: "e", "f"
+  AddInputFromArray<tstring>(TensorShape({6}), {"a", "b", "c", "d", "e", "f"});
+  AddInputFromArray<int64_t>(TensorShape({3}), {0, 4, 6});
+  TF_ASSERT_OK(RunOpKernel());
+
+  std::vector<int64_t> expected_values;
+  for (const char* ngram :
+       {"LP|a", "a|b", "b|c", "c|d", "d|RP", "LP|a|b", "a|b|c", "b|c|d",
+        "c|d|RP", "LP|e", "e|f", "f|RP", "LP|e|f", "e|f|RP"}) {
+    expected_values.push_back(Fingerprint64(ngram) % num_buckets);
+  }
+  std::vector<int64_t> expected_splits({0, 9, 14});
+
+  assert_int64_equal(expected_values, *GetOutput(0));
+  assert_int64_equal(expected_splits, *GetOutput(1));
+}
+
 TEST_F(NgramKernelTest, ShapeFn) {
   ShapeInferenceTestOp op("StringNGrams");
   INFER_OK(op, "?;?", "[?];[?]");
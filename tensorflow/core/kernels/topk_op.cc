@@ -129,6 +129,81 @@ class TopK : public OpKernel {
 
 namespace functor {
 
+// Rows with at least this many columns are split into shards processed in
+// parallel when there are too few rows to keep the worker threads busy.
+constexpr int64_t kParallelTopKMinCols = 64 * 1024;
+// Minimum number of columns of a shard, and of columns per top value kept.
+constexpr int64_t kParallelTopKMinShardCols = 8 * 1024;
+constexpr int64_t kParallelTopKMinColsPerK = 8;
+
+// Computes the top `k` of the row `input_data` of `num_cols` values into
+// `values` and `indices` by splitting the row into shards. Each shard keeps a
+// buffer of up to 2 * k candidates, compacted to its k best whenever it fills
+// up. The k-th best value becomes the threshold below which values are skipped
+// without touching the buffer, which is the common case for long rows. The
+// candidates of all shards are then merged, with the same order as the
+// single-threaded path: larger values first, then smaller indices.
+template <typename T, typename Tidx>
+void ParallelTopKRow(const DeviceBase::CpuWorkerThreads& worker_threads,
+                     bool sorted, int k, const T* input_data,
+                     const int64_t num_cols, const int64_t num_shards,
+                     T* values, Tidx* indices) {
+  const auto stable_comp = [input_data](const Tidx a, const Tidx b) {
+    if (input_data[b] < input_data[a]) {
+      return true;
+    } else if (input_data[b] > input_data[a]) {
+      return false;
+    } else {
+      return a < b;
+    }
+  };
+  std::vector<std::vector<Tidx>> candidates(num_shards);
+  const int64_t shard_cols = (num_cols + num_shards - 1) / num_shards;
+  auto shard_fn = [&](int64_t start_shard, int64_t limit_shard) {
+    for (int64_t s = start_shard; s < limit_shard; ++s) {
+      std::vector<Tidx>& kept = candidates[s];
+      kept.reserve(2 * k);
+      const int64_t begin = s * shard_cols;
+      const int64_t end = std::min(num_cols, begin + shard_cols);
+      bool has_threshold = false;
+      T threshold = T();
+      for (int64_t c = begin; c < end; ++c) {
+        // Columns are visited in increasing order, so a value equal to the
+        // threshold loses the tie against the kept value.
+        if (has_threshold && !(threshold < input_data[c])) continue;
+        kept.push_back(static_cast<Tidx>(c));
+        if (kept.size() == static_cast<size_t>(2 * k)) {
+          std::nth_element(kept.begin(), kept.begin() + (k - 1), kept.end(),
+                           stable_comp);
+          kept.resize(k);
+          threshold = input_data[kept[k - 1]];
+          has_threshold = true;
+        }
+      }
+    }
+  };
+  const int64_t shard_cost = shard_cols * (Eigen::TensorOpCost::AddCost<T>() +
+                                           Eigen::TensorOpCost::AddCost<Tidx>());
+  Shard(worker_threads.num_threads, worker_threads.workers, num_shards,
+        shard_cost, shard_fn);
+
+  std::vector<Tidx> merged;
+  merged.reserve(num_shards * 2 * k);
+  for (const std::vector<Tidx>& kept : candidates) {
+    merged.insert(merged.end(), kept.begin(), kept.end());
+  }
+  if (sorted) {
+    std::partial_sort(merged.begin(), merged.begin() + k, merged.end(),
+                      stable_comp);
+  } else {
+    std::nth_element(merged.begin(), merged.begin() + (k - 1), merged.end(),
+                     stable_comp);
+  }
+  std::copy_n(merged.begin(), k, indices);
+  std::transform(indices, indices + k, values,
+                 [input_data](const Tidx loc) { return input_data[loc]; });
+}
+
 template <typename T, typename Tidx>
 struct TopKFunctor<CPUDevice, T, Tidx> {
   static EIGEN_ALWAYS_INLINE absl::Status Compute(
@@ -161,6 +236,25 @@ struct TopKFunctor<CPUDevice, T, Tidx> {
       return absl::OkStatus();
     }
 
+    auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
+    // With fewer rows than threads, split the long rows instead, e.g. the
+    // scores of millions of candidates of a retrieval model.
+    if (k < num_cols && num_rows < worker_threads.num_threads &&
+        num_cols >= kParallelTopKMinCols) {
+      const int64_t num_shards = std::min<int64_t>(
+          worker_threads.num_threads,
+          num_cols / std::max<int64_t>(kParallelTopKMinShardCols,
+                                       kParallelTopKMinColsPerK * k));
+      if (num_shards > 1) {
+        for (int64_t b = 0; b < num_rows; ++b) {
+          ParallelTopKRow<T, Tidx>(worker_threads, sorted, k, &input(b, 0),
+                                   num_cols, num_shards, &values(b, 0),
+                                   &indices(b, 0));
+        }
+        return absl::OkStatus();
+      }
+    }
+
     auto SortIndices = [&](int64_t start_batch, int64_t limit_batch) {
       for (int32_t b = start_batch; b < limit_batch; ++b) {
         const T* input_data = &input(b, 0);
@@ -247,7 +341,6 @@ struct TopKFunctor<CPUDevice, T, Tidx> {
     const int64_t final_cost = (total_cost >= static_cast<double>(kint64max))
                                    ? kint64max
                                    : static_cast<int64_t>(total_cost);
-    auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
     Shard(worker_threads.num_threads, worker_threads.workers, num_rows,
           final_cost, SortIndices);
 
@@ -0,0 +1,154 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "tensorflow/core/framework/device_base.h"
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/kernels/ops_testutil.h"
+#include "tensorflow/core/lib/gtl/array_slice.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/platform/threadpool.h"
+
+namespace tensorflow {
+namespace {
+
+// Runs TopKV2 on the single-row and two-row inputs that take the parallel
+// path with 4 worker threads, and checks the result against the serial path
+// run with a single worker thread.
+class TopKOpTest : public OpsTestBase {
+ protected:
+  TopKOpTest()
+      : workers_(Env::Default(), "topk_test", /*num_threads=*/4),
+        saved_worker_threads_(device_->tensorflow_cpu_worker_threads()) {}
+
+  ~TopKOpTest() override {
+    device_->set_tensorflow_cpu_worker_threads(
+        const_cast<DeviceBase::CpuWorkerThreads*>(saved_worker_threads_));
+  }
+
+  // Returns the values and indices of the top `k` of `input` computed with
+  // `num_threads` worker threads.
+  template <typename T>
+  std::vector<Tensor> RunTopK(int num_threads, const Tensor& input, int k,
+                              bool sorted) {
+    worker_threads_.num_threads = num_threads;
+    worker_threads_.workers = &workers_;
+    device_->set_tensorflow_cpu_worker_threads(&worker_threads_);
+
+    inputs_.clear();
+    TF_CHECK_OK(NodeDefBuilder("topk", "TopKV2")
+                    .Input(FakeInput(DataTypeToEnum<T>::v()))
+                    .Input(FakeInput(DT_INT32))
+                    .Attr("sorted", sorted)
+                    .Finalize(node_def()));
+    TF_CHECK_OK(InitOp());
+    AddInputFromArray<T>(input.shape(),
+                         gtl::ArraySlice<T>(input.flat<T>().data(),
+                                            input.NumElements()));
+    AddInputFromArray<int32_t>(TensorShape({}), {k});
+    TF_CHECK_OK(RunOpKernel());
+    return {*GetOutput(0), *GetOutput(1)};
+  }
+
+  template <typename T>
+  void CheckParallelMatchesSerial(const Tensor& input, int k, bool sorted) {
+    const std::vector<Tensor> parallel = RunTopK<T>(4, input, k, sorted);
+    const std::vector<Tensor> serial = RunTopK<T>(1, input, k, sorted);
+    if (sorted) {
+      test::ExpectTensorEqual<T>(serial[0], parallel[0]);
+      test::ExpectTensorEqual<int32_t>(serial[1], parallel[1]);
+      return;
+    }
+    // The order of the unsorted results is unspecified, but both paths keep
+    // the same values, breaking ties towards the smaller indices.
+    const int64_t num_rows = input.dim_size(0);
+    for (int64_t r = 0; r < num_rows; ++r) {
+      std::vector<int32_t> serial_indices(k), parallel_indices(k);
+      for (int i = 0; i < k; ++i) {
+        serial_indices[i] = serial[1].matrix<int32_t>()(r, i);
+        parallel_indices[i] = parallel[1].matrix<int32_t>()(r, i);
+      }
+      std::sort(serial_indices.begin(), serial_indices.end());
+      std::sort(parallel_indices.begin(), parallel_indices.end());
+      EXPECT_EQ(serial_indices, parallel_indices) << "row " << r;
+    }
+  }
+
+ private:
+  thread::ThreadPool workers_;
+  DeviceBase::CpuWorkerThreads worker_threads_;
+  const DeviceBase::CpuWorkerThreads* const saved_worker_threads_;
+};
+
+constexpr int64_t kNumCols = 200000;
+
+Tensor DistinctInput(int64_t num_rows) {
+  Tensor input(DT_FLOAT, TensorShape({num_rows, kNumCols}));
+  auto flat = input.flat<float>();
+  // A permutation of 0 ... num_rows * kNumCols - 1, so that the top values
+  // are spread over all the shards.
+  for (int64_t i = 0; i < flat.size(); ++i) {
+    flat(i) = static_cast<float>((i * 7919) % flat.size());
+  }
+  return input;
+}
+
+Tensor InputWithTies(int64_t num_rows) {
+  Tensor input(DT_INT32, TensorShape({num_rows, kNumCols}));
+  auto flat = input.flat<int32_t>();
+  for (int64_t i = 0; i < flat.size(); ++i) {
+    flat(i) = static_cast<int32_t>((i * 7919) % 1000);
+  }
+  return input;
+}
+
+TEST_F(TopKOpTest, ParallelRowSorted) {
+  CheckParallelMatchesSerial<float>(DistinctInput(1), /*k=*/100,
+                                    /*sorted=*/true);
+}
+
+TEST_F(TopKOpTest, ParallelRowUnsorted) {
+  CheckParallelMatchesSerial<float>(DistinctInput(1), /*k=*/100,
+                                    /*sorted=*/false);
+}
+
+TEST_F(TopKOpTest, ParallelRowsSorted) {
+  CheckParallelMatchesSerial<float>(DistinctInput(2), /*k=*/1000,
+                                    /*sorted=*/true);
+}
+
+TEST_F(TopKOpTest, ParallelRowWithTiesSorted) {
+  // Each value appears 200 times, so the top 500 spill over many ties that
+  // must keep the smallest indices.
+  CheckParallelMatchesSerial<int32_t>(InputWithTies(2), /*k=*/500,
+                                      /*sorted=*/true);
+}
+
+TEST_F(TopKOpTest, ParallelRowWithTiesUnsorted) {
+  CheckParallelMatchesSerial<int32_t>(InputWithTies(1), /*k=*/500,
+                                      /*sorted=*/false);
+}
+
+}  // namespace
+}  // namespace tensorflow
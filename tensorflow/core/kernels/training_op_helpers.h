@@ -38,6 +38,14 @@ limitations under the License.
 
 namespace tensorflow {
 
+// Returns true if `var` is updated lock-free and in place on `Device`, see
+// Var::hogwild_mode.
+template <typename Device>
+bool IsHogwildVariable(Var* var) {
+  return std::is_same<Device, Eigen::ThreadPoolDevice>::value &&
+         var->hogwild_mode.load();
+}
+
 // Must be called before performing a sparse operation on a variable. Ensures
 // that no concurrent dense operations can happen while holding the variable's
 // lock.
@@ -166,7 +174,9 @@ tsl::mutex* GetTrainingVariableMutex(OpKernelContext* ctx, int input,
 // resource variables in copy-on-read-mode, it will grab a shared lock if
 // do_lock is false, exclusive lock otherwise.  Note that this silently doesn't
 // lock mutexes for invalid variable references; in all usages this is followed
-// by GetInputTensor which will signal a failure.
+// by GetInputTensor which will signal a failure. If do_lock is false, resource
+// variables in Hogwild mode are neither locked nor switched to copy-on-read
+// mode.
 template <typename Device, typename T>
 VariableInputLockHolder MaybeLockVariableInputMutexesInOrder(
     OpKernelContext* ctx, bool do_lock, bool sparse,
@@ -187,7 +197,10 @@ VariableInputLockHolder MaybeLockVariableInputMutexesInOrder(
   for (auto input : input_ids) {
     Var* var;
     tsl::mutex* mutex = GetTrainingVariableMutex<Device, T>(ctx, input, &var);
-    if (var) vars.push_back(var);
+    if (var) {
+      vars.push_back(var);
+      if (!do_lock && IsHogwildVariable<Device>(var)) continue;
+    }
     // Only lock each mutex once if duplicates exist (n^2 but n is 2 or 3).
     if (std::find(mutexes.begin(), mutexes.end(), mutex) == mutexes.end()) {
       acquire_order.push_back(mutexes.size());
@@ -197,6 +210,7 @@ VariableInputLockHolder MaybeLockVariableInputMutexesInOrder(
 
   if (sparse) {
     for (Var* var : vars) {
+      if (!do_lock && IsHogwildVariable<Device>(var)) continue;
       EnsureSparseVariableAccess<Device, T>(ctx, var).IgnoreError();
     }
   }
@@ -273,7 +287,11 @@ absl::Status PrepareToUpdateVariable(OpKernelContext* ctx, Tensor* tensor,
 // * If sparse is true: return the underlying tensor.
 // * If sparse is false: ensure its refcount is 1 (by potentially copying its
 //   contents), and then return the underlying tensor.
-// `lock_held` is ignored for resource variables.
+// * If lock_held is false and the variable is in Hogwild mode: return the
+//   underlying tensor, which the caller did not lock. Only the copy of the
+//   tensor handle is done under a shared lock, so that a concurrent assignment
+//   can't replace the tensor while it is read.
+// Otherwise `lock_held` is ignored for resource variables.
 template <typename Device, typename T>
 absl::Status GetInputTensorFromVariable(OpKernelContext* ctx, int input,
                                         bool lock_held, bool sparse,
@@ -281,6 +299,11 @@ absl::Status GetInputTensorFromVariable(OpKernelContext* ctx, int input,
   if (ctx->input_dtype(input) == DT_RESOURCE) {
     core::RefCountPtr<Var> var;
     TF_RETURN_IF_ERROR(LookupResource(ctx, HandleFromInput(ctx, input), &var));
+    if (!lock_held && IsHogwildVariable<Device>(var.get())) {
+      tf_shared_lock ml(*var->mu());
+      *out = *var->tensor();
+      return absl::OkStatus();
+    }
     if (sparse) {
       var->mu()->assert_held_shared();
       *out = *var->tensor();
@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <algorithm>  // NOLINT
 
+#include "absl/container/flat_hash_set.h"
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/register_types.h"
@@ -2142,6 +2143,191 @@ REGISTER_KERNELS(GPU, double, int64_t);
 #endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
 #undef REGISTER_KERNELS
 
+// Applies a sparse AdagradV2 update to each of N variables, with the locks of
+// all the variables held for the whole update. The rows of all the variables
+// are updated in parallel, except that the rows of a variable with duplicate
+// indices are updated in order by a single thread.
+template <typename T, typename Tindex>
+class GroupedSparseApplyAdagradV2Op : public OpKernel {
+ public:
+  explicit GroupedSparseApplyAdagradV2Op(OpKernelConstruction* ctx)
+      : OpKernel(ctx) {
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("N", &num_vars_));
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("use_locking", &use_exclusive_lock_));
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("update_slots", &update_slots_));
+  }
+
+  void Compute(OpKernelContext* ctx) override TF_NO_THREAD_SAFETY_ANALYSIS {
+    const bool sparse = true;
+    const int n = num_vars_;
+    std::vector<int> var_inputs(2 * n);
+    for (int i = 0; i < 2 * n; ++i) var_inputs[i] = i;
+    // Locks are taken in address order, so grouped and single updates of the
+    // same variables can't deadlock.
+    auto locks = MaybeLockVariableInputMutexesInOrder<CPUDevice, T>(
+        ctx, use_exclusive_lock_, sparse, var_inputs);
+
+    const Tensor& lr = ctx->input(2 * n);
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(lr.shape()),
+                errors::InvalidArgument("lr is not a scalar: ",
+                                        lr.shape().DebugString()));
+    const Tensor& epsilon = ctx->input(2 * n + 1);
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(epsilon.shape()),
+                errors::InvalidArgument("epsilon is not a scalar: ",
+                                        epsilon.shape().DebugString()));
+
+    std::vector<Tensor> vars(n);
+    std::vector<Tensor> accums(n);
+    std::vector<typename TTypes<T>::Matrix> var_mats;
+    std::vector<typename TTypes<T>::Matrix> accum_mats;
+    std::vector<typename TTypes<T>::ConstMatrix> grad_mats;
+    std::vector<typename TTypes<Tindex>::ConstVec> indices_vecs;
+    var_mats.reserve(n);
+    accum_mats.reserve(n);
+    grad_mats.reserve(n);
+    indices_vecs.reserve(n);
+    // `row_begin[i]` is the index of the first row of variable `i` among the
+    // rows of all the variables.
+    std::vector<int64_t> row_begin(n + 1, 0);
+    // The rows are split into units that are each updated by a single thread:
+    // unit `u` is made of the rows in [unit_begin[u], unit_begin[u + 1]).
+    // Each row of a variable is its own unit, unless the variable has
+    // duplicate indices, in which case all its rows make a single unit.
+    std::vector<int64_t> unit_begin;
+    int64_t max_inner_dim = 1;
+    for (int i = 0; i < n; ++i) {
+      OP_REQUIRES_OK(ctx, GetInputTensorFromVariable<CPUDevice, T>(
+                              ctx, i, use_exclusive_lock_, sparse, &vars[i]));
+      OP_REQUIRES_OK(ctx,
+                     GetInputTensorFromVariable<CPUDevice, T>(
+                         ctx, n + i, use_exclusive_lock_, sparse, &accums[i]));
+      const Tensor& var = vars[i];
+      const Tensor& accum = accums[i];
+      OP_REQUIRES(ctx, var.IsInitialized(),
+                  errors::FailedPrecondition(
+                      "Attempting to use uninitialized variables: ",
+                      requested_input(i)));
+      OP_REQUIRES(ctx, accum.IsInitialized(),
+                  errors::FailedPrecondition(
+                      "Attempting to use uninitialized variables: ",
+                      requested_input(n + i)));
+      OP_REQUIRES(
+          ctx, var.shape().IsSameSize(accum.shape()),
+          errors::InvalidArgument("var and accum do not have the same shape",
+                                  var.shape().DebugString(), " ",
+                                  accum.shape().DebugString()));
+      OP_REQUIRES(
+          ctx, TensorShapeUtils::IsVectorOrHigher(var.shape()),
+          errors::InvalidArgument("var must be at least 1 dimensional"));
+
+      const Tensor& grad = ctx->input(2 * n + 2 + i);
+      const Tensor& indices = ctx->input(3 * n + 2 + i);
+      OP_REQUIRES(ctx, TensorShapeUtils::IsVector(indices.shape()),
+                  errors::InvalidArgument("indices must be one-dimensional"));
+      OP_REQUIRES(ctx, grad.dims() == var.dims(),
+                  errors::InvalidArgument("var and grad must have the same "
+                                          "rank for variable ",
+                                          i));
+      int64_t inner_dim = 1;
+      for (int d = 1; d < var.dims(); d++) {
+        OP_REQUIRES(ctx, var.dim_size(d) == grad.dim_size(d),
+                    errors::InvalidArgument(strings::StrCat(
+                        "var and grad must match in dimension ", d)));
+        inner_dim *= grad.dim_size(d);
+      }
+      OP_REQUIRES(ctx, inner_dim > 0,
+                  errors::InvalidArgument(
+                      "Inner dimension should be greater than zero."));
+      const Tindex num_indices = indices.dim_size(0);
+      OP_REQUIRES(ctx, grad.dim_size(0) == num_indices,
+                  errors::InvalidArgument("grad must be the same size as "
+                                          "indices in the first dimension."));
+      const auto indices_vec = indices.vec<Tindex>();
+      const Tindex first_dim_size = static_cast<Tindex>(var.dim_size(0));
+      absl::flat_hash_set<Tindex> seen;
+      seen.reserve(num_indices);
+      bool has_duplicates = false;
+      for (Tindex j = 0; j < num_indices; ++j) {
+        const Tindex index = internal::SubtleMustCopy(indices_vec(j));
+        OP_REQUIRES(ctx, FastBoundsCheck(index, first_dim_size),
+                    errors::InvalidArgument(
+                        strings::StrCat("Index ", index, " at offset ", j,
+                                        " in indices of variable ", i,
+                                        " is out of range")));
+        has_duplicates |= !seen.insert(index).second;
+      }
+      row_begin[i + 1] = row_begin[i] + num_indices;
+      if (has_duplicates) {
+        unit_begin.push_back(row_begin[i]);
+      } else {
+        for (int64_t row = row_begin[i]; row < row_begin[i + 1]; ++row) {
+          unit_begin.push_back(row);
+        }
+      }
+      max_inner_dim = std::max(max_inner_dim, inner_dim);
+      var_mats.push_back(vars[i].flat_outer_dims<T>());
+      accum_mats.push_back(accums[i].flat_outer_dims<T>());
+      grad_mats.push_back(grad.flat_outer_dims<T>());
+      indices_vecs.push_back(indices_vec);
+    }
+
+    const T lr_scalar = lr.scalar<T>()();
+    const T epsilon_scalar = epsilon.scalar<T>()();
+    const bool update_slots = update_slots_;
+    const int64_t num_units = unit_begin.size();
+    unit_begin.push_back(row_begin[n]);
+    auto shard = [&](int64_t begin_unit, int64_t end_unit) {
+      const int64_t begin = unit_begin[begin_unit];
+      const int64_t end = unit_begin[end_unit];
+      int i = std::upper_bound(row_begin.begin(), row_begin.end(), begin) -
+              row_begin.begin() - 1;
+      for (int64_t row = begin; row < end; ++row) {
+        while (row >= row_begin[i + 1]) ++i;
+        const int64_t j = row - row_begin[i];
+        const Tindex index = internal::SubtleMustCopy(indices_vecs[i](j));
+        auto a = accum_mats[i].template chip<0>(index);
+        auto g = grad_mats[i].template chip<0>(j);
+        auto v = var_mats[i].template chip<0>(index);
+        if (update_slots) {
+          a += g.square();
+        }
+        v -= g.constant(lr_scalar) * g /
+             (a.sqrt() + a.constant(epsilon_scalar));
+      }
+    };
+    if (num_units == 0) return;
+    // The rows of the widest variable bound the cost of a row.
+    const double rows_per_unit = static_cast<double>(row_begin[n]) / num_units;
+    const Eigen::TensorOpCost cost(
+        max_inner_dim * sizeof(T) * 3 * rows_per_unit,
+        max_inner_dim * sizeof(T) * 2 * rows_per_unit,
+        max_inner_dim * rows_per_unit *
+            (Eigen::TensorOpCost::AddCost<T>() * 2 +
+             Eigen::TensorOpCost::MulCost<T>() * 2));
+    ctx->eigen_device<CPUDevice>().parallelFor(num_units, cost, shard);
+  }
+
+ private:
+  int num_vars_;
+  bool use_exclusive_lock_;
+  bool update_slots_;
+};
+
+#define REGISTER_KERNELS(T, Tindices)                                  \
+  REGISTER_KERNEL_BUILDER(Name("_GroupedResourceSparseApplyAdagradV2") \
+                              .Device(DEVICE_CPU)                      \
+                              .TypeConstraint<T>("T")                  \
+                              .TypeConstraint<Tindices>("Tindices"),   \
+                          GroupedSparseApplyAdagradV2Op<T, Tindices>);
+#define REGISTER_CPU_KERNELS(T) \
+  REGISTER_KERNELS(T, int32);   \
+  REGISTER_KERNELS(T, int64_t);
+
+TF_CALL_FLOAT_TYPES(REGISTER_CPU_KERNELS);
+
+#undef REGISTER_CPU_KERNELS
+#undef REGISTER_KERNELS
+
 template <typename Device, typename T, typename Tindex>
 class SparseApplyProximalAdagradOp : public OpKernel {
  public:
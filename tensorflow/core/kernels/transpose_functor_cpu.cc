@@ -15,7 +15,9 @@ limitations under the License.
 
 #define EIGEN_USE_THREADS
 
+#include <algorithm>
 #include <complex>
+#include <type_traits>
 
 #include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
 #include "tensorflow/core/framework/attr_value.pb.h"
@@ -68,12 +70,136 @@ void TransposeSimple(const CPUDevice& device, const Tensor& in,
   device.parallelFor(in.NumElements(), cost, std::move(transpose_fn));
 }
 
+// Inputs with fewer elements are left to Eigen's shuffle.
+constexpr int64_t kTiledTransposeMinElements = 32 * 1024;
+
+// Transposes `in` in square tiles spanning the innermost dimension of the input
+// and the dimension that becomes the innermost one of the output, so that the
+// reads and the writes of a tile each touch only kTile cache lines. The other
+// dimensions are iterated over as an outer loop. Tiles are processed in
+// parallel.
+//
+// Returns false, without writing `out`, if the innermost dimension stays in
+// place after collapsing singleton and adjacent dimensions, or if either tiled
+// dimension is smaller than a tile. Eigen's shuffle copies contiguous runs in
+// those cases.
+template <typename T, bool conjugate>
+bool TransposeTiled(const CPUDevice& device, const Tensor& in,
+                    const absl::Span<const int32> perm, Tensor* out) {
+  // A tile row spans at least a 64-byte cache line.
+  constexpr int64_t kTile = std::max<int64_t>(8, 64 / sizeof(T));
+
+  // Singleton dimensions don't affect the memory layout, drop them before
+  // combining the dimensions that stay adjacent.
+  TensorShape shape;
+  internal::TransposePermsVec squeezed_perm;
+  absl::InlinedVector<int32, 8UL> squeezed_dim(in.dims(), -1);
+  for (int i = 0; i < in.dims(); ++i) {
+    if (in.dim_size(i) != 1) {
+      squeezed_dim[i] = shape.dims();
+      shape.AddDim(in.dim_size(i));
+    }
+  }
+  for (const int32 d : perm) {
+    if (squeezed_dim[d] >= 0) squeezed_perm.push_back(squeezed_dim[d]);
+  }
+  if (shape.dims() < 2) return false;
+  internal::TransposePermsVec new_perm;
+  internal::TransposeDimsVec new_dims;
+  internal::ReduceTransposeDimensions(shape, squeezed_perm, &new_perm,
+                                      &new_dims);
+  const int ndims = new_perm.size();
+  if (ndims < 2 || new_perm[ndims - 1] == ndims - 1) return false;
+
+  // Dimension `a` is contiguous in the input, dimension `b` in the output.
+  const int a = ndims - 1;
+  const int b = new_perm[ndims - 1];
+  const int64_t size_a = new_dims[a];
+  const int64_t size_b = new_dims[b];
+  if (size_a < kTile || size_b < kTile) return false;
+
+  absl::InlinedVector<int64_t, 8UL> in_strides(ndims);
+  absl::InlinedVector<int64_t, 8UL> out_strides(ndims);
+  absl::InlinedVector<int64_t, 8UL> out_dim_of(ndims);
+  in_strides[ndims - 1] = 1;
+  out_strides[ndims - 1] = 1;
+  for (int i = ndims - 2; i >= 0; --i) {
+    in_strides[i] = in_strides[i + 1] * new_dims[i + 1];
+    out_strides[i] = out_strides[i + 1] * new_dims[new_perm[i + 1]];
+  }
+  for (int i = 0; i < ndims; ++i) out_dim_of[new_perm[i]] = i;
+  const int64_t in_stride_b = in_strides[b];
+  const int64_t out_stride_a = out_strides[out_dim_of[a]];
+
+  // The remaining dimensions, in input order, with their strides.
+  absl::InlinedVector<int64_t, 8UL> outer_dims;
+  absl::InlinedVector<int64_t, 8UL> outer_in_strides;
+  absl::InlinedVector<int64_t, 8UL> outer_out_strides;
+  int64_t outer_size = 1;
+  for (int i = 0; i < ndims; ++i) {
+    if (i == a || i == b) continue;
+    outer_dims.push_back(new_dims[i]);
+    outer_in_strides.push_back(in_strides[i]);
+    outer_out_strides.push_back(out_strides[out_dim_of[i]]);
+    outer_size *= new_dims[i];
+  }
+
+  const int64_t tiles_a = (size_a + kTile - 1) / kTile;
+  const int64_t tiles_b = (size_b + kTile - 1) / kTile;
+  const T* p = reinterpret_cast<const T*>(in.tensor_data().data());
+  T* q = reinterpret_cast<T*>(const_cast<char*>((out->tensor_data().data())));
+  auto transpose_fn = [=](int64_t begin, int64_t end) {
+    for (int64_t tile = begin; tile < end; ++tile) {
+      const int64_t a0 = (tile % tiles_a) * kTile;
+      const int64_t b0 = (tile / tiles_a % tiles_b) * kTile;
+      int64_t t = tile / (tiles_a * tiles_b);
+      int64_t in_base = 0;
+      int64_t out_base = 0;
+      for (int i = outer_dims.size() - 1; i >= 0; --i) {
+        const int64_t index = t % outer_dims[i];
+        t /= outer_dims[i];
+        in_base += index * outer_in_strides[i];
+        out_base += index * outer_out_strides[i];
+      }
+      const T* src = p + in_base + a0 + b0 * in_stride_b;
+      T* dst = q + out_base + b0 + a0 * out_stride_a;
+      const int64_t na = std::min(kTile, size_a - a0);
+      const int64_t nb = std::min(kTile, size_b - b0);
+      for (int64_t ia = 0; ia < na; ++ia) {
+        for (int64_t ib = 0; ib < nb; ++ib) {
+          if (conjugate) {
+            dst[ia * out_stride_a + ib] =
+                Eigen::numext::conj(src[ib * in_stride_b + ia]);
+          } else {
+            dst[ia * out_stride_a + ib] = src[ib * in_stride_b + ia];
+          }
+        }
+      }
+    }
+  };
+  const double tile_elements = kTile * kTile;
+  Eigen::TensorOpCost cost(
+      /*bytes_loaded=*/tile_elements * sizeof(T),
+      /*bytes_stored=*/tile_elements * sizeof(T),
+      /*compute_cycles=*/tile_elements *
+          (Eigen::TensorOpCost::AddCost<int64_t>() + (conjugate ? 1 : 0)));
+  device.parallelFor(outer_size * tiles_b * tiles_a, cost,
+                     std::move(transpose_fn));
+  return true;
+}
+
 }  // namespace
 
 template <typename T, bool conjugate>
 struct Transpose<CPUDevice, T, conjugate> {
   static void run(const CPUDevice& d, const Tensor& in,
                   const absl::Span<const int32> perm, Tensor* out) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      if (in.NumElements() >= kTiledTransposeMinElements &&
+          TransposeTiled<T, conjugate>(d, in, perm, out)) {
+        return;
+      }
+    }
     switch (in.dims()) {
       case 2:
         internal::TransposeUsingEigen<CPUDevice, T, 2>(d, in, perm, conjugate,
@@ -13,10 +13,18 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#define EIGEN_USE_THREADS
+
+#include <complex>
+#include <vector>
+
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_testutil.h"
 #include "tensorflow/core/kernels/transpose_functor.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/platform/threadpool.h"
 
 namespace tensorflow {
 
@@ -130,4 +138,77 @@ TEST_F(TransposeUtilTest, NonSingletonDimensionAlignment) {
                                                      {0, 1, 2, 5, 4, 3}));
 }
 
+template <typename T>
+T TestValue(int i) {
+  return T(i % 251);
+}
+
+template <>
+complex64 TestValue(int i) {
+  return complex64(i % 251, i % 7);
+}
+
+template <>
+complex128 TestValue(int i) {
+  return complex128(i % 251, i % 7);
+}
+
+class TransposeTiledTest : public ::testing::Test {
+ protected:
+  TransposeTiledTest()
+      : pool_(Env::Default(), "transpose_tiled_test", 4),
+        device_(pool_.AsEigenThreadPool(), 4) {}
+
+  // Checks that DoTranspose, which copies large inputs whose innermost
+  // dimension moves in tiles, matches Eigen's shuffle.
+  template <typename T, int NDIMS>
+  void CheckTranspose(const TensorShape& shape, const std::vector<int32>& perm,
+                      bool conjugate = false) {
+    Tensor in(DataTypeToEnum<T>::value, shape);
+    test::FillFn<T>(&in, TestValue<T>);
+    TensorShape out_shape;
+    for (const int32 d : perm) out_shape.AddDim(shape.dim_size(d));
+    Tensor out(DataTypeToEnum<T>::value, out_shape);
+    Tensor expected(DataTypeToEnum<T>::value, out_shape);
+    if (conjugate) {
+      TF_ASSERT_OK(DoConjugateTranspose(device_, in, perm, &out));
+    } else {
+      TF_ASSERT_OK(DoTranspose(device_, in, perm, &out));
+    }
+    internal::TransposeUsingEigen<Eigen::ThreadPoolDevice, T, NDIMS>(
+        device_, in, perm, conjugate, &expected);
+    test::ExpectTensorEqual<T>(expected, out);
+  }
+
+  thread::ThreadPool pool_;
+  Eigen::ThreadPoolDevice device_;
+};
+
+TEST_F(TransposeTiledTest, Matrix) {
+  CheckTranspose<float, 2>({300, 200}, {1, 0});
+  // Neither dimension is a multiple of the tile size.
+  CheckTranspose<int8, 2>({257, 131}, {1, 0});
+}
+
+TEST_F(TransposeTiledTest, OuterDimensions) {
+  CheckTranspose<float, 3>({64, 48, 32}, {2, 0, 1});
+  CheckTranspose<double, 4>({3, 40, 5, 70}, {2, 3, 0, 1});
+  CheckTranspose<int16, 4>({4, 33, 6, 50}, {3, 0, 2, 1});
+}
+
+TEST_F(TransposeTiledTest, SingletonDimensions) {
+  CheckTranspose<float, 4>({1, 256, 1, 300}, {3, 2, 1, 0});
+  CheckTranspose<int32, 5>({50, 1, 40, 1, 30}, {4, 1, 0, 3, 2});
+}
+
+TEST_F(TransposeTiledTest, InnermostDimensionInPlace) {
+  // Copies contiguous rows with Eigen's shuffle instead.
+  CheckTranspose<float, 3>({64, 64, 16}, {1, 0, 2});
+}
+
+TEST_F(TransposeTiledTest, Conjugate) {
+  CheckTranspose<complex64, 2>({200, 180}, {1, 0}, /*conjugate=*/true);
+  CheckTranspose<complex128, 3>({20, 60, 40}, {0, 2, 1}, /*conjugate=*/true);
+}
+
 }  // namespace tensorflow
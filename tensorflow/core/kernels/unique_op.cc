@@ -13,9 +13,12 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "tensorflow/core/framework/bounds_check.h"
@@ -26,6 +29,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/platform/bfloat16.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
 namespace {
@@ -68,6 +72,149 @@ struct UniqueOpHashMap<bfloat16, TIndex> {
   using map_type = std::unordered_map<bfloat16, TIndex>;
 };
 
+// Inputs of 1-D unique with at least this many elements are uniquified in
+// parallel by `ParallelUnique()`.
+constexpr int64_t kParallelUniqueMinElements = 1 << 16;
+
+// Number of hash partitions, and of chunks the input is split into, used by
+// `ParallelUnique()`.
+constexpr int kUniquePartitionBits = 6;
+constexpr int kNumUniquePartitions = 1 << kUniquePartitionBits;
+constexpr int kNumUniqueChunks = 64;
+
+// Computes the unique elements of `in[0, n)` on the threads of `workers`.
+//
+// The elements are partitioned by hash, so that equal elements fall in the
+// same partition, and each partition is uniquified by a different thread with
+// its own map. The unique elements are then numbered in order of first
+// occurrence across partitions, which yields the same output as the
+// sequential implementation.
+//
+// On return, `idx[i]` is the index of `in[i]` among the unique elements,
+// `first[k]` is the position in `in` of the first occurrence of the k-th unique
+// element and, if `counts` is not null, `(*counts)[k]` is its number of
+// occurrences.
+template <typename T, typename TIndex>
+void ParallelUnique(const DeviceBase::CpuWorkerThreads& workers, const T* in,
+                    int64_t n, TIndex* idx, std::vector<int32>* first,
+                    std::vector<TIndex>* counts) {
+  using MapType = typename UniqueOpHashMap<T, TIndex>::map_type;
+  using KeyType = typename MapType::key_type;
+  constexpr int P = kNumUniquePartitions;
+  constexpr int C = kNumUniqueChunks;
+  const int64_t chunk_size = (n + C - 1) / C;
+  auto for_each_chunk = [&](int64_t cost_per_element,
+                            const std::function<void(int, int64_t, int64_t)>&
+                                fn) {
+    Shard(workers.num_threads, workers.workers, C,
+          chunk_size * cost_per_element, [&](int64_t begin, int64_t end) {
+            for (int64_t c = begin; c < end; ++c) {
+              fn(c, std::min(n, c * chunk_size),
+                 std::min(n, (c + 1) * chunk_size));
+            }
+          });
+  };
+  auto for_each_partition = [&](const std::function<void(int)>& fn) {
+    Shard(workers.num_threads, workers.workers, P, (n / P) * 100,
+          [&](int64_t begin, int64_t end) {
+            for (int64_t p = begin; p < end; ++p) fn(p);
+          });
+  };
+
+  // Partitions the positions of the elements by hash, keeping the positions
+  // of each partition in increasing order.
+  std::vector<uint8> partition(n);
+  std::vector<int32> chunk_offsets(C * P, 0);
+  for_each_chunk(10, [&](int c, int64_t begin, int64_t end) {
+    const typename MapType::hasher hasher;
+    int32* chunk_counts = &chunk_offsets[c * P];
+    for (int64_t i = begin; i < end; ++i) {
+      const KeyType& key = in[i];
+      // Partitions by the high bits of a multiplicative mix of the hash, so
+      // that hashes that are the identity, e.g. for integers, spread too.
+      const uint8 p =
+          (static_cast<uint64>(hasher(key)) * 0x9E3779B97F4A7C15ull) >>
+          (64 - kUniquePartitionBits);
+      partition[i] = p;
+      ++chunk_counts[p];
+    }
+  });
+  std::vector<int32> partition_begin(P + 1, 0);
+  for (int p = 0, offset = 0; p < P; ++p) {
+    partition_begin[p] = offset;
+    for (int c = 0; c < C; ++c) {
+      const int32 count = chunk_offsets[c * P + p];
+      chunk_offsets[c * P + p] = offset;
+      offset += count;
+    }
+  }
+  partition_begin[P] = n;
+  std::vector<int32> positions(n);
+  for_each_chunk(2, [&](int c, int64_t begin, int64_t end) {
+    int32* cursors = &chunk_offsets[c * P];
+    for (int64_t i = begin; i < end; ++i) {
+      positions[cursors[partition[i]]++] = i;
+    }
+  });
+
+  // Uniquifies each partition. `idx` temporarily holds the index of each
+  // element among the unique elements of its partition.
+  std::vector<uint8> is_first(n, 0);
+  std::vector<std::vector<int32>> partition_first(P);
+  std::vector<std::vector<TIndex>> partition_counts(P);
+  for_each_partition([&](int p) {
+    MapType uniq;
+    uniq.reserve(partition_begin[p + 1] - partition_begin[p]);
+    std::vector<int32>& local_first = partition_first[p];
+    std::vector<TIndex>& local_counts = partition_counts[p];
+    for (int32 k = partition_begin[p]; k < partition_begin[p + 1]; ++k) {
+      const int32 i = positions[k];
+      auto it = uniq.emplace(in[i], static_cast<TIndex>(local_first.size()));
+      idx[i] = it.first->second;
+      if (it.second) {
+        is_first[i] = 1;
+        local_first.push_back(i);
+        if (counts != nullptr) local_counts.push_back(0);
+      }
+      if (counts != nullptr) ++local_counts[it.first->second];
+    }
+  });
+
+  // Numbers the unique elements in order of first occurrence. `positions` is
+  // no longer needed, and holds the number of each first occurrence.
+  std::vector<int64_t> chunk_base(C + 1, 0);
+  for_each_chunk(1, [&](int c, int64_t begin, int64_t end) {
+    chunk_base[c + 1] = std::count(is_first.begin() + begin,
+                                   is_first.begin() + end, 1);
+  });
+  for (int c = 0; c < C; ++c) chunk_base[c + 1] += chunk_base[c];
+  for_each_chunk(1, [&](int c, int64_t begin, int64_t end) {
+    int32 next = chunk_base[c];
+    for (int64_t i = begin; i < end; ++i) {
+      if (is_first[i]) positions[i] = next++;
+    }
+  });
+
+  first->resize(chunk_base[C]);
+  if (counts != nullptr) counts->resize(chunk_base[C]);
+  std::vector<std::vector<TIndex>> local_to_global(P);
+  for_each_partition([&](int p) {
+    const std::vector<int32>& local_first = partition_first[p];
+    std::vector<TIndex>& global = local_to_global[p];
+    global.resize(local_first.size());
+    for (size_t k = 0; k < local_first.size(); ++k) {
+      global[k] = positions[local_first[k]];
+      (*first)[global[k]] = local_first[k];
+      if (counts != nullptr) (*counts)[global[k]] = partition_counts[p][k];
+    }
+  });
+  for_each_chunk(2, [&](int c, int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      idx[i] = local_to_global[partition[i]][idx[i]];
+    }
+  });
+}
+
 // `UniqueOp` computes the unique elements in the input tensor.
 //
 // * `T` is the element type.
@@ -143,7 +290,32 @@ class UniqueOp : public OpKernel {
     auto idx_vec = idx->template vec<TIndex>();
 
     int64_t uniq_size;
-    if (new_sizes[0] == 1 && new_sizes[2] == 1) {
+    std::vector<TIndex> parallel_counts;
+    bool has_parallel_counts = false;
+    if (new_sizes[0] == 1 && new_sizes[2] == 1 &&
+        new_sizes[1] >= kParallelUniqueMinElements &&
+        context->device()->tensorflow_cpu_worker_threads()->num_threads > 1) {
+      const DeviceBase::CpuWorkerThreads* workers =
+          context->device()->tensorflow_cpu_worker_threads();
+      auto Tin = input.flat<T>();
+      std::vector<int32> first;
+      has_parallel_counts = num_outputs() > 2;
+      ParallelUnique<T, TIndex>(*workers, Tin.data(), Tin.size(),
+                                idx_vec.data(), &first,
+                                has_parallel_counts ? &parallel_counts
+                                                    : nullptr);
+
+      uniq_size = static_cast<int64_t>(first.size());
+      TensorShape output_shape(input.shape());
+      output_shape.set_dim(axis, uniq_size);
+      Tensor* output = nullptr;
+      OP_REQUIRES_OK(context,
+                     context->allocate_output(0, output_shape, &output));
+      auto Tout = output->flat<T>();
+      for (int64_t k = 0; k < uniq_size; ++k) {
+        Tout(k) = Tin(first[k]);
+      }
+    } else if (new_sizes[0] == 1 && new_sizes[2] == 1) {
       // Specialized and faster implementation when unique is run over single
       // elements. Here we put T directly into the map rather than ints pointing
       // to them as in the general case.
@@ -230,6 +402,11 @@ class UniqueOp : public OpKernel {
       OP_REQUIRES_OK(context, context->allocate_output(
                                   2, TensorShape({uniq_size}), &output));
       auto count_output_vec = output->template vec<TIndex>();
+      if (has_parallel_counts) {
+        std::copy(parallel_counts.begin(), parallel_counts.end(),
+                  count_output_vec.data());
+        return;
+      }
       count_output_vec.setZero();
       const int N = idx_vec.size();
       for (int64_t i = 0; i < N; ++i) {
@@ -15,10 +15,15 @@ limitations under the License.
 
 #include <functional>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include "tensorflow/core/common_runtime/kernel_benchmark_testlib.h"
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def_builder.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
 #include "tensorflow/core/framework/tensor_shape.pb.h"
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/framework/types.pb.h"
@@ -37,6 +42,46 @@ namespace {
 
 const int kMaxStrLen = 40;
 
+class UniqueOpTest : public OpsTestBase {};
+
+// Large enough to be uniquified in parallel.
+TEST_F(UniqueOpTest, LargeInputMatchesSequentialOrder) {
+  TF_ASSERT_OK(NodeDefBuilder("unique", "UniqueWithCounts")
+                   .Input(FakeInput(DT_INT64))
+                   .Attr("out_idx", DT_INT32)
+                   .Finalize(node_def()));
+  TF_ASSERT_OK(InitOp());
+
+  const int n = 1 << 18;
+  std::vector<int64_t> values(n);
+  for (int i = 0; i < n; ++i) values[i] = (std::rand() % 5000) * 7919;
+  AddInputFromArray<int64_t>(TensorShape({n}), values);
+  TF_ASSERT_OK(RunOpKernel());
+
+  std::vector<int64_t> expected_y;
+  std::vector<int32> expected_idx(n);
+  std::vector<int32> expected_count;
+  std::unordered_map<int64_t, int32> seen;
+  for (int i = 0; i < n; ++i) {
+    auto it = seen.emplace(values[i], expected_y.size());
+    if (it.second) {
+      expected_y.push_back(values[i]);
+      expected_count.push_back(0);
+    }
+    expected_idx[i] = it.first->second;
+    ++expected_count[it.first->second];
+  }
+  const int64_t num_unique = expected_y.size();
+  test::ExpectTensorEqual<int64_t>(
+      *GetOutput(0),
+      test::AsTensor<int64_t>(expected_y, TensorShape({num_unique})));
+  test::ExpectTensorEqual<int32>(
+      *GetOutput(1), test::AsTensor<int32>(expected_idx, TensorShape({n})));
+  test::ExpectTensorEqual<int32>(
+      *GetOutput(2),
+      test::AsTensor<int32>(expected_count, TensorShape({num_unique})));
+}
+
 TensorProto GetRandomInt32TensorProto(int dim, int max_int) {
   TensorProto tensor_proto;
   tensor_proto.set_dtype(DT_INT32);
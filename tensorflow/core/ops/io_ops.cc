@@ -55,6 +55,25 @@ absl::Status TwoElementOutput(InferenceContext* c) {
   return absl::OkStatus();
 }
 
+absl::Status SaveV2Shape(InferenceContext* c) {
+  ShapeHandle unused;
+  ShapeHandle s;
+  DimensionHandle unused_dim;
+
+  // Validate prefix.
+  TF_RETURN_IF_ERROR(c->WithRank(c->input(0), 0, &unused));
+
+  // Validate tensor_names and shapes_and_slices.
+  for (int i = 1; i <= 2; ++i) {
+    TF_RETURN_IF_ERROR(c->WithRank(c->input(i), 1, &s));
+    TF_RETURN_IF_ERROR(
+        c->WithValue(c->Dim(s, 0), c->num_inputs() - 3, &unused_dim));
+  }
+  // TODO(mrry): Attempt to parse the shapes_and_slices values and use
+  // them to constrain the shape of the remaining inputs.
+  return absl::OkStatus();
+}
+
 }  // namespace
 
 REGISTER_OP("SaveV2")
@@ -64,24 +83,41 @@ REGISTER_OP("SaveV2")
     .Input("tensors: dtypes")
     .Attr("dtypes: list(type)")
     .SetIsStateful()
-    .SetShapeFn([](InferenceContext* c) {
-      ShapeHandle unused;
-      ShapeHandle s;
-      DimensionHandle unused_dim;
+    .SetShapeFn(SaveV2Shape);
 
-      // Validate prefix.
-      TF_RETURN_IF_ERROR(c->WithRank(c->input(0), 0, &unused));
+REGISTER_OP("_AsyncSaveV2")
+    .Input("prefix: string")
+    .Input("tensor_names: string")
+    .Input("shape_and_slices: string")
+    .Input("tensors: dtypes")
+    .Attr("dtypes: list(type)")
+    .SetIsStateful()
+    .SetShapeFn(SaveV2Shape)
+    .Doc(R"doc(
+Starts saving tensors in V2 checkpoint format from a background thread.
+
+Like SaveV2, but returns as soon as the tensors are copied, without waiting
+for the bundle to be written, so the checkpoint holds their values at the time
+of this op. `_WaitForAsyncSaves` must be run on `prefix` to get the status of
+the save, before saving to the same prefix again, and before merging its files
+with MergeV2Checkpoints. A finished save that is not waited for within 10
+minutes is dropped, with a warning.
+
+Reserved for internal use.
+)doc");
+
+REGISTER_OP("_WaitForAsyncSaves")
+    .Input("prefixes: string")
+    .SetIsStateful()
+    .SetShapeFn(shape_inference::NoOutputs)
+    .Doc(R"doc(
+Waits for the checkpoint saves started by `_AsyncSaveV2` to `prefixes`.
 
-      // Validate tensor_names and shapes_and_slices.
-      for (int i = 1; i <= 2; ++i) {
-        TF_RETURN_IF_ERROR(c->WithRank(c->input(i), 1, &s));
-        TF_RETURN_IF_ERROR(
-            c->WithValue(c->Dim(s, 0), c->num_inputs() - 3, &unused_dim));
-      }
-      // TODO(mrry): Attempt to parse the shapes_and_slices values and use
-      // them to constrain the shape of the remaining inputs.
-      return absl::OkStatus();
-    });
+Fails with the first error of those saves, or if no save to one of the prefixes
+is in progress.
+
+Reserved for internal use.
+)doc");
 
 REGISTER_OP("RestoreV2")
     .Input("prefix: string")
@@ -551,4 +551,123 @@ REGISTER_OP("InitializeTableFromTextFileV2")
       return absl::OkStatus();
     });
 
+REGISTER_OP("DynamicEmbeddingTable")
+    .Output("table_handle: resource")
+    .Attr("container: string = ''")
+    .Attr("shared_name: string = ''")
+    .Attr("dim: int >= 1")
+    .Attr("num_slots: int >= 0 = 0")
+    .Attr("max_rows: int >= 0 = 0")
+    .Attr("eviction_policy: {'lru', 'lfu'} = 'lru'")
+    .Attr("initializer_stddev: float = 0.0")
+    .Attr("initial_slot_value: float = 0.0")
+    .Attr("seed: int = 0")
+    .SetIsStateful()
+    .SetShapeFn(shape_inference::ScalarShape);
+
+REGISTER_OP("DynamicEmbeddingLookup")
+    .Input("table_handle: resource")
+    .Input("ids: int64")
+    .Output("values: float")
+    .Attr("dim: int >= 1")
+    .Attr("insert_missing: bool = true")
+    .SetShapeFn([](InferenceContext* c) {
+      ShapeHandle handle;
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(0), 0, &handle));
+      int64_t dim;
+      TF_RETURN_IF_ERROR(c->GetAttr("dim", &dim));
+      ShapeHandle values;
+      TF_RETURN_IF_ERROR(
+          c->Concatenate(c->input(1), c->Vector(dim), &values));
+      c->set_output(0, values);
+      return absl::OkStatus();
+    });
+
+namespace {
+
+// Checks that `ids` is a vector, `grad` a matrix with a row per id, and the
+// inputs from `first_scalar` on are scalars.
+absl::Status DynamicEmbeddingApplyShapeFn(InferenceContext* c,
+                                          int first_scalar) {
+  ShapeHandle handle;
+  TF_RETURN_IF_ERROR(c->WithRank(c->input(0), 0, &handle));
+  ShapeHandle ids;
+  TF_RETURN_IF_ERROR(c->WithRank(c->input(1), 1, &ids));
+  ShapeHandle grad;
+  TF_RETURN_IF_ERROR(c->WithRank(c->input(2), 2, &grad));
+  DimensionHandle unused;
+  TF_RETURN_IF_ERROR(c->Merge(c->Dim(ids, 0), c->Dim(grad, 0), &unused));
+  for (int i = first_scalar; i < c->num_inputs(); ++i) {
+    TF_RETURN_IF_ERROR(c->WithRank(c->input(i), 0, &handle));
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+REGISTER_OP("DynamicEmbeddingSparseApplyAdagrad")
+    .Input("table_handle: resource")
+    .Input("ids: int64")
+    .Input("grad: float")
+    .Input("lr: float")
+    .Input("epsilon: float")
+    .SetShapeFn([](InferenceContext* c) {
+      return DynamicEmbeddingApplyShapeFn(c, /*first_scalar=*/3);
+    });
+
+REGISTER_OP("DynamicEmbeddingSparseApplyAdam")
+    .Input("table_handle: resource")
+    .Input("ids: int64")
+    .Input("grad: float")
+    .Input("lr: float")
+    .Input("beta1: float")
+    .Input("beta2: float")
+    .Input("beta1_power: float")
+    .Input("beta2_power: float")
+    .Input("epsilon: float")
+    .SetShapeFn([](InferenceContext* c) {
+      return DynamicEmbeddingApplyShapeFn(c, /*first_scalar=*/3);
+    });
+
+REGISTER_OP("DynamicEmbeddingSize")
+    .Input("table_handle: resource")
+    .Output("size: int64")
+    .SetShapeFn([](InferenceContext* c) {
+      ShapeHandle handle;
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(0), 0, &handle));
+      c->set_output(0, c->Scalar());
+      return absl::OkStatus();
+    });
+
+REGISTER_OP("DynamicEmbeddingExport")
+    .Input("table_handle: resource")
+    .Output("ids: int64")
+    .Output("values: float")
+    .Attr("dim: int >= 1")
+    .SetShapeFn([](InferenceContext* c) {
+      ShapeHandle handle;
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(0), 0, &handle));
+      int64_t dim;
+      TF_RETURN_IF_ERROR(c->GetAttr("dim", &dim));
+      DimensionHandle size = c->UnknownDim();
+      c->set_output(0, c->Vector(size));
+      c->set_output(1, c->Matrix(size, dim));
+      return absl::OkStatus();
+    });
+
+REGISTER_OP("DynamicEmbeddingImport")
+    .Input("table_handle: resource")
+    .Input("ids: int64")
+    .Input("values: float")
+    .SetShapeFn([](InferenceContext* c) {
+      ShapeHandle handle;
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(0), 0, &handle));
+      ShapeHandle ids;
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(1), 1, &ids));
+      ShapeHandle values;
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(2), 2, &values));
+      DimensionHandle unused;
+      return c->Merge(c->Dim(ids, 0), c->Dim(values, 0), &unused);
+    });
+
 }  // namespace tensorflow
@@ -995,6 +995,25 @@ REGISTER_OP("Max")
     .Attr("Tidx: {int32, int64} = DT_INT32")
     .SetShapeFn(shape_inference::ReductionShape);
 
+REGISTER_OP("_FusedMinMax")
+    .Input("input: T")
+    .Input("reduction_indices: Tidx")
+    .Output("min: T")
+    .Output("max: T")
+    .Attr("keep_dims: bool = false")
+    .Attr("T: realnumbertype")
+    .Attr("Tidx: {int32, int64} = DT_INT32")
+    .SetShapeFn([](InferenceContext* c) {
+      TF_RETURN_IF_ERROR(shape_inference::ReductionShape(c));
+      c->set_output(1, c->output(0));
+      return absl::OkStatus();
+    })
+    .Doc(R"doc(
+Computes both Min and Max of the input over the same axes, reading the input
+once. Reserved for internal use: a remapper optimization is expected to create
+these operators from sibling Min and Max nodes.
+)doc");
+
 namespace {
 
 absl::Status ArgOpShape(shape_inference::InferenceContext* c) {
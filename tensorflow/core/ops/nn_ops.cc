@@ -1301,6 +1301,58 @@ REGISTER_OP("LogSoftmax")
 
 // --------------------------------------------------------------------------
 
+REGISTER_OP("_FusedScaledDotProductAttention")
+    .Input("query: T")
+    .Input("key: T")
+    .Input("value: T")
+    .Input("scale: T")
+    .Output("output: T")
+    .Attr("T: {float}")
+    .SetShapeFn([](InferenceContext* c) {
+      ShapeHandle query;
+      ShapeHandle key;
+      ShapeHandle value;
+      ShapeHandle unused;
+      TF_RETURN_IF_ERROR(c->WithRankAtLeast(c->input(0), 2, &query));
+      TF_RETURN_IF_ERROR(c->WithRankAtLeast(c->input(1), 2, &key));
+      TF_RETURN_IF_ERROR(c->WithRankAtLeast(c->input(2), 2, &value));
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(3), 0, &unused));
+
+      // Query, key and value must have the same batch dimensions.
+      ShapeHandle batch;
+      ShapeHandle key_batch;
+      ShapeHandle value_batch;
+      TF_RETURN_IF_ERROR(c->Subshape(query, 0, -2, &batch));
+      TF_RETURN_IF_ERROR(c->Subshape(key, 0, -2, &key_batch));
+      TF_RETURN_IF_ERROR(c->Subshape(value, 0, -2, &value_batch));
+      TF_RETURN_IF_ERROR(c->Merge(batch, key_batch, &batch));
+      TF_RETURN_IF_ERROR(c->Merge(batch, value_batch, &batch));
+
+      DimensionHandle unused_dim;
+      TF_RETURN_IF_ERROR(
+          c->Merge(c->Dim(query, -1), c->Dim(key, -1), &unused_dim));
+      TF_RETURN_IF_ERROR(
+          c->Merge(c->Dim(key, -2), c->Dim(value, -2), &unused_dim));
+
+      ShapeHandle output;
+      TF_RETURN_IF_ERROR(
+          c->Concatenate(batch, c->Matrix(c->Dim(query, -2), c->Dim(value, -1)),
+                         &output));
+      c->set_output(0, output);
+      return absl::OkStatus();
+    })
+    .Doc(R"doc(
+Computes `softmax(scale * query * key^T) * value` over the last two dimensions.
+
+The kernel streams over blocks of keys and keeps a running softmax for each
+query, so the attention matrix is never materialized.
+
+*NOTE*: Do not invoke this operator directly in Python. Grappler is expected to
+create these operators.
+)doc");
+
+// --------------------------------------------------------------------------
+
 REGISTER_OP("SoftmaxCrossEntropyWithLogits")
     .Input("features: T")
     .Input("labels: T")
@@ -439,4 +439,15 @@ REGISTER_OP("DisableCopyOnRead")
     .Input("resource: resource")
     .SetShapeFn(shape_inference::NoOutputs);
 
+REGISTER_OP("_EnableVariableHogwildMode")
+    .Input("resource: resource")
+    .SetShapeFn(shape_inference::NoOutputs)
+    .Doc(R"doc(
+Puts a resource variable in Hogwild mode: on CPU, training ops with
+`use_locking=False` then update it in place, without locking it or copying its
+buffer. Concurrent updates race, and may be lost or interleave element-wise.
+Reads alias the buffer of the variable and observe later updates. Reserved for
+internal use.
+)doc");
+
 }  // namespace tensorflow
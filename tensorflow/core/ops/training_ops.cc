@@ -377,6 +377,47 @@ REGISTER_OP("ResourceSparseApplyAdagradV2")
     .SetShapeFn(
         ApplyAdagradV2ShapeFn</*is_sparse=*/true, /*is_resource=*/true>);
 
+// Applies ResourceSparseApplyAdagradV2 to N variables that share lr and
+// epsilon. Created by the sparse_apply_grouping grappler pass.
+REGISTER_OP("_GroupedResourceSparseApplyAdagradV2")
+    .Input("var: N * resource")
+    .Input("accum: N * resource")
+    .Input("lr: T")
+    .Input("epsilon: T")
+    .Input("grad: N * T")
+    .Input("indices: N * Tindices")
+    .Attr("N: int >= 1")
+    .Attr("T: {half, bfloat16, float, double}")
+    .Attr("Tindices: {int32, int64}")
+    .Attr("use_locking: bool = false")
+    .Attr("update_slots: bool = true")
+    .SetShapeFn([](InferenceContext* c) {
+      int n;
+      TF_RETURN_IF_ERROR(c->GetAttr("N", &n));
+      ShapeHandle unused;
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(2 * n), 0, &unused));  // lr
+      TF_RETURN_IF_ERROR(
+          c->WithRank(c->input(2 * n + 1), 0, &unused));  // epsilon
+      for (int i = 0; i < n; ++i) {
+        ShapeHandle s = ShapeOrHandleShape<true>(c, i);  // var
+        TF_RETURN_IF_ERROR(
+            c->Merge(s, ShapeOrHandleShape<true>(c, n + i), &s));  // accum
+        ShapeHandle grad;
+        TF_RETURN_IF_ERROR(c->WithRankAtLeast(c->input(2 * n + 2 + i), 1,
+                                              &grad));
+        ShapeHandle indices;
+        TF_RETURN_IF_ERROR(c->WithRank(c->input(3 * n + 2 + i), 1, &indices));
+        DimensionHandle unused_dim;
+        TF_RETURN_IF_ERROR(
+            c->Merge(c->Dim(indices, 0), c->Dim(grad, 0), &unused_dim));
+        ShapeHandle grad_unknown_first;
+        TF_RETURN_IF_ERROR(
+            c->ReplaceDim(grad, 0, c->UnknownDim(), &grad_unknown_first));
+        TF_RETURN_IF_ERROR(c->Merge(s, grad_unknown_first, &s));
+      }
+      return absl::OkStatus();
+    });
+
 template <bool is_sparse, bool is_resource>
 static absl::Status ApplyProximalAdagradShapeFn(InferenceContext* c) {
   ShapeHandle unused;
@@ -0,0 +1,293 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/profiler/convert/step_time_attribution.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/types/span.h"
+#include "xla/tsl/profiler/utils/math_utils.h"
+#include "xla/tsl/profiler/utils/timespan.h"
+#include "xla/tsl/profiler/utils/xplane_utils.h"
+#include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/profiler/convert/xplane_to_step_events.h"
+#include "tensorflow/core/profiler/protobuf/step_time_attribution.pb.h"
+#include "tensorflow/core/profiler/protobuf/steps_db.pb.h"
+#include "tensorflow/core/profiler/protobuf/xplane.pb.h"
+#include "tensorflow/core/profiler/utils/event_span.h"
+#include "tensorflow/core/profiler/utils/step_intersection.h"
+#include "tensorflow/core/profiler/utils/xplane_schema.h"
+#include "tensorflow/core/profiler/utils/xplane_utils.h"
+
+namespace tensorflow {
+namespace profiler {
+namespace {
+
+struct Category {
+  const char* name;
+  uint64_t (StepTimeAttribution::*ps)() const;
+};
+
+constexpr Category kCategories[] = {
+    {"input", &StepTimeAttribution::input_ps},
+    {"compute", &StepTimeAttribution::compute_ps},
+    {"collectives", &StepTimeAttribution::collectives_ps},
+    {"communication", &StepTimeAttribution::communication_ps},
+    {"host_overhead", &StepTimeAttribution::host_overhead_ps},
+    {"idle", &StepTimeAttribution::idle_ps},
+};
+
+// Adds `ps` to the category of `type`. Returns false for the time which isn't
+// attributed to an event.
+bool AddEventTypePs(bool has_device, EventType type, uint64_t ps,
+                    StepTimeAttribution* step) {
+  switch (type) {
+    case HOST_WAIT_INPUT:
+    case HOST_TO_DEVICE:
+    case DEVICE_WAIT_HOST:
+    case HOST_PREPROCESS:
+    case HOST_BATCH_FORMATION:
+      step->set_input_ps(step->input_ps() + ps);
+      return true;
+    case DEVICE_COMPUTE_16:
+    case DEVICE_COMPUTE_32:
+      step->set_compute_ps(step->compute_ps() + ps);
+      return true;
+    case HOST_COMPUTE:
+      if (has_device) {
+        step->set_host_overhead_ps(step->host_overhead_ps() + ps);
+      } else {
+        step->set_compute_ps(step->compute_ps() + ps);
+      }
+      return true;
+    case DEVICE_COLLECTIVES:
+      step->set_collectives_ps(step->collectives_ps() + ps);
+      return true;
+    case HOST_TO_HOST:
+    case DEVICE_TO_DEVICE:
+    case DEVICE_TO_HOST:
+    case DEVICE_WAIT_DEVICE:
+      step->set_communication_ps(step->communication_ps() + ps);
+      return true;
+    case HOST_PREPARE:
+    case HOST_RUNTIME:
+    case HOST_COMPILE:
+    case HOST_POSTPROCESS:
+      step->set_host_overhead_ps(step->host_overhead_ps() + ps);
+      return true;
+    default:
+      return false;
+  }
+}
+
+void AddStep(const StepTimeAttribution& step, StepTimeAttribution* total) {
+  total->set_duration_ps(total->duration_ps() + step.duration_ps());
+  total->set_input_ps(total->input_ps() + step.input_ps());
+  total->set_compute_ps(total->compute_ps() + step.compute_ps());
+  total->set_collectives_ps(total->collectives_ps() + step.collectives_ps());
+  total->set_communication_ps(total->communication_ps() +
+                              step.communication_ps());
+  total->set_host_overhead_ps(total->host_overhead_ps() +
+                              step.host_overhead_ps());
+  total->set_idle_ps(total->idle_ps() + step.idle_ps());
+}
+
+// Sets the total and the bottleneck of `result` from its steps.
+void SetTotal(StepTimeAttributionResult* result) {
+  StepTimeAttribution* total = result->mutable_total();
+  total->Clear();
+  total->set_step_num(-1);
+  total->set_host_index(-1);
+  for (const StepTimeAttribution& step : result->steps()) {
+    AddStep(step, total);
+  }
+  result->clear_bottleneck();
+  uint64_t bottleneck_ps = 0;
+  for (const Category& category : kCategories) {
+    if ((total->*category.ps)() > bottleneck_ps) {
+      bottleneck_ps = (total->*category.ps)();
+      result->set_bottleneck(category.name);
+    }
+  }
+}
+
+StepTimeAttribution AttributeStep(bool has_device, int64_t step_num,
+                                  const StepDetails& step_details) {
+  const tsl::profiler::Timespan step_time = step_details.StepTime();
+  StepTimeAttribution step;
+  step.set_step_num(step_num);
+  step.set_step_name(step_details.StepName());
+  step.set_begin_ps(step_time.begin_ps());
+  step.set_duration_ps(step_time.duration_ps());
+  uint64_t attributed_ps = 0;
+  for (const EventTypeSpan& event : step_details.Events()) {
+    // Ignore event duration outside the step marker.
+    const uint64_t event_ps = step_time.OverlappedDurationPs(event.span);
+    if (AddEventTypePs(has_device, event.type, event_ps, &step)) {
+      attributed_ps += event_ps;
+    }
+  }
+  if (attributed_ps < step_time.duration_ps()) {
+    step.set_idle_ps(step.idle_ps() + step_time.duration_ps() - attributed_ps);
+  }
+  return step;
+}
+
+}  // namespace
+
+StepTimeAttributionResult ConvertStepEventsToStepTimeAttribution(
+    bool has_device, const StepEvents& nonoverlapped_step_events) {
+  StepTimeAttributionResult result;
+  for (const auto& [step_num, step_details] : nonoverlapped_step_events) {
+    if (step_details.StepTime().duration_ps() == 0) continue;
+    *result.add_steps() = AttributeStep(has_device, step_num, step_details);
+  }
+  std::sort(result.mutable_steps()->begin(), result.mutable_steps()->end(),
+            [](const StepTimeAttribution& a, const StepTimeAttribution& b) {
+              return a.begin_ps() != b.begin_ps() ? a.begin_ps() < b.begin_ps()
+                                                  : a.step_num() < b.step_num();
+            });
+  SetTotal(&result);
+  return result;
+}
+
+StepTimeAttributionResult ConvertXSpaceToStepTimeAttribution(
+    const XSpace& space) {
+  StepEvents step_events;
+  std::vector<const XPlane*> device_planes =
+      FindPlanesWithPrefix(space, kTpuPlanePrefix);
+  const bool is_tpu = !device_planes.empty();
+  if (!is_tpu) {
+    device_planes = FindPlanesWithPrefix(space, kGpuPlanePrefix);
+  }
+  for (const XPlane* device_trace : device_planes) {
+    if (is_tpu) {
+      // Like for the steps db, the steps of TPU cores are intersected.
+      XPlane aggregated_xplane;
+      tsl::profiler::AggregateXPlane(*device_trace, aggregated_xplane);
+      IntersectCombineStepEvents(
+          ConvertDeviceTraceXPlaneToStepEvents(aggregated_xplane),
+          &step_events);
+    } else {
+      UnionCombineStepEvents(
+          ConvertDeviceTraceXPlaneToStepEvents(*device_trace), &step_events);
+    }
+  }
+  const bool has_device = !device_planes.empty();
+  // Unlike the steps db, the host events of the device steps are kept: input
+  // waits and launch overhead happen on the host.
+  if (const XPlane* host_plane =
+          FindPlaneWithName(space, kHostThreadsPlaneName)) {
+    const StepEvents host_step_events = ConvertHostThreadsXPlaneToStepEvents(
+        *host_plane, has_device ? &step_events : nullptr);
+    UnionCombineStepEvents(host_step_events, &step_events);
+  }
+  return ConvertStepEventsToStepTimeAttribution(
+      has_device, ToNonOverlappedStepEvents(step_events));
+}
+
+StepTimeAttributionResult CombineStepTimeAttributions(
+    absl::Span<const StepTimeAttributionResult> per_host) {
+  std::vector<StepDatabaseResult> step_dbs(per_host.size());
+  absl::flat_hash_map<uint32, const StepDatabaseResult*> perhost_stepdb;
+  for (uint32 host = 0; host < per_host.size(); ++host) {
+    for (const StepTimeAttribution& step : per_host[host].steps()) {
+      PerCoreStepInfo* step_info = step_dbs[host].add_step_sequence();
+      step_info->set_step_num(step.step_num());
+      StepInfoResult& core_step_info =
+          (*step_info->mutable_step_info_per_core())[0];
+      core_step_info.set_step_num(step.step_num());
+      core_step_info.set_begin_ps(step.begin_ps());
+      core_step_info.set_duration_ps(step.duration_ps());
+    }
+    perhost_stepdb[host] = &step_dbs[host];
+  }
+  const StepIntersection intersection(std::numeric_limits<uint32>::max(),
+                                      perhost_stepdb);
+
+  StepTimeAttributionResult result;
+  for (uint32 i = 0; i < intersection.NumSteps(); ++i) {
+    const StepTimeAttribution* longest = nullptr;
+    int32 longest_host = -1;
+    for (uint32 host = 0; host < per_host.size(); ++host) {
+      const uint32 index = intersection.FirstStepIndex(host) + i;
+      if (index >= per_host[host].steps_size()) continue;
+      const StepTimeAttribution& step = per_host[host].steps(index);
+      if (longest == nullptr || step.duration_ps() > longest->duration_ps()) {
+        longest = &step;
+        longest_host = host;
+      }
+    }
+    if (longest == nullptr) continue;
+    StepTimeAttribution* step = result.add_steps();
+    *step = *longest;
+    step->set_host_index(longest_host);
+  }
+  SetTotal(&result);
+  return result;
+}
+
+StepTimeAttributionResult ConvertMultiXSpacesToStepTimeAttribution(
+    absl::Span<const XSpace* const> spaces) {
+  std::vector<StepTimeAttributionResult> per_host;
+  per_host.reserve(spaces.size());
+  for (const XSpace* space : spaces) {
+    per_host.push_back(ConvertXSpaceToStepTimeAttribution(*space));
+  }
+  return CombineStepTimeAttributions(per_host);
+}
+
+std::string StepTimeAttributionToString(
+    const StepTimeAttributionResult& result) {
+  std::string out;
+  absl::StrAppendFormat(&out, "%-12s %5s %12s", "Step", "Host", "Time(ms)");
+  for (const Category& category : kCategories) {
+    absl::StrAppendFormat(&out, " %14s", category.name);
+  }
+  absl::StrAppend(&out, "\n");
+  auto append_row = [&out](const std::string& name,
+                           const StepTimeAttribution& step) {
+    absl::StrAppendFormat(&out, "%-12s %5s %12.3f", name,
+                          step.host_index() < 0
+                              ? std::string("-")
+                              : absl::StrCat(step.host_index()),
+                          tsl::profiler::PicoToMilli(step.duration_ps()));
+    for (const Category& category : kCategories) {
+      absl::StrAppendFormat(
+          &out, " %13.1f%%",
+          tsl::profiler::SafeDivide(100.0 * (step.*category.ps)(),
+                                    step.duration_ps()));
+    }
+    absl::StrAppend(&out, "\n");
+  };
+  for (const StepTimeAttribution& step : result.steps()) {
+    append_row(absl::StrCat(step.step_num()), step);
+  }
+  append_row("Total", result.total());
+  if (!result.bottleneck().empty()) {
+    absl::StrAppend(&out, "Bottleneck: ", result.bottleneck(), "\n");
+  }
+  return out;
+}
+
+}  // namespace profiler
+}  // namespace tensorflow
@@ -0,0 +1,62 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_PROFILER_CONVERT_STEP_TIME_ATTRIBUTION_H_
+#define TENSORFLOW_CORE_PROFILER_CONVERT_STEP_TIME_ATTRIBUTION_H_
+
+#include <string>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "tensorflow/core/profiler/protobuf/step_time_attribution.pb.h"
+#include "tensorflow/core/profiler/protobuf/xplane.pb.h"
+#include "tensorflow/core/profiler/utils/event_span.h"
+
+namespace tensorflow {
+namespace profiler {
+
+// Attributes the time of each step of `nonoverlapped_step_events` (as
+// returned by ToNonOverlappedStepEvents) to input, compute, collectives,
+// communication, host overhead and idle time. Host computation is compute
+// time without a device and host overhead with one. Steps without step
+// markers are skipped. The steps are ordered by their begin time.
+StepTimeAttributionResult ConvertStepEventsToStepTimeAttribution(
+    bool has_device, const StepEvents& nonoverlapped_step_events);
+
+// Attributes the steps of a host from its grouped XSpace (see
+// GroupTfEvents), with its device step events and the host step events of
+// the same steps, or the host step events alone without a device.
+StepTimeAttributionResult ConvertXSpaceToStepTimeAttribution(
+    const XSpace& space);
+
+// Aligns the steps of the hosts of a multi-host capture by their timespans,
+// and attributes each step from the host whose step was the longest, since the
+// other hosts waited for it. `per_host` is indexed by host.
+StepTimeAttributionResult CombineStepTimeAttributions(
+    absl::Span<const StepTimeAttributionResult> per_host);
+
+// Attributes the steps of `spaces`, one XSpace per host.
+StepTimeAttributionResult ConvertMultiXSpacesToStepTimeAttribution(
+    absl::Span<const XSpace* const> spaces);
+
+// A text table of the attribution of each step and of the total, in percents
+// of the step time, followed by the bottleneck.
+std::string StepTimeAttributionToString(
+    const StepTimeAttributionResult& result);
+
+}  // namespace profiler
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_PROFILER_CONVERT_STEP_TIME_ATTRIBUTION_H_
@@ -0,0 +1,147 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/profiler/convert/step_time_attribution.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "xla/tsl/profiler/utils/timespan.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/profiler/protobuf/step_time_attribution.pb.h"
+#include "tensorflow/core/profiler/utils/event_span.h"
+
+namespace tensorflow {
+namespace profiler {
+namespace {
+
+using tsl::profiler::Timespan;
+
+StepDetails MakeStep(const Timespan& step_time,
+                     const std::vector<EventTypeSpan>& events) {
+  StepDetails step;
+  step.AddMarker(
+      StepMarker(StepMarkerType::kExplicitHostStepMarker, "train", step_time));
+  for (const EventTypeSpan& event : events) {
+    step.AddEvent(event);
+  }
+  return step;
+}
+
+TEST(StepTimeAttributionTest, AttributesHostOnlySteps) {
+  StepEvents step_events;
+  step_events[1] = MakeStep(Timespan(0, 100),
+                            {EventTypeSpan(HOST_COMPUTE, Timespan(0, 50)),
+                             EventTypeSpan(HOST_WAIT_INPUT, Timespan(50, 30))});
+  step_events[2] =
+      MakeStep(Timespan(200, 100),
+               {EventTypeSpan(HOST_COMPUTE, Timespan(200, 60)),
+                EventTypeSpan(HOST_TO_HOST, Timespan(260, 40))});
+
+  const StepTimeAttributionResult result =
+      ConvertStepEventsToStepTimeAttribution(/*has_device=*/false,
+                                             step_events);
+  ASSERT_EQ(result.steps_size(), 2);
+  const StepTimeAttribution& first = result.steps(0);
+  EXPECT_EQ(first.step_num(), 1);
+  EXPECT_EQ(first.duration_ps(), 100);
+  EXPECT_EQ(first.compute_ps(), 50);
+  EXPECT_EQ(first.input_ps(), 30);
+  EXPECT_EQ(first.idle_ps(), 20);
+  const StepTimeAttribution& second = result.steps(1);
+  EXPECT_EQ(second.step_num(), 2);
+  EXPECT_EQ(second.compute_ps(), 60);
+  EXPECT_EQ(second.communication_ps(), 40);
+  EXPECT_EQ(second.idle_ps(), 0);
+
+  EXPECT_EQ(result.total().duration_ps(), 200);
+  EXPECT_EQ(result.total().compute_ps(), 110);
+  EXPECT_EQ(result.bottleneck(), "compute");
+}
+
+TEST(StepTimeAttributionTest, HostComputeIsOverheadWithDevice) {
+  StepEvents step_events;
+  step_events[1] =
+      MakeStep(Timespan(0, 100),
+               {EventTypeSpan(HOST_COMPUTE, Timespan(0, 20)),
+                EventTypeSpan(HOST_PREPARE, Timespan(20, 10)),
+                EventTypeSpan(DEVICE_COMPUTE_32, Timespan(30, 40)),
+                EventTypeSpan(DEVICE_COLLECTIVES, Timespan(70, 30))});
+
+  const StepTimeAttributionResult result =
+      ConvertStepEventsToStepTimeAttribution(/*has_device=*/true, step_events);
+  ASSERT_EQ(result.steps_size(), 1);
+  EXPECT_EQ(result.steps(0).host_overhead_ps(), 30);
+  EXPECT_EQ(result.steps(0).compute_ps(), 40);
+  EXPECT_EQ(result.steps(0).collectives_ps(), 30);
+  EXPECT_EQ(result.steps(0).idle_ps(), 0);
+}
+
+TEST(StepTimeAttributionTest, SkipsStepsWithoutMarkers) {
+  StepEvents step_events;
+  step_events[1].AddEvent(EventTypeSpan(HOST_COMPUTE, Timespan(0, 20)));
+  const StepTimeAttributionResult result =
+      ConvertStepEventsToStepTimeAttribution(/*has_device=*/false,
+                                             step_events);
+  EXPECT_EQ(result.steps_size(), 0);
+  EXPECT_TRUE(result.bottleneck().empty());
+}
+
+TEST(StepTimeAttributionTest, CombinesHostsByLongestStep) {
+  StepEvents first_host;
+  first_host[1] = MakeStep(Timespan(0, 100),
+                           {EventTypeSpan(HOST_COMPUTE, Timespan(0, 100))});
+  first_host[2] = MakeStep(Timespan(200, 100),
+                           {EventTypeSpan(HOST_COMPUTE, Timespan(200, 100))});
+  StepEvents second_host;
+  second_host[7] = MakeStep(Timespan(0, 90),
+                            {EventTypeSpan(HOST_COMPUTE, Timespan(0, 90))});
+  second_host[8] =
+      MakeStep(Timespan(200, 150),
+               {EventTypeSpan(HOST_COMPUTE, Timespan(200, 50)),
+                EventTypeSpan(HOST_WAIT_INPUT, Timespan(250, 100))});
+  const std::vector<StepTimeAttributionResult> per_host = {
+      ConvertStepEventsToStepTimeAttribution(/*has_device=*/false, first_host),
+      ConvertStepEventsToStepTimeAttribution(/*has_device=*/false,
+                                             second_host)};
+
+  const StepTimeAttributionResult result =
+      CombineStepTimeAttributions(per_host);
+  ASSERT_EQ(result.steps_size(), 2);
+  EXPECT_EQ(result.steps(0).host_index(), 0);
+  EXPECT_EQ(result.steps(0).duration_ps(), 100);
+  EXPECT_EQ(result.steps(1).host_index(), 1);
+  EXPECT_EQ(result.steps(1).input_ps(), 100);
+  EXPECT_EQ(result.total().duration_ps(), 250);
+  EXPECT_EQ(result.bottleneck(), "compute");
+}
+
+TEST(StepTimeAttributionTest, TextSummary) {
+  StepEvents step_events;
+  step_events[3] =
+      MakeStep(Timespan(0, 1000000000),
+               {EventTypeSpan(HOST_WAIT_INPUT, Timespan(0, 750000000))});
+  const std::string summary = StepTimeAttributionToString(
+      ConvertStepEventsToStepTimeAttribution(/*has_device=*/false,
+                                             step_events));
+  EXPECT_NE(summary.find("Total"), std::string::npos);
+  EXPECT_NE(summary.find("75.0%"), std::string::npos);
+  EXPECT_NE(summary.find("Bottleneck: input"), std::string::npos);
+}
+
+}  // namespace
+}  // namespace profiler
+}  // namespace tensorflow
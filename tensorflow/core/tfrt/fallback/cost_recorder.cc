@@ -51,14 +51,20 @@ uint64_t CostRecorder::GetCost(int64_t op_key) const {
   return r;
 }
 
+absl::flat_hash_map<int64_t, uint64_t> CostRecorder::GetAverageCosts() const {
+  absl::flat_hash_map<int64_t, uint64_t> average_costs;
+  tf_shared_lock l(op_cost_map_mutex_);
+  average_costs.reserve(op_cost_map_.size());
+  for (const auto& [op_key, op_cost] : op_cost_map_) {
+    average_costs[op_key] = op_cost.first / op_cost.second;
+  }
+  return average_costs;
+}
+
 absl::Status CostRecorder::WriteToFile() const {
   OpCostMapProto op_cost_map_proto;
-  {
-    tf_shared_lock l(op_cost_map_mutex_);
-    for (const auto& [op_key, op_cost] : op_cost_map_) {
-      const uint64_t avg_op_cost = op_cost.first / op_cost.second;
-      (*op_cost_map_proto.mutable_op_cost_map())[op_key] = avg_op_cost;
-    }
+  for (const auto& [op_key, avg_op_cost] : GetAverageCosts()) {
+    (*op_cost_map_proto.mutable_op_cost_map())[op_key] = avg_op_cost;
   }
 
   std::string measured_cost_path;
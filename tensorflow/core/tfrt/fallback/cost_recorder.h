@@ -42,6 +42,9 @@ class CostRecorder {
   // otherwise adding op costs would cause overflow.
   uint64_t GetCost(int64_t op_key) const;
 
+  // Returns the average execution duration of each recorded op, by `op_key`.
+  absl::flat_hash_map<int64_t, uint64_t> GetAverageCosts() const;
+
   // Writes the op cost map (in format of `OpCostMapProto`) to a file specified
   // by the env var name `MesuredCostPathEnvVarName()`.
   // TODO(b/263837451): Fix the op_key unstableness during serialization.
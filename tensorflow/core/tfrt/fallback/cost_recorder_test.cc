@@ -48,6 +48,19 @@ TEST(CostRecorderTest, GetCostTest) {
   EXPECT_EQ(recorder.GetCost(kTestOpKey), kTestAvgCost);
 }
 
+TEST(CostRecorderTest, GetAverageCostsTest) {
+  CostRecorder recorder;
+
+  recorder.RecordCost(kTestOpKey, kTestCost);
+  recorder.RecordCost(kTestOpKey, 2 * kTestCost);
+  recorder.RecordCost(kTestOpKey + 1, kTestCost);
+
+  const auto average_costs = recorder.GetAverageCosts();
+  EXPECT_EQ(average_costs.size(), 2);
+  EXPECT_EQ(average_costs.at(kTestOpKey), kTestAvgCost);
+  EXPECT_EQ(average_costs.at(kTestOpKey + 1), kTestCost);
+}
+
 TEST(CostRecorderTest, GetCostDefaultValueTest) {
   CostRecorder recorder;
   ASSERT_EQ(recorder.size(), 0);
@@ -96,10 +96,24 @@ struct GraphExecutionOptions {
     // Number of times to record costs before resetting Op cost estimates.
     // However, a reset always occurs after the first execution.
     int updates_per_interval = 1;
+
+    // If positive, a reset only recompiles the executable if the average cost
+    // of some op moved by at least this fraction of its cost at the last
+    // compilation (or the op wasn't executed before), so that the streams are
+    // only re-split when the costs actually move. Recompiling is expensive.
+    // The first reset always recompiles.
+    double min_relative_cost_change = 0;
   };
 
   CostAnalysisOptions cost_analysis_options;
 
+  // If not empty, the arguments of the client graphs the GraphExecutor loads
+  // are recorded in this file, as a ClientGraphSpecs proto. If the file exists
+  // when the GraphExecutor is created, the client graphs recorded in it are
+  // loaded in the background, so that the first requests using them after a
+  // restart don't wait for their compilation.
+  std::string client_graph_specs_path;
+
   // If true, the MLRT interpreter will be used instead of the BEF executor.
   // This option is experimental.
   bool enable_mlrt = false;
@@ -16,6 +16,7 @@ limitations under the License.
 
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -98,6 +99,7 @@ limitations under the License.
 #include "tensorflow/core/tfrt/utils/fallback_tensor.h"
 #include "tensorflow/core/tfrt/utils/tfrt_graph_execution_state.h"
 #include "tensorflow/core/tfrt/utils/utils.h"
+#include "tsl/platform/env.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/refcount.h"
 #include "tsl/platform/statusor.h"
@@ -530,10 +532,70 @@ absl::StatusOr<std::unique_ptr<GraphExecutor>> GraphExecutor::Create(
                       TfrtGraphExecutionState::Create(
                           graph_execution_state_options, std::move(graph_def),
                           *fallback_state, runtime_config));
-  return std::make_unique<GraphExecutor>(
+  auto graph_executor = std::make_unique<GraphExecutor>(
       std::move(options), std::move(fallback_state),
       std::move(resource_context), std::move(graph_execution_state),
       std::move(kernel_registry));
+  graph_executor->StartPreloadingClientGraphs();
+  return graph_executor;
+}
+
+void GraphExecutor::RecordClientGraphSpec(ClientGraphSpec spec) {
+  *client_graph_specs_.add_specs() = std::move(spec);
+  absl::Status status =
+      tsl::WriteBinaryProto(tsl::Env::Default(),
+                            options_.client_graph_specs_path,
+                            client_graph_specs_);
+  if (!status.ok()) {
+    LOG(WARNING) << "Failed to write the client graph specs to "
+                 << options_.client_graph_specs_path << ": " << status;
+  }
+}
+
+void GraphExecutor::StartPreloadingClientGraphs() {
+  const std::string& path = options_.client_graph_specs_path;
+  if (path.empty() || !tsl::Env::Default()->FileExists(path).ok()) return;
+  ClientGraphSpecs specs;
+  if (absl::Status status =
+          tsl::ReadBinaryProto(tsl::Env::Default(), path, &specs);
+      !status.ok()) {
+    LOG(WARNING) << "Failed to read the client graph specs from " << path
+                 << ": " << status;
+    return;
+  }
+  client_graph_preloading_thread_.reset(tsl::Env::Default()->StartThread(
+      tsl::ThreadOptions(), "tfrt_client_graph_preloading",
+      [this, specs = std::move(specs)]() {
+        for (const ClientGraphSpec& spec : specs.specs()) {
+          const std::vector<std::string> input_tensor_names(
+              spec.input_tensor_names().begin(),
+              spec.input_tensor_names().end());
+          std::vector<tensorflow::DataType> input_tensor_dtypes;
+          input_tensor_dtypes.reserve(spec.input_tensor_dtypes_size());
+          for (int dtype : spec.input_tensor_dtypes()) {
+            input_tensor_dtypes.push_back(
+                static_cast<tensorflow::DataType>(dtype));
+          }
+          const std::vector<std::string> output_tensor_names(
+              spec.output_tensor_names().begin(),
+              spec.output_tensor_names().end());
+          const std::vector<std::string> target_tensor_names(
+              spec.target_tensor_names().begin(),
+              spec.target_tensor_names().end());
+          RunOptions run_options;
+          run_options.name = spec.name();
+          absl::Status status =
+              GetOrCreateLoadedClientGraph(
+                  run_options, input_tensor_names, input_tensor_dtypes,
+                  output_tensor_names, target_tensor_names,
+                  /*work_queue=*/nullptr, spec.graph_name())
+                  .status();
+          if (!status.ok()) {
+            LOG(WARNING) << "Failed to preload the client graph "
+                         << spec.DebugString() << ": " << status;
+          }
+        }
+      }));
 }
 
 namespace {
@@ -656,7 +718,8 @@ absl::Status GraphExecutor::Run(
       &req_deadline_tracker_, loaded_client_graph.stream_callback_id(),
       cost_recorder));
 
-  if (do_recompilation) {
+  if (do_recompilation &&
+      loaded_client_graph.CostsChangedSinceCompilation(*cost_recorder)) {
     TF_RETURN_IF_ERROR(
         loaded_client_graph.UpdateCost(*cost_recorder, runtime()));
     tensorflow::mutex_lock l(num_recompilations_mu_);
@@ -986,6 +1049,23 @@ GraphExecutor::GetOrCreateLoadedClientGraph(
   TF_ASSIGN_OR_RETURN(auto loaded_client_graph,
                       LoadClientGraph(client_graph, work_queue, inputs));
 
+  // A restore graph can only be loaded with its checkpoint path input.
+  if (!options_.client_graph_specs_path.empty() &&
+      !loaded_client_graph->is_restore()) {
+    ClientGraphSpec spec;
+    spec.set_graph_name(std::string(graph_name));
+    spec.set_name(run_options.name);
+    spec.mutable_input_tensor_names()->Add(input_tensor_names.begin(),
+                                           input_tensor_names.end());
+    spec.mutable_input_tensor_dtypes()->Add(input_tensor_dtypes.begin(),
+                                            input_tensor_dtypes.end());
+    spec.mutable_output_tensor_names()->Add(output_tensor_names.begin(),
+                                            output_tensor_names.end());
+    spec.mutable_target_tensor_names()->Add(target_tensor_names.begin(),
+                                            target_tensor_names.end());
+    RecordClientGraphSpec(std::move(spec));
+  }
+
   // Store the new loaded client graph in cache and return.
   auto* loaded_client_graph_ptr = loaded_client_graph.get();
   loaded_client_graphs_[joined_name] = std::move(loaded_client_graph);
@@ -1060,10 +1140,34 @@ CostRecorder* GraphExecutor::LoadedClientGraph::MaybeGetCostRecorder(
   return nullptr;
 }
 
+bool GraphExecutor::LoadedClientGraph::CostsChangedSinceCompilation(
+    const CostRecorder& cost_recorder) const {
+  const double min_relative_cost_change =
+      graph_executor_->options()
+          .cost_analysis_options.min_relative_cost_change;
+  const auto& compiled_costs = cost_analysis_data_.compiled_costs;
+  if (min_relative_cost_change <= 0 || !compiled_costs.has_value()) {
+    return true;
+  }
+  for (const auto& [op_key, cost] : cost_recorder.GetAverageCosts()) {
+    const auto iter = compiled_costs->find(op_key);
+    if (iter == compiled_costs->end()) return true;
+    const double compiled_cost = std::max<uint64_t>(iter->second, 1);
+    if (std::abs(static_cast<double>(cost) - compiled_cost) >=
+        min_relative_cost_change * compiled_cost) {
+      return true;
+    }
+  }
+  VLOG(1) << "TFRT skipping the recompilation of loaded client graph (" << this
+          << ") " << name_ << " as its op costs didn't change";
+  return false;
+}
+
 absl::Status GraphExecutor::LoadedClientGraph::UpdateCost(
     const CostRecorder& cost_recorder, const Runtime& runtime) {
   LOG(INFO) << "TFRT updating op costs of loaded client graph (" << this << ") "
             << name_;
+  cost_analysis_data_.compiled_costs = cost_recorder.GetAverageCosts();
   std::shared_ptr<ExecutableContext> new_executable_context = nullptr;
   if (executable_context()->IsForMlrt()) {
     auto tf_mlir_with_op_keys = ::mlir::OwningOpRef<mlir::ModuleOp>(
@@ -15,6 +15,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_TFRT_GRAPH_EXECUTOR_GRAPH_EXECUTOR_H_
 #define TENSORFLOW_CORE_TFRT_GRAPH_EXECUTOR_GRAPH_EXECUTOR_H_
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -48,6 +49,7 @@ limitations under the License.
 #include "tensorflow/core/tfrt/fallback/cost_recorder.h"
 #include "tensorflow/core/tfrt/fallback/fallback_state.h"
 #include "tensorflow/core/tfrt/fallback/op_kernel_runner.h"
+#include "tensorflow/core/tfrt/graph_executor/client_graph_specs.pb.h"
 #include "tensorflow/core/tfrt/graph_executor/executable_context.h"
 #include "tensorflow/core/tfrt/graph_executor/graph_execution_options.h"
 #include "tensorflow/core/tfrt/graph_executor/sync_resource_state.h"
@@ -58,6 +60,7 @@ limitations under the License.
 #include "tensorflow/core/tfrt/runtime/stream.h"
 #include "tensorflow/core/tfrt/runtime/work_queue_interface.h"
 #include "tensorflow/core/tfrt/utils/tfrt_graph_execution_state.h"
+#include "tsl/platform/env.h"
 #include "tsl/platform/thread_annotations.h"
 #include "tfrt/bef/bef_buffer.h"  // from @tf_runtime
 #include "tfrt/bef_executor/bef_file.h"  // from @tf_runtime
@@ -170,6 +173,11 @@ class GraphExecutor {
     // `cost_recorder`.
     absl::Status UpdateCost(const CostRecorder& cost_recorder,
                             const Runtime& runtime);
+    // Returns false if the costs in `cost_recorder` are within
+    // `CostAnalysisOptions::min_relative_cost_change` of the ones the
+    // executable was last compiled with, in which case recompiling is
+    // unnecessary.
+    bool CostsChangedSinceCompilation(const CostRecorder& cost_recorder) const;
     // Updates `cost_analysis_data_` to make it accurate for the next execution.
     // Assumes a cost update occurred this cycle.
     void UpdateCostAnalysisData(absl::Time now, bool do_recompilation);
@@ -219,6 +227,9 @@ class GraphExecutor {
       absl::Time start_time TF_GUARDED_BY(mu) = absl::Now();
       // Cost recordings within the current measurement cycle.
       int num_cost_updates TF_GUARDED_BY(mu) = 0;
+      // The op costs the executable was last compiled with, if it was
+      // recompiled. Only accessed by the thread updating costs.
+      std::optional<absl::flat_hash_map<int64_t, uint64_t>> compiled_costs;
     };
     CostAnalysisData cost_analysis_data_;
 
@@ -344,6 +355,15 @@ class GraphExecutor {
 
   absl::Status InitBytecode(LoadedClientGraph* loaded_graph);
 
+  // Records `spec` in `client_graph_specs_` and writes them to
+  // `Options::client_graph_specs_path`.
+  void RecordClientGraphSpec(ClientGraphSpec spec)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(loaded_client_graphs_mu_);
+
+  // Starts loading the client graphs recorded in
+  // `Options::client_graph_specs_path`, if any, in the background.
+  void StartPreloadingClientGraphs();
+
   // Returns a `LoadedClientGraph` given input/output tensor info. If there is
   // no existing one yet, creates one first.
   absl::StatusOr<std::reference_wrapper<GraphExecutor::LoadedClientGraph>>
@@ -373,11 +393,18 @@ class GraphExecutor {
   absl::flat_hash_map<std::string /*joined_name*/,
                       std::unique_ptr<LoadedClientGraph>>
       loaded_client_graphs_ TF_GUARDED_BY(loaded_client_graphs_mu_);
+  // The arguments of the client graphs in `loaded_client_graphs_`, if they are
+  // recorded.
+  ClientGraphSpecs client_graph_specs_ TF_GUARDED_BY(loaded_client_graphs_mu_);
 
   std::unique_ptr<mlrt::KernelRegistry> kernel_registry_;
 
   std::unique_ptr<tfrt::ResourceContext> resource_context_;
 
+  // Loads the recorded client graphs. Joined before the members above are
+  // destroyed.
+  std::unique_ptr<tsl::Thread> client_graph_preloading_thread_;
+
  protected:
   // For testing basic Cost Analysis functionality.
   absl::Duration simulated_duration_ = absl::ZeroDuration();
@@ -24,7 +24,9 @@ limitations under the License.
 #include "learning/brain/experimental/tfrt/native_lowering/kernels/sync_fallback_kernels.h"
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/log/check.h"
 #include "absl/status/status.h"
+#include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "tensorflow/cc/framework/ops.h"
@@ -46,12 +48,15 @@ limitations under the License.
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/protobuf/rewriter_config.pb.h"
 #include "tensorflow/core/tfrt/fallback/fallback_state.h"
+#include "tensorflow/core/tfrt/graph_executor/client_graph_specs.pb.h"
 #include "tensorflow/core/tfrt/graph_executor/config.h"
 #include "tensorflow/core/tfrt/graph_executor/graph_execution_options.h"
 #include "tensorflow/core/tfrt/mlrt/interpreter/context.h"
 #include "tensorflow/core/tfrt/mlrt/interpreter/value.h"
 #include "tensorflow/core/tfrt/mlrt/kernel/kernel.h"
 #include "tensorflow/core/tfrt/saved_model/saved_model_testutil.h"
+#include "tsl/platform/env.h"
+#include "tsl/platform/path.h"
 #include "tsl/platform/statusor.h"
 #include "tfrt/cpp_tests/test_util.h"  // from @tf_runtime
 #include "tfrt/host_context/resource_context.h"  // from @tf_runtime
@@ -233,6 +238,53 @@ TEST_P(GraphExecutorTest, OnlineCostAnalysisEveryTime) {
   }
 }
 
+TEST_P(GraphExecutorTest, OnlineCostAnalysisSkipsRecompilationOfStableCosts) {
+  GraphDef graph_def;
+  TF_ASSERT_OK(GetSimpleGraphDef(graph_def));
+
+  auto runtime = DefaultTfrtRuntime(/*num_threads=*/1);
+  GraphExecutor::Options options(runtime.get());
+  options.cost_analysis_options.version =
+      GraphExecutionOptions::CostAnalysisOptions::kPeriodic;
+  options.cost_analysis_options.reset_interval = absl::ZeroDuration();
+  options.cost_analysis_options.updates_per_interval = 1;
+  // No cost moves by a factor of 1e9.
+  options.cost_analysis_options.min_relative_cost_change = 1e9;
+  options.enable_mlrt = GetParam();
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto fallback_state,
+      tensorflow::tfrt_stub::FallbackState::Create(
+          CreateDefaultSessionOptions(options), graph_def.library()));
+  auto resource_context = std::make_unique<tfrt::ResourceContext>();
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto graph_executor_base,
+      GraphExecutor::Create(std::move(options), std::move(fallback_state),
+                            std::move(resource_context), graph_def,
+                            GetKernelRegistry()));
+  auto graph_executor = std::unique_ptr<GraphExecutorForTestingCostAnalysis>(
+      static_cast<GraphExecutorForTestingCostAnalysis*>(
+          graph_executor_base.release()));
+
+  // Set input 'x' to [[1, 1, 1]]
+  std::vector<std::pair<std::string, tensorflow::Tensor>> inputs;
+  inputs.push_back({"input", CreateTfTensor<int32_t>(
+                                 /*shape=*/{1, 3}, /*data=*/{1, 1, 1})});
+
+  std::vector<tensorflow::Tensor> outputs;
+
+  // Only the first reset recompiles.
+  for (int i = 0; i < 10; ++i) {
+    TF_ASSERT_OK(graph_executor->Run(/*run_options=*/{}, inputs,
+                                     /*output_tensor_names=*/{"rank"},
+                                     /*target_tensor_names=*/{}, &outputs));
+    ASSERT_EQ(outputs.size(), 1);
+    EXPECT_THAT(GetTfTensorData<int32_t>(outputs[0]),
+                ::testing::ElementsAreArray({2}));
+    EXPECT_EQ(graph_executor->num_recompilations(), 1);
+  }
+}
+
 TEST_P(GraphExecutorTest, OnlineCostAnalysisDisabled) {
   GraphDef graph_def;
   TF_ASSERT_OK(GetSimpleGraphDef(graph_def));
@@ -554,6 +606,66 @@ TEST_F(GraphExecutorTest, DisableCompilation) {
               ::testing::ElementsAreArray({2}));
 }
 
+TEST_F(GraphExecutorTest, PreloadsRecordedClientGraphs) {
+  GraphDef graph_def;
+  TF_ASSERT_OK(GetSimpleGraphDef(graph_def));
+
+  auto runtime = DefaultTfrtRuntime(/*num_threads=*/1);
+  const std::string client_graph_specs_path =
+      tsl::io::JoinPath(testing::TmpDir(), "client_graph_specs.pb");
+  tsl::Env::Default()->DeleteFile(client_graph_specs_path).IgnoreError();
+  auto create_graph_executor = [&]() {
+    GraphExecutor::Options options(runtime.get());
+    options.client_graph_specs_path = client_graph_specs_path;
+    auto fallback_state = tensorflow::tfrt_stub::FallbackState::Create(
+        CreateDefaultSessionOptions(options), graph_def.library());
+    CHECK_OK(fallback_state.status());
+    return GraphExecutor::Create(
+        std::move(options), *std::move(fallback_state),
+        std::make_unique<tfrt::ResourceContext>(), graph_def,
+        GetKernelRegistry());
+  };
+
+  std::vector<std::pair<std::string, tensorflow::Tensor>> inputs;
+  inputs.push_back({"input", CreateTfTensor<int32_t>(
+                                 /*shape=*/{1, 3}, /*data=*/{1, 1, 1})});
+  std::vector<tensorflow::Tensor> outputs;
+
+  {
+    TF_ASSERT_OK_AND_ASSIGN(auto graph_executor, create_graph_executor());
+    TF_ASSERT_OK(graph_executor->Run(/*run_options=*/{}, inputs,
+                                     /*output_tensor_names=*/{"rank"},
+                                     /*target_tensor_names=*/{}, &outputs));
+  }
+
+  ClientGraphSpecs specs;
+  TF_ASSERT_OK(
+      tsl::ReadBinaryProto(tsl::Env::Default(), client_graph_specs_path,
+                           &specs));
+  ASSERT_EQ(specs.specs_size(), 1);
+  EXPECT_THAT(specs.specs(0).input_tensor_names(),
+              ::testing::ElementsAre("input"));
+  EXPECT_THAT(specs.specs(0).output_tensor_names(),
+              ::testing::ElementsAre("rank"));
+
+  // The next GraphExecutor loads the recorded client graph in the background,
+  // so that it eventually runs without compilation.
+  TF_ASSERT_OK_AND_ASSIGN(auto graph_executor, create_graph_executor());
+  GraphExecutor::RunOptions run_options;
+  run_options.disable_compilation = true;
+  absl::Status status;
+  for (int i = 0; i < 100; ++i) {
+    status = graph_executor->Run(run_options, inputs,
+                                 /*output_tensor_names=*/{"rank"},
+                                 /*target_tensor_names=*/{}, &outputs);
+    if (status.ok()) break;
+    absl::SleepFor(absl::Milliseconds(100));
+  }
+  TF_ASSERT_OK(status);
+  EXPECT_THAT(GetTfTensorData<int32_t>(outputs[0]),
+              ::testing::ElementsAreArray({2}));
+}
+
 TEST_F(GraphExecutorTest, SyncExecute) {
   GraphDef graph_def;
   TF_ASSERT_OK(GetSimpleGraphDef(graph_def));
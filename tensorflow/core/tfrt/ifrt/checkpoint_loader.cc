@@ -14,6 +14,8 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/tfrt/ifrt/checkpoint_loader.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -58,6 +60,7 @@ namespace ifrt_serving {
 
 namespace {
 
+// The number of shards restored concurrently.
 static constexpr int kNumRestoreClusters = 4;
 
 // A shard of variables to be restored.
@@ -191,16 +194,44 @@ void RunShardHelper(const tfrt_stub::OpKernelRunner& runner,
   }
 }
 
-absl::Status RunShard(RestoreVariableShard shard,
-                      IfrtRestoreTensorRegistry* ifrt_restore_tensor_registry,
-                      tfrt::ConcurrentWorkQueue* checkpoint_loader_work_queue,
-                      tf_mlrt::Context& context, bool use_async_restore) {
-  if (!ifrt_restore_tensor_registry) {
-    return absl::InternalError("ifrt_restore_tensor_registry must not be null");
-  }
-  if (!checkpoint_loader_work_queue) {
-    return absl::InternalError("checkpoint_loader_work_queue must not be null");
-  }
+// A shard whose restored tensors are registered in the
+// IfrtRestoreTensorRegistry, ready to be restored.
+struct PreparedRestoreShard {
+  tfrt_stub::OpKernelRunner runner;
+  std::unique_ptr<AsyncState> async_state;
+  RestoreVariableShard shard;
+};
+
+// Shards restored one after another on the checkpoint loader work queue.
+struct RestoreShardChain {
+  std::vector<PreparedRestoreShard> shards;
+  tensorflow::Context bg_context{tensorflow::ContextKind::kThread};
+};
+
+// Restores the shards of `chain` from `index` on, scheduling each one on
+// `work_queue` once the previous one is restored. The device transfers of the
+// restored variables are scheduled on the same queue: this keeps them from
+// being queued behind all of the remaining restores.
+void RunShardChain(std::shared_ptr<RestoreShardChain> chain, int index,
+                   tfrt::ConcurrentWorkQueue* work_queue) {
+  if (index >= chain->shards.size()) return;
+  work_queue->AddTask([chain = std::move(chain), index, work_queue]() mutable {
+    {
+      tensorflow::WithContext wc(chain->bg_context);
+      PreparedRestoreShard& prepared = chain->shards[index];
+      RunShardHelper(prepared.runner, prepared.async_state.get(),
+                     std::move(prepared.shard));
+      // The restored tensors are owned by the futures from now on.
+      prepared.async_state.reset();
+    }
+    RunShardChain(std::move(chain), index + 1, work_queue);
+  });
+}
+
+absl::StatusOr<PreparedRestoreShard> PrepareShard(
+    RestoreVariableShard shard,
+    IfrtRestoreTensorRegistry* ifrt_restore_tensor_registry,
+    tf_mlrt::Context& context) {
   const int num_outputs = shard.var_handles.size();
   DCHECK_EQ(num_outputs, shard.tensor_names.NumElements());
   auto& fallback_request_state = context.fallback_request_state();
@@ -271,25 +302,13 @@ absl::Status RunShard(RestoreVariableShard shard,
     }
     async_state->results.push_back(std::move(promise));
   }
-  // Run the shard synchronously.
-  if (!use_async_restore) {
-    RunShardHelper(runner, async_state.get(), shard);
-  } else {
-    tensorflow::Context bg_context(tensorflow::ContextKind::kThread);
-    // Use dedicated work queue for restore operation.
-    checkpoint_loader_work_queue->AddTask(
-        [runner = std::move(runner), async_state = std::move(async_state),
-         shard = std::move(shard), bg_context = std::move(bg_context)]() {
-          tensorflow::WithContext wc(bg_context);
-          RunShardHelper(runner, async_state.get(), shard);
-        });
-  }
-
-  return absl::OkStatus();
+  return PreparedRestoreShard{.runner = std::move(runner),
+                              .async_state = std::move(async_state),
+                              .shard = std::move(shard)};
 }
 
 int64_t GetSizeFromVarHandle(const ResourceHandle& handle) {
-  int size = 0;
+  int64_t size = 0;
   for (auto& dtype_and_shape : handle.dtypes_and_shapes()) {
     size += DataTypeSize(dtype_and_shape.dtype) *
             dtype_and_shape.shape.num_elements();
@@ -311,15 +330,28 @@ absl::Status CheckpointLoader::Load(
     const tensorflow::tfrt_stub::FallbackTensor& shape_and_slices,
     absl::Span<const tensorflow::DataType> restored_dtypes,
     const std::vector<bool>& truncate_in_cast, tf_mlrt::Context& context) {
+  if (!ifrt_restore_tensor_registry_) {
+    return absl::InternalError("ifrt_restore_tensor_registry must not be null");
+  }
+  if (!checkpoint_loader_work_queue_) {
+    return absl::InternalError("checkpoint_loader_work_queue must not be null");
+  }
+
   std::vector<int64_t> variable_sizes;
   variable_sizes.reserve(var_handles.size());
+  int64_t total_size = 0;
   for (auto& handle : var_handles) {
     variable_sizes.push_back(GetSizeFromVarHandle(
         handle.tensor().scalar<tensorflow::ResourceHandle>()()));
+    total_size += variable_sizes.back();
   }
 
+  const int64_t num_shards = std::max<int64_t>(
+      kNumRestoreClusters,
+      (total_size + max_restore_shard_bytes_ - 1) / max_restore_shard_bytes_);
   std::vector<std::vector<int>> sharded_indices = tf_mlrt::ShardVariables(
-      kNumRestoreClusters, absl::MakeSpan(variable_sizes));
+      std::min<int64_t>(num_shards, std::max<size_t>(var_handles.size(), 1)),
+      absl::MakeSpan(variable_sizes));
 
   // Converts the names and slices back to the tensor.
   auto vector_to_tensor = [](const std::vector<tsl::tstring>& vec) {
@@ -359,10 +391,46 @@ absl::Status CheckpointLoader::Load(
     shard.shape_and_slices = vector_to_tensor(shape_and_slices);
     shards.push_back(std::move(shard));
   }
-  for (const auto& shard : shards) {
-    TF_RETURN_IF_ERROR(RunShard(shard, ifrt_restore_tensor_registry_,
-                                checkpoint_loader_work_queue_, context,
-                                use_async_restore_));
+
+  // Register the restored tensors of all shards before restoring any.
+  std::vector<PreparedRestoreShard> prepared_shards;
+  prepared_shards.reserve(shards.size());
+  for (auto& shard : shards) {
+    absl::StatusOr<PreparedRestoreShard> prepared_shard =
+        PrepareShard(std::move(shard), ifrt_restore_tensor_registry_, context);
+    if (!prepared_shard.ok()) {
+      // Unblock the waiters on the tensors of the shards already registered.
+      for (auto& prepared : prepared_shards) {
+        for (auto& result : prepared.async_state->results) {
+          std::move(result).Set(prepared_shard.status());
+        }
+      }
+      return prepared_shard.status();
+    }
+    prepared_shards.push_back(*std::move(prepared_shard));
+  }
+
+  // Run the shards synchronously.
+  if (!use_async_restore_) {
+    for (auto& prepared : prepared_shards) {
+      RunShardHelper(prepared.runner, prepared.async_state.get(),
+                     std::move(prepared.shard));
+    }
+    return absl::OkStatus();
+  }
+
+  // Use dedicated work queue for restore operation, with up to
+  // `kNumRestoreClusters` shards being restored at a time.
+  std::vector<std::shared_ptr<RestoreShardChain>> chains;
+  for (int i = 0; i < prepared_shards.size(); ++i) {
+    if (i < kNumRestoreClusters) {
+      chains.push_back(std::make_shared<RestoreShardChain>());
+    }
+    chains[i % kNumRestoreClusters]->shards.push_back(
+        std::move(prepared_shards[i]));
+  }
+  for (auto& chain : chains) {
+    RunShardChain(std::move(chain), /*index=*/0, checkpoint_loader_work_queue_);
   }
   return absl::OkStatus();
 }
@@ -15,6 +15,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_TFRT_IFRT_CHECKPOINT_LOADER_H_
 #define TENSORFLOW_CORE_TFRT_IFRT_CHECKPOINT_LOADER_H_
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -41,6 +42,13 @@ namespace ifrt_serving {
 // Implement the `CheckpointLoaderInterface` by using RestoreV2.
 class CheckpointLoader {
  public:
+  // The default maximum size of the variables restored by one RestoreV2, unless
+  // there are fewer shards than concurrently restored ones. Once a shard is
+  // restored, its variables can be transferred to devices while the next
+  // shards are being read, so smaller shards overlap more of the reads with
+  // the transfers.
+  static constexpr int64_t kDefaultMaxRestoreShardBytes = 128 << 20;
+
   struct PrepareRestoreArgs {
     mlir::MLIRContext* context;
     tensorflow::MetaGraphDef meta_graph_def;
@@ -52,10 +60,12 @@ class CheckpointLoader {
   explicit CheckpointLoader(
       IfrtRestoreTensorRegistry* ifrt_restore_tensor_registry,
       tfrt::ConcurrentWorkQueue* checkpoint_loader_work_queue,
-      bool use_async_restore = true)
+      bool use_async_restore = true,
+      int64_t max_restore_shard_bytes = kDefaultMaxRestoreShardBytes)
       : ifrt_restore_tensor_registry_(ifrt_restore_tensor_registry),
         checkpoint_loader_work_queue_(checkpoint_loader_work_queue),
-        use_async_restore_(use_async_restore) {}
+        use_async_restore_(use_async_restore),
+        max_restore_shard_bytes_(max_restore_shard_bytes) {}
   virtual ~CheckpointLoader() = default;
 
   // Called before `Load` to do some preparation work.
@@ -75,6 +85,7 @@ class CheckpointLoader {
   IfrtRestoreTensorRegistry* ifrt_restore_tensor_registry_;
   tfrt::ConcurrentWorkQueue* checkpoint_loader_work_queue_;
   bool use_async_restore_ = true;
+  int64_t max_restore_shard_bytes_ = kDefaultMaxRestoreShardBytes;
 };
 
 }  // namespace ifrt_serving
@@ -0,0 +1,200 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/tfrt/ifrt/checkpoint_loader.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "tensorflow/compiler/mlir/tfrt/transforms/ifrt/ifrt_types.h"
+#include "xla/python/ifrt/future.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "tensorflow/core/framework/function.pb.h"
+#include "tensorflow/core/framework/resource_handle.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_matcher.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/platform/resource_loader.h"
+#include "tensorflow/core/public/session_options.h"
+#include "tensorflow/core/runtime_fallback/kernel/kernel_fallback_compat_request_state.h"
+#include "tensorflow/core/tfrt/fallback/fallback_state.h"
+#include "tensorflow/core/tfrt/fallback/op_kernel_runner.h"
+#include "tensorflow/core/tfrt/ifrt/ifrt_restore_tensor_registry.h"
+#include "tensorflow/core/tfrt/mlrt/kernel/context.h"
+#include "tensorflow/core/tfrt/utils/fallback_tensor.h"
+#include "tsl/platform/status_matchers.h"
+#include "tsl/platform/statusor.h"
+#include "tsl/platform/tstring.h"
+#include "tfrt/host_context/concurrent_work_queue.h"  // from @tf_runtime
+#include "tfrt/host_context/resource_context.h"  // from @tf_runtime
+
+namespace tensorflow {
+namespace ifrt_serving {
+namespace {
+
+using ::tensorflow::test::AsTensor;
+using ::tensorflow::test::TensorEq;
+using ::tsl::testing::StatusIs;
+
+constexpr int kNumVariables = 6;
+
+// The values of the variables "w", "w1", "w2" and "w3" in the checkpoint.
+const std::vector<std::vector<int32_t>>& CheckpointValues() {
+  static const auto* values = new std::vector<std::vector<int32_t>>{
+      {1, 2, 3}, {4, 5, 6}, {7, 8, 9}, {10, 11, 12}};
+  return *values;
+}
+
+std::string CheckpointName(int i) {
+  return i == 0 ? "w/.ATTRIBUTES/VARIABLE_VALUE"
+                : absl::StrCat("w", i, "/.ATTRIBUTES/VARIABLE_VALUE");
+}
+
+std::string RuntimeName(int i) { return absl::StrCat("test__y", i); }
+
+tfrt_stub::FallbackTensor VarHandle(int i, int64_t num_elements) {
+  ResourceHandle handle;
+  handle.set_container("test");
+  handle.set_name(absl::StrCat("y", i));
+  handle.set_dtypes_and_shapes({DtypeAndPartialTensorShape{
+      DT_INT32, PartialTensorShape({num_elements})}});
+  Tensor tensor(DT_RESOURCE, TensorShape({}));
+  tensor.scalar<ResourceHandle>()() = std::move(handle);
+  return tfrt_stub::FallbackTensor(std::move(tensor));
+}
+
+// Restores the variables "y<i>" from the checkpoint variables
+// "w<i % 4>". The checkpoint variables are int32 vectors of 3 elements.
+class CheckpointLoaderTest : public ::testing::TestWithParam<bool> {
+ protected:
+  void SetUp() override {
+    restore_work_queue_ = tfrt::CreateMultiThreadedWorkQueue(
+        /*num_threads=*/4, /*num_blocking_threads=*/4);
+    TF_ASSERT_OK_AND_ASSIGN(fallback_state_, tfrt_stub::FallbackState::Create(
+                                                 session_options_, fdef_lib_));
+    runner_ = [](const std::function<void()>& f) { f(); };
+    fallback_request_state_ =
+        std::make_unique<tfd::KernelFallbackCompatRequestState>(
+            &runner_, &fallback_state_->device_manager(), /*step_id=*/0,
+            &runner_table_, &resource_array_,
+            /*user_intra_op_threadpool=*/nullptr,
+            /*model_metadata=*/std::nullopt,
+            &fallback_state_->process_function_library_runtime());
+    context_ = std::make_unique<tf_mlrt::Context>(
+        fallback_request_state_.get(), &resource_context_);
+  }
+
+  // Loads `var_handles` with a loader whose shards hold up to
+  // `max_restore_shard_bytes`.
+  absl::Status Load(const std::vector<tfrt_stub::FallbackTensor>& var_handles,
+                    int64_t max_restore_shard_bytes) {
+    CheckpointLoader loader(&registry_, restore_work_queue_.get(),
+                            /*use_async_restore=*/GetParam(),
+                            max_restore_shard_bytes);
+    const std::string prefix =
+        GetDataDependencyFilepath(
+            "tensorflow/core/tfrt/mlrt/kernel/testdata/"
+            "gen_checkpoint_data/variables") +
+        "/variables";
+    Tensor names(DT_STRING, TensorShape({kNumVariables}));
+    Tensor slices(DT_STRING, TensorShape({kNumVariables}));
+    for (int i = 0; i < kNumVariables; ++i) {
+      names.flat<tsl::tstring>()(i) = CheckpointName(i % 4);
+      slices.flat<tsl::tstring>()(i) = "";
+    }
+    return loader.Load(
+        tfrt_stub::FallbackTensor(AsTensor<tsl::tstring>({prefix})),
+        var_handles, tfrt_stub::FallbackTensor(std::move(names)),
+        tfrt_stub::FallbackTensor(std::move(slices)),
+        std::vector<DataType>(kNumVariables, DT_INT32),
+        std::vector<bool>(kNumVariables, false), *context_);
+  }
+
+  std::unique_ptr<tfrt::ConcurrentWorkQueue> restore_work_queue_;
+  tensorflow::SessionOptions session_options_;
+  tensorflow::FunctionDefLibrary fdef_lib_;
+  std::function<void(std::function<void()>)> runner_;
+  tfrt_stub::OpKernelRunnerTable runner_table_;
+  tfd::FallbackResourceArray resource_array_;
+  std::unique_ptr<tfrt_stub::FallbackState> fallback_state_;
+  std::unique_ptr<tfd::KernelFallbackCompatRequestState>
+      fallback_request_state_;
+  tfrt::ResourceContext resource_context_;
+  std::unique_ptr<tf_mlrt::Context> context_;
+  IfrtRestoreTensorRegistry registry_;
+};
+
+TEST_P(CheckpointLoaderTest, MoreShardsThanClusters) {
+  std::vector<tfrt_stub::FallbackTensor> var_handles;
+  for (int i = 0; i < kNumVariables; ++i) {
+    var_handles.push_back(VarHandle(i, /*num_elements=*/3));
+  }
+  // One variable per shard.
+  TF_ASSERT_OK(Load(var_handles, /*max_restore_shard_bytes=*/12));
+
+  for (int i = 0; i < kNumVariables; ++i) {
+    absl::StatusOr<Tensor> restored =
+        registry_.GetRestoredTensor(RuntimeName(i)).Await();
+    TF_ASSERT_OK(restored.status());
+    EXPECT_THAT(*restored,
+                TensorEq(AsTensor<int32_t>(CheckpointValues()[i % 4], {3})));
+  }
+}
+
+TEST_P(CheckpointLoaderTest, PrepareFailureSetsRegisteredFutures) {
+  // Variable i has i + 1 elements, and is alone in the i-th shard, since
+  // shards are ordered by increasing size.
+  std::vector<tfrt_stub::FallbackTensor> var_handles;
+  for (int i = 0; i < kNumVariables; ++i) {
+    var_handles.push_back(VarHandle(i, /*num_elements=*/i + 1));
+  }
+  // Registering the variable of the last shard fails.
+  auto promise = xla::ifrt::Future<Tensor>::CreatePromise();
+  TF_ASSERT_OK(registry_.TryRegister(
+      RuntimeName(kNumVariables - 1),
+      IfrtRestoreTensorRegistry::RestoredTensorInfo{
+          /*used_by_host=*/false,
+          DtypeAndShape{DT_INT32, TensorShape({kNumVariables})},
+          xla::ifrt::Future<Tensor>(promise)}));
+
+  EXPECT_THAT(Load(var_handles, /*max_restore_shard_bytes=*/1),
+              StatusIs(absl::StatusCode::kAlreadyExists));
+  for (int i = 0; i < kNumVariables - 1; ++i) {
+    xla::ifrt::Future<Tensor> future =
+        registry_.GetRestoredTensor(RuntimeName(i));
+    ASSERT_TRUE(future.IsReady()) << i;
+    EXPECT_THAT(future.Await().status(),
+                StatusIs(absl::StatusCode::kAlreadyExists))
+        << i;
+  }
+  promise.Set(AsTensor<int32_t>({0}));
+}
+
+INSTANTIATE_TEST_SUITE_P(CheckpointLoaderTest, CheckpointLoaderTest,
+                         ::testing::Bool());
+
+}  // namespace
+}  // namespace ifrt_serving
+}  // namespace tensorflow
@@ -0,0 +1,181 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/tfrt/ifrt/ifrt_file_compilation_cache.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "llvm/Support/raw_ostream.h"
+#include "mlir/IR/BuiltinOps.h"  // from @llvm-project
+#include "mlir/IR/OperationSupport.h"  // from @llvm-project
+#include "xla/pjrt/compile_options.pb.h"
+#include "xla/pjrt/pjrt_executable.h"
+#include "xla/python/ifrt/client.h"
+#include "xla/python/ifrt/compiler.h"
+#include "xla/python/ifrt/device.h"
+#include "xla/python/ifrt/device_list.h"
+#include "xla/python/ifrt/executable.h"
+#include "xla/python/ifrt/hlo/hlo_program.h"
+#include "xla/python/ifrt/host_callback.h"
+#include "xla/python/ifrt/program.h"
+#include "xla/python/pjrt_ifrt/xla_compiler.h"
+#include "xla/tsl/concurrency/ref_count.h"
+#include "xla/tsl/lib/strings/proto_serialization.h"
+#include "tsl/platform/env.h"
+#include "tsl/platform/errors.h"
+#include "tsl/platform/fingerprint.h"
+#include "tsl/platform/path.h"
+#include "tsl/platform/statusor.h"
+
+namespace tensorflow {
+namespace ifrt_serving {
+
+namespace {
+
+// Appends `value` to `key`, prefixed with its length so that the
+// concatenation of the fields of a key is unambiguous.
+void AppendKeyField(absl::string_view value, std::string* key) {
+  absl::StrAppend(key, value.size(), ":", value);
+}
+
+}  // namespace
+
+absl::StatusOr<std::string> IfrtFileCompilationCache::GetExecutableKey(
+    const xla::ifrt::HloProgram& hlo_program,
+    const xla::ifrt::DeviceList& device_list,
+    const xla::CompileOptions& xla_compile_options,
+    const xla::ifrt::Client& client) {
+  std::string key;
+
+  std::string module_str;
+  llvm::raw_string_ostream os(module_str);
+  mlir::ModuleOp module = hlo_program.mlir_module;
+  module.print(os, mlir::OpPrintingFlags().enableDebugInfo(false));
+  os.flush();
+  AppendKeyField(module_str, &key);
+
+  TF_ASSIGN_OR_RETURN(xla::CompileOptionsProto compile_options_proto,
+                      xla_compile_options.ToProto());
+  std::string compile_options_str;
+  if (!tsl::SerializeToStringDeterministic(compile_options_proto,
+                                           &compile_options_str)) {
+    return absl::InternalError("Failed to serialize the compile options");
+  }
+  AppendKeyField(compile_options_str, &key);
+
+  std::string devices_str;
+  for (const xla::ifrt::Device* device : device_list.devices()) {
+    absl::StrAppend(&devices_str, device->Id().value(), ":", device->Kind(),
+                    ",");
+  }
+  AppendKeyField(devices_str, &key);
+
+  AppendKeyField(client.platform_name(), &key);
+  AppendKeyField(client.platform_version(), &key);
+
+  const tsl::Fprint128 fingerprint = tsl::Fingerprint128(key);
+  return absl::StrCat(absl::Hex(fingerprint.high64, absl::kZeroPad16),
+                      absl::Hex(fingerprint.low64, absl::kZeroPad16));
+}
+
+absl::Status IfrtFileCompilationCache::WriteExecutable(
+    const std::string& dir, const std::string& filename,
+    const std::string& serialized) {
+  TF_RETURN_IF_ERROR(env_->RecursivelyCreateDir(dir));
+  const std::string path = tsl::io::JoinPath(dir, filename);
+  std::string tmp_path = absl::StrCat(path, ".tmp");
+  if (!env_->CreateUniqueFileName(&tmp_path, "")) {
+    return absl::InternalError(
+        absl::StrCat("Failed to create a temporary file name for ", path));
+  }
+  TF_RETURN_IF_ERROR(tsl::WriteStringToFile(env_, tmp_path, serialized));
+  return env_->RenameFile(tmp_path, path);
+}
+
+absl::StatusOr<std::unique_ptr<xla::ifrt::LoadedExecutable>>
+IfrtFileCompilationCache::LookupLoadedExecutableOrCreate(
+    std::unique_ptr<xla::ifrt::HloProgram> hlo_program,
+    tsl::RCReference<xla::ifrt::DeviceList> device_list,
+    const xla::CompileOptions& xla_compile_options,
+    const std::vector<tsl::RCReference<xla::ifrt::LoadedHostCallback>>&
+        loaded_host_callbacks,
+    xla::ifrt::Client* client,
+    absl::AnyInvocable<
+        absl::StatusOr<std::unique_ptr<xla::ifrt::LoadedExecutable>>(
+            std::unique_ptr<xla::ifrt::Program> program,
+            std::unique_ptr<xla::ifrt::CompileOptions> options)>
+        value_fn) {
+  TF_ASSIGN_OR_RETURN(const std::string key,
+                      GetExecutableKey(*hlo_program, *device_list,
+                                       xla_compile_options, *client));
+  const std::string filename = absl::StrCat(key, ".executable");
+
+  for (size_t i = 0; i < cache_dirs_.size(); ++i) {
+    const std::string path = tsl::io::JoinPath(cache_dirs_[i], filename);
+    std::string serialized;
+    if (!tsl::ReadFileToString(env_, path, &serialized).ok()) continue;
+    absl::StatusOr<std::unique_ptr<xla::ifrt::LoadedExecutable>> executable =
+        client->GetDefaultCompiler()->DeserializeLoadedExecutable(
+            serialized,
+            std::make_unique<xla::ifrt::XlaDeserializeExecutableOptions>(
+                xla_compile_options, loaded_host_callbacks));
+    if (!executable.ok()) {
+      LOG(WARNING) << "Failed to load the cached executable " << path << ": "
+                   << executable.status();
+      continue;
+    }
+    VLOG(1) << "Loaded the cached executable " << path;
+    for (size_t j = 0; j < i; ++j) {
+      absl::Status status =
+          WriteExecutable(cache_dirs_[j], filename, serialized);
+      if (!status.ok()) {
+        LOG(WARNING) << "Failed to copy the cached executable " << path
+                     << " to " << cache_dirs_[j] << ": " << status;
+      }
+    }
+    return executable;
+  }
+
+  TF_ASSIGN_OR_RETURN(
+      std::unique_ptr<xla::ifrt::LoadedExecutable> executable,
+      value_fn(std::move(hlo_program),
+               std::make_unique<xla::ifrt::XlaCompileOptions>(
+                   xla_compile_options, loaded_host_callbacks)));
+  absl::StatusOr<std::string> serialized = executable->Serialize();
+  if (!serialized.ok()) {
+    LOG(WARNING) << "Failed to serialize the executable " << filename
+                 << " for caching: " << serialized.status();
+    return executable;
+  }
+  for (const std::string& dir : cache_dirs_) {
+    absl::Status status = WriteExecutable(dir, filename, *serialized);
+    if (!status.ok()) {
+      LOG(WARNING) << "Failed to write the executable " << filename << " to "
+                   << dir << ": " << status;
+    }
+  }
+  return executable;
+}
+
+}  // namespace ifrt_serving
+}  // namespace tensorflow
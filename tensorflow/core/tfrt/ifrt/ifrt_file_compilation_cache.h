@@ -0,0 +1,95 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_TFRT_IFRT_IFRT_FILE_COMPILATION_CACHE_H_
+#define TENSORFLOW_CORE_TFRT_IFRT_IFRT_FILE_COMPILATION_CACHE_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/status/statusor.h"
+#include "tensorflow/core/tfrt/ifrt/ifrt_persistent_compilation_cache.h"
+#include "xla/pjrt/pjrt_executable.h"
+#include "xla/python/ifrt/client.h"
+#include "xla/python/ifrt/device_list.h"
+#include "xla/python/ifrt/executable.h"
+#include "xla/python/ifrt/hlo/hlo_program.h"
+#include "xla/python/ifrt/host_callback.h"
+#include "xla/python/ifrt/program.h"
+#include "xla/tsl/concurrency/ref_count.h"
+#include "tsl/platform/env.h"
+
+namespace tensorflow {
+namespace ifrt_serving {
+
+// An IfrtPersistentCompilationCache storing serialized executables as files in
+// a list of directories, e.g. a local disk directory followed by a directory
+// of a distributed file system shared by the hosts serving a model.
+//
+// An executable is looked up in the directories in order, and copied to the
+// directories preceding the one it is found in. When it is found in none, it is
+// compiled and written to all of them, so that the other hosts sharing a
+// directory load it instead of compiling it.
+//
+// The key of an executable is a fingerprint of the HLO program (which includes
+// its shardings), the compile options, the devices it is compiled for, and the
+// platform name and version of the client (which identify the compiler).
+class IfrtFileCompilationCache : public IfrtPersistentCompilationCache {
+ public:
+  explicit IfrtFileCompilationCache(std::vector<std::string> cache_dirs,
+                                    tsl::Env* env = tsl::Env::Default())
+      : cache_dirs_(std::move(cache_dirs)), env_(env) {}
+
+  absl::StatusOr<std::unique_ptr<xla::ifrt::LoadedExecutable>>
+  LookupLoadedExecutableOrCreate(
+      std::unique_ptr<xla::ifrt::HloProgram> hlo_program,
+      tsl::RCReference<xla::ifrt::DeviceList> device_list,
+      const xla::CompileOptions& xla_compile_options,
+      const std::vector<tsl::RCReference<xla::ifrt::LoadedHostCallback>>&
+          loaded_host_callbacks,
+      xla::ifrt::Client* client,
+      absl::AnyInvocable<
+          absl::StatusOr<std::unique_ptr<xla::ifrt::LoadedExecutable>>(
+              std::unique_ptr<xla::ifrt::Program> program,
+              std::unique_ptr<xla::ifrt::CompileOptions> options)>
+          value_fn) override;
+
+  bool IsXlaCompilationCacheEnabled() const override { return true; }
+
+  // Returns the key of the executable compiled from `hlo_program` with
+  // `xla_compile_options` for `device_list` of `client`.
+  static absl::StatusOr<std::string> GetExecutableKey(
+      const xla::ifrt::HloProgram& hlo_program,
+      const xla::ifrt::DeviceList& device_list,
+      const xla::CompileOptions& xla_compile_options,
+      const xla::ifrt::Client& client);
+
+ private:
+  // Writes `serialized` to the file `filename` of `dir`. The file is renamed
+  // into place, so that concurrent readers never see a partial executable.
+  absl::Status WriteExecutable(const std::string& dir,
+                               const std::string& filename,
+                               const std::string& serialized);
+
+  const std::vector<std::string> cache_dirs_;
+  tsl::Env* const env_;
+};
+
+}  // namespace ifrt_serving
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_TFRT_IFRT_IFRT_FILE_COMPILATION_CACHE_H_
@@ -0,0 +1,100 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/tfrt/ifrt/ifrt_file_compilation_cache.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
+#include "xla/tsl/framework/serving_device_selector.h"
+#include "xla/tsl/framework/test_util/mock_serving_device_selector.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_matcher.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/tfrt/ifrt/ifrt_serving_executable_test_util.h"
+#include "tsl/platform/env.h"
+#include "tsl/platform/path.h"
+#include "tsl/platform/statusor.h"
+
+namespace tensorflow {
+namespace ifrt_serving {
+namespace {
+
+using tensorflow::ifrt_serving::test_utils::GetMlirModulePath;
+using ::tensorflow::test::AsTensor;
+using ::tensorflow::test::TensorEq;
+using ::testing::ElementsAre;
+using ::testing::Return;
+using ::testing::SizeIs;
+
+// Compiles or loads `executable.mlir` with `cache_dirs`, checks its result and
+// returns the files in `cache_dirs[0]`.
+std::vector<std::string> RunExecutable(
+    const std::vector<std::string>& cache_dirs) {
+  tsl::test_util::MockServingDeviceSelector selector;
+  test_utils::IfrtServingExecutableTestHelper helper(
+      &selector, std::make_unique<IfrtFileCompilationCache>(cache_dirs));
+  int64_t program_id = 123456;
+  EXPECT_CALL(selector, ReserveDevice(absl::StrCat(program_id)))
+      .WillRepeatedly(Return(tsl::DeviceReservation(0, /*selector=*/nullptr)));
+  auto executable =
+      helper.MakeExecutable(program_id, GetMlirModulePath("executable.mlir"));
+
+  auto x = AsTensor<int32_t>({1, 2, 3}, tensorflow::TensorShape({1, 3}));
+  auto y = AsTensor<int32_t>({1, 2, 3}, tensorflow::TensorShape({3, 1}));
+  std::vector<tensorflow::Tensor> inputs{x, y};
+  auto result = executable->Execute(absl::MakeSpan(inputs), {});
+  TF_EXPECT_OK(result.status());
+  if (result.ok()) {
+    EXPECT_THAT(*result, ElementsAre(TensorEq(AsTensor<int32_t>(
+                             {14}, tensorflow::TensorShape({1, 1})))));
+  }
+
+  std::vector<std::string> files;
+  TF_EXPECT_OK(tsl::Env::Default()->GetChildren(cache_dirs[0], &files));
+  return files;
+}
+
+TEST(IfrtFileCompilationCacheTest, LoadsExecutablesFromSharedDirectory) {
+  const std::string shared_dir =
+      tsl::io::JoinPath(testing::TmpDir(), "ifrt_cache_shared");
+  const std::string local_dir =
+      tsl::io::JoinPath(testing::TmpDir(), "ifrt_cache_local");
+
+  // The first host compiles the executable and writes it to the shared
+  // directory.
+  EXPECT_THAT(RunExecutable({shared_dir}), SizeIs(1));
+
+  // The second host loads it from the shared directory and copies it to its
+  // local directory.
+  std::vector<std::string> local_files =
+      RunExecutable({local_dir, shared_dir});
+  std::vector<std::string> shared_files;
+  TF_ASSERT_OK(tsl::Env::Default()->GetChildren(shared_dir, &shared_files));
+  ASSERT_THAT(shared_files, SizeIs(1));
+  EXPECT_THAT(local_files, ElementsAre(shared_files[0]));
+}
+
+}  // namespace
+}  // namespace ifrt_serving
+}  // namespace tensorflow
@@ -55,8 +55,12 @@ std::string GetMlirModulePath(absl::string_view module_name) {
 }
 
 IfrtServingExecutableTestHelper::IfrtServingExecutableTestHelper(
-    tsl::test_util::MockServingDeviceSelector* device_selector)
-    : device_selector_(device_selector) {
+    tsl::test_util::MockServingDeviceSelector* device_selector,
+    std::unique_ptr<IfrtPersistentCompilationCache>
+        persistent_compilation_cache)
+    : device_selector_(device_selector),
+      ifrt_persistent_compilation_cache_(
+          std::move(persistent_compilation_cache)) {
   auto client_or = xla::ifrt::test_util::GetClient();
   TF_CHECK_OK(client_or.status());
   client_ = std::move(client_or.value());
@@ -76,8 +80,10 @@ IfrtServingExecutableTestHelper::IfrtServingExecutableTestHelper(
   mlir::registerAllDialects(registry_);
   mlir::RegisterAllTensorFlowDialects(registry_);
   context_ = std::make_unique<mlir::MLIRContext>(registry_);
-  ifrt_persistent_compilation_cache_ =
-      std::make_unique<IfrtPersistentCompilationCache>();
+  if (ifrt_persistent_compilation_cache_ == nullptr) {
+    ifrt_persistent_compilation_cache_ =
+        std::make_unique<IfrtPersistentCompilationCache>();
+  }
 }
 
 std::unique_ptr<IfrtServingExecutable>
@@ -44,8 +44,12 @@ namespace test_utils {
 // A test helper class to create and IfrtServingExecutable.
 class IfrtServingExecutableTestHelper {
  public:
+  // The executables use `persistent_compilation_cache` if not null, and a
+  // cache compiling every program otherwise.
   explicit IfrtServingExecutableTestHelper(
-      tsl::test_util::MockServingDeviceSelector* device_selector);
+      tsl::test_util::MockServingDeviceSelector* device_selector,
+      std::unique_ptr<IfrtPersistentCompilationCache>
+          persistent_compilation_cache = nullptr);
 
   // Creates an IfrtServingExecutable with the given program id.
   // Note the instance of this class must outlive the returned
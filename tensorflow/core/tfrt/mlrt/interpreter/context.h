@@ -93,11 +93,29 @@ class LoadedExecutable {
 
   bc::Executable executable() const { return executable_; }
 
+  // Returns the implementations of the kernels of `function`, in program
+  // order, so that the interpreter can dispatch each kernel without decoding
+  // its code from the bytecode first. Returns an empty span if `function` is
+  // not in this executable.
+  absl::Span<const KernelImplementation> GetKernelImplementations(
+      bc::Function function) const {
+    if (auto iter = function_kernels_.find(function.kernels().data());
+        iter != function_kernels_.end()) {
+      return iter->second;
+    }
+
+    return {};
+  }
+
  private:
   bc::Executable executable_;
 
   absl::flat_hash_map<std::string, bc::Function> functions_;
   std::vector<KernelImplementation> kernels_;
+  // The kernel implementations of each function, keyed by the address of its
+  // kernels in the bytecode.
+  absl::flat_hash_map<const char*, std::vector<KernelImplementation>>
+      function_kernels_;
 };
 
 // A helper structure that holds states for a kernel. Typical usuage is that a
@@ -207,6 +225,8 @@ class FunctionContext {
   std::vector<Value> registers_;
   std::vector<Value*> results_;
   bc::Function function_object_;
+  // See LoadedExecutable::GetKernelImplementations().
+  const KernelImplementation* kernel_implementations_ = nullptr;
   KernelContext kernel_context_;
 
   ExecutionContext* execution_context_ = nullptr;
@@ -280,6 +300,8 @@ class ExecutionContext {
             Args args, Results results) {
     auto& function_context =
         function_stack_.emplace_back(function_object, this);
+    function_context.kernel_implementations_ =
+        loaded_executable_->GetKernelImplementations(function_object).data();
     function_context.Call(last_uses, args, results);
     state_ = State::kReady;
   }
@@ -288,6 +310,8 @@ class ExecutionContext {
   void CallByMove(bc::Function function_object, Args args, Results results) {
     auto& function_context =
         function_stack_.emplace_back(function_object, this);
+    function_context.kernel_implementations_ =
+        loaded_executable_->GetKernelImplementations(function_object).data();
     function_context.CallByMove(args, results);
     state_ = State::kReady;
   }
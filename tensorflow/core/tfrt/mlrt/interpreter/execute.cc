@@ -92,12 +92,16 @@ void Execute(ExecutionContext& ctx) {
     FunctionContext* current_function = &context.function_stack_.back();
     int64_t pc = current_function->pc_;
 
-    auto kernels = context.loaded_executable().kernels();
-
     auto kernel_object_iter =
         current_function->function_object().kernels().begin();
     kernel_object_iter += pc;
 
+    // The kernel implementations are resolved when the executable is loaded,
+    // so that dispatching a kernel doesn't depend on decoding its code.
+    DCHECK(current_function->kernel_implementations_);
+    const KernelImplementation* kernel_implementation_iter =
+        current_function->kernel_implementations_ + pc;
+
     KernelFrame::State kstate(current_function);
     KernelFrame frame(&kstate);
 
@@ -109,8 +113,9 @@ void Execute(ExecutionContext& ctx) {
              current_function->function_object().kernels().end());
       bc::Kernel kernel_object = *kernel_object_iter;
       frame.set_kernel(kernel_object);
-      kernels[kernel_object.code()](frame);
+      (*kernel_implementation_iter)(frame);
       ++kernel_object_iter;
+      ++kernel_implementation_iter;
     }
 
     // Update the program counter if we need to break the sequential execution
@@ -148,6 +148,7 @@ ThreadWorkSource::ThreadWorkSource()
       non_blocking_inflight_(0),
       pending_tasks_(0),
       traceme_id_(0),
+      max_blocking_inflight_(0),
       version_(0),
       sub_thread_pool_waiter_(nullptr) {
   queue_waiters_.next = &queue_waiters_;
@@ -282,6 +283,14 @@ int64_t ThreadWorkSource::GetTracemeId() {
 
 void ThreadWorkSource::SetTracemeId(int64_t value) { traceme_id_ = value; }
 
+int64_t ThreadWorkSource::GetMaxBlockingInflight() {
+  return max_blocking_inflight_.load(std::memory_order_relaxed);
+}
+
+void ThreadWorkSource::SetMaxBlockingInflight(int64_t value) {
+  max_blocking_inflight_.store(value, std::memory_order_relaxed);
+}
+
 void ThreadWorkSource::SetWaiter(uint64_t version, Waiter* waiter,
                                  tensorflow::mutex* mutex) {
   {
@@ -503,8 +512,12 @@ Task RunHandlerThreadPool::FindTask(
     ++current_index;
 
     // For blocking thread, search for blocking tasks first.
+    const int64_t request_max_blocking_inflight =
+        (*tws)->GetMaxBlockingInflight();
     if (may_steal_blocking_work &&
-        (*tws)->GetInflightTaskCount(true) < max_blocking_inflight) {
+        (*tws)->GetInflightTaskCount(true) <
+            (request_max_blocking_inflight > 0 ? request_max_blocking_inflight
+                                               : max_blocking_inflight)) {
       t = (*tws)->PopBlockingTask();
       if (t.f) {
         *task_from_blocking_queue = true;
@@ -1023,6 +1036,7 @@ void RunHandler::Impl::Reset(int64_t step_id,
   step_id_ = step_id;
   options_ = options;
   tws_.SetTracemeId(step_id);
+  tws_.SetMaxBlockingInflight(options.max_inflight_inter_op_tasks);
 }
 
 int RunHandler::Impl::RunHandlerEigenThreadPool::NumThreads() const {
@@ -46,11 +46,20 @@ namespace tf {
 class RunHandler;
 
 // Options for RunHanler.
+//
+// Latency classes are expressed with these options: interactive requests use a
+// higher `priority` than batch requests, so that their handlers are searched
+// first by every thread, and batch requests set `max_inflight_inter_op_tasks`
+// so that they can't occupy all the threads stealing inter-op work.
 struct RunHandlerOptions {
-  RunHandlerOptions() : priority(0) {}
+  RunHandlerOptions() : priority(0), max_inflight_inter_op_tasks(0) {}
 
   // Request priority.
   int priority;
+
+  // The maximum number of inter-op tasks of the request executing at a time.
+  // If not positive, the default limit of the thread pool is used.
+  int max_inflight_inter_op_tasks;
 };
 
 // RunHandlerPool is a fixed size pool of pre-allocated RunHandlers
@@ -242,6 +251,12 @@ class ThreadWorkSource {
 
   void SetTracemeId(int64_t value);
 
+  // Returns the maximum number of inflight blocking tasks of this work source,
+  // or 0 if the default limit of the thread pool applies.
+  int64_t GetMaxBlockingInflight();
+
+  void SetMaxBlockingInflight(int64_t value);
+
   void SetWaiter(uint64_t version, Waiter* waiter, tensorflow::mutex* mutex);
 
   int64_t GetInflightTaskCount(bool is_blocking);
@@ -283,6 +298,7 @@ class ThreadWorkSource {
   tensorflow::mutex waiters_mu_;
   Waiter queue_waiters_ TF_GUARDED_BY(waiters_mu_);
   std::atomic<int64_t> traceme_id_;
+  std::atomic<int64_t> max_blocking_inflight_;
 
   tensorflow::mutex run_handler_waiter_mu_;
   uint64_t version_ TF_GUARDED_BY(run_handler_waiter_mu_);
@@ -364,7 +380,9 @@ class RunHandlerThreadPool {
 
   // Search tasks from Requets range searching_range_start to
   // searching_range_end. If there is no tasks in the search range and
-  // may_steal_blocking_work is true, then search from all requests.
+  // may_steal_blocking_work is true, then search from all requests. Blocking
+  // tasks are only taken from requests with fewer inflight blocking tasks than
+  // their own limit, or max_blocking_inflight if they don't set one.
   Task FindTask(
       int searching_range_start, int searching_range_end, int thread_id,
       int sub_thread_pool_id, int max_blocking_inflight,
@@ -409,6 +409,46 @@ TEST_P(RunHandlerThreadPoolTest, FindTask) {
     EXPECT_EQ(result, 2);
   }
 
+  {
+    // Blocking tasks are not picked up from requests at their own inflight
+    // limit.
+    int result = -1;
+    thread_work_sources[2]->SetMaxBlockingInflight(1);
+    thread_work_sources[2]->IncrementInflightTaskCount(/*is_blocking=*/true);
+    run_handler_thread_pool.AddWorkToQueue(
+        thread_work_sources[2],
+        /*is_blocking=*/true, TaskFunction([&result] { result = 2; }));
+    run_handler_thread_pool.AddWorkToQueue(
+        thread_work_sources[3],
+        /*is_blocking=*/true, TaskFunction([&result] { result = 3; }));
+    const auto find_blocking_task_from_all_handlers =
+        [&](bool* task_from_blocking_queue, internal::Task* t) {
+          internal::ThreadWorkSource* tws;
+          *t = run_handler_thread_pool.FindTask(
+              /*searching_range_start=*/0, /*searching_range_end=*/5,
+              /*thread_id=*/0,
+              /*sub_thread_pool_id=*/0, /*max_blocking_inflight=*/10,
+              /*may_steal_blocking_work=*/true, thread_work_sources,
+              task_from_blocking_queue, &tws);
+        };
+    bool task_from_blocking_queue;
+    internal::Task t;
+    find_blocking_task_from_all_handlers(&task_from_blocking_queue, &t);
+    EXPECT_EQ(task_from_blocking_queue, true);
+    t.f->f();
+    EXPECT_EQ(result, 3);
+
+    find_blocking_task_from_all_handlers(&task_from_blocking_queue, &t);
+    EXPECT_EQ(t.f, nullptr);
+
+    thread_work_sources[2]->DecrementInflightTaskCount(/*is_blocking=*/true);
+    find_blocking_task_from_all_handlers(&task_from_blocking_queue, &t);
+    EXPECT_EQ(task_from_blocking_queue, true);
+    t.f->f();
+    EXPECT_EQ(result, 2);
+    thread_work_sources[2]->SetMaxBlockingInflight(0);
+  }
+
   {
     // Nonblocking threads can only pick up non-blocking task.
     int result = -1;
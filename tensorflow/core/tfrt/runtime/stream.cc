@@ -15,6 +15,7 @@ limitations under the License.
 #include "tensorflow/core/tfrt/runtime/stream.h"
 
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <optional>
 #include <string>
@@ -89,14 +90,39 @@ absl::Status StreamCallbackRegistry::CallbackState::Invoke(
           "Failed to invole the callback that is closed.");
     }
     ++num_outstanding_;
+    pending_results_.push_back(std::move(result));
+    if (invoking_) {
+      return absl::OkStatus();
+    }
+    invoking_ = true;
   }
-  thread_pool->Schedule([this, result = std::move(result)]() mutable {
-    InvokeCallback(std::move(result));
+  thread_pool->Schedule([this]() { InvokePendingCallbacks(); });
+  return absl::OkStatus();
+}
 
+void StreamCallbackRegistry::CallbackState::InvokePendingCallbacks() {
+  std::deque<StreamedResult> results;
+  {
     absl::MutexLock lock(&mu_);
-    --num_outstanding_;
-  });
-  return absl::OkStatus();
+    results.swap(pending_results_);
+  }
+  while (true) {
+    for (auto& result : results) {
+      InvokeCallback(std::move(result));
+    }
+    const int num_results = results.size();
+    results.clear();
+
+    // `this` may be destroyed by `Close()` as soon as `mu_` is released with
+    // no outstanding results.
+    absl::MutexLock lock(&mu_);
+    num_outstanding_ -= num_results;
+    if (pending_results_.empty()) {
+      invoking_ = false;
+      return;
+    }
+    results.swap(pending_results_);
+  }
 }
 
 void StreamCallbackRegistry::CallbackState::Close() {
@@ -17,6 +17,7 @@ under the License.
 
 #include <algorithm>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -171,7 +172,9 @@ class StreamCallbackRegistry {
   //
   // All invocations to `callback` are handled serially by a single thread, so
   // `callback` doesn't need to be thread-safe even if multiple
-  // `tf.PwStreamResults` ops may run concurrently.
+  // `tf.PwStreamResults` ops may run concurrently. Results are passed to
+  // `callback` in the order they are received; results received while the
+  // callback is running are coalesced into the same thread pool task.
   absl::StatusOr<ScopedStreamCallback> Register(
       absl::string_view model_name, StreamCallbackId callback_id,
       StepId step_id,
@@ -204,7 +207,8 @@ class StreamCallbackRegistry {
       DCHECK(registry_);
     }
 
-    // Invokes the callback in `thread_pool` with `result`.
+    // Invokes the callback in `thread_pool` with `result`, or in the task
+    // already invoking it with earlier results, if any.
     absl::Status Invoke(tsl::thread::ThreadPoolInterface* thread_pool,
                         StreamedResult result);
 
@@ -218,6 +222,9 @@ class StreamCallbackRegistry {
     }
     void InvokeCallback(StreamedResult result);
 
+    // Invokes the callback with the pending results until there are none.
+    void InvokePendingCallbacks();
+
     StreamCallbackRegistry* registry_ = nullptr;
     std::string model_name_;
     StreamCallbackId callback_id_;
@@ -229,6 +236,11 @@ class StreamCallbackRegistry {
     absl::Mutex mu_;
     bool closed_ ABSL_GUARDED_BY(mu_) = false;
     int num_outstanding_ ABSL_GUARDED_BY(mu_) = 0;
+
+    // The results not yet passed to the callback, and whether a task invoking
+    // the callback with them is scheduled.
+    std::deque<StreamedResult> pending_results_ ABSL_GUARDED_BY(mu_);
+    bool invoking_ ABSL_GUARDED_BY(mu_) = false;
   };
 
   std::unique_ptr<CallbackState> Unregister(StreamCallbackId callback_id,
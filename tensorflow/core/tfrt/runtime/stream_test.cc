@@ -17,6 +17,7 @@ limitations under the License.
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <utility>
 #include <vector>
@@ -146,6 +147,33 @@ TEST(StreamTest, MultipleWriters) {
   }
 }
 
+TEST(StreamTest, ResultsAreDeliveredInOrder) {
+  StreamCallbackId callback_id(1234);
+  StepId step_id(5678);
+
+  std::vector<int32_t> outputs;
+  {
+    TfThreadPool thread_pool(/*name=*/"test", /*num_threads=*/4);
+    TF_ASSERT_OK_AND_ASSIGN(
+        auto scoped_stream_callback,
+        GetGlobalStreamCallbackRegistry().Register(
+            "test_model", callback_id, step_id,
+            [&](absl::flat_hash_map<std::string, tensorflow::Tensor> arg) {
+              outputs.push_back(GetTfTensorData<int32_t>(arg["a"])[0]);
+            }));
+
+    for (int32_t i = 0; i < 100; ++i) {
+      CHECK_OK(GetGlobalStreamCallbackRegistry().Invoke(
+          &thread_pool, callback_id, step_id,
+          {{{"a", AsTensor<int32_t>({i})}}, absl::Now()}));
+    }
+  }
+
+  std::vector<int32_t> expected(100);
+  std::iota(expected.begin(), expected.end(), 0);
+  EXPECT_THAT(outputs, ElementsAreArray(expected));
+}
+
 class TestStreamControllerInterface : public StreamControllerInterface {
  public:
   TestStreamControllerInterface()
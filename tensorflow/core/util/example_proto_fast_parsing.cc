@@ -15,6 +15,7 @@ limitations under the License.
 #include "tensorflow/core/util/example_proto_fast_parsing.h"
 
 #include <algorithm>
+#include <cstring>
 #include <functional>
 #include <optional>
 #include <utility>
@@ -119,6 +120,57 @@ constexpr uint8 kVarintTag(uint32 tag) { return (tag << 3) | 0; }
 constexpr uint8 kDelimitedTag(uint32 tag) { return (tag << 3) | 2; }
 constexpr uint8 kFixed32Tag(uint32 tag) { return (tag << 3) | 5; }
 
+// Returns the number of varints in the packed run `[begin, end)`, which is the
+// number of bytes that do not have their continuation bit set.
+size_t CountPackedVarints(const uint8* begin, const uint8* end) {
+  size_t count = 0;
+  for (const uint8* p = begin; p < end; ++p) {
+    count += (*p & 0x80) == 0;
+  }
+  return count;
+}
+
+// Decodes the packed run of varints `[begin, end)`, storing at most `capacity`
+// of them in `out`. Returns the number of varints in the run, or -1 if the run
+// is malformed.
+//
+// Small values (e.g. ids and counts) encode to a single byte each, so the run
+// is scanned eight bytes at a time and words without any continuation bit are
+// unpacked without the per-byte branching of `CodedInputStream::ReadVarint64`.
+int64_t DecodePackedVarint64s(const uint8* begin, const uint8* end,
+                              int64_t* out, size_t capacity) {
+  constexpr uint64 kContinuationBits = 0x8080808080808080ULL;
+  constexpr int kMaxVarint64Bytes = 10;
+  const uint8* p = begin;
+  size_t index = 0;
+  while (p < end) {
+    if (port::kLittleEndian && end - p >= 8 && index + 8 <= capacity) {
+      uint64 word;
+      std::memcpy(&word, p, sizeof(word));
+      if ((word & kContinuationBits) == 0) {
+        for (int i = 0; i < 8; ++i) {
+          out[index + i] = static_cast<int64_t>((word >> (8 * i)) & 0xff);
+        }
+        index += 8;
+        p += 8;
+        continue;
+      }
+    }
+    uint64 value = 0;
+    int num_bytes = 0;
+    uint8 byte;
+    do {
+      if (p == end || num_bytes == kMaxVarint64Bytes) return -1;
+      byte = *p++;
+      value |= static_cast<uint64>(byte & 0x7f) << (7 * num_bytes);
+      ++num_bytes;
+    } while (byte & 0x80);
+    if (index < capacity) out[index] = static_cast<int64_t>(value);
+    ++index;
+  }
+  return index;
+}
+
 namespace parsed {
 
 // ParseDataType has to be called first, then appropriate ParseZzzzList.
@@ -307,6 +359,22 @@ class Feature {
         if (!stream.ReadVarint32(&packed_length)) return false;
         auto packed_limit = stream.PushLimit(packed_length);
 
+        const void* packed_data;
+        int packed_size;
+        if (stream.GetDirectBufferPointer(&packed_data, &packed_size) &&
+            static_cast<uint32>(packed_size) == packed_length) {
+          // Size the output once and decode the whole run in place.
+          const uint8* begin = static_cast<const uint8*>(packed_data);
+          const uint8* end = begin + packed_length;
+          const size_t initial_size = int64_list->size();
+          int64_list->resize(initial_size + CountPackedVarints(begin, end));
+          if (DecodePackedVarint64s(begin, end,
+                                    int64_list->data() + initial_size,
+                                    int64_list->size() - initial_size) < 0) {
+            return false;
+          }
+          if (!stream.Skip(packed_length)) return false;
+        }
         while (!stream.ExpectAtEnd()) {
           protobuf_uint64 n;  // There is no API for int64
           if (!stream.ReadVarint64(&n)) return false;
@@ -1981,6 +2049,19 @@ inline int ParseInt64Feature(protobuf::io::CodedInputStream* stream,
         return -1;
       }
       auto packed_limit = stream->PushLimit(packed_length);
+      const void* packed_data;
+      int packed_size;
+      if (stream->GetDirectBufferPointer(&packed_data, &packed_size) &&
+          static_cast<uint32>(packed_size) == packed_length) {
+        const uint8* begin = static_cast<const uint8*>(packed_data);
+        const int64_t num_decoded = DecodePackedVarint64s(
+            begin, begin + packed_length, out,
+            out != nullptr ? packed_length : 0);
+        if (num_decoded < 0 || !stream->Skip(packed_length)) {
+          return -1;
+        }
+        num_elements += num_decoded;
+      }
       while (!stream->ExpectAtEnd()) {
         protobuf_uint64 n;  // There is no API for int64
         if (!stream->ReadVarint64(&n)) {
@@ -219,6 +219,20 @@ TEST(FastParse, SingleInt64) {
   TestCorrectness(Serialize(example));
 }
 
+TEST(FastParse, LongPackedInt64List) {
+  Example example;
+  Int64List* int64_list =
+      (*example.mutable_features()->mutable_feature())["ids"]
+          .mutable_int64_list();
+  // Runs of single-byte values mixed with multi-byte and negative values.
+  for (int i = 0; i < 100; ++i) {
+    int64_list->add_value(i % 128);
+    if (i % 13 == 0) int64_list->add_value(int64_t{1} << (i % 63));
+    if (i % 29 == 0) int64_list->add_value(-i);
+  }
+  TestCorrectness(Serialize(example));
+}
+
 static string ExampleWithSomeFeatures() {
   Example example;
 
@@ -182,8 +182,17 @@ absl::Status MemmappedFileSystem::GetChildren(const string& filename,
 absl::Status MemmappedFileSystem::GetMatchingPaths(
     const string& pattern, TransactionToken* token,
     std::vector<string>* results) {
-  return errors::Unimplemented(
-      "memmapped format doesn't support GetMatchingPaths");
+  if (!mapped_memory_) {
+    return errors::FailedPrecondition("MemmappedEnv is not initialized");
+  }
+  results->clear();
+  for (const auto& element : directory_) {
+    if (Match(element.first, pattern)) {
+      results->push_back(element.first);
+    }
+  }
+  std::sort(results->begin(), results->end());
+  return absl::OkStatus();
 }
 
 absl::Status MemmappedFileSystem::DeleteFile(const string& filename,
@@ -243,8 +252,11 @@ absl::Status MemmappedFileSystem::InitializeFromFile(Env* env,
   uint64 prev_element_offset = directory_offset;
   for (auto element_iter = proto_directory.element().rbegin();
        element_iter != proto_directory.element().rend(); ++element_iter) {
-    // Check that the element offset is in the right range.
-    if (element_iter->offset() >= prev_element_offset) {
+    // Check that the element offset is in the right range. Empty elements
+    // may share the offset of the next one.
+    if (element_iter->offset() > prev_element_offset ||
+        (element_iter->offset() == prev_element_offset &&
+         element_iter->length() != 0)) {
       return errors::DataLoss("Corrupted memmapped model file: ", filename,
                               " Invalid offset of internal component");
     }
@@ -269,7 +281,8 @@ bool MemmappedFileSystem::IsMemmappedPackageFilename(const string& filename) {
 namespace {
 bool IsValidRegionChar(char c) {
   return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
-         (c >= '0' && c <= '9') || c == '_' || c == '.';
+         (c >= '0' && c <= '9') || c == '_' || c == '.' || c == '-' ||
+         c == '/';
 }
 }  // namespace
 
@@ -43,8 +43,8 @@ namespace tensorflow {
 //
 // Region naming:
 // Region naming is up to the application, all of them starts from
-// kMemmappedPackagePrefix. The default graph usually has name
-// kMemmappedPackageDefaultGraphDef;
+// kMemmappedPackagePrefix and include [A-Za-z0-9_.-/]. The default graph
+// usually has name kMemmappedPackageDefaultGraphDef;
 //
 // A "frozen" GraphDef can be converted into this format using
 // tensorflow/contrib/util/convert_graphdef_memmapped_format
@@ -82,8 +82,6 @@ class MemmappedFileSystem : public FileSystem {
       std::unique_ptr<WritableFile>* result) override;
   absl::Status GetChildren(const string& dir, TransactionToken* token,
                            std::vector<string>* r) override;
-  absl::Status GetMatchingPaths(const string& pattern, TransactionToken* token,
-                                std::vector<string>* results) override;
   absl::Status DeleteFile(const string& f, TransactionToken* token) override;
   absl::Status CreateDir(const string& d, TransactionToken* token) override;
   absl::Status DeleteDir(const string& d, TransactionToken* token) override;
@@ -96,6 +94,9 @@ class MemmappedFileSystem : public FileSystem {
   // Currently just returns size.
   absl::Status Stat(const string& fname, TransactionToken* token,
                     FileStatistics* stat) override;
+  // Matches the names of the regions of the package.
+  absl::Status GetMatchingPaths(const string& pattern, TransactionToken* token,
+                                std::vector<string>* results) override;
 
   // Initializes filesystem from a file in memmapped format.
   absl::Status InitializeFromFile(Env* env, const string& filename);
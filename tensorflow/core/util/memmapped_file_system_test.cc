@@ -15,6 +15,7 @@ limitations under the License.
 #include "tensorflow/core/util/memmapped_file_system.h"
 
 #include <memory>
+#include <vector>
 
 #include "tensorflow/core/framework/tensor_testutil.h"
 #include "tensorflow/core/framework/versions.pb.h"
@@ -142,6 +143,54 @@ TEST(MemmappedFileSystemTest, Corrupted) {
             absl::OkStatus());
 }
 
+TEST(MemmappedFileSystemTest, SaveFile) {
+  Env* env = Env::Default();
+  const string dir = testing::TmpDir();
+  const string data_filename = io::JoinPath(dir, "memmapped_env_file_data");
+  const string empty_filename = io::JoinPath(dir, "memmapped_env_file_empty");
+  const string data(10000, 'x');
+  TF_ASSERT_OK(WriteStringToFile(env, data_filename, data));
+  TF_ASSERT_OK(WriteStringToFile(env, empty_filename, ""));
+
+  const string filename = io::JoinPath(dir, "memmapped_env_file_test");
+  MemmappedFileSystemWriter writer;
+  TF_ASSERT_OK(writer.InitializeToFile(env, filename));
+  TF_ASSERT_OK(writer.SaveProtobuf(GraphDef(), kProtoFileName));
+  TF_ASSERT_OK(writer.SaveFile(env, empty_filename,
+                               "memmapped_package://dir/empty-file"));
+  TF_ASSERT_OK(writer.SaveFile(env, data_filename,
+                               "memmapped_package://dir/data-00000-of-00001"));
+  EXPECT_TRUE(absl::IsInvalidArgument(
+      writer.SaveFile(env, data_filename, "memmapped_package://bla bla")));
+  TF_ASSERT_OK(writer.FlushAndClose());
+
+  MemmappedEnv memmapped_env(env);
+  TF_ASSERT_OK(memmapped_env.InitializeFromFile(filename));
+  std::unique_ptr<ReadOnlyMemoryRegion> memory_region;
+  TF_ASSERT_OK(memmapped_env.NewReadOnlyMemoryRegionFromFile(
+      "memmapped_package://dir/data-00000-of-00001", &memory_region));
+  EXPECT_EQ(data, StringPiece(static_cast<const char*>(memory_region->data()),
+                              memory_region->length()));
+  // The file starts on its own page.
+  std::unique_ptr<ReadOnlyMemoryRegion> package_region;
+  TF_ASSERT_OK(env->NewReadOnlyMemoryRegionFromFile(filename, &package_region));
+  EXPECT_EQ(0, (static_cast<const char*>(memory_region->data()) -
+                static_cast<const char*>(package_region->data())) %
+                   MemmappedFileSystemWriter::kFileAlignment);
+
+  uint64 file_size = 1;
+  TF_ASSERT_OK(memmapped_env.GetFileSize("memmapped_package://dir/empty-file",
+                                         &file_size));
+  EXPECT_EQ(0, file_size);
+
+  std::vector<string> paths;
+  TF_ASSERT_OK(memmapped_env.GetMatchingPaths("memmapped_package://dir/*",
+                                              &paths));
+  EXPECT_EQ(std::vector<string>({"memmapped_package://dir/data-00000-of-00001",
+                                 "memmapped_package://dir/empty-file"}),
+            paths);
+}
+
 TEST(MemmappedFileSystemTest, ProxyToDefault) {
   MemmappedEnv memmapped_env(Env::Default());
   const string dir = testing::TmpDir();
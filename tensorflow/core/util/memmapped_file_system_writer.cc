@@ -15,6 +15,7 @@ limitations under the License.
 #include "tensorflow/core/util/memmapped_file_system_writer.h"
 
 #include <algorithm>
+#include <memory>
 
 namespace tensorflow {
 
@@ -124,6 +125,48 @@ absl::Status MemmappedFileSystemWriter::AdjustAlignment(uint64 alignment) {
   return absl::OkStatus();
 }
 
+absl::Status MemmappedFileSystemWriter::SaveFile(Env* env,
+                                                 const string& filename,
+                                                 const string& element_name) {
+  if (!output_file_) {
+    return errors::FailedPrecondition(
+        "MemmappedEnvWritter: saving file into not opened file");
+  }
+  if (!MemmappedFileSystem::IsWellFormedMemmappedPackageFilename(
+          element_name)) {
+    return errors::InvalidArgument(
+        "MemmappedEnvWritter: element_name is invalid: must have memmapped "
+        "package prefix ",
+        MemmappedFileSystem::kMemmappedPackagePrefix,
+        " and include [A-Za-z0-9_.-/]");
+  }
+  uint64 file_size;
+  TF_RETURN_IF_ERROR(env->GetFileSize(filename, &file_size));
+  std::unique_ptr<RandomAccessFile> file;
+  TF_RETURN_IF_ERROR(env->NewRandomAccessFile(filename, &file));
+
+  TF_RETURN_IF_ERROR(AdjustAlignment(kFileAlignment));
+  AddToDirectoryElement(element_name, file_size);
+  // Copies the file in chunks, so that large variable files aren't read into
+  // memory at once.
+  static constexpr uint64 kCopyBufferSize = 1 << 20;
+  std::unique_ptr<char[]> scratch(
+      new char[std::min(kCopyBufferSize, std::max<uint64>(file_size, 1))]);
+  for (uint64 offset = 0; offset < file_size;) {
+    const size_t n = std::min(kCopyBufferSize, file_size - offset);
+    StringPiece data;
+    TF_RETURN_IF_ERROR(file->Read(offset, n, &data, scratch.get()));
+    if (data.size() != n) {
+      return errors::DataLoss("MemmappedEnvWritter: file ", filename,
+                              " was truncated while saving it");
+    }
+    TF_RETURN_IF_ERROR(output_file_->Append(data));
+    offset += n;
+    output_file_offset_ += n;
+  }
+  return absl::OkStatus();
+}
+
 void MemmappedFileSystemWriter::AddToDirectoryElement(const string& name,
                                                       uint64 length) {
   MemmappedFileSystemDirectoryElement* new_directory_element =
@@ -29,12 +29,21 @@ namespace tensorflow {
 // MemmappedFileSystem.
 class MemmappedFileSystemWriter {
  public:
+  // The alignment of the regions saved by SaveFile(), a multiple of the page
+  // size of common platforms.
+  static constexpr uint64 kFileAlignment = 4096;
+
   MemmappedFileSystemWriter() = default;
   ~MemmappedFileSystemWriter() = default;
   absl::Status InitializeToFile(Env* env, const string& filename);
   absl::Status SaveTensor(const Tensor& tensor, const string& element_name);
   absl::Status SaveProtobuf(const protobuf::MessageLite& message,
                             const string& element_name);
+  // Saves the contents of the file `filename` of `env` at an offset aligned to
+  // kFileAlignment, so that each file saved in a package can be mapped on its
+  // own pages.
+  absl::Status SaveFile(Env* env, const string& filename,
+                        const string& element_name);
   // Writes out the directory of regions and closes the output file.
   absl::Status FlushAndClose();
 
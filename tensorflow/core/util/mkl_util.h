@@ -17,6 +17,7 @@ limitations under the License.
 #define TENSORFLOW_CORE_UTIL_MKL_UTIL_H_
 #ifdef INTEL_MKL
 
+#include <algorithm>
 #include <list>
 #include <memory>
 #include <string>
@@ -2072,12 +2073,28 @@ class MklPrimitiveFactory {
 #endif
 
  private:
+  /// Capacity of the primitive caches, 1024 unless overridden by
+  /// TF_MKL_PRIMITIVE_CACHE_CAPACITY. Models that see more distinct shapes
+  /// than this per op type keep recreating evicted primitives.
+  static inline size_t GetCacheCapacity() {
+    static const size_t capacity = [] {
+      int64_t value = 1024;
+      absl::Status status = ReadInt64FromEnvVar(
+          "TF_MKL_PRIMITIVE_CACHE_CAPACITY", 1024, &value);
+      if (!status.ok()) {
+        LOG(WARNING) << status;
+        value = 1024;
+      }
+      return static_cast<size_t>(std::max<int64_t>(value, 1));
+    }();
+    return capacity;
+  }
+
   static inline LRUCache<MklPrimitive>& GetLRUCache() {
-    static const int kCapacity = 1024;  // cache capacity
 #if !defined(DNNL_AARCH64_USE_ACL) || !defined(ENABLE_ONEDNN_OPENMP)
-    static thread_local LRUCache<MklPrimitive> lru_cache_(kCapacity);
+    static thread_local LRUCache<MklPrimitive> lru_cache_(GetCacheCapacity());
 #else
-    static LRUCache<MklPrimitive> lru_cache_(kCapacity);
+    static LRUCache<MklPrimitive> lru_cache_(GetCacheCapacity());
 #endif
     return lru_cache_;
   }
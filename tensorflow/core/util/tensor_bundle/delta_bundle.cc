@@ -0,0 +1,178 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/util/tensor_bundle/delta_bundle.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/platform/errors.h"
+
+namespace tensorflow {
+
+const char* const kDeltaRowIdsSuffix = "/.DELTA_ROW_IDS";
+const char* const kDeltaRowsSuffix = "/.DELTA_ROWS";
+
+namespace {
+
+// Allocates "val" and looks up the tensor "key" of "reader" into it.
+Status LookupAllocated(BundleReader* reader, absl::string_view key,
+                       Tensor* val) {
+  DataType dtype;
+  TensorShape shape;
+  TF_RETURN_IF_ERROR(reader->LookupDtypeAndShape(key, &dtype, &shape));
+  *val = Tensor(dtype, shape);
+  return reader->Lookup(key, val);
+}
+
+// Overwrites the rows of "val" stored by "reader" for the tensor "key".
+Status ApplyDeltaRows(BundleReader* reader, absl::string_view key,
+                      Tensor* val) {
+  Tensor row_ids;
+  Tensor rows;
+  TF_RETURN_IF_ERROR(
+      LookupAllocated(reader, absl::StrCat(key, kDeltaRowIdsSuffix), &row_ids));
+  TF_RETURN_IF_ERROR(
+      LookupAllocated(reader, absl::StrCat(key, kDeltaRowsSuffix), &rows));
+
+  TensorShape row_shape = rows.shape();
+  if (rows.dims() > 0) row_shape.RemoveDim(0);
+  TensorShape val_row_shape = val->shape();
+  if (val->dims() > 0) val_row_shape.RemoveDim(0);
+  if (row_ids.dtype() != DT_INT64 || row_ids.dims() != 1 ||
+      rows.dtype() != val->dtype() || rows.dims() == 0 || val->dims() == 0 ||
+      rows.dim_size(0) != row_ids.dim_size(0) || row_shape != val_row_shape) {
+    return errors::DataLoss("Delta rows of ", key, " of dtype ",
+                            DataTypeString(rows.dtype()), " and shape ",
+                            rows.shape().DebugString(), " at indices of shape ",
+                            row_ids.shape().DebugString(),
+                            " don't match the tensor of dtype ",
+                            DataTypeString(val->dtype()), " and shape ",
+                            val->shape().DebugString());
+  }
+  if (!DataTypeCanUseMemcpy(val->dtype())) {
+    return errors::Unimplemented("Delta rows of ", key, " have dtype ",
+                                 DataTypeString(val->dtype()),
+                                 " that doesn't support memcpy");
+  }
+
+  const int64_t num_rows = val->dim_size(0);
+  const size_t row_bytes = val_row_shape.num_elements() *
+                           DataTypeSize(val->dtype());
+  const auto ids = row_ids.vec<int64_t>();
+  const char* src = rows.tensor_data().data();
+  char* dst = const_cast<char*>(val->tensor_data().data());
+  for (int64_t i = 0; i < ids.size(); ++i) {
+    if (ids(i) < 0 || ids(i) >= num_rows) {
+      return errors::DataLoss("Delta row index ", ids(i), " of ", key,
+                              " is out of range [0, ", num_rows, ")");
+    }
+    std::memcpy(dst + ids(i) * row_bytes, src + i * row_bytes, row_bytes);
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+Status AddDeltaRows(BundleWriter* writer, absl::string_view key,
+                    const Tensor& row_ids, const Tensor& rows) {
+  if (row_ids.dtype() != DT_INT64 || row_ids.dims() != 1) {
+    return errors::InvalidArgument(
+        "Delta row indices must be an int64 vector, got ",
+        DataTypeString(row_ids.dtype()), " of shape ",
+        row_ids.shape().DebugString());
+  }
+  if (rows.dims() == 0 || rows.dim_size(0) != row_ids.dim_size(0)) {
+    return errors::InvalidArgument("Expected ", row_ids.dim_size(0),
+                                   " delta rows, got a tensor of shape ",
+                                   rows.shape().DebugString());
+  }
+  if (!DataTypeCanUseMemcpy(rows.dtype())) {
+    return errors::InvalidArgument("Delta rows of dtype ",
+                                   DataTypeString(rows.dtype()),
+                                   " are not supported");
+  }
+  TF_RETURN_IF_ERROR(
+      writer->Add(absl::StrCat(key, kDeltaRowIdsSuffix), row_ids));
+  return writer->Add(absl::StrCat(key, kDeltaRowsSuffix), rows);
+}
+
+Status LookupWithDeltas(absl::Span<BundleReader* const> readers,
+                        absl::string_view key, Tensor* val) {
+  // The last bundle storing the tensor in full.
+  int base = static_cast<int>(readers.size()) - 1;
+  while (base >= 0 && !readers[base]->Contains(key)) --base;
+  if (base < 0) {
+    return errors::NotFound("Key ", key,
+                            " not stored in full in the chain of ",
+                            readers.size(), " bundles");
+  }
+  TF_RETURN_IF_ERROR(LookupAllocated(readers[base], key, val));
+  const std::string row_ids_key = absl::StrCat(key, kDeltaRowIdsSuffix);
+  for (size_t i = base + 1; i < readers.size(); ++i) {
+    if (readers[i]->Contains(row_ids_key)) {
+      TF_RETURN_IF_ERROR(ApplyDeltaRows(readers[i], key, val));
+    }
+  }
+  return absl::OkStatus();
+}
+
+Status CompactDeltaBundles(Env* env, absl::Span<const tstring> prefixes,
+                           absl::string_view output_prefix) {
+  std::vector<std::unique_ptr<BundleReader>> owned_readers;
+  std::vector<BundleReader*> readers;
+  // The keys of all the tensors of the chain, in order.
+  std::set<std::string> keys;
+  for (const tstring& prefix : prefixes) {
+    owned_readers.push_back(std::make_unique<BundleReader>(env, prefix));
+    BundleReader* reader = owned_readers.back().get();
+    TF_RETURN_IF_ERROR(reader->status());
+    readers.push_back(reader);
+
+    reader->Seek(kHeaderEntryKey);
+    for (reader->Next(); reader->Valid(); reader->Next()) {
+      absl::string_view key = reader->key();
+      // Slices of partitioned tensors have keys starting with a 0.
+      if (key.empty() || key[0] == '\0' ||
+          absl::EndsWith(key, kDeltaRowsSuffix)) {
+        continue;
+      }
+      absl::ConsumeSuffix(&key, kDeltaRowIdsSuffix);
+      keys.emplace(key);
+    }
+  }
+
+  BundleWriter writer(env, output_prefix);
+  TF_RETURN_IF_ERROR(writer.status());
+  for (const std::string& key : keys) {
+    Tensor val;
+    TF_RETURN_IF_ERROR(LookupWithDeltas(readers, key, &val));
+    TF_RETURN_IF_ERROR(writer.Add(key, val));
+  }
+  return writer.Finish();
+}
+
+}  // namespace tensorflow
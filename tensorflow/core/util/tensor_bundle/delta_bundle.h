@@ -0,0 +1,80 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Delta tensor bundles: checkpoints of large, sparsely updated tensors (e.g.
+// embedding tables) as a base bundle followed by a chain of bundles holding
+// only what changed since the previous bundle of the chain.
+//
+// A delta bundle is a regular tensor bundle, in which each tensor is stored
+// either in full with BundleWriter::Add(), replacing its previous value, or as
+// the rows (slices along the first dimension) that changed, with
+// AddDeltaRows().  Usage:
+//
+//   // Save.
+//   BundleWriter writer(env, "/fs/model/ckpt-2-delta");
+//   AddDeltaRows(&writer, "embedding", changed_row_ids, changed_rows);
+//   writer.Finish();
+//
+//   // Restore.
+//   BundleReader base(env, "/fs/model/ckpt-1");
+//   BundleReader delta(env, "/fs/model/ckpt-2-delta");
+//   LookupWithDeltas({&base, &delta}, "embedding", &tensor);
+//
+// CompactDeltaBundles() rebases a chain into a new full bundle, so that chains
+// stay short.
+
+#ifndef TENSORFLOW_CORE_UTIL_TENSOR_BUNDLE_DELTA_BUNDLE_H_
+#define TENSORFLOW_CORE_UTIL_TENSOR_BUNDLE_DELTA_BUNDLE_H_
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/tstring.h"
+#include "tensorflow/core/util/tensor_bundle/tensor_bundle.h"
+
+namespace tensorflow {
+
+// Suffixes of the keys under which AddDeltaRows() stores the indices of the
+// changed rows of a tensor, and their values.
+extern const char* const kDeltaRowIdsSuffix;
+extern const char* const kDeltaRowsSuffix;
+
+// Adds to "writer" the changed rows of the tensor "key": "row_ids" is an int64
+// vector of distinct row indices, and "rows" holds their values, with shape
+// [row_ids.size()] + the shape of a row of the full tensor.  The dtype of
+// "rows" must support memcpy.
+Status AddDeltaRows(BundleWriter* writer, absl::string_view key,
+                    const Tensor& row_ids,
+                    const Tensor& rows) TF_MUST_USE_RESULT;
+
+// Looks up the tensor "key" in the chain of bundles "readers", base first:
+// starts from the last bundle storing it in full, then overwrites the rows
+// stored by the following bundles, in order.  Unlike BundleReader::Lookup(),
+// allocates "val".  Returns a NotFound error if no bundle stores "key" in full.
+// REQUIRES: readers[i]->status().ok() for all i.
+Status LookupWithDeltas(absl::Span<BundleReader* const> readers,
+                        absl::string_view key, Tensor* val) TF_MUST_USE_RESULT;
+
+// Writes to "output_prefix" a bundle storing in full each tensor of the chain
+// of bundles "prefixes", base first.  The output can be used as the base of
+// new chains.  Partitioned tensors are stored unpartitioned.
+Status CompactDeltaBundles(Env* env, absl::Span<const tstring> prefixes,
+                           absl::string_view output_prefix) TF_MUST_USE_RESULT;
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_UTIL_TENSOR_BUNDLE_DELTA_BUNDLE_H_
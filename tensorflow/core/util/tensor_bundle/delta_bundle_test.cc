@@ -0,0 +1,138 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/util/tensor_bundle/delta_bundle.h"
+
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/platform/tstring.h"
+#include "tensorflow/core/util/tensor_bundle/tensor_bundle.h"
+
+namespace tensorflow {
+namespace {
+
+// Prepend the current test case's working temporary directory to <prefix>
+std::string Prefix(const std::string& prefix) {
+  return absl::StrCat(testing::TmpDir(), "/", prefix);
+}
+
+// Writes a base bundle with a [4, 2] "embedding" and a scalar "step", and two
+// deltas: the first changes rows 1 and 3 of "embedding", the second changes
+// row 3 again and "step".
+void WriteChain() {
+  {
+    BundleWriter writer(Env::Default(), Prefix("base"));
+    TF_ASSERT_OK(writer.Add(
+        "embedding", test::AsTensor<float>({0, 0, 1, 1, 2, 2, 3, 3}, {4, 2})));
+    TF_ASSERT_OK(writer.Add("step", test::AsScalar<int64_t>(1)));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  {
+    BundleWriter writer(Env::Default(), Prefix("delta1"));
+    TF_ASSERT_OK(AddDeltaRows(&writer, "embedding",
+                              test::AsTensor<int64_t>({1, 3}),
+                              test::AsTensor<float>({10, 11, 30, 31}, {2, 2})));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  {
+    BundleWriter writer(Env::Default(), Prefix("delta2"));
+    TF_ASSERT_OK(AddDeltaRows(&writer, "embedding",
+                              test::AsTensor<int64_t>({3}),
+                              test::AsTensor<float>({300, 301}, {1, 2})));
+    TF_ASSERT_OK(writer.Add("step", test::AsScalar<int64_t>(3)));
+    TF_ASSERT_OK(writer.Finish());
+  }
+}
+
+TEST(DeltaBundleTest, LookupWithDeltas) {
+  WriteChain();
+  BundleReader base(Env::Default(), Prefix("base"));
+  BundleReader delta1(Env::Default(), Prefix("delta1"));
+  BundleReader delta2(Env::Default(), Prefix("delta2"));
+  TF_ASSERT_OK(base.status());
+  TF_ASSERT_OK(delta1.status());
+  TF_ASSERT_OK(delta2.status());
+
+  Tensor val;
+  TF_ASSERT_OK(LookupWithDeltas({&base, &delta1}, "embedding", &val));
+  test::ExpectTensorEqual<float>(
+      val, test::AsTensor<float>({0, 0, 10, 11, 2, 2, 30, 31}, {4, 2}));
+
+  TF_ASSERT_OK(LookupWithDeltas({&base, &delta1, &delta2}, "embedding", &val));
+  test::ExpectTensorEqual<float>(
+      val, test::AsTensor<float>({0, 0, 10, 11, 2, 2, 300, 301}, {4, 2}));
+  TF_ASSERT_OK(LookupWithDeltas({&base, &delta1, &delta2}, "step", &val));
+  test::ExpectTensorEqual<int64_t>(val, test::AsScalar<int64_t>(3));
+
+  EXPECT_TRUE(
+      absl::IsNotFound(LookupWithDeltas({&delta1}, "embedding", &val)));
+}
+
+TEST(DeltaBundleTest, OutOfRangeRow) {
+  {
+    BundleWriter writer(Env::Default(), Prefix("small_base"));
+    TF_ASSERT_OK(writer.Add("t", test::AsTensor<float>({1, 2}, {2, 1})));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  {
+    BundleWriter writer(Env::Default(), Prefix("bad_delta"));
+    TF_ASSERT_OK(AddDeltaRows(&writer, "t", test::AsTensor<int64_t>({2}),
+                              test::AsTensor<float>({3}, {1, 1})));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  BundleReader base(Env::Default(), Prefix("small_base"));
+  BundleReader delta(Env::Default(), Prefix("bad_delta"));
+  Tensor val;
+  EXPECT_TRUE(absl::IsDataLoss(LookupWithDeltas({&base, &delta}, "t", &val)));
+}
+
+TEST(DeltaBundleTest, AddDeltaRowsValidatesShapes) {
+  BundleWriter writer(Env::Default(), Prefix("invalid_delta"));
+  EXPECT_TRUE(absl::IsInvalidArgument(
+      AddDeltaRows(&writer, "t", test::AsTensor<int64_t>({0, 1}),
+                   test::AsTensor<float>({1}, {1, 1}))));
+  EXPECT_TRUE(absl::IsInvalidArgument(
+      AddDeltaRows(&writer, "t", test::AsTensor<int32>({0}),
+                   test::AsTensor<float>({1}, {1, 1}))));
+}
+
+TEST(DeltaBundleTest, Compact) {
+  WriteChain();
+  const tstring prefixes[] = {Prefix("base"), Prefix("delta1"),
+                              Prefix("delta2")};
+  TF_ASSERT_OK(
+      CompactDeltaBundles(Env::Default(), prefixes, Prefix("compacted")));
+
+  BundleReader reader(Env::Default(), Prefix("compacted"));
+  TF_ASSERT_OK(reader.status());
+  EXPECT_FALSE(reader.Contains(absl::StrCat("embedding", kDeltaRowIdsSuffix)));
+  Tensor val;
+  TF_ASSERT_OK(LookupWithDeltas({&reader}, "embedding", &val));
+  test::ExpectTensorEqual<float>(
+      val, test::AsTensor<float>({0, 0, 10, 11, 2, 2, 300, 301}, {4, 2}));
+  TF_ASSERT_OK(LookupWithDeltas({&reader}, "step", &val));
+  test::ExpectTensorEqual<int64_t>(val, test::AsScalar<int64_t>(3));
+}
+
+}  // namespace
+}  // namespace tensorflow
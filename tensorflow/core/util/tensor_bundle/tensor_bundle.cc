@@ -22,6 +22,8 @@ limitations under the License.
 
 #include "absl/base/call_once.h"
 #include "absl/synchronization/mutex.h"
+#include "tensorflow/core/framework/allocation_description.pb.h"
+#include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/register_types.h"
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/framework/tensor_shape.pb.h"
@@ -87,6 +89,29 @@ const int64_t kMinSectionSize = static_cast<int64_t>(1) << 31;
 
 namespace {
 
+// Buffer of a tensor restored from a memory-mapped data file. It keeps the
+// mapping alive, and doesn't own its memory so that it's never written to.
+class MappedTensorBuffer : public TensorBuffer {
+ public:
+  MappedTensorBuffer(std::shared_ptr<ReadOnlyMemoryRegion> region,
+                     const char* data, size_t size)
+      : TensorBuffer(const_cast<char*>(data)),
+        region_(std::move(region)),
+        size_(size) {}
+
+  size_t size() const override { return size_; }
+  TensorBuffer* root_buffer() override { return this; }
+  void FillAllocationDescription(AllocationDescription* proto) const override {
+    proto->set_requested_bytes(size_);
+    proto->set_allocator_name("mmapped_tensor_bundle");
+  }
+  bool OwnsMemory() const override { return false; }
+
+ private:
+  const std::shared_ptr<ReadOnlyMemoryRegion> region_;
+  const size_t size_;
+};
+
 // Reads "num_elements" string elements from file[offset, offset+size) into the
 // length-N "destination".  Discards the original content of "destination".
 //
@@ -786,6 +811,8 @@ BundleReader::BundleReader(Env* env, StringPiece prefix, Options options)
       table_(nullptr),
       index_cache_(nullptr),
       iter_(nullptr),
+      use_mmap_(options.use_mmap),
+      verify_mapped_checksums_(options.verify_mapped_checksums),
       need_to_swap_bytes_(false),
       enable_multi_threading_for_testing_(
           options.enable_multi_threading_for_testing) {
@@ -880,7 +907,73 @@ Status BundleReader::GetBundleEntryProto(StringPiece key,
   return absl::OkStatus();
 }
 
+Status BundleReader::GetMappedValue(const BundleEntryProto& entry,
+                                    Tensor* val, bool* mapped) {
+  *mapped = false;
+  const TensorShape shape(entry.shape());
+  if (val->NumElements() != 0 &&
+      (val->dtype() != entry.dtype() || val->shape() != shape)) {
+    // Leaves the checks of a mismatched "val" to the read path.
+    return absl::OkStatus();
+  }
+  auto it = mapped_data_.find(entry.shard_id());
+  if (it == mapped_data_.end()) {
+    const std::string filename =
+        DataFilename(prefix_, entry.shard_id(), num_shards_);
+    std::unique_ptr<ReadOnlyMemoryRegion> region;
+    const Status s = env_->NewReadOnlyMemoryRegionFromFile(filename, &region);
+    if (!s.ok()) {
+      VLOG(1) << "Reading " << filename << " instead of mapping it: " << s;
+      region.reset();
+    }
+    it = mapped_data_.emplace(entry.shard_id(), std::move(region)).first;
+  }
+  const std::shared_ptr<ReadOnlyMemoryRegion>& region = it->second;
+  if (region == nullptr) return absl::OkStatus();
+
+  const size_t size = shape.num_elements() * DataTypeSize(entry.dtype());
+  if (entry.size() != size) {
+    return errors::DataLoss("Invalid size in bundle entry: key ", key(),
+                            "; stored size ", entry.size(),
+                            "; expected size ", size);
+  }
+  if (entry.offset() + entry.size() > region->length()) {
+    return errors::DataLoss("Bundle entry ", key(), " at offset ",
+                            entry.offset(), " of ", entry.size(),
+                            " bytes goes past the end of data file shard ",
+                            entry.shard_id(), " (", region->length(),
+                            " bytes)");
+  }
+  const char* data = static_cast<const char*>(region->data()) + entry.offset();
+  if (size == 0 ||
+      reinterpret_cast<uintptr_t>(data) % Allocator::kAllocatorAlignment != 0) {
+    return absl::OkStatus();
+  }
+  if (verify_mapped_checksums_) {
+    const uint32 actual_crc32c = crc32c::Value(data, size);
+    if (crc32c::Unmask(entry.crc32c()) != actual_crc32c) {
+      return errors::DataLoss(
+          "TensorBundle at ", prefix_, " shard ", entry.shard_id(), " (",
+          entry.size(), " bytes): Checksum does not match: stored ",
+          strings::Printf("%08u", crc32c::Unmask(entry.crc32c())),
+          " vs. calculated on the mapped bytes ", actual_crc32c);
+    }
+  }
+  auto* buf = new MappedTensorBuffer(region, data, size);
+  *val = Tensor(entry.dtype(), shape, buf);
+  buf->Unref();
+  *mapped = true;
+  return absl::OkStatus();
+}
+
 Status BundleReader::GetValue(const BundleEntryProto& entry, Tensor* val) {
+  if (use_mmap_ && DataTypeCanUseMemcpy(entry.dtype()) &&
+      !need_to_swap_bytes_) {
+    bool mapped;
+    TF_RETURN_IF_ERROR(GetMappedValue(entry, val, &mapped));
+    if (mapped) return absl::OkStatus();
+  }
+
   Tensor* ret = val;
   const TensorShape stored_shape(TensorShape(entry.shape()));
   if (val->NumElements() == 0) {
@@ -237,6 +237,22 @@ class BundleReader : public AbstractBundleReader {
 
     // For tests only.
     bool enable_multi_threading_for_testing = false;
+
+    // If true, the data files are memory-mapped, and tensors whose type can be
+    // memcpy'ed, that are stored aligned to Allocator::kAllocatorAlignment
+    // (see BundleWriter::Options::data_alignment) and in the endianness of
+    // this machine, are looked up without copying: "Lookup()" then replaces
+    // the buffer of "val" with one pointing into the mapping, which it keeps
+    // alive. Such buffers don't own their memory, so ops copy them rather than
+    // update them in place. Processes mapping the same bundle share its pages.
+    // Other tensors, tensors looked up into a "val" of another dtype or shape,
+    // and data files that can't be mapped, are read as usual.
+    bool use_mmap = false;
+
+    // With "use_mmap", whether the checksum of a mapped tensor is verified
+    // when it's looked up. This reads all of its pages, so callers that want
+    // them to be loaded on first use may turn it off.
+    bool verify_mapped_checksums = true;
   };
   BundleReader(Env* env, absl::string_view prefix, Options options);
 
@@ -334,6 +350,12 @@ class BundleReader : public AbstractBundleReader {
   Status GetValue(const BundleEntryProto& entry,
                   Tensor* val) TF_MUST_USE_RESULT;
 
+  // Makes "val" point into the memory-mapped data file holding the tensor
+  // described by "entry", and sets "mapped" to true, if possible. A "val"
+  // that is already allocated must have the dtype and shape of "entry".
+  Status GetMappedValue(const BundleEntryProto& entry, Tensor* val,
+                        bool* mapped) TF_MUST_USE_RESULT;
+
   // Reads the slice described by "slice_spec".  The corresponding full tensor
   // has key "ful_tensor_key" and metadata proto "full_tensor_entry".
   // REQUIRES: full_tensor_entry.slices_size() > 0
@@ -356,6 +378,13 @@ class BundleReader : public AbstractBundleReader {
   // Owned InputBuffer objects. cache_ owns the underlying RandomAccessFiles.
   std::unordered_map<int32_t, io::InputBuffer*> data_;
 
+  // With Options::use_mmap, the mapped data files, or null for the ones that
+  // can't be mapped. Restored tensors share the ownership of their file.
+  const bool use_mmap_;
+  const bool verify_mapped_checksums_;
+  std::unordered_map<int32_t, std::shared_ptr<ReadOnlyMemoryRegion>>
+      mapped_data_;
+
   // Maps each partitioned tensor's key to its stored slices (represented in a
   // TensorSliceSet).  Populated on-demand.
   std::unordered_map<std::string, checkpoint::TensorSliceSet*> tensor_slices_;
@@ -24,6 +24,8 @@ limitations under the License.
 #endif  // _WIN32
 
 #include "absl/status/status.h"
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/framework/tensor_description.pb.h"
 #include "tensorflow/core/framework/tensor_testutil.h"
 #include "tensorflow/core/framework/tensor_util.h"
 #include "tensorflow/core/framework/types.pb.h"
@@ -1308,6 +1310,79 @@ TEST_F(TensorBundleAlignmentTest, AlignmentTest) {
   }
 }
 
+TEST(TensorBundleTest, MemoryMappedLookup) {
+  {
+    BundleWriter::Options opts;
+    opts.data_alignment = Allocator::kAllocatorAlignment;
+    BundleWriter writer(Env::Default(), Prefix("mmap"), opts);
+    TF_EXPECT_OK(writer.Add("small", Constant(true, TensorShape({1}))));
+    TF_EXPECT_OK(writer.Add("big", Constant_100x100<float>(7)));
+    TF_EXPECT_OK(writer.Add("str", Constant_2x3<tstring>("foo")));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  Tensor big;
+  {
+    BundleReader::Options options;
+    options.use_mmap = true;
+    BundleReader reader(Env::Default(), Prefix("mmap"), options);
+    TF_ASSERT_OK(reader.status());
+    Expect<bool>(&reader, "small", Constant(true, TensorShape({1})));
+    Expect<tstring>(&reader, "str", Constant_2x3<tstring>("foo"));
+    TF_ASSERT_OK(reader.Lookup("big", &big));
+
+    TensorDescription tensor_description;
+    big.FillDescription(&tensor_description);
+    EXPECT_EQ(tensor_description.allocation_description().allocator_name(),
+              "mmapped_tensor_bundle");
+  }
+  // The tensor keeps the mapping alive after the reader is gone.
+  test::ExpectTensorEqual<float>(big, Constant_100x100<float>(7));
+}
+
+TEST(TensorBundleTest, MemoryMappedLookupIntoAllocatedTensor) {
+  {
+    BundleWriter::Options opts;
+    opts.data_alignment = Allocator::kAllocatorAlignment;
+    BundleWriter writer(Env::Default(), Prefix("mmap_allocated"), opts);
+    TF_EXPECT_OK(writer.Add("big", Constant_100x100<float>(7)));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  BundleReader::Options options;
+  options.use_mmap = true;
+  options.verify_mapped_checksums = false;
+  BundleReader reader(Env::Default(), Prefix("mmap_allocated"), options);
+  TF_ASSERT_OK(reader.status());
+
+  Tensor big(DT_FLOAT, TensorShape({100, 100}));
+  TF_ASSERT_OK(reader.Lookup("big", &big));
+  TensorDescription tensor_description;
+  big.FillDescription(&tensor_description);
+  EXPECT_EQ(tensor_description.allocation_description().allocator_name(),
+            "mmapped_tensor_bundle");
+  test::ExpectTensorEqual<float>(big, Constant_100x100<float>(7));
+
+  // A tensor of another shape is not replaced, and fails the size check of
+  // the read path.
+  Tensor wrong_shape(DT_FLOAT, TensorShape({10, 10}));
+  EXPECT_TRUE(errors::IsDataLoss(reader.Lookup("big", &wrong_shape)));
+  EXPECT_EQ(wrong_shape.shape(), TensorShape({10, 10}));
+}
+
+TEST(TensorBundleTest, MemoryMappedLookupOfUnalignedData) {
+  {
+    BundleWriter writer(Env::Default(), Prefix("mmap_unaligned"));
+    TF_EXPECT_OK(writer.Add("a", Constant(true, TensorShape({3}))));
+    TF_EXPECT_OK(writer.Add("b", Constant_2x3<float>(2)));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  BundleReader::Options options;
+  options.use_mmap = true;
+  BundleReader reader(Env::Default(), Prefix("mmap_unaligned"), options);
+  TF_ASSERT_OK(reader.status());
+  Expect<bool>(&reader, "a", Constant(true, TensorShape({3})));
+  Expect<float>(&reader, "b", Constant_2x3<float>(2));
+}
+
 static void BM_BundleAlignment(::testing::benchmark::State& state) {
   {
     const int alignment = state.range(0);
@@ -17,10 +17,19 @@ limitations under the License.
 
 #include <algorithm>
 #include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_cat.h"
 #include "xla/tsl/util/env_var.h"
 #include "tensorflow/core/platform/blocking_counter.h"
+#include "tensorflow/core/platform/env_time.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/profile_utils/cpu_utils.h"
 #include "tsl/profiler/lib/traceme.h"
 
 namespace tensorflow {
@@ -43,8 +52,105 @@ bool UseEigenParallelFor() {
   return result;
 }
 
+// The number of samples after which the learned cost replaces the static
+// estimate.
+constexpr int64_t kMinAdaptiveShardSamples = 4;
+
+// Returns the number of CPU cycles per nanosecond times 1000.
+int64_t MilliCyclesPerNano() {
+  static const int64_t result = []() -> int64_t {
+    const int64_t hz = profile_utils::CpuUtils::GetCycleCounterFrequency();
+    // Assume 1GHz if the frequency is not known on this platform.
+    return hz > 0 ? hz / 1000000 : 1000;
+  }();
+  return result;
+}
+
+struct AdaptiveShardCostRegistry {
+  mutex mu;
+  absl::flat_hash_map<std::pair<std::string, int>,
+                      std::unique_ptr<AdaptiveShardCost>>
+      costs TF_GUARDED_BY(mu);
+};
+
+AdaptiveShardCostRegistry* GlobalAdaptiveShardCosts() {
+  static AdaptiveShardCostRegistry* registry = new AdaptiveShardCostRegistry;
+  return registry;
+}
+
 }  // namespace
 
+int64_t AdaptiveShardCost::learned_cost_per_unit() const {
+  const int64_t scaled = scaled_nanos_per_unit_.load(std::memory_order_relaxed);
+  if (scaled == 0) return 0;
+  return std::max<int64_t>(
+      1, scaled * MilliCyclesPerNano() / (kCostScale * 1000));
+}
+
+int64_t AdaptiveShardCost::CostPerUnit(int64_t static_cost_per_unit) const {
+  if (num_samples() < kMinAdaptiveShardSamples) return static_cost_per_unit;
+  return learned_cost_per_unit();
+}
+
+void AdaptiveShardCost::Record(int64_t units, int64_t nanos) {
+  if (units <= 0 || nanos <= 0) return;
+  const int64_t sample = std::max<int64_t>(1, nanos * kCostScale / units);
+  // Concurrent updates may overwrite each other, which only drops samples.
+  const int64_t old = scaled_nanos_per_unit_.load(std::memory_order_relaxed);
+  scaled_nanos_per_unit_.store(old == 0 ? sample : old + (sample - old) / 8,
+                               std::memory_order_relaxed);
+  num_samples_.fetch_add(1, std::memory_order_relaxed);
+}
+
+int ShardSizeBucket(int64_t total) {
+  int bucket = 0;
+  while (total > 1) {
+    total >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+AdaptiveShardCost* GetAdaptiveShardCost(absl::string_view name, int bucket) {
+  AdaptiveShardCostRegistry* registry = GlobalAdaptiveShardCosts();
+  std::pair<std::string, int> key(std::string(name), bucket);
+  {
+    tf_shared_lock l(registry->mu);
+    auto it = registry->costs.find(key);
+    if (it != registry->costs.end()) return it->second.get();
+  }
+  mutex_lock l(registry->mu);
+  auto& cost = registry->costs[key];
+  if (cost == nullptr) {
+    cost = std::make_unique<AdaptiveShardCost>(key.first, bucket);
+  }
+  return cost.get();
+}
+
+std::string DumpAdaptiveShardCosts() {
+  AdaptiveShardCostRegistry* registry = GlobalAdaptiveShardCosts();
+  std::vector<const AdaptiveShardCost*> costs;
+  {
+    tf_shared_lock l(registry->mu);
+    costs.reserve(registry->costs.size());
+    for (const auto& entry : registry->costs) {
+      costs.push_back(entry.second.get());
+    }
+  }
+  std::sort(costs.begin(), costs.end(),
+            [](const AdaptiveShardCost* a, const AdaptiveShardCost* b) {
+              return std::make_pair(a->name(), a->bucket()) <
+                     std::make_pair(b->name(), b->bucket());
+            });
+  std::string result;
+  for (const AdaptiveShardCost* cost : costs) {
+    absl::StrAppend(&result, cost->name(), " bucket=", cost->bucket(),
+                    " samples=", cost->num_samples(),
+                    " cost_per_unit=", cost->learned_cost_per_unit(), "\n");
+  }
+  return result;
+}
+
 /* ABSL_CONST_INIT */ thread_local int per_thread_max_parallelism = 1000000;
 
 void SetPerThreadMaxParallelism(int max_parallelism) {
@@ -83,6 +189,29 @@ void Shard(int max_parallelism, thread::ThreadPool* workers, int64_t total,
       max_parallelism);
 }
 
+void Shard(int max_parallelism, thread::ThreadPool* workers, int64_t total,
+           int64_t cost_per_unit, AdaptiveShardCost* adaptive_cost,
+           std::function<void(int64_t, int64_t)> work) {
+  if (adaptive_cost == nullptr) {
+    Shard(max_parallelism, workers, total, cost_per_unit, std::move(work));
+    return;
+  }
+  // Every strategy runs exactly one shard that starts at 0, so timing only
+  // that shard costs two clock reads per call.
+  Shard(max_parallelism, workers, total,
+        adaptive_cost->CostPerUnit(cost_per_unit),
+        [adaptive_cost, &work](int64_t start, int64_t limit) {
+          if (start != 0) {
+            work(start, limit);
+            return;
+          }
+          const uint64 start_nanos = EnvTime::NowNanos();
+          work(start, limit);
+          adaptive_cost->Record(limit - start,
+                                EnvTime::NowNanos() - start_nanos);
+        });
+}
+
 // DEPRECATED: Prefer threadpool->ParallelFor with SchedulingStrategy, which
 // allows you to specify the strategy for choosing shard sizes, including using
 // a fixed shard size.
@@ -16,8 +16,12 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_UTIL_WORK_SHARDER_H_
 #define TENSORFLOW_CORE_UTIL_WORK_SHARDER_H_
 
+#include <atomic>
 #include <functional>
+#include <string>
+#include <utility>
 
+#include "absl/strings/string_view.h"
 #include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/platform/types.h"
 
@@ -59,6 +63,71 @@ namespace tensorflow {
 void Shard(int max_parallelism, thread::ThreadPool* workers, int64_t total,
            int64_t cost_per_unit, std::function<void(int64_t, int64_t)> work);
 
+// The cost per unit of work of the Shard() calls made from one call site,
+// learned from the time that those calls actually take.
+//
+// The first shard of every call is timed, and the measured cost per unit
+// replaces the static estimate once a few samples have been recorded. The
+// cost is converted to CPU cycles, so that it is comparable to the static
+// estimates that kernels pass in.
+//
+// All methods are thread-safe.
+class AdaptiveShardCost {
+ public:
+  AdaptiveShardCost(std::string name, int bucket)
+      : name_(std::move(name)), bucket_(bucket) {}
+
+  // Returns the learned cost per unit if enough samples have been recorded,
+  // and `static_cost_per_unit` otherwise.
+  int64_t CostPerUnit(int64_t static_cost_per_unit) const;
+
+  // Records that `units` units of work took `nanos` nanoseconds.
+  void Record(int64_t units, int64_t nanos);
+
+  const std::string& name() const { return name_; }
+  int bucket() const { return bucket_; }
+  int64_t num_samples() const {
+    return num_samples_.load(std::memory_order_relaxed);
+  }
+  // Returns the learned cost per unit in CPU cycles, or 0 if no sample has
+  // been recorded.
+  int64_t learned_cost_per_unit() const;
+
+ private:
+  const std::string name_;
+  const int bucket_;
+  std::atomic<int64_t> num_samples_{0};
+  // Exponential moving average of the nanoseconds per unit, in fixed point
+  // with `kCostScale` steps per nanosecond so that sub-nanosecond costs of
+  // elementwise work are not rounded away.
+  static constexpr int64_t kCostScale = 64;
+  std::atomic<int64_t> scaled_nanos_per_unit_{0};
+
+  AdaptiveShardCost(const AdaptiveShardCost&) = delete;
+  void operator=(const AdaptiveShardCost&) = delete;
+};
+
+// Returns the size bucket of a Shard() call with `total` units of work, for
+// use in GetAdaptiveShardCost(). Sizes within a factor of two of each other
+// share a bucket.
+int ShardSizeBucket(int64_t total);
+
+// Returns the learned costs of the call site identified by `name` (e.g. the
+// kernel type and dtype) and `bucket` (e.g. ShardSizeBucket(total)). The
+// returned object is owned by a process-wide registry and is never deleted.
+AdaptiveShardCost* GetAdaptiveShardCost(absl::string_view name, int bucket);
+
+// Returns one line per call site registered by GetAdaptiveShardCost(), with
+// its name, bucket, number of samples and learned cost per unit.
+std::string DumpAdaptiveShardCosts();
+
+// Like Shard() above, but shards with the cost per unit learned by
+// `adaptive_cost`, using `cost_per_unit` until enough samples are recorded.
+// If `adaptive_cost` is nullptr, this is equivalent to Shard() above.
+void Shard(int max_parallelism, thread::ThreadPool* workers, int64_t total,
+           int64_t cost_per_unit, AdaptiveShardCost* adaptive_cost,
+           std::function<void(int64_t, int64_t)> work);
+
 // Each thread has an associated option to express the desired maximum
 // parallelism. Its default is a very large quantity.
 //
@@ -18,9 +18,11 @@ limitations under the License.
 #include <algorithm>
 #include <atomic>
 #include <functional>
+#include <string>
 #include <vector>
 
 #include "tensorflow/core/lib/core/threadpool.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/test.h"
@@ -93,6 +95,42 @@ TEST(Shard, OverflowTest) {
   }
 }
 
+TEST(Shard, AdaptiveCost) {
+  thread::ThreadPool threads(Env::Default(), "test", 8);
+  AdaptiveShardCost* cost = GetAdaptiveShardCost("AdaptiveCostTest", 10);
+  EXPECT_EQ(cost, GetAdaptiveShardCost("AdaptiveCostTest", 10));
+  EXPECT_NE(cost, GetAdaptiveShardCost("AdaptiveCostTest", 11));
+  EXPECT_EQ(0, cost->learned_cost_per_unit());
+  // The static estimate is used until enough samples are recorded.
+  EXPECT_EQ(1234, cost->CostPerUnit(1234));
+
+  const int64_t total = 1 << 10;
+  for (int i = 0; i < 8; ++i) {
+    std::vector<std::atomic<int>> done(total);
+    for (auto& d : done) d = 0;
+    Shard(8, &threads, total, 1234, cost,
+          [&done](int64_t start, int64_t limit) {
+            for (int64_t j = start; j < limit; ++j) {
+              done[j].fetch_add(1);
+              Env::Default()->SleepForMicroseconds(1);
+            }
+          });
+    for (const auto& d : done) ASSERT_EQ(1, d.load());
+  }
+  EXPECT_EQ(8, cost->num_samples());
+  EXPECT_GT(cost->learned_cost_per_unit(), 0);
+  EXPECT_EQ(cost->learned_cost_per_unit(), cost->CostPerUnit(1234));
+  EXPECT_NE(std::string::npos,
+            DumpAdaptiveShardCosts().find("AdaptiveCostTest bucket=10"));
+}
+
+TEST(Shard, ShardSizeBucket) {
+  EXPECT_EQ(0, ShardSizeBucket(1));
+  EXPECT_EQ(1, ShardSizeBucket(2));
+  EXPECT_EQ(1, ShardSizeBucket(3));
+  EXPECT_EQ(10, ShardSizeBucket(1024));
+}
+
 void BM_Sharding(::testing::benchmark::State& state) {
   const int arg = state.range(0);
 
@@ -182,5 +182,16 @@ bool EnableMultiDeviceMode() {
       "DTENSOR_ENABLE_MULTI_DEVICE_EXPANSION", false, &multi_device_mode);
   return status.ok() && multi_device_mode;
 }
+
+bool EnableCostBasedLayoutPropagation() {
+  static bool is_enabled = [] {
+    bool ret = false;
+    TF_CHECK_OK(tsl::ReadBoolFromEnvVar(
+        "DTENSOR_ENABLE_COST_BASED_LAYOUT_PROPAGATION",
+        /*default_val=*/false, &ret));
+    return ret;
+  }();
+  return is_enabled;
+}
 }  // namespace dtensor
 }  // namespace tensorflow
@@ -86,6 +86,11 @@ int AllReduceCombineOptimizationTopologicalDistance();
 
 // Returns whether to perform multi-device expansion.
 bool EnableMultiDeviceMode();
+
+// Returns whether layout propagation chooses the layout of each value by
+// estimating the communication volume of the relayouts it causes, instead of
+// only with the rule-based merge.
+bool EnableCostBasedLayoutPropagation();
 }  // namespace dtensor
 }  // namespace tensorflow
 
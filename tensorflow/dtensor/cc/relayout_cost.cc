@@ -0,0 +1,97 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/dtensor/cc/relayout_cost.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tensorflow/dtensor/cc/tensor_layout.h"
+
+namespace tensorflow {
+namespace dtensor {
+namespace {
+
+// Returns the number of shards of `spec` over `mesh`, 1 for the specs that
+// aren't mesh dimensions (unsharded, any or match).
+int64_t NumShards(const Mesh& mesh, const std::string& spec) {
+  if (!mesh.IsMeshDim(spec)) return 1;
+  return mesh.dim_size(spec).value();
+}
+
+}  // namespace
+
+bool MeshDimSpansHosts(const Mesh& mesh, absl::string_view dim) {
+  const int64_t num_local_devices = mesh.num_local_devices();
+  if (num_local_devices == 0 || num_local_devices >= mesh.size()) return false;
+  const std::vector<int64> dim_sizes = mesh.dim_sizes();
+  // The number of consecutive devices spanned by one step along `dim`.
+  int64_t stride = 1;
+  for (int i = mesh.rank() - 1; i >= 0; --i) {
+    if (mesh.dim_name(i) == dim) {
+      return stride * dim_sizes[i] > num_local_devices;
+    }
+    stride *= dim_sizes[i];
+  }
+  return false;
+}
+
+double EstimateRelayoutCost(const Layout& from, const Layout& to,
+                            absl::Span<const int64_t> global_shape,
+                            int64_t element_size) {
+  const Mesh& mesh = from.mesh();
+  // The local shard of `to`, and the fraction of it that is already local.
+  double to_local_bytes = element_size;
+  double local_fraction = 1.0;
+  bool spans_hosts = false;
+  for (int i = 0; i < from.rank() && i < to.rank(); ++i) {
+    const std::string& from_spec = from.sharding_spec(i);
+    const std::string& to_spec = to.sharding_spec(i);
+    const int64_t dim_size =
+        i < global_shape.size() && global_shape[i] > 0 ? global_shape[i] : 1;
+    to_local_bytes *= static_cast<double>(dim_size) / NumShards(mesh, to_spec);
+    if (from_spec == to_spec || !mesh.IsMeshDim(from_spec)) continue;
+    local_fraction /= NumShards(mesh, from_spec);
+    spans_hosts |= MeshDimSpansHosts(mesh, from_spec);
+  }
+  const double cost = to_local_bytes * (1.0 - local_fraction);
+  return spans_hosts ? cost * kCrossHostRelayoutCostFactor : cost;
+}
+
+std::string DescribeRelayout(const Layout& from, const Layout& to) {
+  const Mesh& mesh = from.mesh();
+  std::vector<std::string> collectives;
+  for (int i = 0; i < from.rank() && i < to.rank(); ++i) {
+    const std::string& from_spec = from.sharding_spec(i);
+    const std::string& to_spec = to.sharding_spec(i);
+    if (from_spec == to_spec || !mesh.IsMeshDim(from_spec)) continue;
+    if (mesh.IsMeshDim(to_spec)) {
+      collectives.push_back(absl::StrCat("all-to-all(", from_spec, "->",
+                                         to_spec, ") on dim ", i));
+    } else {
+      collectives.push_back(
+          absl::StrCat("all-gather(", from_spec, ") on dim ", i));
+    }
+  }
+  return collectives.empty() ? "none" : absl::StrJoin(collectives, ", ");
+}
+
+}  // namespace dtensor
+}  // namespace tensorflow
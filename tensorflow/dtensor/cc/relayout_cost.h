@@ -0,0 +1,55 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_DTENSOR_CC_RELAYOUT_COST_H_
+#define TENSORFLOW_DTENSOR_CC_RELAYOUT_COST_H_
+
+#include <cstdint>
+#include <string>
+
+#include "absl/types/span.h"
+#include "tensorflow/dtensor/cc/tensor_layout.h"
+
+namespace tensorflow {
+namespace dtensor {
+
+// The traffic over mesh dimensions that span several hosts is weighted by this
+// factor, as it goes over the network instead of the device interconnect.
+inline constexpr double kCrossHostRelayoutCostFactor = 8.0;
+
+// Returns true if the devices along mesh dimension `dim` of `mesh` are on
+// more than one host. The devices of a host are assumed to be consecutive in
+// the row-major order of the mesh.
+bool MeshDimSpansHosts(const Mesh& mesh, absl::string_view dim);
+
+// Estimates the bytes each device receives to relayout a tensor of
+// `global_shape` with `element_size` byte elements from `from` to `to`, both
+// on the same mesh. Unsharding a dimension is an all-gather, resharding it
+// over another mesh dimension is an all-to-all, and sharding an unsharded
+// dimension is a local slice that costs nothing. Unknown dimensions count as
+// size 1. Traffic over mesh dimensions that span hosts is weighted by
+// kCrossHostRelayoutCostFactor.
+double EstimateRelayoutCost(const Layout& from, const Layout& to,
+                            absl::Span<const int64_t> global_shape,
+                            int64_t element_size);
+
+// Describes the collectives of relayouting from `from` to `to`, e.g.
+// "all-gather(x) on dim 0, all-to-all(y->x) on dim 1", or "none".
+std::string DescribeRelayout(const Layout& from, const Layout& to);
+
+}  // namespace dtensor
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_DTENSOR_CC_RELAYOUT_COST_H_
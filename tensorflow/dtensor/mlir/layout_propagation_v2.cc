@@ -14,6 +14,7 @@ limitations under the License.
 ==============================================================================*/
 
 #include <algorithm>
+#include <cstdint>
 #include <deque>
 #include <iterator>
 #include <memory>
@@ -21,6 +22,7 @@ limitations under the License.
 #include <queue>
 #include <set>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
@@ -65,6 +67,7 @@ limitations under the License.
 #include "tensorflow/dtensor/cc/constants.h"
 #include "tensorflow/dtensor/cc/dstatus.h"
 #include "tensorflow/dtensor/cc/dtensor_utils.h"
+#include "tensorflow/dtensor/cc/relayout_cost.h"
 #include "tensorflow/dtensor/cc/tensor_layout.h"
 #include "tensorflow/dtensor/mlir/dtensor_dialect/ir/dialect.h"
 #include "tensorflow/dtensor/mlir/dtensor_dialect/ir/dtensor_attributes.h"
@@ -201,6 +204,38 @@ void FilterkAnySpecs(std::vector<std::string>& proposed_specs) {
     if (spec == Layout::kAny) spec = Layout::kUnshardedDim;
   }
 }
+
+// Returns the global shape and the element size in bytes of `value`, for
+// estimating the cost of its relayouts. Returns false if `value` isn't a
+// ranked tensor.
+bool GetShapeAndElementSize(mlir::Value value, std::vector<int64_t>& shape,
+                            int64_t& element_size) {
+  auto type = mlir::dyn_cast<mlir::RankedTensorType>(GetSubtypeOrSelf(value));
+  if (!type) return false;
+  shape.assign(type.getShape().begin(), type.getShape().end());
+  const mlir::Type element_type = type.getElementType();
+  element_size = element_type.isIntOrFloat()
+                     ? std::max<int64_t>(
+                           1, element_type.getIntOrFloatBitWidth() / 8)
+                     : 1;
+  return true;
+}
+
+// Estimates the relayouts from the producer layout to `layout` and from
+// `layout` to each of the consumer layouts.
+double EstimateMergedLayoutCost(
+    const Layout& layout, const absl::optional<Layout>& producer,
+    const mlir::DenseMap<mlir::OpOperand*, Layout>& consumers,
+    const std::vector<int64_t>& shape, int64_t element_size) {
+  double cost = 0;
+  if (producer) {
+    cost += EstimateRelayoutCost(*producer, layout, shape, element_size);
+  }
+  for (const auto& consumer : consumers) {
+    cost += EstimateRelayoutCost(layout, consumer.second, shape, element_size);
+  }
+  return cost;
+}
 }  // namespace
 
 // Merges the producer and consumer layouts into a single layout.
@@ -213,7 +248,7 @@ void FilterkAnySpecs(std::vector<std::string>& proposed_specs) {
 // where the producer is unshared *and* the mesh dimension it wants to be
 // sharded over is not already sharded over by the producer, then we add that
 // sharding to the producer layout.
-StatusOr<Layout> MergeLayouts(
+StatusOr<Layout> MergeLayoutsByRules(
     const mlir::Value& producer_value, const absl::optional<Layout>& producer,
     const mlir::DenseMap<mlir::OpOperand*, Layout>& consumers) {
   if (consumers.empty()) return producer.value();
@@ -317,6 +352,100 @@ StatusOr<Layout> MergeLayouts(
   return Layout::GetLayout(producer->type(), proposed_specs, mesh);
 }
 
+// Merges the producer and consumer layouts with MergeLayoutsByRules. With
+// cost-based layout propagation, the producer layout or one of the consumer
+// layouts is picked instead when its estimated relayout volume is lower than
+// that of the rule-based merge, e.g. when replicating a value that all but one
+// of its consumers want sharded would all-gather it for nothing.
+StatusOr<Layout> MergeLayouts(
+    const mlir::Value& producer_value, const absl::optional<Layout>& producer,
+    const mlir::DenseMap<mlir::OpOperand*, Layout>& consumers) {
+  TF_ASSIGN_OR_RETURN(
+      Layout merged,
+      MergeLayoutsByRules(producer_value, producer, consumers));
+  if (!EnableCostBasedLayoutPropagation() || consumers.empty()) return merged;
+  std::vector<int64_t> shape;
+  int64_t element_size;
+  if (!GetShapeAndElementSize(producer_value, shape, element_size)) {
+    return merged;
+  }
+
+  absl::optional<Layout> costed_producer = producer;
+  if (producer &&
+      IsProducerResourceOpWithEmptyLayout(producer_value, *producer)) {
+    costed_producer.reset();
+  }
+  std::vector<const Layout*> candidates;
+  if (costed_producer) candidates.push_back(&*costed_producer);
+  for (const auto& consumer : consumers) candidates.push_back(&consumer.second);
+
+  Layout best = merged;
+  double best_cost = EstimateMergedLayoutCost(merged, costed_producer,
+                                              consumers, shape, element_size);
+  for (const Layout* candidate : candidates) {
+    if (candidate->mesh() != merged.mesh() ||
+        candidate->rank() != merged.rank()) {
+      continue;
+    }
+    std::vector<std::string> specs = candidate->sharding_spec_strs();
+    FilterkAnySpecs(specs);
+    StatusOr<Layout> layout =
+        Layout::GetLayout(merged.type(), specs, merged.mesh());
+    if (!layout.ok()) continue;
+    const double cost = EstimateMergedLayoutCost(
+        *layout, costed_producer, consumers, shape, element_size);
+    if (cost < best_cost) {
+      best = *std::move(layout);
+      best_cost = cost;
+    }
+  }
+  return best;
+}
+
+// Logs the relayouts left by the propagated layouts and their estimated
+// communication volume, most expensive first.
+void LogCommunicationPlan(
+    const llvm::DenseMap<mlir::Value, Layout>& merged_layouts,
+    llvm::DenseMap<mlir::Value, std::optional<Layout>>& producer_request,
+    llvm::DenseMap<mlir::Value, mlir::DenseMap<mlir::OpOperand*, Layout>>&
+        consumer_requests) {
+  constexpr int kMaxLoggedRelayouts = 20;
+  // Cost, value name and collectives of each relayout.
+  std::vector<std::tuple<double, std::string, std::string>> relayouts;
+  double total_cost = 0;
+  for (const auto& [value, layout] : merged_layouts) {
+    std::vector<int64_t> shape;
+    int64_t element_size;
+    if (!GetShapeAndElementSize(value, shape, element_size)) continue;
+    auto add_relayout = [&](const Layout& from, const Layout& to) {
+      if (from.mesh() != to.mesh() || from.rank() != to.rank()) return;
+      const double cost = EstimateRelayoutCost(from, to, shape, element_size);
+      if (cost == 0) return;
+      total_cost += cost;
+      relayouts.emplace_back(cost, mlir::GetNameFromLoc(value.getLoc()),
+                             DescribeRelayout(from, to));
+    };
+    if (const auto& producer = producer_request[value]; producer) {
+      add_relayout(*producer, layout);
+    }
+    for (const auto& consumer : consumer_requests[value]) {
+      add_relayout(layout, consumer.second);
+    }
+  }
+  std::sort(relayouts.begin(), relayouts.end(),
+            [](const auto& a, const auto& b) {
+              return std::get<0>(a) > std::get<0>(b);
+            });
+  LOG(INFO) << "DTensor layout propagation left " << relayouts.size()
+            << " relayouts, estimated at " << total_cost
+            << " bytes received per device.";
+  for (int i = 0; i < relayouts.size() && i < kMaxLoggedRelayouts; ++i) {
+    const auto& [cost, name, collectives] = relayouts[i];
+    LOG(INFO) << "  " << name << ": " << collectives << ", " << cost
+              << " bytes";
+  }
+}
+
 mlir::LogicalResult InsertLayoutsForDTensorLayout(
     mlir::ModuleOp& module,
     llvm::DenseMap<mlir::Value, std::optional<Layout>>& producer_request,
@@ -1591,6 +1720,11 @@ struct DLayoutPropagationPassV2
     if (!AllOpResultsHaveLayouts(&module, tf_dialect, merged_layouts))
       return signalPassFailure();
 
+    if (EnableCostBasedLayoutPropagation()) {
+      LogCommunicationPlan(merged_layouts, producer_request,
+                           consumer_requests);
+    }
+
     if (mlir::failed(InsertDTensorLayoutOps(builder, merged_layouts)))
       return signalPassFailure();
 
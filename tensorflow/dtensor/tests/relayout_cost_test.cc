@@ -0,0 +1,98 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/dtensor/cc/relayout_cost.h"
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/dtensor/cc/tensor_layout.h"
+#include "tsl/platform/statusor.h"
+
+namespace tensorflow {
+namespace dtensor {
+namespace {
+
+// A 2x2 mesh over two hosts of two devices each: "y" stays on a host, "x"
+// spans both.
+Mesh TwoHostMesh() {
+  std::vector<std::string> devices;
+  for (int i = 0; i < 4; ++i) {
+    devices.push_back(absl::StrCat("/job:localhost/task:", i / 2,
+                                   "/device:CPU:", i % 2));
+  }
+  return Mesh::CreateMesh("mesh", /*dim_names=*/{"x", "y"},
+                          /*mesh_shape=*/{2, 2},
+                          /*global_device_ids=*/{0, 1, 2, 3},
+                          /*global_devices_str=*/devices,
+                          /*local_device_ids=*/{0, 1},
+                          /*local_devices_str=*/{devices[0], devices[1]},
+                          /*use_xla_spmd=*/false);
+}
+
+Layout MakeLayout(const std::vector<std::string>& specs, const Mesh& mesh) {
+  return Layout::GetLayout(specs, mesh).value();
+}
+
+TEST(RelayoutCostTest, MeshDimSpansHosts) {
+  const Mesh mesh = TwoHostMesh();
+  EXPECT_TRUE(MeshDimSpansHosts(mesh, "x"));
+  EXPECT_FALSE(MeshDimSpansHosts(mesh, "y"));
+}
+
+TEST(RelayoutCostTest, SameLayoutAndSlicingAreFree) {
+  const Mesh mesh = TwoHostMesh();
+  const Layout sharded = MakeLayout({"y", Layout::kUnshardedDim}, mesh);
+  const Layout replicated =
+      MakeLayout({Layout::kUnshardedDim, Layout::kUnshardedDim}, mesh);
+  EXPECT_EQ(EstimateRelayoutCost(sharded, sharded, {8, 8}, 4), 0.0);
+  EXPECT_EQ(EstimateRelayoutCost(replicated, sharded, {8, 8}, 4), 0.0);
+  EXPECT_EQ(DescribeRelayout(replicated, sharded), "none");
+}
+
+TEST(RelayoutCostTest, AllGatherCost) {
+  const Mesh mesh = TwoHostMesh();
+  const Layout replicated =
+      MakeLayout({Layout::kUnshardedDim, Layout::kUnshardedDim}, mesh);
+  // Half of the 8x8 float tensor is gathered from the other device.
+  EXPECT_EQ(EstimateRelayoutCost(MakeLayout({"y", Layout::kUnshardedDim}, mesh),
+                                 replicated, {8, 8}, 4),
+            128.0);
+  // The same gather across hosts is weighted.
+  EXPECT_EQ(EstimateRelayoutCost(MakeLayout({"x", Layout::kUnshardedDim}, mesh),
+                                 replicated, {8, 8}, 4),
+            128.0 * kCrossHostRelayoutCostFactor);
+  EXPECT_EQ(DescribeRelayout(MakeLayout({"x", Layout::kUnshardedDim}, mesh),
+                             replicated),
+            "all-gather(x) on dim 0");
+}
+
+TEST(RelayoutCostTest, MovingTheShardedDimension) {
+  const Mesh mesh = TwoHostMesh();
+  const Layout from = MakeLayout({"y", Layout::kUnshardedDim}, mesh);
+  const Layout to = MakeLayout({Layout::kUnshardedDim, "y"}, mesh);
+  // Half of the 8x4 local shard of `to` is received.
+  EXPECT_EQ(EstimateRelayoutCost(from, to, {8, 8}, 4), 64.0);
+  EXPECT_EQ(DescribeRelayout(from, to), "all-gather(y) on dim 0");
+  EXPECT_EQ(DescribeRelayout(from, MakeLayout({"x", Layout::kUnshardedDim},
+                                              mesh)),
+            "all-to-all(y->x) on dim 0");
+}
+
+}  // namespace
+}  // namespace dtensor
+}  // namespace tensorflow
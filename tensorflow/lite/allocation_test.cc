@@ -140,6 +140,22 @@ TEST(MMAPAllocation, TestValidFileDescriptorWithOffset) {
 
   close(fd);
 }
+
+TEST(MMAPAllocation, TestAdviseRandomAccess) {
+  if (!MMAPAllocation::IsSupported()) {
+    return;
+  }
+
+  TestErrorReporter error_reporter;
+  MMAPAllocation allocation(
+      "tensorflow/lite/testdata/empty_model.bin", &error_reporter);
+  ASSERT_TRUE(allocation.valid());
+
+  EXPECT_TRUE(allocation.AdviseRandomAccess(0, allocation.bytes()));
+  EXPECT_TRUE(allocation.AdviseRandomAccess(allocation.bytes(), 0));
+  EXPECT_FALSE(allocation.AdviseRandomAccess(0, allocation.bytes() + 1));
+  EXPECT_FALSE(allocation.AdviseRandomAccess(allocation.bytes() + 1, 0));
+}
 #endif  // defined(__linux__)
 
 }  // namespace tflite
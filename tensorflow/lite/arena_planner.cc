@@ -33,6 +33,8 @@ constexpr int32_t kLastActiveNodeUndefined =
     std::numeric_limits<int32_t>::max();
 constexpr int32_t kNodeNotAssigned = std::numeric_limits<int32_t>::max();
 constexpr int32_t kScalarTensorBytes = 4;
+// The number of plans in ArenaPlanner::cached_arena_plans_.
+constexpr size_t kMaxCachedArenaPlans = 4;
 
 ArenaPlanner::ArenaPlanner(TfLiteContext* context,
                            std::unique_ptr<GraphInfo> graph_info,
@@ -509,7 +511,8 @@ TfLiteStatus ArenaPlanner::CalculateAllocations(
     last_active_node_ = last_node;
     return kTfLiteOk;
   }
-  if (first_node < last_active_node_) {
+  const bool arena_reset = first_node < last_active_node_;
+  if (arena_reset) {
     arena_.ResetAllocs();
     last_active_node_ = first_node;
   } else {
@@ -518,7 +521,8 @@ TfLiteStatus ArenaPlanner::CalculateAllocations(
     arena_.PurgeActiveAllocs(first_node);
   }
   CreateTensorAllocationVector(tensors_allocated);
-  // Vector of ids of already allocated tensors, ordered by offset.
+  // The tensors to allocate in arena_, in allocation order.
+  std::vector<ArenaAllocWithUsageInterval> arena_allocs;
   for (const auto& tensor_index : *tensors_allocated) {
     TfLiteTensor& tensor = tensors[tensor_index];
     // Only allocate ArenaRw tensors which own their buffer.
@@ -541,10 +545,12 @@ TfLiteStatus ArenaPlanner::CalculateAllocations(
       }
     }
     if (tensor.allocation_type == kTfLiteArenaRw) {
-      TF_LITE_ENSURE_STATUS(
-          arena_.Allocate(context_, tensor_alignment_, tensor.bytes,
-                          tensor_index, alloc_node_[tensor_index],
-                          dealloc_node_[tensor_index], &allocs_[tensor_index]));
+      ArenaAllocWithUsageInterval alloc;
+      alloc.size = tensor.bytes;
+      alloc.tensor = tensor_index;
+      alloc.first_node = alloc_node_[tensor_index];
+      alloc.last_node = dealloc_node_[tensor_index];
+      arena_allocs.push_back(alloc);
     }
     // Check allocs_[].size to prevent from reallocation of persistent tensors.
     // Only allocate ArenaRwPersistent tensors which own their buffer.
@@ -559,10 +565,53 @@ TfLiteStatus ArenaPlanner::CalculateAllocations(
       }
     }
   }
+  TF_LITE_ENSURE_STATUS(AllocateInArena(arena_reset, &arena_allocs));
   last_active_node_ = last_node;
   return kTfLiteOk;
 }
 
+TfLiteStatus ArenaPlanner::AllocateInArena(
+    bool arena_reset, std::vector<ArenaAllocWithUsageInterval>* arena_allocs) {
+  if (arena_reset) {
+    // The offsets only depend on the allocs requested, in order.
+    auto same_request = [](const ArenaAllocWithUsageInterval& a,
+                           const ArenaAllocWithUsageInterval& b) {
+      return a.tensor == b.tensor && a.size == b.size &&
+             a.first_node == b.first_node && a.last_node == b.last_node;
+    };
+    auto it = std::find_if(
+        cached_arena_plans_.begin(), cached_arena_plans_.end(),
+        [&](const std::vector<ArenaAllocWithUsageInterval>& plan) {
+          return std::equal(plan.begin(), plan.end(), arena_allocs->begin(),
+                            arena_allocs->end(), same_request);
+        });
+    if (it != cached_arena_plans_.end()) {
+      std::rotate(cached_arena_plans_.begin(), it, it + 1);
+      const std::vector<ArenaAllocWithUsageInterval>& plan =
+          cached_arena_plans_.front();
+      arena_.AddAllocs(plan);
+      for (const ArenaAllocWithUsageInterval& alloc : plan) {
+        allocs_[alloc.tensor] = alloc;
+      }
+      return kTfLiteOk;
+    }
+  }
+  for (ArenaAllocWithUsageInterval& alloc : *arena_allocs) {
+    TF_LITE_ENSURE_STATUS(arena_.Allocate(
+        context_, tensor_alignment_, alloc.size, alloc.tensor,
+        alloc.first_node, alloc.last_node, &allocs_[alloc.tensor]));
+    alloc = allocs_[alloc.tensor];
+  }
+  if (arena_reset) {
+    if (cached_arena_plans_.size() == kMaxCachedArenaPlans) {
+      cached_arena_plans_.pop_back();
+    }
+    cached_arena_plans_.insert(cached_arena_plans_.begin(),
+                               std::move(*arena_allocs));
+  }
+  return kTfLiteOk;
+}
+
 bool AreTensorsAllocatedInSameArena(int32_t root_tensor_index,
                                     int32_t tensor_index,
                                     const TfLiteTensor* tensors) {
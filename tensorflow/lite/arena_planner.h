@@ -104,6 +104,12 @@ class ArenaPlanner : public MemoryPlanner {
   TfLiteStatus CalculateAllocations(int first_node, int last_node,
                                     std::vector<int32_t>* tensors_allocated);
 
+  // Reserves space in arena_ for `arena_allocs`, in order, and sets their
+  // offsets. `arena_reset` tells whether arena_ holds no allocs, in which case
+  // the plan is looked up in and added to `cached_arena_plans_`.
+  TfLiteStatus AllocateInArena(
+      bool arena_reset, std::vector<ArenaAllocWithUsageInterval>* arena_allocs);
+
   // Assign absolute memory location to a tensor, based on its relative
   // position inside the corresponding arena buffer.
   TfLiteStatus ResolveTensorAllocation(int32_t tensor_index,
@@ -159,6 +165,11 @@ class ArenaPlanner : public MemoryPlanner {
   // Index of the last node whose tensors were allocated.
   int last_active_node_;
 
+  // The allocs of the last plans of arena_ computed from scratch, most
+  // recently used first. Resizing the inputs back to shapes seen recently then
+  // reuses the offsets found for them instead of searching for gaps again.
+  std::vector<std::vector<ArenaAllocWithUsageInterval>> cached_arena_plans_;
+
   // Holds index of original tensor if the tensor is sharing underlined
   // data with another tensor.
   // NOLINTNEXTLINE - absl::flat_hash_map increases binary size by 106kB.
@@ -370,6 +370,38 @@ TEST_F(ArenaPlannerTest, AllocsCorrectlyReset) {
   EXPECT_EQ(GetOffset(1), 4);
 }
 
+TEST_F(ArenaPlannerTest, ReusesPlansOfRecentSizes) {
+  TestGraph graph({0, 1},
+                  {
+                      /* in, out, tmp */
+                      {{0, 1}, {2}, {}},     // First op
+                      {{2, 0}, {4, 5}, {}},  // Second op
+                      {{4, 5}, {3}, {}}      // Third op
+                  },
+                  {3});
+  SetGraph(&graph);
+  std::vector<TfLiteTensor>& tensors = *graph.tensors();
+  auto get_offsets = [&]() {
+    std::vector<std::ptrdiff_t> offsets;
+    for (int i = 0; i < tensors.size(); ++i) offsets.push_back(GetOffset(i));
+    return offsets;
+  };
+  Execute(0, graph.nodes().size() - 1);
+  const std::vector<std::ptrdiff_t> offsets = get_offsets();
+
+  // Grow tensor 2 enough to change the plan, then shrink it back: the offsets
+  // are the same as for the first plan.
+  ResetAllocations();
+  tensors[2].bytes += 100;
+  Execute(0, graph.nodes().size() - 1);
+  EXPECT_NE(get_offsets(), offsets);
+
+  ResetAllocations();
+  tensors[2].bytes -= 100;
+  Execute(0, graph.nodes().size() - 1);
+  EXPECT_EQ(get_offsets(), offsets);
+}
+
 TEST_F(ArenaPlannerTest, SimpleGraphInputsPreserved) {
   TestGraph graph({0, 1},
                   {
@@ -328,6 +328,8 @@ typedef enum TfLiteQuantizationType : int {
   /// Affine quantization (with support for per-channel quantization).
   /// Corresponds to TfLiteAffineQuantization.
   kTfLiteAffineQuantization = 1,
+  /// Blockwise quantization. Corresponds to TfLiteBlockwiseQuantization.
+  kTfLiteBlockwiseQuantization = 2,
 } TfLiteQuantizationType;
 
 /// Structure specifying the quantization used by the tensor, if-any.
@@ -353,6 +355,22 @@ typedef struct TfLiteAffineQuantization {
   int32_t quantized_dimension;
 } TfLiteAffineQuantization;
 
+/// Parameters for symmetric quantization by blocks of `blocksize` consecutive
+/// values along the last dimension.
+/// `scale` is the index of the tensor holding the scale of each block, of the
+/// shape of the quantized tensor with its last dimension divided by
+/// `blocksize`. `zero_point` is the index of the tensor holding the zero point
+/// of each block, or -1 if they are all 0. `quantized_dimension` is the channel
+/// dimension, as in TfLiteAffineQuantization.
+/// Quantized values can be converted back to float using:
+///     `real_value = scale[block] * (quantized_value - zero_point[block])`
+typedef struct TfLiteBlockwiseQuantization {
+  int32_t scale;
+  int32_t zero_point;
+  int32_t blocksize;
+  int32_t quantized_dimension;
+} TfLiteBlockwiseQuantization;
+
 /// A union of pointers that points to memory for a given tensor.
 ///
 /// Do not access these members directly, if possible, use
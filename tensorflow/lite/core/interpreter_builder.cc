@@ -408,6 +408,29 @@ TfLiteStatus InterpreterBuilder::ParseQuantization(
     const QuantizationParameters* src_quantization,
     TfLiteQuantization* quantization, const std::vector<int>& dims) {
   quantization->type = kTfLiteNoQuantization;
+  if (src_quantization && src_quantization->details_type() ==
+                              QuantizationDetails_BlockwiseQuantization) {
+    const auto* src_blockwise =
+        src_quantization->details_as_BlockwiseQuantization();
+    if (src_blockwise->block_size() <= 0) {
+      TF_LITE_REPORT_ERROR(error_reporter_,
+                           "Blockwise quantization block_size must be "
+                           "positive, but got %d.",
+                           src_blockwise->block_size());
+      return kTfLiteError;
+    }
+    quantization->type = kTfLiteBlockwiseQuantization;
+    auto* blockwise_quantization =
+        reinterpret_cast<TfLiteBlockwiseQuantization*>(
+            malloc(sizeof(TfLiteBlockwiseQuantization)));
+    blockwise_quantization->scale = src_blockwise->scales();
+    blockwise_quantization->zero_point = src_blockwise->zero_points();
+    blockwise_quantization->blocksize = src_blockwise->block_size();
+    blockwise_quantization->quantized_dimension =
+        src_quantization->quantized_dimension();
+    quantization->params = reinterpret_cast<void*>(blockwise_quantization);
+    return kTfLiteOk;
+  }
   if (!src_quantization || !src_quantization->scale() ||
       src_quantization->scale()->size() == 0) {
     return kTfLiteOk;
@@ -647,6 +670,22 @@ TfLiteStatus InterpreterBuilder::ParseTensors(
           *buffer_size = buffer->size();
           *buffer_data =
               reinterpret_cast<const char*>(allocation_->base()) + offset;
+          // The data is used in place, so it must be aligned for its type.
+          const size_t type_size = TfLiteTypeGetSize(type);
+          if (type_size > 1 &&
+              reinterpret_cast<uintptr_t>(*buffer_data) % type_size != 0) {
+            TF_LITE_REPORT_ERROR(
+                error_reporter_,
+                "Constant buffer %d at offset %llu is not aligned for its "
+                "type.\n",
+                tensor->buffer(), static_cast<unsigned long long>(offset));
+            return kTfLiteError;
+          }
+          if (options_.GetLazyLoadOffsetBuffers() &&
+              allocation_->type() == Allocation::Type::kMMap) {
+            static_cast<const MMAPAllocation*>(allocation_)
+                ->AdviseRandomAccess(offset, buffer->size());
+          }
           return kTfLiteOk;
         }
       }
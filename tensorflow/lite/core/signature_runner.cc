@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/lite/core/signature_runner.h"
 
+#include <cstring>
 #include <vector>
 
 #include "tensorflow/lite/c/common.h"
@@ -118,6 +119,86 @@ TfLiteStatus SignatureRunner::Invoke() {
   return kTfLiteOk;
 }
 
+namespace {
+
+// Returns true if `tensor` has a batch dimension of `batch_size`, and can be
+// split into rows of `tensor.bytes / batch_size` bytes.
+bool HasBatchRows(const TfLiteTensor& tensor, int batch_size) {
+  if (tensor.type == kTfLiteString || tensor.type == kTfLiteResource ||
+      tensor.type == kTfLiteVariant) {
+    return false;
+  }
+  return tensor.dims->size > 0 && tensor.dims->data[0] == batch_size;
+}
+
+}  // namespace
+
+TfLiteStatus SignatureRunner::InvokeBatch(
+    const std::vector<BatchRequest>& requests) {
+  const int batch_size = requests.size();
+  if (batch_size == 0) {
+    subgraph_->ReportError("InvokeBatch called without requests");
+    return kTfLiteError;
+  }
+  for (const BatchRequest& request : requests) {
+    if (request.inputs.size() != input_names_.size() ||
+        request.outputs.size() != output_names_.size()) {
+      subgraph_->ReportError(
+          "Batch request with %zu inputs and %zu outputs, expected %zu and %zu",
+          request.inputs.size(), request.outputs.size(), input_names_.size(),
+          output_names_.size());
+      return kTfLiteError;
+    }
+  }
+
+  for (const char* input_name : input_names_) {
+    const TfLiteTensor* tensor = input_tensor(input_name);
+    if (tensor->dims->size == 0) {
+      subgraph_->ReportError("Input %s has no batch dimension", input_name);
+      return kTfLiteError;
+    }
+    if (tensor->dims->data[0] != batch_size) {
+      std::vector<int> new_size(tensor->dims->data,
+                                tensor->dims->data + tensor->dims->size);
+      new_size[0] = batch_size;
+      TF_LITE_ENSURE_STATUS(ResizeInputTensor(input_name, new_size));
+    }
+  }
+  TF_LITE_ENSURE_STATUS(AllocateTensors());
+
+  for (size_t i = 0; i < input_names_.size(); ++i) {
+    TfLiteTensor* tensor = input_tensor(input_names_[i]);
+    if (!HasBatchRows(*tensor, batch_size)) {
+      subgraph_->ReportError("Input %s can't be batched", input_names_[i]);
+      return kTfLiteError;
+    }
+    const size_t row_bytes = tensor->bytes / batch_size;
+    if (row_bytes == 0) continue;
+    for (int row = 0; row < batch_size; ++row) {
+      std::memcpy(tensor->data.raw + row * row_bytes, requests[row].inputs[i],
+                  row_bytes);
+    }
+  }
+
+  TF_LITE_ENSURE_STATUS(Invoke());
+
+  for (size_t i = 0; i < output_names_.size(); ++i) {
+    const TfLiteTensor* tensor = output_tensor(output_names_[i]);
+    if (!HasBatchRows(*tensor, batch_size)) {
+      subgraph_->ReportError("Output %s doesn't have a batch dimension of %d",
+                             output_names_[i], batch_size);
+      return kTfLiteError;
+    }
+    const size_t row_bytes = tensor->bytes / batch_size;
+    if (row_bytes == 0) continue;
+    for (int row = 0; row < batch_size; ++row) {
+      std::memcpy(requests[row].outputs[i],
+                  tensor->data.raw_const + row * row_bytes, row_bytes);
+    }
+  }
+  return kTfLiteOk;
+}
+
 TfLiteStatus SignatureRunner::SetCustomAllocationForInputTensor(
     const char* input_name, const TfLiteCustomAllocation& allocation,
     int64_t flags) {
@@ -149,6 +149,30 @@ class SignatureRunner {
   /// signature in dependency order).
   TfLiteStatus Invoke();
 
+  /// \warning This is an experimental API and subject to change. \n
+  /// \brief A request of a batched invocation, see `InvokeBatch`.
+  struct BatchRequest {
+    /// The data of one row of each input, in the order of `input_names()`.
+    std::vector<const void*> inputs;
+    /// The buffers receiving one row of each output, in the order of
+    /// `output_names()`.
+    std::vector<void*> outputs;
+  };
+
+  /// \warning This is an experimental API and subject to change. \n
+  /// \brief Runs `requests` in a single invocation, stacking them along the
+  /// first (batch) dimension of every input and output.
+  ///
+  /// The inputs are resized to a batch dimension of `requests.size()`, keeping
+  /// their other dimensions, and the tensors are allocated. Row `i` of each
+  /// input is then copied from `requests[i].inputs`, and after the invocation
+  /// row `i` of each output is copied to `requests[i].outputs`. A row of a
+  /// tensor is `tensor->bytes / requests.size()` bytes, and every output must
+  /// have a batch dimension of `requests.size()`.
+  ///
+  /// Only inputs and outputs of fixed-size types are supported.
+  TfLiteStatus InvokeBatch(const std::vector<BatchRequest>& requests);
+
   /// Attempts to cancel in flight invocation if any.
   /// This will not affect calls to `Invoke` that happened after this.
   /// Non blocking and thread safe.
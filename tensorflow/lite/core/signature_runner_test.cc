@@ -96,6 +96,38 @@ TEST(SignatureRunnerTest, TestMultiSignatures) {
   ASSERT_EQ(sub_output->data.f[2], 3);
 }
 
+TEST(SignatureRunnerTest, InvokeBatch) {
+  TestErrorReporter reporter;
+  auto model = FlatBufferModel::BuildFromFile(
+      "tensorflow/lite/testdata/multi_signatures.bin", &reporter);
+  ASSERT_TRUE(model);
+  ops::builtin::BuiltinOpResolver resolver;
+  InterpreterBuilder builder(*model, resolver);
+
+  std::unique_ptr<Interpreter> interpreter;
+  ASSERT_EQ(builder(&interpreter), kTfLiteOk);
+  SignatureRunner* add_runner = interpreter->GetSignatureRunner("add");
+  ASSERT_NE(add_runner, nullptr);
+
+  const float inputs[3] = {1, 2, 3};
+  float outputs[3] = {0, 0, 0};
+  std::vector<SignatureRunner::BatchRequest> requests(3);
+  for (int i = 0; i < 3; ++i) {
+    requests[i].inputs = {&inputs[i]};
+    requests[i].outputs = {&outputs[i]};
+  }
+  ASSERT_EQ(add_runner->InvokeBatch(requests), kTfLiteOk);
+  EXPECT_EQ(add_runner->input_tensor("x")->dims->data[0], 3);
+  EXPECT_EQ(outputs[0], 3);
+  EXPECT_EQ(outputs[1], 4);
+  EXPECT_EQ(outputs[2], 5);
+
+  // Requests must have one buffer per input and output.
+  requests[1].outputs.clear();
+  EXPECT_EQ(add_runner->InvokeBatch(requests), kTfLiteError);
+  EXPECT_EQ(add_runner->InvokeBatch({}), kTfLiteError);
+}
+
 }  // namespace
 }  // namespace impl
 }  // namespace tflite
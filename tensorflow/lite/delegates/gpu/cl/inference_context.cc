@@ -142,6 +142,51 @@ void GetUsages(const GpuModel& model,
   }
 }
 
+// Returns the runtime tensors of `usages` to compute in place of another one,
+// mapped to it: the output of an elementwise node can overwrite its first
+// input when the node is its last use and both are linear buffers of the same
+// shape and layout. Extends the usage of these inputs accordingly.
+std::map<ValueId, ValueId> GetInPlaceAliases(const GpuModel& gpu_model,
+                                             std::map<ValueId, int2>* usages) {
+  std::map<ValueId, ValueId> aliases;
+  for (int op_index = 0; op_index < gpu_model.nodes.size(); ++op_index) {
+    const GpuNode& node = gpu_model.nodes[op_index];
+    if (!node.elementwise || node.inputs.empty() || node.outputs.size() != 1) {
+      continue;
+    }
+    const ValueId input_id = node.inputs[0];
+    const ValueId output_id = node.outputs[0];
+    auto input_usage = usages->find(input_id);
+    auto output_usage = usages->find(output_id);
+    if (input_usage == usages->end() || output_usage == usages->end() ||
+        input_usage->second.y != op_index ||
+        output_usage->second.x != op_index ||
+        std::count(node.inputs.begin(), node.inputs.end(), input_id) != 1) {
+      continue;
+    }
+    const TensorDescriptor& input_desc = gpu_model.tensors.at(input_id);
+    const TensorDescriptor& output_desc = gpu_model.tensors.at(output_id);
+    if (input_desc.GetStorageType() != TensorStorageType::BUFFER ||
+        input_desc != output_desc ||
+        input_desc.GetBHWDCShape() != output_desc.GetBHWDCShape()) {
+      continue;
+    }
+    auto alias = aliases.find(input_id);
+    const ValueId root_id = alias == aliases.end() ? input_id : alias->second;
+    // The inputs of the model are only written by the user.
+    if (std::any_of(gpu_model.input_ids_and_refs.begin(),
+                    gpu_model.input_ids_and_refs.end(),
+                    [root_id](const std::pair<ValueId, ValueId>& input) {
+                      return input.first == root_id;
+                    })) {
+      continue;
+    }
+    aliases[output_id] = root_id;
+    (*usages)[root_id].y = output_usage->second.y;
+  }
+  return aliases;
+}
+
 absl::Status GetBufferAssignment(
     const GpuModel& gpu_model, const CreateGpuModelInfo* create_info,
     const GpuInfo& gpu_info,
@@ -160,9 +205,12 @@ absl::Status GetBufferAssignment(
                              gpu_model.tensors.at(id).GetStorageType());
       },
       &buffer_usages);
+  const std::map<ValueId, ValueId> aliases =
+      GetInPlaceAliases(gpu_model, &buffer_usages);
 
   bool has_buffer_based_images = false;
   for (auto& usage : buffer_usages) {
+    if (aliases.find(usage.first) != aliases.end()) continue;
     const auto& t = gpu_model.tensors.at(usage.first);
     const auto& shape = t.GetBHWDCShape();
     const auto& descriptor = t;
@@ -199,6 +247,12 @@ absl::Status GetBufferAssignment(
                                      static_cast<TaskId>(usage.second.x),
                                      static_cast<TaskId>(usage.second.y)});
   }
+  if (graph_ids_to_shared_buffer_tensors) {
+    for (const auto& alias : aliases) {
+      (*graph_ids_to_shared_buffer_tensors)[alias.first] =
+          (*graph_ids_to_shared_buffer_tensors)[alias.second];
+    }
+  }
 
   RETURN_IF_ERROR(AssignObjectsToTensors(
       *buffer_usage_records, MemoryStrategy::GREEDY_BEST, buffer_assignment));
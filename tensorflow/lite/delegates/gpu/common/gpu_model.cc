@@ -822,6 +822,8 @@ absl::Status GraphToGpuModel(const GraphFloat32& graph,
   RemoveUnusedTensors(gpu_model);
 
   for (auto& node : gpu_model->nodes) {
+    // AssembleCode() clears the flag.
+    node.elementwise = node.gpu_operation->IsLinkable();
     RETURN_IF_ERROR(node.gpu_operation->AssembleCode(gpu_info));
   }
 
@@ -34,6 +34,9 @@ struct GpuNode {
   std::vector<ValueId> inputs;
   std::vector<ValueId> outputs;
   std::string name;
+  // Whether each element of the output of gpu_operation only depends on the
+  // elements at the same coordinates of its inputs. Not serialized.
+  bool elementwise = false;
 
   GpuNode() = default;
   GpuNode(GpuNode&& node) = default;
@@ -53,6 +53,7 @@ limitations under the License.
 #include "tensorflow/lite/delegates/gpu/android_hardware_buffer.h"
 #include "tensorflow/lite/delegates/gpu/api.h"
 #include "tensorflow/lite/delegates/gpu/cl/api.h"
+#include "tensorflow/lite/delegates/gpu/cl/inference_context.h"
 #include "tensorflow/lite/delegates/gpu/cl/util.h"
 #include "tensorflow/lite/delegates/gpu/common/model_builder.h"
 #include "tensorflow/lite/delegates/gpu/common/model_builder_helper.h"
@@ -326,22 +327,37 @@ class DelegateKernelCore {
                                std::vector<uint32_t>* input_refs,
                                std::vector<uint32_t>* output_refs);
 
+  // Returns the options of the OpenCL backend, from the delegate options.
+  cl::InferenceOptions GetClInferenceOptions() const;
+
+  // Returns true if the TFLite graph doesn't need to be converted to find the
+  // inputs and outputs of the serialized model: no quantized tensor of the
+  // partition is replaced by a float tensor added to the context.
+  bool CanSkipGraphConversion(TfLiteContext* context,
+                              const TfLiteDelegateParams* delegate_params);
+
+  // If `try_serialized_model` is true and `serialization` holds a model for
+  // `graph`, `graph` is not used.
   absl::Status InitializeOpenClApi(GraphFloat32* graph,
                                    std::unique_ptr<InferenceBuilder>* builder,
                                    bool* graph_is_destroyed,
                                    TfLiteContext* context,
                                    const TfLiteDelegateParams* delegate_params,
-                                   Serialization* serialization);
+                                   Serialization* serialization,
+                                   bool try_serialized_model);
 
   absl::Status InitializeOpenGlApi(GraphFloat32* graph,
                                    std::unique_ptr<InferenceBuilder>* builder);
 
+  // If `input_refs` and `output_refs` are not null, they are set to the
+  // tensors of the inputs and outputs of the serialized model.
   absl::Status MaybeInitializeSerializedOpenCL(
       TfLiteContext* context, const TfLiteDelegateParams* delegate_params,
       std::unique_ptr<InferenceBuilder>* builder, cl::InferenceOptions* options,
       cl::InferenceEnvironmentOptions* env_options,
       cl::InferenceEnvironmentProperties* properties,
-      Serialization* serialization);
+      Serialization* serialization, std::vector<uint32_t>* input_refs = nullptr,
+      std::vector<uint32_t>* output_refs = nullptr);
 
   absl::Status SaveSerializedOpenCL(
       TfLiteContext* context, const TfLiteDelegateParams* delegate_params,
@@ -444,30 +460,53 @@ absl::Status DelegateKernelCore::InitializeGraph(
 
 absl::Status DelegateKernelCore::Setup(
     TfLiteContext* context, const TfLiteDelegateParams* delegate_params) {
-  // Extract TFLite delegate execution plan from the context and convert it
-  // into GraphFloat32.
   GraphFloat32 graph;
   std::vector<uint32_t> input_refs;
   std::vector<uint32_t> output_refs;
-  RETURN_IF_ERROR(InitializeGraph(context, delegate_params, &graph, &input_refs,
-                                  &output_refs));
-
   std::unique_ptr<InferenceBuilder> builder;
   bool graph_is_destroyed;
   bool backend_opencl = false;
   const int experimental_flags = delegate_->options().experimental_flags;
-  if (experimental_flags & TFLITE_GPU_EXPERIMENTAL_FLAGS_CL_ONLY) {
+  Serialization* serialization = delegate_->serialization();
+  // A serialized model has its kernels picked and tuned already: load it
+  // before converting the TFLite graph, which it makes unnecessary.
+  bool try_serialized_model = serialization != nullptr;
+  if (try_serialized_model &&
+      !(experimental_flags & TFLITE_GPU_EXPERIMENTAL_FLAGS_GL_ONLY) &&
+      CanSkipGraphConversion(context, delegate_params)) {
+    cl::InferenceOptions options = GetClInferenceOptions();
+    cl::InferenceEnvironmentOptions env_options;
+    cl::InferenceEnvironmentProperties properties;
+    backend_opencl =
+        MaybeInitializeSerializedOpenCL(
+            context, delegate_params, &builder, &options, &env_options,
+            &properties, serialization, &input_refs, &output_refs)
+            .ok();
+    try_serialized_model = false;
+  }
+
+  if (backend_opencl) {
+    quant_conversion_map_.clear();
+  } else if (experimental_flags & TFLITE_GPU_EXPERIMENTAL_FLAGS_CL_ONLY) {
+    // Extract TFLite delegate execution plan from the context and convert it
+    // into GraphFloat32.
+    RETURN_IF_ERROR(InitializeGraph(context, delegate_params, &graph,
+                                    &input_refs, &output_refs));
     RETURN_IF_ERROR(InitializeOpenClApi(&graph, &builder, &graph_is_destroyed,
-                                        context, delegate_params,
-                                        delegate_->serialization()));
+                                        context, delegate_params, serialization,
+                                        try_serialized_model));
     backend_opencl = true;
   } else if (experimental_flags & TFLITE_GPU_EXPERIMENTAL_FLAGS_GL_ONLY) {
+    RETURN_IF_ERROR(InitializeGraph(context, delegate_params, &graph,
+                                    &input_refs, &output_refs));
     RETURN_IF_ERROR(InitializeOpenGlApi(&graph, &builder));
   } else {
+    RETURN_IF_ERROR(InitializeGraph(context, delegate_params, &graph,
+                                    &input_refs, &output_refs));
     // By default, we try CL first & fall back to GL if that fails.
-    absl::Status status =
-        InitializeOpenClApi(&graph, &builder, &graph_is_destroyed, context,
-                            delegate_params, delegate_->serialization());
+    absl::Status status = InitializeOpenClApi(
+        &graph, &builder, &graph_is_destroyed, context, delegate_params,
+        serialization, try_serialized_model);
     if (!status.ok()) {
       TF_LITE_KERNEL_LOG(context, std::string(status.message()).c_str());
       TF_LITE_KERNEL_LOG(context, "Falling back to OpenGL");
@@ -516,15 +555,7 @@ absl::Status DelegateKernelCore::Setup(
   return builder->Build(&runner_);
 }
 
-absl::Status DelegateKernelCore::InitializeOpenClApi(
-    GraphFloat32* graph, std::unique_ptr<InferenceBuilder>* builder,
-    bool* graph_is_destroyed, TfLiteContext* context,
-    const TfLiteDelegateParams* delegate_params,
-    Serialization* serialization = nullptr) {
-  *graph_is_destroyed = false;
-  cl::InferenceEnvironmentOptions env_options;
-  cl::InferenceEnvironmentProperties properties;
-
+cl::InferenceOptions DelegateKernelCore::GetClInferenceOptions() const {
   // OpenCL initialization is parameterized by these InferenceOptions.
   auto delegate_options = delegate_->options();
   cl::InferenceOptions options;
@@ -547,6 +578,45 @@ absl::Status DelegateKernelCore::InitializeOpenClApi(
 #ifdef TFLITE_GPU_ENABLE_INVOKE_LOOP
   options.gpu_invoke_loop_times = delegate_options.gpu_invoke_loop_times;
 #endif
+  return options;
+}
+
+bool DelegateKernelCore::CanSkipGraphConversion(
+    TfLiteContext* context, const TfLiteDelegateParams* delegate_params) {
+  if (!delegate_->IsQuantOpsAllowed()) return true;
+  auto is_quantized = [context](int tensor_index) {
+    if (tensor_index == kTfLiteOptionalTensor) return false;
+    const TfLiteTensor& tensor = context->tensors[tensor_index];
+    return !tflite::IsConstantTensor(&tensor) &&
+           (tensor.type == kTfLiteInt8 || tensor.type == kTfLiteUInt8);
+  };
+  for (int i = 0; i < delegate_params->nodes_to_replace->size; ++i) {
+    TfLiteNode* node;
+    TfLiteRegistration* registration;
+    if (context->GetNodeAndRegistration(
+            context, delegate_params->nodes_to_replace->data[i], &node,
+            &registration) != kTfLiteOk) {
+      return false;
+    }
+    for (int j = 0; j < node->inputs->size; ++j) {
+      if (is_quantized(node->inputs->data[j])) return false;
+    }
+    for (int j = 0; j < node->outputs->size; ++j) {
+      if (is_quantized(node->outputs->data[j])) return false;
+    }
+  }
+  return true;
+}
+
+absl::Status DelegateKernelCore::InitializeOpenClApi(
+    GraphFloat32* graph, std::unique_ptr<InferenceBuilder>* builder,
+    bool* graph_is_destroyed, TfLiteContext* context,
+    const TfLiteDelegateParams* delegate_params, Serialization* serialization,
+    bool try_serialized_model) {
+  *graph_is_destroyed = false;
+  cl::InferenceEnvironmentOptions env_options;
+  cl::InferenceEnvironmentProperties properties;
+  cl::InferenceOptions options = GetClInferenceOptions();
 
   if (!serialization) {
     // This path is faster when there is no serialization involved.
@@ -557,7 +627,8 @@ absl::Status DelegateKernelCore::InitializeOpenClApi(
         options, std::move(*graph), builder));
   } else {
     // If serialization data is found, initialize CL from it & return early.
-    if (MaybeInitializeSerializedOpenCL(context, delegate_params, builder,
+    if (try_serialized_model &&
+        MaybeInitializeSerializedOpenCL(context, delegate_params, builder,
                                         &options, &env_options, &properties,
                                         serialization)
             .ok()) {
@@ -626,7 +697,8 @@ absl::Status DelegateKernelCore::MaybeInitializeSerializedOpenCL(
     std::unique_ptr<InferenceBuilder>* builder, cl::InferenceOptions* options,
     cl::InferenceEnvironmentOptions* env_options,
     cl::InferenceEnvironmentProperties* properties,
-    Serialization* serialization) {
+    Serialization* serialization, std::vector<uint32_t>* input_refs,
+    std::vector<uint32_t>* output_refs) {
   if (!serialization) return absl::InvalidArgumentError("No serialization");
   // We use a fingerprint of the options to ensure compatibility.
   std::string options_fingerprint =
@@ -640,6 +712,29 @@ absl::Status DelegateKernelCore::MaybeInitializeSerializedOpenCL(
   if (model_data_status == kTfLiteOk) {
     absl::Span<const uint8_t> model_span = absl::Span<const uint8_t>{
         reinterpret_cast<const uint8_t*>(model_data.data()), model_data.size()};
+    if (input_refs && output_refs) {
+      // Matches the inputs and outputs like InitializeGraph().
+      std::vector<int64_t> in_refs;
+      std::vector<int64_t> out_refs;
+      RETURN_IF_ERROR(cl::GetInOutRefs(model_span, &in_refs, &out_refs));
+      size_t num_inputs = 0;
+      for (int i = 0; i < delegate_params->input_tensors->size; ++i) {
+        if (!tflite::IsConstantTensor(
+                context->tensors + delegate_params->input_tensors->data[i])) {
+          ++num_inputs;
+        }
+      }
+      if (in_refs.size() != num_inputs) {
+        return absl::FailedPreconditionError(
+            "Serialized model inputs don't match the delegated nodes");
+      }
+      input_refs->assign(in_refs.begin(), in_refs.end());
+      output_refs->assign(
+          out_refs.begin(),
+          out_refs.begin() +
+              std::min<size_t>(out_refs.size(),
+                               delegate_params->output_tensors->size));
+    }
     RETURN_IF_ERROR(cl::NewInferenceEnvironment(*env_options, &cl_environment_,
                                                 properties));
     RETURN_IF_ERROR(cl_environment_->NewInferenceBuilder(model_span, builder));
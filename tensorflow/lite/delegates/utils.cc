@@ -18,8 +18,10 @@ limitations under the License.
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <limits>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "tensorflow/lite/builtin_ops.h"
@@ -125,6 +127,65 @@ GraphPartitionHelper::GetFirstNLargestPartitions(
   return results;
 }
 
+double GraphPartitionHelper::EstimateDelegationGain(
+    const PartitionCostModel& cost_model,
+    const TfLiteDelegateParams& partition) const {
+  double gain = -cost_model.partition_overhead_us;
+  for (int node_index : TfLiteIntArrayView(partition.nodes_to_replace)) {
+    TfLiteNode* node;
+    TfLiteRegistration* registration;
+    if (context_->GetNodeAndRegistration(context_, node_index, &node,
+                                         &registration) != kTfLiteOk) {
+      // Don't delegate partitions we can't estimate.
+      return -std::numeric_limits<double>::infinity();
+    }
+    const auto it = cost_model.op_costs.find(registration->builtin_code);
+    const PartitionCostModel::OpCost& op_cost =
+        it != cost_model.op_costs.end() ? it->second
+                                        : cost_model.default_op_cost;
+    int64_t num_elements = 0;
+    for (int tensor_index : TfLiteIntArrayView(node->outputs)) {
+      if (tensor_index == kTfLiteOptionalTensor) continue;
+      num_elements += NumElements(&context_->tensors[tensor_index]);
+    }
+    gain += num_elements *
+            (op_cost.cpu_us_per_element - op_cost.delegate_us_per_element);
+  }
+  // Constant inputs are handed over to the delegate once, when it's prepared.
+  size_t transfer_bytes = 0;
+  for (const TfLiteIntArray* tensors :
+       {partition.input_tensors, partition.output_tensors}) {
+    if (tensors == nullptr) continue;
+    for (int tensor_index : TfLiteIntArrayView(tensors)) {
+      if (tensor_index == kTfLiteOptionalTensor) continue;
+      const TfLiteTensor& tensor = context_->tensors[tensor_index];
+      if (!IsConstantTensor(&tensor)) transfer_bytes += tensor.bytes;
+    }
+  }
+  return gain - transfer_bytes * cost_model.transfer_us_per_byte;
+}
+
+std::vector<TfLiteDelegateParams*>
+GraphPartitionHelper::GetProfitablePartitions(
+    const PartitionCostModel& cost_model, int n) const {
+  std::vector<std::pair<double, TfLiteDelegateParams*>> gains;
+  for (TfLiteDelegateParams* p : partitions_) {
+    const double gain = EstimateDelegationGain(cost_model, *p);
+    if (gain > 0) gains.emplace_back(gain, p);
+  }
+  std::stable_sort(gains.begin(), gains.end(),
+                   [](const auto& left, const auto& right) {
+                     // Reverse sort
+                     return left.first > right.first;
+                   });
+
+  std::vector<TfLiteDelegateParams*> results;
+  for (int i = 0; i < std::min<int>(gains.size(), n); ++i) {
+    results.push_back(gains[i].second);
+  }
+  return results;
+}
+
 std::vector<int> GraphPartitionHelper::GetNodesOfFirstNLargestPartitionsImpl(
     int n, int min_nodes_per_partition) {
   auto first_n_partitions =
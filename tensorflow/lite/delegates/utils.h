@@ -96,6 +96,25 @@ using IsNodeSupportedFn =
     std::function<bool(TfLiteContext*, TfLiteNode*, TfLiteRegistration*,
                        std::string* unsupported_details)>;
 
+// Estimated latencies, in microseconds, of running a partition on the CPU and
+// on a delegate, e.g. derived from the per-op profiles of the benchmark tool.
+struct PartitionCostModel {
+  // Latency of a node, per element of its outputs.
+  struct OpCost {
+    double cpu_us_per_element = 0;
+    double delegate_us_per_element = 0;
+  };
+  // Costs by builtin operator code.
+  std::unordered_map<int, OpCost> op_costs;
+  // Cost of the operators missing from `op_costs`.
+  OpCost default_op_cost;
+  // Fixed cost of each delegate kernel: launch and synchronization.
+  double partition_overhead_us = 0;
+  // Cost of moving a byte of the non-constant inputs and outputs of a
+  // partition between the CPU and the delegate.
+  double transfer_us_per_byte = 0;
+};
+
 // A utility class to help model graph parition.
 // Note the class *needs* to be used in TfLiteDelegate::Prepare.
 class GraphPartitionHelper {
@@ -149,6 +168,15 @@ class GraphPartitionHelper {
     return GetNodesOfFirstNLargestPartitionsImpl(n, min_nodes_per_partition);
   }
 
+  // Returns the first n partitions that are estimated by 'cost_model' to run
+  // faster on the delegate than on the CPU, overhead and transfers included,
+  // or all of them if there are fewer than 'n'. Partitions are ranked by
+  // estimated time saved, and the returned TfLiteDelegateParams objects are
+  // *owned* by the TfLite runtime.
+  std::vector<TfLiteDelegateParams*> GetProfitablePartitions(
+      const PartitionCostModel& cost_model,
+      int n = std::numeric_limits<int>::max()) const;
+
   int num_total_nodes() const { return num_total_nodes_; }
   int num_supported_nodes() const { return num_supported_nodes_; }
   int num_partitions() const { return partitions_.size(); }
@@ -162,6 +190,11 @@ class GraphPartitionHelper {
   }
   virtual std::vector<int> GetNodesOfFirstNLargestPartitionsImpl(
       int n, int min_nodes_per_partition);
+
+  // Returns the estimated time saved, in microseconds, by delegating
+  // 'partition'. Negative if the partition runs faster on the CPU.
+  double EstimateDelegationGain(const PartitionCostModel& cost_model,
+                                const TfLiteDelegateParams& partition) const;
   virtual TfLiteStatus PartitionImpl(
       std::set<std::string>* unsupported_nodes_info, int start_node_index,
       int end_node_index);
@@ -35,6 +35,9 @@ BufferType BufferTypeFromString(const char* buffer_type) {
   if (std::strcmp(buffer_type, kBufferTypeAHardwareBufferBlob) == 0) {
     return BufferType::kAHardwareBufferBlob;
   }
+  if (std::strcmp(buffer_type, kBufferTypeHostMemory) == 0) {
+    return BufferType::kHostMemory;
+  }
   return BufferType::kUnknown;
 }
 
@@ -42,6 +45,8 @@ const char* StringFromBufferType(BufferType buffer_type) {
   switch (buffer_type) {
     case BufferType::kAHardwareBufferBlob:
       return kBufferTypeAHardwareBufferBlob;
+    case BufferType::kHostMemory:
+      return kBufferTypeHostMemory;
     case BufferType::kUnknown:
       return "<unknown buffer type>";
   }
@@ -24,6 +24,9 @@ limitations under the License.
 namespace tflite::delegates::utils {
 
 constexpr char kBufferTypeAHardwareBufferBlob[] = "ahardware_buffer_blob";
+// Plain host memory: the pointer of the TfLiteBackendBuffer is the address of
+// the data.
+constexpr char kBufferTypeHostMemory[] = "host_memory";
 constexpr char kSyncTypeSyncFenceFd[] = "sync_fence_fd";
 
 // RAII wrapper of TfLiteAttributeMap.
@@ -54,7 +57,7 @@ inline ScopedTfLiteSynchronization CreateScopedTfLiteSynchronization() {
                                      TfLiteSynchronizationDelete);
 }
 
-enum class BufferType { kUnknown, kAHardwareBufferBlob };
+enum class BufferType { kUnknown, kAHardwareBufferBlob, kHostMemory };
 
 struct BufferAttributes {
   std::optional<BufferType> buffer_type;
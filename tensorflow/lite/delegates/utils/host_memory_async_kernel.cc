@@ -0,0 +1,268 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/delegates/utils/host_memory_async_kernel.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "tensorflow/lite/async/c/task.h"
+#include "tensorflow/lite/async/c/types.h"
+#include "tensorflow/lite/async/interop/c/attribute_map.h"
+#include "tensorflow/lite/async/interop/c/types.h"
+#include "tensorflow/lite/c/c_api_types.h"
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/delegates/utils/async_type_helpers.h"
+#include "tensorflow/lite/delegates/utils/ret_macros.h"
+#include "tensorflow/lite/minimal_logging.h"
+
+namespace tflite::delegates::utils {
+namespace {
+
+bool IsPowerOfTwo(size_t x) { return x != 0 && (x & (x - 1)) == 0; }
+
+}  // namespace
+
+TfLiteStatus HostMemoryAsyncKernel::RegisterBuffer(
+    TfLiteOpaqueContext* context, TfLiteIoType io_type,
+    const TfLiteBackendBuffer* buffer, const TfLiteAttributeMap* attrs,
+    TfLiteBufferHandle handle) {
+  TFLITE_ABORT_CHECK(buffer != nullptr, "");  // Crash OK
+  TFLITE_ABORT_CHECK(attrs != nullptr, "");   // Crash OK
+  TFLITE_RET_CHECK_STATUS(
+      TfLiteAttributeMapIsBufferAttributeMap(attrs),
+      "calling RegisterBuffer with invalid attribute map type");
+  const BufferAttributes buffer_attrs = ReadBufferAttrs(attrs);
+  TFLITE_RET_CHECK_STATUS(
+      buffer_attrs.buffer_type == BufferType::kHostMemory,
+      "calling RegisterBuffer with a buffer type other than host memory");
+  TFLITE_RET_CHECK_STATUS(
+      buffer_attrs.size.has_value(),
+      "calling RegisterBuffer with buffer size unspecified");
+  TFLITE_RET_CHECK_STATUS(buffer_attrs.offset.value_or(0) == 0,
+                          "calling RegisterBuffer with non-zero offset");
+  auto* data = static_cast<char*>(TfLiteBackendBufferGetPtr(buffer));
+  TFLITE_RET_CHECK_STATUS(data != nullptr,
+                          "calling RegisterBuffer with nullptr buffer");
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  TFLITE_RET_CHECK_STATUS(
+      buffer_by_handle_.try_emplace(handle, Buffer{data, *buffer_attrs.size})
+          .second,
+      "RegisterBuffer called with duplicate handle");
+  attributes_by_buffer_[data] = buffer_attrs;
+  return kTfLiteOk;
+}
+
+TfLiteStatus HostMemoryAsyncKernel::RegisterBufferSlice(
+    TfLiteOpaqueContext* context, TfLiteBufferHandle buffer_pool,
+    const TfLiteAttributeMap* attrs, TfLiteBufferHandle handle) {
+  TFLITE_ABORT_CHECK(attrs != nullptr, "");  // Crash OK
+  TFLITE_RET_CHECK_STATUS(
+      TfLiteAttributeMapIsBufferAttributeMap(attrs),
+      "calling RegisterBufferSlice with invalid attribute map type");
+  const BufferAttributes slice_attrs = ReadBufferAttrs(attrs);
+  TFLITE_RET_CHECK_STATUS(
+      slice_attrs.size.has_value(),
+      "calling RegisterBufferSlice with slice size unspecified");
+  const size_t offset = slice_attrs.offset.value_or(0);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto pool = buffer_by_handle_.find(buffer_pool);
+  TFLITE_RET_CHECK_STATUS(pool != buffer_by_handle_.end(),
+                          "RegisterBufferSlice called with unknown pool");
+  TFLITE_RET_CHECK_STATUS(
+      offset <= pool->second.size &&
+          *slice_attrs.size <= pool->second.size - offset,
+      "RegisterBufferSlice called with a slice out of the pool");
+  TFLITE_RET_CHECK_STATUS(
+      buffer_by_handle_
+          .try_emplace(handle, Buffer{pool->second.data + offset,
+                                      *slice_attrs.size})
+          .second,
+      "RegisterBufferSlice called with duplicate handle");
+  return kTfLiteOk;
+}
+
+TfLiteStatus HostMemoryAsyncKernel::UnregisterBuffer(
+    TfLiteOpaqueContext* context, TfLiteBufferHandle handle) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  TFLITE_RET_CHECK_STATUS(buffer_by_handle_.erase(handle) == 1,
+                          "UnregisterBuffer called with unknown handle");
+  return kTfLiteOk;
+}
+
+bool HostMemoryAsyncKernel::ReconcileRestrictions(
+    const TfLiteOpaqueContext* opaque_context,
+    const TfLiteOpaqueNode* opaque_node, int tensor_index,
+    const TfLiteAttributeMap* user_provided_attributes,
+    TfLiteAttributeMap* merged, TfLiteAttributeMap* conflict) const {
+  TFLITE_ABORT_CHECK(opaque_context != nullptr, "");            // Crash OK
+  TFLITE_ABORT_CHECK(user_provided_attributes != nullptr, "");  // Crash OK
+  TFLITE_ABORT_CHECK(merged != nullptr, "");                    // Crash OK
+
+  // The following cast is safe only because this code is part of the
+  // TF Lite runtime implementation.
+  const auto* context = reinterpret_cast<const TfLiteContext*>(opaque_context);
+  if (TfLiteAttributeMapIsBufferAttributeMap(user_provided_attributes)) {
+    TFLITE_RET_CHECK(TfLiteAttributeMapIsBufferAttributeMap(merged),
+                     "'merged' has a different attribute map type", false);
+    const BufferAttributes user = ReadBufferAttrs(user_provided_attributes);
+    BufferAttributes merged_attrs{};
+    BufferAttributes conflict_attrs{};
+    bool ok = true;
+    if (user.buffer_type.value_or(BufferType::kHostMemory) !=
+        BufferType::kHostMemory) {
+      conflict_attrs.buffer_type = BufferType::kHostMemory;
+      ok = false;
+    }
+    merged_attrs.buffer_type = BufferType::kHostMemory;
+    if (user.alignment.has_value()) {
+      if (IsPowerOfTwo(*user.alignment)) {
+        merged_attrs.alignment = user.alignment;
+      } else {
+        conflict_attrs.alignment = 1;
+        ok = false;
+      }
+    }
+    merged_attrs.size = std::max(user.size.value_or(0),
+                                 context->tensors[tensor_index].bytes +
+                                     extra_bytes_);
+    WriteBufferAttrs(merged_attrs, merged);
+    if (conflict != nullptr) {
+      WriteBufferAttrs(conflict_attrs, conflict);
+    }
+    return ok;
+  }
+  if (TfLiteAttributeMapIsSyncAttributeMap(user_provided_attributes)) {
+    TFLITE_RET_CHECK(TfLiteAttributeMapIsSyncAttributeMap(merged),
+                     "'merged' has a different attribute map type", false);
+    const SyncAttributes user = ReadSyncAttrs(user_provided_attributes);
+    SyncAttributes merged_attrs{};
+    merged_attrs.sync_type = SyncType::kNoSyncObj;
+    WriteSyncAttrs(merged_attrs, merged);
+    if (user.sync_type.value_or(SyncType::kNoSyncObj) != SyncType::kNoSyncObj) {
+      if (conflict != nullptr) WriteSyncAttrs(merged_attrs, conflict);
+      return false;
+    }
+    return true;
+  }
+  TFLITE_LOG_PROD(TFLITE_LOG_ERROR, "unknown type of user_provided_attributes");
+  return false;
+}
+
+TfLiteStatus HostMemoryAsyncKernel::SetAttributes(
+    TfLiteOpaqueContext* context, TfLiteOpaqueNode* node, int tensor_index,
+    const TfLiteAttributeMap* attrs) {
+  if (TfLiteAttributeMapIsBufferAttributeMap(attrs)) {
+    TFLITE_RET_CHECK_STATUS(
+        ReadBufferAttrs(attrs).buffer_type.value_or(BufferType::kHostMemory) ==
+            BufferType::kHostMemory,
+        "calling SetAttributes with a buffer type other than host memory");
+    return kTfLiteOk;
+  }
+  TFLITE_RET_CHECK_STATUS(
+      TfLiteAttributeMapIsSyncAttributeMap(attrs),
+      "calling SetAttributes with an invalid attribute map type");
+  TFLITE_RET_CHECK_STATUS(
+      ReadSyncAttrs(attrs).sync_type.value_or(SyncType::kNoSyncObj) ==
+          SyncType::kNoSyncObj,
+      "calling SetAttributes with a sync type other than no_sync_obj");
+  return kTfLiteOk;
+}
+
+TfLiteStatus HostMemoryAsyncKernel::SetBufferAttributes(
+    const TfLiteBackendBuffer* buffer, const TfLiteAttributeMap* attrs) {
+  TFLITE_ABORT_CHECK(buffer != nullptr, "Buffer is null");    // Crash OK
+  TFLITE_ABORT_CHECK(attrs != nullptr, "Attribute is null");  // Crash OK
+  TFLITE_RET_CHECK_STATUS(
+      TfLiteAttributeMapIsBufferAttributeMap(attrs),
+      "calling SetBufferAttributes with an invalid attribute map type");
+  const BufferAttributes buffer_attrs = ReadBufferAttrs(attrs);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = attributes_by_buffer_.find(TfLiteBackendBufferGetPtr(buffer));
+  TFLITE_RET_CHECK_STATUS(it != attributes_by_buffer_.end(),
+                          "Unable to find the buffer.");
+  TFLITE_RET_CHECK_STATUS(
+      buffer_attrs.size.value_or(0) <= it->second.size.value_or(0),
+      "calling SetBufferAttributes with a size larger than the registered "
+      "size");
+  if (buffer_attrs.alignment.has_value()) {
+    it->second.alignment = buffer_attrs.alignment;
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus HostMemoryAsyncKernel::GetBufferAttributes(
+    const TfLiteBackendBuffer* buffer, TfLiteAttributeMap* attrs) {
+  TFLITE_ABORT_CHECK(buffer != nullptr, "Buffer is null");        // Crash OK
+  TFLITE_ABORT_CHECK(attrs != nullptr, "Attribute map is null");  // Crash OK
+  TFLITE_RET_CHECK_STATUS(
+      TfLiteAttributeMapIsBufferAttributeMap(attrs),
+      "calling GetBufferAttributes with an invalid attribute map type");
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = attributes_by_buffer_.find(TfLiteBackendBufferGetPtr(buffer));
+  TFLITE_RET_CHECK_STATUS(it != attributes_by_buffer_.end(),
+                          "Unable to find the buffer.");
+  WriteBufferAttrs(it->second, attrs);
+  return kTfLiteOk;
+}
+
+TfLiteStatus HostMemoryAsyncKernel::Eval(TfLiteOpaqueContext* opaque_context,
+                                         TfLiteOpaqueNode* opaque_node,
+                                         TfLiteExecutionTask* task) {
+  // The following casts are safe only because this code is part of the
+  // TF Lite runtime implementation.
+  auto* context = reinterpret_cast<TfLiteContext*>(opaque_context);
+  auto* node = reinterpret_cast<TfLiteNode*>(opaque_node);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  // The tensors bound to a buffer, with their own memory.
+  std::vector<std::pair<TfLiteTensor*, char*>> bound_tensors;
+  auto bind = [&](int tensor_index, size_t extra_bytes) -> TfLiteStatus {
+    if (tensor_index == kTfLiteOptionalTensor) return kTfLiteOk;
+    const TfLiteBufferHandle handle =
+        TfLiteExecutionTaskGetBufferByIndex(task, tensor_index);
+    if (handle == kTfLiteNullBufferHandle) return kTfLiteOk;
+    auto it = buffer_by_handle_.find(handle);
+    TFLITE_RET_CHECK_STATUS(it != buffer_by_handle_.end(),
+                            "Eval called with an unknown buffer handle");
+    TfLiteTensor* tensor = &context->tensors[tensor_index];
+    TFLITE_RET_CHECK_STATUS(it->second.size >= tensor->bytes + extra_bytes,
+                            "Eval called with a buffer smaller than its "
+                            "tensor");
+    bound_tensors.emplace_back(tensor, tensor->data.raw);
+    tensor->data.raw = it->second.data;
+    return kTfLiteOk;
+  };
+  TfLiteStatus status = kTfLiteOk;
+  for (int i = 0; i < node->inputs->size && status == kTfLiteOk; ++i) {
+    status = bind(node->inputs->data[i], extra_bytes_);
+  }
+  for (int i = 0; i < node->outputs->size && status == kTfLiteOk; ++i) {
+    status = bind(node->outputs->data[i], 0);
+  }
+  if (status == kTfLiteOk) {
+    status = invoke_(context, node);
+  }
+  for (auto& [tensor, data] : bound_tensors) {
+    tensor->data.raw = data;
+  }
+  return status;
+}
+
+}  // namespace tflite::delegates::utils
@@ -0,0 +1,127 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_DELEGATES_UTILS_HOST_MEMORY_ASYNC_KERNEL_H_
+#define TENSORFLOW_LITE_DELEGATES_UTILS_HOST_MEMORY_ASYNC_KERNEL_H_
+
+#include <cstddef>
+#include <functional>
+#include <mutex>  // NOLINT(build/c++11)
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/lite/async/backend_async_kernel_interface.h"
+#include "tensorflow/lite/async/c/types.h"
+#include "tensorflow/lite/async/interop/c/attribute_map.h"
+#include "tensorflow/lite/async/interop/c/constants.h"
+#include "tensorflow/lite/async/interop/c/types.h"
+#include "tensorflow/lite/c/c_api_types.h"
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/delegates/utils/async_type_helpers.h"
+
+namespace tflite::delegates::utils {
+
+// Asynchronous kernel of a delegate computing on the CPU, which runs the
+// synchronous kernel of the delegate on buffers of host memory
+// (kBufferTypeHostMemory) registered by the application.
+//
+// For each task, the registered buffers are used in place of the memory of the
+// tensors they are bound to, so that the kernel reads its inputs from and
+// writes its outputs to them without copies. The tensors without a buffer keep
+// their own memory. The execution is synchronous: Eval() runs the kernel, and
+// only kTfLiteSyncTypeNoSyncObj synchronizations are supported.
+class HostMemoryAsyncKernel : public BackendAsyncKernelInterface {
+ public:
+  using InvokeFn = std::function<TfLiteStatus(TfLiteContext*, TfLiteNode*)>;
+
+  // `invoke` runs the synchronous kernel of the node. It may read up to
+  // `extra_bytes` past the end of the input tensors.
+  explicit HostMemoryAsyncKernel(InvokeFn invoke, size_t extra_bytes = 0)
+      : invoke_(std::move(invoke)), extra_bytes_(extra_bytes) {}
+
+  // Buffer operations
+  TfLiteStatus RegisterBuffer(TfLiteOpaqueContext* context,
+                              TfLiteIoType io_type,
+                              const TfLiteBackendBuffer* buffer,
+                              const TfLiteAttributeMap* attrs,
+                              TfLiteBufferHandle handle) override;
+  TfLiteStatus RegisterBufferSlice(TfLiteOpaqueContext* context,
+                                   TfLiteBufferHandle buffer_pool,
+                                   const TfLiteAttributeMap* attrs,
+                                   TfLiteBufferHandle handle) override;
+  TfLiteStatus UnregisterBuffer(TfLiteOpaqueContext* context,
+                                TfLiteBufferHandle handle) override;
+
+  // Reconciliations
+  const std::vector<const char*>& SupportedBufferTypes(
+      TfLiteIoType io_type) const override {
+    return supported_buffer_types_;
+  }
+  const std::vector<const char*>& SupportedSynchronizations(
+      TfLiteIoType io_type) const override {
+    return supported_synchronizations_;
+  }
+  bool ReconcileRestrictions(const TfLiteOpaqueContext* context,
+                             const TfLiteOpaqueNode* node, int tensor_index,
+                             const TfLiteAttributeMap* user_provided_attributes,
+                             TfLiteAttributeMap* merged,
+                             TfLiteAttributeMap* conflict) const override;
+  TfLiteStatus SetAttributes(TfLiteOpaqueContext* context,
+                             TfLiteOpaqueNode* node, int tensor_index,
+                             const TfLiteAttributeMap* attrs) override;
+  TfLiteStatus SetBufferAttributes(const TfLiteBackendBuffer* buffer,
+                                   const TfLiteAttributeMap* attrs) override;
+  TfLiteStatus GetBufferAttributes(const TfLiteBackendBuffer* buffer,
+                                   TfLiteAttributeMap* attrs) override;
+  TfLiteStatus Prepare(TfLiteOpaqueContext* context,
+                       TfLiteOpaqueNode* node) override {
+    return kTfLiteOk;
+  }
+
+  // Execution methods
+  TfLiteStatus Eval(TfLiteOpaqueContext* context, TfLiteOpaqueNode* node,
+                    TfLiteExecutionTask* task) override;
+  TfLiteStatus Wait(TfLiteOpaqueContext* context,
+                    TfLiteExecutionTask* task) override {
+    // Eval is synchronous, so Wait is a no-op.
+    return kTfLiteOk;
+  }
+  TfLiteStatus Finish(TfLiteOpaqueContext* context,
+                      TfLiteExecutionTask* task) override {
+    return kTfLiteOk;
+  }
+
+ private:
+  struct Buffer {
+    char* data;
+    size_t size;
+  };
+
+  const InvokeFn invoke_;
+  const size_t extra_bytes_;
+
+  const std::vector<const char*> supported_buffer_types_ = {
+      kBufferTypeHostMemory};
+  const std::vector<const char*> supported_synchronizations_ = {
+      kTfLiteSyncTypeNoSyncObj};
+
+  std::mutex mutex_;
+  std::unordered_map<TfLiteBufferHandle, Buffer> buffer_by_handle_;
+  std::unordered_map<const void*, BufferAttributes> attributes_by_buffer_;
+};
+
+}  // namespace tflite::delegates::utils
+
+#endif  // TENSORFLOW_LITE_DELEGATES_UTILS_HOST_MEMORY_ASYNC_KERNEL_H_
@@ -20,6 +20,7 @@ limitations under the License.
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "tensorflow/lite/builtin_ops.h"
 #include "tensorflow/lite/core/c/common.h"
 #include "tensorflow/lite/core/subgraph.h"
 
@@ -251,6 +252,59 @@ TEST(GraphPartitionHelper, CheckPartitions) {
   EXPECT_THAT(nodes, testing::ElementsAreArray({0, 3, 7, 8, 2, 4, 9}));
 }
 
+TEST(GraphPartitionHelper, CheckProfitablePartitions) {
+  // The mocked TfLiteContext has 4 partitions: {1}, {0,3,7,8}, {2,4,9}, {5,6}.
+  // Every node is an ADD writing 100 floats to tensor 0, which is also the
+  // input and output of every partition.
+  MockTfLiteContext mocked_context;
+  TfLiteTensor tensor = {};
+  tensor.type = kTfLiteFloat32;
+  tensor.allocation_type = kTfLiteArenaRw;
+  tensor.dims = TfLiteIntArrayCreate(1);
+  tensor.dims->data[0] = 100;
+  tensor.bytes = 100 * sizeof(float);
+  mocked_context.tensors = &tensor;
+  mocked_context.tensors_size = 1;
+  mocked_context.registration()->builtin_code = kTfLiteBuiltinAdd;
+  mocked_context.node()->outputs = TfLiteIntArrayCreate(1);
+  mocked_context.node()->outputs->data[0] = 0;
+  for (int i = 0; i < mocked_context.num_delegate_params(); ++i) {
+    TfLiteDelegateParams& params = mocked_context.delegate_params()[i];
+    params.input_tensors = TfLiteIntArrayCreate(1);
+    params.input_tensors->data[0] = 0;
+    params.output_tensors = TfLiteIntArrayCreate(1);
+    params.output_tensors->data[0] = 0;
+  }
+  GraphPartitionHelper helper(&mocked_context, IsNodeSupported);
+  EXPECT_EQ(kTfLiteOk, helper.Partition(nullptr));
+
+  // Delegating a node saves 0.8us, and a partition costs 2us.
+  PartitionCostModel cost_model;
+  cost_model.op_costs[kTfLiteBuiltinAdd] = {/*cpu_us_per_element=*/0.01,
+                                            /*delegate_us_per_element=*/0.002};
+  cost_model.partition_overhead_us = 2;
+  auto partitions = helper.GetProfitablePartitions(cost_model);
+  auto nodes = GetNodesToReplaceFromPartitions(partitions);
+  EXPECT_THAT(nodes, testing::ElementsAreArray({0, 3, 7, 8, 2, 4, 9}));
+
+  partitions = helper.GetProfitablePartitions(cost_model, /*n=*/1);
+  nodes = GetNodesToReplaceFromPartitions(partitions);
+  EXPECT_THAT(nodes, testing::ElementsAreArray({0, 3, 7, 8}));
+
+  // Moving the 800 bytes of inputs and outputs costs another 0.8us.
+  cost_model.transfer_us_per_byte = 0.001;
+  partitions = helper.GetProfitablePartitions(cost_model);
+  nodes = GetNodesToReplaceFromPartitions(partitions);
+  EXPECT_THAT(nodes, testing::ElementsAreArray({0, 3, 7, 8}));
+
+  // Ops without a cost are never worth delegating.
+  cost_model.op_costs.clear();
+  EXPECT_TRUE(helper.GetProfitablePartitions(cost_model).empty());
+
+  TfLiteIntArrayFree(mocked_context.node()->outputs);
+  TfLiteIntArrayFree(tensor.dims);
+}
+
 TfLiteStatus ErrorGetExecutionPlan(TfLiteContext* context,
                                    TfLiteIntArray** execution_plan) {
   return kTfLiteError;
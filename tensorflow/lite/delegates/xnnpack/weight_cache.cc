@@ -35,6 +35,7 @@ limitations under the License.
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "xnnpack.h"  // from @XNNPACK
@@ -127,6 +128,32 @@ bool FileExists(const char* path) {
   return access(path, F_OK) != -1;
 }
 
+// Returns a fingerprint of the size and of the first and last bytes of a
+// constant buffer.
+//
+// Sampling the buffer is enough to tell apart the weights of different
+// versions of a model without reading the whole model on every load.
+uint64_t FingerprintBuffer(const void* data, const uint64_t size) {
+  constexpr size_t kSampleSize = 256;
+  // FNV-1a.
+  uint64_t fingerprint = 0xcbf29ce484222325;
+  const auto add = [&fingerprint](const void* bytes, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+      fingerprint ^= static_cast<const uint8_t*>(bytes)[i];
+      fingerprint *= 0x100000001b3;
+    }
+  };
+  add(&size, sizeof(size));
+  if (data) {
+    const uint8_t* const bytes = static_cast<const uint8_t*>(data);
+    const size_t head_size = std::min<uint64_t>(size, kSampleSize);
+    const size_t tail_size = std::min<uint64_t>(size - head_size, kSampleSize);
+    add(bytes, head_size);
+    add(bytes + size - tail_size, tail_size);
+  }
+  return fingerprint;
+}
+
 }  // namespace
 
 void swap(MMapHandle& a, MMapHandle& b) {
@@ -226,6 +253,7 @@ WeightCacheBuilder::WeightCacheBuilder(WeightCacheBuilder&& other)
       XNN_MOVE_CONSTRUCT_MEMBER(build_segment_size_),
       XNN_MOVE_CONSTRUCT_MEMBER(build_segment_start_),
       XNN_MOVE_CONSTRUCT_MEMBER(first_write_done_),
+      XNN_MOVE_CONSTRUCT_MEMBER(tensor_fingerprints_),
       XNN_MOVE_CONSTRUCT_MEMBER(fd_),
       XNN_MOVE_CONSTRUCT_MEMBER(file_path_) {}
 #undef XNN_MOVE_CONSTRUCT_MEMBER
@@ -238,6 +266,7 @@ WeightCacheBuilder& WeightCacheBuilder::operator=(WeightCacheBuilder&& other) {
   XNN_MOVE_MEMBER(build_segment_size_);
   XNN_MOVE_MEMBER(build_segment_start_);
   XNN_MOVE_MEMBER(first_write_done_);
+  XNN_MOVE_MEMBER(tensor_fingerprints_);
   XNN_MOVE_MEMBER(fd_);
   XNN_MOVE_MEMBER(file_path_);
 #undef XNN_MOVE_MEMBER
@@ -337,13 +366,41 @@ BufferLocation WeightCacheBuilder::Append(PackIdentifier pack_id,
   return loc;
 }
 
+void WeightCacheBuilder::SetTensorFingerprints(
+    const std::unordered_map<uint64_t, uint64_t>& tensor_fingerprints) {
+  tensor_fingerprints_ = tensor_fingerprints;
+}
+
 bool WeightCacheBuilder::StopBuildStep() {
   XNNPACK_RETURN_CHECK(fd_.IsValid(),
                        "cache file ('%s') is not open for writing: %s.",
                        file_path_.c_str(), strerror(errno));
 
   is_build_step_ = false;
-  if (fd_.GetPos() == build_segment_start_ && first_write_done_) {
+
+  // Add the fingerprints of the buffers that weren't known to the previous
+  // build steps.
+  bool new_fingerprints = false;
+  {
+    std::unordered_set<uint64_t> known_ids;
+    for (const auto& tensor_fingerprint : schema_.tensor_fingerprints) {
+      known_ids.insert(tensor_fingerprint->id);
+    }
+    for (const auto [id, fingerprint] : tensor_fingerprints_) {
+      if (known_ids.insert(id).second) {
+        cache::schema::TensorFingerprintT tensor_fingerprint;
+        tensor_fingerprint.id = id;
+        tensor_fingerprint.fingerprint = fingerprint;
+        schema_.tensor_fingerprints.push_back(
+            std::make_unique<cache::schema::TensorFingerprintT>(
+                tensor_fingerprint));
+        new_fingerprints = true;
+      }
+    }
+  }
+
+  if (fd_.GetPos() == build_segment_start_ && first_write_done_ &&
+      !new_fingerprints) {
     // Nothing was written to the file, we can exit early.
     return true;
   }
@@ -407,6 +464,8 @@ MMapWeightCacheProvider& MMapWeightCacheProvider::operator=(
   other.cache_provider_.context = &other;
   swap(file_path_, other.file_path_);
   swap(buffer_address_to_identifier_, other.buffer_address_to_identifier_);
+  swap(tensor_fingerprints_, other.tensor_fingerprints_);
+  swap(loaded_tensor_fingerprints_, other.loaded_tensor_fingerprints_);
   swap(cache_key_to_offset_, other.cache_key_to_offset_);
   swap(mmap_handles_, other.mmap_handles_);
   swap(mmap_buffer_base_offset_, other.mmap_buffer_base_offset_);
@@ -457,6 +516,7 @@ bool MMapWeightCacheProvider::Load(const std::string& path) {
 bool MMapWeightCacheProvider::Load() {
   mmap_buffer_base_offset_ = 0;
   cache_key_to_offset_.clear();
+  loaded_tensor_fingerprints_.clear();
   mmap_handles_.resize(1);
   MMapHandle& mmap_handle = mmap_handles_.front();
   ScopeGuard unmap_on_fail([this] { mmap_handles_.clear(); });
@@ -529,11 +589,34 @@ bool MMapWeightCacheProvider::Load() {
            mmap_handle.data() + mmap_buffer_base_offset_ + buffer->offset()});
     }
   }
+  if (const auto tensor_fingerprints = buffer_list->tensor_fingerprints();
+      tensor_fingerprints) {
+    for (auto* tensor_fingerprint : *tensor_fingerprints) {
+      XNNPACK_RETURN_CHECK(tensor_fingerprint,
+                           "invalid tensor fingerprint in buffer list.");
+      loaded_tensor_fingerprints_.emplace(tensor_fingerprint->id(),
+                                          tensor_fingerprint->fingerprint());
+    }
+  }
+
+  XNNPACK_RETURN_CHECK(TensorFingerprintsMatch(),
+                       "cache file was built for a different model. Cache "
+                       "needs to be built again.");
 
   unmap_on_fail.Deactivate();
   return true;
 }
 
+bool MMapWeightCacheProvider::TensorFingerprintsMatch() const {
+  for (const auto [id, fingerprint] : tensor_fingerprints_) {
+    const auto it = loaded_tensor_fingerprints_.find(id);
+    if (it == loaded_tensor_fingerprints_.end() || it->second != fingerprint) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool MMapWeightCacheProvider::LoadLastBuildStep() {
   if (mmap_handles_.empty()) {
     return Load();
@@ -610,6 +693,7 @@ bool MMapWeightCacheProvider::StartBuildStep() {
 }
 
 bool MMapWeightCacheProvider::StopBuildStep() {
+  builder_.SetTensorFingerprints(tensor_fingerprints_);
   XNNPACK_RETURN_CHECK(builder_.StopBuildStep());
   is_build_step_ = false;
   return LoadLastBuildStep();
@@ -618,11 +702,38 @@ bool MMapWeightCacheProvider::StopBuildStep() {
 void MMapWeightCacheProvider::MapTensorIdentifiers(
     const TfLiteTensor* tensors, const size_t size,
     const std::unordered_map<size_t, size_t>& tensor_index_to_identifier) {
+  const bool first_mapping = buffer_address_to_identifier_.empty();
   for (const auto [index, identifier] : tensor_index_to_identifier) {
     XNNPACK_ABORT_CHECK(index < size,
                         "Tensor index corresponds to a non existing tensor.");
-    buffer_address_to_identifier_[tensors[index].data.data] = identifier;
+    const TfLiteTensor& tensor = tensors[index];
+    buffer_address_to_identifier_[tensor.data.data] = identifier;
+    tensor_fingerprints_[identifier] =
+        FingerprintBuffer(tensor.data.data, tensor.bytes);
+  }
+
+  // Only a cache file that was loaded, not built by this run, can be stale.
+  if (building_run_ || mmap_handles_.empty() || TensorFingerprintsMatch()) {
+    return;
   }
+  XNNPACK_ABORT_CHECK(first_mapping,
+                      "XNNPack weight cache: '%s' was built for a different "
+                      "model and packed weights may already have been read "
+                      "from it.",
+                      file_path_.c_str());
+  TFLITE_LOG_PROD(tflite::TFLITE_LOG_WARNING,
+                  "XNNPack weight cache: '%s' was built for a different "
+                  "model. Weights will be packed in memory instead. Remove "
+                  "the file for it to be built again.",
+                  file_path_.c_str());
+  mmap_handles_.clear();
+  mmap_buffer_base_offset_ = 0;
+  cache_key_to_offset_.clear();
+  offset_to_addr_.clear();
+  loaded_tensor_fingerprints_.clear();
+  XNNPACK_ABORT_CHECK(StartBuild(kInMemoryCachePath),
+                      "XNNPack weight cache: could not start an in-memory "
+                      "cache build.");
 }
 
 void MMapWeightCacheProvider::RemapDataBuffer(const void* const buffer,
@@ -682,6 +793,8 @@ void* MMapWeightCacheProvider::OffsetToAddr(const size_t offset) {
 
 void MMapWeightCacheProvider::Release() {
   buffer_address_to_identifier_.clear();
+  tensor_fingerprints_.clear();
+  loaded_tensor_fingerprints_.clear();
   cache_key_to_offset_.clear();
   mmap_handles_.clear();
   mmap_buffer_base_offset_ = 0;
@@ -55,7 +55,7 @@ inline constexpr char kInMemoryCachePath[] = ":memory";
 // When reading a cache file, the cache should be rejected if `version`
 // doesn't match `kVersion`.
 struct XNNPackCacheHeader {
-  enum : uint64_t { kInvalidHeader = 0, kVersion = 1 };
+  enum : uint64_t { kInvalidHeader = 0, kVersion = 2 };
   uint64_t version;
   uint8_t xnnpack_build_identifier[32];
   uint64_t buffer_list_offset;
@@ -215,6 +215,12 @@ class WeightCacheBuilder {
   BufferLocation Append(PackIdentifier pack_id, const void* data,
                         uint64_t size);
 
+  // Sets the fingerprints of the constant buffers of the model, written to
+  // disk by the next call to `StopBuildStep` along with those already in the
+  // file.
+  void SetTensorFingerprints(
+      const std::unordered_map<uint64_t, uint64_t>& tensor_fingerprints);
+
   // Writes the flatbuffer to disk.
   [[nodiscard /*Writing the weight cache can fail.*/]]
   bool StopBuildStep();
@@ -264,6 +270,8 @@ class WeightCacheBuilder {
   // cache. To ensure a smooth reloading, we need to ensure that the file header
   // is correct. This flag lets us know if that has happened.
   bool first_write_done_ = false;
+  // The fingerprints set by `SetTensorFingerprints`, by buffer identifier.
+  std::unordered_map<uint64_t, uint64_t> tensor_fingerprints_;
   // Temporary file descriptor to write the weights to disk immediately.
   FileDescriptor fd_;
   std::string file_path_;
@@ -331,6 +339,11 @@ class MMapWeightCacheProvider {
   bool StopBuildStep();
 
   // Creates the tensor map.
+  //
+  // If a cache file was loaded and the content of the tensors doesn't match
+  // the model it was built for, the file is dropped and the weights are packed
+  // in an in-memory cache instead. This aborts if packed weights may already
+  // have been read from the file (i.e. tensors were mapped before).
   void MapTensorIdentifiers(
       const TfLiteTensor* tensors, size_t size,
       const std::unordered_map<size_t, size_t>& tensor_index_to_identifier);
@@ -416,6 +429,10 @@ class MMapWeightCacheProvider {
   [[nodiscard /*Loading cache data may fail.*/]]
   bool LoadLastBuildStep();
 
+  // Returns true if the mapped buffers have the fingerprints recorded in the
+  // loaded cache file.
+  bool TensorFingerprintsMatch() const;
+
   // Cache provider implementation for XNNPack.
   xnn_weights_cache_provider cache_provider_{
       /*context=*/this,
@@ -432,6 +449,13 @@ class MMapWeightCacheProvider {
   // Maps buffer addresses to buffer identifiers.
   std::unordered_map<const void*, uint64_t> buffer_address_to_identifier_;
 
+  // Maps the identifiers of the mapped buffers to their fingerprint.
+  std::unordered_map<uint64_t, uint64_t> tensor_fingerprints_;
+
+  // Maps buffer identifiers to the fingerprint they had when the loaded cache
+  // file was built.
+  std::unordered_map<uint64_t, uint64_t> loaded_tensor_fingerprints_;
+
   std::unordered_map<const void*, const void*> buffer_remaps_;
 
   // Maps cache request hashes to the buffer identifier.
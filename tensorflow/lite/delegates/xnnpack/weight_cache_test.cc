@@ -861,6 +861,41 @@ TEST_F(LoadMMapWeightCacheProviderTest, LookUpSucceeds) {
               ElementsAreArray(reference_2.buffer));
 }
 
+TEST_F(LoadMMapWeightCacheProviderTest, LoadSucceedsForSameModel) {
+  MMapWeightCacheProvider reload_provider;
+  reload_provider.MapTensorIdentifiers(ctx.tensors.data(), ctx.tensors.size(),
+                                       ctx.tensor_buffer_identifiers);
+  ASSERT_TRUE(reload_provider.Load(tmp_file.GetCPath()));
+
+  const xnn_weights_cache_look_up_key look_up_key_1 = LookUpKey1();
+  EXPECT_EQ(reload_provider.LookUp(&look_up_key_1),
+            ctx.packed_buffers.find(pack_id_1)->second.offset);
+}
+
+TEST_F(LoadMMapWeightCacheProviderTest, LoadFailsForModifiedWeights) {
+  ctx.buffers[kWeightIndex2].back() ^= 1;
+
+  MMapWeightCacheProvider reload_provider;
+  reload_provider.MapTensorIdentifiers(ctx.tensors.data(), ctx.tensors.size(),
+                                       ctx.tensor_buffer_identifiers);
+  EXPECT_FALSE(reload_provider.Load(tmp_file.GetCPath()));
+}
+
+TEST_F(LoadMMapWeightCacheProviderTest,
+       ModifiedWeightsMappedAfterLoadFallBackToInMemoryCache) {
+  ctx.buffers[kWeightIndex2].front() ^= 1;
+
+  MMapWeightCacheProvider reload_provider;
+  ASSERT_TRUE(reload_provider.Load(tmp_file.GetCPath()));
+  reload_provider.MapTensorIdentifiers(ctx.tensors.data(), ctx.tensors.size(),
+                                       ctx.tensor_buffer_identifiers);
+
+  EXPECT_EQ(reload_provider.GetFilePath(), kInMemoryCachePath);
+  EXPECT_TRUE(reload_provider.CanStartBuildStep());
+  const xnn_weights_cache_look_up_key look_up_key_2 = LookUpKey2();
+  EXPECT_EQ(reload_provider.LookUp(&look_up_key_2), SIZE_MAX);
+}
+
 TEST(MMapWeightCacheProviderTest, XnnpackCApiJourney) {
   using std::size;
   TempFileDesc temp_fd(TempFileDesc::kAutoClose);
@@ -883,6 +918,7 @@ TEST(MMapWeightCacheProviderTest, XnnpackCApiJourney) {
     std::unordered_map<size_t, size_t> tensor_buffer_identifiers;
     for (int i = 0; i < kBufferCount; ++i) {
       tensors[i].data.data = (void*)(fake_buffer_pointer + i);
+      tensors[i].bytes = 1;
       tensor_buffer_identifiers[i] = i;
     }
 
@@ -998,6 +1034,7 @@ TEST(MMapWeightCacheProviderTest, XnnpackCApiJourney) {
     std::unordered_map<size_t, size_t> tensor_buffer_identifiers;
     for (int i = 0; i < kBufferCount; ++i) {
       tensors[i].data.data = (void*)(fake_buffer_pointer + i);
+      tensors[i].bytes = 1;
       tensor_buffer_identifiers[i] = i;
     }
 
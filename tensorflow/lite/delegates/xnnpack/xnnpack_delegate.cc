@@ -47,6 +47,7 @@ limitations under the License.
 #include "tensorflow/lite/core/c/builtin_op_data.h"
 #include "tensorflow/lite/core/c/common.h"
 #include "tensorflow/lite/core/subgraph.h"
+#include "tensorflow/lite/delegates/utils/host_memory_async_kernel.h"
 #include "tensorflow/lite/delegates/xnnpack/file_util.h"
 #include "tensorflow/lite/delegates/xnnpack/flexbuffers_util.h"
 #include "tensorflow/lite/delegates/xnnpack/quantization_util.h"
@@ -7114,6 +7115,12 @@ class Subgraph {
 
   inline Delegate* GetDelegate() const { return delegate_; }
 
+  // The asynchronous kernel, running Invoke() on the host memory buffers
+  // registered by the application.
+  inline TfLiteAsyncKernel* AsyncKernel() const {
+    return async_kernel_->kernel();
+  }
+
  private:
   Subgraph(Delegate& delegate, xnn_runtime_t runtime,
            const std::unordered_set<int>& externals, std::vector<int>& inputs,
@@ -7129,6 +7136,12 @@ class Subgraph {
     has_variables_ = !delegate.GetAllVariableTensors().empty();
     enable_subgraph_reshaping_ = delegate.enable_subgraph_reshaping();
     delegate_ = &delegate;
+    // XNNPACK operators may read XNN_EXTRA_BYTES past the end of their inputs.
+    async_kernel_ = std::make_unique<delegates::utils::HostMemoryAsyncKernel>(
+        [this](TfLiteContext* context, TfLiteNode* node) {
+          return Invoke(context, enable_subgraph_reshaping_, delegate_);
+        },
+        XNN_EXTRA_BYTES);
   }
 
   // XNNPACK Runtime (subgraph + workspace) with smart-pointer for lifetime
@@ -7157,6 +7170,7 @@ class Subgraph {
   bool variables_set_up_ = false;
   bool enable_subgraph_reshaping_ = false;
   Delegate* delegate_;
+  std::unique_ptr<delegates::utils::HostMemoryAsyncKernel> async_kernel_;
 };
 
 TfLiteIntArray* Delegate::PrepareOpsToDelegate(TfLiteContext* context) {
@@ -7682,6 +7696,14 @@ TfLiteStatus SubgraphInvoke(TfLiteContext* context, TfLiteNode* node) {
                subgraph->GetDelegate());
 }
 
+TfLiteAsyncKernel* SubgraphAsyncKernel(TfLiteContext* context,
+                                       TfLiteNode* node) {
+  if (node->user_data == nullptr) {
+    return nullptr;
+  }
+  return static_cast<Subgraph*>(node->user_data)->AsyncKernel();
+}
+
 void SubgraphFree(TfLiteContext* context, void* buffer) {
   if (buffer != nullptr) {
     delete static_cast<Subgraph*>(buffer);
@@ -7697,6 +7719,8 @@ const TfLiteRegistration kSubgraphRegistration = {
     /*.builtin_code=*/0,
     /*.custom_name=*/"TfLiteXNNPackDelegate",
     /*.version=*/2,
+    /*.registration_external=*/nullptr,
+    /*.async_kernel=*/SubgraphAsyncKernel,
 };
 
 TfLiteStatus DelegatePrepare(TfLiteContext* context, TfLiteDelegate* delegate) {
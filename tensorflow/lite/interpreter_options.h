@@ -103,12 +103,33 @@ class InterpreterOptions {
     return experimental_cache_constant_cast_op_;
   }
 
+  // If set to `true` and the model is memory mapped, the OS is told not to read
+  // ahead the constant buffers stored after the flatbuffer (in models larger
+  // than 2GB for instance), so that only the pages the kernels access are
+  // loaded. This lowers the peak memory usage of models whose weights are
+  // sparsely accessed, e.g. large embedding tables, at the cost of more page
+  // faults for the others.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  void SetLazyLoadOffsetBuffers(bool value) {
+    experimental_lazy_load_offset_buffers_ = value;
+  }
+
+  // If `true`, the pages of the constant buffers stored after the flatbuffer
+  // are loaded on access only.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  bool GetLazyLoadOffsetBuffers() const {
+    return experimental_lazy_load_offset_buffers_;
+  }
+
  private:
   bool experimental_preserve_all_tensors_ = false;
   bool experimental_ensure_dynamic_tensors_are_released_ = false;
   int experimental_optimize_memory_for_large_tensors_ = 0;
   bool experimental_disable_delegate_clustering_ = false;
   bool experimental_cache_constant_cast_op_ = false;
+  bool experimental_lazy_load_offset_buffers_ = false;
 };
 
 }  // namespace tflite
@@ -38,6 +38,7 @@ limitations under the License.
 #include "tensorflow/lite/kernels/internal/optimized/multithreaded_conv.h"
 #endif
 #include "tensorflow/lite/kernels/internal/optimized/optimized_ops.h"
+#include "tensorflow/lite/kernels/internal/optimized/sparse_ops/fully_connected.h"
 #include "tensorflow/lite/kernels/internal/portable_tensor_utils.h"
 #include "tensorflow/lite/kernels/internal/reference/conv.h"
 #include "tensorflow/lite/kernels/internal/reference/integer_ops/conv.h"
@@ -122,6 +123,12 @@ struct OpData {
   int32_t groups = 1;
 
   TfLiteType quantized_bias_type = kTfLiteNoType;
+
+  // The sparsity of a sparse 1x1 filter, viewed as the [channels_out,
+  // channels_in] weights of a FullyConnected. It points to the arrays of the
+  // filter's sparsity.
+  TfLiteSparsity sparse_filter = {};
+  TfLiteDimensionMetadata sparse_filter_dim_metadata[3] = {};
 };
 
 inline PaddingType RuntimePaddingType(TfLitePadding padding) {
@@ -216,6 +223,92 @@ bool IsIm2ColRequired(const TfLiteTensor* input, TfLiteConvParams* params,
   }
 }
 
+// Checks that a sparse `filter` is one the sparse FullyConnected kernels can
+// run directly, and stores its sparsity in the FullyConnected format in
+// `data`. Such filters are 1x1, applied with stride and dilation 1, and are
+// either random sparse or block sparse with 1xN blocks along the input
+// channels. Other sparse filters must be densified by the model.
+TfLiteStatus PrepareSparseFilter(TfLiteContext* context,
+                                 const TfLiteConvParams* params,
+                                 const TfLiteTensor* input,
+                                 const TfLiteTensor* filter, OpData* data) {
+  const TfLiteSparsity& sparsity = *filter->sparsity;
+  if (filter->dims->data[1] != 1 || filter->dims->data[2] != 1 ||
+      params->stride_width != 1 || params->stride_height != 1 ||
+      params->dilation_width_factor != 1 ||
+      params->dilation_height_factor != 1 || data->groups != 1) {
+    TF_LITE_KERNEL_LOG(context,
+                       "Sparse filters are only supported for pointwise "
+                       "convolutions with stride and dilation 1.");
+    return kTfLiteError;
+  }
+  TF_LITE_ENSURE(context, input->type == kTfLiteFloat32 ||
+                              input->type == kTfLiteInt8);
+  TF_LITE_ENSURE_TYPES_EQ(context, filter->type, input->type);
+  // [channels_out, 1, 1, channels_in], traversed in order, with an optional
+  // block dimension splitting channels_in.
+  const int dim_metadata_size = sparsity.dim_metadata_size;
+  TF_LITE_ENSURE(context, dim_metadata_size == 4 || dim_metadata_size == 5);
+  TF_LITE_ENSURE(context, sparsity.traversal_order &&
+                              sparsity.traversal_order->size ==
+                                  dim_metadata_size);
+  for (int i = 0; i < dim_metadata_size; ++i) {
+    TF_LITE_ENSURE_EQ(context, sparsity.traversal_order->data[i], i);
+  }
+  for (int i = 0; i < 3; ++i) {
+    TF_LITE_ENSURE_EQ(context, sparsity.dim_metadata[i].format,
+                      kTfLiteDimDense);
+  }
+  TF_LITE_ENSURE_EQ(context, sparsity.dim_metadata[1].dense_size, 1);
+  TF_LITE_ENSURE_EQ(context, sparsity.dim_metadata[2].dense_size, 1);
+  TF_LITE_ENSURE_EQ(context, sparsity.dim_metadata[3].format,
+                    kTfLiteDimSparseCSR);
+  int block_size = 1;
+  if (dim_metadata_size == 5) {
+    TF_LITE_ENSURE(context, sparsity.block_map &&
+                                sparsity.block_map->size == 1 &&
+                                sparsity.block_map->data[0] == 3);
+    TF_LITE_ENSURE_EQ(context, sparsity.dim_metadata[4].format,
+                      kTfLiteDimDense);
+    block_size = sparsity.dim_metadata[4].dense_size;
+  }
+  // The float kernels are specialized for random sparse and 1x4 blocks.
+  if (input->type == kTfLiteFloat32 && block_size != 1 && block_size != 4) {
+    TF_LITE_KERNEL_LOG(context, "Unsupported sparse filter block size %d.",
+                       block_size);
+    return kTfLiteError;
+  }
+
+  const int channels_out = filter->dims->data[0];
+  const int channels_in = filter->dims->data[3];
+  const TfLiteIntArray* segments = sparsity.dim_metadata[3].array_segments;
+  const TfLiteIntArray* indices = sparsity.dim_metadata[3].array_indices;
+  TF_LITE_ENSURE(context, segments && indices);
+  TF_LITE_ENSURE_EQ(context, segments->size, channels_out + 1);
+  TF_LITE_ENSURE_EQ(context, segments->data[channels_out], indices->size);
+  size_t filter_type_size;
+  TF_LITE_ENSURE_STATUS(
+      GetSizeOfType(context, filter->type, &filter_type_size));
+  TF_LITE_ENSURE(context, static_cast<size_t>(indices->size) * block_size *
+                                  filter_type_size <=
+                              filter->bytes);
+  for (int i = 0; i < indices->size; ++i) {
+    TF_LITE_ENSURE(context, indices->data[i] >= 0 &&
+                                (indices->data[i] + 1) * block_size <=
+                                    channels_in);
+  }
+
+  data->sparse_filter_dim_metadata[0] = sparsity.dim_metadata[0];
+  data->sparse_filter_dim_metadata[1] = sparsity.dim_metadata[3];
+  if (dim_metadata_size == 5) {
+    data->sparse_filter_dim_metadata[2] = sparsity.dim_metadata[4];
+  }
+  data->sparse_filter = {};
+  data->sparse_filter.dim_metadata = data->sparse_filter_dim_metadata;
+  data->sparse_filter.dim_metadata_size = dim_metadata_size - 2;
+  return kTfLiteOk;
+}
+
 // Allocate temporary tensors (`im2col`, `hwcn_weights` if necessary).
 // Note: `context->AddTensors` might invalidate pointers to existing tensors.
 // Therefore the logic to add tensors are isolated into this function.
@@ -444,7 +537,13 @@ TfLiteStatus Prepare(KernelType kernel_type, TfLiteContext* context,
       (context->recommended_num_threads != 1) && !is_hybrid &&
       (params->dilation_width_factor == 1) &&
       (params->dilation_height_factor == 1) &&
-      (filter->allocation_type != kTfLiteArenaRw) && !IsDynamicTensor(filter);
+      (filter->allocation_type != kTfLiteArenaRw) && !IsDynamicTensor(filter) &&
+      filter->sparsity == nullptr;
+
+  if (filter->sparsity != nullptr) {
+    TF_LITE_ENSURE_STATUS(
+        PrepareSparseFilter(context, params, input, filter, data));
+  }
 
   int channels_in = filter->dims->data[3];
   int channels_out = filter->dims->data[0];
@@ -727,6 +826,9 @@ void EvalQuantized(TfLiteContext* context, TfLiteNode* node,
   op_params.output_shift = -data->output_shift;
   op_params.quantized_activation_min = data->output_activation_min;
   op_params.quantized_activation_max = data->output_activation_max;
+  // Unpacked int4 filters are temporary buffers, which can't be cached.
+  op_params.lhs_cacheable =
+      IsConstantTensor(filter) && filter->type != kTfLiteInt4;
   switch (effective_kernel_type) {
     case kReference: {
       reference_ops::Conv(
@@ -772,6 +874,8 @@ void EvalQuantizedPerChannel(TfLiteContext* context, TfLiteNode* node,
   op_params.padding_values.width = data->padding.width;
   op_params.quantized_activation_min = data->output_activation_min;
   op_params.quantized_activation_max = data->output_activation_max;
+  op_params.lhs_cacheable =
+      IsConstantTensor(filter) && filter->type != kTfLiteInt4;
 
   KernelType effective_kernel_type = kernel_type;
   // We have to fallback to reference execution path when im2col is needed but
@@ -866,6 +970,8 @@ void EvalQuantizedPerChannel16x8(TfLiteContext* context, TfLiteNode* node,
   op_params.padding_values.width = data->padding.width;
   op_params.quantized_activation_min = data->output_activation_min;
   op_params.quantized_activation_max = data->output_activation_max;
+  op_params.lhs_cacheable =
+      IsConstantTensor(filter) && filter->type != kTfLiteInt4;
 
   KernelType effective_kernel_type = kernel_type;
   // We have to fallback to reference execution path when im2col is needed but
@@ -980,6 +1086,7 @@ void EvalFloat(TfLiteContext* context, TfLiteNode* node,
   op_params.dilation_height_factor = params->dilation_height_factor;
   op_params.float_activation_min = output_activation_min;
   op_params.float_activation_max = output_activation_max;
+  op_params.lhs_cacheable = IsConstantTensor(filter);
   switch (effective_kernel_type) {
     case kReference: {
       reference_ops::Conv(op_params, GetTensorShape(input),
@@ -1027,6 +1134,57 @@ void EvalFloat(TfLiteContext* context, TfLiteNode* node,
   }
 }
 
+// Computes a pointwise convolution with a sparse filter as a FullyConnected
+// over the pixels of the input.
+TfLiteStatus EvalSparse(TfLiteContext* context, TfLiteConvParams* params,
+                        OpData* data, const TfLiteTensor* input,
+                        const TfLiteTensor* filter, const TfLiteTensor* bias,
+                        TfLiteTensor* output) {
+  const int channels_in = filter->dims->data[3];
+  const int channels_out = filter->dims->data[0];
+  const int pixels = NumElements(input) / channels_in;
+  const RuntimeShape input_shape({pixels, channels_in});
+  const RuntimeShape filter_shape({channels_out, channels_in});
+  const RuntimeShape bias_shape({channels_out});
+  const RuntimeShape output_shape({pixels, channels_out});
+  const TfLiteSparsity& sparsity = data->sparse_filter;
+  CpuBackendContext* cpu_backend_context =
+      CpuBackendContext::GetFromContext(context);
+
+  FullyConnectedParams op_params;
+  if (input->type == kTfLiteFloat32) {
+    CalculateActivationRange(params->activation,
+                             &op_params.float_activation_min,
+                             &op_params.float_activation_max);
+    if (sparsity.dim_metadata_size == 2) {
+      optimized_ops::FullyConnectedSparseWeight(
+          sparsity, op_params, input_shape, GetTensorData<float>(input),
+          filter_shape, GetTensorData<float>(filter), bias_shape,
+          GetTensorData<float>(bias), output_shape,
+          GetTensorData<float>(output));
+    } else {
+      optimized_ops::FullyConnectedSparseWeight1x4(
+          sparsity, op_params, input_shape, GetTensorData<float>(input),
+          filter_shape, GetTensorData<float>(filter), bias_shape,
+          GetTensorData<float>(bias), output_shape,
+          GetTensorData<float>(output), cpu_backend_context);
+    }
+    return kTfLiteOk;
+  }
+  op_params.input_offset = -input->params.zero_point;
+  op_params.output_offset = output->params.zero_point;
+  op_params.quantized_activation_min = data->output_activation_min;
+  op_params.quantized_activation_max = data->output_activation_max;
+  optimized_ops::FullyConnectedSparseWeightInt8(
+      sparsity, op_params, input_shape, GetTensorData<int8_t>(input),
+      filter_shape, GetTensorData<int8_t>(filter),
+      data->per_channel_output_multiplier.data(),
+      data->per_channel_output_shift.data(), bias_shape,
+      GetTensorData<int32_t>(bias), output_shape, GetTensorData<int8_t>(output),
+      cpu_backend_context);
+  return kTfLiteOk;
+}
+
 template <KernelType kernel_type>
 TfLiteStatus EvalHybridPerChannel(TfLiteContext* context, TfLiteNode* node,
                                   TfLiteConvParams* params, OpData* data,
@@ -1278,6 +1436,10 @@ TfLiteStatus EvalImpl(TfLiteContext* context, TfLiteNode* node) {
     data->have_weights_been_transposed = true;
   }
 
+  if (filter->sparsity != nullptr) {
+    return EvalSparse(context, params, data, input, filter, bias, output);
+  }
+
   TFLITE_DCHECK_EQ(input_type, input->type);
   switch (input_type) {  // Already know in/outtypes are same.
     case kTfLiteFloat32:
@@ -45,6 +45,7 @@ TfLiteRegistration* Register_CONVOLUTION_CBLAS_OPT();
 
 namespace {
 
+using ::testing::ElementsAre;
 using ::testing::ElementsAreArray;
 
 template <typename FilterType>
@@ -2346,6 +2347,90 @@ TEST_P(ConvolutionOpTest, SimpleTestHybridWithDilationPerChannel) {
                                  0.16)));
 }
 
+// A pointwise convolution with a constant sparse float filter.
+class SparseConvolutionOpModel : public SingleOpModel {
+ public:
+  SparseConvolutionOpModel(TfLiteRegistration* registration,
+                           const TensorData& input, const TensorData& filter,
+                           const std::vector<float>& filter_data) {
+    input_ = AddInput(input);
+    filter_ = AddConstSparseInput(filter, filter_data);
+    bias_ = AddInput({TensorType_FLOAT32, {filter.shape[0]}});
+    output_ = AddOutput({TensorType_FLOAT32, {}});
+    SetBuiltinOp(BuiltinOperator_CONV_2D, BuiltinOptions_Conv2DOptions,
+                 CreateConv2DOptions(builder_, Padding_VALID,
+                                     /*stride_w=*/1, /*stride_h=*/1)
+                     .Union());
+    resolver_ = std::make_unique<SingleOpResolver>(BuiltinOperator_CONV_2D,
+                                                   registration);
+    BuildInterpreter({GetShape(input_), GetShape(filter_), GetShape(bias_)});
+  }
+
+  void SetBias(std::initializer_list<float> f) { PopulateTensor(bias_, f); }
+  void SetInput(std::initializer_list<float> data) {
+    PopulateTensor(input_, data);
+  }
+  std::vector<float> GetOutput() { return ExtractVector<float>(output_); }
+  std::vector<int> GetOutputShape() { return GetTensorShape(output_); }
+
+ private:
+  int input_;
+  int filter_;
+  int bias_;
+  int output_;
+};
+
+const std::vector<float>* const kSparseFilterData = new std::vector<float>({
+    1, 2, 3, 4, 0, 0, 0, 0,    // first 1x1 filter
+    0, 0, 0, 0, -1, 1, -1, 1,  // second 1x1 filter
+});
+
+TEST_P(ConvolutionOpTest, SparseFilterFloat32) {
+  TensorData filter = {TensorType_FLOAT32, {2, 1, 1, 8}};
+  filter.traversal_order = {0, 1, 2, 3};
+  filter.format = {kTfLiteDimDense, kTfLiteDimDense, kTfLiteDimDense,
+                   kTfLiteDimSparseCSR};
+  SparseConvolutionOpModel m(GetRegistration(),
+                             {TensorType_FLOAT32, {1, 2, 2, 8}}, filter,
+                             *kSparseFilterData);
+  m.SetInput({
+      1, 1, 1, 1, 1, 1, 1, 1,  // top left
+      1, 2, 3, 4, 5, 6, 7, 8,  // top right
+      2, 2, 2, 2, 2, 2, 2, 2,  // bottom left
+      8, 7, 6, 5, 4, 3, 2, 1,  // bottom right
+  });
+  m.SetBias({1, 2});
+
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  EXPECT_THAT(m.GetOutputShape(), ElementsAre(1, 2, 2, 2));
+  EXPECT_THAT(m.GetOutput(), ElementsAreArray({11, 2, 31, 4, 21, 2, 61, 0}));
+}
+
+TEST_P(ConvolutionOpTest, SparseFilter1x4Float32) {
+  TensorData filter = {TensorType_FLOAT32, {2, 1, 1, 8}};
+  filter.traversal_order = {0, 1, 2, 3, 4};
+  filter.format = {kTfLiteDimDense, kTfLiteDimDense, kTfLiteDimDense,
+                   kTfLiteDimSparseCSR};
+  filter.block_map = {3};
+  filter.block_size = {4};
+  SparseConvolutionOpModel m(GetRegistration(),
+                             {TensorType_FLOAT32, {1, 2, 2, 8}}, filter,
+                             *kSparseFilterData);
+  m.SetInput({
+      1, 1, 1, 1, 1, 1, 1, 1,  // top left
+      1, 2, 3, 4, 5, 6, 7, 8,  // top right
+      2, 2, 2, 2, 2, 2, 2, 2,  // bottom left
+      8, 7, 6, 5, 4, 3, 2, 1,  // bottom right
+  });
+  m.SetBias({1, 2});
+
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  EXPECT_THAT(m.GetOutputShape(), ElementsAre(1, 2, 2, 2));
+  EXPECT_THAT(m.GetOutput(), ElementsAreArray({11, 2, 31, 4, 21, 2, 61, 0}));
+}
+
 const auto kQuantizedKernelMap = new std::map<string, TfLiteRegistration*>({
     {"GenericOptimized", ops::builtin::Register_CONV_2D_UINT8()},
 });
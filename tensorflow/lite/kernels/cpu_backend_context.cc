@@ -151,6 +151,10 @@ void CpuBackendContext::SetMaxNumThreads(int max_num_threads) {
 
 void CpuBackendContext::SetUseCaching(bool flag) { use_caching_ = flag; }
 
+void CpuBackendContext::SetAlwaysCacheConstantData(bool flag) {
+  always_cache_constant_data_ = flag;
+}
+
 #ifdef TFLITE_KERNEL_USE_XNNPACK
 pthreadpool_t CpuBackendContext::get_xnnpack_threadpool() {
   if (!xnnpack_threadpool_ && max_num_threads_ > 1) {
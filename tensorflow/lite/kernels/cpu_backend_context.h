@@ -56,6 +56,16 @@ class CpuBackendContext final : public TfLiteInternalBackendContext {
 
   bool use_caching() const { return use_caching_; }
 
+  // When caching, sets whether to cache the prepacked constant operands of
+  // all matrix multiplications, rather than only of the narrow ones (like
+  // matrix*vector) where it is a large speedup. Ruy evicts the least
+  // recently used prepacked matrices beyond its own cache size limit.
+  void SetAlwaysCacheConstantData(bool flag);
+
+  bool always_cache_constant_data() const {
+    return always_cache_constant_data_;
+  }
+
 #ifdef TFLITE_KERNEL_USE_XNNPACK
   pthreadpool_t get_xnnpack_threadpool();
 #endif
@@ -121,6 +131,9 @@ class CpuBackendContext final : public TfLiteInternalBackendContext {
   // CpuBackendGem operations to a library that permits such an optimization
   // (currently the Ruy library only).
   bool use_caching_;
+  // If use_caching_, whether constant operands are cached regardless of the
+  // expected speedup.
+  bool always_cache_constant_data_ = false;
 
 #ifdef TFLITE_KERNEL_USE_XNNPACK
   // A smart pointer for the xnnpack threadpool. Is created by a call from the
@@ -43,7 +43,8 @@ inline ruy::CachePolicy ToRuyCachePolicy(CachePolicy cache_policy) {
 
 template <typename Scalar, typename DataPointer>
 void MakeRuyMatrix(const MatrixParams<Scalar>& params, DataPointer data_ptr,
-                   ruy::Matrix<Scalar>* dst, bool use_caching = false) {
+                   ruy::Matrix<Scalar>* dst, bool use_caching = false,
+                   bool always_cache_constant_data = false) {
   ruy::Order ruy_order = params.order == Order::kColMajor
                              ? ruy::Order::kColMajor
                              : ruy::Order::kRowMajor;
@@ -54,7 +55,12 @@ void MakeRuyMatrix(const MatrixParams<Scalar>& params, DataPointer data_ptr,
   dst->set_data(data_ptr);
   dst->set_zero_point(params.zero_point);
   if (use_caching) {
-    dst->set_cache_policy(ToRuyCachePolicy(params.cache_policy));
+    CachePolicy cache_policy = params.cache_policy;
+    if (always_cache_constant_data &&
+        cache_policy == CachePolicy::kCacheIfLargeSpeedup) {
+      cache_policy = CachePolicy::kAlwaysCache;
+    }
+    dst->set_cache_policy(ToRuyCachePolicy(cache_policy));
   }
 }
 
@@ -131,8 +137,10 @@ struct GemmImplUsingRuy {
     ruy::Matrix<LhsScalar> ruy_lhs;
     ruy::Matrix<RhsScalar> ruy_rhs;
     ruy::Matrix<DstScalar> ruy_dst;
-    MakeRuyMatrix(lhs_params, lhs_data, &ruy_lhs, context->use_caching());
-    MakeRuyMatrix(rhs_params, rhs_data, &ruy_rhs, context->use_caching());
+    MakeRuyMatrix(lhs_params, lhs_data, &ruy_lhs, context->use_caching(),
+                  context->always_cache_constant_data());
+    MakeRuyMatrix(rhs_params, rhs_data, &ruy_rhs, context->use_caching(),
+                  context->always_cache_constant_data());
     MakeRuyMatrix(dst_params, dst_data, &ruy_dst);
 
     ruy::MulParams<AccumScalar, DstScalar> ruy_mul_params;
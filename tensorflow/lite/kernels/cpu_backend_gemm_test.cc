@@ -632,6 +632,30 @@ TEST(CpuBackendGemmSimpleTestAgainstGolden, Int8Int16) {
       3, 5, 4, {19, 48, 77, 48, 149, 250, 76, 249, 422, 105, 350, 595});
 }
 
+TEST(CpuBackendGemmCachePolicyTest, AlwaysCacheConstantData) {
+  MatrixParams<float> params;
+  params.rows = 2;
+  params.cols = 2;
+  const float data[4] = {1, 2, 3, 4};
+  ruy::Matrix<float> matrix;
+
+  params.cache_policy = cpu_backend_gemm::CachePolicy::kCacheIfLargeSpeedup;
+  cpu_backend_gemm::detail::MakeRuyMatrix(params, data, &matrix,
+                                          /*use_caching=*/true);
+  EXPECT_EQ(matrix.cache_policy(), ruy::CachePolicy::kCacheIfLargeSpeedup);
+  cpu_backend_gemm::detail::MakeRuyMatrix(
+      params, data, &matrix, /*use_caching=*/true,
+      /*always_cache_constant_data=*/true);
+  EXPECT_EQ(matrix.cache_policy(), ruy::CachePolicy::kAlwaysCache);
+
+  // Data that isn't constant is never cached.
+  params.cache_policy = cpu_backend_gemm::CachePolicy::kNeverCache;
+  cpu_backend_gemm::detail::MakeRuyMatrix(
+      params, data, &matrix, /*use_caching=*/true,
+      /*always_cache_constant_data=*/true);
+  EXPECT_EQ(matrix.cache_policy(), ruy::CachePolicy::kNeverCache);
+}
+
 template <typename tLhsScalar, typename tRhsScalar, typename tAccumScalar,
           typename tDstScalar>
 struct TypesTuple {
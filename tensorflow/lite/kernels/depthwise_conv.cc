@@ -119,6 +119,13 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
   TF_LITE_ENSURE_EQ(context, NumDimensions(filter), 4);
   TF_LITE_ENSURE(context, params->dilation_height_factor > 0);
   TF_LITE_ENSURE(context, params->dilation_width_factor > 0);
+  // The kernels read the filter as a dense tensor.
+  if (filter->sparsity != nullptr) {
+    TF_LITE_KERNEL_LOG(context,
+                       "Sparse depthwise filters must be densified by the "
+                       "model (DENSIFY).");
+    return kTfLiteError;
+  }
 
   const TfLiteType data_type = input->type;
 
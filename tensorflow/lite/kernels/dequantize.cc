@@ -15,6 +15,15 @@ limitations under the License.
 #include "tensorflow/lite/kernels/dequantize.h"
 
 #include <stddef.h>
+#include <stdint.h>
+
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include "tensorflow/lite/core/c/common.h"
 #include "tensorflow/lite/kernels/internal/optimized/neon_check.h"
@@ -37,6 +46,83 @@ struct OpContext {
 struct OpData {
   // This boolean value is only used when the input tensor is constant.
   bool float_dequantized_weights_initialized;
+  // The dequantized constant input, shared with the nodes dequantizing the
+  // same buffer of the same model in other interpreters. Null if the output
+  // is allocated in the arena.
+  std::shared_ptr<std::vector<float>> shared_weights;
+};
+
+// Identifies the dequantized values of a constant tensor: its buffer in the
+// model, its type and its quantization parameters.
+using SharedWeightsKey =
+    std::tuple<const void*, size_t, TfLiteType, std::vector<float>,
+               std::vector<int32_t>, int32_t>;
+
+SharedWeightsKey GetSharedWeightsKey(const TfLiteTensor* input) {
+  std::vector<float> scales = {input->params.scale};
+  std::vector<int32_t> zero_points = {input->params.zero_point};
+  int32_t quantized_dimension = 0;
+  if (IsQuantizedPerChannel(input)) {
+    const auto* params = reinterpret_cast<const TfLiteAffineQuantization*>(
+        input->quantization.params);
+    scales.assign(params->scale->data,
+                  params->scale->data + params->scale->size);
+    zero_points.assign(params->zero_point->data,
+                       params->zero_point->data + params->zero_point->size);
+    quantized_dimension = params->quantized_dimension;
+  }
+  return SharedWeightsKey(input->data.raw_const, input->bytes, input->type,
+                          std::move(scales), std::move(zero_points),
+                          quantized_dimension);
+}
+
+// The dequantized constant tensors of the models loaded in the process. The
+// interpreters built from a model share the model buffers, so that the nodes
+// dequantizing a buffer in each of them can share a single float buffer.
+class SharedWeights {
+ public:
+  static SharedWeights& Get() {
+    static SharedWeights* shared_weights = new SharedWeights();
+    return *shared_weights;
+  }
+
+  // Sets `output` to the values of the constant tensor `input` dequantized
+  // by `dequantize(input, output)`, which only runs if no other node
+  // currently holds them. The returned buffer holds the values of `output`,
+  // which is left read-only: it is not owned by the interpreter, like the
+  // constant tensors of the model.
+  template <typename DequantizeFn>
+  std::shared_ptr<std::vector<float>> Dequantize(const TfLiteTensor* input,
+                                                 TfLiteTensor* output,
+                                                 DequantizeFn dequantize) {
+    SharedWeightsKey key = GetSharedWeightsKey(input);
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_ptr<std::vector<float>> weights;
+    auto it = weights_.find(key);
+    if (it != weights_.end()) weights = it->second.lock();
+    if (!weights) {
+      for (it = weights_.begin(); it != weights_.end();) {
+        it = it->second.expired() ? weights_.erase(it) : std::next(it);
+      }
+      // Like heap allocated tensors, the buffer is padded for XNNPack.
+      constexpr size_t kXnnExtraBytes = 16;
+      weights = std::make_shared<std::vector<float>>(
+          (output->bytes + kXnnExtraBytes) / sizeof(float));
+      output->data.f = weights->data();
+      if (dequantize(input, output) != kTfLiteOk) {
+        output->data.raw = nullptr;
+        return nullptr;
+      }
+      weights_[std::move(key)] = weights;
+    }
+    output->data.f = weights->data();
+    output->allocation_type = kTfLiteMmapRo;
+    return weights;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::map<SharedWeightsKey, std::weak_ptr<std::vector<float>>> weights_;
 };
 
 void* Init(TfLiteContext* context, const char* buffer, size_t length) {
@@ -49,7 +135,9 @@ void Free(TfLiteContext* context, void* buffer) {
   delete reinterpret_cast<OpData*>(buffer);
 }
 
+template <KernelType kernel_type>
 TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
+  OpData* op_data = reinterpret_cast<OpData*>(node->user_data);
   TF_LITE_ENSURE_EQ(context, NumInputs(node), 1);
   TF_LITE_ENSURE_EQ(context, NumOutputs(node), 1);
 
@@ -65,9 +153,30 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
     TF_LITE_ENSURE_EQ(context, op_context.input->params.zero_point, 0);
   }
 
+  if (op_data->shared_weights) {
+    return kTfLiteOk;
+  }
   op_context.output->type = kTfLiteFloat32;
-  // If the input tensor is constant, we can persist the dequantized value in
-  // the output tensor. Otherwise we run dequantize upon each eval.
+  // If the input tensor is constant, we dequantize it once, into a buffer
+  // shared by the interpreters built from the same model. Otherwise we run
+  // dequantize upon each eval.
+  if (IsConstantTensor(op_context.input) &&
+      op_context.output->allocation_type == kTfLiteArenaRw) {
+    TF_LITE_ENSURE_OK(
+        context, context->ResizeTensor(
+                     context, op_context.output,
+                     TfLiteIntArrayCopy(op_context.input->dims)));
+    op_data->shared_weights = SharedWeights::Get().Dequantize(
+        op_context.input, op_context.output,
+        [context, node](const TfLiteTensor* input, TfLiteTensor* output) {
+          return DequantizeImpl<kernel_type>(context, node, input, output);
+        });
+    TF_LITE_ENSURE(context, op_data->shared_weights != nullptr);
+    op_data->float_dequantized_weights_initialized = true;
+    return kTfLiteOk;
+  }
+  // Otherwise, if the input tensor is constant, we can persist the dequantized
+  // value in the output tensor.
   if (IsConstantTensor(op_context.input)) {
     op_context.output->allocation_type = kTfLiteArenaRwPersistent;
   }
@@ -100,14 +209,15 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
 
 TfLiteRegistration* Register_DEQUANTIZE_OPT() {
   static TfLiteRegistration r = {
-      dequantize::Init, dequantize::Free, dequantize::Prepare,
+      dequantize::Init, dequantize::Free,
+      dequantize::Prepare<dequantize::kGenericOptimized>,
       dequantize::Eval<dequantize::kGenericOptimized>};
   return &r;
 }
 
 TfLiteRegistration* Register_DEQUANTIZE_REF() {
   static TfLiteRegistration r = {dequantize::Init, dequantize::Free,
-                                 dequantize::Prepare,
+                                 dequantize::Prepare<dequantize::kReference>,
                                  dequantize::Eval<dequantize::kReference>};
   return &r;
 }
@@ -24,6 +24,7 @@ limitations under the License.
 #include "flatbuffers/flatbuffers.h"  // from @flatbuffers
 #include "tensorflow/lite/core/api/op_resolver.h"
 #include "tensorflow/lite/core/interpreter.h"
+#include "tensorflow/lite/core/interpreter_builder.h"
 #include "tensorflow/lite/kernels/internal/types.h"
 #include "tensorflow/lite/kernels/test_util.h"
 #include "tensorflow/lite/schema/schema_generated.h"
@@ -137,6 +138,52 @@ TEST(DequantizeOpTest, Int16) {
                   {-64.5, -63, -62.5, -62, -61.5, 62, 62.5, 63, 63.5, 65.5})));
 }
 
+class DequantizeConstOpModel : public DequantizeOpModel {
+ public:
+  DequantizeConstOpModel(std::initializer_list<int> shape, float scale,
+                         int32_t zero_point,
+                         std::initializer_list<int8_t> data) {
+    input_ = AddConstInput(
+        TensorData{TensorType_INT8, shape, 0, 0, scale, zero_point}, data);
+    output_ = AddOutput({TensorType_FLOAT32, shape});
+    SetBuiltinOp(BuiltinOperator_DEQUANTIZE, BuiltinOptions_DequantizeOptions,
+                 CreateDequantizeOptions(builder_).Union());
+
+    resolver_ = std::make_unique<SingleOpResolver>(
+        BuiltinOperator_DEQUANTIZE, ops::builtin::Register_DEQUANTIZE(),
+        /*version=*/2);
+
+    BuildInterpreter({});
+  }
+
+  // Builds another interpreter from the model of this one.
+  std::unique_ptr<Interpreter> BuildOtherInterpreter() {
+    std::unique_ptr<Interpreter> interpreter;
+    InterpreterBuilder(GetModel(builder_.GetBufferPointer()), *resolver_)(
+        &interpreter);
+    return interpreter;
+  }
+};
+
+TEST(DequantizeOpTest, ConstantInputIsSharedAcrossInterpreters) {
+  DequantizeConstOpModel m({2, 5}, 0.5, -1,
+                           {-128, -127, -126, -125, -124, 123, 124, 125, 126,
+                            127});
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  EXPECT_THAT(m.GetOutput(),
+              ElementsAreArray(ArrayFloatNear(
+                  {-63.5, -63, -62.5, -62, -61.5, 62, 62.5, 63, 63.5, 64})));
+
+  std::unique_ptr<Interpreter> other = m.BuildOtherInterpreter();
+  ASSERT_NE(other, nullptr);
+  ASSERT_EQ(other->AllocateTensors(), kTfLiteOk);
+  ASSERT_EQ(other->Invoke(), kTfLiteOk);
+  const TfLiteTensor* output = m.GetOutputTensor(0);
+  const TfLiteTensor* other_output = other->output_tensor(0);
+  EXPECT_EQ(other_output->allocation_type, kTfLiteMmapRo);
+  EXPECT_EQ(other_output->data.raw, output->data.raw);
+}
+
 class DequantizePerChannelOpModel : public DequantizeOpModel {
  public:
   DequantizePerChannelOpModel(TensorType type, std::initializer_list<int> shape,
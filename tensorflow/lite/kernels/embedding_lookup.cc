@@ -28,6 +28,10 @@ limitations under the License.
 //   or a dequantized value in the case of a uint8 input.
 //   When indices are out of bound, the ops will not succeed.
 //
+// Only the looked up rows of Tensor[1] are read, and quantized rows are
+// dequantized one at a time, so a constant table mapped from the model file is
+// only paged in as its rows are used.
+//
 
 #include <stdint.h>
 
@@ -63,11 +67,11 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
     TF_LITE_ENSURE(context, qparams->zero_point != nullptr);
     TfLiteTensor* output;
     TF_LITE_ENSURE_OK(context, GetOutputSafe(context, node, 0, &output));
-    if ((value->type == kTfLiteUInt8 || value->type == kTfLiteInt8 ||
-         value->type == kTfLiteInt4) &&
-        (output->type == kTfLiteFloat32)) {
-      // EvalHybrid supports only symmetric quantization for now.
-      TF_LITE_ENSURE(context, qparams->zero_point->data[0] == 0);
+    if (value->type == kTfLiteUInt8 && output->type == kTfLiteFloat32) {
+      // EvalHybrid reads uint8 tables as symmetrically quantized int8 values.
+      for (int i = 0; i < qparams->zero_point->size; ++i) {
+        TF_LITE_ENSURE(context, qparams->zero_point->data[i] == 0);
+      }
     }
     if (qparams->scale->size > 1 || qparams->zero_point->size > 1) {
       // Per-axis quantization is supported by EvalHybrid only.
@@ -132,7 +136,7 @@ TfLiteStatus EvalHybrid(TfLiteContext* context, TfLiteNode* node,
   const int row_size = SizeOfDimension(value, 0);
 
   // col_size after we flatten tensor into 2D.
-  int col_size = 1;
+  int64_t col_size = 1;
   for (int i = 1; i < NumDimensions(value); i++) {
     col_size *= SizeOfDimension(value, i);
   }
@@ -140,6 +144,11 @@ TfLiteStatus EvalHybrid(TfLiteContext* context, TfLiteNode* node,
   float* output_ptr = GetTensorData<float>(output);
   const int8_t* value_ptr = GetTensorData<int8_t>(value);
   const int32_t* lookup_data = GetTensorData<int32_t>(lookup);
+  const TfLiteAffineQuantization* qparams =
+      value->quantization.type == kTfLiteAffineQuantization
+          ? static_cast<const TfLiteAffineQuantization*>(
+                value->quantization.params)
+          : nullptr;
 
   for (int i = 0; i < SizeOfDimension(lookup, 0); i++) {
     int idx = lookup_data[i];
@@ -154,29 +163,33 @@ TfLiteStatus EvalHybrid(TfLiteContext* context, TfLiteNode* node,
       // TODO(alanchiao): refactor scalar multiply into separate function
       // for ease of adding a neon equivalent if ever necessary.
       double scaling_factor = value->params.scale;
-      if (value->quantization.type == kTfLiteAffineQuantization) {
-        const auto qparams = static_cast<const TfLiteAffineQuantization*>(
-            value->quantization.params);
+      int32_t zero_point = 0;
+      if (qparams != nullptr) {
         if (qparams->scale->size > 1) {
           // get this row's scale for per-axis quantization
           scaling_factor = qparams->scale->data[idx];
         }
+        const int zero_point_index = qparams->zero_point->size > 1 ? idx : 0;
+        zero_point = qparams->zero_point->data[zero_point_index];
       }
 
+      // Offsets are 64-bit, as large tables may have more than 2^31 items.
+      const int64_t row_offset = idx * col_size;
+      float* output_row = output_ptr + i * col_size;
       if (value->type == kTfLiteInt4) {
-        for (int j = 0; j < col_size; j++) {
-          int i8_idx = j + idx * col_size;
-          int i4_idx = i8_idx / 2;
+        for (int64_t j = 0; j < col_size; j++) {
+          int64_t i8_idx = j + row_offset;
+          int64_t i4_idx = i8_idx / 2;
           bool even = i8_idx % 2 == 0;
           int8_t i4_val = value_ptr[i4_idx];
           int8_t i8_val =
               even ? static_cast<int8_t>(i4_val << 4) >> 4 : i4_val >> 4;
-          output_ptr[j + i * col_size] = i8_val * scaling_factor;
+          output_row[j] = (i8_val - zero_point) * scaling_factor;
         }
       } else {
-        for (int j = 0; j < col_size; j++) {
-          output_ptr[j + i * col_size] =
-              value_ptr[j + idx * col_size] * scaling_factor;
+        const int8_t* value_row = value_ptr + row_offset;
+        for (int64_t j = 0; j < col_size; j++) {
+          output_row[j] = (value_row[j] - zero_point) * scaling_factor;
         }
       }
     }
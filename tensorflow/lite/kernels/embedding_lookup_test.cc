@@ -42,13 +42,16 @@ class BaseEmbeddingLookupOpModel : public SingleOpModel {
       std::initializer_list<int> weight_shape,
       TensorType weight_type = TensorType_FLOAT32,
       TensorType output_type = TensorType_FLOAT32,
-      const std::vector<float>& per_channel_quantization_scales = {}) {
+      const std::vector<float>& per_channel_quantization_scales = {},
+      std::vector<int64_t> per_channel_quantization_offsets = {}) {
     input_ = AddInput(TensorType_INT32);
     if (per_channel_quantization_scales.empty()) {
       weight_ = AddInput(weight_type);
     } else {
-      std::vector<int64_t> per_channel_quantization_offsets(
-          per_channel_quantization_scales.size(), 0);
+      if (per_channel_quantization_offsets.empty()) {
+        per_channel_quantization_offsets.resize(
+            per_channel_quantization_scales.size(), 0);
+      }
       weight_ = AddInput({weight_type, weight_shape, 0, 0, 0, 0, true,
                           per_channel_quantization_scales,
                           per_channel_quantization_offsets, 0});
@@ -139,6 +142,24 @@ class PerAxisHybridEmbeddingLookupOpModel : public BaseEmbeddingLookupOpModel {
   }
 };
 
+class AsymmetricPerAxisHybridEmbeddingLookupOpModel
+    : public BaseEmbeddingLookupOpModel {
+ public:
+  AsymmetricPerAxisHybridEmbeddingLookupOpModel(
+      std::initializer_list<int> index_shape,
+      std::initializer_list<int> weight_shape,
+      const std::vector<float>& per_channel_quantization_scales,
+      const std::vector<int64_t>& per_channel_quantization_offsets)
+      : BaseEmbeddingLookupOpModel(
+            index_shape, weight_shape, TensorType_INT8, TensorType_FLOAT32,
+            per_channel_quantization_scales, per_channel_quantization_offsets) {
+  }
+
+  void SetQuantizedWeight(std::initializer_list<int8_t> data) {
+    PopulateTensor(weight_, data);
+  }
+};
+
 // TODO(ahentz): write more tests that exercise the details of the op, such as
 // lookup errors and variable input shapes.
 TEST(EmbeddingLookupOpTest, SimpleTest) {
@@ -343,6 +364,26 @@ TEST(PerAxisHybridEmbeddingLookupHybridOpTest, PerAxisSimple2DTestInt8) {
                   kTestTolerance)));
 }
 
+TEST(PerAxisHybridEmbeddingLookupHybridOpTest, AsymmetricPerAxis2DTestInt8) {
+  AsymmetricPerAxisHybridEmbeddingLookupOpModel m(
+      {3}, {3, 4}, {0.5, 0.25, 2.0}, {0, 10, -3});
+  m.SetInput({1, 0, 2});
+  m.SetQuantizedWeight({
+      0, 2, -4, 6,     // Row 0
+      10, 14, 6, 18,   // Row 1
+      -3, -2, 0, -5,   // Row 2
+  });
+
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  EXPECT_THAT(m.GetOutput<float>(),
+              ElementsAreArray(ArrayFloatNear({
+                  0.0, 1.0, -1.0, 2.0,  // Row 1
+                  0.0, 1.0, -2.0, 3.0,  // Row 0
+                  0.0, 2.0, 6.0, -4.0,  // Row 2
+              })));
+}
+
 TEST(PerAxisHybridEmbeddingLookupHybridOpTest, PerAxisSimple3DTestInt8) {
   PerAxisHybridEmbeddingLookupOpModel m(
       {3}, {3, 2, 4}, {0.00102, 0.0089, 0.016772}, TensorType_INT8);
@@ -21,6 +21,7 @@ limitations under the License.
 #include <memory>
 #include <vector>
 
+#include "Eigen/Core"  // from @eigen_archive
 #include "tensorflow/lite/core/c/builtin_op_data.h"
 #include "tensorflow/lite/core/c/c_api_types.h"
 #include "tensorflow/lite/core/c/common.h"
@@ -159,6 +160,9 @@ struct OpData {
   bool ledger_initialized;
   // Used for 4bit hybrid
   std::unique_ptr<optimized_4bit::OpData4Bit> op_data_4bit = nullptr;
+  // The scale of each block of a blockwise quantized filter, converted to
+  // float.
+  std::vector<float> blockwise_scales;
   TfLiteType quantized_bias_type = kTfLiteNoType;
 };
 
@@ -633,6 +637,84 @@ TfLiteStatus PrepareImpl(TfLiteContext* context, TfLiteNode* node,
                           filter->dims->data[1]);
 }
 
+// Prepares the FullyConnected of a float input by an int4 filter quantized by
+// blocks of its rows.
+TfLiteStatus PrepareBlockwise(TfLiteContext* context, TfLiteNode* node) {
+  auto* params =
+      reinterpret_cast<TfLiteFullyConnectedParams*>(node->builtin_data);
+  OpData* data = reinterpret_cast<OpData*>(node->user_data);
+  TF_LITE_ENSURE(context, node->inputs->size == 2 || node->inputs->size == 3);
+  TF_LITE_ENSURE_EQ(context, node->outputs->size, 1);
+  TF_LITE_ENSURE_EQ(context, params->weights_format,
+                    kTfLiteFullyConnectedWeightsFormatDefault);
+
+  const TfLiteTensor* input;
+  TF_LITE_ENSURE_OK(context, GetInputSafe(context, node, kInputTensor, &input));
+  const TfLiteTensor* filter;
+  TF_LITE_ENSURE_OK(context,
+                    GetInputSafe(context, node, kWeightsTensor, &filter));
+  const TfLiteTensor* bias =
+      (node->inputs->size == 3)
+          ? GetOptionalInputTensor(context, node, kBiasTensor)
+          : nullptr;
+  TfLiteTensor* output;
+  TF_LITE_ENSURE_OK(context,
+                    GetOutputSafe(context, node, kOutputTensor, &output));
+  TF_LITE_ENSURE_TYPES_EQ(context, input->type, kTfLiteFloat32);
+  TF_LITE_ENSURE_TYPES_EQ(context, filter->type, kTfLiteInt4);
+  TF_LITE_ENSURE_TYPES_EQ(context, output->type, kTfLiteFloat32);
+  TF_LITE_ENSURE(context, !bias || bias->type == kTfLiteFloat32);
+  TF_LITE_ENSURE_EQ(context, NumDimensions(filter), 2);
+  const int num_units = SizeOfDimension(filter, 0);
+  const int cols = SizeOfDimension(filter, 1);
+  if (bias) {
+    TF_LITE_ENSURE_EQ(context, NumElements(bias), num_units);
+  }
+
+  const auto* quantization = reinterpret_cast<TfLiteBlockwiseQuantization*>(
+      filter->quantization.params);
+  TF_LITE_ENSURE(context, quantization);
+  TF_LITE_ENSURE_EQ(context, quantization->quantized_dimension, 0);
+  TF_LITE_ENSURE_MSG(context, quantization->zero_point == kTfLiteOptionalTensor,
+                     "Blockwise quantization zero points are not supported.");
+  const int blocksize = quantization->blocksize;
+  // Each block then starts at a byte boundary of the packed filter.
+  TF_LITE_ENSURE(context, blocksize > 0 && blocksize % 2 == 0);
+  TF_LITE_ENSURE(context, cols > 0 && cols % blocksize == 0);
+  TF_LITE_ENSURE(context,
+                 quantization->scale >= 0 &&
+                     static_cast<size_t>(quantization->scale) <
+                         context->tensors_size);
+  const TfLiteTensor* scales = &context->tensors[quantization->scale];
+  TF_LITE_ENSURE(context, IsConstantTensor(scales));
+  TF_LITE_ENSURE_EQ(context, NumElements(scales),
+                    num_units * (cols / blocksize));
+  data->blockwise_scales.resize(NumElements(scales));
+  switch (scales->type) {
+    case kTfLiteFloat32:
+      std::copy_n(GetTensorData<float>(scales), data->blockwise_scales.size(),
+                  data->blockwise_scales.begin());
+      break;
+    case kTfLiteFloat16: {
+      const Eigen::half* half_scales =
+          reinterpret_cast<const Eigen::half*>(scales->data.raw_const);
+      for (size_t i = 0; i < data->blockwise_scales.size(); ++i) {
+        data->blockwise_scales[i] = static_cast<float>(half_scales[i]);
+      }
+      break;
+    }
+    default:
+      TF_LITE_KERNEL_LOG(context, "Unsupported blockwise scale type %s.",
+                         TfLiteTypeGetName(scales->type));
+      return kTfLiteError;
+  }
+
+  const int input_size = NumElements(input);
+  TF_LITE_ENSURE_EQ(context, input_size % cols, 0);
+  return UpdateOutputSize(context, params, input, output, input_size / cols,
+                          num_units, cols);
+}
+
 template <KernelType kernel_type>
 TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
   // Check for supported activation types.
@@ -657,6 +739,9 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
                                 params->activation == kTfLiteActReluN1To1 ||
                                 params->activation == kTfLiteActRelu6);
   }
+  if (filter->quantization.type == kTfLiteBlockwiseQuantization) {
+    return PrepareBlockwise(context, node);
+  }
   if (filter->type == kTfLiteInt4) {
     TF_LITE_ENSURE_MSG(
         context,
@@ -1257,15 +1342,22 @@ bool VerifySparsity(const RuntimeShape& weights_shape,
   const int max_batch_index = batches - 1;
   const int max_output = max_batch_index * output_depth + w0_size;
   const int max_batch_depth = accum_depth * max_batch_index;
+  // The indices of block sparse weights are those of their 1xN blocks.
+  const int block_size =
+      sparsity->dim_metadata_size == kDimMetadataSizeBlockSparse
+          ? sparsity->dim_metadata[2].dense_size
+          : 1;
 
   // Verify output size is enough.
   if (output_elements < max_output) return false;
 
   // Verify index from sparse in input is valid.
   for (int i = 0; i < sparsity->dim_metadata[1].array_indices->size; ++i) {
-    if (input_elements <=
-        max_batch_depth + sparsity->dim_metadata[1].array_indices->data[i])
-      return false;
+    const int last_index =
+        sparsity->dim_metadata[1].array_indices->data[i] * block_size +
+        block_size - 1;
+    if (last_index >= accum_depth) return false;
+    if (input_elements <= max_batch_depth + last_index) return false;
   }
   return true;
 }
@@ -1314,7 +1406,9 @@ TfLiteStatus EvalQuantized(TfLiteContext* context, TfLiteNode* node,
     op_params.output_shift = data->output_shift;
     op_params.quantized_activation_min = data->output_activation_min;
     op_params.quantized_activation_max = data->output_activation_max;
-    op_params.lhs_cacheable = IsConstantTensor(filter);
+    // Unpacked int4 filters are temporary buffers, which can't be cached.
+    op_params.lhs_cacheable =
+        IsConstantTensor(filter) && filter->type != kTfLiteInt4;
     op_params.rhs_cacheable = IsConstantTensor(input);
     switch (output->type) {
       case kTfLiteUInt8:
@@ -1369,9 +1463,17 @@ TfLiteStatus EvalQuantized(TfLiteContext* context, TfLiteNode* node,
                 GetTensorData<int8_t>(output),
                 CpuBackendContext::GetFromContext(context));
           } else {
-            TF_LITE_KERNEL_LOG(
-                context, "Unsupported sparse fully-connected weight format.");
-            return kTfLiteError;
+            // Random sparse, or block sparse with block size of 1xN.
+            optimized_ops::FullyConnectedSparseWeightInt8(
+                sparsity, op_params, input_shape, GetTensorData<int8_t>(input),
+                filter_shape, GetTensorData<int8_t>(filter),
+                is_per_channel ? data->per_channel_output_multiplier.data()
+                               : nullptr,
+                is_per_channel ? data->per_channel_output_shift.data()
+                               : nullptr,
+                bias_shape, GetTensorData<int32_t>(bias), output_shape,
+                GetTensorData<int8_t>(output),
+                CpuBackendContext::GetFromContext(context));
           }
         } else {
           const int8_t* filter_data;
@@ -1607,6 +1709,51 @@ TfLiteStatus EvalFloat(TfLiteContext* context, TfLiteNode* node,
   return kTfLiteOk;
 }
 
+// Computes the FullyConnected prepared by PrepareBlockwise, unpacking the
+// filter on the fly so that it is read once per batch.
+TfLiteStatus EvalBlockwise4Bit(TfLiteContext* context,
+                               TfLiteFullyConnectedParams* params,
+                               OpData* data, const TfLiteTensor* input,
+                               const TfLiteTensor* filter,
+                               const TfLiteTensor* bias,
+                               TfLiteTensor* output) {
+  const auto* quantization = reinterpret_cast<TfLiteBlockwiseQuantization*>(
+      filter->quantization.params);
+  const int blocksize = quantization->blocksize;
+  const int num_units = SizeOfDimension(filter, 0);
+  const int cols = SizeOfDimension(filter, 1);
+  const int num_blocks = cols / blocksize;
+  const int batch_size = NumElements(input) / cols;
+  const uint8_t* filter_data = GetTensorData<uint8_t>(filter);
+  const float* bias_data = bias ? GetTensorData<float>(bias) : nullptr;
+  const float* scales = data->blockwise_scales.data();
+  for (int b = 0; b < batch_size; ++b) {
+    const float* input_row = GetTensorData<float>(input) + b * cols;
+    float* output_row = GetTensorData<float>(output) + b * num_units;
+    for (int unit = 0; unit < num_units; ++unit) {
+      // Two int4 values per byte, the first one in the low nibble.
+      const uint8_t* packed_row = filter_data + unit * (cols / 2);
+      float acc = bias_data ? bias_data[unit] : 0.0f;
+      for (int block = 0; block < num_blocks; ++block) {
+        const uint8_t* packed = packed_row + block * (blocksize / 2);
+        const float* x = input_row + block * blocksize;
+        float block_acc = 0.0f;
+        for (int i = 0; i < blocksize / 2; ++i) {
+          const int8_t low = static_cast<int8_t>(packed[i] << 4) >> 4;
+          const int8_t high = static_cast<int8_t>(packed[i]) >> 4;
+          block_acc += low * x[2 * i] + high * x[2 * i + 1];
+        }
+        acc += block_acc * scales[unit * num_blocks + block];
+      }
+      output_row[unit] = acc;
+    }
+  }
+  tensor_utils::ApplyActivationToVector(
+      GetTensorData<float>(output), batch_size * num_units, params->activation,
+      GetTensorData<float>(output));
+  return kTfLiteOk;
+}
+
 template <KernelType kernel_type>
 TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
   auto* params =
@@ -1635,6 +1782,11 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
     return kTfLiteOk;
   }
 
+  if (filter->quantization.type == kTfLiteBlockwiseQuantization) {
+    return EvalBlockwise4Bit(context, params, data, input, filter, bias,
+                             output);
+  }
+
   switch (filter->type) {
     case kTfLiteFloat32:
       return EvalFloat<kernel_type>(context, node, params, data, input, filter,
@@ -1428,6 +1428,66 @@ TEST(HybridFullyConnectedOpTest, SimpleTestQuantizedInt4) {
                                  /*max_abs_err=*/0.5f)));
 }
 
+class BlockwiseFullyConnectedOpModel : public SingleOpModel {
+ public:
+  BlockwiseFullyConnectedOpModel(int units, int batches, int input_size,
+                                 const std::vector<int8_t>& weights,
+                                 const std::vector<float>& scales,
+                                 int block_size,
+                                 const std::vector<float>& bias) {
+    input_ = AddInput({TensorType_FLOAT32, {batches, input_size}});
+    weights_ = AddConstBlockwiseQuantInput(
+        {TensorType_INT4, {units, input_size}}, weights, scales, block_size);
+    bias_ = AddConstInput(TensorData{TensorType_FLOAT32, {units}}, bias);
+    output_ = AddOutput({TensorType_FLOAT32});
+
+    SetBuiltinOp(
+        BuiltinOperator_FULLY_CONNECTED, BuiltinOptions_FullyConnectedOptions,
+        CreateFullyConnectedOptions(builder_, ActivationFunctionType_NONE)
+            .Union());
+    resolver_ = std::make_unique<SingleOpResolver>(
+        BuiltinOperator_FULLY_CONNECTED,
+        ops::builtin::Register_FULLY_CONNECTED());
+    BuildInterpreter({GetShape(input_), GetShape(weights_), GetShape(bias_)},
+                     /*num_threads=*/1, /*allow_fp32_relax_to_fp16=*/false,
+                     /*apply_delegate=*/false);
+  }
+
+  void SetInput(const std::vector<float>& f) { PopulateTensor(input_, f); }
+  std::vector<float> GetOutput() { return ExtractVector<float>(output_); }
+  std::vector<int> GetOutputShape() { return GetTensorShape(output_); }
+
+ private:
+  int input_;
+  int weights_;
+  int bias_;
+  int output_;
+};
+
+TEST(BlockwiseFullyConnectedOpTest, SimpleTestInt4) {
+  BlockwiseFullyConnectedOpModel m(
+      /*units=*/2, /*batches=*/2, /*input_size=*/8,
+      /*weights=*/
+      {
+          1, 2, 3, 4, -1, -2, -3, -4,  // u = 0
+          7, -8, 0, 1, 2, 2, 2, 2,     // u = 1
+      },
+      /*scales=*/{0.5, 1, 2, 0.25}, /*block_size=*/4, /*bias=*/{1, -1});
+
+  m.SetInput({
+      1, 1, 1, 1, 1, 1, 1, 1,  // b = 0
+      1, 2, 3, 4, 5, 6, 7, 8,  // b = 1
+  });
+
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  EXPECT_THAT(m.GetOutputShape(), ElementsAre(2, 2));
+  EXPECT_THAT(m.GetOutput(), ElementsAreArray(ArrayFloatNear({
+                                 -4, 1,   //
+                                 -54, 2,  //
+                             })));
+}
+
 TEST(HybridFullyConnectedOpTest, SimpleTestQuantizedInt8MultiThreaded) {
   for (int num_threads = 1; num_threads <= 4; ++num_threads) {
     HybridFullyConnectedOpModel m(
@@ -2511,6 +2571,70 @@ TEST_P(SparseQuantizedFullyConnectedOpTest,
   EXPECT_THAT(m.GetOutput(), ElementsAre(11, 1, 25, 0, 1, 21));
 }
 
+TEST_P(SparseQuantizedFullyConnectedOpTest, SimpleRandomSparseTest) {
+  std::vector<float> weight_data = {
+      1,  2,  3,  4,  -1, -2, -3, -4, 1,  2,  3,  4, -4, -3, -2, -1,  // u = 0
+      0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 0,  0,  0,  0,   // u = 1
+      -1, -2, -3, -4, 4,  3,  2,  1,  -1, -2, -3, 4, 1,  2,  3,  4,   // u = 2
+  };
+  TensorData weight = {TensorType_INT8, {3, 16}, 0, 0, 1};
+  weight.traversal_order = {0, 1};
+  weight.format = {kTfLiteDimDense, kTfLiteDimSparseCSR};
+  SparseQuantizedFullyConnectedOpModel m(
+      GetRegistration(),
+      /*units=*/3, /*batches=*/2,
+      /*input=*/{TensorType_INT8, {2, 16}, 0, 0, 1}, weight, weight_data,
+      /*output=*/{TensorType_INT8, {}, 0, 0, 1});
+
+  m.SetBias({1, 2, 3});
+  m.SetInput({
+      1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4,  // b = 0
+      4, 3, 2, 1, 4, 3, 2, 1, 4, 3, 2, 1, 4, 3, 2, 1,  // b = 1
+  });
+
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  EXPECT_THAT(m.GetOutputShape(), ElementsAre(2, 3));
+  EXPECT_THAT(m.GetOutput(), ElementsAre(11, 2, 25, 0, 2, 21));
+}
+
+TEST_P(SparseQuantizedFullyConnectedOpTest, Simple1x4PerChannelTest) {
+  std::vector<float> weight_data = {
+      1,  2,  3,  4,  0, 0, 0, 0, 1,  2,  3,  4, -4, -3, -2, -1,  // u = 0
+      0,  0,  0,  0,  0, 0, 0, 0, 0,  0,  0,  0, 0,  0,  0,  0,   // u = 1
+      -1, -2, -3, -4, 4, 3, 2, 1, -1, -2, -3, 4, 0,  0,  0,  0,   // u = 2
+  };
+  TensorData weight = {TensorType_INT8,
+                       {3, 16},
+                       0.0,
+                       0.0,
+                       0.0,
+                       0,
+                       true,
+                       {4.0 / 127.0, 1.0 / 127.0, 4.0 / 127.0},
+                       {0, 0, 0}};
+  weight.traversal_order = {0, 1, 2};
+  weight.format = {kTfLiteDimDense, kTfLiteDimSparseCSR};
+  weight.block_map = {1};
+  weight.block_size = {4};
+  SparseQuantizedFullyConnectedOpModel m(
+      GetRegistration(),
+      /*units=*/3, /*batches=*/2,
+      /*input=*/{TensorType_INT8, {2, 16}, 0, 0, 1}, weight, weight_data,
+      /*output=*/{TensorType_INT8, {}, 0, 0, 1});
+
+  m.SetBias({1, 2, 3});
+  m.SetInput({
+      1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4,  // b = 0
+      4, 3, 2, 1, 4, 3, 2, 1, 4, 3, 2, 1, 4, 3, 2, 1,  // b = 1
+  });
+
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  EXPECT_THAT(m.GetOutputShape(), ElementsAre(2, 3));
+  EXPECT_THAT(m.GetOutput(), ElementsAre(41, 1, 0, 11, 1, 1));
+}
+
 INSTANTIATE_TEST_SUITE_P(
     SparseQuantizedFullyConnectedOpTest, SparseQuantizedFullyConnectedOpTest,
     ::testing::ValuesIn(SingleOpTest::GetKernelTags(*kKernelMapNoPie)));
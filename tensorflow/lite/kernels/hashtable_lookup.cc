@@ -113,7 +113,8 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
 
   const int num_rows = SizeOfDimension(value, 0);
   TF_LITE_ENSURE(context, num_rows != 0);
-  const int row_bytes = value->bytes / num_rows;
+  // 64-bit, as large tables may be more than 2GB.
+  const int64_t row_bytes = value->bytes / num_rows;
   void* pointer = nullptr;
   DynamicBuffer buf;
 
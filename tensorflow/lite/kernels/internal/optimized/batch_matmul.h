@@ -98,12 +98,17 @@ inline void BatchMatMul(const FullyConnectedParams& params,
   lhs_params.rows = lhs_rows;
   lhs_params.cols = accum_depth;
   lhs_params.zero_point = -filter_offset;
+  // The lhs here is the rhs of the BatchMatMul op, see batch_matmul.cc.
+  lhs_params.cache_policy =
+      cpu_backend_gemm::DefaultCachePolicy(params.rhs_cacheable);
 
   MatrixParams<int8_t> rhs_params;
   rhs_params.order = cpu_backend_gemm::Order::kColMajor;
   rhs_params.rows = accum_depth;
   rhs_params.cols = rhs_cols;
   rhs_params.zero_point = -input_offset;
+  rhs_params.cache_policy =
+      cpu_backend_gemm::DefaultCachePolicy(params.lhs_cacheable);
 
   MatrixParams<int8_t> dst_params;
   dst_params.order = cpu_backend_gemm::Order::kColMajor;
@@ -209,12 +214,16 @@ inline void BatchMatMul(const FullyConnectedParams& params,
   lhs_params.rows = lhs_rows;
   lhs_params.cols = accum_depth;
   lhs_params.zero_point = -weights_offset;
+  lhs_params.cache_policy =
+      cpu_backend_gemm::DefaultCachePolicy(params.rhs_cacheable);
 
   MatrixParams<int8_t> rhs_params;
   rhs_params.order = cpu_backend_gemm::Order::kColMajor;
   rhs_params.rows = accum_depth;
   rhs_params.cols = rhs_cols;
   rhs_params.zero_point = -input_offset;
+  rhs_params.cache_policy =
+      cpu_backend_gemm::DefaultCachePolicy(params.lhs_cacheable);
 
   MatrixParams<int32_t> dst_params;
   dst_params.order = cpu_backend_gemm::Order::kColMajor;
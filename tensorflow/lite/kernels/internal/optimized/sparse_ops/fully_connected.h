@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <algorithm>
 #include <cstdint>
+#include <vector>
 
 #include "ruy/profiler/instrumentation.h"  // from @ruy
 #include "tensorflow/lite/core/c/common.h"
@@ -153,6 +154,111 @@ inline void FullyConnectedSparseWeight1x4Impl(
   }
 }
 
+// Computes the batches [thread_start, thread_end) of a quantized
+// FullyConnected with random sparse or 1xN block sparse weights. The weights
+// of row r are the blocks of N values starting at the columns
+// N * w1_indices[w1_segments[r], w1_segments[r + 1]).
+inline void FullyConnectedSparseWeightInt8Impl(
+    const TfLiteSparsity& sparsity, const FullyConnectedParams& params,
+    const RuntimeShape& input_shape, const int8_t* input_data,
+    const RuntimeShape& weights_shape, const int8_t* weights_data,
+    const int32_t* per_channel_scale, const int32_t* per_channel_shift,
+    const RuntimeShape& bias_shape, const int32_t* bias_data,
+    const RuntimeShape& output_shape, int8_t* output_data, int thread_start,
+    int thread_end) {
+  ruy::profiler::ScopeLabel label("FullyConnected");
+  ruy::profiler::ScopeLabel inner_label("Quantized 1xN Block Sparse");
+
+  const int input_dims_count = input_shape.DimensionsCount();
+  const int output_dims_count = output_shape.DimensionsCount();
+  const int weights_dims_count = weights_shape.DimensionsCount();
+  const int input_depth = MatchingDim(weights_shape, weights_dims_count - 1,
+                                      input_shape, input_dims_count - 1);
+  const int output_depth = MatchingDim(weights_shape, weights_dims_count - 2,
+                                       output_shape, output_dims_count - 1);
+  const int block_size =
+      sparsity.dim_metadata_size > 2 ? sparsity.dim_metadata[2].dense_size : 1;
+  const int32_t input_offset = params.input_offset;
+  const int32_t output_offset = params.output_offset;
+  const int32_t output_activation_min = params.quantized_activation_min;
+  const int32_t output_activation_max = params.quantized_activation_max;
+
+  const int* w1_segments = sparsity.dim_metadata[1].array_segments->data;
+  const int* w1_indices = sparsity.dim_metadata[1].array_indices->data;
+
+  for (int b = thread_start; b < thread_end; ++b) {
+    const int8_t* input_batch = input_data + b * input_depth;
+    for (int row = 0; row < output_depth; ++row) {
+      int32_t acc = 0;
+      for (int pw1 = w1_segments[row]; pw1 < w1_segments[row + 1]; ++pw1) {
+        const int8_t* weights_block = weights_data + pw1 * block_size;
+        const int8_t* input_block =
+            input_batch + w1_indices[pw1] * block_size;
+        for (int c = 0; c < block_size; ++c) {
+          acc += weights_block[c] * (input_block[c] + input_offset);
+        }
+      }
+      if (bias_data) acc += bias_data[row];
+      acc = MultiplyByQuantizedMultiplier(
+          acc, per_channel_scale ? per_channel_scale[row]
+                                 : params.output_multiplier,
+          per_channel_shift ? per_channel_shift[row] : params.output_shift);
+      acc += output_offset;
+      acc = std::max(acc, output_activation_min);
+      acc = std::min(acc, output_activation_max);
+      output_data[b * output_depth + row] = static_cast<int8_t>(acc);
+    }
+  }
+}
+
+struct FullyConnectedSparseWeightInt8Task : cpu_backend_threadpool::Task {
+  FullyConnectedSparseWeightInt8Task(
+      const TfLiteSparsity& sparsity, const FullyConnectedParams& params,
+      const RuntimeShape& input_shape, const int8_t* input_data,
+      const RuntimeShape& weights_shape, const int8_t* weights_data,
+      const int32_t* per_channel_scale, const int32_t* per_channel_shift,
+      const RuntimeShape& bias_shape, const int32_t* bias_data,
+      const RuntimeShape& output_shape, int8_t* output_data, int thread_start,
+      int thread_end)
+      : sparsity(sparsity),
+        params(params),
+        input_shape(input_shape),
+        input_data(input_data),
+        weights_shape(weights_shape),
+        weights_data(weights_data),
+        per_channel_scale(per_channel_scale),
+        per_channel_shift(per_channel_shift),
+        bias_shape(bias_shape),
+        bias_data(bias_data),
+        output_shape(output_shape),
+        output_data(output_data),
+        thread_start(thread_start),
+        thread_end(thread_end) {}
+
+  void Run() override {
+    FullyConnectedSparseWeightInt8Impl(
+        sparsity, params, input_shape, input_data, weights_shape, weights_data,
+        per_channel_scale, per_channel_shift, bias_shape, bias_data,
+        output_shape, output_data, thread_start, thread_end);
+  }
+
+ private:
+  const TfLiteSparsity& sparsity;
+  const FullyConnectedParams& params;
+  const RuntimeShape& input_shape;
+  const int8_t* input_data;
+  const RuntimeShape& weights_shape;
+  const int8_t* weights_data;
+  const int32_t* per_channel_scale;
+  const int32_t* per_channel_shift;
+  const RuntimeShape& bias_shape;
+  const int32_t* bias_data;
+  const RuntimeShape& output_shape;
+  int8_t* output_data;
+  int thread_start;
+  int thread_end;
+};
+
 struct FullyConnectedSparseWeight1x4Task : cpu_backend_threadpool::Task {
   FullyConnectedSparseWeight1x4Task(
       const TfLiteSparsity& sparsity, const FullyConnectedParams& params,
@@ -219,6 +325,45 @@ inline void FullyConnectedSparseWeight1x16(
       output_data, 0, batches, *cpu_backend_context);
 }
 
+// Quantized FullyConnected with random sparse or 1xN block sparse weights,
+// for any N. `per_channel_scale` and `per_channel_shift` are null if the
+// weights are quantized per-tensor. Like FullyConnectedSparseWeight1x4, the
+// batches are split between the threads.
+inline void FullyConnectedSparseWeightInt8(
+    const TfLiteSparsity& sparsity, const FullyConnectedParams& params,
+    const RuntimeShape& input_shape, const int8_t* input_data,
+    const RuntimeShape& weights_shape, const int8_t* weights_data,
+    const int32_t* per_channel_scale, const int32_t* per_channel_shift,
+    const RuntimeShape& bias_shape, const int32_t* bias_data,
+    const RuntimeShape& output_shape, int8_t* output_data,
+    CpuBackendContext* cpu_backend_context) {
+  const int max_threads = cpu_backend_context->max_num_threads();
+  const int batches =
+      FlatSizeSkipDim(output_shape, output_shape.DimensionsCount() - 1);
+  const int thread_count = std::max(1, std::min(batches, max_threads));
+  if (thread_count == 1) {
+    return FullyConnectedSparseWeightInt8Impl(
+        sparsity, params, input_shape, input_data, weights_shape, weights_data,
+        per_channel_scale, per_channel_shift, bias_shape, bias_data,
+        output_shape, output_data, 0, batches);
+  }
+  std::vector<FullyConnectedSparseWeightInt8Task> tasks;
+  tasks.reserve(thread_count);
+  int thread_start = 0;
+  for (int i = 0; i < thread_count; ++i) {
+    int thread_end = thread_start + batches / thread_count;
+    if (i < batches % thread_count) thread_end++;
+
+    tasks.emplace_back(sparsity, params, input_shape, input_data, weights_shape,
+                       weights_data, per_channel_scale, per_channel_shift,
+                       bias_shape, bias_data, output_shape, output_data,
+                       thread_start, thread_end);
+    thread_start = thread_end;
+  }
+  cpu_backend_threadpool::Execute(tasks.size(), tasks.data(),
+                                  cpu_backend_context);
+}
+
 // The multi-threaded kernel slices the workload along the batch dimension. If
 // there's not enough batches of data, the number of threads used is equal to
 // the batch size. We can improve this later with slicing along the row
@@ -181,6 +181,7 @@ inline float GetTensorScale(const TfLiteTensor* tensor) {
 //   cell_to_gate_weights      | n_cell               | y (peephole)
 //   gate_bias                 | n_cell               |
 //   layer_norm_coefficients   | n_cell               | y (layer norm)
+//   precomputed_gate_inputs   | n_cell               | y
 // Output vector:
 //   gate                      | n_cell               |
 // Scalar parameters:
@@ -189,6 +190,10 @@ inline float GetTensorScale(const TfLiteTensor* tensor) {
 //   activation                                 - activation to use.
 //   is_input_all_zeros, is_aux_input_all_zeros - if input vectors are all zero.
 //   use_layer_norm                             - if doing layer norm LSTM.
+//
+// If 'precomputed_gate_inputs' is provided, it holds the input contribution
+// (and the bias without layer norm) computed by PrecomputeLstmGateInputsFloat,
+// and the input weights are not used. There must be no aux input then.
 inline void CalculateLstmGateFloat(
     const float* input, const float* input_to_gate_weights,
     const float* aux_input, const float* aux_input_to_gate_weights,
@@ -199,44 +204,59 @@ inline void CalculateLstmGateFloat(
     const int n_output, const int n_cell,
     const TfLiteFusedActivation activation, float* gate,
     const bool is_input_all_zeros, const bool is_aux_input_all_zeros,
-    float* output, bool recurrent_is_diag, CpuBackendContext* context) {
+    float* output, bool recurrent_is_diag, CpuBackendContext* context,
+    const float* precomputed_gate_inputs = nullptr) {
   const bool use_peephole = (cell_to_gate_weights != nullptr);
   const bool use_layer_norm = (layer_norm_coefficients != nullptr);
 
-  // Initialize scratch buffers with bias for regular lstm or initialize with
-  // zero for layer norm lstm.
-  if (use_layer_norm) {
-    std::fill_n(gate, n_cell * n_batch, 0.0f);
-  } else {
-    tensor_utils::VectorBatchVectorAssign(gate_bias, n_cell, n_batch, gate);
-  }
-  // For each batch and cell: compute input_weight * input.
-  // Skip if input is all zeros.
-  float* accumulation_buffer = gate;
-  if (!is_input_all_zeros) {
-    MatrixBatchVectorMultiplyAccumulate(input_to_gate_weights, input,
-                                        accumulation_buffer, output, n_cell,
-                                        n_input, n_batch, context);
-    std::swap(accumulation_buffer, output);
-  }
-  // For each batch and cell: compute aux_input_weight * aux_input.
-  // Skip if auxiliary input is not available or all zeros.
-  if (!is_aux_input_all_zeros) {
-    MatrixBatchVectorMultiplyAccumulate(aux_input_to_gate_weights, aux_input,
-                                        accumulation_buffer, output, n_cell,
-                                        n_aux_input, n_batch, context);
-    std::swap(accumulation_buffer, output);
-  }
-  // For each batch and cell: compute recurrent_weight * output_state.
-  if (recurrent_is_diag) {
-    tflite::tensor_utils::VectorBatchVectorCwiseProductAccumulate(
-        recurrent_to_gate_weights, n_cell, output_state, n_batch,
-        accumulation_buffer);
-    std::swap(accumulation_buffer, output);
+  if (precomputed_gate_inputs != nullptr) {
+    // For each batch and cell: compute recurrent_weight * output_state on top
+    // of the precomputed input contributions.
+    if (recurrent_is_diag) {
+      std::copy_n(precomputed_gate_inputs, n_cell * n_batch, output);
+      tflite::tensor_utils::VectorBatchVectorCwiseProductAccumulate(
+          recurrent_to_gate_weights, n_cell, output_state, n_batch, output);
+    } else {
+      MatrixBatchVectorMultiplyAccumulate(
+          recurrent_to_gate_weights, output_state, precomputed_gate_inputs,
+          output, n_cell, n_output, n_batch, context);
+    }
   } else {
-    MatrixBatchVectorMultiplyAccumulate(recurrent_to_gate_weights, output_state,
-                                        accumulation_buffer, output, n_cell,
-                                        n_output, n_batch, context);
+    // Initialize scratch buffers with bias for regular lstm or initialize with
+    // zero for layer norm lstm.
+    if (use_layer_norm) {
+      std::fill_n(gate, n_cell * n_batch, 0.0f);
+    } else {
+      tensor_utils::VectorBatchVectorAssign(gate_bias, n_cell, n_batch, gate);
+    }
+    // For each batch and cell: compute input_weight * input.
+    // Skip if input is all zeros.
+    float* accumulation_buffer = gate;
+    if (!is_input_all_zeros) {
+      MatrixBatchVectorMultiplyAccumulate(input_to_gate_weights, input,
+                                          accumulation_buffer, output, n_cell,
+                                          n_input, n_batch, context);
+      std::swap(accumulation_buffer, output);
+    }
+    // For each batch and cell: compute aux_input_weight * aux_input.
+    // Skip if auxiliary input is not available or all zeros.
+    if (!is_aux_input_all_zeros) {
+      MatrixBatchVectorMultiplyAccumulate(aux_input_to_gate_weights, aux_input,
+                                          accumulation_buffer, output, n_cell,
+                                          n_aux_input, n_batch, context);
+      std::swap(accumulation_buffer, output);
+    }
+    // For each batch and cell: compute recurrent_weight * output_state.
+    if (recurrent_is_diag) {
+      tflite::tensor_utils::VectorBatchVectorCwiseProductAccumulate(
+          recurrent_to_gate_weights, n_cell, output_state, n_batch,
+          accumulation_buffer);
+      std::swap(accumulation_buffer, output);
+    } else {
+      MatrixBatchVectorMultiplyAccumulate(
+          recurrent_to_gate_weights, output_state, accumulation_buffer, output,
+          n_cell, n_output, n_batch, context);
+    }
   }
   // For each batch and cell: compute cell_weight .* cell_state (peephole LSTM)
   if (use_peephole) {
@@ -255,6 +275,32 @@ inline void CalculateLstmGateFloat(
                                         gate);
 }
 
+// Computes W_input * input (+ bias without layer norm) of a gate for all the
+// 'n_rows' input vectors of a sequence at once, into 'gate_inputs' of size
+// 'n_rows * n_cell'. Compared to one matrix-vector product per time step, the
+// weights are streamed once per sequence instead of once per step.
+void PrecomputeLstmGateInputsFloat(const float* input,
+                                   const float* input_to_gate_weights,
+                                   const float* layer_norm_coefficients,
+                                   const float* gate_bias, int n_rows,
+                                   int n_input, int n_cell, float* gate_inputs,
+                                   CpuBackendContext* context) {
+  tflite::FullyConnectedParams float_fc_params;
+  float_fc_params.float_activation_min = std::numeric_limits<float>::lowest();
+  float_fc_params.float_activation_max = std::numeric_limits<float>::max();
+  float_fc_params.lhs_cacheable = true;
+  float_fc_params.rhs_cacheable = false;
+
+  // With layer norm, the bias is added after normalization.
+  const float* bias =
+      layer_norm_coefficients == nullptr ? gate_bias : nullptr;
+  tflite::optimized_ops::FullyConnected(
+      float_fc_params, tflite::RuntimeShape({n_rows, n_input}), input,
+      tflite::RuntimeShape({n_cell, n_input}), input_to_gate_weights,
+      tflite::RuntimeShape({n_cell}), bias,
+      tflite::RuntimeShape({n_rows, n_cell}), gate_inputs, context);
+}
+
 // Updates the LSTM cell state, used by both float and hybrid LSTM versions.
 //
 // Implements the following formula:
@@ -875,6 +921,11 @@ void CalculateLstmOutputInteger8x8_8(
 // for bidirectional LSTMs with merge_outputs. In this case, the batched
 // operations cannot be used since they assume that the batched outputs are
 // contiguous, and we manually loop over the batched outputs.
+//
+// The optional precomputed_*_gate_inputs_ptr of size 'n_batch * n_cell' hold
+// the input contributions to the gates of this step, computed by
+// PrecomputeLstmGateInputsFloat for the whole sequence. If provided, there is
+// no aux input and the input weights are not used.
 // LINT.IfChange
 inline void LstmStepFloat(
     const float* input_ptr, const float* input_to_input_weights_ptr,
@@ -905,7 +956,11 @@ inline void LstmStepFloat(
     float* scratch1, float* scratch2, float* scratch3, float* scratch4,
     float* output_ptr, bool recurrent_to_input_is_diag,
     bool recurrent_to_forget_is_diag, bool recurrent_to_cell_is_diag,
-    bool recurrent_to_output_is_diag, CpuBackendContext* context) {
+    bool recurrent_to_output_is_diag, CpuBackendContext* context,
+    const float* precomputed_input_gate_inputs_ptr = nullptr,
+    const float* precomputed_forget_gate_inputs_ptr = nullptr,
+    const float* precomputed_cell_gate_inputs_ptr = nullptr,
+    const float* precomputed_output_gate_inputs_ptr = nullptr) {
   ruy::profiler::ScopeLabel label("LstmStepFloat");
   // Since we have already checked that weights are all there or none, we can
   // check the existence of only one to the get the condition.
@@ -937,7 +992,7 @@ inline void LstmStepFloat(
         n_input, n_aux_input, n_output, n_cell,
         /*activation=*/kTfLiteActSigmoid, input_gate_scratch,
         is_input_all_zeros, is_aux_input_all_zeros, accumulation_scratch_buffer,
-        recurrent_to_input_is_diag, context);
+        recurrent_to_input_is_diag, context, precomputed_input_gate_inputs_ptr);
   }
   // Calculate the forget gate.
   CalculateLstmGateFloat(
@@ -950,7 +1005,7 @@ inline void LstmStepFloat(
       n_input, n_aux_input, n_output, n_cell,
       /*activation=*/kTfLiteActSigmoid, forget_gate_scratch, is_input_all_zeros,
       is_aux_input_all_zeros, accumulation_scratch_buffer,
-      recurrent_to_forget_is_diag, context);
+      recurrent_to_forget_is_diag, context, precomputed_forget_gate_inputs_ptr);
   // Calculate the cell update gate.
   CalculateLstmGateFloat(
       input_ptr, input_to_cell_weights_ptr, aux_input_ptr,
@@ -962,7 +1017,7 @@ inline void LstmStepFloat(
       cell_gate_bias_ptr, n_batch, n_input, n_aux_input, n_output, n_cell,
       params->activation, cell_gate_scratch, is_input_all_zeros,
       is_aux_input_all_zeros, accumulation_scratch_buffer,
-      recurrent_to_cell_is_diag, context);
+      recurrent_to_cell_is_diag, context, precomputed_cell_gate_inputs_ptr);
   // Update the cell state.
   UpdateLstmCellFloat(n_batch, n_cell, cell_state_ptr, input_gate_scratch,
                       forget_gate_scratch, cell_gate_scratch, use_cifg,
@@ -978,7 +1033,7 @@ inline void LstmStepFloat(
       n_input, n_aux_input, n_output, n_cell,
       /*activation=*/kTfLiteActSigmoid, output_gate_scratch, is_input_all_zeros,
       is_aux_input_all_zeros, accumulation_scratch_buffer,
-      recurrent_to_output_is_diag, context);
+      recurrent_to_output_is_diag, context, precomputed_output_gate_inputs_ptr);
   // Update the output state.
   CalculateLstmOutputFloat(n_batch, n_cell, n_output, cell_state_ptr,
                            output_gate_scratch, params->activation,
@@ -1819,7 +1874,7 @@ TfLiteStatus EvalFloat(
     TfLiteTensor* cell_state, TfLiteTensor* output,
     bool recurrent_to_input_is_diag, bool recurrent_to_forget_is_diag,
     bool recurrent_to_cell_is_diag, bool recurrent_to_output_is_diag,
-    CpuBackendContext* context) {
+    CpuBackendContext* context, TfLiteTensor* input_gates_scratch) {
   TF_LITE_ASSERT(input->dims->size >= 2 && input->dims->size <= 3);
 
   int max_time, n_batch;
@@ -1864,6 +1919,43 @@ TfLiteStatus EvalFloat(
     accumulation_scratch_buffer = scratch_buffer_ptr + 4 * n_cell * n_batch;
   }
 
+  // Compute the input contributions to the gates of the whole sequence upfront:
+  // only the recurrent contributions depend on the previous step.
+  const float* precomputed_gate_inputs[4] = {nullptr, nullptr, nullptr,
+                                             nullptr};
+  if (input_gates_scratch != nullptr && aux_input == nullptr) {
+    const float* input_to_gate_weights[4] = {
+        GetTensorData<float>(input_to_input_weights),
+        GetTensorData<float>(input_to_forget_weights),
+        GetTensorData<float>(input_to_cell_weights),
+        GetTensorData<float>(input_to_output_weights)};
+    const float* layer_norm_coefficients[4] = {
+        GetTensorData<float>(input_layer_norm_coefficients),
+        GetTensorData<float>(forget_layer_norm_coefficients),
+        GetTensorData<float>(cell_layer_norm_coefficients),
+        GetTensorData<float>(output_layer_norm_coefficients)};
+    const float* gate_bias[4] = {GetTensorData<float>(input_gate_bias),
+                                 GetTensorData<float>(forget_gate_bias),
+                                 GetTensorData<float>(cell_gate_bias),
+                                 GetTensorData<float>(output_gate_bias)};
+    float* gate_inputs = GetTensorData<float>(input_gates_scratch);
+    for (int gate = use_cifg ? 1 : 0; gate < 4; ++gate) {
+      PrecomputeLstmGateInputsFloat(
+          GetTensorData<float>(input), input_to_gate_weights[gate],
+          layer_norm_coefficients[gate], gate_bias[gate], max_time * n_batch,
+          n_input, n_cell, gate_inputs, context);
+      precomputed_gate_inputs[gate] = gate_inputs;
+      gate_inputs += max_time * n_batch * n_cell;
+    }
+  }
+  // Returns the precomputed inputs of 'gate' for the input vectors starting at
+  // 'row'.
+  auto gate_inputs_at = [&](int gate, int row) -> const float* {
+    return precomputed_gate_inputs[gate] == nullptr
+               ? nullptr
+               : precomputed_gate_inputs[gate] + row * n_cell;
+  };
+
   const int output_batch_leading_dim =
       output->dims->data[output->dims->size - 1];
   if (time_major) {
@@ -1913,7 +2005,11 @@ TfLiteStatus EvalFloat(
           input_gate_scratch, forget_gate_scratch, cell_gate_scratch,
           output_gate_scratch, accumulation_scratch_buffer, output_ptr,
           recurrent_to_input_is_diag, recurrent_to_forget_is_diag,
-          recurrent_to_cell_is_diag, recurrent_to_output_is_diag, context);
+          recurrent_to_cell_is_diag, recurrent_to_output_is_diag, context,
+          gate_inputs_at(0, t_rel * n_batch),
+          gate_inputs_at(1, t_rel * n_batch),
+          gate_inputs_at(2, t_rel * n_batch),
+          gate_inputs_at(3, t_rel * n_batch));
     }
   } else {
     for (int b = 0; b < n_batch; b++) {
@@ -1976,7 +2072,9 @@ TfLiteStatus EvalFloat(
             forget_gate_scratch_ptr, cell_gate_scratch_ptr,
             output_gate_scratch_ptr, accumulation_scratch_buffer, output_ptr,
             recurrent_to_input_is_diag, recurrent_to_forget_is_diag,
-            recurrent_to_cell_is_diag, recurrent_to_output_is_diag, context);
+            recurrent_to_cell_is_diag, recurrent_to_output_is_diag, context,
+            gate_inputs_at(0, time_offset), gate_inputs_at(1, time_offset),
+            gate_inputs_at(2, time_offset), gate_inputs_at(3, time_offset));
       }
     }
   }
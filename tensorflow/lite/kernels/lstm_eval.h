@@ -95,6 +95,10 @@ struct IntegerLstmParameter {
   int32_t intermediate_zp[12];
 };
 
+// If 'input_gates_scratch' is provided, it must hold (3 with CIFG, 4 otherwise)
+// * max_time * n_batch * n_cell floats, and the input contributions to the
+// gates are computed for the whole sequence before the time loop. Unused with
+// an aux input.
 TfLiteStatus EvalFloat(
     const TfLiteTensor* input, const TfLiteTensor* input_to_input_weights,
     const TfLiteTensor* input_to_forget_weights,
@@ -124,7 +128,7 @@ TfLiteStatus EvalFloat(
     TfLiteTensor* cell_state, TfLiteTensor* output,
     bool recurrent_to_input_is_diag, bool recurrent_to_forget_is_diag,
     bool recurrent_to_cell_is_diag, bool recurrent_to_output_is_diag,
-    CpuBackendContext* context);
+    CpuBackendContext* context, TfLiteTensor* input_gates_scratch = nullptr);
 
 TfLiteStatus EvalHybrid(
     const TfLiteTensor* input, const TfLiteTensor* input_to_input_weights,
@@ -327,6 +327,48 @@ class SingleOpModel {
     return AddConstInput(t, data.data(), data.size());
   }
 
+  // Adds a constant INT4 input with blockwise quantization and returns its
+  // index. `data` holds one value in [-8, 7] per element, and the blocks of
+  // `block_size` consecutive elements are scaled by the fp32 `scales`, stored
+  // in a separate constant tensor.
+  int AddConstBlockwiseQuantInput(const TensorData& t,
+                                  const std::vector<int8_t>& data,
+                                  const std::vector<float>& scales,
+                                  int block_size) {
+    const int scales_id =
+        AddTensor(TensorData{TensorType_FLOAT32,
+                             {static_cast<int>(scales.size())}},
+                  scales.data(), scales.size());
+    const int id = tensors_.size();
+    flatbuffers::Offset<QuantizationParameters> q_params =
+        CreateQuantizationParameters(
+            builder_, /*min=*/0, /*max=*/0, /*scale=*/0, /*zero_point=*/0,
+            QuantizationDetails_BlockwiseQuantization,
+            CreateBlockwiseQuantization(builder_, scales_id,
+                                        /*zero_points=*/kTfLiteOptionalTensor,
+                                        block_size)
+                .Union());
+
+    std::vector<uint8_t> packed((data.size() + 1) / 2);
+    for (size_t i = 0; i < data.size(); ++i) {
+      packed[i / 2] |= (data[i] & 0x0F) << (i % 2 ? 4 : 0);
+    }
+    if (buffers_.empty()) {
+      buffers_.push_back(CreateBuffer(builder_, builder_.CreateVector({})));
+    }
+    const int buffer_id = buffers_.size();
+    builder_.ForceVectorAlignment(packed.size(), sizeof(uint8_t), 16);
+    buffers_.push_back(CreateBuffer(builder_, builder_.CreateVector(packed)));
+
+    tensors_.push_back(
+        CreateTensor(builder_, builder_.CreateVector<int>(t.shape), t.type,
+                     /*buffer=*/buffer_id,
+                     /*name=*/0, q_params, /*is_variable=*/false));
+    tensor_data_[id] = t;
+    inputs_.push_back(id);
+    return id;
+  }
+
   // TODO(b/166202747): Use a better way to do type specialization. Reduce
   // duplicate code in the two functions below.
   int AddConstSparseInput(const TensorData& t,
@@ -407,6 +407,10 @@ enum TemporaryTensor {
   kNumTemporaryTensors = 12,
 };
 
+// Float only, in place of the hybrid temporaries: the input contributions to
+// the gates for the whole sequence.
+constexpr int kInputGatesScratch = 1;
+
 void* Init(TfLiteContext* context, const char* buffer, size_t length) {
   auto* op_data = new OpData();
   context->AddTensors(context, kNumTemporaryTensors,
@@ -990,7 +994,7 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
   } else if (is_integer) {
     node->temporaries = TfLiteIntArrayCreate(6);
   } else {
-    node->temporaries = TfLiteIntArrayCreate(1);
+    node->temporaries = TfLiteIntArrayCreate(2);
   }
   node->temporaries->data[kScratchBuffer] =
       scratch_tensor_index + kScratchBuffer;
@@ -1019,6 +1023,26 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
   TF_LITE_ENSURE_OK(context, context->ResizeTensor(context, scratch_buffer,
                                                    scratch_buffer_size));
 
+  if (!IsHybridOp(input, input_to_output_weights) && !is_integer) {
+    node->temporaries->data[kInputGatesScratch] =
+        scratch_tensor_index + kInputGatesScratch;
+    TfLiteTensor* input_gates_scratch;
+    TF_LITE_ENSURE_OK(context,
+                      GetTemporarySafe(context, node, kInputGatesScratch,
+                                       &input_gates_scratch));
+    input_gates_scratch->type = kTfLiteFloat32;
+    input_gates_scratch->allocation_type = kTfLiteArenaRw;
+    const int max_time =
+        time_major ? input->dims->data[0] : input->dims->data[1];
+    const int n_gates = use_cifg ? 3 : 4;
+    TfLiteIntArray* input_gates_scratch_size = TfLiteIntArrayCreate(2);
+    input_gates_scratch_size->data[0] = n_gates * max_time * n_batch;
+    input_gates_scratch_size->data[1] = n_cell;
+    TF_LITE_ENSURE_OK(context,
+                      context->ResizeTensor(context, input_gates_scratch,
+                                            input_gates_scratch_size));
+  }
+
   if (IsHybridOp(input, input_to_output_weights)) {
     op_data->compute_row_sums = true;
     // Allocate temporary tensors to store quantized values of input,
@@ -1366,6 +1390,10 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
       TfLiteTensor* scratch_buffer;
       TF_LITE_ENSURE_OK(context, GetTemporarySafe(context, node, kScratchBuffer,
                                                   &scratch_buffer));
+      TfLiteTensor* input_gates_scratch;
+      TF_LITE_ENSURE_OK(context,
+                        GetTemporarySafe(context, node, kInputGatesScratch,
+                                         &input_gates_scratch));
       return lstm_eval::EvalFloat(
           input, input_to_input_weights, input_to_forget_weights,
           input_to_cell_weights, input_to_output_weights,
@@ -1392,7 +1420,7 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
           (recurrent_to_cell_weights->dims->size == 1),
           /*recurrent_to_output_is_diag=*/
           (recurrent_to_output_weights->dims->size == 1),
-          CpuBackendContext::GetFromContext(context));
+          CpuBackendContext::GetFromContext(context), input_gates_scratch);
     }
     case kTfLiteUInt8:
     case kTfLiteInt8: {
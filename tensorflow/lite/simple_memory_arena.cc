@@ -246,6 +246,8 @@ TfLiteStatus SimpleMemoryArena::Allocate(
   // If we don't find a better gap just allocate at the end of the buffer.
   const size_t kOffsetNotAssigned = std::numeric_limits<size_t>::max();
   size_t best_offset = kOffsetNotAssigned;
+  // The bytes left unused in the best gap found so far, after aligning the
+  // start of the tensor and placing it.
   size_t best_offset_fit = kOffsetNotAssigned;
 
   // Go through the sorted allocs and look at the gaps between them.
@@ -257,12 +259,12 @@ TfLiteStatus SimpleMemoryArena::Allocate(
       continue;
     }
     size_t aligned_current_offset = AlignTo(alignment, current_offset);
-    // If we found a gap larger than required size, and smaller than previous
-    // best fit, take it.
+    // If we found a gap larger than required size, that leaves fewer bytes
+    // unused than the previous best fit, take it.
     if (aligned_current_offset + size <= alloc.offset &&
-        alloc.offset - aligned_current_offset < best_offset_fit) {
+        alloc.offset - aligned_current_offset - size < best_offset_fit) {
       best_offset = aligned_current_offset;
-      best_offset_fit = alloc.offset - current_offset;
+      best_offset_fit = alloc.offset - aligned_current_offset - size;
     }
     current_offset = std::max(current_offset, alloc.offset + alloc.size);
     // A gap of zero is as good as it gets, no point continuing.
@@ -284,6 +286,18 @@ TfLiteStatus SimpleMemoryArena::Allocate(
   return kTfLiteOk;
 }
 
+void SimpleMemoryArena::AddAllocs(
+    const std::vector<ArenaAllocWithUsageInterval>& allocs) {
+  for (const ArenaAllocWithUsageInterval& alloc : allocs) {
+    // Like Allocate(), zero-sized allocs are not recorded.
+    if (alloc.size == 0) continue;
+    high_water_mark_ = std::max(high_water_mark_, alloc.offset + alloc.size);
+    active_allocs_.push_back(alloc);
+  }
+  // Allocate() inserts each alloc after those with the same offset.
+  std::stable_sort(active_allocs_.begin(), active_allocs_.end());
+}
+
 TfLiteStatus SimpleMemoryArena::Commit(bool* arena_reallocated) {
   // Resize the arena to the high water mark (calculated by Allocate), retaining
   // old contents and alignment in the process. Since Alloc pointers are offset
@@ -142,6 +142,11 @@ class SimpleMemoryArena {
                         int32_t tensor, int32_t first_node, int32_t last_node,
                         ArenaAllocWithUsageInterval* new_alloc);
 
+  // Adds `allocs`, whose offsets were computed by calls to Allocate() on an
+  // arena holding no other allocs, as if Allocate() had been called for each of
+  // them in order. This should be called right after ResetAllocs().
+  void AddAllocs(const std::vector<ArenaAllocWithUsageInterval>& allocs);
+
   TfLiteStatus Commit(bool* arena_reallocated);
 
   TfLiteStatus ResolveAlloc(TfLiteContext* context,
@@ -42,6 +42,50 @@ TEST(SimpleMemoryArenaTest, BasicArenaOperations) {
   EXPECT_EQ(allocs[5].offset, 2048);
 }
 
+TEST(SimpleMemoryArenaTest, BestFitAccountsForAlignment) {
+  TfLiteContext context;
+  SimpleMemoryArena arena(64);
+  ArenaAllocWithUsageInterval allocs[6];
+
+  arena.Allocate(&context, 64, 1, 0, 0, 10, &allocs[0]);
+  arena.Allocate(&context, 64, 64, 1, 0, 1, &allocs[1]);
+  arena.Allocate(&context, 64, 64, 2, 0, 10, &allocs[2]);
+  arena.Allocate(&context, 64, 64, 3, 0, 1, &allocs[3]);
+  arena.Allocate(&context, 64, 64, 4, 0, 10, &allocs[4]);
+  EXPECT_EQ(allocs[1].offset, 64);
+  EXPECT_EQ(allocs[3].offset, 192);
+
+  // Both gaps left by tensors 1 and 3 fit exactly once the start of the first
+  // one is aligned: the first is taken.
+  arena.Allocate(&context, 64, 64, 5, 5, 6, &allocs[5]);
+  EXPECT_EQ(allocs[5].offset, 64);
+}
+
+TEST(SimpleMemoryArenaTest, AddAllocsLikeAllocate) {
+  TfLiteContext context;
+  SimpleMemoryArena arena(64);
+  ArenaAllocWithUsageInterval allocs[4];
+  arena.Allocate(&context, 32, 2047, 0, 0, 2, &allocs[0]);
+  arena.Allocate(&context, 32, 0, 1, 1, 2, &allocs[1]);
+  arena.Allocate(&context, 32, 1023, 2, 1, 3, &allocs[2]);
+
+  SimpleMemoryArena added_arena(64);
+  added_arena.AddAllocs({allocs[0], allocs[1], allocs[2]});
+
+  // Both arenas place the next allocation at the same offset, and commit
+  // buffers of the same size.
+  ArenaAllocWithUsageInterval added_alloc;
+  arena.Allocate(&context, 32, 1023, 3, 2, 3, &allocs[3]);
+  added_arena.Allocate(&context, 32, 1023, 3, 2, 3, &added_alloc);
+  EXPECT_EQ(allocs[3].offset, 3072);
+  EXPECT_EQ(added_alloc.offset, allocs[3].offset);
+
+  bool reallocated = false;
+  ASSERT_EQ(arena.Commit(&reallocated), kTfLiteOk);
+  ASSERT_EQ(added_arena.Commit(&reallocated), kTfLiteOk);
+  EXPECT_EQ(added_arena.GetBufferSize(), arena.GetBufferSize());
+}
+
 TEST(SimpleMemoryArenaTest, BasicZeroAlloc) {
   TfLiteContext context;
   SimpleMemoryArena arena(64);
@@ -0,0 +1,388 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/tools/benchmark/benchmark_concurrent_models.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "tensorflow/lite/core/c/c_api_types.h"
+#include "tensorflow/lite/profiling/memory_info.h"
+#include "tensorflow/lite/profiling/time.h"
+#include "tensorflow/lite/tools/benchmark/benchmark_model.h"
+#include "tensorflow/lite/tools/benchmark/benchmark_params.h"
+#include "tensorflow/lite/tools/benchmark/benchmark_tflite_model.h"
+#include "tensorflow/lite/tools/benchmark/benchmark_utils.h"
+#include "tensorflow/lite/tools/command_line_flags.h"
+#include "tensorflow/lite/tools/logging.h"
+
+namespace tflite {
+namespace benchmark {
+namespace {
+
+// A BenchmarkTfLiteModel serving the requests of one thread.
+class ConcurrentInstance : public BenchmarkTfLiteModel {
+ public:
+  TfLiteStatus Initialize() {
+    TF_LITE_ENSURE_STATUS(ValidateParams());
+    TF_LITE_ENSURE_STATUS(Init());
+    return PrepareInputData();
+  }
+
+  TfLiteStatus Serve() {
+    TF_LITE_ENSURE_STATUS(ResetInputsAndOutputs());
+    return RunImpl();
+  }
+};
+
+struct Completion {
+  int64_t end_us;
+  int64_t latency_us;
+};
+
+// The requests of a model, shared by the threads of its instances.
+struct ModelQueue {
+  absl::Mutex mu;
+  absl::CondVar cv;
+  // The arrival times of the requests waiting for an instance.
+  std::deque<int64_t> arrivals_us ABSL_GUARDED_BY(mu);
+  bool stopped ABSL_GUARDED_BY(mu) = false;
+  int64_t arrived ABSL_GUARDED_BY(mu) = 0;
+  int64_t failed ABSL_GUARDED_BY(mu) = 0;
+  std::vector<Completion> completions ABSL_GUARDED_BY(mu);
+};
+
+void ServeRequests(ConcurrentInstance* instance, ModelQueue* queue) {
+  while (true) {
+    int64_t arrival_us;
+    {
+      absl::MutexLock lock(&queue->mu);
+      while (!queue->stopped && queue->arrivals_us.empty()) {
+        queue->cv.Wait(&queue->mu);
+      }
+      if (queue->stopped) return;
+      arrival_us = queue->arrivals_us.front();
+      queue->arrivals_us.pop_front();
+    }
+    const TfLiteStatus status = instance->Serve();
+    const int64_t end_us = profiling::time::NowMicros();
+    absl::MutexLock lock(&queue->mu);
+    if (status == kTfLiteOk) {
+      queue->completions.push_back({end_us, end_us - arrival_us});
+    } else {
+      ++queue->failed;
+    }
+  }
+}
+
+// Returns the nearest-rank percentile `p` (in [0, 1]) of sorted `values`.
+int64_t Percentile(const std::vector<int64_t>& sorted_values, double p) {
+  if (sorted_values.empty()) return 0;
+  const size_t rank =
+      static_cast<size_t>(std::ceil(p * sorted_values.size()));
+  return sorted_values[std::min(std::max<size_t>(rank, 1),
+                                sorted_values.size()) -
+                       1];
+}
+
+double MaxThermalZoneTemperatureC() {
+  double max_temperature_c = -1.0;
+#ifdef __linux__
+  for (int zone = 0;; ++zone) {
+    std::ifstream file("/sys/class/thermal/thermal_zone" +
+                       std::to_string(zone) + "/temp");
+    if (!file) break;
+    int64_t millidegrees;
+    if (file >> millidegrees) {
+      max_temperature_c = std::max(max_temperature_c, millidegrees / 1000.0);
+    }
+  }
+#endif  // __linux__
+  return max_temperature_c;
+}
+
+double AverageCpuFrequencyMhz() {
+#ifdef __linux__
+  const int num_cpus = std::thread::hardware_concurrency();
+  double sum_khz = 0;
+  int count = 0;
+  for (int cpu = 0; cpu < num_cpus; ++cpu) {
+    std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(cpu) +
+                       "/cpufreq/scaling_cur_freq");
+    int64_t khz;
+    if (file && file >> khz) {
+      sum_khz += khz;
+      ++count;
+    }
+  }
+  if (count > 0) return sum_khz / count / 1000.0;
+#endif  // __linux__
+  return -1.0;
+}
+
+}  // namespace
+
+BenchmarkParams BenchmarkConcurrentModels::DefaultParams() {
+  BenchmarkParams params;
+  params.AddParam("graphs", BenchmarkParam::Create<std::string>(""));
+  params.AddParam("num_instances", BenchmarkParam::Create<int32_t>(1));
+  params.AddParam("target_qps", BenchmarkParam::Create<float>(10.0f));
+  params.AddParam("duration_secs", BenchmarkParam::Create<float>(10.0f));
+  params.AddParam("arrival_process",
+                  BenchmarkParam::Create<std::string>("poisson"));
+  params.AddParam("report_interval_secs", BenchmarkParam::Create<float>(1.0f));
+  return params;
+}
+
+BenchmarkConcurrentModels::BenchmarkConcurrentModels()
+    : params_(DefaultParams()) {}
+
+std::vector<Flag> BenchmarkConcurrentModels::GetFlags() {
+  return {
+      CreateFlag<std::string>("graphs", &params_,
+                              "comma-separated graph file names"),
+      CreateFlag<int32_t>("num_instances", &params_,
+                          "number of interpreters of each graph, each invoked "
+                          "on its own thread"),
+      CreateFlag<float>("target_qps", &params_,
+                        "total rate of the requests, spread evenly over the "
+                        "graphs, in requests per second"),
+      CreateFlag<float>("duration_secs", &params_,
+                        "duration of the load, in seconds"),
+      CreateFlag<std::string>(
+          "arrival_process", &params_,
+          "how requests arrive: 'poisson' (exponentially distributed gaps) "
+          "or 'uniform' (evenly spaced)"),
+      CreateFlag<float>("report_interval_secs", &params_,
+                        "interval between two reports of throughput, latency, "
+                        "temperature and CPU frequency, in seconds"),
+  };
+}
+
+void BenchmarkConcurrentModels::LogParams() {
+  LOG_BENCHMARK_PARAM(std::string, "graphs", "Graphs", true);
+  LOG_BENCHMARK_PARAM(int32_t, "num_instances", "Instances per graph", true);
+  LOG_BENCHMARK_PARAM(float, "target_qps", "Target QPS", true);
+  LOG_BENCHMARK_PARAM(float, "duration_secs", "Duration (seconds)", true);
+  LOG_BENCHMARK_PARAM(std::string, "arrival_process", "Arrival process", true);
+  LOG_BENCHMARK_PARAM(float, "report_interval_secs",
+                      "Report interval (seconds)", true);
+}
+
+TfLiteStatus BenchmarkConcurrentModels::ParseFlags(int* argc, char** argv) {
+  auto flag_list = GetFlags();
+  if (!Flags::Parse(argc, const_cast<const char**>(argv), flag_list)) {
+    TFLITE_LOG(ERROR) << Flags::Usage(argv[0], flag_list);
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus BenchmarkConcurrentModels::ValidateParams() {
+  graphs_.clear();
+  util::SplitAndParse(params_.Get<std::string>("graphs"), ',', &graphs_);
+  if (graphs_.empty()) {
+    TFLITE_LOG(ERROR) << "Please specify the models with --graphs.";
+    return kTfLiteError;
+  }
+  if (params_.Get<int32_t>("num_instances") <= 0 ||
+      params_.Get<float>("target_qps") <= 0 ||
+      params_.Get<float>("duration_secs") <= 0 ||
+      params_.Get<float>("report_interval_secs") <= 0) {
+    TFLITE_LOG(ERROR) << "--num_instances, --target_qps, --duration_secs and "
+                         "--report_interval_secs must be positive.";
+    return kTfLiteError;
+  }
+  const std::string arrival_process =
+      params_.Get<std::string>("arrival_process");
+  if (arrival_process != "poisson" && arrival_process != "uniform") {
+    TFLITE_LOG(ERROR) << "Unknown --arrival_process: " << arrival_process;
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus BenchmarkConcurrentModels::Run(int argc, char** argv) {
+  TF_LITE_ENSURE_STATUS(ParseFlags(&argc, argv));
+  instance_args_.assign(argv, argv + argc);
+  return Run();
+}
+
+TfLiteStatus BenchmarkConcurrentModels::Run() {
+  TF_LITE_ENSURE_STATUS(ValidateParams());
+  LogParams();
+  if (instance_args_.empty()) instance_args_.push_back("benchmark");
+
+  const int num_models = graphs_.size();
+  const int num_instances = params_.Get<int32_t>("num_instances");
+  model_stats_.assign(num_models, {});
+  interval_stats_.clear();
+
+  // Initialize the instances one at a time, to attribute the memory they use.
+  std::vector<std::unique_ptr<ConcurrentInstance>> instances;
+  for (int model = 0; model < num_models; ++model) {
+    model_stats_[model].graph = graphs_[model];
+    for (int i = 0; i < num_instances; ++i) {
+      std::vector<std::string> args = instance_args_;
+      args.push_back("--graph=" + graphs_[model]);
+      std::vector<char*> argv;
+      for (std::string& arg : args) argv.push_back(&arg[0]);
+      int argc = argv.size();
+
+      const auto start_mem_usage = profiling::memory::GetMemoryUsage();
+      auto instance = std::make_unique<ConcurrentInstance>();
+      TF_LITE_ENSURE_STATUS(instance->ParseFlags(&argc, argv.data()));
+      TF_LITE_ENSURE_STATUS(instance->Initialize());
+      // The first inference is usually much slower than the others.
+      TF_LITE_ENSURE_STATUS(instance->Serve());
+      const auto mem_usage =
+          profiling::memory::GetMemoryUsage() - start_mem_usage;
+      model_stats_[model].memory_per_instance_mb +=
+          mem_usage.mem_footprint_kb / 1024.0 / num_instances;
+      instances.push_back(std::move(instance));
+    }
+  }
+
+  std::vector<ModelQueue> queues(num_models);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < instances.size(); ++i) {
+    threads.emplace_back(ServeRequests, instances[i].get(),
+                         &queues[i / num_instances]);
+  }
+
+  // Generate the arrivals, and sample the temperature and CPU frequency at
+  // the end of each interval.
+  const double qps = params_.Get<float>("target_qps");
+  const bool poisson = params_.Get<std::string>("arrival_process") == "poisson";
+  std::mt19937 random_engine(std::random_device{}());
+  std::exponential_distribution<double> poisson_gap_secs(qps);
+  const int64_t interval_us =
+      static_cast<int64_t>(params_.Get<float>("report_interval_secs") * 1e6);
+  const int64_t start_us = profiling::time::NowMicros();
+  const int64_t end_us =
+      start_us +
+      static_cast<int64_t>(params_.Get<float>("duration_secs") * 1e6);
+  int64_t next_interval_us = start_us + interval_us;
+  // Keep arrival times in double precision so uniform gaps don't drift.
+  double next_arrival_us = start_us;
+  for (int64_t request = 0;; ++request) {
+    const int64_t arrival_us = static_cast<int64_t>(next_arrival_us);
+    while (next_interval_us <= std::min(arrival_us, end_us)) {
+      profiling::time::SleepForMicros(
+          std::max<int64_t>(next_interval_us - profiling::time::NowMicros(),
+                            0));
+      ConcurrentIntervalStats interval;
+      interval.end_secs = (next_interval_us - start_us) / 1e6;
+      interval.max_temperature_c = MaxThermalZoneTemperatureC();
+      interval.avg_cpu_freq_mhz = AverageCpuFrequencyMhz();
+      interval_stats_.push_back(interval);
+      next_interval_us += interval_us;
+    }
+    if (arrival_us >= end_us) break;
+    profiling::time::SleepForMicros(
+        std::max<int64_t>(arrival_us - profiling::time::NowMicros(), 0));
+    ModelQueue& queue = queues[request % num_models];
+    {
+      absl::MutexLock lock(&queue.mu);
+      queue.arrivals_us.push_back(arrival_us);
+      ++queue.arrived;
+    }
+    queue.cv.Signal();
+    next_arrival_us += (poisson ? poisson_gap_secs(random_engine) : 1.0 / qps) *
+                       1e6;
+  }
+  // Wait for the instances to finish their current inference.
+  for (ModelQueue& queue : queues) {
+    absl::MutexLock lock(&queue.mu);
+    queue.stopped = true;
+    queue.cv.SignalAll();
+  }
+  for (std::thread& thread : threads) thread.join();
+  const double duration_secs = (profiling::time::NowMicros() - start_us) / 1e6;
+
+  std::vector<std::vector<int64_t>> interval_latencies_us(
+      interval_stats_.size());
+  for (int model = 0; model < num_models; ++model) {
+    ModelQueue& queue = queues[model];
+    absl::MutexLock lock(&queue.mu);
+    ConcurrentModelStats& stats = model_stats_[model];
+    stats.arrived = queue.arrived;
+    stats.failed = queue.failed;
+    stats.completed = queue.completions.size();
+    stats.throughput_qps = stats.completed / duration_secs;
+    std::vector<int64_t> latencies_us;
+    for (const Completion& completion : queue.completions) {
+      latencies_us.push_back(completion.latency_us);
+      const size_t interval = (completion.end_us - start_us) / interval_us;
+      if (interval < interval_latencies_us.size()) {
+        interval_latencies_us[interval].push_back(completion.latency_us);
+      }
+    }
+    std::sort(latencies_us.begin(), latencies_us.end());
+    stats.latency_p50_us = Percentile(latencies_us, 0.5);
+    stats.latency_p99_us = Percentile(latencies_us, 0.99);
+    stats.latency_p999_us = Percentile(latencies_us, 0.999);
+    stats.latency_max_us = latencies_us.empty() ? 0 : latencies_us.back();
+  }
+  for (int i = 0; i < interval_stats_.size(); ++i) {
+    std::sort(interval_latencies_us[i].begin(), interval_latencies_us[i].end());
+    interval_stats_[i].completed = interval_latencies_us[i].size();
+    interval_stats_[i].latency_p99_us =
+        Percentile(interval_latencies_us[i], 0.99);
+  }
+
+  LogResults();
+  for (const ConcurrentModelStats& stats : model_stats_) {
+    if (stats.failed > 0) return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+void BenchmarkConcurrentModels::LogResults() const {
+  TFLITE_LOG(INFO) << "Over time (all graphs):";
+  for (const ConcurrentIntervalStats& interval : interval_stats_) {
+    TFLITE_LOG(INFO) << "  t=" << interval.end_secs
+                     << "s completed=" << interval.completed
+                     << " p99=" << interval.latency_p99_us << "us"
+                     << " max_temperature=" << interval.max_temperature_c
+                     << "C avg_cpu_freq=" << interval.avg_cpu_freq_mhz
+                     << "MHz";
+  }
+  for (const ConcurrentModelStats& stats : model_stats_) {
+    TFLITE_LOG(INFO) << "Graph " << stats.graph << ": arrived=" << stats.arrived
+                     << " completed=" << stats.completed
+                     << " failed=" << stats.failed
+                     << " throughput=" << stats.throughput_qps << "qps"
+                     << " p50=" << stats.latency_p50_us << "us"
+                     << " p99=" << stats.latency_p99_us << "us"
+                     << " p99.9=" << stats.latency_p999_us << "us"
+                     << " max=" << stats.latency_max_us << "us"
+                     << " memory_per_instance="
+                     << stats.memory_per_instance_mb << "MB";
+  }
+}
+
+}  // namespace benchmark
+}  // namespace tflite
@@ -0,0 +1,114 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_TOOLS_BENCHMARK_BENCHMARK_CONCURRENT_MODELS_H_
+#define TENSORFLOW_LITE_TOOLS_BENCHMARK_BENCHMARK_CONCURRENT_MODELS_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "tensorflow/lite/core/c/c_api_types.h"
+#include "tensorflow/lite/tools/benchmark/benchmark_params.h"
+#include "tensorflow/lite/tools/command_line_flags.h"
+
+namespace tflite {
+namespace benchmark {
+
+// The results of a concurrent benchmark for one model.
+struct ConcurrentModelStats {
+  std::string graph;
+  // Requests which arrived during the benchmark, and those which completed.
+  // Requests still queued when the benchmark ends are not run.
+  int64_t arrived = 0;
+  int64_t completed = 0;
+  int64_t failed = 0;
+  double throughput_qps = 0.0;
+  // Latencies from the arrival of a request to the end of its inference, so
+  // they include the time the request was queued for a free instance.
+  int64_t latency_p50_us = 0;
+  int64_t latency_p99_us = 0;
+  int64_t latency_p999_us = 0;
+  int64_t latency_max_us = 0;
+  // Memory footprint growth caused by initializing one instance, averaged
+  // over the instances of the model.
+  double memory_per_instance_mb = 0.0;
+};
+
+// The state of the benchmark over one --report_interval_secs window.
+struct ConcurrentIntervalStats {
+  double end_secs = 0.0;
+  int64_t completed = 0;
+  int64_t latency_p99_us = 0;
+  // The hottest thermal zone and the average current CPU frequency at the end
+  // of the interval, or negative if they aren't available on the platform.
+  double max_temperature_c = -1.0;
+  double avg_cpu_freq_mhz = -1.0;
+};
+
+// Benchmarks several models under a concurrent, open-loop load, the way
+// servers and apps with several loaded models run them.
+//
+// Each of the comma-separated --graphs gets --num_instances interpreters,
+// each invoked on its own thread. Requests arrive at --target_qps in total,
+// spread round-robin over the models, independently of their completion: a
+// request waits in its model's queue for a free instance if all of them are
+// busy, and that wait is part of its latency. Arrivals are a Poisson process,
+// or evenly spaced with --arrival_process=uniform.
+//
+// The flags which aren't those of the concurrent benchmark are parsed by each
+// instance, a BenchmarkTfLiteModel, so that all of them other than --graph
+// (threads, delegates, inputs, ...) apply to every instance.
+class BenchmarkConcurrentModels {
+ public:
+  BenchmarkConcurrentModels();
+  virtual ~BenchmarkConcurrentModels() = default;
+
+  TfLiteStatus Run(int argc, char** argv);
+  TfLiteStatus Run();
+
+  // The results of the last run, one entry per graph.
+  const std::vector<ConcurrentModelStats>& model_stats() const {
+    return model_stats_;
+  }
+  const std::vector<ConcurrentIntervalStats>& interval_stats() const {
+    return interval_stats_;
+  }
+
+ protected:
+  static BenchmarkParams DefaultParams();
+
+  // Unparsable flags will remain in 'argv' in the original order and 'argc'
+  // will be updated accordingly.
+  TfLiteStatus ParseFlags(int* argc, char** argv);
+  virtual std::vector<Flag> GetFlags();
+
+  void LogParams();
+  TfLiteStatus ValidateParams();
+  void LogResults() const;
+
+  BenchmarkParams params_;
+  // The command line flags of the instances, starting with the program name.
+  std::vector<std::string> instance_args_;
+
+  std::vector<std::string> graphs_;
+  std::vector<ConcurrentModelStats> model_stats_;
+  std::vector<ConcurrentIntervalStats> interval_stats_;
+};
+
+}  // namespace benchmark
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_TOOLS_BENCHMARK_BENCHMARK_CONCURRENT_MODELS_H_
@@ -63,6 +63,7 @@ BenchmarkParams BenchmarkModel::DefaultParams() {
   params.AddParam("run_frequency", BenchmarkParam::Create<float>(-1.0f));
   params.AddParam("num_threads", BenchmarkParam::Create<int32_t>(-1));
   params.AddParam("use_caching", BenchmarkParam::Create<bool>(false));
+  params.AddParam("always_cache_weights", BenchmarkParam::Create<bool>(false));
   params.AddParam("benchmark_name", BenchmarkParam::Create<std::string>(""));
   params.AddParam("output_prefix", BenchmarkParam::Create<std::string>(""));
   params.AddParam("warmup_runs", BenchmarkParam::Create<int32_t>(1));
@@ -145,6 +146,11 @@ std::vector<Flag> BenchmarkModel::GetFlags() {
           "Enable caching of prepacked weights matrices in matrix "
           "multiplication routines. Currently implies the use of the Ruy "
           "library."),
+      CreateFlag<bool>(
+          "always_cache_weights", &params_,
+          "With use_caching, cache the prepacked weights of all matrix "
+          "multiplications, not only of the narrow ones where caching is "
+          "expected to be a large speedup."),
       CreateFlag<std::string>("benchmark_name", &params_, "benchmark name"),
       CreateFlag<std::string>("output_prefix", &params_,
                               "benchmark output prefix"),
@@ -196,6 +202,8 @@ void BenchmarkModel::LogParams() {
                       "Number of prorated runs per second", verbose);
   LOG_BENCHMARK_PARAM(int32_t, "num_threads", "Num threads", verbose);
   LOG_BENCHMARK_PARAM(bool, "use_caching", "Use caching", verbose);
+  LOG_BENCHMARK_PARAM(bool, "always_cache_weights", "Always cache weights",
+                      verbose);
   LOG_BENCHMARK_PARAM(std::string, "benchmark_name", "Benchmark name", verbose);
   LOG_BENCHMARK_PARAM(std::string, "output_prefix", "Output prefix", verbose);
   LOG_BENCHMARK_PARAM(int32_t, "warmup_runs", "Min warmup runs", verbose);
@@ -34,6 +34,7 @@ limitations under the License.
 #include "tensorflow/lite/interpreter.h"
 #include "tensorflow/lite/string_util.h"
 #include "tensorflow/lite/testing/util.h"
+#include "tensorflow/lite/tools/benchmark/benchmark_concurrent_models.h"
 #include "tensorflow/lite/tools/benchmark/benchmark_performance_options.h"
 #include "tensorflow/lite/tools/benchmark/benchmark_tflite_model.h"
 #include "tensorflow/lite/tools/command_line_flags.h"
@@ -546,6 +547,36 @@ TEST(BenchmarkTest, RunWithUseCaching) {
   EXPECT_EQ(kTfLiteOk, status);
 }
 
+TEST(BenchmarkTest, DoesntCrashConcurrentModels) {
+  ASSERT_THAT(g_fp32_model_path, testing::NotNull());
+  ASSERT_THAT(g_int8_model_path, testing::NotNull());
+  BenchmarkConcurrentModels benchmark;
+  ScopedCommandlineArgs scoped_argv(
+      {"--graphs=" + *g_fp32_model_path + "," + *g_int8_model_path,
+       "--num_instances=2", "--target_qps=200", "--duration_secs=0.5",
+       "--report_interval_secs=0.25", "--num_threads=1"});
+  EXPECT_EQ(kTfLiteOk, benchmark.Run(scoped_argv.argc(), scoped_argv.argv()));
+
+  ASSERT_EQ(benchmark.model_stats().size(), 2);
+  for (const ConcurrentModelStats& stats : benchmark.model_stats()) {
+    EXPECT_GT(stats.arrived, 0);
+    EXPECT_GT(stats.completed, 0);
+    EXPECT_LE(stats.completed, stats.arrived);
+    EXPECT_EQ(stats.failed, 0);
+    EXPECT_LE(stats.latency_p50_us, stats.latency_p99_us);
+    EXPECT_LE(stats.latency_p99_us, stats.latency_p999_us);
+    EXPECT_LE(stats.latency_p999_us, stats.latency_max_us);
+  }
+  EXPECT_EQ(benchmark.interval_stats().size(), 2);
+}
+
+TEST(BenchmarkTest, ConcurrentModelsRequireGraphs) {
+  BenchmarkConcurrentModels benchmark;
+  ScopedCommandlineArgs scoped_argv({"--duration_secs=0.1"});
+  EXPECT_EQ(kTfLiteError,
+            benchmark.Run(scoped_argv.argc(), scoped_argv.argv()));
+}
+
 class MaxDurationWorksTestListener : public BenchmarkListener {
   void OnBenchmarkEnd(const BenchmarkResults& results) override {
     const int64_t num_actual_runs = results.inference_time_us().count();
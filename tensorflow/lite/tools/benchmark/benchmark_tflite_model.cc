@@ -1053,6 +1053,8 @@ TfLiteStatus BenchmarkTfLiteModel::InitInterpreter() {
     std::unique_ptr<tflite::CpuBackendContext> cpu_backend_context(
         new tflite::CpuBackendContext());
     cpu_backend_context->SetUseCaching(true);
+    cpu_backend_context->SetAlwaysCacheConstantData(
+        params_.Get<bool>("always_cache_weights"));
     cpu_backend_context->SetMaxNumThreads(num_threads);
     external_context_->set_internal_backend_context(
         std::move(cpu_backend_context));
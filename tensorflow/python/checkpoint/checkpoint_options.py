@@ -48,6 +48,7 @@ class CheckpointOptions(object):
       "enable_async",
       "experimental_sharding_callback",
       "experimental_skip_slot_variables",
+      "experimental_parallel_shard_writes",
   )
 
   @deprecated_args(
@@ -60,7 +61,8 @@ class CheckpointOptions(object):
       experimental_write_callbacks=None,
       enable_async=False,
       experimental_skip_slot_variables=False,
-      experimental_sharding_callback=None
+      experimental_sharding_callback=None,
+      experimental_parallel_shard_writes=False,
   ):
     """Creates an object that stores options for a Checkpoint.
 
@@ -100,6 +102,11 @@ class CheckpointOptions(object):
         `tf.train.experimental.ShardByDevicePolicy` and
         `tf.train.experimental.MaxShardSizePolicy`. You may also write a custom
         callback, see `tf.train.experimental.ShardingCallback`.
+      experimental_parallel_shard_writes: bool Type. If true, the checkpoint
+        shards that each task saves are written concurrently from background
+        threads, instead of one after the other. The saved tensors are copied
+        when their shard starts to be written, so memory consumption may
+        increase by the size of the checkpoint.
     """
     self.experimental_io_device = experimental_io_device
     self.enable_async = experimental_enable_async_checkpoint or enable_async
@@ -117,6 +124,7 @@ class CheckpointOptions(object):
                          f"was of type {type(experimental_sharding_callback)}.")
     self.experimental_sharding_callback = experimental_sharding_callback
     self.experimental_skip_slot_variables = experimental_skip_slot_variables
+    self.experimental_parallel_shard_writes = experimental_parallel_shard_writes
 
   def __copy__(self):
     # Only `experimental_write_callbacks` needs special treatment to Ensure that
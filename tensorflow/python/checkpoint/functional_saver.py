@@ -55,6 +55,19 @@ MappedCapturesCallable = Callable[
     [core.ConcreteFunction, Sequence[tensor_lib.Tensor]], tensor_lib.Tensor]
 
 
+def _shard_save_device(
+    shard: sharding_util.Shard,
+    task: device_lib.DeviceSpec,
+    options: "checkpoint_options.CheckpointOptions",
+) -> "device_lib.DeviceSpec | str":
+  """Returns the device that saves `shard`, see `_single_shard_save`."""
+  has_tensors = any(
+      tensor is not None
+      for tensor_slices in shard.values()
+      for tensor in tensor_slices.values())
+  return options.experimental_io_device or (has_tensors and task) or "CPU:0"
+
+
 def _single_shard_save(
     file_prefix: tensor_lib.Tensor,
     shard: sharding_util.Shard,
@@ -97,8 +110,12 @@ def _single_shard_save(
         tensors.append(tensor)
         slice_specs.append(spec)
 
-  save_device = options.experimental_io_device or (tensors and task)
-  with ops.device(save_device or "CPU:0"):
+  with ops.device(_shard_save_device(shard, task, options)):
+    if options.experimental_parallel_shard_writes:
+      # The shard is written in the background, and waited for before the
+      # shards are merged.
+      return gen_io_ops._async_save_v2(  # pylint: disable=protected-access
+          file_prefix, tensor_names, slice_specs, tensors)
     return io_ops.save_v2(file_prefix, tensor_names, slice_specs, tensors)
 
 
@@ -519,6 +536,7 @@ class MultiDeviceSaver:
       metrics.AddNumCheckpointShardsWritten(num_shards=num_shards)
       num_shards_tensor = constant_op.constant(num_shards, name="num_shards")
       sharded_saves = []
+      async_prefixes_by_device = {}
 
       shard_idx = 0
       for task, shards in shards_by_task:
@@ -530,6 +548,19 @@ class MultiDeviceSaver:
           saved_prefixes.append(shard_prefix)
           sharded_saves.append(
               _single_shard_save(shard_prefix, shard, task, options))
+          async_prefixes_by_device.setdefault(
+              _shard_save_device(shard, task, options), []).append(shard_prefix)
+
+      if options.experimental_parallel_shard_writes:
+        # Wait for the shards on the device that started writing them, since
+        # each process writes its shards from its own background threads.
+        with ops.control_dependencies(sharded_saves):
+          sharded_saves = []
+          for device, prefixes in async_prefixes_by_device.items():
+            with ops.device(device):
+              sharded_saves.append(
+                  gen_io_ops._wait_for_async_saves(  # pylint: disable=protected-access
+                      array_ops.stack(prefixes)))
 
       with ops.control_dependencies(sharded_saves):
         # Merge on the io_device if specified, otherwise co-locates the merge op
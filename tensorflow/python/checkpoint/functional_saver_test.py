@@ -21,6 +21,7 @@ from tensorflow.python.checkpoint import checkpoint
 from tensorflow.python.checkpoint import checkpoint_options
 from tensorflow.python.checkpoint import functional_saver
 from tensorflow.python.checkpoint import graph_view
+from tensorflow.python.checkpoint.sharding import sharding_policies
 from tensorflow.python.eager import context
 from tensorflow.python.eager import remote
 from tensorflow.python.eager import test
@@ -117,6 +118,30 @@ class SaverTest(test.TestCase):
         if op.type in ("SaveV2", "RestoreV2"):
           self.assertEqual(LOCALHOST, op.device)
 
+  @test_util.run_in_graph_and_eager_modes
+  def test_parallel_shard_writes(self):
+    root = module.Module()
+    root.v0 = resource_variable_ops.ResourceVariable([0., 1., 2., 3.])
+    root.v1 = resource_variable_ops.ResourceVariable([4., 5., 6., 7.])
+    self.evaluate([root.v0.initializer, root.v1.initializer])
+    options = checkpoint_options.CheckpointOptions(
+        experimental_sharding_callback=(
+            sharding_policies.MaxShardSizePolicy(max_shard_size=8)),
+        experimental_parallel_shard_writes=True)
+    ckpt = checkpoint.Checkpoint(root=root)
+    prefix = os.path.join(self.get_temp_dir(), "ckpt")
+    save_path = ckpt.write(prefix, options=options)
+    self.assertGreater(len(gfile.Glob(save_path + ".data-*")), 1)
+    if not context.executing_eagerly():
+      op_types = [op.type for op in ops.get_default_graph().get_operations()]
+      self.assertIn("_AsyncSaveV2", op_types)
+      self.assertNotIn("SaveV2", op_types)
+
+    self.evaluate([root.v0.assign([0.] * 4), root.v1.assign([0.] * 4)])
+    ckpt.read(save_path).run_restore_ops()
+    self.assertAllEqual([0., 1., 2., 3.], self.evaluate(root.v0))
+    self.assertAllEqual([4., 5., 6., 7.], self.evaluate(root.v1))
+
   def test_to_proto(self):
     v1 = resource_variable_ops.ResourceVariable(2.)
     saver = functional_saver.MultiDeviceSaver.from_saveables(
@@ -152,6 +152,7 @@ class OptionsTest(test_base.DatasetTestBase, parameterized.TestCase):
         options_lib.AutoShardPolicy.DATA)
     options.experimental_distribute.num_devices = 1000
     options.experimental_optimization.apply_default_optimizations = True
+    options.experimental_optimization.decode_and_crop_fusion = True
     options.experimental_optimization.filter_fusion = True
     options.experimental_optimization.filter_parallelization = True
     options.experimental_optimization.inject_prefetch = False
@@ -159,6 +160,7 @@ class OptionsTest(test_base.DatasetTestBase, parameterized.TestCase):
     options.experimental_optimization.map_and_filter_fusion = True
     options.experimental_optimization.map_fusion = True
     options.experimental_optimization.map_parallelization = True
+    options.experimental_optimization.map_vectorization = True
     options.experimental_optimization.noop_elimination = True
     options.experimental_optimization.parallel_batch = True
     options.experimental_optimization.shuffle_and_repeat_fusion = True
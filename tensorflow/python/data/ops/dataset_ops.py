@@ -1548,6 +1548,13 @@ class DatasetV2(
     # [0, 1, 2, 3, 4]
     ```
 
+    If the filename ends with a `/`, it names a directory holding a cache that
+    is keyed by a fingerprint of the input pipeline. Jobs that cache the same
+    pipeline into the same directory share the cache: the first iterator to
+    start writes it, iterators in other jobs read from their input until the
+    cache is complete, and later iterations read from the cache. Changing the
+    input pipeline selects a different cache.
+
     Note: `cache` will produce exactly the same elements during each iteration
     through the dataset. If you wish to randomize the iteration order, make sure
     to call `shuffle` *after* calling `cache`.
@@ -339,6 +339,16 @@ class OptimizationOptions(options_lib.OptionsBase):
       "Whether to apply default graph optimizations. If False, only graph "
       "optimizations that have been explicitly enabled will be applied.")
 
+  decode_and_crop_fusion = options_lib.create_option(
+      name="decode_and_crop_fusion",
+      ty=bool,
+      docstring=(
+          "Whether to fuse JPEG decoding in map functions with a subsequent"
+          " crop of the decoded image, so that only the cropped region is"
+          " decoded. If None, defaults to False."
+      ),
+  )
+
   filter_fusion = options_lib.create_option(
       name="filter_fusion",
       ty=bool,
@@ -401,6 +411,17 @@ class OptimizationOptions(options_lib.OptionsBase):
       "Whether to parallelize stateless map transformations. If None, defaults "
       "to True.")
 
+  map_vectorization = options_lib.create_option(
+      name="map_vectorization",
+      ty=bool,
+      docstring=(
+          "Whether to swap a map transformation with a subsequent batch"
+          " transformation when the map function only consists of elementwise"
+          " operations, so that it runs once per batch. If None, defaults to"
+          " False."
+      ),
+  )
+
   noop_elimination = options_lib.create_option(
       name="noop_elimination",
       ty=bool,
@@ -423,6 +444,8 @@ class OptimizationOptions(options_lib.OptionsBase):
     pb = dataset_options_pb2.OptimizationOptions()
     if self.apply_default_optimizations is not None:
       pb.apply_default_optimizations = self.apply_default_optimizations
+    if self.decode_and_crop_fusion is not None:
+      pb.decode_and_crop_fusion = self.decode_and_crop_fusion
     if self.filter_fusion is not None:
       pb.filter_fusion = self.filter_fusion
     if self.filter_parallelization is not None:
@@ -439,6 +462,8 @@ class OptimizationOptions(options_lib.OptionsBase):
       pb.map_fusion = self.map_fusion
     if self.map_parallelization is not None:
       pb.map_parallelization = self.map_parallelization
+    if self.map_vectorization is not None:
+      pb.map_vectorization = self.map_vectorization
     if self.noop_elimination is not None:
       pb.noop_elimination = self.noop_elimination
     if self.parallel_batch is not None:
@@ -450,6 +475,8 @@ class OptimizationOptions(options_lib.OptionsBase):
   def _from_proto(self, pb):
     if pb.WhichOneof("optional_apply_default_optimizations") is not None:
       self.apply_default_optimizations = pb.apply_default_optimizations
+    if pb.WhichOneof("optional_decode_and_crop_fusion") is not None:
+      self.decode_and_crop_fusion = pb.decode_and_crop_fusion
     if pb.WhichOneof("optional_filter_fusion") is not None:
       self.filter_fusion = pb.filter_fusion
     if pb.WhichOneof("optional_filter_parallelization") is not None:
@@ -466,6 +493,8 @@ class OptimizationOptions(options_lib.OptionsBase):
       self.map_fusion = pb.map_fusion
     if pb.WhichOneof("optional_map_parallelization") is not None:
       self.map_parallelization = pb.map_parallelization
+    if pb.WhichOneof("optional_map_vectorization") is not None:
+      self.map_vectorization = pb.map_vectorization
     if pb.WhichOneof("optional_noop_elimination") is not None:
       self.noop_elimination = pb.noop_elimination
     if pb.WhichOneof("optional_parallel_batch") is not None:
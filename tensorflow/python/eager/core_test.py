@@ -403,6 +403,19 @@ class TFETest(test_util.TensorFlowTestCase):
     self.assertEqual(x.device, '/job:localhost/replica:0/task:0/device:CPU:1')
     self.assertEqual(y.device, '/job:localhost/replica:0/task:0/device:CPU:0')
 
+  @test_util.disable_tfrt('Multi CPU placement not supported yet.')
+  def testRepeatedOpWithChangingAttrsAndDevice(self):
+    # The fast path remembers the kernel of the last execution of an op, which
+    # must not be reused once the dtype or the device changes.
+    for i in range(6):
+      dtype = dtypes.float32 if i % 2 else dtypes.int32
+      device = 'cpu:%d' % (i // 2 % 2)
+      with ops.device(device):
+        x = array_ops.identity(constant_op.constant(i, dtype=dtype))
+      self.assertEqual(x.dtype, dtype)
+      self.assertEndsWith(x.device, device.upper())
+      self.assertAllEqual(x, i)
+
   @test_util.run_gpu_only
   def testShouldCopy(self):
     with ops.device('GPU:0'):
@@ -29,6 +29,7 @@ limitations under the License.
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/node_hash_map.h"
 #include "absl/debugging/leak_check.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
@@ -46,6 +47,7 @@ limitations under the License.
 #include "tensorflow/c/tf_datatype.h"
 #include "tensorflow/c/tf_status.h"
 #include "tensorflow/c/tf_status_helper.h"
+#include "tensorflow/core/common_runtime/eager/eager_operation.h"
 #include "tensorflow/core/framework/attr_value.pb.h"
 #include "tensorflow/core/framework/op_def.pb.h"
 #include "tensorflow/core/framework/tensor_shape.h"
@@ -126,6 +128,19 @@ TFE_Op* GetOp(TFE_Context* ctx, const char* op_or_function_name,
   return op.release();
 }
 
+// Returns the kernel cache hint of the `op_name` ops that this thread runs in
+// `ctx` from the fast path. Repeated executions of the same op, e.g. in a
+// Python loop, then skip the kernel lookup. The hints are not moved by later
+// insertions, so a hint stays valid while its op runs.
+tensorflow::EagerKernelCacheHint* GetKernelCacheHint(TFE_Context* ctx,
+                                                   const char* op_name) {
+  thread_local absl::node_hash_map<                                 // NOLINT
+      std::pair<TFE_Context*, std::string>,                         // NOLINT
+      tensorflow::EagerKernelCacheHint>                             // NOLINT
+      kernel_cache_hints;                                           // NOLINT
+  return &kernel_cache_hints[{ctx, op_name}];
+}
+
 void ReturnOp(TFE_Context* ctx, TFE_Op* op) {
   if (op) {
     tensorflow::unwrap(op)->Clear();
@@ -3759,6 +3774,10 @@ PyObject* TFE_Py_FastPathExecute_C(PyObject* args) {
   tensorflow::unwrap(op)->SetStackTrace(
       tensorflow::ManagedStackTrace(tensorflow::GetStackTrace(
           tensorflow::StackTrace::kStackTraceInitialSize)));
+  if (tensorflow::EagerOperation::classof(tensorflow::unwrap(op))) {
+    tensorflow::OperationFromInterface(tensorflow::unwrap(op))
+        ->SetKernelCacheHint(GetKernelCacheHint(ctx, op_name));
+  }
 
   const tensorflow::OpDef* op_def = tensorflow::unwrap(op)->OpDef();
   if (op_def == nullptr) return nullptr;
@@ -41,8 +41,9 @@ def all_reduce(t,
       independent subdivision should begin.  Use [0] if no subdivision should
       be done.
     communication_hint: preferred collective communication.  The implementation
-      may fall back to another mechanism.  Options include `auto`, `ring`, and
-      `nccl`.
+      may fall back to another mechanism.  Options include `auto`, `ring`,
+      `nccl` and `hierarchical`, which reduces within each task before
+      reducing across tasks.
     timeout: a float. If set to a non zero, set a completion timeout to detect
       staleness.  If the timer goes off, a DeadlineExceededError is raised.  The
       timeout value in seconds. This feature is experimental.
@@ -117,8 +118,9 @@ def all_reduce_v2(t,
     final_op: string naming the unary Op to be applied to each fully reduced
       value.  Can be 'Id' for no operation.
     communication_hint: preferred collective communication.  The implementation
-      may fall back to another mechanism.  Options include `auto`, `ring`, and
-      `nccl`.
+      may fall back to another mechanism.  Options include `auto`, `ring`,
+      `nccl` and `hierarchical`, which reduces within each task before
+      reducing across tasks.
     timeout: a float. If set to a non zero, set a completion timeout to detect
       staleness.  If the timer goes off, a DeadlineExceededError is raised.  The
       timeout value in seconds. This feature is experimental.
@@ -551,6 +553,66 @@ def all_to_all_v2(
   )
 
 
+def ragged_all_to_all(
+    t,
+    send_sizes,
+    recv_sizes,
+    group_size,
+    group_key,
+    instance_key,
+    communication_hint='auto',
+    timeout=0,
+    ordering_token=None,
+    name=None,
+):
+  """Exchanges chunks of rows of different sizes mutually.
+
+  Args:
+    t: a `tf.Tensor` with at least one dimension. Its rows are split into
+      chunks of `send_sizes` rows, and chunk `i` is sent to `rank i` within the
+      group.
+    send_sizes: an int64 tensor of shape `[group_size]` that sums to the first
+      dimension of `t`.
+    recv_sizes: an int64 tensor of shape `[group_size]`, the number of rows
+      received from each `rank`. It can be obtained by an `all_to_all_v2` of
+      `send_sizes`.
+    group_size: an int32 tensor, the total number of tensors to be mutually
+      exchanged. Each must reside on a different device. Should be a positive
+      integer.
+    group_key: an int32 tensor identifying the group of devices.
+    instance_key: an int32 tensor identifying the participating group of Ops.
+    communication_hint: preferred collective communication. The implementation
+      may fall back to another mechanism. Only `auto` is supported.
+    timeout: a float. If set to a non zero, set a completion timeout to detect
+      staleness. If the timer goes off, a DeadlineExceededError is raised. The
+      timeout value in seconds. This feature is experimental.
+    ordering_token: a resource tensor on the same device as the op to order the
+      collectives in a per-device manner by auto control dependency.
+    name: name of the Op.
+
+  Returns:
+    An Op implementing the distributed operation, which concatenates the rows
+    received from each `rank` in order.
+  """
+  if ordering_token is not None:
+    ordering_token = [ordering_token]
+  else:
+    ordering_token = []
+
+  return gen_collective_ops.collective_ragged_all_to_all(
+      t,
+      send_sizes=send_sizes,
+      recv_sizes=recv_sizes,
+      group_size=group_size,
+      group_key=group_key,
+      instance_key=instance_key,
+      communication_hint=communication_hint.lower(),
+      timeout_seconds=timeout,
+      ordering_token=ordering_token,
+      name=name,
+  )
+
+
 def all_to_all_v3(communicator, t, group_assignment=None, timeout_seconds=None):
   """Exchanges tensors mutually.
 
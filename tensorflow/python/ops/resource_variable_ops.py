@@ -898,6 +898,19 @@ class BaseResourceVariable(variables.Variable, core.Tensor):
     # specifies instead of the device where the variable is.
     return array_ops.identity(value)
 
+  def _enable_hogwild_mode(self):
+    """Puts this variable in Hogwild mode.
+
+    On CPU, training ops with `use_locking=False` then update the variable in
+    place without locking it, so concurrent updates race and may be lost.
+    Reads alias the buffer of the variable and observe later updates.
+
+    Returns:
+      The op that enables the mode, or None when executing eagerly.
+    """
+    return gen_resource_variable_ops._enable_variable_hogwild_mode(  # pylint: disable=protected-access
+        self.handle)
+
   def sparse_read(self, indices, name=None):
     """Reads the value of this variable sparsely, using `gather`."""
     with ops.name_scope("Gather" if name is None else name) as name:
@@ -506,6 +506,85 @@ class TrainingOpsTest(TensorFlowTestCase):
     thread1.join()
     thread2.join()
 
+  @test_util.run_v2_only
+  def testResourceApplyGradientDescentHogwildAndAssignRace(self):
+    dtype = np.float32
+    x = np.ones([1000], dtype=dtype)
+    var = variables.Variable(x)
+    var._enable_hogwild_mode()  # pylint: disable=protected-access
+    alpha = np.array(0.001, dtype=dtype)
+    delta = np.ones([1000], dtype=dtype)
+    num_iter = 1000
+
+    @def_function.function
+    def fn_assign():
+      ret = constant_op.constant(0, dtypes.int32)
+      for i in math_ops.range(num_iter):
+        op = var.assign(x)
+        with ops.control_dependencies([op]):
+          ret += i
+      return ret
+
+    @def_function.function
+    def fn_resource_apply_gradient_descent():
+      ret = constant_op.constant(0, dtypes.int32)
+      for i in math_ops.range(num_iter):
+        apply_op = gen_training_ops.resource_apply_gradient_descent(
+            var.handle, alpha, delta, use_locking=False)
+        with ops.control_dependencies([apply_op]):
+          ret += i
+      return ret
+
+    # The lock-free applies must stay memory safe while assignments replace
+    # the buffer of the variable.
+    thread1 = threading.Thread(target=lambda: self.evaluate(fn_assign()))
+    thread2 = threading.Thread(
+        target=lambda: self.evaluate(fn_resource_apply_gradient_descent()))
+    thread1.start()
+    thread2.start()
+    thread1.join()
+    thread2.join()
+    # Every element is either assigned or updated in place by whole steps.
+    value = self.evaluate(var)
+    self.assertTrue(np.all(value <= 1))
+    self.assertTrue(np.all(value >= 1 - num_iter * alpha - 1e-3))
+
+  def _sparseAdagradV2Numpy(self, var, accum, lr, epsilon, grad, indices):
+    var = np.copy(var)
+    accum = np.copy(accum)
+    for i, index in enumerate(indices):
+      accum[index] += grad[i] * grad[i]
+      var[index] -= lr * grad[i] / (np.sqrt(accum[index]) + epsilon)
+    return var, accum
+
+  @test_util.run_v2_only
+  def testGroupedResourceSparseApplyAdagradV2(self):
+    dtype = np.float64
+    lr = np.array(0.01, dtype=dtype)
+    epsilon = np.array(1e-8, dtype=dtype)
+    # The first variable has unique indices, the second one many duplicate
+    # indices into rows of a single element.
+    xs = [np.arange(30).reshape([3, 10]).astype(dtype),
+          np.arange(5).reshape([5, 1]).astype(dtype)]
+    ys = [np.arange(1, 31).reshape([3, 10]).astype(dtype),
+          np.ones([5, 1], dtype=dtype)]
+    grads = [np.arange(20).reshape([2, 10]).astype(dtype),
+             np.linspace(-1, 1, 10000).reshape([10000, 1]).astype(dtype)]
+    indices = [np.array([0, 2], dtype=np.int64),
+               np.arange(10000, dtype=np.int64) % 5]
+    var = [variables.Variable(x) for x in xs]
+    accum = [variables.Variable(y) for y in ys]
+    # pylint: disable=protected-access
+    gen_training_ops._grouped_resource_sparse_apply_adagrad_v2(
+        [v.handle for v in var], [a.handle for a in accum], lr, epsilon,
+        grads, indices)
+    # pylint: enable=protected-access
+    for i in range(2):
+      expected_var, expected_accum = self._sparseAdagradV2Numpy(
+          xs[i], ys[i], lr, epsilon, grads[i], indices[i])
+      self.assertAllClose(expected_var, self.evaluate(var[i]))
+      self.assertAllClose(expected_accum, self.evaluate(accum[i]))
+
 
 if __name__ == '__main__':
   googletest.main()
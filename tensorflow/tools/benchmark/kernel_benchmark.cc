@@ -0,0 +1,483 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/tools/benchmark/kernel_benchmark.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/str_split.h"
+#include "tensorflow/core/framework/cost_graph.pb.h"
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/op.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/register_types.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/graph/tensor_id.h"
+#include "tensorflow/core/lib/strings/proto_serialization.h"
+#include "tensorflow/core/platform/cpu_info.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/init_main.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/protobuf/config.pb.h"
+#include "tensorflow/core/protobuf/rewriter_config.pb.h"
+#include "tensorflow/core/public/session.h"
+#include "tensorflow/core/public/session_options.h"
+#include "tensorflow/core/util/command_line_flags.h"
+#include "tensorflow/core/util/reporter.h"
+#include "tsl/platform/errors.h"
+
+namespace tensorflow {
+namespace kernel_benchmark {
+
+namespace {
+
+// The name of the benchmarked node in the graphs built by TimeKernelCase().
+constexpr char kKernelNodeName[] = "kernel";
+
+// Ops which don't run a kernel worth timing on their own.
+bool IsSkippedOp(const string& op) {
+  static const auto* const kSkippedOps = new absl::flat_hash_set<string>({
+      "Const", "Placeholder", "PlaceholderWithDefault", "Identity",
+      "IdentityN", "NoOp", "Enter", "Exit", "Merge", "Switch", "LoopCond",
+      "NextIteration", "_Arg", "_Retval", "_DeviceArg", "_DeviceRetval",
+      "_Send", "_Recv", "_HostSend", "_HostRecv"});
+  return kSkippedOps->contains(op);
+}
+
+bool IsSupportedInputType(DataType dtype) {
+  return !IsRefType(dtype) && dtype != DT_RESOURCE && dtype != DT_VARIANT &&
+         dtype != DT_STRING;
+}
+
+bool GetFullyDefinedShape(const TensorShapeProto& proto, TensorShape* shape) {
+  const PartialTensorShape partial_shape(proto);
+  return partial_shape.IsFullyDefined() && partial_shape.AsTensorShape(shape);
+}
+
+// Sets the shape, and the value when it matters, of `input`, output `port` of
+// `producer`. Returns false if the shape isn't known.
+bool GetInputShape(const NodeDef& producer, int port,
+                   const CostGraphDef::Node* cost_node, KernelInput* input) {
+  const auto value = producer.attr().find("value");
+  if (producer.op() == "Const" && port == 0 && value != producer.attr().end()) {
+    Tensor tensor;
+    if (tensor.FromProto(value->second.tensor())) {
+      input->shape = tensor.shape();
+      if (DataTypeIsInteger(tensor.dtype()) || tensor.dtype() == DT_BOOL) {
+        input->has_value = true;
+        input->value = std::move(tensor);
+      }
+      return true;
+    }
+  }
+  if (cost_node != nullptr && port < cost_node->output_info_size() &&
+      GetFullyDefinedShape(cost_node->output_info(port).shape(),
+                           &input->shape)) {
+    return true;
+  }
+  const auto output_shapes = producer.attr().find("_output_shapes");
+  return output_shapes != producer.attr().end() &&
+         port < output_shapes->second.list().shape_size() &&
+         GetFullyDefinedShape(output_shapes->second.list().shape(port),
+                              &input->shape);
+}
+
+// Identifies the cases with the same op, attrs and inputs.
+string Signature(const KernelCase& kernel_case) {
+  string signature;
+  SerializeToStringDeterministic(kernel_case.node, &signature);
+  for (const KernelInput& input : kernel_case.inputs) {
+    absl::StrAppend(&signature, "|", DataTypeString(input.dtype),
+                    input.shape.DebugString());
+    if (input.has_value) {
+      TensorProto proto;
+      input.value.AsProtoTensorContent(&proto);
+      string value;
+      SerializeToStringDeterministic(proto, &value);
+      absl::StrAppend(&signature, "=", value);
+    }
+  }
+  return signature;
+}
+
+// Floating point inputs get random values, the others are zeros: zero is a
+// valid index and won't make the integer kernels fail, unlike random values.
+Tensor MakeInputTensor(const KernelInput& input) {
+  if (input.has_value) return input.value;
+  Tensor tensor(input.dtype, input.shape);
+  switch (input.dtype) {
+#define CASE(T)                   \
+  case DataTypeToEnum<T>::value:  \
+    tensor.flat<T>().setRandom(); \
+    break;
+    TF_CALL_FLOAT_TYPES(CASE)
+#undef CASE
+    default:
+      std::memset(tensor.data(), 0, tensor.TotalBytes());
+  }
+  return tensor;
+}
+
+template <typename T>
+absl::Status ReadBinaryOrTextProto(const string& filename, T* proto) {
+  Env* env = Env::Default();
+  if (ReadBinaryProto(env, filename, proto).ok()) {
+    return absl::OkStatus();
+  }
+  return ReadTextProto(env, filename, proto);
+}
+
+// The CPU features which select the code paths of the kernels, for grouping
+// the results of the same ISA.
+string SupportedCpuFeatures() {
+  using port::CPUFeature;
+  static constexpr std::pair<CPUFeature, const char*> kFeatures[] = {
+      {CPUFeature::SSE4_2, "sse4_2"},
+      {CPUFeature::AVX, "avx"},
+      {CPUFeature::AVX2, "avx2"},
+      {CPUFeature::FMA, "fma"},
+      {CPUFeature::AVX512F, "avx512f"},
+      {CPUFeature::AVX512_VNNI, "avx512_vnni"},
+      {CPUFeature::AVX512_BF16, "avx512_bf16"},
+      {CPUFeature::AVX512_FP16, "avx512_fp16"},
+      {CPUFeature::AVX_VNNI, "avx_vnni"},
+      {CPUFeature::AMX_INT8, "amx_int8"},
+      {CPUFeature::AMX_BF16, "amx_bf16"},
+      {CPUFeature::AMX_FP16, "amx_fp16"},
+  };
+  std::vector<string> supported;
+  for (const auto& [feature, name] : kFeatures) {
+    if (port::TestCPUFeature(feature)) supported.push_back(name);
+  }
+  return absl::StrJoin(supported, ",");
+}
+
+void RecordBenchmarkEntry(const string& output_prefix, const string& entry_name,
+                          const KernelCase& kernel_case, const string& device,
+                          const string& cpu_isa, const KernelTiming& timing) {
+  int64_t input_bytes = 0;
+  for (const KernelInput& input : kernel_case.inputs) {
+    input_bytes += input.shape.num_elements() * DataTypeSize(input.dtype);
+  }
+  const double throughput_mb_per_s =
+      timing.wall_time_s > 0.0
+          ? input_bytes * timing.iters / timing.wall_time_s / 1e6
+          : -1.0;
+
+  TestReporter reporter(output_prefix, entry_name);
+  TF_QCHECK_OK(reporter.Initialize());
+  TF_QCHECK_OK(reporter.Benchmark(timing.iters, -1.0, timing.wall_time_s,
+                                  throughput_mb_per_s));
+  TF_QCHECK_OK(reporter.SetProperty("op", kernel_case.node.op()));
+  TF_QCHECK_OK(reporter.SetProperty("device", device));
+  TF_QCHECK_OK(reporter.SetProperty("cpu_isa", cpu_isa));
+  TF_QCHECK_OK(reporter.SetProperty("cpu_features", SupportedCpuFeatures()));
+  TF_QCHECK_OK(reporter.SetProperty(
+      "instances", static_cast<double>(kernel_case.instances)));
+  TF_QCHECK_OK(reporter.Close());
+}
+
+}  // namespace
+
+string KernelCase::Name() const {
+  string name = node.op();
+  for (const KernelInput& input : inputs) {
+    absl::StrAppend(&name, "/", DataTypeString(input.dtype), "[",
+                    absl::StrJoin(input.shape.dim_sizes(), ","), "]");
+  }
+  return name;
+}
+
+absl::Status ExtractKernelCases(const GraphDef& graph,
+                                const CostGraphDef* cost_graph,
+                                std::vector<KernelCase>* cases) {
+  absl::flat_hash_map<string, const NodeDef*> nodes;
+  for (const NodeDef& node : graph.node()) {
+    nodes[node.name()] = &node;
+  }
+  absl::flat_hash_map<string, const CostGraphDef::Node*> cost_nodes;
+  if (cost_graph != nullptr) {
+    for (const CostGraphDef::Node& cost_node : cost_graph->node()) {
+      cost_nodes[cost_node.name()] = &cost_node;
+    }
+  }
+  // The cases already in `cases`, from other graphs of the same model, are
+  // merged with those of `graph`.
+  absl::flat_hash_map<string, size_t> case_indices;
+  for (size_t i = 0; i < cases->size(); ++i) {
+    case_indices[Signature((*cases)[i])] = i;
+  }
+
+  for (const NodeDef& node : graph.node()) {
+    if (IsSkippedOp(node.op())) continue;
+    // Calls of functions of the graph aren't registered ops.
+    const OpDef* op_def;
+    if (!OpRegistry::Global()->LookUpOpDef(node.op(), &op_def).ok()) continue;
+    // The kernels of stateful ops depend on state which a single op graph
+    // doesn't have, like variables, queues and iterators.
+    if (op_def->is_stateful()) continue;
+    DataTypeVector input_types;
+    if (!InputTypesForNode(node, *op_def, &input_types).ok()) continue;
+
+    KernelCase kernel_case;
+    bool known_inputs = true;
+    for (const string& input_name : node.input()) {
+      const TensorId id = ParseTensorName(input_name);
+      if (id.index() < 0) continue;  // A control input.
+      const size_t index = kernel_case.inputs.size();
+      const auto producer = nodes.find(id.node());
+      if (index >= input_types.size() ||
+          !IsSupportedInputType(input_types[index]) ||
+          producer == nodes.end()) {
+        known_inputs = false;
+        break;
+      }
+      const auto cost_node = cost_nodes.find(id.node());
+      KernelInput input;
+      input.dtype = input_types[index];
+      if (!GetInputShape(
+              *producer->second, id.index(),
+              cost_node == cost_nodes.end() ? nullptr : cost_node->second,
+              &input)) {
+        known_inputs = false;
+        break;
+      }
+      kernel_case.inputs.push_back(std::move(input));
+    }
+    if (!known_inputs || kernel_case.inputs.empty() ||
+        kernel_case.inputs.size() != input_types.size()) {
+      continue;
+    }
+
+    kernel_case.node = node;
+    kernel_case.node.clear_name();
+    kernel_case.node.clear_input();
+    kernel_case.node.clear_device();
+    kernel_case.node.mutable_attr()->erase("_output_shapes");
+    kernel_case.node.mutable_attr()->erase("_class");
+    const auto [it, inserted] =
+        case_indices.try_emplace(Signature(kernel_case), cases->size());
+    if (inserted) cases->push_back(std::move(kernel_case));
+    ++(*cases)[it->second].instances;
+  }
+  return absl::OkStatus();
+}
+
+absl::Status LoadKernelCasesFromRunMetadata(const string& filename,
+                                            std::vector<KernelCase>* cases) {
+  RunMetadata run_metadata;
+  TF_RETURN_IF_ERROR(ReadBinaryOrTextProto(filename, &run_metadata));
+  const CostGraphDef* cost_graph =
+      run_metadata.has_cost_graph() ? &run_metadata.cost_graph() : nullptr;
+  for (const GraphDef& graph : run_metadata.partition_graphs()) {
+    TF_RETURN_IF_ERROR(ExtractKernelCases(graph, cost_graph, cases));
+  }
+  for (const RunMetadata::FunctionGraphs& function_graphs :
+       run_metadata.function_graphs()) {
+    for (const GraphDef& graph : function_graphs.partition_graphs()) {
+      TF_RETURN_IF_ERROR(ExtractKernelCases(graph, cost_graph, cases));
+    }
+  }
+  return absl::OkStatus();
+}
+
+absl::Status LoadKernelCasesFromGraph(const string& filename,
+                                      std::vector<KernelCase>* cases) {
+  GraphDef graph;
+  TF_RETURN_IF_ERROR(ReadBinaryOrTextProto(filename, &graph));
+  return ExtractKernelCases(graph, nullptr, cases);
+}
+
+absl::Status TimeKernelCase(const KernelCase& kernel_case, const string& device,
+                            int num_threads, double min_time_s,
+                            int64_t max_iters, KernelTiming* timing) {
+  if (device != "cpu" && device != "gpu") {
+    return errors::InvalidArgument("Unknown device ", device);
+  }
+  const bool gpu = device == "gpu";
+  const string device_name = gpu ? "/device:GPU:0" : "/device:CPU:0";
+
+  GraphDef graph;
+  NodeDef kernel = kernel_case.node;
+  kernel.set_name(kKernelNodeName);
+  kernel.set_device(device_name);
+  TF_RETURN_IF_ERROR(FindKernelDef(DeviceType(gpu ? DEVICE_GPU : DEVICE_CPU),
+                                   kernel, nullptr, nullptr));
+  for (size_t i = 0; i < kernel_case.inputs.size(); ++i) {
+    const KernelInput& input = kernel_case.inputs[i];
+    NodeDef* constant = graph.add_node();
+    constant->set_name(absl::StrCat("input_", i));
+    constant->set_op("Const");
+    constant->set_device(device_name);
+    AddNodeAttr("dtype", input.dtype, constant);
+    MakeInputTensor(input).AsProtoTensorContent(
+        (*constant->mutable_attr())["value"].mutable_tensor());
+    kernel.add_input(constant->name());
+  }
+  *graph.add_node() = std::move(kernel);
+
+  SessionOptions options;
+  ConfigProto& config = options.config;
+  if (num_threads > 0) {
+    config.set_intra_op_parallelism_threads(num_threads);
+    config.set_inter_op_parallelism_threads(1);
+  }
+  (*config.mutable_device_count())["GPU"] = gpu ? 1 : 0;
+  // Fail rather than time the CPU kernel when there is no GPU.
+  config.set_allow_soft_placement(false);
+  // The inputs are constants: folding would remove the kernel from the graph.
+  OptimizerOptions* optimizer_options =
+      config.mutable_graph_options()->mutable_optimizer_options();
+  optimizer_options->set_opt_level(OptimizerOptions::L0);
+  optimizer_options->set_do_constant_folding(false);
+  config.mutable_graph_options()
+      ->mutable_rewrite_options()
+      ->set_disable_meta_optimizer(true);
+
+  std::unique_ptr<Session> session(NewSession(options));
+  if (session == nullptr) {
+    return errors::Internal("Failed to create a session");
+  }
+  TF_RETURN_IF_ERROR(session->Create(graph));
+  // The first run constructs the kernel and transfers the inputs.
+  TF_RETURN_IF_ERROR(session->Run({}, {}, {kKernelNodeName}, nullptr));
+
+  // The GPU streams are synchronized at the end of each run, so the wall time
+  // includes the execution of the kernel and not only its launch.
+  Env* env = Env::Default();
+  const int64_t start_us = env->NowMicros();
+  int64_t elapsed_us = 0;
+  timing->iters = 0;
+  while (timing->iters < max_iters &&
+         (timing->iters == 0 || elapsed_us < min_time_s * 1e6)) {
+    TF_RETURN_IF_ERROR(session->Run({}, {}, {kKernelNodeName}, nullptr));
+    ++timing->iters;
+    elapsed_us = env->NowMicros() - start_us;
+  }
+  timing->wall_time_s = elapsed_us / 1e6;
+  return session->Close();
+}
+
+int Main(int argc, char** argv) {
+  string graph = "";
+  string run_metadata = "";
+  string devices_string = "cpu";
+  string ops_string = "";
+  string cpu_isa = "";
+  int num_threads = -1;
+  float min_time = 0.5f;
+  int64_t max_iters = 1000;
+  string benchmark_name = "kernels";
+  string output_prefix = "";
+
+  std::vector<Flag> flag_list = {
+      Flag("graph", &graph, "GraphDef file with _output_shapes attrs"),
+      Flag("run_metadata", &run_metadata,
+           "RunMetadata file with partition graphs and a cost graph"),
+      Flag("devices", &devices_string, "devices to run the kernels on"),
+      Flag("ops", &ops_string, "ops to benchmark, all of them if empty"),
+      Flag("cpu_isa", &cpu_isa,
+           "highest ISA oneDNN may dispatch to (ONEDNN_MAX_CPU_ISA)"),
+      Flag("num_threads", &num_threads, "number of threads"),
+      Flag("min_time", &min_time, "minimum time to run each kernel"),
+      Flag("max_iters", &max_iters, "maximum runs of each kernel"),
+      Flag("benchmark_name", &benchmark_name, "benchmark name"),
+      Flag("output_prefix", &output_prefix, "benchmark output prefix"),
+  };
+  string usage = Flags::Usage(argv[0], flag_list);
+  const bool parse_result = Flags::Parse(&argc, argv, flag_list);
+
+  if (!parse_result || graph.empty() == run_metadata.empty()) {
+    LOG(ERROR) << usage;
+    return -1;
+  }
+
+  // oneDNN reads its ISA limit when it first dispatches, so it must be set
+  // before any session runs. The kernels of Eigen are selected at compile
+  // time: compare builds with different --copt=-march for those.
+  if (!cpu_isa.empty()) {
+    setenv("ONEDNN_MAX_CPU_ISA", cpu_isa.c_str(), /*overwrite=*/1);
+  }
+  const char* onednn_max_cpu_isa = std::getenv("ONEDNN_MAX_CPU_ISA");
+  const string isa_label =
+      onednn_max_cpu_isa != nullptr ? onednn_max_cpu_isa : "default";
+
+  port::InitMain(argv[0], &argc, &argv);
+  if (argc > 1) {
+    LOG(ERROR) << "Unknown argument " << argv[1] << "\n" << usage;
+    return -1;
+  }
+
+  std::vector<KernelCase> cases;
+  const absl::Status load_status =
+      graph.empty() ? LoadKernelCasesFromRunMetadata(run_metadata, &cases)
+                    : LoadKernelCasesFromGraph(graph, &cases);
+  if (!load_status.ok()) {
+    LOG(ERROR) << "Could not load the kernels: " << load_status;
+    return -1;
+  }
+  const std::vector<string> devices =
+      absl::StrSplit(devices_string, ',', absl::SkipEmpty());
+  const std::vector<string> ops_list =
+      absl::StrSplit(ops_string, ',', absl::SkipEmpty());
+  const absl::flat_hash_set<string> ops(ops_list.begin(), ops_list.end());
+  LOG(INFO) << "Found " << cases.size() << " distinct kernels";
+
+  for (const KernelCase& kernel_case : cases) {
+    if (!ops.empty() && !ops.contains(kernel_case.node.op())) continue;
+    for (const string& device : devices) {
+      KernelTiming timing;
+      const absl::Status status = TimeKernelCase(
+          kernel_case, device, num_threads, min_time, max_iters, &timing);
+      if (errors::IsNotFound(status)) continue;  // No kernel for the device.
+      const string entry_name = absl::StrCat(
+          benchmark_name, "/", kernel_case.Name(), "/", device, "/", isa_label);
+      if (!status.ok()) {
+        LOG(WARNING) << "Failed to run " << entry_name << ": " << status;
+        continue;
+      }
+      LOG(INFO) << entry_name << ": "
+                << timing.wall_time_s * 1e6 / timing.iters << " us over "
+                << timing.iters << " runs";
+      if (!output_prefix.empty()) {
+        RecordBenchmarkEntry(output_prefix, entry_name, kernel_case, device,
+                             isa_label, timing);
+      }
+    }
+  }
+  return 0;
+}
+
+}  // namespace kernel_benchmark
+}  // namespace tensorflow
@@ -0,0 +1,100 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_TOOLS_BENCHMARK_KERNEL_BENCHMARK_H_
+#define TENSORFLOW_TOOLS_BENCHMARK_KERNEL_BENCHMARK_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "tensorflow/core/framework/cost_graph.pb.h"
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/platform/types.h"
+
+// Benchmarks the kernels of the ops of a real graph, one op at a time, with
+// the shapes they ran with, so that kernel regressions are tracked on the
+// workloads which matter rather than on hand-picked shapes.
+
+namespace tensorflow {
+namespace kernel_benchmark {
+
+struct KernelInput {
+  DataType dtype;
+  TensorShape shape;
+  // Set when the input is produced by a Const of the graph and isn't a
+  // floating point tensor: shapes, axes, permutations and indices steer the
+  // kernel, so they keep their values. Other inputs are filled randomly.
+  bool has_value = false;
+  Tensor value;
+};
+
+// A node of the graph, without its name, inputs and device, with the types
+// and shapes of its inputs.
+struct KernelCase {
+  NodeDef node;
+  std::vector<KernelInput> inputs;
+  // The number of nodes of the graph with the same op, attrs and inputs.
+  int instances = 0;
+
+  // "<op>/<dtype>[<shape>]/..." with one entry per input.
+  string Name() const;
+};
+
+// Appends to `cases` the nodes of `graph` whose input shapes are known, once
+// per distinct case. The shape of an input is taken from the Const producing
+// it, from `cost_graph` (as in a RunMetadata of a step) if not null, or from
+// the "_output_shapes" attr of its producer. Nodes without data inputs, with
+// resource, variant, string or reference inputs, of stateful ops and of
+// control flow ops are skipped.
+absl::Status ExtractKernelCases(const GraphDef& graph,
+                                const CostGraphDef* cost_graph,
+                                std::vector<KernelCase>* cases);
+
+// Reads the cases of the partition graphs of a RunMetadata, with the shapes of
+// its cost graph, collected with RunOptions.output_partition_graphs and
+// FULL_TRACE. The file may be a binary or text proto.
+absl::Status LoadKernelCasesFromRunMetadata(const string& filename,
+                                            std::vector<KernelCase>* cases);
+
+// Reads the cases of a GraphDef with "_output_shapes" attrs, binary or text.
+absl::Status LoadKernelCasesFromGraph(const string& filename,
+                                      std::vector<KernelCase>* cases);
+
+struct KernelTiming {
+  int64_t iters = 0;
+  double wall_time_s = 0.0;
+};
+
+// Runs the kernel of `kernel_case` on `device`, "cpu" or "gpu", until it ran
+// for `min_time_s` or `max_iters` times, after a first run constructing the
+// kernel. The inputs are Const nodes and graph optimizations are disabled, so
+// that each run only executes the kernel. Returns NotFound if the op has no
+// kernel for the device.
+absl::Status TimeKernelCase(const KernelCase& kernel_case, const string& device,
+                            int num_threads, double min_time_s,
+                            int64_t max_iters, KernelTiming* timing);
+
+// Handles all setup and argument parsing.
+int Main(int argc, char** argv);
+
+}  // namespace kernel_benchmark
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_TOOLS_BENCHMARK_KERNEL_BENCHMARK_H_
@@ -0,0 +1,114 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/tools/benchmark/kernel_benchmark.h"
+
+#include <vector>
+
+#include "tensorflow/cc/framework/scope.h"
+#include "tensorflow/cc/ops/array_ops.h"
+#include "tensorflow/cc/ops/math_ops.h"
+#include "tensorflow/cc/ops/nn_ops.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/cost_graph.pb.h"
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace kernel_benchmark {
+namespace {
+
+TEST(KernelBenchmarkTest, ExtractsDistinctCasesWithConstShapes) {
+  Scope root = Scope::NewRootScope();
+  const Tensor a(DT_FLOAT, TensorShape({2, 3}));
+  const Tensor b(DT_FLOAT, TensorShape({3, 4}));
+  auto first = ops::MatMul(root, a, b);
+  auto second = ops::MatMul(root, a, b);
+  auto transposed =
+      ops::MatMul(root, b, a, ops::MatMul::TransposeA(true).TransposeB(true));
+  auto reshape = ops::Reshape(root, a, {3, 2});
+  GraphDef graph;
+  TF_ASSERT_OK(root.ToGraphDef(&graph));
+
+  std::vector<KernelCase> cases;
+  TF_ASSERT_OK(ExtractKernelCases(graph, nullptr, &cases));
+  ASSERT_EQ(cases.size(), 3);
+  EXPECT_EQ(cases[0].Name(), "MatMul/float[2,3]/float[3,4]");
+  EXPECT_EQ(cases[0].instances, 2);
+  EXPECT_FALSE(cases[0].inputs[0].has_value);
+  EXPECT_EQ(cases[1].Name(), "MatMul/float[3,4]/float[2,3]");
+  EXPECT_EQ(cases[1].instances, 1);
+  EXPECT_EQ(cases[2].Name(), "Reshape/float[2,3]/int32[2]");
+  ASSERT_TRUE(cases[2].inputs[1].has_value);
+  test::ExpectTensorEqual<int32>(cases[2].inputs[1].value,
+                                 test::AsTensor<int32>({3, 2}));
+}
+
+TEST(KernelBenchmarkTest, TakesShapesFromCostGraphAndOutputShapes) {
+  Scope root = Scope::NewRootScope();
+  auto placeholder = ops::Placeholder(root.WithOpName("input"), DT_FLOAT);
+  auto relu = ops::Relu(root, placeholder);
+  auto tanh = ops::Tanh(root, relu);
+  auto unknown = ops::Sigmoid(root, ops::Placeholder(root, DT_FLOAT));
+  GraphDef graph;
+  TF_ASSERT_OK(root.ToGraphDef(&graph));
+  for (NodeDef& node : *graph.mutable_node()) {
+    if (node.name() == relu.node()->name()) {
+      TensorShape({8, 16}).AsProto(
+          (*node.mutable_attr())["_output_shapes"].mutable_list()->add_shape());
+    }
+  }
+  CostGraphDef cost_graph;
+  CostGraphDef::Node* cost_node = cost_graph.add_node();
+  cost_node->set_name("input");
+  TensorShape({4, 32}).AsProto(cost_node->add_output_info()->mutable_shape());
+
+  std::vector<KernelCase> cases;
+  TF_ASSERT_OK(ExtractKernelCases(graph, &cost_graph, &cases));
+  ASSERT_EQ(cases.size(), 2);
+  EXPECT_EQ(cases[0].Name(), "Relu/float[4,32]");
+  EXPECT_EQ(cases[1].Name(), "Tanh/float[8,16]");
+}
+
+TEST(KernelBenchmarkTest, TimesCpuKernel) {
+  Scope root = Scope::NewRootScope();
+  auto matmul = ops::MatMul(root, Tensor(DT_FLOAT, TensorShape({16, 32})),
+                            Tensor(DT_FLOAT, TensorShape({32, 8})));
+  GraphDef graph;
+  TF_ASSERT_OK(root.ToGraphDef(&graph));
+  std::vector<KernelCase> cases;
+  TF_ASSERT_OK(ExtractKernelCases(graph, nullptr, &cases));
+  ASSERT_EQ(cases.size(), 1);
+
+  KernelTiming timing;
+  TF_ASSERT_OK(TimeKernelCase(cases[0], "cpu", /*num_threads=*/1,
+                              /*min_time_s=*/0.0, /*max_iters=*/3, &timing));
+  EXPECT_EQ(timing.iters, 1);
+  EXPECT_GE(timing.wall_time_s, 0.0);
+
+  TF_ASSERT_OK(TimeKernelCase(cases[0], "cpu", /*num_threads=*/1,
+                              /*min_time_s=*/1000.0, /*max_iters=*/3, &timing));
+  EXPECT_EQ(timing.iters, 3);
+}
+
+}  // namespace
+}  // namespace kernel_benchmark
+}  // namespace tensorflow
@@ -22,6 +22,7 @@ limitations under the License.
 
 #include "absl/log/log.h"
 #include "absl/status/status.h"
+#include "xla/tsl/profiler/backends/cpu/continuous_profiler.h"
 #include "xla/tsl/profiler/backends/cpu/host_tracer_utils.h"
 #include "xla/tsl/profiler/backends/cpu/threadpool_listener.h"
 #include "xla/tsl/profiler/backends/cpu/traceme_recorder.h"
@@ -90,6 +91,8 @@ absl::Status HostTracer::Start() {  // TENSORFLOW_STATUS_OK
   // start_timestamp_ns_ to prevent timestamp underflow in XPlane.
   // Therefore this have to be done before TraceMeRecorder::Start.
   start_timestamp_ns_ = tsl::profiler::GetCurrentTimeNanos();
+  // A continuous profiling sample would keep the recorder from starting.
+  tsl::profiler::ContinuousProfiler::Get()->AbortSample();
   recording_ =
       tsl::profiler::TraceMeRecorder::Start(host_trace_level_, filter_mask_);
   if (!recording_) {
@@ -90,6 +90,7 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.set_xla_cpu_enable_concurrency_optimized_scheduler(false);
   opts.set_xla_cpu_prefer_vector_width(256);
   opts.set_xla_cpu_max_isa("");
+  opts.set_xla_cpu_parallel_task_count_profile("");
 
   opts.set_xla_cpu_enable_fast_math(false);
   // Disable forms of fast math that have caused users problems in the past.
@@ -265,6 +266,7 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.set_xla_gpu_require_complete_aot_autotune_results(false);
 
   opts.set_xla_gpu_enable_host_memory_offloading(false);
+  opts.set_xla_gpu_host_memory_offloading_bandwidth(0);
 
   opts.set_xla_gpu_nccl_terminate_on_error(false);
 
@@ -917,6 +919,14 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       "use newer instructions. Available values: SSE4_2, AVX, AVX2, AVX512, "
       "AVX512_VNNI, AVX512_BF16, AMX, and AMX_FP16. (`AMX` will enable both "
       "`AMX_BF16` and `AMX_INT8` instructions.)"));
+  flag_list->push_back(tsl::Flag(
+      "xla_cpu_parallel_task_count_profile",
+      string_setter_for(
+          &DebugOptions::set_xla_cpu_parallel_task_count_profile),
+      debug_options->xla_cpu_parallel_task_count_profile(),
+      "Path of a ParallelTaskCountProfile with the parallel task counts "
+      "measured for HLOs on the target machine, used instead of the cost "
+      "model of the parallel task assignment."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_crash_on_verification_failures",
       bool_setter_for(
@@ -1942,6 +1952,14 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       bool_setter_for(&DebugOptions::set_xla_gpu_enable_host_memory_offloading),
       debug_options->xla_gpu_enable_host_memory_offloading(),
       "Whether to trigger host memory offloading on a device."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_host_memory_offloading_bandwidth",
+      int64_setter_for(
+          &DebugOptions::set_xla_gpu_host_memory_offloading_bandwidth),
+      debug_options->xla_gpu_host_memory_offloading_bandwidth(),
+      "Bandwidth in bytes/sec of the transfers between the device and the "
+      "host memory used by host memory offloading (e.g. the PCIe bandwidth). "
+      "Uses the device memory bandwidth if 0."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_nccl_terminate_on_error",
       bool_setter_for(&DebugOptions::set_xla_gpu_nccl_terminate_on_error),
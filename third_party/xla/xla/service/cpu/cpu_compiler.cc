@@ -852,8 +852,16 @@ absl::Status CpuCompiler::RunHloPassesAfterLayoutAssn(
     // and thread synchronization dependencies which would likely increase
     // binary size (and most AOT applications are single-threaded).
     // TODO(b/29630486) Support multi-threaded AOT.
+    ParallelTaskCountProfile parallel_task_count_profile;
+    const std::string& profile_path =
+        module->config().debug_options().xla_cpu_parallel_task_count_profile();
+    if (!profile_path.empty()) {
+      TF_RETURN_IF_ERROR(tsl::ReadTextOrBinaryProto(
+          tsl::Env::Default(), profile_path, &parallel_task_count_profile));
+    }
     pipeline.AddPass<ParallelTaskAssigner>(
-        max_parallelism, ShapeSizeBytesFunction(), target_machine_features);
+        max_parallelism, ShapeSizeBytesFunction(), target_machine_features,
+        std::move(parallel_task_count_profile));
   }
   // Copy insertion should be performed immediately before IR emission to
   // avoid inserting unnecessary copies (later pass adds an instruction which
@@ -39,6 +39,7 @@ limitations under the License.
 #include "xla/service/llvm_ir/dynamic_update_slice_util.h"
 #include "xla/util.h"
 #include "tsl/platform/cpu_info.h"
+#include "tsl/platform/fingerprint.h"
 #include "tsl/platform/logging.h"  // IWYU pragma: keep
 #include "tsl/platform/status.h"
 
@@ -124,12 +125,25 @@ class DefaultCostModel : public ParallelCostModel {
   const std::unique_ptr<HloCostAnalysis> cost_analysis_;
 };
 
+uint64_t ParallelTaskCountProfileFingerprint(
+    const HloInstruction& instruction) {
+  return tsl::Fingerprint64(
+      instruction.ToString(HloPrintOptions::Fingerprint()));
+}
+
 ParallelTaskAssignment::ParallelTaskAssignment(
     const int64_t max_parallelism,
     const HloCostAnalysis::ShapeSizeFunction& shape_size, HloModule* module,
-    const TargetMachineFeatures* target_machine_features)
-    : target_machine_features_(*target_machine_features) {
+    const TargetMachineFeatures* target_machine_features,
+    const ParallelTaskCountProfile* profile)
+    : max_parallelism_(max_parallelism),
+      target_machine_features_(*target_machine_features) {
   VLOG(1) << "ParallelTaskAssignment max_parallelism: " << max_parallelism;
+  if (profile != nullptr) {
+    for (const ParallelTaskCountProfile::Entry& entry : profile->entries()) {
+      measured_task_counts_[entry.fingerprint()] = entry.parallel_task_count();
+    }
+  }
   // Run cost analysis on 'module'.
   auto cost_analysis = std::make_unique<HloCostAnalysis>(shape_size);
   HloComputation* computation = module->entry_computation();
@@ -182,6 +196,16 @@ int64_t ParallelTaskAssignment::GetTargetParallelTaskCount(
       (opcode == HloOpcode::kConvolution &&
        !PotentiallyImplementedAsEigenConvolution(*instruction,
                                                  target_machine_features_))) {
+    // Prefer the measured parallel task count, if any.
+    if (!measured_task_counts_.empty()) {
+      auto it = measured_task_counts_.find(
+          ParallelTaskCountProfileFingerprint(*instruction));
+      if (it != measured_task_counts_.end()) {
+        VLOG(2) << "Using measured parallel task count " << it->second
+                << " for " << instruction->name();
+        return std::min(max_parallelism_, std::max(int64_t{1}, it->second));
+      }
+    }
     // Consult 'cost_model_' to compute target parallel task count.
     return cost_model_->GetParallelTaskCount(instruction);
   }
@@ -273,9 +297,9 @@ bool ParallelTaskAssigner::AssignParallelTasksHelper(
 
 void ParallelTaskAssigner::ComputeTargetParallelTasks(
     HloModule* module, HloToParallelTasks* hlo_to_parallel_tasks) {
-  ParallelTaskAssignment parallel_task_assignment(max_parallelism_,
-                                                  shape_size_function_, module,
-                                                  &target_machine_features_);
+  ParallelTaskAssignment parallel_task_assignment(
+      max_parallelism_, shape_size_function_, module, &target_machine_features_,
+      &profile_);
 
   // Compute parallel task counts for all instructions in 'module'.
   for (auto* computation : module->MakeNonfusionComputations()) {
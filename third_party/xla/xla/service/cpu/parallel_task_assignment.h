@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <cstdint>
 #include <memory>
+#include <utility>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
@@ -28,6 +29,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/pass/hlo_pass_interface.h"
+#include "xla/service/cpu/backend_config.pb.h"
 #include "xla/service/hlo_cost_analysis.h"
 #include "xla/util.h"
 
@@ -41,6 +43,12 @@ class ParallelCostModel {
   virtual int64_t GetParallelTaskCount(HloInstruction* instruction) = 0;
 };
 
+// Returns the fingerprint identifying 'instruction' in a
+// ParallelTaskCountProfile. It only depends on the canonical text of the
+// instruction (and of its fused computation), so it is stable across
+// compilations of the same HLO.
+uint64_t ParallelTaskCountProfileFingerprint(const HloInstruction& instruction);
+
 // ParallelTaskAssignment computes parallel task counts for HLOs in 'module'.
 class ParallelTaskAssignment {
  public:
@@ -48,18 +56,24 @@ class ParallelTaskAssignment {
   // 'shape_size': shape size function used by HloCostAnalysis during parallel
   //               task assignment.
   // 'module': the containing HloModule.
+  // 'profile': if non-null, the measured parallel task counts used instead of
+  //            the cost model for the instructions it covers.
   ParallelTaskAssignment(int64_t max_parallelism,
                          const HloCostAnalysis::ShapeSizeFunction& shape_size,
                          HloModule* module,
-                         const TargetMachineFeatures* target_machine_features);
+                         const TargetMachineFeatures* target_machine_features,
+                         const ParallelTaskCountProfile* profile = nullptr);
   ~ParallelTaskAssignment() {}
 
   // Computes and returns the target parallel task count for 'instruction'.
   int64_t GetTargetParallelTaskCount(HloInstruction* instruction);
 
  private:
+  const int64_t max_parallelism_;
   std::unique_ptr<ParallelCostModel> cost_model_;
   const TargetMachineFeatures& target_machine_features_;
+  // Measured parallel task counts by ParallelTaskCountProfileFingerprint().
+  absl::flat_hash_map<uint64_t, int64_t> measured_task_counts_;
 };
 
 // ParallelTaskAssigner computes target parallel task counts for all HLOs
@@ -75,12 +89,16 @@ class ParallelTaskAssigner : public HloModulePass {
   // 'max_parallelism': the maximum parallel task count per instruction.
   // 'shape_size': shape size function used by HloCostAnalysis during parallel
   //               task assignment.
+  // 'profile': the measured parallel task counts used instead of the cost
+  //            model for the instructions it covers.
   ParallelTaskAssigner(const int64_t max_parallelism,
                        const HloCostAnalysis::ShapeSizeFunction& shape_size,
-                       const TargetMachineFeatures* target_machine_features)
+                       const TargetMachineFeatures* target_machine_features,
+                       ParallelTaskCountProfile profile = {})
       : max_parallelism_(max_parallelism),
         shape_size_function_(shape_size),
-        target_machine_features_(*target_machine_features) {}
+        target_machine_features_(*target_machine_features),
+        profile_(std::move(profile)) {}
   ~ParallelTaskAssigner() override {}
 
   absl::string_view name() const override {
@@ -116,6 +134,7 @@ class ParallelTaskAssigner : public HloModulePass {
   int64_t max_parallelism_;
   HloCostAnalysis::ShapeSizeFunction shape_size_function_;
   const TargetMachineFeatures& target_machine_features_;
+  const ParallelTaskCountProfile profile_;
 };
 
 }  // namespace cpu
@@ -18,6 +18,7 @@ limitations under the License.
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "absl/status/statusor.h"
 #include "xla/backends/cpu/codegen/target_machine_features.h"
@@ -47,9 +48,11 @@ class ParallelTaskAssignmentTest : public HloTestBase {
           return cpu::TargetMachineFeatures::kEigenExpectedTensorAlignment;
         }) {}
 
-  absl::StatusOr<bool> RunParallelTaskAssigner(HloModule* module) {
+  absl::StatusOr<bool> RunParallelTaskAssigner(
+      HloModule* module, cpu::ParallelTaskCountProfile profile = {}) {
     return cpu::ParallelTaskAssigner(max_parallelism_, shape_size_func_,
-                                     &target_machine_features_)
+                                     &target_machine_features_,
+                                     std::move(profile))
         .Run(module);
   }
 
@@ -86,6 +89,41 @@ TEST_F(ParallelTaskAssignmentTest, ReduceWindowParallelized) {
   EXPECT_EQ(backend_config.outer_dimension_partitions(0), 2);
 }
 
+TEST_F(ParallelTaskAssignmentTest, MeasuredTaskCountOverridesCostModel) {
+  constexpr char hlo_string[] = R"(
+  HloModule m
+    add {
+      lhs = f32[] parameter(0)
+      rhs = f32[] parameter(1)
+      ROOT add = f32[] add(lhs, rhs)
+    }
+
+    ENTRY e {
+      p0 = f32[512,256] parameter(0)
+      p1 = f32[] parameter(1)
+      ROOT reduce-window = f32[16,256] reduce-window(p0, p1),
+          window={size=32x1 stride=32x1}, to_apply=add
+    }
+  )";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> m,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  cpu::ParallelTaskCountProfile profile;
+  auto* entry = profile.add_entries();
+  entry->set_fingerprint(cpu::ParallelTaskCountProfileFingerprint(
+      *FindInstruction(m.get(), HloOpcode::kReduceWindow)));
+  entry->set_parallel_task_count(4);
+  TF_ASSERT_OK_AND_ASSIGN(bool changed,
+                          RunParallelTaskAssigner(m.get(), profile));
+  EXPECT_TRUE(changed);
+
+  auto* reduce_window = FindInstruction(m.get(), HloOpcode::kReduceWindow);
+  TF_ASSERT_OK_AND_ASSIGN(auto backend_config,
+                          reduce_window->backend_config<cpu::BackendConfig>());
+  EXPECT_EQ(backend_config.outer_dimension_partitions_size(), 1);
+  EXPECT_EQ(backend_config.outer_dimension_partitions(0), 4);
+}
+
 TEST_F(ParallelTaskAssignmentTest, DotOperationNotParallelized) {
   const std::string hlo_string = R"(
     HloModule TestTaskParallel_Dot
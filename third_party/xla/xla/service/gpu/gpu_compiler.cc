@@ -2552,13 +2552,32 @@ absl::Status GpuCompiler::RunPreSchedulingPasses(
   return pipeline.Run(module).status();
 }
 
+// Returns the configuration of host memory offloading in rematerialization,
+// or std::nullopt if it's disabled.
+std::optional<HloRematerialization::HostMemoryOffloadConfig>
+GetHostMemoryOffloadConfig(const HloModule& module,
+                           const se::DeviceDescription& gpu_device_info) {
+  const DebugOptions& debug_options = module.config().debug_options();
+  if (!debug_options.xla_gpu_enable_host_memory_offloading()) {
+    return std::nullopt;
+  }
+  // Transfers to and from the host go through the host link, which is usually
+  // much slower than the device memory.
+  const int64_t bandwidth =
+      debug_options.xla_gpu_host_memory_offloading_bandwidth() > 0
+          ? debug_options.xla_gpu_host_memory_offloading_bandwidth()
+          : gpu_device_info.memory_bandwidth();
+  return HloRematerialization::HostMemoryOffloadConfig(
+      /*host_memory_space=*/static_cast<int64_t>(se::MemoryType::kHost),
+      /*bandwidth_to_host_bytes_per_second=*/bandwidth,
+      /*bandwidth_from_host_bytes_per_second=*/bandwidth);
+}
+
 HloCostAnalysis::Options CreateHloAnalysisOpts(
     const HloModule& module, const se::DeviceDescription& gpu_device_info,
     ShapeSizeFn shape_size_fn) {
   HloCostAnalysis::Options hlo_cost_analysis_options;
   hlo_cost_analysis_options.shape_size = shape_size_fn;
-  std::optional<HloRematerialization::HostMemoryOffloadConfig>
-      offloading_config = std::nullopt;
   if (module.config().debug_options().xla_gpu_enable_host_memory_offloading()) {
     constexpr float kGiga = 1e+9;
     // Fused multiply-add means that these two instructions are computed as
@@ -2567,17 +2586,8 @@ HloCostAnalysis::Options CreateHloAnalysisOpts(
     float flops_per_sec = gpu_device_info.core_count() *
                           gpu_device_info.fpus_per_core() *
                           gpu_device_info.clock_rate_ghz() * kGiga * kFma;
-    int64_t host_memory_space_color =
-        static_cast<int64_t>(se::MemoryType::kHost);
     hlo_cost_analysis_options.set_flops_per_second(flops_per_sec);
     hlo_cost_analysis_options.set_transcendentals_per_second(flops_per_sec);
-    offloading_config =
-        std::make_optional<HloRematerialization::HostMemoryOffloadConfig>(
-            /*host_memory_space=*/host_memory_space_color,
-            /*bandwidth_to_host_bytes_per_second=*/
-            gpu_device_info.memory_bandwidth(),
-            /*bandwidth_from_host_bytes_per_second=*/
-            gpu_device_info.memory_bandwidth());
   }
   return hlo_cost_analysis_options;
 }
@@ -2588,18 +2598,7 @@ HloRematerialization::Options CreateRematOpts(
   bool enable_offloading =
       module.config().debug_options().xla_gpu_enable_host_memory_offloading();
   std::optional<HloRematerialization::HostMemoryOffloadConfig>
-      offloading_config = std::nullopt;
-  if (enable_offloading) {
-    int64_t host_memory_space_color =
-        static_cast<int64_t>(se::MemoryType::kHost);
-    offloading_config =
-        std::make_optional<HloRematerialization::HostMemoryOffloadConfig>(
-            /*host_memory_space=*/host_memory_space_color,
-            /*bandwidth_to_host_bytes_per_second=*/
-            gpu_device_info.memory_bandwidth(),
-            /*bandwidth_from_host_bytes_per_second=*/
-            gpu_device_info.memory_bandwidth());
-  }
+      offloading_config = GetHostMemoryOffloadConfig(module, gpu_device_info);
   HloRematerialization::RematerializationModeConfig
       rematerialization_mode_config(/*recompute=*/true, /*compress=*/true,
                                     /*host_offload=*/enable_offloading);
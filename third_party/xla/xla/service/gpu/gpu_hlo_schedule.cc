@@ -267,29 +267,49 @@ SchedulerConfig GetSchedulerConfig(int64_t memory_limit,
 tensorflow::profiler::ProfiledInstructionsProto GetProfileForFingerprint(
     tensorflow::profiler::ProfiledInstructionsProto& profile,
     const std::string& fingerprint) {
+  // Returns the name of the instruction in the module with `fingerprint`, or
+  // std::nullopt if `name` is prefixed with the fingerprint of another module.
+  auto strip_fingerprint =
+      [&fingerprint](absl::string_view name) -> std::optional<std::string> {
+    absl::string_view sep = "::";
+    if (!absl::StrContains(name, sep)) {
+      return std::string(name);
+    }
+    std::vector<std::string> split_names = absl::StrSplit(name, sep);
+    if (split_names.size() != 2 || split_names[0] != fingerprint) {
+      return std::nullopt;
+    }
+    return split_names[1];
+  };
+
   tensorflow::profiler::ProfiledInstructionsProto result;
+  for (const auto& latency : profile.latencies()) {
+    std::optional<std::string> source = strip_fingerprint(latency.source());
+    std::optional<std::string> target = strip_fingerprint(latency.target());
+    if (!source.has_value() || !target.has_value()) {
+      continue;
+    }
+    auto* new_latency = result.add_latencies();
+    new_latency->set_source(*std::move(source));
+    new_latency->set_target(*std::move(target));
+    new_latency->set_latency_us(latency.latency_us());
+  }
+
   bool merge_remat_clones = false;
   for (const auto& cost : profile.costs()) {
-    absl::string_view cost_name = cost.name();
-    std::string new_cost_name = cost.name();
-    absl::string_view cost_sep = "::";
-    if (absl::StrContains(cost_name, cost_sep)) {
-      std::vector<std::string> split_names =
-          absl::StrSplit(cost_name, cost_sep);
-      if (split_names.size() != 2 || split_names[0] != fingerprint) {
-        continue;
-      }
-      new_cost_name = split_names[1];
+    std::optional<std::string> new_cost_name = strip_fingerprint(cost.name());
+    if (!new_cost_name.has_value()) {
+      continue;
     }
 
     // Check if we see instructions that have ".rematX" suffix. These are clones
     // of original instructions created by HLO rematerialization pass. We will
     // average the costs of the remat clones and the original instruction and
     // use that as the new cost of the original one.
-    merge_remat_clones |= absl::StrContains(new_cost_name, ".remat");
+    merge_remat_clones |= absl::StrContains(*new_cost_name, ".remat");
     auto* new_cost = result.add_costs();
     new_cost->set_cost_us(cost.cost_us());
-    new_cost->set_name(new_cost_name);
+    new_cost->set_name(*std::move(new_cost_name));
   }
 
   if (!merge_remat_clones) {
@@ -322,6 +342,7 @@ tensorflow::profiler::ProfiledInstructionsProto GetProfileForFingerprint(
   }
 
   tensorflow::profiler::ProfiledInstructionsProto merged_result;
+  *merged_result.mutable_latencies() = result.latencies();
   for (const auto& cost : costs) {
     auto* new_cost = merged_result.add_costs();
     double average = cost.second.first / cost.second.second;
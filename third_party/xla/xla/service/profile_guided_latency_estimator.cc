@@ -16,7 +16,9 @@ limitations under the License.
 #include "xla/service/profile_guided_latency_estimator.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "absl/container/flat_hash_map.h"
@@ -214,15 +216,34 @@ ProfileGuidedLatencyEstimator::ProfileGuidedLatencyEstimator(
       latency_estimator_(std::move(latency_estimator)),
       aggregator_(std::move(aggregator)) {
   const int cycles_per_microsecond = latency_estimator_->CyclesPerMicrosecond();
+  // A profile may hold several samples of the same cost or latency, e.g. when
+  // it concatenates the profiles of several runs: use their average.
+  absl::flat_hash_map<std::string, std::pair<double, int64_t>> costs;
   for (const auto& instr_cost : proto.costs()) {
-    instr_map_[instr_cost.name()] =
-        ProfileInfo{instr_cost.cost_us() * cycles_per_microsecond};
+    std::pair<double, int64_t>& samples = costs[instr_cost.name()];
+    samples.first += instr_cost.cost_us();
+    ++samples.second;
   }
+  for (const auto& [name, samples] : costs) {
+    instr_map_[name] =
+        ProfileInfo{samples.first / samples.second * cycles_per_microsecond};
+  }
+  absl::flat_hash_map<std::pair<std::string, std::string>,
+                      std::pair<double, int64_t>>
+      latencies;
   for (const auto& latency : proto.latencies()) {
-    auto it = instr_map_.insert(std::make_pair(latency.source(), ProfileInfo{}))
+    std::pair<double, int64_t>& samples =
+        latencies[{latency.source(), latency.target()}];
+    samples.first += latency.latency_us();
+    ++samples.second;
+  }
+  for (const auto& [source_and_target, samples] : latencies) {
+    auto it = instr_map_
+                  .insert(std::make_pair(source_and_target.first,
+                                         ProfileInfo{}))
                   .first;
-    it->second.latencies[latency.target()] =
-        latency.latency_us() * cycles_per_microsecond;
+    it->second.latencies[source_and_target.second] =
+        samples.first / samples.second * cycles_per_microsecond;
   }
 }
 
@@ -466,6 +466,15 @@ bool GpuCudaMallocAsyncAllocator::ClearStats() {
   return true;
 }
 
+void GpuCudaMallocAsyncAllocator::SetReleaseThreshold(
+    uint64_t release_threshold) {
+  if (auto status = cuMemPoolSetAttribute(cuda_state_->pool,
+                                          CU_MEMPOOL_ATTR_RELEASE_THRESHOLD,
+                                          &release_threshold))
+    LOG(FATAL) <<  // Crash OK.
+        "Failed to set CUDA pool attribute: " << cuda::ToStatus(status);
+}
+
 void GpuCudaMallocAsyncAllocator::SetStreamAndPreallocateMemory(void* stream) {
   auto new_cuda_stream = static_cast<CUstream>(stream);
   // We don't need to re-set the CUDA stream if this is the same stream
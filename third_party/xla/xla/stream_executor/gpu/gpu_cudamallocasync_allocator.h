@@ -94,6 +94,10 @@ class GpuCudaMallocAsyncAllocator : public tsl::Allocator {
 
   void SetStreamAndPreallocateMemory(void* stream) override;
 
+  // Sets the release threshold of the memory pool, which may be shared with
+  // other allocators. The bytes_limit of this allocator is unchanged.
+  void SetReleaseThreshold(uint64_t release_threshold);
+
   static int GetInstantiatedCountTestOnly() { return number_instantiated_; }
 
   tsl::AllocatorMemoryType GetMemoryType() const override {
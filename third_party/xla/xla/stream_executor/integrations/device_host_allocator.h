@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef XLA_STREAM_EXECUTOR_INTEGRATIONS_DEVICE_HOST_ALLOCATOR_H_
 #define XLA_STREAM_EXECUTOR_INTEGRATIONS_DEVICE_HOST_ALLOCATOR_H_
 
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 #include <utility>
@@ -23,17 +24,23 @@ limitations under the License.
 
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/synchronization/mutex.h"
 #include "xla/stream_executor/memory_allocation.h"
 #include "xla/stream_executor/stream_executor.h"
 #include "xla/tsl/framework/allocator.h"
 #include "tsl/platform/logging.h"
+#include "tsl/platform/numa.h"
 #include "tsl/profiler/lib/traceme.h"
 
 namespace stream_executor {
 
 // Allocator for pinned CPU RAM that is made known to a StreamExecutor-based
 // device for the purpose of efficient DMA with the device.
+//
+// If NUMA is enabled and `numa_node` is not `tsl::port::kNUMANoAffinity`, the
+// memory is allocated on that node and then registered with the device, so
+// that DMA does not cross the interconnect between nodes.
 class DeviceHostAllocator : public tsl::SubAllocator {
  public:
   // Note: stream_exec cannot be null.
@@ -56,6 +63,12 @@ class DeviceHostAllocator : public tsl::SubAllocator {
     *bytes_received = num_bytes;
 
     if (num_bytes > 0) {
+      ptr = NumaAlloc(alignment, num_bytes);
+      if (ptr != nullptr) {
+        VisitAlloc(ptr, numa_node_, num_bytes);
+        return ptr;
+      }
+
       auto allocation = stream_exec_->HostMemoryAllocate(num_bytes);
       if (!allocation.ok()) {
         LOG(WARNING) << "could not allocate pinned host memory of size: "
@@ -78,8 +91,15 @@ class DeviceHostAllocator : public tsl::SubAllocator {
 
     if (ptr != nullptr) {
       VisitFree(ptr, numa_node_, num_bytes);
-      absl::MutexLock lock(&mutex_);
-      allocs_.erase(ptr);
+      {
+        absl::MutexLock lock(&mutex_);
+        if (!numa_allocs_.erase(ptr)) {
+          allocs_.erase(ptr);
+          return;
+        }
+      }
+      stream_exec_->HostMemoryUnregister(ptr);
+      tsl::port::NUMAFree(ptr, num_bytes);
     }
   }
 
@@ -90,6 +110,28 @@ class DeviceHostAllocator : public tsl::SubAllocator {
   }
 
  private:
+  // Returns memory of the NUMA node of the allocator registered with the
+  // device, or nullptr if that is not possible.
+  void* NumaAlloc(size_t alignment, size_t num_bytes) {
+    if (numa_node_ == tsl::port::kNUMANoAffinity ||
+        !tsl::port::NUMAEnabled()) {
+      return nullptr;
+    }
+    void* ptr = tsl::port::NUMAMalloc(
+        numa_node_, num_bytes,
+        std::max<int>(alignment, tsl::Allocator::kAllocatorAlignment));
+    if (ptr == nullptr) return nullptr;
+    if (!stream_exec_->HostMemoryRegister(ptr, num_bytes)) {
+      VLOG(1) << "could not register host memory of NUMA node " << numa_node_
+              << " with the device; using the default pinned allocator.";
+      tsl::port::NUMAFree(ptr, num_bytes);
+      return nullptr;
+    }
+    absl::MutexLock lock(&mutex_);
+    numa_allocs_.insert(ptr);
+    return ptr;
+  }
+
   StreamExecutor* stream_exec_;  // not owned, non-null
   const int numa_node_;
 
@@ -99,6 +141,8 @@ class DeviceHostAllocator : public tsl::SubAllocator {
   absl::Mutex mutex_;
   absl::flat_hash_map<void*, std::unique_ptr<MemoryAllocation>> allocs_
       ABSL_GUARDED_BY(mutex_);
+  // The allocations made by `NumaAlloc()`.
+  absl::flat_hash_set<void*> numa_allocs_ ABSL_GUARDED_BY(mutex_);
 };
 
 }  // namespace stream_executor
@@ -188,7 +188,7 @@ class CoordinationServiceStandaloneImpl : public CoordinationServiceInterface {
   // Starts a thread to check staleness.
   void StartCheckStaleness();
   void Stop() ABSL_EXCLUSIVE_LOCKS_REQUIRED(state_mu_);
-  bool ServiceHasStopped() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(state_mu_);
+  bool ServiceHasStopped() const ABSL_SHARED_LOCKS_REQUIRED(state_mu_);
   // Report error from a task to all other connected tasks if the task is not
   // recoverable.
   // Note: SetTaskError() must be called before propagating its error.
@@ -420,6 +420,12 @@ class CoordinationServiceStandaloneImpl : public CoordinationServiceInterface {
     bool recoverable_ = false;
   };
 
+  // Returns an error if the service must not record heartbeats from
+  // `task_name`, and otherwise sets `task_state` to the state of the task.
+  absl::Status CheckHeartbeatSource(const std::string& task_name,
+                                    TaskState** task_state)
+      ABSL_SHARED_LOCKS_REQUIRED(state_mu_);
+
   std::unique_ptr<CoordinationClientCache> client_cache_;
   Env& env_;
   const uint64_t service_incarnation_ = random::New64();
@@ -1095,7 +1101,32 @@ absl::Status CoordinationServiceStandaloneImpl::RecordHeartbeat(
     const CoordinatedTask& task, uint64_t incarnation) {
   const std::string task_name = GetTaskName(task);
   absl::Status s = absl::OkStatus();
+  {
+    // Recording a heartbeat only updates the heartbeat time of the task, which
+    // has its own mutex. A shared lock keeps the heartbeats of large jobs from
+    // serializing with each other and with barriers.
+    absl::ReaderMutexLock l(&state_mu_);
+    TaskState* task_state = nullptr;
+    s = CheckHeartbeatSource(task_name, &task_state);
+    if (!s.ok()) return s;
+    VLOG(10) << "Record heartbeat from task: " << task_name
+             << "at incarnation: " << incarnation << "at " << absl::Now();
+    s = task_state->RecordHeartbeat(incarnation);
+    if (s.ok()) return s;
+  }
+  // Set and propagate the heartbeat error, unless the state changed while the
+  // lock was released.
   absl::MutexLock l(&state_mu_);
+  if (ServiceHasStopped() || !cluster_state_[task_name]->GetStatus().ok()) {
+    return s;
+  }
+  SetTaskError(task_name, s);
+  PropagateError(s, {task});
+  return s;
+}
+
+absl::Status CoordinationServiceStandaloneImpl::CheckHeartbeatSource(
+    const std::string& task_name, TaskState** task_state) {
   if (ServiceHasStopped()) {
     return MakeCoordinationError(absl::InternalError(absl::StrCat(
         "Coordination service has stopped. RecordHeartbeat() from task: ",
@@ -1110,13 +1141,13 @@ absl::Status CoordinationServiceStandaloneImpl::RecordHeartbeat(
         absl::StrCat("Unexpected heartbeat request from task: ", task_name,
                      ". This usually implies a configuration error.")));
   }
-  const std::unique_ptr<TaskState>& task_state = cluster_state_[task_name];
-  if (!task_state->GetStatus().ok()) {
+  *task_state = cluster_state_.find(task_name)->second.get();
+  if (!(*task_state)->GetStatus().ok()) {
     return MakeCoordinationError(absl::AbortedError(absl::StrCat(
         "Unexpected heartbeat request from an already-in-error task: ",
         task_name,
-        " with existing error: ", task_state->GetStatus().ToString())));
-  } else if (task_state->IsDisconnectedBeyondGracePeriod()) {
+        " with existing error: ", (*task_state)->GetStatus().ToString())));
+  } else if ((*task_state)->IsDisconnectedBeyondGracePeriod()) {
     // We accept heartbeats for a short grace period to account for the lag
     // time between the service recording the state change and the agent
     // stopping heartbeats.
@@ -1126,17 +1157,7 @@ absl::Status CoordinationServiceStandaloneImpl::RecordHeartbeat(
                      "The service might have restarted, please restart / reset "
                      "and register again.")));
   }
-  VLOG(10) << "Record heartbeat from task: " << task_name
-           << "at incarnation: " << incarnation << "at " << absl::Now();
-  s = task_state->RecordHeartbeat(incarnation);
-
-  // Set and propagate any heartbeat errors.
-  if (!s.ok()) {
-    SetTaskError(task_name, s);
-    PropagateError(s, {task});
-  }
-
-  return s;
+  return absl::OkStatus();
 }
 
 bool CoordinationServiceStandaloneImpl::AllTasksAreRecoverable(
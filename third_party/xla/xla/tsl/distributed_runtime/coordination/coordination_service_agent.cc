@@ -387,6 +387,20 @@ void CoordinationServiceAgentImpl::StartSendingHeartbeats() {
   CallOptions call_opts;
   call_opts.SetTimeout(heartbeat_interval_ms);
 
+  // The tasks of a job usually connect at the same time. Delaying the first
+  // heartbeat by a random fraction of the interval spreads the heartbeats of
+  // all tasks over the interval, instead of sending them to the service in
+  // bursts. The first heartbeat still arrives within the heartbeat timeout.
+  if (heartbeat_interval_ms > 0) {
+    absl::MutexLock l(&heartbeat_thread_shutdown_mu_);
+    heartbeat_thread_cv_.WaitWithTimeout(
+        &heartbeat_thread_shutdown_mu_,
+        absl::Milliseconds(random::New64() % heartbeat_interval_ms));
+    if (shutting_down_) {
+      return;
+    }
+  }
+
   while (true) {
     absl::Status status;
     absl::Notification n;
@@ -93,6 +93,11 @@ struct AllocatorStats {
   std::optional<int64_t> pool_bytes;
   std::optional<int64_t> peak_pool_bytes;
 
+  // Number of bytes of free memory that the allocator keeps in a cache for
+  // later allocations of the same size. These bytes are not counted in
+  // `bytes_in_use`.
+  std::optional<int64_t> cached_bytes;
+
   AllocatorStats()
       : num_allocs(0),
         bytes_in_use(0),
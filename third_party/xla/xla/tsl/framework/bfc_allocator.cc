@@ -22,9 +22,12 @@ limitations under the License.
 #include <cstdint>
 #include <cstdlib>
 #include <deque>
+#include <functional>
 #include <map>
 #include <memory>
 #include <optional>
+#include <string>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
@@ -34,6 +37,7 @@ limitations under the License.
 #include "absl/synchronization/mutex.h"
 #include "xla/tsl/framework/allocator.h"
 #include "xla/tsl/framework/allocator_retry.h"
+#include "xla/tsl/framework/metrics.h"
 #include "xla/tsl/protobuf/bfc_memory_map.pb.h"
 #include "tsl/platform/env.h"
 #include "tsl/platform/file_system.h"
@@ -94,6 +98,19 @@ BFCAllocator::BFCAllocator(std::unique_ptr<SubAllocator> sub_allocator,
       CHECK_NE(BinForSize(bin_size * 2), BinFromIndex(b));
     }
   }
+
+  if (opts.small_allocation_cache_bytes > 0) {
+    VLOG(1) << "Caching allocations of up to " << kMaxCachedAllocationSize
+            << " bytes, "
+            << strings::HumanReadableNumBytes(opts.small_allocation_cache_bytes)
+            << " per shard";
+    cache_shards_ = std::make_unique<CacheShard[]>(kNumCacheShards);
+  }
+
+  if (opts.export_telemetry) {
+    allocation_lifetime_cell_ =
+        metrics::GetBfcAllocatorAllocationLifetimeCell(name_);
+  }
 }
 
 BFCAllocator::~BFCAllocator() {
@@ -274,6 +291,19 @@ void* BFCAllocator::AllocateRawInternalWithRetry(
 void* BFCAllocator::AllocateRaw(size_t unused_alignment, size_t num_bytes,
                                 const AllocationAttributes& allocation_attr) {
   VLOG(3) << "AllocateRaw " << Name() << "  " << num_bytes;
+  int size_class = -1;
+  if (UseSmallAllocationCache(num_bytes, allocation_attr)) {
+    size_class = RoundedBytes(num_bytes) / kMinAllocationSize - 1;
+    void* ptr = AllocateFromSmallAllocationCache(size_class);
+    if (ptr != nullptr) {
+      VLOG(3) << "AllocateRaw " << Name() << "  " << num_bytes << " " << ptr
+              << " (cached)";
+      return ptr;
+    }
+    // All the chunks of a size class have the same size, so that they can be
+    // reused by any allocation of that size class.
+    num_bytes = (size_class + 1) * kMinAllocationSize;
+  }
   void* result = [&] {
     if (!opts_.allow_retry_on_failure || !allocation_attr.retry_on_failure) {
       // If we have globally disabled retry-on-failure and fail to allocate an
@@ -320,6 +350,14 @@ void* BFCAllocator::AllocateRaw(size_t unused_alignment, size_t num_bytes,
                                           allocation_attr);
     }
   }();
+  if (result == nullptr && FlushSmallAllocationCache()) {
+    // The chunks kept by the cache may be enough to satisfy the request once
+    // they have been coalesced.
+    return AllocateRaw(unused_alignment, num_bytes, allocation_attr);
+  }
+  if (result != nullptr && size_class >= 0) {
+    AddToSmallAllocationCache(result, size_class);
+  }
   VLOG(3) << "AllocateRaw " << Name() << "  " << num_bytes << " " << result;
   VLOG(4) << "[mem-debug] AllocateRaw," << Name() << "," << num_bytes << ","
           << result << "," << tsl::CurrentStackTrace();
@@ -566,6 +604,40 @@ void BFCAllocator::AddTraceMe(absl::string_view traceme_name,
       /*level=*/tsl::profiler::TraceMeLevel::kInfo);
 }
 
+void BFCAllocator::MaybeExportTelemetry(uint64 now_micros) {
+  if (now_micros < next_telemetry_micros_) return;
+  next_telemetry_micros_ = now_micros + kTelemetryIntervalMicros;
+
+  const double fragmentation =
+      *stats_.pool_bytes > stats_.bytes_in_use ? GetFragmentation() : 0.0;
+  const int64_t largest_free_chunk = LargestFreeChunk();
+  std::vector<std::pair<int64_t, int64_t>> free_chunks;
+  free_chunks.reserve(kNumBins);
+  for (BinNum b = 0; b < kNumBins; b++) {
+    free_chunks.emplace_back(BinNumToSize(b),
+                             BinFromIndex(b)->free_chunks.size());
+  }
+  metrics::UpdateBfcAllocatorMemoryLayout(name_, fragmentation,
+                                          largest_free_chunk, free_chunks);
+
+  tsl::profiler::TraceMe::InstantActivity(
+      [&]() {
+        std::string free_chunks_by_size;
+        for (const auto& [min_chunk_bytes, num_chunks] : free_chunks) {
+          if (num_chunks == 0) continue;
+          strings::StrAppend(&free_chunks_by_size,
+                             free_chunks_by_size.empty() ? "" : ",",
+                             min_chunk_bytes, ":", num_chunks);
+        }
+        return tsl::profiler::TraceMeEncode(
+            "MemoryLayout", {{"allocator_name", name_},
+                             {"fragmentation", fragmentation},
+                             {"largest_free_chunk_bytes", largest_free_chunk},
+                             {"free_chunks", free_chunks_by_size}});
+      },
+      /*level=*/tsl::profiler::TraceMeLevel::kInfo);
+}
+
 void* BFCAllocator::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
                                  size_t num_bytes, uint64 freed_before) {
   // First identify the first bin that could satisfy rounded_bytes.
@@ -608,6 +680,9 @@ void* BFCAllocator::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
         // Assign a unique id and increment the id counter, marking the
         // chunk as being in use.
         chunk->allocation_id = next_allocation_id_++;
+        if (opts_.export_telemetry) {
+          chunk->allocated_at_micros = Env::Default()->NowMicros();
+        }
 
         // Update stats.
         ++stats_.num_allocs;
@@ -642,6 +717,10 @@ void* BFCAllocator::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
         }
 #endif
 
+        if (opts_.export_telemetry) {
+          MaybeExportTelemetry(chunk->allocated_at_micros);
+        }
+
         VLOG(4) << "Returning: " << chunk->ptr;
         if (VLOG_IS_ON(4)) {
           LOG(INFO) << "A: " << RenderOccupancy();
@@ -698,6 +777,9 @@ void BFCAllocator::DeallocateRaw(void* ptr) {
   VLOG(4) << "[mem-debug] DeallocateRaw," << Name() << ","
           << (ptr ? RequestedSize(ptr) : 0) << "," << ptr << ","
           << tsl::CurrentStackTrace();
+  if (ptr != nullptr && DeallocateToSmallAllocationCache(ptr)) {
+    return;
+  }
   DeallocateRawInternal(ptr);
   retry_helper_.NotifyDealloc();
 }
@@ -708,7 +790,20 @@ void BFCAllocator::DeallocateRawInternal(void* ptr) {
     return;
   }
   absl::MutexLock l(&mutex_);
+  DeallocateChunkPtr(ptr);
+}
 
+void BFCAllocator::DeallocateChunkPtrs(const std::vector<void*>& ptrs) {
+  {
+    absl::MutexLock l(&mutex_);
+    for (void* ptr : ptrs) {
+      DeallocateChunkPtr(ptr);
+    }
+  }
+  retry_helper_.NotifyDealloc();
+}
+
+void BFCAllocator::DeallocateChunkPtr(void* ptr) {
   // Find the chunk from the ptr.
   BFCAllocator::ChunkHandle h = region_manager_.get_handle(ptr);
   CHECK(h != kInvalidChunkHandle);
@@ -717,6 +812,11 @@ void BFCAllocator::DeallocateRawInternal(void* ptr) {
   void* chunk_ptr = chunk->ptr;
   int64_t req_bytes = chunk->requested_size;
   int64_t alloc_bytes = chunk->size;
+  uint64 now_micros = 0;
+  if (opts_.export_telemetry) {
+    now_micros = Env::Default()->NowMicros();
+    allocation_lifetime_cell_->Add(now_micros - chunk->allocated_at_micros);
+  }
 
   MarkFree(h);
 
@@ -732,11 +832,129 @@ void BFCAllocator::DeallocateRawInternal(void* ptr) {
   // correct aggregation stats (bytes_in_use, fragmentation).
   AddTraceMe("MemoryDeallocation", chunk_ptr, req_bytes, alloc_bytes);
 
+  if (opts_.export_telemetry) {
+    MaybeExportTelemetry(now_micros);
+  }
+
   if (VLOG_IS_ON(4)) {
     LOG(INFO) << "F: " << RenderOccupancy();
   }
 }
 
+BFCAllocator::CacheShard* BFCAllocator::ShardForPtr(const void* ptr) {
+  // Chunks are at least kMinAllocationSize apart.
+  const uintptr_t index =
+      reinterpret_cast<uintptr_t>(ptr) >> kMinAllocationBits;
+  return &cache_shards_[index % kNumCacheShards];
+}
+
+BFCAllocator::CacheShard* BFCAllocator::ShardForCurrentThread() {
+  static thread_local const size_t thread_hash =
+      std::hash<std::thread::id>()(std::this_thread::get_id());
+  return &cache_shards_[thread_hash % kNumCacheShards];
+}
+
+bool BFCAllocator::UseSmallAllocationCache(
+    size_t num_bytes, const AllocationAttributes& allocation_attr) {
+  // Cached chunks are reused without regard to when they were freed, so the
+  // cache cannot be used when reuse must be ordered by a timing counter.
+  return cache_shards_ != nullptr && num_bytes > 0 &&
+         num_bytes <= kMaxCachedAllocationSize &&
+         allocation_attr.freed_by_func == nullptr && timing_counter_ == nullptr;
+}
+
+void* BFCAllocator::AllocateFromSmallAllocationCache(int size_class) {
+  void* ptr;
+  {
+    CacheShard* shard = ShardForCurrentThread();
+    absl::MutexLock l(&shard->mu);
+    std::vector<void*>& free_ptrs = shard->free_ptrs[size_class];
+    if (free_ptrs.empty()) {
+      return nullptr;
+    }
+    ptr = free_ptrs.back();
+    free_ptrs.pop_back();
+    shard->cached_bytes -= (size_class + 1) * kMinAllocationSize;
+  }
+  AddToSmallAllocationCache(ptr, size_class);
+  num_cached_allocs_.fetch_add(1, std::memory_order_relaxed);
+  return ptr;
+}
+
+void BFCAllocator::AddToSmallAllocationCache(void* ptr, int size_class) {
+  CacheShard* shard = ShardForPtr(ptr);
+  absl::MutexLock l(&shard->mu);
+  shard->in_use.emplace(ptr, size_class);
+}
+
+bool BFCAllocator::DeallocateToSmallAllocationCache(void* ptr) {
+  if (cache_shards_ == nullptr) {
+    return false;
+  }
+  int size_class;
+  {
+    CacheShard* shard = ShardForPtr(ptr);
+    absl::MutexLock l(&shard->mu);
+    auto it = shard->in_use.find(ptr);
+    if (it == shard->in_use.end()) {
+      return false;
+    }
+    size_class = it->second;
+    shard->in_use.erase(it);
+  }
+  if (timing_counter_ != nullptr) {
+    return false;
+  }
+  std::vector<void*> to_deallocate;
+  {
+    CacheShard* shard = ShardForCurrentThread();
+    absl::MutexLock l(&shard->mu);
+    shard->free_ptrs[size_class].push_back(ptr);
+    shard->cached_bytes += (size_class + 1) * kMinAllocationSize;
+    if (shard->cached_bytes > opts_.small_allocation_cache_bytes) {
+      // Return the largest chunks first, until half of the limit is left.
+      for (int c = kNumCachedSizeClasses - 1;
+           c >= 0 &&
+           shard->cached_bytes > opts_.small_allocation_cache_bytes / 2;
+           --c) {
+        std::vector<void*>& free_ptrs = shard->free_ptrs[c];
+        while (!free_ptrs.empty() &&
+               shard->cached_bytes > opts_.small_allocation_cache_bytes / 2) {
+          to_deallocate.push_back(free_ptrs.back());
+          free_ptrs.pop_back();
+          shard->cached_bytes -= (c + 1) * kMinAllocationSize;
+        }
+      }
+    }
+  }
+  if (!to_deallocate.empty()) {
+    DeallocateChunkPtrs(to_deallocate);
+  }
+  return true;
+}
+
+bool BFCAllocator::FlushSmallAllocationCache() {
+  if (cache_shards_ == nullptr) {
+    return false;
+  }
+  std::vector<void*> to_deallocate;
+  for (int i = 0; i < kNumCacheShards; ++i) {
+    CacheShard& shard = cache_shards_[i];
+    absl::MutexLock l(&shard.mu);
+    for (std::vector<void*>& free_ptrs : shard.free_ptrs) {
+      to_deallocate.insert(to_deallocate.end(), free_ptrs.begin(),
+                           free_ptrs.end());
+      free_ptrs.clear();
+    }
+    shard.cached_bytes = 0;
+  }
+  if (to_deallocate.empty()) {
+    return false;
+  }
+  DeallocateChunkPtrs(to_deallocate);
+  return true;
+}
+
 // Merges h1 and h2 when Chunk(h1)->next is h2 and Chunk(h2)->prev is c1.
 // We merge Chunk(h2) into Chunk(h1).
 void BFCAllocator::Merge(BFCAllocator::ChunkHandle h1,
@@ -1222,11 +1440,26 @@ MemoryDump BFCAllocator::RecordMemoryMapInternal() {
 
 std::optional<AllocatorStats> BFCAllocator::GetStats() {
   absl::MutexLock l(&mutex_);
-  return stats_;
+  if (cache_shards_ == nullptr) {
+    return stats_;
+  }
+  // The chunks kept by the small allocation cache are in use as far as the
+  // allocator is concerned.
+  AllocatorStats stats = stats_;
+  int64_t cached_bytes = 0;
+  for (int i = 0; i < kNumCacheShards; ++i) {
+    absl::MutexLock shard_lock(&cache_shards_[i].mu);
+    cached_bytes += cache_shards_[i].cached_bytes;
+  }
+  stats.num_allocs += num_cached_allocs_.load(std::memory_order_relaxed);
+  stats.bytes_in_use -= cached_bytes;
+  stats.cached_bytes = cached_bytes;
+  return stats;
 }
 
 bool BFCAllocator::ClearStats() {
   absl::MutexLock l(&mutex_);
+  num_cached_allocs_.store(0, std::memory_order_relaxed);
   stats_.num_allocs = 0;
   stats_.peak_bytes_in_use = stats_.bytes_in_use;
   stats_.largest_alloc_size = 0;
@@ -27,6 +27,7 @@ limitations under the License.
 #include <vector>
 
 #include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
@@ -34,6 +35,7 @@ limitations under the License.
 #include "xla/tsl/framework/allocator_retry.h"
 #include "xla/tsl/framework/shared_counter.h"
 #include "xla/tsl/lib/core/bits.h"
+#include "xla/tsl/lib/monitoring/sampler.h"
 #include "tsl/platform/logging.h"
 #include "tsl/platform/numbers.h"
 #include "tsl/platform/strcat.h"
@@ -73,7 +75,29 @@ class BFCAllocator : public Allocator {
     // Controls when a chunk should be split, if its size exceeds the requested
     // allocation size.
     double fragmentation_fraction = 0;
+
+    // If non-zero, allocations of at most `kMaxCachedAllocationSize` bytes are
+    // rounded up to a multiple of 256 bytes and are kept in a cache of free
+    // chunks when they are deallocated. Later allocations of the same size
+    // class are served from the cache. The cache is split into shards that are
+    // locked independently, so most small allocations and deallocations do not
+    // take the allocator's lock. Each shard keeps at most this many bytes;
+    // beyond that, half of its chunks are returned to the allocator at once.
+    size_t small_allocation_cache_bytes = 0;
+
+    // If true, the lifetimes of allocations are recorded, and metrics that
+    // describe the layout of the free memory (fragmentation, largest free
+    // chunk, free chunks by size) are exported through `tsl::monitoring` and
+    // as profiler events at most once every `kTelemetryIntervalMicros`.
+    bool export_telemetry = false;
   };
+
+  // The minimum time between two exports of the memory layout metrics.
+  static constexpr uint64 kTelemetryIntervalMicros = 1000 * 1000;
+
+  // The largest allocation that is served by the small allocation cache.
+  static constexpr size_t kMaxCachedAllocationSize = 4096;
+
   BFCAllocator(std::unique_ptr<SubAllocator> sub_allocator, size_t total_memory,
                const string& name, const Options& opts);
 
@@ -125,6 +149,33 @@ class BFCAllocator : public Allocator {
 
   void DeallocateRawInternal(void* ptr);
 
+  // Returns `ptr` to its chunk. REQUIRES: `ptr` is not null.
+  void DeallocateChunkPtr(void* ptr) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Returns true if an allocation of `num_bytes` with `allocation_attr` may be
+  // served from the small allocation cache.
+  bool UseSmallAllocationCache(size_t num_bytes,
+                               const AllocationAttributes& allocation_attr);
+
+  // Returns a cached chunk of the size class `size_class`, or nullptr if the
+  // cache of the calling thread has none.
+  void* AllocateFromSmallAllocationCache(int size_class);
+
+  // Records that `ptr`, which was allocated for the size class `size_class`,
+  // is returned to the small allocation cache when it is deallocated.
+  void AddToSmallAllocationCache(void* ptr, int size_class);
+
+  // If `ptr` belongs to the small allocation cache, keeps it there and returns
+  // true. Otherwise returns false and `ptr` must be deallocated normally.
+  bool DeallocateToSmallAllocationCache(void* ptr);
+
+  // Returns all the chunks kept by the small allocation cache to the
+  // allocator. Returns true if it returned any.
+  bool FlushSmallAllocationCache();
+
+  // Returns the chunks at `ptrs` to the allocator.
+  void DeallocateChunkPtrs(const std::vector<void*>& ptrs);
+
   // Chunks whose freed_at_count is later than the safe frontier value are kept
   // on a special list and not subject to merging immediately upon being freed.
   //
@@ -157,6 +208,12 @@ class BFCAllocator : public Allocator {
                   int64_t req_bytes, int64_t alloc_bytes)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
+  // Exports the memory layout metrics if `opts_.export_telemetry` is set and
+  // they were last exported more than `kTelemetryIntervalMicros` before
+  // `now_micros`.
+  void MaybeExportTelemetry(uint64 now_micros)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   // A ChunkHandle is an index into the chunks_ vector in BFCAllocator
   // kInvalidChunkHandle means an invalid chunk
   typedef size_t ChunkHandle;
@@ -213,6 +270,9 @@ class BFCAllocator : public Allocator {
     // Optional count when this chunk was most recently made free.
     uint64 freed_at_count = 0;
 
+    // When the chunk was allocated, if telemetry is exported.
+    uint64 allocated_at_micros = 0;
+
     bool in_use() const { return allocation_id != -1; }
 
 #ifdef TENSORFLOW_MEM_DEBUG
@@ -595,6 +655,40 @@ class BFCAllocator : public Allocator {
   // Stats.
   AllocatorStats stats_ ABSL_GUARDED_BY(mutex_);
 
+  // Records the lifetimes of allocations if telemetry is exported.
+  monitoring::SamplerCell* allocation_lifetime_cell_ = nullptr;
+  uint64 next_telemetry_micros_ ABSL_GUARDED_BY(mutex_) = 0;
+
+  // The small allocation cache (see `Options::small_allocation_cache_bytes`).
+  // The size class of an allocation of `n` bytes is
+  // `RoundedBytes(n) / kMinAllocationSize - 1`.
+  static constexpr int kNumCachedSizeClasses =
+      kMaxCachedAllocationSize / kMinAllocationSize;
+  static constexpr int kNumCacheShards = 16;
+
+  // Threads allocate from and free to the shard that their id hashes to. The
+  // size class of an allocated chunk is recorded in the shard that its address
+  // hashes to, so that it can be found by whichever thread frees the chunk.
+  struct alignas(64) CacheShard {
+    absl::Mutex mu;
+    // The free chunks of each size class.
+    std::array<std::vector<void*>, kNumCachedSizeClasses> free_ptrs
+        ABSL_GUARDED_BY(mu);
+    // The total size of `free_ptrs`.
+    size_t cached_bytes ABSL_GUARDED_BY(mu) = 0;
+    // The size classes of the allocated chunks whose address hashes to this
+    // shard.
+    absl::flat_hash_map<void*, int> in_use ABSL_GUARDED_BY(mu);
+  };
+  CacheShard* ShardForPtr(const void* ptr);
+  CacheShard* ShardForCurrentThread();
+
+  // Null iff the small allocation cache is disabled.
+  std::unique_ptr<CacheShard[]> cache_shards_;
+  // The number of allocations served from the cache since the last call to
+  // `ClearStats()`. They are reported in `AllocatorStats::num_allocs`.
+  std::atomic<int64_t> num_cached_allocs_{0};
+
 #ifdef TENSORFLOW_MEM_DEBUG
   int64 action_counter_ ABSL_GUARDED_BY(mutex_);
 #define MEM_DEBUG_SIZE_HISTORY_SIZE 4096
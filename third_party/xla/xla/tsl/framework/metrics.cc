@@ -16,8 +16,15 @@ limitations under the License.
 #include "xla/tsl/framework/metrics.h"
 
 #include <cstdint>
+#include <string>
+#include <utility>
 
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "xla/tsl/lib/monitoring/counter.h"
+#include "xla/tsl/lib/monitoring/gauge.h"
+#include "xla/tsl/lib/monitoring/sampler.h"
 
 namespace tsl {
 namespace metrics {
@@ -28,6 +35,30 @@ auto* bfc_allocator_delay =
                                 "The total time spent running each graph "
                                 "optimization pass in microseconds.");
 
+auto* bfc_allocator_allocation_lifetime = monitoring::Sampler<1>::New(
+    {"/tensorflow/core/bfc_allocator/allocation_lifetime_usecs",
+     "The time between the allocation and the deallocation of chunks of the "
+     "BFC allocator, in microseconds.",
+     "allocator"},
+    // Power of 2 with bucket count 32 (> 1 hour)
+    {monitoring::Buckets::Exponential(1, 2, 32)});
+
+auto* bfc_allocator_fragmentation = monitoring::Gauge<double, 1>::New(
+    "/tensorflow/core/bfc_allocator/fragmentation",
+    "The fraction of the free memory of the BFC allocator that is not in its "
+    "largest free chunk.",
+    "allocator");
+
+auto* bfc_allocator_largest_free_chunk = monitoring::Gauge<int64_t, 1>::New(
+    "/tensorflow/core/bfc_allocator/largest_free_chunk_bytes",
+    "The size of the largest free chunk of the BFC allocator.", "allocator");
+
+auto* bfc_allocator_free_chunks = monitoring::Gauge<int64_t, 2>::New(
+    "/tensorflow/core/bfc_allocator/free_chunks",
+    "The number of free chunks of the BFC allocator, by the smallest chunk "
+    "size of their bin.",
+    "allocator", "min_chunk_bytes");
+
 }  // namespace
 
 void UpdateBfcAllocatorDelayTime(const uint64_t delay_usecs) {
@@ -37,5 +68,25 @@ void UpdateBfcAllocatorDelayTime(const uint64_t delay_usecs) {
   }
 }
 
+monitoring::SamplerCell* GetBfcAllocatorAllocationLifetimeCell(
+    absl::string_view allocator_name) {
+  return bfc_allocator_allocation_lifetime->GetCell(
+      std::string(allocator_name));
+}
+
+void UpdateBfcAllocatorMemoryLayout(
+    absl::string_view allocator_name, double fragmentation,
+    int64_t largest_free_chunk_bytes,
+    absl::Span<const std::pair<int64_t, int64_t>> free_chunks) {
+  const std::string name(allocator_name);
+  bfc_allocator_fragmentation->GetCell(name)->Set(fragmentation);
+  bfc_allocator_largest_free_chunk->GetCell(name)->Set(
+      largest_free_chunk_bytes);
+  for (const auto& [min_chunk_bytes, num_chunks] : free_chunks) {
+    bfc_allocator_free_chunks->GetCell(name, absl::StrCat(min_chunk_bytes))
+        ->Set(num_chunks);
+  }
+}
+
 }  // namespace metrics
 }  // namespace tsl
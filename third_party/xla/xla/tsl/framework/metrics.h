@@ -17,6 +17,11 @@ limitations under the License.
 #define XLA_TSL_FRAMEWORK_METRICS_H_
 
 #include <cstdint>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/tsl/lib/monitoring/sampler.h"
 
 namespace tsl {
 namespace metrics {
@@ -24,6 +29,19 @@ namespace metrics {
 // Updates the metrics stored about time BFC allocator spents during delay.
 void UpdateBfcAllocatorDelayTime(const uint64_t delay_usecs);
 
+// Returns the cell that records the lifetimes of the allocations of the BFC
+// allocator `allocator_name`.
+monitoring::SamplerCell* GetBfcAllocatorAllocationLifetimeCell(
+    absl::string_view allocator_name);
+
+// Updates the metrics that describe the free memory of the BFC allocator
+// `allocator_name`. `free_chunks` holds the number of free chunks of each bin,
+// keyed by the smallest chunk size of the bin.
+void UpdateBfcAllocatorMemoryLayout(
+    absl::string_view allocator_name, double fragmentation,
+    int64_t largest_free_chunk_bytes,
+    absl::Span<const std::pair<int64_t, int64_t>> free_chunks);
+
 }  // namespace metrics
 }  // namespace tsl
 
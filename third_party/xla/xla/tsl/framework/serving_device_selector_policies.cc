@@ -15,6 +15,8 @@ limitations under the License.
 #include "xla/tsl/framework/serving_device_selector_policies.h"
 
 #include <atomic>
+#include <cstdint>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "xla/tsl/framework/serving_device_selector.h"
@@ -28,4 +30,77 @@ int RoundRobinPolicy::SelectDevice(
   return ordinal_.fetch_add(1, std::memory_order_relaxed) % num_devices;
 }
 
+namespace {
+
+// The work pending on a device.
+struct DeviceLoad {
+  // Sum of the known execution times of its programs.
+  int64_t known_ns = 0;
+  // Number of its programs with a known execution time.
+  int64_t num_known = 0;
+  // Number of its programs without a known execution time.
+  int64_t num_unknown = 0;
+};
+
+void AddProgram(const ServingDeviceSelector::DeviceState::ProgramInfo& program,
+                DeviceLoad& load) {
+  const int64_t time_ns =
+      program.execution_info == nullptr
+          ? 0
+          : program.execution_info->MaybeGetValidTime(program.prefetch_results);
+  if (time_ns > 0) {
+    load.known_ns += time_ns;
+    ++load.num_known;
+  } else {
+    ++load.num_unknown;
+  }
+}
+
+}  // namespace
+
+int LeastLoadedPolicy::SelectDevice(
+    absl::string_view program_fingerprint,
+    const ServingDeviceSelector::DeviceStates& device_states) {
+  const int num_devices = device_states.states.size();
+  std::vector<DeviceLoad> loads(num_devices);
+  int64_t total_known_ns = 0;
+  int64_t num_known = 0;
+  for (int i = 0; i < num_devices; ++i) {
+    const auto& state = device_states.states[i];
+    for (const auto& queue : state.enqueued_programs) {
+      for (const auto& program : queue) AddProgram(program, loads[i]);
+    }
+    for (const auto& queue : state.scheduled_programs) {
+      for (const auto& program : queue) AddProgram(program, loads[i]);
+    }
+    total_known_ns += loads[i].known_ns;
+    num_known += loads[i].num_known;
+  }
+  const double mean_ns =
+      num_known > 0 ? static_cast<double>(total_known_ns) / num_known : 1.0;
+  auto estimated_ns = [&](int i) {
+    return loads[i].known_ns + loads[i].num_unknown * mean_ns;
+  };
+
+  // Scan from a rotating offset so that ties are broken round-robin.
+  const int offset =
+      ordinal_.fetch_add(1, std::memory_order_relaxed) % num_devices;
+  int least_loaded = offset;
+  for (int j = 1; j < num_devices; ++j) {
+    const int i = (offset + j) % num_devices;
+    if (estimated_ns(i) < estimated_ns(least_loaded)) least_loaded = i;
+  }
+
+  const double max_affinity_ns =
+      estimated_ns(least_loaded) + affinity_slack_programs_ * mean_ns;
+  for (int j = 0; j < num_devices; ++j) {
+    const int i = (offset + j) % num_devices;
+    if (device_states.states[i].last_fingerprint == program_fingerprint &&
+        estimated_ns(i) <= max_affinity_ns) {
+      return i;
+    }
+  }
+  return least_loaded;
+}
+
 }  // namespace tsl
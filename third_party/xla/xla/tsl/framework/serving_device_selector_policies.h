@@ -16,6 +16,7 @@ limitations under the License.
 #define XLA_TSL_FRAMEWORK_SERVING_DEVICE_SELECTOR_POLICIES_H_
 
 #include <atomic>
+#include <cstdint>
 
 #include "xla/tsl/framework/serving_device_selector.h"
 
@@ -23,6 +24,7 @@ namespace tsl {
 
 enum class ServingDeviceSelectorPolicy {
   kRoundRobin,
+  kLeastLoaded,
 };
 
 class RoundRobinPolicy : public ServingDeviceSelector::Policy {
@@ -37,6 +39,30 @@ class RoundRobinPolicy : public ServingDeviceSelector::Policy {
   std::atomic<uint64_t> ordinal_;
 };
 
+// Selects the device with the least estimated pending work: the sum of the
+// average execution times of the programs enqueued or scheduled on it.
+// Programs whose execution time is not known yet count as the mean known
+// execution time, so that devices are balanced by queue depth until the first
+// programs complete.
+//
+// To keep the per-program state of the device warm, a program keeps going to
+// the device its fingerprint last ran on as long as that device is loaded by
+// at most `affinity_slack_programs` mean execution times more than the least
+// loaded one. Ties are broken round-robin.
+class LeastLoadedPolicy : public ServingDeviceSelector::Policy {
+ public:
+  explicit LeastLoadedPolicy(double affinity_slack_programs = 1.0)
+      : affinity_slack_programs_(affinity_slack_programs), ordinal_(0) {}
+
+  int SelectDevice(
+      absl::string_view program_fingerprint,
+      const ServingDeviceSelector::DeviceStates& device_states) override;
+
+ private:
+  const double affinity_slack_programs_;
+  std::atomic<uint64_t> ordinal_;
+};
+
 }  // namespace tsl
 
 #endif  // XLA_TSL_FRAMEWORK_SERVING_DEVICE_SELECTOR_POLICIES_H_
@@ -0,0 +1,158 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tsl/lib/io/parallel_gzip_outputbuffer.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "tsl/platform/errors.h"
+#include "tsl/platform/logging.h"
+#include "tsl/platform/notification.h"
+
+namespace tsl {
+namespace io {
+
+namespace {
+
+// Compresses `input` into the gzip member `output`.
+absl::Status CompressBlock(const ZlibCompressionOptions& options,
+                           const std::string& input, std::string* output) {
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  int error = deflateInit2(&stream, options.compression_level,
+                           options.compression_method, options.window_bits,
+                           options.mem_level, options.compression_strategy);
+  if (error != Z_OK) {
+    return errors::InvalidArgument("deflateInit failed with status ", error);
+  }
+  output->resize(deflateBound(&stream, input.size()));
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+  stream.avail_in = input.size();
+  stream.next_out = reinterpret_cast<Bytef*>(&(*output)[0]);
+  stream.avail_out = output->size();
+  error = deflate(&stream, Z_FINISH);
+  output->resize(stream.total_out);
+  deflateEnd(&stream);
+  if (error != Z_STREAM_END) {
+    return errors::DataLoss("deflate() failed with error ", error);
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+struct ParallelGzipOutputBuffer::Block {
+  std::string input;
+  std::string output;
+  absl::Status status;
+  Notification done;
+};
+
+ParallelGzipOutputBuffer::ParallelGzipOutputBuffer(
+    WritableFile* file, const ZlibCompressionOptions& zlib_options,
+    int num_threads, size_t block_bytes)
+    : file_(file),
+      zlib_options_(zlib_options),
+      block_bytes_(std::max<size_t>(block_bytes, 1)),
+      max_pending_blocks_(2 * std::max(num_threads, 1)),
+      pool_(Env::Default(), "parallel_gzip_output_buffer",
+            std::max(num_threads, 1)) {
+  DCHECK_GT(zlib_options.window_bits, MAX_WBITS)
+      << "ParallelGzipOutputBuffer can only write gzip encoded output";
+  input_.reserve(block_bytes_);
+}
+
+ParallelGzipOutputBuffer::~ParallelGzipOutputBuffer() {
+  if (!closed_) {
+    LOG(WARNING)
+        << "ParallelGzipOutputBuffer::Close() not called. Possible data loss";
+  }
+}
+
+absl::Status ParallelGzipOutputBuffer::CompressInput() {
+  auto block = std::make_shared<Block>();
+  block->input = std::move(input_);
+  input_.clear();
+  input_.reserve(block_bytes_);
+  pool_.Schedule([block, options = zlib_options_]() {
+    block->status = CompressBlock(options, block->input, &block->output);
+    block->input.clear();
+    block->input.shrink_to_fit();
+    block->done.Notify();
+  });
+  pending_.push_back(std::move(block));
+  while (pending_.size() > max_pending_blocks_) {
+    TF_RETURN_IF_ERROR(WriteOldestBlock());
+  }
+  return absl::OkStatus();
+}
+
+absl::Status ParallelGzipOutputBuffer::WriteOldestBlock() {
+  std::shared_ptr<Block> block = std::move(pending_.front());
+  pending_.pop_front();
+  block->done.WaitForNotification();
+  TF_RETURN_IF_ERROR(block->status);
+  return file_->Append(block->output);
+}
+
+absl::Status ParallelGzipOutputBuffer::Append(absl::string_view data) {
+  if (closed_) {
+    return errors::FailedPrecondition("ParallelGzipOutputBuffer is closed");
+  }
+  while (!data.empty()) {
+    const size_t bytes = std::min(block_bytes_ - input_.size(), data.size());
+    input_.append(data.data(), bytes);
+    data.remove_prefix(bytes);
+    if (input_.size() == block_bytes_) TF_RETURN_IF_ERROR(CompressInput());
+  }
+  return absl::OkStatus();
+}
+
+absl::Status ParallelGzipOutputBuffer::Flush() {
+  if (closed_) {
+    return errors::FailedPrecondition("ParallelGzipOutputBuffer is closed");
+  }
+  if (!input_.empty()) TF_RETURN_IF_ERROR(CompressInput());
+  while (!pending_.empty()) TF_RETURN_IF_ERROR(WriteOldestBlock());
+  return file_->Flush();
+}
+
+absl::Status ParallelGzipOutputBuffer::Close() {
+  TF_RETURN_IF_ERROR(Flush());
+  closed_ = true;
+  return absl::OkStatus();
+}
+
+absl::Status ParallelGzipOutputBuffer::Name(absl::string_view* result) const {
+  return file_->Name(result);
+}
+
+absl::Status ParallelGzipOutputBuffer::Sync() {
+  TF_RETURN_IF_ERROR(Flush());
+  return file_->Sync();
+}
+
+absl::Status ParallelGzipOutputBuffer::Tell(int64_t* position) {
+  return file_->Tell(position);
+}
+
+}  // namespace io
+}  // namespace tsl
@@ -0,0 +1,105 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_TSL_LIB_IO_PARALLEL_GZIP_OUTPUTBUFFER_H_
+#define XLA_TSL_LIB_IO_PARALLEL_GZIP_OUTPUTBUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+
+#include "xla/tsl/lib/io/zlib_compression_options.h"
+#include "tsl/platform/env.h"
+#include "tsl/platform/file_system.h"
+#include "tsl/platform/status.h"
+#include "tsl/platform/stringpiece.h"
+#include "tsl/platform/threadpool.h"
+
+namespace tsl {
+namespace io {
+
+// Writes gzip compressed output to a file, compressing on a thread pool.
+//
+// The input is split into blocks of `block_bytes`, each compressed into an
+// independent gzip member. Members are written to the file in input order, so
+// the output is a valid multi-member gzip stream, which ZlibInputStream reads
+// with ZlibCompressionOptions::GZIP(). At most 2 * `num_threads` blocks are
+// buffered at a time.
+//
+// A given instance of a ParallelGzipOutputBuffer is NOT safe for concurrent use
+// by multiple threads.
+class ParallelGzipOutputBuffer : public WritableFile {
+ public:
+  // Creates a ParallelGzipOutputBuffer for `file`, which it doesn't own.
+  // `zlib_options.window_bits` must request gzip encoding (be greater than 15).
+  ParallelGzipOutputBuffer(WritableFile* file,
+                           const ZlibCompressionOptions& zlib_options,
+                           int num_threads, size_t block_bytes);
+  ~ParallelGzipOutputBuffer() override;
+
+  // Adds `data` to the current block, which is compressed once full.
+  absl::Status Append(absl::string_view data) override;
+
+  // Compresses the current block, even if not full, and writes all the
+  // compressed blocks to the file.
+  absl::Status Flush() override;
+
+  // Like `Flush()`. After calling this, any further calls to `Append()`,
+  // `Flush()` or `Close()` will fail. Does not close the underlying file.
+  absl::Status Close() override;
+
+  // Returns the name of the underlying file.
+  absl::Status Name(absl::string_view* result) const override;
+
+  // Flushes and syncs the underlying file.
+  absl::Status Sync() override;
+
+  // Returns the write position in the underlying file. The position does not
+  // reflect buffered, un-flushed data.
+  absl::Status Tell(int64_t* position) override;
+
+ private:
+  struct Block;
+
+  // Schedules the compression of `input_` as a new block.
+  absl::Status CompressInput();
+
+  // Waits for the oldest block to be compressed, and writes it to the file.
+  absl::Status WriteOldestBlock();
+
+  WritableFile* file_;  // Not owned
+  const ZlibCompressionOptions zlib_options_;
+  const size_t block_bytes_;
+  const size_t max_pending_blocks_;
+  bool closed_ = false;
+
+  // The input of the block being filled.
+  std::string input_;
+
+  // Blocks scheduled for compression, oldest first.
+  std::deque<std::shared_ptr<Block>> pending_;
+
+  thread::ThreadPool pool_;
+
+  ParallelGzipOutputBuffer(const ParallelGzipOutputBuffer&) = delete;
+  void operator=(const ParallelGzipOutputBuffer&) = delete;
+};
+
+}  // namespace io
+}  // namespace tsl
+
+#endif  // XLA_TSL_LIB_IO_PARALLEL_GZIP_OUTPUTBUFFER_H_
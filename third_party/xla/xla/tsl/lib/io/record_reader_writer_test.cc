@@ -343,6 +343,89 @@ TEST(RecordReaderWriterTest, TestZlib) {
   }
 }
 
+TEST(RecordReaderWriterTest, TestParallelGzip) {
+  Env* env = Env::Default();
+  string fname = testing::TmpDir() + "/record_reader_writer_parallel_gzip_test";
+  std::vector<string> records;
+  for (int i = 0; i < 1000; ++i) {
+    records.push_back(strings::StrCat("record ", i, string(i % 37, 'x')));
+  }
+
+  for (size_t block_bytes : {1, 100, 4096, 1 << 20}) {
+    {
+      std::unique_ptr<WritableFile> file;
+      TF_CHECK_OK(env->NewWritableFile(fname, &file));
+
+      io::RecordWriterOptions options =
+          io::RecordWriterOptions::CreateRecordWriterOptions("GZIP");
+      options.compression_threads = 4;
+      options.compression_block_bytes = block_bytes;
+      io::RecordWriter writer(file.get(), options);
+      for (const string& record : records) {
+        TF_EXPECT_OK(writer.WriteRecord(record));
+      }
+      TF_CHECK_OK(writer.Close());
+      TF_CHECK_OK(file->Close());
+    }
+
+    {
+      std::unique_ptr<RandomAccessFile> read_file;
+      TF_CHECK_OK(env->NewRandomAccessFile(fname, &read_file));
+      io::RecordReader reader(
+          read_file.get(),
+          io::RecordReaderOptions::CreateRecordReaderOptions("GZIP"));
+      uint64 offset = 0;
+      tstring record;
+      for (const string& expected : records) {
+        TF_CHECK_OK(reader.ReadRecord(&offset, &record));
+        EXPECT_EQ(expected, record);
+      }
+      EXPECT_EQ(reader.ReadRecord(&offset, &record).code(),
+                error::OUT_OF_RANGE);
+    }
+  }
+}
+
+TEST(RecordReaderWriterTest, TestZstd) {
+  Env* env = Env::Default();
+  string fname = testing::TmpDir() + "/record_reader_writer_zstd_test";
+
+  for (bool with_dictionary : {false, true}) {
+    io::ZstdCompressionOptions zstd_options;
+    if (with_dictionary) zstd_options.dictionary = "record abc defg";
+    {
+      std::unique_ptr<WritableFile> file;
+      TF_CHECK_OK(env->NewWritableFile(fname, &file));
+
+      io::RecordWriterOptions options =
+          io::RecordWriterOptions::CreateRecordWriterOptions("ZSTD");
+      options.zstd_options = zstd_options;
+      io::RecordWriter writer(file.get(), options);
+      TF_EXPECT_OK(writer.WriteRecord("abc"));
+      TF_EXPECT_OK(writer.WriteRecord("defg"));
+      TF_CHECK_OK(writer.Close());
+      TF_CHECK_OK(file->Close());
+    }
+
+    {
+      std::unique_ptr<RandomAccessFile> read_file;
+      TF_CHECK_OK(env->NewRandomAccessFile(fname, &read_file));
+      io::RecordReaderOptions options =
+          io::RecordReaderOptions::CreateRecordReaderOptions("ZSTD");
+      options.zstd_options = zstd_options;
+      io::RecordReader reader(read_file.get(), options);
+      uint64 offset = 0;
+      tstring record;
+      TF_CHECK_OK(reader.ReadRecord(&offset, &record));
+      EXPECT_EQ("abc", record);
+      TF_CHECK_OK(reader.ReadRecord(&offset, &record));
+      EXPECT_EQ("defg", record);
+      EXPECT_EQ(reader.ReadRecord(&offset, &record).code(),
+                error::OUT_OF_RANGE);
+    }
+  }
+}
+
 TEST(RecordReaderWriterTest, TestUseAfterClose) {
   Env* env = Env::Default();
   string fname = testing::TmpDir() + "/record_reader_writer_flush_close_test";
@@ -22,9 +22,12 @@ limitations under the License.
 #include "tsl/platform/stringpiece.h"
 #if !defined(IS_SLIM_BUILD)
 #include "xla/tsl/lib/io/snappy/snappy_compression_options.h"
+#include "xla/tsl/lib/io/parallel_gzip_outputbuffer.h"
 #include "xla/tsl/lib/io/snappy/snappy_outputbuffer.h"
 #include "xla/tsl/lib/io/zlib_compression_options.h"
 #include "xla/tsl/lib/io/zlib_outputbuffer.h"
+#include "xla/tsl/lib/io/zstd/zstd_compression_options.h"
+#include "xla/tsl/lib/io/zstd/zstd_outputbuffer.h"
 #endif  // IS_SLIM_BUILD
 #include "tsl/platform/cord.h"
 #include "tsl/platform/macros.h"
@@ -41,7 +44,8 @@ struct RecordWriterOptions {
   enum CompressionType {
     NONE = 0,
     ZLIB_COMPRESSION = 1,
-    SNAPPY_COMPRESSION = 2
+    SNAPPY_COMPRESSION = 2,
+    ZSTD_COMPRESSION = 3
   };
   CompressionType compression_type = NONE;
 
@@ -52,6 +56,14 @@ struct RecordWriterOptions {
   // Options specific to compression.
   io::ZlibCompressionOptions zlib_options;
   io::SnappyCompressionOptions snappy_options;
+  io::ZstdCompressionOptions zstd_options;
+
+  // With gzip encoding (zlib_options.window_bits > 15), if greater than 1, the
+  // output is compressed by this many threads, in independent gzip members of
+  // `compression_block_bytes` of input each. The output stays a valid gzip
+  // stream, but zlib_options.flush_mode and the buffer sizes are not used.
+  int compression_threads = 1;
+  size_t compression_block_bytes = 1 << 20;
 #endif  // IS_SLIM_BUILD
 };
 
@@ -0,0 +1,47 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_TSL_LIB_IO_ZSTD_ZSTD_COMPRESSION_OPTIONS_H_
+#define XLA_TSL_LIB_IO_ZSTD_ZSTD_COMPRESSION_OPTIONS_H_
+
+#include <string>
+
+#include "tsl/platform/types.h"
+
+namespace tsl {
+namespace io {
+
+struct ZstdCompressionOptions {
+  // Size of the buffer used for caching the data read from source file.
+  int64_t input_buffer_size = 256 << 10;
+
+  // Size of the sink buffer where the compressed/decompressed data produced by
+  // zstd is cached.
+  int64_t output_buffer_size = 256 << 10;
+
+  // Compression level, from 1 (fastest) to 19 (smallest output). Unused when
+  // decompressing.
+  int compression_level = 3;
+
+  // Optional dictionary (e.g. trained with `zstd --train` on sample records),
+  // which improves the compression of small records. Files must be read with
+  // the dictionary they were written with.
+  std::string dictionary;
+};
+
+}  // namespace io
+}  // namespace tsl
+
+#endif  // XLA_TSL_LIB_IO_ZSTD_ZSTD_COMPRESSION_OPTIONS_H_
@@ -0,0 +1,125 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tsl/lib/io/zstd/zstd_inputstream.h"
+
+#include <zstd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "tsl/platform/errors.h"
+
+namespace tsl {
+namespace io {
+
+ZstdInputStream::ZstdInputStream(InputStreamInterface* input_stream,
+                                 const ZstdCompressionOptions& options,
+                                 bool owns_input_stream)
+    : input_stream_(input_stream),
+      options_(options),
+      owns_input_stream_(owns_input_stream),
+      dctx_(ZSTD_createDCtx()),
+      output_buffer_size_(
+          std::max<size_t>(options.output_buffer_size, ZSTD_DStreamOutSize())),
+      output_buffer_(new char[output_buffer_size_]) {
+  if (dctx_ == nullptr) {
+    init_status_ = errors::ResourceExhausted("Failed to create a zstd context");
+    return;
+  }
+  if (!options_.dictionary.empty()) {
+    const size_t ret = ZSTD_DCtx_loadDictionary(
+        dctx_, options_.dictionary.data(), options_.dictionary.size());
+    if (ZSTD_isError(ret)) {
+      init_status_ = errors::InvalidArgument(
+          "Failed to load the zstd dictionary: ", ZSTD_getErrorName(ret));
+    }
+  }
+}
+
+ZstdInputStream::~ZstdInputStream() {
+  ZSTD_freeDCtx(dctx_);
+  if (owns_input_stream_) {
+    delete input_stream_;
+  }
+}
+
+absl::Status ZstdInputStream::ReadNBytes(int64_t bytes_to_read,
+                                         tstring* result) {
+  result->clear();
+  result->resize_uninitialized(bytes_to_read);
+  char* result_ptr = result->mdata();
+  int64_t bytes_read = 0;
+  absl::Status s;
+  while (bytes_read < bytes_to_read) {
+    if (next_out_ == end_out_) {
+      s = Decompress();
+      if (!s.ok()) break;
+      continue;
+    }
+    const size_t n = std::min<size_t>(end_out_ - next_out_,
+                                      bytes_to_read - bytes_read);
+    memcpy(result_ptr + bytes_read, next_out_, n);
+    next_out_ += n;
+    bytes_read += n;
+  }
+  bytes_read_ += bytes_read;
+  result->resize(bytes_read);
+  return s;
+}
+
+absl::Status ZstdInputStream::Decompress() {
+  TF_RETURN_IF_ERROR(init_status_);
+  if (in_pos_ == input_.size()) {
+    absl::Status s =
+        input_stream_->ReadNBytes(options_.input_buffer_size, &input_);
+    in_pos_ = 0;
+    // Reading past the end of the stream returns the last partial chunk.
+    if (errors::IsOutOfRange(s) && !input_.empty()) s = absl::OkStatus();
+    if (errors::IsOutOfRange(s) && frame_in_progress_) {
+      return errors::DataLoss("Truncated zstd stream");
+    }
+    TF_RETURN_IF_ERROR(s);
+  }
+  ZSTD_inBuffer in = {input_.data(), input_.size(), in_pos_};
+  ZSTD_outBuffer out = {output_buffer_.get(), output_buffer_size_, 0};
+  const size_t ret = ZSTD_decompressStream(dctx_, &out, &in);
+  if (ZSTD_isError(ret)) {
+    return errors::DataLoss("ZSTD_decompressStream failed: ",
+                            ZSTD_getErrorName(ret));
+  }
+  in_pos_ = in.pos;
+  frame_in_progress_ = ret != 0;
+  next_out_ = output_buffer_.get();
+  end_out_ = next_out_ + out.pos;
+  return absl::OkStatus();
+}
+
+int64_t ZstdInputStream::Tell() const { return bytes_read_; }
+
+absl::Status ZstdInputStream::Reset() {
+  TF_RETURN_IF_ERROR(init_status_);
+  TF_RETURN_IF_ERROR(input_stream_->Reset());
+  ZSTD_DCtx_reset(dctx_, ZSTD_reset_session_only);
+  input_.clear();
+  in_pos_ = 0;
+  next_out_ = end_out_ = nullptr;
+  frame_in_progress_ = false;
+  bytes_read_ = 0;
+  return absl::OkStatus();
+}
+
+}  // namespace io
+}  // namespace tsl
@@ -0,0 +1,97 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_TSL_LIB_IO_ZSTD_ZSTD_INPUTSTREAM_H_
+#define XLA_TSL_LIB_IO_ZSTD_ZSTD_INPUTSTREAM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "xla/tsl/lib/io/inputstream_interface.h"
+#include "xla/tsl/lib/io/zstd/zstd_compression_options.h"
+#include "tsl/platform/status.h"
+#include "tsl/platform/tstring.h"
+
+// Declared in zstd.h, which is only included by the implementation.
+typedef struct ZSTD_DCtx_s ZSTD_DCtx;
+
+namespace tsl {
+namespace io {
+
+// An InputStream that decompresses the zstd frames read from an
+// InputStreamInterface, e.g. those written by ZstdOutputBuffer.
+//
+// A given instance of a ZstdInputStream is NOT safe for concurrent use by
+// multiple threads.
+class ZstdInputStream : public InputStreamInterface {
+ public:
+  // Creates a ZstdInputStream for `input_stream`.
+  //
+  // Takes ownership of `input_stream` iff `owns_input_stream` is true.
+  ZstdInputStream(InputStreamInterface* input_stream,
+                  const ZstdCompressionOptions& options,
+                  bool owns_input_stream);
+
+  ~ZstdInputStream() override;
+
+  // Reads bytes_to_read bytes into *result, overwriting *result.
+  //
+  // Return Status codes:
+  // OK:           If successful.
+  // OUT_OF_RANGE: If there are not enough bytes to read before the end of
+  //               the stream.
+  // DATA_LOSS:    If the stream is corrupted or truncated.
+  // others:       If reading from stream failed.
+  absl::Status ReadNBytes(int64_t bytes_to_read, tstring* result) override;
+
+  int64_t Tell() const override;
+
+  absl::Status Reset() override;
+
+ private:
+  // Decompresses more of the input into `output_buffer_`.
+  absl::Status Decompress();
+
+  InputStreamInterface* input_stream_;
+  const ZstdCompressionOptions options_;
+  const bool owns_input_stream_;
+  absl::Status init_status_;
+  ZSTD_DCtx* dctx_;
+
+  // Compressed data read from `input_stream_`, decompressed up to `in_pos_`.
+  tstring input_;
+  size_t in_pos_ = 0;
+
+  // Decompressed data, not yet read in [next_out_, end_out_).
+  const size_t output_buffer_size_;
+  std::unique_ptr<char[]> output_buffer_;
+  const char* next_out_ = nullptr;
+  const char* end_out_ = nullptr;
+
+  // Whether the last frame read is incomplete.
+  bool frame_in_progress_ = false;
+
+  // Number of decompressed bytes read.
+  int64_t bytes_read_ = 0;
+
+  ZstdInputStream(const ZstdInputStream&) = delete;
+  void operator=(const ZstdInputStream&) = delete;
+};
+
+}  // namespace io
+}  // namespace tsl
+
+#endif  // XLA_TSL_LIB_IO_ZSTD_ZSTD_INPUTSTREAM_H_
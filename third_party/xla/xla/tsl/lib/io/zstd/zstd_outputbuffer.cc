@@ -0,0 +1,127 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tsl/lib/io/zstd/zstd_outputbuffer.h"
+
+#include <zstd.h>
+
+#include <algorithm>
+
+#include "tsl/platform/errors.h"
+#include "tsl/platform/logging.h"
+
+namespace tsl {
+namespace io {
+
+namespace {
+
+// Compresses `data` with the end directive `mode` into `buffer`, and writes
+// the output to `file`.
+absl::Status Compress(ZSTD_CCtx* cctx, absl::string_view data,
+                      ZSTD_EndDirective mode, char* buffer, size_t buffer_size,
+                      WritableFile* file) {
+  if (cctx == nullptr) {
+    return errors::FailedPrecondition(
+        "ZstdOutputBuffer is closed or not initialized");
+  }
+  ZSTD_inBuffer in = {data.data(), data.size(), 0};
+  bool done = false;
+  while (!done) {
+    ZSTD_outBuffer out = {buffer, buffer_size, 0};
+    const size_t remaining = ZSTD_compressStream2(cctx, &out, &in, mode);
+    if (ZSTD_isError(remaining)) {
+      return errors::DataLoss("ZSTD_compressStream2 failed: ",
+                              ZSTD_getErrorName(remaining));
+    }
+    if (out.pos > 0) {
+      TF_RETURN_IF_ERROR(file->Append(absl::string_view(buffer, out.pos)));
+    }
+    // Unless ending or flushing, zstd may keep compressed output buffered.
+    done = mode == ZSTD_e_continue ? in.pos == in.size : remaining == 0;
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+ZstdOutputBuffer::ZstdOutputBuffer(WritableFile* file,
+                                   const ZstdCompressionOptions& options)
+    : file_(file),
+      options_(options),
+      output_buffer_size_(
+          std::max<size_t>(options.output_buffer_size, ZSTD_CStreamOutSize())),
+      output_buffer_(new char[output_buffer_size_]) {}
+
+ZstdOutputBuffer::~ZstdOutputBuffer() {
+  if (cctx_ != nullptr) {
+    LOG(WARNING) << "ZstdOutputBuffer::Close() not called. Possible data loss";
+    ZSTD_freeCCtx(cctx_);
+  }
+}
+
+absl::Status ZstdOutputBuffer::Init() {
+  cctx_ = ZSTD_createCCtx();
+  if (cctx_ == nullptr) {
+    return errors::ResourceExhausted("Failed to create a zstd context");
+  }
+  size_t ret = ZSTD_CCtx_setParameter(cctx_, ZSTD_c_compressionLevel,
+                                      options_.compression_level);
+  if (!ZSTD_isError(ret) && !options_.dictionary.empty()) {
+    ret = ZSTD_CCtx_loadDictionary(cctx_, options_.dictionary.data(),
+                                   options_.dictionary.size());
+  }
+  if (ZSTD_isError(ret)) {
+    return errors::InvalidArgument("Failed to initialize zstd compression: ",
+                                   ZSTD_getErrorName(ret));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status ZstdOutputBuffer::Append(absl::string_view data) {
+  return Compress(cctx_, data, ZSTD_e_continue, output_buffer_.get(),
+                  output_buffer_size_, file_);
+}
+
+absl::Status ZstdOutputBuffer::Flush() {
+  TF_RETURN_IF_ERROR(Compress(cctx_, absl::string_view(), ZSTD_e_flush,
+                              output_buffer_.get(), output_buffer_size_,
+                              file_));
+  return file_->Flush();
+}
+
+absl::Status ZstdOutputBuffer::Close() {
+  TF_RETURN_IF_ERROR(Compress(cctx_, absl::string_view(), ZSTD_e_end,
+                              output_buffer_.get(), output_buffer_size_,
+                              file_));
+  ZSTD_freeCCtx(cctx_);
+  cctx_ = nullptr;
+  return absl::OkStatus();
+}
+
+absl::Status ZstdOutputBuffer::Name(absl::string_view* result) const {
+  return file_->Name(result);
+}
+
+absl::Status ZstdOutputBuffer::Sync() {
+  TF_RETURN_IF_ERROR(Flush());
+  return file_->Sync();
+}
+
+absl::Status ZstdOutputBuffer::Tell(int64_t* position) {
+  return file_->Tell(position);
+}
+
+}  // namespace io
+}  // namespace tsl
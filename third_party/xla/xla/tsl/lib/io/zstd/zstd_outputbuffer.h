@@ -0,0 +1,86 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_TSL_LIB_IO_ZSTD_ZSTD_OUTPUTBUFFER_H_
+#define XLA_TSL_LIB_IO_ZSTD_ZSTD_OUTPUTBUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "xla/tsl/lib/io/zstd/zstd_compression_options.h"
+#include "tsl/platform/file_system.h"
+#include "tsl/platform/status.h"
+#include "tsl/platform/stringpiece.h"
+
+// Declared in zstd.h, which is only included by the implementation.
+typedef struct ZSTD_CCtx_s ZSTD_CCtx;
+
+namespace tsl {
+namespace io {
+
+// Provides support for writing zstd (https://facebook.github.io/zstd/)
+// compressed output to file, as a single zstd frame.
+//
+// A given instance of a ZstdOutputBuffer is NOT safe for concurrent use by
+// multiple threads.
+class ZstdOutputBuffer : public WritableFile {
+ public:
+  // Creates a ZstdOutputBuffer for `file`, which it doesn't own.
+  ZstdOutputBuffer(WritableFile* file, const ZstdCompressionOptions& options);
+  ~ZstdOutputBuffer() override;
+
+  // Initializes the compression context. This call is required before any
+  // other operation on the buffer.
+  absl::Status Init();
+
+  // Adds `data` to the compression pipeline. zstd buffers the input, so the
+  // compressed output is only written to file once it has a full block.
+  absl::Status Append(absl::string_view data) override;
+
+  // Compresses any buffered input and writes all output to file.
+  absl::Status Flush() override;
+
+  // Ends the frame and writes all output to file. This must be called before
+  // the destructor to avoid any data loss. After calling this, any further
+  // calls to `Append()`, `Flush()` or `Close()` will fail. Does not close the
+  // underlying file.
+  absl::Status Close() override;
+
+  // Returns the name of the underlying file.
+  absl::Status Name(absl::string_view* result) const override;
+
+  // Flushes and syncs the underlying file.
+  absl::Status Sync() override;
+
+  // Returns the write position in the underlying file. The position does not
+  // reflect buffered, un-flushed data.
+  absl::Status Tell(int64_t* position) override;
+
+ private:
+  WritableFile* file_;  // Not owned
+  const ZstdCompressionOptions options_;
+  const size_t output_buffer_size_;
+  std::unique_ptr<char[]> output_buffer_;
+  ZSTD_CCtx* cctx_ = nullptr;
+
+  ZstdOutputBuffer(const ZstdOutputBuffer&) = delete;
+  void operator=(const ZstdOutputBuffer&) = delete;
+};
+
+}  // namespace io
+}  // namespace tsl
+
+#endif  // XLA_TSL_LIB_IO_ZSTD_ZSTD_OUTPUTBUFFER_H_
@@ -0,0 +1,148 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <memory>
+#include <string>
+
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/lib/io/random_inputstream.h"
+#include "xla/tsl/lib/io/zstd/zstd_compression_options.h"
+#include "xla/tsl/lib/io/zstd/zstd_inputstream.h"
+#include "xla/tsl/lib/io/zstd/zstd_outputbuffer.h"
+#include "tsl/platform/env.h"
+#include "tsl/platform/errors.h"
+#include "tsl/platform/strcat.h"
+#include "tsl/platform/test.h"
+
+namespace tsl {
+namespace {
+
+string GenTestString(int copies) {
+  string result;
+  for (int i = 0; i < copies; ++i) {
+    strings::StrAppend(&result, "Lorem ipsum dolor sit amet ", i, ". ");
+  }
+  return result;
+}
+
+// Writes `data` to `fname` in `num_writes` appends, flushing after each one
+// iff `with_flush`.
+void WriteCompressed(const string& fname, const string& data, int num_writes,
+                     bool with_flush, const io::ZstdCompressionOptions& options,
+                     string* expected) {
+  std::unique_ptr<WritableFile> file;
+  TF_ASSERT_OK(Env::Default()->NewWritableFile(fname, &file));
+  io::ZstdOutputBuffer out(file.get(), options);
+  TF_ASSERT_OK(out.Init());
+  for (int i = 0; i < num_writes; ++i) {
+    TF_ASSERT_OK(out.Append(data));
+    if (with_flush) TF_ASSERT_OK(out.Flush());
+    expected->append(data);
+  }
+  TF_ASSERT_OK(out.Close());
+  TF_ASSERT_OK(file->Close());
+}
+
+// Reads `fname` back in chunks of `read_bytes`.
+absl::Status ReadCompressed(const string& fname, int64_t read_bytes,
+                            const io::ZstdCompressionOptions& options,
+                            string* result) {
+  std::unique_ptr<RandomAccessFile> file;
+  TF_RETURN_IF_ERROR(Env::Default()->NewRandomAccessFile(fname, &file));
+  io::ZstdInputStream in(new io::RandomAccessInputStream(file.get()), options,
+                         true);
+  tstring chunk;
+  absl::Status s;
+  do {
+    s = in.ReadNBytes(read_bytes, &chunk);
+    result->append(chunk);
+  } while (s.ok());
+  if (in.Tell() != static_cast<int64_t>(result->size())) {
+    return errors::Internal("Tell() returned ", in.Tell(), ", expected ",
+                            result->size());
+  }
+  return errors::IsOutOfRange(s) ? absl::OkStatus() : s;
+}
+
+TEST(ZstdBuffers, RoundTrip) {
+  const string fname = testing::TmpDir() + "/zstd_buffers_test";
+  for (int64_t buffer_size : {1, 100, 256 << 10}) {
+    for (bool with_flush : {false, true}) {
+      io::ZstdCompressionOptions options;
+      options.input_buffer_size = buffer_size;
+      options.output_buffer_size = buffer_size;
+      string expected;
+      WriteCompressed(fname, GenTestString(1000), 5, with_flush, options,
+                      &expected);
+      for (int64_t read_bytes : {1, 1000, 1 << 20}) {
+        string result;
+        TF_ASSERT_OK(ReadCompressed(fname, read_bytes, options, &result));
+        EXPECT_EQ(expected, result);
+      }
+    }
+  }
+}
+
+TEST(ZstdBuffers, Dictionary) {
+  const string fname = testing::TmpDir() + "/zstd_buffers_dictionary_test";
+  io::ZstdCompressionOptions options;
+  options.dictionary = GenTestString(20);
+  options.compression_level = 9;
+  string expected;
+  WriteCompressed(fname, GenTestString(10), 1, false, options, &expected);
+  string result;
+  TF_ASSERT_OK(ReadCompressed(fname, 100, options, &result));
+  EXPECT_EQ(expected, result);
+
+  // The data can't be decompressed without the dictionary.
+  result.clear();
+  EXPECT_TRUE(errors::IsDataLoss(
+      ReadCompressed(fname, 100, io::ZstdCompressionOptions(), &result)));
+}
+
+TEST(ZstdBuffers, Truncated) {
+  const string fname = testing::TmpDir() + "/zstd_buffers_truncated_test";
+  io::ZstdCompressionOptions options;
+  string expected;
+  WriteCompressed(fname, GenTestString(100), 1, false, options, &expected);
+  string contents;
+  TF_ASSERT_OK(ReadFileToString(Env::Default(), fname, &contents));
+  contents.pop_back();
+  TF_ASSERT_OK(WriteStringToFile(Env::Default(), fname, contents));
+  string result;
+  EXPECT_TRUE(
+      errors::IsDataLoss(ReadCompressed(fname, 100, options, &result)));
+}
+
+TEST(ZstdBuffers, Reset) {
+  const string fname = testing::TmpDir() + "/zstd_buffers_reset_test";
+  io::ZstdCompressionOptions options;
+  string expected;
+  WriteCompressed(fname, GenTestString(100), 1, false, options, &expected);
+
+  std::unique_ptr<RandomAccessFile> file;
+  TF_ASSERT_OK(Env::Default()->NewRandomAccessFile(fname, &file));
+  io::ZstdInputStream in(new io::RandomAccessInputStream(file.get()), options,
+                         true);
+  tstring result;
+  TF_ASSERT_OK(in.ReadNBytes(10, &result));
+  TF_ASSERT_OK(in.Reset());
+  EXPECT_EQ(0, in.Tell());
+  TF_ASSERT_OK(in.ReadNBytes(expected.size(), &result));
+  EXPECT_EQ(expected, result);
+}
+
+}  // namespace
+}  // namespace tsl
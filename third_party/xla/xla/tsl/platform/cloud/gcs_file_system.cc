@@ -46,6 +46,7 @@ limitations under the License.
 #include "xla/tsl/platform/cloud/google_auth_provider.h"
 #include "xla/tsl/platform/cloud/ram_file_block_cache.h"
 #include "xla/tsl/platform/cloud/time_util.h"
+#include "tsl/platform/blocking_counter.h"
 #include "tsl/platform/env.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/mutex.h"
@@ -947,6 +948,16 @@ GcsFileSystem::GcsFileSystem(bool make_default_cache) {
     timeouts_.write = timeout_value;
   }
 
+  size_t read_parallelism = kDefaultReadParallelism;
+  size_t read_chunk_size = kDefaultReadChunkSize;
+  if (GetEnvVar(kReadParallelism, strings::safe_strtou64, &value)) {
+    read_parallelism = value;
+  }
+  if (GetEnvVar(kReadChunkSize, strings::safe_strtou64, &value)) {
+    read_chunk_size = value * 1024 * 1024;
+  }
+  SetReadParallelism(read_parallelism, read_chunk_size);
+
   int64_t token_value;
   if (GetEnvVar(kThrottleRate, strings::safe_strto64, &token_value)) {
     GcsThrottleConfig config;
@@ -1094,6 +1105,18 @@ std::unique_ptr<FileBlockCache> GcsFileSystem::MakeFileBlockCache(
 }
 
 // A helper function to actually read the data from GCS.
+void GcsFileSystem::SetReadParallelism(size_t parallelism,
+                                       size_t chunk_size_bytes) {
+  read_parallelism_ = std::max<size_t>(parallelism, 1);
+  read_chunk_size_ = chunk_size_bytes;
+  read_thread_pool_.reset();
+  if (read_parallelism_ > 1 && read_chunk_size_ > 0) {
+    // The calling thread sends one of the requests.
+    read_thread_pool_ = std::make_unique<thread::ThreadPool>(
+        Env::Default(), "gcs_parallel_read", read_parallelism_ - 1);
+  }
+}
+
 absl::Status GcsFileSystem::LoadBufferFromGCS(const string& fname,
                                               size_t offset, size_t n,
                                               char* buffer,
@@ -1106,24 +1129,74 @@ absl::Status GcsFileSystem::LoadBufferFromGCS(const string& fname,
   profiler::TraceMe activity(
       [fname]() { return absl::StrCat("LoadBufferFromGCS ", fname); });
 
-  std::unique_ptr<HttpRequest> request;
-  TF_RETURN_WITH_CONTEXT_IF_ERROR(CreateHttpRequest(&request),
-                                  "when reading gs://", bucket, "/", object);
-
-  request->SetUri(strings::StrCat("https://", kStorageHost, "/", bucket, "/",
-                                  request->EscapeString(object)));
-  request->SetRange(offset, offset + n - 1);
-  request->SetResultBufferDirect(buffer, n);
-  request->SetTimeouts(timeouts_.connect, timeouts_.idle, timeouts_.read);
+  // The read is split into chunks of chunk_size bytes, loaded by ranged
+  // requests sent read_parallelism_ at a time. The requests are created in
+  // order on this thread, and only sent concurrently.
+  const size_t chunk_size =
+      read_thread_pool_ != nullptr && n > read_chunk_size_ ? read_chunk_size_
+                                                           : n;
+  const size_t num_chunks =
+      chunk_size == 0 ? 1 : (n + chunk_size - 1) / chunk_size;
+  size_t bytes_read = 0;
+  bool end_of_file = false;
+  for (size_t first_chunk = 0; first_chunk < num_chunks && !end_of_file;
+       first_chunk += read_parallelism_) {
+    const size_t end_chunk =
+        std::min(num_chunks, first_chunk + read_parallelism_);
+    std::vector<std::unique_ptr<HttpRequest>> requests(end_chunk -
+                                                       first_chunk);
+    for (size_t i = 0; i < requests.size(); ++i) {
+      const size_t chunk_offset = (first_chunk + i) * chunk_size;
+      const size_t chunk_n = std::min(chunk_size, n - chunk_offset);
+      std::unique_ptr<HttpRequest>& request = requests[i];
+      TF_RETURN_WITH_CONTEXT_IF_ERROR(CreateHttpRequest(&request),
+                                      "when reading gs://", bucket, "/",
+                                      object);
+      request->SetUri(strings::StrCat("https://", kStorageHost, "/", bucket,
+                                      "/", request->EscapeString(object)));
+      request->SetRange(offset + chunk_offset,
+                        offset + chunk_offset + chunk_n - 1);
+      request->SetResultBufferDirect(buffer + chunk_offset, chunk_n);
+      request->SetTimeouts(timeouts_.connect, timeouts_.idle, timeouts_.read);
+
+      if (stats_ != nullptr) {
+        stats_->RecordBlockLoadRequest(fname, offset + chunk_offset);
+      }
+    }
 
-  if (stats_ != nullptr) {
-    stats_->RecordBlockLoadRequest(fname, offset);
+    std::vector<absl::Status> statuses(requests.size());
+    BlockingCounter pending(requests.size() - 1);
+    for (size_t i = 1; i < requests.size(); ++i) {
+      read_thread_pool_->Schedule([&requests, &statuses, &pending, i]() {
+        statuses[i] = requests[i]->Send();
+        pending.DecrementCount();
+      });
+    }
+    statuses[0] = requests[0]->Send();
+    pending.Wait();
+
+    // A chunk shorter than requested ends the file: the following chunks, if
+    // any, are past its end.
+    for (size_t i = 0; i < requests.size(); ++i) {
+      const size_t chunk_offset = (first_chunk + i) * chunk_size;
+      const size_t chunk_n = std::min(chunk_size, n - chunk_offset);
+      TF_RETURN_WITH_CONTEXT_IF_ERROR(statuses[i], " when reading gs://",
+                                      bucket, "/", object);
+      const size_t chunk_bytes_read =
+          requests[i]->GetResultBufferDirectBytesTransferred();
+      bytes_read += chunk_bytes_read;
+      if (stats_ != nullptr) {
+        stats_->RecordBlockRetrieved(fname, offset + chunk_offset,
+                                     chunk_bytes_read);
+      }
+      throttle_.RecordResponse(chunk_bytes_read);
+      if (chunk_bytes_read < chunk_n) {
+        end_of_file = true;
+        break;
+      }
+    }
   }
 
-  TF_RETURN_WITH_CONTEXT_IF_ERROR(request->Send(), " when reading gs://",
-                                  bucket, "/", object);
-
-  size_t bytes_read = request->GetResultBufferDirectBytesTransferred();
   *bytes_transferred = bytes_read;
   VLOG(1) << "Successful read of gs://" << bucket << "/" << object << " @ "
           << offset << " of size: " << bytes_read;
@@ -1131,12 +1204,6 @@ absl::Status GcsFileSystem::LoadBufferFromGCS(const string& fname,
     return profiler::TraceMeEncode({{"block_size", bytes_read}});
   });
 
-  if (stats_ != nullptr) {
-    stats_->RecordBlockRetrieved(fname, offset, bytes_read);
-  }
-
-  throttle_.RecordResponse(bytes_read);
-
   if (bytes_read < n) {
     // Check stat cache to see if we encountered an interrupted read.
     GcsFileStat stat;
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef XLA_TSL_PLATFORM_CLOUD_GCS_FILE_SYSTEM_H_
 #define XLA_TSL_PLATFORM_CLOUD_GCS_FILE_SYSTEM_H_
 
+#include <memory>
 #include <string>
 #include <unordered_set>
 #include <utility>
@@ -32,6 +33,7 @@ limitations under the License.
 #include "tsl/platform/file_system.h"
 #include "tsl/platform/retrying_file_system.h"
 #include "tsl/platform/status.h"
+#include "tsl/platform/threadpool.h"
 
 namespace tsl {
 
@@ -62,6 +64,14 @@ constexpr size_t kDefaultMaxCacheSize = 0;
 // will be evicted on the next read.
 constexpr char kMaxStaleness[] = "GCS_READ_CACHE_MAX_STALENESS";
 constexpr uint64 kDefaultMaxStaleness = 0;
+// The environment variable that overrides the number of ranged requests a
+// single read from GCS is split into and fetched with concurrently.
+constexpr char kReadParallelism[] = "GCS_READ_PARALLELISM";
+constexpr size_t kDefaultReadParallelism = 1;
+// The environment variable that overrides the size of the ranged requests of
+// parallel reads. Specified in MB.
+constexpr char kReadChunkSize[] = "GCS_READ_CHUNK_SIZE_MB";
+constexpr size_t kDefaultReadChunkSize = 16 * 1024 * 1024;
 
 // Helper function to extract an environment variable and convert it into a
 // value of type T.
@@ -290,6 +300,17 @@ class GcsFileSystem : public FileSystem {
   void ResetFileBlockCache(size_t block_size_bytes, size_t max_bytes,
                            uint64 max_staleness_secs);
 
+  /// \brief Splits the reads larger than `chunk_size_bytes` into ranged
+  /// requests of `chunk_size_bytes`, sending up to `parallelism` of them
+  /// concurrently.
+  ///
+  /// This speeds up the large sequential reads of checkpoints, and applies to
+  /// the blocks loaded by the block cache as well as the uncached reads. A
+  /// `parallelism` of 1 disables the splitting.
+  ///
+  /// Note: must not be called while files of this file system are being read.
+  void SetReadParallelism(size_t parallelism, size_t chunk_size_bytes);
+
  protected:
   virtual std::unique_ptr<FileBlockCache> MakeFileBlockCache(
       size_t block_size, size_t max_bytes, uint64 max_staleness);
@@ -423,6 +444,12 @@ class GcsFileSystem : public FileSystem {
   // Reads smaller than block_size_ will trigger a read of block_size_.
   uint64 block_size_;
 
+  // Reads larger than read_chunk_size_ are split into ranged requests sent
+  // read_parallelism_ at a time, on read_thread_pool_.
+  size_t read_parallelism_ = kDefaultReadParallelism;
+  size_t read_chunk_size_ = kDefaultReadChunkSize;
+  std::unique_ptr<thread::ThreadPool> read_thread_pool_;
+
   // block_cache_lock_ protects the file_block_cache_ pointer (Note that
   // FileBlockCache instances are themselves threadsafe).
   mutex block_cache_lock_;
@@ -0,0 +1,235 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tsl/profiler/backends/cpu/continuous_profiler.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "xla/tsl/lib/histogram/histogram.h"
+#include "xla/tsl/profiler/backends/cpu/traceme_recorder.h"
+#include "xla/tsl/profiler/utils/tf_op_utils.h"
+#include "xla/tsl/protobuf/histogram.pb.h"
+#include "tsl/platform/env_time.h"
+#include "tsl/platform/mutex.h"
+
+namespace tsl {
+namespace profiler {
+namespace {
+
+// Bounds the memory of a window when the event names have a long tail.
+constexpr size_t kMaxEntriesPerWindow = 10000;
+
+// Adds `from` to `into`. Both must have the default buckets, encoded with
+// their zero buckets.
+void MergeHistogram(const HistogramProto& from, HistogramProto* into) {
+  if (into->num() == 0) {
+    *into = from;
+    return;
+  }
+  if (from.num() == 0) return;
+  into->set_min(std::min(into->min(), from.min()));
+  into->set_max(std::max(into->max(), from.max()));
+  into->set_num(into->num() + from.num());
+  into->set_sum(into->sum() + from.sum());
+  into->set_sum_squares(into->sum_squares() + from.sum_squares());
+  for (int i = 0; i < into->bucket_size() && i < from.bucket_size(); ++i) {
+    into->set_bucket(i, into->bucket(i) + from.bucket(i));
+  }
+}
+
+}  // namespace
+
+ContinuousProfiler* ContinuousProfiler::Get() {
+  static ContinuousProfiler* profiler = new ContinuousProfiler();
+  return profiler;
+}
+
+void ContinuousProfiler::Configure(const ContinuousProfilerOptions& options) {
+  {
+    mutex_lock lock(sample_mu_);
+    trace_level_ = options.trace_level;
+    detailed_trace_level_ = options.detailed_trace_level;
+    detailed_one_in_n_samples_ = options.detailed_one_in_n_samples;
+  }
+  {
+    mutex_lock lock(mu_);
+    window_duration_ms_ = std::max<int64_t>(1, options.window_duration_ms);
+    windows_.clear();
+    windows_.resize(std::max(1, options.num_windows));
+  }
+  steps_.store(0, std::memory_order_relaxed);
+  sampled_steps_.store(0, std::memory_order_relaxed);
+  sample_one_in_n_steps_.store(
+      std::max<int64_t>(0, options.sample_one_in_n_steps),
+      std::memory_order_relaxed);
+}
+
+bool ContinuousProfiler::MaybeStartSample() {
+  const int64_t one_in_n =
+      sample_one_in_n_steps_.load(std::memory_order_relaxed);
+  if (one_in_n <= 0 ||
+      steps_.fetch_add(1, std::memory_order_relaxed) % one_in_n != 0) {
+    return false;
+  }
+  mutex_lock lock(sample_mu_);
+  // Another step is sampled, or a profiling session is tracing.
+  if (sampling_ || TraceMeRecorder::Active(/*level=*/0)) return false;
+  const int64_t sample = sampled_steps_.load(std::memory_order_relaxed) + 1;
+  const bool detailed = detailed_one_in_n_samples_ > 0 &&
+                        sample % detailed_one_in_n_samples_ == 0;
+  sampling_ =
+      TraceMeRecorder::Start(detailed ? detailed_trace_level_ : trace_level_);
+  return sampling_;
+}
+
+void ContinuousProfiler::EndSample() {
+  TraceMeRecorder::Events events;
+  {
+    mutex_lock lock(sample_mu_);
+    // The sample was aborted, and the recorder may belong to a session now.
+    if (!sampling_) return;
+    sampling_ = false;
+    events = TraceMeRecorder::Stop();
+  }
+  sampled_steps_.fetch_add(1, std::memory_order_relaxed);
+  AddEvents(events, EnvTime::NowMicros() / EnvTime::kMillisToMicros);
+}
+
+void ContinuousProfiler::AbortSample() {
+  mutex_lock lock(sample_mu_);
+  if (!sampling_) return;
+  sampling_ = false;
+  TraceMeRecorder::Stop();
+}
+
+void ContinuousProfiler::AddEvents(const TraceMeRecorder::Events& events,
+                                   int64_t now_ms) {
+  // The durations are grouped before taking the lock.
+  absl::flat_hash_map<std::string, std::pair<bool, std::vector<double>>>
+      durations_us;
+  for (const TraceMeRecorder::ThreadEvents& thread : events) {
+    for (const TraceMeRecorder::Event& event : thread.events) {
+      if (!event.IsComplete()) continue;
+      absl::string_view name = event.name;
+      name = name.substr(0, name.find('#'));  // Drops the metadata.
+      const TfOp tf_op = ParseTfOpFullname(name);
+      if (tf_op.category != Category::kTensorFlow &&
+          tf_op.category != Category::kTfData) {
+        continue;
+      }
+      auto& [tf_data, values] = durations_us[TfOpEventName(tf_op)];
+      tf_data = tf_op.category == Category::kTfData;
+      values.push_back((event.end_time - event.start_time) / 1000.0);
+    }
+  }
+
+  mutex_lock lock(mu_);
+  if (windows_.empty()) return;
+  const int64_t index = now_ms / window_duration_ms_;
+  Window& window = windows_[index % windows_.size()];
+  if (window.index != index) {
+    window.index = index;
+    window.entries.clear();
+  }
+  for (auto& [name, tf_data_and_values] : durations_us) {
+    auto it = window.entries.find(name);
+    if (it == window.entries.end()) {
+      if (window.entries.size() >= kMaxEntriesPerWindow) continue;
+      it = window.entries.emplace(name, Entry()).first;
+      it->second.tf_data = tf_data_and_values.first;
+      it->second.durations_us = std::make_unique<histogram::Histogram>();
+    }
+    for (double value : tf_data_and_values.second) {
+      it->second.durations_us->Add(value);
+    }
+  }
+}
+
+std::vector<ContinuousProfileStats> ContinuousProfiler::Snapshot() const {
+  absl::flat_hash_map<std::string, std::pair<bool, HistogramProto>> merged;
+  {
+    mutex_lock lock(mu_);
+    const int64_t current =
+        EnvTime::NowMicros() / EnvTime::kMillisToMicros / window_duration_ms_;
+    for (const Window& window : windows_) {
+      if (window.index < 0 ||
+          window.index <= current - static_cast<int64_t>(windows_.size())) {
+        continue;
+      }
+      for (const auto& [name, entry] : window.entries) {
+        HistogramProto proto;
+        entry.durations_us->EncodeToProto(&proto,
+                                          /*preserve_zero_buckets=*/true);
+        auto& [tf_data, histogram] = merged[name];
+        tf_data = entry.tf_data;
+        MergeHistogram(proto, &histogram);
+      }
+    }
+  }
+
+  std::vector<ContinuousProfileStats> snapshot;
+  snapshot.reserve(merged.size());
+  for (const auto& [name, tf_data_and_histogram] : merged) {
+    const HistogramProto& proto = tf_data_and_histogram.second;
+    histogram::Histogram histogram;
+    if (!histogram.DecodeFromProto(proto)) continue;
+    ContinuousProfileStats stats;
+    stats.name = name;
+    stats.category = tf_data_and_histogram.first ? "tf.data" : "op";
+    stats.count = static_cast<int64_t>(proto.num());
+    stats.total_us = proto.sum();
+    stats.p50_us = histogram.Median();
+    stats.p90_us = histogram.Percentile(90.0);
+    stats.p99_us = histogram.Percentile(99.0);
+    stats.max_us = proto.max();
+    snapshot.push_back(std::move(stats));
+  }
+  std::sort(snapshot.begin(), snapshot.end(),
+            [](const ContinuousProfileStats& a,
+               const ContinuousProfileStats& b) {
+              return a.total_us != b.total_us ? a.total_us > b.total_us
+                                              : a.name < b.name;
+            });
+  return snapshot;
+}
+
+std::string ContinuousProfiler::Report(int max_entries) const {
+  const std::vector<ContinuousProfileStats> snapshot = Snapshot();
+  std::string report = absl::StrCat("Sampled steps: ", sampled_steps(), "\n");
+  absl::StrAppendFormat(&report, "%-48s %-8s %10s %12s %10s %10s %10s %10s\n",
+                        "Name", "Category", "Count", "Total(us)", "p50(us)",
+                        "p90(us)", "p99(us)", "Max(us)");
+  for (size_t i = 0; i < snapshot.size(); ++i) {
+    if (max_entries > 0 && i >= static_cast<size_t>(max_entries)) break;
+    const ContinuousProfileStats& stats = snapshot[i];
+    absl::StrAppendFormat(
+        &report, "%-48s %-8s %10d %12.1f %10.1f %10.1f %10.1f %10.1f\n",
+        stats.name, stats.category, stats.count, stats.total_us, stats.p50_us,
+        stats.p90_us, stats.p99_us, stats.max_us);
+  }
+  return report;
+}
+
+}  // namespace profiler
+}  // namespace tsl
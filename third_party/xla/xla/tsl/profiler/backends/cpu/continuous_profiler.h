@@ -0,0 +1,152 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_TSL_PROFILER_BACKENDS_CPU_CONTINUOUS_PROFILER_H_
+#define XLA_TSL_PROFILER_BACKENDS_CPU_CONTINUOUS_PROFILER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "xla/tsl/lib/histogram/histogram.h"
+#include "xla/tsl/profiler/backends/cpu/traceme_recorder.h"
+#include "tsl/platform/mutex.h"
+#include "tsl/platform/thread_annotations.h"
+
+namespace tsl {
+namespace profiler {
+
+struct ContinuousProfilerOptions {
+  // Records the TraceMes of one step in this many. 0 disables sampling.
+  int64_t sample_one_in_n_steps = 0;
+  // The TraceMe level of the samples, and the more detailed level recorded by
+  // one sample in `detailed_one_in_n_samples` (never if 0).
+  int trace_level = 1;
+  int detailed_trace_level = 2;
+  int64_t detailed_one_in_n_samples = 10;
+  // The stats cover the last `num_windows` windows of `window_duration_ms`.
+  int64_t window_duration_ms = 60 * 1000;
+  int num_windows = 10;
+};
+
+// The durations of the sampled executions of a TF op type or tf.data
+// iterator over the rolling window.
+struct ContinuousProfileStats {
+  std::string name;
+  // "op" or "tf.data".
+  std::string category;
+  int64_t count = 0;
+  double total_us = 0.0;
+  double p50_us = 0.0;
+  double p90_us = 0.0;
+  double p99_us = 0.0;
+  double max_us = 0.0;
+};
+
+// An always-on, low-overhead alternative to profiling sessions: records the
+// TraceMes of a small share of steps and aggregates the durations of the TF
+// ops (by type) and tf.data iterators into histograms over a rolling window.
+//
+// Steps are delimited by ContinuousProfiler::Step. Outside of samples TraceMe
+// isn't recording, so the steps which aren't sampled only pay for a counter
+// increment. A sample isn't started while a profiling session is active, and
+// starting a session aborts the sample in flight.
+//
+// Thread-safe.
+class ContinuousProfiler {
+ public:
+  // The profiler of the process, to which the runtime reports its steps.
+  static ContinuousProfiler* Get();
+
+  ContinuousProfiler() = default;
+  ContinuousProfiler(const ContinuousProfiler&) = delete;
+  ContinuousProfiler& operator=(const ContinuousProfiler&) = delete;
+
+  // Replaces the options and clears the stats.
+  void Configure(const ContinuousProfilerOptions& options);
+  bool enabled() const {
+    return sample_one_in_n_steps_.load(std::memory_order_relaxed) > 0;
+  }
+
+  // Marks a step of the runtime, sampled if it is its turn and no other
+  // sample or profiling session is recording.
+  class Step {
+   public:
+    explicit Step(ContinuousProfiler* profiler = Get())
+        : profiler_(profiler), sampled_(profiler_->MaybeStartSample()) {}
+    ~Step() {
+      if (sampled_) profiler_->EndSample();
+    }
+    Step(const Step&) = delete;
+    Step& operator=(const Step&) = delete;
+
+   private:
+    ContinuousProfiler* const profiler_;
+    const bool sampled_;
+  };
+
+  // Drops the sample in flight, if any, so that a profiling session can
+  // start tracing.
+  void AbortSample();
+
+  // The stats of the current rolling window, by decreasing total time.
+  std::vector<ContinuousProfileStats> Snapshot() const;
+  // The first `max_entries` stats of Snapshot() as a table (all if 0).
+  std::string Report(int max_entries = 0) const;
+
+  int64_t sampled_steps() const {
+    return sampled_steps_.load(std::memory_order_relaxed);
+  }
+
+  // Adds the complete events of a sample to the stats. Public for tests.
+  void AddEvents(const TraceMeRecorder::Events& events, int64_t now_ms);
+
+ private:
+  struct Entry {
+    bool tf_data = false;
+    std::unique_ptr<histogram::Histogram> durations_us;
+  };
+  struct Window {
+    // Window index since the epoch, -1 if unused.
+    int64_t index = -1;
+    absl::flat_hash_map<std::string, Entry> entries;
+  };
+
+  bool MaybeStartSample();
+  void EndSample();
+
+  std::atomic<int64_t> sample_one_in_n_steps_ = 0;
+  std::atomic<int64_t> steps_ = 0;
+  std::atomic<int64_t> sampled_steps_ = 0;
+
+  // Serializes the starts and ends of samples with AbortSample().
+  mutex sample_mu_;
+  bool sampling_ TF_GUARDED_BY(sample_mu_) = false;
+  int trace_level_ TF_GUARDED_BY(sample_mu_) = 1;
+  int detailed_trace_level_ TF_GUARDED_BY(sample_mu_) = 2;
+  int64_t detailed_one_in_n_samples_ TF_GUARDED_BY(sample_mu_) = 10;
+
+  mutable mutex mu_;
+  int64_t window_duration_ms_ TF_GUARDED_BY(mu_) = 60 * 1000;
+  std::vector<Window> windows_ TF_GUARDED_BY(mu_);
+};
+
+}  // namespace profiler
+}  // namespace tsl
+
+#endif  // XLA_TSL_PROFILER_BACKENDS_CPU_CONTINUOUS_PROFILER_H_
@@ -0,0 +1,128 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "xla/tsl/profiler/backends/cpu/continuous_profiler.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "xla/tsl/profiler/backends/cpu/traceme_recorder.h"
+#include "tsl/platform/env_time.h"
+#include "tsl/platform/test.h"
+#include "tsl/profiler/lib/traceme.h"
+
+namespace tsl {
+namespace profiler {
+namespace {
+
+int64_t NowMillis() { return EnvTime::NowMicros() / EnvTime::kMillisToMicros; }
+
+ContinuousProfilerOptions SampleOneIn(int64_t n) {
+  ContinuousProfilerOptions options;
+  options.sample_one_in_n_steps = n;
+  return options;
+}
+
+TEST(ContinuousProfilerTest, AggregatesOpsAndIterators) {
+  ContinuousProfiler profiler;
+  profiler.Configure(SampleOneIn(1));
+  TraceMeRecorder::Events events(1);
+  events[0].events.push_back({"model/dense/MatMul:MatMul#id=1#", 1000, 3000});
+  events[0].events.push_back({"model/dense_1/MatMul:MatMul", 5000, 9000});
+  events[0].events.push_back({"Iterator::Prefetch::Map", 2000, 3000});
+  events[0].events.push_back({"SessionRun#id=1#", 1000, 9000});
+  profiler.AddEvents(events, NowMillis());
+
+  const std::vector<ContinuousProfileStats> snapshot = profiler.Snapshot();
+  ASSERT_EQ(snapshot.size(), 2);
+  EXPECT_EQ(snapshot[0].name, "MatMul");
+  EXPECT_EQ(snapshot[0].category, "op");
+  EXPECT_EQ(snapshot[0].count, 2);
+  EXPECT_DOUBLE_EQ(snapshot[0].total_us, 6.0);
+  EXPECT_DOUBLE_EQ(snapshot[0].max_us, 4.0);
+  EXPECT_EQ(snapshot[1].name, "Iterator::Map");
+  EXPECT_EQ(snapshot[1].category, "tf.data");
+  EXPECT_EQ(snapshot[1].count, 1);
+}
+
+TEST(ContinuousProfilerTest, MergesWindowsAndDropsExpiredOnes) {
+  ContinuousProfilerOptions options = SampleOneIn(1);
+  options.window_duration_ms = 1000;
+  options.num_windows = 3;
+  ContinuousProfiler profiler;
+  profiler.Configure(options);
+  TraceMeRecorder::Events events(1);
+  events[0].events.push_back({"a/Relu:Relu", 1000, 2000});
+  const int64_t now_ms = NowMillis();
+  profiler.AddEvents(events, now_ms);
+  profiler.AddEvents(events, now_ms - 1000);
+  profiler.AddEvents(events, now_ms - 5000);
+
+  const std::vector<ContinuousProfileStats> snapshot = profiler.Snapshot();
+  ASSERT_EQ(snapshot.size(), 1);
+  EXPECT_EQ(snapshot[0].count, 2);
+}
+
+TEST(ContinuousProfilerTest, SamplesOneInNSteps) {
+  ContinuousProfiler profiler;
+  profiler.Configure(SampleOneIn(2));
+  for (int i = 0; i < 4; ++i) {
+    ContinuousProfiler::Step step(&profiler);
+    TraceMe trace_me("a/Relu:Relu");
+  }
+  EXPECT_EQ(profiler.sampled_steps(), 2);
+  EXPECT_FALSE(TraceMeRecorder::Active(/*level=*/0));
+  const std::vector<ContinuousProfileStats> snapshot = profiler.Snapshot();
+  ASSERT_EQ(snapshot.size(), 1);
+  EXPECT_EQ(snapshot[0].name, "Relu");
+  EXPECT_EQ(snapshot[0].count, 2);
+}
+
+TEST(ContinuousProfilerTest, AbortedSampleReleasesRecorder) {
+  ContinuousProfiler profiler;
+  profiler.Configure(SampleOneIn(1));
+  {
+    ContinuousProfiler::Step step(&profiler);
+    EXPECT_TRUE(TraceMeRecorder::Active(/*level=*/0));
+    profiler.AbortSample();
+    EXPECT_FALSE(TraceMeRecorder::Active(/*level=*/0));
+    // A profiling session starting now owns the recorder.
+    ASSERT_TRUE(TraceMeRecorder::Start(/*level=*/1));
+  }
+  EXPECT_TRUE(TraceMeRecorder::Active(/*level=*/0));
+  TraceMeRecorder::Stop();
+  EXPECT_EQ(profiler.sampled_steps(), 0);
+}
+
+TEST(ContinuousProfilerTest, DoesntSampleWhileRecorderIsActive) {
+  ContinuousProfiler profiler;
+  profiler.Configure(SampleOneIn(1));
+  ASSERT_TRUE(TraceMeRecorder::Start(/*level=*/1));
+  { ContinuousProfiler::Step step(&profiler); }
+  EXPECT_TRUE(TraceMeRecorder::Active(/*level=*/0));
+  TraceMeRecorder::Stop();
+  EXPECT_EQ(profiler.sampled_steps(), 0);
+}
+
+TEST(ContinuousProfilerTest, DisabledByDefault) {
+  ContinuousProfiler profiler;
+  EXPECT_FALSE(profiler.enabled());
+  { ContinuousProfiler::Step step(&profiler); }
+  EXPECT_FALSE(TraceMeRecorder::Active(/*level=*/0));
+  EXPECT_EQ(profiler.sampled_steps(), 0);
+}
+
+}  // namespace
+}  // namespace profiler
+}  // namespace tsl
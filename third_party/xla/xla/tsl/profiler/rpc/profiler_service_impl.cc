@@ -20,6 +20,7 @@ limitations under the License.
 #include "absl/container/flat_hash_map.h"
 #include "absl/strings/str_replace.h"
 #include "grpcpp/support/status.h"
+#include "xla/tsl/profiler/backends/cpu/continuous_profiler.h"
 #include "xla/tsl/profiler/rpc/client/save_profile.h"
 #include "xla/tsl/profiler/utils/file_system_utils.h"
 #include "xla/tsl/profiler/utils/math_utils.h"
@@ -48,6 +49,10 @@ using tensorflow::ProfileResponse;
 using tensorflow::TerminateRequest;
 using tensorflow::TerminateResponse;
 
+// The number of entries of the continuous profiler returned by Monitor below
+// monitoring level 2.
+constexpr int kMonitorMaxEntries = 20;
+
 // Collects data in XSpace format. The data is saved to a repository
 // unconditionally.
 absl::Status CollectDataToRepository(const ProfileRequest& request,
@@ -66,9 +71,18 @@ absl::Status CollectDataToRepository(const ProfileRequest& request,
 
 class ProfilerServiceImpl : public tensorflow::grpc::ProfilerService::Service {
  public:
+  // Returns the rolling stats of the continuous profiler, all of them at
+  // monitoring level 2 and above, the most expensive otherwise.
   ::grpc::Status Monitor(::grpc::ServerContext* ctx, const MonitorRequest* req,
                          MonitorResponse* response) override {
-    return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "unimplemented.");
+    ContinuousProfiler* continuous_profiler = ContinuousProfiler::Get();
+    if (!continuous_profiler->enabled()) {
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED,
+                            "continuous profiling is disabled.");
+    }
+    response->set_data(continuous_profiler->Report(
+        req->monitoring_level() >= 2 ? 0 : kMonitorMaxEntries));
+    return ::grpc::Status::OK;
   }
 
   ::grpc::Status Profile(::grpc::ServerContext* ctx, const ProfileRequest* req,